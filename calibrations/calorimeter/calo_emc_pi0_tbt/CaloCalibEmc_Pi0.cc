@@ -36,10 +36,155 @@
 #include <cmath>      // for abs
 #include <iostream>
 #include <map>      // for _Rb_tree_const_iterator
+#include <memory>
 #include <string>   // for string
 #include <utility>  // for pair
 #include <vector>   // for vector
 
+namespace
+{
+  // clusters of a block of events read from the cluster tree, with the calibration applied
+  struct ClusterBlock
+  {
+    std::vector<size_t> first{0};  // first cluster of each event, one more entry than events
+    std::vector<TLorentzVector> clusters;
+    std::vector<int> tower_eta;
+    std::vector<float> eta;  // as stored in the tree
+    std::vector<float> phi;
+
+    void clear()
+    {
+      first.assign(1, 0);
+      clusters.clear();
+      tower_eta.clear();
+      eta.clear();
+      phi.clear();
+    }
+  };
+
+  // pair passing the cuts, with the values filled into the histograms
+  struct PairFill
+  {
+    int tower_eta;
+    float mass;
+    double pt1;
+    double pi0pt;
+    float alpha;
+    float eta;
+    float phi;
+  };
+
+  // number of events read before their pairs are searched
+  constexpr size_t kBlockEvents = 10000;
+
+  // pairs of one event of the block, same cuts as the loop over the cluster tree
+  void select_pairs(const ClusterBlock &block, const size_t ievt, std::vector<PairFill> &pairs)
+  {
+    pairs.clear();
+    const size_t first = block.first[ievt];
+    const int iCs = block.first[ievt + 1] - first;
+    const TLorentzVector *savClusLV = block.clusters.data() + first;
+
+    float pt1cut = 0, pt2cut = 0;
+
+    /////////////////////////////////////////////////////////////////
+    //////////////////////////////////////////////////////
+    // *********************************
+    //
+    //  CUTS FOLLOW HERE (e.g. pt cuts)
+    //
+    //*************************************
+    ///////////////////////////////////
+
+    // centrality dependent pt cuts designed to keep
+    // statistical cluster count   contribution (& sig/bkg)
+    // constant with all centrality
+    // in order to maximize statistical power i.e. using all events
+    // in the calibration not just peripheral events.
+    // this is neccessary for the summer 23 data because
+    // the event rate was small and the total statistics per
+    // stable calibration period (typically a daq run-length) is small
+
+    float modCutFactor = 1.0;
+
+    if (iCs < 30)
+    {
+      // pt1cut =  1.65*modCutFactor;
+      // pt2cut  = 0.8*modCutFactor;
+
+      pt1cut = 1.3 * modCutFactor;
+      pt2cut = 0.7 * modCutFactor;
+    }
+    else
+    {
+      // pt1cut = 1.65*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
+      // pt2cut = 0.8*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
+
+      pt1cut = 1.3 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
+      pt2cut = 0.7 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
+    }
+
+    float pi0ptcut = 1.22 * (pt1cut + pt2cut);
+
+    // energy asymmetry alpha cut
+    float alphacutval = 0.6;
+
+    float deltaRconecut = 1.1;  // 2-gamma opening angle(dR) cut
+    // value relevant for background extent in mass
+    //  not in peak area.
+
+    ////////////////////////////////////////////////////////
+    //////////////////////////////////
+    //   END CUTS
+    ///////////////////////////////////////
+    /////////////////////////////////////
+
+    for (int jCs = 0; jCs < iCs; jCs++)
+    {
+      const TLorentzVector *pho1 = &savClusLV[jCs];
+      if (fabs(pho1->Pt()) < pt1cut)
+      {
+        continue;
+      }
+
+      // another loop to go into the saved cluster
+      for (int kCs = 0; kCs < iCs; kCs++)
+      {
+        if (jCs == kCs)
+        {
+          continue;
+        }
+
+        const TLorentzVector *pho2 = &savClusLV[kCs];
+
+        if (fabs(pho2->Pt()) < pt2cut)
+        {
+          continue;
+        }
+
+        float alpha = fabs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
+
+        if (alpha > alphacutval)
+        {
+          continue;
+        }
+
+        if (pho1->DeltaR(*pho2) > deltaRconecut)
+        {
+          continue;
+        }
+
+        TLorentzVector pi0lv = *pho1 + *pho2;
+        if (fabs(pi0lv.Pt()) > pi0ptcut)
+        {
+          float pairInvMass = pi0lv.M();
+          pairs.push_back({block.tower_eta[first + jCs], pairInvMass, pho1->Pt(), pi0lv.Pt(), alpha, block.eta[first + jCs], block.phi[first + jCs]});
+        }
+      }
+    }
+  }
+}  // namespace
+
 //____________________________________________________________________________..
 CaloCalibEmc_Pi0::CaloCalibEmc_Pi0(const std::string &name, const std::string &filename)
   : SubsysReco(name)
@@ -487,10 +632,6 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
   t1->SetBranchAddress("_maxTowerEtas", _maxTowerEtas);
   t1->SetBranchAddress("_maxTowerPhis", _maxTowerPhis);
 
-  // pre-loop to save all the clusters LorentzVector
-
-  TLorentzVector *savClusLV[10000];
-
   //  int nEntries = (int) t1->GetEntriesFast();
   int nEntries = (int) t1->GetEntries();
   int nevts2 = nevts;
@@ -503,6 +644,52 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
   // keeping track of discarded clusters for v7
   int discarded_clusters = 0;
 
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    std::cout << "searching pairs with " << m_threadpool->size() << " threads" << std::endl;
+  }
+
+  // the tree is read serially into blocks of events, the pairs of the events are searched
+  // in parallel and the histograms are filled in event order once the block is done
+  ClusterBlock block;
+  std::vector<std::vector<PairFill>> event_pairs;
+  auto process_block = [&]()
+  {
+    const size_t nblock = block.first.size() - 1;
+    event_pairs.resize(nblock);
+    if (m_threadpool && nblock > 1)
+    {
+      m_threadpool->parallel_for(nblock, [&](size_t ievt)
+                                 { select_pairs(block, ievt, event_pairs[ievt]); });
+    }
+    else
+    {
+      for (size_t ievt = 0; ievt < nblock; ievt++)
+      {
+        select_pairs(block, ievt, event_pairs[ievt]);
+      }
+    }
+
+    for (size_t ievt = 0; ievt < nblock; ievt++)
+    {
+      for (const auto &pair : event_pairs[ievt])
+      {
+        alphaCut = pair.alpha;
+
+        // fill the tower by tower histograms with invariant mass
+        // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
+        // not useful in summer 23 data
+        eta_hist.at(pair.tower_eta)->Fill(pair.mass);
+        pt1_ptpi0_alpha->Fill(pair.pt1, pair.pi0pt, pair.alpha);
+        pairInvMassTotal->Fill(pair.mass);
+        mass_eta->Fill(pair.mass, pair.eta);
+        mass_eta_phi->Fill(pair.mass, pair.eta, pair.phi);
+      }
+    }
+    block.clear();
+  };
+
   for (int i = 0; i < nevts2; i++)
   {
     // load the ith instance of the TTree
@@ -524,24 +711,15 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       continue;
     }
 
-    float pt1cut = 0, pt2cut = 0;
-
     for (int j = 0; j < nClusters; j++)
     {
-      // float px, py, pz;
       float pt, eta, phi, E, aggcv;
       pt = _clusterPts[j];
       eta = _clusterEtas[j];
       phi = _clusterPhis[j];
       E = _clusterEnergies[j];
-      // px  =  pt * cos(phi);
-      // py  =  pt * sin(phi);
-      // pz  =  pt * sinh(eta);
-      // pt *= myaggcorr[
       aggcv = myaggcorr.at(_maxTowerEtas[j]).at(_maxTowerPhis[j]);
 
-      // std::cout << "aggcv applied: " << aggcv << std::endl;
-
       // eta slice shifts test
       //   int ket = _maxTowerEtas[j]/4;
       //   int jket = ket %4;
@@ -553,118 +731,21 @@ void CaloCalibEmc_Pi0::Loop(int nevts, const std::string &filename, TTree *intre
       pt *= aggcv;
       E *= aggcv;
 
-      savClusLV[j] = new TLorentzVector();
-      savClusLV[j]->SetPtEtaPhiE(pt, eta, phi, E);
+      block.clusters.emplace_back();
+      block.clusters.back().SetPtEtaPhiE(pt, eta, phi, E);
+      block.tower_eta.push_back(_maxTowerEtas[j]);
+      block.eta.push_back(eta);
+      block.phi.push_back(phi);
     }
+    block.first.push_back(block.clusters.size());
 
-    TLorentzVector *pho1, *pho2;
-    int iCs = nClusters;
-    for (int jCs = 0; jCs < iCs; jCs++)
+    if (block.first.size() > kBlockEvents)
     {
-      pho1 = savClusLV[jCs];
-      /////////////////////////////////////////////////////////////////
-      //////////////////////////////////////////////////////
-      // *********************************
-      //
-      //  CUTS FOLLOW HERE (e.g. pt cuts)
-      //
-      //*************************************
-      ///////////////////////////////////
-
-      // centrality dependent pt cuts designed to keep
-      // statistical cluster count   contribution (& sig/bkg)
-      // constant with all centrality
-      // in order to maximize statistical power i.e. using all events
-      // in the calibration not just peripheral events.
-      // this is neccessary for the summer 23 data because
-      // the event rate was small and the total statistics per
-      // stable calibration period (typically a daq run-length) is small
-
-      float modCutFactor = 1.0;
-
-      if (iCs < 30)
-      {
-        // pt1cut =  1.65*modCutFactor;
-        // pt2cut  = 0.8*modCutFactor;
-
-        pt1cut = 1.3 * modCutFactor;
-        pt2cut = 0.7 * modCutFactor;
-      }
-      else
-      {
-        // pt1cut = 1.65*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
-        // pt2cut = 0.8*modCutFactor +  1.4*(iCs-29)/200.0*modCutFactor;
-
-        pt1cut = 1.3 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
-        pt2cut = 0.7 * modCutFactor + 1.4 * (iCs - 29) / 200.0 * modCutFactor;
-      }
-
-      float pi0ptcut = 1.22 * (pt1cut + pt2cut);
-
-      // energy asymmetry alpha cut
-      float alphacutval = 0.6;
-
-      float deltaRconecut = 1.1;  // 2-gamma opening angle(dR) cut
-      // value relevant for background extent in mass
-      //  not in peak area.
-
-      ////////////////////////////////////////////////////////
-      //////////////////////////////////
-      //   END CUTS
-      ///////////////////////////////////////
-      /////////////////////////////////////
-
-      if (fabs(pho1->Pt()) < pt1cut)
-      {
-        continue;
-      }
-
-      // another loop to go into the saved cluster
-      for (int kCs = 0; kCs < iCs; kCs++)
-      {
-        if (jCs == kCs)
-        {
-          continue;
-        }
-
-        pho2 = savClusLV[kCs];
-
-        if (fabs(pho2->Pt()) < pt2cut)
-        {
-          continue;
-        }
-
-        alphaCut = fabs((pho1->E() - pho2->E()) / (pho1->E() + pho2->E()));
-
-        if (alphaCut > alphacutval)
-        {
-          continue;
-        }
-
-        TLorentzVector pi0lv;
-
-        if (pho1->DeltaR(*pho2) > deltaRconecut)
-        {
-          continue;
-        }
-
-        pi0lv = *pho1 + *pho2;
-        if (fabs(pi0lv.Pt()) > pi0ptcut)
-        {
-          float pairInvMass = pi0lv.M();
-
-          // fill the tower by tower histograms with invariant mass
-          // cemc_hist_eta_phi[_maxTowerEtas[jCs]][_maxTowerPhis[jCs]]->Fill(pairInvMass);
-          // not useful in summer 23 data
-          eta_hist.at(_maxTowerEtas[jCs])->Fill(pairInvMass);
-          pt1_ptpi0_alpha->Fill(pho1->Pt(), pi0lv.Pt(), alphaCut);
-          pairInvMassTotal->Fill(pairInvMass);
-          mass_eta->Fill(pairInvMass, _clusterEtas[jCs]);
-          mass_eta_phi->Fill(pairInvMass, _clusterEtas[jCs], _clusterPhis[jCs]);
-        }
-      }
+      process_block();
     }
   }
+  process_block();
+
   std::cout << "total number of events: " << nEntries << std::endl;
   std::cout << "total number of events discarded: " << discarded_clusters << std::endl;
 }
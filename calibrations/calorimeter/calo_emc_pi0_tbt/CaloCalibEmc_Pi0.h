@@ -5,7 +5,10 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/PHThreadPool.h>
+
 #include <array>
+#include <memory>
 #include <string>
 
 class PHCompositeNode;
@@ -73,6 +76,13 @@ class CaloCalibEmc_Pi0 : public SubsysReco
     _setMassVal = insetval;
   }
 
+  // threads used by Loop to search the cluster pairs, 0 uses all cores.
+  // The histograms are filled in event order, so they do not depend on it
+  void set_n_threads(unsigned int n)
+  {
+    m_nthreads = n;
+  }
+
  private:
   //  float setMassVal = 0.135;
   float _setMassVal{0.152};
@@ -126,6 +136,9 @@ class CaloCalibEmc_Pi0 : public SubsysReco
   TFile *f_temp{nullptr};
 
   int m_UseTowerInfo{0};  // 0 only old tower, 1 only new (TowerInfo based),
+
+  unsigned int m_nthreads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif  //   CALOEMCPI0TBT_CALOCALIBEMC_PI0_H
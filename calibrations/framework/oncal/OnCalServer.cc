@@ -53,6 +53,7 @@
 #include <iterator>  // for reverse_iterator
 #include <list>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <utility>  // for pair
 
@@ -320,7 +321,6 @@ int OnCalServer::BeginRun(const int runno)
       insertRunNumInDB(table, runNum);
       std::string calibname = (*iter).first->Name();
       add_calibrator_to_statustable(calibname);
-      std::set<int>::const_iterator runiter;
       int calibstatus = GetCalibStatus(calibname, runNum);
       if (calibstatus > 0 && testmode == 0)
       {
@@ -331,12 +331,7 @@ int OnCalServer::BeginRun(const int runno)
       }
       else
       {
-        std::ostringstream stringarg;
-        stringarg << OnCalDBCodes::STARTED;
-        for (runiter = runlist.begin(); runiter != runlist.end(); ++runiter)
-        {
-          updateDB(successTable, calibname, stringarg.str(), *runiter);
-        }
+        updateDBRunList(calibname, OnCalDBCodes::STARTED);
       }
     }
     if (NeedOtherTimeStamp.find((*iter).first) != NeedOtherTimeStamp.end())
@@ -424,6 +419,7 @@ int OnCalServer::End()
 
   gROOT->cd(default_Tdirectory.c_str());
   currdir = gDirectory->GetPath();
+  std::vector<OnCal *> calibrators;
   for (iter = Subsystems.begin(); iter != Subsystems.end(); ++iter)
   {
     OnCal *oncal = dynamic_cast<OnCal *>((*iter).first);
@@ -441,85 +437,43 @@ int OnCalServer::End()
       exit(1);
     }
 
-    std::string CalibratorName = oncal->Name();
-
     int verificationstatus = oncal->VerificationOK();
     int databasecommitstatus = oncal->CommitedToPdbCalOK();
 
-    // report success database the status of the calibration
-    if (recordDB)
-    {
-      std::string table = "OnCal";
-      table += CalibratorName;
-
-      std::ostringstream stringarg;
-      if (databasecommitstatus == OnCalDBCodes::SUCCESS)
-      {
-        stringarg << OnCalDBCodes::COVERED;
-      }
-      else
-      {
-        stringarg << OnCalDBCodes::FAILED;
-      }
-      std::set<int>::const_iterator runiter;
-      for (runiter = runlist.begin(); runiter != runlist.end(); ++runiter)
-      {
-        updateDB(successTable, CalibratorName, stringarg.str(), *runiter);
-      }
-      // update the first run which was used in the calibration
-      // with the real status
-      updateDB(successTable, CalibratorName, databasecommitstatus);
-
-      stringarg.str("");
-      stringarg << databasecommitstatus;
-      updateDB(table, "committed", stringarg.str(), RunNumber());
+    // the status is reported to the success database after the loop
+    calibrators.push_back(oncal);
 
-      stringarg.str("");
-      stringarg << verificationstatus;
-      updateDB(table, "verified", stringarg.str(), RunNumber());
+    std::cout << "SERVER SUMMARY: " << oncal->Name() << "  "
+              << (verificationstatus == 1 ? "Verification: SUCCESS  " : "Verification: FAILURE  ")
+              << (databasecommitstatus == 1 ? "DB commit: SUCCESS  " : "DB commit: FAILURE  ")
+              << std::endl;
 
-      odbc::Timestamp stp(time(nullptr));
-      updateDB(table, "date", stp.toString(), RunNumber());
-      updateDB(table, "comment", oncal->Comment(), RunNumber());
-      time_t beginticks = beginTimeStamp.getTics();
-      stringarg.str("");
-      stringarg << beginticks;
-      updateDB(table, "startvaltime", stringarg.str(), RunNumber());
-      stp.setTime(beginticks);
-      updateDB(table, "begintime", stp.toString(), RunNumber());
-      time_t endticks = endTimeStamp.getTics();
-      stringarg.str("");
-      stringarg << endticks;
-      updateDB(table, "endvaltime", stringarg.str(), RunNumber());
-      stp.setTime(endticks);
-      updateDB(table, "endtime", stp.toString(), RunNumber());
+    printStamps();
+  }
+  gROOT->cd(currdir.c_str());
 
-      std::string filelist = "";
-      for (Fun4AllSyncManager *sync : SyncManagers)
+  // report success database the status of the calibrations
+  if (recordDB && !calibrators.empty())
+  {
+    std::string filelist;
+    for (Fun4AllSyncManager *sync : SyncManagers)
+    {
+      for (Fun4AllInputManager *inmgr : sync->GetInputManagers())
       {
-        for (Fun4AllInputManager *inmgr : sync->GetInputManagers())
+        for (const std::string &infile : inmgr->GetFileOpenedList())
         {
-          for (const std::string &infile : inmgr->GetFileOpenedList())
-          {
-            filelist += (infile).substr(((infile).find_last_of('/') + 1), (infile).size());
-            filelist += " ";  // this needs to be stripped again for last entry
-          }
+          filelist += (infile).substr(((infile).find_last_of('/') + 1), (infile).size());
+          filelist += " ";  // this needs to be stripped again for last entry
         }
       }
+    }
+    if (!filelist.empty())
+    {
       filelist.pop_back();  // strip empty space at end from loop
-      std::cout << "FileList: " << filelist << std::endl;
-      updateDB(table, "files", filelist, RunNumber());
-      updateDB(table, "cvstag", cvstag, RunNumber());
     }
-
-    std::cout << "SERVER SUMMARY: " << oncal->Name() << "  "
-              << (verificationstatus == 1 ? "Verification: SUCCESS  " : "Verification: FAILURE  ")
-              << (databasecommitstatus == 1 ? "DB commit: SUCCESS  " : "DB commit: FAILURE  ")
-              << std::endl;
-
-    printStamps();
+    std::cout << "FileList: " << filelist << std::endl;
+    recordCalibratorsInDB(calibrators, filelist);
   }
-  gROOT->cd(currdir.c_str());
   dumpHistos();  // save the histograms in files
   return i;
 }
@@ -1045,6 +999,156 @@ bool OnCalServer::updateDB(const std::string &table, const std::string &column,
 
 //---------------------------------------------------------------------
 
+bool OnCalServer::updateDBRunList(const std::string &column, const int value)
+{
+  if (!DBconnection)
+  {
+    connectDB();
+  }
+  std::ostringstream cmd;
+  cmd << "UPDATE "
+      << successTable
+      << " SET "
+      << column
+      << " = ? WHERE runnumber = ?";
+
+  if (Verbosity() == 1)
+  {
+    std::cout << "in function OnCalServer::updateDBRunList() ... ";
+    std::cout << "executing SQL statement for " << runlist.size() << " runs ... " << std::endl;
+    std::cout << cmd.str() << std::endl;
+  }
+
+  try
+  {
+    std::unique_ptr<odbc::PreparedStatement> stmt(DBconnection->prepareStatement(cmd.str()));
+    for (int run : runlist)
+    {
+      stmt->setInt(1, value);
+      stmt->setInt(2, run);
+      stmt->executeUpdate();
+    }
+  }
+  catch (odbc::SQLException &e)
+  {
+    std::cout << e.getMessage() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------
+
+bool OnCalServer::recordCalibratorStatus(OnCal *calibrator, const std::string &filelist)
+{
+  const std::string CalibratorName = calibrator->Name();
+  const std::string table = "OnCal" + CalibratorName;
+  const int verificationstatus = calibrator->VerificationOK();
+  const int databasecommitstatus = calibrator->CommitedToPdbCalOK();
+
+  // all runs used in the calibration are covered (or failed)
+  if (!updateDBRunList(CalibratorName, (databasecommitstatus == OnCalDBCodes::SUCCESS) ? OnCalDBCodes::COVERED : OnCalDBCodes::FAILED))
+  {
+    return false;
+  }
+
+  std::ostringstream cmd;
+  try
+  {
+    // update the first run which was used in the calibration
+    // with the real status
+    cmd << "UPDATE " << successTable << " SET " << CalibratorName << " = ? WHERE runnumber = ?";
+    std::unique_ptr<odbc::PreparedStatement> stmt(DBconnection->prepareStatement(cmd.str()));
+    stmt->setInt(1, databasecommitstatus);
+    stmt->setInt(2, runNum);
+    stmt->executeUpdate();
+
+    cmd.str("");
+    cmd << "UPDATE " << table
+        << " SET committed = ?, verified = ?, date = ?, comment = ?,"
+        << " startvaltime = ?, begintime = ?, endvaltime = ?, endtime = ?,"
+        << " files = ?, cvstag = ? WHERE runnumber = ?";
+    if (Verbosity() == 1)
+    {
+      std::cout << "in function OnCalServer::recordCalibratorStatus() ... ";
+      std::cout << "executing SQL statement ... " << std::endl;
+      std::cout << cmd.str() << std::endl;
+    }
+    stmt.reset(DBconnection->prepareStatement(cmd.str()));
+    const time_t beginticks = beginTimeStamp.getTics();
+    const time_t endticks = endTimeStamp.getTics();
+    stmt->setInt(1, databasecommitstatus);
+    stmt->setInt(2, verificationstatus);
+    stmt->setTimestamp(3, odbc::Timestamp(time(nullptr)));
+    stmt->setString(4, calibrator->Comment());
+    stmt->setLong(5, beginticks);
+    stmt->setTimestamp(6, odbc::Timestamp(beginticks));
+    stmt->setLong(7, endticks);
+    stmt->setTimestamp(8, odbc::Timestamp(endticks));
+    stmt->setString(9, filelist);
+    stmt->setString(10, cvstag);
+    stmt->setInt(11, RunNumber());
+    stmt->executeUpdate();
+  }
+  catch (odbc::SQLException &e)
+  {
+    std::cout << PHWHERE << " exception caught: " << e.getMessage() << std::endl;
+    std::cout << "cmd: " << cmd.str() << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//---------------------------------------------------------------------
+
+void OnCalServer::recordCalibratorsInDB(const std::vector<OnCal *> &calibrators, const std::string &filelist)
+{
+  if (!DBconnection)
+  {
+    connectDB();
+  }
+
+  // one transaction for all calibrators, one round trip for the commit
+  bool success = true;
+  try
+  {
+    DBconnection->setAutoCommit(false);
+    for (OnCal *calibrator : calibrators)
+    {
+      success = success && recordCalibratorStatus(calibrator, filelist);
+    }
+    if (success)
+    {
+      DBconnection->commit();
+    }
+    else
+    {
+      DBconnection->rollback();
+    }
+    DBconnection->setAutoCommit(true);
+  }
+  catch (odbc::SQLException &e)
+  {
+    std::cout << PHWHERE << " exception caught: " << e.getMessage() << std::endl;
+    success = false;
+    DisconnectDB();
+    connectDB();
+  }
+  if (success)
+  {
+    return;
+  }
+
+  // a failed statement aborts the transaction, record what can be recorded
+  std::cout << PHWHERE << " transaction failed, updating calibrators one by one" << std::endl;
+  for (OnCal *calibrator : calibrators)
+  {
+    recordCalibratorStatus(calibrator, filelist);
+  }
+}
+
+//---------------------------------------------------------------------
+
 int OnCalServer::check_create_subsystable(const std::string &tablename)
 {
   if (!connectDB())
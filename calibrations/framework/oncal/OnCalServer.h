@@ -110,6 +110,17 @@ class OnCalServer : public Fun4AllServer
                 const int runno, const bool append = false);
   int updateDB(const std::string &table, const std::string &column, const time_t ticks);
 
+  // set column of all runs in runlist in the success table with one prepared statement
+  bool updateDBRunList(const std::string &column, const int value);
+
+  // write the end of job status of a calibrator (success table and its OnCal table),
+  // the OnCal table row is updated with a single statement
+  bool recordCalibratorStatus(OnCal *calibrator, const std::string &filelist);
+
+  // record the status of all calibrators in one transaction, falls back to
+  // single statements if the transaction fails
+  void recordCalibratorsInDB(const std::vector<OnCal *> &calibrators, const std::string &filelist);
+
   int check_create_subsystable(const std::string &DBTable);
   int check_create_successtable(const std::string &DBTable);
   int add_calibrator_to_statustable(const std::string &calibname);
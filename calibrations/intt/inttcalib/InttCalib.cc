@@ -9,6 +9,7 @@
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNodeIterator.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 
 #include <TCanvas.h>
@@ -26,11 +27,28 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <limits>
 
+namespace
+{
+  // fill count entries at x without looping over Fill, the errors are the
+  // same as for count unit weight fills, the statistics are recomputed from
+  // the bins by ResetStats once the histogram is filled
+  void fill_counts(TH1D *hist, double x, int count)
+  {
+    const int bin = hist->FindBin(x);
+    hist->AddBinContent(bin, count);
+    if (hist->GetSumw2N())
+    {
+      hist->GetSumw2()->AddAt(hist->GetSumw2()->At(bin) + count, bin);
+    }
+  }
+}  // namespace
+
 InttCalib::InttCalib(const std::string &name)
   : SubsysReco(name)
 {
@@ -63,12 +81,17 @@ InttCalib::~InttCalib()
 int InttCalib::InitRun(PHCompositeNode * /*unused*/)
 {
   m_evts = 0;
-  for (InttMap::RawData_s raw = InttMap::RawDataBegin;
-       raw != InttMap::RawDataEnd; ++raw)
+  m_hitmap.assign(static_cast<size_t>(m_NUM_CHANNELS) * m_NUM_BCO_BINS, 0);
+  m_hitrate.assign(static_cast<size_t>(m_NUM_CHANNELS), 0.);
+  m_hitrates_loaded = false;
+
+  m_threadpool.reset();
+  if (m_nthreads != 1)
   {
-    for (int bco = 0; bco < 129; ++bco)
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity())
     {
-      m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][bco] = 0;
+      std::cout << "InttCalib::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
     }
   }
 
@@ -177,11 +200,12 @@ int InttCalib::process_event(PHCompositeNode *top_node)
       bco_diff = -999;
     }
 
-    if (bco_diff > -1)
+    uint32_t *counts = GetHitCounts(raw);
+    if (bco_diff > -1 && bco_diff < 128)
     {
-      ++m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][bco_diff];
+      ++counts[bco_diff];
     }
-    ++m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128];
+    ++counts[128];
   }
 
   ++m_evts;
@@ -210,6 +234,7 @@ int InttCalib::EndRun(int const run_number)
   }
 
   m_run_num = run_number;
+  ComputeHitrates();
   if(m_do_fee)
   {
    ConfigureHotMap_fee();
@@ -242,18 +267,7 @@ int InttCalib::ConfigureHotMap_fee()
     title[i] = name[i];
   }
 
-  for (InttMap::RawData_s raw = InttMap::RawDataBegin;
-       raw != InttMap::RawDataEnd; ++raw)
-  {
-    double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
-    InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
-
-    int index = GetFeeIndex(raw, ofl);
-    adjust_hitrate(ofl, hitrate);
-
-    ++hitrate_pdf[index][hitrate];
-  }
+  FillHitratePdfs(hitrate_pdf, true);
   std::vector<double> middle_keys(m_MAX_LADDER);
   for (int i = 0; i < m_MAX_LADDER; ++i)
   {
@@ -300,18 +314,7 @@ int InttCalib::ConfigureHotMap_v3()
     title[i] = name[i];
   }
 
-  for (InttMap::RawData_s raw = InttMap::RawDataBegin;
-       raw != InttMap::RawDataEnd; ++raw)
-  {
-    double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
-    InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
-
-    int index = GetIndex(raw, ofl);
-    adjust_hitrate(ofl, hitrate);
-
-    ++hitrate_pdf[index][hitrate];
-  }
+  FillHitratePdfs(hitrate_pdf, false);
   std::vector<double> middle_keys(8);
   for (int i = 0; i < m_MAX_INDEX; ++i)
   {
@@ -387,7 +390,7 @@ int InttCalib::ConfigureHotMap_v2()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetIndex(raw, ofl);
@@ -428,7 +431,7 @@ int InttCalib::MakeHotMapCdb_fee()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetFeeIndex(raw, ofl);
@@ -511,7 +514,7 @@ int InttCalib::MakeHotMapCdb_v3()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetIndex(raw, ofl);
@@ -596,7 +599,7 @@ int InttCalib::MakeHotMapCdb_v2()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetIndex(raw, ofl);
@@ -660,7 +663,7 @@ int InttCalib::MakeHotMapPng_v3()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetIndex(raw, ofl);
@@ -929,7 +932,7 @@ int InttCalib::MakeHotMapPng_v2()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
 
     int index = GetIndex(raw, ofl);
@@ -997,7 +1000,7 @@ int InttCalib::ConfigureHotMap()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl;
     if (m_feemap.Convert(ofl, raw))
     {
@@ -1168,7 +1171,7 @@ int InttCalib::MakeHotMapPng()
        raw != InttMap::RawDataEnd; ++raw)
   {
     double hitrate =
-        m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+        GetHitrate(raw);
     InttMap::Offline_s ofl;
     if (m_feemap.Convert(ofl, raw))
     {
@@ -1282,19 +1285,13 @@ int InttCalib::MakeHotMapPng()
 int InttCalib::ConfigureBcoMap()
 {
   m_bcorates.clear();
-  for (InttMap::RawData_s raw{.pid = InttMap::RawDataBegin.pid,
-                          .fee = InttMap::RawDataBegin.fee};
-       raw != InttMap::RawDataEnd; ++raw)
+  for (InttMap::RawData_s fee_raw{.pid = InttMap::RawDataBegin.pid,
+                              .fee = InttMap::RawDataBegin.fee};
+       fee_raw != InttMap::RawDataEnd; ++fee_raw)
   {
-    for (auto &bco_count : m_bcorates[raw])
-    {
-      bco_count = 0;
-    }
-  }
+    // the rates are summed in a local array, one map lookup per fee
+    int bco_sum[128] = {0};
 
-  for (InttMap::RawData_s raw = InttMap::RawDataBegin;
-       raw != InttMap::RawDataEnd; ++raw)
-  {
     // Find chip with highest total hits for this pid/fee across all channels
     int chp_most = 0;
     int max_hits = 0;
@@ -1304,7 +1301,7 @@ int InttCalib::ConfigureBcoMap()
       // Sum hits across all channels for this chip
       for (int chan = 0; chan < 128; chan++)
       {
-        chip_total += m_hitmap[raw.pid - 3001][raw.fee][chp][chan][128];
+        chip_total += GetHitCounts({.pid = fee_raw.pid, .fee = fee_raw.fee, .chp = chp, .chn = chan})[128];
       }
       if (chip_total > max_hits)
       {
@@ -1314,14 +1311,23 @@ int InttCalib::ConfigureBcoMap()
     }
 
     // Only add hits if not from the chip with most hits
-    if (raw.chp != chp_most)
+    for (int chp = 0; chp < 26; chp++)
     {
-      for (int bco = 0; bco < 128; ++bco)
+      if (chp == chp_most)
       {
-        m_bcorates[raw][bco] +=
-            m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][bco];
+        continue;
+      }
+      for (int chan = 0; chan < 128; chan++)
+      {
+        uint32_t const *counts = GetHitCounts({.pid = fee_raw.pid, .fee = fee_raw.fee, .chp = chp, .chn = chan});
+        for (int bco = 0; bco < 128; ++bco)
+        {
+          bco_sum[bco] += counts[bco];
+        }
       }
     }
+
+    std::copy(bco_sum, bco_sum + 128, m_bcorates[fee_raw]);
   }
 
   m_bcopeaks.clear();
@@ -1618,8 +1624,55 @@ void InttCalib::Debug()
   MakeHotMapPng_v2();
 }
 
+void InttCalib::ComputeHitrates()
+{
+  // rates given by LoadHitrates are kept
+  if (m_hitrates_loaded)
+  {
+    return;
+  }
+  const double nevts = (m_evts > 0) ? m_evts : 1.;
+  for (size_t channel = 0; channel < m_hitrate.size(); ++channel)
+  {
+    m_hitrate[channel] = m_hitmap[channel * m_NUM_BCO_BINS + 128] / nevts;
+  }
+}
+
+void InttCalib::FillHitratePdfs(std::map<double, int> *hitrate_pdf, bool by_fee) const
+{
+  // all indices of a felix server are filled by the same task
+  auto fill_server = [this, hitrate_pdf, by_fee](size_t server)
+  {
+    for (InttMap::RawData_s raw{.pid = static_cast<int>(server) + 3001, .fee = 0, .chp = 0, .chn = 0};
+         raw.pid == static_cast<int>(server) + 3001 && raw != InttMap::RawDataEnd; ++raw)
+    {
+      double hitrate = GetHitrate(raw);
+      InttMap::Offline_s ofl = m_feemap.ToOffline(raw);
+
+      int index = by_fee ? GetFeeIndex(raw, ofl) : GetIndex(raw, ofl);
+      adjust_hitrate(ofl, hitrate);
+
+      ++hitrate_pdf[index][hitrate];
+    }
+  };
+
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(8, fill_server);
+  }
+  else
+  {
+    for (size_t server = 0; server < 8; ++server)
+    {
+      fill_server(server);
+    }
+  }
+}
+
 int InttCalib::SaveHitrates()
 {
+  ComputeHitrates();
+
   TFile *file = TFile::Open(m_hotmap_png_file.c_str(), "RECREATE");
   if (!file)
   {
@@ -1643,7 +1696,7 @@ int InttCalib::SaveHitrates()
 
   for (raw = InttMap::RawDataBegin; raw != InttMap::RawDataEnd; ++raw)
   {
-    hitrate = m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] / m_evts;
+    hitrate = GetHitrate(raw);
     tree->Fill();
   }
 
@@ -1686,10 +1739,11 @@ int InttCalib::LoadHitrates()
   for (Int_t n = 0, N = tree->GetEntriesFast(); n < N; ++n)
   {
     tree->GetEntry(n);
-    m_hitmap[raw.pid - 3001][raw.fee][raw.chp][raw.chn][128] = hitrate;
+    m_hitrate[GetChannelIndex(raw)] = hitrate;
   }
 
   m_evts = 1.0;
+  m_hitrates_loaded = true;
 
   return 0;
 }
@@ -1723,15 +1777,14 @@ int InttCalib::ConfigureHist_v3(TH1D *&hist, TF1 *&fit, double maxbin,
 
   for (auto const &[hitrate, count] : hitrate_map)
   {
-    for (int i = 0; i < count; ++i)
+    fill_counts(hist, hitrate, count);
+    if (hitrate / global_middle > 0.7)
     {
-      hist->Fill(hitrate);
-      if (hitrate / global_middle > 0.7)
-      {
-        fit_hist->Fill(hitrate);
-      }
+      fill_counts(fit_hist, hitrate, count);
     }
   }
+  hist->ResetStats();
+  fit_hist->ResetStats();
 
   delete fit;
   fit = new TF1(                //
@@ -1780,11 +1833,9 @@ int InttCalib::ConfigureHist_v2(TH1D *&hist, TF1 *&fit,
 
   for (auto const &[hitrate, count] : hitrate_map)
   {
-    for (int i = 0; i < count; ++i)
-    {
-      hist->Fill(hitrate);
-    }
+    fill_counts(hist, hitrate, count);
   }
+  hist->ResetStats();
 
   delete fit;
 
@@ -1907,11 +1958,9 @@ int InttCalib::ConfigureHist(TH1D *&hist, TF1 *&fit,
 
   for (auto const &[hitrate, count] : hitrate_map)
   {
-    for (int i = 0; i < count; ++i)
-    {
-      hist->Fill(hitrate);
-    }
+    fill_counts(hist, hitrate, count);
   }
+  hist->ResetStats();
 
   delete fit;
   fit = new TF1(                                    //
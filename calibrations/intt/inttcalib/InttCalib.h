@@ -10,11 +10,15 @@
 #include <RtypesCore.h>
 
 #include <array>
+#include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
 class TF1;
 class TH1D;
 class TH2D;
@@ -41,6 +45,8 @@ class InttCalib : public SubsysReco
   void SetBcoMaximumEvent(int mext) {m_evts_bco = mext; }
   void SetRunNumber(int runnum) { m_run_num = runnum; }
   void SetDoFeebyFee(bool in) {m_do_fee = in;}
+  /// threads used to build the per ladder hit rate distributions, 0 uses all cores
+  void setNumThreads(unsigned int n) { m_nthreads = n; }
   int SaveHitrates();
   int LoadHitrates();
 
@@ -71,6 +77,20 @@ class InttCalib : public SubsysReco
   int adjust_hitrate(InttMap::Offline_s const&, double&) const;
   int GetIndex(InttMap::RawData_s const&, InttMap::Offline_s const&) const;
   int GetFeeIndex(InttMap::RawData_s const&, InttMap::Offline_s const&) const;
+
+  /// flat index of a channel, in the order of the InttMap::RawData_s iteration
+  static int GetChannelIndex(InttMap::RawData_s const& raw)
+  {
+    return (((raw.pid - 3001) * 14 + raw.fee) * 26 + raw.chp) * 128 + raw.chn;
+  }
+  /// hit counts of a channel, bco offsets 0-127 then the total
+  uint32_t* GetHitCounts(InttMap::RawData_s const& raw) { return m_hitmap.data() + GetChannelIndex(raw) * m_NUM_BCO_BINS; }
+  uint32_t const* GetHitCounts(InttMap::RawData_s const& raw) const { return m_hitmap.data() + GetChannelIndex(raw) * m_NUM_BCO_BINS; }
+  /// hits per event of a channel, set by ComputeHitrates or LoadHitrates
+  double GetHitrate(InttMap::RawData_s const& raw) const { return m_hitrate[GetChannelIndex(raw)]; }
+  void ComputeHitrates();
+  /// adjusted hit rate distribution of each index, one felix server per task
+  void FillHitratePdfs(std::map<double, int>* hitrate_pdf, bool by_fee) const;
   void SetColdSigmaCut(double in) {m_NUM_SIGMA_COLD = in;}
   void SetHotSigmaCut(double in) {m_NUM_SIGMA_HOT = in;}
   // For Fee by Fee
@@ -111,8 +131,12 @@ class InttCalib : public SubsysReco
   InttFeeMapv1 m_feemap;
   InttSurveyMapv1 m_survey;
   Eigen::Vector3d m_vertex{0.0, 0.0, 0.0};
-  // int m_hitmap[8][14][26][128][129]
-  std::array<std::array<std::array<std::array<std::array<double, 129>, 128>, 26>, 14>, 8> m_hitmap{};
+  // hit counts [8][14][26][128][129], the last bin is the total of the channel
+  int static const m_NUM_BCO_BINS = 129;
+  std::vector<uint32_t> m_hitmap;
+  // hits per event of each channel
+  std::vector<double> m_hitrate;
+  bool m_hitrates_loaded = false;
   std::array<std::array<std::array<int, 26>, 14>, 8> m_hitmap_half{};
   
 // TH1D* m_hist[8][14]
@@ -140,6 +164,9 @@ class InttCalib : public SubsysReco
   bool m_ppmode = true;
   bool m_do_make_bco = true;
   bool m_do_fee = false;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif  // INTTCALIB_H
@@ -7,6 +7,7 @@
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
 #include <phool/PHObject.h>        // for PHObject
 #include <phool/recoConsts.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -17,8 +18,10 @@
 #include <TFile.h>
 #include <TTree.h>
 
+#include <algorithm>
 #include <memory>
 #include <cassert>
+#include <cmath>
 #include <iostream>
 
 /*************************************************************/
@@ -27,30 +30,89 @@
 /*        rosstom@ucla.edu,aditya55@physics.ucla.edu         */
 /*************************************************************/
 
-TPCPedestalCalibration::TPCPedestalCalibration(const std::string &name)
- :SubsysReco("TPCPedestalCalibration")
- , m_fname(name)
- , m_writeToCDB(false)
+TPCPedestalCalibration::ChannelStats::ChannelStats()
+  : counts(kNFees * kNChannels, 0)
+  , mean(kNFees * kNChannels, 0)
+  , m2(kNFees * kNChannels, 0)
+  , alive(kNFees * kNChannels, 1)
 {
   // reserve memory for max ADC samples
-  m_adcSamples.resize(1024, 0);
-  for(int fee_no=0;fee_no<26;fee_no++)
+  adcSamples.resize(1024, 0);
+}
+
+void TPCPedestalCalibration::ChannelStats::add(int index, const uint16_t *adcs, int nsamples)
+{
+  // integer sums are exact and vectorize, the waveform is then merged
+  // into the running statistics of the channel in one step
+  uint64_t sum = 0;
+  uint64_t sumsq = 0;
+  unsigned int nzero = 0;
+  for (int s = 0; s < nsamples; s++)
   {
-    for(int channel_no=0;channel_no<256;channel_no++)
+    const uint64_t adc = adcs[s];
+    sum += adc;
+    sumsq += adc * adc;
+    nzero += (adc == 0);
+  }
+  if (nzero)
+  {
+    alive[index] = 0;
+  }
+
+  const uint64_t n = nsamples;
+  const double wf_mean = double(sum) / n;
+  const double wf_m2 = double(n * sumsq - sum * sum) / n;
+
+  const uint64_t total = counts[index] + n;
+  const double delta = wf_mean - mean[index];
+  mean[index] += delta * n / total;
+  m2[index] += wf_m2 + delta * delta * double(counts[index]) * n / total;
+  counts[index] = total;
+}
+
+void TPCPedestalCalibration::ChannelStats::merge(const ChannelStats &other)
+{
+  for (int index = 0; index < kNFees * kNChannels; index++)
+  {
+    alive[index] = std::min(alive[index], other.alive[index]);
+    if (other.counts[index] == 0)
     {
-      m_aveADCFeeChannel[fee_no][channel_no]=0.0;
-      m_stdADCFeeChannel[fee_no][channel_no]=0.0;
-      m_countsADCFeeChannel[fee_no][channel_no]=0.0;
-      m_aliveArrayFeeChannel[fee_no][channel_no]=1;
+      continue;
     }
+    const uint64_t total = counts[index] + other.counts[index];
+    const double delta = other.mean[index] - mean[index];
+    mean[index] += delta * other.counts[index] / total;
+    m2[index] += other.m2[index] + delta * delta * double(counts[index]) * other.counts[index] / total;
+    counts[index] = total;
   }
+}
 
+TPCPedestalCalibration::TPCPedestalCalibration(const std::string &name)
+ :SubsysReco("TPCPedestalCalibration")
+ , m_fname(name)
+ , m_writeToCDB(false)
+{
 }
 
+TPCPedestalCalibration::~TPCPedestalCalibration() = default;
+
 int TPCPedestalCalibration::InitRun(PHCompositeNode * /*unused*/)
 {
   m_cdbttree = new CDBTTree(m_fname);  
 
+  // one set of statistics per packet, so packets can be decoded in parallel
+  m_stats.assign(m_packets.size(), ChannelStats());
+
+  m_threadpool.reset();
+  if (m_nthreads != 1 && m_packets.size() > 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity())
+    {
+      std::cout << "TPCPedestalCalibration::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -68,6 +130,9 @@ int TPCPedestalCalibration::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::DISCARDEVENT;
   }
 
+  // packets are extracted serially, only the decoding runs in parallel
+  std::vector<std::unique_ptr<Packet>> packets;
+  packets.reserve(m_packets.size());
   for (int packet : m_packets)
   {
     if (Verbosity())
@@ -75,109 +140,140 @@ int TPCPedestalCalibration::process_event(PHCompositeNode *topNode)
       std::cout << __PRETTY_FUNCTION__ << " : decoding packet " << packet << std::endl;
     }
 
-    m_packet = packet;
-
-    std::unique_ptr<Packet> p (_event->getPacket(m_packet));
-    if (!p)
+    packets.emplace_back(_event->getPacket(packet));
+    if (!packets.back())
     {
       if (Verbosity())
       {
         std::cout << __PRETTY_FUNCTION__ << " : missing packet " << packet << std::endl;
       }
+    }
+  }
 
-      continue;
+  auto process = [this, &packets](size_t i)
+  {
+    m_stats[i].hasBCO = false;
+    if (packets[i])
+    {
+      ProcessPacket(packets[i].get(), m_stats[i]);
     }
+  };
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(packets.size(), process);
+  }
+  else
+  {
+    for (size_t i = 0; i < packets.size(); i++)
+    {
+      process(i);
+    }
+  }
 
-    m_nWaveormInFrame = p->iValue(0, "NR_WF");
-  
-    for (int wf = 0; wf < m_nWaveormInFrame; wf++)
+  // BCO of the first waveform of the first packet
+  if (m_firstBCO == true)
+  {
+    for (const auto &stats : m_stats)
     {
-      if (m_firstBCO == true)
+      if (stats.hasBCO)
       {
-        m_BCO = p->iValue(wf, "BCO");
+        m_BCO = stats.eventBCO;
         m_firstBCO = false;
+        break;
       }
+    }
+  }
 
-      m_nSamples = p->iValue(wf, "SAMPLES");
-      m_fee = p->iValue(wf, "FEE");
-      m_Channel = p->iValue(wf, "CHANNEL");
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-      if(m_nSamples==0)
-      {
-        m_aliveArrayFeeChannel[m_fee][m_Channel]=0;
-        continue;
-      }
+void TPCPedestalCalibration::ProcessPacket(Packet *p, ChannelStats &stats) const
+{
+  const int nWaveformInFrame = p->iValue(0, "NR_WF");
 
-      assert(m_nSamples < (int) m_adcSamples.size());  // no need for movements in memory allocation
-      for (int s = 0; s < m_nSamples; s++)
-      {
-        m_adcSamples[s] = p->iValue(wf, s);
-      }
+  for (int wf = 0; wf < nWaveformInFrame; wf++)
+  {
+    if (!stats.hasBCO)
+    {
+      stats.eventBCO = p->iValue(wf, "BCO");
+      stats.hasBCO = true;
+    }
 
-      bool dead = false;
-      for(int adc_sam_no=0;adc_sam_no<m_nSamples;adc_sam_no++)
+    const int nSamples = p->iValue(wf, "SAMPLES");
+    const int fee = p->iValue(wf, "FEE");
+    const int channel = p->iValue(wf, "CHANNEL");
+    if (fee < 0 || fee >= kNFees || channel < 0 || channel >= kNChannels)
+    {
+      if (Verbosity())
       {
-        if (m_adcSamples[adc_sam_no] == 0 || std::isnan(float(m_adcSamples[adc_sam_no])))
-        {
-          m_aliveArrayFeeChannel[m_fee][m_Channel]=0;
-        }
+        std::cout << __PRETTY_FUNCTION__ << " : invalid fee " << fee << " channel " << channel << std::endl;
       }
-      if (dead) {continue;}
+      continue;
+    }
+    const int index = fee * kNChannels + channel;
 
-      for(int adc_sam_no=0;adc_sam_no<m_nSamples;adc_sam_no++){
-        m_aveADCFeeChannel[m_fee][m_Channel]+=m_adcSamples[adc_sam_no];
-        m_stdADCFeeChannel[m_fee][m_Channel]+=pow(m_adcSamples[adc_sam_no],2);
-        m_countsADCFeeChannel[m_fee][m_Channel]+=1.0;
-      }
+    if (nSamples == 0)
+    {
+      stats.alive[index] = 0;
+      continue;
     }
-  }  //   for (int packet : m_packets)
 
-  return Fun4AllReturnCodes::EVENT_OK;
+    assert(nSamples < (int) stats.adcSamples.size());  // no need for movements in memory allocation
+    for (int s = 0; s < nSamples; s++)
+    {
+      stats.adcSamples[s] = p->iValue(wf, s);
+    }
+    stats.add(index, stats.adcSamples.data(), nSamples);
+  }
 }
 
 int TPCPedestalCalibration::EndRun(const int runnumber)
 {
   std::cout << "TPCPedestalCalibration::EndRun(const int runnumber) Ending Run for Run " << runnumber << std::endl;
  
-  for(int fee_no=0;fee_no<26;fee_no++)
+  // combine the packets in a fixed order
+  ChannelStats total;
+  for (const auto &stats : m_stats)
   {
-    for(int channel_no=0;channel_no<256;channel_no++)
+    total.merge(stats);
+  }
+
+  for(int fee_no=0;fee_no<kNFees;fee_no++)
+  {
+    for(int channel_no=0;channel_no<kNChannels;channel_no++)
     {
-      if(m_countsADCFeeChannel[fee_no][channel_no] != 0.0)
+      const int index = fee_no*kNChannels + channel_no;
+      m_isAlive = total.alive[index];
+      if(total.counts[index] != 0)
       {
-        float temp1 = m_aveADCFeeChannel[fee_no][channel_no]/m_countsADCFeeChannel[fee_no][channel_no];
-        float temp2 = m_stdADCFeeChannel[fee_no][channel_no]/m_countsADCFeeChannel[fee_no][channel_no];
-        m_aveADCFeeChannel[fee_no][channel_no] = temp1;
-        m_stdADCFeeChannel[fee_no][channel_no] = temp2;
+        m_pedMean = total.mean[index];
+        m_pedStd = std::sqrt(total.m2[index]/total.counts[index]);
       }
       else
       {
-        m_aveADCFeeChannel[fee_no][channel_no] = 0.0;
-        m_stdADCFeeChannel[fee_no][channel_no] = 0.0;
-        m_aliveArrayFeeChannel[fee_no][channel_no]=0;
+        m_pedMean = 0.0;
+        m_pedStd = 0.0;
+        m_isAlive = 0;
       }
 
-      if(m_aveADCFeeChannel[fee_no][channel_no] > 200 || m_aveADCFeeChannel[fee_no][channel_no] < 10)
+      if(m_pedMean > 200 || m_pedMean < 10)
       {
-        m_aliveArrayFeeChannel[fee_no][channel_no]=0;
+        m_isAlive = 0;
       }
-      
-      m_pedMean=m_aveADCFeeChannel[fee_no][channel_no];
-      m_pedStd=sqrt(m_stdADCFeeChannel[fee_no][channel_no] - pow(m_aveADCFeeChannel[fee_no][channel_no],2));
-      m_isAlive=m_aliveArrayFeeChannel[fee_no][channel_no];
+
       m_chan=channel_no;
       m_outFEE=fee_no;
       m_module=mod_arr[fee_no];
       m_slot=slot_arr[fee_no];
       
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"isAlive",m_isAlive);
-      m_cdbttree->SetFloatValue(fee_no*256 + channel_no,"pedMean",m_pedMean);
-      m_cdbttree->SetFloatValue(fee_no*256 + channel_no,"pedStd",m_pedStd);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"sector",m_sector);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"fee",m_outFEE);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"channel",m_chan);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"module",m_module);
-      m_cdbttree->SetIntValue(fee_no*256 + channel_no,"slot",m_slot);
+      m_cdbttree->SetIntValue(index,"isAlive",m_isAlive);
+      m_cdbttree->SetFloatValue(index,"pedMean",m_pedMean);
+      m_cdbttree->SetFloatValue(index,"pedStd",m_pedStd);
+      m_cdbttree->SetIntValue(index,"sector",m_sector);
+      m_cdbttree->SetIntValue(index,"fee",m_outFEE);
+      m_cdbttree->SetIntValue(index,"channel",m_chan);
+      m_cdbttree->SetIntValue(index,"module",m_module);
+      m_cdbttree->SetIntValue(index,"slot",m_slot);
     }
   }
   
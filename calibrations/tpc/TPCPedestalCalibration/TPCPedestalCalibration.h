@@ -7,10 +7,14 @@
 #include <cdbobjects/CDBTTree.h>
 #include <sphenixnpc/CDBUtils.h>
 
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+class Packet;
 class PHCompositeNode;
+class PHThreadPool;
 class TFile;
 class TTree;
 
@@ -19,7 +23,7 @@ class TPCPedestalCalibration : public SubsysReco
  public:
   explicit TPCPedestalCalibration(const std::string &name = "TPCPedestalCalibration.root");
 
-  ~TPCPedestalCalibration() override {}
+  ~TPCPedestalCalibration() override;
 
   int InitRun(PHCompositeNode *topNode) override;
 
@@ -41,6 +45,12 @@ class TPCPedestalCalibration : public SubsysReco
     m_sector = sectorNum;
   }
 
+  //! number of threads decoding the packets of an event, 0 uses all cores
+  void setNumThreads(unsigned int n)
+  {
+    m_nthreads = n;
+  }
+
   void InsertCDBTTree(const std::string &username) // username for CDB record of who uploaded the file
   {
     m_writeToCDB = true;
@@ -58,22 +68,48 @@ class TPCPedestalCalibration : public SubsysReco
   std::vector<int> m_packets{1001};
 
  private:
+  static constexpr int kNFees = 26;
+  static constexpr int kNChannels = 256;
+
+  //! running mean and sum of squared deviations (Welford) of all channels,
+  //! flat arrays indexed by fee * kNChannels + channel
+  struct ChannelStats
+  {
+    ChannelStats();
+
+    //! add the samples of one waveform
+    void add(int index, const uint16_t *adcs, int nsamples);
+
+    //! combine with the statistics of other samples of the same channels
+    void merge(const ChannelStats &other);
+
+    std::vector<uint64_t> counts;
+    std::vector<double> mean;
+    std::vector<double> m2;
+    std::vector<int> alive;
+
+    //! BCO of the first waveform in the current event
+    int eventBCO = 0;
+    bool hasBCO = false;
+
+    //! decoded samples of the current waveform
+    std::vector<uint16_t> adcSamples;
+  };
+
+  //! decode all waveforms of a packet
+  void ProcessPacket(Packet *p, ChannelStats &stats) const;
+
   std::string m_fname;
   bool m_writeToCDB;
   CDBTTree * m_cdbttree = nullptr;
 
   int m_BCO = 0;
-  int m_packet = 0;
-  int m_nWaveormInFrame = 0;
-  int m_nSamples = 0;
-  int m_fee = 0;
-  int m_Channel = 0;
-  std::vector<unsigned short> m_adcSamples; 
-
-  float m_aveADCFeeChannel[26][256]{};
-  float m_stdADCFeeChannel[26][256]{};
-  float m_countsADCFeeChannel[26][256]{};
-  int m_aliveArrayFeeChannel[26][256]{};
+
+  //! statistics of each packet, merged in EndRun
+  std::vector<ChannelStats> m_stats;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 
   std::string m_username = "test";
   bool m_firstBCO = true;
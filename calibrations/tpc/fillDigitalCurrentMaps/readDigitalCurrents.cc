@@ -15,6 +15,7 @@
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -24,7 +25,8 @@
 #include <TH3.h>
 
 #include <algorithm>  // for max
-#include <cmath>      // for M_PI, sin, cos
+#include <cassert>
+#include <cmath>  // for M_PI, sin, cos
 #include <fstream>
 #include <iostream>
 #include <set>
@@ -271,6 +273,15 @@ int readDigitalCurrents::InitRun(PHCompositeNode * /*topNode*/)
   //_h_modules_anode       = (TH2F*)MapsFile ->Get("h_modules_anode")      ->Clone("_h_modules_anode");
   _h_modules_measuredibf = (TH2F *) MapsFile->Get("h_modules_measuredibf")->Clone("_h_modules_measuredibf");
   //}
+
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "readDigitalCurrents::InitRun - processing hitsets with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -340,189 +351,108 @@ int readDigitalCurrents::process_event(PHCompositeNode *topNode)
     }
   }
 
+  // the ion drift of each frame is the same for all hits of the event
+  TAxis *zaxis = _h_DC_SC->GetZaxis();
+  for (int iz = 0; iz < nFrames; iz++)
+  {
+    double bX = _beamxing[iz];
+    _frame_ibf_zbin[0][iz] = -1;
+    _frame_ibf_zbin[1][iz] = -1;
+    if (_event_bunchXing <= bX)
+    {
+      double z_ibf_pos = 1.055 * m - (bX - _event_bunchXing) * 106 * vIon * ns;
+      if (z_ibf_pos > 0 && z_ibf_pos < 1.055 * m)
+      {
+        _frame_ibf_zbin[0][iz] = zaxis->FindFixBin(z_ibf_pos);
+      }
+      double z_ibf_neg = -1.055 * m + (bX - _event_bunchXing) * 106 * vIon * ns;
+      if (z_ibf_neg < 0 && z_ibf_neg > -1.055 * m)
+      {
+        _frame_ibf_zbin[1][iz] = zaxis->FindFixBin(z_ibf_neg);
+      }
+    }
+  }
+
   // loop over all the hits
   // hits are stored in hitsets, so have to get the hitset first
-  int n_hits = 0;
-  // float _event_bunchXing = 1508071;
+  _tpc_hitsets.clear();
   TrkrHitSetContainer::ConstRange all_hitsets = _hitmap->getHitSets();
   for (TrkrHitSetContainer::ConstIterator iter_hitset = all_hitsets.first; iter_hitset != all_hitsets.second; ++iter_hitset)
   {
     // checking that the object is inside TPC
     if (TrkrDefs::getTrkrId(iter_hitset->first) == TrkrDefs::tpcId)
     {
-      TrkrDefs::hitsetkey hitsetkey = iter_hitset->first;
-      const unsigned int zside = TpcDefs::getSide(hitsetkey);
-      TrkrHitSet::ConstRange range = iter_hitset->second->getHits();
       unsigned int layer = TrkrDefs::getLayer(iter_hitset->first);
-      // if(layer>6){
-      PHG4TpcCylinderGeom *layergeom_ccgc = nullptr;
-      PHG4CylinderCellGeom *layergeom_cgc = nullptr;
-      double radius = 0;
-      if (_f_ccgc == 1)
-      {
-        layergeom_ccgc = _geom_container_ccgc->GetLayerCellGeom(layer);
-        radius = layergeom_ccgc->get_radius() * cm;
-      }
-      else
+      if (_layer_bins.find(layer) == _layer_bins.end())
       {
-        layergeom_cgc = _geom_container_cgc->GetLayerCellGeom(layer);
-        radius = layergeom_cgc->get_radius() * cm;
+        BuildLayerBins(layer, _geom_container_ccgc, _geom_container_cgc);
       }
-      // PHG4TpcCylinderGeom *layergeom = _geom_container->GetLayerCellGeom(layer);
-      // double radius = layergeom->get_radius()*cm;  // returns center of the layer
-      int min_phiBin = 1e5;
-      int max_phiBin = -1;
-      for (TrkrHitSet::ConstIterator hit_iter = range.first; hit_iter != range.second; ++hit_iter)
-      {
-        // int f_fill_ibf=0;
-        int f_fill_ibf[30] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-        unsigned short phibin = TpcDefs::getPad(hit_iter->first);
-        unsigned short zbin = TpcDefs::getTBin(hit_iter->first);
-        double _drift_velocity = 8.0e-3;  // ActsGeometry::get_drift_velocity();
-        double phi_center = 0;
-        if (_f_ccgc == 1)
-        {
-          phi_center = layergeom_ccgc->get_phicenter(phibin);
-        }
-        else
-        {
-          phi_center = layergeom_cgc->get_phicenter(phibin);
-        }
-        if (phi_center < 0)
-        {
-          phi_center += 2 * M_PI;
-        }
-        if (phi_center < M_PI / 2 + M_PI / 12 && phi_center > M_PI / 2 - M_PI / 12)
-        {
-          if (min_phiBin > phibin)
-          {
-            min_phiBin = phibin;
-          }
-          if (max_phiBin < phibin)
-          {
-            max_phiBin = phibin;
-          }
-        }
-        float x = radius * cos(phi_center);
-        float y = radius * sin(phi_center);
+      _tpc_hitsets.push_back(iter_hitset);
+    }
+  }
 
-        double z = 0;  // layergeom->get_zcenter(zbin)*cm;
-        if (_f_ccgc == 1)
-        {
-          z = layergeom_ccgc->get_zcenter(zbin) * _drift_velocity * cm;  //*cm/ns;
-          if (zside == 0)
-          {
-            z = -z;
-          }
-        }
-        else
-        {
-          z = layergeom_cgc->get_zcenter(zbin) * cm;
-        }
-        TrkrHit *hit = hit_iter->second;
-        int adc = hit->getAdc() - adc_pedestal;
-        float E = hit->getEnergy();
-        // double z = 0;
-        // double z_prim = -1*1e10;
-        // double z_ibf =  -1*1e10;
-        double z_ibf[30] = {-1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                            -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                            -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10};
-
-        int RBin = _h_R->GetXaxis()->FindBin(radius);
-        if ((RBin > 33 && RBin < 50) && z > 0)
-        {
-	  assert(layergeom_ccgc);
-          int nRBins = layergeom_ccgc->get_phibins();
-          if (phibin < nRBins / 12)
-          {
-            if (_fillCSVFile)
-            {
-              myCSVFile << _evtstart << ","
-                        << layergeom_ccgc->get_zcenter(zbin) << ","
-                        << phibin << ","
-                        << RBin - 34 << ","
-                        << adc << "\n";
-            }
-            _h_hit_XY->Fill(x, y);
-          }
-        }
-        // if(!IsOverFrame(radius/mm,phi_center)){
-        for (int iz = 0; iz < nFrames; iz++)
-        {
-          double bX = _beamxing[iz];
-          if (_event_bunchXing <= bX)
-          {
-            if (z >= 0 && z < 1.055 * m)
-            {
-              z_ibf[iz] = 1.055 * m - (bX - _event_bunchXing) * 106 * vIon * ns;
-              if (z_ibf[iz] > 0 && z_ibf[iz] < 1.055 * m)
-              {
-                f_fill_ibf[iz] = 1;
-              }
-            }
-            if (z < 0 && z > -1.055 * m)
-            {
-              z_ibf[iz] = -1.055 * m + (bX - _event_bunchXing) * 106 * vIon * ns;
-              if (z_ibf[iz] < 0 && z_ibf[iz] > -1.055 * m)
-              {
-                f_fill_ibf[iz] = 1;
-              }
-            }
-          }
-        }
-        if (z >= 0 && z < 1.055 * m)
-        {
-          if (adc >= 0)
-          {
-            n_hits++;
-          }
-          if (adc >= 0)
-          {
-            _h_DC_E->Fill(adc, E);
-          }
-        }
-        if (z < 0 && z > -1.055 * m)
-        {
-          if (adc >= 0)
-          {
-            n_hits++;
-          }
-          if (adc >= 0)
-          {
-            _h_DC_E->Fill(adc, E);
-          }
-        }
+  // the bins of the hitsets are found in parallel, the histograms are filled in hitset order
+  if (_hitset_fills.size() < _tpc_hitsets.size())
+  {
+    _hitset_fills.resize(_tpc_hitsets.size());
+  }
+  auto process_hitset = [this](size_t ihitset)
+  { ProcessHitSet(_tpc_hitsets[ihitset], _hitset_fills[ihitset]); };
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(_tpc_hitsets.size(), process_hitset);
+  }
+  else
+  {
+    for (size_t ihitset = 0; ihitset < _tpc_hitsets.size(); ++ihitset)
+    {
+      process_hitset(ihitset);
+    }
+  }
 
-        // Reading IBF and Gain weights according to X-Y position
-        float w_ibf = 1.;
-        // float w_gain = 1.;
-        // if(_fUseIBFMap){
-        int bin_x = _h_modules_measuredibf->GetXaxis()->FindBin(x / mm);
-        int bin_y = _h_modules_measuredibf->GetYaxis()->FindBin(y / mm);
-        w_ibf = _h_modules_measuredibf->GetBinContent(bin_x, bin_y);
-        // w_gain = _h_modules_anode->GetBinContent(bin_x,bin_y);
-        w_ibf = 1.;
-        //}
-        float w_adc = adc * w_ibf;
-        _h_DC_SC->Fill(phi_center, radius, z, w_adc);
-        _h_DC_SC_XY->Fill(x, y, w_adc);
-        if (f_fill_ibf[0] == 1)
+  int n_hits = 0;
+  for (size_t ihitset = 0; ihitset < _tpc_hitsets.size(); ++ihitset)
+  {
+    for (const auto &fill : _hitset_fills[ihitset])
+    {
+      if (fill.fill_xy)
+      {
+        if (_fillCSVFile)
         {
-          _h_R->Fill(radius);
+          myCSVFile << _evtstart << ","
+                    << fill.zcenter << ","
+                    << fill.pad << ","
+                    << fill.rbin - 34 << ","
+                    << fill.adc << "\n";
         }
-        for (int iz = 0; iz < nFrames; iz++)
+        _h_hit_XY->Fill(fill.x, fill.y);
+      }
+      if (fill.ibf_side >= 0 && fill.adc >= 0)
+      {
+        n_hits++;
+        _h_DC_E->Fill(fill.adc, fill.E);
+      }
+
+      _h_DC_SC->AddBinContent(fill.dc_bin, fill.w_adc);
+      _dc_entries++;
+      _h_DC_SC_XY->Fill(fill.x, fill.y, fill.w_adc);
+      if (fill.ibf_side < 0)
+      {
+        continue;
+      }
+      if (_frame_ibf_zbin[fill.ibf_side][0] >= 0)
+      {
+        _h_R->Fill(fill.radius);
+      }
+      for (int iz = 0; iz < nFrames; iz++)
+      {
+        int zbin = _frame_ibf_zbin[fill.ibf_side][iz];
+        if (zbin >= 0)
         {
-          if (f_fill_ibf[iz] == 1)
-          {
-            _h_SC_ibf[iz]->Fill(phi_center, radius, z_ibf[iz], w_adc);
-          }
+          _h_SC_ibf[iz]->AddBinContent(_h_SC_ibf[iz]->GetBin(fill.phibin, fill.rbin, zbin), fill.w_adc);
+          _frame_entries[iz]++;
         }
-        //}
-        // if(n_hits%100==0) std::cout<<radius<<"|"<<phi_center<<"|"<<z<<std::endl;
       }
-      // std::cout<<" min_phiBin"<< min_phiBin <<" max_phiBin"<< max_phiBin<< std::endl;
     }
   }
 
@@ -532,6 +462,120 @@ int readDigitalCurrents::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+//____________________________________________________________________________..
+void readDigitalCurrents::BuildLayerBins(unsigned int layer, PHG4TpcCylinderGeomContainer *geom_ccgc, PHG4CylinderCellGeomContainer *geom_cgc)
+{
+  PHG4TpcCylinderGeom *layergeom_ccgc = nullptr;
+  PHG4CylinderCellGeom *layergeom_cgc = nullptr;
+  LayerBins &bins = _layer_bins[layer];
+  int ntbins = 0;
+  if (_f_ccgc == 1)
+  {
+    layergeom_ccgc = geom_ccgc->GetLayerCellGeom(layer);
+    bins.radius = layergeom_ccgc->get_radius() * cm;
+    bins.nphibins = layergeom_ccgc->get_phibins();
+    ntbins = layergeom_ccgc->get_zbins();
+  }
+  else
+  {
+    layergeom_cgc = geom_cgc->GetLayerCellGeom(layer);
+    bins.radius = layergeom_cgc->get_radius() * cm;
+    bins.nphibins = layergeom_cgc->get_phibins();
+    ntbins = layergeom_cgc->get_zbins();
+  }
+  bins.rbin = _h_DC_SC->GetYaxis()->FindFixBin(bins.radius);
+
+  for (int phibin = 0; phibin < bins.nphibins; phibin++)
+  {
+    double phi_center = (_f_ccgc == 1) ? layergeom_ccgc->get_phicenter(phibin) : layergeom_cgc->get_phicenter(phibin);
+    if (phi_center < 0)
+    {
+      phi_center += 2 * M_PI;
+    }
+    bins.phibin.push_back(_h_DC_SC->GetXaxis()->FindFixBin(phi_center));
+    bins.x.push_back(bins.radius * cos(phi_center));
+    bins.y.push_back(bins.radius * sin(phi_center));
+  }
+
+  double _drift_velocity = 8.0e-3;  // ActsGeometry::get_drift_velocity();
+  for (int zbin = 0; zbin < ntbins; zbin++)
+  {
+    double z = 0;  // layergeom->get_zcenter(zbin)*cm;
+    double zcenter = 0;
+    if (_f_ccgc == 1)
+    {
+      zcenter = layergeom_ccgc->get_zcenter(zbin);
+      z = zcenter * _drift_velocity * cm;  //*cm/ns;
+    }
+    else
+    {
+      zcenter = layergeom_cgc->get_zcenter(zbin);
+      z = zcenter * cm;
+    }
+    bins.zcenter.push_back(zcenter);
+    for (unsigned int zside = 0; zside < 2; zside++)
+    {
+      double zsigned = (_f_ccgc == 1 && zside == 0) ? -z : z;
+      bins.z[zside].push_back(zsigned);
+      bins.zbin[zside].push_back(_h_DC_SC->GetZaxis()->FindFixBin(zsigned));
+    }
+  }
+}
+
+//____________________________________________________________________________..
+void readDigitalCurrents::ProcessHitSet(TrkrHitSetContainer::ConstIterator iter_hitset, std::vector<HitFill> &fills) const
+{
+  fills.clear();
+  TrkrDefs::hitsetkey hitsetkey = iter_hitset->first;
+  const unsigned int zside = TpcDefs::getSide(hitsetkey);
+  const LayerBins &bins = _layer_bins.find(TrkrDefs::getLayer(hitsetkey))->second;
+  TrkrHitSet::ConstRange range = iter_hitset->second->getHits();
+  for (TrkrHitSet::ConstIterator hit_iter = range.first; hit_iter != range.second; ++hit_iter)
+  {
+    unsigned short phibin = TpcDefs::getPad(hit_iter->first);
+    unsigned short zbin = TpcDefs::getTBin(hit_iter->first);
+
+    HitFill fill;
+    fill.phibin = bins.phibin[phibin];
+    fill.rbin = bins.rbin;
+    fill.radius = bins.radius;
+    fill.x = bins.x[phibin];
+    fill.y = bins.y[phibin];
+    double z = bins.z[zside][zbin];
+
+    TrkrHit *hit = hit_iter->second;
+    fill.adc = hit->getAdc() - adc_pedestal;
+    fill.E = hit->getEnergy();
+
+    if ((fill.rbin > 33 && fill.rbin < 50) && z > 0)
+    {
+      assert(_f_ccgc == 1);
+      if (phibin < bins.nphibins / 12)
+      {
+        fill.fill_xy = true;
+        fill.zcenter = bins.zcenter[zbin];
+        fill.pad = phibin;
+      }
+    }
+
+    if (z >= 0 && z < 1.055 * m)
+    {
+      fill.ibf_side = 0;
+    }
+    if (z < 0 && z > -1.055 * m)
+    {
+      fill.ibf_side = 1;
+    }
+
+    // Reading IBF and Gain weights according to X-Y position
+    // the measured IBF map (_h_modules_measuredibf) is not applied, w_ibf = 1
+    float w_ibf = 1.;
+    fill.w_adc = fill.adc * w_ibf;
+    fill.dc_bin = _h_DC_SC->GetBin(fill.phibin, fill.rbin, bins.zbin[zside][zbin]);
+    fills.push_back(fill);
+  }
+}
+
 //____________________________________________________________________________..
 int readDigitalCurrents::ResetEvent(PHCompositeNode * /*topNode*/)
 {
@@ -550,6 +594,14 @@ int readDigitalCurrents::EndRun(const int runnumber)
 int readDigitalCurrents::End(PHCompositeNode * /*topNode*/)
 {
   std::cout << "readDigitalCurrents::End(PHCompositeNode *topNode) This is the End..." << std::endl;
+  // the space charge histograms are filled bin by bin, recompute their statistics
+  _h_DC_SC->ResetStats();
+  _h_DC_SC->SetEntries(_dc_entries);
+  for (int iz = 0; iz < nFrames; iz++)
+  {
+    _h_SC_ibf[iz]->ResetStats();
+    _h_SC_ibf[iz]->SetEntries(_frame_entries[iz]);
+  }
   _h_R->Sumw2(false);
   _h_hits->Sumw2(false);
   _h_DC_E->Sumw2(false);
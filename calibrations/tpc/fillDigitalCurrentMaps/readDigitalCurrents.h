@@ -5,13 +5,19 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrHitSetContainer.h>
+
 #include <fstream>
 #include <map>
+#include <memory>  // for unique_ptr
 #include <string>
 #include <vector>
 
 class Fun4AllHistoManager;
 class PHCompositeNode;
+class PHG4CylinderCellGeomContainer;
+class PHG4TpcCylinderGeomContainer;
+class PHThreadPool;
 
 // class PHG4CylinderCellGeom;
 
@@ -67,6 +73,9 @@ class readDigitalCurrents : public SubsysReco
   void SetIBF(double ampIBFfrac = 0.004);
   void SetCCGC(double f_ccgc = 0);
 
+  //! number of threads processing the TPC hitsets (1: no threads, 0: all cores)
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   // double pi = 3.14159265358979323846;//2 * acos(0.0);
 
  protected:
@@ -102,6 +111,58 @@ class readDigitalCurrents : public SubsysReco
   float _event_timestamp{0};
   float _event_bunchXing{0};
 
+  //! histogram bins of the pads and time bins of one layer, they depend only on the geometry
+  struct LayerBins
+  {
+    double radius{0};
+    int rbin{0};
+    int nphibins{0};
+    std::vector<int> phibin;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<double> zcenter;
+    // z and its bin per side and time bin
+    std::vector<double> z[2];
+    std::vector<int> zbin[2];
+  };
+
+  //! what one TPC hit fills, the ibf frames filled follow from its side
+  struct HitFill
+  {
+    int phibin{0};
+    int rbin{0};
+    int dc_bin{0};
+    // 0: z in [0, 1.055 m), 1: z in (-1.055 m, 0), -1: neither
+    int ibf_side{-1};
+    double radius{0};
+    int adc{0};
+    float E{0};
+    float w_adc{0};
+    float x{0};
+    float y{0};
+    bool fill_xy{false};
+    // csv record
+    double zcenter{0};
+    unsigned short pad{0};
+  };
+
+  void BuildLayerBins(unsigned int layer, PHG4TpcCylinderGeomContainer *geom_ccgc, PHG4CylinderCellGeomContainer *geom_cgc);
+
+  //! compute the fills of the hits of one hitset, reads only so hitsets can run in parallel
+  void ProcessHitSet(TrkrHitSetContainer::ConstIterator iter_hitset, std::vector<HitFill> &fills) const;
+
+  std::map<unsigned int, LayerBins> _layer_bins;
+  // z bin of the ibf ions of each frame per side for the current event, -1 if not filled
+  int _frame_ibf_zbin[2][nFrames]{};
+  // number of fills of each frame
+  double _frame_entries[nFrames]{};
+  double _dc_entries{0};
+
+  unsigned int m_nthreads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  std::vector<TrkrHitSetContainer::ConstIterator> _tpc_hitsets;
+  std::vector<std::vector<HitFill>> _hitset_fills;
+
   // double pi = 2 * acos(0.0);
   double adc_pedestal{0.};  // 74.4;
   double cm{1e1};
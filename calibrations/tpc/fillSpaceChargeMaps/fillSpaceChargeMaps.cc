@@ -10,6 +10,7 @@
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 
 #include <TAxis.h>  // for TAxis
@@ -27,6 +28,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>  // for pair
@@ -200,6 +202,21 @@ int fillSpaceChargeMaps::InitRun(PHCompositeNode * /*topNode*/)
   _xingRate = 9.383 * MHz;
   _mean = mbRate / xingRate;
   // padplane->CreateReadoutGeometry( PHCompositeNode *, seggeo);
+
+  // the distortion maps are read once, not per event
+  if (_shiftElectrons == 1 && !_shifter)
+  {
+    _shifter = std::make_unique<Shifter>("/sphenix/user/rcorliss/distortion_maps/2021.04/apr07.average.real_B1.4_E-400.0.ross_phi1_sphenix_phislice_lookup_r26xp40xz40.distortion_map.hist.root");
+  }
+
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "fillSpaceChargeMaps::InitRun - processing hits with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
   return 0;
 }
 
@@ -236,220 +253,96 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
   }
   _evtstart++;
 
-  Shifter shifter("/sphenix/user/rcorliss/distortion_maps/2021.04/apr07.average.real_B1.4_E-400.0.ross_phi1_sphenix_phislice_lookup_r26xp40xz40.distortion_map.hist.root");
+  // the ion drift of each frame is the same for all hits of the event
+  TAxis *zaxis = _h_SC_ibf[0]->GetZaxis();
+  for (int iz = 0; iz < nFrames; iz++)
+  {
+    double bX = _beamxing[iz];
+    _frame_active[iz] = (_event_bunchXing <= bX);
+    _frame_dz[iz] = (_fAvg == 1) ? z_bias_avg : (bX - _event_bunchXing) * 106 * vIon * ns;
+    double z_ibf_pos = 1.055 * m - _frame_dz[iz];
+    double z_ibf_neg = -1.055 * m + _frame_dz[iz];
+    _frame_ibf_zbin[0][iz] = (_frame_active[iz] && z_ibf_pos > 0 && z_ibf_pos < 1.055 * m) ? zaxis->FindFixBin(z_ibf_pos) : -1;
+    _frame_ibf_zbin[1][iz] = (_frame_active[iz] && z_ibf_neg < 0 && z_ibf_neg > -1.055 * m) ? zaxis->FindFixBin(z_ibf_neg) : -1;
+  }
 
   PHG4HitContainer *hits = findNode::getClass<PHG4HitContainer>(topNode, "G4HIT_TPC");
   int n_hits = 0;
   if (hits)
   {
+    _g4hits.clear();
     PHG4HitContainer::ConstRange hit_range = hits->getHits();
     for (PHG4HitContainer::ConstIterator hit_iter = hit_range.first; hit_iter != hit_range.second; hit_iter++)
     {
-      int f_fill_prim[30] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-      int f_fill_ibf[30] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
-      float hit_x0 = hit_iter->second->get_x(0);
-      float hit_y0 = hit_iter->second->get_y(0);
-      float hit_z0 = hit_iter->second->get_z(0);
-      float hit_x1 = hit_iter->second->get_x(1);
-      float hit_y1 = hit_iter->second->get_y(1);
-      float hit_z1 = hit_iter->second->get_z(1);
-
-      float hit_eion = hit_iter->second->get_eion();
-      float N_electrons = hit_eion * Tpc_ElectronsPerGeV;
-      float x = (hit_x0 + f * (hit_x1 - hit_x0)) * cm;
-      float y = (hit_y0 + f * (hit_y1 - hit_y0)) * cm;
-      float z = (hit_z0 + f * (hit_z1 - hit_z0)) * cm;
-
-      float r = sqrt(x * x + y * y);
-      float phi = atan2(x, y);
-      if (phi < 0)
-      {
-        phi += 2 * M_PI;
-      }
+      _g4hits.push_back(hit_iter->second);
+    }
 
-      // Shift electrons according to the field maps
-      TVector3 oldPos(x / cm, y / cm, z / cm);
-      TVector3 newPos;
-      if (_shiftElectrons == 1)
+    // the bins of blocks of hits are found in parallel, the histograms are filled in hit order
+    static constexpr size_t block_size = 1024;
+    const size_t nblocks = (_g4hits.size() + block_size - 1) / block_size;
+    if (_blocks.size() < nblocks)
+    {
+      _blocks.resize(nblocks);
+    }
+    auto process_block = [this](size_t iblock)
+    {
+      BlockFill &block = _blocks[iblock];
+      block.hits.clear();
+      block.bins.clear();
+      const size_t last = std::min(_g4hits.size(), (iblock + 1) * block_size);
+      for (size_t ihit = iblock * block_size; ihit < last; ++ihit)
       {
-        if (oldPos.z() < 0)
-        {
-          oldPos.SetZ(std::abs(oldPos.z()));
-          newPos = shifter.ShiftForward(oldPos);
-          newPos.SetZ(newPos.z() * -1);
-        }
-        else
-        {
-          newPos = shifter.ShiftForward(oldPos);
-        }
+        ProcessHit(_g4hits[ihit], block);
       }
-      else
+    };
+    if (m_threadpool)
+    {
+      m_threadpool->parallel_for(nblocks, process_block);
+    }
+    else
+    {
+      for (size_t iblock = 0; iblock < nblocks; ++iblock)
       {
-        newPos.SetZ(oldPos.Z());
-        newPos.SetX(oldPos.X());
-        newPos.SetY(oldPos.Y());
+        process_block(iblock);
       }
+    }
 
-      // Reading IBF and Gain weights according to X-Y position
-      float w_ibf = 1.;
-      float w_gain = 1.;
-
-      if (_fUseIBFMap)
-      {
-        int bin_x = _h_modules_anode->GetXaxis()->FindBin(x / mm);
-        int bin_y = _h_modules_anode->GetYaxis()->FindBin(y / mm);
-        w_ibf = _h_modules_measuredibf->GetBinContent(bin_x, bin_y);
-        w_gain = _h_modules_anode->GetBinContent(bin_x, bin_y);
-      }
-      float ionsPerEle = w_gain * _ampGain * w_ibf * _ampIBFfrac;
-
-      // Check that it is on the frame
-      _isOnPlane = 0;
-      double dr_bin = -1;
-      double dphi_bin = -1;
-      double new_phi = newPos.Phi();
-      double new_r = newPos.Perp() * cm;
-      if (new_phi < 0)
-      {
-        new_phi += 2 * M_PI;
-      }
-      if (!IsOverFrame(new_r, new_phi))
-      {
-        _isOnPlane = 1;
-      }
-      else
-      {
-        std::vector<double> r_phi_bin = putOnPlane(new_r / mm, new_phi);
-        dr_bin = r_phi_bin[0];
-        dphi_bin = r_phi_bin[1];
-      }
-      _hit_z = z;
-      _hit_r = r;
-      _hit_phi = phi;
-      _hit_eion = hit_eion;
-      _ibf_vol = N_electrons * ionsPerEle;
-      _amp_ele_vol = w_gain * _ampGain;
-      if (new_r < 210 || new_r > 770)
-      {
-        continue;
-      }
-      if (_fSliming == 1)
-      {
-        _rawHits->Fill();
-      }
-      double z_prim[30] = {-1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                           -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                           -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10};
-      double z_ibf[30] = {-1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                          -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10,
-                          -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10, -1 * 1e10};
-
-      if (_hit_z >= 5 * mm && _hit_z < 1.055 * m)
+    for (size_t iblock = 0; iblock < nblocks; ++iblock)
+    {
+      const BlockFill &block = _blocks[iblock];
+      auto bin_iter = block.bins.begin();
+      for (const auto &hitfill : block.hits)
       {
-        n_hits++;
-        _h_DC_E->Fill(_ibf_vol, hit_eion * 1e6);
-        for (int iz = 0; iz < 30; iz++)
+        if (_fSliming == 1)
         {
-          double bX = _beamxing[iz];
-          // double bX_end = _beamxing_end[iz];
-          if (_event_bunchXing <= bX)
-          {
-            if (_fAvg == 1)
-            {
-              z_prim[iz] = _hit_z - z_bias_avg;
-              z_ibf[iz] = 1.055 * m - z_bias_avg;
-            }
-            else
-            {
-              z_prim[iz] = _hit_z - (bX - _event_bunchXing) * 106 * vIon * ns;
-              z_ibf[iz] = 1.055 * m - (bX - _event_bunchXing) * 106 * vIon * ns;
-            }
-            if (z_prim[iz] > 0 && z_prim[iz] < 1.055 * m)
-            {
-              f_fill_prim[iz] = 1;
-            }
-            if (z_ibf[iz] > 0 && z_ibf[iz] < 1.055 * m)
-            {
-              f_fill_ibf[iz] = 1;
-            }
-          }
+          _isOnPlane = hitfill.isOnPlane;
+          _hit_z = hitfill.hit_z;
+          _hit_r = hitfill.hit_r;
+          _hit_phi = hitfill.hit_phi;
+          _hit_eion = hitfill.hit_eion;
+          _ibf_vol = hitfill.ibf_vol;
+          _amp_ele_vol = hitfill.amp_ele_vol;
+          _rawHits->Fill();
         }
-      }
-
-      if (_hit_z < -5 * mm && _hit_z > -1.055 * m)
-      {
-        n_hits++;
-        _h_DC_E->Fill(_ibf_vol, hit_eion * 1e6);
-        for (int iz = 0; iz < 30; iz++)
+        if (hitfill.in_drift)
         {
-          double bX = _beamxing[iz];
-          // double bX_end = _beamxing_end[iz];
-          if (_event_bunchXing <= bX)
-          {
-            if (_fAvg == 1)
-            {
-              z_prim[iz] = _hit_z + z_bias_avg;
-              z_ibf[iz] = -1.055 * m + z_bias_avg;
-            }
-            else
-            {
-              z_prim[iz] = _hit_z + (bX - _event_bunchXing) * 106 * vIon * ns;
-              z_ibf[iz] = -1.055 * m + (bX - _event_bunchXing) * 106 * vIon * ns;
-            }
-            if (z_prim[iz] < 0 && z_prim[iz] > -1.055 * m)
-            {
-              f_fill_prim[iz] = 1;
-            }
-            if (z_ibf[iz] < 0 && z_ibf[iz] > -1.055 * m)
-            {
-              f_fill_ibf[iz] = 1;
-            }
-          }
+          n_hits++;
+          _h_DC_E->Fill(hitfill.ibf_vol, hitfill.hit_eion * 1e6);
         }
-      }
-
-      double w_prim = _hit_eion * Tpc_ElectronsPerGeV;
-      for (int iz = 0; iz < 30; iz++)
-      {
-        if (f_fill_prim[iz] == 1)
+        for (size_t ibin = 0; ibin < hitfill.nbins; ++ibin, ++bin_iter)
         {
-          _h_SC_prim[iz]->Fill(_hit_phi, _hit_r, z_prim[iz], w_prim);
+          TH3 *h = bin_iter->ibf ? _h_SC_ibf[bin_iter->frame] : _h_SC_prim[bin_iter->frame];
+          h->AddBinContent(bin_iter->bin, bin_iter->w);
+          _frame_entries[bin_iter->ibf][bin_iter->frame]++;
         }
-        if (f_fill_ibf[iz] == 1)
+        if (hitfill.fill_xy)
         {
-          if (!_isOnPlane)
-          {
-            // Redistribute charges
-            // std::vector<double> newWeights = getNewWeights(_h_SC_ibf[iz], _h_modules_anode, _h_modules_measuredibf, _hit_r, _hit_phi, dr_bin, dphi_bin, _fUseIBFMap);
-            std::vector<double> newWeights = getNewWeights(_h_SC_ibf[iz], _h_modules_anode, _h_modules_measuredibf, new_r, new_phi, dr_bin, dphi_bin, _fUseIBFMap);
-
-            double w_ibf_tmp = newWeights[0];
-            double w_gain_tmp = newWeights[1];
-            _hit_r = newWeights[2];
-            _hit_phi = newWeights[3];
-
-            _ibf_vol = N_electrons * w_gain_tmp * _ampGain * w_ibf_tmp * _ampIBFfrac;
-            _h_SC_ibf[iz]->Fill(_hit_phi, _hit_r, z_ibf[iz], _ibf_vol);
-            if (iz == 0)
-            {
-              _h_SC_XY->Fill(_hit_r * cos(_hit_phi), _hit_r * sin(_hit_phi));  //,_ibf_vol);
-            }
-          }
-          else
-          {
-            _h_SC_ibf[iz]->Fill(new_phi, new_r, z_ibf[iz], _ibf_vol);
-            if (iz == 0)
-            {
-              _h_SC_XY->Fill(new_r * cos(new_phi), new_r * sin(new_phi));  //,_ibf_vol);
-            }
-          }
+          _h_SC_XY->Fill(hitfill.xy_x, hitfill.xy_y);  //,_ibf_vol);
+        }
+        if (hitfill.fill_r)
+        {
+          _h_R->Fill(hitfill.r_fill);
         }
-      }
-
-      if (f_fill_ibf[0] == 1)
-      {
-        _h_R->Fill(_hit_r);
       }
     }
   }
@@ -469,6 +362,14 @@ int fillSpaceChargeMaps::process_event(PHCompositeNode *topNode)
 int fillSpaceChargeMaps::End(PHCompositeNode * /*topNode*/)
 {
   std::cout << "fillSpaceChargeMaps::End" << std::endl;
+  // the frames are filled bin by bin, recompute their statistics
+  for (int iz = 0; iz < nFrames; iz++)
+  {
+    _h_SC_prim[iz]->ResetStats();
+    _h_SC_prim[iz]->SetEntries(_frame_entries[0][iz]);
+    _h_SC_ibf[iz]->ResetStats();
+    _h_SC_ibf[iz]->SetEntries(_frame_entries[1][iz]);
+  }
   if (_fSliming == 1)
   {
     outfile->cd();
@@ -561,16 +462,192 @@ void fillSpaceChargeMaps::UseFieldMaps(int shiftElectrons)
   std::cout << "Use Field-Maps is set to: " << s_shiftElectrons[_shiftElectrons] << std::endl;
 }
 
-std::vector<double> fillSpaceChargeMaps::getNewWeights(TH3 *h_SC_ibf, TH2 *h_modules_anode, TH2 *h_modules_measuredibf, double hit_r, double hit_phi, double dr_bin, double dphi_bin, bool fUseIBFMap)
+void fillSpaceChargeMaps::ProcessHit(const PHG4Hit *g4hit, BlockFill &block) const
+{
+  float hit_x0 = g4hit->get_x(0);
+  float hit_y0 = g4hit->get_y(0);
+  float hit_z0 = g4hit->get_z(0);
+  float hit_x1 = g4hit->get_x(1);
+  float hit_y1 = g4hit->get_y(1);
+  float hit_z1 = g4hit->get_z(1);
+
+  float hit_eion = g4hit->get_eion();
+  float N_electrons = hit_eion * Tpc_ElectronsPerGeV;
+  float x = (hit_x0 + f * (hit_x1 - hit_x0)) * cm;
+  float y = (hit_y0 + f * (hit_y1 - hit_y0)) * cm;
+  float z = (hit_z0 + f * (hit_z1 - hit_z0)) * cm;
+
+  float r = sqrt(x * x + y * y);
+  float phi = atan2(x, y);
+  if (phi < 0)
+  {
+    phi += 2 * M_PI;
+  }
+
+  // Shift electrons according to the field maps
+  TVector3 oldPos(x / cm, y / cm, z / cm);
+  TVector3 newPos = oldPos;
+  if (_shiftElectrons == 1)
+  {
+    if (oldPos.z() < 0)
+    {
+      oldPos.SetZ(std::abs(oldPos.z()));
+      newPos = _shifter->ShiftForward(oldPos);
+      newPos.SetZ(newPos.z() * -1);
+    }
+    else
+    {
+      newPos = _shifter->ShiftForward(oldPos);
+    }
+  }
+
+  // Reading IBF and Gain weights according to X-Y position
+  float w_ibf = 1.;
+  float w_gain = 1.;
+
+  if (_fUseIBFMap)
+  {
+    int bin_x = _h_modules_anode->GetXaxis()->FindFixBin(x / mm);
+    int bin_y = _h_modules_anode->GetYaxis()->FindFixBin(y / mm);
+    w_ibf = _h_modules_measuredibf->GetBinContent(bin_x, bin_y);
+    w_gain = _h_modules_anode->GetBinContent(bin_x, bin_y);
+  }
+  float ionsPerEle = w_gain * _ampGain * w_ibf * _ampIBFfrac;
+
+  // Check that it is on the frame
+  int isOnPlane = 0;
+  double dr_bin = -1;
+  double dphi_bin = -1;
+  double new_phi = newPos.Phi();
+  double new_r = newPos.Perp() * cm;
+  if (new_phi < 0)
+  {
+    new_phi += 2 * M_PI;
+  }
+  if (new_r < 210 || new_r > 770)
+  {
+    return;
+  }
+  if (!IsOverFrame(new_r, new_phi))
+  {
+    isOnPlane = 1;
+  }
+  else
+  {
+    std::vector<double> r_phi_bin = putOnPlane(new_r / mm, new_phi);
+    dr_bin = r_phi_bin[0];
+    dphi_bin = r_phi_bin[1];
+  }
+
+  HitFill hitfill;
+  hitfill.isOnPlane = isOnPlane;
+  hitfill.hit_z = z;
+  hitfill.hit_r = r;
+  hitfill.hit_phi = phi;
+  hitfill.hit_eion = hit_eion;
+  hitfill.ibf_vol = N_electrons * ionsPerEle;
+  hitfill.amp_ele_vol = w_gain * _ampGain;
+
+  // 0: drifting in z > 0, 1: drifting in z < 0
+  int side = -1;
+  if (z >= 5 * mm && z < 1.055 * m)
+  {
+    side = 0;
+  }
+  if (z < -5 * mm && z > -1.055 * m)
+  {
+    side = 1;
+  }
+
+  if (side >= 0)
+  {
+    hitfill.in_drift = true;
+
+    const TAxis *xaxis = _h_SC_prim[0]->GetXaxis();
+    const TAxis *yaxis = _h_SC_prim[0]->GetYaxis();
+    const TAxis *zaxis = _h_SC_prim[0]->GetZaxis();
+    const size_t first_bin = block.bins.size();
+
+    // the ibf redistribution moves the hit for the following frames
+    float fill_r = r;
+    float fill_phi = phi;
+    float ibf_vol = hitfill.ibf_vol;
+    std::vector<double> newWeights;
+    double w_prim = hit_eion * Tpc_ElectronsPerGeV;
+    for (int iz = 0; iz < nFrames; iz++)
+    {
+      if (!_frame_active[iz])
+      {
+        continue;
+      }
+      double z_prim = (side == 0) ? z - _frame_dz[iz] : z + _frame_dz[iz];
+      bool fill_prim = (side == 0) ? (z_prim > 0 && z_prim < 1.055 * m) : (z_prim < 0 && z_prim > -1.055 * m);
+      if (fill_prim)
+      {
+        int bin = _h_SC_prim[iz]->GetBin(xaxis->FindFixBin(fill_phi), yaxis->FindFixBin(fill_r), zaxis->FindFixBin(z_prim));
+        block.bins.push_back({iz, false, bin, w_prim});
+      }
+
+      int ibf_zbin = _frame_ibf_zbin[side][iz];
+      if (ibf_zbin < 0)
+      {
+        continue;
+      }
+      if (!isOnPlane)
+      {
+        // Redistribute charges
+        if (newWeights.empty())
+        {
+          newWeights = getNewWeights(_h_SC_ibf[iz], _h_modules_anode, _h_modules_measuredibf, new_r, new_phi, dr_bin, dphi_bin, _fUseIBFMap);
+        }
+        double w_ibf_tmp = newWeights[0];
+        double w_gain_tmp = newWeights[1];
+        fill_r = newWeights[2];
+        fill_phi = newWeights[3];
+
+        ibf_vol = N_electrons * w_gain_tmp * _ampGain * w_ibf_tmp * _ampIBFfrac;
+        int bin = _h_SC_ibf[iz]->GetBin(xaxis->FindFixBin(fill_phi), yaxis->FindFixBin(fill_r), ibf_zbin);
+        block.bins.push_back({iz, true, bin, ibf_vol});
+        if (iz == 0)
+        {
+          hitfill.fill_xy = true;
+          hitfill.xy_x = fill_r * cos(fill_phi);
+          hitfill.xy_y = fill_r * sin(fill_phi);
+        }
+      }
+      else
+      {
+        int bin = _h_SC_ibf[iz]->GetBin(xaxis->FindFixBin(new_phi), yaxis->FindFixBin(new_r), ibf_zbin);
+        block.bins.push_back({iz, true, bin, ibf_vol});
+        if (iz == 0)
+        {
+          hitfill.fill_xy = true;
+          hitfill.xy_x = new_r * cos(new_phi);
+          hitfill.xy_y = new_r * sin(new_phi);
+        }
+      }
+    }
+
+    if (_frame_ibf_zbin[side][0] >= 0)
+    {
+      hitfill.fill_r = true;
+      hitfill.r_fill = fill_r;
+    }
+    hitfill.nbins = block.bins.size() - first_bin;
+  }
+  block.hits.push_back(hitfill);
+}
+
+std::vector<double> fillSpaceChargeMaps::getNewWeights(TH3 *h_SC_ibf, TH2 *h_modules_anode, TH2 *h_modules_measuredibf, double hit_r, double hit_phi, double dr_bin, double dphi_bin, bool fUseIBFMap) const
 {
   double w_ibf_tmp = 1.0;
   double w_gain_tmp = 1.0;
-  int r_bin = _h_R->GetXaxis()->FindBin(dr_bin);
+  int r_bin = _h_R->GetXaxis()->FindFixBin(dr_bin);
   double r_bin_c = _h_R->GetXaxis()->GetBinCenter(r_bin);
   double r_bin_r = _h_R->GetXaxis()->GetBinCenter(r_bin + 1);
   double r_bin_l = _h_R->GetXaxis()->GetBinCenter(r_bin - 1);
 
-  int phi_bin = h_SC_ibf->GetXaxis()->FindBin(dphi_bin);
+  int phi_bin = h_SC_ibf->GetXaxis()->FindFixBin(dphi_bin);
 
   double phi_bin_c = h_SC_ibf->GetXaxis()->GetBinCenter(phi_bin);
   double phi_bin_r = h_SC_ibf->GetXaxis()->GetBinCenter(phi_bin + 1);
@@ -626,8 +703,8 @@ std::vector<double> fillSpaceChargeMaps::getNewWeights(TH3 *h_SC_ibf, TH2 *h_mod
   {
     double x_tmp = hit_r * cos(hit_phi);
     double y_tmp = hit_r * sin(hit_phi);
-    int bin_x = h_modules_anode->GetXaxis()->FindBin(x_tmp);
-    int bin_y = h_modules_anode->GetYaxis()->FindBin(y_tmp);
+    int bin_x = h_modules_anode->GetXaxis()->FindFixBin(x_tmp);
+    int bin_y = h_modules_anode->GetYaxis()->FindFixBin(y_tmp);
     w_ibf_tmp = h_modules_measuredibf->GetBinContent(bin_x, bin_y);
     w_gain_tmp = h_modules_anode->GetBinContent(bin_x, bin_y);
   }
@@ -651,7 +728,7 @@ std::vector<double> fillSpaceChargeMaps::getNewWeights(TH3 *h_SC_ibf, TH2 *h_mod
   return newWeights;
 }
 
-bool fillSpaceChargeMaps::IsOverFrame(double r, double phi)
+bool fillSpaceChargeMaps::IsOverFrame(double r, double phi) const
 {
   // these parameters are taken from Feb 12 drawings of frames.
   // double tpc_frame_side_gap = 0.8 * mm;    //mm //space between radial line and start of frame
@@ -697,7 +774,7 @@ bool fillSpaceChargeMaps::IsOverFrame(double r, double phi)
   return false;
 }
 
-std::vector<double> fillSpaceChargeMaps::putOnPlane(double r, double phi)
+std::vector<double> fillSpaceChargeMaps::putOnPlane(double r, double phi) const
 {
   // these parameters are taken from Feb 12 drawings of frames.
   // double tpc_frame_side_gap = 0.8*mm;    //mm //space between radial line and start of frame
@@ -7,6 +7,7 @@
 
 #include <cmath>  // for sin, asin, cos, floor, M_PI
 #include <map>
+#include <memory>  // for unique_ptr
 #include <set>
 #include <string>
 #include <vector>
@@ -14,6 +15,9 @@
 // Forward declerations
 class Fun4AllHistoManager;
 class PHCompositeNode;
+class PHG4Hit;
+class PHThreadPool;
+class Shifter;
 class TFile;
 class TH1;
 class TH2;
@@ -60,10 +64,53 @@ class fillSpaceChargeMaps : public SubsysReco
   void UseSliming(int fSliming = 0);
   void UseFieldMaps(int shiftElectrons = 0);
 
+  //! number of threads processing the G4 hits (1: no threads, 0: all cores)
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
-  std::vector<double> getNewWeights(TH3 *_h_SC_ibf, TH2 *_h_modules_anode, TH2 *_h_modules_measuredibf, double _hit_r, double _hit_phi, double dr_bin, double dphi_bin, bool _fUseIBFMap);
-  bool IsOverFrame(double r, double phi);
-  std::vector<double> putOnPlane(double r, double phi);
+  //! one histogram bin to add to a frame
+  struct BinFill
+  {
+    int frame = 0;
+    bool ibf = false;
+    int bin = 0;
+    double w = 0;
+  };
+
+  //! what one accepted G4 hit fills, its bins follow in BlockFill::bins
+  struct HitFill
+  {
+    // sliming tree values
+    int isOnPlane = 0;
+    float hit_z = 0;
+    float hit_r = 0;
+    float hit_phi = 0;
+    float hit_eion = 0;
+    float ibf_vol = 0;
+    float amp_ele_vol = 0;
+
+    bool in_drift = false;
+    bool fill_xy = false;
+    double xy_x = 0;
+    double xy_y = 0;
+    bool fill_r = false;
+    float r_fill = 0;
+    size_t nbins = 0;
+  };
+
+  //! fills of one block of G4 hits, in hit order
+  struct BlockFill
+  {
+    std::vector<HitFill> hits;
+    std::vector<BinFill> bins;
+  };
+
+  //! compute the fills of one G4 hit. Reads only, so blocks of hits run in parallel
+  void ProcessHit(const PHG4Hit *hit, BlockFill &block) const;
+
+  std::vector<double> getNewWeights(TH3 *_h_SC_ibf, TH2 *_h_modules_anode, TH2 *_h_modules_measuredibf, double _hit_r, double _hit_phi, double dr_bin, double dphi_bin, bool _fUseIBFMap) const;
+  bool IsOverFrame(double r, double phi) const;
+  std::vector<double> putOnPlane(double r, double phi) const;
 
   Fun4AllHistoManager *hm = nullptr;
   std::string _filename;
@@ -106,6 +153,22 @@ class fillSpaceChargeMaps : public SubsysReco
   TH3 *_h_SC_prim[nFrames] = {nullptr};
   TH3 *_h_SC_ibf[nFrames] = {nullptr};
 
+  // ion drift of the frames for the current event, the same for all hits
+  bool _frame_active[nFrames] = {false};
+  double _frame_dz[nFrames] = {0};
+  // z bin of the ibf ions of each frame per side (0: z > 0, 1: z < 0), -1 if not filled
+  int _frame_ibf_zbin[2][nFrames] = {{0}};
+  // number of fills of the prim (0) and ibf (1) frames
+  double _frame_entries[2][nFrames] = {{0}};
+
+  //! distortion maps, loaded once
+  std::unique_ptr<Shifter> _shifter;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  std::vector<const PHG4Hit *> _g4hits;
+  std::vector<BlockFill> _blocks;
+
   // PHG4TpcPadPlaneReadout *padplane = nullptr;
   // PHG4TpcCylinderGeomContainer *seggeo = nullptr;
 
@@ -16,16 +16,87 @@
 #include <TTree.h>
 #include <TVector3.h>
 
+#include <phool/PHThreadPool.h>
+
 #include <boost/format.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>  // for assert
 #include <cmath>
+#include <complex>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
 
 #define ALMOST_ZERO 0.00001
 
+namespace
+{
+  //! discrete Fourier transform of the periodic phi direction, mixed radix for any length
+  class PhiDFT
+  {
+   public:
+    using cd = std::complex<double>;
+
+    //! out[k] = sum_j in[j] exp(sign*2*pi*i*j*k/n)
+    PhiDFT(const int n, const int sign)
+      : m_n(n)
+      , m_w(n)
+      , m_scratch(n)
+    {
+      for (int j = 0; j < n; j++)
+      {
+        m_w[j] = std::polar(1.0, sign * 2 * M_PI * j / n);
+      }
+    }
+
+    void transform(const cd *in, cd *out)
+    {
+      step(in, 1, out, m_scratch.data(), m_n);
+      return;
+    }
+
+   private:
+    // decimation in time, the sub-transforms of each factor go to out and are combined via scratch
+    void step(const cd *in, const int stride, cd *out, cd *scratch, const int len) const
+    {
+      if (len == 1)
+      {
+        out[0] = in[0];
+        return;
+      }
+      int p = 2;
+      while (len % p)
+      {
+        p++;
+      }
+      const int m = len / p;
+      for (int r = 0; r < p; r++)
+      {
+        step(in + r * stride, stride * p, out + r * m, scratch + r * m, m);
+      }
+      const int wstep = m_n / len;
+      for (int j = 0; j < len; j++)
+      {
+        const int k = j % m;
+        cd sum = 0;
+        for (int r = 0; r < p; r++)
+        {
+          sum += out[r * m + k] * m_w[static_cast<size_t>((r * j) % len) * wstep];
+        }
+        scratch[j] = sum;
+      }
+      std::copy(scratch, scratch + len, out);
+      return;
+    }
+
+    int m_n;
+    std::vector<cd> m_w;
+    std::vector<cd> m_scratch;
+  };
+}  // namespace
+
 AnnularFieldSim::AnnularFieldSim(float in_innerRadius, float in_outerRadius, float in_outerZ,
                                  int r, int roi_r0, int roi_r1, int /*in_rLowSpacing*/, int /*in_rHighSize*/,
                                  int phi, int roi_phi0, int roi_phi1, int /*in_phiLowSpacing*/, int /*in_phiHighSize*/,
@@ -1312,6 +1383,259 @@ void AnnularFieldSim::populate_analytic_fieldmap(){
 }
 */
 
+void AnnularFieldSim::tabulate_green()
+{
+  // the green's functions are only evaluated at cell centers, shifted by green_shift in z (see calc_unit_field)
+  std::vector<double> radii;
+  std::vector<double> zs;
+  for (int ir = 0; ir < nr; ir++)
+  {
+    radii.push_back(GetCellCenter(ir, 0, 0).Perp());
+  }
+  for (int iz = 0; iz < nz; iz++)
+  {
+    zs.push_back(GetCellCenter(0, 0, iz).Z() + green_shift);
+  }
+  green->TabulateAt(radii, zs);
+  return;
+}
+
+void AnnularFieldSim::parallel_cells(const size_t ncells, const std::function<void(size_t)> &func)
+{
+  // the debug print counter is not thread safe
+  if (nthreads == 1 || ncells < 2 || debug_printActionEveryN > 0)
+  {
+    for (size_t i = 0; i < ncells; i++)
+    {
+      func(i);
+    }
+    return;
+  }
+  PHThreadPool pool(std::max(nthreads, 0));
+  pool.parallel_for(ncells, func);
+  return;
+}
+
+void AnnularFieldSim::build_phislice_soa()
+{
+  // float copy of the phislice lookup, x, y and z blocks, with the self-to-self terms zeroed
+  const size_t length = Epartial_phislice->Length();
+  auto soa = std::make_shared<std::vector<float>>(3 * length);
+  float *x = soa->data();
+  float *y = x + length;
+  float *z = y + length;
+  for (size_t i = 0; i < length; i++)
+  {
+    const TVector3 &unitf = *(Epartial_phislice->GetFlat(i));
+    x[i] = unitf.X();
+    y[i] = unitf.Y();
+    z[i] = unitf.Z();
+  }
+  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  {
+    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+    {
+      const size_t self = Epartial_phislice->GetPtr(ifr - rmin_roi, 0, ifz - zmin_roi, ifr, 0, ifz) - Epartial_phislice->GetFlat(0);
+      x[self] = 0;
+      y[self] = 0;
+      z[self] = 0;
+    }
+  }
+  Epartial_phislice_soa = soa;
+  return;
+}
+
+TVector3 AnnularFieldSim::sum_phislice_field_soa(int r, int phi, int z, const std::vector<float> &charge)
+{
+  // same as sum_phislice_field_at, from the float lookup and a flat copy of the charge.
+  // the rotation is the same for all sources, so it is applied to the sum
+  TVector3 pos = GetRoiCellCenter(r - rmin_roi, phi - phimin_roi, z - zmin_roi);
+  TVector3 slicepos = GetRoiCellCenter(r - rmin_roi, 0, z - zmin_roi);
+  float rotphi = pos.Phi() - slicepos.Phi();
+
+  const size_t length = Epartial_phislice_soa->size() / 3;
+  const float *slice = Epartial_phislice_soa->data() + static_cast<size_t>((r - rmin_roi) * nz_roi + (z - zmin_roi)) * nr * nphi * nz;
+  double sumx = 0;
+  double sumy = 0;
+  double sumz = 0;
+  for (int ir = 0; ir < nr; ir++)
+  {
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      // the self-to-self term is zero in the float lookup
+      const int phirel = FilterPhiIndex(iphi - phi);
+      const float *x = slice + static_cast<size_t>(ir * nphi + phirel) * nz;
+      const float *y = x + length;
+      const float *zc = y + length;
+      const float *qz = charge.data() + static_cast<size_t>(ir * nphi + iphi) * nz;
+      for (int iz = 0; iz < nz; iz++)
+      {
+        sumx += x[iz] * qz[iz];
+        sumy += y[iz] * qz[iz];
+        sumz += zc[iz] * qz[iz];
+      }
+    }
+  }
+  TVector3 sum(sumx, sumy, sumz);
+  sum.RotateZ(rotphi);
+  return sum;
+}
+
+void AnnularFieldSim::build_phislice_fft()
+{
+  // the phislice sum is a circular cross-correlation in phi: E(phi)=sum_d G(d)*q(phi+d).
+  // store conj(FT(G)) = sum_d G(d) exp(+2 pi i k d/nphi) for k<=nphi/2 (G is real), with the self-to-self terms zeroed.
+  const int nk = nphi / 2 + 1;
+  const size_t block = 6 * static_cast<size_t>(nk);
+  auto spectra = std::make_shared<std::vector<float>>(static_cast<size_t>(nr_roi) * nz_roi * nr * nz * block);
+  auto fill_slice = [&](size_t islice)
+  {
+    const int ir = islice / nz_roi;
+    const int iz = islice % nz_roi;
+    PhiDFT dft(nphi, 1);
+    std::vector<std::complex<double>> in(nphi);
+    std::vector<std::complex<double>> out(nphi);
+    for (int ior = 0; ior < nr; ior++)
+    {
+      for (int ioz = 0; ioz < nz; ioz++)
+      {
+        float *dest = spectra->data() + (islice * nr * nz + static_cast<size_t>(ior) * nz + ioz) * block;
+        const bool self = (ior == ir + rmin_roi && ioz == iz + zmin_roi);
+        for (int c = 0; c < 3; c++)
+        {
+          for (int d = 0; d < nphi; d++)
+          {
+            in[d] = (self && d == 0) ? 0 : Epartial_phislice->Get(ir, 0, iz, ior, d, ioz)(c);
+          }
+          dft.transform(in.data(), out.data());
+          for (int k = 0; k < nk; k++)
+          {
+            dest[c * nk + k] = out[k].real();
+            dest[(3 + c) * nk + k] = out[k].imag();
+          }
+        }
+      }
+    }
+  };
+  parallel_cells(static_cast<size_t>(nr_roi) * nz_roi, fill_slice);
+  Epartial_phislice_fft = spectra;
+  return;
+}
+
+void AnnularFieldSim::populate_fieldmap_phifft()
+{
+  // the same field as the phislice sum, as a product of phi spectra summed over the source (r,z)
+  // and one inverse transform per target (r,z), instead of a sum over all source cells per target cell.
+  std::cout << boost::str(boost::format("populating fieldmap for (%dx%dx%d) grid with (%dx%dx%d) source from phi spectra") % nr_roi % nphi_roi % nz_roi % nr % nphi % nz) << std::endl;
+  if (!Epartial_phislice_fft)
+  {
+    build_phislice_fft();
+  }
+  const int nk = nphi / 2 + 1;
+  const size_t block = 6 * static_cast<size_t>(nk);
+
+  // FT(q) = sum_phi q(phi) exp(-2 pi i k phi/nphi) of each source (r,z), re then im
+  std::vector<float> qhat(static_cast<size_t>(nr) * nz * 2 * nk);
+  auto fill_charge = [&](size_t isource)
+  {
+    const int ir = isource / nz;
+    const int iz = isource % nz;
+    PhiDFT dft(nphi, -1);
+    std::vector<std::complex<double>> in(nphi);
+    std::vector<std::complex<double>> out(nphi);
+    for (int iphi = 0; iphi < nphi; iphi++)
+    {
+      in[iphi] = q->GetChargeInBin(ir, iphi, iz);
+    }
+    dft.transform(in.data(), out.data());
+    float *dest = qhat.data() + isource * 2 * nk;
+    for (int k = 0; k < nk; k++)
+    {
+      dest[k] = out[k].real();
+      dest[nk + k] = out[k].imag();
+    }
+  };
+  parallel_cells(static_cast<size_t>(nr) * nz, fill_charge);
+
+  // one task per target (r,z), each writes its own phi row of the field map
+  std::vector<double> cosw(nphi);
+  std::vector<double> sinw(nphi);
+  for (int j = 0; j < nphi; j++)
+  {
+    cosw[j] = std::cos(2 * M_PI * j / nphi);
+    sinw[j] = std::sin(2 * M_PI * j / nphi);
+  }
+  auto fill_row = [&](size_t islice)
+  {
+    const int ir = islice / nz_roi;
+    const int iz = islice % nz_roi;
+    std::vector<double> acc(block, 0);
+    double *accre = acc.data();
+    double *accim = accre + 3 * nk;
+    const float *slice = Epartial_phislice_fft->data() + islice * nr * nz * block;
+    for (size_t isource = 0; isource < static_cast<size_t>(nr) * nz; isource++)
+    {
+      const float *gre = slice + isource * block;
+      const float *gim = gre + 3 * nk;
+      const float *qre = qhat.data() + isource * 2 * nk;
+      const float *qim = qre + nk;
+      for (int c = 0; c < 3; c++)
+      {
+        for (int k = 0; k < nk; k++)
+        {
+          accre[c * nk + k] += gre[c * nk + k] * qre[k] - gim[c * nk + k] * qim[k];
+          accim[c * nk + k] += gre[c * nk + k] * qim[k] + gim[c * nk + k] * qre[k];
+        }
+      }
+    }
+
+    // inverse transform of the real result, then the same rotation as the direct sum
+    const int nkfull = (nphi % 2) ? nk : nk - 1;  // frequencies with a conjugate partner
+    TVector3 slicepos = GetRoiCellCenter(ir, 0, iz);
+    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    {
+      double sum[3];
+      for (int c = 0; c < 3; c++)
+      {
+        double value = accre[c * nk];
+        for (int k = 1; k < nkfull; k++)
+        {
+          const int j = (static_cast<long>(k) * iphi) % nphi;
+          value += 2 * (accre[c * nk + k] * cosw[j] - accim[c * nk + k] * sinw[j]);
+        }
+        if (nkfull < nk)
+        {
+          value += (iphi % 2) ? -accre[c * nk + nphi / 2] : accre[c * nk + nphi / 2];
+        }
+        sum[c] = value / nphi;
+      }
+      TVector3 localF(sum[0], sum[1], sum[2]);
+      TVector3 pos = GetRoiCellCenter(ir, iphi - phimin_roi, iz);
+      localF.RotateZ(pos.Phi() - slicepos.Phi());
+      Efield->Set(ir, iphi - phimin_roi, iz, localF + Eexternal->Get(ir, iphi - phimin_roi, iz));
+    }
+  };
+  parallel_cells(static_cast<size_t>(nr_roi) * nz_roi, fill_row);
+
+  // compare a few cells with the direct sum
+  const int nvalidate = 8;
+  const unsigned long long ncells = static_cast<unsigned long long>(nr_roi) * nphi_roi * nz_roi;
+  double maxdiff = 0;
+  double maxfield = 0;
+  for (int i = 0; i < nvalidate; i++)
+  {
+    const unsigned long long icell = (2 * i + 1) * ncells / (2 * nvalidate);
+    const int ir = icell / (nphi_roi * nz_roi);
+    const int iphi = (icell / nz_roi) % nphi_roi;
+    const int iz = icell % nz_roi;
+    TVector3 direct = sum_phislice_field_at(ir + rmin_roi, iphi + phimin_roi, iz + zmin_roi) + Eexternal->Get(ir, iphi, iz);
+    maxdiff = std::max(maxdiff, (Efield->Get(ir, iphi, iz) - direct).Mag());
+    maxfield = std::max(maxfield, direct.Mag());
+  }
+  std::cout << boost::str(boost::format("populate_fieldmap_phifft: max deviation from the direct sum in %d cells is %E (max field %E)") % nvalidate % maxdiff % maxfield) << std::endl;
+  return;
+}
+
 void AnnularFieldSim::populate_fieldmap()
 {
   // sum the E field at every point in the region of interest
@@ -1323,33 +1647,76 @@ void AnnularFieldSim::populate_fieldmap()
   {
     std::cout << boost::str(boost::format(" ==> truncating anything more than %d cells away") % truncation_length) << std::endl;
   }
+  if (lookupCase == PhiSlice && phi_fft)
+  {
+    populate_fieldmap_phifft();
+    return;
+  }
   unsigned long long totalelements = nr_roi;
   totalelements *= nphi_roi;
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
+  unsigned long long percent = std::max(1ULL, totalelements / 100 * debug_npercent);
   std::cout << boost::str(boost::format("total elements = %llu") % (totalelements * nr * nphi * nz)) << std::endl;
 
-  int el = 0;
-
-  TVector3 localF;  // holder for the summed field at the current position.
-  for (int ir = rmin_roi; ir < rmax_roi; ir++)
+  // the phislice sum reads the lookup and the charge from contiguous float arrays
+  std::vector<float> charge;
+  const bool use_soa = (lookupCase == PhiSlice && debug_printActionEveryN <= 0);
+  if (use_soa)
   {
-    for (int iphi = phimin_roi; iphi < phimax_roi; iphi++)
+    if (!Epartial_phislice_soa)
     {
-      for (int iz = zmin_roi; iz < zmax_roi; iz++)
+      build_phislice_soa();
+    }
+    charge.resize(static_cast<size_t>(nr) * nphi * nz);
+    for (int ir = 0; ir < nr; ir++)
+    {
+      for (int iphi = 0; iphi < nphi; iphi++)
       {
-        localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
-        if (!(el % percent))
+        for (int iz = 0; iz < nz; iz++)
         {
-          std::cout << boost::str(boost::format("populate_fieldmap %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
-          std::cout << boost::str(boost::format("sum_field_at (ir=%d,iphi=%d,iz=%d) gives (%E,%E,%E)") % ir % iphi % iz % localF.X() % localF.Y() % localF.Z()) << std::endl;
+          charge[(static_cast<size_t>(ir) * nphi + iphi) * nz + iz] = q->GetChargeInBin(ir, iphi, iz);
         }
-        el++;
+      }
+    }
+  }
 
-        Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
-                                                                               // if (localF.Mag()>1e-9)
-                                                                               // if(debugFlag()) print_need_cout("%d: AnnularFieldSim::populate_fieldmap fieldmap@ (%d,%d,%d) mag=%f\n",__LINE__,ir,iphi,iz,localF.Mag());
+  // one task per (r,phi) column of the roi, each writes its own cells
+  std::atomic<unsigned long long> el{0};
+  auto fill_column = [&](size_t icell)
+  {
+    const int ir = rmin_roi + icell / nphi_roi;
+    const int iphi = phimin_roi + icell % nphi_roi;
+    TVector3 localF;  // holder for the summed field at the current position.
+    for (int iz = zmin_roi; iz < zmax_roi; iz++)
+    {
+      if (use_soa)
+      {
+        localF = sum_phislice_field_soa(ir, iphi, iz, charge) + Eexternal->Get(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi);
+      }
+      else
+      {
+        localF = sum_field_at(ir, iphi, iz);  // asks in global coordinates
+      }
+      const unsigned long long iel = el++;
+      if (!(iel % percent))
+      {
+        std::cout << boost::str(boost::format("populate_fieldmap %llu%%:  ") % ((uint64_t) (debug_npercent) *iel / percent))
+                  << boost::str(boost::format("sum_field_at (ir=%d,iphi=%d,iz=%d) gives (%E,%E,%E)") % ir % iphi % iz % localF.X() % localF.Y() % localF.Z()) << std::endl;
       }
+
+      Efield->Set(ir - rmin_roi, iphi - phimin_roi, iz - zmin_roi, localF);  // sets in roi coordinates.
+    }
+  };
+  if (lookupCase == Full3D || lookupCase == PhiSlice || lookupCase == NoLookup)
+  {
+    parallel_cells(static_cast<size_t>(nr_roi) * nphi_roi, fill_column);
+  }
+  else
+  {
+    // the hybrid sum fills a shared buffer, the analytic model evaluates TFormulas
+    for (size_t icell = 0; icell < static_cast<size_t>(nr_roi) * nphi_roi; icell++)
+    {
+      fill_column(icell);
     }
   }
   return;
@@ -1406,49 +1773,47 @@ void AnnularFieldSim::populate_full3d_lookup()
   totalelements *= nr;
   totalelements *= nphi;
   totalelements *= nz;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
+  unsigned long long percent = std::max(1ULL, totalelements / 100 * debug_npercent);
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  // one task per target cell, each writes its own part of the lookup
+  std::atomic<unsigned long long> el{0};
+  auto fill_target = [&](size_t icell)
   {
-    for (int ifphi = phimin_roi; ifphi < phimax_roi; ifphi++)
+    const int ifr = rmin_roi + icell / (nphi_roi * nz_roi);
+    const int ifphi = phimin_roi + (icell / nz_roi) % nphi_roi;
+    const int ifz = zmin_roi + icell % nz_roi;
+    TVector3 at = GetCellCenter(ifr, ifphi, ifz);
+    TVector3 from(1, 0, 0);
+    for (int ior = 0; ior < nr; ior++)
     {
-      for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        at = GetCellCenter(ifr, ifphi, ifz);
-        for (int ior = 0; ior < nr; ior++)
+        for (int ioz = 0; ioz < nz; ioz++)
         {
-          for (int iophi = 0; iophi < nphi; iophi++)
+          const unsigned long long iel = ++el;
+          if (!(iel % percent))
           {
-            for (int ioz = 0; ioz < nz; ioz++)
-            {
-              el++;
-              if (!(el % percent))
-              {
-                std::cout << boost::str(boost::format("populate_full3d_lookup %d%%") % ((uint64_t) (debug_npercent) *el / percent)) << std::endl;
-              }
-              from = GetCellCenter(ior, iophi, ioz);
+            std::cout << boost::str(boost::format("populate_full3d_lookup %d%%") % ((uint64_t) (debug_npercent) *iel / percent)) << std::endl;
+          }
+          from = GetCellCenter(ior, iophi, ioz);
 
-              //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-              // print_need_cout("calc_unit_field...\n");
-              if (ifr == ior && ifphi == iophi && ifz == ioz)
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
-              }
-              else
-              {
-                Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
-              }
-            }
+          //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
+          // print_need_cout("calc_unit_field...\n");
+          if (ifr == ior && ifphi == iophi && ifz == ioz)
+          {
+            Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, zero);
+          }
+          else
+          {
+            Epartial->Set(ifr - rmin_roi, ifphi - phimin_roi, ifz - zmin_roi, ior, iophi, ioz, calc_unit_field(at, from));
           }
         }
       }
     }
-  }
+  };
+  parallel_cells(static_cast<size_t>(nr_roi) * nphi_roi * nz_roi, fill_target);
   return;
 }
 
@@ -1732,56 +2097,57 @@ void AnnularFieldSim::populate_phislice_lookup()
   totalelements *= nz;
   totalelements *= nr_roi;
   totalelements *= nz_roi;  // breaking up this multiplication prevents a 32bit math overflow
-  unsigned long long percent = totalelements / 100 * debug_npercent;
+  unsigned long long percent = std::max(1ULL, totalelements / 100 * debug_npercent);
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
-  TVector3 at(1, 0, 0);
-  TVector3 from(1, 0, 0);
   TVector3 zero(0, 0, 0);
 
-  int el = 0;
-  for (int ifr = rmin_roi; ifr < rmax_roi; ifr++)
+  // the float copy and the spectra are rebuilt from the new lookup when needed
+  Epartial_phislice_soa.reset();
+  Epartial_phislice_fft.reset();
+
+  // one task per target cell of the slice, each writes its own part of the lookup
+  std::atomic<unsigned long long> el{0};
+  auto fill_target = [&](size_t icell)
   {
-    for (int ifz = zmin_roi; ifz < zmax_roi; ifz++)
+    const int ifr = rmin_roi + icell / nz_roi;
+    const int ifz = zmin_roi + icell % nz_roi;
+    TVector3 at = GetCellCenter(ifr, 0, ifz);
+    TVector3 from(1, 0, 0);
+    for (int ior = 0; ior < nr; ior++)
     {
-      at = GetCellCenter(ifr, 0, ifz);
-      for (int ior = 0; ior < nr; ior++)
+      for (int iophi = 0; iophi < nphi; iophi++)
       {
-        for (int iophi = 0; iophi < nphi; iophi++)
+        for (int ioz = 0; ioz < nz; ioz++)
         {
-          for (int ioz = 0; ioz < nz; ioz++)
+          const unsigned long long iel = ++el;
+          from = GetCellCenter(ior, iophi, ioz);
+          //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
+          // print_need_cout("calc_unit_field...\n");
+          if (ifr == ior && 0 == iophi && ifz == ioz)
           {
-            el++;
-            from = GetCellCenter(ior, iophi, ioz);
-            //*f[ifx][ify][ifz][iox][ioy][ioz]=cacl_unit_field(at,from);
-            // print_need_cout("calc_unit_field...\n");
-            if (ifr == ior && 0 == iophi && ifz == ioz)
+            if (!(iel % percent))
             {
-              if (!(el % percent))
-              {
-                std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
-                std::cout << boost::str(boost::format("self-to-self is zero (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % zero.X() % zero.Y() % zero.Z()) << std::endl;
-              }
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
+              std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *iel / percent))
+                        << boost::str(boost::format("self-to-self is zero (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % zero.X() % zero.Y() % zero.Z()) << std::endl;
             }
-            else
+            Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, zero);
+          }
+          else
+          {
+            TVector3 unitf = calc_unit_field(at, from);
+            if (!(iel % percent))
             {
-              TVector3 unitf = calc_unit_field(at, from);
-              if (true)
-              {
-                if (!(el % percent))
-                {
-                  std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *el / percent));
-                  std::cout << boost::str(boost::format("calc_unit_field (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % unitf.X() % unitf.Y() % unitf.Z()) << std::endl;
-                }
-              }
-
-              Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, unitf);  // the origin phi is relative to zero anyway.
+              std::cout << boost::str(boost::format("populate_phislice_lookup %llu%%:  ") % ((uint64_t) (debug_npercent) *iel / percent))
+                        << boost::str(boost::format("calc_unit_field (ir=%d,iphi=%d,iz=%d) to (or=%d,ophi=0,oz=%d) gives (%E,%E,%E)") % ior % iophi % ioz % ifr % ifz % unitf.X() % unitf.Y() % unitf.Z()) << std::endl;
             }
+
+            Epartial_phislice->Set(ifr - rmin_roi, 0, ifz - zmin_roi, ior, iophi, ioz, unitf);  // the origin phi is relative to zero anyway.
           }
         }
       }
     }
-  }
+  };
+  parallel_cells(static_cast<size_t>(nr_roi) * nz_roi, fill_target);
   return;
 }
 
@@ -1796,6 +2162,10 @@ void AnnularFieldSim::load_phislice_lookup(const std::string &sourcefile)
   unsigned long long percent = totalelements / 100 * debug_npercent;
   std::cout << boost::str(boost::format("total elements = %llu") % totalelements) << std::endl;
 
+  // the float copy and the spectra are rebuilt from the new lookup when needed
+  Epartial_phislice_soa.reset();
+  Epartial_phislice_fft.reset();
+
   TFile *input = TFile::Open(sourcefile.c_str(), "READ");
   TTree *tInfo;
   input->GetObject("info", tInfo);
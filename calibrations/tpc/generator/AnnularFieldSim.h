@@ -3,7 +3,10 @@
 #include <TVector3.h>
 
 #include <cmath>   // for NAN, abs
+#include <functional>
+#include <memory>
 #include <string>  // for string
+#include <vector>
 
 class AnalyticFieldModel;
 class ChargeMapReader;
@@ -93,6 +96,18 @@ class AnnularFieldSim
     truncation_length = x;
     return;
   }
+  //! threads used to populate the lookup tables and the field map, 0 uses all cores
+  void SetNThreads(int n)
+  {
+    nthreads = n;
+    return;
+  }
+  //! sum the phislice field map with FFTs in phi instead of the direct sum
+  void SetPhiFFT(bool b)
+  {
+    phi_fft = b;
+    return;
+  }
 
   // getters for internal states:
   const std::string GetLookupString();
@@ -152,17 +167,21 @@ class AnnularFieldSim
   void load_rossegger(double epsilon = 1E-4)
   {
     green = new Rossegger(rmin, rmax, zmax, epsilon);
+    tabulate_green();
     return;
   };
   void borrow_rossegger(Rossegger *ross, float zshift)
   {
     green = ross;
     green_shift = zshift;
+    tabulate_green();
     return;
   };  // get an already-existing rossegger table instead of loading it ourselves.
   void borrow_epartial_from(AnnularFieldSim *sim, float zshift)
   {
     Epartial_phislice = sim->Epartial_phislice;
+    Epartial_phislice_soa = sim->Epartial_phislice_soa;
+    Epartial_phislice_fft = sim->Epartial_phislice_fft;
     green_shift = zshift;
     return;
   };  // get an already-existing rossegger table instead of loading it ourselves.
@@ -187,7 +206,12 @@ class AnnularFieldSim
   TVector3 GetGroupCellCenter(int r0, int r1, int phi0, int phi1, int z0, int z1);
   TVector3 GetWeightedCellCenter(int r, int phi, int z);
   TVector3 fieldIntegral(float zdest, const TVector3 &start, MultiArray<TVector3> *field);
+  void parallel_cells(const size_t ncells, const std::function<void(size_t)> &func);  // func(i) for all cells, on nthreads threads
+  void tabulate_green();
+  void build_phislice_soa();
+  void build_phislice_fft();
   void populate_fieldmap();
+  void populate_fieldmap_phifft();
   // now handled by setting 'analytic' lookup:  void populate_analytic_fieldmap();
   void populate_lookup();
   void populate_full3d_lookup();
@@ -208,6 +232,7 @@ class AnnularFieldSim
   TVector3 sum_local_field_at(int r, int phi, int z);
   TVector3 sum_nonlocal_field_at(int r, int phi, int z);
   TVector3 sum_phislice_field_at(int r, int phi, int z);
+  TVector3 sum_phislice_field_soa(int r, int phi, int z, const std::vector<float> &charge);
   TVector3 swimToInAnalyticSteps(float zdest, TVector3 start, int steps, int *goodToStep);
   TVector3 swimToInSteps(float zdest, const TVector3 &start, int steps, bool interpolate, int *goodToStep);
   TVector3 swimTo(float zdest, const TVector3 &start, bool interpolate = true, bool useAnalytic = false);
@@ -299,6 +324,8 @@ class AnnularFieldSim
   LookupCase lookupCase;  // which lookup system to instantiate and use.
   ChargeCase chargeCase;  // which charge model to use
   int truncation_length;  // distance in cells (full 3D metric in units of bins)
+  int nthreads = 1;       // threads for the lookup and field map loops, 0 = all cores
+  bool phi_fft = false;   // sum the phislice field map as a convolution in phi with FFTs
 
   // variables related to the region of interest:
   //
@@ -337,6 +364,8 @@ class AnnularFieldSim
   MultiArray<TVector3> *Epartial_lowres;    // electric field in each l-bin in the roi from charge in a given l-bin anywhere in the volume.
   MultiArray<TVector3> *Epartial;           // electric field for the old brute-force model.
   MultiArray<TVector3> *Epartial_phislice;  // electric field in a 2D phi-slice from the full 3D region.
+  std::shared_ptr<std::vector<float>> Epartial_phislice_soa;  // float copy of Epartial_phislice, x, y and z blocks of Length() each, for the field sum.
+  std::shared_ptr<std::vector<float>> Epartial_phislice_fft;  // phi spectra of Epartial_phislice, per slice and source (r,z) re x,y,z then im x,y,z of nphi/2+1 each.
   MultiArray<TVector3> *Eexternal;          // externally applied electric field in each f-bin in the roi
   MultiArray<TVector3> *Bfield;             // magnetic field in each f-bin in the roi
 
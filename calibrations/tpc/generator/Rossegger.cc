@@ -13,9 +13,11 @@
 
 #include <algorithm>  // for max
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>  // for exit, abs
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -27,6 +29,13 @@ extern "C"
 }
 //
 
+namespace
+{
+  // the fortran routines keep their intermediate results in COMMON blocks,
+  // so only one thread at a time may call them
+  std::mutex fortran_mutex;
+}  // namespace
+
 // Bessel Function J_n(x):
 #define jn(order, x) boost::math::cyl_bessel_j(order, x)
 // Bessel (Neumann) Function Y_n(x):
@@ -351,6 +360,7 @@ double Rossegger::Limu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dlia_(&IFAC, &X, &A, &DLI, &DERR, &IERRO);
   return DLI;
 }
@@ -363,6 +373,7 @@ double Rossegger::Kimu(double mu, double x)
   int IERRO = 0;
 
   double X = x;
+  std::lock_guard<std::mutex> lock(fortran_mutex);
   dkia_(&IFAC, &X, &A, &DKI, &DERR, &IERRO);
   return DKI;
 }
@@ -803,6 +814,33 @@ double Rossegger::Ez(double r, double phi, double z, double r1, double phi1, dou
   }
   // Rossegger Equation 5.64
   double G = 0;
+  const RadialTerms *tr = FindRadialTerms(r);
+  const RadialTerms *tr1 = FindRadialTerms(r1);
+  const AxialTerms *tz = FindAxialTerms(z);
+  const AxialTerms *tz1 = FindAxialTerms(z1);
+  if (tr && tr1 && tz && tz1 && verbosity <= 10)
+  {
+    // same sum from the tabulated terms
+    for (int m = 0; m < NumberOfOrders; m++)
+    {
+      const double *rmn = tr->rmn[m];
+      const double *rmn_1 = tr1->rmn[m];
+      const double *z_term = (z < z1) ? tz->cosh_z[m] : tz->cosh_lz[m];
+      const double *z1_term = (z < z1) ? tz1->sinh_lz[m] : tz1->sinh_z[m];
+      double sum = 0;
+      for (int n = 0; n < NumberOfOrders; n++)
+      {
+        sum += rmn[n] * rmn_1[n] / N2mn[m][n] * z_term[n] * z1_term[n] / sinh_Betamn_L[m][n];
+      }
+      G += (2 - ((m == 0) ? 1 : 0)) * cos(m * (phi - phi1)) * ((z < z1) ? sum : -sum);
+    }
+    G = G / (2.0 * pi);
+    if (verbosity)
+    {
+      std::cout << "Ez = " << G << std::endl;
+    }
+    return G;
+  }
   for (int m = 0; m < NumberOfOrders; m++)
   {
     if (verbosity > 10)
@@ -1009,6 +1047,31 @@ double Rossegger::Er(double r, double phi, double z, double r1, double phi1, dou
 
   double part = 0;
   double G = 0;
+  const RadialTerms *tr = FindRadialTerms(r);
+  const RadialTerms *tr1 = FindRadialTerms(r1);
+  const AxialTerms *tz = FindAxialTerms(z);
+  const AxialTerms *tz1 = FindAxialTerms(z1);
+  if (tr && tr1 && tz && tz1 && verbosity <= 10)
+  {
+    // same sum from the tabulated terms
+    for (int m = 0; m < NumberOfOrders; m++)
+    {
+      const double *r_term = (r < r1) ? tr->rprime_a[m] : tr->rprime_b[m];
+      const double *r1_term = (r < r1) ? tr1->rmn2[m] : tr1->rmn1[m];
+      double sum = 0;
+      for (int n = 0; n < NumberOfOrders; n++)
+      {
+        sum += tz->sin_z[n] * tz1->sin_z[n] * r_term[n] * r1_term[n] / bessel_denominator[m][n];
+      }
+      G += (2 - ((m == 0) ? 1 : 0)) * cos(m * (phi - phi1)) * sum;
+    }
+    G = G / (L * pi);
+    if (verbosity)
+    {
+      std::cout << "Er = " << G << std::endl;
+    }
+    return G;
+  }
   for (int m = 0; m < NumberOfOrders; m++)
   {
     for (int n = 0; n < NumberOfOrders; n++)
@@ -1172,6 +1235,30 @@ double Rossegger::Ephi(double r, double phi, double z, double r1, double phi1, d
   }
 
   double G = 0;
+  const RadialTerms *tr = FindRadialTerms(r);
+  const RadialTerms *tr1 = FindRadialTerms(r1);
+  const AxialTerms *tz = FindAxialTerms(z);
+  const AxialTerms *tz1 = FindAxialTerms(z1);
+  if (tr && tr1 && tz && tz1)
+  {
+    // same sum from the tabulated terms
+    const double dphi = (phi > phi1) ? phi - phi1 : phi1 - phi;
+    const double sign = (phi > phi1) ? -1 : 1;
+    for (int n = 0; n < NumberOfOrders; n++)
+    {
+      const double z_term = tz->sin_z[n] * tz1->sin_z[n];
+      for (int k = 0; k < NumberOfOrders; k++)
+      {
+        G += z_term * tr->rnk[n][k] * tr1->rnk[n][k] / N2nk[n][k] * sinh(Munk[n][k] * (pi - dphi)) / sinh_pi_Munk[n][k];
+      }
+    }
+    G = sign * G / (L * r);
+    if (verbosity)
+    {
+      std::cout << "Ephi = " << G << std::endl;
+    }
+    return G;
+  }
   // Rossegger Eqn. 5.66:
   for (int k = 0; k < NumberOfOrders; k++)
   {
@@ -1320,6 +1407,255 @@ double Rossegger::Ephi_(double r, double phi, double z, double r1, double phi1,
   return G;
 }
 
+void Rossegger::FillRadialTerms(double r, RadialTerms &terms)
+{
+  for (int m = 0; m < NumberOfOrders; m++)
+  {
+    for (int n = 0; n < NumberOfOrders; n++)
+    {
+      terms.rmn[m][n] = Rmn(m, n, r);
+      terms.rmn1[m][n] = Rmn1(m, n, r);
+      terms.rmn2[m][n] = Rmn2(m, n, r);
+      terms.rprime_a[m][n] = RPrime(m, n, a, r);
+      terms.rprime_b[m][n] = RPrime(m, n, b, r);
+    }
+  }
+  for (int n = 0; n < NumberOfOrders; n++)
+  {
+    for (int k = 0; k < NumberOfOrders; k++)
+    {
+      terms.rnk[n][k] = Rnk(n, k, r);
+    }
+  }
+  return;
+}
+
+void Rossegger::FillAxialTerms(double z, AxialTerms &terms)
+{
+  for (int m = 0; m < NumberOfOrders; m++)
+  {
+    for (int n = 0; n < NumberOfOrders; n++)
+    {
+      terms.cosh_z[m][n] = cosh(Betamn[m][n] * z);
+      terms.cosh_lz[m][n] = cosh(Betamn[m][n] * (L - z));
+      terms.sinh_z[m][n] = sinh(Betamn[m][n] * z);
+      terms.sinh_lz[m][n] = sinh(Betamn[m][n] * (L - z));
+    }
+  }
+  for (int n = 0; n < NumberOfOrders; n++)
+  {
+    terms.sin_z[n] = sin(BetaN[n] * z);
+  }
+  return;
+}
+
+namespace
+{
+  // coordinates closer than this share a table entry, the callers recompute cell centers with rounding differences
+  constexpr double kTableTolerance = 1e-7;  // cm
+
+  template <class T>
+  const T *find_in_table(const std::vector<std::pair<double, T>> &table, double x)
+  {
+    auto it = std::lower_bound(table.begin(), table.end(), x - kTableTolerance,
+                               [](const std::pair<double, T> &entry, double value)
+                               { return entry.first < value; });
+    if (it != table.end() && it->first <= x + kTableTolerance)
+    {
+      return &it->second;
+    }
+    return nullptr;
+  }
+
+  template <class T>
+  void sort_table(std::vector<std::pair<double, T>> &table)
+  {
+    std::sort(table.begin(), table.end(), [](const std::pair<double, T> &lhs, const std::pair<double, T> &rhs)
+              { return lhs.first < rhs.first; });
+    return;
+  }
+}  // namespace
+
+const Rossegger::RadialTerms *Rossegger::FindRadialTerms(double r) const
+{
+  return find_in_table(radialTable, r);
+}
+
+const Rossegger::AxialTerms *Rossegger::FindAxialTerms(double z) const
+{
+  return find_in_table(axialTable, z);
+}
+
+void Rossegger::TabulateAt(const std::vector<double> &radii, const std::vector<double> &zs)
+{
+  // the cache file is specific to the geometry, the precision and the requested coordinates
+  std::ostringstream key;
+  key.precision(9);
+  for (const double r : radii)
+  {
+    key << r << ",";
+  }
+  key << ";";
+  for (const double z : zs)
+  {
+    key << z << ",";
+  }
+  uint32_t hash = 2166136261U;  // FNV-1a
+  for (const char c : key.str())
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619U;
+  }
+  std::string tablefilename = boost::str(boost::format("rosseger_tables_eps%1.0E_a%2.2f_b%2.2f_L%2.2f_%08x.root") % epsilon % a % b % L % hash);
+  TFile *fileptr = TFile::Open(tablefilename.c_str(), "READ");
+  if (fileptr)
+  {
+    fileptr->Close();
+    LoadTables(tablefilename);
+  }
+
+  int nfilled = 0;
+  for (const double r : radii)
+  {
+    if (!FindRadialTerms(r))
+    {
+      radialTable.emplace_back(r, RadialTerms());
+      FillRadialTerms(r, radialTable.back().second);
+      sort_table(radialTable);
+      nfilled++;
+    }
+  }
+  for (const double z : zs)
+  {
+    if (!FindAxialTerms(z))
+    {
+      axialTable.emplace_back(z, AxialTerms());
+      FillAxialTerms(z, axialTable.back().second);
+      sort_table(axialTable);
+      nfilled++;
+    }
+  }
+  std::cout << "Rossegger tables hold " << radialTable.size() << " radii and " << axialTable.size()
+            << " z positions, " << nfilled << " newly computed" << std::endl;
+  if (nfilled)
+  {
+    SaveTables(tablefilename);
+  }
+  return;
+}
+
+void Rossegger::SaveTables(const std::string &destfile)
+{
+  TFile *output = TFile::Open(destfile.c_str(), "RECREATE");
+  output->cd();
+
+  const int nterms = NumberOfOrders * NumberOfOrders;
+  TTree *tInfo = new TTree("info", "table parameters");
+  int ord = NumberOfOrders;
+  tInfo->Branch("order", &ord);
+  tInfo->Branch("epsilon", &epsilon);
+  tInfo->Fill();
+
+  double r;
+  RadialTerms rterms;
+  TTree *tradial = new TTree("radial", "terms depending on r");
+  tradial->Branch("r", &r);
+  tradial->Branch("rmn", &rterms.rmn[0][0], boost::str(boost::format("rmn[%d]/D") % nterms).c_str());
+  tradial->Branch("rmn1", &rterms.rmn1[0][0], boost::str(boost::format("rmn1[%d]/D") % nterms).c_str());
+  tradial->Branch("rmn2", &rterms.rmn2[0][0], boost::str(boost::format("rmn2[%d]/D") % nterms).c_str());
+  tradial->Branch("rprime_a", &rterms.rprime_a[0][0], boost::str(boost::format("rprime_a[%d]/D") % nterms).c_str());
+  tradial->Branch("rprime_b", &rterms.rprime_b[0][0], boost::str(boost::format("rprime_b[%d]/D") % nterms).c_str());
+  tradial->Branch("rnk", &rterms.rnk[0][0], boost::str(boost::format("rnk[%d]/D") % nterms).c_str());
+  for (const auto &entry : radialTable)
+  {
+    r = entry.first;
+    rterms = entry.second;
+    tradial->Fill();
+  }
+
+  double z;
+  AxialTerms zterms;
+  TTree *taxial = new TTree("axial", "terms depending on z");
+  taxial->Branch("z", &z);
+  taxial->Branch("cosh_z", &zterms.cosh_z[0][0], boost::str(boost::format("cosh_z[%d]/D") % nterms).c_str());
+  taxial->Branch("cosh_lz", &zterms.cosh_lz[0][0], boost::str(boost::format("cosh_lz[%d]/D") % nterms).c_str());
+  taxial->Branch("sinh_z", &zterms.sinh_z[0][0], boost::str(boost::format("sinh_z[%d]/D") % nterms).c_str());
+  taxial->Branch("sinh_lz", &zterms.sinh_lz[0][0], boost::str(boost::format("sinh_lz[%d]/D") % nterms).c_str());
+  taxial->Branch("sin_z", &zterms.sin_z[0], boost::str(boost::format("sin_z[%d]/D") % NumberOfOrders).c_str());
+  for (const auto &entry : axialTable)
+  {
+    z = entry.first;
+    zterms = entry.second;
+    taxial->Fill();
+  }
+
+  tInfo->Write();
+  tradial->Write();
+  taxial->Write();
+  output->Close();
+  return;
+}
+
+void Rossegger::LoadTables(const std::string &sourcefile)
+{
+  TFile *f = TFile::Open(sourcefile.c_str(), "READ");
+  std::cout << "reading rossegger tables from " << sourcefile << std::endl;
+  TTree *tInfo = (TTree *) (f->Get("info"));
+  int ord = 0;
+  double fileepsilon = 0;
+  tInfo->SetBranchAddress("order", &ord);
+  tInfo->SetBranchAddress("epsilon", &fileepsilon);
+  tInfo->GetEntry(0);
+  if (ord != NumberOfOrders || fileepsilon != epsilon)
+  {
+    std::cout << "order=" << ord << ",epsilon=" << fileepsilon << " do not match, recomputing the tables" << std::endl;
+    f->Close();
+    return;
+  }
+
+  double r;
+  RadialTerms rterms;
+  TTree *tradial = (TTree *) (f->Get("radial"));
+  tradial->SetBranchAddress("r", &r);
+  tradial->SetBranchAddress("rmn", &rterms.rmn[0][0]);
+  tradial->SetBranchAddress("rmn1", &rterms.rmn1[0][0]);
+  tradial->SetBranchAddress("rmn2", &rterms.rmn2[0][0]);
+  tradial->SetBranchAddress("rprime_a", &rterms.rprime_a[0][0]);
+  tradial->SetBranchAddress("rprime_b", &rterms.rprime_b[0][0]);
+  tradial->SetBranchAddress("rnk", &rterms.rnk[0][0]);
+  for (int i = 0; i < tradial->GetEntries(); i++)
+  {
+    tradial->GetEntry(i);
+    if (!FindRadialTerms(r))
+    {
+      radialTable.emplace_back(r, rterms);
+    }
+  }
+  sort_table(radialTable);
+
+  double z;
+  AxialTerms zterms;
+  TTree *taxial = (TTree *) (f->Get("axial"));
+  taxial->SetBranchAddress("z", &z);
+  taxial->SetBranchAddress("cosh_z", &zterms.cosh_z[0][0]);
+  taxial->SetBranchAddress("cosh_lz", &zterms.cosh_lz[0][0]);
+  taxial->SetBranchAddress("sinh_z", &zterms.sinh_z[0][0]);
+  taxial->SetBranchAddress("sinh_lz", &zterms.sinh_lz[0][0]);
+  taxial->SetBranchAddress("sin_z", &zterms.sin_z[0]);
+  for (int i = 0; i < taxial->GetEntries(); i++)
+  {
+    taxial->GetEntry(i);
+    if (!FindAxialTerms(z))
+    {
+      axialTable.emplace_back(z, zterms);
+    }
+  }
+  sort_table(axialTable);
+
+  f->Close();
+  return;
+}
+
 void Rossegger::SaveZeroes(const std::string &destfile)
 {
   TFile *output = TFile::Open(destfile.c_str(), "RECREATE");
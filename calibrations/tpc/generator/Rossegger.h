@@ -21,6 +21,8 @@
 #include <cstdio>
 #include <map>
 #include <string>
+#include <utility>
+#include <vector>
 
 class TH2;
 class TH3;
@@ -68,6 +70,11 @@ class Rossegger
   double Er_(double r, double phi, double z, double r1, double phi1, double z1);
   double Ephi_(double r, double phi, double z, double r1, double phi1, double z1);
 
+  // tabulate the series terms that depend only on r or only on z at these coordinates,
+  // read from or written to a cache file.  Ez, Er and Ephi use the tables when all their
+  // coordinates are tabulated.  Not thread safe, call before evaluating the fields in parallel.
+  void TabulateAt(const std::vector<double> &radii, const std::vector<double> &zs);
+
  protected:
   bool fByFile = false;
   double a = NAN;
@@ -115,6 +122,32 @@ class Rossegger
   double sinh_Betamn_L[NumberOfOrders][NumberOfOrders]{};   // sinh(Betamn[m][n]*L)  as in Rossegger 5.64
   double sinh_pi_Munk[NumberOfOrders][NumberOfOrders]{};    // sinh(pi*Munk[n][k]) as in Rossegger 5.66
 
+  struct RadialTerms
+  {
+    double rmn[NumberOfOrders][NumberOfOrders];       // Rmn(m,n,r)
+    double rmn1[NumberOfOrders][NumberOfOrders];      // Rmn1(m,n,r)
+    double rmn2[NumberOfOrders][NumberOfOrders];      // Rmn2(m,n,r)
+    double rprime_a[NumberOfOrders][NumberOfOrders];  // RPrime(m,n,a,r)
+    double rprime_b[NumberOfOrders][NumberOfOrders];  // RPrime(m,n,b,r)
+    double rnk[NumberOfOrders][NumberOfOrders];       // Rnk(n,k,r)
+  };
+  struct AxialTerms
+  {
+    double cosh_z[NumberOfOrders][NumberOfOrders];   // cosh(Betamn[m][n]*z)
+    double cosh_lz[NumberOfOrders][NumberOfOrders];  // cosh(Betamn[m][n]*(L-z))
+    double sinh_z[NumberOfOrders][NumberOfOrders];   // sinh(Betamn[m][n]*z)
+    double sinh_lz[NumberOfOrders][NumberOfOrders];  // sinh(Betamn[m][n]*(L-z))
+    double sin_z[NumberOfOrders];                    // sin(BetaN[n]*z)
+  };
+  void FillRadialTerms(double r, RadialTerms &terms);
+  void FillAxialTerms(double z, AxialTerms &terms);
+  const RadialTerms *FindRadialTerms(double r) const;
+  const AxialTerms *FindAxialTerms(double z) const;
+  void LoadTables(const std::string &sourcefile);
+  void SaveTables(const std::string &destfile);
+  std::vector<std::pair<double, RadialTerms>> radialTable;  // sorted by r
+  std::vector<std::pair<double, AxialTerms>> axialTable;    // sorted by z
+
   TH2 *Tags = nullptr;
   std::map<std::string, TH3 *> Grid;
 };
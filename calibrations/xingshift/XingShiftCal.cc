@@ -77,9 +77,46 @@ int XingShiftCal::InitRun(PHCompositeNode * /*topNode*/)
 
   recoConsts *rc = recoConsts::instance();
   runnumber = rc->get_IntFlag("RUNNUMBER");
+  ResetRun();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void XingShiftCal::ResetRun()
+{
+  nevt = 0;
+  threshold = 1000;
+  done = 0;
+  success = false;
+  commitSuccessCDB = 0;
+  commitSuccessSpinDB = 0;
+  xingshift = 0;
+  for (int i = 0; i < NBUNCHES; i++)
+  {
+    blueSpinPattern[i] = 0;
+    yellSpinPattern[i] = 0;
+    blueFillPattern[i] = 0;
+    yellFillPattern[i] = 0;
+    bluePcSpinPattern[i] = 0;
+    yellPcSpinPattern[i] = 0;
+    mbdns[i] = 0;
+    mbdvtx[i] = 0;
+    zdcns[i] = 0;
+  }
+  for (auto &scalercount : scalercounts)
+  {
+    for (unsigned long &j : scalercount)
+    {
+      j = 0;
+    }
+  }
+  polBlue = 0;
+  polBlueErr = 0;
+  polYellow = 0;
+  polYellowErr = 0;
+  fillnumberBlue = 0;
+  fillnumberYellow = 0;
+}
+
 int XingShiftCal::process_event(PHCompositeNode *topNode)
 {
   if (done == 1)
@@ -297,16 +334,14 @@ int XingShiftCal::ResetEvent(PHCompositeNode * /*topNode*/)
   // std::cout << "XingShiftCal::ResetEvent(PHCompositeNode *topNode) Resetting internal structures, prepare for next event" << std::endl;
   return Fun4AllReturnCodes::EVENT_OK;
 }
-/*
-int XingShiftCal::EndRun(const int runnumber)
+int XingShiftCal::EndRun(const int /*runno*/)
 {
-  std::cout << "XingShiftCal::EndRun(const int runnumber) Ending Run for Run " << runnumber << std::endl;
-  return Fun4AllReturnCodes::EVENT_OK;
-}
-*/
-int XingShiftCal::End(PHCompositeNode * /*topNode*/)
-{
-  std::cout << "XingShiftCal::End(PHCompositeNode *topNode) This is the End..." << std::endl;
+  if (nevt == 0)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  std::cout << "XingShiftCal::EndRun() Ending Run " << runnumber << std::endl;
+  nruns++;
 
   if (done)
   {
@@ -344,6 +379,18 @@ int XingShiftCal::End(PHCompositeNode * /*topNode*/)
     std::cout << "Commit to SpinDB : FAILURE" << std::endl;
   }
 
+  if (success)
+  {
+    nrunscalibrated++;
+  }
+  ResetRun();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int XingShiftCal::End(PHCompositeNode * /*topNode*/)
+{
+  std::cout << "XingShiftCal::End(PHCompositeNode *topNode) This is the End..." << std::endl;
+  std::cout << "calibrated " << nrunscalibrated << " of " << nruns << " runs" << std::endl;
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -520,73 +567,11 @@ int XingShiftCal::CommitToSpinDB()
   unsigned int qa_level = 0xffff;
 
 
-  //=============== connect to daq db to get gl1p scalers ===============
-  std::string daqdbname = "daq";
-  std::string daqdbowner = "phnxrc";
-  std::string daqdbpasswd = "";
-
-  odbc::Connection *conDAQ = nullptr;
-  try
-  {
-    conDAQ = odbc::DriverManager::getConnection(daqdbname.c_str(), daqdbowner.c_str(), daqdbpasswd.c_str());
-  }
-  catch (odbc::SQLException &eDAQ)
-  {
-    std::cout << PHWHERE
-              << " Exception caught at XingShiftCal::CommitPatternToSpinDB when connecting to DAQ DB" << std::endl;
-    std::cout << "Message: " << eDAQ.getMessage() << std::endl;
-    //commitSuccessDAQDB = 0;
-    if (conDAQ)
-    {
-      delete conDAQ;
-      conDAQ = nullptr;
-    }
-    return 0;
-  }
-
-  std::ostringstream sqlGL1PSelect;
-  sqlGL1PSelect << "SELECT index, bunch, scaled FROM gl1_pscalers"
-                << " WHERE runnumber = " << runnumber
-                << ";";
-  odbc::Statement *stmtGL1PSelect = conDAQ->createStatement();
-  odbc::ResultSet *rsGL1P = nullptr;
-  try
+  //=============== gl1p scalers from the daq db ===============
+  if (ReadGL1PScalers())
   {
-    rsGL1P = stmtGL1PSelect->executeQuery(sqlGL1PSelect.str());
-  }
-  catch (odbc::SQLException &eGL1P)
-  {
-    std::cout << PHWHERE
-              << " Exception caught at XingShiftCal::CommitPatternToSpinDB when querying DAQ DB" << std::endl;
-    std::cout << "Message: " << eGL1P.getMessage() << std::endl;
-    //commitSuccessSpinDB = 0;
-    if (conDAQ)
-    {
-      delete conDAQ;
-      conDAQ = nullptr;
-    }
     return 0;
   }
-
-
-  while (rsGL1P->next()) {
-    int index = rsGL1P->getInt("index");
-    int bunch = rsGL1P->getInt("bunch");
-    //MBD NS
-    if (index == 0)
-    {
-      mbdns[bunch] = rsGL1P->getInt("scaled");
-    }
-    else if (index == 1)
-    {
-      mbdvtx[bunch] = rsGL1P->getInt("scaled");
-    }
-    else if (index == 5)
-    {
-      zdcns[bunch] = rsGL1P->getInt("scaled");
-    }
-
-  }
   // =======================================================
   
 
@@ -907,12 +892,6 @@ int XingShiftCal::CommitToSpinDB()
   // if (verbosity) cout<<"spin db done"<<endl;
   commitSuccessSpinDB = 1;
 
-  if (conDAQ)
-  {
-    delete conDAQ;
-    conDAQ = nullptr;
-  }
-
   if (conSpin)
   {
     delete conSpin;
@@ -1228,6 +1207,95 @@ int XingShiftCal::SpinDBQA()
 }
 
 
+// fills mbdns, mbdvtx and zdcns of the current run. The scalers of all runs
+// in the run range are read with the first one, so a job processing a list
+// of runs queries the daq db once
+int XingShiftCal::ReadGL1PScalers()
+{
+  const bool inrange = (runnumber >= m_FirstRun && runnumber <= m_LastRun);
+  if (!inrange || !m_GL1PScalersRead)
+  {
+    std::string daqdbname = "daq";
+    std::string daqdbowner = "phnxrc";
+    std::string daqdbpasswd = "";
+
+    odbc::Connection *conDAQ = nullptr;
+    try
+    {
+      conDAQ = odbc::DriverManager::getConnection(daqdbname.c_str(), daqdbowner.c_str(), daqdbpasswd.c_str());
+    }
+    catch (odbc::SQLException &eDAQ)
+    {
+      std::cout << PHWHERE
+                << " Exception caught at XingShiftCal::ReadGL1PScalers when connecting to DAQ DB" << std::endl;
+      std::cout << "Message: " << eDAQ.getMessage() << std::endl;
+      return -1;
+    }
+
+    std::ostringstream sqlGL1PSelect;
+    sqlGL1PSelect << "SELECT runnumber, index, bunch, scaled FROM gl1_pscalers WHERE ";
+    if (inrange)
+    {
+      sqlGL1PSelect << "runnumber BETWEEN " << m_FirstRun << " AND " << m_LastRun
+                    << " AND index IN (0, 1, 5)";
+    }
+    else
+    {
+      sqlGL1PSelect << "runnumber = " << runnumber;
+    }
+    sqlGL1PSelect << ";";
+    odbc::Statement *stmtGL1PSelect = conDAQ->createStatement();
+    odbc::ResultSet *rsGL1P = nullptr;
+    try
+    {
+      rsGL1P = stmtGL1PSelect->executeQuery(sqlGL1PSelect.str());
+    }
+    catch (odbc::SQLException &eGL1P)
+    {
+      std::cout << PHWHERE
+                << " Exception caught at XingShiftCal::ReadGL1PScalers when querying DAQ DB" << std::endl;
+      std::cout << "Message: " << eGL1P.getMessage() << std::endl;
+      delete stmtGL1PSelect;
+      delete conDAQ;
+      return -1;
+    }
+
+    while (rsGL1P->next())
+    {
+      int index = rsGL1P->getInt("index");
+      int bunch = rsGL1P->getInt("bunch");
+      if (bunch < 0 || bunch >= NBUNCHES)
+      {
+        continue;
+      }
+      // MBD NS, MBD vertex, ZDC NS
+      int slot = (index == 0) ? 0 : (index == 1) ? 1 : (index == 5) ? 2 : -1;
+      if (slot >= 0)
+      {
+        auto &scalers = m_GL1PScalers.try_emplace(rsGL1P->getInt("runnumber")).first->second;
+        scalers[slot][bunch] = rsGL1P->getInt("scaled");
+      }
+    }
+    delete rsGL1P;
+    delete stmtGL1PSelect;
+    delete conDAQ;
+    m_GL1PScalersRead = m_GL1PScalersRead || inrange;
+  }
+
+  auto iter = m_GL1PScalers.find(runnumber);
+  for (int i = 0; i < NBUNCHES; i++)
+  {
+    mbdns[i] = (iter != m_GL1PScalers.end()) ? iter->second[0][i] : 0;
+    mbdvtx[i] = (iter != m_GL1PScalers.end()) ? iter->second[1][i] : 0;
+    zdcns[i] = (iter != m_GL1PScalers.end()) ? iter->second[2][i] : 0;
+  }
+  if (!inrange && iter != m_GL1PScalers.end())
+  {
+    m_GL1PScalers.erase(iter);
+  }
+  return 0;
+}
+
 std::string XingShiftCal::SQLArrayConstF(float x, int n)
 {
   std::ostringstream s;
@@ -5,8 +5,9 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <map>
+#include <array>
 #include <cstdint>
+#include <map>
 #include <string>
 
 class PHCompositeNode;
@@ -26,7 +27,8 @@ class XingShiftCal : public SubsysReco
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
   int ResetEvent(PHCompositeNode *topNode) override;
-  // int EndRun(const int runnumber) override;
+  //! calibrates and commits the run, a job can process several runs
+  int EndRun(const int runnumber) override;
   int End(PHCompositeNode *topNode) override;
   int Reset(PHCompositeNode * /*topNode*/) override;
 
@@ -39,7 +41,17 @@ class XingShiftCal : public SubsysReco
   int SpinDBQA();
   std::string SQLArrayConstF(float x, int n);
 
+  //! read the gl1p scalers of all runs in [first, last] with one query
+  void SetRunRange(const int first, const int last)
+  {
+    m_FirstRun = first;
+    m_LastRun = last;
+  }
+
  private:
+  void ResetRun();
+  int ReadGL1PScalers();
+
   Packet *p{nullptr};
 
   //  Packet *pBlueSpin {nullptr};
@@ -110,6 +122,15 @@ class XingShiftCal : public SubsysReco
   std::map<std::string, std::string> preset_pattern_blue;
   std::map<std::string, std::string> preset_pattern_yellow;
 
+  int m_FirstRun{0};
+  int m_LastRun{-1};
+  bool m_GL1PScalersRead{false};
+  // [run][mbdns, mbdvtx, zdcns][bunch]
+  std::map<int, std::array<std::array<int64_t, NBUNCHES>, 3>> m_GL1PScalers;
+
+  int nruns{0};
+  int nrunscalibrated{0};
+
 
 
 };
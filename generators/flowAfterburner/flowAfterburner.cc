@@ -15,10 +15,6 @@
 
 #include <phool/phool.h>
 
-#include <gsl/gsl_errno.h>
-#include <gsl/gsl_math.h>
-#include <gsl/gsl_roots.h>
-
 #include <HepMC/GenEvent.h>
 #include <HepMC/GenParticle.h>  // for GenParticle
 #include <HepMC/GenRanges.h>
@@ -30,10 +26,13 @@
 #include <CLHEP/Random/RandFlat.h>
 #include <CLHEP/Vector/LorentzVector.h>
 
+#include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdlib>  // for exit
 #include <iostream>
 #include <map>  // for map
+#include <vector>
 
 namespace CLHEP
 {
@@ -59,38 +58,37 @@ struct loaderObj
 
 loaderObj loader;
 
-double
-vn_func(double x, void *params)
+namespace
 {
-  float *par_float = (float *) params;
-  float phi_0 = par_float[0];
-  float *vn = par_float + 1;
-  float *psi_n = vn + 6;
-  double val =
-      x + 2 * (vn[0] * sin(1 * (x - psi_n[0])) / 1.0 +
-               vn[1] * sin(2 * (x - psi_n[1])) / 2.0 +
-               vn[2] * sin(3 * (x - psi_n[2])) / 3.0 +
-               vn[3] * sin(4 * (x - psi_n[3])) / 4.0 +
-               vn[4] * sin(5 * (x - psi_n[4])) / 5.0 +
-               vn[5] * sin(6 * (x - psi_n[5])) / 6.0);
-  return val - phi_0;
-}
+  // number of harmonics
+  constexpr int nharmonics = 6;
 
-double
-vn_func_derivative(double x, void *params)
-{
-  float *par_float = (float *) params;
-  float *vn = par_float + 1;
-  float *psi_n = vn + 6;
-  double val =
-      1 + 2 * (vn[0] * cos(1 * (x - psi_n[0])) / 1.0 +
-               vn[1] * cos(2 * (x - psi_n[1])) / 2.0 +
-               vn[2] * cos(3 * (x - psi_n[2])) / 3.0 +
-               vn[3] * cos(4 * (x - psi_n[3])) / 4.0 +
-               vn[4] * cos(5 * (x - psi_n[4])) / 5.0 +
-               vn[5] * cos(6 * (x - psi_n[5])) / 6.0);
-  return val;
-}
+  // converged if the Newton step is below, failed if not converged after max_iterations
+  constexpr double tolerance = 1e-10;
+  constexpr int max_iterations = 100;
+
+  // particles of the main vertex which get flow, structure of arrays
+  struct FlowParticles
+  {
+    std::vector<HepMC::GenParticle *> particle;
+    std::vector<double> pt;
+    std::vector<double> eta;
+    std::vector<double> phi_0;
+    std::array<std::vector<float>, nharmonics> vn;
+
+    void clear()
+    {
+      particle.clear();
+      pt.clear();
+      eta.clear();
+      phi_0.clear();
+      for (auto &v : vn)
+      {
+        v.clear();
+      }
+    }
+  };
+}  // namespace
 
 float psi_n[6], v1, v2, v3, v4, v5, v6;
 
@@ -205,91 +203,118 @@ void custom_vn(double /*b*/, double /*eta*/, double /*pt*/)
   v6 = 0.0015;
 }
 
-double
-AddFlowToParent(HepMC::GenEvent *event, HepMC::GenParticle *parent)
+// vn of all particles, from the selected parameterization
+void FillFlowCoefficients(FlowParticles &particles, double b)
 {
-  CLHEP::HepLorentzVector momentum(parent->momentum().px(),
-                                   parent->momentum().py(),
-                                   parent->momentum().pz(),
-                                   parent->momentum().e());
-  double pt = momentum.perp();
-  double eta = momentum.pseudoRapidity();
-  double phi_0 = momentum.phi();
+  for (size_t i = 0; i < particles.particle.size(); ++i)
+  {
+    v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
 
-  HepMC::HeavyIon *hi = event->heavy_ion();
-  double b = hi->impact_parameter();
+    // Call the appropriate function to set the vn values
+    if (algorithm == minbias_algorithm)
+    {
+      jjia_minbias_new(b, particles.eta[i], particles.pt[i]);
+    }
+    else if (algorithm == minbias_v2_algorithm)
+    {
+      jjia_minbias_new_v2only(b, particles.eta[i], particles.pt[i]);
+    }
+    else if (algorithm == custom_algorithm)
+    {
+      custom_vn(b, particles.eta[i], particles.pt[i]);
+    }
+    const float vn[nharmonics] = {v1, v2, v3, v4, v5, v6};
+    for (int n = 0; n < nharmonics; ++n)
+    {
+      particles.vn[n].push_back(vn[n]);
+    }
+  }
+}
 
-  v1 = 0, v2 = 0, v3 = 0, v4 = 0, v5 = 0, v6 = 0;
+// Solve phi + 2 sum_n vn/n sin(n (phi - psi_n)) = phi_0 for all particles at once.
+// Newton iterations in lock step over the arrays, sin(n phi) and cos(n phi) come from
+// the angle addition recurrence, so one sincos per particle and iteration is needed.
+// A step leaving the bracket [-2pi, 2pi] (the interval of the former Brent solver)
+// is replaced by bisection. Returns the shift phi - phi_0, 0 if not converged.
+void SolveAzimuthShifts(const FlowParticles &particles, std::vector<double> &phishift)
+{
+  const size_t nparticles = particles.particle.size();
 
-  // Call the appropriate function to set the vn values
-  if (algorithm == minbias_algorithm)
-  {
-    jjia_minbias_new(b, eta, pt);
-  }
-  else if (algorithm == minbias_v2_algorithm)
+  double cos_npsi[nharmonics];
+  double sin_npsi[nharmonics];
+  for (int n = 0; n < nharmonics; ++n)
   {
-    jjia_minbias_new_v2only(b, eta, pt);
-  }
-  else if (algorithm == custom_algorithm)
-  {
-    custom_vn(b, eta, pt);
+    cos_npsi[n] = cos((n + 1) * psi_n[n]);
+    sin_npsi[n] = sin((n + 1) * psi_n[n]);
   }
 
-  double phishift = 0;
+  std::vector<double> phi(particles.phi_0);
+  std::vector<double> lo(nparticles, -2 * M_PI);
+  std::vector<double> hi(nparticles, 2 * M_PI);
+  std::vector<char> converged(nparticles, 0);
 
-  const gsl_root_fsolver_type *T = gsl_root_fsolver_brent;
-  gsl_root_fsolver *s = gsl_root_fsolver_alloc(T);
-  double x_lo = -2 * M_PI, x_hi = 2 * M_PI;
-  float params[13];
-  for (float &param : params)
+  size_t nactive = nparticles;
+  for (int iter = 0; iter < max_iterations && nactive > 0; ++iter)
   {
-    param = 0;
-  }
-  gsl_function F;
-  F.function = &vn_func;
-  F.params = &params;
-  gsl_root_fsolver_set(s, &F, x_lo, x_hi);
-  int iter = 0;
-  params[0] = phi_0;
-  params[1] = v1;
-  params[2] = v2;
-  params[3] = v3;
-  params[4] = v4;
-  params[5] = v5;
-  params[6] = v6;
-  params[7] = psi_n[0];
-  params[8] = psi_n[1];
-  params[9] = psi_n[2];
-  params[10] = psi_n[3];
-  params[11] = psi_n[4];
-  params[12] = psi_n[5];
-  int status;
-  double phi;
-  do
-  {
-    iter++;
-    gsl_root_fsolver_iterate(s);
-    phi = gsl_root_fsolver_root(s);
-    x_lo = gsl_root_fsolver_x_lower(s);
-    x_hi = gsl_root_fsolver_x_upper(s);
-    status = gsl_root_test_interval(x_lo, x_hi, 0, 0.00001);
-  } while (status == GSL_CONTINUE && iter < 1000);
-  gsl_root_fsolver_free(s);
-
-  if (iter >= 1000)
-  {
-    return 0;
-  }
+    nactive = 0;
+    for (size_t i = 0; i < nparticles; ++i)
+    {
+      if (converged[i])
+      {
+        continue;
+      }
+      const double x = phi[i];
+      const double sin_x = sin(x);
+      const double cos_x = cos(x);
+      double sin_nx = sin_x;
+      double cos_nx = cos_x;
+      double f = x - particles.phi_0[i];
+      double df = 1;
+      for (int n = 0; n < nharmonics; ++n)
+      {
+        // sin(n (x - psi_n)) and cos(n (x - psi_n))
+        const double sin_n = sin_nx * cos_npsi[n] - cos_nx * sin_npsi[n];
+        const double cos_n = cos_nx * cos_npsi[n] + sin_nx * sin_npsi[n];
+        f += 2 * particles.vn[n][i] * sin_n / (n + 1);
+        df += 2 * particles.vn[n][i] * cos_n;
+
+        // advance to (n+2) x
+        const double sin_next = sin_nx * cos_x + cos_nx * sin_x;
+        cos_nx = cos_nx * cos_x - sin_nx * sin_x;
+        sin_nx = sin_next;
+      }
 
-  phishift = phi - phi_0;
+      // f grows from the lower to the upper end of the bracket
+      if (f > 0)
+      {
+        hi[i] = x;
+      }
+      else
+      {
+        lo[i] = x;
+      }
+      double next = (df > 0) ? x - f / df : lo[i] - 1;
+      if (next <= lo[i] || next >= hi[i])
+      {
+        next = 0.5 * (lo[i] + hi[i]);
+      }
+      phi[i] = next;
+      if (std::abs(next - x) < tolerance)
+      {
+        converged[i] = 1;
+      }
+      else
+      {
+        ++nactive;
+      }
+    }
+  }
 
-  if (fabs(phishift) > 1e-7)
+  phishift.resize(nparticles);
+  for (size_t i = 0; i < nparticles; ++i)
   {
-    momentum.rotateZ(phishift);  // DPM check units * Gaudi::Units::rad);
-    parent->set_momentum(momentum);
+    phishift[i] = converged[i] ? phi[i] - particles.phi_0[i] : 0;
   }
-
-  return phishift;
 }
 
 int flowAfterburner(HepMC::GenEvent *event,
@@ -324,9 +349,12 @@ int flowAfterburner(HepMC::GenEvent *event,
   // Loop over all children of this vertex
   HepMC::GenVertexParticleRange r(*mainvtx, HepMC::children);
 
+  // collect the particles from the main vertex within the implementation range,
+  // the buffers are reused from event to event
+  static FlowParticles particles;
+  particles.clear();
   for (HepMC::GenVertex::particle_iterator it = r.begin(); it != r.end(); it++)
   {
-    // Process particles from main vertex
     HepMC::GenParticle *parent = (*it);
 
     // Skip the "jets" found during the Hijing run itself
@@ -352,9 +380,31 @@ int flowAfterburner(HepMC::GenEvent *event,
       continue;
     }
 
-    // Add flow to particles from main vertex
-    double phishift = AddFlowToParent(event, parent);
-    MoveDescendantsToParent(parent, phishift);
+    particles.particle.push_back(parent);
+    particles.pt.push_back(momentum.perp());
+    particles.eta.push_back(momentum.pseudoRapidity());
+    particles.phi_0.push_back(momentum.phi());
+  }
+
+  FillFlowCoefficients(particles, hi->impact_parameter());
+
+  static std::vector<double> phishift;
+  SolveAzimuthShifts(particles, phishift);
+
+  // Add flow to particles from main vertex and rotate their descendants
+  for (size_t i = 0; i < particles.particle.size(); ++i)
+  {
+    HepMC::GenParticle *parent = particles.particle[i];
+    if (fabs(phishift[i]) > 1e-7)
+    {
+      CLHEP::HepLorentzVector momentum(parent->momentum().px(),
+                                       parent->momentum().py(),
+                                       parent->momentum().pz(),
+                                       parent->momentum().e());
+      momentum.rotateZ(phishift[i]);  // DPM check units * Gaudi::Units::rad);
+      parent->set_momentum(momentum);
+    }
+    MoveDescendantsToParent(parent, phishift[i]);
   }
 
   return 0;
@@ -1,5 +1,6 @@
 #include "Fun4AllHepMCInputManager.h"
 
+#include "PHHepMCEventQueue.h"
 #include "PHHepMCGenEvent.h"
 #include "PHHepMCGenEventMap.h"
 
@@ -28,11 +29,13 @@
 #include <TPRegexp.h>
 #include <TString.h>
 
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/filter/bzip2.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 
 #include <cmath>
 #include <cstdlib>
+#include <exception>
 #include <fstream>
 #include <iostream>
 #include <map>  // for _Rb_tree_it...
@@ -109,20 +112,34 @@ int Fun4AllHepMCInputManager::fileopen(const std::string &filenam)
     TString tstr(fname);
     TPRegexp bzip_ext(".bz2$");
     TPRegexp gzip_ext(".gz$");
+    // use boost iostream library to decompress bz2 and gzip on the fly
     if (tstr.Contains(bzip_ext))
     {
-      // use boost iosteam library to decompress bz2 on the fly
-      filestream = new std::ifstream(fname, std::ios::in | std::ios::binary);
       zinbuffer.push(boost::iostreams::bzip2_decompressor());
-      zinbuffer.push(*filestream);
+    }
+    else if (tstr.Contains(gzip_ext))
+    {
+      zinbuffer.push(boost::iostreams::gzip_decompressor());
+    }
+    if (m_MemoryMapFlag)
+    {
+      // the pages of the file are read by the kernel, no copy into a stream buffer
+      try
+      {
+        zinbuffer.push(boost::iostreams::mapped_file_source(fname));
+      }
+      catch (const std::exception &e)
+      {
+        std::cout << PHWHERE << Name() << ": cannot map " << fname << ": " << e.what() << std::endl;
+        zinbuffer.reset();
+        return -1;
+      }
       unzipstream = new std::istream(&zinbuffer);
       ascii_in = new HepMC::IO_GenEvent(*unzipstream);
     }
-    else if (tstr.Contains(gzip_ext))
+    else if (!zinbuffer.empty())
     {
-      // use boost iosream to decompress the gzip file on the fly
       filestream = new std::ifstream(fname, std::ios::in | std::ios::binary);
-      zinbuffer.push(boost::iostreams::gzip_decompressor());
       zinbuffer.push(*filestream);
       unzipstream = new std::istream(&zinbuffer);
       ascii_in = new HepMC::IO_GenEvent(*unzipstream);
@@ -132,6 +149,13 @@ int Fun4AllHepMCInputManager::fileopen(const std::string &filenam)
       // expects normal ascii hepmc file
       ascii_in = new HepMC::IO_GenEvent(fname, std::ios::in);
     }
+    if (m_ReadAheadEvents > 0)
+    {
+      HepMC::IO_GenEvent *input = ascii_in;
+      m_EventQueue = new PHHepMCEventQueue([input]
+                                           { return input->read_next_event(); },
+                                           m_ReadAheadEvents);
+    }
   }
 
   recoConsts *rc = recoConsts::instance();
@@ -191,7 +215,7 @@ int Fun4AllHepMCInputManager::run(const int /*nevents*/)
       }
       else
       {
-        evt = ascii_in->read_next_event();
+        evt = ReadNextEvent();
       }
     }
 
@@ -257,8 +281,17 @@ int Fun4AllHepMCInputManager::fileclose()
   }
   else
   {
+    // the reader thread has to stop before its input goes away
+    delete m_EventQueue;
+    m_EventQueue = nullptr;
     delete ascii_in;
     ascii_in = nullptr;
+    // drop the filters of this file, the next file pushes its own
+    zinbuffer.reset();
+    delete unzipstream;
+    unzipstream = nullptr;
+    delete filestream;
+    filestream = nullptr;
   }
   IsOpen(0);
   // if we have a file list, move next entry to top of the list
@@ -323,7 +356,7 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   int errorflag = 0;
   while (nevents > 0 && !errorflag)
   {
-    evt = ascii_in->read_next_event();
+    evt = ReadNextEvent();
     if (!evt)
     {
       std::cout << "Error after skipping " << i - nevents << std::endl;
@@ -346,6 +379,15 @@ int Fun4AllHepMCInputManager::PushBackEvents(const int i)
   return errorflag;
 }
 
+HepMC::GenEvent *Fun4AllHepMCInputManager::ReadNextEvent()
+{
+  if (m_EventQueue)
+  {
+    return m_EventQueue->next();
+  }
+  return ascii_in->read_next_event();
+}
+
 HepMC::GenEvent *
 Fun4AllHepMCInputManager::ConvertFromOscar()
 {
@@ -13,6 +13,7 @@
 #include <vector>
 
 class PHCompositeNode;
+class PHHepMCEventQueue;
 class SyncObject;
 
 // forward declaration of classes in namespace
@@ -34,6 +35,12 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   int ResetEvent() override;
   void ReadOscar(const int i) { m_ReadOscarFlag = i; }
   int ReadOscar() const { return m_ReadOscarFlag; }
+  // parse up to nevents HepMC events ahead in a separate thread (0: read on demand)
+  void ReadAhead(const unsigned int nevents) { m_ReadAheadEvents = nevents; }
+  unsigned int ReadAhead() const { return m_ReadAheadEvents; }
+  // read the input file through a memory map instead of a file stream
+  void MemoryMap(const bool b) { m_MemoryMapFlag = b; }
+  bool MemoryMap() const { return m_MemoryMapFlag; }
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
 
@@ -48,6 +55,9 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   int MyCurrentEvent(const unsigned int index = 0) const;
 
  protected:
+  // next event of the HepMC input, from the read ahead queue if enabled
+  HepMC::GenEvent *ReadNextEvent();
+
   HepMC::GenEvent *evt = nullptr;
 
   int events_total = 0;
@@ -66,6 +76,10 @@ class Fun4AllHepMCInputManager : public Fun4AllInputManager, public PHHepMCGenHe
   std::istream *unzipstream = nullptr;  // feed into HepMc
 
   int m_ReadOscarFlag = 0;
+  unsigned int m_ReadAheadEvents = 0;
+  bool m_MemoryMapFlag = false;
+
+  PHHepMCEventQueue *m_EventQueue = nullptr;
 
   std::vector<int> m_MyEvent;
 
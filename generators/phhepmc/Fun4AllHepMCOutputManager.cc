@@ -142,7 +142,8 @@ int Fun4AllHepMCOutputManager::Write(PHCompositeNode *topNode)
   }
   assert(genevt);
 
-  HepMC::GenEvent *evt = genevt->getEvent();
+  // const access, shared pile up events are not copied
+  const HepMC::GenEvent *evt = static_cast<const PHHepMCGenEvent *>(genevt)->getEvent();
   if (!evt)
   {
     cout << PHWHERE << "0 HepMC Pointer" << endl;
@@ -118,12 +118,18 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
     for (int icollision = 0; icollision < ncollisions; ++icollision)
     {
       // loop until retrieve a valid event
-      while (true)
+      while (!m_EventCacheComplete)
       {
         if (!IsOpen())
         {
           if (FileListEmpty())
           {
+            if (!m_EventCache.empty())
+            {
+              // input is exhausted, cycle through the cached events from now on
+              m_EventCacheComplete = true;
+              break;
+            }
             if (Verbosity() > 0)
             {
               std::cout << Name() << ": No Input file open" << std::endl;
@@ -151,11 +157,11 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
           }
           else
           {
-            evt = ascii_in->read_next_event();
+            evt = ReadNextEvent();
             if (evt && m_SignalEventNumber == evt->event_number())
             {
               delete evt;
-              evt = ascii_in->read_next_event();
+              evt = ReadNextEvent();
             }
           }
         }
@@ -193,7 +199,37 @@ int Fun4AllHepMCPileupInputManager::run(const int /*nevents*/, const bool skip)
           }
         }
       }  // loop until retrieve a valid event
-      if (!skip)
+      if (m_EventCacheComplete)
+      {
+        std::shared_ptr<const HepMC::GenEvent> cached = NextCachedEvent();
+        events_total++;
+        m_EventNumberMap.insert(std::make_pair(cached->event_number(), crossing_time));
+        if (!skip)
+        {
+          InsertEvent(cached, crossing_time);
+        }
+        continue;
+      }
+      if (m_EventCacheSize > 0)
+      {
+        // the event belongs to the cache from now on
+        std::shared_ptr<const HepMC::GenEvent> cached(evt);
+        evt = nullptr;
+        m_EventCache.push_back(cached);
+        if (m_EventCache.size() >= m_EventCacheSize)
+        {
+          if (Verbosity() > 0)
+          {
+            std::cout << Name() << ": cached " << m_EventCache.size() << " events, input is not read anymore" << std::endl;
+          }
+          m_EventCacheComplete = true;
+        }
+        if (!skip)
+        {
+          InsertEvent(cached, crossing_time);
+        }
+      }
+      else if (!skip)
       {
         InsertEvent(evt, crossing_time);
       }
@@ -229,11 +265,12 @@ int Fun4AllHepMCPileupInputManager::PushBackEvents(const int i)
     PHHepMCGenEventMap *geneventmap = PHHepMCGenHelper::get_geneventmap();
     for (auto iter = geneventmap->begin(); iter != geneventmap->end(); ++iter)
     {
-      if (m_EventNumberMap.find((iter->second)->getEvent()->event_number()) != m_EventNumberMap.end())
+      // const access, shared events are not copied
+      const PHHepMCGenEvent *genevent = iter->second;
+      if (m_EventNumberMap.find(genevent->getEvent()->event_number()) != m_EventNumberMap.end())
       {
         m_EventPushedBackFlag = 1;
-        HepMC::GenEvent *evttmp = (iter->second)->getEvent();
-        ascii_io << evttmp;
+        ascii_io << genevent->getEvent();
       }
     }
     return 0;
@@ -241,6 +278,24 @@ int Fun4AllHepMCPileupInputManager::PushBackEvents(const int i)
   return -1;
 }
 int Fun4AllHepMCPileupInputManager::InsertEvent(HepMC::GenEvent *evt, const double crossing_time)
+{
+  assert(evt);
+  PHHepMCGenEvent *genevent = NewGenEvent();
+  genevent->addEvent(evt);
+  PlaceGenEvent(genevent, crossing_time);
+  return 0;
+}
+
+int Fun4AllHepMCPileupInputManager::InsertEvent(const std::shared_ptr<const HepMC::GenEvent> &evt, const double crossing_time)
+{
+  assert(evt);
+  PHHepMCGenEvent *genevent = NewGenEvent();
+  genevent->addSharedEvent(evt);
+  PlaceGenEvent(genevent, crossing_time);
+  return 0;
+}
+
+PHHepMCGenEvent *Fun4AllHepMCPileupInputManager::NewGenEvent()
 {
   PHHepMCGenEventMap *geneventmap = PHHepMCGenHelper::get_geneventmap();
   PHHepMCGenEvent *genevent = nullptr;
@@ -257,10 +312,25 @@ int Fun4AllHepMCPileupInputManager::InsertEvent(HepMC::GenEvent *evt, const doub
     genevent = geneventmap->insert_background_event(get_PHHepMCGenEvent_template() );
   }
   assert(genevent);
-  assert(evt);
-  genevent->addEvent(evt);
+  return genevent;
+}
+
+void Fun4AllHepMCPileupInputManager::PlaceGenEvent(PHHepMCGenEvent *genevent, const double crossing_time)
+{
+  // the event record is not touched, vertex and boost are applied by HepMCNodeReader
   PHHepMCGenHelper::HepMC2Lab_boost_rotation_translation(genevent);
   // place to the crossing center in time
   genevent->moveVertex(0, 0, 0, crossing_time);
-  return 0;
+}
+
+std::shared_ptr<const HepMC::GenEvent> Fun4AllHepMCPileupInputManager::NextCachedEvent()
+{
+  assert(!m_EventCache.empty());
+  std::shared_ptr<const HepMC::GenEvent> cached = m_EventCache[m_EventCachePosition++ % m_EventCache.size()];
+  // same as for the input, the signal event is not used as background
+  if (cached->event_number() == m_SignalEventNumber && m_EventCache.size() > 1)
+  {
+    cached = m_EventCache[m_EventCachePosition++ % m_EventCache.size()];
+  }
+  return cached;
 }
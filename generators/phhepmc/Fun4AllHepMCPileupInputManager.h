@@ -3,10 +3,16 @@
 
 #include "Fun4AllHepMCInputManager.h"
 
+class PHHepMCGenEvent;
+
 #include <gsl/gsl_rng.h>
 
+#include <cstddef>
+
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 //! Generate pile up collisions based on beam parameter
 //! If set_embedding_id(i) with a negative number or 0, the pile up event will be inserted with increasing positive embedding_id. This is the default operation mode.
@@ -35,12 +41,23 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
   /// time between bunch crossing in ns
   void set_time_between_crossings(double nsec) { _time_between_crossings = nsec; }
 
+  /// keep the first n background events in memory and cycle through them once n events
+  /// were read or the input is exhausted, instead of parsing the input again (0: no cache).
+  /// The cached events are shared (not copied) by all crossings they are used in
+  void set_event_cache_size(unsigned int n) { m_EventCacheSize = n; }
+
   int SkipForThisManager(const int nevents) override;
   void SignalInputManager(Fun4AllHepMCInputManager *in) { m_SignalInputManager = in; }
   int PushBackEvents(const int i) override;
 
  private:
   int InsertEvent(HepMC::GenEvent *evt, const double crossing_time);
+  int InsertEvent(const std::shared_ptr<const HepMC::GenEvent> &evt, const double crossing_time);
+  PHHepMCGenEvent *NewGenEvent();
+  void PlaceGenEvent(PHHepMCGenEvent *genevent, const double crossing_time);
+
+  /// next cached event which is not the signal event
+  std::shared_ptr<const HepMC::GenEvent> NextCachedEvent();
 
   Fun4AllHepMCInputManager *m_SignalInputManager = nullptr;
   gsl_rng *RandomGenerator = nullptr;
@@ -61,6 +78,11 @@ class Fun4AllHepMCPileupInputManager : public Fun4AllHepMCInputManager
 
   bool _first_run = true;
 
+  unsigned int m_EventCacheSize = 0;
+  bool m_EventCacheComplete = false;
+  size_t m_EventCachePosition = 0;
+  std::vector<std::shared_ptr<const HepMC::GenEvent>> m_EventCache;
+
   std::map<int, double> m_EventNumberMap;
 };
 
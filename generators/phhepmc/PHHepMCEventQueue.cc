@@ -0,0 +1,79 @@
+#include "PHHepMCEventQueue.h"
+
+#include <HepMC/GenEvent.h>
+
+#include <algorithm>
+
+PHHepMCEventQueue::PHHepMCEventQueue(const std::function<HepMC::GenEvent *()> &read, const size_t depth)
+  : m_read(read)
+  , m_depth(std::max<size_t>(depth, 1))
+{
+  m_thread = std::thread(&PHHepMCEventQueue::reader, this);
+}
+
+PHHepMCEventQueue::~PHHepMCEventQueue()
+{
+  stop();
+}
+
+HepMC::GenEvent *PHHepMCEventQueue::next()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_filled_cv.wait(lock, [this]
+                   { return !m_events.empty() || m_done; });
+  if (m_events.empty())
+  {
+    return nullptr;
+  }
+  HepMC::GenEvent *evt = m_events.front();
+  m_events.pop_front();
+  m_taken_cv.notify_one();
+  return evt;
+}
+
+void PHHepMCEventQueue::stop()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_taken_cv.notify_one();
+  if (m_thread.joinable())
+  {
+    m_thread.join();
+  }
+  for (auto evt : m_events)
+  {
+    delete evt;
+  }
+  m_events.clear();
+}
+
+void PHHepMCEventQueue::reader()
+{
+  while (true)
+  {
+    {
+      // wait for room in the queue
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_taken_cv.wait(lock, [this]
+                      { return m_events.size() < m_depth || m_stop; });
+      if (m_stop)
+      {
+        break;
+      }
+    }
+    // parsing is done without holding the lock
+    HepMC::GenEvent *evt = m_read();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!evt)
+    {
+      break;
+    }
+    m_events.push_back(evt);
+    m_filled_cv.notify_one();
+  }
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_done = true;
+  m_filled_cv.notify_all();
+}
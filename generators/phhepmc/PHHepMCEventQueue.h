@@ -0,0 +1,56 @@
+#ifndef PHHEPMC_PHHEPMCEVENTQUEUE_H
+#define PHHEPMC_PHHEPMCEVENTQUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace HepMC
+{
+  class GenEvent;
+}  // namespace HepMC
+
+//! reads HepMC events ahead of their use in a separate thread
+/*!
+  The reader thread calls the given read function (e.g. IO_GenEvent::read_next_event)
+  until it returns nullptr (end of file or error) and keeps at most depth events in
+  a queue, so decompression and parsing of the next events overlap with the
+  processing of the current one. The read function must not be used by anyone
+  else while the queue is running. Events which were not taken are deleted
+  when the queue is stopped.
+*/
+class PHHepMCEventQueue
+{
+ public:
+  PHHepMCEventQueue(const std::function<HepMC::GenEvent *()> &read, const size_t depth);
+  virtual ~PHHepMCEventQueue();
+
+  PHHepMCEventQueue(const PHHepMCEventQueue &) = delete;
+  PHHepMCEventQueue &operator=(const PHHepMCEventQueue &) = delete;
+
+  //! next event (ownership goes to the caller), waits for the reader thread.
+  //! nullptr once the read function returned nullptr
+  HepMC::GenEvent *next();
+
+  //! stop and join the reader thread, delete queued events
+  void stop();
+
+ private:
+  void reader();
+
+  std::function<HepMC::GenEvent *()> m_read;
+  size_t m_depth{1};
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_filled_cv;
+  std::condition_variable m_taken_cv;
+  std::deque<HepMC::GenEvent *> m_events;
+  bool m_done{false};
+  bool m_stop{false};
+};
+
+#endif
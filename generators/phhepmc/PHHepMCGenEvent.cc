@@ -31,8 +31,7 @@ PHHepMCGenEvent::PHHepMCGenEvent(const PHHepMCGenEvent& event)
   , _collisionVertex(event.get_collision_vertex())
   , _theEvt(nullptr)
 {
-  if (event.getEvent())
-    _theEvt = new HepMC::GenEvent(*event.getEvent());
+  copyEvent(event);
   return;
 }
 
@@ -44,14 +43,14 @@ PHHepMCGenEvent& PHHepMCGenEvent::operator=(const PHHepMCGenEvent& event)
 
   _embedding_id = event.get_embedding_id();
   _isSimulated = event.is_simulated();
-  _theEvt = new HepMC::GenEvent(*event.getEvent());
+  copyEvent(event);
 
   return *this;
 }
 
 PHHepMCGenEvent::~PHHepMCGenEvent()
 {
-  delete _theEvt;
+  releaseEvent();
 }
 
 void PHHepMCGenEvent::Reset()
@@ -59,12 +58,17 @@ void PHHepMCGenEvent::Reset()
   _embedding_id = 0;
   _isSimulated = false;
   _collisionVertex.set(0, 0, 0, 0);
-  delete _theEvt;
-  _theEvt = nullptr;
+  releaseEvent();
 }
 
 HepMC::GenEvent* PHHepMCGenEvent::getEvent()
 {
+  // the caller may modify the event, which must not affect the other users of a shared event
+  if (_sharedEvt)
+  {
+    _theEvt = new HepMC::GenEvent(*_sharedEvt);
+    _sharedEvt.reset();
+  }
   return _theEvt;
 }
 
@@ -75,9 +79,8 @@ const HepMC::GenEvent* PHHepMCGenEvent::getEvent() const
 
 bool PHHepMCGenEvent::addEvent(HepMC::GenEvent* evt)
 {
-  // clean up old event if it exists,
-  // no check needed, one can delete null pointers
-  delete _theEvt;
+  // clean up old event if it exists
+  releaseEvent();
 
   _theEvt = evt;
   if (!_theEvt) return false;
@@ -86,6 +89,8 @@ bool PHHepMCGenEvent::addEvent(HepMC::GenEvent* evt)
 
 bool PHHepMCGenEvent::swapEvent(HepMC::GenEvent*& evt)
 {
+  // the caller takes ownership, so a shared event is copied first
+  getEvent();
   swap(_theEvt, evt);
 
   if (!_theEvt) return false;
@@ -97,11 +102,55 @@ bool PHHepMCGenEvent::addEvent(HepMC::GenEvent& evt)
   return addEvent(new HepMC::GenEvent(evt));
 }
 
+bool PHHepMCGenEvent::addSharedEvent(const std::shared_ptr<const HepMC::GenEvent>& evt)
+{
+  releaseEvent();
+
+  // never modified through this object, see getEvent()
+  _sharedEvt = evt;
+  _theEvt = const_cast<HepMC::GenEvent*>(evt.get());
+  if (!_theEvt) return false;
+  return true;
+}
+
 void PHHepMCGenEvent::clearEvent()
 {
+  if (_sharedEvt)
+  {
+    // no need to copy what is cleared anyway
+    HepMC::GenEvent* evt = new HepMC::GenEvent(_sharedEvt->momentum_unit(), _sharedEvt->length_unit());
+    addEvent(evt);
+    return;
+  }
   if (_theEvt) _theEvt->clear();
 }
 
+void PHHepMCGenEvent::copyEvent(const PHHepMCGenEvent& event)
+{
+  releaseEvent();
+  if (event._sharedEvt)
+  {
+    addSharedEvent(event._sharedEvt);
+  }
+  else if (event.getEvent())
+  {
+    _theEvt = new HepMC::GenEvent(*event.getEvent());
+  }
+}
+
+void PHHepMCGenEvent::releaseEvent()
+{
+  if (_sharedEvt)
+  {
+    _sharedEvt.reset();
+  }
+  else
+  {
+    delete _theEvt;
+  }
+  _theEvt = nullptr;
+}
+
 void PHHepMCGenEvent::moveVertex(double x, double y, double z, double t)
 {
   _collisionVertex.setX(_collisionVertex.x() + x);
@@ -131,7 +180,12 @@ void PHHepMCGenEvent::identify(std::ostream& os) const
 {
   os << "identify yourself: PHHepMCGenEvent Object";
   os << ", No of Particles: " << size();
-  os << ", No of Vertices:  " << vertexSize() << endl;
+  os << ", No of Vertices:  " << vertexSize();
+  if (_sharedEvt)
+  {
+    os << ", shared";
+  }
+  os << endl;
   os << " embedding_id = " << _embedding_id << endl;
   os << " isSimulated = " << _isSimulated << endl;
   os << " collisionVertex = (" << _collisionVertex.x() << "," << _collisionVertex.y() << "," << _collisionVertex.z() << ") cm, " << _collisionVertex.t() << " ns" << endl;
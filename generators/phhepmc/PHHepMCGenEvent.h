@@ -10,6 +10,7 @@
 #include <CLHEP/Vector/LorentzRotation.h>
 
 #include <iostream>  // for cout, ostream
+#include <memory>
 
 namespace HepMC
 {
@@ -33,6 +34,8 @@ class PHHepMCGenEvent : public PHObject
   }
   PHObject* CloneMe() const override { return new PHHepMCGenEvent(*this); }
 
+  //! the non const access makes a private copy of a shared event first,
+  //! use the const one if the event is only read
   HepMC::GenEvent* getEvent();
   const HepMC::GenEvent* getEvent() const;
 
@@ -104,6 +107,11 @@ class PHHepMCGenEvent : public PHObject
   bool swapEvent(HepMC::GenEvent*& evt);
   void clearEvent();
 
+  //! host an immutable HepMC event shared with other PHHepMCGenEvents (e.g. cached pile up events),
+  //! only the vertex and Lorentz transformation of this object are applied to it
+  bool addSharedEvent(const std::shared_ptr<const HepMC::GenEvent>& evt);
+  bool isSharedEvent() const { return _sharedEvt != nullptr; }
+
   //! move the collision vertex position in the Hall coordinate system, use PHENIX units of cm, ns
   virtual void moveVertex(double x, double y, double z, double t = 0);
 
@@ -131,6 +139,15 @@ class PHHepMCGenEvent : public PHObject
   //! The HEP MC record from event generator. Note the units are recorded in GenEvent
   HepMC::GenEvent* _theEvt;
 
+  //! owner of _theEvt if the event is shared, _theEvt is not deleted in this case
+  std::shared_ptr<const HepMC::GenEvent> _sharedEvt;  //! transient
+
+  //! copy or share the event of another object
+  void copyEvent(const PHHepMCGenEvent& event);
+
+  //! delete or release the event
+  void releaseEvent();
+
   ClassDefOverride(PHHepMCGenEvent, 5)
 };
 
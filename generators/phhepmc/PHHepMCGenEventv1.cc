@@ -37,7 +37,7 @@ PHHepMCGenEventv1& PHHepMCGenEventv1::operator=(const PHHepMCGenEventv1& event)
 
   _embedding_id = event.get_embedding_id();
   _isSimulated = event.is_simulated();
-  _theEvt = new HepMC::GenEvent(*event.getEvent());
+  copyEvent(event);
 
   return *this;
 }
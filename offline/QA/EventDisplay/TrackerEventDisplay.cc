@@ -27,9 +27,9 @@
 #include <phool/recoConsts.h>
 
 #include <TVector3.h>
-#include <boost/format.hpp>
 #include <boost/math/special_functions/sign.hpp>
 
+#include <charconv>
 #include <cmath>
 #include <iomanip>
 #include <iostream>
@@ -41,6 +41,73 @@
 #include <utility>
 #include <vector>
 
+namespace
+{
+  // writes the { "x": , "y": , "z": , "e": } display points to a block buffer,
+  // which is written to the file when full
+  class PointWriter
+  {
+   public:
+    explicit PointWriter(std::ofstream& out)
+      : m_out(out)
+    {
+      m_buffer.reserve(block_size + 256);
+    }
+
+    ~PointWriter() { flush(); }
+
+    PointWriter(const PointWriter&) = delete;
+    PointWriter& operator=(const PointWriter&) = delete;
+
+    void add(float x, float y, float z, float e)
+    {
+      if (m_first)
+      {
+        m_first = false;
+      }
+      else
+      {
+        m_buffer += ',';
+      }
+      m_buffer += "{ \"x\": ";
+      append(x);
+      m_buffer += ", \"y\": ";
+      append(y);
+      m_buffer += ", \"z\": ";
+      append(z);
+      m_buffer += ", \"e\": ";
+      append(e);
+      m_buffer += '}';
+
+      if (m_buffer.size() > block_size)
+      {
+        flush();
+      }
+    }
+
+    void flush()
+    {
+      m_out.write(m_buffer.data(), m_buffer.size());
+      m_buffer.clear();
+    }
+
+   private:
+    static constexpr size_t block_size = 1U << 20U;
+
+    // same text as the default stream formatting (6 significant digits)
+    void append(float value)
+    {
+      char text[32];
+      const auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, 6);
+      m_buffer.append(text, result.ptr);
+    }
+
+    std::ofstream& m_out;
+    std::string m_buffer;
+    bool m_first{true};
+  };
+}  // namespace
+
 TrackerEventDisplay::TrackerEventDisplay(const std::string& /*name*/, const std::string& filename, const std::string& runnumber, const std::string& date)
   : SubsysReco("TrackerEventDisplay")
   , _filename(filename)
@@ -58,7 +125,10 @@ int TrackerEventDisplay::Init(PHCompositeNode* /*topNode*/)
 
 int TrackerEventDisplay::process_event(PHCompositeNode* topNode)
 {
-  makeJsonFile(topNode);
+  if (_event_prescale <= 1 || _ievent % _event_prescale == 0)
+  {
+    makeJsonFile(topNode);
+  }
   ++_ievent;
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -75,6 +145,12 @@ int TrackerEventDisplay::End(PHCompositeNode* /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+unsigned int TrackerEventDisplay::get_decimation(TrkrDefs::TrkrId detector) const
+{
+  const auto iter = _decimation.find(detector);
+  return (iter == _decimation.end() || iter->second == 0) ? 1 : iter->second;
+}
+
 void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
 {
   if (Verbosity() > 1)
@@ -104,8 +180,6 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
 
   if (_hit)
   {
-    bool firstHit = true;
-
     outdata.open((_filename + "_event" + std::to_string(_ievent) + "_hits.json").c_str(), std::ofstream::out | std::ofstream::trunc);
 
     if (!outdata)
@@ -137,7 +211,11 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
 
     if (hitmap)
     {
-      TrkrHitSetContainer::ConstRange all_hitsets = hitmap->getHitSets();
+      PointWriter writer(outdata);
+      const unsigned int decimation = get_decimation(TrkrDefs::TrkrId::tpcId);
+      unsigned int count = 0;
+
+      TrkrHitSetContainer::ConstRange all_hitsets = hitmap->getHitSets(TrkrDefs::TrkrId::tpcId);
       for (TrkrHitSetContainer::ConstIterator iter = all_hitsets.first;
            iter != all_hitsets.second;
            ++iter)
@@ -150,6 +228,12 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
              hitr != hitrangei.second;
              ++hitr)
         {
+          // keep every decimation-th hit
+          if (count++ % decimation)
+          {
+            continue;
+          }
+
           TrkrDefs::hitkey hit_key = hitr->first;
           TrkrHit* hit = hitr->second;
           // float event = _ievent;
@@ -193,30 +277,7 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
             x = radius * cos(phi_center);
             y = radius * sin(phi_center);
 
-            std::stringstream spts;
-
-            if (firstHit)
-            {
-              firstHit = false;
-            }
-            else
-            {
-              spts << ",";
-            }
-
-            spts << "{ \"x\": ";
-            spts << x;
-            spts << ", \"y\": ";
-            spts << y;
-            spts << ", \"z\": ";
-            spts << z;
-            spts << ", \"e\": ";
-            spts << adc;
-            spts << "}";
-
-            outdata << (boost::format("%1%") % spts.str());
-            spts.clear();
-            spts.str("");
+            writer.add(x, y, z, adc);
           }
         }
       }
@@ -238,8 +299,6 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
 
   if (_cluster)
   {
-    bool firstHit = true;
-
     outdata.open((_filename + "_event" + std::to_string(_ievent) + "_clusters.json").c_str(), std::ofstream::out | std::ofstream::trunc);
 
     if (!outdata)
@@ -286,11 +345,24 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
 
     if (clustermap)
     {
+      PointWriter writer(outdata);
+      std::map<TrkrDefs::TrkrId, unsigned int> counts;
+
       for (const auto& hitsetkey : clustermap->getHitSetKeys())
       {
+        const auto detector = static_cast<TrkrDefs::TrkrId>(TrkrDefs::getTrkrId(hitsetkey));
+        const unsigned int decimation = get_decimation(detector);
+        unsigned int& count = counts[detector];
+
         auto range = clustermap->getClusters(hitsetkey);
         for (auto iter = range.first; iter != range.second; ++iter)
         {
+          // keep every decimation-th cluster of the detector
+          if (count++ % decimation)
+          {
+            continue;
+          }
+
           TrkrDefs::cluskey cluster_key = iter->first;
           TrkrCluster* cluster = clustermap->findCluster(cluster_key);
 
@@ -301,30 +373,7 @@ void TrackerEventDisplay::makeJsonFile(PHCompositeNode* topNode)
           float z = cglob(2);
           float adc = cluster->getAdc();
 
-          std::stringstream spts;
-
-          if (firstHit)
-          {
-            firstHit = false;
-          }
-          else
-          {
-            spts << ",";
-          }
-
-          spts << "{ \"x\": ";
-          spts << x;
-          spts << ", \"y\": ";
-          spts << y;
-          spts << ", \"z\": ";
-          spts << z;
-          spts << ", \"e\": ";
-          spts << adc;
-          spts << "}";
-
-          outdata << (boost::format("%1%") % spts.str());
-          spts.clear();
-          spts.str("");
+          writer.add(x, y, z, adc);
         }
       }
     }
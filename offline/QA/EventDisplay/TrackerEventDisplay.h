@@ -6,6 +6,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <fstream>
+#include <map>
 #include <set>
 #include <string>
 
@@ -29,12 +30,20 @@ class TrackerEventDisplay : public SubsysReco
   void makeHitsJson(bool value) { _hit = value; }
   void makeClustersJson(bool value) { _cluster = value; }
 
+  //! write the json files of every n-th event only
+  void set_event_prescale(unsigned int value) { _event_prescale = value; }
+
+  //! write every n-th hit and cluster of the detector only
+  void set_decimation(TrkrDefs::TrkrId detector, unsigned int value) { _decimation[detector] = value; }
+
  private:
   std::ofstream outdata;
 
   bool _hit{true};
   bool _cluster{false};
   unsigned int _ievent{0};
+  unsigned int _event_prescale{1};
+  std::map<TrkrDefs::TrkrId, unsigned int> _decimation;
   std::string _filename;
   std::string _runnumber;
   std::string _date;
@@ -43,6 +52,9 @@ class TrackerEventDisplay : public SubsysReco
 
   // output subroutines
   void makeJsonFile(PHCompositeNode *topNode);
+
+  // decimation of the detector, 1 if not set
+  unsigned int get_decimation(TrkrDefs::TrkrId detector) const;
 };
 
 #endif  // EVENTDISPLAY_TRACKEREVENTDISPLAY_H
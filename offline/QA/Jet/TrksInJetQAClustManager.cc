@@ -15,6 +15,13 @@
 // public methods -------------------------------------------------------------
 
 void TrksInJetQAClustManager::GetInfo(TrkrCluster* cluster, TrkrDefs::cluskey& clustKey, ActsGeometry* actsGeom)
+{
+  // get cluster position and fill histograms
+  GetInfo(actsGeom->getGlobalPosition(clustKey, cluster), clustKey);
+
+}  // end GetInfo(TrkrCluster*, TrkrDefs::cluskey&, ActsGeometry*)'
+
+void TrksInJetQAClustManager::GetInfo(const Acts::Vector3& actsPos, const TrkrDefs::cluskey clustKey)
 {
   // check which subsystem cluster is in
   const uint16_t layer = TrkrDefs::getLayer(clustKey);
@@ -22,9 +29,6 @@ void TrksInJetQAClustManager::GetInfo(TrkrCluster* cluster, TrkrDefs::cluskey& c
   const bool isIntt = IsInIntt(layer);
   const bool isTpc = IsInTpc(layer);
 
-  // get cluster position
-  Acts::Vector3 actsPos = actsGeom->getGlobalPosition(clustKey, cluster);
-
   // collect cluster info
   ClustQAContent content{
       .x = actsPos(0),
@@ -47,7 +51,7 @@ void TrksInJetQAClustManager::GetInfo(TrkrCluster* cluster, TrkrDefs::cluskey& c
     FillHistograms(Type::Tpc, content);
   }
 
-}  // end GetInfo(TrkrCluster*, TrkrDefs::cluskey&, ActsGeometry*)'
+}  // end GetInfo(Acts::Vector3&, TrkrDefs::cluskey)'
 
 // private methods ------------------------------------------------------------
 
@@ -69,6 +69,7 @@ class TrksInJetQAClustManager : public TrksInJetQABaseManager
 
   // public methods
   void GetInfo(TrkrCluster* cluster, TrkrDefs::cluskey& clustKey, ActsGeometry* actsGeom);
+  void GetInfo(const Acts::Vector3& actsPos, const TrkrDefs::cluskey clustKey);
 
  private:
   // private methods
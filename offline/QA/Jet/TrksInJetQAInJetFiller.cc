@@ -12,6 +12,10 @@
 // submodule definition
 #include "TrksInJetQAInJetFiller.h"
 
+// c++ utilities
+#include <algorithm>
+#include <cmath>
+
 // inherited public methods ---------------------------------------------------
 
 void TrksInJetQAInJetFiller::Fill(PHCompositeNode* topNode)
@@ -48,8 +52,83 @@ void TrksInJetQAInJetFiller::GetNode(const int node, PHCompositeNode* topNode)
 
 }  // end 'GetNode(int, PHCompositeNode*)'
 
+void TrksInJetQAInJetFiller::IndexTracks()
+{
+  // keep track map order, tracks in a jet are added in this order
+  m_trkList.clear();
+  for (auto& itTrk : *m_trkMap)
+  {
+    m_trkList.push_back(itTrk.second);
+  }
+
+  // get eta range of tracks
+  bool isFirst = true;
+  m_etaMin = 0.;
+  m_etaMax = 0.;
+  for (SvtxTrack* track : m_trkList)
+  {
+    const double eta = track->get_eta();
+    if (!std::isfinite(eta) || !std::isfinite(track->get_phi()))
+    {
+      continue;
+    }
+    m_etaMin = isFirst ? eta : std::min(m_etaMin, eta);
+    m_etaMax = isFirst ? eta : std::max(m_etaMax, eta);
+    isFirst = false;
+  }
+
+  // cells are at least rJet wide in eta and phi, so tracks within
+  // rJet of a jet are in the jet cell or its neighbors
+  const bool hasCells = (m_config.rJet > 0.);
+  m_nEtaCells = hasCells ? 1 + static_cast<std::size_t>((m_etaMax - m_etaMin) / m_config.rJet) : 1;
+  m_nPhiCells = hasCells ? std::max<std::size_t>(1, static_cast<std::size_t>(2. * M_PI / m_config.rJet)) : 1;
+  m_trkCells.resize(m_nEtaCells * m_nPhiCells);
+  for (auto& cell : m_trkCells)
+  {
+    cell.clear();
+  }
+
+  // bin tracks
+  for (std::size_t iTrk = 0; iTrk < m_trkList.size(); ++iTrk)
+  {
+    const double eta = m_trkList[iTrk]->get_eta();
+    const double phi = m_trkList[iTrk]->get_phi();
+    if (!std::isfinite(eta) || !std::isfinite(phi))
+    {
+      continue;
+    }
+    const std::size_t iEta = hasCells ? std::min(m_nEtaCells - 1, static_cast<std::size_t>((eta - m_etaMin) / m_config.rJet)) : 0;
+    const double phiWrap = std::remainder(phi, 2. * M_PI) + M_PI;
+    const std::size_t iPhi = std::min(m_nPhiCells - 1, static_cast<std::size_t>(phiWrap * m_nPhiCells / (2. * M_PI)));
+    m_trkCells[iEta * m_nPhiCells + iPhi].push_back(iTrk);
+  }
+  return;
+
+}  // end 'IndexTracks()'
+
+void TrksInJetQAInJetFiller::IndexPFObjects()
+{
+  // keep the first pfo of an id, as a search through the store would
+  m_pfoById.clear();
+  for (
+      ParticleFlowElementContainer::ConstIterator itFlow = m_flowStore->getParticleFlowElements().first;
+      itFlow != m_flowStore->getParticleFlowElements().second;
+      ++itFlow)
+  {
+    m_pfoById.emplace(itFlow->second->get_id(), itFlow->second);
+  }
+  m_pfoIndexed = true;
+  return;
+
+}  // end 'IndexPFObjects()'
+
 void TrksInJetQAInJetFiller::FillJetAndTrackQAHists(PHCompositeNode* topNode)
 {
+  // index tracks once per event, pfos and cluster positions on first use
+  IndexTracks();
+  m_pfoIndexed = false;
+  m_clustPos.clear();
+
   // loop over jets
   for (
       uint64_t iJet = 0;
@@ -95,13 +174,19 @@ void TrksInJetQAInJetFiller::FillClustAndHitQAHists(SvtxTrack* track)
   // get cluster keys
   for (auto clustKey : ClusKeyIter(track))
   {
-    // grab cluster and its info
+    // grab cluster and its info, clusters of tracks in several jets
+    // only need their position once
     if (m_config.doClustQA)
     {
-      m_clustManager->GetInfo(
-          m_clustMap->findCluster(clustKey),
-          clustKey,
-          m_actsGeom);
+      auto itPos = m_clustPos.find(clustKey);
+      if (itPos == m_clustPos.end())
+      {
+        itPos = m_clustPos.emplace(
+                              clustKey,
+                              m_actsGeom->getGlobalPosition(clustKey, m_clustMap->findCluster(clustKey)))
+                    .first;
+      }
+      m_clustManager->GetInfo(itPos->second, clustKey);
     }
 
     // get hits if needed
@@ -172,11 +257,46 @@ void TrksInJetQAInJetFiller::GetCstTracks(Jet* jet, PHCompositeNode* topNode)
 
 void TrksInJetQAInJetFiller::GetNonCstTracks(Jet* jet)
 {
+  // no track is within rJet of a jet without position
+  const double jetEta = jet->get_eta();
+  const double jetPhi = jet->get_phi();
+  if (!std::isfinite(jetEta) || !std::isfinite(jetPhi) || m_trkList.empty())
+  {
+    return;
+  }
+
+  // collect tracks from the cells around the jet
+  m_trkCandidates.clear();
+  const bool inEtaRange = (jetEta + m_config.rJet >= m_etaMin) && (jetEta - m_config.rJet <= m_etaMax);
+  if (inEtaRange && m_config.rJet > 0.)
+  {
+    const double etaLo = std::max(0., (jetEta - m_config.rJet - m_etaMin) / m_config.rJet);
+    const std::size_t iEtaLo = std::min(m_nEtaCells - 1, static_cast<std::size_t>(etaLo));
+    const std::size_t iEtaHi = std::min(m_nEtaCells - 1, static_cast<std::size_t>((jetEta + m_config.rJet - m_etaMin) / m_config.rJet));
+    const double phiWrap = std::remainder(jetPhi, 2. * M_PI) + M_PI;
+    const std::size_t iPhiJet = std::min(m_nPhiCells - 1, static_cast<std::size_t>(phiWrap * m_nPhiCells / (2. * M_PI)));
+    const bool allPhi = (m_nPhiCells <= 3);
+    for (std::size_t iEta = iEtaLo; iEta <= iEtaHi; ++iEta)
+    {
+      for (std::size_t iPhi = 0; iPhi < m_nPhiCells; ++iPhi)
+      {
+        const std::size_t dPhiCell = std::min((iPhi + m_nPhiCells - iPhiJet) % m_nPhiCells, (iPhiJet + m_nPhiCells - iPhi) % m_nPhiCells);
+        if (!allPhi && dPhiCell > 1)
+        {
+          continue;
+        }
+        const auto& cell = m_trkCells[iEta * m_nPhiCells + iPhi];
+        m_trkCandidates.insert(m_trkCandidates.end(), cell.begin(), cell.end());
+      }
+    }
+  }
+  std::sort(m_trkCandidates.begin(), m_trkCandidates.end());
+
   // loop over tracks
-  for (auto& itTrk : *m_trkMap)
+  for (const std::size_t iTrk : m_trkCandidates)
   {
     // grab track
-    SvtxTrack* track = itTrk.second;
+    SvtxTrack* track = m_trkList[iTrk];
 
     // ignore tracks we've already added to the list
     if (IsTrkInList(track->get_id()))
@@ -258,23 +378,17 @@ PFObject* TrksInJetQAInJetFiller::GetPFObject(const uint32_t id, PHCompositeNode
   {
     GetNode(Node::Flow, topNode);
   }
-
-  // loop over pfos
-  for (
-      ParticleFlowElementContainer::ConstIterator itFlow = m_flowStore->getParticleFlowElements().first;
-      itFlow != m_flowStore->getParticleFlowElements().second;
-      ++itFlow)
+  if (!m_pfoIndexed)
   {
-    // get pfo
-    PFObject* pfo = itFlow->second;
+    IndexPFObjects();
+  }
 
-    // if has provided id, set pointer and exit
-    if (id == pfo->get_id())
-    {
-      pfoToFind = pfo;
-      break;
-    }
-  }  // end pfo loop
+  // look up pfo with provided id
+  auto itPfo = m_pfoById.find(id);
+  if (itPfo != m_pfoById.end())
+  {
+    pfoToFind = itPfo->second;
+  }
   return pfoToFind;
 
 }  // end 'GetPFObject(uint32_t, PHCompositeNode*)'
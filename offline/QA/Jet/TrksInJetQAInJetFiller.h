@@ -41,6 +41,7 @@
 
 // c+ utilities
 #include <cassert>
+#include <unordered_map>
 #include <vector>
 
 // TrksInJetQAInJetFiller -----------------------------------------------------
@@ -64,6 +65,8 @@ class TrksInJetQAInJetFiller : public TrksInJetQABaseFiller
  private:
   // private methods
   void GetNode(const int node, PHCompositeNode* topNode);
+  void IndexTracks();
+  void IndexPFObjects();
   void FillJetAndTrackQAHists(PHCompositeNode* topNode);
   void FillClustAndHitQAHists(SvtxTrack* track);
   void GetCstTracks(Jet* jet, PHCompositeNode* topNode);
@@ -80,6 +83,20 @@ class TrksInJetQAInJetFiller : public TrksInJetQABaseFiller
   // for tracks in jet
   std::vector<SvtxTrack*> m_trksInJet;
 
+  // tracks binned in (eta, phi) once per event, cells are at least rJet wide
+  std::vector<SvtxTrack*> m_trkList;
+  std::vector<std::vector<std::size_t>> m_trkCells;
+  std::vector<std::size_t> m_trkCandidates;
+  std::size_t m_nEtaCells = 0;
+  std::size_t m_nPhiCells = 0;
+  double m_etaMin = 0.;
+  double m_etaMax = 0.;
+
+  // pfo by id, and cluster positions, once per event
+  std::unordered_map<uint32_t, PFObject*> m_pfoById;
+  bool m_pfoIndexed = false;
+  std::unordered_map<TrkrDefs::cluskey, Acts::Vector3> m_clustPos;
+
 };  // end TrksInJetQAInJetFiller
 
 #endif
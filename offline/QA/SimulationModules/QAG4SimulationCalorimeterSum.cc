@@ -89,9 +89,7 @@ int QAG4SimulationCalorimeterSum::InitRun(PHCompositeNode *topNode)
   {
     if (!_svtxevalstack)
     {
-      _svtxevalstack.reset(new SvtxEvalStack(topNode));
-      _svtxevalstack->set_strict(true);
-      _svtxevalstack->set_verbosity(Verbosity() + 1);
+      _svtxevalstack = SvtxEvalStack::get_shared(topNode, true, Verbosity() + 1);
     }
   }
   return Fun4AllReturnCodes::EVENT_OK;
@@ -123,7 +123,7 @@ class QAG4SimulationCalorimeterSum : public SubsysReco
   std::shared_ptr<CaloEvalStack> _caloevalstack_cemc;
   std::shared_ptr<CaloEvalStack> _caloevalstack_hcalin;
   std::shared_ptr<CaloEvalStack> _caloevalstack_hcalout;
-  std::shared_ptr<SvtxEvalStack> _svtxevalstack;
+  SvtxEvalStack* _svtxevalstack = nullptr;
 
   uint32_t _flags;
 
@@ -65,9 +65,7 @@ int QAG4SimulationKFParticle::InitRun(PHCompositeNode *topNode)
 {
   if (!m_svtxEvalStack)
   {
-    m_svtxEvalStack.reset(new SvtxEvalStack(topNode));
-    m_svtxEvalStack->set_strict(false);
-    m_svtxEvalStack->set_verbosity(Verbosity());
+    m_svtxEvalStack = SvtxEvalStack::get_shared(topNode, false, Verbosity());
   }
   m_trackMap = findNode::getClass<SvtxTrackMap>(topNode, m_trackMapName);
   if (!m_trackMap)
@@ -7,7 +7,6 @@
 
 #include <g4eval/SvtxEvalStack.h>
 
-#include <memory>
 #include <string>  // for string
 
 class KFParticle_Container;
@@ -54,7 +53,7 @@ class QAG4SimulationKFParticle : public SubsysReco
 
   PHG4TruthInfoContainer *m_truthContainer = nullptr;
 
-  std::unique_ptr<SvtxEvalStack> m_svtxEvalStack;
+  SvtxEvalStack* m_svtxEvalStack = nullptr;
 
   SvtxTrackMap *m_trackMap = nullptr;
   PHG4TruthInfoContainer *m_truthInfo = nullptr;
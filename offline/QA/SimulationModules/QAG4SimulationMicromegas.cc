@@ -158,10 +158,7 @@ int QAG4SimulationMicromegas::InitRun(PHCompositeNode* topNode)
 
   if (!m_svtxEvalStack)
   {
-    m_svtxEvalStack.reset(new SvtxEvalStack(topNode));
-    //    m_svtxEvalStack->set_strict(true);
-    m_svtxEvalStack->set_strict(false);
-    m_svtxEvalStack->set_verbosity(Verbosity());
+    m_svtxEvalStack = SvtxEvalStack::get_shared(topNode, false, Verbosity());
   }
 
   m_truthContainer = findNode::getClass<PHG4TruthInfoContainer>(topNode,
@@ -35,7 +35,7 @@ class QAG4SimulationMicromegas : public SubsysReco
  private:
   /// common prefix for QA histograms
   std::string get_histo_prefix() const;
-  std::unique_ptr<SvtxEvalStack> m_svtxEvalStack;
+  SvtxEvalStack* m_svtxEvalStack = nullptr;
   /// load nodes
   int load_nodes(PHCompositeNode*);
 
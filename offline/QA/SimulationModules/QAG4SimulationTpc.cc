@@ -68,9 +68,7 @@ int QAG4SimulationTpc::InitRun(PHCompositeNode* topNode)
 
   if (!m_svtxEvalStack)
   {
-    m_svtxEvalStack.reset(new SvtxEvalStack(topNode));
-    m_svtxEvalStack->set_strict(true);
-    m_svtxEvalStack->set_verbosity(Verbosity());
+    m_svtxEvalStack = SvtxEvalStack::get_shared(topNode, true, Verbosity());
   }
 
   m_truthContainer = findNode::getClass<PHG4TruthInfoContainer>(topNode,
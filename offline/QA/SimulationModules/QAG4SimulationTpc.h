@@ -9,7 +9,6 @@
 #include <fun4all/SubsysReco.h>
 
 #include <map>
-#include <memory>
 #include <set>
 #include <string>
 
@@ -37,7 +36,7 @@ class QAG4SimulationTpc : public SubsysReco
   /// common prefix for QA histograms
   std::string get_histo_prefix() const;
 
-  std::unique_ptr<SvtxEvalStack> m_svtxEvalStack;
+  SvtxEvalStack* m_svtxEvalStack = nullptr;
   PHG4TruthInfoContainer* m_truthContainer;
 
   /// load nodes
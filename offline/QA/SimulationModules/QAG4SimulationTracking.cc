@@ -55,9 +55,7 @@ int QAG4SimulationTracking::InitRun(PHCompositeNode *topNode)
 {
   if (!m_svtxEvalStack)
   {
-    m_svtxEvalStack.reset(new SvtxEvalStack(topNode));
-    m_svtxEvalStack->set_strict(false);
-    m_svtxEvalStack->set_verbosity(Verbosity());
+    m_svtxEvalStack = SvtxEvalStack::get_shared(topNode, false, Verbosity());
   }
 
   m_vertexMap = findNode::getClass<GlobalVertexMap>(topNode, "GlobalVertexMap");
@@ -7,7 +7,6 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -67,7 +66,7 @@ class QAG4SimulationTracking : public SubsysReco
   using G4HitSet = std::set<PHG4Hit *>;
   G4HitSet find_g4hits(TrkrDefs::cluskey) const;
 
-  std::unique_ptr<SvtxEvalStack> m_svtxEvalStack;
+  SvtxEvalStack* m_svtxEvalStack = nullptr;
   std::set<int> m_embeddingIDs;
 
   //! range of the truth track eta to be analyzed
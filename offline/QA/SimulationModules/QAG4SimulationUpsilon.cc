@@ -59,9 +59,7 @@ int QAG4SimulationUpsilon::InitRun(PHCompositeNode *topNode)
 
   if (!_svtxEvalStack)
   {
-    _svtxEvalStack.reset(new SvtxEvalStack(topNode));
-    _svtxEvalStack->set_strict(true);
-    _svtxEvalStack->set_verbosity(Verbosity() + 1);
+    _svtxEvalStack = SvtxEvalStack::get_shared(topNode, true, Verbosity() + 1);
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -3,7 +3,6 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -48,7 +47,7 @@ class QAG4SimulationUpsilon : public SubsysReco
   }
 
  private:
-  std::shared_ptr<SvtxEvalStack> _svtxEvalStack;
+  SvtxEvalStack* _svtxEvalStack = nullptr;
   std::set<int> m_embeddingIDs;
   std::pair<double, double> m_etaRange;
 
@@ -7,7 +7,6 @@
 
 #include <g4eval/SvtxEvalStack.h>
 
-#include <memory>
 #include <set>
 #include <string>
 
@@ -44,7 +43,7 @@ class QAG4SimulationVertex : public SubsysReco
 
   unsigned int _nlayers_maps = 3;
 
-  std::unique_ptr<SvtxEvalStack> m_svtxEvalStack;
+  SvtxEvalStack* m_svtxEvalStack = nullptr;
 
   int m_embed_id_cut = 0;
   bool m_checkembed = false;
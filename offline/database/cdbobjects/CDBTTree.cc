@@ -12,6 +12,7 @@
 #include <TSystem.h>
 #include <TTree.h>
 
+#include <algorithm>  // for minmax_element
 #include <climits>
 #include <cmath>    // for NAN, isfinite
 #include <cstdint>  // for uint64_t
@@ -19,6 +20,7 @@
 #include <limits>   // for numeric_limits, numeric_limits<>::max_digits10
 #include <set>      // for set
 #include <utility>  // for pair, make_pair
+#include <vector>
 
 CDBTTree::CDBTTree(const std::string &fname)
   : m_Filename(fname)
@@ -390,6 +392,11 @@ void CDBTTree::Print()
     }
   }
 
+  PrintColumns(m_FloatColumns, "float");
+  PrintColumns(m_DoubleColumns, "double");
+  PrintColumns(m_IntColumns, "int");
+  PrintColumns(m_UInt64Columns, "uint64");
+
   if (!m_SingleFloatEntryMap.empty())
   {
     std::cout << "Number of single float fields: " << m_SingleFloatEntryMap.size() << std::endl;
@@ -479,6 +486,10 @@ void CDBTTree::WriteCDBTTree()
 
 void CDBTTree::LoadCalibrations()
 {
+  if (m_Loaded)
+  {
+    return;
+  }
   std::string currdir = gDirectory->GetPath();
 
   if (m_Filename.empty())
@@ -568,7 +579,51 @@ void CDBTTree::LoadCalibrations()
         m_TTree[MultipleEntries]->SetBranchAddress(thisbranch->GetName(), &(itermap.first)->second);
       }
     }
-    for (auto entry = 0; entry < m_TTree[MultipleEntries]->GetEntries(); ++entry)
+    // the values of each field go into one array in entry order, the channel to
+    // entry lookup is built once afterwards
+    const auto nentries = m_TTree[MultipleEntries]->GetEntries();
+    auto intid = intvalmap.find("IID");
+    if (intid == intvalmap.end())
+    {
+      std::cout << PHWHERE << " no IID branch in " << m_TTree[MultipleEntries]->GetName()
+                << " from " << f->GetName() << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    std::vector<std::pair<const float *, std::vector<float> *>> floatcolumns;
+    for (auto &field : floatvalmap)
+    {
+      auto &column = m_FloatColumns[field.first];
+      column.reserve(nentries);
+      floatcolumns.emplace_back(&field.second, &column);
+    }
+    std::vector<std::pair<const double *, std::vector<double> *>> doublecolumns;
+    for (auto &field : doublevalmap)
+    {
+      auto &column = m_DoubleColumns[field.first];
+      column.reserve(nentries);
+      doublecolumns.emplace_back(&field.second, &column);
+    }
+    std::vector<std::pair<const int *, std::vector<int> *>> intcolumns;
+    for (auto &field : intvalmap)
+    {
+      if (field.first == "IID")
+      {
+        continue;
+      }
+      auto &column = m_IntColumns[field.first];
+      column.reserve(nentries);
+      intcolumns.emplace_back(&field.second, &column);
+    }
+    std::vector<std::pair<const uint64_t *, std::vector<uint64_t> *>> uint64columns;
+    for (auto &field : uint64valmap)
+    {
+      auto &column = m_UInt64Columns[field.first];
+      column.reserve(nentries);
+      uint64columns.emplace_back(&field.second, &column);
+    }
+    m_Channels.reserve(nentries);
+    for (auto entry = 0; entry < nentries; ++entry)
     {
       for (auto &field : floatvalmap)
       {
@@ -587,60 +642,28 @@ void CDBTTree::LoadCalibrations()
         field.second = std::numeric_limits<uint64_t>::max();
       }
       m_TTree[MultipleEntries]->GetEntry(entry);
-      int ID = intvalmap.find("IID")->second;
-      std::map<std::string, float> tmp_floatvalmap;
-      for (auto &field : floatvalmap)
+      m_Channels.push_back(intid->second);
+      // non finite values are treated as not set, as for the single entries
+      for (auto &[value, column] : floatcolumns)
       {
-        if (std::isfinite(field.second))
-        {
-          tmp_floatvalmap.insert(std::make_pair(field.first, field.second));
-        }
+        column->push_back(std::isfinite(*value) ? *value : std::numeric_limits<float>::quiet_NaN());
       }
-      if (!tmp_floatvalmap.empty())
+      for (auto &[value, column] : doublecolumns)
       {
-        m_FloatEntryMap.insert(std::make_pair(ID, tmp_floatvalmap));
+        column->push_back(std::isfinite(*value) ? *value : std::numeric_limits<double>::quiet_NaN());
       }
-
-      std::map<std::string, double> tmp_doublevalmap;
-      for (auto &field : doublevalmap)
-      {
-        if (std::isfinite(field.second))
-        {
-          tmp_doublevalmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_doublevalmap.empty())
-      {
-        m_DoubleEntryMap.insert(std::make_pair(ID, tmp_doublevalmap));
-      }
-
-      std::map<std::string, int> tmp_intvalmap;
-      for (auto &field : intvalmap)
-      {
-        if (field.second != std::numeric_limits<int>::min() && field.first != "IID")
-        {
-          tmp_intvalmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_intvalmap.empty())
+      for (auto &[value, column] : intcolumns)
       {
-        m_IntEntryMap.insert(std::make_pair(ID, tmp_intvalmap));
+        column->push_back(*value);
       }
-
-      std::map<std::string, uint64_t> tmp_uint64valmap;
-      for (auto &field : uint64valmap)
+      for (auto &[value, column] : uint64columns)
       {
-        if (field.second != std::numeric_limits<uint64_t>::max())
-        {
-          tmp_uint64valmap.insert(std::make_pair(field.first, field.second));
-        }
-      }
-      if (!tmp_uint64valmap.empty())
-      {
-        m_UInt64EntryMap.insert(std::make_pair(ID, tmp_uint64valmap));
+        column->push_back(*value);
       }
     }
+    BuildRowIndex();
   }
+  m_Loaded = true;
   for (auto ttree : m_TTree)
   {
     delete ttree;
@@ -652,7 +675,7 @@ void CDBTTree::LoadCalibrations()
 
 float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
 {
-  if (m_SingleFloatEntryMap.empty())
+  if (!m_Loaded && m_SingleFloatEntryMap.empty())
   {
     LoadCalibrations();
   }
@@ -679,36 +702,16 @@ float CDBTTree::GetSingleFloatValue(const std::string &name, int verbose)
 
 float CDBTTree::GetFloatValue(int channel, const std::string &name, int verbose)
 {
-  if (m_FloatEntryMap.empty())
+  if (!m_Loaded && m_FloatEntryMap.empty())
   {
     LoadCalibrations();
   }
-  auto channelmapiter = m_FloatEntryMap.find(channel);
-  if (channelmapiter == m_FloatEntryMap.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-		<< " for " << name << " in float calibrations" << std::endl;
-    }
-    return std::numeric_limits<float>::quiet_NaN();
-  }
-  std::string fieldname = "F" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << "Could not find " << name << " among float calibrations of channel " << channel << std::endl;
-    }
-    return std::numeric_limits<float>::quiet_NaN();
-  }
-  return calibiter->second;
+  return GetMultipleValue(m_FloatEntryMap, m_FloatColumns, channel, name, "F" + name, "float", verbose);
 }
 
 double CDBTTree::GetSingleDoubleValue(const std::string &name, int verbose)
 {
-  if (m_SingleDoubleEntryMap.empty())
+  if (!m_Loaded && m_SingleDoubleEntryMap.empty())
   {
     LoadCalibrations();
   }
@@ -735,36 +738,16 @@ double CDBTTree::GetSingleDoubleValue(const std::string &name, int verbose)
 
 double CDBTTree::GetDoubleValue(int channel, const std::string &name, int verbose)
 {
-  if (m_DoubleEntryMap.empty())
+  if (!m_Loaded && m_DoubleEntryMap.empty())
   {
     LoadCalibrations();
   }
-  auto channelmapiter = m_DoubleEntryMap.find(channel);
-  if (channelmapiter == m_DoubleEntryMap.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-		<< " for " << name << " in double calibrations" << std::endl;
-    }
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  std::string fieldname = "D" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << "Could not find " << name << " among double calibrations for channel " << channel << std::endl;
-    }
-    return std::numeric_limits<double>::quiet_NaN();
-  }
-  return calibiter->second;
+  return GetMultipleValue(m_DoubleEntryMap, m_DoubleColumns, channel, name, "D" + name, "double", verbose);
 }
 
 int CDBTTree::GetSingleIntValue(const std::string &name, int verbose)
 {
-  if (m_SingleIntEntryMap.empty())
+  if (!m_Loaded && m_SingleIntEntryMap.empty())
   {
     LoadCalibrations();
   }
@@ -791,36 +774,16 @@ int CDBTTree::GetSingleIntValue(const std::string &name, int verbose)
 
 int CDBTTree::GetIntValue(int channel, const std::string &name, int verbose)
 {
-  if (m_IntEntryMap.empty())
+  if (!m_Loaded && m_IntEntryMap.empty())
   {
     LoadCalibrations();
   }
-  auto channelmapiter = m_IntEntryMap.find(channel);
-  if (channelmapiter == m_IntEntryMap.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << PHWHERE << " Could not find channel " << channel
-		<< " for " << name << " in int calibrations" << std::endl;
-    }
-    return std::numeric_limits<int>::min();
-  }
-  std::string fieldname = "I" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
-  {
-    if (verbose > 0)
-    {
-      std::cout << "Could not find " << name << " among int calibrations for channel " << channel << std::endl;
-    }
-    return std::numeric_limits<int>::min();
-  }
-  return calibiter->second;
+  return GetMultipleValue(m_IntEntryMap, m_IntColumns, channel, name, "I" + name, "int", verbose);
 }
 
 uint64_t CDBTTree::GetSingleUInt64Value(const std::string &name, int verbose)
 {
-  if (m_SingleUInt64EntryMap.empty())
+  if (!m_Loaded && m_SingleUInt64EntryMap.empty())
   {
     LoadCalibrations();
   }
@@ -847,29 +810,171 @@ uint64_t CDBTTree::GetSingleUInt64Value(const std::string &name, int verbose)
 
 uint64_t CDBTTree::GetUInt64Value(int channel, const std::string &name, int verbose)
 {
-  if (m_UInt64EntryMap.empty())
+  if (!m_Loaded && m_UInt64EntryMap.empty())
   {
     LoadCalibrations();
   }
-  auto channelmapiter = m_UInt64EntryMap.find(channel);
-  if (channelmapiter == m_UInt64EntryMap.end())
+  return GetMultipleValue(m_UInt64EntryMap, m_UInt64Columns, channel, name, "g" + name, "uint64_t", verbose);
+}
+
+CDBTTree::Column<float> CDBTTree::GetFloatColumn(const std::string &name, int verbose)
+{
+  return GetColumn(m_FloatColumns, name, "F" + name, "float", verbose);
+}
+
+CDBTTree::Column<double> CDBTTree::GetDoubleColumn(const std::string &name, int verbose)
+{
+  return GetColumn(m_DoubleColumns, name, "D" + name, "double", verbose);
+}
+
+CDBTTree::Column<int> CDBTTree::GetIntColumn(const std::string &name, int verbose)
+{
+  return GetColumn(m_IntColumns, name, "I" + name, "int", verbose);
+}
+
+CDBTTree::Column<uint64_t> CDBTTree::GetUInt64Column(const std::string &name, int verbose)
+{
+  return GetColumn(m_UInt64Columns, name, "g" + name, "uint64_t", verbose);
+}
+
+const std::vector<int> &CDBTTree::GetChannels()
+{
+  if (!m_Loaded)
   {
-    if (verbose > 0)
+    LoadCalibrations();
+  }
+  return m_Channels;
+}
+
+void CDBTTree::BuildRowIndex()
+{
+  m_RowOfChannel.clear();
+  m_SparseRowOfChannel.clear();
+  if (m_Channels.empty())
+  {
+    return;
+  }
+  const auto [minchannel, maxchannel] = std::minmax_element(m_Channels.begin(), m_Channels.end());
+  const int64_t range = static_cast<int64_t>(*maxchannel) - *minchannel + 1;
+  // a direct lookup table unless the channel numbers are sparse (e.g. encoded tower keys)
+  if (range <= 2 * static_cast<int64_t>(m_Channels.size()) + 64)
+  {
+    m_FirstChannel = *minchannel;
+    m_RowOfChannel.assign(range, -1);
+    for (size_t row = 0; row < m_Channels.size(); ++row)
     {
-      std::cout << "Could not find channel " << channel << " in unint64 calibrations" << std::endl;
+      int &entry = m_RowOfChannel[m_Channels[row] - m_FirstChannel];
+      // like the map insert before, the first entry of a channel wins
+      if (entry < 0)
+      {
+        entry = row;
+      }
     }
-    return std::numeric_limits<uint64_t>::max();
   }
-  std::string fieldname = "g" + name;
-  auto calibiter = channelmapiter->second.find(fieldname);
-  if (calibiter == channelmapiter->second.end())
+  else
+  {
+    m_SparseRowOfChannel.reserve(m_Channels.size());
+    for (size_t row = 0; row < m_Channels.size(); ++row)
+    {
+      m_SparseRowOfChannel.emplace(m_Channels[row], row);
+    }
+  }
+}
+
+template <typename T>
+T CDBTTree::GetMultipleValue(const std::map<int, std::map<std::string, T>> &entrymap,
+                             const std::map<std::string, std::vector<T>> &columns,
+                             int channel, const std::string &name, const std::string &fieldname,
+                             const std::string &type, int verbose) const
+{
+  // values set in this job with Set...Value() but not read from file
+  if (!entrymap.empty())
+  {
+    auto channelmapiter = entrymap.find(channel);
+    if (channelmapiter == entrymap.end())
+    {
+      if (verbose > 0)
+      {
+        std::cout << PHWHERE << " Could not find channel " << channel
+                  << " for " << name << " in " << type << " calibrations" << std::endl;
+      }
+      return Column<T>::invalid_value();
+    }
+    auto calibiter = channelmapiter->second.find(fieldname);
+    if (calibiter == channelmapiter->second.end())
+    {
+      if (verbose > 0)
+      {
+        std::cout << "Could not find " << name << " among " << type << " calibrations of channel " << channel << std::endl;
+      }
+      return Column<T>::invalid_value();
+    }
+    return calibiter->second;
+  }
+
+  const int row = GetRow(channel);
+  if (row < 0)
   {
     if (verbose > 0)
     {
       std::cout << PHWHERE << " Could not find channel " << channel
-		<< " for " << name << " in uint64_t calibrations" << std::endl;
+                << " for " << name << " in " << type << " calibrations" << std::endl;
+    }
+    return Column<T>::invalid_value();
+  }
+  auto columniter = columns.find(fieldname);
+  const T value = (columniter == columns.end()) ? Column<T>::invalid_value() : columniter->second[row];
+  if (verbose > 0)
+  {
+    const bool invalid = std::is_floating_point_v<T> ? !std::isfinite(static_cast<double>(value)) : (value == Column<T>::invalid_value());
+    if (invalid)
+    {
+      std::cout << "Could not find " << name << " among " << type << " calibrations of channel " << channel << std::endl;
+    }
+  }
+  return value;
+}
+
+template <typename T>
+CDBTTree::Column<T> CDBTTree::GetColumn(const std::map<std::string, std::vector<T>> &columns,
+                                        const std::string &name, const std::string &fieldname,
+                                        const std::string &type, int verbose)
+{
+  if (!m_Loaded)
+  {
+    LoadCalibrations();
+  }
+  auto columniter = columns.find(fieldname);
+  if (columniter == columns.end())
+  {
+    if (verbose > 0)
+    {
+      std::cout << PHWHERE << " Could not find " << name << " in " << type << " calibrations" << std::endl;
+    }
+    return {};
+  }
+  return {this, &columniter->second};
+}
+
+template <typename T>
+void CDBTTree::PrintColumns(const std::map<std::string, std::vector<T>> &columns, const std::string &type) const
+{
+  if (columns.empty())
+  {
+    return;
+  }
+  std::cout << "Number of " << type << " fields: " << columns.size()
+            << " for " << m_Channels.size() << " channels" << std::endl;
+  for (size_t row = 0; row < m_Channels.size(); ++row)
+  {
+    std::cout << "ID: " << m_Channels[row] << std::endl;
+    for (const auto &column : columns)
+    {
+      std::string tmpstring = column.first;
+      tmpstring.erase(0, 1);
+      std::cout << "name " << tmpstring << " value: " << column.second[row] << std::endl;
     }
-    return std::numeric_limits<uint64_t>::max();
   }
-  return calibiter->second;
+  std::cout << "--------------------------------------------------" << std::endl
+            << std::endl;
 }
@@ -2,14 +2,68 @@
 #define CDBOBJECTS_CDBTTREE_H
 
 #include <cstdint>
+#include <limits>
 #include <map>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 class TTree;
 
 class CDBTTree
 {
  public:
+  //! read only handle on one field of the multiple entries, indexed by channel
+  /*!
+    The field name is resolved once when the column is requested, values are then
+    read from a dense typed array without string lookups. Channels without a value
+    return the same invalid value as the Get...Value() methods (NaN, INT_MIN or
+    UINT64_MAX). A column stays valid as long as its CDBTTree exists.
+  */
+  template <typename T>
+  class Column
+  {
+   public:
+    Column() = default;
+
+    //! false if the field does not exist in the payload
+    bool isValid() const { return m_Values != nullptr; }
+
+    T operator[](const int channel) const
+    {
+      const int row = isValid() ? m_Tree->GetRow(channel) : -1;
+      return (row < 0) ? invalid_value() : (*m_Values)[row];
+    }
+
+    static T invalid_value()
+    {
+      if constexpr (std::is_floating_point_v<T>)
+      {
+        return std::numeric_limits<T>::quiet_NaN();
+      }
+      else if constexpr (std::is_signed_v<T>)
+      {
+        return std::numeric_limits<T>::min();
+      }
+      else
+      {
+        return std::numeric_limits<T>::max();
+      }
+    }
+
+   private:
+    friend class CDBTTree;
+    Column(const CDBTTree *tree, const std::vector<T> *values)
+      : m_Tree(tree)
+      , m_Values(values)
+    {
+    }
+
+    const CDBTTree *m_Tree{nullptr};
+    const std::vector<T> *m_Values{nullptr};
+  };
+
   CDBTTree() = default;
   explicit CDBTTree(const std::string &fname);
   ~CDBTTree();
@@ -38,7 +92,45 @@ class CDBTTree
   uint64_t GetSingleUInt64Value(const std::string &name, int verbose = 1);
   uint64_t GetUInt64Value(int channel, const std::string &name, int verbose = 1);
 
+  //! column access to the multiple entries, loads the calibrations if needed
+  Column<float> GetFloatColumn(const std::string &name, int verbose = 1);
+  Column<double> GetDoubleColumn(const std::string &name, int verbose = 1);
+  Column<int> GetIntColumn(const std::string &name, int verbose = 1);
+  Column<uint64_t> GetUInt64Column(const std::string &name, int verbose = 1);
+
+  //! channels of the multiple entries, in the order stored in the file
+  const std::vector<int> &GetChannels();
+
  private:
+  //! row of the column arrays for this channel, -1 if it has no entry
+  int GetRow(const int channel) const
+  {
+    if (!m_RowOfChannel.empty())
+    {
+      const int64_t index = static_cast<int64_t>(channel) - m_FirstChannel;
+      return (index >= 0 && index < static_cast<int64_t>(m_RowOfChannel.size())) ? m_RowOfChannel[index] : -1;
+    }
+    auto iter = m_SparseRowOfChannel.find(channel);
+    return (iter == m_SparseRowOfChannel.end()) ? -1 : iter->second;
+  }
+
+  //! channel to row lookup, dense if the channel numbers allow it
+  void BuildRowIndex();
+
+  template <typename T>
+  T GetMultipleValue(const std::map<int, std::map<std::string, T>> &entrymap,
+                     const std::map<std::string, std::vector<T>> &columns,
+                     int channel, const std::string &name, const std::string &fieldname,
+                     const std::string &type, int verbose) const;
+
+  template <typename T>
+  Column<T> GetColumn(const std::map<std::string, std::vector<T>> &columns,
+                      const std::string &name, const std::string &fieldname,
+                      const std::string &type, int verbose);
+
+  template <typename T>
+  void PrintColumns(const std::map<std::string, std::vector<T>> &columns, const std::string &type) const;
+
   enum
   {
     SingleEntries = 0,
@@ -57,6 +149,19 @@ class CDBTTree
   std::map<std::string, int> m_SingleIntEntryMap;
   std::map<int, std::map<std::string, uint64_t>> m_UInt64EntryMap;
   std::map<std::string, uint64_t> m_SingleUInt64EntryMap;
+
+  ///@name multiple entries read from file, one array per field with one entry per channel
+  //@{
+  bool m_Loaded{false};
+  std::vector<int> m_Channels;
+  int m_FirstChannel{0};
+  std::vector<int> m_RowOfChannel;
+  std::unordered_map<int, int> m_SparseRowOfChannel;
+  std::map<std::string, std::vector<float>> m_FloatColumns;
+  std::map<std::string, std::vector<double>> m_DoubleColumns;
+  std::map<std::string, std::vector<int>> m_IntColumns;
+  std::map<std::string, std::vector<uint64_t>> m_UInt64Columns;
+  //@}
 };
 
 #endif
@@ -610,6 +610,40 @@ int PgPostBankBackupManager::commitAllBankfromTFile(const std::string &input_fil
   shared_ptr<PgPostBankBackupLog> bklog(
       static_cast<PgPostBankBackupLog *>(nullptr));
 
+  // records are inserted in transactions of commit_batch_size rows
+  // and logged once their transaction is committed
+  const bool autocommit = con->GetAutoCommit();
+  con->SetAutoCommit(false);
+  rid_list_t pending_rids;
+  auto commit_pending = [&]()
+  {
+    if (pending_rids.empty())
+    {
+      return;
+    }
+    try
+    {
+      con->Commit();
+    }
+    catch (TSQLException &e)
+    {
+      cout
+          << "PgPostBankBackupManager::commitAllBankfromTFile - Error - "
+          << " Exception caught during connection->commit()"
+          << endl;
+      cout << e.GetMessage() << endl;
+      exit(1);
+    }
+    timer_log.get()->restart();
+    for (const int pending_rid : pending_rids)
+    {
+      bklog->Log(pending_rid, PgPostBankBackupLog::kOptFile2Db);
+    }
+    timer_log.get()->stop();
+    commit_cnt += pending_rids.size();
+    pending_rids.clear();
+  };
+
   TIter next(f->GetListOfKeys());
   TObject *o = nullptr;
   while ((o = next()))
@@ -668,6 +702,7 @@ int PgPostBankBackupManager::commitAllBankfromTFile(const std::string &input_fil
         table_name = bs->get_database_header().getTableName();
 
         existing_rids = PgPostBankBackupManager::getListOfRId(table_name);
+        std::sort(existing_rids.begin(), existing_rids.end());
 
         if (Verbosity() >= 1)
         {
@@ -709,8 +744,8 @@ int PgPostBankBackupManager::commitAllBankfromTFile(const std::string &input_fil
       }
 
       const int rid = bs->get_database_header().getRId();
-      const bool existing_rid = std::find(existing_rids.begin(),
-                                          existing_rids.end(), rid) != existing_rids.end();
+      const bool existing_rid = std::binary_search(existing_rids.begin(),
+                                                   existing_rids.end(), rid);
       if (existing_rid)
       {
         if (Verbosity() >= 2)
@@ -771,25 +806,11 @@ int PgPostBankBackupManager::commitAllBankfromTFile(const std::string &input_fil
         }
         else
         {
-          try
-          {
-            con->Commit();
-          }
-          catch (TSQLException &e)
+          pending_rids.push_back(rid);
+          if (static_cast<int>(pending_rids.size()) >= commit_batch_size)
           {
-            cout
-                << "PgPostBankBackupManager::commitAllBankfromTFile - Error - "
-                << " Exception caught during connection->commit()"
-                << endl;
-            cout << e.GetMessage() << endl;
-            //      delete pstmt;
-            exit(1);
+            commit_pending();
           }
-          timer_log.get()->restart();
-          bklog->Log(rid, PgPostBankBackupLog::kOptFile2Db);
-          timer_log.get()->stop();
-
-          commit_cnt++;
         }
 
         timer_db.get()->stop();
@@ -809,6 +830,9 @@ int PgPostBankBackupManager::commitAllBankfromTFile(const std::string &input_fil
 
   }  // main loop of records
 
+  commit_pending();
+  con->SetAutoCommit(autocommit);
+
   f->Close();
 
   if (Verbosity() >= 1)
@@ -843,37 +867,89 @@ int PgPostBankBackupManager::fetchBank2TFile(const std::string &bankName,
     return 0;
   }
 
+  PgPostApplication *ap = PgPostApplication::instance();
+  assert(ap);
+  TSQLConnection *con = ap->getConnection();
+  assert(con);
+
+  // the records are read fetch_batch_size rids per query
+  // and written in the order of rid_list
   int cnt = 0;
-  for (rid_list_t::const_iterator it = rid_list.begin(); it != rid_list.end();
-       ++it)
+  for (size_t first = 0; first < rid_list.size(); first += fetch_batch_size)
   {
-    const int rid = *it;
-    if (Verbosity() >= 1)
+    const size_t last = std::min(rid_list.size(), first + fetch_batch_size);
+
+    std::ostringstream tem;
+    tem
+        << "select bankid,inserttime,startvaltime,endvaltime,description,username,calibrations,rid from "
+        << bankName << " where rid in (";
+    for (size_t i = first; i < last; ++i)
     {
-      cout << "PgPostBankBackupManager::fetchBank2TFile - Process "
-           << bankName << " at record ID " << rid << " (" << cnt << "/"
-           << rid_list.size() << ")" << endl;
+      tem << (i > first ? "," : "") << rid_list[i];
     }
+    tem << ")";
 
-    PgPostBankBackupStorage *bs = fetchBank(bankName, rid);
-
-    if (!bs)
+    if (verbosity >= 2)
     {
-      cout << "PgPostBankBackupManager::fetchBank2TFile - Error -"
-           << " nullptr PgPostBankBackupStorage object produced" << endl;
+      cout << "PgPostBankBackupManager::fetchBank2TFile - database exe : "
+           << tem.str() << endl;
     }
-    else if (!bs->isValid())
+
+    map<int, PgPostBankBackupStorage *> records;
+    TSQLStatement *stmt = con->CreateStatement();
+    stmt->SetMaxRows(last - first + 1);
     {
-      cout << "PgPostBankBackupManager::fetchBank2TFile - Error -"
-           << " invalid PgPostBankBackupStorage object produced" << endl;
-      bs->Print();
+      std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(tem.str().c_str()));
+      if (!rs)
+      {
+        cout << "PgPostBankBackupManager::fetchBank2TFile - ERROR - "
+             << " Cannot get TSQLResultSet from ExecuteQuery, exiting" << endl;
+        exit(1);
+      }
+      while (rs->Next())
+      {
+        const int rid = rs->GetInt(8);
+        PgPostBankBackupStorage *&bs = records[rid];
+        delete bs;
+        bs = SQLResultSet2BackupStorage(rs.get(), bankName);
+      }
     }
-    else
+    deleteSQLStatement(stmt);
+
+    for (size_t i = first; i < last; ++i)
     {
-      bs->Write(bs->GetName(), TObject::kWriteDelete);
+      const int rid = rid_list[i];
+      if (Verbosity() >= 1)
+      {
+        cout << "PgPostBankBackupManager::fetchBank2TFile - Process "
+             << bankName << " at record ID " << rid << " (" << cnt << "/"
+             << rid_list.size() << ")" << endl;
+      }
 
-      delete bs;
-      cnt++;
+      const auto iter = records.find(rid);
+      PgPostBankBackupStorage *bs = (iter == records.end()) ? nullptr : iter->second;
+
+      if (!bs)
+      {
+        cout << "PgPostBankBackupManager::fetchBank2TFile - Error -"
+             << " nullptr PgPostBankBackupStorage object produced" << endl;
+      }
+      else if (!bs->isValid())
+      {
+        cout << "PgPostBankBackupManager::fetchBank2TFile - Error -"
+             << " invalid PgPostBankBackupStorage object produced" << endl;
+        bs->Print();
+      }
+      else
+      {
+        bs->Write(bs->GetName(), TObject::kWriteDelete);
+        cnt++;
+      }
+    }
+
+    for (auto &record : records)
+    {
+      delete record.second;
     }
   }
 
@@ -925,30 +1001,28 @@ int PgPostBankBackupManager::fetchAllBank2TFile(const std::string &bankName,
   TSQLStatement *stmt = con->CreateStatement();
   assert(stmt);
 
-  if (verbosity >= 1)
-  {
-    cout
-        << "PgPostBankBackupManager::fetchAllBank2TFile - reset output length to row count "
-        << row_cnt << " for " << bankName << endl;
-  }
-  stmt->SetMaxRows(row_cnt + 1);
-
-  std::ostringstream tem;
-  //  std::ostringstream t2;
-  tem
-      << "select bankid,inserttime,startvaltime,endvaltime,description,username,calibrations,rid from "
-      << bankName;
-  if (record_selection.length() > 0)
-  {
-    tem << " where " << record_selection;
-  }
-  tem << "   ORDER BY rid ASC";
+  // the table is read in pages of fetch_batch_size records ordered by rid,
+  // each page starting after the last rid of the previous one. This keeps
+  // the memory bounded instead of holding the full result set
+  stmt->SetMaxRows(fetch_batch_size + 1);
 
-  if (verbosity >= 2)
+  auto page_query = [&](const bool first_page, const int last_rid)
   {
-    cout << "PgPostBankBackupManager::fetchAllBank2TFile - database exe : "
-         << tem.str() << endl;
-  }
+    std::ostringstream tem;
+    tem
+        << "select bankid,inserttime,startvaltime,endvaltime,description,username,calibrations,rid from "
+        << bankName;
+    if (record_selection.length() > 0)
+    {
+      tem << " where (" << record_selection << ")";
+    }
+    if (!first_page)
+    {
+      tem << (record_selection.length() > 0 ? " and" : " where") << " rid > " << last_rid;
+    }
+    tem << "   ORDER BY rid ASC LIMIT " << fetch_batch_size;
+    return tem.str();
+  };
 
   TDirectory *gd = gDirectory;
   TFile f;
@@ -968,22 +1042,6 @@ int PgPostBankBackupManager::fetchAllBank2TFile(const std::string &bankName,
          << file_name << endl;
   }
 
-  std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(tem.str().c_str()));
-  if (!rs || !rs.get())
-  //  TSQLResultSet * rs(stmt->ExecuteQuery(tem.str().c_str()));
-  //  if (!rs)
-  {
-    cout << "PgPostBankBackupManager::fetchAllBank2TFile - ERROR - "
-         << " Cannot get TSQLResultSet from ExecuteQuery, exiting" << endl;
-    exit(1);
-  }
-
-  //  if (verbosity >= 2)
-  //    cout << "PgPostBankBackupManager::fetchAllBank2TFile - received "
-  //        << rs->GetRowCount() << " rows"
-  ////    <<", max row = "<<
-  //        << endl;
-
   PgPostBankBackupLog bklog(bankName, tag);
   bklog.Init();
 
@@ -996,83 +1054,112 @@ int PgPostBankBackupManager::fetchAllBank2TFile(const std::string &bankName,
   PHTimeServer::timer timer_log(
       PHTimeServer::get()->insert_new("Log database"));
 
-  while (rs->Next())
+  bool first_page = true;
+  int last_rid = 0;
+  int page_cnt = fetch_batch_size;
+  while (page_cnt >= fetch_batch_size)
   {
-    PgPostBankBackupLog::enu_ops success = PgPostBankBackupLog::kOptSuccess;
-
-    timer_loop.get()->restart();
+    const std::string query = page_query(first_page, last_rid);
+    first_page = false;
+    page_cnt = 0;
 
-    if (verbosity >= 1)
+    if (verbosity >= 2)
     {
-      if (cnt % 1000 == 0)
-      {
-        cout << "PgPostBankBackupManager::fetchAllBank2TFile - processing "
-             << bankName << ": " << cnt << "/" << row_cnt << " to "
-             << file_name << endl;
-      }
+      cout << "PgPostBankBackupManager::fetchAllBank2TFile - database exe : "
+           << query << endl;
+    }
 
-      if (cnt % 10000 == 1)
-      {
-        timer_loop.get()->print_stat();
-        timer_db.get()->print_stat();
-        timer_file.get()->print_stat();
-        timer_log.get()->print_stat();
-      }
+    timer_db.get()->restart();
+    std::unique_ptr<TSQLResultSet> rs(stmt->ExecuteQuery(query.c_str()));
+    timer_db.get()->stop();
+    if (!rs)
+    {
+      cout << "PgPostBankBackupManager::fetchAllBank2TFile - ERROR - "
+           << " Cannot get TSQLResultSet from ExecuteQuery, exiting" << endl;
+      exit(1);
     }
 
-    if (file_rec_cnt >= splitting_limit)
+    while (rs->Next())
     {
-      f.Close();
-      ++file_id;
-      file_rec_cnt = 0;
-      file_name = (boost::format("%s_%04d.root") % out_file_base % file_id).str();
-      f.Open(file_name.c_str(), "recreate");
-      if (f.IsZombie())
+      ++page_cnt;
+      PgPostBankBackupLog::enu_ops success = PgPostBankBackupLog::kOptSuccess;
+
+      timer_loop.get()->restart();
+
+      if (verbosity >= 1)
       {
-        cout << "PgPostBankBackupManager::fetchAllBank2TFile - Error -"
-             << " can not open file" << file_name;
-        return 0;
+        if (cnt % 1000 == 0)
+        {
+          cout << "PgPostBankBackupManager::fetchAllBank2TFile - processing "
+               << bankName << ": " << cnt << "/" << row_cnt << " to "
+               << file_name << endl;
+        }
+
+        if (cnt % 10000 == 1)
+        {
+          timer_loop.get()->print_stat();
+          timer_db.get()->print_stat();
+          timer_file.get()->print_stat();
+          timer_log.get()->print_stat();
+        }
       }
-      if (verbosity >= 1)
+
+      if (file_rec_cnt >= splitting_limit)
       {
-        cout
-            << "PgPostBankBackupManager::fetchAllBank2TFile - writing new file  "
-            << file_name << endl;
+        f.Close();
+        ++file_id;
+        file_rec_cnt = 0;
+        file_name = (boost::format("%s_%04d.root") % out_file_base % file_id).str();
+        f.Open(file_name.c_str(), "recreate");
+        if (f.IsZombie())
+        {
+          cout << "PgPostBankBackupManager::fetchAllBank2TFile - Error -"
+               << " can not open file" << file_name;
+          return 0;
+        }
+        if (verbosity >= 1)
+        {
+          cout
+              << "PgPostBankBackupManager::fetchAllBank2TFile - writing new file  "
+              << file_name << endl;
+        }
       }
-    }
 
-    timer_db.get()->restart();
-    const int rid = rs->GetInt(8);
-    PgPostBankBackupStorage *bs = SQLResultSet2BackupStorage(rs.get(),
-                                                             bankName);
-    timer_db.get()->stop();
+      timer_db.get()->restart();
+      const int rid = rs->GetInt(8);
+      PgPostBankBackupStorage *bs = SQLResultSet2BackupStorage(rs.get(),
+                                                               bankName);
+      timer_db.get()->stop();
 
-    if (bs)
-    {
-      timer_file.get()->restart();
-      bs->Write(bs->GetName(), TObject::kWriteDelete);
-      timer_file.get()->stop();
+      if (bs)
+      {
+        timer_file.get()->restart();
+        bs->Write(bs->GetName(), TObject::kWriteDelete);
+        timer_file.get()->stop();
 
-      delete bs;
-      cnt++;
-      file_rec_cnt++;
-    }
-    else
-    {
-      success = PgPostBankBackupLog::kOptFailed;
+        delete bs;
+        cnt++;
+        file_rec_cnt++;
+      }
+      else
+      {
+        success = PgPostBankBackupLog::kOptFailed;
 
-      cout << "PgPostBankBackupManager::fetchAllBank2TFile - Error - "
-           << "invalid PgPostBankBackupStorage for row " << rs->GetRow()
-           << endl;
-    }
+        cout << "PgPostBankBackupManager::fetchAllBank2TFile - Error - "
+             << "invalid PgPostBankBackupStorage for row " << rs->GetRow()
+             << endl;
+      }
 
-    timer_log.get()->restart();
-    bklog.Log(rid,
-              (PgPostBankBackupLog::enu_ops)(success * PgPostBankBackupLog::kOptBackup2File));
-    timer_log.get()->stop();
+      timer_log.get()->restart();
+      bklog.Log(rid,
+                (PgPostBankBackupLog::enu_ops)(success * PgPostBankBackupLog::kOptBackup2File));
+      timer_log.get()->stop();
 
-    timer_loop.get()->stop();
+      timer_loop.get()->stop();
+      last_rid = rid;
+    }
   }
+  deleteSQLStatement(stmt);
 
   f.Close();
   gDirectory = gd;
@@ -15,6 +15,7 @@
 
 #include <phool/PHTimeStamp.h>
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -98,6 +99,20 @@ class PgPostBankBackupManager
     return verbosity;
   }
 
+  //! number of records read from the database per query in fetchBank2TFile and fetchAllBank2TFile
+  void
+  setFetchBatchSize(const int n)
+  {
+    fetch_batch_size = std::max(n, 1);
+  }
+
+  //! number of records inserted per transaction in commitAllBankfromTFile
+  void
+  setCommitBatchSize(const int n)
+  {
+    commit_batch_size = std::max(n, 1);
+  }
+
   static std::string
   getBankBaseName(const std::string &bank_classname);
 
@@ -120,6 +135,12 @@ class PgPostBankBackupManager
   //! The verbosity level. 0 means not verbose at all.
   int verbosity;
 
+  //! records per query when reading a table
+  int fetch_batch_size = 1000;
+
+  //! records per transaction when writing a table
+  int commit_batch_size = 1000;
+
   std::string tag;
 };
 
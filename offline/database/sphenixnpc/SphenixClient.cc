@@ -16,7 +16,17 @@ SphenixClient::SphenixClient(const std::string& gt_name)
 
 nlohmann::json SphenixClient::getPayloadIOVs(long long iov)
 {
-  return nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
+  auto iter = m_PayloadIOVCache.find(iov);
+  if (iter != m_PayloadIOVCache.end())
+  {
+    return iter->second;
+  }
+  nlohmann::json resp = nopayloadclient::NoPayloadClient::getPayloadIOVs(0, iov);
+  if (resp["code"] == 0)
+  {
+    m_PayloadIOVCache[iov] = resp;
+  }
+  return resp;
 }
 
 nlohmann::json SphenixClient::getUrl(const std::string& pl_type, long long iov)
@@ -58,9 +68,10 @@ nlohmann::json SphenixClient::getUrlDict(long long iov)
   {
     return resp;
   }
+  // same validity as getUrl(), the end of the iov is exclusive
   for (auto it = resp["msg"].begin(); it != resp["msg"].end();)
   {
-    if (it.value()["minor_iov_end"] < iov)
+    if (it.value()["minor_iov_end"] <= iov)
     {
       it = resp["msg"].erase(it);
     }
@@ -78,11 +89,13 @@ nlohmann::json SphenixClient::getUrlDict(long long iov)
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::deletePayloadIOV(const std::string& pl_type, long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::deletePayloadIOV(pl_type, 0, iov_start, 0, iov_end);
 }
 
@@ -123,12 +136,14 @@ nlohmann::json SphenixClient::lockGlobalTag(const std::string& gt_name)
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start);
 }
 
 nlohmann::json SphenixClient::insertPayload(const std::string& pl_type, const std::string& file_url,
                                             long long iov_start, long long iov_end)
 {
+  m_PayloadIOVCache.clear();
   return nopayloadclient::NoPayloadClient::insertPayload(pl_type, file_url, 0, iov_start, 0, iov_end);
 }
 
@@ -143,6 +158,7 @@ nlohmann::json SphenixClient::setGlobalTag(const std::string& gt_name)
   if (existGlobalTag(gt_name))
   {
     m_CachedGlobalTag = gt_name;
+    m_PayloadIOVCache.clear();
     return nopayloadclient::NoPayloadClient::setGlobalTag(gt_name);
   }
 
@@ -158,6 +174,7 @@ int SphenixClient::cache_set_GlobalTag(const std::string& tagname)
     return iret;
   }
   m_CachedGlobalTag = tagname;
+  m_PayloadIOVCache.clear();
   nopayloadclient::NoPayloadClient::setGlobalTag(tagname);
   bool found_gt = false;
   nlohmann::json resp = nopayloadclient::NoPayloadClient::getGlobalTags();
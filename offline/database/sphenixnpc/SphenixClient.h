@@ -5,6 +5,7 @@
 
 #include <nlohmann/json.hpp>
 
+#include <map>
 #include <set>
 #include <string>
 
@@ -40,8 +41,14 @@ class SphenixClient : public nopayloadclient::NoPayloadClient
   void Verbosity(int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
+  //! forget the cached payload iovs, they are also dropped when the global tag or its payloads change
+  void clearPayloadIOVCache() { m_PayloadIOVCache.clear(); }
+
  private:
   int m_Verbosity = 0;
+  //! successful getPayloadIOVs replies by iov. One reply covers all domains, which are
+  //! typically looked up one after the other with the same time stamp
+  std::map<long long, nlohmann::json> m_PayloadIOVCache;
   std::string m_CachedGlobalTag;
   std::set<std::string> m_DomainCache;
   std::set<std::string> m_GlobalTagCache;
@@ -1,7 +1,10 @@
 #include "CDBInterface.h"
+#include "CDBLocalCache.h"
 
 #include <sphenixnpc/SphenixClient.h>
 
+#include <nlohmann/json.hpp>
+
 #include <ffaobjects/CdbUrlSave.h>
 #include <ffaobjects/CdbUrlSavev1.h>
 
@@ -14,6 +17,7 @@
 #include <phool/PHNode.h>          // for PHNode
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
 #include <phool/PHObject.h>        // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 #include <phool/recoConsts.h>
@@ -52,6 +56,16 @@ CDBInterface::~CDBInterface()
   delete cdbclient;
 }
 
+//____________________________________________________________________________..
+int CDBInterface::InitRun(PHCompositeNode * /* topNode */)
+{
+  if (m_PrefetchEnabled)
+  {
+    Prefetch();
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 //____________________________________________________________________________..
 int CDBInterface::End(PHCompositeNode *topNode)
 {
@@ -119,41 +133,83 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
   {
     return "";
   }
-  recoConsts *rc = recoConsts::instance();
-  if (!rc->FlagExist("CDB_GLOBALTAG"))
-  {
-    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
-    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (!rc->FlagExist("TIMESTAMP"))
-  {
-    std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
-    std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
-    gSystem->Exit(1);
-  }
-  if (cdbclient == nullptr)
+  std::string globaltag;
+  uint64_t timestamp;
+  getGlobalTagAndTimeStamp(globaltag, timestamp);
+  const auto key = std::make_tuple(globaltag, domain, timestamp);
+  std::string return_url;
+  std::string local_url;
+  auto memo = m_UrlMemo.find(key);
+  if (memo != m_UrlMemo.end())
   {
-    cdbclient = new SphenixClient(rc->get_StringFlag("CDB_GLOBALTAG"));
+    // already looked up in this job or prefetched
+    return_url = memo->second.first;
+    local_url = memo->second.second;
+    if (local_url.empty() && !return_url.empty())
+    {
+      // prefetched without staging the payload
+      local_url = return_url;
+      if (m_LocalCache)
+      {
+        local_url = m_LocalCache->getPayload(return_url);
+      }
+      memo->second.second = local_url;
+    }
   }
-  uint64_t timestamp = rc->get_uint64Flag("TIMESTAMP");
-  if (Verbosity() > 0)
+  else if (m_Prefetched.find(std::make_pair(globaltag, timestamp)) != m_Prefetched.end())
   {
-    std::cout << "Global Tag: " << rc->get_StringFlag("CDB_GLOBALTAG")
-              << ", domain: " << domain
-              << ", timestamp: " << timestamp;
+    // all domains with a valid payload were prefetched, this one has none
+    if (Verbosity() > 0)
+    {
+      std::cout << "Global Tag: " << globaltag
+                << ", domain: " << domain
+                << ", timestamp: " << timestamp
+                << "... prefetched: no file found" << std::endl;
+    }
+    m_UrlMemo[key] = std::make_pair(return_url, local_url);
   }
-  std::string return_url = cdbclient->getCalibration(domain, timestamp);
-  if (Verbosity() > 0)
+  else
   {
+    if (Verbosity() > 0)
+    {
+      std::cout << "Global Tag: " << globaltag
+                << ", domain: " << domain
+                << ", timestamp: " << timestamp;
+    }
+    if (m_LocalCache)
+    {
+      return_url = m_LocalCache->getUrl(globaltag, domain, timestamp);
+    }
     if (return_url.empty())
     {
-      std::cout << "... reply: no file found" << std::endl;
+      if (cdbclient == nullptr)
+      {
+        cdbclient = new SphenixClient(globaltag);
+      }
+      return_url = cdbclient->getCalibration(domain, timestamp);
+      if (m_LocalCache)
+      {
+        m_LocalCache->putUrl(globaltag, domain, timestamp, return_url);
+      }
     }
-    else
+    if (Verbosity() > 0)
     {
-      std::cout << "... reply: " << return_url << std::endl;
+      if (return_url.empty())
+      {
+        std::cout << "... reply: no file found" << std::endl;
+      }
+      else
+      {
+        std::cout << "... reply: " << return_url << std::endl;
+      }
     }
+    // the database url is saved on the node tree, the job reads from the local copy
+    local_url = return_url;
+    if (m_LocalCache && !return_url.empty())
+    {
+      local_url = m_LocalCache->getPayload(return_url);
+    }
+    m_UrlMemo[key] = std::make_pair(return_url, local_url);
   }
   if (return_url.empty())
   {
@@ -165,5 +221,137 @@ std::string CDBInterface::getUrl(const std::string &domain, const std::string &f
     std::cout << PHWHERE << "not adding again " << domain << ", url: " << return_url
               << ", time stamp: " << timestamp << std::endl;
   }
-  return return_url;
+  return local_url.empty() ? return_url : local_url;
+}
+
+int CDBInterface::Prefetch()
+{
+  if (disable)
+  {
+    return 0;
+  }
+  std::string globaltag;
+  uint64_t timestamp;
+  getGlobalTagAndTimeStamp(globaltag, timestamp);
+  if (m_Prefetched.find(std::make_pair(globaltag, timestamp)) != m_Prefetched.end())
+  {
+    return 0;
+  }
+  if (cdbclient == nullptr)
+  {
+    cdbclient = new SphenixClient(globaltag);
+  }
+  nlohmann::json resp = cdbclient->getUrlDict(timestamp);
+  if (resp["code"] != 0)
+  {
+    std::cout << PHWHERE << " prefetch for global tag " << globaltag
+              << ", timestamp " << timestamp << " failed: " << resp["msg"] << std::endl;
+    return -1;
+  }
+  int nresolved = 0;
+  for (const auto &payload : resp["msg"].items())
+  {
+    const std::string url = payload.value();
+    const auto key = std::make_tuple(globaltag, payload.key(), timestamp);
+    // the local url is filled by the first getUrl() unless the payload is staged below
+    m_UrlMemo.emplace(key, std::make_pair(url, std::string()));
+    if (m_LocalCache)
+    {
+      m_LocalCache->putUrl(globaltag, payload.key(), timestamp, url);
+    }
+    ++nresolved;
+  }
+  m_Prefetched.insert(std::make_pair(globaltag, timestamp));
+  if (Verbosity() > 0)
+  {
+    std::cout << "CDBInterface: prefetched " << nresolved << " domains for global tag "
+              << globaltag << ", timestamp " << timestamp << std::endl;
+  }
+
+  // stage the requested payloads concurrently, copying them is usually slower than the lookup
+  if (m_LocalCache && !m_PrefetchPayloads.empty())
+  {
+    std::vector<std::pair<std::string, std::string> *> tostage;
+    for (const auto &domain : m_PrefetchPayloads)
+    {
+      auto memo = m_UrlMemo.find(std::make_tuple(globaltag, domain, timestamp));
+      if (memo != m_UrlMemo.end() && !memo->second.first.empty() && memo->second.second.empty())
+      {
+        tostage.push_back(&memo->second);
+      }
+    }
+    auto stage = [this, &tostage](size_t i)
+    { tostage[i]->second = m_LocalCache->getPayload(tostage[i]->first); };
+    if (m_PrefetchThreads != 1 && tostage.size() > 1)
+    {
+      PHThreadPool pool(m_PrefetchThreads);
+      pool.parallel_for(tostage.size(), stage);
+    }
+    else
+    {
+      for (size_t i = 0; i < tostage.size(); ++i)
+      {
+        stage(i);
+      }
+    }
+  }
+  return nresolved;
+}
+
+void CDBInterface::getGlobalTagAndTimeStamp(std::string &globaltag, uint64_t &timestamp) const
+{
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("CDB_GLOBALTAG"))
+  {
+    std::cout << PHWHERE << "CDB_GLOBALTAG flag needs to be set via" << std::endl;
+    std::cout << "rc->set_StringFlag(\"CDB_GLOBALTAG\",<global tag>)" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (!rc->FlagExist("TIMESTAMP"))
+  {
+    std::cout << PHWHERE << "TIMESTAMP flag needs to be set via" << std::endl;
+    std::cout << "rc->set_uint64Flag(\"TIMESTAMP\",<64 bit timestamp>)" << std::endl;
+    gSystem->Exit(1);
+  }
+  globaltag = rc->get_StringFlag("CDB_GLOBALTAG");
+  timestamp = rc->get_uint64Flag("TIMESTAMP");
+}
+
+void CDBInterface::SetLocalCache(const std::string &dir)
+{
+  m_LocalCache = std::make_unique<CDBLocalCache>(dir);
+  m_LocalCache->Verbosity(Verbosity());
+}
+
+void CDBInterface::SetLocalCacheMaxSize(const uint64_t bytes)
+{
+  if (!m_LocalCache)
+  {
+    std::cout << PHWHERE << " local cache not enabled, call SetLocalCache() first" << std::endl;
+    return;
+  }
+  m_LocalCache->SetMaxSize(bytes);
+}
+
+void CDBInterface::SetLocalCacheTTL(const uint64_t seconds)
+{
+  if (!m_LocalCache)
+  {
+    std::cout << PHWHERE << " local cache not enabled, call SetLocalCache() first" << std::endl;
+    return;
+  }
+  m_LocalCache->SetTTL(seconds);
+}
+
+bool CDBInterface::getProcessedPayload(const std::string &url, const std::string &name, std::vector<double> &data) const
+{
+  return m_LocalCache && m_LocalCache->getProcessed(url, name, data);
+}
+
+void CDBInterface::putProcessedPayload(const std::string &url, const std::string &name, const std::vector<double> &data) const
+{
+  if (m_LocalCache)
+  {
+    m_LocalCache->putProcessed(url, name, data);
+  }
 }
@@ -6,10 +6,15 @@
 #include <fun4all/SubsysReco.h>
 
 #include <cstdint>  // for uint64_t
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <tuple>  // for tuple
+#include <utility>
+#include <vector>
 
+class CDBLocalCache;
 class PHCompositeNode;
 class SphenixClient;
 
@@ -20,6 +25,9 @@ class CDBInterface : public SubsysReco
 
   ~CDBInterface() override;
 
+  /// Called for each new run, resolves all domains if prefetching is enabled
+  int InitRun(PHCompositeNode *topNode) override;
+
   /// Called at the end of all processing.
   int End(PHCompositeNode *topNode) override;
 
@@ -29,13 +37,55 @@ class CDBInterface : public SubsysReco
 
   std::string getUrl(const std::string &domain, const std::string &filename = "");
 
+  //! resolve the urls of all domains of the global tag for the current time stamp with a single database query
+  /*!
+    Subsequent getUrl() calls for this time stamp are answered without contacting the database,
+    domains without payload return the fallback filename as before. Payloads of the domains added
+    with AddPrefetchPayload() are staged to the local cache in parallel.
+    Returns the number of resolved domains, a negative value if the query failed, in which case
+    getUrl() falls back to one lookup per domain.
+  */
+  int Prefetch();
+  //! run Prefetch() in InitRun. Create the CDBInterface before registering the modules using it,
+  //! so its InitRun is called first
+  void EnablePrefetch(const bool b = true) { m_PrefetchEnabled = b; }
+  //! stage the payload of this domain to the local cache during Prefetch()
+  void AddPrefetchPayload(const std::string &domain) { m_PrefetchPayloads.insert(domain); }
+  //! number of threads used to stage payloads, 0 uses all cores
+  void SetPrefetchThreads(const unsigned int n) { m_PrefetchThreads = n; }
+
+  //! share lookups and payload copies with other jobs on this node through a local directory
+  void SetLocalCache(const std::string &dir);
+  //! size limit of the local payload copies in bytes, 0 means no limit
+  void SetLocalCacheMaxSize(const uint64_t bytes);
+  //! time to live of local cache entries in seconds, by default they do not expire
+  //! (CDBLocalCache::NoExpiration). 0 disables the local cache
+  void SetLocalCacheTTL(const uint64_t seconds);
+
+  //! array a module computed from a payload file in an earlier job, see CDBLocalCache::getProcessed.
+  //! False if it is not cached or the local cache is not enabled
+  bool getProcessedPayload(const std::string &url, const std::string &name, std::vector<double> &data) const;
+  //! keep an array computed from a payload file in the local cache for later jobs, if it is enabled
+  void putProcessedPayload(const std::string &url, const std::string &name, const std::vector<double> &data) const;
+
  private:
   CDBInterface(const std::string &name = "CDBInterface");
 
+  //! global tag and time stamp from recoConsts, exits if they are not set
+  void getGlobalTagAndTimeStamp(std::string &globaltag, uint64_t &timestamp) const;
+
   static CDBInterface *__instance;
   SphenixClient *cdbclient {nullptr};
   bool disable {false};
   std::set<std::tuple<std::string, std::string, uint64_t>> m_UrlVector;
+  //! database and local url of earlier lookups, keyed by global tag, domain and time stamp
+  std::map<std::tuple<std::string, std::string, uint64_t>, std::pair<std::string, std::string>> m_UrlMemo;
+  std::unique_ptr<CDBLocalCache> m_LocalCache;
+  //! global tags and time stamps for which all domains were resolved by Prefetch()
+  std::set<std::pair<std::string, uint64_t>> m_Prefetched;
+  std::set<std::string> m_PrefetchPayloads;
+  bool m_PrefetchEnabled{false};
+  unsigned int m_PrefetchThreads{1};
 };
 
 #endif  // FFAMODULES_CDBINTERFACE_H
@@ -0,0 +1,363 @@
+#include "CDBLocalCache.h"
+
+#include <phool/phool.h>
+
+#include <unistd.h>  // for getpid
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  const uint64_t fnv_offset = 14695981039346656037ULL;
+
+  //! FNV-1a hash, stable across builds and processes
+  uint64_t fnv1a(uint64_t hash, const char *data, const size_t size)
+  {
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= static_cast<unsigned char>(data[i]);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  std::string to_hex(const uint64_t hash)
+  {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+  }
+
+  std::string hash_string(const std::string &input)
+  {
+    return to_hex(fnv1a(fnv_offset, input.data(), input.size()));
+  }
+
+  //! FNV-1a hash of the content of a file, empty if it cannot be read
+  std::string hash_file(const std::string &path)
+  {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+      return "";
+    }
+    uint64_t hash = fnv_offset;
+    std::vector<char> buffer(1 << 16);
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0)
+    {
+      hash = fnv1a(hash, buffer.data(), in.gcount());
+    }
+    return in.bad() ? "" : to_hex(hash);
+  }
+
+  //! file name of a plain file url, empty for remote protocols
+  std::string local_file(const std::string &url)
+  {
+    std::string source = url;
+    const std::string file_prefix = "file://";
+    if (source.compare(0, file_prefix.size(), file_prefix) == 0)
+    {
+      source = source.substr(file_prefix.size());
+    }
+    if (source.find("://") != std::string::npos)
+    {
+      return "";
+    }
+    return source;
+  }
+
+  // processed entries are this tag, the number of values and the values
+  const char processed_tag[8] = {'C', 'D', 'B', 'P', 'R', 'O', 'C', '1'};
+
+  //! unique temporary name next to the final path
+  std::string temporary_path(const std::string &path)
+  {
+    static std::atomic<unsigned int> counter{0};
+    return path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(counter++);
+  }
+}  // namespace
+
+//____________________________________________________________________________..
+CDBLocalCache::CDBLocalCache(const std::string &dir)
+  : m_IndexDir(dir + "/index")
+  , m_PayloadDir(dir + "/payloads")
+  , m_ProcessedDir(dir + "/processed")
+{
+  std::error_code ec;
+  std::filesystem::create_directories(m_IndexDir, ec);
+  std::filesystem::create_directories(m_PayloadDir, ec);
+  std::filesystem::create_directories(m_ProcessedDir, ec);
+  if (ec)
+  {
+    std::cout << PHWHERE << " cannot create cache directory " << dir
+              << ": " << ec.message() << std::endl;
+  }
+}
+
+//____________________________________________________________________________..
+std::string CDBLocalCache::getUrl(const std::string &globaltag, const std::string &domain, const uint64_t timestamp) const
+{
+  if (!Enabled())
+  {
+    return "";
+  }
+  const std::string path = m_IndexDir + "/" + hash_string(globaltag + "\n" + domain + "\n" + std::to_string(timestamp));
+  if (!isValid(path))
+  {
+    return "";
+  }
+  std::ifstream in(path);
+  std::string url;
+  std::getline(in, url);
+  if (m_Verbosity > 0 && !url.empty())
+  {
+    std::cout << "CDBLocalCache: cached url for " << domain << ": " << url << std::endl;
+  }
+  return url;
+}
+
+//____________________________________________________________________________..
+void CDBLocalCache::putUrl(const std::string &globaltag, const std::string &domain, const uint64_t timestamp, const std::string &url) const
+{
+  if (url.empty() || !Enabled())
+  {
+    return;
+  }
+  const std::string path = m_IndexDir + "/" + hash_string(globaltag + "\n" + domain + "\n" + std::to_string(timestamp));
+  writeFile(path, url + "\n");
+}
+
+//____________________________________________________________________________..
+std::string CDBLocalCache::getPayload(const std::string &url)
+{
+  // only plain files can be staged, remote protocols are left to their own caching
+  const std::string source = Enabled() ? local_file(url) : "";
+  std::error_code ec;
+  if (source.empty() || !std::filesystem::is_regular_file(source, ec))
+  {
+    return url;
+  }
+  const auto size = std::filesystem::file_size(source, ec);
+  const auto mtime = std::filesystem::last_write_time(source, ec);
+  if (ec)
+  {
+    return url;
+  }
+
+  const std::string key = hash_string(source + "\n" + std::to_string(size) + "\n" + std::to_string(mtime.time_since_epoch().count()));
+  const std::string local = m_PayloadDir + "/" + key + "_" + std::filesystem::path(source).filename().string();
+  if (isValid(local))
+  {
+    // mark as recently used
+    std::filesystem::last_write_time(local, std::filesystem::file_time_type::clock::now(), ec);
+    return local;
+  }
+
+  // make room before adding
+  cleanup();
+
+  const std::string tmp = temporary_path(local);
+  std::filesystem::copy_file(source, tmp, std::filesystem::copy_options::overwrite_existing, ec);
+  if (!ec)
+  {
+    std::filesystem::rename(tmp, local, ec);
+  }
+  if (ec)
+  {
+    if (m_Verbosity > 0)
+    {
+      std::cout << PHWHERE << " cannot stage " << source << ": " << ec.message() << std::endl;
+    }
+    std::filesystem::remove(tmp, ec);
+    return url;
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBLocalCache: staged " << source << " to " << local << std::endl;
+  }
+  return local;
+}
+
+//____________________________________________________________________________..
+bool CDBLocalCache::getProcessed(const std::string &url, const std::string &name, std::vector<double> &data) const
+{
+  const std::string path = Enabled() ? processedPath(url, name) : "";
+  if (path.empty() || !isValid(path))
+  {
+    return false;
+  }
+  std::ifstream in(path, std::ios::binary);
+  char tag[sizeof(processed_tag)];
+  uint64_t n = 0;
+  in.read(tag, sizeof(tag));
+  in.read(reinterpret_cast<char *>(&n), sizeof(n));
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(path, ec);
+  if (!in || ec || std::memcmp(tag, processed_tag, sizeof(tag)) != 0 ||
+      size != sizeof(tag) + sizeof(n) + n * sizeof(double))
+  {
+    return false;
+  }
+  data.resize(n);
+  in.read(reinterpret_cast<char *>(data.data()), n * sizeof(double));
+  if (!in)
+  {
+    data.clear();
+    return false;
+  }
+  // mark as recently used
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+  if (m_Verbosity > 0)
+  {
+    std::cout << "CDBLocalCache: read " << name << " of " << url << " from " << path << std::endl;
+  }
+  return true;
+}
+
+//____________________________________________________________________________..
+void CDBLocalCache::putProcessed(const std::string &url, const std::string &name, const std::vector<double> &data) const
+{
+  const std::string path = Enabled() ? processedPath(url, name) : "";
+  if (path.empty())
+  {
+    return;
+  }
+  const uint64_t n = data.size();
+  std::string content(processed_tag, sizeof(processed_tag));
+  content.append(reinterpret_cast<const char *>(&n), sizeof(n));
+  content.append(reinterpret_cast<const char *>(data.data()), n * sizeof(double));
+  if (!writeFile(path, content) && m_Verbosity > 0)
+  {
+    std::cout << PHWHERE << " cannot write " << path << std::endl;
+  }
+}
+
+//____________________________________________________________________________..
+std::string CDBLocalCache::processedPath(const std::string &url, const std::string &name) const
+{
+  const std::string source = local_file(url);
+  if (source.empty())
+  {
+    return "";
+  }
+  const std::string checksum = hash_file(source);
+  if (checksum.empty())
+  {
+    return "";
+  }
+  return m_ProcessedDir + "/" + hash_string(checksum + "\n" + name);
+}
+
+//____________________________________________________________________________..
+void CDBLocalCache::cleanup()
+{
+  if (m_MaxSize == 0 && m_TTL == NoExpiration)
+  {
+    return;
+  }
+
+  std::error_code ec;
+  // processed entries are small, they only expire
+  for (const auto &entry : std::filesystem::directory_iterator(m_ProcessedDir, ec))
+  {
+    if (!isValid(entry.path().string()))
+    {
+      std::error_code entry_ec;
+      std::filesystem::remove(entry.path(), entry_ec);
+    }
+  }
+
+  // (last write time, size, path) of all payload copies
+  std::vector<std::tuple<std::filesystem::file_time_type, uint64_t, std::filesystem::path>> entries;
+  uint64_t total = 0;
+  for (const auto &entry : std::filesystem::directory_iterator(m_PayloadDir, ec))
+  {
+    std::error_code entry_ec;
+    if (!entry.is_regular_file(entry_ec))
+    {
+      continue;
+    }
+    const auto time = entry.last_write_time(entry_ec);
+    const auto size = entry.file_size(entry_ec);
+    if (entry_ec)
+    {
+      continue;
+    }
+    if (!isValid(entry.path().string()))
+    {
+      std::filesystem::remove(entry.path(), entry_ec);
+      continue;
+    }
+    entries.emplace_back(time, size, entry.path());
+    total += size;
+  }
+
+  if (m_MaxSize == 0 || total <= m_MaxSize)
+  {
+    return;
+  }
+
+  // least recently used first
+  std::sort(entries.begin(), entries.end());
+  for (const auto &[time, size, path] : entries)
+  {
+    if (total <= m_MaxSize)
+    {
+      break;
+    }
+    std::error_code entry_ec;
+    if (std::filesystem::remove(path, entry_ec))
+    {
+      total -= size;
+    }
+  }
+}
+
+//____________________________________________________________________________..
+bool CDBLocalCache::isValid(const std::string &path) const
+{
+  std::error_code ec;
+  const auto time = std::filesystem::last_write_time(path, ec);
+  if (ec)
+  {
+    return false;
+  }
+  if (m_TTL == NoExpiration)
+  {
+    return true;
+  }
+  const auto age = std::filesystem::file_time_type::clock::now() - time;
+  return age < std::chrono::seconds(m_TTL);
+}
+
+//____________________________________________________________________________..
+bool CDBLocalCache::writeFile(const std::string &path, const std::string &content) const
+{
+  const std::string tmp = temporary_path(path);
+  {
+    std::ofstream out(tmp, std::ios::binary);
+    out << content;
+    if (!out)
+    {
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, path, ec);
+  if (ec)
+  {
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  return true;
+}
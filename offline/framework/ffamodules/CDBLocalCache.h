@@ -0,0 +1,88 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAMODULES_CDBLOCALCACHE_H
+#define FFAMODULES_CDBLOCALCACHE_H
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+//! node local cache of CDB lookups and payload files, shared by all jobs using the same directory
+/*!
+  Three kinds of entries are kept below the cache directory:
+  - index/: the payload url returned for a (global tag, domain, time stamp) lookup,
+    so jobs of the same run do not need to query the conditions database again.
+    Entries older than the time to live are ignored and refreshed, a time
+    to live of 0 switches the cache off.
+  - payloads/: local copies of payload files, named after a hash of the source url,
+    size and modification time, so a changed source file gets a new entry.
+    Least recently used copies are removed when the cache exceeds its size limit,
+    and copies not used for longer than the time to live are removed.
+  - processed/: arrays modules compute from a payload file (e.g. a template
+    profile read into its bin contents), named after a checksum of the
+    payload content and a name chosen by the module, so jobs using the same
+    payload can skip reading and processing it.
+
+  All files are written to a temporary name first and renamed, so concurrent jobs
+  never see partial files. Errors are not fatal, the original url is used instead.
+*/
+class CDBLocalCache
+{
+ public:
+  //! time to live of entries which never expire (the default)
+  static constexpr uint64_t NoExpiration = std::numeric_limits<uint64_t>::max();
+
+  explicit CDBLocalCache(const std::string &dir);
+  virtual ~CDBLocalCache() = default;
+
+  //! cached url for a lookup, empty if not found or expired
+  std::string getUrl(const std::string &globaltag, const std::string &domain, const uint64_t timestamp) const;
+
+  //! store the url of a lookup
+  void putUrl(const std::string &globaltag, const std::string &domain, const uint64_t timestamp, const std::string &url) const;
+
+  //! local copy of a payload file, staged if needed. Returns url unchanged if it is not a local file or staging fails.
+  //! Can be called concurrently for different payloads
+  std::string getPayload(const std::string &url);
+
+  //! processed form of a payload file, false if not cached or url is not a local file.
+  //! name identifies the processing and should change with it (e.g. carry a version)
+  bool getProcessed(const std::string &url, const std::string &name, std::vector<double> &data) const;
+
+  //! store the processed form of a payload file
+  void putProcessed(const std::string &url, const std::string &name, const std::vector<double> &data) const;
+
+  //! remove expired entries and enforce the size limit of the payload copies
+  void cleanup();
+
+  //! maximum size of the payload copies in bytes, 0 means no limit
+  void SetMaxSize(const uint64_t bytes) { m_MaxSize = bytes; }
+
+  //! time to live of index entries and payload copies in seconds, NoExpiration keeps them
+  //! until the size limit removes them, 0 disables the cache (nothing is read or stored)
+  void SetTTL(const uint64_t seconds) { m_TTL = seconds; }
+
+  bool Enabled() const { return m_TTL > 0; }
+
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+ private:
+  //! true if the file exists and is not older than the time to live
+  bool isValid(const std::string &path) const;
+
+  //! write content to path through a temporary file
+  bool writeFile(const std::string &path, const std::string &content) const;
+
+  //! entry of a processed payload, empty if url is not a readable local file
+  std::string processedPath(const std::string &url, const std::string &name) const;
+
+  std::string m_IndexDir;
+  std::string m_PayloadDir;
+  std::string m_ProcessedDir;
+  uint64_t m_MaxSize{0};
+  uint64_t m_TTL{NoExpiration};
+  int m_Verbosity{0};
+};
+
+#endif  // FFAMODULES_CDBLOCALCACHE_H
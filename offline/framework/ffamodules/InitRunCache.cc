@@ -0,0 +1,149 @@
+#include "InitRunCache.h"
+
+#include <phool/PHObject.h>
+#include <phool/phool.h>
+#include <phool/recoConsts.h>
+
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TObject.h>
+
+#include <unistd.h>  // for getpid
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+  //! FNV-1a hash, stable across builds and processes
+  std::string hash_string(const std::string &input)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : input)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return out.str();
+  }
+
+  //! unique temporary name next to the final path
+  std::string temporary_path(const std::string &path)
+  {
+    static std::atomic<unsigned int> counter{0};
+    return path + ".tmp." + std::to_string(getpid()) + "." + std::to_string(counter++);
+  }
+
+  const char *objectkey = "object";
+}  // namespace
+
+InitRunCache *InitRunCache::instance()
+{
+  static InitRunCache cache;
+  return &cache;
+}
+
+//____________________________________________________________________________..
+void InitRunCache::SetCacheDir(const std::string &dir)
+{
+  m_CacheDir = dir;
+  if (m_CacheDir.empty())
+  {
+    return;
+  }
+  std::error_code ec;
+  std::filesystem::create_directories(m_CacheDir, ec);
+  if (ec)
+  {
+    std::cout << PHWHERE << " cannot create cache directory " << m_CacheDir
+              << ": " << ec.message() << ", cache disabled" << std::endl;
+    m_CacheDir.clear();
+  }
+}
+
+//____________________________________________________________________________..
+std::string InitRunCache::path(const std::string &module, const std::string &name, const std::string &version) const
+{
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("CDB_GLOBALTAG") || !rc->FlagExist("TIMESTAMP"))
+  {
+    return "";
+  }
+  const std::string key = rc->get_StringFlag("CDB_GLOBALTAG") + "\n" + std::to_string(rc->get_uint64Flag("TIMESTAMP")) + "\n" + module + "\n" + name + "\n" + version;
+  return m_CacheDir + "/" + module + "_" + name + "_" + hash_string(key) + ".root";
+}
+
+//____________________________________________________________________________..
+PHObject *InitRunCache::get(const std::string &module, const std::string &name, const std::string &version) const
+{
+  if (!Enabled())
+  {
+    return nullptr;
+  }
+  const std::string file = path(module, name, version);
+  std::error_code ec;
+  if (file.empty() || !std::filesystem::is_regular_file(file, ec))
+  {
+    return nullptr;
+  }
+  TDirectory::TContext context;  // TFile changes gDirectory
+  TFile f(file.c_str(), "READ");
+  if (f.IsZombie())
+  {
+    return nullptr;
+  }
+  // objects which are not histograms are not owned by the file
+  PHObject *obj = dynamic_cast<PHObject *>(f.Get(objectkey));
+  if (m_Verbosity > 0)
+  {
+    std::cout << "InitRunCache: " << (obj ? "read " : "no object in ") << file << std::endl;
+  }
+  return obj;
+}
+
+//____________________________________________________________________________..
+bool InitRunCache::put(const std::string &module, const std::string &name, const PHObject *obj, const std::string &version) const
+{
+  if (!Enabled() || !obj)
+  {
+    return false;
+  }
+  const std::string file = path(module, name, version);
+  if (file.empty())
+  {
+    return false;
+  }
+  const std::string tmp = temporary_path(file);
+  bool written = false;
+  {
+    TDirectory::TContext context;
+    TFile f(tmp.c_str(), "RECREATE");
+    if (!f.IsZombie())
+    {
+      written = f.WriteTObject(obj, objectkey) > 0;
+      f.Close();
+    }
+  }
+  std::error_code ec;
+  if (written)
+  {
+    std::filesystem::rename(tmp, file, ec);
+  }
+  if (!written || ec)
+  {
+    std::cout << PHWHERE << " cannot write " << file << std::endl;
+    std::filesystem::remove(tmp, ec);
+    return false;
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "InitRunCache: wrote " << file << std::endl;
+  }
+  return true;
+}
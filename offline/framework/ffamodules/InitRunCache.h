@@ -0,0 +1,66 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAMODULES_INITRUNCACHE_H
+#define FFAMODULES_INITRUNCACHE_H
+
+#include <string>
+
+class PHObject;
+
+//! disk cache of objects modules build at the start of a run from conditions data
+/*!
+  Modules which spend startup time building a node object (e.g. a tower
+  geometry from a CDB tree) can store the result and pick it up in the
+  next job with the same global tag and time stamp:
+
+    InitRunCache *cache = InitRunCache::instance();
+    PHObject *obj = cache->get(Name(), "TOWERGEOM_CEMC");
+    if (!obj)
+    {
+      obj = build_it();
+      cache->put(Name(), "TOWERGEOM_CEMC", obj);
+    }
+
+  The cache is off until a directory is set in the macro:
+
+    InitRunCache::instance()->SetCacheDir("/tmp/initrun_cache");
+
+  Entries are keyed by the recoConsts CDB_GLOBALTAG and TIMESTAMP, the
+  module, the object name and a version string. The module has to put
+  everything else the object depends on (its own settings, payload
+  files not taken from the global tag) into the version string. Without
+  global tag or time stamp nothing is cached. Files are written to a
+  temporary name and renamed, so concurrent jobs never read partial
+  entries. Errors are not fatal, the module builds the object itself.
+*/
+class InitRunCache
+{
+ public:
+  static InitRunCache *instance();
+
+  InitRunCache(const InitRunCache &) = delete;
+  InitRunCache &operator=(const InitRunCache &) = delete;
+
+  //! enable the cache, an empty dir disables it
+  void SetCacheDir(const std::string &dir);
+  bool Enabled() const { return !m_CacheDir.empty(); }
+
+  //! cached object, nullptr if not found or the cache is disabled. The caller owns the object
+  PHObject *get(const std::string &module, const std::string &name, const std::string &version = "") const;
+
+  //! store an object, returns true if it was written
+  bool put(const std::string &module, const std::string &name, const PHObject *obj, const std::string &version = "") const;
+
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+ private:
+  InitRunCache() = default;
+
+  //! file of an entry, empty if global tag or time stamp are not set
+  std::string path(const std::string &module, const std::string &name, const std::string &version) const;
+
+  std::string m_CacheDir;
+  int m_Verbosity{0};
+};
+
+#endif  // FFAMODULES_INITRUNCACHE_H
@@ -0,0 +1,55 @@
+#include "PerformanceSummary.h"
+
+#include <phool/phool.h>
+
+#include <iostream>
+
+class PHObject;
+
+static std::vector<PerformanceSummary::ModuleStat> dummy_modules;
+static std::map<std::string, double> dummy_values;
+
+PHObject *
+PerformanceSummary::CloneMe() const
+{
+  std::cout << "PerformanceSummary::CloneMe() is not implemented in daugther class" << std::endl;
+  return nullptr;
+}
+
+void PerformanceSummary::Reset()
+{
+  std::cout << PHWHERE << "ERROR Reset() not implemented by daughter class" << std::endl;
+  return;
+}
+
+void PerformanceSummary::identify(std::ostream &os) const
+{
+  os << "identify yourself: virtual PerformanceSummary Object" << std::endl;
+  return;
+}
+
+int PerformanceSummary::isValid() const
+{
+  std::cout << PHWHERE << "isValid not implemented by daughter class" << std::endl;
+  return 0;
+}
+
+std::vector<PerformanceSummary::ModuleStat>::const_iterator PerformanceSummary::begin() const
+{
+  return dummy_modules.begin();
+}
+
+std::vector<PerformanceSummary::ModuleStat>::const_iterator PerformanceSummary::end() const
+{
+  return dummy_modules.end();
+}
+
+std::map<std::string, double>::const_iterator PerformanceSummary::values_begin() const
+{
+  return dummy_values.begin();
+}
+
+std::map<std::string, double>::const_iterator PerformanceSummary::values_end() const
+{
+  return dummy_values.end();
+}
@@ -0,0 +1,54 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAOBJECTS_PERFORMANCESUMMARY_H
+#define FFAOBJECTS_PERFORMANCESUMMARY_H
+
+#include <phool/PHObject.h>
+
+#include <cstdint>  // for uint64_t
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+//! performance record of the job which wrote the file, saved on the RUN node
+class PerformanceSummary : public PHObject
+{
+ public:
+  //! module name, events, total, mean and 99th percentile time per event (ms)
+  using ModuleStat = std::tuple<std::string, uint64_t, double, double, double>;
+
+  /// dtor
+  ~PerformanceSummary() override {}
+
+  PHObject *CloneMe() const override;
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream 
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains valid data
+  int isValid() const override;
+
+  virtual void AddModule(const std::string & /*name*/, const uint64_t /*nevents*/, const double /*total*/, const double /*mean*/, const double /*p99*/) { return; }
+
+  virtual std::vector<ModuleStat>::const_iterator begin() const;
+  virtual std::vector<ModuleStat>::const_iterator end() const;
+
+  //! job values (peak_rss_kb, input_read_ms, input_bytes, output_write_ms, output_bytes, ...)
+  virtual void set_value(const std::string & /*name*/, const double /*value*/) { return; }
+  virtual double get_value(const std::string & /*name*/) const { return -1; }
+
+  virtual std::map<std::string, double>::const_iterator values_begin() const;
+  virtual std::map<std::string, double>::const_iterator values_end() const;
+
+ private:
+  ClassDefOverride(PerformanceSummary, 1)
+};
+
+#endif
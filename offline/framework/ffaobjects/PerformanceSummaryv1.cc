@@ -0,0 +1,52 @@
+#include "PerformanceSummaryv1.h"
+
+#include <iostream>
+
+void PerformanceSummaryv1::Reset()
+{
+  m_Modules.clear();
+  m_Values.clear();
+  return;
+}
+
+void PerformanceSummaryv1::identify(std::ostream &os) const
+{
+  os << "identify yourself: PerformanceSummaryv1 Object" << std::endl;
+  for (const auto &[name, value] : m_Values)
+  {
+    os << name << ": " << value << std::endl;
+  }
+  for (const auto &[name, nevents, total, mean, p99] : m_Modules)
+  {
+    os << "module: " << name
+       << ", events: " << nevents
+       << ", total (ms): " << total
+       << ", mean (ms): " << mean
+       << ", p99 (ms): " << p99 << std::endl;
+  }
+  return;
+}
+
+int PerformanceSummaryv1::isValid() const
+{
+  if (!m_Modules.empty() || !m_Values.empty())
+  {
+    return 1;
+  }
+  return 0;
+}
+
+void PerformanceSummaryv1::AddModule(const std::string &name, const uint64_t nevents, const double total, const double mean, const double p99)
+{
+  m_Modules.emplace_back(name, nevents, total, mean, p99);
+}
+
+double PerformanceSummaryv1::get_value(const std::string &name) const
+{
+  auto iter = m_Values.find(name);
+  if (iter == m_Values.end())
+  {
+    return -1;
+  }
+  return iter->second;
+}
@@ -0,0 +1,54 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFAOBJECTS_PERFORMANCESUMMARYV1_H
+#define FFAOBJECTS_PERFORMANCESUMMARYV1_H
+
+#include "PerformanceSummary.h"
+
+#include <cstdint>  // for uint64_t
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class PHObject;
+
+///
+class PerformanceSummaryv1 : public PerformanceSummary
+{
+ public:
+  /// dtor
+  ~PerformanceSummaryv1() override {}
+
+  PHObject *CloneMe() const override { return new PerformanceSummaryv1(*this); }
+
+  /// Clear Event
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream 
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains valid data
+  int isValid() const override;
+
+  void AddModule(const std::string &name, const uint64_t nevents, const double total, const double mean, const double p99) override;
+
+  std::vector<ModuleStat>::const_iterator begin() const override { return m_Modules.begin(); }
+  std::vector<ModuleStat>::const_iterator end() const override { return m_Modules.end(); }
+
+  void set_value(const std::string &name, const double value) override { m_Values[name] = value; }
+  double get_value(const std::string &name) const override;
+
+  std::map<std::string, double>::const_iterator values_begin() const override { return m_Values.begin(); }
+  std::map<std::string, double>::const_iterator values_end() const override { return m_Values.end(); }
+
+ private:
+  std::vector<ModuleStat> m_Modules;
+  std::map<std::string, double> m_Values;
+
+  ClassDefOverride(PerformanceSummaryv1, 1)
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "Gl1StreamDump.h"
+
+#include <ffarawobjects/Gl1Packet.h>
+#include <ffarawobjects/Gl1Stream.h>
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/SubsysReco.h>  // for SubsysReco
+
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <TSystem.h>
+
+#include <iostream>  // for operator<<, endl, basic_ost...
+
+//____________________________________________________________________________..
+Gl1StreamDump::Gl1StreamDump(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+//____________________________________________________________________________..
+Gl1StreamDump::~Gl1StreamDump() = default;
+
+//____________________________________________________________________________..
+int Gl1StreamDump::InitRun(PHCompositeNode * /*topNode*/)
+{
+  if (outfilename.empty())
+  {
+    std::cout << "no output filename given" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (m_Writer)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  m_Writer = std::make_unique<Gl1StreamWriter>(outfilename, m_BlockSize);
+  if (!m_Writer->IsOpen())
+  {
+    std::cout << "could not open " << outfilename << std::endl;
+    gSystem->Exit(1);
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int Gl1StreamDump::process_event(PHCompositeNode *topNode)
+{
+  Gl1Packet *gl1packet = findNode::getClass<Gl1Packet>(topNode, m_NodeName);
+  if (!gl1packet)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << " no " << m_NodeName << " node" << std::endl;
+    }
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+  Gl1StreamRecord record;
+  record.FillFrom(gl1packet);
+  m_Writer->Fill(record);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+int Gl1StreamDump::End(PHCompositeNode * /*topNode*/)
+{
+  if (m_Writer)
+  {
+    m_Writer->Close();
+    std::cout << Name() << ": " << m_Writer->Records() << " events, "
+              << m_Writer->Bytes() << " bytes written to " << outfilename << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
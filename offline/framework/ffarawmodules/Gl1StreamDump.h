@@ -0,0 +1,40 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFARAWMODULES_GL1STREAMDUMP_H
+#define FFARAWMODULES_GL1STREAMDUMP_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <memory>
+#include <string>
+
+class Gl1StreamWriter;
+class PHCompositeNode;
+
+//! writes the Gl1Packet of every event into a GL1 stream file (see Gl1Stream.h)
+class Gl1StreamDump : public SubsysReco
+{
+ public:
+  Gl1StreamDump(const std::string &name = "Gl1StreamDump");
+
+  ~Gl1StreamDump() override;
+
+  int InitRun(PHCompositeNode *topNode) override;
+
+  int process_event(PHCompositeNode *topNode) override;
+
+  int End(PHCompositeNode *topNode) override;
+
+  void OutFileName(const std::string &name) { outfilename = name; }
+  void NodeName(const std::string &name) { m_NodeName = name; }
+  //! records per block, larger blocks compress better (default 4096)
+  void BlockSize(const unsigned int n) { m_BlockSize = n; }
+
+ private:
+  std::unique_ptr<Gl1StreamWriter> m_Writer;
+  std::string outfilename;
+  std::string m_NodeName{"GL1Packet"};
+  unsigned int m_BlockSize{4096};
+};
+
+#endif  // FFARAWMODULES_GL1STREAMDUMP_H
@@ -0,0 +1,590 @@
+#include "Gl1Stream.h"
+
+#include "Gl1Packet.h"
+
+#include <phool/phool.h>
+
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+  const char file_tag[8] = {'G', 'L', '1', 'S', 'T', 'R', 'M', '1'};
+  const unsigned int nscalers = 64 * 3;
+  const unsigned int nallscalers = nscalers + 16 * 3;
+  // a block larger than this is a corrupt file
+  const uint64_t max_block_bytes = 1ULL << 31;
+
+  uint64_t zigzag(const uint64_t delta)
+  {
+    const auto v = static_cast<int64_t>(delta);
+    return (static_cast<uint64_t>(v) << 1U) ^ static_cast<uint64_t>(v >> 63);
+  }
+
+  uint64_t unzigzag(const uint64_t v)
+  {
+    return (v >> 1U) ^ (~(v & 1U) + 1);
+  }
+
+  void put_varint(std::string &out, uint64_t v)
+  {
+    while (v >= 0x80)
+    {
+      out.push_back(static_cast<char>((v & 0x7FU) | 0x80U));
+      v >>= 7U;
+    }
+    out.push_back(static_cast<char>(v));
+  }
+
+  void put_fixed(std::string &out, uint64_t v, const unsigned int nbytes)
+  {
+    for (unsigned int i = 0; i < nbytes; ++i)
+    {
+      out.push_back(static_cast<char>(v & 0xFFU));
+      v >>= 8U;
+    }
+  }
+
+  uint64_t scaler_value(const Gl1StreamRecord &record, const unsigned int index)
+  {
+    return (index < nscalers) ? record.scaler[index / 3][index % 3] : record.gl1pscaler[(index - nscalers) / 3][(index - nscalers) % 3];
+  }
+
+  void set_scaler_value(Gl1StreamRecord &record, const unsigned int index, const uint64_t value)
+  {
+    if (index < nscalers)
+    {
+      record.scaler[index / 3][index % 3] = value;
+    }
+    else
+    {
+      record.gl1pscaler[(index - nscalers) / 3][(index - nscalers) % 3] = value;
+    }
+  }
+
+  //! the bits of a word which are set in the mask, packed into the low bits
+  class BitPacker
+  {
+   public:
+    BitPacker(std::string &out, const uint64_t mask)
+      : m_Out(out)
+    {
+      for (unsigned int bit = 0; bit < 64; ++bit)
+      {
+        if ((mask >> bit) & 1U)
+        {
+          m_Positions.push_back(bit);
+        }
+      }
+      m_Bits = m_Positions.size();
+    }
+
+    void put(const uint64_t word)
+    {
+      uint64_t packed = 0;
+      for (unsigned int i = 0; i < m_Positions.size(); ++i)
+      {
+        packed |= ((word >> m_Positions[i]) & 1U) << i;
+      }
+      if (m_Bits == 0)
+      {
+        return;
+      }
+      m_Acc |= packed << m_Fill;
+      if (m_Fill + m_Bits >= 64)
+      {
+        put_fixed(m_Out, m_Acc, 8);
+        const unsigned int used = 64 - m_Fill;
+        m_Acc = (used < 64) ? (packed >> used) : 0;
+        m_Fill = m_Fill + m_Bits - 64;
+      }
+      else
+      {
+        m_Fill += m_Bits;
+      }
+    }
+
+    void flush()
+    {
+      put_fixed(m_Out, m_Acc, (m_Fill + 7) / 8);
+      m_Acc = 0;
+      m_Fill = 0;
+    }
+
+   private:
+    std::string &m_Out;
+    unsigned int m_Bits{0};
+    std::vector<unsigned int> m_Positions;
+    uint64_t m_Acc{0};
+    unsigned int m_Fill{0};
+  };
+
+  //! reads a column, any read past its end marks it bad
+  class Cursor
+  {
+   public:
+    Cursor(const char *begin, const char *end)
+      : m_Pos(begin)
+      , m_End(end)
+    {
+    }
+
+    bool good() const { return m_Good; }
+    bool done() const { return m_Pos == m_End; }
+    const char *pos() const { return m_Pos; }
+    const char *end() const { return m_End; }
+
+    uint64_t varint()
+    {
+      uint64_t v = 0;
+      for (unsigned int shift = 0; shift < 64; shift += 7)
+      {
+        if (m_Pos == m_End)
+        {
+          break;
+        }
+        const auto byte = static_cast<unsigned char>(*m_Pos++);
+        v |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+        if (!(byte & 0x80U))
+        {
+          return v;
+        }
+      }
+      m_Good = false;
+      return 0;
+    }
+
+    //! up to 8 little endian bytes, fewer at the end of the column
+    uint64_t fixed(const unsigned int nbytes, unsigned int &nread)
+    {
+      uint64_t v = 0;
+      nread = 0;
+      while (nread < nbytes && m_Pos != m_End)
+      {
+        v |= static_cast<uint64_t>(static_cast<unsigned char>(*m_Pos++)) << (8 * nread);
+        ++nread;
+      }
+      return v;
+    }
+
+    uint64_t fixed(const unsigned int nbytes)
+    {
+      unsigned int nread = 0;
+      const uint64_t v = fixed(nbytes, nread);
+      m_Good = m_Good && (nread == nbytes);
+      return v;
+    }
+
+    //! the next column, prefixed with its size
+    Cursor column()
+    {
+      const uint64_t size = varint();
+      if (!m_Good || size > static_cast<uint64_t>(m_End - m_Pos))
+      {
+        m_Good = false;
+        return {m_End, m_End};
+      }
+      Cursor col(m_Pos, m_Pos + size);
+      m_Pos += size;
+      return col;
+    }
+
+   private:
+    const char *m_Pos;
+    const char *m_End;
+    bool m_Good{true};
+  };
+
+  class BitUnpacker
+  {
+   public:
+    BitUnpacker(Cursor &in, const uint64_t mask)
+      : m_In(in)
+    {
+      for (unsigned int bit = 0; bit < 64; ++bit)
+      {
+        if ((mask >> bit) & 1U)
+        {
+          m_Positions.push_back(bit);
+        }
+      }
+      m_Bits = m_Positions.size();
+    }
+
+    uint64_t get()
+    {
+      if (m_Bits == 0)
+      {
+        return 0;
+      }
+      uint64_t packed = 0;
+      if (m_Avail >= m_Bits)
+      {
+        packed = m_Acc;
+        m_Acc = (m_Bits < 64) ? (m_Acc >> m_Bits) : 0;
+        m_Avail -= m_Bits;
+      }
+      else
+      {
+        unsigned int nread = 0;
+        const uint64_t next = m_In.fixed(8, nread);
+        if (m_Avail + 8 * nread < m_Bits)
+        {
+          m_Good = false;
+          return 0;
+        }
+        packed = m_Acc | (next << m_Avail);
+        const unsigned int used = m_Bits - m_Avail;
+        m_Acc = (used < 64) ? (next >> used) : 0;
+        m_Avail = 8 * nread - used;
+      }
+      if (m_Bits < 64)
+      {
+        packed &= (1ULL << m_Bits) - 1;
+      }
+      uint64_t word = 0;
+      for (unsigned int i = 0; i < m_Positions.size(); ++i)
+      {
+        word |= ((packed >> i) & 1U) << m_Positions[i];
+      }
+      return word;
+    }
+
+    bool good() const { return m_Good; }
+
+   private:
+    Cursor &m_In;
+    unsigned int m_Bits{0};
+    std::vector<unsigned int> m_Positions;
+    uint64_t m_Acc{0};
+    unsigned int m_Avail{0};
+    bool m_Good{true};
+  };
+}  // namespace
+
+void Gl1StreamRecord::FillFrom(const Gl1Packet *pkt)
+{
+  bco = pkt->getBCO();
+  bunchnumber = pkt->getBunchNumber();
+  packetnumber = pkt->getPacketNumber();
+  evtsequence = pkt->getEvtSequence();
+  triggerinput = pkt->getTriggerInput();
+  livevector = pkt->getLiveVector();
+  scaledvector = pkt->getScaledVector();
+  gtmbusyvector = pkt->getGTMBusyVector();
+  for (int i = 0; i < 64; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      scaler[i][j] = pkt->lValue(i, j);
+    }
+  }
+  const std::string gl1p_names[3]{"GL1PRAW", "GL1PLIVE", "GL1PSCALED"};
+  for (int i = 0; i < 16; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      gl1pscaler[i][j] = pkt->lValue(i, gl1p_names[j]);
+    }
+  }
+}
+
+//____________________________________________________________________________..
+Gl1StreamWriter::Gl1StreamWriter(const std::string &filename, const unsigned int blocksize)
+  : m_Out(filename, std::ios::binary | std::ios::trunc)
+  , m_BlockSize(blocksize > 0 ? blocksize : 1)
+{
+  if (!m_Out.is_open())
+  {
+    std::cout << PHWHERE << " cannot open " << filename << std::endl;
+    return;
+  }
+  m_Out.write(file_tag, sizeof(file_tag));
+  m_Bytes = sizeof(file_tag);
+}
+
+Gl1StreamWriter::~Gl1StreamWriter()
+{
+  Close();
+}
+
+void Gl1StreamWriter::Fill(const Gl1StreamRecord &record)
+{
+  if (!IsOpen())
+  {
+    return;
+  }
+  m_Bco.push_back(record.bco);
+  m_BunchNumber.push_back(record.bunchnumber);
+  m_PacketNumber.push_back(record.packetnumber);
+  m_EvtSequence.push_back(record.evtsequence);
+  m_Trigger[0].push_back(record.triggerinput);
+  m_Trigger[1].push_back(record.livevector);
+  m_Trigger[2].push_back(record.scaledvector);
+  m_Trigger[3].push_back(record.gtmbusyvector);
+
+  // changed scalers relative to the previous record of the block
+  unsigned int nchanged = 0;
+  std::string changes;
+  for (unsigned int index = 0; index < nallscalers; ++index)
+  {
+    const uint64_t value = scaler_value(record, index);
+    const uint64_t last = scaler_value(m_LastScalers, index);
+    if (value != last)
+    {
+      put_varint(changes, index);
+      put_varint(changes, zigzag(value - last));
+      set_scaler_value(m_LastScalers, index, value);
+      ++nchanged;
+    }
+  }
+  put_varint(m_Scalers, nchanged);
+  m_Scalers += changes;
+
+  ++m_Records;
+  if (m_Bco.size() >= m_BlockSize)
+  {
+    WriteBlock();
+  }
+}
+
+void Gl1StreamWriter::Close()
+{
+  if (!IsOpen())
+  {
+    return;
+  }
+  WriteBlock();
+  m_Out.close();
+}
+
+void Gl1StreamWriter::WriteBlock()
+{
+  if (m_Bco.empty())
+  {
+    return;
+  }
+  std::string payload;
+  std::string column;
+  auto add_column = [&payload, &column]()
+  {
+    put_varint(payload, column.size());
+    payload += column;
+    column.clear();
+  };
+
+  uint64_t last = 0;
+  for (const uint64_t bco : m_Bco)
+  {
+    put_varint(column, zigzag(bco - last));
+    last = bco;
+  }
+  add_column();
+  last = 0;
+  for (const unsigned int packetnumber : m_PacketNumber)
+  {
+    put_varint(column, zigzag(packetnumber - last));
+    last = packetnumber;
+  }
+  add_column();
+  last = 0;
+  for (const int evtsequence : m_EvtSequence)
+  {
+    const auto value = static_cast<uint64_t>(static_cast<int64_t>(evtsequence));
+    put_varint(column, zigzag(value - last));
+    last = value;
+  }
+  add_column();
+  for (const uint64_t bunchnumber : m_BunchNumber)
+  {
+    put_varint(column, bunchnumber);
+  }
+  add_column();
+  for (auto &words : m_Trigger)
+  {
+    uint64_t mask = 0;
+    for (const uint64_t word : words)
+    {
+      mask |= word;
+    }
+    put_fixed(column, mask, 8);
+    BitPacker packer(column, mask);
+    for (const uint64_t word : words)
+    {
+      packer.put(word);
+    }
+    packer.flush();
+    add_column();
+  }
+  column.swap(m_Scalers);
+  add_column();
+
+  std::string header;
+  put_fixed(header, m_Bco.size(), 4);
+  put_fixed(header, payload.size(), 8);
+  m_Out.write(header.data(), header.size());
+  m_Out.write(payload.data(), payload.size());
+  m_Bytes += header.size() + payload.size();
+  if (!m_Out)
+  {
+    std::cout << PHWHERE << " error writing GL1 stream" << std::endl;
+  }
+
+  m_Bco.clear();
+  m_BunchNumber.clear();
+  m_PacketNumber.clear();
+  m_EvtSequence.clear();
+  for (auto &words : m_Trigger)
+  {
+    words.clear();
+  }
+  m_Scalers.clear();
+  // blocks are independent, the scaler changes of the next one start from 0
+  m_LastScalers = Gl1StreamRecord();
+}
+
+//____________________________________________________________________________..
+Gl1StreamReader::Gl1StreamReader(const std::string &filename)
+  : m_In(filename, std::ios::binary)
+{
+  char tag[sizeof(file_tag)];
+  if (!m_In.read(tag, sizeof(tag)) || std::memcmp(tag, file_tag, sizeof(tag)) != 0)
+  {
+    std::cout << PHWHERE << " " << filename << " is not a GL1 stream file" << std::endl;
+    return;
+  }
+  m_Open = true;
+}
+
+bool Gl1StreamReader::next(Gl1StreamRecord &record)
+{
+  if (m_Next >= m_Bco.size() && !ReadBlock())
+  {
+    return false;
+  }
+  const size_t i = m_Next++;
+  record.bco = m_Bco[i];
+  record.bunchnumber = m_BunchNumber[i];
+  record.packetnumber = m_PacketNumber[i];
+  record.evtsequence = m_EvtSequence[i];
+  record.triggerinput = m_Trigger[0][i];
+  record.livevector = m_Trigger[1][i];
+  record.scaledvector = m_Trigger[2][i];
+  record.gtmbusyvector = m_Trigger[3][i];
+  if (m_ReadScalers)
+  {
+    Cursor in(m_Scalers.data() + m_ScalerPos, m_Scalers.data() + m_Scalers.size());
+    const uint64_t nchanged = in.varint();
+    for (uint64_t n = 0; n < nchanged && in.good(); ++n)
+    {
+      const uint64_t index = in.varint();
+      const uint64_t delta = unzigzag(in.varint());
+      if (index >= nallscalers)
+      {
+        break;
+      }
+      set_scaler_value(m_LastScalers, index, scaler_value(m_LastScalers, index) + delta);
+    }
+    m_ScalerPos = in.pos() - m_Scalers.data();
+    record.scaler = m_LastScalers.scaler;
+    record.gl1pscaler = m_LastScalers.gl1pscaler;
+  }
+  ++m_Records;
+  return true;
+}
+
+bool Gl1StreamReader::ReadBlock()
+{
+  m_Next = 0;
+  m_Bco.clear();
+  if (!m_Open)
+  {
+    return false;
+  }
+  char header[12];
+  if (!m_In.read(header, sizeof(header)))
+  {
+    return false;  // end of file
+  }
+  Cursor head(header, header + sizeof(header));
+  const uint64_t nrecords = head.fixed(4);
+  const uint64_t nbytes = head.fixed(8);
+  std::string payload;
+  if (nbytes <= max_block_bytes)
+  {
+    payload.resize(nbytes);
+    m_In.read(payload.data(), nbytes);
+  }
+  if (nbytes > max_block_bytes || !m_In)
+  {
+    std::cout << PHWHERE << " truncated or corrupt GL1 stream file" << std::endl;
+    m_Open = false;
+    return false;
+  }
+
+  Cursor in(payload.data(), payload.data() + payload.size());
+  bool good = true;
+  Cursor bco = in.column();
+  uint64_t last = 0;
+  m_Bco.resize(nrecords);
+  for (auto &value : m_Bco)
+  {
+    last += unzigzag(bco.varint());
+    value = last;
+  }
+  good = good && bco.good();
+  Cursor packetnumber = in.column();
+  last = 0;
+  m_PacketNumber.resize(nrecords);
+  for (auto &value : m_PacketNumber)
+  {
+    last += unzigzag(packetnumber.varint());
+    value = static_cast<unsigned int>(last);
+  }
+  good = good && packetnumber.good();
+  Cursor evtsequence = in.column();
+  last = 0;
+  m_EvtSequence.resize(nrecords);
+  for (auto &value : m_EvtSequence)
+  {
+    last += unzigzag(evtsequence.varint());
+    value = static_cast<int>(static_cast<int64_t>(last));
+  }
+  good = good && evtsequence.good();
+  Cursor bunchnumber = in.column();
+  m_BunchNumber.resize(nrecords);
+  for (auto &value : m_BunchNumber)
+  {
+    value = bunchnumber.varint();
+  }
+  good = good && bunchnumber.good();
+  for (auto &words : m_Trigger)
+  {
+    Cursor trigger = in.column();
+    BitUnpacker unpacker(trigger, trigger.fixed(8));
+    words.resize(nrecords);
+    for (auto &word : words)
+    {
+      word = unpacker.get();
+    }
+    good = good && trigger.good() && unpacker.good();
+  }
+  Cursor scalers = in.column();
+  good = good && in.good() && in.done();
+  if (!good)
+  {
+    std::cout << PHWHERE << " corrupt GL1 stream block" << std::endl;
+    m_Bco.clear();
+    m_Open = false;
+    return false;
+  }
+  m_Scalers.clear();
+  m_ScalerPos = 0;
+  m_LastScalers = Gl1StreamRecord();
+  if (m_ReadScalers)
+  {
+    // the changes are applied record by record in next()
+    m_Scalers.assign(scalers.pos(), scalers.end());
+  }
+  return !m_Bco.empty();
+}
@@ -0,0 +1,130 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FFARAWOBJECTS_GL1STREAM_H
+#define FFARAWOBJECTS_GL1STREAM_H
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+class Gl1Packet;
+
+//! the content of one Gl1Packet, as written to and read from a GL1 stream file
+class Gl1StreamRecord
+{
+ public:
+  void FillFrom(const Gl1Packet *pkt);
+
+  uint64_t bco{0};
+  uint64_t bunchnumber{0};
+  unsigned int packetnumber{0};
+  int evtsequence{0};
+  uint64_t triggerinput{0};
+  uint64_t livevector{0};
+  uint64_t scaledvector{0};
+  uint64_t gtmbusyvector{0};
+  std::array<std::array<uint64_t, 3>, 64> scaler{{{0}}};      ///< [trigger][raw, live, scaled]
+  std::array<std::array<uint64_t, 3>, 16> gl1pscaler{{{0}}};  ///< [gl1p][raw, live, scaled]
+};
+
+//! writes GL1 records into a compact columnar file
+/*!
+  The file is a header followed by blocks of up to blocksize records.
+  Each block is decoded on its own and stores its records column by column:
+  - bco, packet number and event sequence as deltas to the previous record
+    (zigzag varints, a few bits for consecutive events)
+  - the bunch number as varint
+  - each of the four trigger words (input, live, scaled, GTM busy) bitpacked:
+    only the bits set in any record of the block are stored
+  - the 240 scalers only when they change, as (index, delta) pairs per record
+
+  Every column is prefixed with its size, so a reader which only needs the bco
+  and trigger words skips the scalers without decoding them. Records are
+  written in the order of Fill(), one per GL1 event. The format uses little
+  endian byte order and does not depend on ROOT.
+*/
+class Gl1StreamWriter
+{
+ public:
+  explicit Gl1StreamWriter(const std::string &filename, const unsigned int blocksize = 4096);
+  virtual ~Gl1StreamWriter();
+
+  Gl1StreamWriter(const Gl1StreamWriter &) = delete;
+  Gl1StreamWriter &operator=(const Gl1StreamWriter &) = delete;
+
+  bool IsOpen() const { return m_Out.is_open(); }
+
+  void Fill(const Gl1StreamRecord &record);
+
+  //! write the last block and close the file
+  void Close();
+
+  uint64_t Records() const { return m_Records; }
+  uint64_t Bytes() const { return m_Bytes; }
+
+ private:
+  void WriteBlock();
+
+  std::ofstream m_Out;
+  unsigned int m_BlockSize{4096};
+  uint64_t m_Records{0};
+  uint64_t m_Bytes{0};
+
+  // columns of the current block
+  std::vector<uint64_t> m_Bco;
+  std::vector<uint64_t> m_BunchNumber;
+  std::vector<unsigned int> m_PacketNumber;
+  std::vector<int> m_EvtSequence;
+  std::array<std::vector<uint64_t>, 4> m_Trigger;
+  std::string m_Scalers;
+  Gl1StreamRecord m_LastScalers;
+};
+
+//! reads the records of a GL1 stream file in order
+/*!
+  Gl1StreamReader reader("run.gl1s");
+  Gl1StreamRecord record;
+  while (reader.next(record))
+  {
+    ...
+  }
+*/
+class Gl1StreamReader
+{
+ public:
+  explicit Gl1StreamReader(const std::string &filename);
+  virtual ~Gl1StreamReader() = default;
+
+  bool IsOpen() const { return m_Open; }
+
+  //! skip the scaler columns, the scalers of the records stay 0
+  void ReadScalers(const bool b) { m_ReadScalers = b; }
+
+  //! next record, false at the end of the file or if it is corrupt
+  bool next(Gl1StreamRecord &record);
+
+  uint64_t Records() const { return m_Records; }
+
+ private:
+  bool ReadBlock();
+
+  std::ifstream m_In;
+  bool m_Open{false};
+  bool m_ReadScalers{true};
+  uint64_t m_Records{0};
+
+  // decoded columns of the current block
+  size_t m_Next{0};
+  std::vector<uint64_t> m_Bco;
+  std::vector<uint64_t> m_BunchNumber;
+  std::vector<unsigned int> m_PacketNumber;
+  std::vector<int> m_EvtSequence;
+  std::array<std::vector<uint64_t>, 4> m_Trigger;
+  std::string m_Scalers;
+  size_t m_ScalerPos{0};
+  Gl1StreamRecord m_LastScalers;
+};
+
+#endif  // FFARAWOBJECTS_GL1STREAM_H
@@ -0,0 +1,114 @@
+#include "MvtxRawHitContainerv2.h"
+
+#include <iostream>
+
+void MvtxRawHitContainerv2::Reset()
+{
+  m_bco.clear();
+  m_strobe_bc.clear();
+  m_chip_bc.clear();
+  m_layer.clear();
+  m_stave.clear();
+  m_chip.clear();
+  m_first_word.assign(1, 0);
+  m_pixels.clear();
+  m_nhits = 0;
+  m_hits.clear();
+}
+
+void MvtxRawHitContainerv2::identify(std::ostream &os) const
+{
+  os << "MvtxRawHitContainerv2" << std::endl;
+  os << "containing " << m_nhits << " Mvtx hits in "
+     << m_bco.size() << " chip readouts, "
+     << m_pixels.size() << " pixel words" << std::endl;
+  if (!m_bco.empty())
+  {
+    os << "for beam clock: " << std::hex << m_bco.front() << std::dec << std::endl;
+  }
+}
+
+MvtxRawHit *MvtxRawHitContainerv2::AddHit(MvtxRawHit *mvtxhit)
+{
+  add_pixel(mvtxhit->get_bco(), mvtxhit->get_strobe_bc(), mvtxhit->get_chip_bc(),
+            mvtxhit->get_layer_id(), mvtxhit->get_stave_id(), mvtxhit->get_chip_id(),
+            mvtxhit->get_row(), mvtxhit->get_col());
+  return mvtxhit;
+}
+
+void MvtxRawHitContainerv2::add_pixel(const uint64_t bco, const uint32_t strobe_bc, const uint32_t chip_bc,
+                                      const uint8_t layer, const uint8_t stave, const uint8_t chip,
+                                      const uint16_t row, const uint16_t col)
+{
+  if (row > kRowMask || col > kColMask)
+  {
+    std::cout << __PRETTY_FUNCTION__ << " - pixel out of range, row " << row
+              << " col " << col << ", skipped" << std::endl;
+    return;
+  }
+
+  // start a new readout group when the chip or its readout changes
+  const bool same_group = !m_bco.empty() &&
+                          m_bco.back() == bco &&
+                          m_strobe_bc.back() == strobe_bc &&
+                          m_chip_bc.back() == chip_bc &&
+                          m_layer.back() == layer &&
+                          m_stave.back() == stave &&
+                          m_chip.back() == chip;
+  if (!same_group)
+  {
+    m_bco.push_back(bco);
+    m_strobe_bc.push_back(strobe_bc);
+    m_chip_bc.push_back(chip_bc);
+    m_layer.push_back(layer);
+    m_stave.push_back(stave);
+    m_chip.push_back(chip);
+    m_first_word.push_back(m_first_word.back());
+  }
+  ++m_nhits;
+
+  // extend the last run if this pixel follows it in the same row
+  if (same_group && m_first_word.back() > m_first_word[m_first_word.size() - 2])
+  {
+    uint32_t &word = m_pixels.back();
+    const uint32_t last_row = (word >> kColBits) & kRowMask;
+    const uint32_t ncols = (word >> (kColBits + kRowBits)) + 1;
+    if (last_row == row && (word & kColMask) + ncols == col)
+    {
+      word += 1U << (kColBits + kRowBits);
+      return;
+    }
+  }
+  m_pixels.push_back((static_cast<uint32_t>(row) << kColBits) | col);
+  m_first_word.back() = m_pixels.size();
+}
+
+MvtxRawHit *MvtxRawHitContainerv2::get_hit(unsigned int index)
+{
+  if (index >= m_nhits)
+  {
+    return nullptr;
+  }
+
+  // unpack all hits, e.g. after hits were added or the container was read from file
+  if (m_hits.size() != m_nhits)
+  {
+    m_hits.clear();
+    m_hits.reserve(m_nhits);
+    for (unsigned int i = 0; i < get_nchips(); ++i)
+    {
+      for_each_pixel(i, [this, i](const uint16_t row, const uint16_t col)
+                     {
+        MvtxRawHitv1 &hit = m_hits.emplace_back();
+        hit.set_bco(m_bco[i]);
+        hit.set_strobe_bc(m_strobe_bc[i]);
+        hit.set_chip_bc(m_chip_bc[i]);
+        hit.set_layer_id(m_layer[i]);
+        hit.set_stave_id(m_stave[i]);
+        hit.set_chip_id(m_chip[i]);
+        hit.set_row(row);
+        hit.set_col(col); });
+    }
+  }
+  return &m_hits[index];
+}
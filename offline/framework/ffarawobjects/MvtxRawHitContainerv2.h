@@ -0,0 +1,119 @@
+#ifndef FUN4ALLRAW_MVTXHITRAWCONTAINERV2_H
+#define FUN4ALLRAW_MVTXHITRAWCONTAINERV2_H
+
+#include "MvtxRawHitContainer.h"
+#include "MvtxRawHitv1.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MvtxRawHit;
+
+//! MVTX raw hit container with the pixels grouped by chip readout
+/*!
+ * consecutive hits with the same bco, strobe, chip bco and chip are stored as one
+ * readout group, so these fields are kept once per chip instead of once per pixel.
+ * The pixels of a group are packed into 32 bit words holding the row, the first column
+ * and the number of following columns fired in the same row.
+ *
+ * the decoders loop over the groups with get_nchips() and for_each_pixel(), without
+ * creating hit objects. get_hit() still returns MvtxRawHitv1 copies owned by the
+ * container, made on first use and invalidated when hits are added or the container
+ * is reset.
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class MvtxRawHitContainerv2 : public MvtxRawHitContainer
+{
+ public:
+  MvtxRawHitContainerv2() = default;
+  ~MvtxRawHitContainerv2() override = default;
+
+  /// Clear Event, allocated memory is kept
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override { return m_nhits > 0; }
+
+  //! pack a hit, the hit object is not kept
+  MvtxRawHit *AddHit(MvtxRawHit *mvtxhit) override;
+
+  unsigned int get_nhits() override { return m_nhits; }
+  MvtxRawHit *get_hit(unsigned int index) override;
+
+  //! pack one pixel
+  void add_pixel(const uint64_t bco, const uint32_t strobe_bc, const uint32_t chip_bc,
+                 const uint8_t layer, const uint8_t stave, const uint8_t chip,
+                 const uint16_t row, const uint16_t col);
+
+  ///@name readout groups
+  //@{
+  unsigned int get_nchips() const { return m_bco.size(); }
+  uint64_t get_chip_bco(unsigned int i) const { return m_bco[i]; }
+  uint32_t get_chip_strobe_bc(unsigned int i) const { return m_strobe_bc[i]; }
+  uint32_t get_chip_chip_bc(unsigned int i) const { return m_chip_bc[i]; }
+  uint8_t get_chip_layer_id(unsigned int i) const { return m_layer[i]; }
+  uint8_t get_chip_stave_id(unsigned int i) const { return m_stave[i]; }
+  uint8_t get_chip_chip_id(unsigned int i) const { return m_chip[i]; }
+  //@}
+
+  //! call f(row, col) for every pixel of readout group i
+  template <class F>
+  void for_each_pixel(unsigned int i, F &&f) const
+  {
+    for (uint32_t iword = m_first_word[i]; iword < m_first_word[i + 1]; ++iword)
+    {
+      const uint32_t word = m_pixels[iword];
+      const uint16_t row = (word >> kColBits) & kRowMask;
+      const uint16_t col = word & kColMask;
+      const uint32_t ncols = (word >> (kColBits + kRowBits)) + 1;
+      for (uint32_t icol = 0; icol < ncols; ++icol)
+      {
+        f(row, static_cast<uint16_t>(col + icol));
+      }
+    }
+  }
+
+  //! number of packed pixel words
+  size_t get_nwords() const { return m_pixels.size(); }
+
+ private:
+  ///@name pixel word: (ncols - 1) << 19 | row << 10 | col
+  //@{
+  static constexpr unsigned int kColBits = 10;
+  static constexpr unsigned int kRowBits = 9;
+  static constexpr uint32_t kColMask = (1U << kColBits) - 1;
+  static constexpr uint32_t kRowMask = (1U << kRowBits) - 1;
+  //@}
+
+  ///@name readout group data, one entry per group
+  //@{
+  std::vector<uint64_t> m_bco;
+  std::vector<uint32_t> m_strobe_bc;
+  std::vector<uint32_t> m_chip_bc;
+  std::vector<uint8_t> m_layer;
+  std::vector<uint8_t> m_stave;
+  std::vector<uint8_t> m_chip;
+  //@}
+
+  //! pixel words of group i are in [m_first_word[i], m_first_word[i+1])
+  std::vector<uint32_t> m_first_word{0};
+
+  //! packed pixels of all groups
+  std::vector<uint32_t> m_pixels;
+
+  //! number of pixels
+  uint32_t m_nhits{0};
+
+  //! hit copies returned by get_hit, rebuilt on demand
+  std::vector<MvtxRawHitv1> m_hits;  //!
+
+  ClassDefOverride(MvtxRawHitContainerv2, 1)
+};
+
+#endif
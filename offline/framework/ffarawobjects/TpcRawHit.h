@@ -58,6 +58,21 @@ class TpcRawHit : public PHObject
   virtual bool get_parityerror() const { return false; }
   virtual void set_parityerror(const bool /*b*/) { return; }
 
+  //!@name direct access to the ADC waveforms, without iterator allocation
+  //@{
+  //! number of waveforms. Zero if the hit does not support direct access, use CreateAdcIterator() then
+  virtual unsigned int get_n_waveforms() const { return 0; }
+
+  //! first time bin of waveform
+  virtual uint16_t get_waveform_start(const unsigned int /*i*/) const { return std::numeric_limits<uint16_t>::max(); }
+
+  //! number of samples in waveform
+  virtual uint16_t get_waveform_length(const unsigned int /*i*/) const { return 0; }
+
+  //! pointer to the get_waveform_length(i) contiguous samples of waveform
+  virtual const uint16_t *get_waveform_adc(const unsigned int /*i*/) const { return nullptr; }
+  //@}
+
   class AdcIterator
   {
    public:
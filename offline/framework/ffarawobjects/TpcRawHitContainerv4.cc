@@ -0,0 +1,150 @@
+#include "TpcRawHitContainerv4.h"
+
+#include <iostream>
+#include <limits>
+#include <memory>
+
+TpcRawHitContainerv4::TpcRawHitContainerv4()
+  : m_first_waveform(1, 0)
+  , m_waveform_offset(1, 0)
+{
+}
+
+void TpcRawHitContainerv4::Reset()
+{
+  m_bco.clear();
+  m_packetid.clear();
+  m_fee.clear();
+  m_channel.clear();
+  m_type.clear();
+  m_checksumerror.clear();
+  m_parityerror.clear();
+  m_first_waveform.assign(1, 0);
+  m_waveform_start.clear();
+  m_waveform_offset.assign(1, 0);
+  m_adc.clear();
+  m_hits.clear();
+}
+
+void TpcRawHitContainerv4::identify(std::ostream &os) const
+{
+  os << "TpcRawHitContainerv4" << std::endl;
+  os << "containing " << m_bco.size() << " Tpc hits, "
+     << m_waveform_start.size() << " waveforms, "
+     << m_adc.size() << " samples" << std::endl;
+  if (!m_bco.empty())
+  {
+    os << "for beam clock: " << std::hex << m_bco.front() << std::dec << std::endl;
+  }
+}
+
+void TpcRawHitContainerv4::reserve(const size_t nhits, const size_t nwaveforms, const size_t nsamples)
+{
+  m_bco.reserve(nhits);
+  m_packetid.reserve(nhits);
+  m_fee.reserve(nhits);
+  m_channel.reserve(nhits);
+  m_type.reserve(nhits);
+  m_checksumerror.reserve(nhits);
+  m_parityerror.reserve(nhits);
+  m_first_waveform.reserve(nhits + 1);
+  m_waveform_start.reserve(nwaveforms);
+  m_waveform_offset.reserve(nwaveforms + 1);
+  m_adc.reserve(nsamples);
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit()
+{
+  // same defaults as TpcRawHitv3
+  m_bco.push_back(std::numeric_limits<uint64_t>::max());
+  m_packetid.push_back(std::numeric_limits<int32_t>::max());
+  m_fee.push_back(std::numeric_limits<uint16_t>::max());
+  m_channel.push_back(std::numeric_limits<uint16_t>::max());
+  m_type.push_back(std::numeric_limits<uint16_t>::max());
+  m_checksumerror.push_back(true);
+  m_parityerror.push_back(true);
+  m_first_waveform.push_back(m_first_waveform.back());
+  return get_hit(m_bco.size() - 1);
+}
+
+TpcRawHit *TpcRawHitContainerv4::AddHit(TpcRawHit *tpchit)
+{
+  TpcRawHit *newhit = AddHit();
+  newhit->set_bco(tpchit->get_bco());
+  newhit->set_packetid(tpchit->get_packetid());
+  newhit->set_fee(tpchit->get_fee());
+  newhit->set_channel(tpchit->get_channel());
+  newhit->set_type(tpchit->get_type());
+  newhit->set_checksumerror(tpchit->get_checksumerror());
+  newhit->set_parityerror(tpchit->get_parityerror());
+
+  const unsigned int nwaveforms = tpchit->get_n_waveforms();
+  if (nwaveforms > 0)
+  {
+    // fast path: copy the contiguous samples of each waveform
+    for (unsigned int i = 0; i < nwaveforms; ++i)
+    {
+      add_waveform(tpchit->get_waveform_start(i), tpchit->get_waveform_adc(i), tpchit->get_waveform_length(i));
+    }
+    return newhit;
+  }
+
+  // no direct access: group consecutive time bins into waveforms
+  std::vector<uint16_t> adc;
+  uint16_t start_time = 0;
+  for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+       !adc_iterator->IsDone();
+       adc_iterator->Next())
+  {
+    const uint16_t time_bin = adc_iterator->CurrentTimeBin();
+    if (!adc.empty() && time_bin != start_time + adc.size())
+    {
+      add_waveform(start_time, adc.data(), adc.size());
+      adc.clear();
+    }
+    if (adc.empty())
+    {
+      start_time = time_bin;
+    }
+    adc.push_back(adc_iterator->CurrentAdc());
+  }
+  if (!adc.empty())
+  {
+    add_waveform(start_time, adc.data(), adc.size());
+  }
+  return newhit;
+}
+
+void TpcRawHitContainerv4::add_waveform(const uint16_t start_time, const uint16_t *adc, const size_t nsamples)
+{
+  if (m_bco.empty())
+  {
+    std::cout << __PRETTY_FUNCTION__ << " - no hit to add waveform to" << std::endl;
+    return;
+  }
+  m_waveform_start.push_back(start_time);
+  m_adc.insert(m_adc.end(), adc, adc + nsamples);
+  m_waveform_offset.push_back(m_adc.size());
+  m_first_waveform.back() = m_waveform_start.size();
+}
+
+TpcRawHit *TpcRawHitContainerv4::get_hit(unsigned int index)
+{
+  if (index >= m_bco.size())
+  {
+    return nullptr;
+  }
+
+  // handles copied along with the container still point to the original
+  if (!m_hits.empty() && m_hits.front().m_container != this)
+  {
+    m_hits.clear();
+  }
+
+  // create missing handles, e.g. after hits were added or the container was read from file
+  for (unsigned int i = m_hits.size(); i < m_bco.size(); ++i)
+  {
+    m_hits.emplace_back(this, i);
+  }
+  return &m_hits[index];
+}
@@ -0,0 +1,98 @@
+#ifndef FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+#define FUN4ALLRAW_TPCHITRAWCONTAINERv4_H
+
+#include "TpcRawHitContainer.h"
+#include "TpcRawHitv4.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TpcRawHit;
+
+//! TPC raw hit container with all waveforms of a time frame in one contiguous buffer
+/*!
+ * hit data are stored in one array per field, and the ADC samples of all hits in a single
+ * sample buffer with an offset table per waveform. Adding a hit appends to these arrays
+ * instead of allocating a hit object and one vector per waveform, and the unpackers read
+ * the samples in place through TpcRawHit::get_waveform_adc().
+ *
+ * get_hit() returns lightweight TpcRawHitv4 handles owned by the container. They are
+ * invalidated when hits are added or the container is reset.
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class TpcRawHitContainerv4 : public TpcRawHitContainer
+{
+ public:
+  TpcRawHitContainerv4();
+  ~TpcRawHitContainerv4() override = default;
+
+  /// Clear Event, allocated memory is kept
+  void Reset() override;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  /// isValid returns non zero if object contains vailid data
+  int isValid() const override { return !m_bco.empty(); }
+
+  //! add an empty hit. Waveforms are then added with add_waveform()
+  TpcRawHit *AddHit() override;
+
+  //! copy a hit and its waveforms
+  TpcRawHit *AddHit(TpcRawHit *tpchit) override;
+
+  unsigned int get_nhits() override { return m_bco.size(); }
+  TpcRawHit *get_hit(unsigned int index) override;
+  void setStatus(const unsigned int i) override { status = i; }
+  unsigned int getStatus() const override { return status; }
+  void setBco(const uint64_t i) override { bco = i; }
+  uint64_t getBco() const override { return bco; }
+
+  //! append a waveform of nsamples contiguous samples to the last added hit
+  void add_waveform(const uint16_t start_time, const uint16_t *adc, const size_t nsamples);
+
+  //! reserve memory for a time frame
+  void reserve(const size_t nhits, const size_t nwaveforms, const size_t nsamples);
+
+  //! total number of stored ADC samples
+  size_t get_nsamples() const { return m_adc.size(); }
+
+ private:
+  friend class TpcRawHitv4;
+
+  ///@name hit data, one entry per hit
+  //@{
+  std::vector<uint64_t> m_bco;
+  std::vector<int32_t> m_packetid;
+  std::vector<uint16_t> m_fee;
+  std::vector<uint16_t> m_channel;
+  std::vector<uint16_t> m_type;
+  std::vector<uint8_t> m_checksumerror;
+  std::vector<uint8_t> m_parityerror;
+  //@}
+
+  //! waveforms of hit i are in [m_first_waveform[i], m_first_waveform[i+1])
+  std::vector<uint32_t> m_first_waveform;
+
+  //! first time bin of each waveform
+  std::vector<uint16_t> m_waveform_start;
+
+  //! samples of waveform j are in [m_waveform_offset[j], m_waveform_offset[j+1])
+  std::vector<uint32_t> m_waveform_offset;
+
+  //! ADC samples of all waveforms
+  std::vector<uint16_t> m_adc;
+
+  uint64_t bco{0};
+  unsigned int status{0};
+
+  //! hit handles returned by get_hit, rebuilt on demand
+  std::vector<TpcRawHitv4> m_hits;  //!
+
+  ClassDefOverride(TpcRawHitContainerv4, 1)
+};
+
+#endif
@@ -93,6 +93,11 @@ class TpcRawHitv3 : public TpcRawHit
   bool get_parityerror() const override { return parityerror; }
   void set_parityerror(const bool b) override { parityerror = b; }
 
+  unsigned int get_n_waveforms() const override { return m_adcData.size(); }
+  uint16_t get_waveform_start(const unsigned int i) const override { return m_adcData[i].first; }
+  uint16_t get_waveform_length(const unsigned int i) const override { return m_adcData[i].second.size(); }
+  const uint16_t *get_waveform_adc(const unsigned int i) const override { return m_adcData[i].second.data(); }
+
   class AdcIteratorv3 : public AdcIterator
   {
    private:
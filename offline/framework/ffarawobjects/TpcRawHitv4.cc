@@ -0,0 +1,77 @@
+#include "TpcRawHitv4.h"
+#include "TpcRawHitContainerv4.h"
+
+#include <iostream>
+
+void TpcRawHitv4::identify(std::ostream &os) const
+{
+  os << "BCO: 0x" << std::hex << get_bco() << std::dec << std::endl;
+  os << " packet id: " << get_packetid() << std::endl;
+
+  for (unsigned int i = 0; i < get_n_waveforms(); ++i)
+  {
+    os << " start time: " << get_waveform_start(i) << " | ADCs: ";
+    const uint16_t *adc = get_waveform_adc(i);
+    for (uint16_t j = 0; j < get_waveform_length(i); ++j)
+    {
+      os << adc[j] << " ";
+    }
+    os << std::endl;
+  }
+}
+
+uint64_t TpcRawHitv4::get_bco() const { return m_container->m_bco[m_index]; }
+void TpcRawHitv4::set_bco(const uint64_t val) { m_container->m_bco[m_index] = val; }
+
+int32_t TpcRawHitv4::get_packetid() const { return m_container->m_packetid[m_index]; }
+void TpcRawHitv4::set_packetid(const int32_t val) { m_container->m_packetid[m_index] = val; }
+
+uint16_t TpcRawHitv4::get_fee() const { return m_container->m_fee[m_index]; }
+void TpcRawHitv4::set_fee(const uint16_t val) { m_container->m_fee[m_index] = val; }
+
+uint16_t TpcRawHitv4::get_channel() const { return m_container->m_channel[m_index]; }
+void TpcRawHitv4::set_channel(const uint16_t val) { m_container->m_channel[m_index] = val; }
+
+uint16_t TpcRawHitv4::get_type() const { return m_container->m_type[m_index]; }
+void TpcRawHitv4::set_type(const uint16_t val) { m_container->m_type[m_index] = val; }
+
+bool TpcRawHitv4::get_checksumerror() const { return m_container->m_checksumerror[m_index]; }
+void TpcRawHitv4::set_checksumerror(const bool b) { m_container->m_checksumerror[m_index] = b; }
+
+bool TpcRawHitv4::get_parityerror() const { return m_container->m_parityerror[m_index]; }
+void TpcRawHitv4::set_parityerror(const bool b) { m_container->m_parityerror[m_index] = b; }
+
+unsigned int TpcRawHitv4::get_n_waveforms() const
+{
+  return m_container->m_first_waveform[m_index + 1] - m_container->m_first_waveform[m_index];
+}
+
+uint16_t TpcRawHitv4::get_waveform_start(const unsigned int i) const
+{
+  return m_container->m_waveform_start[m_container->m_first_waveform[m_index] + i];
+}
+
+uint16_t TpcRawHitv4::get_waveform_length(const unsigned int i) const
+{
+  const auto iwf = m_container->m_first_waveform[m_index] + i;
+  return m_container->m_waveform_offset[iwf + 1] - m_container->m_waveform_offset[iwf];
+}
+
+const uint16_t *TpcRawHitv4::get_waveform_adc(const unsigned int i) const
+{
+  const auto iwf = m_container->m_first_waveform[m_index] + i;
+  return m_container->m_adc.data() + m_container->m_waveform_offset[iwf];
+}
+
+uint16_t TpcRawHitv4::get_adc(const uint16_t sample) const
+{
+  for (unsigned int i = 0; i < get_n_waveforms(); ++i)
+  {
+    const uint16_t start = get_waveform_start(i);
+    if (sample >= start && sample < start + get_waveform_length(i))
+    {
+      return get_waveform_adc(i)[sample - start];
+    }
+  }
+  return 0;
+}
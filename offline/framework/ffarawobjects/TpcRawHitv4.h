@@ -0,0 +1,158 @@
+#ifndef FUN4ALLRAW_TPCRAWTHITv4_H
+#define FUN4ALLRAW_TPCRAWTHITv4_H
+
+#include "TpcRawHit.h"
+
+#include <cstdint>
+#include <limits>
+
+class TpcRawHitContainerv4;
+
+//! lightweight handle on one hit of a TpcRawHitContainerv4
+/*!
+ * the hit data and ADC samples are owned by the container, which stores all waveforms
+ * of a time frame in one contiguous buffer. This class only holds the container and the
+ * hit index, it is not meant to be stored on its own.
+ */
+// NOLINTNEXTLINE(hicpp-special-member-functions)
+class TpcRawHitv4 : public TpcRawHit
+{
+ public:
+  TpcRawHitv4() = default;
+  TpcRawHitv4(TpcRawHitContainerv4 *container, unsigned int index)
+    : m_container(container)
+    , m_index(index)
+  {
+  }
+
+  ~TpcRawHitv4() override = default;
+
+  /** identify Function from PHObject
+      @param os Output Stream
+   */
+  void identify(std::ostream &os = std::cout) const override;
+
+  uint64_t get_bco() const override;
+  void set_bco(const uint64_t val) override;
+
+  int32_t get_packetid() const override;
+  void set_packetid(const int32_t val) override;
+
+  uint16_t get_fee() const override;
+  void set_fee(const uint16_t val) override;
+
+  uint16_t get_channel() const override;
+  void set_channel(const uint16_t val) override;
+
+  uint16_t get_sampaaddress() const override
+  {
+    return static_cast<uint16_t>(get_channel() >> 5U) & 0xfU;
+  }
+
+  uint16_t get_sampachannel() const override { return get_channel() & 0x1fU; }
+
+  uint16_t get_samples() const override { return 1024U; }
+
+  //! slow, loops over waveforms. Prefer the direct waveform access
+  uint16_t get_adc(const uint16_t sample) const override;
+
+  uint16_t get_type() const override;
+  void set_type(const uint16_t val) override;
+
+  bool get_checksumerror() const override;
+  void set_checksumerror(const bool b) override;
+
+  bool get_parityerror() const override;
+  void set_parityerror(const bool b) override;
+
+  unsigned int get_n_waveforms() const override;
+  uint16_t get_waveform_start(const unsigned int i) const override;
+  uint16_t get_waveform_length(const unsigned int i) const override;
+  const uint16_t *get_waveform_adc(const unsigned int i) const override;
+
+  class AdcIteratorv4 : public AdcIterator
+  {
+   private:
+    const TpcRawHitv4 &m_hit;
+    unsigned int m_waveform_index = 0;
+    uint16_t m_adc_position_in_waveform_index = 0;
+
+    //! move to the first non empty waveform at or after m_waveform_index
+    void skip_empty()
+    {
+      while (m_waveform_index < m_hit.get_n_waveforms() && m_hit.get_waveform_length(m_waveform_index) == 0)
+      {
+        ++m_waveform_index;
+      }
+    }
+
+   public:
+    explicit AdcIteratorv4(const TpcRawHitv4 &hit)
+      : m_hit(hit)
+    {
+    }
+
+    void First() override
+    {
+      m_waveform_index = 0;
+      m_adc_position_in_waveform_index = 0;
+      skip_empty();
+    }
+
+    void Next() override
+    {
+      if (IsDone())
+      {
+        return;
+      }
+
+      if (m_adc_position_in_waveform_index + 1U < m_hit.get_waveform_length(m_waveform_index))
+      {
+        ++m_adc_position_in_waveform_index;
+      }
+      else
+      {
+        m_adc_position_in_waveform_index = 0;
+        ++m_waveform_index;
+        skip_empty();
+      }
+    }
+
+    bool IsDone() const override { return m_waveform_index >= m_hit.get_n_waveforms(); }
+
+    uint16_t CurrentTimeBin() const override
+    {
+      if (!IsDone())
+      {
+        return m_hit.get_waveform_start(m_waveform_index) + m_adc_position_in_waveform_index;
+      }
+      return std::numeric_limits<uint16_t>::max();
+    }
+
+    uint16_t CurrentAdc() const override
+    {
+      if (!IsDone())
+      {
+        return m_hit.get_waveform_adc(m_waveform_index)[m_adc_position_in_waveform_index];
+      }
+      return std::numeric_limits<uint16_t>::max();
+    }
+  };
+
+  AdcIterator *CreateAdcIterator() const override
+  {
+    auto *iter = new AdcIteratorv4(*this);
+    iter->First();
+    return iter;
+  }
+
+ private:
+  friend class TpcRawHitContainerv4;
+
+  TpcRawHitContainerv4 *m_container{nullptr};  //!
+  unsigned int m_index{0};                      //!
+
+  ClassDefOverride(TpcRawHitv4, 1)
+};
+
+#endif
@@ -10,16 +10,364 @@
 
 #include <boost/tokenizer.hpp>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <fstream>
+#include <future>
 #include <iostream>
+#include <map>
+#include <mutex>
 #include <random> // For retrying connections
+#include <set>
 #include <string>
 #include <thread>
 
+namespace
+{
+  //! job wide cache of resolved locations, keyed by search path and logical name
+  std::mutex &cache_mutex()
+  {
+    static std::mutex m;
+    return m;
+  }
+
+  std::map<std::string, std::shared_future<std::string>> &location_cache()
+  {
+    static std::map<std::string, std::shared_future<std::string>> cache;
+    return cache;
+  }
+
+  std::string cache_key(const std::string &gsearchpath, const std::string &logical_name)
+  {
+    return gsearchpath + '\n' + logical_name;
+  }
+
+  //! search() and evaluate() return the logical name itself if the file was not found
+  bool found(const std::string &logical_name, const std::string &location)
+  {
+    return location != logical_name;
+  }
+
+  std::shared_future<std::string> ready(const std::string &value)
+  {
+    std::promise<std::string> result;
+    result.set_value(value);
+    return result.get_future().share();
+  }
+
+  //! translate a lustre path into its MinIO url, exits if the path is not in the MinIO area
+  std::string lustre_to_minio(std::string path)
+  {
+    const std::string toreplace("/sphenix/lustre01/sphnxpro");
+    size_t strpos = path.find(toreplace);
+    if (strpos == std::string::npos)
+    {
+      std::cout << " could not locate " << toreplace
+                << " in full file path " << path << std::endl;
+      exit(1);
+    }
+    else if (strpos > 0)
+    {
+      std::cout << "full file path " << path
+                << "does not start with " << toreplace << std::endl;
+      exit(1);
+    }
+    path.replace(path.begin(), path.begin() + toreplace.size(), "s3://sphenixs3.rcf.bnl.gov:9000");
+    return path;
+  }
+}  // namespace
+
 const char *
 FROG::location(const std::string &logical_name)
+{
+  const char *gsearchpath_env = getenv("GSEARCHPATH");
+  if (logical_name.empty() || logical_name.find('/') != std::string::npos || gsearchpath_env == nullptr)
+  {
+    // nothing to look up
+    return search(logical_name).c_str();
+  }
+  const std::string key = cache_key(gsearchpath_env, logical_name);
+  std::shared_future<std::string> cached;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    auto iter = location_cache().find(key);
+    if (iter != location_cache().end())
+    {
+      cached = iter->second;
+    }
+  }
+  if (cached.valid())
+  {
+    // waits if the lookup is still running in the background
+    pfn = cached.get();
+    if (found(logical_name, pfn))
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << "FROG: cached location for " << logical_name << ": " << pfn << std::endl;
+      }
+      return pfn.c_str();
+    }
+    // a background lookup which did not find the file, the file might have appeared since
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    location_cache().erase(key);
+  }
+  search(logical_name);
+  if (found(logical_name, pfn))
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    location_cache().emplace(key, ready(pfn));
+  }
+  return pfn.c_str();
+}
+
+int FROG::locate(const std::vector<std::string> &logical_names)
+{
+  const char *gsearchpath_env = getenv("GSEARCHPATH");
+  if (gsearchpath_env == nullptr)
+  {
+    return 0;
+  }
+  const std::string gsearchpath(gsearchpath_env);
+  std::vector<std::string> todo;
+  {
+    std::set<std::string> seen;
+    std::lock_guard<std::mutex> lock(cache_mutex());
+    for (const auto &lfn : logical_names)
+    {
+      if (lfn.empty() || lfn.find('/') != std::string::npos ||
+          location_cache().find(cache_key(gsearchpath, lfn)) != location_cache().end() ||
+          !seen.insert(lfn).second)
+      {
+        continue;
+      }
+      todo.push_back(lfn);
+    }
+  }
+  if (todo.empty())
+  {
+    return 0;
+  }
+
+  std::vector<std::string> searchpath;
+  bool usecatalog = false;
+  boost::char_separator<char> sep(":");
+  boost::tokenizer<boost::char_separator<char> > tok(gsearchpath, sep);
+  for (auto &iter : tok)
+  {
+    searchpath.push_back(iter);
+    if (iter == "PG" || iter == "DCACHE" || iter == "XROOTD" || iter == "LUSTRE" || iter == "MINIO")
+    {
+      usecatalog = true;
+    }
+  }
+
+  // all catalog entries of all files, a few queries instead of one per file and search path entry
+  std::map<std::string, std::vector<std::pair<std::string, std::string>>> catalog;
+  // without the catalog entries the results of the catalog search path entries are not valid
+  bool catalogfailed = usecatalog && !GetConnection();
+  if (usecatalog && !catalogfailed)
+  {
+    for (size_t first = 0; first < todo.size(); first += m_MAX_QUERY_NAMES)
+    {
+      std::string sqlquery = "SELECT lfn, full_host_name, full_file_path from files where lfn in (";
+      const size_t last = std::min(todo.size(), first + m_MAX_QUERY_NAMES);
+      for (size_t i = first; i < last; ++i)
+      {
+        std::string quoted = todo[i];
+        for (size_t pos = quoted.find('\''); pos != std::string::npos; pos = quoted.find('\'', pos + 2))
+        {
+          quoted.insert(pos, 1, '\'');
+        }
+        sqlquery += (i == first ? "'" : ",'") + quoted + "'";
+      }
+      sqlquery += ")";
+      if (Verbosity() > 1)
+      {
+        std::cout << "sql query:" << std::endl
+                  << sqlquery << std::endl;
+      }
+      try
+      {
+        odbc::Statement *stmt = m_OdbcConnection->createStatement();
+        odbc::ResultSet *rs = stmt->executeQuery(sqlquery);
+        while (rs->next())
+        {
+          catalog[rs->getString(1)].emplace_back(rs->getString(2), rs->getString(3));
+        }
+        delete rs;
+        delete stmt;
+      }
+      catch (odbc::SQLException &e)
+      {
+        std::cout << PHWHERE << " catalog query failed: " << e.getMessage() << std::endl;
+        catalogfailed = true;
+        break;
+      }
+    }
+  }
+  Disconnect();
+  if (catalogfailed)
+  {
+    // location() searches these files again, one at a time
+    std::cout << PHWHERE << " file catalog not available, " << todo.size() << " files not located" << std::endl;
+    return 0;
+  }
+
+  // the remaining file system probes are independent and mostly wait on the file servers
+  std::vector<std::string> results(todo.size());
+  const std::vector<std::pair<std::string, std::string>> nocatalog;
+  std::atomic<size_t> next{0};
+  auto probe = [&]()
+  {
+    for (size_t i = next++; i < todo.size(); i = next++)
+    {
+      auto iter = catalog.find(todo[i]);
+      results[i] = evaluate(todo[i], searchpath, (iter == catalog.end()) ? nocatalog : iter->second);
+    }
+  };
+  const unsigned int nthreads = std::min<size_t>({todo.size(), std::max(1U, std::thread::hardware_concurrency()), m_MAX_PROBE_THREADS});
+  std::vector<std::thread> threads;
+  for (unsigned int i = 1; i < nthreads; ++i)
+  {
+    threads.emplace_back(probe);
+  }
+  probe();
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  int nlocated = 0;
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  for (size_t i = 0; i < todo.size(); ++i)
+  {
+    // files which were not found are searched again by location()
+    if (!found(todo[i], results[i]))
+    {
+      continue;
+    }
+    location_cache().emplace(cache_key(gsearchpath, todo[i]), ready(results[i]));
+    ++nlocated;
+    if (Verbosity() > 1)
+    {
+      std::cout << "FROG: " << todo[i] << " located at " << results[i] << std::endl;
+    }
+  }
+  return nlocated;
+}
+
+void FROG::prefetch(const std::string &logical_name)
+{
+  const char *gsearchpath_env = getenv("GSEARCHPATH");
+  if (logical_name.empty() || logical_name.find('/') != std::string::npos || gsearchpath_env == nullptr)
+  {
+    return;
+  }
+  const std::string key = cache_key(gsearchpath_env, logical_name);
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  if (location_cache().find(key) != location_cache().end())
+  {
+    return;
+  }
+  const int verbosity = Verbosity();
+  // a separate FROG with its own catalog connection
+  location_cache().emplace(key, std::async(std::launch::async, [logical_name, verbosity]()
+                                           {
+                                             FROG frog;
+                                             frog.Verbosity(verbosity);
+                                             return frog.search(logical_name); })
+                                    .share());
+}
+
+void FROG::clearCache()
+{
+  std::lock_guard<std::mutex> lock(cache_mutex());
+  location_cache().clear();
+}
+
+std::string FROG::evaluate(const std::string &logical_name, const std::vector<std::string> &searchpath,
+                           const std::vector<std::pair<std::string, std::string>> &catalog) const
+{
+  // same order and rules as the individual searches, first matching catalog entry wins
+  auto first_entry = [&catalog](const auto &match) -> const std::string *
+  {
+    for (const auto &entry : catalog)
+    {
+      if (match(entry.first))
+      {
+        return &entry.second;
+      }
+    }
+    return nullptr;
+  };
+  auto is_lustre = [](const std::string &host)
+  { return host == "lustre"; };
+  for (const auto &iter : searchpath)
+  {
+    if (iter == "PG")
+    {
+      const std::string *path = first_entry([](const std::string &host)
+                                            { return host != "hpss" && host != "dcache" && host != "lustre"; });
+      if (path)
+      {
+        return *path;
+      }
+    }
+    else if (iter == "DCACHE")
+    {
+      const std::string *path = first_entry([](const std::string &host)
+                                            { return host == "dcache"; });
+      if (path && std::ifstream(*path))
+      {
+        return "dcache:" + *path;
+      }
+    }
+    else if (iter == "XROOTD")
+    {
+      const std::string *path = first_entry(is_lustre);
+      if (path)
+      {
+        return "root://xrdsphenix.rcf.bnl.gov/" + *path;
+      }
+    }
+    else if (iter == "LUSTRE")
+    {
+      const std::string *path = first_entry(is_lustre);
+      if (path)
+      {
+        return *path;
+      }
+    }
+    else if (iter == "MINIO")
+    {
+      const std::string *path = first_entry(is_lustre);
+      if (path)
+      {
+        return lustre_to_minio(*path);
+      }
+    }
+    else  // assuming this is a file path
+    {
+      std::string fullfile(iter);
+      fullfile.append("/").append(logical_name);
+      if (std::ifstream(fullfile))
+      {
+        return fullfile;
+      }
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "FROG: " << logical_name << " not found in GSEARCHPATH" << std::endl;
+  }
+  return logical_name;
+}
+
+const std::string &
+FROG::search(const std::string &logical_name)
 {
   pfn = logical_name;
   if (logical_name.empty() || logical_name.find('/') != std::string::npos)
@@ -35,14 +383,14 @@ FROG::location(const std::string &logical_name)
         std::cout << "FROG: found / in filename, assuming it contains a full path" << std::endl;
       }
     }
-    return pfn.c_str();
+    return pfn;
   }
   try
   {
     char *gsearchpath_env = getenv("GSEARCHPATH");
     if (gsearchpath_env == nullptr)
     {
-      return pfn.c_str();
+      return pfn;
     }
     std::string gsearchpath(gsearchpath_env);
     if (Verbosity() > 0)
@@ -161,7 +509,7 @@ FROG::location(const std::string &logical_name)
     }
   }
   Disconnect();
-  return pfn.c_str();
+  return pfn;
 }
 
 bool FROG::localSearch(const std::string &logical_name)
@@ -337,23 +685,7 @@ bool FROG::MinIOSearch(const std::string &lname)
 
   if (rs->next())
   {
-    pfn = rs->getString(1);
-    std::string toreplace("/sphenix/lustre01/sphnxpro");
-    size_t strpos = pfn.find(toreplace);
-    if (strpos == std::string::npos)
-    {
-      std::cout << " could not locate " << toreplace 
-		<< " in full file path " << pfn << std::endl;
-      exit(1);
-    }
-    else if (strpos > 0)
-    {
-      std::cout << "full file path " << pfn 
-		<< "does not start with " << toreplace << std::endl;
-      exit(1);
-
-    }
-    pfn.replace(pfn.begin(),pfn.begin()+toreplace.size(),"s3://sphenixs3.rcf.bnl.gov:9000");
+    pfn = lustre_to_minio(rs->getString(1));
     bret = true;
   }
   delete rs;
@@ -4,6 +4,8 @@
 #define FROG_FROG_H
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace odbc
 {
@@ -16,7 +18,17 @@ class FROG
   FROG() {}
   virtual ~FROG() {}
 
+  //! physical location of a logical file name following GSEARCHPATH
+  //! found files are cached for the job, files resolved by locate() or prefetch() are not searched again
   const char *location(const std::string &logical_name);
+  //! resolve a list of logical names with one file catalog query and concurrent file probes
+  //! returns the number of names which were found and added to the cache,
+  //! nothing is cached if the catalog query fails
+  int locate(const std::vector<std::string> &logical_names);
+  //! start resolving a logical name in the background, location() waits for the result
+  void prefetch(const std::string &logical_name);
+  //! forget all cached locations
+  static void clearCache();
   bool localSearch(const std::string &lname);
   bool dCacheSearch(const std::string &lname);
   bool XRootDSearch(const std::string &lname);
@@ -27,11 +39,18 @@ class FROG
   int Verbosity() const { return m_Verbosity; }
 
  private:
+  //! uncached search through GSEARCHPATH, sets pfn
+  const std::string &search(const std::string &logical_name);
+  //! location from catalog entries (host, path) fetched by locate()
+  std::string evaluate(const std::string &logical_name, const std::vector<std::string> &searchpath,
+                       const std::vector<std::pair<std::string, std::string>> &catalog) const;
   bool GetConnection();
   void Disconnect();
   static const int m_MAX_NUM_RETRIES {3000};
   static const int m_MIN_SLEEP_DUR {5000}; // milliseconds
   static const int m_MAX_SLEEP_DUR {30000}; // milliseconds
+  static const unsigned int m_MAX_PROBE_THREADS {8};
+  static const unsigned int m_MAX_QUERY_NAMES {500}; // lfns per catalog query in locate()
 
   odbc::Connection *m_OdbcConnection {nullptr};
   int m_Verbosity {0};
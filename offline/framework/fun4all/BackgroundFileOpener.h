@@ -0,0 +1,66 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_BACKGROUNDFILEOPENER_H
+#define FUN4ALL_BACKGROUNDFILEOPENER_H
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+
+//! opens the next input file on a background thread while the current one is processed
+/*!
+  The opener runs on its own thread and returns the physical file name and the opened
+  object (nullptr if the open failed). fileopen() takes the prepared result if it
+  asks for the same file, otherwise the result is discarded and the file is opened
+  as usual. The opener must only touch objects it creates itself.
+*/
+template <typename T>
+class BackgroundFileOpener
+{
+ public:
+  using Result = std::pair<std::string, std::unique_ptr<T>>;
+
+  BackgroundFileOpener() = default;
+  ~BackgroundFileOpener() { reset(); }
+  BackgroundFileOpener(const BackgroundFileOpener &) = delete;
+  BackgroundFileOpener &operator=(const BackgroundFileOpener &) = delete;
+
+  //! start opening filename, a previously prepared file is discarded
+  void start(const std::string &filename, std::function<Result(const std::string &)> opener)
+  {
+    reset();
+    m_FileName = filename;
+    m_Future = std::async(std::launch::async, std::move(opener), filename);
+  }
+
+  //! prepared result for filename, waits if the open is still running
+  //! the object is nullptr if this file was not prepared or could not be opened
+  Result take(const std::string &filename)
+  {
+    if (!m_Future.valid() || filename != m_FileName)
+    {
+      reset();
+      return {};
+    }
+    m_FileName.clear();
+    return m_Future.get();
+  }
+
+  //! wait for a running open and discard its result
+  void reset()
+  {
+    if (m_Future.valid())
+    {
+      m_Future.get();
+    }
+    m_FileName.clear();
+  }
+
+ private:
+  std::string m_FileName;
+  std::future<Result> m_Future;
+};
+
+#endif
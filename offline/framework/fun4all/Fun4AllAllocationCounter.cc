@@ -0,0 +1,69 @@
+#include "Fun4AllAllocationCounter.h"
+
+#include <atomic>
+
+namespace
+{
+  // plain arrays with constant initialization, usable during static
+  // initialization and from any thread without allocating
+  class alignas(64) Block
+  {
+   public:
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> allocated{0};
+    std::atomic<int64_t> frees{0};
+    std::atomic<int64_t> freed{0};
+  };
+
+  constexpr unsigned int nblocks = 64;
+  Block blocks[nblocks];
+  std::atomic<unsigned int> nextblock{0};
+  std::atomic<bool> active{false};
+
+  Block &thread_block()
+  {
+    thread_local Block *block = nullptr;
+    if (!block)
+    {
+      block = &blocks[nextblock.fetch_add(1, std::memory_order_relaxed) % nblocks];
+    }
+    return *block;
+  }
+}  // namespace
+
+bool Fun4AllAllocationCounter::Active()
+{
+  return active.load(std::memory_order_relaxed);
+}
+
+void Fun4AllAllocationCounter::SetActive()
+{
+  active.store(true, std::memory_order_relaxed);
+}
+
+void Fun4AllAllocationCounter::Allocated(const size_t bytes)
+{
+  Block &block = thread_block();
+  block.allocations.fetch_add(1, std::memory_order_relaxed);
+  block.allocated.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Fun4AllAllocationCounter::Freed(const size_t bytes)
+{
+  Block &block = thread_block();
+  block.frees.fetch_add(1, std::memory_order_relaxed);
+  block.freed.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+Fun4AllAllocationCounter::Counts Fun4AllAllocationCounter::Total()
+{
+  Counts counts;
+  for (const auto &block : blocks)
+  {
+    counts.Allocations += block.allocations.load(std::memory_order_relaxed);
+    counts.AllocatedBytes += block.allocated.load(std::memory_order_relaxed);
+    counts.Frees += block.frees.load(std::memory_order_relaxed);
+    counts.FreedBytes += block.freed.load(std::memory_order_relaxed);
+  }
+  return counts;
+}
@@ -0,0 +1,51 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLALLOCATIONCOUNTER_H
+#define FUN4ALL_FUN4ALLALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+//! heap allocation counters of the process
+/*!
+  Filled by the operator new/delete replacements in libfun4allmemhooks,
+  which is opt-in since it changes the allocator of the whole process:
+
+    LD_PRELOAD=libfun4allmemhooks.so root.exe Fun4All_macro.C
+
+  (or gSystem->Load("libfun4allmemhooks") first thing in the macro,
+  which misses allocations of libraries loaded before). With module
+  profiling enabled, Fun4AllServer takes the difference of Total()
+  around each module, see Fun4AllServer::ModuleProfile. Allocations
+  in helper threads count for the module running at that time.
+  Without the hooks Active() is false and all counts stay 0.
+
+  The counters are spread over cache line sized blocks, one per thread
+  (threads share blocks beyond 64 threads), so counting does not
+  serialize multithreaded modules.
+*/
+class Fun4AllAllocationCounter
+{
+ public:
+  class Counts
+  {
+   public:
+    int64_t Allocations{0};
+    int64_t AllocatedBytes{0};
+    int64_t Frees{0};
+    int64_t FreedBytes{0};
+  };
+
+  //! true if the hooks library is loaded
+  static bool Active();
+
+  //! sum over all threads since the start of the job
+  static Counts Total();
+
+  //! called by the hooks, must not allocate
+  static void Allocated(const size_t bytes);
+  static void Freed(const size_t bytes);
+  static void SetActive();
+};
+
+#endif
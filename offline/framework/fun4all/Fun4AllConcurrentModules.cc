@@ -0,0 +1,230 @@
+#include "Fun4AllConcurrentModules.h"
+
+#include "Fun4AllReturnCodes.h"
+#include "Fun4AllServer.h"
+
+#include <phool/PHThreadPool.h>
+#include <phool/phool.h>
+
+#include <TDirectory.h>
+#include <TROOT.h>  // for ROOT::EnableThreadSafety
+#include <TSystem.h>
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+
+Fun4AllConcurrentModules::Fun4AllConcurrentModules(const std::string &name)
+  : SubsysReco(name)
+{
+}
+
+Fun4AllConcurrentModules::~Fun4AllConcurrentModules()
+{
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      delete subsystem;
+    }
+  }
+}
+
+void Fun4AllConcurrentModules::registerSubsystem(SubsysReco *subsystem, const unsigned int stage)
+{
+  if (m_Stages.empty())
+  {
+    // the modules run on several threads, which needs ROOT's global locks and per thread gDirectory
+    ROOT::EnableThreadSafety();
+  }
+  if (stage >= m_Stages.size())
+  {
+    m_Stages.resize(stage + 1);
+    m_Timers.resize(m_Stages.size());
+  }
+  m_Stages[stage].push_back(subsystem);
+  m_Timers[stage].set_name(Name() + "_stage" + std::to_string(stage));
+}
+
+int Fun4AllConcurrentModules::Init(PHCompositeNode *topNode)
+{
+  for (auto &stage : m_Stages)
+  {
+    for (auto iter = stage.begin(); iter != stage.end();)
+    {
+      int iret = (*iter)->Init(topNode);
+      if (iret == Fun4AllReturnCodes::DONOTREGISTERSUBSYSTEM)
+      {
+        if (Verbosity() > 0)
+        {
+          std::cout << Name() << ": not running " << (*iter)->Name() << std::endl;
+        }
+        delete *iter;
+        iter = stage.erase(iter);
+        continue;
+      }
+      if (iret != Fun4AllReturnCodes::EVENT_OK)
+      {
+        std::cout << PHWHERE << " " << (*iter)->Name() << " Init() returned " << iret << std::endl;
+        return iret;
+      }
+      ++iter;
+    }
+  }
+  m_RetCodes.resize(m_Stages.size());
+  m_Errors.resize(m_Stages.size());
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllConcurrentModules::InitRun(PHCompositeNode *topNode)
+{
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      int iret = subsystem->InitRun(topNode);
+      if (iret != Fun4AllReturnCodes::EVENT_OK)
+      {
+        std::cout << PHWHERE << " " << subsystem->Name() << " InitRun() returned " << iret << std::endl;
+        return iret;
+      }
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllConcurrentModules::process_event(PHCompositeNode *topNode)
+{
+  // the server cd'ed to the directory of this module, gDirectory of the worker threads is their own
+  TDirectory *moduledir = gDirectory;
+  // tasks must not throw, exceptions are caught per stage and reported afterwards
+  auto run_stage = [this, topNode, moduledir](size_t istage)
+  {
+    // restores the gDirectory of the worker thread when the stage is done
+    TDirectory::TContext dircontext(moduledir);
+    m_Timers[istage].restart();
+    int iret = Fun4AllReturnCodes::EVENT_OK;
+    for (auto *subsystem : m_Stages[istage])
+    {
+      // like the server, every module starts in the directory it was given
+      moduledir->cd();
+      try
+      {
+        iret = Combine(iret, subsystem->process_event(topNode));
+      }
+      catch (const std::exception &e)
+      {
+        m_Errors[istage] = subsystem->Name() + ": " + e.what();
+      }
+      catch (...)
+      {
+        m_Errors[istage] = subsystem->Name() + ": unknown exception";
+      }
+      // like the server, an aborted event skips the rest of the stage
+      if (iret < 0 || !m_Errors[istage].empty())
+      {
+        break;
+      }
+    }
+    m_RetCodes[istage] = iret;
+    m_Timers[istage].stop();
+  };
+  Fun4AllServer::instance()->ThreadPool()->parallel_for(m_Stages.size(), run_stage);
+
+  int iret = Fun4AllReturnCodes::EVENT_OK;
+  for (size_t istage = 0; istage < m_Stages.size(); ++istage)
+  {
+    if (!m_Errors[istage].empty())
+    {
+      std::cout << PHWHERE << " caught exception thrown during process_event from "
+                << m_Errors[istage] << std::endl;
+      gSystem->Exit(1);
+    }
+    iret = Combine(iret, m_RetCodes[istage]);
+  }
+  return iret;
+}
+
+int Fun4AllConcurrentModules::ResetEvent(PHCompositeNode *topNode)
+{
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      subsystem->ResetEvent(topNode);
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllConcurrentModules::EndRun(const int runnumber)
+{
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      subsystem->EndRun(runnumber);
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int Fun4AllConcurrentModules::End(PHCompositeNode *topNode)
+{
+  int iret = Fun4AllReturnCodes::EVENT_OK;
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      iret += subsystem->End(topNode);
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    Print("TIMER");
+  }
+  return iret;
+}
+
+int Fun4AllConcurrentModules::Reset(PHCompositeNode *topNode)
+{
+  int iret = Fun4AllReturnCodes::EVENT_OK;
+  for (auto &stage : m_Stages)
+  {
+    for (auto *subsystem : stage)
+    {
+      iret += subsystem->Reset(topNode);
+    }
+  }
+  return iret;
+}
+
+void Fun4AllConcurrentModules::Print(const std::string &what) const
+{
+  for (size_t istage = 0; istage < m_Stages.size(); ++istage)
+  {
+    if (what == "ALL" || what == "MODULES")
+    {
+      std::cout << Name() << " stage " << istage << ":";
+      for (auto *subsystem : m_Stages[istage])
+      {
+        std::cout << " " << subsystem->Name();
+      }
+      std::cout << std::endl;
+    }
+    if (what == "ALL" || what == "TIMER")
+    {
+      m_Timers[istage].print_stat();
+    }
+  }
+}
+
+int Fun4AllConcurrentModules::Combine(const int iret1, const int iret2)
+{
+  // aborts are negative (the more negative the more severe), discard is positive
+  if (iret1 < 0 || iret2 < 0)
+  {
+    return std::min(iret1, iret2);
+  }
+  return std::max(iret1, iret2);
+}
@@ -0,0 +1,71 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLCONCURRENTMODULES_H
+#define FUN4ALL_FUN4ALLCONCURRENTMODULES_H
+
+#include "SubsysReco.h"
+
+#include <phool/PHTimer.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+//! runs independent chains of modules concurrently within an event
+/*!
+  The modules of a stage run in the order they were registered, the
+  stages run in parallel on the threads of Fun4AllServer::ThreadPool()
+  (recoConsts flag NTHREADS). E.g. the calorimeter reconstruction can
+  run while the tracking works on the same event:
+
+    Fun4AllConcurrentModules *stages = new Fun4AllConcurrentModules();
+    stages->registerSubsystem(new CaloTowerBuilder("CEMCBUILDER"), 0);
+    stages->registerSubsystem(new RawClusterBuilderTemplate("EmcRawClusterBuilderTemplate"), 0);
+    stages->registerSubsystem(new PHActsSiliconSeeding(), 1);
+    se->registerSubsystem(stages);
+
+  The stages share the node tree. Modules in different stages must not
+  write to the same nodes or read what another stage writes in this
+  event, and they must create their nodes in Init() or InitRun(). All
+  other methods (Init, InitRun, End, ...) run serially in stage order.
+  Event processing is pipelined across modules of one event, not across
+  events: modules cache pointers into the node tree, so there is only
+  one event in flight.
+*/
+class Fun4AllConcurrentModules : public SubsysReco
+{
+ public:
+  Fun4AllConcurrentModules(const std::string &name = "CONCURRENTMODULES");
+
+  //! deletes the registered modules
+  ~Fun4AllConcurrentModules() override;
+
+  //! add a module to the end of a stage, the module is owned by this object
+  void registerSubsystem(SubsysReco *subsystem, const unsigned int stage);
+
+  int Init(PHCompositeNode *topNode) override;
+  int InitRun(PHCompositeNode *topNode) override;
+
+  //! runs the stages in parallel, returns the most severe return code of all modules
+  int process_event(PHCompositeNode *topNode) override;
+
+  int ResetEvent(PHCompositeNode *topNode) override;
+  int EndRun(const int runnumber) override;
+  int End(PHCompositeNode *topNode) override;
+  int Reset(PHCompositeNode *topNode) override;
+  void Print(const std::string &what = "ALL") const override;
+
+ private:
+  //! the more severe of two process_event return codes
+  static int Combine(const int iret1, const int iret2);
+
+  std::vector<std::vector<SubsysReco *>> m_Stages;
+
+  //! per stage results of process_event, filled by the worker threads
+  std::vector<int> m_RetCodes;
+  std::vector<std::string> m_Errors;
+  std::vector<PHTimer> m_Timers;
+};
+
+#endif
@@ -1,5 +1,6 @@
 #include "Fun4AllDstInputManager.h"
 
+#include "BackgroundFileOpener.h"
 #include "Fun4AllReturnCodes.h"
 #include "Fun4AllServer.h"
 
@@ -18,16 +19,23 @@
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/phooldefs.h>
 
+#include <TEnv.h>
+#include <TROOT.h>
 #include <TSystem.h>
+#include <TTreeCacheUnzip.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
 #include <boost/algorithm/string.hpp>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <memory>
+#include <sstream>
 #include <utility>   // for pair
 #include <vector>    // for vector
 
@@ -41,6 +49,7 @@ Fun4AllDstInputManager::Fun4AllDstInputManager(const std::string &name, const st
 
 Fun4AllDstInputManager::~Fun4AllDstInputManager()
 {
+  delete m_NextFile;
   delete m_IManager;
   delete m_RunNodeSum;
   return;
@@ -57,11 +66,25 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  fullfilename = frog.location(FileName());
+  // file opened on a background thread while the previous one was read
+  BackgroundFileOpener<PHNodeIOManager>::Result prepared;
+  if (m_NextFile)
+  {
+    prepared = m_NextFile->take(FileName());
+  }
+  if (prepared.second)
+  {
+    fullfilename = prepared.first;
+  }
+  else
+  {
+    FROG frog;
+    fullfilename = frog.location(FileName());
+  }
   if (Verbosity() > 0)
   {
-    std::cout << Name() << ": opening file " << fullfilename << std::endl;
+    std::cout << Name() << ": opening file " << fullfilename
+              << (prepared.second ? " (opened in background)" : "") << std::endl;
   }
   // sanity check - the IManager must be nullptr when this method is executed
   // if not something is very very wrong and we must not continue
@@ -128,11 +151,36 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
   }
   // now open the dst node
   dstNode = se->getNode(InputNode(), TopNodeName());
-  m_IManager = new PHNodeIOManager(fullfilename, PHReadOnly);
+  if (m_ReadAheadCacheSize > 0)
+  {
+    // both settings are global and need to be set before the file is opened
+    gEnv->SetValue("TFile.AsyncPrefetching", 1);
+    TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+  }
+  m_IManager = prepared.second ? prepared.second.release() : new PHNodeIOManager(fullfilename, PHReadOnly);
   if (m_IManager->isFunctional())
   {
     IsOpen(1);
+    m_IManager->SetReadCacheSize(m_ReadAheadCacheSize);
+    m_IManager->EnableIOTiming(m_IOTimingFlag);
+    m_IManager->SetLazyRead(m_LazyReadFlag);
     events_thisfile = 0;
+    m_FileEntries = nullptr;
+    m_FileEntryPosition = 0;
+    if (!m_EventIndex.empty())
+    {
+      auto iter = m_EventIndex.find(FileName());
+      if (iter != m_EventIndex.end())
+      {
+        m_FileEntries = &iter->second;
+        m_IManager->SetEntryList(iter->second);
+        if (Verbosity() > 0)
+        {
+          std::cout << Name() << ": reading " << m_FileEntries->size()
+                    << " indexed events from " << FileName() << std::endl;
+        }
+      }
+    }
     setBranches();                // set branch selections
     AddToFileOpened(FileName());  // add file to the list of files which were opened
                                   // check if our input file has a sync object or not
@@ -144,7 +192,29 @@ int Fun4AllDstInputManager::fileopen(const std::string &filenam)
     {
       m_HaveSyncObject = -1;
     }
-
+    if (OpenNextFileInBackground() && !NextFileName().empty())
+    {
+      if (!m_NextFile)
+      {
+        // TFile::Open on another thread needs ROOT's global locks and per thread gDirectory
+        ROOT::EnableThreadSafety();
+        m_NextFile = new BackgroundFileOpener<PHNodeIOManager>();
+      }
+      m_NextFile->start(NextFileName(), [](const std::string &lfn)
+                        {
+                          FROG frog;
+                          std::string location = frog.location(lfn);
+                          auto iman = std::make_unique<PHNodeIOManager>(location, PHReadOnly);
+                          if (!iman->isFunctional())
+                          {
+                            iman.reset();
+                          }
+                          else
+                          {
+                            iman->GetBranchMap();  // reads the TTree header
+                          }
+                          return BackgroundFileOpener<PHNodeIOManager>::Result(location, std::move(iman)); });
+    }
     return 0;
   }
   else
@@ -185,7 +255,7 @@ int Fun4AllDstInputManager::run(const int nevents)
 readagain:
   PHCompositeNode *dummy;
   int ncount = 0;
-  dummy = m_IManager->read(dstNode);
+  dummy = ReadNextEvent();
   while (dummy)
   {
     ncount++;
@@ -193,7 +263,7 @@ readagain:
     {
       break;
     }
-    dummy = m_IManager->read(dstNode);
+    dummy = ReadNextEvent();
   }
   if (!dummy)
   {
@@ -224,8 +294,17 @@ int Fun4AllDstInputManager::fileclose()
     std::cout << Name() << ": fileclose: No Input file open" << std::endl;
     return -1;
   }
+  if (m_IOTimingFlag)
+  {
+    m_IManager->PrintIOTiming();
+  }
+  if (m_LazyReadFlag)
+  {
+    m_UsedBranches.insert(m_IManager->UsedBranches().begin(), m_IManager->UsedBranches().end());
+  }
   delete m_IManager;
   m_IManager = nullptr;
+  m_FileEntries = nullptr;
   IsOpen(0);
   UpdateFileList();
   m_HaveSyncObject = 0;
@@ -374,7 +453,7 @@ int Fun4AllDstInputManager::SyncIt(const SyncObject *mastersync)
       // Here the event counter and segment number and run number do agree - we found the right match
       // now read the full event (previously we only read the sync object)
       PHCompositeNode *dummy;
-      dummy = m_IManager->read(dstNode);
+      dummy = ReadNextEvent();
       if (!dummy)
       {
         std::cout << PHWHERE << " " << Name() << " Could not read full Event" << std::endl;
@@ -465,8 +544,20 @@ readnextsync:
     // so check if IManager is valid before getting a new event
     if (m_IManager)
     {
-      EventOnDst = m_IManager->getEventNumber();  // this returns the next number of the event
-      itest = m_IManager->readSpecific(EventOnDst, syncbranchname.c_str());
+      if (m_FileEntries)
+      {
+        // the next event is the next entry of the index, not the next one on the dst
+        if (m_FileEntryPosition < m_FileEntries->size())
+        {
+          EventOnDst = (*m_FileEntries)[m_FileEntryPosition];
+          itest = m_IManager->readSpecific(EventOnDst, syncbranchname.c_str());
+        }
+      }
+      else
+      {
+        EventOnDst = m_IManager->getEventNumber();  // this returns the next number of the event
+        itest = m_IManager->readSpecific(EventOnDst, syncbranchname.c_str());
+      }
     }
     else
     {
@@ -479,7 +570,7 @@ readnextsync:
   }
   else
   {
-    if (m_IManager->read(dstNode))
+    if (ReadNextEvent())
     {
       itest = 1;
     }
@@ -507,6 +598,10 @@ readnextsync:
   {
     EventOnDst++;
     m_IManager->setEventNumber(EventOnDst);  // update event number in phool io manager
+    if (m_FileEntries)
+    {
+      m_FileEntryPosition++;
+    }
   }
   else
   {
@@ -620,6 +715,23 @@ void Fun4AllDstInputManager::Print(const std::string &what) const
       std::cout << std::endl;
     }
   }
+  if ((what == "ALL" || what == "BRANCHUSAGE") && m_LazyReadFlag)
+  {
+    std::set<std::string> used = m_UsedBranches;
+    if (m_IManager)
+    {
+      used.insert(m_IManager->UsedBranches().begin(), m_IManager->UsedBranches().end());
+    }
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Branches used by this job in Fun4AllDstInputManager " << Name()
+              << " (" << used.size() << "), to read only those:" << std::endl;
+    std::cout << "in->BranchSelect(\"*\", 0);" << std::endl;
+    for (const auto &branch : used)
+    {
+      std::cout << "in->BranchSelect(\"" << branch << "\", 1);" << std::endl;
+    }
+  }
   if ((what == "ALL" || what == "PHOOL") && m_IManager)
   {
     // loop over the map and print out the content (name and location in memory)
@@ -634,6 +746,19 @@ void Fun4AllDstInputManager::Print(const std::string &what) const
 
 int Fun4AllDstInputManager::PushBackEvents(const int i)
 {
+  if (m_IManager && m_FileEntries)
+  {
+    // move in the index (negative i skips ahead), the next read sets the event number from it
+    if (i > 0)
+    {
+      m_FileEntryPosition -= std::min(m_FileEntryPosition, static_cast<size_t>(i));
+    }
+    else
+    {
+      m_FileEntryPosition = std::min(m_FileEntries->size(), m_FileEntryPosition + static_cast<size_t>(-i));
+    }
+    return 0;
+  }
   if (m_IManager)
   {
     unsigned EventOnDst = m_IManager->getEventNumber();
@@ -646,6 +771,20 @@ int Fun4AllDstInputManager::PushBackEvents(const int i)
   return -1;
 }
 
+bool Fun4AllDstInputManager::ConcurrentReadOk() const
+{
+  // opening the next file and the local SubsysRecos (RejectEvent) change the node tree
+  if (!IsOpen() || !m_IManager || !events_thisfile || HasSubsystems())
+  {
+    return false;
+  }
+  if (m_FileEntries)
+  {
+    return m_FileEntryPosition < m_FileEntries->size();
+  }
+  return m_IManager->getEventNumber() < m_IManager->GetEntries();
+}
+
 int Fun4AllDstInputManager::HasSyncObject() const
 {
   if (m_HaveSyncObject)
@@ -660,3 +799,88 @@ int Fun4AllDstInputManager::HasSyncObject() const
   }
   return 0;
 }
+
+PHCompositeNode *Fun4AllDstInputManager::ReadNextEvent()
+{
+  if (!m_FileEntries)
+  {
+    return m_IManager->read(dstNode);
+  }
+  if (m_FileEntryPosition >= m_FileEntries->size())
+  {
+    return nullptr;
+  }
+  // PHNodeIOManager::read reads the entry given by the event number
+  m_IManager->setEventNumber((*m_FileEntries)[m_FileEntryPosition]);
+  m_FileEntryPosition++;
+  return m_IManager->read(dstNode);
+}
+
+long Fun4AllDstInputManager::CurrentEntry() const
+{
+  if (!m_IManager)
+  {
+    return -1;
+  }
+  // the io manager points to the entry after the one read last
+  return static_cast<long>(m_IManager->getEventNumber()) - 1;
+}
+
+int Fun4AllDstInputManager::AddEventIndexFile(const std::string &indexfile)
+{
+  std::ifstream infile(indexfile);
+  if (!infile.is_open())
+  {
+    std::cout << PHWHERE << Name() << ": could not open event index " << indexfile << std::endl;
+    return -1;
+  }
+  // the index lists "file entry" per line, '#' starts a comment
+  std::vector<std::string> newfiles;
+  std::string line;
+  unsigned int nentries = 0;
+  while (std::getline(infile, line))
+  {
+    size_t pos = line.find('#');
+    if (pos != std::string::npos)
+    {
+      line.erase(pos);
+    }
+    std::istringstream linestream(line);
+    std::string filename;
+    long entry = -1;
+    if (!(linestream >> filename))
+    {
+      continue;
+    }
+    if (!(linestream >> entry) || entry < 0)
+    {
+      std::cout << PHWHERE << Name() << ": invalid line in event index " << indexfile
+                << ": " << line << std::endl;
+      return -1;
+    }
+    auto iter = m_EventIndex.find(filename);
+    if (iter == m_EventIndex.end())
+    {
+      iter = m_EventIndex.insert(std::make_pair(filename, std::vector<size_t>())).first;
+      newfiles.push_back(filename);
+    }
+    iter->second.push_back(entry);
+    nentries++;
+  }
+  // reading the entries in ascending order touches every basket only once
+  for (auto &[filename, entries] : m_EventIndex)
+  {
+    std::sort(entries.begin(), entries.end());
+    entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+  }
+  for (auto &filename : newfiles)
+  {
+    AddFile(filename);
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << nentries << " events of " << newfiles.size()
+              << " new files in event index " << indexfile << std::endl;
+  }
+  return 0;
+}
@@ -5,9 +5,14 @@
 
 #include "Fun4AllInputManager.h"
 
+#include <cstddef>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
+template <typename T>
+class BackgroundFileOpener;
 class PHCompositeNode;
 class PHNodeIOManager;
 class SyncObject;
@@ -28,9 +33,29 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   void Print(const std::string &what = "ALL") const override;
   int PushBackEvents(const int i) override;
   int HasSyncObject() const override;
+  // read ahead: TTreeCache of given size in bytes filled by ROOT on a background
+  // thread (asynchronous prefetching), baskets are unzipped in parallel
+  // when ROOT implicit multithreading is enabled. 0 disables it
+  void SetReadAhead(const long cachesize) { m_ReadAheadCacheSize = cachesize; }
+  // print read time per branch and read vs unzip time when a file is closed
+  void EnableIOTiming(const int i = 1) { m_IOTimingFlag = i; }
+  // read only the events listed in an event index written by Fun4AllDstOutputManager::WriteEventIndex
+  // the files of the index are added to the file list, their entries are read in
+  // ascending order (basket by basket) and passed to the TTreeCache as TEntryList
+  int AddEventIndexFile(const std::string &indexfile);
+  // entry of the current event in the current file, -1 if nothing was read yet
+  long CurrentEntry() const;
+  // the node tree of a file is made when its first event is read, after that
+  // the next events of the file can be read concurrently with other input managers
+  bool ConcurrentReadOk() const override;
+  // read the payload of a node only when it is used (findNode::getClass or written out)
+  // instead of all selected branches for every event. Print("BRANCHUSAGE") lists the
+  // branches which were used as BranchSelect calls for the macro
+  void EnableLazyRead(const bool b = true) { m_LazyReadFlag = b; }
 
  protected:
   int ReadNextEventSyncObject();
+  PHCompositeNode *ReadNextEvent();
   void ReadRunTTree(const int i) { m_ReadRunTTree = i; }
   void IManager(PHNodeIOManager *iman) { m_IManager = iman; }
   PHNodeIOManager *IManager() { return m_IManager; }
@@ -49,13 +74,21 @@ class Fun4AllDstInputManager : public Fun4AllInputManager
   int events_thisfile = 0;
   int events_skipped_during_sync = 0;
   int m_HaveSyncObject = 0;
+  int m_IOTimingFlag = 0;
+  long m_ReadAheadCacheSize = 0;
+  bool m_LazyReadFlag = false;
+  std::set<std::string> m_UsedBranches;  // branches used in lazy mode, all files closed so far
   std::map<const std::string, int> branchread;
+  std::map<std::string, std::vector<size_t>> m_EventIndex;  // sorted entries per file
+  const std::vector<size_t> *m_FileEntries = nullptr;       // entries of the open file, nullptr reads all
+  size_t m_FileEntryPosition = 0;
   std::string syncbranchname;
   PHCompositeNode *dstNode = nullptr;
   PHCompositeNode *m_RunNode = nullptr;
   PHCompositeNode *m_RunNodeCopy = nullptr;
   PHCompositeNode *m_RunNodeSum = nullptr;
   PHNodeIOManager *m_IManager = nullptr;
+  BackgroundFileOpener<PHNodeIOManager> *m_NextFile = nullptr;
   SyncObject *syncobject = nullptr;
   std::string RunNode = "RUN";
 };
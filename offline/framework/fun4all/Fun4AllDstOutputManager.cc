@@ -1,5 +1,6 @@
 #include "Fun4AllDstOutputManager.h"
 
+#include "Fun4AllDstInputManager.h"
 #include "Fun4AllServer.h"
 
 #include <phool/PHNode.h>
@@ -8,6 +9,7 @@
 #include <phool/phool.h>  // for PHWHERE, PHReadOnly, PHRunTree
 #include <phool/recoConsts.h>
 
+#include <TROOT.h>
 #include <TSystem.h>
 
 #include <boost/format.hpp>
@@ -85,6 +87,14 @@ void Fun4AllDstOutputManager::Print(const std::string &what) const
         std::cout << Name() << ": Node " << nodename << " is written out" << std::endl;
       }
     }
+    for (auto &[nodename, setting] : m_NodeCompressionSetting)
+    {
+      std::cout << Name() << ": Node " << nodename << " compression setting " << setting << std::endl;
+    }
+    if (!m_EventIndexInput.empty())
+    {
+      std::cout << Name() << ": writes event index of input manager " << m_EventIndexInput << std::endl;
+    }
   }
   // base class print method
   Fun4AllOutputManager::Print(what);
@@ -106,6 +116,10 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
   {
     return 0;
   }
+  if (!m_EventIndexInput.empty())
+  {
+    return WriteEventIndexEntry();
+  }
   if (!dstOut)
   {
     outfile_open_first_write();  //    outfileopen(OutFileName());
@@ -181,7 +195,8 @@ int Fun4AllDstOutputManager::Write(PHCompositeNode *startNode)
 int Fun4AllDstOutputManager::WriteNode(PHCompositeNode *thisNode)
 {
   delete dstOut;
-  if (!m_SaveRunNodeFlag)
+  // the run nodes stay in the files the index points to
+  if (!m_SaveRunNodeFlag || !m_EventIndexInput.empty())
   {
     dstOut = nullptr;
     return 0;
@@ -308,5 +323,46 @@ int Fun4AllDstOutputManager::outfile_open_first_write()
   }
 
   dstOut->SetCompressionSetting(m_CompressionSetting);
+  for (auto &[nodename, setting] : m_NodeCompressionSetting)
+  {
+    dstOut->SetNodeCompressionSetting(nodename, setting);
+  }
+  // with implicit MT TTree::Fill flushes the baskets of all branches in parallel
+  if (m_ParallelCompressionFlag && !ROOT::IsImplicitMTEnabled())
+  {
+    ROOT::EnableImplicitMT(m_ParallelCompressionThreads);
+  }
+  return 0;
+}
+
+int Fun4AllDstOutputManager::WriteEventIndexEntry()
+{
+  Fun4AllServer *se = Fun4AllServer::instance();
+  Fun4AllDstInputManager *in = dynamic_cast<Fun4AllDstInputManager *>(se->getInputManager(m_EventIndexInput));
+  if (!in)
+  {
+    std::cout << PHWHERE << Name() << ": no Fun4AllDstInputManager " << m_EventIndexInput
+              << ", cannot write event index" << std::endl;
+    return -1;
+  }
+  if (!m_EventIndexFile.is_open())
+  {
+    m_EventIndexFile.open(OutFileName());
+    if (!m_EventIndexFile.is_open())
+    {
+      std::cout << PHWHERE << " Could not open " << OutFileName() << std::endl;
+      return -1;
+    }
+    m_EventIndexFile << "# event index of " << m_EventIndexInput << ": file entry" << std::endl;
+  }
+  long entry = in->CurrentEntry();
+  if (entry < 0)
+  {
+    std::cout << PHWHERE << Name() << ": " << m_EventIndexInput
+              << " has no current event" << std::endl;
+    return -1;
+  }
+  // no endl, the stream is flushed when it is closed
+  m_EventIndexFile << in->FileName() << " " << entry << "\n";
   return 0;
 }
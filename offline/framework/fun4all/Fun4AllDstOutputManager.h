@@ -5,6 +5,8 @@
 
 #include "Fun4AllOutputManager.h"
 
+#include <fstream>
+#include <map>
 #include <set>
 #include <string>
 
@@ -33,21 +35,38 @@ class Fun4AllDstOutputManager : public Fun4AllOutputManager
   int Write(PHCompositeNode *startNode) override;
   int WriteNode(PHCompositeNode *thisNode) override;
   std::string UsedOutFileName() const { return m_UsedOutFileName; }
+  int CurrentSegment() const override { return m_CurrentSegment; }
+  void CurrentSegment(const int segment) override { m_CurrentSegment = segment; }
   void CompressionSetting(const int i) override { m_CompressionSetting = i; }
+  // compression setting for a single node (e.g. 404 LZ4 for transient output, 207 LZMA for archival)
+  void NodeCompressionSetting(const std::string &nodename, const int i) { m_NodeCompressionSetting[nodename] = i; }
+  // compress baskets of different branches in parallel with ROOT implicit multithreading
+  // (enables it with nthreads if not already on, 0 uses all cores)
+  void ParallelCompression(const unsigned int nthreads = 0) { m_ParallelCompressionFlag = true; m_ParallelCompressionThreads = nthreads; }
+  // skim by reference: instead of the nodes write "file entry" of every selected event
+  // read by the given Fun4AllDstInputManager to the output file (a text file).
+  // Read it back with Fun4AllDstInputManager::AddEventIndexFile
+  void WriteEventIndex(const std::string &inputmanager) { m_EventIndexInput = inputmanager; }
 
  private:
   int outfile_open_first_write();
+  int WriteEventIndexEntry();
   PHNodeIOManager *dstOut{nullptr};
   int m_SaveRunNodeFlag{1};
   int m_SaveDstNodeFlag{1};
   int m_CompressionSetting{505};
+  bool m_ParallelCompressionFlag{false};
+  unsigned int m_ParallelCompressionThreads{0};
   int m_CurrentSegment{0};
   std::string m_FileNameStem;
   std::string m_UsedOutFileName;
+  std::string m_EventIndexInput;
+  std::ofstream m_EventIndexFile;
   std::set<std::string> savenodes;
   std::set<std::string> saverunnodes;
   std::set<std::string> stripnodes;
   std::set<std::string> striprunnodes;
+  std::map<std::string, int> m_NodeCompressionSetting;
 };
 
 #endif
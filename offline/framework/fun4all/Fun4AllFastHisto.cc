@@ -0,0 +1,134 @@
+#include "Fun4AllFastHisto.h"
+
+#include <TArrayD.h>
+#include <TH1.h>
+#include <TH2.h>
+
+#include <algorithm>
+#include <cmath>
+
+Fun4AllFastHisto::Fun4AllFastHisto(const std::string &name, const std::string &title, const unsigned int nbins, const unsigned int nshards)
+  : m_name(name)
+  , m_title(title)
+  , m_nbins(nbins)
+{
+  setNumShards(nshards);
+}
+
+void Fun4AllFastHisto::setNumShards(const unsigned int nshards)
+{
+  m_shards.resize(std::max(nshards, 1U));
+  for (auto &shard : m_shards)
+  {
+    shard.sumw.resize(m_nbins, 0);
+    shard.sumw2.resize(m_nbins, 0);
+  }
+}
+
+void Fun4AllFastHisto::Reset()
+{
+  for (auto &shard : m_shards)
+  {
+    std::fill(shard.sumw.begin(), shard.sumw.end(), 0);
+    std::fill(shard.sumw2.begin(), shard.sumw2.end(), 0);
+    shard.entries = 0;
+  }
+}
+
+double Fun4AllFastHisto::GetEntries() const
+{
+  double entries = 0;
+  for (const auto &shard : m_shards)
+  {
+    entries += shard.entries;
+  }
+  return entries;
+}
+
+double Fun4AllFastHisto::GetBinContent(const int bin) const
+{
+  if (bin < 0 || bin >= static_cast<int>(m_nbins))
+  {
+    return 0;
+  }
+  double sum = 0;
+  for (const auto &shard : m_shards)
+  {
+    sum += shard.sumw[bin];
+  }
+  return sum;
+}
+
+double Fun4AllFastHisto::GetBinError(const int bin) const
+{
+  if (bin < 0 || bin >= static_cast<int>(m_nbins))
+  {
+    return 0;
+  }
+  double sum = 0;
+  for (const auto &shard : m_shards)
+  {
+    sum += shard.sumw2[bin];
+  }
+  return std::sqrt(sum);
+}
+
+void Fun4AllFastHisto::copyTo(TH1 *h) const
+{
+  // sum the shards in order, so the result does not depend on the thread scheduling
+  std::vector<double> sumw(m_nbins, 0);
+  std::vector<double> sumw2(m_nbins, 0);
+  for (const auto &shard : m_shards)
+  {
+    for (unsigned int bin = 0; bin < m_nbins; ++bin)
+    {
+      sumw[bin] += shard.sumw[bin];
+      sumw2[bin] += shard.sumw2[bin];
+    }
+  }
+
+  h->Sumw2();
+  TArrayD *errors = h->GetSumw2();
+  for (unsigned int bin = 0; bin < m_nbins; ++bin)
+  {
+    h->SetBinContent(bin, sumw[bin]);
+    (*errors)[bin] = sumw2[bin];
+  }
+  // statistics are recomputed from the bin contents
+  h->ResetStats();
+  h->SetEntries(GetEntries());
+}
+
+Fun4AllFastHisto1D::Fun4AllFastHisto1D(const std::string &name, const std::string &title,
+                                       const int nbinsx, const double xmin, const double xmax,
+                                       const unsigned int nshards)
+  : Fun4AllFastHisto(name, title, std::max(nbinsx, 1) + 2, nshards)
+  , m_x(nbinsx, xmin, xmax)
+{
+}
+
+TH1 *Fun4AllFastHisto1D::toTH1() const
+{
+  TH1 *h = new TH1D(GetName().c_str(), GetTitle().c_str(), m_x.n, m_x.xmin, m_x.xmax);
+  h->SetDirectory(nullptr);
+  copyTo(h);
+  return h;
+}
+
+Fun4AllFastHisto2D::Fun4AllFastHisto2D(const std::string &name, const std::string &title,
+                                       const int nbinsx, const double xmin, const double xmax,
+                                       const int nbinsy, const double ymin, const double ymax,
+                                       const unsigned int nshards)
+  : Fun4AllFastHisto(name, title, (std::max(nbinsx, 1) + 2) * (std::max(nbinsy, 1) + 2), nshards)
+  , m_x(nbinsx, xmin, xmax)
+  , m_y(nbinsy, ymin, ymax)
+{
+}
+
+TH1 *Fun4AllFastHisto2D::toTH1() const
+{
+  TH1 *h = new TH2D(GetName().c_str(), GetTitle().c_str(), m_x.n, m_x.xmin, m_x.xmax, m_y.n, m_y.xmin, m_y.xmax);
+  h->SetDirectory(nullptr);
+  copyTo(h);
+  return h;
+}
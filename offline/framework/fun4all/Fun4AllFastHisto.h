@@ -0,0 +1,152 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALL_FUN4ALLFASTHISTO_H
+#define FUN4ALL_FUN4ALLFASTHISTO_H
+
+#include <string>
+#include <vector>
+
+class TH1;
+
+//! fixed binning histogram with one independent copy (shard) per worker
+/*!
+  Filling computes the bin with one multiplication and a truncation, there is
+  no axis lookup and no ROOT global state is touched. Every shard has its own
+  buffers, so tasks running concurrently can fill the same histogram without
+  locks as long as each uses its own shard index (e.g. the task index of a
+  PHThreadPool::parallel_for with one task per shard).
+
+  The shards are summed when the histogram is converted to a TH1D/TH2D, which
+  Fun4AllHistoManager does when writing its output file. Bin numbering follows
+  ROOT: 0 is the underflow, n + 1 the overflow bin of each axis.
+*/
+class Fun4AllFastHisto
+{
+ public:
+  virtual ~Fun4AllFastHisto() = default;
+
+  const std::string &GetName() const { return m_name; }
+  void SetName(const std::string &name) { m_name = name; }
+  const std::string &GetTitle() const { return m_title; }
+
+  //! number of shards, changing it keeps the content of the remaining shards
+  unsigned int nShards() const { return m_shards.size(); }
+  void setNumShards(const unsigned int nshards);
+
+  //! clear all shards
+  void Reset();
+
+  //! number of fills summed over all shards
+  double GetEntries() const;
+
+  //! sum of all shards for global bin (ROOT numbering)
+  double GetBinContent(const int bin) const;
+  double GetBinError(const int bin) const;
+
+  //! new TH1D or TH2D holding the sum of all shards, owned by the caller
+  virtual TH1 *toTH1() const = 0;
+
+ protected:
+  //! fixed binning along one axis
+  struct Axis
+  {
+    Axis(const int nbins, const double min, const double max)
+      : n(nbins > 0 ? nbins : 1)
+      , xmin(min)
+      , xmax(max)
+      , scale(n / (max - min))
+    {
+    }
+
+    //! bin of x, NaN goes to the underflow
+    int bin(const double x) const
+    {
+      if (!(x >= xmin))
+      {
+        return 0;
+      }
+      if (x >= xmax)
+      {
+        return n + 1;
+      }
+      const int b = static_cast<int>((x - xmin) * scale) + 1;
+      return b > n ? n : b;
+    }
+
+    int n;
+    double xmin;
+    double xmax;
+    double scale;
+  };
+
+  //! sums of weights of one worker, aligned so shards never share a cache line
+  struct alignas(64) Shard
+  {
+    std::vector<double> sumw;
+    std::vector<double> sumw2;
+    double entries = 0;
+  };
+
+  Fun4AllFastHisto(const std::string &name, const std::string &title, const unsigned int nbins, const unsigned int nshards);
+
+  void fill(const unsigned int shard, const int bin, const double w)
+  {
+    Shard &s = m_shards[shard];
+    s.sumw[bin] += w;
+    s.sumw2[bin] += w * w;
+    ++s.entries;
+  }
+
+  //! copy the summed shards into h, which must have the same binning
+  void copyTo(TH1 *h) const;
+
+ private:
+  std::string m_name;
+  std::string m_title;
+  unsigned int m_nbins = 0;
+  std::vector<Shard> m_shards;
+};
+
+//! one dimensional Fun4AllFastHisto, written as TH1D
+class Fun4AllFastHisto1D : public Fun4AllFastHisto
+{
+ public:
+  Fun4AllFastHisto1D(const std::string &name, const std::string &title,
+                     const int nbinsx, const double xmin, const double xmax,
+                     const unsigned int nshards = 1);
+
+  //! fill shard, must be below nShards()
+  void Fill(const unsigned int shard, const double x, const double w = 1.)
+  {
+    fill(shard, m_x.bin(x), w);
+  }
+
+  TH1 *toTH1() const override;
+
+ private:
+  Axis m_x;
+};
+
+//! two dimensional Fun4AllFastHisto, written as TH2D
+class Fun4AllFastHisto2D : public Fun4AllFastHisto
+{
+ public:
+  Fun4AllFastHisto2D(const std::string &name, const std::string &title,
+                     const int nbinsx, const double xmin, const double xmax,
+                     const int nbinsy, const double ymin, const double ymax,
+                     const unsigned int nshards = 1);
+
+  //! fill shard, must be below nShards()
+  void Fill(const unsigned int shard, const double x, const double y, const double w = 1.)
+  {
+    fill(shard, m_x.bin(x) + (m_x.n + 2) * m_y.bin(y), w);
+  }
+
+  TH1 *toTH1() const override;
+
+ private:
+  Axis m_x;
+  Axis m_y;
+};
+
+#endif
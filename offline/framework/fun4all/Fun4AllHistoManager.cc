@@ -1,5 +1,6 @@
 #include "Fun4AllHistoManager.h"
 
+#include "Fun4AllFastHisto.h"
 #include "TDirectoryHelper.h"
 
 #include <phool/phool.h>
@@ -8,6 +9,7 @@
 #include <TFile.h>
 #include <TH1.h>
 #include <TNamed.h>
+#include <TROOT.h>
 #include <TTree.h>
 
 #include <RVersion.h>
@@ -16,10 +18,15 @@
 #include <THnSparse.h>
 #endif
 
+#include <chrono>
+#include <filesystem>
 #include <iomanip>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <system_error>
 #include <utility>  // for pair
+#include <vector>
 
 Fun4AllHistoManager::Fun4AllHistoManager(const std::string &name)
   : Fun4AllBase(name)
@@ -29,47 +36,77 @@ Fun4AllHistoManager::Fun4AllHistoManager(const std::string &name)
 
 Fun4AllHistoManager::~Fun4AllHistoManager()
 {
+  WaitForSnapshot();
   while (Histo.begin() != Histo.end())
   {
     delete Histo.begin()->second;
     Histo.erase(Histo.begin());
   }
+  while (FastHisto.begin() != FastHisto.end())
+  {
+    delete FastHisto.begin()->second;
+    FastHisto.erase(FastHisto.begin());
+  }
   return;
 }
 
+std::string Fun4AllHistoManager::OutFileName() const
+{
+  if (!outfilename.empty())
+  {
+    return outfilename;
+  }
+  recoConsts *rc = recoConsts::instance();
+  std::ostringstream filnam;
+  int runnumber = -1;
+  if (rc->FlagExist("RUNNUMBER"))
+  {
+    runnumber = rc->get_IntFlag("RUNNUMBER");
+  }
+  // this will set the filename to the name of the manager
+  // add the runnumber in the std 10 digit format and
+  // end it with a .root extension
+  filnam << Name() << "-"
+         << std::setfill('0') << std::setw(10)
+         << runnumber << ".root";
+  return filnam.str();
+}
+
+std::string Fun4AllHistoManager::SnapshotFileName() const
+{
+  if (!m_SnapshotFileName.empty())
+  {
+    return m_SnapshotFileName;
+  }
+  // HistoManager-0000000001.root -> HistoManager-0000000001_snapshot.root
+  std::string filename = OutFileName();
+  const std::string extension = ".root";
+  if (filename.size() > extension.size() && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0)
+  {
+    filename.insert(filename.size() - extension.size(), "_snapshot");
+    return filename;
+  }
+  return filename + "_snapshot";
+}
+
 int Fun4AllHistoManager::dumpHistos(const std::string &filename, const std::string &openmode)
 {
   int iret = 0;
+  WaitForSnapshot();
+  const std::string snapshotfile = SnapshotFileName();
   if (!filename.empty())
   {
     outfilename = filename;
   }
   else
   {
-    if (outfilename.empty())
-    {
-      recoConsts *rc = recoConsts::instance();
-      std::ostringstream filnam;
-      int runnumber = -1;
-      if (rc->FlagExist("RUNNUMBER"))
-      {
-        runnumber = rc->get_IntFlag("RUNNUMBER");
-      }
-      // this will set the filename to the name of the manager
-      // add the runnumber in the std 10 digit format and
-      // end it with a .root extension
-      filnam << Name() << "-"
-             << std::setfill('0') << std::setw(10)
-             << runnumber << ".root";
-      outfilename = filnam.str();
-    }
+    outfilename = OutFileName();
   }
   std::cout << "Fun4AllHistoManager::dumpHistos() Writing root file: " << outfilename << std::endl;
 
-  const int compress = 9;
   std::ostringstream creator;
   creator << "Created by " << Name();
-  TFile hfile(outfilename.c_str(), openmode.c_str(), creator.str().c_str(), compress);
+  TFile hfile(outfilename.c_str(), openmode.c_str(), creator.str().c_str(), m_CompressionSetting);
   if (!hfile.IsOpen())
   {
     std::cout << PHWHERE << " Could not open output file" << outfilename << std::endl;
@@ -79,64 +116,182 @@ int Fun4AllHistoManager::dumpHistos(const std::string &filename, const std::stri
   std::map<const std::string, TNamed *>::const_iterator hiter;
   for (hiter = Histo.begin(); hiter != Histo.end(); ++hiter)
   {
-    const std::string &hname = hiter->first;
-    const TNamed *hptr = hiter->second;
-    if (Verbosity() > 0)
+    int ret = writeHisto(hfile, hiter->first, hiter->second);
+    if (ret)
     {
-      std::cout << PHWHERE << " Saving histo "
-                << hname
-                << std::endl;
+      iret = ret;
     }
-
-    //  Decode the string to see if it wants a directory
-    std::string::size_type pos = hname.find_last_of('/');
-    std::string dirname;
-    if (pos != std::string::npos)  // string::npos is the result if search unsuccessful
+  }
+  // fast histograms are converted to ROOT histograms only for writing
+  for (const auto &fastiter : FastHisto)
+  {
+    std::unique_ptr<TH1> h(fastiter.second->toTH1());
+    int ret = writeHisto(hfile, fastiter.first, h.get());
+    if (ret)
     {
-      dirname = hname.substr(0, pos);
+      iret = ret;
     }
-    else
+  }
+  hfile.Close();
+  // the snapshot is superseded by the final file
+  if (m_SnapshotEvents > 0 && !iret && snapshotfile != outfilename)
+  {
+    std::error_code ec;
+    std::filesystem::remove(snapshotfile, ec);
+  }
+  return iret;
+}
+
+void Fun4AllHistoManager::SetSnapshot(const unsigned int nevents, const std::string &filename)
+{
+  m_SnapshotEvents = nevents;
+  m_SnapshotFileName = filename;
+}
+
+int Fun4AllHistoManager::Snapshot()
+{
+  if (m_Snapshot.valid() && m_Snapshot.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+  {
+    if (Verbosity() > 0)
     {
-      dirname = "";
+      std::cout << Name() << ": previous snapshot still being written, skipping this one" << std::endl;
     }
+    return 0;
+  }
+  if (WaitForSnapshot())
+  {
+    std::cout << PHWHERE << Name() << ": previous snapshot failed" << std::endl;
+  }
+  // writing on another thread needs ROOT's global locks and per thread gDirectory
+  ROOT::EnableThreadSafety();
 
-    if (Verbosity())
+  // copying is fast compared to compressing and writing, the histograms are
+  // filled again as soon as the copies are made
+  std::vector<std::pair<std::string, std::unique_ptr<TNamed>>> copies;
+  copies.reserve(Histo.size() + FastHisto.size());
+  for (const auto &[hname, h] : Histo)
+  {
+    if (h->InheritsFrom("TTree"))
     {
-      std::cout << " Histogram named " << hptr->GetName();
-      std::cout << " key " << hname;
-      if (dirname.size())
-      {
-        std::cout << " being saved to directory " << dirname;
-      }
-      std::cout << std::endl;
+      continue;
     }
-
-    if (dirname.size())
+    TNamed *copy = static_cast<TNamed *>(h->Clone());
+    if (copy->InheritsFrom("TH1"))
     {
-      TDirectoryHelper::mkdir(&hfile, dirname.c_str());
-      hfile.cd(dirname.c_str());
+      static_cast<TH1 *>(copy)->SetDirectory(nullptr);
     }
+    copies.emplace_back(hname, copy);
+  }
+  for (const auto &[hname, h] : FastHisto)
+  {
+    copies.emplace_back(hname, h->toTH1());
+  }
+
+  const std::string filename = SnapshotFileName();
+  const int compress = m_CompressionSetting;
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": writing snapshot of " << copies.size() << " histograms to " << filename << std::endl;
+  }
+  m_Snapshot = std::async(std::launch::async, [this, filename, compress, copies = std::move(copies)]()
+                          {
+                            const std::string tmpname = filename + ".tmp";
+                            int iret = 0;
+                            {
+                              std::string creator = "Snapshot by " + Name();
+                              TFile hfile(tmpname.c_str(), "RECREATE", creator.c_str(), compress);
+                              if (!hfile.IsOpen())
+                              {
+                                std::cout << PHWHERE << " Could not open snapshot file " << tmpname << std::endl;
+                                return -1;
+                              }
+                              for (const auto &[hname, h] : copies)
+                              {
+                                int ret = writeHisto(hfile, hname, h.get());
+                                if (ret)
+                                {
+                                  iret = ret;
+                                }
+                              }
+                              hfile.Close();
+                            }
+                            std::error_code ec;
+                            std::filesystem::rename(tmpname, filename, ec);
+                            if (ec)
+                            {
+                              std::cout << PHWHERE << " Could not rename " << tmpname << " to " << filename
+                                        << ": " << ec.message() << std::endl;
+                              return -1;
+                            }
+                            return iret; });
+  return 0;
+}
+
+int Fun4AllHistoManager::WaitForSnapshot()
+{
+  if (!m_Snapshot.valid())
+  {
+    return 0;
+  }
+  return m_Snapshot.get();
+}
+
+int Fun4AllHistoManager::writeHisto(TFile &hfile, const std::string &hname, const TNamed *hptr) const
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << PHWHERE << " Saving histo "
+              << hname
+              << std::endl;
+  }
+
+  //  Decode the string to see if it wants a directory
+  std::string::size_type pos = hname.find_last_of('/');
+  std::string dirname;
+  if (pos != std::string::npos)  // string::npos is the result if search unsuccessful
+  {
+    dirname = hname.substr(0, pos);
+  }
+  else
+  {
+    dirname = "";
+  }
 
-    if (hptr)
+  if (Verbosity())
+  {
+    std::cout << " Histogram named " << hptr->GetName();
+    std::cout << " key " << hname;
+    if (dirname.size())
     {
-      int byteswritten = hptr->Write();
-      if (!byteswritten)
-      {
-        std::cout << PHWHERE << "Error saving histogram "
-                  << hptr->GetName()
-                  << std::endl;
-        iret = -2;
-      }
+      std::cout << " being saved to directory " << dirname;
     }
-    else
+    std::cout << std::endl;
+  }
+
+  if (dirname.size())
+  {
+    TDirectoryHelper::mkdir(&hfile, dirname.c_str());
+    hfile.cd(dirname.c_str());
+  }
+
+  if (hptr)
+  {
+    int byteswritten = hptr->Write();
+    if (!byteswritten)
     {
-      std::cout << PHWHERE << "dumpHistos : histogram "
-                << hname << " is a null pointer! Won't be saved."
+      std::cout << PHWHERE << "Error saving histogram "
+                << hptr->GetName()
                 << std::endl;
+      return -2;
     }
   }
-  hfile.Close();
-  return iret;
+  else
+  {
+    std::cout << PHWHERE << "dumpHistos : histogram "
+              << hname << " is a null pointer! Won't be saved."
+              << std::endl;
+  }
+  return 0;
 }
 
 bool Fun4AllHistoManager::registerHisto(TNamed *h1d, const int replace)
@@ -188,6 +343,58 @@ bool Fun4AllHistoManager::registerHisto(const std::string &hname, TNamed *h1d, c
   return true;
 }
 
+bool Fun4AllHistoManager::registerFastHisto(Fun4AllFastHisto *h, const int replace)
+{
+  return registerFastHisto(h->GetName(), h, replace);
+}
+
+bool Fun4AllHistoManager::registerFastHisto(const std::string &hname, Fun4AllFastHisto *h, const int replace)
+{
+  std::map<const std::string, Fun4AllFastHisto *>::iterator histoiter = FastHisto.find(hname);
+  if ((histoiter != FastHisto.end() || Histo.find(hname) != Histo.end()) && replace == 0)
+  {
+    std::cout << "Histogram " << hname << " already registered, I won't overwrite it" << std::endl;
+    std::cout << "Use a different name and try again" << std::endl;
+    return false;
+  }
+  if (histoiter != FastHisto.end() && histoiter->second != h)
+  {
+    delete histoiter->second;
+  }
+
+  std::string::size_type pos = hname.find_last_of('/');
+  std::string histoname = hname;
+  if (pos != std::string::npos)
+  {
+    histoname = hname.substr(pos + 1);
+  }
+  if (Verbosity() > 1)
+  {
+    if (histoname != h->GetName())
+    {
+      std::cout << PHWHERE << "Fast histogram " << h->GetName()
+                << " at " << h << " renamed to " << histoname << std::endl;
+    }
+  }
+  h->SetName(histoname);
+  FastHisto[hname] = h;
+  return true;
+}
+
+Fun4AllFastHisto *
+Fun4AllHistoManager::getFastHisto(const std::string &hname) const
+{
+  std::map<const std::string, Fun4AllFastHisto *>::const_iterator histoiter = FastHisto.find(hname);
+  if (histoiter != FastHisto.end())
+  {
+    return histoiter->second;
+  }
+  std::cout << "Fun4AllHistoManager::getFastHisto: ERROR Unknown Histogram " << hname
+            << ", The following are implemented: " << std::endl;
+  Print("ALL");
+  return nullptr;
+}
+
 int Fun4AllHistoManager::isHistoRegistered(const std::string &name) const
 {
   std::map<const std::string, TNamed *>::const_iterator histoiter = Histo.find(name);
@@ -195,6 +402,10 @@ int Fun4AllHistoManager::isHistoRegistered(const std::string &name) const
   {
     return 1;
   }
+  if (FastHisto.find(name) != FastHisto.end())
+  {
+    return 1;
+  }
   return 0;
 }
 
@@ -277,6 +488,11 @@ void Fun4AllHistoManager::Print(const std::string &what) const
     {
       std::cout << hiter->first << " is " << hiter->second << std::endl;
     }
+    for (const auto &fastiter : FastHisto)
+    {
+      std::cout << fastiter.first << " is " << fastiter.second
+                << " (fast, " << fastiter.second->nShards() << " shards)" << std::endl;
+    }
     std::cout << std::endl;
   }
   return;
@@ -297,5 +513,9 @@ void Fun4AllHistoManager::Reset()
       (dynamic_cast<THnSparse *>(h))->Reset();
     }
   }
+  for (const auto &fastiter : FastHisto)
+  {
+    fastiter.second->Reset();
+  }
   return;
 }
@@ -5,9 +5,12 @@
 
 #include "Fun4AllBase.h"
 
+#include <future>
 #include <map>
 #include <string>
 
+class Fun4AllFastHisto;
+class TFile;
 class TNamed;
 
 class Fun4AllHistoManager : public Fun4AllBase
@@ -36,6 +39,24 @@ class Fun4AllHistoManager : public Fun4AllBase
     }
     return t;
   }
+  //! Register a fast fixed binning histogram, the manager takes ownership.
+  //! Its shards are summed and written as TH1D/TH2D by dumpHistos
+  bool registerFastHisto(const std::string &hname, Fun4AllFastHisto *h, const int replace = 0);
+  bool registerFastHisto(Fun4AllFastHisto *h, const int replace = 0);
+
+  template <typename T>
+  T *makeFastHisto(T *t)
+  {
+    if (not registerFastHisto(t))
+    {
+      delete t;
+      t = nullptr;
+    }
+    return t;
+  }
+  Fun4AllFastHisto *getFastHisto(const std::string &hname) const;
+  unsigned int nFastHistos() const { return FastHisto.size(); }
+
   int isHistoRegistered(const std::string &name) const;
   TNamed *getHisto(const std::string &hname) const;
   TNamed *getHisto(const unsigned int ihisto) const;
@@ -44,10 +65,39 @@ class Fun4AllHistoManager : public Fun4AllBase
   void Reset();
   int dumpHistos(const std::string &filename = "", const std::string &openmode = "RECREATE");
   void setOutfileName(const std::string &filename) { outfilename = filename; }
+  //! compression setting of the output file, e.g. 505 for ZSTD level 5 (default 9: zlib level 9)
+  void SetCompressionSetting(const int setting) { m_CompressionSetting = setting; }
+  int GetCompressionSetting() const { return m_CompressionSetting; }
+
+  //! write a snapshot of the histograms every nevents events (0 = never) while the job runs
+  /*! the default file name is the one of dumpHistos with _snapshot added,
+      it is removed when dumpHistos wrote the final file */
+  void SetSnapshot(const unsigned int nevents, const std::string &filename = "");
+  unsigned int SnapshotEvents() const { return m_SnapshotEvents; }
+  //! copy the histograms and write the copies on a background thread
+  /*! the file is written under a temporary name and renamed when it is complete,
+      so the snapshot file is always readable. Skipped when the previous snapshot
+      is still being written. TTrees are not part of the snapshot */
+  int Snapshot();
 
  private:
+  //! write object to the directory encoded in hname
+  int writeHisto(TFile &hfile, const std::string &hname, const TNamed *hptr) const;
+
+  //! output file name, made from the manager name and the run number if not set
+  std::string OutFileName() const;
+  std::string SnapshotFileName() const;
+
+  //! wait for the snapshot which is being written, returns its return code
+  int WaitForSnapshot();
+
   std::string outfilename;
+  std::string m_SnapshotFileName;
+  int m_CompressionSetting{9};
+  unsigned int m_SnapshotEvents{0};
+  std::future<int> m_Snapshot;
   std::map<const std::string, TNamed *> Histo;
+  std::map<const std::string, Fun4AllFastHisto *> FastHisto;
 };
 
 #endif /* __FUN4ALLHISTOMANAGER_H */
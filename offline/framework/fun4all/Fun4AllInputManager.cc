@@ -3,6 +3,8 @@
 #include "Fun4AllServer.h"
 #include "SubsysReco.h"
 
+#include <frog/FROG.h>
+
 #include <phool/phool.h>
 
 #include <boost/filesystem.hpp>
@@ -10,6 +12,8 @@
 #include <cstdint>  // for uintmax_t
 #include <fstream>
 #include <iostream>
+#include <iterator>  // for next
+#include <vector>
 
 Fun4AllInputManager::Fun4AllInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
   : Fun4AllBase(name)
@@ -226,8 +230,29 @@ int Fun4AllInputManager::OpenNextFile()
     }
     else
     {
+      if (m_PrefetchNextFile && std::next(iter) != m_FileList.end())
+      {
+        FROG frog;
+        frog.prefetch(*std::next(iter));
+      }
       return 0;
     }
   }
   return -1;
 }
+
+std::string Fun4AllInputManager::NextFileName() const
+{
+  if (m_FileList.size() < 2)
+  {
+    return "";
+  }
+  return *std::next(m_FileList.begin());
+}
+
+int Fun4AllInputManager::ResolveFileLocations()
+{
+  FROG frog;
+  frog.Verbosity(Verbosity());
+  return frog.locate(std::vector<std::string>(m_FileList.begin(), m_FileList.end()));
+}
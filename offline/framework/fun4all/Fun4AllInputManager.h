@@ -56,9 +56,22 @@ class Fun4AllInputManager : public Fun4AllBase
   virtual int IsOpen() const { return m_IsOpen; }
   virtual int SkipForThisManager(const int /*nevents*/) { return 0; }
   virtual int HasSyncObject() const { return 0; }
+  //! true if the next run(1) only reads from the open file and does not change the node tree,
+  //! the sync manager can then read it at the same time as its other input managers
+  virtual bool ConcurrentReadOk() const { return false; }
   virtual std::string GetString(const std::string &) const { return ""; }
   const std::list<std::string> GetFileList() const { return m_FileListCopy; }
   const std::list<std::string> GetFileOpenedList() const { return m_FileListOpened; }
+  //! resolve the locations of all files in the list at once (one file catalog query)
+  int ResolveFileLocations();
+  //! look up the location of the next file in the background while the current one is read
+  void PrefetchNextFileLocation(const bool b = true) { m_PrefetchNextFile = b; }
+  //! open and set up the next file of the list on a background thread while the current one is read
+  //! (supported by the DST and PRDF input managers)
+  void OpenNextFileInBackground(const bool b) { m_OpenNextFileInBackground = b; }
+  bool OpenNextFileInBackground() const { return m_OpenNextFileInBackground; }
+  //! the file which is opened after the current one, empty if there is none
+  std::string NextFileName() const;
 
  protected:
   Fun4AllInputManager(const std::string &name = "DUMMY", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
@@ -66,6 +79,7 @@ class Fun4AllInputManager : public Fun4AllBase
   int OpenNextFile();
   void IsOpen(const int i) { m_IsOpen = i; }
   Fun4AllSyncManager *MySyncManager() { return m_MySyncManager; }
+  bool HasSubsystems() const { return !m_SubsystemsVector.empty(); }
 
  private:
   Fun4AllSyncManager *m_MySyncManager = nullptr;
@@ -73,6 +87,8 @@ class Fun4AllInputManager : public Fun4AllBase
   int m_Repeat = 0;
   int m_MyRunNumber = 0;
   int m_InitRun = 0;
+  bool m_PrefetchNextFile = false;
+  bool m_OpenNextFileInBackground = false;
   std::vector<SubsysReco *> m_SubsystemsVector;
   std::string m_InputNode;
   std::string m_FileName;
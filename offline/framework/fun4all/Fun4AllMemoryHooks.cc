@@ -0,0 +1,153 @@
+// replacements of the global operator new and delete which count the
+// allocations in Fun4AllAllocationCounter. This file is the only source
+// of libfun4allmemhooks, never link it into a regular library
+
+#include "Fun4AllAllocationCounter.h"
+
+#include <malloc.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  // the usable size is counted for allocations and frees, so the two balance
+  void *allocate(const size_t size)
+  {
+    void *ptr = std::malloc(size ? size : 1);
+    if (ptr)
+    {
+      Fun4AllAllocationCounter::Allocated(malloc_usable_size(ptr));
+    }
+    return ptr;
+  }
+
+  void *allocate_aligned(const size_t size, const std::align_val_t alignment)
+  {
+    void *ptr = nullptr;
+    const size_t align = std::max(static_cast<size_t>(alignment), sizeof(void *));
+    if (posix_memalign(&ptr, align, size ? size : 1) != 0)
+    {
+      return nullptr;
+    }
+    Fun4AllAllocationCounter::Allocated(malloc_usable_size(ptr));
+    return ptr;
+  }
+
+  void deallocate(void *ptr) noexcept
+  {
+    if (ptr)
+    {
+      Fun4AllAllocationCounter::Freed(malloc_usable_size(ptr));
+      std::free(ptr);
+    }
+  }
+
+  class Activate
+  {
+   public:
+    Activate() { Fun4AllAllocationCounter::SetActive(); }
+  };
+  const Activate activate;
+}  // namespace
+
+void *operator new(size_t size)
+{
+  void *ptr = allocate(size);
+  if (!ptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t & /*unused*/) noexcept
+{
+  return allocate(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t & /*unused*/) noexcept
+{
+  return allocate(size);
+}
+
+void *operator new(size_t size, std::align_val_t alignment)
+{
+  void *ptr = allocate_aligned(size, alignment);
+  if (!ptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+  return operator new(size, alignment);
+}
+
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t & /*unused*/) noexcept
+{
+  return allocate_aligned(size, alignment);
+}
+
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t & /*unused*/) noexcept
+{
+  return allocate_aligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t /*size*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t /*size*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t /*alignment*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, std::align_val_t /*alignment*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, size_t /*size*/, std::align_val_t /*alignment*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t & /*unused*/) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t & /*unused*/) noexcept
+{
+  deallocate(ptr);
+}
@@ -111,6 +111,9 @@ class Fun4AllOutputManager : public Fun4AllBase
   unsigned int GetNEvents() const { return m_MaxEvents; }
   void FileRule(const std::string &newrule) { m_FileRule = newrule; }
   const std::string FileRule() const { return m_FileRule; }
+  //! file segment written next with the file rule, kept in checkpoints
+  virtual int CurrentSegment() const { return 0; }
+  virtual void CurrentSegment(const int /*segment*/) { return; }
   void SplitLevel(const int split) { splitlevel = split; }
   void BufferSize(const int size) { buffersize = size; }
   int SplitLevel() const { return splitlevel; }
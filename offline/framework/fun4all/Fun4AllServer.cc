@@ -1,5 +1,6 @@
 #include "Fun4AllServer.h"
 
+#include "Fun4AllAllocationCounter.h"
 #include "Fun4AllHistoBinDefs.h"
 #include "Fun4AllHistoManager.h"  // for Fun4AllHistoManager
 #include "Fun4AllMemoryTracker.h"
@@ -9,35 +10,106 @@
 #include "Fun4AllSyncManager.h"
 #include "SubsysReco.h"
 
+#include <ffaobjects/PerformanceSummary.h>
+#include <ffaobjects/PerformanceSummaryv1.h>
+
 #include <phool/PHCompositeNode.h>
+#include <phool/PHCounter.h>
+#include <phool/PHIODataNode.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHNodeReset.h>
+#include <phool/PHNodeSize.h>
+#include <phool/PHNodeTrim.h>
 #include <phool/PHObject.h>
+#include <phool/PHProfiler.h>
 #include <phool/PHPointerListIterator.h>
+#include <phool/PHRandomSeed.h>
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimeStamp.h>
 #include <phool/PHTimer.h>  // for PHTimer
+#include <phool/PHTrace.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 #include <phool/recoConsts.h>
 
 #include <Rtypes.h>  // for kMAXSIGNALS
 #include <TDirectory.h>
+#include <TFile.h>
 #include <TH1.h>
+#include <THnSparse.h>
+#include <TObjString.h>
 #include <TROOT.h>
 #include <TSysEvtHandler.h>  // for ESignals
 
 #include <TSystem.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdlib>
+#include <ctime>
 #include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
+#include <set>
 #include <sstream>
+#include <thread>
+
+#include <sys/resource.h>
 
 //#define FFAMEMTRACKER
 
+namespace
+{
+  // module times for the PerformanceSummary percentiles, 20 log bins
+  // per decade from 1 us to 1000 s (10% resolution)
+  const int TIMEBINS_PER_DECADE = 20;
+  const double TIMEHIST_MIN_LOG = -3;
+  const unsigned int TIMEHIST_NBINS = 9 * TIMEBINS_PER_DECADE;
+
+  unsigned int time_bin(const double ms)
+  {
+    if (ms <= 0)
+    {
+      return 0;
+    }
+    const double bin = (std::log10(ms) - TIMEHIST_MIN_LOG) * TIMEBINS_PER_DECADE;
+    if (bin < 0)
+    {
+      return 0;
+    }
+    return std::min(static_cast<unsigned int>(bin), TIMEHIST_NBINS - 1);
+  }
+
+  //! center (in log) of the bin holding the fraction q of the entries
+  double time_quantile(const std::vector<unsigned int> &histo, const double q)
+  {
+    unsigned long ntotal = 0;
+    for (auto n : histo)
+    {
+      ntotal += n;
+    }
+    if (ntotal == 0)
+    {
+      return 0;
+    }
+    const double target = q * ntotal;
+    unsigned long nsum = 0;
+    for (unsigned int i = 0; i < histo.size(); ++i)
+    {
+      nsum += histo[i];
+      if (nsum >= target)
+      {
+        return std::pow(10., TIMEHIST_MIN_LOG + (i + 0.5) / TIMEBINS_PER_DECADE);
+      }
+    }
+    return std::pow(10., TIMEHIST_MIN_LOG + (histo.size() - 0.5) / TIMEBINS_PER_DECADE);
+  }
+}  // namespace
+
 Fun4AllServer *Fun4AllServer::__instance = nullptr;
 
 Fun4AllServer *Fun4AllServer::instance()
@@ -56,6 +128,8 @@ Fun4AllServer::Fun4AllServer(const std::string &name)
   , ffamemtracker(Fun4AllMemoryTracker::instance())
 #endif
 {
+  m_StartupTimer.restart();
+  m_EventTimeHisto.assign(TIMEHIST_NBINS, 0);
   InitAll();
   return;
 }
@@ -111,6 +185,8 @@ Fun4AllServer::~Fun4AllServer()
     delete TDirCollection.back();
     TDirCollection.pop_back();
   }
+  // the modules are gone, nobody uses the threads anymore
+  delete m_ThreadPool;
   recoConsts *rc = recoConsts::instance();
   delete rc;
   delete ffamemtracker;
@@ -168,6 +244,16 @@ bool Fun4AllServer::registerHisto(const std::string &hname, TNamed *h1d, const i
   return ServerHistoManager->registerHisto(hname, h1d, replace);
 }
 
+bool Fun4AllServer::registerFastHisto(Fun4AllFastHisto *h, const int replace)
+{
+  return ServerHistoManager->registerFastHisto(h, replace);
+}
+
+bool Fun4AllServer::registerFastHisto(const std::string &hname, Fun4AllFastHisto *h, const int replace)
+{
+  return ServerHistoManager->registerFastHisto(hname, h, replace);
+}
+
 int Fun4AllServer::isHistoRegistered(const std::string &name) const
 {
   int iret = ServerHistoManager->isHistoRegistered(name);
@@ -225,7 +311,11 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
     {
       std::cout << "Calling Init() for Subsystem " << subsystem->Name() << std::endl;
     }
+    PHTimer inittimer;
+    inittimer.restart();
     iret = subsystem->Init(subsystopNode);
+    inittimer.stop();
+    m_StartupTimes.emplace_back("Init " + subsystem->Name(), inittimer.elapsed());
 #ifdef FFAMEMTRACKER
     ffamemtracker->Stop(memory_tracker_name, "SubsysReco");
 #endif
@@ -266,11 +356,116 @@ int Fun4AllServer::registerSubsystem(SubsysReco *subsystem, const std::string &t
   std::string timer_name;
   timer_name = subsystem->Name() + "_" + topnodename;
   PHTimer timer(timer_name);
-  if (timer_map.find(timer_name) == timer_map.end())
+  std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
+  if (titer == timer_map.end())
+  {
+    titer = timer_map.insert(make_pair(timer_name, timer)).first;
+  }
+  // cache the timer and the TDirectory name so process_event does not
+  // have to assemble strings and search the timer map for every module
+  // in every event (map iterators stay valid on insert)
+  SubsystemTimers.push_back(&titer->second);
+  SubsystemTDirNames.push_back(topnodename + "/" + subsystem->Name());
+  ModuleProfile profile;
+  profile.Name = timer_name;
+  SubsystemProfiles.push_back(profile);
+  SubsystemTimeHistos.emplace_back(TIMEHIST_NBINS, 0);
+  const auto reqiter = m_RequiredEventClasses.find(subsystem->Name());
+  SubsystemEventClasses.push_back(reqiter == m_RequiredEventClasses.end() ? 0 : reqiter->second);
+  SubsystemSkipCounts.push_back(0);
+  RetCodes.push_back(iret);  // vector with return codes
+  return 0;
+}
+
+int Fun4AllServer::registerFilter(SubsysReco *filter, const std::string &topnodename)
+{
+  const size_t nsubsys = Subsystems.size();
+  int iret = registerSubsystem(filter, topnodename);
+  if (iret || Subsystems.size() == nsubsys)
   {
-    timer_map.insert(make_pair(timer_name, timer));
+    // failed or the filter did not want to be registered
+    return iret;
+  }
+  // move the new module from the end behind the filters registered so far
+  auto tofront = [this](auto &vec)
+  { std::rotate(vec.begin() + m_NFilters, vec.end() - 1, vec.end()); };
+  tofront(Subsystems);
+  tofront(RetCodes);
+  tofront(SubsystemTimers);
+  tofront(SubsystemTDirNames);
+  tofront(SubsystemProfiles);
+  tofront(SubsystemTimeHistos);
+  tofront(SubsystemEventClasses);
+  tofront(SubsystemSkipCounts);
+  m_NFilters++;
+  m_FilterStats.resize(m_NFilters);
+  // the event selectors refer to the modules by index
+  for (auto *outman : OutputManager)
+  {
+    UpdateEventSelector(outman);
+  }
+  if (Verbosity() >= VERBOSITY_SOME)
+  {
+    std::cout << "Registered " << filter->Name() << " as filter " << m_NFilters << std::endl;
+  }
+  return 0;
+}
+
+int Fun4AllServer::EventClassBit(const std::string &eventclass)
+{
+  auto iter = m_EventClassBits.find(eventclass);
+  if (iter != m_EventClassBits.end())
+  {
+    return iter->second;
+  }
+  if (m_EventClassBits.size() >= 64)
+  {
+    std::cout << PHWHERE << " too many event classes, cannot add " << eventclass << std::endl;
+    return -1;
+  }
+  const int bit = m_EventClassBits.size();
+  m_EventClassBits[eventclass] = bit;
+  m_EventClassCounts.push_back(0);
+  return bit;
+}
+
+void Fun4AllServer::SetEventClass(const std::string &eventclass)
+{
+  const int bit = EventClassBit(eventclass);
+  if (bit < 0)
+  {
+    return;
+  }
+  const uint64_t mask = uint64_t{1} << bit;
+  if (!(m_EventClasses & mask))
+  {
+    m_EventClasses |= mask;
+    m_EventClassCounts[bit]++;
+  }
+}
+
+bool Fun4AllServer::HasEventClass(const std::string &eventclass) const
+{
+  const auto iter = m_EventClassBits.find(eventclass);
+  return iter != m_EventClassBits.end() && (m_EventClasses & (uint64_t{1} << iter->second));
+}
+
+int Fun4AllServer::RequireEventClass(const std::string &modulename, const std::string &eventclass)
+{
+  const int bit = EventClassBit(eventclass);
+  if (bit < 0)
+  {
+    return -1;
+  }
+  const uint64_t mask = uint64_t{1} << bit;
+  m_RequiredEventClasses[modulename] |= mask;
+  for (size_t i = 0; i < Subsystems.size(); ++i)
+  {
+    if (Subsystems[i].first->Name() == modulename)
+    {
+      SubsystemEventClasses[i] |= mask;
+    }
   }
-  RetCodes.push_back(iret);  // vector with return codes
   return 0;
 }
 
@@ -317,6 +512,17 @@ int Fun4AllServer::unregisterSubsystemsNow()
     delete (*removeiter).first;
     // also update the vector with return codes
     RetCodes.erase(RetCodes.begin() + index);
+    SubsystemTimers.erase(SubsystemTimers.begin() + index);
+    SubsystemTDirNames.erase(SubsystemTDirNames.begin() + index);
+    SubsystemProfiles.erase(SubsystemProfiles.begin() + index);
+    SubsystemTimeHistos.erase(SubsystemTimeHistos.begin() + index);
+    SubsystemEventClasses.erase(SubsystemEventClasses.begin() + index);
+    SubsystemSkipCounts.erase(SubsystemSkipCounts.begin() + index);
+    if (index < static_cast<int>(m_NFilters))
+    {
+      m_FilterStats.erase(m_FilterStats.begin() + index);
+      m_NFilters--;
+    }
     std::vector<Fun4AllOutputManager *>::iterator outiter;
     for (outiter = OutputManager.begin(); outiter != OutputManager.end(); ++outiter)
     {
@@ -505,6 +711,20 @@ TNamed *Fun4AllServer::getHisto(const std::string &hname) const
 int Fun4AllServer::process_event()
 {
   eventcounter++;
+  m_JobEventCounter++;
+  if (m_TimeToFirstEvent <= 0)
+  {
+    m_StartupTimer.stop();
+    m_TimeToFirstEvent = m_StartupTimer.elapsed();
+    if (Verbosity() >= VERBOSITY_SOME)
+    {
+      Print("STARTUP");
+    }
+  }
+  if (m_ProfileFirstEvent > 0 && eventcounter == m_ProfileFirstEvent)
+  {
+    PHProfiler::instance()->Start(m_ProfileFileName);
+  }
   unsigned icnt = 0;
   int eventbad = 0;
   if (ScreamEveryEvent)
@@ -530,13 +750,39 @@ int Fun4AllServer::process_event()
   }
   gROOT->cd(default_Tdirectory.c_str());
   std::string currdir = gDirectory->GetPath();
+  m_EventClasses = 0;
+  m_EventTimer.restart();
+  if (m_ModuleProfilingFlag)
+  {
+    // modules which do not run in this event (skipped or after an abort) must not report the last one
+    for (auto &profile : SubsystemProfiles)
+    {
+      profile.Clear();
+    }
+  }
   for (auto &Subsystem : Subsystems)
   {
     if (Verbosity() >= VERBOSITY_MORE)
     {
       std::cout << "Fun4AllServer::process_event processing " << Subsystem.first->Name() << std::endl;
     }
-    std::string newdirname = Subsystem.second->getName() + "/" + Subsystem.first->Name();
+    if (SubsystemEventClasses[icnt] && !(SubsystemEventClasses[icnt] & m_EventClasses))
+    {
+      // none of the classes this module needs was set by the filters
+      SubsystemSkipCounts[icnt]++;
+      RetCodes[icnt] = Fun4AllReturnCodes::DISCARDEVENT;
+      if (Verbosity() >= VERBOSITY_MORE)
+      {
+        std::cout << "Fun4AllServer::process_event skipping " << Subsystem.first->Name() << ", event class not set" << std::endl;
+      }
+      icnt++;
+      continue;
+    }
+    if (icnt < m_NFilters)
+    {
+      m_FilterStats[icnt].Events++;
+    }
+    const std::string &newdirname = SubsystemTDirNames[icnt];
     if (!gROOT->cd(newdirname.c_str()))
     {
       std::cout << PHWHERE << "Unexpected TDirectory Problem cd'ing to "
@@ -557,24 +803,34 @@ int Fun4AllServer::process_event()
 
     try
     {
-      std::string timer_name;
-      timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
-      std::map<const std::string, PHTimer>::iterator titer = timer_map.find(timer_name);
-      bool timer_found = false;
-      if (titer != timer_map.end())
+      PHTimer *subsys_timer = SubsystemTimers[icnt];
+      // reading the memory from /proc is not free, only done on request
+      std::clock_t cpustart = 0;
+      long rssstart = 0;
+      double taskstart = 0;
+      Fun4AllAllocationCounter::Counts allocstart;
+      if (m_ModuleProfilingFlag)
       {
-        timer_found = true;
-        titer->second.restart();
-      }
-      else
-      {
-        std::cout << "could not find timer for " << timer_name << std::endl;
+        ProcInfo_t procinfo;
+        gSystem->GetProcInfo(&procinfo);
+        rssstart = procinfo.fMemResident;
+        cpustart = std::clock();
+        taskstart = m_ThreadPool ? m_ThreadPool->busy_time() : 0;
+        allocstart = Fun4AllAllocationCounter::Total();
       }
+      subsys_timer->restart();
 #ifdef FFAMEMTRACKER
+      std::string timer_name = Subsystem.first->Name() + "_" + Subsystem.second->getName();
       ffamemtracker->Start(timer_name, "SubsysReco");
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
-      int retcode = Subsystem.first->process_event(Subsystem.second);
+      int retcode = 0;
+      {
+        PHTraceScope trace(Subsystem.first->Name(), "module");
+        PHProfiler::SetActive(Subsystem.first->Name().c_str());
+        retcode = Subsystem.first->process_event(Subsystem.second);
+        PHProfiler::SetActive(nullptr);
+      }
 #ifdef FFAMEMTRACKER
       ffamemtracker->Snapshot("Fun4AllServerProcessEvent");
 #endif
@@ -593,9 +849,26 @@ int Fun4AllServer::process_event()
         std::cout << "error: " << e.what() << std::endl;
         gSystem->Exit(1);
       }
-      if (timer_found)
+      subsys_timer->stop();
+      if (m_PerformanceSummaryFlag)
+      {
+        SubsystemTimeHistos[icnt][time_bin(subsys_timer->elapsed())]++;
+      }
+      if (m_ModuleProfilingFlag)
       {
-        titer->second.stop();
+        ModuleProfile &profile = SubsystemProfiles[icnt];
+        profile.Valid = true;
+        profile.CpuTime = 1000. * (std::clock() - cpustart) / CLOCKS_PER_SEC;
+        profile.WallTime = subsys_timer->elapsed();
+        ProcInfo_t procinfo;
+        gSystem->GetProcInfo(&procinfo);
+        profile.RSSDelta = procinfo.fMemResident - rssstart;
+        // the pool might have been created by this module
+        profile.TaskTime = m_ThreadPool ? m_ThreadPool->busy_time() - taskstart : 0;
+        const Fun4AllAllocationCounter::Counts allocs = Fun4AllAllocationCounter::Total();
+        profile.Allocations = allocs.Allocations - allocstart.Allocations;
+        profile.AllocatedBytes = allocs.AllocatedBytes - allocstart.AllocatedBytes;
+        profile.FreedBytes = allocs.FreedBytes - allocstart.FreedBytes;
       }
 #ifdef FFAMEMTRACKER
       ffamemtracker->Stop(timer_name, "SubsysReco");
@@ -627,6 +900,10 @@ int Fun4AllServer::process_event()
       {
         retcodesmap[Fun4AllReturnCodes::ABORTEVENT]++;
         eventbad = 1;
+        if (icnt < m_NFilters)
+        {
+          m_FilterStats[icnt].Rejected++;
+        }
         if (Verbosity() >= VERBOSITY_MORE)
         {
           std::cout << "Fun4AllServer::Abort Event by " << Subsystem.first->Name() << std::endl;
@@ -667,6 +944,8 @@ int Fun4AllServer::process_event()
     }
     icnt++;
   }
+  m_EventTimer.stop();
+  m_EventTimeHisto[time_bin(m_EventTimer.elapsed())]++;
   if (!eventbad)
   {
     retcodesmap[Fun4AllReturnCodes::EVENT_OK]++;
@@ -714,7 +993,21 @@ int Fun4AllServer::process_event()
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
           ffamemtracker->Start((*iterOutMan)->Name(), "OutputManager");
 #endif
-          (*iterOutMan)->WriteGeneric(dstNode);
+          {
+            PHTraceScope trace((*iterOutMan)->Name(), "output");
+            if (m_PerformanceSummaryFlag)
+            {
+              m_OutputTimer.restart();
+            }
+            PHProfiler::SetActive((*iterOutMan)->Name().c_str());
+            (*iterOutMan)->WriteGeneric(dstNode);
+            m_OpenOutputFiles.insert(*iterOutMan);
+            PHProfiler::SetActive(nullptr);
+            if (m_PerformanceSummaryFlag)
+            {
+              m_OutputTimer.stop();
+            }
+          }
 #ifdef FFAMEMTRACKER
           ffamemtracker->Stop((*iterOutMan)->Name(), "OutputManager");
           ffamemtracker->Snapshot("Fun4AllServerOutputManager");
@@ -726,11 +1019,7 @@ int Fun4AllServer::process_event()
               std::cout << PHWHERE << (*iterOutMan)->Name() << " wrote " << (*iterOutMan)->EventsWritten()
                         << " events, closing " << (*iterOutMan)->OutFileName() << std::endl;
             }
-            PHNodeIterator nodeiter(TopNode);
-            PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
-            MakeNodesTransient(runNode);  // make all nodes transient by default
-            (*iterOutMan)->WriteNode(runNode);
-            (*iterOutMan)->RunAfterClosing();
+            CloseOutputFile(*iterOutMan);
           }
         }
         else
@@ -743,6 +1032,20 @@ int Fun4AllServer::process_event()
       }
     }
   }
+  if (m_ModuleProfilingFlag > 1)
+  {
+    // streamed size of the event nodes, before they are reset
+    PHNodeSize sizer;
+    for (const auto &[topnodename, topnode] : topnodemap)
+    {
+      PHNodeIterator mainIter(topnode);
+      if (mainIter.cd("DST"))
+      {
+        mainIter.forEach(sizer);
+      }
+    }
+    m_NodeSizes = sizer.Sizes();
+  }
   for (auto &Subsystem : Subsystems)
   {
     if (Verbosity() >= VERBOSITY_EVEN_MORE)
@@ -759,11 +1062,41 @@ int Fun4AllServer::process_event()
     }
     syncman->ResetEvent();
   }
+  PHCounterRegistry::instance()->EndEvent();
+  if (eventcounter == m_ProfileLastEvent)
+  {
+    PHProfiler::instance()->Stop();
+  }
   Fun4AllMonitoring::instance()->Snapshot("Event");
   ResetNodeTree();
+  if (m_CheckpointEvents > 0 && m_JobEventCounter % m_CheckpointEvents == 0)
+  {
+    WriteCheckpoint();
+  }
+  for (auto *histoman : HistoManager)
+  {
+    if (histoman->SnapshotEvents() > 0 && m_JobEventCounter % histoman->SnapshotEvents() == 0)
+    {
+      histoman->Snapshot();
+    }
+  }
   return 0;
 }
 
+void Fun4AllServer::CloseOutputFile(Fun4AllOutputManager *manager)
+{
+  PHNodeIterator nodeiter(TopNode);
+  PHCompositeNode *runNode = dynamic_cast<PHCompositeNode *>(nodeiter.findFirst("PHCompositeNode", "RUN"));
+  if (m_PerformanceSummaryFlag && runNode)
+  {
+    FillPerformanceSummary(runNode);
+  }
+  MakeNodesTransient(runNode);  // make all nodes transient by default
+  manager->WriteNode(runNode);
+  manager->RunAfterClosing();
+  m_OpenOutputFiles.erase(manager);
+}
+
 int Fun4AllServer::ResetNodeTree()
 {
   std::vector<std::string> ResetNodeList;
@@ -783,6 +1116,36 @@ int Fun4AllServer::ResetNodeTree()
       }
     }
   }
+
+  // the containers keep their memory for the next event, release it according to the trim policy
+  ++m_NodeResetCount;
+  bool trim = (m_NodeTrimEvents > 0 && m_NodeResetCount % m_NodeTrimEvents == 0);
+  if (!trim && m_NodeTrimRSSLimit > 0)
+  {
+    trim = (ffamemtracker->GetRSSMemory() / 1024. > m_NodeTrimRSSLimit);
+  }
+  if (trim)
+  {
+    if (Verbosity() > 1)
+    {
+      std::cout << "Fun4AllServer::ResetNodeTree - trimming node memory, resident memory "
+                << ffamemtracker->GetRSSMemory() / 1024. << " MB" << std::endl;
+    }
+    PHNodeTrim trimmer;
+    trimmer.Verbosity(Verbosity() > 2 ? Verbosity() - 2 : 0);
+    for (iter = topnodemap.begin(); iter != topnodemap.end(); ++iter)
+    {
+      PHNodeIterator mainIter((*iter).second);
+      for (const auto &nodename : ResetNodeList)
+      {
+        if (mainIter.cd(nodename))
+        {
+          mainIter.forEach(trimmer);
+          mainIter.cd();
+        }
+      }
+    }
+  }
   return 0;  // anything except 0 would abort the event loop in pmonitor
 }
 
@@ -906,7 +1269,11 @@ int Fun4AllServer::BeginRunSubsystem(const std::pair<SubsysReco *, PHCompositeNo
 #ifdef FFAMEMTRACKER
     ffamemtracker->Start(subsys.first->Name(), "SubsysReco");
 #endif
+    PHTimer initruntimer;
+    initruntimer.restart();
     iret = subsys.first->InitRun(subsys.second);
+    initruntimer.stop();
+    m_StartupTimes.emplace_back("InitRun " + subsys.first->Name(), initruntimer.elapsed());
 #ifdef FFAMEMTRACKER
     ffamemtracker->Stop(subsys.first->Name(), "SubsysReco");
 #endif
@@ -1062,6 +1429,8 @@ int Fun4AllServer::EndRun(const int runno)
 
 int Fun4AllServer::End()
 {
+  // fewer events than requested, the End methods are not profiled
+  PHProfiler::instance()->Stop();
   recoConsts *rc = recoConsts::instance();
   EndRun(rc->get_IntFlag("RUNNUMBER"));  // call SubsysReco EndRun methods for current run
   int i = 0;
@@ -1116,6 +1485,14 @@ int Fun4AllServer::End()
   }
   else
   {
+    if (m_PerformanceSummaryFlag)
+    {
+      FillPerformanceSummary(runNode);
+      if (!m_PerformanceSummaryJson.empty())
+      {
+        WritePerformanceSummaryJson(runNode);
+      }
+    }
     if (!OutputManager.empty())  // there are registered IO managers
     {
       MakeNodesTransient(runNode);  // make all nodes transient by default
@@ -1148,6 +1525,24 @@ int Fun4AllServer::End()
     std::cout << "*******************************************************************************" << std::endl;
   }
 
+  if (m_NFilters > 0 && Verbosity() >= VERBOSITY_SOME)
+  {
+    Print("FILTERS");
+  }
+
+  if (!m_TraceFileName.empty())
+  {
+    PHTrace *trace = PHTrace::instance();
+    trace->Enable(false);
+    std::cout << "Fun4AllServer::End: writing " << trace->size() << " trace spans to " << m_TraceFileName << std::endl;
+    trace->WriteJson(m_TraceFileName);
+  }
+  if (!m_CheckpointFileName.empty())
+  {
+    // the job is complete, a restart has to begin from the first event
+    std::error_code ec;
+    std::filesystem::remove(m_CheckpointFileName, ec);
+  }
   return i;
 }
 
@@ -1209,6 +1604,87 @@ void Fun4AllServer::Print(const std::string &what) const
     }
     std::cout << std::endl;
   }
+  if (what == "ALL" || what == "STARTUP")
+  {
+    // slowest first, the library loads are only the ones done via LoadLibrary()
+    std::vector<std::pair<std::string, double>> sorted = m_StartupTimes;
+    std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b)
+              { return a.second > b.second; });
+    double total = 0;
+    const auto oldprecision = std::cout.precision();
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Startup times in Fun4AllServer:" << std::endl;
+    for (const auto &[step, ms] : sorted)
+    {
+      std::cout << std::setw(12) << std::fixed << std::setprecision(1) << ms << " ms  " << step << std::endl;
+      total += ms;
+    }
+    std::cout << std::setw(12) << total << " ms  total of the steps above" << std::endl;
+    if (m_TimeToFirstEvent > 0)
+    {
+      std::cout << std::setw(12) << m_TimeToFirstEvent << " ms  from server creation to the first event" << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout.precision(oldprecision);
+    std::cout << std::endl;
+  }
+  if (what == "ALL" || what == "LATENCY")
+  {
+    // time of all modules per event, e.g. to check the budget of an online reconstruction
+    const auto oldprecision = std::cout.precision();
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Event processing times in Fun4AllServer (events per bin):" << std::endl;
+    for (unsigned int i = 0; i < m_EventTimeHisto.size(); ++i)
+    {
+      if (m_EventTimeHisto[i])
+      {
+        std::cout << std::setw(12) << std::fixed << std::setprecision(3)
+                  << std::pow(10., TIMEHIST_MIN_LOG + static_cast<double>(i) / TIMEBINS_PER_DECADE)
+                  << " ms  " << m_EventTimeHisto[i] << std::endl;
+      }
+    }
+    std::cout << "median " << EventTimeQuantile(0.5) << " ms, 99% " << EventTimeQuantile(0.99)
+              << " ms, 99.9% " << EventTimeQuantile(0.999) << " ms" << std::endl;
+    std::cout.unsetf(std::ios::floatfield);
+    std::cout.precision(oldprecision);
+    std::cout << std::endl;
+  }
+  if (what == "ALL" || what == "FILTERS")
+  {
+    std::cout << "--------------------------------------" << std::endl
+              << std::endl;
+    std::cout << "Filters in Fun4AllServer (events seen, rejected):" << std::endl;
+    for (unsigned int i = 0; i < m_NFilters; ++i)
+    {
+      const FilterStat &stat = m_FilterStats[i];
+      std::cout << std::setw(12) << stat.Events << std::setw(12) << stat.Rejected << "  "
+                << Subsystems[i].first->Name() << std::endl;
+    }
+    if (!m_EventClassBits.empty())
+    {
+      std::cout << "Event classes (events tagged):" << std::endl;
+      for (const auto &[eventclass, bit] : m_EventClassBits)
+      {
+        std::cout << std::setw(12) << m_EventClassCounts[bit] << "  " << eventclass << std::endl;
+      }
+    }
+    bool header = false;
+    for (size_t i = 0; i < Subsystems.size(); ++i)
+    {
+      if (SubsystemEventClasses[i])
+      {
+        if (!header)
+        {
+          std::cout << "Modules which require event classes (events skipped):" << std::endl;
+          header = true;
+        }
+        std::cout << std::setw(12) << SubsystemSkipCounts[i] << "  " << Subsystems[i].first->Name() << std::endl;
+      }
+    }
+    std::cout << std::endl;
+  }
   if (what == "ALL" || what == "TOPNODES")
   {
     // loop over the map and print out the content (name and location in memory)
@@ -1263,6 +1739,7 @@ int Fun4AllServer::outfileclose()
     delete *(OutputManager.begin());
     OutputManager.erase(OutputManager.begin());
   }
+  m_OpenOutputFiles.clear();
   return 0;
 }
 
@@ -1383,7 +1860,21 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       {
         std::cout << "executing run for input master " << (*iter)->Name() << std::endl;
       }
-      int retval = (*iter)->run(1);
+      int retval = 0;
+      {
+        PHTraceScope trace((*iter)->Name(), "input");
+        if (m_PerformanceSummaryFlag)
+        {
+          m_InputTimer.restart();
+        }
+        PHProfiler::SetActive((*iter)->Name().c_str());
+        retval = (*iter)->run(1);
+        PHProfiler::SetActive(nullptr);
+        if (m_PerformanceSummaryFlag)
+        {
+          m_InputTimer.stop();
+        }
+      }
       // if a new input file is opened during syncing and it contains
       // different nodes
       // as the previous one, the info in the nodes which are only in
@@ -1457,6 +1948,10 @@ int Fun4AllServer::run(const int nevnts, const bool require_nevents)
       setRun(runnumber);
       BeginRun(runnumber);
       ifirst = 0;
+      if (!m_ResumeCheckpoint.empty())
+      {
+        RestoreCheckpoint();
+      }
     }
     else if (!run_number_forced)
     {
@@ -1525,6 +2020,7 @@ int Fun4AllServer::skip(const int nevnts)
       iret += (*iter)->skip(nevnts);
     }
     eventcounter += nevnts;  // update event counter so it reflects the number of events in the input
+    m_JobEventCounter += nevnts;
   }
   return iret;
 }
@@ -1710,6 +2206,383 @@ void Fun4AllServer::NodeIdentify(const std::string &name)
   return;
 }
 
+void Fun4AllServer::EnableTracing(const std::string &filename)
+{
+  m_TraceFileName = filename;
+  PHTrace::instance()->Enable(!filename.empty());
+}
+
+void Fun4AllServer::EnableModuleProfiling(const int i)
+{
+  m_ModuleProfilingFlag = i;
+  PHCounterRegistry::instance()->Enable(i > 0);
+}
+
+void Fun4AllServer::ProfileEvents(const int first, const int last, const std::string &filename)
+{
+  m_ProfileFirstEvent = first;
+  m_ProfileLastEvent = last;
+  m_ProfileFileName = filename;
+}
+
+int Fun4AllServer::LoadLibrary(const std::string &library)
+{
+  PHTimer loadtimer;
+  loadtimer.restart();
+  int iret = gSystem->Load(library.c_str());
+  loadtimer.stop();
+  instance()->m_StartupTimes.emplace_back("Load " + library, loadtimer.elapsed());
+  return iret;
+}
+
+void Fun4AllServer::EnablePerformanceSummary(const std::string &jsonfile)
+{
+  m_PerformanceSummaryFlag = 1;
+  m_PerformanceSummaryJson = jsonfile;
+}
+
+void Fun4AllServer::EnableCheckpoint(const std::string &filename, const unsigned int nevents)
+{
+  m_CheckpointFileName = filename;
+  m_CheckpointEvents = nevents;
+}
+
+namespace
+{
+  // histogram names can contain '/', which are directories in the checkpoint file
+  std::string checkpoint_key(std::string name)
+  {
+    std::replace(name.begin(), name.end(), '/', '|');
+    return name;
+  }
+}  // namespace
+
+int Fun4AllServer::WriteCheckpoint()
+{
+  PHTraceScope trace("Checkpoint", "output");
+  // the next events go to new file segments, a resumed job writes them again
+  for (auto *outman : OutputManager)
+  {
+    if (m_OpenOutputFiles.find(outman) == m_OpenOutputFiles.end())
+    {
+      continue;
+    }
+    if (!outman->ApplyFileRule())
+    {
+      static std::set<std::string> warned;
+      if (warned.insert(outman->Name()).second)
+      {
+        std::cout << PHWHERE << " output of " << outman->Name()
+                  << " cannot be resumed from a checkpoint, set UseFileRule()" << std::endl;
+      }
+      continue;
+    }
+    CloseOutputFile(outman);
+  }
+
+  // the previous checkpoint stays valid until the new one is complete
+  const std::string tmpname = m_CheckpointFileName + ".tmp";
+  TDirectory *savedir = gDirectory;
+  TFile *checkpoint = TFile::Open(tmpname.c_str(), "RECREATE");
+  if (!checkpoint || checkpoint->IsZombie())
+  {
+    std::cout << PHWHERE << " could not open checkpoint file " << tmpname << std::endl;
+    delete checkpoint;
+    savedir->cd();
+    return -1;
+  }
+
+  std::ostringstream state;
+  state << "jobevents " << m_JobEventCounter << std::endl
+        << "eventcounter " << eventcounter << std::endl;
+  for (auto *outman : OutputManager)
+  {
+    state << "segment " << outman->Name() << " " << outman->CurrentSegment() << std::endl;
+  }
+  TObjString serverstate(state.str().c_str());
+  checkpoint->WriteTObject(&serverstate, "Fun4AllServer");
+  TObjString seedstate(PHRandomSeed::SaveState().c_str());
+  checkpoint->WriteTObject(&seedstate, "PHRandomSeed");
+
+  TDirectory *histodir = checkpoint->mkdir("HISTOS");
+  for (auto *histoman : HistoManager)
+  {
+    TDirectory *dir = histodir->mkdir(histoman->Name().c_str());
+    for (unsigned int i = 0; i < histoman->nHistos(); ++i)
+    {
+      dir->WriteTObject(histoman->getHisto(i), checkpoint_key(histoman->getHistoName(i)).c_str());
+    }
+  }
+
+  int iret = 0;
+  TDirectory *moduledir = checkpoint->mkdir("MODULES");
+  for (auto &[module, topnode] : Subsystems)
+  {
+    TDirectory *dir = moduledir->mkdir(module->Name().c_str());
+    dir->cd();
+    if (module->SaveCheckpoint(dir))
+    {
+      std::cout << PHWHERE << " checkpoint of " << module->Name() << " failed" << std::endl;
+      iret = -1;
+    }
+  }
+  checkpoint->Close();
+  delete checkpoint;
+  savedir->cd();
+  std::error_code ec;
+  if (iret)
+  {
+    std::filesystem::remove(tmpname, ec);
+    return iret;
+  }
+  std::filesystem::rename(tmpname, m_CheckpointFileName, ec);
+  if (ec)
+  {
+    std::cout << PHWHERE << " could not move " << tmpname << " to " << m_CheckpointFileName
+              << ": " << ec.message() << std::endl;
+    return -1;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "Fun4AllServer: wrote checkpoint " << m_CheckpointFileName
+              << " after " << m_JobEventCounter << " events" << std::endl;
+  }
+  return 0;
+}
+
+int Fun4AllServer::ResumeFromCheckpoint(const std::string &filename)
+{
+  if (!std::filesystem::exists(filename))
+  {
+    std::cout << "Fun4AllServer: no checkpoint " << filename << ", starting from the first event" << std::endl;
+    return 0;
+  }
+  TDirectory *savedir = gDirectory;
+  TFile *checkpoint = TFile::Open(filename.c_str(), "READ");
+  TObjString *state = checkpoint ? dynamic_cast<TObjString *>(checkpoint->Get("Fun4AllServer")) : nullptr;
+  if (!state)
+  {
+    std::cout << PHWHERE << " " << filename << " is not a checkpoint file" << std::endl;
+    delete checkpoint;
+    savedir->cd();
+    return -1;
+  }
+  std::istringstream is(state->GetString().Data());
+  delete checkpoint;
+  savedir->cd();
+
+  long jobevents = 0;
+  std::string key;
+  while (is >> key)
+  {
+    if (key == "jobevents")
+    {
+      is >> jobevents;
+    }
+    else if (key == "eventcounter")
+    {
+      is >> m_ResumeEventCounter;
+    }
+    else if (key == "segment")
+    {
+      std::string name;
+      int segment = 0;
+      is >> name >> segment;
+      if (Fun4AllOutputManager *outman = getOutputManager(name))
+      {
+        outman->CurrentSegment(segment);
+      }
+    }
+  }
+  // the events counted in the checkpoint include those the macro skipped
+  // before calling this, only the rest of them is skipped here
+  const long toskip = jobevents - m_JobEventCounter;
+  std::cout << "Fun4AllServer: resuming from checkpoint " << filename
+            << ", skipping " << toskip << " events" << std::endl;
+  int iret = skip(toskip);
+  m_ResumeCheckpoint = filename;
+  return iret;
+}
+
+int Fun4AllServer::RestoreCheckpoint()
+{
+  TDirectory *savedir = gDirectory;
+  TFile *checkpoint = TFile::Open(m_ResumeCheckpoint.c_str(), "READ");
+  if (!checkpoint || checkpoint->IsZombie())
+  {
+    std::cout << PHWHERE << " could not open checkpoint " << m_ResumeCheckpoint << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+
+  // InitRun reset the event counter, continue with the one of the checkpoint
+  eventcounter = m_ResumeEventCounter;
+
+  // seeds requested in Init and InitRun are the same as in the first job, later ones continue the sequence
+  TObjString *seeds = dynamic_cast<TObjString *>(checkpoint->Get("PHRandomSeed"));
+  if (seeds)
+  {
+    PHRandomSeed::RestoreState(seeds->GetString().Data());
+  }
+
+  for (auto *histoman : HistoManager)
+  {
+    TDirectory *dir = checkpoint->GetDirectory(("HISTOS/" + histoman->Name()).c_str());
+    if (!dir)
+    {
+      continue;
+    }
+    for (unsigned int i = 0; i < histoman->nHistos(); ++i)
+    {
+      TNamed *histo = histoman->getHisto(i);
+      TObject *saved = dir->Get(checkpoint_key(histoman->getHistoName(i)).c_str());
+      if (!saved)
+      {
+        continue;
+      }
+      if (TH1 *h1 = dynamic_cast<TH1 *>(histo))
+      {
+        if (TH1 *saved1 = dynamic_cast<TH1 *>(saved))
+        {
+          h1->Reset();
+          h1->Add(saved1);
+          continue;
+        }
+      }
+      else if (THnSparse *hs = dynamic_cast<THnSparse *>(histo))
+      {
+        if (THnSparse *savedhs = dynamic_cast<THnSparse *>(saved))
+        {
+          hs->Reset();
+          hs->Add(savedhs);
+          continue;
+        }
+      }
+      std::cout << PHWHERE << " cannot restore " << histoman->getHistoName(i)
+                << " of " << histoman->Name() << " from the checkpoint" << std::endl;
+    }
+  }
+
+  int iret = 0;
+  for (auto &[module, topnode] : Subsystems)
+  {
+    TDirectory *dir = checkpoint->GetDirectory(("MODULES/" + module->Name()).c_str());
+    if (!dir)
+    {
+      std::cout << PHWHERE << " no checkpoint for " << module->Name() << std::endl;
+      continue;
+    }
+    dir->cd();
+    if (module->RestoreCheckpoint(dir))
+    {
+      std::cout << PHWHERE << " restoring " << module->Name() << " from checkpoint failed" << std::endl;
+      iret = -1;
+    }
+  }
+  delete checkpoint;
+  savedir->cd();
+  if (iret)
+  {
+    gSystem->Exit(1);
+    exit(1);
+  }
+  m_ResumeCheckpoint.clear();
+  return 0;
+}
+
+void Fun4AllServer::FillPerformanceSummary(PHCompositeNode *runNode)
+{
+  PerformanceSummary *summary = findNode::getClass<PerformanceSummary>(runNode, "PerformanceSummary");
+  if (!summary)
+  {
+    summary = new PerformanceSummaryv1();
+    PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(summary, "PerformanceSummary", "PHObject");
+    runNode->addNode(newNode);
+  }
+  // a summary read from the input belongs to the job which wrote the input
+  summary->Reset();
+  for (size_t i = 0; i < Subsystems.size(); ++i)
+  {
+    const PHTimer *timer = SubsystemTimers[i];
+    const unsigned int ncycle = timer->get_ncycle();
+    summary->AddModule(SubsystemProfiles[i].Name, ncycle, timer->get_accumulated_time(),
+                       (ncycle ? timer->get_time_per_cycle() : 0.), time_quantile(SubsystemTimeHistos[i], 0.99));
+  }
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  summary->set_value("events", eventcounter);
+  summary->set_value("event_p50_ms", EventTimeQuantile(0.5));
+  summary->set_value("event_p99_ms", EventTimeQuantile(0.99));
+  summary->set_value("peak_rss_kb", usage.ru_maxrss);
+  summary->set_value("cpu_time_s", usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                                       1e-6 * (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec));
+  summary->set_value("input_read_ms", m_InputTimer.get_accumulated_time());
+  // the ROOT counters cover all ROOT files of the process
+  summary->set_value("input_bytes", TFile::GetFileBytesRead());
+  // ROOT compresses the baskets while writing, the compression is part of the write time
+  summary->set_value("output_write_ms", m_OutputTimer.get_accumulated_time());
+  summary->set_value("output_bytes", TFile::GetFileBytesWritten());
+}
+
+double Fun4AllServer::EventTimeQuantile(const double q) const
+{
+  return time_quantile(m_EventTimeHisto, q);
+}
+
+void Fun4AllServer::WritePerformanceSummaryJson(PHCompositeNode *runNode) const
+{
+  PerformanceSummary *summary = findNode::getClass<PerformanceSummary>(runNode, "PerformanceSummary");
+  std::ofstream json(m_PerformanceSummaryJson);
+  if (!summary || !json.is_open())
+  {
+    std::cout << PHWHERE << " could not write performance summary to " << m_PerformanceSummaryJson << std::endl;
+    return;
+  }
+  json.precision(12);  // byte counts
+  json << "{\n  \"runnumber\": " << runnumber;
+  for (auto iter = summary->values_begin(); iter != summary->values_end(); ++iter)
+  {
+    json << ",\n  \"" << iter->first << "\": " << iter->second;
+  }
+  json << ",\n  \"modules\": [";
+  bool first = true;
+  for (const auto &[name, nevents, total, mean, p99] : *summary)
+  {
+    json << (first ? "" : ",") << "\n    {\"name\": \"" << name << "\", \"events\": " << nevents
+         << ", \"total_ms\": " << total << ", \"mean_ms\": " << mean << ", \"p99_ms\": " << p99 << "}";
+    first = false;
+  }
+  json << "\n  ]\n}" << std::endl;
+}
+
+unsigned int Fun4AllServer::ThreadBudget() const
+{
+  recoConsts *rc = recoConsts::instance();
+  if (!rc->FlagExist("NTHREADS"))
+  {
+    return 1;
+  }
+  int nthreads = rc->get_IntFlag("NTHREADS");
+  if (nthreads <= 0)
+  {
+    return std::thread::hardware_concurrency();
+  }
+  return nthreads;
+}
+
+PHThreadPool *Fun4AllServer::ThreadPool()
+{
+  if (!m_ThreadPool)
+  {
+    m_ThreadPool = new PHThreadPool(ThreadBudget());
+    if (Verbosity() > 0)
+    {
+      std::cout << "Fun4AllServer: shared thread pool with " << m_ThreadPool->size() << " threads" << std::endl;
+    }
+  }
+  return m_ThreadPool;
+}
+
 void Fun4AllServer::PrintTimer(const std::string &name)
 {
   std::map<const std::string, PHTimer>::const_iterator iter;
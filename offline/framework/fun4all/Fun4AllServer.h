@@ -9,18 +9,22 @@
 
 #include <phool/PHTimer.h>
 
+#include <cstdint>
 #include <deque>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
+class Fun4AllFastHisto;
 class Fun4AllInputManager;
 class Fun4AllMemoryTracker;
 class Fun4AllSyncManager;
 class Fun4AllOutputManager;
 class PHCompositeNode;
+class PHThreadPool;
 class PHTimeStamp;
 class SubsysReco;
 class TDirectory;
@@ -42,11 +46,34 @@ class Fun4AllServer : public Fun4AllBase
     return ServerHistoManager->makeHisto(t);
   }
   virtual int isHistoRegistered(const std::string &name) const;
+  //! fast fixed binning histograms with one shard per worker thread, see Fun4AllFastHisto
+  bool registerFastHisto(const std::string &hname, Fun4AllFastHisto *h, const int replace = 0);
+  bool registerFastHisto(Fun4AllFastHisto *h, const int replace = 0);
+  template <typename T>
+  T *makeFastHisto(T *t)
+  {
+    return ServerHistoManager->makeFastHisto(t);
+  }
 
   int registerSubsystem(SubsysReco *subsystem, const std::string &topnodename = "TOP");
   void addNewSubsystem(SubsysReco *subsystem, const std::string &topnodename = "TOP") { NewSubsystems.push_back(std::make_pair(subsystem, topnodename)); }
   int unregisterSubsystem(SubsysReco *subsystem);
   SubsysReco *getSubsysReco(const std::string &name);
+
+  //! register a filter, filters run before all other modules in the order they were registered
+  /*! filters are cheap predicates (trigger bits, vertex, laser flag), they
+      reject events with ABORTEVENT before the expensive modules run or tag
+      them with SetEventClass() for RequireEventClass(). Their rejection
+      statistics are shown with Print("FILTERS") */
+  int registerFilter(SubsysReco *filter, const std::string &topnodename = "TOP");
+  //! tag the current event with a class (up to 64 names), the tags are cleared for every event
+  void SetEventClass(const std::string &eventclass);
+  bool HasEventClass(const std::string &eventclass) const;
+  //! run module modulename only on events which were tagged with one of its required classes
+  /*! can be called before or after the module is registered, every call
+      adds a class. Skipped modules return DISCARDEVENT to the event
+      selectors of the output managers */
+  int RequireEventClass(const std::string &modulename, const std::string &eventclass);
   int registerOutputManager(Fun4AllOutputManager *manager);
   Fun4AllOutputManager *getOutputManager(const std::string &name);
   int registerHistoManager(Fun4AllHistoManager *manager);
@@ -114,9 +141,101 @@ class Fun4AllServer : public Fun4AllBase
   void PrintMemoryTracker(const std::string &name = "") const;
   int RunNumber() const { return runnumber; }
   int EventCounter() const { return eventcounter; }
+  //! time (ms) the modules took for an event, below which the fraction q of the events of the job are
+  /*! e.g. EventTimeQuantile(0.99) to check an online latency budget */
+  double EventTimeQuantile(const double q) const;
   std::map<const std::string, PHTimer>::const_iterator timer_begin() { return timer_map.begin(); }
   std::map<const std::string, PHTimer>::const_iterator timer_end() { return timer_map.end(); }
 
+  // resource usage of each module in the last event, filled if module profiling is enabled
+  class ModuleProfile
+  {
+   public:
+    std::string Name;     // same as the timer name
+    double WallTime{0};   // ms
+    double CpuTime{0};    // ms, process cpu time, includes helper threads of the module
+    long RSSDelta{0};     // kB, change of the resident memory
+    double TaskTime{0};   // ms, wall time of the module in parallel loops of the shared thread pool
+    // heap use, only counted with libfun4allmemhooks loaded (see Fun4AllAllocationCounter)
+    long Allocations{0};
+    long AllocatedBytes{0};
+    long FreedBytes{0};
+    bool Valid{false};  // the module ran in the last event
+    //! reset the values at the start of an event, keeps the name
+    void Clear()
+    {
+      std::string name = std::move(Name);
+      *this = ModuleProfile();
+      Name = std::move(name);
+    }
+  };
+  //! 1: resource usage per module, 2: also the streamed size of each node at the end of the event
+  /*! also switches on the module counters (PHCounterRegistry) */
+  void EnableModuleProfiling(const int i = 1);
+  int ModuleProfiling() const { return m_ModuleProfilingFlag; }
+  const std::vector<ModuleProfile> &ModuleProfiles() const { return SubsystemProfiles; }
+  //! bytes by node name in the last event, filled with module profiling 2
+  const std::map<std::string, long> &NodeSizes() const { return m_NodeSizes; }
+
+  //! thread budget of the job, recoConsts flag NTHREADS (default 1, 0 = all cores)
+  unsigned int ThreadBudget() const;
+  //! thread pool shared by all modules, started on first use with ThreadBudget() threads
+  /*! modules use this instead of their own pools, so the job does not
+      run more threads than cores given to it */
+  PHThreadPool *ThreadPool();
+
+  //! when ResetNodeTree() releases the memory the containers keep for the next event (PHObject::Trim)
+  /*! every nevents events (0 = never) and whenever the resident memory
+      is above rss_limit_mb after the reset (0 = no limit). By default
+      the memory is kept for the whole job */
+  void SetNodeTrimPolicy(const unsigned int nevents, const double rss_limit_mb = 0)
+  {
+    m_NodeTrimEvents = nevents;
+    m_NodeTrimRSSLimit = rss_limit_mb;
+  }
+
+  //! record a timeline of the modules, input reads and output writes (see PHTrace)
+  /*! written as Chrome trace json to filename in End(), opens in
+      chrome://tracing or https://ui.perfetto.dev */
+  void EnableTracing(const std::string &filename = "fun4all_trace.json");
+
+  //! save a PerformanceSummary of the job on the RUN node of the output files
+  /*! time per module (total, mean, 99th percentile), peak memory and the
+      time and bytes of the input reads and output writes. Also written as
+      json to jsonfile in End() if given */
+  void EnablePerformanceSummary(const std::string &jsonfile = "");
+
+  //! sample the cpu time of events first to last of the run (counted from 1, see PHProfiler)
+  /*! the samples per module are written to filename.modules.txt, with
+      libprofiler loaded also a gperftools profile to filename.prof */
+  void ProfileEvents(const int first, const int last, const std::string &filename = "fun4all_profile");
+  //! write a checkpoint to filename every nevents events, so that preempted jobs can continue with ResumeFromCheckpoint()
+  /*! the output files are closed at every checkpoint and the next events
+      go to the next segment, output managers have to use UseFileRule().
+      Modules save their own state in SubsysReco::SaveCheckpoint(). The
+      checkpoint is removed by End() */
+  void EnableCheckpoint(const std::string &filename, const unsigned int nevents);
+  //! continue the job from the checkpoint in filename, call after the modules and inputs are set up, before run()
+  /*! the events up to the checkpoint are skipped. They include the events
+      the macro skipped with skip() before this call, call skip() before
+      and not after it. The random seeds, registered histograms (TH1 and
+      THnSparse) and module states are restored after the InitRun of the
+      first event. Without checkpoint the job starts from
+      the beginning, so the same macro is used for the start and restarts */
+  int ResumeFromCheckpoint(const std::string &filename);
+  //! true from ResumeFromCheckpoint() until the state is restored, e.g. to append to output files in InitRun
+  bool ResumingFromCheckpoint() const { return !m_ResumeCheckpoint.empty(); }
+  //! gSystem->Load() which records the load time for Print("STARTUP"), returns the gSystem->Load() code
+  static int LoadLibrary(const std::string &library);
+
+  // events seen and rejected (ABORTEVENT) by a filter
+  class FilterStat
+  {
+   public:
+    long Events{0};
+    long Rejected{0};
+  };
+
  protected:
   Fun4AllServer(const std::string &name = "Fun4AllServer");
   int InitNodeTree(PHCompositeNode *topNode);
@@ -125,6 +244,14 @@ class Fun4AllServer : public Fun4AllBase
   int UpdateEventSelector(Fun4AllOutputManager *manager);
   int unregisterSubsystemsNow();
   int setRun(const int runnumber);
+  void FillPerformanceSummary(PHCompositeNode *runNode);
+  void WritePerformanceSummaryJson(PHCompositeNode *runNode) const;
+  //! write the run node and close the current file of an output manager
+  void CloseOutputFile(Fun4AllOutputManager *manager);
+  int WriteCheckpoint();
+  int RestoreCheckpoint();
+  //! bit of an event class, assigned on first use, -1 if there are too many classes
+  int EventClassBit(const std::string &eventclass);
   static Fun4AllServer *__instance;
   TH1 *FrameWorkVars{nullptr};
   Fun4AllMemoryTracker *ffamemtracker{nullptr};
@@ -132,6 +259,7 @@ class Fun4AllServer : public Fun4AllBase
   PHTimeStamp *beginruntimestamp{nullptr};
   PHCompositeNode *TopNode{nullptr};
   Fun4AllSyncManager *defaultSyncManager{nullptr};
+  PHThreadPool *m_ThreadPool{nullptr};
 
   int OutNodeCount{0};
   int bortime_override{0};
@@ -141,12 +269,49 @@ class Fun4AllServer : public Fun4AllBase
   int eventnumber{0};
   int eventcounter{0};
   int keep_db_connected{0};
+  int m_ModuleProfilingFlag{0};
+  unsigned int m_NodeTrimEvents{0};
+  unsigned int m_NodeResetCount{0};
+  double m_NodeTrimRSSLimit{0};  // MB
+  std::string m_TraceFileName;
+  int m_PerformanceSummaryFlag{0};
+  std::string m_PerformanceSummaryJson;
+  int m_ProfileFirstEvent{0};
+  int m_ProfileLastEvent{0};
+  std::string m_ProfileFileName;
+  std::string m_CheckpointFileName;
+  unsigned int m_CheckpointEvents{0};
+  long m_JobEventCounter{0};      // events read in the job, not reset for new runs
+  std::string m_ResumeCheckpoint;  // restored after the InitRun of the first event
+  int m_ResumeEventCounter{0};
+  std::set<Fun4AllOutputManager *> m_OpenOutputFiles;  // written to since their file was closed
+  PHTimer m_InputTimer{"Fun4AllServer_input"};
+  PHTimer m_OutputTimer{"Fun4AllServer_output"};
+  PHTimer m_StartupTimer{"Fun4AllServer_startup"};  // creation to first event
+  PHTimer m_EventTimer{"Fun4AllServer_event"};      // all modules of an event
+  double m_TimeToFirstEvent{0};  // ms
+  unsigned int m_NFilters{0};  // the filters are the first entries of Subsystems
+  uint64_t m_EventClasses{0};  // classes of the current event
+  std::map<std::string, int> m_EventClassBits;
+  std::vector<long> m_EventClassCounts;  // events tagged per class bit
+  std::map<std::string, uint64_t> m_RequiredEventClasses;  // by module name
+
+  std::vector<std::pair<std::string, double>> m_StartupTimes;  // library loads, Init, InitRun (ms)
 
   std::vector<std::string> ComplaintList;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> Subsystems;
   std::vector<std::pair<SubsysReco *, PHCompositeNode *>> DeleteSubsystems;
   std::deque<std::pair<SubsysReco *, std::string>> NewSubsystems;
   std::vector<int> RetCodes;
+  std::vector<PHTimer *> SubsystemTimers;        // parallel to Subsystems
+  std::vector<std::string> SubsystemTDirNames;  // parallel to Subsystems
+  std::vector<ModuleProfile> SubsystemProfiles;  // parallel to Subsystems
+  std::vector<std::vector<unsigned int>> SubsystemTimeHistos;  // parallel to Subsystems, for PerformanceSummary
+  std::vector<unsigned int> m_EventTimeHisto;                   // time of all modules per event, same binning
+  std::vector<uint64_t> SubsystemEventClasses;  // parallel to Subsystems, required classes (0 = all events)
+  std::vector<long> SubsystemSkipCounts;        // parallel to Subsystems, events skipped for the classes
+  std::vector<FilterStat> m_FilterStats;         // parallel to the first m_NFilters Subsystems
+  std::map<std::string, long> m_NodeSizes;
   std::vector<Fun4AllOutputManager *> OutputManager;
   std::vector<TDirectory *> TDirCollection;
   std::vector<Fun4AllHistoManager *> HistoManager;
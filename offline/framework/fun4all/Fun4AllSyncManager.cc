@@ -6,11 +6,16 @@
 
 #include <ffaobjects/SyncObject.h>
 
+#include <phool/PHThreadPool.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <TROOT.h>  // for ROOT::EnableThreadSafety
 #include <TSystem.h>
 
+#include <algorithm>
+
 #include <cstdlib>
+#include <iomanip>
 #include <iostream>  // for operator<<, endl, basic_ostream
 #include <list>      // for list<>::const_iterator, _List_con...
 #include <string>
@@ -55,6 +60,9 @@ int Fun4AllSyncManager::registerInputManager(Fun4AllInputManager *InputManager)
   }
   m_InManager.push_back(InputManager);
   m_iretInManager.push_back(0);
+  m_ReadTimer.emplace_back(InputManager->Name());
+  m_ReadTimeMax.push_back(0);
+  m_ConcurrentReadCount.push_back(0);
   InputManager->setSyncManager(this);
   return 0;
 }
@@ -94,9 +102,16 @@ int Fun4AllSyncManager::run(const int nevnts)
     unsigned iman = 0;
     int ifirst = 0;
     int hassync = 0;
+    if (m_ConcurrentReads)
+    {
+      ReadInputManagers();
+    }
     for (auto &iter : m_InManager)
     {
-      m_iretInManager[iman] = iter->run(1);
+      if (!m_ConcurrentReads)
+      {
+        m_iretInManager[iman] = ReadInputManager(iman);
+      }
       iret += m_iretInManager[iman];
       // one can run DSTs without sync object via the DST input manager
       // this only poses a problem if one runs two of them and expects the syncing to work
@@ -221,6 +236,18 @@ int Fun4AllSyncManager::run(const int nevnts)
         {
           m_InManager[nman]->NoSyncPushBackEvents(1);
         }
+        // the input managers after the one out of sync were read already with
+        // concurrent reads, they are read again in the next pass
+        if (m_ConcurrentReads)
+        {
+          for (unsigned nman = iman + 1; nman < m_InManager.size(); nman++)
+          {
+            if (m_iretInManager[nman] == Fun4AllReturnCodes::EVENT_OK)
+            {
+              m_InManager[nman]->PushBackEvents(1);
+            }
+          }
+        }
         continue;
       }
     }
@@ -421,6 +448,10 @@ void Fun4AllSyncManager::Print(const std::string &what) const
     }
     std::cout << std::endl;
   }
+  if (what == "ALL" || what == "LATENCY")
+  {
+    PrintReadLatency();
+  }
   return;
 }
 
@@ -431,6 +462,89 @@ int Fun4AllSyncManager::CheckSync(const unsigned i)
   return iret;
 }
 
+void Fun4AllSyncManager::ConcurrentReads(const bool b)
+{
+  if (b)
+  {
+    // reading ROOT files on several threads needs ROOT's global locks and per thread gDirectory
+    ROOT::EnableThreadSafety();
+  }
+  m_ConcurrentReads = b;
+}
+
+int Fun4AllSyncManager::ReadInputManager(const unsigned i)
+{
+  PHTimer &timer = m_ReadTimer[i];
+  timer.restart();
+  int iret = m_InManager[i]->run(1);
+  timer.stop();
+  m_ReadTimeMax[i] = std::max(m_ReadTimeMax[i], timer.elapsed());
+  return iret;
+}
+
+void Fun4AllSyncManager::ReadInputManagers()
+{
+  m_ReadPassTimer.restart();
+  // reads which open a file or change the node tree are done first, one by one
+  std::vector<unsigned> concurrent;
+  for (unsigned i = 0; i < m_InManager.size(); ++i)
+  {
+    if (m_InManager[i]->ConcurrentReadOk())
+    {
+      concurrent.push_back(i);
+    }
+    else
+    {
+      m_iretInManager[i] = ReadInputManager(i);
+    }
+  }
+  if (concurrent.size() > 1)
+  {
+    Fun4AllServer::instance()->ThreadPool()->parallel_for(concurrent.size(), [this, &concurrent](size_t j)
+                                                          { m_iretInManager[concurrent[j]] = ReadInputManager(concurrent[j]); });
+    for (unsigned i : concurrent)
+    {
+      m_ConcurrentReadCount[i]++;
+    }
+  }
+  else if (!concurrent.empty())
+  {
+    m_iretInManager[concurrent.front()] = ReadInputManager(concurrent.front());
+  }
+  m_ReadPassTimer.stop();
+  return;
+}
+
+void Fun4AllSyncManager::PrintReadLatency() const
+{
+  std::cout << "--------------------------------------" << std::endl
+            << std::endl;
+  std::cout << "Read time of InputManagers in Fun4AllSyncManager " << Name();
+  if (m_ConcurrentReads)
+  {
+    std::cout << " (concurrent reads)";
+  }
+  std::cout << ":" << std::endl;
+  for (unsigned i = 0; i < m_InManager.size(); ++i)
+  {
+    const PHTimer &timer = m_ReadTimer[i];
+    const unsigned int ncycle = timer.get_ncycle();
+    std::cout << std::setw(30) << std::left << m_InManager[i]->Name() << std::right
+              << " reads: " << std::setw(8) << ncycle
+              << " concurrent: " << std::setw(8) << m_ConcurrentReadCount[i]
+              << " total (ms): " << std::setw(10) << timer.get_accumulated_time()
+              << " mean (ms): " << std::setw(8) << (ncycle ? timer.get_time_per_cycle() : 0.)
+              << " max (ms): " << std::setw(8) << m_ReadTimeMax[i] << std::endl;
+  }
+  if (m_ReadPassTimer.get_ncycle())
+  {
+    // with concurrent reads an event waits only for the slowest input manager
+    std::cout << "all InputManagers, mean per event (ms): " << m_ReadPassTimer.get_time_per_cycle() << std::endl;
+  }
+  std::cout << std::endl;
+  return;
+}
+
 void Fun4AllSyncManager::GetInputFullFileList(std::vector<std::string> &fnames) const
 {
   for (Fun4AllInputManager *InMan : m_InManager)
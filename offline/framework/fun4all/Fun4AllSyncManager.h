@@ -9,6 +9,8 @@
 
 #include "Fun4AllBase.h"
 
+#include <phool/PHTimer.h>
+
 #include <string>  // for string
 #include <vector>
 
@@ -55,10 +57,19 @@ class Fun4AllSyncManager : public Fun4AllBase
   const std::vector<Fun4AllInputManager *> GetInputManagers() const { return m_InManager; }
   bool MixRunsOk() const { return m_MixRunsOkFlag; }
   void MixRunsOk(bool b) { m_MixRunsOkFlag = b; }
+  //! read the next event of all input managers at the same time on the threads of
+  //! Fun4AllServer::ThreadPool() and check the sync afterwards. Only input managers which
+  //! read from an open file without changing the node tree (ConcurrentReadOk) are read
+  //! concurrently, the others (new file, first event of a file, local SubsysRecos) one by one
+  void ConcurrentReads(const bool b);
+  bool ConcurrentReads() const { return m_ConcurrentReads; }
 
  private:
   void PrintSyncProblem() const;
   int CheckSync(unsigned i);
+  int ReadInputManager(const unsigned i);
+  void ReadInputManagers();
+  void PrintReadLatency() const;
   int m_PrdfSegment = 0;
   int m_PrdfEvents = 0;
   int m_EventsTotal = 0;
@@ -66,9 +77,15 @@ class Fun4AllSyncManager : public Fun4AllBase
   int m_CurrentEvent = 0;
   int m_Repeat = 0;
   bool m_MixRunsOkFlag = false;
+  bool m_ConcurrentReads = false;
   SyncObject *m_MasterSync = nullptr;
   std::vector<Fun4AllInputManager *> m_InManager;
   std::vector<int> m_iretInManager;
+  // read time of each input manager and of all reads of an event
+  std::vector<PHTimer> m_ReadTimer;
+  std::vector<double> m_ReadTimeMax;
+  std::vector<unsigned int> m_ConcurrentReadCount;
+  PHTimer m_ReadPassTimer{"ReadPass"};
 };
 
 #endif
@@ -1,11 +1,15 @@
 #include "InputFileHandler.h"
 
+#include <frog/FROG.h>
+
 #include <phool/phool.h>
 
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <iterator>  // for next
+#include <vector>
 
 int InputFileHandler::AddFile(const std::string &filename)
 {
@@ -95,12 +99,33 @@ int InputFileHandler::OpenNextFile()
     }
     else
     {
+      if (m_PrefetchNextFile && std::next(iter) != m_FileList.end())
+      {
+        FROG frog;
+        frog.prefetch(*std::next(iter));
+      }
       return 1;
     }
   }
   return 0;
 }
 
+std::string InputFileHandler::NextFileName() const
+{
+  if (m_FileList.size() < 2)
+  {
+    return "";
+  }
+  return *std::next(m_FileList.begin());
+}
+
+int InputFileHandler::ResolveFileLocations()
+{
+  FROG frog;
+  frog.Verbosity(GetVerbosity());
+  return frog.locate(std::vector<std::string>(m_FileList.begin(), m_FileList.end()));
+}
+
 void InputFileHandler::Print(const std::string & /* what */) const
 {
   std::cout << "file list: " << std::endl;
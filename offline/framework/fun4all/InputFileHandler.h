@@ -24,11 +24,23 @@ class InputFileHandler
   void UpdateFileList();
   void FileName(const std::string &fn) { m_FileName = fn; }
   const std::string FileName() const { return m_FileName; }
+  //! resolve the locations of all files in the list at once (one file catalog query)
+  int ResolveFileLocations();
+  //! look up the location of the next file in the background while the current one is read
+  void PrefetchNextFileLocation(const bool b = true) { m_PrefetchNextFile = b; }
+  //! open and set up the next file of the list on a background thread while the current one is read
+  //! (supported by the DST and PRDF input managers)
+  void OpenNextFileInBackground(const bool b) { m_OpenNextFileInBackground = b; }
+  bool OpenNextFileInBackground() const { return m_OpenNextFileInBackground; }
+  //! the file which is opened after the current one, empty if there is none
+  std::string NextFileName() const;
 
  private:
   int m_IsOpen = 0;
   int m_Repeat = 0;
   int m_Verbosity = 0;
+  bool m_PrefetchNextFile = false;
+  bool m_OpenNextFileInBackground = false;
   std::string m_FileName;
   std::list<std::string> m_FileList;
   std::list<std::string> m_FileListCopy;
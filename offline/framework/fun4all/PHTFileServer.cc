@@ -29,7 +29,7 @@ PHTFileServer::~PHTFileServer()
 }
 
 //_________________________________________________
-void PHTFileServer::open(const std::string& filename, const std::string& type)
+void PHTFileServer::open(const std::string& filename, const std::string& type, const int compress)
 {
   SafeTFile::TFileMap::iterator iter(SafeTFile::file_map().find(filename));
   if (iter != SafeTFile::file_map().end())
@@ -49,7 +49,7 @@ void PHTFileServer::open(const std::string& filename, const std::string& type)
     std::cout << (what.str()) << std::endl;
 
     // create new SafeTFile; insert in map; change TDirectory
-    SafeTFile* file(new SafeTFile(filename, type));
+    SafeTFile* file(new SafeTFile(filename, type, compress));
     if (!file->IsOpen())
     {
       std::cout << ("PHTFileServer::open - error opening TFile") << std::endl;
@@ -40,9 +40,12 @@ class PHTFileServer
 
   /*! \brief
     open a SafeTFile. If filename is not found in the map, create a new TFile
-    and append to the map; increment counter otherwise
+    and append to the map; increment counter otherwise.
+    compress is the compression setting of a new TFile (e.g. 505 for ZSTD level 5),
+    it is ignored if the file is already opened
   */
-  void open(const std::string& filename, const std::string& type = "RECREATE");
+  void open(const std::string& filename, const std::string& type = "RECREATE",
+            const int compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault);
 
   //! flush TFile matching filename
   bool flush(const std::string& filename);
@@ -70,8 +73,9 @@ class PHTFileServer
   {
    public:
     //! constructor
-    SafeTFile(const std::string& filename, const std::string& type = "RECREATE")
-      : TFile(filename.c_str(), type.c_str())
+    SafeTFile(const std::string& filename, const std::string& type = "RECREATE",
+              const int compress = ROOT::RCompressionSetting::EDefaults::kUseCompiledDefault)
+      : TFile(filename.c_str(), type.c_str(), "", compress)
       , _filename(filename)
       , _counter(1)
     {
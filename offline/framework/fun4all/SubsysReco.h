@@ -8,6 +8,7 @@
 #include <string>
 
 class PHCompositeNode;
+class TDirectory;
 
 /** Base class for all reconstruction and analysis modules to be
  *  used under the Fun4All framework.
@@ -58,6 +59,18 @@ class SubsysReco : public Fun4AllBase
   /// Clean up after each event.
   virtual int ResetEvent(PHCompositeNode * /*topNode*/) { return 0; }
 
+  /** Called when the Fun4AllServer writes a checkpoint (see Fun4AllServer::EnableCheckpoint).
+      Modules with state which is not rebuilt from the events (accumulated
+      sums, random generators, positions in their own output files) write
+      it to dir. A non zero return code means the checkpoint is not usable.
+   */
+  virtual int SaveCheckpoint(TDirectory * /*dir*/) { return 0; }
+
+  /** Called when resuming from a checkpoint, after the InitRun of the
+      first event. Reads back what SaveCheckpoint() wrote to dir.
+   */
+  virtual int RestoreCheckpoint(TDirectory * /*dir*/) { return 0; }
+
   void Print(const std::string & /*what*/ = "ALL") const override {}
 
  protected:
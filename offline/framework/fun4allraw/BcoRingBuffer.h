@@ -0,0 +1,330 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_BCORINGBUFFER_H
+#define FUN4ALLRAW_BCORINGBUFFER_H
+
+/*!
+ * \file BcoRingBuffer.h
+ * \brief BCO ordered buffer of raw hits, drop-in replacement for std::map<uint64_t, T>
+ * \detail
+ * streaming inputs fill their hit buffers with (mostly) increasing BCOs and drain them
+ * from the lowest BCO. The entries are kept sorted in a circular array, so that appending
+ * a new BCO and removing the first one are O(1) without a heap allocation per BCO, and
+ * lookups are a binary search on contiguous memory. Out of order BCOs are inserted at
+ * their sorted position, which costs a shift of the entries that follow.
+ * Slots are recycled and their payload is cleared rather than destroyed, so the hit
+ * vectors keep their capacity from one BCO to the next.
+ *
+ * Unlike std::map, iterators and references are invalidated by insertions and erasures.
+ * The key of an entry must not be modified.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class T>
+class BcoRingBuffer
+{
+ public:
+  using key_type = uint64_t;
+  using mapped_type = T;
+  using value_type = std::pair<uint64_t, T>;
+  using size_type = size_t;
+
+  /// random access iterator over the entries, in increasing BCO order
+  template <bool IsConst>
+  class Iterator
+  {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename BcoRingBuffer::value_type;
+    using difference_type = std::ptrdiff_t;
+    using container_type = std::conditional_t<IsConst, const BcoRingBuffer, BcoRingBuffer>;
+    using reference = std::conditional_t<IsConst, const value_type &, value_type &>;
+    using pointer = std::conditional_t<IsConst, const value_type *, value_type *>;
+
+    Iterator() = default;
+    Iterator(container_type *buffer, size_t index)
+      : m_buffer(buffer)
+      , m_index(index)
+    {
+    }
+
+    /// conversion from non const to const iterator
+    template <bool C = IsConst, class = std::enable_if_t<C>>
+    Iterator(const Iterator<false> &other)
+      : m_buffer(other.m_buffer)
+      , m_index(other.m_index)
+    {
+    }
+
+    reference operator*() const { return m_buffer->slot(m_index); }
+    pointer operator->() const { return &m_buffer->slot(m_index); }
+    reference operator[](difference_type n) const { return m_buffer->slot(m_index + n); }
+
+    Iterator &operator++()
+    {
+      ++m_index;
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      Iterator out(*this);
+      ++m_index;
+      return out;
+    }
+    Iterator &operator--()
+    {
+      --m_index;
+      return *this;
+    }
+    Iterator operator--(int)
+    {
+      Iterator out(*this);
+      --m_index;
+      return out;
+    }
+    Iterator &operator+=(difference_type n)
+    {
+      m_index += n;
+      return *this;
+    }
+    Iterator &operator-=(difference_type n)
+    {
+      m_index -= n;
+      return *this;
+    }
+    Iterator operator+(difference_type n) const { return Iterator(m_buffer, m_index + n); }
+    Iterator operator-(difference_type n) const { return Iterator(m_buffer, m_index - n); }
+    friend Iterator operator+(difference_type n, const Iterator &iter) { return iter + n; }
+    difference_type operator-(const Iterator &other) const { return static_cast<difference_type>(m_index) - static_cast<difference_type>(other.m_index); }
+
+    bool operator==(const Iterator &other) const { return m_index == other.m_index; }
+    bool operator!=(const Iterator &other) const { return m_index != other.m_index; }
+    bool operator<(const Iterator &other) const { return m_index < other.m_index; }
+    bool operator>(const Iterator &other) const { return m_index > other.m_index; }
+    bool operator<=(const Iterator &other) const { return m_index <= other.m_index; }
+    bool operator>=(const Iterator &other) const { return m_index >= other.m_index; }
+
+    /// position of the entry, counted from the lowest BCO
+    size_t index() const { return m_index; }
+
+   private:
+    friend class BcoRingBuffer;
+    friend class Iterator<!IsConst>;
+    container_type *m_buffer{nullptr};
+    size_t m_index{0};
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reverse_iterator = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  ///@name iterators
+  //@{
+  iterator begin() { return iterator(this, 0); }
+  iterator end() { return iterator(this, m_size); }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, m_size); }
+  reverse_iterator rbegin() { return reverse_iterator(end()); }
+  reverse_iterator rend() { return reverse_iterator(begin()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+  //@}
+
+  bool empty() const { return m_size == 0; }
+  size_t size() const { return m_size; }
+
+  /// number of allocated slots
+  size_t capacity() const { return m_slots.size(); }
+
+  /// remove all entries. Allocated slots are kept
+  void clear()
+  {
+    m_head = 0;
+    m_size = 0;
+  }
+
+  /// entry for a given BCO, created if not found
+  T &operator[](const uint64_t bco)
+  {
+    // common case: the BCO is not lower than the last one
+    if (m_size > 0 && slot(m_size - 1).first == bco)
+    {
+      return slot(m_size - 1).second;
+    }
+
+    if (m_size == 0 || slot(m_size - 1).first < bco)
+    {
+      return append(bco).second;
+    }
+
+    auto iter = lower_bound(bco);
+    if (iter->first == bco)
+    {
+      return iter->second;
+    }
+
+    // out of order BCO: append and rotate to the sorted position
+    const size_t index = iter.m_index;
+    append(bco);
+    for (size_t i = m_size - 1; i > index; --i)
+    {
+      std::swap(slot(i), slot(i - 1));
+    }
+    return slot(index).second;
+  }
+
+  ///@name lookup
+  //@{
+  iterator find(const uint64_t bco)
+  {
+    auto iter = lower_bound(bco);
+    return (iter != end() && iter->first == bco) ? iter : end();
+  }
+
+  const_iterator find(const uint64_t bco) const
+  {
+    auto iter = lower_bound(bco);
+    return (iter != end() && iter->first == bco) ? iter : end();
+  }
+
+  size_t count(const uint64_t bco) const { return find(bco) == end() ? 0 : 1; }
+
+  /// first entry with BCO >= bco
+  iterator lower_bound(const uint64_t bco)
+  {
+    return std::lower_bound(begin(), end(), bco, [](const value_type &entry, uint64_t value)
+                            { return entry.first < value; });
+  }
+
+  const_iterator lower_bound(const uint64_t bco) const
+  {
+    return std::lower_bound(begin(), end(), bco, [](const value_type &entry, uint64_t value)
+                            { return entry.first < value; });
+  }
+
+  /// first entry with BCO > bco
+  iterator upper_bound(const uint64_t bco)
+  {
+    return std::upper_bound(begin(), end(), bco, [](uint64_t value, const value_type &entry)
+                            { return value < entry.first; });
+  }
+
+  const_iterator upper_bound(const uint64_t bco) const
+  {
+    return std::upper_bound(begin(), end(), bco, [](uint64_t value, const value_type &entry)
+                            { return value < entry.first; });
+  }
+  //@}
+
+  ///@name erasure
+  //@{
+  /// erase one entry, returns an iterator to the next one. O(1) for the first entry
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+
+  /// erase a range of entries, returns an iterator to the entry following the range
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    const size_t ifirst = first.m_index;
+    const size_t n = last.m_index - ifirst;
+    if (n == 0)
+    {
+      return iterator(this, ifirst);
+    }
+
+    if (ifirst == 0)
+    {
+      // drain from the front, the most common case
+      m_head = (m_head + n) & mask();
+    }
+    else
+    {
+      // move the erased slots past the end, so they are recycled
+      for (size_t i = ifirst; i + n < m_size; ++i)
+      {
+        std::swap(slot(i), slot(i + n));
+      }
+    }
+    m_size -= n;
+    if (m_size == 0)
+    {
+      m_head = 0;
+    }
+    return iterator(this, ifirst);
+  }
+
+  /// erase entry with a given BCO, returns the number of erased entries
+  size_t erase(const uint64_t bco)
+  {
+    auto iter = find(bco);
+    if (iter == end())
+    {
+      return 0;
+    }
+    erase(iter);
+    return 1;
+  }
+  //@}
+
+ private:
+  value_type &slot(size_t index) { return m_slots[(m_head + index) & mask()]; }
+  const value_type &slot(size_t index) const { return m_slots[(m_head + index) & mask()]; }
+
+  size_t mask() const { return m_slots.size() - 1; }
+
+  /// add an entry at the end, recycling the slot
+  value_type &append(const uint64_t bco)
+  {
+    if (m_size == m_slots.size())
+    {
+      grow();
+    }
+    auto &entry = slot(m_size++);
+    entry.first = bco;
+    reset(entry.second, 0);
+    return entry;
+  }
+
+  /// double the number of slots, keeping the order of entries
+  void grow()
+  {
+    std::vector<value_type> slots(std::max<size_t>(2 * m_slots.size(), 16));
+    for (size_t i = 0; i < m_slots.size(); ++i)
+    {
+      std::swap(slots[i], slot(i));
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+  }
+
+  /// clear a recycled payload. Uses T::clear() if available, to keep allocated memory
+  template <class U>
+  static auto reset(U &value, int) -> decltype(value.clear(), void())
+  {
+    value.clear();
+  }
+
+  template <class U>
+  static void reset(U &value, long)
+  {
+    value = U();
+  }
+
+  /// storage, size is a power of two
+  std::vector<value_type> m_slots;
+
+  /// slot of the first entry
+  size_t m_head{0};
+
+  /// number of entries
+  size_t m_size{0};
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include "Fun4AllPrdfInputManager.h"
 
+#include "PrdfBackgroundOpener.h"
+
 #include <fun4all/Fun4AllInputManager.h>  // for Fun4AllInputManager
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/Fun4AllServer.h>
@@ -49,6 +51,7 @@ Fun4AllPrdfInputManager::Fun4AllPrdfInputManager(const std::string &name, const
 
 Fun4AllPrdfInputManager::~Fun4AllPrdfInputManager()
 {
+  delete m_NextFile;
   if (IsOpen())
   {
     fileclose();
@@ -66,14 +69,29 @@ int Fun4AllPrdfInputManager::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  std::string fname = frog.location(FileName());
+  // file opened on a background thread while the previous one was read
+  BackgroundFileOpener<Eventiterator>::Result prepared;
+  if (m_NextFile)
+  {
+    prepared = m_NextFile->take(FileName());
+  }
   if (Verbosity() > 0)
   {
-    std::cout << Name() << ": opening file " << FileName() << std::endl;
+    std::cout << Name() << ": opening file " << FileName()
+              << (prepared.second ? " (opened in background)" : "") << std::endl;
   }
+  std::string fname = prepared.first;
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (prepared.second)
+  {
+    m_EventIterator = prepared.second.release();
+  }
+  else
+  {
+    FROG frog;
+    fname = frog.location(FileName());
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   m_EventsThisFile = 0;
   if (status)
   {
@@ -86,6 +104,10 @@ int Fun4AllPrdfInputManager::fileopen(const std::string &filenam)
   m_Segment = runseg.second;
   IsOpen(1);
   AddToFileOpened(fname);  // add file to the list of files which were opened
+  if (OpenNextFileInBackground())
+  {
+    OpenPrdfInBackground(m_NextFile, NextFileName());
+  }
   return 0;
 }
 
@@ -8,6 +8,8 @@
 #include <string>
 
 class Event;
+template <typename T>
+class BackgroundFileOpener;
 class Eventiterator;
 class PHCompositeNode;
 class SyncObject;
@@ -39,6 +41,7 @@ class Fun4AllPrdfInputManager : public Fun4AllInputManager
   Event *m_Event = nullptr;
   Event *m_SaveEvent = nullptr;
   Eventiterator *m_EventIterator = nullptr;
+  BackgroundFileOpener<Eventiterator> *m_NextFile = nullptr;
   SyncObject *m_SyncObject = nullptr;
   std::string m_PrdfNodeName;
 };
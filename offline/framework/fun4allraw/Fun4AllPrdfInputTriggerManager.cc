@@ -397,10 +397,23 @@ std::string Fun4AllPrdfInputTriggerManager::GetString(const std::string &what) c
   return "";
 }
 
+void Fun4AllPrdfInputTriggerManager::ReadAhead(const unsigned int depth)
+{
+  m_ReadAheadDepth = depth;
+  for (auto *iter : m_TriggerInputVector)
+  {
+    iter->ReadAhead(depth);
+  }
+}
+
 void Fun4AllPrdfInputTriggerManager::registerTriggerInput(SingleTriggerInput *prdfin, InputManagerType::enu_subsystem system)
 {
   prdfin->CreateDSTNode(m_topNode);
   prdfin->TriggerInputManager(this);
+  if (m_ReadAheadDepth > 0)
+  {
+    prdfin->ReadAhead(m_ReadAheadDepth);
+  }
   switch (system)
   {
   case InputManagerType::GL1:
@@ -77,6 +77,9 @@ class Fun4AllPrdfInputTriggerManager : public Fun4AllInputManager
     m_InitialPoolDepth = n;
     m_PoolDepth = n;
   }
+  //! read and decode the calorimeter inputs ahead in their own threads,
+  //! up to depth events each (0 = off, read on the main thread)
+  void ReadAhead(const unsigned int depth);
   void DetermineReferenceEventNumber();
   void ClockDiffFill();
   int ClockDiffCheck();
@@ -126,6 +129,7 @@ class Fun4AllPrdfInputTriggerManager : public Fun4AllInputManager
   unsigned int m_InitialPoolDepth = 10;
   unsigned int m_DefaultPoolDepth = 10;
   unsigned int m_PoolDepth{m_InitialPoolDepth};
+  unsigned int m_ReadAheadDepth{0};
   std::set<int> m_Gl1DroppedEvent;
   std::vector<SingleTriggerInput *> m_TriggerInputVector;
   std::vector<SingleTriggerInput *> m_NoGl1InputVector;
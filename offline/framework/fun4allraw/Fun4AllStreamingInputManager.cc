@@ -33,6 +33,7 @@
 #include <frog/FROG.h>
 
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 #include <boost/format.hpp>
@@ -45,7 +46,34 @@
 #include <cstdint>  // for uint64_t, uint16_t
 #include <cstdlib>
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <set>
+#include <tuple>
 #include <utility>   // for pair
+#include <vector>
+
+namespace
+{
+  //! raw hits added by one input during a concurrent FillPool, handed to the manager afterwards
+  struct StagedRawHits
+  {
+    std::vector<std::pair<uint64_t, InttRawHit *>> intt;
+    std::vector<std::pair<uint64_t, MvtxRawHit *>> mvtx;
+    std::vector<std::tuple<uint64_t, uint16_t, uint32_t>> mvtx_feeid;
+    std::vector<std::pair<uint64_t, uint64_t>> mvtx_l1trg;
+    std::vector<std::pair<uint64_t, TpcRawHit *>> tpc;
+  };
+
+  //! staging buffer of the input decoded by this thread, null outside of a concurrent FillPool
+  thread_local StagedRawHits *t_staged_hits = nullptr;
+
+  //! true if one of the (sorted) bcos is less than 1 strobe length of 120 crossings from refbco
+  bool within_strobe(const std::set<uint64_t> &bcos, const uint64_t refbco)
+  {
+    const uint64_t strobe = 120;
+    auto iter = bcos.lower_bound(refbco < strobe ? 0 : refbco - strobe + 1);
+    return iter != bcos.end() && *iter < refbco + strobe;
+  }
+}  // namespace
 
 Fun4AllStreamingInputManager::Fun4AllStreamingInputManager(const std::string &name, const std::string &dstnodename, const std::string &topnodename)
   : Fun4AllInputManager(name, dstnodename, topnodename)
@@ -494,6 +522,11 @@ void Fun4AllStreamingInputManager::AddGl1RawHit(uint64_t bclk, Gl1Packet *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 {
+  if (t_staged_hits)
+  {
+    t_staged_hits->mvtx.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx hit to bclk 0x"
@@ -504,6 +537,11 @@ void Fun4AllStreamingInputManager::AddMvtxRawHit(uint64_t bclk, MvtxRawHit *hit)
 
 void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feeid, uint32_t detField)
 {
+  if (t_staged_hits)
+  {
+    t_staged_hits->mvtx_feeid.emplace_back(bclk, feeid, detField);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx feeid info to bclk 0x"
@@ -518,6 +556,11 @@ void Fun4AllStreamingInputManager::AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feei
 
 void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco)
 {
+  if (t_staged_hits)
+  {
+    t_staged_hits->mvtx_l1trg.emplace_back(bclk, lv1Bco);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding mvtx L1Trg to bclk 0x"
@@ -528,13 +571,36 @@ void Fun4AllStreamingInputManager::AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bc
 
 void Fun4AllStreamingInputManager::AddInttRawHit(uint64_t bclk, InttRawHit *hit)
 {
+  if (t_staged_hits)
+  {
+    t_staged_hits->intt.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding intt hit to bclk 0x"
               << std::hex << bclk << std::dec << std::endl;
   }
   m_InttRawHitMap[bclk].InttRawHitVector.push_back(hit);
-  m_InttPacketFeeBcoMap[hit->get_packetid()][hit->get_fee()] = bclk;
+}
+
+void Fun4AllStreamingInputManager::AddInttRawHits(uint64_t bclk, const std::vector<InttRawHit *> &hits)
+{
+  if (t_staged_hits)
+  {
+    for (auto hit : hits)
+    {
+      t_staged_hits->intt.emplace_back(bclk, hit);
+    }
+    return;
+  }
+  if (Verbosity() > 1)
+  {
+    std::cout << "Adding " << hits.size() << " intt hits to bclk 0x"
+              << std::hex << bclk << std::dec << std::endl;
+  }
+  std::vector<InttRawHit *> &hitvector = m_InttRawHitMap[bclk].InttRawHitVector;
+  hitvector.insert(hitvector.end(), hits.begin(), hits.end());
 }
 
 void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, MicromegasRawHit *hit)
@@ -549,6 +615,11 @@ void Fun4AllStreamingInputManager::AddMicromegasRawHit(uint64_t bclk, Micromegas
 
 void Fun4AllStreamingInputManager::AddTpcRawHit(uint64_t bclk, TpcRawHit *hit)
 {
+  if (t_staged_hits)
+  {
+    t_staged_hits->tpc.emplace_back(bclk, hit);
+    return;
+  }
   if (Verbosity() > 1)
   {
     std::cout << "Adding tpc hit to bclk 0x"
@@ -714,47 +785,36 @@ int Fun4AllStreamingInputManager::FillIntt()
   {
     
     // this is on a per packet basis
-    auto bcl_stack = p->BclkStackMap();
-    auto feebclstack = p->getFeeGTML1BCOMap();
+    const auto &bcl_stack = p->BclkStackMap();
+    const auto &feebclstack = p->getFeeGTML1BCOMap();
     int packet_id = bcl_stack.begin()->first;
     int histo_to_fill = (packet_id % 10) - 1;
-  
-    std::set<int> feeidset;
+
+    unsigned int ntaggedfees = 0;
     int fee = 0;
-    for (auto &[feeid, gtmbcoset] : feebclstack)
+    for (const auto &[feeid, gtmbcoset] : feebclstack)
     {
-      for (auto &bcl : gtmbcoset)
+      if (within_strobe(gtmbcoset, m_RefBCO))
       {
-        auto diff = (m_RefBCO > bcl) ? m_RefBCO - bcl : bcl - m_RefBCO;
-        if (diff < 120) { // diff is 1 strobe length of 120 crossings
-          h_gl1taggedfee_intt[histo_to_fill][fee]->Fill(refbcobitshift);
-          feeidset.insert(feeid);
-          // this fee was tagged, go to the next one
-          break;
-        }
+        h_gl1taggedfee_intt[histo_to_fill][fee]->Fill(refbcobitshift);
+        ntaggedfees++;
       }
       fee++;
     }
-    
-    if (feeidset.size() == 14)
+
+    if (ntaggedfees == 14)
     {
       allpacketsallfees++;
       h_taggedAllFees_intt[histo_to_fill]->Fill(refbcobitshift);
     }
-    feeidset.clear();
     bool thispacket = false;
-        
-    for (auto &[packetid, gtmbcoset] : bcl_stack)
+
+    for (const auto &[packetid, gtmbcoset] : bcl_stack)
     {
-      for (auto &gtmbco : gtmbcoset)
+      if (within_strobe(gtmbcoset, m_RefBCO))
       {
-        auto diff = (m_RefBCO > gtmbco) ? m_RefBCO - gtmbco : gtmbco - m_RefBCO;
-        if (diff < 120)  //diff is 1 strobe length of 120 crossings
-        {
-          thispacket = true;
-          h_gl1tagged_intt[histo_to_fill]->Fill(refbcobitshift);
-          break;
-        }
+        thispacket = true;
+        h_gl1tagged_intt[histo_to_fill]->Fill(refbcobitshift);
       }
     }
     
@@ -1320,13 +1380,17 @@ int Fun4AllStreamingInputManager::FillInttPool()
   {
     ref_bco_minus_range = m_RefBCO - m_intt_negative_bco;
   }
+  const bool decoded = FillPoolsConcurrently(m_InttInputVector, ref_bco_minus_range);
   for (auto iter : m_InttInputVector)
   {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillInttPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!decoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     // iter->FillPool();
     if (m_RunNumber == 0)
     {
@@ -1363,13 +1427,17 @@ int Fun4AllStreamingInputManager::FillTpcPool()
     ref_bco_minus_range = m_RefBCO - m_tpc_negative_bco;
   }
 
+  const bool decoded = FillPoolsConcurrently(m_TpcInputVector, ref_bco_minus_range);
   for (auto iter : m_TpcInputVector)
   {
     if (Verbosity() > 0)
     {
       std::cout << "Fun4AllStreamingInputManager::FillTpcPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!decoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -1436,13 +1504,17 @@ int Fun4AllStreamingInputManager::FillMicromegasPool()
 int Fun4AllStreamingInputManager::FillMvtxPool()
 {
   uint64_t ref_bco_minus_range = m_RefBCO < m_mvtx_bco_range ? 0 : m_RefBCO - m_mvtx_bco_range;
+  const bool decoded = FillPoolsConcurrently(m_MvtxInputVector, ref_bco_minus_range);
   for (auto iter : m_MvtxInputVector)
   {
     if (Verbosity() > 3)
     {
       std::cout << "Fun4AllStreamingInputManager::FillMvtxPool - fill pool for " << iter->Name() << std::endl;
     }
-    iter->FillPool(ref_bco_minus_range);
+    if (!decoded)
+    {
+      iter->FillPool(ref_bco_minus_range);
+    }
     if (m_RunNumber == 0)
     {
       m_RunNumber = iter->RunNumber();
@@ -1470,6 +1542,63 @@ int Fun4AllStreamingInputManager::FillMvtxPool()
   }
   return 0;
 }
+
+bool Fun4AllStreamingInputManager::FillPoolsConcurrently(const std::vector<SingleStreamingInput *> &inputs, const uint64_t minBCO)
+{
+  if (m_NumDecodeThreads == 1 || inputs.size() < 2)
+  {
+    return false;
+  }
+  if (!m_ThreadPool)
+  {
+    m_ThreadPool = std::make_unique<PHThreadPool>(m_NumDecodeThreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "Fun4AllStreamingInputManager::FillPoolsConcurrently - decoding with "
+                << m_ThreadPool->size() << " threads" << std::endl;
+    }
+  }
+
+  std::vector<StagedRawHits> staged(inputs.size());
+  m_ThreadPool->parallel_for(inputs.size(), [&](size_t i)
+                             {
+    t_staged_hits = &staged[i];
+    inputs[i]->FillPool(minBCO);
+    t_staged_hits = nullptr; });
+
+  // hand over the hits in input order, as in sequential decoding
+  for (const auto &hits : staged)
+  {
+    // the hits of a bclk are consecutive, they are appended with one lookup
+    for (size_t i = 0; i < hits.intt.size();)
+    {
+      const uint64_t bclk = hits.intt[i].first;
+      std::vector<InttRawHit *> &hitvector = m_InttRawHitMap[bclk].InttRawHitVector;
+      for (; i < hits.intt.size() && hits.intt[i].first == bclk; ++i)
+      {
+        hitvector.push_back(hits.intt[i].second);
+      }
+    }
+    for (const auto &[bclk, hit] : hits.mvtx)
+    {
+      AddMvtxRawHit(bclk, hit);
+    }
+    for (const auto &[bclk, feeid, detField] : hits.mvtx_feeid)
+    {
+      AddMvtxFeeIdInfo(bclk, feeid, detField);
+    }
+    for (const auto &[bclk, lv1Bco] : hits.mvtx_l1trg)
+    {
+      AddMvtxL1TrgBco(bclk, lv1Bco);
+    }
+    for (const auto &[bclk, hit] : hits.tpc)
+    {
+      AddTpcRawHit(bclk, hit);
+    }
+  }
+  return true;
+}
+
 void Fun4AllStreamingInputManager::createQAHistos()
 {
   auto hm = QAHistManagerDef::getHistoManager();
@@ -3,13 +3,16 @@
 #ifndef FUN4ALLRAW_FUN4ALLSTREAMINGINPUTMANAGER_H
 #define FUN4ALLRAW_FUN4ALLSTREAMINGINPUTMANAGER_H
 
+#include "BcoRingBuffer.h"
 #include "InputManagerType.h"
 
 #include <fun4all/Fun4AllInputManager.h>
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 class SingleStreamingInput;
 class Gl1Packet;
@@ -18,6 +21,7 @@ class MicromegasRawHit;
 class MvtxRawHit;
 class MvtxFeeIdInfo;
 class PHCompositeNode;
+class PHThreadPool;
 class SyncObject;
 class TpcRawHit;
 class TH1;
@@ -46,6 +50,8 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   int FillTpc();
   void AddGl1RawHit(uint64_t bclk, Gl1Packet *hit);
   void AddInttRawHit(uint64_t bclk, InttRawHit *hit);
+  //! hits of one bclk, appended with a single lookup of the bclk
+  void AddInttRawHits(uint64_t bclk, const std::vector<InttRawHit *> &hits);
   void AddMicromegasRawHit(uint64_t /* bclk */, MicromegasRawHit * /* hit */);
   void AddMvtxFeeIdInfo(uint64_t bclk, uint16_t feeid, uint32_t detField);
   void AddMvtxL1TrgBco(uint64_t bclk, uint64_t lv1Bco);
@@ -67,6 +73,14 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
 
   void runMvtxTriggered(bool b = true) { m_mvtx_is_triggered = b; }
 
+  //! decode the INTT, MVTX and TPC inputs of each subsystem concurrently on n threads (0: all cores)
+  /**
+   * each SingleStreamingInput reads and decodes its own packets on a worker thread.
+   * Raw hits are handed to the manager in input order once all inputs of the subsystem
+   * are done, so the assembled events are identical to the sequential mode (n = 1, default)
+   */
+  void SetNumDecodeThreads(const unsigned int n) { m_NumDecodeThreads = n; }
+
  private:
   struct MvtxRawHitInfo
   {
@@ -74,34 +88,64 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
     std::vector<MvtxFeeIdInfo *> MvtxFeeIdInfoVector;
     std::vector<MvtxRawHit *> MvtxRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      MvtxL1TrgBco.clear();
+      MvtxFeeIdInfoVector.clear();
+      MvtxRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct Gl1RawHitInfo
   {
     std::vector<Gl1Packet *> Gl1RawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      Gl1RawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct InttRawHitInfo
   {
     std::vector<InttRawHit *> InttRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      InttRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct MicromegasRawHitInfo
   {
     std::vector<MicromegasRawHit *> MicromegasRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      MicromegasRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   struct TpcRawHitInfo
   {
     std::vector<TpcRawHit *> TpcRawHitVector;
     unsigned int EventFoundCounter{0};
+    void clear()
+    {
+      TpcRawHitVector.clear();
+      EventFoundCounter = 0;
+    }
   };
 
   void createQAHistos();
 
+  //! run FillPool(minBCO) for all inputs concurrently. Returns false if sequential decoding is used
+  bool FillPoolsConcurrently(const std::vector<SingleStreamingInput *> &inputs, const uint64_t minBCO);
+
   SyncObject *m_SyncObject{nullptr};
   PHCompositeNode *m_topNode{nullptr};
 
@@ -125,17 +169,19 @@ class Fun4AllStreamingInputManager : public Fun4AllInputManager
   bool m_tpc_registered_flag{false};
   bool m_mvtx_is_triggered{false};
 
+  unsigned int m_NumDecodeThreads{1};
+  std::unique_ptr<PHThreadPool> m_ThreadPool;
+
   std::vector<SingleStreamingInput *> m_Gl1InputVector;
   std::vector<SingleStreamingInput *> m_InttInputVector;
   std::vector<SingleStreamingInput *> m_MicromegasInputVector;
   std::vector<SingleStreamingInput *> m_MvtxInputVector;
   std::vector<SingleStreamingInput *> m_TpcInputVector;
-  std::map<uint64_t, Gl1RawHitInfo> m_Gl1RawHitMap;
-  std::map<uint64_t, InttRawHitInfo> m_InttRawHitMap;
-  std::map<uint64_t, MicromegasRawHitInfo> m_MicromegasRawHitMap;
-  std::map<uint64_t, MvtxRawHitInfo> m_MvtxRawHitMap;
-  std::map<uint64_t, TpcRawHitInfo> m_TpcRawHitMap;
-  std::map<int, std::map<int, uint64_t>> m_InttPacketFeeBcoMap;
+  BcoRingBuffer<Gl1RawHitInfo> m_Gl1RawHitMap;
+  BcoRingBuffer<InttRawHitInfo> m_InttRawHitMap;
+  BcoRingBuffer<MicromegasRawHitInfo> m_MicromegasRawHitMap;
+  BcoRingBuffer<MvtxRawHitInfo> m_MvtxRawHitMap;
+  BcoRingBuffer<TpcRawHitInfo> m_TpcRawHitMap;
 
   // QA histos
   TH1 *h_refbco_mvtx{nullptr};
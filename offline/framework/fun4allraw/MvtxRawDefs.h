@@ -3,7 +3,7 @@
 
 #include <array>
 #include <cstdint>
-#include <map>
+#include <utility>
 
 namespace MvtxRawDefs
 {
@@ -13,63 +13,63 @@ namespace MvtxRawDefs
   static constexpr uint8_t nChipsPerGbt = 3;
   static constexpr uint8_t nStavesPerFelix = 8;
 
-  static const std::array<uint8_t, nMvtxLayers> firstStaveIndex = {{ 0, 12, 28 }};
+  inline constexpr std::array<uint8_t, nMvtxLayers> firstStaveIndex = {{ 0, 12, 28 }};
 
-  static const std::array<std::array<uint8_t, nChipsPerGbt>, nGbtPerStave> gbtChipId_to_staveChipId = {{ {{0,1,2}}, {{3,4,5}}, {{6,7,8}} }};
+  static constexpr std::array<std::array<uint8_t, nChipsPerGbt>, nGbtPerStave> gbtChipId_to_staveChipId = {{ {{0,1,2}}, {{3,4,5}}, {{6,7,8}} }};
 
   // 07/03/2024
-  // {staveIndex[0-47], { FLX[0-5], EndPoint[0-1] } }
-  const std::map<uint8_t, std::pair<uint8_t, uint8_t>> stave_felix_map =
-  {
-    { 0, {2,0} },
-    { 1, {2,0} },
-    { 2, {2,1} },
-    { 3, {0,0} },
-    { 4, {0,0} },
-    { 5, {0,1} },
-    { 6, {4,0} },
-    { 7, {4,0} },
-    { 8, {4,1} },
-    { 9, {3,0} },
-    {10, {3,0} },
-    {11, {3,1} },
-    {12, {1,0} },
-    {13, {1,0} },
-    {14, {1,1} },
-    {15, {1,1} },
-    {16, {2,0} },
-    {17, {2,1} },
-    {18, {2,1} },
-    {19, {2,1} },
-    {20, {5,0} },
-    {21, {5,0} },
-    {22, {5,1} },
-    {23, {5,1} },
-    {24, {4,0} },
-    {25, {4,1} },
-    {26, {4,1} },
-    {27, {4,1} },
-    {28, {4,0} },
-    {29, {0,0} },
-    {30, {0,0} },
-    {31, {0,1} },
-    {32, {0,1} },
-    {33, {3,0} },
-    {34, {1,0} },
-    {35, {1,0} },
-    {36, {1,1} },
-    {37, {1,1} },
-    {38, {2,0} },
-    {39, {3,0} },
-    {40, {3,1} },
-    {41, {3,1} },
-    {42, {3,1} },
-    {43, {0,1} },
-    {44, {5,0} },
-    {45, {5,0} },
-    {46, {5,1} },
-    {47, {5,1} },
-  };
+  // staveIndex[0-47] -> { FLX[0-5], EndPoint[0-1] }
+  inline constexpr std::array<std::pair<uint8_t, uint8_t>, 48> stave_felix_map =
+  {{
+    {2, 0},  // 0
+    {2, 0},  // 1
+    {2, 1},  // 2
+    {0, 0},  // 3
+    {0, 0},  // 4
+    {0, 1},  // 5
+    {4, 0},  // 6
+    {4, 0},  // 7
+    {4, 1},  // 8
+    {3, 0},  // 9
+    {3, 0},  // 10
+    {3, 1},  // 11
+    {1, 0},  // 12
+    {1, 0},  // 13
+    {1, 1},  // 14
+    {1, 1},  // 15
+    {2, 0},  // 16
+    {2, 1},  // 17
+    {2, 1},  // 18
+    {2, 1},  // 19
+    {5, 0},  // 20
+    {5, 0},  // 21
+    {5, 1},  // 22
+    {5, 1},  // 23
+    {4, 0},  // 24
+    {4, 1},  // 25
+    {4, 1},  // 26
+    {4, 1},  // 27
+    {4, 0},  // 28
+    {0, 0},  // 29
+    {0, 0},  // 30
+    {0, 1},  // 31
+    {0, 1},  // 32
+    {3, 0},  // 33
+    {1, 0},  // 34
+    {1, 0},  // 35
+    {1, 1},  // 36
+    {1, 1},  // 37
+    {2, 0},  // 38
+    {3, 0},  // 39
+    {3, 1},  // 40
+    {3, 1},  // 41
+    {3, 1},  // 42
+    {0, 1},  // 43
+    {5, 0},  // 44
+    {5, 0},  // 45
+    {5, 1},  // 46
+    {5, 1}   // 47
+  }};
 
   typedef struct linkId
   {
@@ -78,10 +78,28 @@ namespace MvtxRawDefs
     uint32_t gbtid {0xFF};
   } linkId_t;
 
-  uint8_t getStaveIndex( const uint8_t& lyrId, const uint8_t& stvId );
-  std::pair<uint8_t, uint8_t> const& get_flx_endpoint( const uint8_t& lyrId, const uint8_t& stvId );
+  // inline, the decoders call these for every fee id they see
+  inline uint8_t getStaveIndex( const uint8_t& lyrId, const uint8_t& stvId )
+  {
+    return firstStaveIndex[lyrId] + stvId;
+  }
 
-  linkId_t decode_feeid( const uint16_t feeid );
+  inline std::pair<uint8_t, uint8_t> const& get_flx_endpoint( const uint8_t& lyrId, const uint8_t& stvId )
+  {
+    return stave_felix_map.at( getStaveIndex(lyrId, stvId) );
+  }
+
+  inline linkId_t decode_feeid( const uint16_t feeid )
+  {
+    linkId_t ret = {};
+    // the static_cast< uint16_t> is needed to because the result of (feeid >> 12U)
+    // is promoted to int which then triggers a (correct) clang-tidy warning that
+    // a bitwise operation is performed on a signed integer
+    ret.layer = static_cast<uint16_t>(feeid >> 12U) & 0x7U;
+    ret.stave = feeid & 0x1FU;
+    ret.gbtid = static_cast<uint16_t>(feeid >> 8U) & 0x3U;
+    return ret;
+  }
 
   float getStrobeLength(const int& runNumber);
 
@@ -0,0 +1,42 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLRAW_PRDFBACKGROUNDOPENER_H
+#define FUN4ALLRAW_PRDFBACKGROUNDOPENER_H
+
+#include <fun4all/BackgroundFileOpener.h>
+
+#include <frog/FROG.h>
+
+#include <Event/Eventiterator.h>
+#include <Event/fileEventiterator.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+
+//! start the FROG lookup and fileEventiterator open of filename on a background thread
+//! the opener is created on first use, nothing happens for an empty filename
+inline void OpenPrdfInBackground(BackgroundFileOpener<Eventiterator> *&opener, const std::string &filename)
+{
+  if (filename.empty())
+  {
+    return;
+  }
+  if (!opener)
+  {
+    opener = new BackgroundFileOpener<Eventiterator>();
+  }
+  opener->start(filename, [](const std::string &lfn)
+                {
+                  FROG frog;
+                  std::string location = frog.location(lfn);
+                  int status = 0;
+                  std::unique_ptr<Eventiterator> evtiter = std::make_unique<fileEventiterator>(location.c_str(), status);
+                  if (status)
+                  {
+                    evtiter.reset();
+                  }
+                  return BackgroundFileOpener<Eventiterator>::Result(location, std::move(evtiter)); });
+}
+
+#endif
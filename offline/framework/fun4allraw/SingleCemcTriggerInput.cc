@@ -4,7 +4,7 @@
 #include "InputManagerType.h"
 
 #include <ffarawobjects/CaloPacketContainerv1.h>
-#include <ffarawobjects/CaloPacketv1.h>
+#include <ffarawobjects/CaloPacket.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHIODataNode.h>    // for PHIODataNode
@@ -39,6 +39,7 @@ SingleCemcTriggerInput::SingleCemcTriggerInput(const std::string &name)
 
 SingleCemcTriggerInput::~SingleCemcTriggerInput()
 {
+  StopReadAhead();
   CleanupUsedLocalPackets(std::numeric_limits<int>::max());
   CleanupUsedPackets(std::numeric_limits<int>::max());
   // some events are already in the m_EventStack but they haven't been put
@@ -55,207 +56,35 @@ void SingleCemcTriggerInput::FillPool(const unsigned int keep)
   {
     return;
   }
-  while (GetEventiterator() == nullptr)  // at startup this is a null pointer
+  while (GetSomeMoreEvents(keep))
   {
-    if (!OpenNextFile())
+    DecodedEvent event;
+    if (!NextDecodedEvent(event))
     {
       AllDone(1);
       return;
     }
-  }
-  while (GetSomeMoreEvents(keep))
-  {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
-    while (!evt)
-    {
-      fileclose();
-      if (!OpenNextFile())
-      {
-        AllDone(1);
-        return;
-      }
-      evt.reset(GetEventiterator()->getNextEvent());
-    }
-    if (Verbosity() > 21)
+    for (auto *pkt : event.Packets)
     {
-      std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
-    }
-    RunNumber(evt->getRunNumber());
-    if (Verbosity() > 21)
-    {
-      evt->identify();
-    }
-    if (evt->getEvtType() != DATAEVENT)
-    {
-      m_NumSpecialEvents++;
-      continue;
-    }
-    int EventSequence = evt->getEvtSequence();
-    if (EventSequence < SkipToEvent())
-    {
-      continue;
-    }
-    std::vector<Packet *> pktvec = evt->getPacketVector();
-    for (auto packet : pktvec)
-    {
-      int packet_id = packet->getIdentifier();
-      // for testing we need only one packet to keep blabbering at minimum
-      // if (packet_id != 6105)
-      // {
-      // 	delete packet;
-      // 	continue;
-      // }
+      CaloPacket *newhit = static_cast<CaloPacket *>(pkt);
+      int packet_id = newhit->getIdentifier();
       // The call to  EventNumberOffset(identifier) will initialize it to our default (zero) if it wasn't set already
       // if we encounter a misalignemt, the Fun4AllPrdfInputTriggerManager will adjust this. But the event
       // number of the adjustment depends on its pooldepth. Events in its pools will be moved to the correct slots
       // and only when the pool gets refilled, this correction kicks in
       // SO DO NOT BE CONFUSED when printing this out - seeing different events where this kicks in
-      int CorrectedEventSequence = EventSequence + EventNumberOffset(packet_id);
-      if (Verbosity() > 2)
-      {
-        packet->identify();
-      }
-
-      // by default use previous bco clock for gtm bco
-      CaloPacket *newhit = new CaloPacketv1();
-      int nr_modules = packet->iValue(0, "NRMODULES");
-      int nr_channels = packet->iValue(0, "CHANNELS");
-      int nr_samples = packet->iValue(0, "SAMPLES");
-      if (nr_modules > newhit->getMaxNumModules())
-      {
-        std::cout << PHWHERE << " too many modules " << nr_modules << ", max is "
-                  << newhit->getMaxNumModules() << ", need to adjust arrays" << std::endl;
-        gSystem->Exit(1);
-      }
-      if (nr_channels > newhit->getMaxNumChannels())
-      {
-        std::cout << PHWHERE << " too many channels " << nr_channels << ", max is "
-                  << newhit->getMaxNumChannels() << ", need to adjust arrays" << std::endl;
-        gSystem->Exit(1);
-      }
-      if (nr_samples > newhit->getMaxNumSamples())
-      {
-        std::cout << PHWHERE << " too many samples " << nr_samples << ", max is "
-                  << newhit->getMaxNumSamples() << ", need to adjust arrays" << std::endl;
-        gSystem->Exit(1);
-      }
-
-      uint64_t gtm_bco = packet->lValue(0, "CLOCK");
-      newhit->setNrModules(nr_modules);
-      newhit->setNrSamples(nr_samples);
-      newhit->setNrChannels(nr_channels);
-      newhit->setBCO(gtm_bco);
-      newhit->setPacketEvtSequence(packet->iValue(0, "EVTNR"));
-      newhit->setIdentifier(packet_id);
-      newhit->setHitFormat(packet->getHitFormat());
+      int CorrectedEventSequence = event.EventSequence + EventNumberOffset(packet_id);
       newhit->setEvtSequence(CorrectedEventSequence);
-      newhit->setEvenChecksum(packet->iValue(0, "EVENCHECKSUM"));
-      newhit->setCalcEvenChecksum(packet->iValue(0, "CALCEVENCHECKSUM"));
-      newhit->setOddChecksum(packet->iValue(0, "ODDCHECKSUM"));
-      newhit->setCalcOddChecksum(packet->iValue(0, "CALCODDCHECKSUM"));
-      newhit->setModuleAddress(packet->iValue(0, "MODULEADDRESS"));
-      newhit->setDetId(packet->iValue(0, "DETID"));
-      // 2 Cemc packets have counter problems, one for the event number (6024), the other for the clock counter (6057)
-      std::map<int, unsigned int> femevtmap;
-      std::map<int, unsigned int> femclkmap;
-      unsigned int femevt = std::numeric_limits<unsigned int>::max();
-      unsigned int femclk = std::numeric_limits<unsigned int>::max();
-      for (int ifem = 0; ifem < nr_modules; ifem++)
-      {
-        femevt = packet->iValue(ifem, "FEMEVTNR");
-        femclk = packet->iValue(ifem, "FEMCLOCK");
-        femclkmap[femclk]++;
-        femevtmap[femevt]++;
-        newhit->setFemSlot(ifem, packet->iValue(ifem, "FEMSLOT"));
-        newhit->setChecksumLsb(ifem, packet->iValue(ifem, "CHECKSUMLSB"));
-        newhit->setChecksumMsb(ifem, packet->iValue(ifem, "CHECKSUMMSB"));
-        newhit->setCalcChecksumLsb(ifem, packet->iValue(ifem, "CALCCHECKSUMLSB"));
-        newhit->setCalcChecksumMsb(ifem, packet->iValue(ifem, "CALCCHECKSUMMSB"));
-      }
-      // if FEM clocks are different, find 2 out of 3 and set all of them to the majority
-      if (femclkmap.size() > 1)  // more than one entry
-      {
-        if (femclkmap.size() >= 3)
-        {
-          femclk = std::numeric_limits<int>::max();
-        }
-        else
-        {
-          unsigned int imax = 0;
-          for (auto &iter : femclkmap)
-          {
-            if (imax < iter.second)
-            {
-              imax = iter.second;
-              femclk = iter.first;
-            }
-          }
-        }
-      }
-      for (int ifem = 0; ifem < nr_modules; ifem++)
-      {
-        newhit->setFemClock(ifem, femclk);
-      }
-
-      // if FEM Event Nums are different, find 2 out of 3 and set all of them to the majority
-      if (femevtmap.size() > 1)  // more than one entry
-      {
-        if (femevtmap.size() >= 3)
-        {
-          femevt = std::numeric_limits<int>::max();
-        }
-        else
-        {
-          unsigned int imax = 0;
-          for (auto &iter : femevtmap)
-          {
-            if (imax < iter.second)
-            {
-              imax = iter.second;
-              femevt = iter.first;
-            }
-          }
-        }
-      }
-      for (int ifem = 0; ifem < nr_modules; ifem++)
-      {
-        newhit->setFemEvtSequence(ifem, femevt);
-      }
-
-      for (int ipmt = 0; ipmt < nr_channels; ipmt++)
-      {
-        // store pre/post only for suppressed channels, the array in the packet routines is not
-        // initialized so reading pre/post for not zero suppressed channels returns garbage
-        bool isSuppressed = packet->iValue(ipmt, "SUPPRESSED");
-        newhit->setSuppressed(ipmt, isSuppressed);
-        if (isSuppressed)
-        {
-          newhit->setPre(ipmt, packet->iValue(ipmt, "PRE"));
-          newhit->setPost(ipmt, packet->iValue(ipmt, "POST"));
-        }
-        else
-        {
-          for (int isamp = 0; isamp < nr_samples; isamp++)
-          {
-            newhit->setSample(ipmt, isamp, packet->iValue(isamp, ipmt));
-          }
-        }
-      }
       if (Verbosity() > 2)
       {
         std::cout << PHWHERE << "corrected evtno: " << CorrectedEventSequence
-                  << ", original evtno: " << EventSequence
-                  << ", bco: 0x" << std::hex << gtm_bco << std::dec
+                  << ", original evtno: " << event.EventSequence
+                  << ", bco: 0x" << std::hex << newhit->getBCO() << std::dec
                   << std::endl;
       }
       //      std::cout << "Pushing packet " << packet_id << " for event " << CorrectedEventSequence << " into local packet map" << std::endl;
       m_LocalPacketMap[CorrectedEventSequence].push_back(newhit);
       m_EventStack.insert(CorrectedEventSequence);
-      if (ddump_enabled())
-      {
-        ddumppacket(packet);
-      }
-      delete packet;
     }
     if (m_LocalPacketMap.size() >= LocalPoolDepth())
     {
@@ -349,6 +178,135 @@ void SingleCemcTriggerInput::FillPool(const unsigned int keep)
   }
 }
 
+OfflinePacket *SingleCemcTriggerInput::DecodePacket(Packet *packet)
+{
+  int packet_id = packet->getIdentifier();
+  CaloPacket *newhit = NewCaloPacket();
+  int nr_modules = packet->iValue(0, "NRMODULES");
+  int nr_channels = packet->iValue(0, "CHANNELS");
+  int nr_samples = packet->iValue(0, "SAMPLES");
+  if (nr_modules > newhit->getMaxNumModules())
+  {
+    std::cout << PHWHERE << " too many modules " << nr_modules << ", max is "
+              << newhit->getMaxNumModules() << ", need to adjust arrays" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (nr_channels > newhit->getMaxNumChannels())
+  {
+    std::cout << PHWHERE << " too many channels " << nr_channels << ", max is "
+              << newhit->getMaxNumChannels() << ", need to adjust arrays" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (nr_samples > newhit->getMaxNumSamples())
+  {
+    std::cout << PHWHERE << " too many samples " << nr_samples << ", max is "
+              << newhit->getMaxNumSamples() << ", need to adjust arrays" << std::endl;
+    gSystem->Exit(1);
+  }
+
+  uint64_t gtm_bco = packet->lValue(0, "CLOCK");
+  newhit->setNrModules(nr_modules);
+  newhit->setNrSamples(nr_samples);
+  newhit->setNrChannels(nr_channels);
+  newhit->setBCO(gtm_bco);
+  newhit->setPacketEvtSequence(packet->iValue(0, "EVTNR"));
+  newhit->setIdentifier(packet_id);
+  newhit->setHitFormat(packet->getHitFormat());
+  newhit->setEvenChecksum(packet->iValue(0, "EVENCHECKSUM"));
+  newhit->setCalcEvenChecksum(packet->iValue(0, "CALCEVENCHECKSUM"));
+  newhit->setOddChecksum(packet->iValue(0, "ODDCHECKSUM"));
+  newhit->setCalcOddChecksum(packet->iValue(0, "CALCODDCHECKSUM"));
+  newhit->setModuleAddress(packet->iValue(0, "MODULEADDRESS"));
+  newhit->setDetId(packet->iValue(0, "DETID"));
+  // 2 Cemc packets have counter problems, one for the event number (6024), the other for the clock counter (6057)
+  std::map<int, unsigned int> femevtmap;
+  std::map<int, unsigned int> femclkmap;
+  unsigned int femevt = std::numeric_limits<unsigned int>::max();
+  unsigned int femclk = std::numeric_limits<unsigned int>::max();
+  for (int ifem = 0; ifem < nr_modules; ifem++)
+  {
+    femevt = packet->iValue(ifem, "FEMEVTNR");
+    femclk = packet->iValue(ifem, "FEMCLOCK");
+    femclkmap[femclk]++;
+    femevtmap[femevt]++;
+    newhit->setFemSlot(ifem, packet->iValue(ifem, "FEMSLOT"));
+    newhit->setChecksumLsb(ifem, packet->iValue(ifem, "CHECKSUMLSB"));
+    newhit->setChecksumMsb(ifem, packet->iValue(ifem, "CHECKSUMMSB"));
+    newhit->setCalcChecksumLsb(ifem, packet->iValue(ifem, "CALCCHECKSUMLSB"));
+    newhit->setCalcChecksumMsb(ifem, packet->iValue(ifem, "CALCCHECKSUMMSB"));
+  }
+  // if FEM clocks are different, find 2 out of 3 and set all of them to the majority
+  if (femclkmap.size() > 1)  // more than one entry
+  {
+    if (femclkmap.size() >= 3)
+    {
+      femclk = std::numeric_limits<int>::max();
+    }
+    else
+    {
+      unsigned int imax = 0;
+      for (auto &iter : femclkmap)
+      {
+        if (imax < iter.second)
+        {
+          imax = iter.second;
+          femclk = iter.first;
+        }
+      }
+    }
+  }
+  for (int ifem = 0; ifem < nr_modules; ifem++)
+  {
+    newhit->setFemClock(ifem, femclk);
+  }
+
+  // if FEM Event Nums are different, find 2 out of 3 and set all of them to the majority
+  if (femevtmap.size() > 1)  // more than one entry
+  {
+    if (femevtmap.size() >= 3)
+    {
+      femevt = std::numeric_limits<int>::max();
+    }
+    else
+    {
+      unsigned int imax = 0;
+      for (auto &iter : femevtmap)
+      {
+        if (imax < iter.second)
+        {
+          imax = iter.second;
+          femevt = iter.first;
+        }
+      }
+    }
+  }
+  for (int ifem = 0; ifem < nr_modules; ifem++)
+  {
+    newhit->setFemEvtSequence(ifem, femevt);
+  }
+
+  for (int ipmt = 0; ipmt < nr_channels; ipmt++)
+  {
+    // store pre/post only for suppressed channels, the array in the packet routines is not
+    // initialized so reading pre/post for not zero suppressed channels returns garbage
+    bool isSuppressed = packet->iValue(ipmt, "SUPPRESSED");
+    newhit->setSuppressed(ipmt, isSuppressed);
+    if (isSuppressed)
+    {
+      newhit->setPre(ipmt, packet->iValue(ipmt, "PRE"));
+      newhit->setPost(ipmt, packet->iValue(ipmt, "POST"));
+    }
+    else
+    {
+      for (int isamp = 0; isamp < nr_samples; isamp++)
+      {
+        newhit->setSample(ipmt, isamp, packet->iValue(isamp, ipmt));
+      }
+    }
+  }
+  return newhit;
+}
+
 void SingleCemcTriggerInput::Print(const std::string &what) const
 {
   if (what == "ALL" || what == "STORAGE")
@@ -402,7 +360,7 @@ void SingleCemcTriggerInput::CleanupUsedLocalPackets(const int eventno)
     {
       for (auto pktiter : iter.second)
       {
-        delete pktiter;
+        RecycleCaloPacket(pktiter);
       }
       toclearevents.push_back(iter.first);
     }
@@ -428,7 +386,7 @@ void SingleCemcTriggerInput::CleanupUsedPackets(const int eventno)
     {
       for (auto pktiter : iter.second)
       {
-        delete pktiter;
+        RecycleCaloPacket(pktiter);
       }
       toclearevents.push_back(iter.first);
     }
@@ -31,6 +31,7 @@ class SingleCemcTriggerInput : public SingleTriggerInput
   int ClockReferencePacket() const { return m_ClockReferencePacket; }
 
  private:
+  OfflinePacket *DecodePacket(Packet *packet) override;
   void CheckFEMClock();
   void CheckFEMEventNumber();
   int ShiftEvents(int pktid, int offset);
@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLEGL1POOLINPUT_H
 #define FUN4ALLRAW_SINGLEGL1POOLINPUT_H
 
+#include "BcoRingBuffer.h"
 #include "SingleStreamingInput.h"
 
 #include <cstdint>
@@ -35,7 +36,7 @@ class SingleGl1PoolInput : public SingleStreamingInput
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
 
-  std::map<uint64_t, std::vector<Gl1Packet *>> m_Gl1RawHitMap;
+  BcoRingBuffer<std::vector<Gl1Packet *>> m_Gl1RawHitMap;
   std::set<uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
 };
@@ -23,6 +23,7 @@
 #include <set>
 #include <memory>
 #include <utility>  // for pair
+#include <vector>
 
 SingleInttPoolInput::SingleInttPoolInput(const std::string &name)
   : SingleStreamingInput(name)
@@ -212,6 +213,13 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
         }
         else
         {
+          // the hits of a bco are mostly consecutive, each run of them is stored
+          // with one lookup. m_BeamClockFEE and m_FEEBclkMap only change with the
+          // FEE or its bco
+          uint64_t run_bco = 0;
+          int previous_fee = -1;
+          uint64_t previous_bco = 0;
+          m_HitRun.clear();
           for (int j = 0; j < num_hits; j++)
           {
             uint64_t gtm_bco = pool->lValue(j, "BCO");
@@ -244,8 +252,13 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
               gtm_bco += 0x10000000000;  // rollover makes sure our bclks are ascending even if we roll over the 40 bit counter
             }
             m_PreviousClock[FEE] = gtm_bco;
-            m_BeamClockFEE[gtm_bco].insert(FEE);
-            m_FEEBclkMap[FEE] = gtm_bco;
+            if (FEE != previous_fee || gtm_bco != previous_bco)
+            {
+              m_BeamClockFEE[gtm_bco].insert(FEE);
+              m_FEEBclkMap[FEE] = gtm_bco;
+              previous_fee = FEE;
+              previous_bco = gtm_bco;
+            }
             if (Verbosity() > 2)
             {
               std::cout << "evtno: " << EventSequence
@@ -257,11 +270,16 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
                         << ", channel: " << newhit->get_channel_id()
                         << ", evt_counter: " << newhit->get_event_counter() << std::endl;
             }
-            if (StreamingInputManager())
+            if (!m_HitRun.empty() && gtm_bco != run_bco)
             {
-              StreamingInputManager()->AddInttRawHit(gtm_bco, newhit.get());
+              StoreHits(run_bco);
             }
-            m_InttRawHitMap[gtm_bco].push_back(newhit.release());
+            run_bco = gtm_bco;
+            m_HitRun.push_back(newhit.release());
+          }
+          if (!m_HitRun.empty())
+          {
+            StoreHits(run_bco);
           }
         }
         //	    Print("FEEBCLK");
@@ -271,6 +289,17 @@ void SingleInttPoolInput::FillPool(const uint64_t minBCO)
   }
 }
 
+void SingleInttPoolInput::StoreHits(const uint64_t bco)
+{
+  if (StreamingInputManager())
+  {
+    StreamingInputManager()->AddInttRawHits(bco, m_HitRun);
+  }
+  std::vector<InttRawHit *> &hits = m_InttRawHitMap[bco];
+  hits.insert(hits.end(), m_HitRun.begin(), m_HitRun.end());
+  m_HitRun.clear();
+}
+
 void SingleInttPoolInput::Print(const std::string &what) const
 {
   if (what == "ALL" || what == "FEE")
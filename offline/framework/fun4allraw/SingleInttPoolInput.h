@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLEINTTPOOLINPUT_H
 #define FUN4ALLRAW_SINGLEINTTPOOLINPUT_H
 
+#include "BcoRingBuffer.h"
 #include "SingleStreamingInput.h"
 
 #include <array>
@@ -43,10 +44,14 @@ class SingleInttPoolInput : public SingleStreamingInput
   std::array<uint64_t, 14> m_PreviousClock{};
   std::array<uint64_t, 14> m_Rollover{};
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
-  std::map<uint64_t, std::vector<InttRawHit *>> m_InttRawHitMap;
+  BcoRingBuffer<std::vector<InttRawHit *>> m_InttRawHitMap;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
 
+  //! consecutive hits of a pool with the same bco, stored together
+  void StoreHits(const uint64_t bco);
+  std::vector<InttRawHit *> m_HitRun;
+
   std::map<int, intt_pool *> poolmap;
 };
 
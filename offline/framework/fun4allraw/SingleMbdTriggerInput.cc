@@ -4,7 +4,7 @@
 #include "InputManagerType.h"
 
 #include <ffarawobjects/CaloPacketContainerv1.h>
-#include <ffarawobjects/CaloPacketv1.h>
+#include <ffarawobjects/CaloPacket.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/PHIODataNode.h>    // for PHIODataNode
@@ -37,6 +37,7 @@ SingleMbdTriggerInput::SingleMbdTriggerInput(const std::string &name)
 
 SingleMbdTriggerInput::~SingleMbdTriggerInput()
 {
+  StopReadAhead();
   CleanupUsedPackets(std::numeric_limits<int>::max());
   // some events are already in the m_EventStack but they haven't been put
   // into the m_PacketMap
@@ -52,120 +53,30 @@ void SingleMbdTriggerInput::FillPool(const unsigned int keep)
   {
     return;
   }
-  while (GetEventiterator() == nullptr)  // at startup this is a null pointer
+  while (GetSomeMoreEvents(keep))
   {
-    if (!OpenNextFile())
+    DecodedEvent event;
+    if (!NextDecodedEvent(event))
     {
       AllDone(1);
       return;
     }
-  }
-  while (GetSomeMoreEvents(keep))
-  {
-    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
-    while (!evt)
+    for (auto *pkt : event.Packets)
     {
-      fileclose();
-      if (!OpenNextFile())
-      {
-        AllDone(1);
-        return;
-      }
-      evt.reset(GetEventiterator()->getNextEvent());
-    }
-    if (Verbosity() > 2)
-    {
-      std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
-    }
-    RunNumber(evt->getRunNumber());
-    if (GetVerbosity() > 1)
-    {
-      evt->identify();
-    }
-    if (evt->getEvtType() != DATAEVENT)
-    {
-      m_NumSpecialEvents++;
-      continue;
-    }
-    int EventSequence = evt->getEvtSequence();
-    if (EventSequence < SkipToEvent())
-    {
-      continue;
-    }
-    std::vector<Packet *> pktvec = evt->getPacketVector();
-    for (auto packet : pktvec)
-    {
-      int packet_id = packet->getIdentifier();
+      CaloPacket *newhit = static_cast<CaloPacket *>(pkt);
+      int packet_id = newhit->getIdentifier();
       // The call to  EventNumberOffset(identifier) will initialize it to our default if it wasn't set already
       // if we encounter a misalignemt, the Fun4AllPrdfInputTriggerManager will adjust this. But the event
       // number of the adjustment depends on its pooldepth. Events in its pools will be moved to the correct slots
       // and only when the pool gets refilled, this correction kicks in
       // SO DO NOT BE CONFUSED when printing this out - seeing different events where this kicks in
-      int CorrectedEventSequence = EventSequence + EventNumberOffset(packet_id);
-      if (Verbosity() > 2)
-      {
-        packet->identify();
-      }
-
-      CaloPacket *newhit = new CaloPacketv1();
-      int nr_modules = packet->iValue(0, "NRMODULES");
-      int nr_channels = packet->iValue(0, "CHANNELS");
-      int nr_samples = packet->iValue(0, "SAMPLES");
-      if (nr_modules > 3)
-      {
-        std::cout << PHWHERE << " too many modules, need to adjust arrays" << std::endl;
-        gSystem->Exit(1);
-      }
-
-      uint64_t gtm_bco = packet->lValue(0, "CLOCK");
-      newhit->setNrModules(nr_modules);
-      newhit->setNrSamples(nr_samples);
-      newhit->setNrChannels(nr_channels);
-      newhit->setBCO(gtm_bco);
-      newhit->setPacketEvtSequence(packet->iValue(0, "EVTNR"));
-      newhit->setIdentifier(packet_id);
-      newhit->setHitFormat(packet->getHitFormat());
+      int CorrectedEventSequence = event.EventSequence + EventNumberOffset(packet_id);
       newhit->setEvtSequence(CorrectedEventSequence);
-      newhit->setEvenChecksum(packet->iValue(0, "EVENCHECKSUM"));
-      newhit->setCalcEvenChecksum(packet->iValue(0, "CALCEVENCHECKSUM"));
-      newhit->setOddChecksum(packet->iValue(0, "ODDCHECKSUM"));
-      newhit->setCalcOddChecksum(packet->iValue(0, "CALCODDCHECKSUM"));
-      newhit->setModuleAddress(packet->iValue(0, "MODULEADDRESS"));
-      newhit->setDetId(packet->iValue(0, "DETID"));
-      for (int ifem = 0; ifem < nr_modules; ifem++)
-      {
-        newhit->setFemClock(ifem, packet->iValue(ifem, "FEMCLOCK"));
-        newhit->setFemEvtSequence(ifem, packet->iValue(ifem, "FEMEVTNR"));
-        newhit->setFemSlot(ifem, packet->iValue(ifem, "FEMSLOT"));
-        newhit->setChecksumLsb(ifem, packet->iValue(ifem, "CHECKSUMLSB"));
-        newhit->setChecksumMsb(ifem, packet->iValue(ifem, "CHECKSUMMSB"));
-        newhit->setCalcChecksumLsb(ifem, packet->iValue(ifem, "CALCCHECKSUMLSB"));
-        newhit->setCalcChecksumMsb(ifem, packet->iValue(ifem, "CALCCHECKSUMMSB"));
-      }
-      for (int ipmt = 0; ipmt < nr_channels; ipmt++)
-      {
-        // store pre/post only for suppressed channels, the array in the packet routines is not
-        // initialized so reading pre/post for not zero suppressed channels returns garbage
-        bool isSuppressed = packet->iValue(ipmt, "SUPPRESSED");
-        newhit->setSuppressed(ipmt, isSuppressed);
-        if (isSuppressed)
-        {
-          newhit->setPre(ipmt, packet->iValue(ipmt, "PRE"));
-          newhit->setPost(ipmt, packet->iValue(ipmt, "POST"));
-        }
-        else
-        {
-          for (int isamp = 0; isamp < nr_samples; isamp++)
-          {
-            newhit->setSample(ipmt, isamp, packet->iValue(isamp, ipmt));
-          }
-        }
-      }
       if (Verbosity() > 2)
       {
         std::cout << PHWHERE << "corrected evtno: " << CorrectedEventSequence
-                  << ", original evtno: " << EventSequence
-                  << ", bco: 0x" << std::hex << gtm_bco << std::dec
+                  << ", original evtno: " << event.EventSequence
+                  << ", bco: 0x" << std::hex << newhit->getBCO() << std::dec
                   << std::endl;
       }
       if (TriggerInputManager())
@@ -174,13 +85,67 @@ void SingleMbdTriggerInput::FillPool(const unsigned int keep)
       }
       m_PacketMap[CorrectedEventSequence].push_back(newhit);
       m_EventStack.insert(CorrectedEventSequence);
-      if (ddump_enabled())
+    }
+  }
+}
+
+OfflinePacket *SingleMbdTriggerInput::DecodePacket(Packet *packet)
+{
+  int packet_id = packet->getIdentifier();
+  CaloPacket *newhit = NewCaloPacket();
+  int nr_modules = packet->iValue(0, "NRMODULES");
+  int nr_channels = packet->iValue(0, "CHANNELS");
+  int nr_samples = packet->iValue(0, "SAMPLES");
+  if (nr_modules > 3)
+  {
+    std::cout << PHWHERE << " too many modules, need to adjust arrays" << std::endl;
+    gSystem->Exit(1);
+  }
+
+  uint64_t gtm_bco = packet->lValue(0, "CLOCK");
+  newhit->setNrModules(nr_modules);
+  newhit->setNrSamples(nr_samples);
+  newhit->setNrChannels(nr_channels);
+  newhit->setBCO(gtm_bco);
+  newhit->setPacketEvtSequence(packet->iValue(0, "EVTNR"));
+  newhit->setIdentifier(packet_id);
+  newhit->setHitFormat(packet->getHitFormat());
+  newhit->setEvenChecksum(packet->iValue(0, "EVENCHECKSUM"));
+  newhit->setCalcEvenChecksum(packet->iValue(0, "CALCEVENCHECKSUM"));
+  newhit->setOddChecksum(packet->iValue(0, "ODDCHECKSUM"));
+  newhit->setCalcOddChecksum(packet->iValue(0, "CALCODDCHECKSUM"));
+  newhit->setModuleAddress(packet->iValue(0, "MODULEADDRESS"));
+  newhit->setDetId(packet->iValue(0, "DETID"));
+  for (int ifem = 0; ifem < nr_modules; ifem++)
+  {
+    newhit->setFemClock(ifem, packet->iValue(ifem, "FEMCLOCK"));
+    newhit->setFemEvtSequence(ifem, packet->iValue(ifem, "FEMEVTNR"));
+    newhit->setFemSlot(ifem, packet->iValue(ifem, "FEMSLOT"));
+    newhit->setChecksumLsb(ifem, packet->iValue(ifem, "CHECKSUMLSB"));
+    newhit->setChecksumMsb(ifem, packet->iValue(ifem, "CHECKSUMMSB"));
+    newhit->setCalcChecksumLsb(ifem, packet->iValue(ifem, "CALCCHECKSUMLSB"));
+    newhit->setCalcChecksumMsb(ifem, packet->iValue(ifem, "CALCCHECKSUMMSB"));
+  }
+  for (int ipmt = 0; ipmt < nr_channels; ipmt++)
+  {
+    // store pre/post only for suppressed channels, the array in the packet routines is not
+    // initialized so reading pre/post for not zero suppressed channels returns garbage
+    bool isSuppressed = packet->iValue(ipmt, "SUPPRESSED");
+    newhit->setSuppressed(ipmt, isSuppressed);
+    if (isSuppressed)
+    {
+      newhit->setPre(ipmt, packet->iValue(ipmt, "PRE"));
+      newhit->setPost(ipmt, packet->iValue(ipmt, "POST"));
+    }
+    else
+    {
+      for (int isamp = 0; isamp < nr_samples; isamp++)
       {
-        ddumppacket(packet);
+        newhit->setSample(ipmt, isamp, packet->iValue(isamp, ipmt));
       }
-      delete packet;
     }
   }
+  return newhit;
 }
 
 void SingleMbdTriggerInput::Print(const std::string &what) const
@@ -210,7 +175,7 @@ void SingleMbdTriggerInput::CleanupUsedPackets(const int eventno)
     {
       for (auto pktiter : iter.second)
       {
-        delete pktiter;
+        RecycleCaloPacket(pktiter);
       }
       toclearevents.push_back(iter.first);
     }
@@ -25,6 +25,7 @@ class SingleMbdTriggerInput : public SingleTriggerInput
   void CreateDSTNode(PHCompositeNode *topNode) override;
 
  private:
+  OfflinePacket *DecodePacket(Packet *packet) override;
 };
 
 #endif
@@ -7,11 +7,13 @@
 #include <ffarawobjects/MvtxFeeIdInfov1.h>
 #include <ffarawobjects/MvtxRawEvtHeaderv2.h>
 #include <ffarawobjects/MvtxRawHitContainerv1.h>
+#include <ffarawobjects/MvtxRawHitContainerv2.h>
 #include <ffarawobjects/MvtxRawHitv1.h>
 
 #include <frog/FROG.h>
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNodeIterator.h>  // for PHNodeIterator
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -110,6 +112,14 @@ void SingleMvtxPoolInput::FillPool(const uint64_t minBCO)
           std::cout << "starting new mvtx pool for packet " << plist[i]->getIdentifier() << std::endl;
         }
         poolmap[plist[i]->getIdentifier()] = new mvtx_pool();
+        if (m_NumDecodeThreads != 1)
+        {
+          if (!m_ThreadPool)
+          {
+            m_ThreadPool = std::make_unique<PHThreadPool>(m_NumDecodeThreads);
+          }
+          poolmap[plist[i]->getIdentifier()]->set_thread_pool(m_ThreadPool.get());
+        }
       }
       poolmap[plist[i]->getIdentifier()]->addPacket(plist[i]);
       delete plist[i];
@@ -406,7 +416,14 @@ void SingleMvtxPoolInput::CreateDSTNode(PHCompositeNode *topNode)
   MvtxRawHitContainer *mvtxhitcont = findNode::getClass<MvtxRawHitContainer>(detNode, m_rawHitContainerName);
   if (!mvtxhitcont)
   {
-    mvtxhitcont = new MvtxRawHitContainerv1();
+    if (m_PackedHitContainer)
+    {
+      mvtxhitcont = new MvtxRawHitContainerv2();
+    }
+    else
+    {
+      mvtxhitcont = new MvtxRawHitContainerv1();
+    }
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(mvtxhitcont, m_rawHitContainerName, "PHObject");
     detNode->addNode(newNode);
   }
@@ -1,14 +1,17 @@
 #ifndef FUN4ALLRAW_SINGLEMVTXPOOLINPUT_H
 #define FUN4ALLRAW_SINGLEMVTXPOOLINPUT_H
 
+#include "BcoRingBuffer.h"
 #include "SingleStreamingInput.h"
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <vector>
 
 class MvtxRawHit;
 class Packet;
+class PHThreadPool;
 class mvtx_pool;
 
 class SingleMvtxPoolInput : public SingleStreamingInput
@@ -35,6 +38,12 @@ class SingleMvtxPoolInput : public SingleStreamingInput
   void  SetStrobeWidth(const float val) { m_strobeWidth = val; }
   float GetStrobeWidth() { return m_strobeWidth; }
 
+  //! number of threads used to decode the GBT links of each packet, 0 uses all cores
+  void SetNumDecodeThreads(const unsigned int n) { m_NumDecodeThreads = n; }
+
+  //! store raw hits in a MvtxRawHitContainerv2, with the pixels packed per chip readout
+  void SetPackedHitContainer(const bool b) { m_PackedHitContainer = b; }
+
  protected:
  private:
   Packet **plist{nullptr};
@@ -43,7 +52,7 @@ class SingleMvtxPoolInput : public SingleStreamingInput
   unsigned int m_NegativeBco{0};
   std::string m_rawEventHeaderName = "MVTXRAWEVTHEADER";
 
-  std::map<uint64_t, std::vector<MvtxRawHit *>> m_MvtxRawHitMap;
+  BcoRingBuffer<std::vector<MvtxRawHit *>> m_MvtxRawHitMap;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::map<int, uint64_t> m_FeeStrobeMap;
   std::set<uint64_t> m_BclkStack;
@@ -52,6 +61,10 @@ class SingleMvtxPoolInput : public SingleStreamingInput
 
   bool m_readStrWidthFromDB = true;
   float m_strobeWidth = 0;
+  bool m_PackedHitContainer{false};
+
+  unsigned int m_NumDecodeThreads{1};
+  std::unique_ptr<PHThreadPool> m_ThreadPool;
 };
 
 #endif
@@ -12,6 +12,8 @@
 #include <utility>  // for pair
 #include <vector>
 
+template <typename T>
+class BackgroundFileOpener;
 class Eventiterator;
 class Fun4AllPrdfInputPoolManager;
 class Packet;
@@ -45,6 +47,7 @@ class SinglePrdfInput : public Fun4AllBase, public InputFileHandler
     unsigned int EventFoundCounter = 0;
   };
   Eventiterator *m_EventIterator = nullptr;
+  BackgroundFileOpener<Eventiterator> *m_NextFile = nullptr;
   Fun4AllPrdfInputPoolManager *m_InputMgr = nullptr;
   Packet **plist = nullptr;
   unsigned int m_NumSpecialEvents = 0;
@@ -1,5 +1,7 @@
 #include "SingleStreamingInput.h"
 
+#include "PrdfBackgroundOpener.h"
+
 #include <frog/FROG.h>
 
 #include <phool/phool.h>
@@ -19,6 +21,7 @@ SingleStreamingInput::SingleStreamingInput(const std::string &name)
 
 SingleStreamingInput::~SingleStreamingInput()
 {
+  delete m_NextFile;
   delete m_EventIterator;
 }
 
@@ -33,14 +36,29 @@ int SingleStreamingInput::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  std::string fname = frog.location(FileName());
+  // file opened on a background thread while the previous one was read
+  BackgroundFileOpener<Eventiterator>::Result prepared;
+  if (m_NextFile)
+  {
+    prepared = m_NextFile->take(FileName());
+  }
   if (Verbosity() > 0)
   {
-    std::cout << Name() << ": opening file " << FileName() << std::endl;
+    std::cout << Name() << ": opening file " << FileName()
+              << (prepared.second ? " (opened in background)" : "") << std::endl;
   }
+  std::string fname = prepared.first;
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (prepared.second)
+  {
+    m_EventIterator = prepared.second.release();
+  }
+  else
+  {
+    FROG frog;
+    fname = frog.location(FileName());
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   m_EventsThisFile = 0;
   if (status)
   {
@@ -51,6 +69,10 @@ int SingleStreamingInput::fileopen(const std::string &filenam)
   }
   IsOpen(1);
   AddToFileOpened(fname);  // add file to the list of files which were opened
+  if (OpenNextFileInBackground())
+  {
+    OpenPrdfInBackground(m_NextFile, NextFileName());
+  }
   return 0;
 }
 
@@ -9,6 +9,8 @@
 #include <set>
 #include <string>
 
+template <typename T>
+class BackgroundFileOpener;
 class Eventiterator;
 class Fun4AllEvtInputPoolManager;
 class Fun4AllStreamingInputManager;
@@ -112,6 +114,7 @@ class SingleStreamingInput : public Fun4AllBase, public InputFileHandler
 
  private:
   Eventiterator *m_EventIterator{nullptr};
+  BackgroundFileOpener<Eventiterator> *m_NextFile{nullptr};
   //  Fun4AllEvtInputPoolManager *m_InputMgr {nullptr};
   Fun4AllStreamingInputManager *m_StreamingInputMgr{nullptr};
   uint64_t m_MaxBclkSpread{1000000};
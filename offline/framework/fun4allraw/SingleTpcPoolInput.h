@@ -1,6 +1,7 @@
 #ifndef FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 #define FUN4ALLRAW_SINGLETPCPOOLINPUT_H
 
+#include "BcoRingBuffer.h"
 #include "SingleStreamingInput.h"
 
 #include <array>
@@ -37,12 +38,14 @@ class SingleTpcPoolInput : public SingleStreamingInput
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
   unsigned int m_max_tpc_time_samples{425};
+  //! number of waveforms dropped since the last "too many hits" printout
+  int m_too_many_hits_count{0};
   bool m_skipEarlyEvents{true};
   //! map bco to packet
   std::map<unsigned int, uint64_t> m_packet_bco;
 
   std::map<uint64_t, std::set<int>> m_BeamClockFEE;
-  std::map<uint64_t, std::vector<TpcRawHit *>> m_TpcRawHitMap;
+  BcoRingBuffer<std::vector<TpcRawHit *>> m_TpcRawHitMap;
   std::map<int, uint64_t> m_FEEBclkMap;
   std::set<uint64_t> m_BclkStack;
 };
@@ -5,6 +5,7 @@
 #include "InputManagerType.h"
 
 #include <ffarawobjects/TpcRawHitContainerv3.h>
+#include <ffarawobjects/TpcRawHitContainerv4.h>
 #include <ffarawobjects/TpcRawHitv3.h>
 
 #include <frog/FROG.h>
@@ -373,7 +374,14 @@ void SingleTpcTimeFrameInput::CreateDSTNode(PHCompositeNode *topNode)
   TpcRawHitContainer *tpchitcont = findNode::getClass<TpcRawHitContainer>(detNode, m_rawHitContainerName);
   if (!tpchitcont)
   {
-    tpchitcont = new TpcRawHitContainerv3();
+    if (m_ContiguousHitContainer)
+    {
+      tpchitcont = new TpcRawHitContainerv4();
+    }
+    else
+    {
+      tpchitcont = new TpcRawHitContainerv3();
+    }
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(tpchitcont, m_rawHitContainerName, "PHObject");
     detNode->addNode(newNode);
   }
@@ -39,6 +39,9 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
 
   void AddPacketID(const int packetID) { m_SelectedPacketIDs.insert(packetID); }
 
+  //! store raw hits in a TpcRawHitContainerv4, with all waveforms in one contiguous buffer
+  void SetContiguousHitContainer(const bool b) { m_ContiguousHitContainer = b; }
+
  private:
   const int NTPCPACKETS = 3;
 
@@ -46,6 +49,7 @@ class SingleTpcTimeFrameInput : public SingleStreamingInput
   unsigned int m_NumSpecialEvents{0};
   unsigned int m_BcoRange{0};
   unsigned int m_NegativeBco{0};
+  bool m_ContiguousHitContainer{false};
 
   //! packet ID -> TimeFrame builder
   std::map<int, TpcTimeFrameBuilder *> m_TpcTimeFrameBuilderMap;
@@ -1,10 +1,15 @@
 #include "SingleTriggerInput.h"
 
+#include "PrdfBackgroundOpener.h"
+
 #include <frog/FROG.h>
 
-#include <ffarawobjects/CaloPacket.h>
+#include <ffarawobjects/CaloPacketv1.h>
+#include <ffarawobjects/OfflinePacket.h>
 #include <phool/phool.h>
 
+#include <Event/Event.h>
+#include <Event/EventTypes.h>
 #include <Event/Eventiterator.h>
 #include <Event/fileEventiterator.h>
 #include <Event/packet.h>
@@ -13,6 +18,7 @@
 
 #include <cstdint>   // for uint64_t
 #include <iostream>  // for operator<<, basic_ostream, endl
+#include <memory>
 #include <set>
 #include <utility>  // for pair
 #include <vector>
@@ -24,6 +30,8 @@ SingleTriggerInput::SingleTriggerInput(const std::string &name)
 
 SingleTriggerInput::~SingleTriggerInput()
 {
+  StopReadAhead();
+  delete m_NextFile;
   for (auto &openfiles : m_PacketDumpFile)
   {
     openfiles.second->close();
@@ -31,6 +39,10 @@ SingleTriggerInput::~SingleTriggerInput()
   }
   m_PacketDumpFile.clear();
   delete m_EventIterator;
+  for (auto *pkt : m_CaloPacketPool)
+  {
+    delete pkt;
+  }
 }
 
 int SingleTriggerInput::fileopen(const std::string &filenam)
@@ -44,14 +56,29 @@ int SingleTriggerInput::fileopen(const std::string &filenam)
     fileclose();
   }
   FileName(filenam);
-  FROG frog;
-  std::string fname = frog.location(FileName());
+  // file opened on a background thread while the previous one was read
+  BackgroundFileOpener<Eventiterator>::Result prepared;
+  if (m_NextFile)
+  {
+    prepared = m_NextFile->take(FileName());
+  }
   if (Verbosity() > 0)
   {
-    std::cout << Name() << ": opening file " << FileName() << std::endl;
+    std::cout << Name() << ": opening file " << FileName()
+              << (prepared.second ? " (opened in background)" : "") << std::endl;
   }
+  std::string fname = prepared.first;
   int status = 0;
-  m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  if (prepared.second)
+  {
+    m_EventIterator = prepared.second.release();
+  }
+  else
+  {
+    FROG frog;
+    fname = frog.location(FileName());
+    m_EventIterator = new fileEventiterator(fname.c_str(), status);
+  }
   m_EventsThisFile = 0;
   if (status)
   {
@@ -62,6 +89,10 @@ int SingleTriggerInput::fileopen(const std::string &filenam)
   }
   IsOpen(1);
   AddToFileOpened(fname);  // add file to the list of files which were opened
+  if (OpenNextFileInBackground())
+  {
+    OpenPrdfInBackground(m_NextFile, NextFileName());
+  }
   return 0;
 }
 
@@ -365,3 +396,190 @@ int SingleTriggerInput::SetFEMEventRefPacketId(const int pktid)
   gSystem->Exit(1);
   exit(1);
 }
+
+bool SingleTriggerInput::ReadAndDecode(DecodedEvent &event)
+{
+  while (GetEventiterator() == nullptr)  // at startup this is a null pointer
+  {
+    if (!OpenNextFile())
+    {
+      return false;
+    }
+  }
+  while (true)
+  {
+    std::unique_ptr<Event> evt(GetEventiterator()->getNextEvent());
+    while (!evt)
+    {
+      fileclose();
+      if (!OpenNextFile())
+      {
+        return false;
+      }
+      evt.reset(GetEventiterator()->getNextEvent());
+    }
+    if (Verbosity() > 2)
+    {
+      std::cout << PHWHERE << "Fetching next Event" << evt->getEvtSequence() << std::endl;
+    }
+    event.RunNumber = evt->getRunNumber();
+    if (GetVerbosity() > 1)
+    {
+      evt->identify();
+    }
+    if (evt->getEvtType() != DATAEVENT)
+    {
+      event.NumSpecialEvents++;
+      continue;
+    }
+    event.EventSequence = evt->getEvtSequence();
+    if (event.EventSequence < SkipToEvent())
+    {
+      continue;
+    }
+    std::vector<Packet *> pktvec = evt->getPacketVector();
+    for (auto packet : pktvec)
+    {
+      if (Verbosity() > 2)
+      {
+        packet->identify();
+      }
+      if (OfflinePacket *newpacket = DecodePacket(packet))
+      {
+        event.Packets.push_back(newpacket);
+      }
+      // no read ahead with ddump, this runs on the main thread
+      if (ddump_enabled())
+      {
+        ddumppacket(packet);
+      }
+      delete packet;
+    }
+    return true;
+  }
+}
+
+void SingleTriggerInput::ReadAheadLoop()
+{
+  while (true)
+  {
+    DecodedEvent event;
+    const bool more = ReadAndDecode(event);
+    std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+    if (!more)
+    {
+      m_ReadAheadSpecialEvents = event.NumSpecialEvents;
+      m_ReadAheadDone = true;
+      m_ReadAheadCondition.notify_all();
+      return;
+    }
+    // bounded buffer, wait until the manager took some events
+    m_ReadAheadCondition.wait(lock, [this]
+                              { return m_ReadAheadStop || m_ReadAheadQueue.size() < m_ReadAheadDepth; });
+    if (m_ReadAheadStop)
+    {
+      for (auto *pkt : event.Packets)
+      {
+        delete pkt;
+      }
+      return;
+    }
+    m_ReadAheadQueue.push_back(std::move(event));
+    m_ReadAheadCondition.notify_all();
+  }
+}
+
+bool SingleTriggerInput::NextDecodedEvent(DecodedEvent &event)
+{
+  event = DecodedEvent();
+  bool found = false;
+  if (m_ReadAheadDepth == 0 || ddump_enabled())
+  {
+    found = ReadAndDecode(event);
+  }
+  else
+  {
+    if (!m_ReadAheadThread.joinable() && !m_ReadAheadDone)
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << Name() << ": reading " << m_ReadAheadDepth << " events ahead" << std::endl;
+      }
+      m_ReadAheadThread = std::thread(&SingleTriggerInput::ReadAheadLoop, this);
+    }
+    std::unique_lock<std::mutex> lock(m_ReadAheadMutex);
+    m_ReadAheadCondition.wait(lock, [this]
+                              { return !m_ReadAheadQueue.empty() || m_ReadAheadDone; });
+    if (!m_ReadAheadQueue.empty())
+    {
+      event = std::move(m_ReadAheadQueue.front());
+      m_ReadAheadQueue.pop_front();
+      m_ReadAheadCondition.notify_all();
+      found = true;
+    }
+    else
+    {
+      event.NumSpecialEvents = m_ReadAheadSpecialEvents;
+      m_ReadAheadSpecialEvents = 0;
+    }
+  }
+  m_NumSpecialEvents += event.NumSpecialEvents;
+  if (found)
+  {
+    RunNumber(event.RunNumber);
+  }
+  return found;
+}
+
+void SingleTriggerInput::StopReadAhead()
+{
+  if (!m_ReadAheadThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_ReadAheadMutex);
+    m_ReadAheadStop = true;
+  }
+  m_ReadAheadCondition.notify_all();
+  m_ReadAheadThread.join();
+  for (auto &event : m_ReadAheadQueue)
+  {
+    for (auto *pkt : event.Packets)
+    {
+      delete pkt;
+    }
+  }
+  m_ReadAheadQueue.clear();
+}
+
+CaloPacket *SingleTriggerInput::NewCaloPacket()
+{
+  CaloPacket *pkt = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(m_CaloPacketPoolMutex);
+    if (!m_CaloPacketPool.empty())
+    {
+      pkt = m_CaloPacketPool.back();
+      m_CaloPacketPool.pop_back();
+    }
+  }
+  if (pkt)
+  {
+    pkt->Reset();
+    return pkt;
+  }
+  return new CaloPacketv1();
+}
+
+void SingleTriggerInput::RecycleCaloPacket(OfflinePacket *pkt)
+{
+  CaloPacket *calopkt = dynamic_cast<CaloPacket *>(pkt);
+  if (!calopkt)
+  {
+    delete pkt;
+    return;
+  }
+  std::lock_guard<std::mutex> lock(m_CaloPacketPoolMutex);
+  m_CaloPacketPool.push_back(calopkt);
+}
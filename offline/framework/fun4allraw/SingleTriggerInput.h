@@ -4,14 +4,21 @@
 #include <fun4all/Fun4AllBase.h>
 #include <fun4all/InputFileHandler.h>
 
+#include <condition_variable>
 #include <cstdint>  // for uint64_t
+#include <deque>
 #include <fstream>
 #include <limits>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <vector>
 
+template <typename T>
+class BackgroundFileOpener;
+class CaloPacket;
 class Eventiterator;
 class Fun4AllPrdfInputTriggerManager;
 class OfflinePacket;
@@ -58,9 +65,32 @@ class SingleTriggerInput : public Fun4AllBase, public InputFileHandler
   virtual int LastEvent() const { return m_LastEvent; }
   virtual int SetFEMEventRefPacketId(const int pktid);
   virtual int FEMEventRefPacketId() const {return  m_FEMEventRefPacketId;}
+  //! read and decode up to depth events ahead on a separate thread, 0 reads on the main thread.
+  //! Only inputs which implement DecodePacket support this
+  virtual void ReadAhead(const unsigned int depth) { m_ReadAheadDepth = depth; }
+  virtual unsigned int ReadAhead() const { return m_ReadAheadDepth; }
   // these ones are used directly by the derived classes, maybe later
   // move to cleaner accessors
  protected:
+  //! data event with its decoded packets, the event number is not corrected
+  struct DecodedEvent
+  {
+    int RunNumber{0};
+    int EventSequence{0};
+    unsigned int NumSpecialEvents{0};  // skipped special events before this one
+    std::vector<OfflinePacket *> Packets;
+  };
+  //! convert a raw packet, runs on the read ahead thread so it must not change the state of the input
+  virtual OfflinePacket *DecodePacket(Packet * /*packet*/) { return nullptr; }
+  //! next data event at or after SkipToEvent, from the read ahead thread or the file. False if all files are read
+  bool NextDecodedEvent(DecodedEvent &event);
+  //! stop the read ahead thread, must be called in the destructor of inputs using it
+  void StopReadAhead();
+  //! reset CaloPacket from the pool of this input or a new one, can be called from the read ahead thread
+  CaloPacket *NewCaloPacket();
+  //! give a CaloPacket back to the pool instead of deleting it
+  void RecycleCaloPacket(OfflinePacket *pkt);
+
   std::map<int, std::vector<OfflinePacket *>> m_PacketMap;
   unsigned int m_NumSpecialEvents{0};
   std::set<int> m_EventNumber;
@@ -69,6 +99,7 @@ class SingleTriggerInput : public Fun4AllBase, public InputFileHandler
   // we have accessors for these here
  private:
   Eventiterator *m_EventIterator{nullptr};
+  BackgroundFileOpener<Eventiterator> *m_NextFile{nullptr};
   Fun4AllPrdfInputTriggerManager *m_TriggerInputMgr{nullptr};
   int m_ddump_flag{0};
   int m_RunNumber{0};
@@ -86,6 +117,22 @@ class SingleTriggerInput : public Fun4AllBase, public InputFileHandler
   std::map<int, std::ofstream *> m_PacketDumpFile;
   std::map<int, int> m_PacketDumpCounter;
   std::map<int, int> m_EventNumberOffset;  // packet wise event number offset
+
+  //! read ahead
+  bool ReadAndDecode(DecodedEvent &event);
+  void ReadAheadLoop();
+  unsigned int m_ReadAheadDepth{0};
+  std::thread m_ReadAheadThread;
+  std::mutex m_ReadAheadMutex;
+  std::condition_variable m_ReadAheadCondition;
+  std::deque<DecodedEvent> m_ReadAheadQueue;
+  unsigned int m_ReadAheadSpecialEvents{0};  // special events after the last data event
+  bool m_ReadAheadDone{false};
+  bool m_ReadAheadStop{false};
+
+  //! used CaloPackets, the 32kB sample arrays are reused instead of reallocated for every event
+  std::mutex m_CaloPacketPoolMutex;
+  std::vector<CaloPacket *> m_CaloPacketPool;
 };
 
 #endif
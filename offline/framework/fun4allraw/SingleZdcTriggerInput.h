@@ -30,6 +30,7 @@ class SingleZdcTriggerInput : public SingleTriggerInput
   int ClockReferencePacket() const { return m_ClockReferencePacket; }
 
  private:
+  OfflinePacket *DecodePacket(Packet *packet) override;
   void CheckFEMEventNumber();
   int ShiftEvents(int pktid, int offset);
   int m_ClockReferencePacket{0};
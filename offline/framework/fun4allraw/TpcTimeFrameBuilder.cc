@@ -18,6 +18,7 @@
 #include <TString.h>
 #include <TVector3.h>
 
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <limits>
@@ -26,6 +27,72 @@
 
 using namespace std;
 
+namespace
+{
+  //! byte lookup table for the FEE CRC16, polynomial 0x8005, most significant bit first
+  /*!
+   * the FEE checksum is a reflected CRC16 (0xa001) over bit-reversed words, with the
+   * result bit-reversed again. This is identical to the non reflected CRC16 (0x8005)
+   * over the words as they are, which removes both bit reversals and processes one
+   * byte per table lookup instead of one bit per iteration
+   */
+  constexpr std::array<uint16_t, 256> make_crc16_table()
+  {
+    std::array<uint16_t, 256> table{};
+    for (unsigned int i = 0; i < 256; ++i)
+    {
+      auto crc = static_cast<uint16_t>(i << 8U);
+      for (int k = 0; k < 8; ++k)
+      {
+        crc = (crc & 0x8000U) ? static_cast<uint16_t>(crc << 1U) ^ 0x8005U : static_cast<uint16_t>(crc << 1U);
+      }
+      table[i] = crc;
+    }
+    return table;
+  }
+
+  constexpr std::array<uint16_t, 256> crc16_table = make_crc16_table();
+
+  //! byte bit reversal table
+  constexpr std::array<uint8_t, 256> make_reverse_table()
+  {
+    std::array<uint8_t, 256> table{};
+    for (unsigned int i = 0; i < 256; ++i)
+    {
+      uint8_t value = 0;
+      for (int k = 0; k < 8; ++k)
+      {
+        if (i & (1U << k))
+        {
+          value |= static_cast<uint8_t>(1U << (7 - k));
+        }
+      }
+      table[i] = value;
+    }
+    return table;
+  }
+
+  constexpr std::array<uint8_t, 256> reverse_table = make_reverse_table();
+
+  //! parity of the 10 bit payload of each data word
+  constexpr std::array<uint8_t, 1024> make_parity_table()
+  {
+    std::array<uint8_t, 1024> table{};
+    for (unsigned int i = 0; i < 1024; ++i)
+    {
+      uint8_t parity = 0;
+      for (unsigned int word = i; word; word >>= 1U)
+      {
+        parity ^= word & 1U;
+      }
+      table[i] = parity;
+    }
+    return table;
+  }
+
+  constexpr std::array<uint8_t, 1024> parity_table = make_parity_table();
+}  // namespace
+
 TpcTimeFrameBuilder::TpcTimeFrameBuilder(const int packet_id)
   : m_packet_id(packet_id)
   , m_HistoPrefix("TpcTimeFrameBuilder_Packet" + to_string(packet_id))
@@ -986,18 +1053,16 @@ int TpcTimeFrameBuilder::decode_gtm_data(const TpcTimeFrameBuilder::dma_word& gt
 
 uint16_t TpcTimeFrameBuilder::reverseBits(const uint16_t x) const
 {
-  uint16_t n = x;
-  n = (static_cast<uint16_t>(n >> 1U) & 0x55555555U) | (static_cast<uint16_t>(n << 1U) & 0xaaaaaaaaU);
-  n = (static_cast<uint16_t>(n >> 2U) & 0x33333333U) | (static_cast<uint16_t>(n << 2U) & 0xccccccccU);
-  n = (static_cast<uint16_t>(n >> 4U) & 0x0f0f0f0fU) | (static_cast<uint16_t>(n << 4U) & 0xf0f0f0f0U);
-  n = (static_cast<uint16_t>(n >> 8U) & 0x00ff00ffU) | (static_cast<uint16_t>(n << 8U) & 0xff00ff00U);
-  // n = (n >> 16U) & 0x0000ffffU | (n << 16U) & 0xffff0000U;
-  return n;
+  return static_cast<uint16_t>(reverse_table[x & 0xffU] << 8U) | reverse_table[x >> 8U];
 }
 
 std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t fee, const uint16_t l) const
 {
-  const std::deque<uint16_t>& data_buffer = m_feeData[fee];
+  return crc16_parity(m_feeData[fee], l);
+}
+
+std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const std::deque<uint16_t>& data_buffer, const uint16_t l)
+{
   assert(l < data_buffer.size());
 
   std::deque<uint16_t>::const_iterator it = data_buffer.begin();
@@ -1009,25 +1074,17 @@ std::pair<uint16_t, uint16_t> TpcTimeFrameBuilder::crc16_parity(const uint32_t f
   {
     const uint16_t& x = *it;
 
-    crc ^= reverseBits(x);
-    for (uint16_t k = 0; k < 16U; k++)
-    {
-      crc = crc & 1U ? static_cast<uint16_t>(crc >> 1U) ^ 0xa001U : crc >> 1U;
-    }
+    // see make_crc16_table for why no bit reversal is needed
+    crc ^= x;
+    crc = static_cast<uint16_t>(crc << 8U) ^ crc16_table[crc >> 8U];
+    crc = static_cast<uint16_t>(crc << 8U) ^ crc16_table[crc >> 8U];
 
     // parity on data payload only
     if (i >= HEADER_LENGTH)
     {
-      // fast parity
-      uint16_t word = x & uint16_t((1U << 10U) - 1U);
-      word = word ^ static_cast<uint16_t>(word >> 1U);
-      word = word ^ static_cast<uint16_t>(word >> 2U);
-      word = word ^ static_cast<uint16_t>(word >> 4U);
-      word = word ^ static_cast<uint16_t>(word >> 8U);
-      data_parity ^= word & 1U;
+      data_parity ^= parity_table[x & 0x3ffU];
     }
   }
-  crc = reverseBits(crc);
   return make_pair(crc, data_parity);
 }
 
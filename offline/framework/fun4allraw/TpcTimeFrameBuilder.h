@@ -40,6 +40,9 @@ class TpcTimeFrameBuilder
     m_fastBCOSkip = fastBCOSkip;
   }
 
+  //! crc16 of the first l words of a FEE packet and parity of its payload
+  static std::pair<uint16_t, uint16_t> crc16_parity(const std::deque<uint16_t>& data_buffer, const uint16_t l);
+
  protected:
   // Length for the 256-bit wide Round Robin Multiplexer for the data stream
   static const size_t DAM_DMA_WORD_LENGTH = 16;
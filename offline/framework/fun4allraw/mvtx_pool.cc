@@ -6,6 +6,8 @@
 #include <Event/packet.h>
 #include "mvtx_decoder/RDH.h"
 
+#include <phool/PHThreadPool.h>
+
 using namespace std;
 
 //_________________________________________________
@@ -224,6 +226,14 @@ int mvtx_pool::mvtx_decode()
   }
   m_is_decoded = true;
 
+  if (m_thread_pool && mGBTLinks.size() > 1)
+  {
+    // links are independent: each owns its raw data, hit buffers and decoding statistics
+    m_thread_pool->parallel_for(mGBTLinks.size(), [this](size_t i)
+                                { mGBTLinks[i].collectROFCableData(); });
+    return 0;
+  }
+
   for (auto& link : mGBTLinks)
   {
     link.collectROFCableData();
@@ -12,6 +12,7 @@
 #include <cstdint>
 
 class Packet;
+class PHThreadPool;
 
 class mvtx_pool {
 
@@ -48,6 +49,9 @@ class mvtx_pool {
   void set_verbosity(const int val) { verbosity = val; }
   int  get_verbosity() { return verbosity; }
 
+  //! decode the GBT links of a packet in parallel on this pool. Not owned
+  void set_thread_pool(PHThreadPool* pool) { m_thread_pool = pool; }
+
  protected:
    uint32_t get_linkId(const uint16_t i);
 
@@ -72,6 +76,8 @@ class mvtx_pool {
 
   uint8_t* payload = nullptr;
   unsigned int payload_position = 0;
+
+  PHThreadPool* m_thread_pool = nullptr;
 };
 
 #endif /* __MVTX_POOL_H__ */
@@ -0,0 +1,201 @@
+#include "ModuleBenchmark.h"
+
+#include <fun4all/Fun4AllMemoryTracker.h>
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
+#include <fun4all/SubsysReco.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHObject.h>
+#include <phool/getClass.h>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+ModuleBenchmark::ModuleBenchmark(SubsysReco *module, const std::string &name)
+  : SubsysReco(name)
+  , m_Module(module)
+{
+}
+
+ModuleBenchmark::~ModuleBenchmark()
+{
+  delete m_Module;
+}
+
+int ModuleBenchmark::Init(PHCompositeNode *topNode)
+{
+  if (!m_Module)
+  {
+    std::cout << Name() << ": no module to benchmark" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  return m_Module->Init(topNode);
+}
+
+int ModuleBenchmark::InitRun(PHCompositeNode *topNode)
+{
+  const int iret = m_Module->InitRun(topNode);
+  m_StartRSS = Fun4AllMemoryTracker::instance()->GetRSSMemory();
+  m_PeakRSS = std::max(m_PeakRSS, m_StartRSS);
+  return iret;
+}
+
+int ModuleBenchmark::process_event(PHCompositeNode *topNode)
+{
+  double walltime = 0;
+  double cputime = 0;
+  int iret = Fun4AllReturnCodes::EVENT_OK;
+  for (unsigned int irep = 0; irep < m_Repetitions; ++irep)
+  {
+    if (irep > 0)
+    {
+      for (const auto &nodename : m_ResetNodes)
+      {
+        PHObject *object = findNode::getClass<PHObject>(topNode, nodename);
+        if (object)
+        {
+          object->Reset();
+        }
+      }
+    }
+    const auto wallstart = std::chrono::steady_clock::now();
+    const std::clock_t cpustart = std::clock();
+    iret = m_Module->process_event(topNode);
+    cputime += 1000. * (std::clock() - cpustart) / CLOCKS_PER_SEC;
+    walltime += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallstart).count();
+    m_PeakRSS = std::max<long>(m_PeakRSS, Fun4AllMemoryTracker::instance()->GetRSSMemory());
+    if (iret != Fun4AllReturnCodes::EVENT_OK)
+    {
+      break;
+    }
+  }
+
+  ++m_NEvents;
+  if (m_NEvents > m_WarmupEvents && iret == Fun4AllReturnCodes::EVENT_OK)
+  {
+    m_WallTimes.push_back(walltime / m_Repetitions);
+    m_CpuTimes.push_back(cputime / m_Repetitions);
+    if (Verbosity() > 0)
+    {
+      std::cout << Name() << ": " << m_Module->Name() << " event " << m_NEvents << " wall " << m_WallTimes.back()
+                << " ms, cpu " << m_CpuTimes.back() << " ms" << std::endl;
+    }
+  }
+  return iret;
+}
+
+int ModuleBenchmark::ResetEvent(PHCompositeNode *topNode)
+{
+  return m_Module->ResetEvent(topNode);
+}
+
+int ModuleBenchmark::EndRun(const int runnumber)
+{
+  return m_Module->EndRun(runnumber);
+}
+
+int ModuleBenchmark::End(PHCompositeNode *topNode)
+{
+  const int iret = m_Module->End(topNode);
+  WriteJson();
+  return iret;
+}
+
+ModuleBenchmark::Stats ModuleBenchmark::Statistics(std::vector<double> values)
+{
+  Stats stats;
+  if (values.empty())
+  {
+    return stats;
+  }
+  std::sort(values.begin(), values.end());
+  const double n = values.size();
+  double sum = 0;
+  double sum2 = 0;
+  for (const double value : values)
+  {
+    sum += value;
+    sum2 += value * value;
+  }
+  stats.mean = sum / n;
+  stats.stddev = values.size() > 1 ? std::sqrt(std::max(0., (sum2 - n * stats.mean * stats.mean) / (n - 1))) : 0;
+  // quantiles interpolated between the sorted values
+  auto quantile = [&values](const double q)
+  {
+    const double pos = q * (values.size() - 1);
+    const size_t index = static_cast<size_t>(pos);
+    if (index + 1 >= values.size())
+    {
+      return values.back();
+    }
+    return values[index] + (pos - index) * (values[index + 1] - values[index]);
+  };
+  stats.median = quantile(0.5);
+  stats.q90 = quantile(0.9);
+  stats.min = values.front();
+  stats.max = values.back();
+  return stats;
+}
+
+void ModuleBenchmark::WriteJson() const
+{
+  std::ofstream out(m_JsonFileName);
+  if (!out.is_open())
+  {
+    std::cout << Name() << ": could not open " << m_JsonFileName << std::endl;
+    return;
+  }
+  std::vector<std::string> inputs;
+  Fun4AllServer::instance()->GetInputFullFileList(inputs);
+
+  // process high water mark of the resident memory, kB on Linux
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+
+  const Stats wall = Statistics(m_WallTimes);
+  const Stats cpu = Statistics(m_CpuTimes);
+
+  // module, node and file names are written as they are, no escaping needed
+  out << "{\n"
+      << "  \"module\": \"" << m_Module->Name() << "\",\n"
+      << "  \"inputs\": [";
+  for (size_t i = 0; i < inputs.size(); ++i)
+  {
+    out << (i ? ", " : "") << "\"" << inputs[i] << "\"";
+  }
+  out << "],\n"
+      << "  \"warmup_events\": " << m_WarmupEvents << ",\n"
+      << "  \"repetitions\": " << m_Repetitions << ",\n"
+      << "  \"events\": " << m_WallTimes.size() << ",\n";
+  for (const auto &[label, stats] : {std::make_pair("wall", wall), std::make_pair("cpu", cpu)})
+  {
+    out << "  \"" << label << "_ms\": {"
+        << "\"mean\": " << stats.mean << ", "
+        << "\"stddev\": " << stats.stddev << ", "
+        << "\"median\": " << stats.median << ", "
+        << "\"q90\": " << stats.q90 << ", "
+        << "\"min\": " << stats.min << ", "
+        << "\"max\": " << stats.max << "},\n";
+  }
+  out << "  \"rss_start_kb\": " << m_StartRSS << ",\n"
+      << "  \"rss_peak_kb\": " << m_PeakRSS << ",\n"
+      << "  \"maxrss_process_kb\": " << usage.ru_maxrss << ",\n"
+      << "  \"wall_per_event_ms\": [";
+  for (size_t i = 0; i < m_WallTimes.size(); ++i)
+  {
+    out << (i ? ", " : "") << m_WallTimes[i];
+  }
+  out << "]\n}\n";
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": " << m_Module->Name() << " " << m_WallTimes.size() << " events, wall time mean "
+              << wall.mean << " ms, median " << wall.median << " ms, peak rss " << m_PeakRSS << " kB" << std::endl;
+  }
+}
@@ -0,0 +1,94 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef FUN4ALLUTILS_MODULEBENCHMARK_H
+#define FUN4ALLUTILS_MODULEBENCHMARK_H
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+#include <vector>
+
+class PHCompositeNode;
+
+//! benchmark of a single module on canned input events
+/*!
+  Runs the module on every input event, the first events are warm-up
+  only, the time of the others goes into the statistics. The module is
+  owned by ModuleBenchmark and must not be registered with the server.
+  The input is a short DST with the nodes the module needs, e.g.
+
+    ModuleBenchmark *bench = new ModuleBenchmark(new TpcClusterizer());
+    bench->AddResetNode("TRKR_CLUSTER");
+    bench->WarmupEvents(2);
+    bench->Repetitions(5);
+    bench->JsonFileName("TpcClusterizer_benchmark.json");
+    se->registerSubsystem(bench);
+
+  With repetitions > 1 the module runs several times on each event, the
+  output nodes given with AddResetNode are reset before each repetition.
+  For modules using random numbers set the recoConsts flag RANDOMSEED,
+  so the runs are reproducible.
+
+  The json file (written in End) has the settings, the input files, the
+  per event wall and cpu time, their mean, standard deviation, median,
+  90% quantile, min and max, and the peak resident memory, so results
+  can be compared between releases.
+*/
+class ModuleBenchmark : public SubsysReco
+{
+ public:
+  explicit ModuleBenchmark(SubsysReco *module, const std::string &name = "ModuleBenchmark");
+
+  //! deletes the benchmarked module
+  ~ModuleBenchmark() override;
+
+  int Init(PHCompositeNode *topNode) override;
+  int InitRun(PHCompositeNode *topNode) override;
+  int process_event(PHCompositeNode *topNode) override;
+  int ResetEvent(PHCompositeNode *topNode) override;
+  int EndRun(const int runnumber) override;
+  int End(PHCompositeNode *topNode) override;
+
+  //! output node of the module which is reset before each repetition
+  void AddResetNode(const std::string &name) { m_ResetNodes.push_back(name); }
+
+  //! events which are processed but not counted (default 1)
+  void WarmupEvents(const unsigned int n) { m_WarmupEvents = n; }
+
+  //! number of times the module runs on each event (default 1)
+  void Repetitions(const unsigned int n) { m_Repetitions = (n > 0 ? n : 1); }
+
+  void JsonFileName(const std::string &name) { m_JsonFileName = name; }
+
+ private:
+  class Stats
+  {
+   public:
+    double mean = 0;
+    double stddev = 0;
+    double median = 0;
+    double q90 = 0;
+    double min = 0;
+    double max = 0;
+  };
+  static Stats Statistics(std::vector<double> values);
+  void WriteJson() const;
+
+  SubsysReco *m_Module = nullptr;
+  std::vector<std::string> m_ResetNodes;
+  unsigned int m_WarmupEvents = 1;
+  unsigned int m_Repetitions = 1;
+  unsigned int m_NEvents = 0;
+
+  // ms, one entry per counted event (sum over the repetitions divided by their number)
+  std::vector<double> m_WallTimes;
+  std::vector<double> m_CpuTimes;
+
+  // kB
+  long m_StartRSS = 0;
+  long m_PeakRSS = 0;
+
+  std::string m_JsonFileName = "benchmark.json";
+};
+
+#endif
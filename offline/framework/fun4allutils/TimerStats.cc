@@ -9,9 +9,13 @@
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHCounter.h>
 #include <phool/PHIODataNode.h>  // for PHIODataNode
 #include <phool/getClass.h>
 
+#include <algorithm>
+#include <fstream>
+#include <iostream>
 #include <map>  // for _Rb_tree_iterator
 
 TimerStats::TimerStats(const std::string &name)
@@ -23,6 +27,11 @@ int TimerStats::InitRun(PHCompositeNode * /*topNode*/)
 {
   delete cdbttree; // make cppcheck happy, deleting a null ptr
   cdbttree = new CDBTTree(outfilename);
+  // keep a higher level (node sizes) if the macro asked for it
+  if (!jsonfilename.empty() && !Fun4AllServer::instance()->ModuleProfiling())
+  {
+    Fun4AllServer::instance()->EnableModuleProfiling();
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -43,6 +52,53 @@ int TimerStats::process_event(PHCompositeNode *topNode)
   {
     cdbttree->SetFloatValue(iev, iter->first, iter->second.elapsed());
   }
+  if (se->ModuleProfiling())
+  {
+    for (const auto &profile : se->ModuleProfiles())
+    {
+      // skipped modules, modules after an abort and this one (which is still running)
+      if (!profile.Valid)
+      {
+        continue;
+      }
+      cdbttree->SetFloatValue(iev, profile.Name + "_cpu", profile.CpuTime);
+      cdbttree->SetIntValue(iev, profile.Name + "_rss", profile.RSSDelta);
+      cdbttree->SetFloatValue(iev, profile.Name + "_task", profile.TaskTime);
+      if (profile.Allocations > 0)
+      {
+        cdbttree->SetIntValue(iev, profile.Name + "_nalloc", profile.Allocations);
+        cdbttree->SetIntValue(iev, profile.Name + "_allockb", profile.AllocatedBytes / 1024);
+      }
+      Summary &summary = summaries[profile.Name];
+      summary.nevents++;
+      summary.wallsum += profile.WallTime;
+      summary.wallmax = std::max(summary.wallmax, profile.WallTime);
+      summary.cpusum += profile.CpuTime;
+      summary.cpumax = std::max(summary.cpumax, profile.CpuTime);
+      summary.tasksum += profile.TaskTime;
+      summary.rssmax = std::max(summary.rssmax, profile.RSSDelta);
+      summary.allocsum += profile.AllocatedBytes;
+      summary.allocmax = std::max(summary.allocmax, profile.AllocatedBytes);
+    }
+    for (const auto &[nodename, bytes] : se->NodeSizes())
+    {
+      cdbttree->SetIntValue(iev, "node_" + nodename, bytes);
+      NodeSummary &summary = nodesummaries[nodename];
+      summary.nevents++;
+      summary.bytessum += bytes;
+      summary.bytesmax = std::max(summary.bytesmax, bytes);
+    }
+    // counters of this event so far, TimerStats should be registered last
+    for (const auto &[key, counter] : *PHCounterRegistry::instance())
+    {
+      const long count = counter->Event();
+      cdbttree->SetIntValue(iev, "cnt_" + counter->Module() + "_" + counter->Name(), count);
+      CounterSummary &summary = countersummaries[key];
+      summary.nevents++;
+      summary.sum += count;
+      summary.max = std::max(summary.max, count);
+    }
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -51,5 +107,64 @@ int TimerStats::End(PHCompositeNode * /*topNode*/)
   cdbttree->Commit();
   cdbttree->WriteCDBTTree();
   delete cdbttree;
+  cdbttree = nullptr;
+  if (!jsonfilename.empty())
+  {
+    WriteJson();
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+void TimerStats::WriteJson() const
+{
+  std::ofstream out(jsonfilename);
+  if (!out.is_open())
+  {
+    std::cout << Name() << ": could not open " << jsonfilename << std::endl;
+    return;
+  }
+  // module names are plain C++ identifiers and node names, no escaping needed
+  out << "{\n  \"modules\": [";
+  bool first = true;
+  for (const auto &[name, summary] : summaries)
+  {
+    double norm = summary.nevents > 0 ? 1. / summary.nevents : 0;
+    out << (first ? "" : ",") << "\n    {"
+        << "\"name\": \"" << name << "\", "
+        << "\"events\": " << summary.nevents << ", "
+        << "\"wall_mean_ms\": " << summary.wallsum * norm << ", "
+        << "\"wall_max_ms\": " << summary.wallmax << ", "
+        << "\"cpu_mean_ms\": " << summary.cpusum * norm << ", "
+        << "\"cpu_max_ms\": " << summary.cpumax << ", "
+        << "\"task_mean_ms\": " << summary.tasksum * norm << ", "
+        << "\"rss_delta_max_kb\": " << summary.rssmax << ", "
+        << "\"alloc_mean_kb\": " << summary.allocsum * norm / 1024 << ", "
+        << "\"alloc_max_kb\": " << summary.allocmax / 1024 << "}";
+    first = false;
+  }
+  out << "\n  ],\n  \"nodes\": [";
+  first = true;
+  for (const auto &[name, summary] : nodesummaries)
+  {
+    double norm = summary.nevents > 0 ? 1. / summary.nevents : 0;
+    out << (first ? "" : ",") << "\n    {"
+        << "\"name\": \"" << name << "\", "
+        << "\"events\": " << summary.nevents << ", "
+        << "\"bytes_mean\": " << summary.bytessum * norm << ", "
+        << "\"bytes_max\": " << summary.bytesmax << "}";
+    first = false;
+  }
+  out << "\n  ],\n  \"counters\": [";
+  first = true;
+  for (const auto &[name, summary] : countersummaries)
+  {
+    double norm = summary.nevents > 0 ? 1. / summary.nevents : 0;
+    out << (first ? "" : ",") << "\n    {"
+        << "\"name\": \"" << name << "\", "
+        << "\"events\": " << summary.nevents << ", "
+        << "\"mean\": " << summary.sum * norm << ", "
+        << "\"max\": " << summary.max << "}";
+    first = false;
+  }
+  out << "\n  ]\n}\n";
+}
@@ -5,6 +5,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <map>
 #include <string>  // for string
 
 class PHCompositeNode;
@@ -19,11 +20,48 @@ class TimerStats : public SubsysReco
   int process_event(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
   void OutFileName(const std::string &name) { outfilename = name; }
+  // per module summary (mean and max wall/cpu time, max memory change, heap allocations)
+  // node sizes (module profiling 2) and module counters (PHCounter) in json format,
+  // filled from Fun4AllServer module profiling, only written if a name is given
+  void JsonFileName(const std::string &name) { jsonfilename = name; }
 
  private:
+  class Summary
+  {
+   public:
+    int nevents = 0;
+    double wallsum = 0;
+    double wallmax = 0;
+    double cpusum = 0;
+    double cpumax = 0;
+    double tasksum = 0;
+    long rssmax = 0;
+    double allocsum = 0;  // bytes
+    long allocmax = 0;
+  };
+  class NodeSummary
+  {
+   public:
+    int nevents = 0;
+    double bytessum = 0;
+    long bytesmax = 0;
+  };
+  class CounterSummary
+  {
+   public:
+    int nevents = 0;
+    double sum = 0;
+    long max = 0;
+  };
+  void WriteJson() const;
+
   CDBTTree *cdbttree = nullptr;
   int iev = 0;
   std::string outfilename = "timerstats.root";
+  std::string jsonfilename;
+  std::map<std::string, Summary> summaries;
+  std::map<std::string, NodeSummary> nodesummaries;
+  std::map<std::string, CounterSummary> countersummaries;
 };
 
 #endif
@@ -51,6 +51,7 @@ bool PHCompositeNode::addNode(PHNode* newNode)
   // No conflict, so we can append the new node.
   //
   newNode->setParent(this);
+  treeChanged();
   return (subNodes.append(newNode));
 }
 
@@ -62,6 +63,7 @@ void PHCompositeNode::prune()
   {
     if (!thisNode->isPersistent())
     {
+      treeChanged();
       subNodes.removeAt(nodeIter.pos());
       --nodeIter;
       delete thisNode;
@@ -89,12 +91,60 @@ void PHCompositeNode::forgetMe(PHNode* child)
   {
     if (thisNode == child)
     {
+      treeChanged();
       subNodes.removeAt(nodeIter.pos());
       child = nullptr;
     }
   }
 }
 
+PHNode* PHCompositeNode::findFirst(const std::string& requiredType, const std::string& requiredName)
+{
+  std::string key = requiredType;
+  key += '\n';  // not allowed in node names
+  key += requiredName;
+
+  std::lock_guard<std::mutex> lock(m_LookupMutex);
+  const uint64_t generation = treeGeneration();
+  if (generation != m_LookupGeneration)
+  {
+    m_LookupCache.clear();
+    m_LookupGeneration = generation;
+  }
+  auto iter = m_LookupCache.find(key);
+  if (iter != m_LookupCache.end())
+  {
+    return iter->second;
+  }
+  // misses are cached as well, modules often look for optional nodes every event
+  PHNode* node = searchFirst(requiredType, requiredName);
+  m_LookupCache.emplace(std::move(key), node);
+  return node;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+PHNode* PHCompositeNode::searchFirst(const std::string& requiredType, const std::string& requiredName)
+{
+  PHPointerListIterator<PHNode> iter(subNodes);
+  PHNode* thisNode;
+  while ((thisNode = iter()))
+  {
+    if ((requiredType.empty() || thisNode->getType() == requiredType) && thisNode->getName() == requiredName)
+    {
+      return thisNode;
+    }
+    if (thisNode->getType() == "PHCompositeNode")
+    {
+      PHNode* nodeFoundInSubTree = static_cast<PHCompositeNode*>(thisNode)->searchFirst(requiredType, requiredName);
+      if (nodeFoundInSubTree)
+      {
+        return nodeFoundInSubTree;
+      }
+    }
+  }
+  return nullptr;
+}
+
 bool PHCompositeNode::write(PHIOManager* IOManager, const std::string& path)
 {
   std::string newPath = name;
@@ -7,7 +7,10 @@
 #include "PHNode.h"
 #include "PHPointerList.h"
 
+#include <cstdint>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 class PHIOManager;
 
@@ -24,6 +27,14 @@ class PHCompositeNode : public PHNode
   //
   bool addNode(PHNode *);
 
+  //
+  // First node (depth first) in the sub-tree with the given name and
+  // type (any type if empty). The result is cached until any node tree
+  // changes (see PHNode::treeGeneration), so repeated lookups
+  // with the same name are a hash map access
+  //
+  PHNode *findFirst(const std::string &type, const std::string &name);
+
   //
   // This recursively calls the prune function of all the subnodes.
   // If a subnode is found to be marked as transient (non persistent)
@@ -43,6 +54,10 @@ class PHCompositeNode : public PHNode
   int deleteMe = 0;
 
  private:
+  PHNode *searchFirst(const std::string &type, const std::string &name);
+  std::mutex m_LookupMutex;
+  std::unordered_map<std::string, PHNode *> m_LookupCache;
+  uint64_t m_LookupGeneration = 0;
   PHCompositeNode() = delete;
 };
 
@@ -0,0 +1,31 @@
+#include "PHCounter.h"
+
+PHCounterRegistry *PHCounterRegistry::instance()
+{
+  static PHCounterRegistry registry;
+  return &registry;
+}
+
+PHCounter *PHCounterRegistry::get(const std::string &module, const std::string &name)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::unique_ptr<PHCounter> &counter = m_Counters[module + "/" + name];
+  if (!counter)
+  {
+    counter = std::make_unique<PHCounter>(module, name, m_Enabled);
+  }
+  return counter.get();
+}
+
+void PHCounterRegistry::EndEvent()
+{
+  if (!Enabled())
+  {
+    return;
+  }
+  for (auto &[key, counter] : m_Counters)
+  {
+    counter->m_Total += counter->m_Event.exchange(0, std::memory_order_relaxed);
+    counter->m_NEvents++;
+  }
+}
@@ -0,0 +1,96 @@
+#ifndef PHOOL_PHCOUNTER_H
+#define PHOOL_PHCOUNTER_H
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+class PHCounterRegistry;
+
+//! named count of a module (links made, tree queries, fit outliers, ...)
+/*!
+  Get the counter once (Init or InitRun) and add to it in the event:
+
+    m_NLinks = PHCounterRegistry::instance()->get(Name(), "links");
+    ...
+    m_NLinks->add(links.size());
+
+  When the registry is disabled add() costs one atomic load. Adding is
+  thread safe, counts inside tight loops are better summed locally and
+  added once.
+*/
+class PHCounter
+{
+ public:
+  PHCounter(const std::string &module, const std::string &name, const std::atomic<bool> &enabled)
+    : m_Module(module)
+    , m_Name(name)
+    , m_Enabled(enabled)
+  {
+  }
+
+  void add(const long n = 1)
+  {
+    if (m_Enabled.load(std::memory_order_relaxed))
+    {
+      m_Event.fetch_add(n, std::memory_order_relaxed);
+    }
+  }
+
+  const std::string &Module() const { return m_Module; }
+  const std::string &Name() const { return m_Name; }
+
+  //! count in the current event
+  long Event() const { return m_Event.load(std::memory_order_relaxed); }
+  //! count in all finished events
+  long Total() const { return m_Total; }
+  //! number of finished events
+  long Events() const { return m_NEvents; }
+
+ private:
+  friend class PHCounterRegistry;
+
+  std::string m_Module;
+  std::string m_Name;
+  const std::atomic<bool> &m_Enabled;
+  std::atomic<long> m_Event{0};
+  long m_Total{0};
+  long m_NEvents{0};
+};
+
+//! all PHCounters of the job, enabled with Fun4AllServer module profiling
+class PHCounterRegistry
+{
+ public:
+  static PHCounterRegistry *instance();
+
+  PHCounterRegistry(const PHCounterRegistry &) = delete;
+  PHCounterRegistry &operator=(const PHCounterRegistry &) = delete;
+
+  void Enable(const bool flag = true) { m_Enabled.store(flag, std::memory_order_relaxed); }
+  bool Enabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+  //! counter name of module, created on first call. Not for the event loop
+  PHCounter *get(const std::string &module, const std::string &name);
+
+  //! add the event counts to the totals and clear them, called by Fun4AllServer after each event
+  void EndEvent();
+
+  //! counters by "module/name"
+  using CounterMap = std::map<std::string, std::unique_ptr<PHCounter>>;
+  CounterMap::const_iterator begin() const { return m_Counters.begin(); }
+  CounterMap::const_iterator end() const { return m_Counters.end(); }
+
+ private:
+  PHCounterRegistry() = default;
+
+  std::atomic<bool> m_Enabled{false};
+
+  //! guards the creation of counters, getters run in Init
+  std::mutex m_Mutex;
+  CounterMap m_Counters;
+};
+
+#endif
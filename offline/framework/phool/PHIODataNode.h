@@ -12,6 +12,9 @@
 
 #include <TObject.h>
 
+#include <cstddef>
+#include <limits>
+#include <memory>
 #include <string>
 
 template <typename T>
@@ -21,6 +24,18 @@ class PHIODataNode : public PHDataNode<T>
 
  public:
   T *operator*() { return this->getData(); }
+  T *getData()
+  {
+    loadLazy();
+    return PHDataNode<T>::getData();
+  }
+  void loadLazy() override
+  {
+    if (m_LazyReader && *m_LazyReader)
+    {
+      (*m_LazyReader)->readLazyBranch(m_LazyBranch, m_LazyEntry);
+    }
+  }
   PHIODataNode(T *, const std::string &);
   PHIODataNode(T *, const std::string &, const std::string &);
   virtual ~PHIODataNode() {}
@@ -33,6 +48,11 @@ class PHIODataNode : public PHDataNode<T>
   PHIODataNode() = delete;
   int buffersize{32000};
   int splitlevel{99};
+  // set by the PHNodeIOManager which reads this node lazily, the
+  // shared pointer is nulled when the manager closes its file
+  std::shared_ptr<PHNodeIOManager *> m_LazyReader;
+  TBranch *m_LazyBranch{nullptr};
+  size_t m_LazyEntry{std::numeric_limits<size_t>::max()};
 };
 
 template <class T>
@@ -59,6 +79,7 @@ bool PHIODataNode<T>::write(PHIOManager *IOManager, const std::string &path)
 {
   if (this->persistent)
   {
+    loadLazy();
     PHNodeIOManager *np = dynamic_cast<PHNodeIOManager *>(IOManager);
     if (np)
     {
@@ -14,6 +14,8 @@
 
 #include <iostream>
 
+std::atomic<uint64_t> PHNode::s_TreeGeneration{0};
+
 PHNode::PHNode(const std::string& n)
   : PHNode(n, "")
 {
@@ -52,6 +54,7 @@ PHNode::PHNode(const std::string& n, const std::string& typ)
 
 PHNode::~PHNode()
 {
+  treeChanged();
   if (parent)
   {
     parent->forgetMe(this);
@@ -4,6 +4,8 @@
 //  Declaration of class PHNode
 //  Purpose: abstract base class for all node classes
 
+#include <atomic>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 
@@ -25,19 +27,36 @@ class PHNode
   const std::string getType() const { return type; }
   const std::string getName() const { return name; }
   const std::string getClass() const { return objectclass; }
-  void setParent(PHNode *p) { parent = p; }
-  void setName(const std::string &n) { name = n; }
+  void setParent(PHNode *p)
+  {
+    parent = p;
+    treeChanged();
+  }
+  void setName(const std::string &n)
+  {
+    name = n;
+    treeChanged();
+  }
   void setObjectType(const std::string &n) { objecttype = n; }
   virtual void prune() = 0;
   virtual void print(const std::string &) = 0;
   virtual void forgetMe(PHNode *) = 0;
   virtual bool write(PHIOManager *, const std::string & = "") = 0;
+  // read the payload of a lazily read input node (PHNodeIOManager::SetLazyRead)
+  // for the current entry if not done yet, does nothing for other nodes
+  virtual void loadLazy() {}
 
   virtual void setResetFlag(const bool b) { reset_able = b; }
   virtual bool getResetFlag() const { return reset_able; }
   void makeTransient() { persistent = false; }
 
+  // counter incremented whenever a node is added, removed or renamed in any node
+  // tree, cached node lookups are valid as long as it does not change
+  static uint64_t treeGeneration() { return s_TreeGeneration.load(std::memory_order_acquire); }
+
  protected:
+  static void treeChanged() { s_TreeGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
   PHNode *parent = nullptr;
   bool persistent = true;
   std::string type = "PHNode";
@@ -47,6 +66,7 @@ class PHNode
   std::string objectclass;
 
  private:
+  static std::atomic<uint64_t> s_TreeGeneration;
   PHNode() = delete;
   PHNode(const PHNode &) = delete;
   PHNode &operator=(const PHNode &) = delete;
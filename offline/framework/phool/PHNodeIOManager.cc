@@ -5,6 +5,7 @@
 #include "PHCompositeNode.h"
 #include "PHIODataNode.h"
 #include "PHNodeIterator.h"
+#include "PHObject.h"
 #include "phooldefs.h"
 
 #include <TBranch.h>  // for TBranch
@@ -12,6 +13,7 @@
 #include <TBranchObject.h>
 #include <TClass.h>
 #include <TDirectory.h>  // for TDirectory
+#include <TEntryList.h>
 #include <TFile.h>
 #include <TLeafObject.h>
 #include <TObjArray.h>  // for TObjArray
@@ -19,6 +21,7 @@
 #include <TROOT.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <TTreePerfStats.h>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wdeprecated-declarations"
@@ -26,6 +29,7 @@
 #pragma GCC diagnostic pop
 
 #include <cassert>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -65,6 +69,30 @@ PHNodeIOManager::~PHNodeIOManager()
 
 void PHNodeIOManager::closeFile()
 {
+  if (m_PerfStats)
+  {
+    if (tree)
+    {
+      tree->SetPerfStats(nullptr);
+    }
+    delete m_PerfStats;
+    m_PerfStats = nullptr;
+  }
+  // lazily read nodes must not reach into a closed file
+  if (m_LazyHandle)
+  {
+    *m_LazyHandle = nullptr;
+    m_LazyHandle.reset();
+  }
+  if (m_EntryList)
+  {
+    if (tree)
+    {
+      tree->SetEntryList(nullptr);
+    }
+    delete m_EntryList;
+    m_EntryList = nullptr;
+  }
   if (file)
   {
     if (accessMode == PHWrite || accessMode == PHUpdate)
@@ -171,8 +199,18 @@ bool PHNodeIOManager::write(TObject** data, const std::string& path, int nodebuf
       {
         buffersize = nodebuffersize;
       }
-      tree->Branch(path.c_str(), (*data)->ClassName(),
-                   data, buffersize, splitlevel);
+      TBranch* newBranch = tree->Branch(path.c_str(), (*data)->ClassName(),
+                                        data, buffersize, splitlevel);
+      // the node name is the last part of the branch path
+      if (newBranch && !m_NodeCompressionSetting.empty())
+      {
+        std::string nodename = path.substr(path.find_last_of(phooldefs::branchpathdelim) + 1);
+        auto iter = m_NodeCompressionSetting.find(nodename);
+        if (iter != m_NodeCompressionSetting.end())
+        {
+          newBranch->SetCompressionSettings(iter->second);
+        }
+      }
     }
     else
     {
@@ -300,14 +338,14 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
 
   if (requestedEvent)
   {
-    if ((bytesRead = tree->GetEvent(requestedEvent)))
+    if ((bytesRead = readEntry(requestedEvent)))
     {
       eventNumber = requestedEvent + 1;
     }
   }
   else
   {
-    bytesRead = tree->GetEvent(eventNumber++);
+    bytesRead = readEntry(eventNumber++);
   }
 
   gFile = file_ptr;  // recover gFile
@@ -325,6 +363,101 @@ bool PHNodeIOManager::readEventFromFile(size_t requestedEvent)
   return true;
 }
 
+int PHNodeIOManager::readEntry(size_t entry)
+{
+  if (m_LazyReadFlag)
+  {
+    // only position the tree, the branches are read when their nodes are used
+    if (static_cast<Long64_t>(entry) >= tree->GetEntries() || tree->LoadTree(entry) < 0)
+    {
+      return 0;
+    }
+    m_LazyEntry = entry;
+    return 1;
+  }
+  return m_IOTimingFlag ? readEntryTimed(entry) : tree->GetEvent(entry);
+}
+
+void PHNodeIOManager::readLazyBranch(TBranch* branch, size_t& loaded)
+{
+  if (!tree || !branch || loaded == m_LazyEntry)
+  {
+    return;
+  }
+  std::string currdir = gDirectory->GetPath();
+  TFile* file_ptr = gFile;  // save current gFile
+  file->cd();
+  if (branch->GetEntry(m_LazyEntry) < 0)
+  {
+    std::cout << PHWHERE << "Error: Input TTree corrupt, exiting now" << std::endl;
+    exit(1);
+  }
+  gFile = file_ptr;  // recover gFile
+  gROOT->cd(currdir.c_str());
+  loaded = m_LazyEntry;
+  m_UsedBranches.insert(branch->GetName());
+}
+
+// same as TTree::GetEntry but reads the active top level branches one by one
+// to accumulate the time spent in each of them
+int PHNodeIOManager::readEntryTimed(size_t entry)
+{
+  if (tree->LoadTree(entry) < 0)
+  {
+    return 0;
+  }
+  int nbytes = 0;
+  TObjArray* branchArray = tree->GetListOfBranches();
+  for (int i = 0; i < branchArray->GetEntriesFast(); i++)
+  {
+    TBranch* branch = static_cast<TBranch*>((*branchArray)[i]);
+    if (branch->TestBit(kDoNotProcess))
+    {
+      continue;
+    }
+    auto start = std::chrono::steady_clock::now();
+    int nb = branch->GetEntry(entry);
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    m_BranchReadTime[branch->GetName()] += elapsed.count();
+    if (nb < 0)
+    {
+      return nb;
+    }
+    nbytes += nb;
+  }
+  if (nbytes > 0)
+  {
+    m_TimedEntries++;
+  }
+  return nbytes;
+}
+
+void PHNodeIOManager::PrintIOTiming() const
+{
+  if (!m_IOTimingFlag)
+  {
+    return;
+  }
+  std::cout << "PHNodeIOManager read timing for " << filename
+            << " (" << m_TimedEntries << " entries)" << std::endl;
+  double sum = 0;
+  for (const auto& [branchname, ms] : m_BranchReadTime)
+  {
+    std::cout << "  " << branchname << ": " << ms << " ms, "
+              << (m_TimedEntries ? ms / m_TimedEntries : 0) << " ms/entry" << std::endl;
+    sum += ms;
+  }
+  std::cout << "  total: " << sum << " ms" << std::endl;
+  if (m_PerfStats)
+  {
+    m_PerfStats->Finish();
+    std::cout << "  disk read: " << m_PerfStats->GetDiskTime() << " s, unzip: "
+              << m_PerfStats->GetUnzipTime() << " s, bytes read: "
+              << m_PerfStats->GetBytesRead() << ", read calls: "
+              << m_PerfStats->GetReadCalls() << std::endl;
+  }
+}
+
 int PHNodeIOManager::readSpecific(size_t requestedEvent, const std::string& objectName)
 {
   // objectName should be one of the valid branch name of the "T" TTree, and
@@ -348,6 +481,20 @@ int PHNodeIOManager::readSpecific(size_t requestedEvent, const std::string& obje
   return 0;
 }
 
+template <class T>
+bool PHNodeIOManager::bindLazyNode(PHNode* node, TBranch* branch) const
+{
+  PHIODataNode<T>* ionode = dynamic_cast<PHIODataNode<T>*>(node);
+  if (!ionode)
+  {
+    return false;
+  }
+  ionode->m_LazyReader = m_LazyHandle;
+  ionode->m_LazyBranch = m_LazyReadFlag ? branch : nullptr;
+  ionode->m_LazyEntry = std::numeric_limits<size_t>::max();
+  return true;
+}
+
 PHCompositeNode*
 PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
 {
@@ -381,6 +528,22 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
 
   tree->SetName(nname.str().c_str());
 
+  // the cache reads the baskets of all used branches for a range of entries
+  // in one request. Branches are picked up during the learning phase
+  if (m_ReadCacheSize > 0)
+  {
+    tree->SetCacheSize(m_ReadCacheSize);
+  }
+  if (m_IOTimingFlag && !m_PerfStats)
+  {
+    m_PerfStats = new TTreePerfStats((std::string("ioperf_") + nname.str()).c_str(), tree);
+  }
+  applyEntryList();
+  if (m_LazyReadFlag && !m_LazyHandle)
+  {
+    m_LazyHandle = std::make_shared<PHNodeIOManager*>(this);
+  }
+
   // Select the branches according to objectToRead
   std::map<std::string, bool>::const_iterator it;
 
@@ -492,6 +655,12 @@ PHNodeIOManager::reconstructNodeTree(PHCompositeNode* topNode)
       newIODataNode->setObjectType("PHObject");
     }
     thisBranch->SetAddress(&(newIODataNode->data));
+    // nodes reused from a previous file have to be rebound to this one, nodes
+    // created by modules are PHIODataNode<PHObject>, the ones created here PHIODataNode<TObject>
+    if (!bindLazyNode<PHObject>(newIODataNode, thisBranch))
+    {
+      bindLazyNode<TObject>(newIODataNode, thisBranch);
+    }
     for (j = 1; j < splitvec.size() - 1; j++)
     {
       nodeIter.cd("..");
@@ -565,6 +734,44 @@ PHNodeIOManager::GetFileSize()
   return 0.;
 }
 
+size_t PHNodeIOManager::GetEntries() const
+{
+  if (tree)
+  {
+    return tree->GetEntries();
+  }
+  return 0;
+}
+
+void PHNodeIOManager::SetEntryList(const std::vector<size_t>& entries)
+{
+  m_Entries = entries;
+  // without tree the list is applied when the node tree is reconstructed
+  if (tree)
+  {
+    applyEntryList();
+  }
+}
+
+void PHNodeIOManager::applyEntryList()
+{
+  tree->SetEntryList(nullptr);
+  delete m_EntryList;
+  m_EntryList = nullptr;
+  if (m_Entries.empty())
+  {
+    return;
+  }
+  // the entries are still read by number, the list only tells the
+  // TTreeCache which baskets it can skip when prefetching
+  m_EntryList = new TEntryList(tree);
+  for (auto entry : m_Entries)
+  {
+    m_EntryList->Enter(entry);
+  }
+  tree->SetEntryList(m_EntryList);
+}
+
 std::map<std::string, TBranch*>*
 PHNodeIOManager::GetBranchMap()
 {
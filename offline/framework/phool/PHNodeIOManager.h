@@ -13,13 +13,19 @@
 #include <cstdint>
 #include <limits>
 #include <map>
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class PHNode;
 class TBranch;
+class TEntryList;
 class TFile;
 class TObject;
 class TTree;
+class TTreePerfStats;
 
 class PHNodeIOManager : public PHIOManager
 {
@@ -43,8 +49,13 @@ class PHNodeIOManager : public PHIOManager
   bool isSelected(const std::string &objectName);
   int isFunctional() const { return isFunctionalFlag; }
   bool SetCompressionSetting(const int level);
+  // compression setting for the branch of a given node, overrides the file setting
+  // must be set before the first write
+  void SetNodeCompressionSetting(const std::string &nodename, const int setting) { m_NodeCompressionSetting[nodename] = setting; }
   uint64_t GetBytesWritten();
   uint64_t GetFileSize();
+  // entries of the input tree, 0 before the first read
+  size_t GetEntries() const;
   std::map<std::string, TBranch *> *GetBranchMap();
 
   bool write(TObject **, const std::string &, int nodebuffersize, int nodesplitlevel);
@@ -55,11 +66,41 @@ class PHNodeIOManager : public PHIOManager
   int SplitLevel() const { return splitlevel; }
   int BufferSize() const { return buffersize; }
 
+  // size in bytes of the TTreeCache for the input tree, 0 disables it
+  // must be set before the first read
+  void SetReadCacheSize(const long size) { m_ReadCacheSize = size; }
+  long GetReadCacheSize() const { return m_ReadCacheSize; }
+
+  // measure read time per branch and ROOT read vs unzip time
+  // must be set before the first read. Branches are then read one by one
+  void EnableIOTiming(const bool flag) { m_IOTimingFlag = flag; }
+  void PrintIOTiming() const;
+
+  // entries which will be read (sorted), handed to the input tree as TEntryList
+  // so the TTreeCache only prefetches the baskets holding them. Empty clears it
+  void SetEntryList(const std::vector<size_t> &entries);
+
+  // lazy read: reading an event only loads the tree, the payload of a node is read
+  // from its branch when the node is first accessed (getClass, getData, write)
+  // must be set before the first read
+  void SetLazyRead(const bool flag) { m_LazyReadFlag = flag; }
+  bool GetLazyRead() const { return m_LazyReadFlag; }
+  // read branch for the current entry unless loaded already is the current entry
+  void readLazyBranch(TBranch *branch, size_t &loaded);
+  // branches read on access in lazy mode
+  const std::set<std::string> &UsedBranches() const { return m_UsedBranches; }
+
  private:
   int FillBranchMap();
   PHCompositeNode *reconstructNodeTree(PHCompositeNode *);
   bool readEventFromFile(size_t requestedEvent);
+  void applyEntryList();
+  int readEntryTimed(size_t entry);
+  int readEntry(size_t entry);
   std::string getBranchClassName(TBranch *);
+  // (re)bind an input node to this manager for lazy reads, false if it is not a PHIODataNode<T>
+  template <class T>
+  bool bindLazyNode(PHNode *node, TBranch *branch) const;
 
   TFile *file{nullptr};
   TTree *tree{nullptr};
@@ -71,6 +112,18 @@ class PHNodeIOManager : public PHIOManager
   int splitlevel{std::numeric_limits<int>::min()};
   std::map<std::string, TBranch *> fBranches;
   std::map<std::string, bool> objectToRead;
+  std::map<std::string, int> m_NodeCompressionSetting;
+  long m_ReadCacheSize{0};
+  bool m_IOTimingFlag{false};
+  TTreePerfStats *m_PerfStats{nullptr};
+  TEntryList *m_EntryList{nullptr};
+  size_t m_TimedEntries{0};
+  std::map<std::string, double> m_BranchReadTime;  // accumulated read time per branch in ms
+  std::vector<size_t> m_Entries;
+  bool m_LazyReadFlag{false};
+  size_t m_LazyEntry{std::numeric_limits<size_t>::max()};
+  std::shared_ptr<PHNodeIOManager *> m_LazyHandle;
+  std::set<std::string> m_UsedBranches;
 };
 
 #endif
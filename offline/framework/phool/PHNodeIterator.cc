@@ -50,58 +50,14 @@ void PHNodeIterator::print()
   currentNode->print();
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
 PHNode* PHNodeIterator::findFirst(const std::string& requiredType, const std::string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode* thisNode;
-  while ((thisNode = iter()))
-  {
-    if (thisNode->getType() == requiredType && thisNode->getName() == requiredName)
-    {
-      return thisNode;
-    }
-    else
-    {
-      if (thisNode->getType() == "PHCompositeNode")
-      {
-        PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredType.c_str(), requiredName.c_str());
-        if (nodeFoundInSubTree)
-        {
-          return nodeFoundInSubTree;
-        }
-      }
-    }
-  }
-  return nullptr;
+  return currentNode->findFirst(requiredType, requiredName);
 }
 
-// NOLINTNEXTLINE(misc-no-recursion)
 PHNode* PHNodeIterator::findFirst(const std::string& requiredName)
 {
-  PHPointerListIterator<PHNode> iter(currentNode->subNodes);
-  PHNode* thisNode;
-  while ((thisNode = iter()))
-  {
-    if (thisNode->getName() == requiredName)
-    {
-      return thisNode;
-    }
-    else
-    {
-      if (thisNode->getType() == "PHCompositeNode")
-      {
-        PHNodeIterator nodeIter(static_cast<PHCompositeNode*>(thisNode));
-        PHNode* nodeFoundInSubTree = nodeIter.findFirst(requiredName.c_str());
-        if (nodeFoundInSubTree)
-        {
-          return nodeFoundInSubTree;
-        }
-      }
-    }
-  }
-  return nullptr;
+  return currentNode->findFirst("", requiredName);
 }
 
 bool PHNodeIterator::cd(const std::string& pathString)
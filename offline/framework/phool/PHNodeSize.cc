@@ -0,0 +1,35 @@
+//  Implementation of class PHNodeSize
+
+#include "PHNodeSize.h"
+
+#include "PHIODataNode.h"
+#include "PHNode.h"
+#include "PHObject.h"
+
+#include <iostream>
+
+PHNodeSize::PHNodeSize()
+  : m_Buffer(TBuffer::kWrite)
+{
+}
+
+void PHNodeSize::perform(PHNode* node)
+{
+  if (node->getType() != "PHIODataNode" || node->getObjectType() != "PHObject")
+  {
+    return;
+  }
+  PHObject* object = (static_cast<PHIODataNode<PHObject>*>(node))->getData();
+  if (!object)
+  {
+    return;
+  }
+  // the buffer keeps its capacity, only the first node of an event grows it
+  m_Buffer.Reset();
+  m_Buffer.WriteObject(object);
+  m_Sizes[node->getName()] = m_Buffer.Length();
+  if (verbosity > 0)
+  {
+    std::cout << "PHNodeSize: " << node->getName() << " " << m_Buffer.Length() << " bytes" << std::endl;
+  }
+}
@@ -0,0 +1,33 @@
+#ifndef PHOOL_PHNODESIZE_H
+#define PHOOL_PHNODESIZE_H
+
+//  Declaration of class PHNodeSize
+//  Purpose: strategy which measures the streamed size of the PHObject of a PHIODataNode
+
+#include "PHNodeOperation.h"
+
+#include <TBufferFile.h>
+
+#include <map>
+#include <string>
+
+class PHNode;
+
+class PHNodeSize : public PHNodeOperation
+{
+ public:
+  PHNodeSize();
+  ~PHNodeSize() override {}
+
+  //! uncompressed streamed size in bytes, by node name
+  const std::map<std::string, long>& Sizes() const { return m_Sizes; }
+
+ protected:
+  void perform(PHNode*) override;
+
+ private:
+  TBufferFile m_Buffer;
+  std::map<std::string, long> m_Sizes;
+};
+
+#endif
@@ -0,0 +1,30 @@
+//  Implementation of class PHNodeTrim
+
+#include "PHNodeTrim.h"
+
+#include "PHDataNode.h"
+#include "PHNode.h"
+#include "PHObject.h"
+
+#include <iostream>
+#include <string>
+
+void PHNodeTrim::perform(PHNode* node)
+{
+  // only nodes which are reset keep memory between events
+  if (node->getResetFlag() != true)
+  {
+    return;
+  }
+  if (verbosity > 0)
+  {
+    std::cout << "PHNodeTrim: Trimming " << node->getName() << std::endl;
+  }
+  if (node->getType() == "PHDataNode" || node->getType() == "PHIODataNode")
+  {
+    if (node->getObjectType() == "PHObject")
+    {
+      (static_cast<PHDataNode<PHObject>*>(node))->getData()->Trim();
+    }
+  }
+}
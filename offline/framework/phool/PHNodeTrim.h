@@ -0,0 +1,21 @@
+#ifndef PHOOL_PHNODETRIM_H
+#define PHOOL_PHNODETRIM_H
+
+//  Declaration of class PHNodeTrim
+//  Purpose: strategy which calls Trim() on the PHObject of a PHNode
+
+#include "PHNodeOperation.h"
+
+class PHNode;
+
+class PHNodeTrim : public PHNodeOperation
+{
+ public:
+  PHNodeTrim() {}
+  ~PHNodeTrim() override {}
+
+ protected:
+  void perform(PHNode*) override;
+};
+
+#endif
@@ -31,8 +31,13 @@ class PHObject : public TObject
   virtual void identify(std::ostream& os = std::cout) const;
 
   /// Clear Event
+  /** containers may keep the memory of their content (object pools,
+      vector capacity) for the next event instead of freeing it */
   virtual void Reset();
 
+  /// release the memory which Reset() keeps for reuse, called by Fun4AllServer::ResetNodeTree() according to the trim policy
+  virtual void Trim() {}
+
   /// isValid returns non zero if object contains vailid data
   virtual int isValid() const;
 
@@ -0,0 +1,357 @@
+#include "PHProfiler.h"
+
+#include <dlfcn.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// older glibc does not name the thread id of SIGEV_THREAD_ID
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace
+{
+  // gperftools samples with SIGPROF, this one is free so both can run
+  int sample_signal() { return SIGRTMIN + 3; }
+
+  const unsigned int MAXTHREADS = 512;
+  const unsigned int TABLESIZE = 4096;  // power of 2
+
+  // a thread which set a tag, the signal of its timer carries the slot index
+  class Slot
+  {
+   public:
+    std::atomic<const char *> tag{nullptr};
+    pid_t tid{0};
+    pthread_t thread{};
+    timer_t timer{};
+    bool has_timer{false};
+    bool alive{false};
+  };
+
+  // samples by tag pointer, open addressing so the handler does not allocate
+  class Entry
+  {
+   public:
+    std::atomic<const char *> tag{nullptr};
+    std::atomic<long> count{0};
+  };
+
+  Slot slots[MAXTHREADS];
+  std::atomic<unsigned int> nslots{0};
+  Entry table[TABLESIZE];
+  std::atomic<long> untagged{0};
+  std::atomic<long> lost{0};
+  std::atomic<bool> sampling{false};
+  long period_ns = 0;
+
+  // guards the timers and alive flags, not the tags
+  std::mutex slot_mutex;
+
+  void count_sample(const char *tag)
+  {
+    if (!tag)
+    {
+      untagged.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    const uintptr_t hash = reinterpret_cast<uintptr_t>(tag) >> 3;
+    for (unsigned int i = 0; i < TABLESIZE; ++i)
+    {
+      Entry &entry = table[(hash + i) & (TABLESIZE - 1)];
+      const char *key = entry.tag.load(std::memory_order_relaxed);
+      if (!key && entry.tag.compare_exchange_strong(key, tag))
+      {
+        key = tag;
+      }
+      if (key == tag)
+      {
+        entry.count.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+    lost.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void sample_handler(int /*signo*/, siginfo_t *info, void * /*context*/)
+  {
+    if (!sampling.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+    const int saved_errno = errno;
+    const unsigned int index = info->si_value.sival_int;
+    if (index < MAXTHREADS)
+    {
+      count_sample(slots[index].tag.load(std::memory_order_relaxed));
+    }
+    errno = saved_errno;
+  }
+
+  // called with slot_mutex held
+  void create_timer(const unsigned int index)
+  {
+    Slot &slot = slots[index];
+    if (slot.has_timer || !slot.alive)
+    {
+      return;
+    }
+    clockid_t clock;
+    if (pthread_getcpuclockid(slot.thread, &clock))
+    {
+      return;
+    }
+    struct sigevent event = {};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = sample_signal();
+    event.sigev_value.sival_int = index;
+    event.sigev_notify_thread_id = slot.tid;
+    if (timer_create(clock, &event, &slot.timer))
+    {
+      return;
+    }
+    struct itimerspec spec = {};
+    spec.it_interval.tv_sec = period_ns / 1000000000;
+    spec.it_interval.tv_nsec = period_ns % 1000000000;
+    spec.it_value = spec.it_interval;
+    timer_settime(slot.timer, 0, &spec, nullptr);
+    slot.has_timer = true;
+  }
+
+  // called with slot_mutex held
+  void delete_timer(const unsigned int index)
+  {
+    Slot &slot = slots[index];
+    if (slot.has_timer)
+    {
+      timer_delete(slot.timer);
+      slot.has_timer = false;
+    }
+  }
+
+  // registers the thread on first use, removes its timer when the thread ends
+  class ThreadSlot
+  {
+   public:
+    ThreadSlot()
+      : index(nslots.fetch_add(1))
+    {
+      if (index < MAXTHREADS)
+      {
+        Slot &slot = slots[index];
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        slot.tid = syscall(SYS_gettid);
+        slot.thread = pthread_self();
+        slot.alive = true;
+        if (sampling)
+        {
+          create_timer(index);
+        }
+      }
+    }
+    ~ThreadSlot()
+    {
+      if (index < MAXTHREADS)
+      {
+        std::lock_guard<std::mutex> lock(slot_mutex);
+        delete_timer(index);
+        slots[index].alive = false;
+      }
+    }
+    ThreadSlot(const ThreadSlot &) = delete;
+    ThreadSlot &operator=(const ThreadSlot &) = delete;
+
+    unsigned int index;
+  };
+
+  Slot *thread_slot()
+  {
+    thread_local ThreadSlot threadslot;
+    return (threadslot.index < MAXTHREADS) ? &slots[threadslot.index] : nullptr;
+  }
+}  // namespace
+
+PHProfiler *PHProfiler::instance()
+{
+  static PHProfiler profiler;
+  return &profiler;
+}
+
+void PHProfiler::SetActive(const char *tag)
+{
+  Slot *slot = thread_slot();
+  if (slot)
+  {
+    slot->tag.store(tag, std::memory_order_relaxed);
+  }
+}
+
+const char *PHProfiler::Active()
+{
+  Slot *slot = thread_slot();
+  return slot ? slot->tag.load(std::memory_order_relaxed) : nullptr;
+}
+
+int PHProfiler::Start(const std::string &filename)
+{
+  if (m_Running)
+  {
+    return 0;
+  }
+  if (m_Frequency <= 0)
+  {
+    std::cout << "PHProfiler: invalid sampling frequency " << m_Frequency << std::endl;
+    return -1;
+  }
+  m_FileName = filename;
+
+  static bool handler_installed = false;
+  if (!handler_installed)
+  {
+    struct sigaction action = {};
+    action.sa_sigaction = sample_handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(sample_signal(), &action, nullptr))
+    {
+      std::cout << "PHProfiler: could not install the sampling signal handler" << std::endl;
+      return -1;
+    }
+    handler_installed = true;
+  }
+
+  for (auto &entry : table)
+  {
+    entry.tag = nullptr;
+    entry.count = 0;
+  }
+  untagged = 0;
+  lost = 0;
+  period_ns = 1000000000L / m_Frequency;
+
+  // the calling thread is always sampled
+  thread_slot();
+  {
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    sampling = true;
+    const unsigned int n = std::min(nslots.load(), MAXTHREADS);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      create_timer(i);
+    }
+  }
+
+  // gperftools only if libprofiler is in the process, no link dependency
+  using ProfilerStart_t = int (*)(const char *);
+  auto profilerstart = reinterpret_cast<ProfilerStart_t>(dlsym(RTLD_DEFAULT, "ProfilerStart"));
+  m_Gperftools = profilerstart && profilerstart((m_FileName + ".prof").c_str());
+
+  PerfCommand("enable");
+  m_Running = true;
+  std::cout << "PHProfiler: started, " << m_Frequency << " Hz"
+            << (m_Gperftools ? ", gperftools to " + m_FileName + ".prof" : "")
+            << (m_PerfControl.empty() ? "" : ", perf enabled") << std::endl;
+  return 0;
+}
+
+void PHProfiler::Stop()
+{
+  if (!m_Running)
+  {
+    return;
+  }
+  m_Running = false;
+  PerfCommand("disable");
+  if (m_Gperftools)
+  {
+    using ProfilerStop_t = void (*)();
+    auto profilerstop = reinterpret_cast<ProfilerStop_t>(dlsym(RTLD_DEFAULT, "ProfilerStop"));
+    if (profilerstop)
+    {
+      profilerstop();
+    }
+    m_Gperftools = false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(slot_mutex);
+    sampling = false;
+    const unsigned int n = std::min(nslots.load(), MAXTHREADS);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      delete_timer(i);
+    }
+  }
+
+  // the same name can come from different strings (e.g. modules on two topnodes)
+  std::map<std::string, long> bytag;
+  long total = untagged;
+  for (const auto &entry : table)
+  {
+    const char *tag = entry.tag;
+    if (tag)
+    {
+      bytag[tag] += entry.count;
+      total += entry.count;
+    }
+  }
+  if (untagged > 0)
+  {
+    bytag["(untagged)"] += untagged;
+  }
+  std::vector<std::pair<std::string, long>> sorted(bytag.begin(), bytag.end());
+  std::sort(sorted.begin(), sorted.end(), [](const auto &a, const auto &b)
+            { return a.second > b.second; });
+
+  const std::string outfile = m_FileName + ".modules.txt";
+  std::ofstream out(outfile);
+  if (!out.is_open())
+  {
+    std::cout << "PHProfiler: could not open " << outfile << std::endl;
+    return;
+  }
+  const double ms_per_sample = 1000. / m_Frequency;
+  out << "# cpu time samples per tag, " << m_Frequency << " Hz per thread";
+  if (lost > 0)
+  {
+    out << ", " << lost << " samples lost (too many tags)";
+  }
+  out << "\n#  samples  percent   cpu_ms  tag\n";
+  for (const auto &[tag, count] : sorted)
+  {
+    out << std::setw(10) << count << " "
+        << std::setw(8) << std::fixed << std::setprecision(2) << (total > 0 ? 100. * count / total : 0.) << " "
+        << std::setw(8) << std::setprecision(0) << count * ms_per_sample << "  "
+        << tag << "\n";
+  }
+  std::cout << "PHProfiler: stopped, " << total << " samples written to " << outfile << std::endl;
+}
+
+void PHProfiler::PerfCommand(const std::string &command) const
+{
+  if (m_PerfControl.empty())
+  {
+    return;
+  }
+  std::ofstream fifo(m_PerfControl);
+  if (!fifo.is_open())
+  {
+    std::cout << "PHProfiler: could not open perf control " << m_PerfControl << std::endl;
+    return;
+  }
+  fifo << command << std::endl;
+}
@@ -0,0 +1,67 @@
+#ifndef PHOOL_PHPROFILER_H
+#define PHOOL_PHPROFILER_H
+
+#include <string>
+
+//! sampling cpu profiler for a range of events
+/*!
+  Fun4AllServer::ProfileEvents(first, last, filename) starts it before
+  event first and stops it after event last, so the initialization does
+  not dominate the profile. While running it
+
+  - samples the cpu time of every thread which has set a tag (the
+    server tags the running module, input and output manager, the
+    PHThreadPool workers take the tag of the caller) and writes the
+    samples per tag to filename.modules.txt
+  - runs the gperftools cpu profiler into filename.prof, if libprofiler
+    is loaded (LD_PRELOAD or gSystem->Load("libprofiler")), symbolize with
+    pprof
+  - enables and disables perf if a control fifo is set:
+
+      mkfifo perf.ctl
+      perf record --delay=-1 --control=fifo:perf.ctl -g -- root.exe Fun4All_macro.C
+      PHProfiler::instance()->SetPerfControl("perf.ctl");
+
+  Each sampled thread has its own cpu time timer, the samples are
+  counted in the signal handler without locks or allocations.
+*/
+class PHProfiler
+{
+ public:
+  static PHProfiler *instance();
+
+  PHProfiler(const PHProfiler &) = delete;
+  PHProfiler &operator=(const PHProfiler &) = delete;
+
+  //! tag the samples of the calling thread, the string must outlive the profiling
+  static void SetActive(const char *tag);
+  //! tag of the calling thread
+  static const char *Active();
+
+  //! samples per second of cpu time and thread (default 100)
+  void SetFrequency(const int hz) { m_Frequency = hz; }
+
+  //! perf control fifo, see above
+  void SetPerfControl(const std::string &fifo) { m_PerfControl = fifo; }
+
+  //! start sampling, output goes to filename.*, returns 0 on success
+  int Start(const std::string &filename);
+
+  //! stop sampling and write the per tag samples
+  void Stop();
+
+  bool Running() const { return m_Running; }
+
+ private:
+  PHProfiler() = default;
+
+  void PerfCommand(const std::string &command) const;
+
+  int m_Frequency{100};
+  bool m_Running{false};
+  bool m_Gperftools{false};
+  std::string m_FileName;
+  std::string m_PerfControl;
+};
+
+#endif
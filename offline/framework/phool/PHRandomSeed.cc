@@ -3,12 +3,17 @@
 
 #include <iostream>
 #include <memory>  // for allocator
+#include <mutex>
 #include <queue>
 #include <random>
+#include <sstream>
+#include <string>
 
 static std::queue<unsigned int> seedqueue;
 static std::mt19937 fRandomGenerator;
 static std::uniform_int_distribution<unsigned int> fDistribution;
+// seeds may be requested from several threads
+static std::mutex seedmutex;
 
 bool PHRandomSeed::fInitialized(false);
 bool PHRandomSeed::fFixed(false);
@@ -16,6 +21,7 @@ int PHRandomSeed::verbose(1);
 
 unsigned int PHRandomSeed::GetSeed()
 {
+  std::lock_guard<std::mutex> lock(seedmutex);
   unsigned int iseed;
   if (!seedqueue.empty())
   {
@@ -61,9 +67,54 @@ void PHRandomSeed::InitSeed()
 
 void PHRandomSeed::LoadSeed(const unsigned int iseed)
 {
+  std::lock_guard<std::mutex> lock(seedmutex);
   seedqueue.push(iseed);
 }
 
+std::string PHRandomSeed::SaveState()
+{
+  std::lock_guard<std::mutex> lock(seedmutex);
+  std::ostringstream os;
+  os << fInitialized << " " << fFixed << " " << seedqueue.size();
+  std::queue<unsigned int> seeds = seedqueue;
+  while (!seeds.empty())
+  {
+    os << " " << seeds.front();
+    seeds.pop();
+  }
+  os << " " << fRandomGenerator;
+  return os.str();
+}
+
+bool PHRandomSeed::RestoreState(const std::string &state)
+{
+  std::lock_guard<std::mutex> lock(seedmutex);
+  std::istringstream is(state);
+  bool initialized = false;
+  bool fixed = false;
+  size_t nseeds = 0;
+  is >> initialized >> fixed >> nseeds;
+  std::queue<unsigned int> seeds;
+  for (size_t i = 0; i < nseeds && is; ++i)
+  {
+    unsigned int iseed = 0;
+    is >> iseed;
+    seeds.push(iseed);
+  }
+  std::mt19937 generator;
+  is >> generator;
+  if (!is)
+  {
+    std::cout << "PHRandomSeed::RestoreState - invalid state, not restored" << std::endl;
+    return false;
+  }
+  fInitialized = initialized;
+  fFixed = fixed;
+  seedqueue.swap(seeds);
+  fRandomGenerator = generator;
+  return true;
+}
+
 void PHRandomSeed::Verbosity(const int iverb)
 {
   verbose = iverb;
@@ -1,11 +1,15 @@
 #ifndef PHOOL_PHRANDOMSEED_H
 #define PHOOL_PHRANDOMSEED_H
 
+#include <string>
+
 //! standard way to get a random seed:
 //! `unsigned int seed = PHRandomSeed();`
 //! It return fix seed sequence if recoConsts RANDOMSEED is set.
 //! If values are preloaded via PHRandomSeed::LoadSeed, they are returned in loaded order
 //! otherwise it return a random seed from std::random_device rdev
+//! Seeds can be requested from several threads. For random numbers which do not depend
+//! on the number of threads use PHRandomStream
 class PHRandomSeed
 {
  public:
@@ -23,6 +27,11 @@ class PHRandomSeed
   static void Verbosity(const int iverb);
   static int Verbosity() { return verbose; };
 
+  //! state of the seed sequence (fixed seed generator, preloaded seeds) as text, for checkpoints
+  static std::string SaveState();
+  //! continue the seed sequence from a SaveState() text, returns false if the text is not valid
+  static bool RestoreState(const std::string &state);
+
  protected:
   static void InitSeed();
   static bool fFixed;
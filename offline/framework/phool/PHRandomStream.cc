@@ -0,0 +1,158 @@
+#include "PHRandomStream.h"
+
+#include "PHRandomSeed.h"
+
+#include <algorithm>
+#include <cmath>
+
+PHRandomStream::PHRandomStream(const std::string &module, const uint32_t stream)
+  : PHRandomStream(PHRandomSeed::GetSeed(), module, stream)
+{
+}
+
+PHRandomStream::PHRandomStream(const uint32_t seed, const std::string &module, const uint32_t stream)
+  : m_seed(seed)
+  , m_stream(stream)
+{
+  setKey(module);
+  SetEvent(0, 0);
+}
+
+void PHRandomStream::setKey(const std::string &module)
+{
+  // FNV-1a of the module name, so modules sharing a seed get different numbers
+  uint32_t hash = 2166136261U;
+  for (const char c : module)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 16777619U;
+  }
+  m_key[0] = m_seed;
+  m_key[1] = hash;
+}
+
+void PHRandomStream::SetEvent(const int run, const uint64_t event)
+{
+  m_run = run;
+  m_event = event;
+
+  // the event key is the encrypted (run, event), keys of different events are unrelated
+  const uint32_t counter[4] = {static_cast<uint32_t>(run), static_cast<uint32_t>(event), static_cast<uint32_t>(event >> 32), 0x5048524EU};
+  uint32_t out[4];
+  philox(counter, m_key, out);
+  m_event_key[0] = out[0];
+  m_event_key[1] = out[1];
+}
+
+double PHRandomStream::Generator::Gaus(const double mean, const double sigma)
+{
+  if (m_has_gaus)
+  {
+    m_has_gaus = false;
+    return mean + sigma * m_gaus;
+  }
+  const double radius = std::sqrt(-2. * std::log(Uniform()));
+  const double phi = 2. * M_PI * Uniform();
+  m_gaus = radius * std::sin(phi);
+  m_has_gaus = true;
+  return mean + sigma * radius * std::cos(phi);
+}
+
+unsigned int PHRandomStream::Generator::Poisson(const double mean)
+{
+  if (!(mean > 0))
+  {
+    return 0;
+  }
+
+  if (mean < 10)
+  {
+    // multiplication of uniforms
+    const double limit = std::exp(-mean);
+    unsigned int n = 0;
+    double product = Uniform();
+    while (product > limit)
+    {
+      ++n;
+      product *= Uniform();
+    }
+    return n;
+  }
+
+  // W. Hoermann, "The transformed rejection method for generating Poisson random variables"
+  const double slam = std::sqrt(mean);
+  const double loglam = std::log(mean);
+  const double b = 0.931 + 2.53 * slam;
+  const double a = -0.059 + 0.02483 * b;
+  const double invalpha = 1.1239 + 1.1328 / (b - 3.4);
+  const double vr = 0.9277 - 3.6224 / (b - 2);
+  while (true)
+  {
+    const double u = Uniform() - 0.5;
+    const double v = Uniform();
+    const double us = 0.5 - std::fabs(u);
+    const double k = std::floor((2 * a / us + b) * u + mean + 0.43);
+    if (us >= 0.07 && v <= vr)
+    {
+      return static_cast<unsigned int>(k);
+    }
+    if (k < 0 || (us < 0.013 && v > us))
+    {
+      continue;
+    }
+    if (std::log(v) + std::log(invalpha) - std::log(a / (us * us) + b) <= -mean + k * loglam - std::lgamma(k + 1))
+    {
+      return static_cast<unsigned int>(k);
+    }
+  }
+}
+
+void PHRandomStream::Uniform(const uint64_t first, const size_t n, double *out) const
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    out[i] = Get(first + i).Uniform();
+  }
+}
+
+void PHRandomStream::Gaus(const uint64_t first, const size_t n, double *out, const double mean, const double sigma) const
+{
+  // same numbers as Get(item).Gaus(), in two passes: the first one is integer
+  // only and vectorizes, the second one is the Box-Muller transform
+  constexpr size_t chunk = 256;
+  double u1[chunk];
+  double u2[chunk];
+  for (size_t start = 0; start < n; start += chunk)
+  {
+    const size_t size = std::min(chunk, n - start);
+    for (size_t i = 0; i < size; ++i)
+    {
+      const uint64_t item = first + start + i;
+      const uint32_t counter[4] = {0, static_cast<uint32_t>(item), static_cast<uint32_t>(item >> 32), m_stream};
+      uint32_t block[4];
+      philox(counter, m_event_key, block);
+      u1[i] = to_uniform(block[0], block[1]);
+      u2[i] = to_uniform(block[2], block[3]);
+    }
+    for (size_t i = 0; i < size; ++i)
+    {
+      out[start + i] = mean + sigma * std::sqrt(-2. * std::log(u1[i])) * std::cos(2. * M_PI * u2[i]);
+    }
+  }
+}
+
+void PHRandomStream::Poisson(const uint64_t first, const size_t n, unsigned int *out, const double mean) const
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    out[i] = Get(first + i).Poisson(mean);
+  }
+}
+
+void PHRandomStream::Poisson(const uint64_t first, const size_t n, unsigned int *out, const double *mean) const
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    out[i] = Get(first + i).Poisson(mean[i]);
+  }
+}
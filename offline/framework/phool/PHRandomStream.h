@@ -0,0 +1,156 @@
+#ifndef PHOOL_PHRANDOMSTREAM_H
+#define PHOOL_PHRANDOMSTREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//! counter based random numbers (Philox4x32-10) for data parallel modules
+/*!
+  The random numbers are a pure function of (seed, module, stream, run,
+  event, item, draw), there is no generator state shared between
+  draws. A thread working on item i (a g4hit, a channel, an electron)
+  gets the same numbers for it no matter which thread did the other
+  items, or in which order, so the output for a given seed does not
+  depend on the number of threads:
+
+    // InitRun
+    m_random = PHRandomStream(Name());             // seed from PHRandomSeed
+    // process_event
+    m_random.SetEvent(runnumber, eventnumber);
+    m_threadpool->parallel_for(nhits, [&](size_t i)
+    {
+      auto rng = m_random.Get(i);                  // sequence of item i
+      double x = rng.Gaus(0, sigma);
+      unsigned int n = rng.Poisson(mean);
+    });
+
+  The bulk functions fill arrays with one draw per item, starting at
+  item first. A const PHRandomStream can be used by many threads, a
+  Generator belongs to one thread.
+*/
+class PHRandomStream
+{
+ public:
+  //! sequence of draws of one item
+  class Generator
+  {
+   public:
+    Generator(const uint32_t key0, const uint32_t key1, const uint32_t item0, const uint32_t item1, const uint32_t event)
+      : m_key{key0, key1}
+      , m_counter{0, item0, item1, event}
+    {
+    }
+
+    //! uniform in (0,1), 0 and 1 are never returned
+    double Uniform()
+    {
+      if (m_position >= 4)
+      {
+        PHRandomStream::philox(m_counter, m_key, m_block);
+        ++m_counter[0];
+        m_position = 0;
+      }
+      const double u = PHRandomStream::to_uniform(m_block[m_position], m_block[m_position + 1]);
+      m_position += 2;
+      return u;
+    }
+
+    //! gaussian (Box-Muller)
+    double Gaus(const double mean = 0, const double sigma = 1);
+
+    //! poisson, inversion for small means, transformed rejection (PTRS) above
+    unsigned int Poisson(const double mean);
+
+   private:
+    uint32_t m_key[2];
+    uint32_t m_counter[4];
+    uint32_t m_block[4] = {0, 0, 0, 0};
+    unsigned int m_position = 4;
+
+    bool m_has_gaus = false;
+    double m_gaus = 0;
+  };
+
+  //! unusable until a seed is given
+  PHRandomStream() = default;
+
+  //! seed from PHRandomSeed, so fixed seeds (recoConsts RANDOMSEED) are honoured
+  explicit PHRandomStream(const std::string &module, const uint32_t stream = 0);
+
+  //! explicit seed
+  PHRandomStream(const uint32_t seed, const std::string &module, const uint32_t stream = 0);
+
+  //! select the event, all draws depend on it
+  void SetEvent(const int run, const uint64_t event);
+
+  //! next event, for modules without event header
+  void NextEvent() { SetEvent(m_run, m_event + 1); }
+
+  int run() const { return m_run; }
+  uint64_t event() const { return m_event; }
+  uint32_t seed() const { return m_seed; }
+
+  //! draws of one item
+  Generator Get(const uint64_t item) const
+  {
+    return Generator(m_event_key[0], m_event_key[1], static_cast<uint32_t>(item), static_cast<uint32_t>(item >> 32), m_stream);
+  }
+
+  //!@name bulk draws, out[i] is the first draw of item first + i
+  //@{
+  void Uniform(const uint64_t first, const size_t n, double *out) const;
+  void Gaus(const uint64_t first, const size_t n, double *out, const double mean = 0, const double sigma = 1) const;
+  void Poisson(const uint64_t first, const size_t n, unsigned int *out, const double mean) const;
+  //! one mean per item
+  void Poisson(const uint64_t first, const size_t n, unsigned int *out, const double *mean) const;
+  //@}
+
+  //! uniform in (0,1) from 53 bits of two words
+  static double to_uniform(const uint32_t high, const uint32_t low)
+  {
+    const uint64_t bits = (static_cast<uint64_t>(high) << 21) ^ (low >> 11);
+    return (static_cast<double>(bits) + 0.5) * 0x1p-53;
+  }
+
+  //! Philox4x32 with 10 rounds
+  static void philox(const uint32_t *counter, const uint32_t *key, uint32_t *out)
+  {
+    uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+    uint32_t k[2] = {key[0], key[1]};
+    for (int round = 0; round < 10; ++round)
+    {
+      const uint64_t p0 = static_cast<uint64_t>(0xD2511F53U) * c[0];
+      const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57U) * c[2];
+      const uint32_t c0 = static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0];
+      const uint32_t c2 = static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1];
+      c[0] = c0;
+      c[1] = static_cast<uint32_t>(p1);
+      c[2] = c2;
+      c[3] = static_cast<uint32_t>(p0);
+      k[0] += 0x9E3779B9U;
+      k[1] += 0xBB67AE85U;
+    }
+    for (int i = 0; i < 4; ++i)
+    {
+      out[i] = c[i];
+    }
+  }
+
+ private:
+  void setKey(const std::string &module);
+
+  uint32_t m_seed = 0;
+  uint32_t m_stream = 0;
+
+  //! key from seed and module name
+  uint32_t m_key[2] = {0, 0};
+
+  //! key from m_key, run and event
+  uint32_t m_event_key[2] = {0, 0};
+
+  int m_run = 0;
+  uint64_t m_event = 0;
+};
+
+#endif
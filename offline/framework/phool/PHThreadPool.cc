@@ -0,0 +1,118 @@
+#include "PHThreadPool.h"
+
+#include "PHProfiler.h"
+#include "PHTrace.h"
+
+#include <chrono>
+
+PHThreadPool::PHThreadPool(const unsigned int nthreads)
+{
+  unsigned int nworkers = (nthreads > 0) ? nthreads : std::thread::hardware_concurrency();
+  // the calling thread is one of the workers
+  if (nworkers > 0)
+  {
+    --nworkers;
+  }
+  m_threads.reserve(nworkers);
+  for (unsigned int i = 0; i < nworkers; ++i)
+  {
+    m_threads.emplace_back(&PHThreadPool::worker, this);
+  }
+}
+
+PHThreadPool::~PHThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_start_cv.notify_all();
+  for (auto &thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void PHThreadPool::parallel_for(const size_t ntasks, const std::function<void(size_t)> &func)
+{
+  if (ntasks == 0)
+  {
+    return;
+  }
+  // nested or concurrent calls run serially, the threads are busy
+  bool idle = false;
+  if (m_threads.empty() || ntasks == 1 || !m_running.compare_exchange_strong(idle, true))
+  {
+    for (size_t i = 0; i < ntasks; ++i)
+    {
+      func(i);
+    }
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_func = &func;
+    m_tag = PHProfiler::Active();
+    m_ntasks = ntasks;
+    m_next = 0;
+    m_active = m_threads.size();
+    ++m_generation;
+  }
+  m_start_cv.notify_all();
+
+  run_tasks(func, ntasks, m_tag);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_done_cv.wait(lock, [this]
+                 { return m_active == 0; });
+  m_func = nullptr;
+  m_busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  m_running = false;
+}
+
+void PHThreadPool::run_tasks(const std::function<void(size_t)> &func, const size_t ntasks, const char *tag)
+{
+  // one span per thread and loop shows the load balance
+  PHTraceScope trace("parallel_for", "task");
+  // the samples of the workers go to the module which started the loop
+  const char *previous = PHProfiler::Active();
+  PHProfiler::SetActive(tag);
+  for (size_t i = m_next++; i < ntasks; i = m_next++)
+  {
+    func(i);
+  }
+  PHProfiler::SetActive(previous);
+}
+
+void PHThreadPool::worker()
+{
+  uint64_t generation = 0;
+  while (true)
+  {
+    const std::function<void(size_t)> *func = nullptr;
+    const char *tag = nullptr;
+    size_t ntasks = 0;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_start_cv.wait(lock, [this, generation]
+                      { return m_stop || m_generation != generation; });
+      if (m_stop)
+      {
+        return;
+      }
+      generation = m_generation;
+      func = m_func;
+      tag = m_tag;
+      ntasks = m_ntasks;
+    }
+    run_tasks(*func, ntasks, tag);
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (--m_active == 0)
+      {
+        m_done_cv.notify_one();
+      }
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#ifndef PHOOL_PHTHREADPOOL_H
+#define PHOOL_PHTHREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! persistent pool of worker threads for data parallel loops
+/*!
+  The threads are started once (e.g. in InitRun) and reused for every
+  call to parallel_for, which avoids creating and joining threads for
+  every event. Work is handed out dynamically through a shared atomic
+  index, so threads which finish early pick up the remaining tasks.
+  The calling thread participates in the loop.
+
+  Tasks must not throw and should write their results into per task
+  buffers which the caller merges after parallel_for returns, no lock
+  is needed for this since parallel_for only returns once all tasks
+  are done.
+
+  A pool can be shared between modules (see Fun4AllServer::ThreadPool()).
+  A parallel_for called from inside a task, or while another thread
+  has a parallel_for running, is executed serially by the caller.
+*/
+class PHThreadPool
+{
+ public:
+  //! nthreads is the total number of threads including the caller,
+  //! 0 uses std::thread::hardware_concurrency()
+  explicit PHThreadPool(const unsigned int nthreads = 0);
+  virtual ~PHThreadPool();
+
+  PHThreadPool(const PHThreadPool &) = delete;
+  PHThreadPool &operator=(const PHThreadPool &) = delete;
+
+  //! number of threads working on a parallel_for (including the caller)
+  unsigned int size() const { return m_threads.size() + 1; }
+
+  //! run func(i) for all i in [0, ntasks), returns when all tasks are done
+  void parallel_for(const size_t ntasks, const std::function<void(size_t)> &func);
+
+  //! combine func(i) for all i in [0, ntasks) with op, in task order so the result is reproducible
+  template <typename T, typename Func, typename Op>
+  T parallel_reduce(const size_t ntasks, T init, const Func &func, const Op &op)
+  {
+    // std::vector<bool> packs neighbouring results into one word, which the tasks would race on
+    using Result = std::conditional_t<std::is_same_v<T, bool>, unsigned char, T>;
+    std::vector<Result> results(ntasks);
+    parallel_for(ntasks, [&results, &func](size_t i)
+                 { results[i] = func(i); });
+    for (auto &result : results)
+    {
+      init = op(std::move(init), static_cast<T>(std::move(result)));
+    }
+    return init;
+  }
+
+  //! wall time (ms) spent in parallel_for calls which ran on the pool threads
+  double busy_time() const { return m_busy_ns.load() * 1e-6; }
+
+ private:
+  void worker();
+  void run_tasks(const std::function<void(size_t)> &func, const size_t ntasks, const char *tag);
+
+  std::vector<std::thread> m_threads;
+  std::mutex m_mutex;
+  std::condition_variable m_start_cv;
+  std::condition_variable m_done_cv;
+  const std::function<void(size_t)> *m_func{nullptr};
+  const char *m_tag{nullptr};  // profiler tag of the caller
+  size_t m_ntasks{0};
+  std::atomic<size_t> m_next{0};
+  std::atomic<bool> m_running{false};
+  std::atomic<uint64_t> m_busy_ns{0};
+  unsigned int m_active{0};
+  uint64_t m_generation{0};
+  bool m_stop{false};
+};
+
+#endif
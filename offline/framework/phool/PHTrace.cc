@@ -0,0 +1,106 @@
+#include "PHTrace.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  // names are module and phase names, only quotes and backslashes need escaping
+  std::string escape(const std::string &in)
+  {
+    std::string out;
+    out.reserve(in.size());
+    for (const char c : in)
+    {
+      if (c == '"' || c == '\\')
+      {
+        out += '\\';
+      }
+      out += c;
+    }
+    return out;
+  }
+}  // namespace
+
+PHTrace *PHTrace::instance()
+{
+  static PHTrace trace;
+  return &trace;
+}
+
+PHTrace::PHTrace()
+  : m_Start(std::chrono::steady_clock::now())
+{
+  // the creating thread (the one running Fun4AllServer) is thread 0
+  ThreadBuffer();
+}
+
+PHTrace::Buffer &PHTrace::ThreadBuffer()
+{
+  // the trace is a singleton, so the cached pointer stays valid
+  thread_local Buffer *buffer = nullptr;
+  if (!buffer)
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Buffers.push_back(std::make_unique<Buffer>());
+    buffer = m_Buffers.back().get();
+    buffer->tid = m_Buffers.size() - 1;
+  }
+  return *buffer;
+}
+
+void PHTrace::Record(const std::string &name, const char *category, const uint64_t begin, const uint64_t end)
+{
+  ThreadBuffer().spans.push_back({name, category, begin, end});
+}
+
+size_t PHTrace::size() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  size_t n = 0;
+  for (const auto &buffer : m_Buffers)
+  {
+    n += buffer->spans.size();
+  }
+  return n;
+}
+
+void PHTrace::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto &buffer : m_Buffers)
+  {
+    buffer->spans.clear();
+  }
+}
+
+int PHTrace::WriteJson(const std::string &filename) const
+{
+  std::ofstream out(filename);
+  if (!out.is_open())
+  {
+    std::cout << "PHTrace::WriteJson - could not open " << filename << std::endl;
+    return -1;
+  }
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  // complete events ("X"), times in us. Fixed notation, the default precision
+  // of 6 digits rounds the begin of a span to 0.1 s after 100 s of running
+  out << std::fixed << std::setprecision(3);
+  out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  bool first = true;
+  for (const auto &buffer : m_Buffers)
+  {
+    out << (first ? "" : ",") << "\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << buffer->tid
+        << ", \"args\": {\"name\": \"" << (buffer->tid == 0 ? "main" : "thread " + std::to_string(buffer->tid)) << "\"}}";
+    first = false;
+    for (const auto &span : buffer->spans)
+    {
+      out << ",\n{\"name\": \"" << escape(span.name) << "\", \"cat\": \"" << (span.category ? span.category : "")
+          << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->tid
+          << ", \"ts\": " << span.begin / 1000. << ", \"dur\": " << (span.end - span.begin) / 1000. << "}";
+    }
+  }
+  out << "\n]}\n";
+  return 0;
+}
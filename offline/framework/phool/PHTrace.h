@@ -0,0 +1,128 @@
+#ifndef PHOOL_PHTRACE_H
+#define PHOOL_PHTRACE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//! opt-in timeline of the processing, written as Chrome trace json
+/*!
+  Records begin and end of named spans per thread. Fun4AllServer::EnableTracing()
+  switches it on and adds spans for the module process_event calls, the
+  input reads and the output writes; modules can add sub-phases with
+
+    PHTRACE_SCOPE("TpcClusterizer::sector");
+
+  The file written at the end of the job opens in chrome://tracing or
+  https://ui.perfetto.dev. When tracing is off a scope costs one atomic
+  load, spans are collected in per thread buffers without locking.
+*/
+class PHTrace
+{
+ public:
+  static PHTrace *instance();
+
+  PHTrace(const PHTrace &) = delete;
+  PHTrace &operator=(const PHTrace &) = delete;
+
+  void Enable(const bool flag = true) { m_Enabled.store(flag, std::memory_order_relaxed); }
+  bool Enabled() const { return m_Enabled.load(std::memory_order_relaxed); }
+
+  //! ns since the trace was created
+  uint64_t Now() const
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count();
+  }
+
+  //! add a span of the calling thread, times from Now()
+  void Record(const std::string &name, const char *category, const uint64_t begin, const uint64_t end);
+
+  //! write all spans, returns 0 on success. No thread may record meanwhile
+  int WriteJson(const std::string &filename) const;
+
+  //! drop all spans. No thread may record meanwhile
+  void Clear();
+
+  //! number of recorded spans
+  size_t size() const;
+
+ private:
+  PHTrace();
+
+  class Span
+  {
+   public:
+    std::string name;
+    const char *category = nullptr;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+  };
+
+  class Buffer
+  {
+   public:
+    unsigned int tid = 0;
+    std::vector<Span> spans;
+  };
+
+  //! buffer of the calling thread, created on first use
+  Buffer &ThreadBuffer();
+
+  std::atomic<bool> m_Enabled{false};
+  std::chrono::steady_clock::time_point m_Start;
+
+  //! guards m_Buffers, not the spans inside
+  mutable std::mutex m_Mutex;
+  std::vector<std::unique_ptr<Buffer>> m_Buffers;
+};
+
+//! records the enclosing scope as a span if tracing is enabled
+class PHTraceScope
+{
+ public:
+  //! category must be a string literal (or outlive the trace), name is only copied if tracing is enabled
+  explicit PHTraceScope(const char *name, const char *category = "phase")
+  {
+    PHTrace *trace = PHTrace::instance();
+    if (trace->Enabled())
+    {
+      m_Name = name;
+      m_Category = category;
+      m_Begin = trace->Now();
+      m_Active = true;
+    }
+  }
+
+  explicit PHTraceScope(const std::string &name, const char *category = "phase")
+    : PHTraceScope(name.c_str(), category)
+  {
+  }
+
+  ~PHTraceScope()
+  {
+    if (m_Active)
+    {
+      PHTrace *trace = PHTrace::instance();
+      trace->Record(m_Name, m_Category, m_Begin, trace->Now());
+    }
+  }
+
+  PHTraceScope(const PHTraceScope &) = delete;
+  PHTraceScope &operator=(const PHTraceScope &) = delete;
+
+ private:
+  std::string m_Name;
+  const char *m_Category = nullptr;
+  uint64_t m_Begin = 0;
+  bool m_Active = false;
+};
+
+#define PHTRACE_CONCAT_IMPL(a, b) a##b
+#define PHTRACE_CONCAT(a, b) PHTRACE_CONCAT_IMPL(a, b)
+#define PHTRACE_SCOPE(name) PHTraceScope PHTRACE_CONCAT(phtrace_scope_, __LINE__)(name)
+
+#endif
@@ -8,21 +8,23 @@
 
 #include <TObject.h>
 
+#include <cstdint>
 #include <string>
 
 class PHCompositeNode;
 
 namespace findNode
 {
+  // object of type T held by the given node, nullptr if none
   template <class T>
-  T *getClass(PHCompositeNode *top, const std::string &name)
+  T *getClassFromNode(PHNode *FoundNode)
   {
-    PHNodeIterator iter(top);
-    PHNode *FoundNode = iter.findFirst(name);  // returns pointer to PHNode
     if (!FoundNode)
     {
       return nullptr;
     }
+    // payloads of lazily read input nodes are read on first access
+    FoundNode->loadLazy();
     // first test if it is a PHDataNode
     PHDataNode<T> *DNode = dynamic_cast<PHDataNode<T> *>(FoundNode);
     if (DNode)
@@ -55,6 +57,52 @@ namespace findNode
 
     return nullptr;
   }
+
+  // lookups are cached by the top node, see PHCompositeNode::findFirst
+  template <class T>
+  T *getClass(PHCompositeNode *top, const std::string &name)
+  {
+    PHNodeIterator iter(top);
+    return getClassFromNode<T>(iter.findFirst(name));
+  }
+
+  // handle for a node looked up every event, e.g. a member of a SubsysReco:
+  //   findNode::NodeHandle<SvtxTrackMap> m_trackmap{"SvtxTrackMap"};
+  //   SvtxTrackMap *trackmap = m_trackmap.get(topNode);
+  // the node is only searched again after a node tree has changed, the object
+  // is taken from the node each time since it may have been replaced
+  template <class T>
+  class NodeHandle
+  {
+   public:
+    explicit NodeHandle(const std::string &name)
+      : m_name(name)
+    {
+    }
+
+    T *get(PHCompositeNode *top)
+    {
+      if (top != m_top || PHNode::treeGeneration() != m_generation)
+      {
+        m_top = top;
+        m_generation = PHNode::treeGeneration();
+        PHNodeIterator iter(top);
+        m_node = iter.findFirst(m_name);
+      }
+      return getClassFromNode<T>(m_node);
+    }
+
+    const std::string &name() const { return m_name; }
+
+    // force a new lookup at the next get()
+    void reset() { m_top = nullptr; }
+
+   private:
+    std::string m_name;
+    PHCompositeNode *m_top = nullptr;
+    PHNode *m_node = nullptr;
+    uint64_t m_generation = 0;
+  };
 }  // namespace findNode
 
 #endif
@@ -1,15 +1,55 @@
 #include "onnxlib.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace
+{
+  //! the environment has to outlive all sessions created with it
+  Ort::Env &onnxEnv()
+  {
+    static Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
+    return env;
+  }
+}  // namespace
+
 // --------------------------------------------------
 Ort::Session *onnxSession(std::string &modelfile)
 {
-  Ort::Env env(OrtLoggingLevel::ORT_LOGGING_LEVEL_WARNING, "fit");
   Ort::SessionOptions sessionOptions;
   sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
 
-  return new Ort::Session(env, modelfile.c_str(), sessionOptions);
+  return new Ort::Session(onnxEnv(), modelfile.c_str(), sessionOptions);
+}
+
+Ort::Session *onnxSession(std::string &modelfile, const onnxOptions &options)
+{
+  Ort::SessionOptions sessionOptions;
+  sessionOptions.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_EXTENDED);
+  sessionOptions.SetIntraOpNumThreads(options.intra_op_threads);
+
+  try
+  {
+    if (options.provider == onnxOptions::TensorRT)
+    {
+      OrtTensorRTProviderOptions trtOptions{};
+      trtOptions.device_id = options.device_id;
+      sessionOptions.AppendExecutionProvider_TensorRT(trtOptions);
+    }
+    // cuda is also the fallback for operators TensorRT does not support
+    if (options.provider == onnxOptions::CUDA || options.provider == onnxOptions::TensorRT)
+    {
+      OrtCUDAProviderOptions cudaOptions;
+      cudaOptions.device_id = options.device_id;
+      sessionOptions.AppendExecutionProvider_CUDA(cudaOptions);
+    }
+  }
+  catch (const Ort::Exception &e)
+  {
+    std::cout << "onnxSession: execution provider not available, using cpu: " << e.what() << std::endl;
+  }
+
+  return new Ort::Session(onnxEnv(), modelfile.c_str(), sessionOptions);
 }
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn)
@@ -63,3 +103,97 @@ std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &inpu
   session->Run(Ort::RunOptions{nullptr}, inputNames.data(), inputTensors.data(), 1, outputNames.data(), outputTensors.data(), 1);
   return outputTensorValues;
 }
+
+// --------------------------------------------------
+onnxBatch::onnxBatch(Ort::Session *session, const std::vector<int64_t> &inputshape, int Nreturn)
+  : m_Session(session)
+  , m_MemoryInfo(Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault))
+  , m_NReturn(Nreturn)
+{
+  m_InputShape.push_back(0);
+  for (auto dim : inputshape)
+  {
+    m_InputShape.push_back(dim);
+    m_EntrySize *= dim;
+  }
+  m_OutputShape = {0, Nreturn};
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  char *name = session->GetInputName(0, allocator);
+  m_InputName = name;
+  allocator.Free(name);
+  name = session->GetOutputName(0, allocator);
+  m_OutputName = name;
+  allocator.Free(name);
+
+  // a positive first dimension is a fixed batch size
+  std::vector<int64_t> modelshape = session->GetInputTypeInfo(0).GetTensorTypeAndShapeInfo().GetShape();
+  if (!modelshape.empty() && modelshape[0] > 0)
+  {
+    m_MaxBatch = modelshape[0];
+    m_BatchInput.resize(m_MaxBatch * m_EntrySize);
+    m_BatchOutput.resize(m_MaxBatch * m_NReturn);
+  }
+}
+
+float *onnxBatch::input(int N)
+{
+  if ((int64_t) m_Input.size() < N * m_EntrySize)
+  {
+    m_Input.resize(N * m_EntrySize);
+    m_TensorBatch = -1;  // the buffer moved
+  }
+  return m_Input.data();
+}
+
+void onnxBatch::makeTensors(int batch)
+{
+  if (batch == m_TensorBatch)
+  {
+    return;
+  }
+  float *in = m_MaxBatch > 0 ? m_BatchInput.data() : m_Input.data();
+  float *out = m_MaxBatch > 0 ? m_BatchOutput.data() : m_Output.data();
+  m_InputShape[0] = batch;
+  m_OutputShape[0] = batch;
+  m_InputTensors.clear();
+  m_OutputTensors.clear();
+  m_InputTensors.push_back(Ort::Value::CreateTensor<float>(m_MemoryInfo, in, batch * m_EntrySize, m_InputShape.data(), m_InputShape.size()));
+  m_OutputTensors.push_back(Ort::Value::CreateTensor<float>(m_MemoryInfo, out, batch * m_NReturn, m_OutputShape.data(), m_OutputShape.size()));
+  m_TensorBatch = batch;
+}
+
+const std::vector<float> &onnxBatch::run(int N)
+{
+  const char *inputNames[] = {m_InputName.c_str()};
+  const char *outputNames[] = {m_OutputName.c_str()};
+  input(N);
+  if ((int64_t) m_Output.size() < N * m_NReturn)
+  {
+    m_Output.resize(N * m_NReturn);
+    m_TensorBatch = -1;
+  }
+  if (N <= 0)
+  {
+    return m_Output;
+  }
+
+  if (m_MaxBatch == 0)
+  {
+    makeTensors(N);
+    m_Session->Run(Ort::RunOptions{nullptr}, inputNames, m_InputTensors.data(), 1, outputNames, m_OutputTensors.data(), 1);
+    return m_Output;
+  }
+
+  // fixed batch size, the last batch is padded with zeros
+  makeTensors(m_MaxBatch);
+  for (int first = 0; first < N; first += m_MaxBatch)
+  {
+    int n = std::min(m_MaxBatch, N - first);
+    std::copy(m_Input.begin() + first * m_EntrySize, m_Input.begin() + (first + n) * m_EntrySize, m_BatchInput.begin());
+    std::fill(m_BatchInput.begin() + n * m_EntrySize, m_BatchInput.end(), 0);
+    m_Session->Run(Ort::RunOptions{nullptr}, inputNames, m_InputTensors.data(), 1, outputNames, m_OutputTensors.data(), 1);
+    std::copy(m_BatchOutput.begin(), m_BatchOutput.begin() + n * m_NReturn, m_Output.begin() + first * m_NReturn);
+  }
+  return m_Output;
+}
@@ -7,12 +7,75 @@
 #include <onnxruntime_cxx_api.h>
 #pragma GCC diagnostic pop
 
+#include <cstdint>
+#include <string>
+#include <vector>
+
 // This is a stub for some ONNX code refactoring
 
+//! session configuration
+struct onnxOptions
+{
+  enum Provider
+  {
+    CPU = 0,
+    CUDA = 1,
+    TensorRT = 2
+  };
+
+  //! threads used within one operator, 0 lets onnxruntime decide
+  int intra_op_threads{1};
+  //! execution provider, falls back to the cpu if it is not available
+  Provider provider{CPU};
+  int device_id{0};
+};
+
 Ort::Session *onnxSession(std::string &modelfile);
 
+Ort::Session *onnxSession(std::string &modelfile, const onnxOptions &options);
+
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nsamp, int Nreturn);
 
 std::vector<float> onnxInference(Ort::Session *session, std::vector<float> &input, int N, int Nx, int Ny, int Nz, int Nreturn);
 
+//! batched inference with buffers reused between calls
+/*!
+  The inputs of N entries are filled into input(N) and run(N) evaluates all of them
+  in one call, the first N * Nreturn values of the result are its output. Models with a fixed batch size are run
+  in as many batches as needed. The tensors wrapping the buffers are only recreated
+  when the batch size changes.
+*/
+class onnxBatch
+{
+ public:
+  //! inputshape is the shape of one entry without the batch dimension
+  onnxBatch(Ort::Session *session, const std::vector<int64_t> &inputshape, int Nreturn);
+
+  //! input buffer for N entries, the content is kept between calls
+  float *input(int N);
+
+  //! run the model on the first N entries of the input buffer
+  const std::vector<float> &run(int N);
+
+ private:
+  void makeTensors(int batch);
+
+  Ort::Session *m_Session{nullptr};
+  Ort::MemoryInfo m_MemoryInfo{nullptr};
+  std::vector<int64_t> m_InputShape;
+  std::vector<int64_t> m_OutputShape;
+  int64_t m_EntrySize{1};
+  int m_NReturn{0};
+  int m_MaxBatch{0};  // 0: no limit
+  int m_TensorBatch{-1};
+  std::string m_InputName;
+  std::string m_OutputName;
+  std::vector<float> m_Input;
+  std::vector<float> m_Output;
+  std::vector<float> m_BatchInput;
+  std::vector<float> m_BatchOutput;
+  std::vector<Ort::Value> m_InputTensors;
+  std::vector<Ort::Value> m_OutputTensors;
+};
+
 #endif
@@ -1,5 +1,7 @@
 #include "RawTowerGeomContainer.h"
 
+#include "TowerInfoContainer.h"
+
 #include <phool/phool.h>  // for PHOOL_VIRTUAL_WARN
 
 #include <iostream>
@@ -28,3 +30,15 @@ RawTowerGeomContainer::Range RawTowerGeomContainer::get_tower_geometries()
   PHOOL_VIRTUAL_WARN("get_tower_geometries()");
   return Range(DummyMap.begin(), DummyMap.end());
 }
+
+RawTowerGeom* RawTowerGeomContainer::get_tower_geometry(TowerInfoContainer* towers, const unsigned int channel)
+{
+  const unsigned int towerkey = towers->encode_key(channel);
+  return get_tower_geometry(towers->getTowerEtaBin(towerkey), towers->getTowerPhiBin(towerkey));
+}
+
+const RawTowerGeomContainer::TowerCenter* RawTowerGeomContainer::get_tower_center(TowerInfoContainer* towers, const unsigned int channel)
+{
+  const unsigned int towerkey = towers->encode_key(channel);
+  return get_tower_center(towers->getTowerEtaBin(towerkey), towers->getTowerPhiBin(towerkey));
+}
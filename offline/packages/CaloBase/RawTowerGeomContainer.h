@@ -12,6 +12,7 @@
 #include <utility>
 
 class RawTowerGeom;
+class TowerInfoContainer;
 
 /*! \class RawTowerGeomContainer
     \brief base class to describe calorimeter geometries
@@ -50,6 +51,39 @@ class RawTowerGeomContainer : public PHObject
   virtual ConstRange get_tower_geometries(void) const;
   virtual Range get_tower_geometries(void);
 
+  //! tower center with the trigonometry done, for per tower loops
+  class TowerCenter
+  {
+   public:
+    double x{0};
+    double y{0};
+    double z{0};
+    double r{0};    // RawTowerGeom::get_center_radius()
+    double eta{0};  // RawTowerGeom::get_eta(), seen from (0,0,0)
+    double phi{0};  // atan2(y, x)
+    double cosphi{1};
+    double sinphi{0};
+  };
+
+  //! tower with key encode_towerid(calorimeter id, index1, index2), nullptr if there is none
+  /*! index1 and index2 are the eta and phi bin of a cylindrical calorimeter
+      (TowerInfoContainer::getTowerEtaBin and getTowerPhiBin). The towers
+      are looked up in a dense table by index instead of the map */
+  virtual RawTowerGeom *get_tower_geometry(const int /*index1*/, const int /*index2*/)
+  {
+    PHOOL_VIRTUAL_WARN("get_tower_geometry(const int, const int)");
+    return nullptr;
+  }
+  //! precomputed center of the same tower, nullptr if there is none or the keys do not fit a dense table
+  virtual const TowerCenter *get_tower_center(const int /*index1*/, const int /*index2*/)
+  {
+    PHOOL_VIRTUAL_WARN("get_tower_center(const int, const int)");
+    return nullptr;
+  }
+  //! the same for a channel of a TowerInfoContainer of this calorimeter
+  RawTowerGeom *get_tower_geometry(TowerInfoContainer *towers, const unsigned int channel);
+  const TowerCenter *get_tower_center(TowerInfoContainer *towers, const unsigned int channel);
+
   virtual unsigned int size() const
   {
     PHOOL_VIRTUAL_WARN("size()");
@@ -2,7 +2,9 @@
 
 #include "RawTowerGeom.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <map>
@@ -59,6 +61,7 @@ RawTowerGeomContainerv1::add_tower_geometry(RawTowerGeom* geo)
   }
 
   _geoms[geo->get_id()] = geo;
+  m_TableValid = false;
   return _geoms.find(geo->get_id());
 }
 
@@ -73,6 +76,80 @@ RawTowerGeomContainerv1::get_tower_geometry(RawTowerDefs::keytype key)
   return nullptr;
 }
 
+RawTowerGeom*
+RawTowerGeomContainerv1::get_tower_geometry(const int index1, const int index2)
+{
+  const int index = table_index(index1, index2);
+  if (index < 0)
+  {
+    // the towers do not fit a dense table
+    return (m_TowerTable.empty() && index1 >= 0 && index2 >= 0 && index1 < 0xFFF && index2 < 0xFFF) ? get_tower_geometry(RawTowerDefs::encode_towerid(_caloid, index1, index2)) : nullptr;
+  }
+  return m_TowerTable[index];
+}
+
+const RawTowerGeomContainer::TowerCenter*
+RawTowerGeomContainerv1::get_tower_center(const int index1, const int index2)
+{
+  const int index = table_index(index1, index2);
+  if (index < 0 || !m_TowerTable[index])
+  {
+    return nullptr;
+  }
+  return &m_CenterTable[index];
+}
+
+int RawTowerGeomContainerv1::table_index(const int index1, const int index2)
+{
+  if (!m_TableValid)
+  {
+    build_table();
+  }
+  if (index1 < 0 || index1 >= m_TableIndex1 || index2 < 0 || index2 >= m_TableIndex2)
+  {
+    return -1;
+  }
+  return index1 * m_TableIndex2 + index2;
+}
+
+void RawTowerGeomContainerv1::build_table()
+{
+  m_TableValid = true;
+  m_TableIndex1 = 0;
+  m_TableIndex2 = 0;
+  m_TowerTable.clear();
+  m_CenterTable.clear();
+  for (const auto& [key, geo] : _geoms)
+  {
+    m_TableIndex1 = std::max<int>(m_TableIndex1, RawTowerDefs::decode_index1(key) + 1);
+    m_TableIndex2 = std::max<int>(m_TableIndex2, RawTowerDefs::decode_index2(key) + 1);
+  }
+  // keys which do not use two indices (e.g. three in RawTowerDefs::encode_towerid()) can make
+  // the table mostly empty, those containers stay with the map lookup
+  if (static_cast<size_t>(m_TableIndex1) * m_TableIndex2 > 4 * _geoms.size() + 1024)
+  {
+    m_TableIndex1 = 0;
+    m_TableIndex2 = 0;
+    return;
+  }
+  m_TowerTable.resize(m_TableIndex1 * m_TableIndex2, nullptr);
+  m_CenterTable.resize(m_TowerTable.size());
+  for (const auto& [key, geo] : _geoms)
+  {
+    const int index = RawTowerDefs::decode_index1(key) * m_TableIndex2 + RawTowerDefs::decode_index2(key);
+    m_TowerTable[index] = geo;
+    TowerCenter& center = m_CenterTable[index];
+    center.x = geo->get_center_x();
+    center.y = geo->get_center_y();
+    center.z = geo->get_center_z();
+    center.r = geo->get_center_radius();
+    center.eta = geo->get_eta();
+    center.phi = std::atan2(center.y, center.x);
+    center.cosphi = std::cos(center.phi);
+    center.sinphi = std::sin(center.phi);
+  }
+}
+
 int RawTowerGeomContainerv1::isValid() const
 {
   return (!_geoms.empty());
@@ -80,6 +157,9 @@ int RawTowerGeomContainerv1::isValid() const
 
 void RawTowerGeomContainerv1::Reset()
 {
+  m_TableValid = false;
+  m_TowerTable.clear();
+  m_CenterTable.clear();
   while (_geoms.begin() != _geoms.end())
   {
     delete _geoms.begin()->second;
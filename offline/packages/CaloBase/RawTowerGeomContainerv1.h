@@ -6,6 +6,7 @@
 #include "RawTowerDefs.h"
 
 #include <iostream>
+#include <vector>
 
 class RawTowerGeom;
 
@@ -33,12 +34,29 @@ class RawTowerGeomContainerv1 : public RawTowerGeomContainer
   ConstRange get_tower_geometries(void) const override;
   Range get_tower_geometries(void) override;
 
+  using RawTowerGeomContainer::get_tower_center;
+  using RawTowerGeomContainer::get_tower_geometry;
+  //! the table is built on the first lookup, towers changed after that are not seen
+  RawTowerGeom *get_tower_geometry(const int index1, const int index2) override;
+  const TowerCenter *get_tower_center(const int index1, const int index2) override;
+
   unsigned int size() const override { return _geoms.size(); }
 
  protected:
+  //! position in the dense table, -1 if outside
+  int table_index(const int index1, const int index2);
+  void build_table();
+
   RawTowerDefs::CalorimeterId _caloid;
   Map _geoms;
 
+  // dense (index1, index2) tables, rebuilt after towers were added
+  bool m_TableValid{false};                  //!
+  int m_TableIndex1{0};                      //!
+  int m_TableIndex2{0};                      //!
+  std::vector<RawTowerGeom *> m_TowerTable;  //!
+  std::vector<TowerCenter> m_CenterTable;    //!
+
   ClassDefOverride(RawTowerGeomContainerv1, 1)
 };
 
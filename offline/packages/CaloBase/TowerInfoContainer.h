@@ -4,6 +4,7 @@
 #include <phool/PHObject.h>
 
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <map>
@@ -56,6 +57,14 @@ class TowerInfoContainer : public PHObject
 
   virtual DETECTOR get_detectorid() const { return DETECTOR_INVALID; }
 
+  // contiguous per channel arrays of size(), only available if the towers are stored
+  // as structure of arrays (TowerInfoContainerv5), nullptr otherwise
+  virtual float* get_energy_array() { return nullptr; }
+  virtual float* get_time_array() { return nullptr; }
+  virtual float* get_chi2_array() { return nullptr; }
+  virtual float* get_pedestal_array() { return nullptr; }
+  virtual uint8_t* get_status_array() { return nullptr; }
+
  private:
   ClassDefOverride(TowerInfoContainer, 1);
 };
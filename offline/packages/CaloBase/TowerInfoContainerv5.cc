@@ -0,0 +1,148 @@
+#include "TowerInfoContainerv5.h"
+#include "TowerInfov5.h"
+
+#include <algorithm>
+
+TowerInfoContainerv5::TowerInfoContainerv5(DETECTOR detec)
+  : _detector(detec)
+{
+  int nchannels = 744;
+  if (_detector == DETECTOR::SEPD)
+  {
+    nchannels = 744;
+  }
+  else if (_detector == DETECTOR::EMCAL)
+  {
+    nchannels = 24576;
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    nchannels = 1536;
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    nchannels = 256;
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    nchannels = 52;
+  }
+  _energy.resize(nchannels, 0);
+  _time.resize(nchannels, 0);
+  _chi2.resize(nchannels, 0);
+  _pedestal.resize(nchannels, 0);
+  _status.resize(nchannels, 0);
+  make_towers();
+}
+
+TowerInfoContainerv5::TowerInfoContainerv5(const TowerInfoContainerv5 &source)
+  : TowerInfoContainer(source)
+  , _detector(source.get_detectorid())
+{
+  // same as other versions, the copy has the same channels but cleared towers
+  const size_t nchannels = source.size();
+  _energy.resize(nchannels, 0);
+  _time.resize(nchannels, 0);
+  _chi2.resize(nchannels, 0);
+  _pedestal.resize(nchannels, 0);
+  _status.resize(nchannels, 0);
+  make_towers();
+}
+
+void TowerInfoContainerv5::identify(std::ostream &os) const
+{
+  os << "TowerInfoContainerv5 of size " << size() << std::endl;
+}
+
+void TowerInfoContainerv5::Reset()
+{
+  // clear content of towers in the container for the next event
+  std::fill(_energy.begin(), _energy.end(), 0);
+  std::fill(_time.begin(), _time.end(), 0);
+  std::fill(_chi2.begin(), _chi2.end(), 0);
+  std::fill(_pedestal.begin(), _pedestal.end(), 0);
+  std::fill(_status.begin(), _status.end(), 0);
+}
+
+void TowerInfoContainerv5::make_towers()
+{
+  _towers.clear();
+  _towers.reserve(_energy.size());
+  for (unsigned int i = 0; i < _energy.size(); ++i)
+  {
+    _towers.emplace_back(this, i);
+  }
+}
+
+TowerInfov5 *TowerInfoContainerv5::get_tower_at_channel(int pos)
+{
+  if (pos < 0 || pos >= (int) _energy.size())
+  {
+    return nullptr;
+  }
+  // views are transient, they are missing after reading from file
+  if (_towers.size() != _energy.size())
+  {
+    make_towers();
+  }
+  return &_towers[pos];
+}
+
+TowerInfov5 *TowerInfoContainerv5::get_tower_at_key(int pos)
+{
+  int index = decode_key(pos);
+  return get_tower_at_channel(index);
+}
+
+unsigned int TowerInfoContainerv5::encode_key(unsigned int towerIndex)
+{
+  int key = 0;
+  if (_detector == DETECTOR::EMCAL)
+  {
+    key = TowerInfoContainer::encode_emcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    key = TowerInfoContainer::encode_hcal(towerIndex);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    key = TowerInfoContainer::encode_epd(towerIndex);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    key = TowerInfoContainer::encode_mbd(towerIndex);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    key = TowerInfoContainer::encode_zdc(towerIndex);
+  }
+  return key;
+}
+
+unsigned int TowerInfoContainerv5::decode_key(unsigned int tower_key)
+{
+  int index = 0;
+
+  if (_detector == DETECTOR::EMCAL)
+  {
+    index = TowerInfoContainer::decode_emcal(tower_key);
+  }
+  else if (_detector == DETECTOR::HCAL)
+  {
+    index = TowerInfoContainer::decode_hcal(tower_key);
+  }
+  else if (_detector == DETECTOR::SEPD)
+  {
+    index = TowerInfoContainer::decode_epd(tower_key);
+  }
+  else if (_detector == DETECTOR::MBD)
+  {
+    index = TowerInfoContainer::decode_mbd(tower_key);
+  }
+  else if (_detector == DETECTOR::ZDC)
+  {
+    index = TowerInfoContainer::decode_zdc(tower_key);
+  }
+  return index;
+}
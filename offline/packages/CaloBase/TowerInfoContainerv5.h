@@ -0,0 +1,64 @@
+#ifndef TOWERINFOCONTAINERV5_H
+#define TOWERINFOCONTAINERV5_H
+
+#include "TowerInfoContainer.h"
+#include "TowerInfov5.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+class PHObject;
+
+// same content as TowerInfoContainerv2 but stored as one array per quantity,
+// indexed by channel. Tower loops can run over the arrays directly,
+// get_tower_at_channel returns a TowerInfov5 view into them
+class TowerInfoContainerv5 : public TowerInfoContainer
+{
+ public:
+  TowerInfoContainerv5(DETECTOR detec);
+
+  // default constructor for ROOT IO
+  TowerInfoContainerv5() {}
+  PHObject *CloneMe() const override { return new TowerInfoContainerv5(*this); }
+  TowerInfoContainerv5(const TowerInfoContainerv5 &);
+  TowerInfoContainerv5 &operator=(const TowerInfoContainerv5 &) = delete;
+
+  ~TowerInfoContainerv5() override {}
+
+  void identify(std::ostream &os = std::cout) const override;
+
+  void Reset() override;
+  TowerInfov5 *get_tower_at_channel(int pos) override;
+  TowerInfov5 *get_tower_at_key(int pos) override;
+
+  unsigned int encode_key(unsigned int towerIndex) override;
+  unsigned int decode_key(unsigned int tower_key) override;
+
+  size_t size() const override { return _energy.size(); }
+  DETECTOR get_detectorid() const override { return _detector; }
+
+  float *get_energy_array() override { return _energy.data(); }
+  float *get_time_array() override { return _time.data(); }
+  float *get_chi2_array() override { return _chi2.data(); }
+  float *get_pedestal_array() override { return _pedestal.data(); }
+  uint8_t *get_status_array() override { return _status.data(); }
+
+ protected:
+  // (re)create the tower views, after construction and after reading from file
+  void make_towers();
+
+  DETECTOR _detector = DETECTOR_INVALID;
+  std::vector<float> _energy;
+  std::vector<float> _time;
+  std::vector<float> _chi2;
+  std::vector<float> _pedestal;
+  std::vector<uint8_t> _status;
+  std::vector<TowerInfov5> _towers;  //!
+
+ private:
+  ClassDefOverride(TowerInfoContainerv5, 1);
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "TowerInfov5.h"
+#include "TowerInfoContainerv5.h"
+
+void TowerInfov5::Reset()
+{
+  Clear();
+}
+
+void TowerInfov5::Clear(Option_t* /*unused*/)
+{
+  set_energy(0);
+  set_time_float(0);
+  set_chi2(0);
+  set_pedestal(0);
+  set_status(0);
+}
+
+void TowerInfov5::set_energy(float energy)
+{
+  _container->get_energy_array()[_channel] = energy;
+}
+
+float TowerInfov5::get_energy()
+{
+  return _container->get_energy_array()[_channel];
+}
+
+void TowerInfov5::set_time_float(float t)
+{
+  _container->get_time_array()[_channel] = t;
+}
+
+float TowerInfov5::get_time_float()
+{
+  return _container->get_time_array()[_channel];
+}
+
+void TowerInfov5::set_chi2(float chi2)
+{
+  _container->get_chi2_array()[_channel] = chi2;
+}
+
+float TowerInfov5::get_chi2()
+{
+  return _container->get_chi2_array()[_channel];
+}
+
+void TowerInfov5::set_pedestal(float pedestal)
+{
+  _container->get_pedestal_array()[_channel] = pedestal;
+}
+
+float TowerInfov5::get_pedestal()
+{
+  return _container->get_pedestal_array()[_channel];
+}
+
+uint8_t TowerInfov5::get_status() const
+{
+  return _container->get_status_array()[_channel];
+}
+
+void TowerInfov5::set_status(uint8_t status)
+{
+  _container->get_status_array()[_channel] = status;
+}
+
+void TowerInfov5::set_status_bit(int bit, bool value)
+{
+  if (bit < 0 || bit > 7)
+  {
+    return;
+  }
+  uint8_t& status = _container->get_status_array()[_channel];
+  status &= ~((uint8_t) 1 << bit);
+  status |= (uint8_t) value << bit;
+}
+
+bool TowerInfov5::get_status_bit(int bit) const
+{
+  if (bit < 0 || bit > 7)
+  {
+    return false;  // default behavior
+  }
+  return (get_status() & ((uint8_t) 1 << bit)) != 0;
+}
+
+void TowerInfov5::copy_tower(TowerInfo* tower)
+{
+  set_time_float(tower->get_time_float());
+  set_energy(tower->get_energy());
+  set_chi2(tower->get_chi2());
+  set_pedestal(tower->get_pedestal());
+  set_status(tower->get_status());
+  return;
+}
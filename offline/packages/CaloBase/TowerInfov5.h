@@ -0,0 +1,80 @@
+#ifndef TOWERINFOV5_H
+#define TOWERINFOV5_H
+
+#include "TowerInfo.h"
+
+#include <cstdint>
+
+class TowerInfoContainerv5;
+
+// tower view into the per channel arrays of TowerInfoContainerv5
+// it does not hold any data and is never written out on its own
+class TowerInfov5 : public TowerInfo
+{
+ public:
+  TowerInfov5() {}
+  TowerInfov5(TowerInfoContainerv5* container, unsigned int channel)
+    : _container(container)
+    , _channel(channel)
+  {
+  }
+
+  ~TowerInfov5() override {}
+
+  void Reset() override;
+  void Clear(Option_t* = "") override;
+
+  void set_energy(float energy) override;
+  float get_energy() override;
+
+  void set_time(short t) override { set_time_float(t); }
+  short get_time() override { return get_time_float(); }
+
+  void set_time_float(float t) override;
+  float get_time_float() override;
+
+  void set_chi2(float chi2) override;
+  float get_chi2() override;
+
+  void set_pedestal(float pedestal) override;
+  float get_pedestal() override;
+
+  void set_isHot(bool isHot) override { set_status_bit(0, isHot); }
+  bool get_isHot() const override { return get_status_bit(0); }
+
+  void set_isBadTime(bool isBadTime) override { set_status_bit(1, isBadTime); }
+  bool get_isBadTime() const override { return get_status_bit(1); }
+
+  void set_isBadChi2(bool isBadChi2) override { set_status_bit(2, isBadChi2); }
+  bool get_isBadChi2() const override { return get_status_bit(2); }
+
+  void set_isNotInstr(bool isNotInstr) override { set_status_bit(3, isNotInstr); }
+  bool get_isNotInstr() const override { return get_status_bit(3); }
+
+  void set_isNoCalib(bool isNoCalib) override { set_status_bit(4, isNoCalib); }
+  bool get_isNoCalib() const override { return get_status_bit(4); }
+
+  void set_isZS(bool isZS) override { set_status_bit(5, isZS); }
+  bool get_isZS() const override { return get_status_bit(5); }
+
+  void set_isRecovered(bool isRecovered) override { set_status_bit(6, isRecovered); }
+  bool get_isRecovered() const override { return get_status_bit(6); }
+
+  bool get_isGood() const override { return !(get_isHot() || get_isBadChi2() || get_isNoCalib()); }
+
+  uint8_t get_status() const override;
+  void set_status(uint8_t status) override;
+
+  void copy_tower(TowerInfo* tower) override;
+
+ private:
+  TowerInfoContainerv5* _container = nullptr;  //!
+  unsigned int _channel = 0;                   //!
+
+  void set_status_bit(int bit, bool value);
+  bool get_status_bit(int bit) const;
+
+  ClassDefOverride(TowerInfov5, 1);
+};
+
+#endif
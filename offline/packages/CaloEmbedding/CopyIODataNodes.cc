@@ -16,8 +16,47 @@
 #include <fun4all/Fun4AllServer.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHIODataNode.h>
+#include <phool/PHNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/PHObject.h>
 #include <phool/getClass.h>
 
+#include <TObject.h>
+
+#include <iostream>
+
+namespace
+{
+  // nodes read from file are PHIODataNode<TObject> (created by PHNodeIOManager),
+  // nodes created by modules PHIODataNode<PHObject>
+  TObject *node_data(PHNode *node)
+  {
+    if (PHIODataNode<PHObject> *phobjectnode = dynamic_cast<PHIODataNode<PHObject> *>(node))
+    {
+      return phobjectnode->getData();
+    }
+    if (PHIODataNode<TObject> *tobjectnode = dynamic_cast<PHIODataNode<TObject> *>(node))
+    {
+      return tobjectnode->getData();
+    }
+    return nullptr;
+  }
+
+  // object must be a PHObject
+  void set_node_data(PHNode *node, TObject *object)
+  {
+    if (PHIODataNode<PHObject> *phobjectnode = dynamic_cast<PHIODataNode<PHObject> *>(node))
+    {
+      phobjectnode->setData(dynamic_cast<PHObject *>(object));
+    }
+    else if (PHIODataNode<TObject> *tobjectnode = dynamic_cast<PHIODataNode<TObject> *>(node))
+    {
+      tobjectnode->setData(object);
+    }
+  }
+}  // namespace
+
 //____________________________________________________________________________..
 CopyIODataNodes::CopyIODataNodes(const std::string &name)
   : SubsysReco(name)
@@ -56,6 +95,16 @@ int CopyIODataNodes::InitRun(PHCompositeNode *topNode)
   {
     CreateSyncObject(topNode, se->topNode());
   }
+  // nodes missing on the input are not moved
+  std::vector<std::string> movenodes;
+  for (const auto &nodename : m_MoveNodes)
+  {
+    if (CreateMovedNode(topNode, se->topNode(), nodename))
+    {
+      movenodes.push_back(nodename);
+    }
+  }
+  m_MoveNodes.swap(movenodes);
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -88,6 +137,10 @@ int CopyIODataNodes::process_event(PHCompositeNode *topNode)
   {
     CopySyncObject(topNode, se->topNode());
   }
+  for (const auto &nodename : m_MoveNodes)
+  {
+    MoveNodeObject(topNode, se->topNode(), nodename);
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -385,3 +438,97 @@ void CopyIODataNodes::CopySyncObject(PHCompositeNode *from_topNode, PHCompositeN
   }
   return;
 }
+
+bool CopyIODataNodes::CreateMovedNode(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode, const std::string &nodename)
+{
+  PHNodeIterator from_iter(from_topNode);
+  PHNode *from_node = from_iter.findFirst("PHIODataNode", nodename);
+  if (!from_node)
+  {
+    std::cout << "Could not locate " << nodename << " on " << from_topNode->getName() << std::endl;
+    return false;
+  }
+  PHNodeIterator to_iter(to_topNode);
+  if (to_iter.findFirst("PHIODataNode", nodename))
+  {
+    return true;
+  }
+
+  // same composite nodes as in the input node tree, e.g. DST/TRKR
+  std::vector<std::string> path;
+  for (PHNode *parent = from_node->getParent(); parent && parent != from_topNode; parent = parent->getParent())
+  {
+    path.push_back(parent->getName());
+  }
+  PHCompositeNode *parentNode = to_topNode;
+  for (auto name = path.rbegin(); name != path.rend(); ++name)
+  {
+    PHNodeIterator iter(parentNode);
+    PHCompositeNode *node = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", *name));
+    if (!node)
+    {
+      node = new PHCompositeNode(*name);
+      parentNode->addNode(node);
+    }
+    parentNode = node;
+  }
+
+  PHObject *from_object = dynamic_cast<PHObject *>(node_data(from_node));
+  if (!from_object)
+  {
+    std::cout << nodename << " on " << from_topNode->getName() << " does not hold a PHObject, it will not be moved" << std::endl;
+    return false;
+  }
+  PHObject *to_object = from_object->CloneMe();
+  to_object->Reset();
+  PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(to_object, nodename, "PHObject");
+  parentNode->addNode(newNode);
+  return true;
+}
+
+void CopyIODataNodes::MoveNodeObject(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode, const std::string &nodename)
+{
+  // nodes are searched every event, the input manager replaces its nodes
+  // when a new file holds a different class
+  PHNodeIterator from_iter(from_topNode);
+  PHNode *from_node = from_iter.findFirst("PHIODataNode", nodename);
+  PHNodeIterator to_iter(to_topNode);
+  PHNode *to_node = to_iter.findFirst("PHIODataNode", nodename);
+  if (!from_node || !to_node)
+  {
+    return;
+  }
+
+  // getData reads lazily read input nodes
+  TObject *from_object = node_data(from_node);
+  TObject *to_object = node_data(to_node);
+  if (!from_object || !to_object)
+  {
+    return;
+  }
+  if (std::string(from_object->ClassName()) != to_object->ClassName())
+  {
+    // the input would be read into an object of the wrong class, copy
+    // this event, the classes match from the next one on
+    if (Verbosity() > 0)
+    {
+      std::cout << "CopyIODataNodes: " << nodename << " changed from " << to_object->ClassName()
+                << " to " << from_object->ClassName() << std::endl;
+    }
+    delete to_object;
+    set_node_data(to_node, dynamic_cast<PHObject *>(from_object)->CloneMe());
+    return;
+  }
+
+  // the input branch address points to the node data, the next event
+  // is read into the object given back to the input node
+  set_node_data(to_node, from_object);
+  set_node_data(from_node, to_object);
+  dynamic_cast<PHObject *>(to_object)->Reset();
+  if (Verbosity() > 0)
+  {
+    std::cout << "To " << nodename << " identify()" << std::endl;
+    dynamic_cast<PHObject *>(from_object)->identify();
+  }
+  return;
+}
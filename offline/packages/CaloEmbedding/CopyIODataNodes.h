@@ -6,6 +6,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -36,6 +37,14 @@ class CopyIODataNodes : public SubsysReco
   void CopyRunHeader(bool flag = true) { m_CopyRunHeaderFlag = flag; }
   void CopySyncObject(bool flag = true) { m_CopySyncObjectFlag = flag; }
 
+  /** Move the object of an input node to the output node tree every event,
+      instead of copying it. The objects of the two nodes are swapped, the
+      input node keeps the (reset) object of the previous event, which the
+      input manager reads the next event into. Intended for large containers
+      (towers, hits, clusters); the input node is empty after this module.
+   */
+  void MoveNode(const std::string &nodename) { m_MoveNodes.push_back(nodename); }
+
  private:
   void CreateCentralityInfo(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode);
   void CopyCentralityInfo(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode);
@@ -57,6 +66,9 @@ class CopyIODataNodes : public SubsysReco
   void CreateSyncObject(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode);
   void CopySyncObject(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode);
 
+  bool CreateMovedNode(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode, const std::string &nodename);
+  void MoveNodeObject(PHCompositeNode *from_topNode, PHCompositeNode *to_topNode, const std::string &nodename);
+
   bool m_CopyCentralityInfoFlag = true;
   bool m_CopyEventHeaderFlag = true;
   bool m_CopyGlobalVertexMapFlag = true;
@@ -64,6 +76,8 @@ class CopyIODataNodes : public SubsysReco
   bool m_CopyMbdOutFlag = true;
   bool m_CopyRunHeaderFlag = true;
   bool m_CopySyncObjectFlag = true;
+
+  std::vector<std::string> m_MoveNodes;
 };
 
 #endif  // COPYIODATANODES_H
@@ -66,6 +66,8 @@ int caloTowerEmbed::InitRun(PHCompositeNode *topNode)
     m_detector = "SEPD";
   }
 
+  m_geometryChecked = false;
+
   try
   {
     CreateNodeTree(topNode);
@@ -88,6 +90,64 @@ int caloTowerEmbed::process_event(PHCompositeNode * /*topNode*/)
   {
     std::cout << "event " << m_eventNumber << " working on " << m_detector << std::endl;
   }
+
+  // the tower positions do not change within a run, compare them once
+  if (!m_geometryChecked)
+  {
+    m_geometryMatches = check_geometry();
+    m_geometryChecked = true;
+  }
+  if (!m_geometryMatches)
+  {
+    if (Verbosity())
+    {
+      std::cout << "eta and phi values in " << m_detector << " do not match between data and simulation, removing this event" << std::endl;
+    }
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  unsigned int ntowers = _data_towers->size();
+
+  // both containers stored as arrays: add directly without going through the towers
+  float *data_energy = _data_towers->get_energy_array();
+  float *data_time = _data_towers->get_time_array();
+  uint8_t *data_status = _data_towers->get_status_array();
+  float *sim_energy = _sim_towers->get_energy_array();
+  float *sim_time = _sim_towers->get_time_array();
+  uint8_t *sim_status = _sim_towers->get_status_array();
+  if (data_energy && data_time && data_status && sim_energy && sim_time && sim_status)
+  {
+    for (unsigned int channel = 0; channel < ntowers; channel++)
+    {
+      sim_status[channel] = data_status[channel];
+      sim_energy[channel] += data_energy[channel];
+      // the time goes through get_time/set_time (short) as for the other containers
+      sim_time[channel] = static_cast<short>(data_time[channel]);
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    TowerInfo *caloinfo_data = _data_towers->get_tower_at_channel(channel);
+    TowerInfo *caloinfo_sim = _sim_towers->get_tower_at_channel(channel);
+
+    caloinfo_sim->set_status(caloinfo_data->get_status());
+
+    float data_E = caloinfo_data->get_energy();
+    float sim_E = caloinfo_sim->get_energy();
+    float embed_E = data_E + sim_E;
+
+    caloinfo_sim->set_energy(embed_E);
+    caloinfo_sim->set_time(caloinfo_data->get_time());
+  }  // end loop over channels
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+bool caloTowerEmbed::check_geometry()
+{
   RawTowerDefs::keytype keyData = 0;
   RawTowerDefs::keytype keySim = 0;
 
@@ -126,44 +186,18 @@ int caloTowerEmbed::process_event(PHCompositeNode * /*topNode*/)
       keySim = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ieta_sim, iphi_sim);
     }
 
-    _sim_towers->get_tower_at_channel(channel)->set_status(_data_towers->get_tower_at_channel(channel)->get_status());
-
-    TowerInfo *caloinfo_data = _data_towers->get_tower_at_channel(channel);
-    TowerInfo *caloinfo_sim = _sim_towers->get_tower_at_channel(channel);
-
-    float data_E = caloinfo_data->get_energy();
-    float sim_E = caloinfo_sim->get_energy();
-    float embed_E = data_E + sim_E;
-
-    float data_phi = 0.0;
-    float sim_phi = 0.0;
-
-    float data_eta = 0.0;
-    float sim_eta = 0.0;
-
-    data_phi = tower_geom->get_tower_geometry(keyData)->get_phi();
-    data_eta = tower_geom->get_tower_geometry(keyData)->get_eta();
+    float data_phi = tower_geom->get_tower_geometry(keyData)->get_phi();
+    float data_eta = tower_geom->get_tower_geometry(keyData)->get_eta();
 
-    sim_phi = tower_geom->get_tower_geometry(keySim)->get_phi();
-    sim_eta = tower_geom->get_tower_geometry(keySim)->get_eta();
+    float sim_phi = tower_geom->get_tower_geometry(keySim)->get_phi();
+    float sim_eta = tower_geom->get_tower_geometry(keySim)->get_eta();
 
-    if (data_phi == sim_phi && data_eta == sim_eta)
+    if (data_phi != sim_phi || data_eta != sim_eta)
     {
-      _sim_towers->get_tower_at_channel(channel)->set_energy(embed_E);
-      _sim_towers->get_tower_at_channel(channel)->set_time(caloinfo_data->get_time());
+      return false;
     }
-    else
-    {
-      if (Verbosity())
-      {
-        std::cout << "eta and phi values in " << m_detector << " do not match between data and simulation, removing this event" << std::endl;
-      }
-      return Fun4AllReturnCodes::ABORTEVENT;
-    }
-
-  }  // end loop over channels
-
-  return Fun4AllReturnCodes::EVENT_OK;
+  }
+  return true;
 }
 
 int caloTowerEmbed::End(PHCompositeNode * /*topNode*/)
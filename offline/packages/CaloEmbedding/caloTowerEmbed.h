@@ -57,6 +57,9 @@ class caloTowerEmbed : public SubsysReco
   }
 
  private:
+  //! true if data and simulation towers of each channel are at the same eta and phi
+  bool check_geometry();
+
   TowerInfoContainer *_data_towers{nullptr};
   TowerInfoContainer *_sim_towers{nullptr};
 
@@ -64,6 +67,8 @@ class caloTowerEmbed : public SubsysReco
 
   bool m_useRetower{false};
   bool m_removeBadTowers{false};
+  bool m_geometryChecked{false};
+  bool m_geometryMatches{false};
 
   CaloTowerDefs::DetectorSystem m_dettype{CaloTowerDefs::DETECTOR_INVALID};
 
@@ -5,8 +5,25 @@
 #include "BEmcCluster.h"
 #include "BEmcRec.h"
 
+#include <algorithm>
 #include <iostream>
 
+namespace
+{
+  // GetSubClusters() scratch buffers, reused from cluster to cluster
+  // (per thread, the clusters may be split in parallel)
+  class SubClusterScratch
+  {
+   public:
+    std::vector<EmcModule> hlist;
+    std::vector<EmcModule> phit;
+    std::vector<float> energy;  // npk x nhit
+    std::vector<float> totEnergy;
+    std::vector<float> tmpEnergy;
+  };
+  thread_local SubClusterScratch scratch;
+}  // namespace
+
 // Define and initialize static members
 
 // Max number of peaks in cluster; used in EmcCluster::GetSubClusters(...)
@@ -37,6 +54,20 @@ EmcModule::EmcModule(int ich_, float amp_, float tof_)
 // ///////////////////////////////////////////////////////////////////////////
 // EmcCluster member functions
 
+void EmcCluster::Fill(std::vector<EmcCluster>& list, size_t icl, const EmcModule* first, const EmcModule* last, BEmcRec* sector)
+{
+  if (icl < list.size())
+  {
+    list[icl].fOwner = sector;
+    list[icl].ReInitialize(first, last);
+  }
+  else
+  {
+    list.emplace_back(sector);
+    list.back().ReInitialize(first, last);
+  }
+}
+
 void EmcCluster::GetCorrPos(float& xc, float& yc)
 // Returns the cluster corrected position in tower units
 // Corrected for S-oscilations, not for shower depth
@@ -170,6 +201,8 @@ float EmcCluster::GetECore()
   {
     return 0;
   }
+  BEmcRec::PeakProfile profile;
+  fOwner->SetPeakProfile(energy, xcg, ycg, profile);
   ph = fHitList.begin();
   while (ph != fHitList.end())
   {
@@ -180,7 +213,7 @@ float EmcCluster::GetECore()
     //    float dx = fOwner->fTowerDist(float(ix), xcg);
     //    float dy = ycg - iy;
     //    float et = fOwner->PredictEnergy(dx, dy, energy);
-    float et = fOwner->PredictEnergy(energy, xcg, ycg, ix, iy);
+    float et = fOwner->PredictEnergy(profile, ix, iy);
     if (et > thresh)
     {
       es += (*ph).amp;
@@ -354,33 +387,26 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
   int PeakCh[fgMaxNofPeaks];
   float epk[fgMaxNofPeaks * 2], xpk[fgMaxNofPeaks * 2], ypk[fgMaxNofPeaks * 2];
   float ratio, eg, dx, dy, a;
-  float *Energy[fgMaxNofPeaks], *totEnergy, *tmpEnergy;
-  EmcModule *phit, *hlist, *vv;
-  EmcCluster peak(fOwner);
-  std::vector<EmcModule>::iterator ph;
-  std::vector<EmcModule> hl;
+  float *Energy, *totEnergy, *tmpEnergy;
+  EmcModule *phit, *hlist;
+  BEmcRec::PeakProfile profile;
 
-  PkList.clear();
+  // the subclusters of PkList are refilled, their hit lists keep their memory
   ppeaks.clear();
 
   nhit = fHitList.size();
 
   if (nhit <= 0)
   {
+    PkList.clear();
     return 0;
   }
 
-  hlist = new EmcModule[nhit];
-
-  ph = fHitList.begin();
-  vv = hlist;
-  while (ph != fHitList.end())
-  {
-    *vv++ = *ph++;
-  }
+  scratch.hlist.assign(fHitList.begin(), fHitList.end());
+  hlist = scratch.hlist.data();
 
-  // sort by linear channel number
-  qsort(hlist, nhit, sizeof(EmcModule), fOwner->HitNCompare);
+  // sort by linear channel number (unique, so this is the order of qsort with HitNCompare)
+  std::sort(hlist, hlist + nhit, BEmcRec::HitNLess);
 
   //
   //  Find peak (maximum) position (towers with local maximum amp)
@@ -424,7 +450,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       }
       if (npk >= fgMaxNofPeaks)
       {
-        delete[] hlist;
+        PkList.clear();
         std::cout << "!!! Error in EmcCluster::GetSubClusters(): too many peaks in a cluster (>"
                   << fgMaxNofPeaks
                   << "). May need tower energy threshold increase for clustering." << std::endl;
@@ -448,13 +474,8 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
   // there was only one peak
   if (npk <= 1)
   {
-    hl.clear();
-    for (int ich = 0; ich < nhit; ich++)
-    {
-      hl.push_back(hlist[ich]);
-    }
-    peak.ReInitialize(hl);
-    PkList.push_back(peak);
+    Fill(PkList, 0, hlist, hlist + nhit, fOwner);
+    PkList.erase(PkList.begin() + 1, PkList.end());
 
     if (npk == 1)
     {
@@ -465,23 +486,18 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       ppeaks.push_back(GetMaxTower());
     }
 
-    delete[] hlist;
     return 1;
   }
 
   // there were more than one peak
 
-  for (ipk = 0; ipk < npk; ipk++)
-  {
-    Energy[ipk] = new float[nhit];
-  }
-  totEnergy = new float[nhit];
-  tmpEnergy = new float[nhit];
-  for (int i = 0; i < nhit; ++i)
-  {
-    totEnergy[i] = 0.0;
-    tmpEnergy[i] = 0.0;
-  }
+  // Energy[ipk * nhit + in] is the energy of peak ipk in tower in
+  scratch.energy.resize(npk * nhit);
+  scratch.totEnergy.assign(nhit, 0.0);
+  scratch.tmpEnergy.assign(nhit, 0.0);
+  Energy = scratch.energy.data();
+  totEnergy = scratch.totEnergy.data();
+  tmpEnergy = scratch.tmpEnergy.data();
   //
   // Divide energy in towers among photons positioned in every peak
   //
@@ -494,7 +510,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       ic = PeakCh[ipk];
       if (iter > 0)
       {
-        ratio = Energy[ipk][ic] / totEnergy[ic];
+        ratio = Energy[ipk * nhit + ic] / totEnergy[ic];
       }
       eg = hlist[ic].amp * ratio;
       ixypk = hlist[ic].ich;
@@ -528,7 +544,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
           {
             if (iter > 0)
             {
-              ratio = Energy[ipk][in] / totEnergy[in];
+              ratio = Energy[ipk * nhit + in] / totEnergy[in];
             }
             eg = hlist[in].amp * ratio;
             epk[ipk] += eg;
@@ -559,7 +575,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
           {
             if (iter > 0)
             {
-              ratio = Energy[ipk][in] / totEnergy[in];
+              ratio = Energy[ipk * nhit + in] / totEnergy[in];
             }
             eg = hlist[in].amp * ratio;
             epk[ipk] += eg;
@@ -572,6 +588,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       xpk[ipk] = xpk[ipk] / epk[ipk] + ixpk;
       ypk[ipk] = ypk[ipk] / epk[ipk] + iypk;
       //      fOwner->SetProfileParameters(0, epk[ipk], xpk[ipk], ypk[ipk]);
+      fOwner->SetPeakProfile(epk[ipk], xpk[ipk], ypk[ipk], profile);
 
       for (in = 0; in < nhit; in++)
       {
@@ -586,10 +603,10 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
         if (ABS(dx) < 2.5 && ABS(dy) < 2.5)
         {
           //          a = epk[ipk] * fOwner->PredictEnergy(dx, dy, epk[ipk]);
-          a = epk[ipk] * fOwner->PredictEnergy(epk[ipk], xpk[ipk], ypk[ipk], ix, iy);
+          a = epk[ipk] * fOwner->PredictEnergy(profile, ix, iy);
         }
 
-        Energy[ipk][in] = a;
+        Energy[ipk * nhit + in] = a;
         tmpEnergy[in] += a;
       }
 
@@ -608,7 +625,8 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
     }
   }  // for iter
 
-  phit = new EmcModule[nhit];
+  scratch.phit.resize(nhit);
+  phit = scratch.phit.data();
 
   ng = 0;
   for (ipk = 0; ipk < npk; ipk++)
@@ -621,7 +639,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       if (tmpEnergy[in] > 0)
       {
         ixy = hlist[in].ich;
-        a = hlist[in].amp * Energy[ipk][in] / tmpEnergy[in];
+        a = hlist[in].amp * Energy[ipk * nhit + in] / tmpEnergy[in];
         if (a > fgEmin)
         {
           phit[nh].ich = ixy;
@@ -671,20 +689,23 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       //      fOwner->SetProfileParameters(0, epk[ig], xpk[ig], ypk[ig]);
       for (in = 0; in < nhit; in++)
       {
-        Energy[ipk][in] = 0;
-        for (ig = igmpk1[ipk]; ig <= igmpk2[ipk]; ig++)
+        Energy[ipk * nhit + in] = 0;
+      }
+      // the photons of a peak are added to every tower in the same order as before
+      for (ig = igmpk1[ipk]; ig <= igmpk2[ipk]; ig++)
+      {
+        fOwner->SetPeakProfile(epk[ig], xpk[ig], ypk[ig], profile);
+        for (in = 0; in < nhit; in++)
         {
           ixy = hlist[in].ich;
           iy = ixy / fOwner->GetNx();
           ix = ixy - iy * fOwner->GetNx();
-          dx = fOwner->fTowerDist(float(ix), xpk[ig]);
-          dy = ypk[ig] - iy;
           //          a = epk[ig] * fOwner->PredictEnergy(dx, dy, epk[ig]);
-          a = epk[ig] * fOwner->PredictEnergy(epk[ig], xpk[ig], ypk[ig], ix, iy);
-          Energy[ipk][in] += a;
+          a = epk[ig] * fOwner->PredictEnergy(profile, ix, iy);
+          Energy[ipk * nhit + in] += a;
           tmpEnergy[in] += a;
         }
-      }  // for( in
+      }  // for( ig
     }    // if( ig >= 0
   }      // for( ipk
 
@@ -697,7 +718,7 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
       if (tmpEnergy[in] > 0)
       {
         ixy = hlist[in].ich;
-        a = hlist[in].amp * Energy[ipk][in] / tmpEnergy[in];
+        a = hlist[in].amp * Energy[ipk * nhit + in] / tmpEnergy[in];
         if (a > fgEmin)
         {
           phit[nh].ich = ixy;
@@ -712,25 +733,11 @@ int EmcCluster::GetSubClusters(std::vector<EmcCluster>& PkList, std::vector<EmcM
     {
       //      *ip++ = hlist[PeakCh[ipk]];
       ppeaks.push_back(hlist[PeakCh[ipk]]);
-      hl.clear();
-      for (in = 0; in < nh; in++)
-      {
-        hl.push_back(phit[in]);
-      }
-      peak.ReInitialize(hl);
-      PkList.push_back(peak);
+      Fill(PkList, nn, phit, phit + nh, fOwner);
       nn++;
     }
   }  // for( ipk
-
-  delete[] phit;
-  delete[] hlist;
-  for (ipk = 0; ipk < npk; ipk++)
-  {
-    delete[] Energy[ipk];
-  }
-  delete[] totEnergy;
-  delete[] tmpEnergy;
+  PkList.erase(PkList.begin() + nn, PkList.end());
 
   return nn;
 }
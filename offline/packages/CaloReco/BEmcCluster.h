@@ -74,10 +74,17 @@ class EmcCluster : public TObject
   {
     fHitList = hlist;
   }
+  /// Reinitializes EmcCluster with the towers [first, last), keeps the memory of the Hit List
+  void ReInitialize(const EmcModule* first, const EmcModule* last)
+  {
+    fHitList.assign(first, last);
+  }
+  /// Sets list[icl] to the towers [first, last), an existing entry (from a previous call) is reused
+  static void Fill(std::vector<EmcCluster>& list, size_t icl, const EmcModule* first, const EmcModule* last, BEmcRec* sector);
   /// Returns number of EmcModules in EmcCluster
   int GetNofHits() { return fHitList.size(); }
   /// Returns EmcCluster fHitList
-  std::vector<EmcModule> GetHitList() { return fHitList; };
+  const std::vector<EmcModule>& GetHitList() const { return fHitList; };
   /// Returns the EmcModule with the maximum energy
   EmcModule GetMaxTower();
   /// Returns the EmcModule corresponding to the reconstructed impact tower
@@ -1,6 +1,7 @@
 #include "BEmcProfile.h"
 #include "BEmcCluster.h"
 
+#include <TAxis.h>
 #include <TFile.h>
 #include <TH1.h>  // for TH1F
 #include <TMath.h>
@@ -143,9 +144,32 @@ BEmcProfile::BEmcProfile(const std::string& fname)
   }
 
   f->Close();
+
+  m_MeanBins.resize(nen * nth * NP);
+  m_SigmaBins.resize(nen * nth * NP);
+  for (int i = 0; i < nen * nth * NP; i++)
+  {
+    FillBins(hmean[i], m_MeanBins[i]);
+    FillBins(hsigma[i], m_SigmaBins[i]);
+  }
+  m_R4Bins.resize(nen * nth);
+  for (int i = 0; i < nen * nth; i++)
+  {
+    FillBins(hr4[i], m_R4Bins[i]);
+  }
   bloaded = true;
 }
 
+void BEmcProfile::FillBins(TH1F* hist, ProfileBins& bins)
+{
+  bins.axis = hist->GetXaxis();
+  bins.content.resize(hist->GetNbinsX() + 2);
+  for (unsigned int i = 0; i < bins.content.size(); i++)
+  {
+    bins.content[i] = hist->GetBinContent(i);
+  }
+}
+
 BEmcProfile::~BEmcProfile()
 {
   if (bloaded)
@@ -511,36 +535,37 @@ void BEmcProfile::PredictEnergy(int ip, float energy, float theta, float /*phi*/
   int ii12 = ip + ie1 * NP + it2 * nen * NP;
   int ii22 = ip + ie2 * NP + it2 * nen * NP;
 
-  int ibin = hmean[ii11]->FindBin(xx);
+  // the profiles are never extended, FindFixBin is what FindBin returns
+  int ibin = m_MeanBins[ii11].axis->FindFixBin(xx);
 
   // Log (1/sqrt) energy dependence of mean (sigma)
   //
-  float pr11 = hmean[ii11]->GetBinContent(ibin);
-  float pr21 = hmean[ii21]->GetBinContent(ibin);
+  float pr11 = m_MeanBins[ii11].GetBinContent(ibin);
+  float pr21 = m_MeanBins[ii21].GetBinContent(ibin);
   float prt1 = pr11 + (pr21 - pr11) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt1 < 0)
   {
     prt1 = 0;
   }
 
-  float er11 = hsigma[ii11]->GetBinContent(ibin);
-  float er21 = hsigma[ii21]->GetBinContent(ibin);
+  float er11 = m_SigmaBins[ii11].GetBinContent(ibin);
+  float er21 = m_SigmaBins[ii21].GetBinContent(ibin);
   float ert1 = er11 + (er21 - er11) / (1. / sqrt(en2) - 1. / sqrt(en1)) * (1. / sqrt(energy) - 1. / sqrt(en1));
   if (ert1 < 0)
   {
     ert1 = 0;
   }
 
-  float pr12 = hmean[ii12]->GetBinContent(ibin);
-  float pr22 = hmean[ii22]->GetBinContent(ibin);
+  float pr12 = m_MeanBins[ii12].GetBinContent(ibin);
+  float pr22 = m_MeanBins[ii22].GetBinContent(ibin);
   float prt2 = pr12 + (pr22 - pr12) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt2 < 0)
   {
     prt2 = 0;
   }
 
-  float er12 = hsigma[ii12]->GetBinContent(ibin);
-  float er22 = hsigma[ii22]->GetBinContent(ibin);
+  float er12 = m_SigmaBins[ii12].GetBinContent(ibin);
+  float er22 = m_SigmaBins[ii22].GetBinContent(ibin);
   float ert2 = er12 + (er22 - er12) / (1. / sqrt(en2) - 1. / sqrt(en1)) * (1. / sqrt(energy) - 1. / sqrt(en1));
   if (ert2 < 0)
   {
@@ -568,15 +593,15 @@ void BEmcProfile::PredictEnergy(int ip, float energy, float theta, float /*phi*/
     ibin1 = ibin - 1;
   }
   int ibin2 = ibin;
-  if (ibin < hmean[ii11]->GetNbinsX())
+  if (ibin < m_MeanBins[ii11].axis->GetNbins())
   {
-    if (hmean[ii11]->GetBinContent(ibin + 1) > 0)
+    if (m_MeanBins[ii11].GetBinContent(ibin + 1) > 0)
     {
       ibin2 = ibin + 1;
     }
   }
-  float dd = (hmean[ii11]->GetBinContent(ibin2) -
-              hmean[ii11]->GetBinContent(ibin1)) /
+  float dd = (m_MeanBins[ii11].GetBinContent(ibin2) -
+              m_MeanBins[ii11].GetBinContent(ibin1)) /
              2.;
   //  if( fabs(dd)>er )
   // {
@@ -663,20 +688,20 @@ float BEmcProfile::PredictEnergyR(float energy, float theta, float /*phi*/, floa
   int ii12 = ie1 + it2 * nen;
   int ii22 = ie2 + it2 * nen;
 
-  int ibin = hr4[ii11]->FindBin(rr);
+  int ibin = m_R4Bins[ii11].axis->FindFixBin(rr);
 
   // Log (1/sqrt) energy dependence of mean (sigma)
   //
-  float pr11 = hr4[ii11]->GetBinContent(ibin);
-  float pr21 = hr4[ii21]->GetBinContent(ibin);
+  float pr11 = m_R4Bins[ii11].GetBinContent(ibin);
+  float pr21 = m_R4Bins[ii21].GetBinContent(ibin);
   float prt1 = pr11 + (pr21 - pr11) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt1 < 0)
   {
     prt1 = 0;
   }
 
-  float pr12 = hr4[ii12]->GetBinContent(ibin);
-  float pr22 = hr4[ii22]->GetBinContent(ibin);
+  float pr12 = m_R4Bins[ii12].GetBinContent(ibin);
+  float pr22 = m_R4Bins[ii22].GetBinContent(ibin);
   float prt2 = pr12 + (pr22 - pr12) / (log(en2) - log(en1)) * (log(energy) - log(en1));
   if (prt2 < 0)
   {
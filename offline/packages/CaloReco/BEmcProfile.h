@@ -2,6 +2,7 @@
 #include <vector>  // for vector
 
 class EmcModule;
+class TAxis;
 class TH1F;
 
 class BEmcProfile
@@ -39,5 +40,33 @@ class BEmcProfile
   TH1F** hr4;
 
  private:
+  //! bin contents of a profile histogram, so the predictions only read arrays
+  //! (and can run on several threads)
+  class ProfileBins
+  {
+   public:
+    const TAxis* axis{nullptr};
+    std::vector<float> content;  // with under- and overflow
+    //! same as TH1::GetBinContent, out of range bins are clamped
+    double GetBinContent(int bin) const
+    {
+      if (bin < 0)
+      {
+        bin = 0;
+      }
+      if (bin >= (int) content.size())
+      {
+        bin = content.size() - 1;
+      }
+      return content[bin];
+    }
+  };
+
+  static void FillBins(TH1F* hist, ProfileBins& bins);
+
+  std::vector<ProfileBins> m_MeanBins;
+  std::vector<ProfileBins> m_SigmaBins;
+  std::vector<ProfileBins> m_R4Bins;
+
   int m_Verbosity;
 };
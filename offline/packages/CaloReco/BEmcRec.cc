@@ -12,6 +12,7 @@
 
 #include <TMath.h>
 
+#include <algorithm>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
@@ -321,46 +322,33 @@ int BEmcRec::FindClusters()
 // Returns number of clusters found
 {
   int nhit, nCl;
-  //  int LenCl[fgMaxLen];
-  int* LenCl;
   int next, ib, ie, iab, iae, last, LastCl, leng, ich;
   int ia = 0;
 
-  EmcModule* vv;
-  EmcModule *vhit, *vt;
-  EmcCluster Clt(this);
-  std::vector<EmcModule>::iterator ph;
-  std::vector<EmcModule> hl;
-
-  (*fClusters).clear();
   nhit = (*fModules).size();
 
   if (nhit <= 0)
   {
+    (*fClusters).clear();
     return 0;
   }
   if (nhit == 1)
   {
-    Clt.ReInitialize((*fModules));
-    fClusters->push_back(Clt);
+    EmcCluster::Fill(*fClusters, 0, fModules->data(), fModules->data() + 1, this);
+    fClusters->erase(fClusters->begin() + 1, fClusters->end());
     return 1;
   }
 
-  int MaxLen = fgMaxLen;
-  LenCl = new int[MaxLen];
-  ZeroVector(LenCl, MaxLen);
-
-  vt = new EmcModule[nhit];
-  vhit = new EmcModule[nhit];
-
-  ph = (*fModules).begin();
-  vv = vhit;
-  while (ph != (*fModules).end())
-  {
-    *vv++ = *ph++;
-  }
+  // there are at most nhit subclusters
+  fClusterLengths.assign(nhit, 0);
+  fHitScratch.assign(fModules->begin(), fModules->end());
+  fSwapScratch.resize(nhit);
+  int* LenCl = fClusterLengths.data();
+  EmcModule* vhit = fHitScratch.data();
+  EmcModule* vt = fSwapScratch.data();
 
-  qsort(vhit, nhit, sizeof(EmcModule), HitNCompare);
+  // the channels are unique, so this is the order of qsort with HitNCompare
+  std::sort(vhit, vhit + nhit, HitNLess);
 
   nCl = 0;
   next = 0;
@@ -381,22 +369,6 @@ int BEmcRec::FindClusters()
       ib = next;
       ie = ich - 1;
       next = ich;
-      if (nCl >= MaxLen)
-      {
-        //        delete[] vhit;
-        //        delete[] vt;
-        //        return -1;
-        int* LenCltmp = new int[MaxLen];
-        CopyVector(LenCl, LenCltmp, MaxLen);
-        delete[] LenCl;
-// NOLINTNEXTLINE(bugprone-implicit-widening-of-multiplication-result)
-        LenCl = new int[MaxLen * 2];
-        ZeroVector(LenCl, MaxLen * 2);
-        CopyVector(LenCltmp, LenCl, MaxLen);
-        delete[] LenCltmp;
-        MaxLen *= 2;
-        //	std::cout << "Extend array size to " << MaxLen << std::endl;
-      }
       nCl++;
       LenCl[nCl - 1] = next - ib;
       if (nCl > 1)
@@ -452,39 +424,29 @@ int BEmcRec::FindClusters()
     continue;
   }  //  for( ich=1
 
-  if (nCl > 0)
+  // the clusters of the previous event are refilled, their hit lists keep their memory
+  ib = 0;
+  for (int iCl = 0; iCl < nCl; iCl++)
   {
-    ib = 0;
-    for (int iCl = 0; iCl < nCl; iCl++)
-    {
-      leng = LenCl[iCl];
-      hl.clear();
-      for (ich = 0; ich < leng; ich++)
-      {
-        hl.push_back(vhit[ib + ich]);
-      }
-      Clt.ReInitialize(hl);
-      ib += LenCl[iCl];
-      fClusters->push_back(Clt);
-    }
+    leng = LenCl[iCl];
+    EmcCluster::Fill(*fClusters, iCl, vhit + ib, vhit + ib + leng, this);
+    ib += LenCl[iCl];
   }
-  delete[] LenCl;
-  delete[] vhit;
-  delete[] vt;
+  fClusters->erase(fClusters->begin() + nCl, fClusters->end());
 
   return nCl;
 }
 
 // ///////////////////////////////////////////////////////////////////////////
 
-void BEmcRec::Momenta(std::vector<EmcModule>* phit, float& pe, float& px,
+void BEmcRec::Momenta(const std::vector<EmcModule>* phit, float& pe, float& px,
                       float& py, float& pxx, float& pyy, float& pyx,
                       float thresh)
 {
   // First and second momenta calculation
 
   float a, x, y, e, xx, yy, yx;
-  std::vector<EmcModule>::iterator ph;
+  std::vector<EmcModule>::const_iterator ph;
 
   pe = 0;
   px = 0;
@@ -585,14 +547,34 @@ void BEmcRec::Momenta(std::vector<EmcModule>* phit, float& pe, float& px,
 
 float BEmcRec::PredictEnergy(float en, float xcg, float ycg, int ix, int iy)
 {
-  if (_emcprof != nullptr && bProfileProb)
+  PeakProfile peak;
+  SetPeakProfile(en, xcg, ycg, peak);
+  return PredictEnergy(peak, ix, iy);
+}
+
+void BEmcRec::SetPeakProfile(float en, float xcg, float ycg, PeakProfile& peak)
+{
+  peak.en = en;
+  peak.xcg = xcg;
+  peak.ycg = ycg;
+  peak.prob = (_emcprof != nullptr && bProfileProb);
+  peak.epset = false;
+  if (peak.prob)
+  {
+    SetPeakProfileProb(peak);
+  }
+}
+
+float BEmcRec::PredictEnergy(PeakProfile& peak, int ix, int iy)
+{
+  if (peak.prob)
   {
-    return PredictEnergyProb(en, xcg, ycg, ix, iy);
+    return PredictEnergyProb(peak, ix, iy);
   }
 
-  float dx = fabs(fTowerDist(float(ix), xcg));
-  float dy = ycg - iy;
-  return PredictEnergyParam(en, dx, dy);
+  float dx = fabs(fTowerDist(float(ix), peak.xcg));
+  float dy = peak.ycg - iy;
+  return PredictEnergyParam(peak.en, dx, dy);
 }
 
 float BEmcRec::PredictEnergyParam(float /*en*/, float xc, float yc)
@@ -656,6 +638,19 @@ float BEmcRec::PredictEnergyProb(float en, float xcg, float ycg, int ix, int iy)
     return -1;
   }
 
+  PeakProfile peak;
+  peak.en = en;
+  peak.xcg = xcg;
+  peak.ycg = ycg;
+  SetPeakProfileProb(peak);
+  return PredictEnergyProb(peak, ix, iy);
+}
+
+void BEmcRec::SetPeakProfileProb(PeakProfile& peak)
+// Shower impact and the profiles of the 4 towers around the CG
+{
+  float xcg = peak.xcg;
+  float ycg = peak.ycg;
   while (xcg < -0.5)
   {
     xcg += float(fNx);
@@ -669,28 +664,34 @@ float BEmcRec::PredictEnergyProb(float en, float xcg, float ycg, int ix, int iy)
   int ixcg = int(xcg + 0.5);
 // NOLINTNEXTLINE(bugprone-incorrect-roundings)
   int iycg = int(ycg + 0.5);
-  float ddx = fabs(xcg - ixcg);
-  float ddy = fabs(ycg - iycg);
+  peak.ddx = fabs(xcg - ixcg);
+  peak.ddy = fabs(ycg - iycg);
 
   float xg=0, yg=0, zg=0;
-  Tower2Global(en, xcg, ycg, xg, yg, zg);
+  Tower2Global(peak.en, xcg, ycg, xg, yg, zg);
 
-  float theta, phi;
-  GetImpactThetaPhi(xg, yg, zg, theta, phi);
+  GetImpactThetaPhi(xg, yg, zg, peak.theta, peak.phi);
 
-  int isx = 1;
+  peak.isx = 1;
   if (xcg - ixcg < 0)
   {
-    isx = -1;
+    peak.isx = -1;
   }
-  int isy = 1;
+  peak.isy = 1;
   if (ycg - iycg < 0)
   {
-    isy = -1;
+    peak.isy = -1;
   }
+  peak.xcgw = xcg;
+  peak.ixcg = ixcg;
+  peak.iycg = iycg;
+  peak.epset = false;
+}
 
-  int idx = iTowerDist(ixcg, ix) * isx;
-  int idy = (iy - iycg) * isy;
+float BEmcRec::PredictEnergyProb(PeakProfile& peak, int ix, int iy)
+{
+  int idx = iTowerDist(peak.ixcg, ix) * peak.isx;
+  int idy = (iy - peak.iycg) * peak.isy;
 
   int id = -1;
   if (idx == 0 && idy == 0)
@@ -712,18 +713,22 @@ float BEmcRec::PredictEnergyProb(float en, float xcg, float ycg, int ix, int iy)
 
   if (id < 0)
   {
-    float dx = fabs(fTowerDist(xcg, float(ix)));
-    float dy = fabs(iy - ycg);
+    float dx = fabs(fTowerDist(peak.xcgw, float(ix)));
+    float dy = fabs(iy - peak.ycg);
     float rr = sqrt(dx * dx + dy * dy);
     //    return PredictEnergyParam(en, dx, dy);
-    return _emcprof->PredictEnergyR(en, theta, phi, rr);
+    return _emcprof->PredictEnergyR(peak.en, peak.theta, peak.phi, rr);
   }
 
-  float ep[4], err[4];
-  for (int ip = 0; ip < 4; ip++)
+  if (!peak.epset)
   {
-    _emcprof->PredictEnergy(ip, en, theta, phi, ddx, ddy, ep[ip], err[ip]);
+    for (int ip = 0; ip < 4; ip++)
+    {
+      _emcprof->PredictEnergy(ip, peak.en, peak.theta, peak.phi, peak.ddx, peak.ddy, peak.ep[ip], peak.err[ip]);
+    }
+    peak.epset = true;
   }
+  const float* ep = peak.ep;
 
   float eout;
 
@@ -755,7 +760,7 @@ float BEmcRec::PredictEnergyProb(float en, float xcg, float ycg, int ix, int iy)
 
 // ///////////////////////////////////////////////////////////////////////////
 
-float BEmcRec::GetTowerEnergy(int iy, int iz, std::vector<EmcModule>* plist)
+float BEmcRec::GetTowerEnergy(int iy, int iz, const std::vector<EmcModule>* plist)
 {
   int nn = plist->size();
   if (nn <= 0)
@@ -776,8 +781,7 @@ float BEmcRec::GetTowerEnergy(int iy, int iz, std::vector<EmcModule>* plist)
   return 0;
 }
 
-// !!!!! Change here to a ponter to HitList
-float BEmcRec::GetProb(std::vector<EmcModule> HitList, float en, float xg, float yg, float zg, float& chi2, int& ndf)
+float BEmcRec::GetProb(const std::vector<EmcModule>& HitList, float en, float xg, float yg, float zg, float& chi2, int& ndf)
 // Do nothing; should be defined in a detector specific module BEmcRec{Name}
 {
   //  float enoise = 0.01;  // 10 MeV per tower
@@ -81,12 +81,37 @@ class BEmcRec
 
   int FindClusters();
 
-  void Momenta(std::vector<EmcModule> *, float &, float &, float &, float &, float &,
+  void Momenta(const std::vector<EmcModule> *, float &, float &, float &, float &, float &,
                float &, float thresh = 0);
 
   void Tower2Global(float E, float xC, float yC, float &xA, float &yA, float &zA);
-  float GetTowerEnergy(int iy, int iz, std::vector<EmcModule> *plist);
+  float GetTowerEnergy(int iy, int iz, const std::vector<EmcModule> *plist);
 
+  /// The part of PredictEnergy() which only depends on the shower (energy and CG),
+  /// set once with SetPeakProfile() and used for all towers of a peak area
+  class PeakProfile
+  {
+   public:
+    float en{0};
+    float xcg{0};
+    float ycg{0};
+    bool prob{false};  // shower profiles from _emcprof, the rest is only set for these
+    float xcgw{0};     // xcg in [-0.5, fNx-0.5)
+    int ixcg{0};
+    int iycg{0};
+    float ddx{0};
+    float ddy{0};
+    int isx{1};
+    int isy{1};
+    float theta{0};
+    float phi{0};
+    bool epset{false};  // ep and err are evaluated on first use
+    float ep[4]{};
+    float err[4]{};
+  };
+
+  void SetPeakProfile(float en, float xcg, float ycg, PeakProfile &peak);
+  float PredictEnergy(PeakProfile &peak, int ix, int iy);
   float PredictEnergy(float, float, float, int, int);
   float PredictEnergyProb(float en, float xcg, float ycg, int ix, int iy);
   virtual float PredictEnergyParam(float, float, float);
@@ -112,7 +137,7 @@ class BEmcRec
     phi = 0;
   }
 
-  float GetProb(std::vector<EmcModule> HitList, float e, float xg, float yg, float zg, float &chi2, int &ndf);
+  float GetProb(const std::vector<EmcModule> &HitList, float e, float xg, float yg, float zg, float &chi2, int &ndf);
   void SetProbNoiseParam(float rn) { fgProbNoiseParam = rn; }
   float GetProbNoiseParam() { return fgProbNoiseParam; }
 
@@ -121,6 +146,7 @@ class BEmcRec
 
   // Auxiliary static functions
   static int HitNCompare(const void *, const void *);
+  static bool HitNLess(const EmcModule &h1, const EmcModule &h2) { return h1.ich < h2.ich; }
   static int HitACompare(const void *, const void *);
   static void CopyVector(const int *, int *, int);
   static void CopyVector(const EmcModule *, EmcModule *, int);
@@ -150,6 +176,14 @@ class BEmcRec
   BEmcProfile *_emcprof = nullptr;
 
  private:
+  void SetPeakProfileProb(PeakProfile &peak);
+  float PredictEnergyProb(PeakProfile &peak, int ix, int iy);
+
+  // FindClusters() scratch buffers, reused from event to event
+  std::vector<EmcModule> fHitScratch;
+  std::vector<EmcModule> fSwapScratch;
+  std::vector<int> fClusterLengths;
+
   std::string m_ThisName = "NOTSET";
   int Calorimeter_ID = 0;
   float Scin_size = NAN;
@@ -3,6 +3,7 @@
 #include <cdbobjects/CDBTTree.h>
 
 #include <ffamodules/CDBInterface.h>
+#include <ffamodules/InitRunCache.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>                         // for SubsysReco
@@ -134,17 +135,31 @@ void CaloGeomMapping::CreateGeomNode(PHCompositeNode* topNode)
 
   const RawTowerDefs::CalorimeterId caloid = RawTowerDefs::convert_name_to_caloid(m_Detector);
   m_TowerGeomNodeName = "TOWERGEOM_" + m_Detector;
+  // Get the geometry mapping file from the Conditions Database
+  std::string inName=CDBInterface::instance()->getUrl("CALO_TOWER_GEOMETRY");
+
+  bool newcontainer = false;
   m_RawTowerGeomContainer = findNode::getClass<RawTowerGeomContainer>(topNode, m_TowerGeomNodeName);
   if (!m_RawTowerGeomContainer)
   {
-    m_RawTowerGeomContainer = new RawTowerGeomContainer_Cylinderv1(caloid);
+    // an earlier job with the same payload may have built it already
+    PHObject *cached = InitRunCache::instance()->get(Name(), m_TowerGeomNodeName, inName);
+    m_RawTowerGeomContainer = dynamic_cast<RawTowerGeomContainer *>(cached);
+    if (!m_RawTowerGeomContainer)
+    {
+      delete cached;
+      m_RawTowerGeomContainer = new RawTowerGeomContainer_Cylinderv1(caloid);
+      newcontainer = true;
+    }
     // add it to the node tree
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(m_RawTowerGeomContainer, m_TowerGeomNodeName, "PHObject");
     RunDetNode->addNode(newNode);
+    if (!newcontainer)
+    {
+      return;
+    }
   }
 
-  // Get the geometry mapping file from the Conditions Database
-  std::string inName=CDBInterface::instance()->getUrl("CALO_TOWER_GEOMETRY");
   CDBTTree * cdbttree = new CDBTTree(inName);
   cdbttree->LoadCalibrations();
 
@@ -268,6 +283,10 @@ void CaloGeomMapping::CreateGeomNode(PHCompositeNode* topNode)
       }
     }
   }  // end loop over eta, phi bins
+  if (newcontainer)
+  {
+    InitRunCache::instance()->put(Name(), m_TowerGeomNodeName, m_RawTowerGeomContainer, inName);
+  }
 }  // end of building RawTowerGeomContainer
 
 void CaloGeomMapping::set_detector_name(const std::string &name)
@@ -7,6 +7,7 @@
 #include <calobase/TowerInfoContainerv2.h>
 #include <calobase/TowerInfoContainerv3.h>
 #include <calobase/TowerInfoContainerv4.h>
+#include <calobase/TowerInfoContainerv5.h>
 #include <calobase/TowerInfoContainerSimv1.h>
 #include <calobase/TowerInfoContainerSimv2.h>
 
@@ -38,6 +39,7 @@
 #include <variant>
 #include <iostream>  // for operator<<, endl, basic...
 #include <memory>    // for allocator_traits<>::val...
+#include <type_traits>
 #include <vector>    // for vector
 
 static const std::map<CaloTowerDefs::DetectorSystem, std::string> nodemap{
@@ -64,6 +66,11 @@ CaloTowerBuilder::~CaloTowerBuilder()
 //____________________________________________________________________________..
 int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
 {
+  if (m_online)
+  {
+    _processingtype = CaloWaveformProcessing::FAST;
+    m_dobitfliprecovery = false;
+  }
   WaveformProcessing->set_processing_type(_processingtype);
   WaveformProcessing->set_softwarezerosuppression(m_bdosoftwarezerosuppression, m_nsoftwarezerosuppression);
   if (m_setTimeLim)
@@ -74,6 +81,7 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
   {
     WaveformProcessing->set_bitFlipRecovery(m_dobitfliprecovery);
   }
+  WaveformProcessing->set_fastTemplateFit(m_fastTemplateFit);
 
   if (m_dettype == CaloTowerDefs::CEMC)
   {
@@ -101,7 +109,13 @@ int CaloTowerBuilder::InitRun(PHCompositeNode *topNode)
       std::cout << PHWHERE << "ADC Skip mask not found in CDB, not even in the default... " << std::endl;
       exit(1);
     }
+    delete cdbttree;
     cdbttree = new CDBTTree(calibdir.c_str());
+    m_adc_skip_mask.resize(m_packet_high - m_packet_low + 1);
+    for (int pid = m_packet_low; pid <= m_packet_high; ++pid)
+    {
+      m_adc_skip_mask[pid - m_packet_low] = cdbttree->GetIntValue(pid, m_fieldname);
+    }
   }
   else if (m_dettype == CaloTowerDefs::HCALIN)
   {
@@ -244,6 +258,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
     CaloPacketContainer *hcalcont = findNode::getClass<CaloPacketContainer>(topNode, nodemap.find(m_dettype)->second);
     if (!hcalcont)
     {
+      waveforms.clear();
       return Fun4AllReturnCodes::EVENT_OK;
     }
     event = hcalcont;
@@ -262,9 +277,24 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
     }
     event = _event;
   }
+  // the waveform vectors of the previous event are reused, clear() keeps their capacity
+  size_t nwaveforms = 0;
+  auto next_waveform = [&]() -> std::vector<float> &
+  {
+    if (nwaveforms == waveforms.size())
+    {
+      waveforms.emplace_back();
+      waveforms.back().reserve(m_nsamples);
+    }
+    std::vector<float> &waveform = waveforms[nwaveforms++];
+    waveform.clear();
+    return waveform;
+  };
   //since the function call on Packet and CaloPacket is the same, maybe we can use lambda?
   auto process_packet = [&](auto *packet, int pid)
   {
+    // CaloPackets have direct accessors, no string lookup per channel
+    constexpr bool is_calopacket = std::is_same_v<std::remove_cv_t<std::remove_pointer_t<decltype(packet)>>, CaloPacket>;
     if (packet)
     {
       int nchannels = packet->iValue(0, "CHANNELS");
@@ -272,7 +302,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
 
       if (m_dettype == CaloTowerDefs::CEMC)
       {
-        adc_skip_mask = cdbttree->GetIntValue(pid, m_fieldname);
+        adc_skip_mask = m_adc_skip_mask[pid - m_packet_low];
       }
       if (m_dettype == CaloTowerDefs::ZDC)
       {
@@ -298,36 +328,43 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
             {
               for (int iskip = 0; iskip < 64; iskip++)
               {
-                std::vector<float> waveform;
-                waveform.reserve(m_nsamples);
-
-                for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-                {
-                  waveform.push_back(0);
-                }
-                waveforms.push_back(waveform);
-                waveform.clear();
+                next_waveform().assign(m_nzerosuppsamples, 0);
               }
             }
           }
         }
 
-        std::vector<float> waveform;
-        waveform.reserve(m_nsamples);
-        if (packet->iValue(channel, "SUPPRESSED"))
+        std::vector<float> &waveform = next_waveform();
+        if constexpr (is_calopacket)
         {
-          waveform.push_back(packet->iValue(channel, "PRE"));
-          waveform.push_back(packet->iValue(channel, "POST"));
+          if (packet->getSuppressed(channel))
+          {
+            waveform.push_back(packet->getPre(channel));
+            waveform.push_back(packet->getPost(channel));
+          }
+          else
+          {
+            for (int samp = 0; samp < m_nsamples; samp++)
+            {
+              waveform.push_back(packet->getSample(channel, samp));
+            }
+          }
         }
         else
         {
-          for (int samp = 0; samp < m_nsamples; samp++)
+          if (packet->iValue(channel, "SUPPRESSED"))
           {
-            waveform.push_back(packet->iValue(samp, channel));
+            waveform.push_back(packet->iValue(channel, "PRE"));
+            waveform.push_back(packet->iValue(channel, "POST"));
+          }
+          else
+          {
+            for (int samp = 0; samp < m_nsamples; samp++)
+            {
+              waveform.push_back(packet->iValue(samp, channel));
+            }
           }
         }
-        waveforms.push_back(waveform);
-        waveform.clear();
       }
 
       if (nchannels < m_nchannels && !(m_dettype == CaloTowerDefs::CEMC && adc_skip_mask < 4))
@@ -338,15 +375,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
           {
             continue;
           }
-          std::vector<float> waveform;
-          waveform.reserve(m_nsamples);
-
-          for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-          {
-            waveform.push_back(0);
-          }
-          waveforms.push_back(waveform);
-          waveform.clear();
+          next_waveform().assign(m_nzerosuppsamples, 0);
         }
       }
     }
@@ -358,14 +387,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
         {
           continue;
         }
-        std::vector<float> waveform;
-        waveform.reserve(2);
-        for (int samp = 0; samp < m_nzerosuppsamples; samp++)
-        {
-          waveform.push_back(0);
-        }
-        waveforms.push_back(waveform);
-        waveform.clear();
+        next_waveform().assign(m_nzerosuppsamples, 0);
       }
     }
     return Fun4AllReturnCodes::EVENT_OK;
@@ -397,6 +419,7 @@ int CaloTowerBuilder::process_data(PHCompositeNode *topNode, std::vector<std::ve
       }
     }
   }
+  waveforms.resize(nwaveforms);
 
   return Fun4AllReturnCodes::EVENT_OK;
 
@@ -408,7 +431,7 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
   {
     return process_sim();
   }
-  std::vector<std::vector<float>> waveforms;
+  std::vector<std::vector<float>> &waveforms = m_waveforms;
   if(process_data(topNode, waveforms) == Fun4AllReturnCodes::ABORTEVENT)
   {
     return Fun4AllReturnCodes::ABORTEVENT;
@@ -452,7 +475,6 @@ int CaloTowerBuilder::process_event(PHCompositeNode *topNode)
       towerinfo->set_waveform_value(j, waveforms.at(i).at(j));
     }
   }
-  waveforms.clear();
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -580,6 +602,10 @@ void CaloTowerBuilder::CreateNodeTree(PHCompositeNode *topNode)
   {
     m_CaloInfoContainer = new TowerInfoContainerv4(DetectorEnum);
   }
+  else if (m_buildertype == CaloTowerDefs::kWaveformTowerv5)
+  {
+    m_CaloInfoContainer = new TowerInfoContainerv5(DetectorEnum);
+  }
   else if (m_buildertype == CaloTowerDefs::kWaveformTowerSimv1)
   {
     m_CaloInfoContainer = new TowerInfoContainerSimv1(DetectorEnum);
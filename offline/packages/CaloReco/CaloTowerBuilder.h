@@ -12,6 +12,7 @@
 
 #include <limits>
 #include <string>
+#include <vector>
 
 class CaloWaveformProcessing;
 class PHCompositeNode;
@@ -95,6 +96,19 @@ class CaloTowerBuilder : public SubsysReco
     m_dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! use the batched closed form template fit instead of a TF1 fit per channel
+  void set_fastTemplateFit(bool dofasttemplatefit)
+  {
+    m_fastTemplateFit = dofasttemplatefit;
+  }
+
+  //! low latency settings for the online monitoring: the FAST waveform processing
+  //! for all detectors, overriding set_processing_type(), and no bit flip recovery
+  void set_online_mode(bool online = true)
+  {
+    m_online = online;
+  }
+
   void set_tbt_softwarezerosuppression(const std::string &url)
   {
     m_zsURL = url;
@@ -139,6 +153,8 @@ class CaloTowerBuilder : public SubsysReco
   float m_timeLim_low{-3.0};
   float m_timeLim_high{4.0};
   bool m_dobitfliprecovery{false};
+  bool m_fastTemplateFit{false};
+  bool m_online{false};
 
   std::string m_fieldname;
   std::string m_calibName;
@@ -146,6 +162,12 @@ class CaloTowerBuilder : public SubsysReco
   std::string m_zsURL;
   std::string m_zs_fieldname{"zs_threshold"};
 
+  //! adc skip mask of the CEMC packets, read from the CDB in InitRun, indexed by packet id - m_packet_low
+  std::vector<unsigned int> m_adc_skip_mask;
+
+  //! waveforms of the current event, kept between events so the per channel vectors are not reallocated
+  std::vector<std::vector<float>> m_waveforms;
+
 
 };
 
@@ -210,6 +210,10 @@ int CaloTowerCalib::InitRun(PHCompositeNode *topNode)
   {
     cdbttree = new CDBTTree(m_directURL);
   }
+  if (cdbttree)
+  {
+    m_calib_column = cdbttree->GetFloatColumn(m_fieldname);
+  }
   //time calibration getting the CDB
   m_calibName_time = m_detector + "_meanTime";
   m_fieldname_time = "time";
@@ -276,6 +280,15 @@ int CaloTowerCalib::InitRun(PHCompositeNode *topNode)
     }
   } 
 
+  if (m_dotimecalib)
+  {
+    m_time_column = cdbttree_time->GetFloatColumn(m_fieldname_time);
+  }
+  if (m_doZScrosscalib)
+  {
+    m_ZScrosscalib_column = cdbttree_ZScrosscalib->GetFloatColumn(m_fieldname_ZScrosscalib);
+  }
+
   PHNodeIterator iter(topNode);
 
   // Looking for the DST node
@@ -316,12 +329,12 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
     TowerInfo *caloinfo_raw = _raw_towers->get_tower_at_channel(channel);
     _calib_towers->get_tower_at_channel(channel)->copy_tower(caloinfo_raw);
     float raw_amplitude = caloinfo_raw->get_energy();
-    float calibconst = cdbttree->GetFloatValue(key, m_fieldname);
+    float calibconst = m_calib_column[key];
     bool isZS = caloinfo_raw->get_isZS();
 
     if (isZS && m_doZScrosscalib)
     {
-      float crosscalibconst = cdbttree_ZScrosscalib->GetFloatValue(key, m_fieldname_ZScrosscalib);
+      float crosscalibconst = m_ZScrosscalib_column[key];
       if (crosscalibconst == 0) 
       { 
         crosscalibconst = 1; 
@@ -344,7 +357,7 @@ int CaloTowerCalib::process_event(PHCompositeNode *topNode)
       {
       //I realized that there is no point to do timing calibration for the towerinfov1 object since the resolution is not enough...
       float raw_time = caloinfo_raw->get_time_float();
-      float meantime = cdbttree_time->GetFloatValue(key, m_fieldname_time);
+      float meantime = m_time_column[key];
       _calib_towers->get_tower_at_channel(channel)->set_time_float(raw_time - meantime);
       }
     }
@@ -7,12 +7,13 @@
 
 #include <calobase/TowerInfoContainer.h>  // for TowerInfoContainer, TowerIn...
 
+#include <cdbobjects/CDBTTree.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <iostream>
 #include <string>
 
-class CDBTTree;
 class PHCompositeNode;
 class TowerInfoContainer;
 
@@ -128,6 +129,10 @@ class CaloTowerCalib : public SubsysReco
   CDBTTree *cdbttree = nullptr;
   CDBTTree *cdbttree_time = nullptr;
   CDBTTree *cdbttree_ZScrosscalib = nullptr;
+  // fields used in process_event, looked up once per run
+  CDBTTree::Column<float> m_calib_column;
+  CDBTTree::Column<float> m_time_column;
+  CDBTTree::Column<float> m_ZScrosscalib_column;
   int m_runNumber;
 };
 
@@ -7,12 +7,13 @@
 
 #include <calobase/TowerInfoContainer.h>  // for TowerInfoContainer, TowerIn...
 
+#include <cdbobjects/CDBTTree.h>
+
 #include <fun4all/SubsysReco.h>
 
 #include <iostream>
 #include <string>
 
-class CDBTTree;
 class PHCompositeNode;
 class TowerInfoContainer;
 
@@ -92,6 +93,10 @@ class CaloTowerStatus : public SubsysReco
   CDBTTree *m_cdbttree_chi2{nullptr};
   CDBTTree *m_cdbttree_time{nullptr};
   CDBTTree *m_cdbttree_hotMap{nullptr};
+  // fields used in process_event, looked up once per run
+  CDBTTree::Column<float> m_chi2_column;
+  CDBTTree::Column<float> m_time_column;
+  CDBTTree::Column<int> m_hotMap_column;
 
   bool m_doHotChi2{true};
   bool m_doTime{true};
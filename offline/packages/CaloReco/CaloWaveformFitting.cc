@@ -1,4 +1,5 @@
 #include "CaloWaveformFitting.h"
+#include "CaloWaveformTemplateFitter.h"
 
 #include <TF1.h>
 #include <TFile.h>
@@ -16,9 +17,13 @@
 #include <ROOT/TThreadedObject.hxx>
 
 #include <pthread.h>
+#include <algorithm>
+#include <cassert>
 #include <iostream>
-#include <string>
 #include <limits>
+#include <map>
+#include <string>
+#include <utility>
 
 ROOT::TThreadExecutor *t = new ROOT::TThreadExecutor(1);
 double CaloWaveformFitting::template_function(double *x, double *par)
@@ -30,6 +35,7 @@ double CaloWaveformFitting::template_function(double *x, double *par)
 CaloWaveformFitting::~CaloWaveformFitting()
 {
   delete h_template;
+  delete m_TemplateFitter;
 }
 
 void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
@@ -43,6 +49,47 @@ void CaloWaveformFitting::initialize_processing(const std::string &templatefile)
   delete fin;
   m_peakTimeTemp = h_template->GetBinCenter(h_template->GetMaximumBin());
   t = new ROOT::TThreadExecutor(_nthreads);
+
+  // the template profile bin centers are equidistant, linear interpolation
+  // between them reproduces TH1::Interpolate
+  std::vector<float> values;
+  values.reserve(h_template->GetNbinsX());
+  for (int i = 1; i <= h_template->GetNbinsX(); i++)
+  {
+    values.push_back(h_template->GetBinContent(i));
+  }
+  delete m_TemplateFitter;
+  m_TemplateFitter = new CaloWaveformTemplateFitter();
+  m_TemplateFitter->set_template(values, h_template->GetBinCenter(1), h_template->GetBinWidth(1));
+}
+
+std::vector<double> CaloWaveformFitting::get_fast_template() const
+{
+  std::vector<double> fasttemplate;
+  if (!h_template)
+  {
+    return fasttemplate;
+  }
+  fasttemplate.push_back(m_peakTimeTemp);
+  fasttemplate.push_back(h_template->GetBinCenter(1));
+  fasttemplate.push_back(h_template->GetBinWidth(1));
+  for (int i = 1; i <= h_template->GetNbinsX(); i++)
+  {
+    // as float, like the template of the fast fit
+    fasttemplate.push_back(static_cast<float>(h_template->GetBinContent(i)));
+  }
+  return fasttemplate;
+}
+
+void CaloWaveformFitting::initialize_fast_processing(const std::vector<double> &fasttemplate)
+{
+  assert(fasttemplate.size() > 3);
+  m_peakTimeTemp = fasttemplate[0];
+  t = new ROOT::TThreadExecutor(_nthreads);
+  std::vector<float> values(fasttemplate.begin() + 3, fasttemplate.end());
+  delete m_TemplateFitter;
+  m_TemplateFitter = new CaloWaveformTemplateFitter();
+  m_TemplateFitter->set_template(values, fasttemplate[1], fasttemplate[2]);
 }
 
 std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vector<std::vector<float>> waveformvector)
@@ -53,70 +100,32 @@ std::vector<std::vector<float>> CaloWaveformFitting::process_waveform(std::vecto
   {
     waveformvector.at(i).push_back(i);
   }
-  fitresults = calo_processing_templatefit(waveformvector);
+  fitresults = calo_processing_templatefit(std::move(waveformvector));
   return fitresults;
 }
 
 std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit(std::vector<std::vector<float>> chnlvector)
 {
+  if (m_fastTemplateFit && m_TemplateFitter)
+  {
+    return calo_processing_templatefit_fast(chnlvector);
+  }
   auto func = [&](std::vector<float> &v)
   {
     int size1 = v.size() - 1;
     if (size1 == _nzerosuppresssamples)
     {
-      v.push_back(v.at(1) - v.at(0));  // returns peak sample - pedestal sample
-      v.push_back(std::numeric_limits<float>::quiet_NaN());                 // set time to qnan for ZS
-      v.push_back(v.at(0));
-      if (v.at(0) != 0 && v.at(1) == 0) // check if post-sample is 0, if so set high chi2
-      { 
-        v.push_back(1000000);
-      } 
-      else 
-      {
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
-      }
-      v.push_back(0);
+      push_zs_result(v, v.at(1) - v.at(0));  // returns peak sample - pedestal sample
     }
     else
     {
       float maxheight = 0;
-      int maxbin = 0;
-      for (int i = 0; i < size1; i++)
-      {
-        if (v.at(i) > maxheight)
-        {
-          maxheight = v.at(i);
-          maxbin = i;
-        }
-      }
       float pedestal = 1500;
-      if (maxbin > 4)
-      {
-        pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
-      }
-      else if (maxbin > 3)
-      {
-        pedestal = (v.at(maxbin - 4));
-      }
-      else
-      {
-        pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
-      }
+      estimate_pedestal(v, size1, maxheight, pedestal);
 
-      if ( (_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight-pedestal  < _nsoftwarezerosuppression)  )
+      if (is_software_zero_suppressed(v, maxheight, pedestal))
       {
-        v.push_back(v.at(6) - v.at(0));
-        v.push_back(std::numeric_limits<float>::quiet_NaN());
-        v.push_back(v.at(0));
-        if (v.at(0) != 0 && v.at(1) == 0) // check if post-sample is 0, if so set high chi2
-        { 
-          v.push_back(1000000);
-        } 
-        else 
-        {
-          v.push_back(std::numeric_limits<float>::quiet_NaN());
-        }
-        v.push_back(0);
+        push_zs_result(v, v.at(6) - v.at(0));
       }
       else
       {
@@ -146,51 +155,15 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
         chi2min /= size1 - 3;  // divide by the number of dof
         if (chi2min > _chi2threshold && (f->GetParameter(2) < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (f->GetParameter(2) > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold) && _dobitfliprecovery) 
         {
-          std::vector<float> rv; // temporary recovered waveform
-          rv.reserve(size1);
-          for (int i = 0; i < size1; i++)
-          {
-            rv.push_back(v.at(i));
-          }
-          unsigned int bits[3] = {8192,4096,2048};
-          for (auto bit : bits) 
-          {
-            for (int i = 0; i < size1; i++) 
-            {
-              if (((unsigned int)rv.at(i) & bit) && ((unsigned int)rv.at(i) % bit > _bfr_lowpedestalthreshold)) 
-              {
-                rv.at(i) = rv.at(i) - bit;
-              }
-            }
-          }
+          std::vector<float> rv(v.begin(), v.begin() + size1); // temporary recovered waveform
+          recover_bitflips(rv);
           for (int i = 0; i < size1; i++)
           {
             h->SetBinContent(i + 1, rv.at(i));
             h->SetBinError(i + 1, 1);
           }
 
-          maxheight = 0;
-          maxbin = 0;
-          for (int i = 0; i < size1; i++)
-          {
-            if (rv.at(i) > maxheight)
-            {
-              maxheight = rv.at(i);
-              maxbin = i;
-            }
-          }
-          if (maxbin > 4)
-          {
-            pedestal = 0.5 * (rv.at(maxbin - 4) + rv.at(maxbin - 5));
-          }
-          else if (maxbin > 3)
-          {
-            pedestal = (rv.at(maxbin - 4));
-          }
-          else
-          {
-            pedestal = 0.5 * (rv.at(size1 - 3) + rv.at(size1 - 2));
-          }
+          estimate_pedestal(rv, size1, maxheight, pedestal);
           
           auto recover_f = new TF1(std::string("recover_f_" + std::to_string((int) round(v.at(size1)))).c_str(), this, &CaloWaveformFitting::template_function, 0, 31, 3, "CaloWaveformFitting", "template_function");
           ROOT::Math::WrappedMultiTF1 *recoverFitFunction = new ROOT::Math::WrappedMultiTF1(*recover_f, 3);
@@ -269,6 +242,178 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit
   return fit_params;
 }
 
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector)
+{
+  int nchnls = chnlvector.size();
+  std::vector<std::vector<float>> fit_params(nchnls);
+  std::vector<float> pedestals(nchnls, 0);
+  // channels to fit, grouped by number of samples
+  std::map<int, std::vector<int>> tofit;
+  for (int i = 0; i < nchnls; i++)
+  {
+    std::vector<float> v = chnlvector.at(i);
+    int size1 = v.size() - 1;
+    if (size1 == _nzerosuppresssamples)
+    {
+      push_zs_result(v, v.at(1) - v.at(0));
+      fit_params.at(i).assign(v.end() - 5, v.end());
+      continue;
+    }
+    float maxheight = 0;
+    estimate_pedestal(v, size1, maxheight, pedestals.at(i));
+    if (is_software_zero_suppressed(v, maxheight, pedestals.at(i)))
+    {
+      push_zs_result(v, v.at(6) - v.at(0));
+      fit_params.at(i).assign(v.end() - 5, v.end());
+      continue;
+    }
+    tofit[size1].push_back(i);
+  }
+
+  for (auto &[size1, channels] : tofit)
+  {
+    std::vector<const float *> waveforms;
+    waveforms.reserve(channels.size());
+    for (int ch : channels)
+    {
+      waveforms.push_back(chnlvector.at(ch).data());
+    }
+    double time_low = -1 * m_peakTimeTemp;
+    double time_high = size1 - m_peakTimeTemp;
+    std::vector<CaloWaveformTemplateFitter::Result> results;
+    fit_templates(waveforms, size1, (m_setTimeLim ? m_timeLim_low : time_low), (m_setTimeLim ? m_timeLim_high : time_high), results);
+
+    // refit waveforms with a bad chi2 after removing bit flips
+    std::vector<std::vector<float>> recovered;
+    std::vector<int> recovered_index;
+    for (unsigned int j = 0; j < channels.size(); j++)
+    {
+      float pedestal = pedestals.at(channels[j]);
+      if (_dobitfliprecovery && results[j].chi2 / (size1 - 3) > _chi2threshold && (results[j].pedestal < _bfr_highpedestalthreshold || pedestal < _bfr_highpedestalthreshold) && (results[j].pedestal > _bfr_lowpedestalthreshold || pedestal > _bfr_lowpedestalthreshold))
+      {
+        recovered.emplace_back(waveforms[j], waveforms[j] + size1);
+        recover_bitflips(recovered.back());
+        recovered_index.push_back(j);
+      }
+    }
+    std::vector<CaloWaveformTemplateFitter::Result> recovered_results;
+    if (!recovered.empty())
+    {
+      std::vector<const float *> recovered_waveforms;
+      for (auto &rv : recovered)
+      {
+        recovered_waveforms.push_back(rv.data());
+      }
+      fit_templates(recovered_waveforms, size1, time_low, time_high, recovered_results);
+    }
+    std::vector<int> flags(channels.size(), 0);
+    for (unsigned int r = 0; r < recovered_results.size(); r++)
+    {
+      const auto &res = recovered_results[r];
+      if (res.chi2 / (size1 - 3) < _chi2lowthreshold && res.pedestal < _bfr_highpedestalthreshold && res.pedestal > _bfr_lowpedestalthreshold)
+      {
+        results[recovered_index[r]] = res;
+        flags[recovered_index[r]] = 1;
+      }
+    }
+
+    for (unsigned int j = 0; j < channels.size(); j++)
+    {
+      fit_params.at(channels[j]) = {results[j].amplitude, results[j].time, results[j].pedestal, results[j].chi2 / (size1 - 3), static_cast<float>(flags[j])};
+    }
+  }
+  return fit_params;
+}
+
+void CaloWaveformFitting::fit_templates(const std::vector<const float *> &waveforms, int nsamples, double time_low, double time_high, std::vector<CaloWaveformTemplateFitter::Result> &results)
+{
+  int nwaveforms = waveforms.size();
+  int nchunks = std::min(_nthreads, nwaveforms);
+  if (nchunks <= 1)
+  {
+    m_TemplateFitter->fit(waveforms, nsamples, time_low, time_high, results);
+    return;
+  }
+  results.resize(nwaveforms);
+  int chunksize = (nwaveforms + nchunks - 1) / nchunks;
+  auto func = [&](unsigned int chunk)
+  {
+    int first = chunk * chunksize;
+    int last = std::min(nwaveforms, first + chunksize);
+    if (first >= last)
+    {
+      return;
+    }
+    std::vector<const float *> chunkwaveforms(waveforms.begin() + first, waveforms.begin() + last);
+    std::vector<CaloWaveformTemplateFitter::Result> chunkresults;
+    m_TemplateFitter->fit(chunkwaveforms, nsamples, time_low, time_high, chunkresults);
+    std::copy(chunkresults.begin(), chunkresults.end(), results.begin() + first);
+  };
+  t->Foreach(func, nchunks);
+}
+
+void CaloWaveformFitting::estimate_pedestal(const std::vector<float> &v, int size1, float &maxheight, float &pedestal)
+{
+  maxheight = 0;
+  int maxbin = 0;
+  for (int i = 0; i < size1; i++)
+  {
+    if (v.at(i) > maxheight)
+    {
+      maxheight = v.at(i);
+      maxbin = i;
+    }
+  }
+  if (maxbin > 4)
+  {
+    pedestal = 0.5 * (v.at(maxbin - 4) + v.at(maxbin - 5));
+  }
+  else if (maxbin > 3)
+  {
+    pedestal = (v.at(maxbin - 4));
+  }
+  else
+  {
+    pedestal = 0.5 * (v.at(size1 - 3) + v.at(size1 - 2));
+  }
+}
+
+bool CaloWaveformFitting::is_software_zero_suppressed(const std::vector<float> &v, float maxheight, float pedestal) const
+{
+  return (_bdosoftwarezerosuppression && v.at(6) - v.at(0) < _nsoftwarezerosuppression) || (_maxsoftwarezerosuppression && maxheight - pedestal < _nsoftwarezerosuppression);
+}
+
+void CaloWaveformFitting::push_zs_result(std::vector<float> &v, float amplitude)
+{
+  v.push_back(amplitude);
+  v.push_back(std::numeric_limits<float>::quiet_NaN());  // set time to qnan for ZS
+  v.push_back(v.at(0));
+  if (v.at(0) != 0 && v.at(1) == 0)  // check if post-sample is 0, if so set high chi2
+  {
+    v.push_back(1000000);
+  }
+  else
+  {
+    v.push_back(std::numeric_limits<float>::quiet_NaN());
+  }
+  v.push_back(0);
+}
+
+void CaloWaveformFitting::recover_bitflips(std::vector<float> &rv) const
+{
+  unsigned int bits[3] = {8192, 4096, 2048};
+  for (auto bit : bits)
+  {
+    for (auto &sample : rv)
+    {
+      if (((unsigned int) sample & bit) && ((unsigned int) sample % bit > _bfr_lowpedestalthreshold))
+      {
+        sample = sample - bit;
+      }
+    }
+  }
+}
+
 void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax)
 {
   int n = 3;
@@ -337,13 +482,14 @@ void CaloWaveformFitting::FastMax(float x0, float x1, float x2, float y0, float
   delete sp;
   return;
 }
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
+  fit_values.reserve(nchnls);
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
+    const std::vector<float> &v = chnlvector.at(m);
     int nsamples = v.size();
 
     double maxy = v.at(0);
@@ -393,20 +539,19 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_fast(std::v
       }
     }
     amp -= ped;
-    std::vector<float> val = {amp, time, ped, chi2, 0};
-    fit_values.push_back(val);
-    val.clear();
+    fit_values.push_back({amp, time, ped, chi2, 0});
   }
   return fit_values;
 }
 
-std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector)
 {
   std::vector<std::vector<float>> fit_values;
   int nchnls = chnlvector.size();
+  fit_values.reserve(nchnls);
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
+    const std::vector<float> &v = chnlvector.at(m);
     int nsamples = (int)v.size();
 
     if (nsamples == 2)
@@ -420,16 +565,16 @@ std::vector<std::vector<float>> CaloWaveformFitting::calo_processing_nyquist(std
       continue;
     }
     
-    std::vector<float> result = NyquistInterpolation(v);
-    fit_values.push_back(result);
+    fit_values.push_back(NyquistInterpolation(v));
   }
   return fit_values;
 
 }
 //mabye I can find a way to make it thread safe
-std::vector<float> CaloWaveformFitting::NyquistInterpolation(std::vector<float> &vec_signal_samples)
+std::vector<float> CaloWaveformFitting::NyquistInterpolation(const std::vector<float> &vec_signal_samples)
 {
   // int N = (int) vec_signal_samples.size();
+  set_psinc_tables(vec_signal_samples.size());
   auto max_elem_iter = std::max_element(vec_signal_samples.begin(), vec_signal_samples.end());
   int maxx = std::distance(vec_signal_samples.begin(), max_elem_iter);
   float max = *max_elem_iter;
@@ -526,7 +671,7 @@ double CaloWaveformFitting::Dkernel(double x, int N)
   return sum;
 }
 
-float CaloWaveformFitting::stablepsinc(float time, std::vector<float> &vec_signal_samples)
+float CaloWaveformFitting::stablepsinc(float time, const std::vector<float> &vec_signal_samples)
 {
   int N = (int) vec_signal_samples.size();
   float sum = 0;
@@ -547,7 +692,24 @@ float CaloWaveformFitting::stablepsinc(float time, std::vector<float> &vec_signa
   return sum;
 }
 
-float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samples)
+void CaloWaveformFitting::set_psinc_tables(int N)
+{
+  if (N == (int) m_psincSign.size())
+  {
+    return;
+  }
+  m_psincCos.resize(N);
+  m_psincSin.resize(N);
+  m_psincSign.resize(N);
+  for (int n = 0; n < N; n++)
+  {
+    m_psincCos[n] = std::cos(M_PI * n / N);
+    m_psincSin[n] = std::sin(M_PI * n / N);
+    m_psincSign[n] = (n % 2 == 0) ? 1 : -1;
+  }
+}
+
+float CaloWaveformFitting::psinc(float time, const std::vector<float> &vec_signal_samples)
 {
   int N = (int) vec_signal_samples.size();
 
@@ -564,25 +726,33 @@ float CaloWaveformFitting::psinc(float time, std::vector<float> &vec_signal_samp
     }
   }
 
-  float sum = 0;
+  // sin(pi*(t-n)) = (-1)^n sin(pi*t) and the sin/tan(pi*(t-n)/N) from the tables of cos/sin(pi*n/N),
+  // three sin/cos per call instead of two per sample
+  const double piu = M_PI * time;
+  const double sinpiu = std::sin(piu);
+  const double cospiuN = std::cos(piu / N);
+  const double sinpiuN = std::sin(piu / N);
+  const float *samples = vec_signal_samples.data();
+  const double *costab = m_psincCos.data();
+  const double *sintab = m_psincSin.data();
+  const double *signtab = m_psincSign.data();
+  double sum = 0;
   if (N % 2 == 0)
   {
     for (int n = 0; n < N; n++)
     {
-      double piu = M_PI * (time - n);
-      double piuN = piu / N;
-      sum += vec_signal_samples[n] * std::sin(piu) / (std::tan(piuN)) / N;
+      const double sind = sinpiuN * costab[n] - cospiuN * sintab[n];
+      const double cosd = cospiuN * costab[n] + sinpiuN * sintab[n];
+      sum += signtab[n] * samples[n] * cosd / sind;
     }
   }
   else
   {
     for (int n = 0; n < N; n++)
     {
-      double piu = M_PI * (time - n);
-      double piuN = piu / N;
-      sum += vec_signal_samples[n] * std::sin(piu) / (std::sin(piuN)) / N;
+      const double sind = sinpiuN * costab[n] - cospiuN * sintab[n];
+      sum += signtab[n] * samples[n] / sind;
     }
   }
- 
-  return sum;
+  return sinpiu * sum / N;
 }
@@ -4,6 +4,8 @@
 #include <string>
 #include <vector>
 
+#include "CaloWaveformTemplateFitter.h"
+
 class TProfile;
 
 class CaloWaveformFitting
@@ -51,25 +53,48 @@ class CaloWaveformFitting
     _dobitfliprecovery = dobitfliprecovery;
   }
 
+  //! use the batched closed form template fit instead of a TF1 fit per channel
+  void set_fastTemplateFit(bool dofasttemplatefit)
+  {
+    m_fastTemplateFit = dofasttemplatefit;
+  }
+
   std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
   std::vector<std::vector<float>> calo_processing_templatefit(std::vector<std::vector<float>> chnlvector);
-  std::vector<std::vector<float>> calo_processing_fast(std::vector<std::vector<float>> chnlvector);
-  std::vector<std::vector<float>> calo_processing_nyquist(std::vector<std::vector<float>> chnlvector);
+  std::vector<std::vector<float>> calo_processing_fast(const std::vector<std::vector<float>> &chnlvector);
+  std::vector<std::vector<float>> calo_processing_nyquist(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing(const std::string &templatefile);
 
+  //! what the fast template fit needs from the template file: peak time, center
+  //! of the first bin, bin width and the bin contents (after initialize_processing)
+  std::vector<double> get_fast_template() const;
+  //! set up only the fast template fit from get_fast_template() of an earlier job,
+  //! without reading the template file
+  void initialize_fast_processing(const std::vector<double> &fasttemplate);
+
  private:
   void FastMax(float x0, float x1, float x2, float y0, float y1, float y2, float &xmax, float &ymax);
-  std::vector<float> NyquistInterpolation(std::vector<float> &vec_signal_samples);
+  std::vector<float> NyquistInterpolation(const std::vector<float> &vec_signal_samples);
   double Dkernelodd(double x, int N);
   double Dkernel(double x, int N);
 
-  float stablepsinc(float t, std::vector<float> &vec_signal_samples);
+  float stablepsinc(float t, const std::vector<float> &vec_signal_samples);
 
-  float psinc(float t, std::vector<float> &vec_signal_samples);
+  //! cos/sin(pi*n/N) and (-1)^n for psinc, recomputed when the number of samples changes
+  void set_psinc_tables(int N);
+  float psinc(float t, const std::vector<float> &vec_signal_samples);
   double template_function(double *x, double *par);
 
+  std::vector<std::vector<float>> calo_processing_templatefit_fast(const std::vector<std::vector<float>> &chnlvector);
+  void fit_templates(const std::vector<const float *> &waveforms, int nsamples, double time_low, double time_high, std::vector<CaloWaveformTemplateFitter::Result> &results);
+  static void estimate_pedestal(const std::vector<float> &v, int size1, float &maxheight, float &pedestal);
+  bool is_software_zero_suppressed(const std::vector<float> &v, float maxheight, float pedestal) const;
+  static void push_zs_result(std::vector<float> &v, float amplitude);
+  void recover_bitflips(std::vector<float> &rv) const;
+
   TProfile *h_template {nullptr};
+  CaloWaveformTemplateFitter *m_TemplateFitter {nullptr};
   double m_peakTimeTemp {0};
   int _nthreads{1};
   int _nzerosuppresssamples{2};
@@ -85,6 +110,11 @@ class CaloWaveformFitting
   bool _maxsoftwarezerosuppression{false};
   bool m_setTimeLim{false};
   bool _dobitfliprecovery {false};
+  bool m_fastTemplateFit {false};
+
+  std::vector<double> m_psincCos;
+  std::vector<double> m_psincSin;
+  std::vector<double> m_psincSign;
 
   std::string m_template_input_file;
   std::string url_template;
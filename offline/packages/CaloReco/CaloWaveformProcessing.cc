@@ -11,12 +11,15 @@
 #include <iostream>
 #include <memory>                     // for allocator_traits<>::value_type
 #include <string>
+#include <utility>
+#include <vector>
 
 Ort::Session *onnxmodule;
 
 CaloWaveformProcessing::~CaloWaveformProcessing()
 {
   delete m_Fitter;
+  delete m_onnxBatch;
 }
 
 void CaloWaveformProcessing::initialize_processing()
@@ -28,7 +31,23 @@ void CaloWaveformProcessing::initialize_processing()
     std::string calibrations_repo_template = std::string(calibrationsroot) + "/WaveformProcessing/templates/" + m_template_input_file;
     url_template = CDBInterface::instance()->getUrl(m_template_name, calibrations_repo_template);
     m_Fitter = new CaloWaveformFitting();
-    m_Fitter->initialize_processing(url_template);
+    m_Fitter->set_fastTemplateFit(m_fastTemplateFit);
+    // the fast fit does not need the template profile, only its bin contents.
+    // With the local CDB cache they are read from there in later jobs
+    const std::string fasttemplatename = "CaloWaveformFitting_fasttemplate_v1";
+    std::vector<double> fasttemplate;
+    if (m_fastTemplateFit && CDBInterface::instance()->getProcessedPayload(url_template, fasttemplatename, fasttemplate) && fasttemplate.size() > 3)
+    {
+      m_Fitter->initialize_fast_processing(fasttemplate);
+    }
+    else
+    {
+      m_Fitter->initialize_processing(url_template);
+      if (m_fastTemplateFit)
+      {
+        CDBInterface::instance()->putProcessedPayload(url_template, fasttemplatename, m_Fitter->get_fast_template());
+      }
+    }
     m_Fitter->set_nthreads(get_nthreads());
     if (m_setTimeLim)
     {
@@ -48,7 +67,15 @@ void CaloWaveformProcessing::initialize_processing()
   {
     std::string calibrations_repo_model = std::string(calibrationsroot) + "/WaveformProcessing/models/" + m_model_name;
     url_onnx = CDBInterface::instance()->getUrl(m_model_name, calibrations_repo_model);
-    onnxmodule = onnxSession(url_onnx);
+    onnxOptions options;
+    options.intra_op_threads = get_nthreads();
+    if (m_onnxUseCuda)
+    {
+      options.provider = onnxOptions::CUDA;
+    }
+    onnxmodule = onnxSession(url_onnx, options);
+    delete m_onnxBatch;
+    m_onnxBatch = new onnxBatch(onnxmodule, {m_onnxSamples}, m_onnxReturn);
   }
   else if (m_processingtype == CaloWaveformProcessing::NYQUIST)
   {
@@ -57,19 +84,27 @@ void CaloWaveformProcessing::initialize_processing()
     m_Fitter = new CaloWaveformFitting();
     m_Fitter->initialize_processing(url_template);
   }
+  else if (m_processingtype == CaloWaveformProcessing::FAST)
+  {
+    // no template, the fast processing only uses the peak finding of the fitter
+    delete m_Fitter;
+    m_Fitter = new CaloWaveformFitting();
+  }
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::vector<std::vector<float>> waveformvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(const std::vector<std::vector<float>> &waveformvector)
 {
   int size1 = waveformvector.size();
   std::vector<std::vector<float>> fitresults;
   if (m_processingtype == CaloWaveformProcessing::TEMPLATE)
   {
+    // the template fit appends the channel number and its results, it works on a copy
+    std::vector<std::vector<float>> chnlvector = waveformvector;
     for (int i = 0; i < size1; i++)
     {
-      waveformvector.at(i).push_back(i);
+      chnlvector.at(i).push_back(i);
     }
-    fitresults = m_Fitter->calo_processing_templatefit(waveformvector);
+    fitresults = m_Fitter->calo_processing_templatefit(std::move(chnlvector));
   }
   if (m_processingtype == CaloWaveformProcessing::ONNX)
   {
@@ -86,21 +121,28 @@ std::vector<std::vector<float>> CaloWaveformProcessing::process_waveform(std::ve
   return fitresults;
 }
 
-std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(std::vector<std::vector<float>> chnlvector)
+std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector)
 {
-  std::vector<std::vector<float>> fit_values;
+  // all channels of the event are evaluated in one batch
   int nchnls = chnlvector.size();
+  float *input = m_onnxBatch->input(nchnls);
   for (int m = 0; m < nchnls; m++)
   {
-    std::vector<float> v = chnlvector.at(m);
-    int nsamples = v.size() - 1;
-    std::vector<float> vtmp;
-    vtmp.reserve(nsamples);
+    const std::vector<float> &v = chnlvector.at(m);
+    int nsamples = std::min<int>(v.size() - 1, m_onnxSamples);
+    float *vtmp = input + m * m_onnxSamples;
     for (int k = 0; k < nsamples; k++)
     {
-      vtmp.push_back(v.at(k) / 1000.0);
+      vtmp[k] = v.at(k) / 1000.0;
     }
-    std::vector<float> val = onnxInference(onnxmodule, vtmp, 1, 31, 3);
+    std::fill(vtmp + std::max(nsamples, 0), vtmp + m_onnxSamples, 0);
+  }
+  const std::vector<float> &output = m_onnxBatch->run(nchnls);
+  std::vector<std::vector<float>> fit_values(nchnls);
+  for (int m = 0; m < nchnls; m++)
+  {
+    std::vector<float> &val = fit_values.at(m);
+    val.assign(output.begin() + m * m_onnxReturn, output.begin() + (m + 1) * m_onnxReturn);
     int nvals = val.size();
     for (int i = 0; i < nvals; i++)
     {
@@ -109,8 +151,6 @@ std::vector<std::vector<float>> CaloWaveformProcessing::calo_processing_ONNX(std
         val.at(i) = val.at(i) * 1000;
       }
     }
-    fit_values.push_back(val);
-    val.clear();
   }
   return fit_values;
 }
@@ -7,6 +7,7 @@
 #include <vector>
 
 class CaloWaveformFitting;
+class onnxBatch;
 
 class CaloWaveformProcessing : public SubsysReco
 {
@@ -68,23 +69,38 @@ class CaloWaveformProcessing : public SubsysReco
     return;
   }
 
+  //! run the ONNX model on the gpu if available
+  void set_onnx_cuda(bool usecuda)
+  {
+    m_onnxUseCuda = usecuda;
+  }
+
   void set_bitFlipRecovery(bool dobitfliprecovery) {
     _dobitfliprecovery = dobitfliprecovery;
   }
 
-  std::vector<std::vector<float>> process_waveform(std::vector<std::vector<float>> waveformvector);
-  std::vector<std::vector<float>> calo_processing_ONNX(std::vector<std::vector<float>> chnlvector);
+  //! use the batched closed form template fit instead of a TF1 fit per channel
+  void set_fastTemplateFit(bool dofasttemplatefit)
+  {
+    m_fastTemplateFit = dofasttemplatefit;
+  }
+
+  std::vector<std::vector<float>> process_waveform(const std::vector<std::vector<float>> &waveformvector);
+  std::vector<std::vector<float>> calo_processing_ONNX(const std::vector<std::vector<float>> &chnlvector);
 
   void initialize_processing();
 
  private:
   CaloWaveformFitting *m_Fitter = nullptr;
+  onnxBatch *m_onnxBatch = nullptr;
 
   CaloWaveformProcessing::process m_processingtype = CaloWaveformProcessing::TEMPLATE;
   int _nthreads = 1;
   int _nsoftwarezerosuppression = 40;
   bool _bdosoftwarezerosuppression = false;
   bool _dobitfliprecovery = false;
+  bool m_fastTemplateFit = false;
+  bool m_onnxUseCuda = false;
 
   std::string m_template_input_file;
   std::string url_template;
@@ -95,6 +111,8 @@ class CaloWaveformProcessing : public SubsysReco
   float m_timeLim_high{4.0};
 
   std::string url_onnx;
+  int m_onnxSamples = 31;
+  int m_onnxReturn = 3;
   std::string m_model_name = "CEMC_ONNX";
 };
 #endif
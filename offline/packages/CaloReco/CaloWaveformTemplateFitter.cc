@@ -0,0 +1,202 @@
+#include "CaloWaveformTemplateFitter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+  //! number of waveforms fitted together, the innermost loops run over them
+  constexpr int kBlock = 16;
+}  // namespace
+
+void CaloWaveformTemplateFitter::set_template(const std::vector<float> &values, const double first, const double step)
+{
+  m_Values.assign(values.begin(), values.end());
+  m_First = first;
+  m_InvStep = 1. / step;
+}
+
+double CaloWaveformTemplateFitter::value(const double x) const
+{
+  const double u = (x - m_First) * m_InvStep;
+  if (u <= 0)
+  {
+    return m_Values.front();
+  }
+  const double last = m_Values.size() - 1;
+  if (u >= last)
+  {
+    return m_Values.back();
+  }
+  const size_t i = static_cast<size_t>(u);
+  const double f = u - i;
+  return m_Values[i] + f * (m_Values[i + 1] - m_Values[i]);
+}
+
+CaloWaveformTemplateFitter::Result CaloWaveformTemplateFitter::fit_at(const float *waveform, const int nsamples, const double time) const
+{
+  std::vector<double> tmpl(nsamples);
+  double tmean = 0;
+  double ymean = 0;
+  for (int s = 0; s < nsamples; s++)
+  {
+    tmpl[s] = value(s - time);
+    tmean += tmpl[s];
+    ymean += waveform[s];
+  }
+  tmean /= nsamples;
+  ymean /= nsamples;
+  double stt = 0;
+  double sty = 0;
+  for (int s = 0; s < nsamples; s++)
+  {
+    stt += (tmpl[s] - tmean) * (tmpl[s] - tmean);
+    sty += (tmpl[s] - tmean) * (waveform[s] - ymean);
+  }
+  const double amplitude = (stt > 0) ? sty / stt : 0;
+  const double pedestal = ymean - amplitude * tmean;
+  double chi2 = 0;
+  for (int s = 0; s < nsamples; s++)
+  {
+    const double r = waveform[s] - amplitude * tmpl[s] - pedestal;
+    chi2 += r * r;
+  }
+  Result res;
+  res.amplitude = amplitude;
+  res.time = time;
+  res.pedestal = pedestal;
+  res.chi2 = chi2;
+  return res;
+}
+
+void CaloWaveformTemplateFitter::fit(const std::vector<const float *> &waveforms, const int nsamples, const double time_low, const double time_high, std::vector<Result> &results) const
+{
+  const int nwaveforms = waveforms.size();
+  Result invalid;
+  invalid.time = std::numeric_limits<float>::quiet_NaN();
+  invalid.chi2 = std::numeric_limits<float>::quiet_NaN();
+  results.assign(nwaveforms, invalid);
+  if (!is_valid() || nsamples < 3 || nwaveforms == 0)
+  {
+    return;
+  }
+
+  // time grid and mean subtracted template values, shared by all waveforms
+  std::vector<double> times;
+  const int nsteps = std::max(0, static_cast<int>(std::floor((time_high - time_low) / m_ScanStep)));
+  for (int k = 0; k <= nsteps; k++)
+  {
+    times.push_back(time_low + k * m_ScanStep);
+  }
+  if (time_high > times.back() + 1e-6)
+  {
+    times.push_back(time_high);
+  }
+  const int ntimes = times.size();
+  std::vector<double> grid(ntimes * nsamples);
+  std::vector<double> grid_var(ntimes);
+  for (int k = 0; k < ntimes; k++)
+  {
+    double *row = &grid[k * nsamples];
+    double mean = 0;
+    for (int s = 0; s < nsamples; s++)
+    {
+      row[s] = value(s - times[k]);
+      mean += row[s];
+    }
+    mean /= nsamples;
+    double var = 0;
+    for (int s = 0; s < nsamples; s++)
+    {
+      row[s] -= mean;
+      var += row[s] * row[s];
+    }
+    grid_var[k] = var;
+  }
+
+  // mean subtracted samples of a block, sample major so the waveform loops are contiguous
+  std::vector<double> y(nsamples * kBlock);
+  std::vector<double> chi2(ntimes * kBlock);
+  for (int first = 0; first < nwaveforms; first += kBlock)
+  {
+    const int nblock = std::min(kBlock, nwaveforms - first);
+    double yvar[kBlock] = {0};
+    for (int c = 0; c < kBlock; c++)
+    {
+      double mean = 0;
+      if (c < nblock)
+      {
+        for (int s = 0; s < nsamples; s++)
+        {
+          mean += waveforms[first + c][s];
+        }
+        mean /= nsamples;
+      }
+      for (int s = 0; s < nsamples; s++)
+      {
+        y[s * kBlock + c] = (c < nblock) ? waveforms[first + c][s] - mean : 0;
+        yvar[c] += y[s * kBlock + c] * y[s * kBlock + c];
+      }
+    }
+
+    // chi2 at all grid points: yvar - sty^2 / var for the best amplitude at this time
+    for (int k = 0; k < ntimes; k++)
+    {
+      const double *row = &grid[k * nsamples];
+      double sty[kBlock] = {0};
+      for (int s = 0; s < nsamples; s++)
+      {
+        const double t = row[s];
+        const double *ys = &y[s * kBlock];
+        for (int c = 0; c < kBlock; c++)
+        {
+          sty[c] += t * ys[c];
+        }
+      }
+      const double inv_var = (grid_var[k] > 0) ? 1. / grid_var[k] : 0;
+      double *chi2k = &chi2[k * kBlock];
+      for (int c = 0; c < kBlock; c++)
+      {
+        chi2k[c] = yvar[c] - sty[c] * sty[c] * inv_var;
+      }
+    }
+
+    for (int c = 0; c < nblock; c++)
+    {
+      int best = 0;
+      for (int k = 1; k < ntimes; k++)
+      {
+        if (chi2[k * kBlock + c] < chi2[best * kBlock + c])
+        {
+          best = k;
+        }
+      }
+      const float *waveform = waveforms[first + c];
+      Result res = fit_at(waveform, nsamples, times[best]);
+
+      // vertex of the parabola through the best grid point and its neighbours
+      if (best > 0 && best < ntimes - 1)
+      {
+        const double t0 = times[best - 1];
+        const double t1 = times[best];
+        const double t2 = times[best + 1];
+        const double c0 = chi2[(best - 1) * kBlock + c];
+        const double c1 = chi2[best * kBlock + c];
+        const double c2 = chi2[(best + 1) * kBlock + c];
+        const double num = (t1 - t0) * (t1 - t0) * (c1 - c2) - (t1 - t2) * (t1 - t2) * (c1 - c0);
+        const double den = (t1 - t0) * (c1 - c2) - (t1 - t2) * (c1 - c0);
+        if (den != 0)
+        {
+          const double tref = std::clamp(t1 - 0.5 * num / den, t0, t2);
+          Result refined = fit_at(waveform, nsamples, tref);
+          if (refined.chi2 < res.chi2)
+          {
+            res = refined;
+          }
+        }
+      }
+      results[first + c] = res;
+    }
+  }
+}
@@ -0,0 +1,58 @@
+#ifndef CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+#define CALORECO_CALOWAVEFORMTEMPLATEFITTER_H
+
+#include <vector>
+
+//! batched fit of amplitude, time and pedestal of waveforms to a fixed template
+/*!
+  The model is y(i) = amplitude * template(i - time) + pedestal with unit errors,
+  the same as the TF1 based fit in CaloWaveformFitting.
+
+  For a given time amplitude and pedestal follow from a linear least squares fit
+  in closed form. The chi2 is scanned on a fine time grid within the limits, the
+  template values of the grid are shared by all waveforms so the scan of a block of
+  waveforms is a matrix product which the compiler vectorizes over the waveforms.
+  The best grid point is refined by a parabola through its neighbours.
+
+  fit() is const and can be called concurrently.
+*/
+class CaloWaveformTemplateFitter
+{
+ public:
+  struct Result
+  {
+    float amplitude{0};
+    float time{0};
+    float pedestal{0};
+    float chi2{0};  // sum of squared residuals, not divided by the degrees of freedom
+  };
+
+  CaloWaveformTemplateFitter() = default;
+  virtual ~CaloWaveformTemplateFitter() = default;
+
+  //! template values at equidistant points first, first + step, ...
+  //! linear interpolation in between, constant outside (same as TH1::Interpolate)
+  void set_template(const std::vector<float> &values, const double first, const double step);
+
+  //! step of the time scan in samples
+  void set_scan_step(const double step) { m_ScanStep = step; }
+
+  bool is_valid() const { return m_Values.size() > 1; }
+
+  //! fit nsamples samples of each waveform, time within [time_low, time_high]
+  void fit(const std::vector<const float *> &waveforms, const int nsamples, const double time_low, const double time_high, std::vector<Result> &results) const;
+
+  //! template value at x
+  double value(const double x) const;
+
+ private:
+  //! closed form fit at fixed time
+  Result fit_at(const float *waveform, const int nsamples, const double time) const;
+
+  std::vector<double> m_Values;
+  double m_First{0};
+  double m_InvStep{1};
+  double m_ScanStep{0.05};
+};
+
+#endif
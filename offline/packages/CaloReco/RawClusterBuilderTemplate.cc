@@ -30,6 +30,7 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -42,6 +43,34 @@
 #include <utility>
 #include <vector>
 
+namespace
+{
+  // a subcluster (peak area) above the cluster energy cut
+  class SubCluster
+  {
+   public:
+    const EmcCluster *peakarea{nullptr};
+    float ecl{0};
+    float ecore{0};
+    float xg{0};
+    float yg{0};
+    float zg{0};
+    float prob{0};
+    float chi2{0};
+    int ndf{0};
+  };
+
+  // the peak areas of one cluster, filled on the pool threads
+  class ClusterSplit
+  {
+   public:
+    int npk{0};
+    std::vector<EmcCluster> peakareas;
+    std::vector<EmcModule> peaks;
+    std::vector<SubCluster> subclusters;
+  };
+}  // namespace
+
 RawClusterBuilderTemplate::RawClusterBuilderTemplate(const std::string &name)
   : SubsysReco(name)
 {
@@ -223,6 +252,15 @@ int RawClusterBuilderTemplate::InitRun(PHCompositeNode *topNode)
     //    PrintCylGeom(towergeom,"phieta.txt");
   }
 
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "RawClusterBuilderTemplate::InitRun - splitting clusters with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -448,110 +486,91 @@ int RawClusterBuilderTemplate::process_event(PHCompositeNode *topNode)
 
   // Get pointer to clusters
   std::vector<EmcCluster> *ClusterList = bemc->GetClusters();
-  std::vector<EmcCluster>::iterator pc;
-
-  std::vector<EmcCluster>::iterator pp;
-  float ecl, ecore, xcg, ycg, xx, xy, yy;
-  //  float xcorr, ycorr;
-  EmcModule hmax;
-  RawCluster *cluster;
 
-  std::vector<EmcCluster> PList;
-  std::vector<EmcModule> Peaks;
-
-  float prob, chi2;
-  int ndf;
-  float xg, yg, zg;
-
-  std::vector<EmcModule>::iterator ph;
-  std::vector<EmcModule> hlist;
-
-  // ncl = 0;
-  for (pc = ClusterList->begin(); pc != ClusterList->end(); ++pc)
+  // The clusters are split into peak areas independently (in parallel if
+  // there is a thread pool), the RawClusters are made in cluster order
+  std::vector<ClusterSplit> splits(ClusterList->size());
+  auto split_cluster = [this, ClusterList, &splits](size_t icl)
   {
-    //    ecl = pc->GetTotalEnergy();
-    //    pc->GetMoments( &xcg, &ycg, &xx, &xy, &yy );
-
-    int npk = pc->GetSubClusters(PList, Peaks);
-    if (npk < 0)
+    ClusterSplit &split = splits[icl];
+    split.npk = (*ClusterList)[icl].GetSubClusters(split.peakareas, split.peaks);
+    if (split.npk < 0)
     {
-      return Fun4AllReturnCodes::ABORTEVENT;
+      return;
     }
-
-    //    std::cout << "  iCl = " << ncl << " (" << npk << "): E ="
-    //         << ecl << "  x = " << xcg << "  y = " << ycg << std::endl;
-
-    for (pp = PList.begin(); pp != PList.end(); ++pp)
+    for (auto &pp : split.peakareas)
     {
+      SubCluster subcluster;
+      subcluster.peakarea = &pp;
       // Cluster energy
-      ecl = pp->GetTotalEnergy();
-      if (ecl < m_min_cluster_e)
+      subcluster.ecl = pp.GetTotalEnergy();
+      if (subcluster.ecl < m_min_cluster_e)
       {
         continue;
       }
-      ecore = pp->GetECoreCorrected();
-      // 3x3 energy around center of gravity
-      // e9 = pp->GetE9();
-      // Ecore (basically near 2x2 energy around center of gravity)
-      // ecore = pp->GetECore();
-      // Center of Gravity etc.
-      pp->GetMoments(xcg, ycg, xx, xy, yy);
+      subcluster.ecore = pp.GetECoreCorrected();
 
       if (m_UseAltZVertex == 2)
       {
-        xg = -99999;  // signal to force zvtx = 0
-        pp->GetGlobalPos(xg, yg, zg);
+        subcluster.xg = -99999;  // signal to force zvtx = 0
       }
       else
       {
-        xg = 0;  // usual mode, uses regular zvtx
-        pp->GetGlobalPos(xg, yg, zg);
+        subcluster.xg = 0;  // usual mode, uses regular zvtx
       }
+      pp.GetGlobalPos(subcluster.xg, subcluster.yg, subcluster.zg);
 
-      // Tower with max energy
-      hmax = pp->GetMaxTower();
-
-      //      phi = (xcg-float(NPHI)/2.+0.5)/float(NPHI)*2.*M_PI;
-      //      eta = (ycg-float(NETA)/2.+0.5)/float(NETA)*2.2; // -1.1<eta<1.1;
-
-      //      Cell2Abs(towergeom,xcg,ycg,phi,eta);
-
-      //      pp->GetCorrPos(&xcorr, &ycorr);
-      //      Cell2Abs(towergeom, xcorr, ycorr, phi, eta);
-      //      const double ref_radius = towergeom->get_radius();
+      subcluster.chi2 = 0;
+      subcluster.ndf = 0;
+      subcluster.prob = pp.GetProb(subcluster.chi2, subcluster.ndf);
+      split.subclusters.push_back(subcluster);
+    }
+  };
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(splits.size(), split_cluster);
+  }
+  else
+  {
+    for (size_t icl = 0; icl < splits.size(); ++icl)
+    {
+      split_cluster(icl);
+    }
+  }
 
-      //      phi = 0;
-      //      if (phi > M_PI) phi -= 2. * M_PI;  // convert to [-pi,pi]]
+  const RawTowerDefs::CalorimeterId Calo_ID = towergeom->get_calorimeter_id();
+  for (auto &split : splits)
+  {
+    if (split.npk < 0)
+    {
+      return Fun4AllReturnCodes::ABORTEVENT;
+    }
 
-      //      prob = -1;
-      chi2 = 0;
-      ndf = 0;
-      prob = pp->GetProb(chi2, ndf);
+    for (auto &subcluster : split.subclusters)
+    {
       //      std::cout << "Prob/Chi2/NDF = " << prob << " " << chi2
       //           << " " << ndf << " Ecl = " << ecl << std::endl;
 
-      cluster = new RawClusterv1();
-      cluster->set_energy(ecl);
-      cluster->set_ecore(ecore);
+      RawCluster *cluster = new RawClusterv1();
+      cluster->set_energy(subcluster.ecl);
+      cluster->set_ecore(subcluster.ecore);
 
-      cluster->set_r(std::sqrt(xg * xg + yg * yg));
-      cluster->set_phi(std::atan2(yg, xg));
-      cluster->set_z(zg);
+      cluster->set_r(std::sqrt(subcluster.xg * subcluster.xg + subcluster.yg * subcluster.yg));
+      cluster->set_phi(std::atan2(subcluster.yg, subcluster.xg));
+      cluster->set_z(subcluster.zg);
 
-      cluster->set_prob(prob);
-      if (ndf > 0)
+      cluster->set_prob(subcluster.prob);
+      if (subcluster.ndf > 0)
       {
-        cluster->set_chi2(chi2 / ndf);
+        cluster->set_chi2(subcluster.chi2 / subcluster.ndf);
       }
       else
       {
         cluster->set_chi2(0);
       }
-      hlist = pp->GetHitList();
-      ph = hlist.begin();
-      while (ph != hlist.end())
+      for (const auto &hit : subcluster.peakarea->GetHitList())
       {
-        ich = (*ph).ich;
+        ich = hit.ich;
         int iy = ich / NBINX;
         int ix = ich % NBINX;
         // that code needs a closer look - here are the towers
@@ -559,21 +578,13 @@ int RawClusterBuilderTemplate::process_event(PHCompositeNode *topNode)
         // the id is the tower id
         // !!!!! Make sure twrkey is correctly extracted
         //        RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(towers->getCalorimeterID(), ix + BINX0, iy + BINY0);
-        const RawTowerDefs::CalorimeterId Calo_ID = towergeom->get_calorimeter_id();
         RawTowerDefs::keytype twrkey = RawTowerDefs::encode_towerid(Calo_ID, iy + BINY0, ix + BINX0);  // Becuase in this part index1 is iy
         //	std::cout << iphi << " " << ieta << ": "
         //           << twrkey << " e = " << (*ph).amp) << std::endl;
-        cluster->addTower(twrkey, (*ph).amp / fEnergyNorm);
-        ++ph;
+        cluster->addTower(twrkey, hit.amp / fEnergyNorm);
       }
 
       _clusters->AddCluster(cluster);
-      // ncl++;
-
-      //      std::cout << "    ipk = " << ipk << ": E = " << ecl << "  E9 = "
-      //           << e9 << "  x = " << xcg << "  y = " << ycg
-      //           << "  MaxTower: (" << hmax.ich%NPHI << ","
-      //           << hmax.ich/NPHI << ") e = " << hmax.amp << std::endl;
     }
   }
 
@@ -3,9 +3,11 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <memory>
 #include <string>
 
 class PHCompositeNode;
+class PHThreadPool;
 class RawClusterContainer;
 class RawTowerGeomContainer;
 class BEmcRec;
@@ -63,6 +65,9 @@ class RawClusterBuilderTemplate : public SubsysReco
 
    void set_min_cluster_E_saved(float min_cluster_E) { m_min_cluster_e = min_cluster_E; }
 
+  //! split the clusters into peak areas on nthreads threads, 0 uses all cores, 1 (default) runs serially
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   
 
  private:
@@ -107,6 +112,9 @@ class RawClusterBuilderTemplate : public SubsysReco
 
   std::string m_inputnodename;
   std::string m_outputnodename;
+
+  unsigned int m_nthreads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif /* RawClusterBuilderTemplate_H__ */
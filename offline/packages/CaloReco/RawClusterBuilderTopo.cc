@@ -195,6 +195,24 @@ std::vector<int> RawClusterBuilderTopo::get_adjacent_towers_by_ID(int ID)
   return adjacent_towers;
 }
 
+void RawClusterBuilderTopo::build_neighbor_table()
+{
+  int n_towers = get_EMCal_ID_offset() + _EMCAL_NETA * _EMCAL_NPHI;
+  _NEIGHBOR_OFFSET.assign(1, 0);
+  _NEIGHBOR_OFFSET.reserve(n_towers + 1);
+  _NEIGHBOR_IDS.clear();
+  for (int ID = 0; ID < n_towers; ID++)
+  {
+    std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(ID);
+    _NEIGHBOR_IDS.insert(_NEIGHBOR_IDS.end(), adjacent_tower_IDs.begin(), adjacent_tower_IDs.end());
+    _NEIGHBOR_OFFSET.push_back(_NEIGHBOR_IDS.size());
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "RawClusterBuilderTopo::build_neighbor_table: " << _NEIGHBOR_IDS.size() << " neighbors for " << n_towers << " towers" << std::endl;
+  }
+}
+
 void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &original_towers)
 {
   if (Verbosity() > 2)
@@ -202,17 +220,18 @@ void RawClusterBuilderTopo::export_single_cluster(const std::vector<int> &origin
     std::cout << "RawClusterBuilderTopo::export_single_cluster called " << std::endl;
   }
 
-  std::map<int, std::pair<int, int> > tower_ownership;
+  std::vector<std::pair<int, int> > &tower_ownership = _TOWERMAP_OWNERSHIP_ID;
   for (const int &original_tower : original_towers)
   {
     tower_ownership[original_tower] = std::pair<int, int>(0, -1);  // all towers owned by cluster 0
   }
-  export_clusters(original_towers, tower_ownership, 1, std::vector<float>(), std::vector<float>(), std::vector<float>());
+  const std::vector<float> empty;
+  export_clusters(original_towers, tower_ownership, 1, empty, empty, empty);
 
   return;
 }
 
-void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, std::map<int, std::pair<int, int> > tower_ownership, unsigned int n_clusters, std::vector<float> pseudocluster_sumE, std::vector<float> pseudocluster_eta, std::vector<float> pseudocluster_phi)
+void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_towers, const std::vector<std::pair<int, int> > &tower_ownership, unsigned int n_clusters, const std::vector<float> &pseudocluster_sumE, const std::vector<float> &pseudocluster_eta, const std::vector<float> &pseudocluster_phi)
 {
   if (n_clusters != 1)  // if we didn't just pass down from export_single_cluster
   {
@@ -242,26 +261,16 @@ void RawClusterBuilderTopo::export_clusters(const std::vector<int> &original_tow
   for (int original_tower : original_towers)
   {
     int this_ID = original_tower;
-    std::pair<int, int> the_pair = tower_ownership[this_ID];
+    const std::pair<int, int> &the_pair = tower_ownership[this_ID];
 
     if (Verbosity() > 5)
     {
       std::cout << "RawClusterBuilderTopo::export_clusters -> assigning tower " << original_tower << " with ownership ( " << the_pair.first << ", " << the_pair.second << " ) " << std::endl;
     }
-    int this_ieta = get_ieta_from_ID(this_ID);
-    int this_iphi = get_iphi_from_ID(this_ID);
     int this_layer = get_ilayer_from_ID(this_ID);
     float this_E = get_E_from_ID(this_ID);
 
-    int this_key = 0;
-    if (this_layer == 2)
-    {
-      this_key = _EMTOWERMAP_KEY_ETA_PHI[this_ieta][this_iphi];
-    }
-    else
-    {
-      this_key = _TOWERMAP_KEY_LAYER_ETA_PHI[this_layer][this_ieta][this_iphi];
-    }
+    int this_key = _TOWERMAP_KEY_ID[this_ID];
 
     RawTowerGeom *tower_geom = _geom_containers[this_layer]->get_tower_geometry(this_key);
 
@@ -462,10 +471,6 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // define geometry only once if it has not been yet
     _EMCAL_NETA = _geom_containers[2]->get_etabins();
     _EMCAL_NPHI = _geom_containers[2]->get_phibins();
-
-    _EMTOWERMAP_STATUS_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, -2));
-    _EMTOWERMAP_KEY_ETA_PHI.resize(_EMCAL_NETA, std::vector<int>(_EMCAL_NPHI, 0));
-    _EMTOWERMAP_E_ETA_PHI.resize(_EMCAL_NETA, std::vector<float>(_EMCAL_NPHI, 0));
   }
 
   if (_HCAL_NETA < 0)
@@ -473,33 +478,22 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // define geometry only once if it has not been yet
     _HCAL_NETA = _geom_containers[1]->get_etabins();
     _HCAL_NPHI = _geom_containers[1]->get_phibins();
+  }
 
-    _TOWERMAP_STATUS_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, -2)));
-    _TOWERMAP_KEY_LAYER_ETA_PHI.resize(2, std::vector<std::vector<int> >(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0)));
-    _TOWERMAP_E_LAYER_ETA_PHI.resize(2, std::vector<std::vector<float> >(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0)));
+  if (_TOWERMAP_E_ID.empty())
+  {
+    int n_towers = get_EMCal_ID_offset() + _EMCAL_NETA * _EMCAL_NPHI;
+    _TOWERMAP_STATUS_ID.resize(n_towers, -2);
+    _TOWERMAP_KEY_ID.resize(n_towers, 0);
+    _TOWERMAP_E_ID.resize(n_towers, 0);
+    _TOWERMAP_OWNERSHIP_ID.resize(n_towers, std::pair<int, int>(-1, -1));
+    build_neighbor_table();
   }
 
   // reset maps
   // but note -- do not reset keys!
-  for (int ieta = 0; ieta < _EMCAL_NETA; ieta++)
-  {
-    for (int iphi = 0; iphi < _EMCAL_NPHI; iphi++)
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -2;  // set tower does not exist
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = 0;        // set zero energy
-    }
-  }
-  for (int ilayer = 0; ilayer < 2; ilayer++)
-  {
-    for (int ieta = 0; ieta < _HCAL_NETA; ieta++)
-    {
-      for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-      {
-        _TOWERMAP_STATUS_LAYER_ETA_PHI[ilayer][ieta][iphi] = -2;  // set tower does not exist
-        _TOWERMAP_E_LAYER_ETA_PHI[ilayer][ieta][iphi] = 0;        // set zero energy
-      }
-    }
-  }
+  std::fill(_TOWERMAP_STATUS_ID.begin(), _TOWERMAP_STATUS_ID.end(), -2);  // set tower does not exist
+  std::fill(_TOWERMAP_E_ID.begin(), _TOWERMAP_E_ID.end(), 0);             // set zero energy
 
   // setup
   std::vector<std::pair<int, float> > list_of_seeds;
@@ -532,14 +526,14 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _EMTOWERMAP_STATUS_ETA_PHI[ieta][iphi] = -1;  // change status to unknown
-      _EMTOWERMAP_E_ETA_PHI[ieta][iphi] = this_E;
-      _EMTOWERMAP_KEY_ETA_PHI[ieta][iphi] = key;
+      int ID = get_ID(2, ieta, iphi);
+      _TOWERMAP_STATUS_ID[ID] = -1;  // change status to unknown
+      _TOWERMAP_E_ID[ID] = this_E;
+      _TOWERMAP_KEY_ID[ID] = key;
 
       // use fabs() here for simplicity - if we're not using abs E, negative towers are already excluded
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[2])
       {
-        int ID = get_ID(2, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -577,13 +571,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[0][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[0][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[0][ieta][iphi] = key;
+      int ID = get_ID(0, ieta, iphi);
+      _TOWERMAP_STATUS_ID[ID] = -1;  // change status to unknown
+      _TOWERMAP_E_ID[ID] = this_E;
+      _TOWERMAP_KEY_ID[ID] = key;
 
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[0])
       {
-        int ID = get_ID(0, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -616,13 +610,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[1][ieta][iphi] = -1;  // change status to unknown
-      _TOWERMAP_E_LAYER_ETA_PHI[1][ieta][iphi] = this_E;
-      _TOWERMAP_KEY_LAYER_ETA_PHI[1][ieta][iphi] = key;
+      int ID = get_ID(1, ieta, iphi);
+      _TOWERMAP_STATUS_ID[ID] = -1;  // change status to unknown
+      _TOWERMAP_E_ID[ID] = this_E;
+      _TOWERMAP_KEY_ID[ID] = key;
 
       if (std::fabs(this_E) >= _sigma_seed * _noise_LAYER[1])
       {
-        int ID = get_ID(1, ieta, iphi);
         list_of_seeds.emplace_back(ID, this_E);
         if (Verbosity() > 10)
         {
@@ -660,14 +654,13 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
   std::vector<std::vector<int> > all_cluster_towers;  // store final cluster tower lists here
 
-  while (list_of_seeds.size() > 0)
+  for (unsigned int iseed = 0; iseed < list_of_seeds.size(); iseed++)
   {
-    int seed_ID = list_of_seeds.at(0).first;
-    list_of_seeds.erase(list_of_seeds.begin());
+    int seed_ID = list_of_seeds.at(iseed).first;
 
     if (Verbosity() > 5)
     {
-      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() << std::endl;
+      std::cout << " RawClusterBuilderTopo::process_event: in seeded loop, current seed has ID = " << seed_ID << " , length of remaining seed vector = " << list_of_seeds.size() - iseed - 1 << std::endl;
     }
 
     // if this seed was already claimed by some other seed during its growth, remove it and do nothing
@@ -697,17 +690,17 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << " RawClusterBuilderTopo::process_event: Entering Growth stage for cluster " << cluster_index << std::endl;
     }
 
-    while (grow_tower_ID.size() > 0)
+    // breadth first growth, grow_tower_ID is used as a queue
+    for (unsigned int igrow = 0; igrow < grow_tower_ID.size(); igrow++)
     {
-      int grow_ID = grow_tower_ID.at(0);
-      grow_tower_ID.erase(grow_tower_ID.begin());
+      int grow_ID = grow_tower_ID.at(igrow);
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() << " grow towers left" << std::endl;
+        std::cout << " --> cluster " << cluster_index << ", growth stage, examining neighbors of ID " << grow_ID << ", " << grow_tower_ID.size() - igrow - 1 << " grow towers left" << std::endl;
       }
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(grow_ID);
+      NeighborRange adjacent_tower_IDs = get_neighbors(grow_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -769,7 +762,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
 
       if (Verbosity() > 5)
       {
-        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
+        std::cout << " --> after examining neighbors, grow list is now " << grow_tower_ID.size() - igrow - 1 << ", # of towers in cluster = " << cluster_tower_ID.size() << std::endl;
       }
     }
 
@@ -789,7 +782,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       {
         std::cout << " --> cluster " << cluster_index << ", perimeter stage, examining neighbors of ID " << core_ID << ", core cluster # " << ic << " of " << n_core_towers << " total " << std::endl;
       }
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(core_ID);
+      NeighborRange adjacent_tower_IDs = get_neighbors(core_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -897,7 +890,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       }
 
       // examine neighbors
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(tower_ID);
+      NeighborRange adjacent_tower_IDs = get_neighbors(tower_ID);
       int neighbors_in_cluster = 0;
 
       // check for higher neighbor
@@ -1044,7 +1037,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     // -1 means unseen
     // -2 means seen and in the seed list now (e.g. don't add it to the seed list again)
     // -3 shared tower, ignore going forward...
-    std::map<int, std::pair<int, int> > tower_ownership;
+    std::vector<std::pair<int, int> > &tower_ownership = _TOWERMAP_OWNERSHIP_ID;
     for (int &original_tower : original_towers)
     {
       tower_ownership[original_tower] = std::pair<int, int>(-1, -1);  // initialize all towers as un-seen
@@ -1075,6 +1068,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
     }
 
     bool first_pass = true;
+    std::vector<char> pseudocluster_adjacency;
 
     do
     {
@@ -1103,13 +1097,9 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         }
         else
         {
-          std::map<int, bool> pseudocluster_adjacency;
-          for (unsigned int s = 0; s < local_maxima_ID.size(); s++)
-          {
-            pseudocluster_adjacency[s] = false;
-          }
+          pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
           // look over all towers THIS one is adjacent to, and count up...
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          NeighborRange adjacent_tower_IDs = get_neighbors(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1205,7 +1195,7 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
         int neighbor_ID = neighbor_list.at(n);
         if (new_ownerships.at(n) > -1)
         {
-          std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(neighbor_ID);
+          NeighborRange adjacent_tower_IDs = get_neighbors(neighbor_ID);
 
           for (int this_adjacent_tower_ID : adjacent_tower_IDs)
           {
@@ -1321,21 +1311,19 @@ int RawClusterBuilderTopo::process_event(PHCompositeNode *topNode)
       std::cout << "RawClusterBuilderTopo::process_event now splitting up shared clusters (including unassigned clusters), initial shared list has size " << shared_list.size() << std::endl;
     }
     // iterate through shared cells, identifying which two they belong to
-    while (shared_list.size() > 0)
+    for (unsigned int ishared = 0; ishared < shared_list.size(); ishared++)
     {
-      // pick the first cell and pop off list
-      int shared_ID = shared_list.at(0);
-      shared_list.erase(shared_list.begin());
+      // pick the next cell, shared_list is used as a queue
+      int shared_ID = shared_list.at(ishared);
 
       if (Verbosity() > 5)
       {
-        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() << " shared towers left " << std::endl;
+        std::cout << " -> looking at shared tower " << shared_ID << ", after this one there are " << shared_list.size() - ishared - 1 << " shared towers left " << std::endl;
       }
       // look through adjacent pseudoclusters, taking two with highest energies
-      std::vector<bool> pseudocluster_adjacency;
-      pseudocluster_adjacency.resize(local_maxima_ID.size(), false);
+      pseudocluster_adjacency.assign(local_maxima_ID.size(), false);
 
-      std::vector<int> adjacent_tower_IDs = get_adjacent_towers_by_ID(shared_ID);
+      NeighborRange adjacent_tower_IDs = get_neighbors(shared_ID);
 
       for (int this_adjacent_tower_ID : adjacent_tower_IDs)
       {
@@ -9,7 +9,6 @@
 
 #include <fun4all/SubsysReco.h>
 
-#include <map>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
@@ -100,13 +99,18 @@ class RawClusterBuilderTopo : public SubsysReco
  private:
   void CreateNodes(PHCompositeNode *topNode);
 
-  std::vector<std::vector<std::vector<float> > > _TOWERMAP_E_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_KEY_LAYER_ETA_PHI;
-  std::vector<std::vector<std::vector<int> > > _TOWERMAP_STATUS_LAYER_ETA_PHI;
+  // tower energy, key and status of all layers, indexed by tower ID
+  std::vector<float> _TOWERMAP_E_ID;
+  std::vector<int> _TOWERMAP_KEY_ID;
+  std::vector<int> _TOWERMAP_STATUS_ID;
 
-  std::vector<std::vector<float> > _EMTOWERMAP_E_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_KEY_ETA_PHI;
-  std::vector<std::vector<int> > _EMTOWERMAP_STATUS_ETA_PHI;
+  // ownership of the towers of the cluster being split, indexed by tower ID
+  std::vector<std::pair<int, int> > _TOWERMAP_OWNERSHIP_ID;
+
+  // neighbor table built once per geometry (compressed rows):
+  // the neighbors of tower ID are _NEIGHBOR_IDS[_NEIGHBOR_OFFSET[ID] ... _NEIGHBOR_OFFSET[ID + 1] - 1]
+  std::vector<int> _NEIGHBOR_OFFSET;
+  std::vector<int> _NEIGHBOR_IDS;
 
   // geometric constants to express IHCal<->EMCal overlap in eta
   static int RawClusterBuilderTopo_constants_EMCal_eta_start_given_IHCal[];
@@ -135,24 +139,46 @@ class RawClusterBuilderTopo : public SubsysReco
 
   std::vector<int> get_adjacent_towers_by_ID(int ID);
 
+  // fills the neighbor table from get_adjacent_towers_by_ID, keeping its order
+  void build_neighbor_table();
+
+  struct NeighborRange
+  {
+    const int *first;
+    const int *last;
+    const int *begin() const { return first; }
+    const int *end() const { return last; }
+  };
+
+  NeighborRange get_neighbors(int ID) const
+  {
+    return {_NEIGHBOR_IDS.data() + _NEIGHBOR_OFFSET[ID], _NEIGHBOR_IDS.data() + _NEIGHBOR_OFFSET[ID + 1]};
+  }
+
   float calculate_dR(float, float, float, float);
 
   void export_single_cluster(const std::vector<int> &);
 
-  void export_clusters(const std::vector<int> &, std::map<int, std::pair<int, int> >, unsigned int, std::vector<float>, std::vector<float>, std::vector<float>);
+  void export_clusters(const std::vector<int> &, const std::vector<std::pair<int, int> > &, unsigned int, const std::vector<float> &, const std::vector<float> &, const std::vector<float> &);
+
+  // IDs of the two HCal layers come first, followed by the EMCal
+  int get_EMCal_ID_offset() const
+  {
+    return 2 * _HCAL_NETA * _HCAL_NPHI;
+  }
 
-  int get_ID(int ilayer, int ieta, int iphi)
+  int get_ID(int ilayer, int ieta, int iphi) const
   {
     if (ilayer < 2)
     {
       return ilayer * _HCAL_NETA * _HCAL_NPHI + ieta * _HCAL_NPHI + iphi;
     }
-    return _EMCAL_NPHI * _EMCAL_NETA + ieta * _EMCAL_NPHI + iphi;
+    return get_EMCal_ID_offset() + ieta * _EMCAL_NPHI + iphi;
   }
 
-  int get_ilayer_from_ID(int ID)
+  int get_ilayer_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
+    if (ID < get_EMCal_ID_offset())
     {
       return ((int) (ID / (_HCAL_NETA * _HCAL_NPHI)));
     }
@@ -162,58 +188,43 @@ class RawClusterBuilderTopo : public SubsysReco
     }
   }
 
-  int get_ieta_from_ID(int ID)
+  int get_ieta_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
+    if (ID < get_EMCal_ID_offset())
     {
       return ((int) ((ID % (_HCAL_NETA * _HCAL_NPHI)) / (_HCAL_NPHI)));
     }
     else
     {
-      return ((int) ((ID - _EMCAL_NPHI * _EMCAL_NETA) / _EMCAL_NPHI));
+      return ((int) ((ID - get_EMCal_ID_offset()) / _EMCAL_NPHI));
     }
   }
 
-  int get_iphi_from_ID(int ID)
+  int get_iphi_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
+    if (ID < get_EMCal_ID_offset())
     {
       return ((int) (ID % _HCAL_NPHI));
     }
     else
     {
-      return ((int) ((ID - _EMCAL_NPHI * _EMCAL_NETA) % _EMCAL_NPHI));
+      return ((int) ((ID - get_EMCal_ID_offset()) % _EMCAL_NPHI));
     }
   }
 
-  int get_status_from_ID(int ID)
+  int get_status_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _TOWERMAP_STATUS_ID[ID];
   }
 
-  float get_E_from_ID(int ID)
+  float get_E_from_ID(int ID) const
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      return _TOWERMAP_E_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
-    }
-    return _EMTOWERMAP_E_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)];
+    return _TOWERMAP_E_ID[ID];
   }
 
   void set_status_by_ID(int ID, int status)
   {
-    if (ID < _EMCAL_NPHI * _EMCAL_NETA)
-    {
-      _TOWERMAP_STATUS_LAYER_ETA_PHI[get_ilayer_from_ID(ID)][get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
-    else
-    {
-      _EMTOWERMAP_STATUS_ETA_PHI[get_ieta_from_ID(ID)][get_iphi_from_ID(ID)] = status;
-    }
+    _TOWERMAP_STATUS_ID[ID] = status;
   }
 
   RawClusterContainer *_clusters = nullptr;
@@ -26,6 +26,7 @@ I trained a crappy CNN to classify EMCal clusters as photon or not photon. S.Li
 #include <phool/onnxlib.h>
 #include <phool/phool.h>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -40,6 +41,7 @@ int RawClusterCNNClassifier::Init(PHCompositeNode *topNode)
 {
   // init the onnx model
   onnxmodule = onnxSession(m_modelPath);
+  m_onnxBatch = new onnxBatch(onnxmodule, {inputDimx, inputDimy, inputDimz}, outputDim);
 
   if (m_inputNodeName == m_outputNodeName)
   {
@@ -93,6 +95,9 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // the clusters are evaluated in one batch after the loop
+  int vectorSize = inputDimx * inputDimy;
+  m_batchClusters.clear();
   RawClusterContainer::Map clusterMap = _clusters->getClustersMap();
   for (auto &clusterPair : clusterMap)
   {
@@ -148,10 +153,9 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
       }
     }
     // find the N by N tower around the max tower
-    std::vector<float> input;
-    // resize to inputDimx * inputDimy
-    int vectorSize = inputDimx * inputDimy;
-    input.resize(vectorSize, 0);
+    // input of this cluster in the batch, the buffer content is kept when it grows
+    float *input = m_onnxBatch->input(m_batchClusters.size() + 1) + m_batchClusters.size() * vectorSize;
+    std::fill(input, input + vectorSize, 0);
 
     if (maxtowerE > 0)
     {
@@ -185,14 +189,18 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
             continue;
           }
           int index = (ieta - maxtowerieta + ylength) * inputDimx + iphi - maxtoweriphi + xlength;
-          input.at(index) = towerinfo->get_energy();
+          input[index] = towerinfo->get_energy();
         }
       }
     }
-    std::vector<float> prob = onnxInference(onnxmodule, input, 1, inputDimx, inputDimy, inputDimz, outputDim);
-    // std::cout << "new prob: " << prob[0] << "ET: " << ET << " original prob: " << recoCluster->get_prob() << std::endl;
+    m_batchClusters.push_back(recoCluster);
+  }
+
+  const std::vector<float> &prob = m_onnxBatch->run(m_batchClusters.size());
+  for (size_t i = 0; i < m_batchClusters.size(); ++i)
+  {
     // inplace change for the prob for now
-    recoCluster->set_prob(prob[0]);
+    m_batchClusters[i]->set_prob(prob[i * outputDim]);
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -200,6 +208,8 @@ int RawClusterCNNClassifier::process_event(PHCompositeNode *topNode)
 
 int RawClusterCNNClassifier::End(PHCompositeNode * /*topNode*/)
 {
+  delete m_onnxBatch;
+  m_onnxBatch = nullptr;
   delete onnxmodule;
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -5,7 +5,10 @@
 
 #include <phool/onnxlib.h>
 
+#include <vector>
+
 class PHCompositeNode;
+class RawCluster;
 class RawClusterContainer;
 
 class RawClusterCNNClassifier : public SubsysReco
@@ -35,6 +38,9 @@ class RawClusterCNNClassifier : public SubsysReco
 
  private:
   Ort::Session *onnxmodule{nullptr};
+  //! all clusters of an event are evaluated in one call
+  onnxBatch *m_onnxBatch{nullptr};
+  std::vector<RawCluster *> m_batchClusters;
   const int inputDimx{5};
   const int inputDimy{5};
   const int inputDimz{1};
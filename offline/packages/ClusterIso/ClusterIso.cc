@@ -27,6 +27,8 @@
 
 #include <CLHEP/Vector/ThreeVector.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <map>
 #include <utility>
@@ -221,6 +223,11 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
           }
         }
 
+        // the retowered EMCal uses the inner HCal geometry without vertex correction
+        fillConeTowers(towersEM3old, geomEM, false, m_towersEM);
+        fillConeTowers(towersIH3, geomIH, true, m_towersIH);
+        fillConeTowers(towersOH3, geomOH, true, m_towersOH);
+
         for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
         {
           RawCluster *cluster = rtiter->second;
@@ -238,79 +245,10 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
             continue;
           }  // skip if cluster is under eT cut
 
-          // calculate EMCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersEM3old->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersEM3old->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersEM3old->encode_key(channel);
-              int ieta = towersEM3old->getTowerEtaBin(towerkey);
-              int iphi = towersEM3old->getTowerPhiBin(towerkey);
-
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
-
-              RawTowerGeom *tower_geom = geomEM->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = tower_geom->get_eta();
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
-
-          // calculate Inner HCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersIH3->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersIH3->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersIH3->encode_key(channel);
-              int ieta = towersIH3->getTowerEtaBin(towerkey);
-              int iphi = towersIH3->getTowerPhiBin(towerkey);
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
-              RawTowerGeom *tower_geom = geomIH->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
-
-          // calculate Outer HCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersOH3->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersOH3->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersOH3->encode_key(channel);
-              int ieta = towersOH3->getTowerEtaBin(towerkey);
-              int iphi = towersOH3->getTowerPhiBin(towerkey);
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ieta, iphi);
-              RawTowerGeom *tower_geom = geomOH->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
+          // calculate EMCal, Inner and Outer HCal tower contributions to isolation energy
+          addConeEt(m_towersEM, cluster_eta, cluster_phi, isoEt);
+          addConeEt(m_towersIH, cluster_eta, cluster_phi, isoEt);
+          addConeEt(m_towersOH, cluster_eta, cluster_phi, isoEt);
 
           isoEt -= et;  // Subtract cluster eT from isoET
           if (Verbosity() >= VERBOSITY_EVEN_MORE)
@@ -384,6 +322,10 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
           }
         }
 
+        fillConeTowers(towersEM3old, geomEM, true, m_towersEM);
+        fillConeTowers(towersIH3, geomIH, true, m_towersIH);
+        fillConeTowers(towersOH3, geomOH, true, m_towersOH);
+
         for (rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
         {
           RawCluster *cluster = rtiter->second;
@@ -411,82 +353,19 @@ int ClusterIso::process_event(PHCompositeNode *topNode)
           }  // skip if cluster is below eT cut
 
           // calculate EMCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersEM3old->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersEM3old->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersEM3old->encode_key(channel);
-              int ieta = towersEM3old->getTowerEtaBin(towerkey);
-              int iphi = towersEM3old->getTowerPhiBin(towerkey);
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, ieta, iphi);
-              RawTowerGeom *tower_geom = geomEM->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
+          addConeEt(m_towersEM, cluster_eta, cluster_phi, isoEt);
           if (Verbosity() >= VERBOSITY_MAX)
           {
             std::cout << "\t after EMCal isoEt:" << isoEt << '\n';
           }
           // calculate Inner HCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersIH3->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersIH3->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersIH3->encode_key(channel);
-              int ieta = towersIH3->getTowerEtaBin(towerkey);
-              int iphi = towersIH3->getTowerPhiBin(towerkey);
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
-              RawTowerGeom *tower_geom = geomIH->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
+          addConeEt(m_towersIH, cluster_eta, cluster_phi, isoEt);
           if (Verbosity() >= VERBOSITY_MAX)
           {
             std::cout << "\t after innerHCal isoEt:" << isoEt << '\n';
           }
           // calculate Outer HCal tower contribution to isolation energy
-          {
-            unsigned int ntowers = towersOH3->size();
-            for (unsigned int channel = 0; channel < ntowers; channel++)
-            {
-              TowerInfo *tower = towersOH3->get_tower_at_channel(channel);
-              if (!IsAcceptableTower(tower))
-              {
-                continue;
-              }
-              unsigned int towerkey = towersOH3->encode_key(channel);
-              int ieta = towersOH3->getTowerEtaBin(towerkey);
-              int iphi = towersOH3->getTowerPhiBin(towerkey);
-              const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ieta, iphi);
-              RawTowerGeom *tower_geom = geomOH->get_tower_geometry(key);
-              double this_phi = tower_geom->get_phi();
-              double this_eta = getTowerEta(tower_geom, m_vx, m_vy, m_vz);
-              if (deltaR(cluster_eta, this_eta, cluster_phi, this_phi) < m_coneSize)
-              {
-                isoEt += tower->get_energy() / cosh(this_eta);  // if tower is in cone, add energy
-              }
-            }
-          }
+          addConeEt(m_towersOH, cluster_eta, cluster_phi, isoEt);
           if (Verbosity() >= VERBOSITY_MAX)
           {
             std::cout << "\t after outerHCal isoEt:" << isoEt << '\n';
@@ -511,6 +390,139 @@ int ClusterIso::End(PHCompositeNode * /*topNode*/)
   return 0;
 }
 
+/** \Brief Fills eta, phi and eT of the accepted towers
+ *
+ * The towers do not depend on the cluster, so this is done once per event
+ * and the cone sums only loop over the accepted towers.
+ */
+void ClusterIso::fillConeTowers(TowerInfoContainer *towers, RawTowerGeomContainer *geom, bool vertex_corrected, ConeTowers &conetowers)
+{
+  conetowers.towers.clear();
+  unsigned int ntowers = towers->size();
+  conetowers.towers.reserve(ntowers);
+  for (unsigned int channel = 0; channel < ntowers; channel++)
+  {
+    TowerInfo *tower = towers->get_tower_at_channel(channel);
+    if (!IsAcceptableTower(tower))
+    {
+      continue;
+    }
+    RawTowerGeom *tower_geom = geom->get_tower_geometry(towers, channel);
+    ConeTower conetower;
+    conetower.phi = tower_geom->get_phi();
+    conetower.eta = vertex_corrected ? getTowerEta(tower_geom, m_vx, m_vy, m_vz) : tower_geom->get_eta();
+    if (!std::isfinite(conetower.eta) || !std::isfinite(conetower.phi))
+    {
+      continue;  // never inside a cone
+    }
+    conetower.et = tower->get_energy() / cosh(conetower.eta);
+    conetowers.towers.push_back(conetower);
+  }
+  fillConeGrid(conetowers);
+}
+
+void ClusterIso::fillConeGrid(ConeTowers &conetowers)
+{
+  conetowers.neta = 0;
+  conetowers.nphi = 0;
+  if (conetowers.towers.empty() || !(m_coneSize > 0))
+  {
+    return;
+  }
+  double etamin = conetowers.towers.front().eta;
+  double etamax = etamin;
+  for (const auto &conetower : conetowers.towers)
+  {
+    etamin = std::min(etamin, conetower.eta);
+    etamax = std::max(etamax, conetower.eta);
+  }
+  conetowers.etamin = etamin;
+  conetowers.etacell = m_coneSize;
+  conetowers.neta = static_cast<int>((etamax - etamin) / conetowers.etacell) + 1;
+  conetowers.nphi = std::max(1, static_cast<int>(2 * M_PI / m_coneSize));
+  conetowers.phicell = 2 * M_PI / conetowers.nphi;
+
+  // counting sort of the towers by cell, within a cell they stay in tower order
+  const unsigned int ncells = conetowers.neta * conetowers.nphi;
+  conetowers.cellstart.assign(ncells + 1, 0);
+  conetowers.cellfill.resize(conetowers.towers.size());
+  for (unsigned int i = 0; i < conetowers.towers.size(); i++)
+  {
+    const ConeTower &conetower = conetowers.towers[i];
+    int ieta = std::min(static_cast<int>((conetower.eta - etamin) / conetowers.etacell), conetowers.neta - 1);
+    int iphi = static_cast<int>(std::floor((conetower.phi + M_PI) / conetowers.phicell)) % conetowers.nphi;
+    if (iphi < 0)
+    {
+      iphi += conetowers.nphi;
+    }
+    conetowers.cellfill[i] = ieta * conetowers.nphi + iphi;
+    conetowers.cellstart[conetowers.cellfill[i] + 1]++;
+  }
+  for (unsigned int cell = 0; cell < ncells; cell++)
+  {
+    conetowers.cellstart[cell + 1] += conetowers.cellstart[cell];
+  }
+  conetowers.cellorder.resize(conetowers.towers.size());
+  std::vector<unsigned int> &next = m_inCone;  // free until the cone sums
+  next.assign(conetowers.cellstart.begin(), conetowers.cellstart.end() - 1);
+  for (unsigned int i = 0; i < conetowers.towers.size(); i++)
+  {
+    conetowers.cellorder[next[conetowers.cellfill[i]]++] = i;
+  }
+}
+
+/**
+ * Only the cells around the cluster are searched, one more on each side
+ * than the cone needs. The towers inside the cone are summed in tower order
+ * like a loop over all towers would, so isoEt does not depend on the grid.
+ */
+void ClusterIso::addConeEt(const ConeTowers &conetowers, double cluster_eta, double cluster_phi, double &isoEt)
+{
+  if (conetowers.neta == 0 || !std::isfinite(cluster_eta) || !std::isfinite(cluster_phi))
+  {
+    return;  // no tower can be inside the cone
+  }
+  double etalow = std::floor((cluster_eta - m_coneSize - conetowers.etamin) / conetowers.etacell) - 1;
+  double etahigh = std::floor((cluster_eta + m_coneSize - conetowers.etamin) / conetowers.etacell) + 1;
+  if (etahigh < 0 || etalow >= conetowers.neta)
+  {
+    return;
+  }
+  int ietamin = std::max(0, static_cast<int>(etalow));
+  int ietamax = std::min(conetowers.neta - 1, static_cast<int>(etahigh));
+  int iphimin = static_cast<int>(std::floor((cluster_phi - m_coneSize + M_PI) / conetowers.phicell)) - 1;
+  int iphimax = static_cast<int>(std::floor((cluster_phi + m_coneSize + M_PI) / conetowers.phicell)) + 1;
+  if (iphimax - iphimin + 1 >= conetowers.nphi)
+  {
+    iphimin = 0;
+    iphimax = conetowers.nphi - 1;
+  }
+
+  m_inCone.clear();
+  for (int ieta = ietamin; ieta <= ietamax; ieta++)
+  {
+    for (int jphi = iphimin; jphi <= iphimax; jphi++)
+    {
+      int iphi = (jphi % conetowers.nphi + conetowers.nphi) % conetowers.nphi;
+      unsigned int cell = ieta * conetowers.nphi + iphi;
+      for (unsigned int k = conetowers.cellstart[cell]; k < conetowers.cellstart[cell + 1]; k++)
+      {
+        unsigned int i = conetowers.cellorder[k];
+        const ConeTower &conetower = conetowers.towers[i];
+        if (deltaR(cluster_eta, conetower.eta, cluster_phi, conetower.phi) < m_coneSize)
+        {
+          m_inCone.push_back(i);
+        }
+      }
+    }
+  }
+  std::sort(m_inCone.begin(), m_inCone.end());
+  for (unsigned int i : m_inCone)
+  {
+    isoEt += conetowers.towers[i].et;  // if tower is in cone, add energy
+  }
+}
+
 bool ClusterIso::IsAcceptableTower(TowerInfo *tower)
 {
   if (tower->get_isBadTime())
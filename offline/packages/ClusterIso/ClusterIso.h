@@ -8,10 +8,13 @@
 
 #include <cmath>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class RawTowerGeom;
+class RawTowerGeomContainer;
 class TowerInfo;
+class TowerInfoContainer;
 
 /** \Brief Tool to find isolation energy of each EMCal cluster.
  *
@@ -50,8 +53,42 @@ class ClusterIso : public SubsysReco
   }
 
  private:
+  //! eta, phi and eT of an accepted tower
+  class ConeTower
+  {
+   public:
+    double eta;
+    double phi;
+    double et;
+  };
+
+  //! accepted towers of a calorimeter, sorted into (eta, phi) cells of at least the cone size
+  class ConeTowers
+  {
+   public:
+    std::vector<ConeTower> towers;
+    double etamin{0};
+    double etacell{1};
+    double phicell{1};
+    int neta{0};
+    int nphi{0};
+    std::vector<unsigned int> cellstart;  ///< towers of cell i are cellorder[cellstart[i]] to cellorder[cellstart[i+1]-1]
+    std::vector<unsigned int> cellorder;
+    std::vector<unsigned int> cellfill;
+  };
+
   double getTowerEta(RawTowerGeom* tower_geom, double vx, double vy, double vz);
   bool IsAcceptableTower(TowerInfo* tower);
+  //! fills the accepted towers once per event, eta w.r.t. the vertex if vertex_corrected
+  void fillConeTowers(TowerInfoContainer* towers, RawTowerGeomContainer* geom, bool vertex_corrected, ConeTowers& conetowers);
+  //! sorts the towers into their cells
+  void fillConeGrid(ConeTowers& conetowers);
+  //! adds the eT of the towers inside the cone around (eta, phi) to isoEt
+  void addConeEt(const ConeTowers& conetowers, double cluster_eta, double cluster_phi, double& isoEt);
+  ConeTowers m_towersEM;
+  ConeTowers m_towersIH;
+  ConeTowers m_towersOH;
+  std::vector<unsigned int> m_inCone;  ///< towers inside the cone, scratch of addConeEt
   float m_eTCut{};     ///< The minimum required transverse energy in a cluster for ClusterIso to be run
   float m_coneSize{};  ///< Size of the cone used to isolate a given cluster
   float m_vx;          ///< Correct vertex x coordinate
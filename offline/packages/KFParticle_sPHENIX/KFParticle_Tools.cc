@@ -58,6 +58,7 @@
 #include <iterator>   // for end
 #include <map>        // for _Rb_tree_iterator, map
 #include <memory>     // for allocator_traits<>::va...
+#include <set>
 
 KFParticle_truthAndDetTools toolSet;
 
@@ -374,7 +375,7 @@ int KFParticle_Tools::calcMinIP(const KFParticle &track, const std::vector<KFPar
   return 0;
 }
 
-std::vector<int> KFParticle_Tools::findAllGoodTracks(std::vector<KFParticle> daughterParticles, const std::vector<KFParticle> &primaryVertices)
+std::vector<int> KFParticle_Tools::findAllGoodTracks(const std::vector<KFParticle> &daughterParticles, const std::vector<KFParticle> &primaryVertices)
 {
   std::vector<int> goodTrackIndex;
 
@@ -391,49 +392,46 @@ std::vector<int> KFParticle_Tools::findAllGoodTracks(std::vector<KFParticle> dau
   return goodTrackIndex;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(std::vector<KFParticle> daughterParticles, std::vector<int> goodTrackIndex, int nTracks)
+std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int nTracks)
 {
   std::vector<std::vector<int>> goodTracksThatMeet;
 
-  for (std::vector<int>::iterator i_it = goodTrackIndex.begin(); i_it != goodTrackIndex.end(); ++i_it)
+  for (auto i_it = goodTrackIndex.begin(); i_it != goodTrackIndex.end(); ++i_it)
   {
-    for (std::vector<int>::iterator j_it = goodTrackIndex.begin(); j_it != goodTrackIndex.end(); ++j_it)
+    for (auto j_it = i_it + 1; j_it != goodTrackIndex.end(); ++j_it)
     {
-      if (i_it < j_it)
+      float dca = 0;
+      if (m_use_2D_matching_tools)
       {
-        float dca = 0;
-        if (m_use_2D_matching_tools)
+        dca = daughterParticles[*i_it].GetDistanceFromParticleXY(daughterParticles[*j_it]);
+      }
+      else
+      {
+        dca = daughterParticles[*i_it].GetDistanceFromParticle(daughterParticles[*j_it]);
+      }
+
+      if (dca <= m_comb_DCA)
+      {
+        KFVertex twoParticleVertex;
+        twoParticleVertex += daughterParticles[*i_it];
+        twoParticleVertex += daughterParticles[*j_it];
+        float vertexchi2ndof = twoParticleVertex.GetChi2() / twoParticleVertex.GetNDF();
+        float sv_radial_position = sqrt(pow(twoParticleVertex.GetX(), 2) + pow(twoParticleVertex.GetY(), 2));
+        std::vector<int> combination = {*i_it, *j_it};
+
+        if (nTracks == 2 && vertexchi2ndof > m_vertex_chi2ndof)
         {
-          daughterParticles[*i_it].GetDistanceFromParticleXY(daughterParticles[*j_it]);
+          continue;
         }
         else
         {
-          daughterParticles[*i_it].GetDistanceFromParticle(daughterParticles[*j_it]);
-        }
-
-        if (dca <= m_comb_DCA)
-        {
-          KFVertex twoParticleVertex;
-          twoParticleVertex += daughterParticles[*i_it];
-          twoParticleVertex += daughterParticles[*j_it];
-          float vertexchi2ndof = twoParticleVertex.GetChi2() / twoParticleVertex.GetNDF();
-          float sv_radial_position = sqrt(pow(twoParticleVertex.GetX(), 2) + pow(twoParticleVertex.GetY(), 2));
-          std::vector<int> combination = {*i_it, *j_it};
-
-          if (nTracks == 2 && vertexchi2ndof > m_vertex_chi2ndof)
+          if (nTracks == 2 && sv_radial_position < m_min_radial_SV)
           {
             continue;
           }
           else
           {
-            if (nTracks == 2 && sv_radial_position < m_min_radial_SV)
-            {
-              continue;
-            }
-            else
-            {
-              goodTracksThatMeet.push_back(combination);
-            }
+            goodTracksThatMeet.push_back(combination);
           }
         }
       }
@@ -443,13 +441,17 @@ std::vector<std::vector<int>> KFParticle_Tools::findTwoProngs(std::vector<KFPart
   return goodTracksThatMeet;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::findNProngs(std::vector<KFParticle> daughterParticles,
+std::vector<std::vector<int>> KFParticle_Tools::findNProngs(const std::vector<KFParticle> &daughterParticles,
                                                             const std::vector<int> &goodTrackIndex,
                                                             std::vector<std::vector<int>> goodTracksThatMeet,
                                                             int nRequiredTracks, unsigned int nProngs)
 {
   unsigned int nGoodProngs = goodTracksThatMeet.size();
 
+  // the same set of tracks is reached from each of its (nProngs - 1) track subsets, only test it once
+  std::set<std::vector<int>> testedCombinations;
+  std::vector<int> sortedCombination;
+
   for (auto &i_it : goodTrackIndex)
   {
     for (unsigned int i_prongs = 0; i_prongs < nGoodProngs; ++i_prongs)
@@ -464,17 +466,25 @@ std::vector<std::vector<int>> KFParticle_Tools::findNProngs(std::vector<KFPartic
       }
       if (trackNotUsedAlready)
       {
+        sortedCombination.assign(goodTracksThatMeet[i_prongs].begin(), goodTracksThatMeet[i_prongs].begin() + nProngs - 1);
+        sortedCombination.push_back(i_it);
+        std::sort(sortedCombination.begin(), sortedCombination.end());
+        if (!testedCombinations.insert(sortedCombination).second)
+        {
+          continue;
+        }
+
         bool dcaMet = true;
-        for (unsigned int i = 0; i < nProngs - 1; ++i)
+        for (unsigned int i = 0; i < nProngs - 1 && dcaMet; ++i)
         {
           float dca = 0;
           if (m_use_2D_matching_tools)
           {
-            daughterParticles[i_it].GetDistanceFromParticleXY(daughterParticles[goodTracksThatMeet[i_prongs][i]]);
+            dca = daughterParticles[i_it].GetDistanceFromParticleXY(daughterParticles[goodTracksThatMeet[i_prongs][i]]);
           }
           else
           {
-            daughterParticles[i_it].GetDistanceFromParticle(daughterParticles[goodTracksThatMeet[i_prongs][i]]);          
+            dca = daughterParticles[i_it].GetDistanceFromParticle(daughterParticles[goodTracksThatMeet[i_prongs][i]]);
           }
 
           if (dca > m_comb_DCA)
@@ -527,7 +537,7 @@ std::vector<std::vector<int>> KFParticle_Tools::findNProngs(std::vector<KFPartic
   return goodTracksThatMeet;
 }
 
-std::vector<std::vector<int>> KFParticle_Tools::appendTracksToIntermediates(KFParticle intermediateResonances[], std::vector<KFParticle> daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks)
+std::vector<std::vector<int>> KFParticle_Tools::appendTracksToIntermediates(KFParticle intermediateResonances[], const std::vector<KFParticle> &daughterParticles, const std::vector<int> &goodTrackIndex, int num_remaining_tracks)
 {
   std::vector<std::vector<int>> goodTracksThatMeet, goodTracksThatMeetIntermediates;  //, vectorOfGoodTracks;
   if (num_remaining_tracks == 1)
@@ -656,6 +666,21 @@ float KFParticle_Tools::flightDistanceChi2(const KFParticle &particle, const KFP
   return m_chi2Value(0, 0);
 }
 
+bool KFParticle_Tools::isChargeAllowed(const KFParticle vDaughters[], const int daughterOrder[], int nTracks, float required_vertexID)
+{
+  float unique_vertexID = 0;
+  for (int i = 0; i < nTracks; ++i)
+  {
+    unique_vertexID += (Int_t) vDaughters[i].GetQ() * getParticleMass(daughterOrder[i]);
+  }
+
+  if (m_get_charge_conjugate)
+  {
+    return std::abs(unique_vertexID) == std::abs(required_vertexID);
+  }
+  return unique_vertexID == required_vertexID;
+}
+
 std::tuple<KFParticle, bool> KFParticle_Tools::buildMother(KFParticle vDaughters[], int daughterOrder[],
                                                            bool isIntermediate, int intermediateNumber, int nTracks,
                                                            bool constrainMass, float required_vertexID)
@@ -666,7 +691,6 @@ std::tuple<KFParticle, bool> KFParticle_Tools::buildMother(KFParticle vDaughters
   mother.SetConstructMethod(2);
 
   bool daughterMassCheck = true;
-  float unique_vertexID = 0;
 
   // Figure out if the decay has reco. tracks mixed with resonances
   int num_tracks_used_by_intermediates = 0;
@@ -713,7 +737,6 @@ std::tuple<KFParticle, bool> KFParticle_Tools::buildMother(KFParticle vDaughters
                           (Int_t) vDaughters[i].GetQ(),
                           daughterMass);
     mother.AddDaughter(inputTracks[i]);
-    unique_vertexID += (Int_t) vDaughters[i].GetQ() * getParticleMass(daughterOrder[i]);
   }
 
   if (isIntermediate)
@@ -725,15 +748,7 @@ std::tuple<KFParticle, bool> KFParticle_Tools::buildMother(KFParticle vDaughters
     mother.SetPDG(getParticleID(m_mother_name_Tools));
   }
 
-  bool chargeCheck;
-  if (m_get_charge_conjugate)
-  {
-    chargeCheck = std::abs(unique_vertexID) == std::abs(required_vertexID) ? true : false;
-  }
-  else
-  {
-    chargeCheck = unique_vertexID == required_vertexID ? true : false;
-  }
+  bool chargeCheck = isChargeAllowed(vDaughters, daughterOrder, nTracks, required_vertexID);
 
   for (int j = 0; j < nTracks; ++j)
   {
@@ -41,6 +41,7 @@
 #include <memory>   // for allocator_traits<>::value_type
 #include <string>   // for string
 #include <tuple>    // for tie, tuple
+#include <utility>  // for move
 
 #include <iostream>
 
@@ -412,18 +413,14 @@ void KFParticle_eventReconstruction::buildChain(std::vector<KFParticle>& selecte
 void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>& selectedMotherCand,
                                                        std::vector<KFParticle>& selectedVertexCand,
                                                        std::vector<std::vector<KFParticle>>& selectedDaughtersCand,
-                                                       std::vector<KFParticle> daughterParticlesCand,
-                                                       std::vector<std::vector<int>> goodTracksThatMeetCand,
-                                                       std::vector<KFParticle> primaryVerticesCand,
+                                                       const std::vector<KFParticle>& daughterParticlesCand,
+                                                       const std::vector<std::vector<int>>& goodTracksThatMeetCand,
+                                                       const std::vector<KFParticle>& primaryVerticesCand,
                                                        int n_track_start, int n_track_stop,
                                                        bool isIntermediate, int intermediateNumber, bool constrainMass)
 {
   int nTracks = n_track_stop - n_track_start;
   std::vector<std::vector<int>> uniqueCombinations = findUniqueDaughterCombinations(n_track_start, n_track_stop);
-  std::vector<KFParticle> goodCandidates, goodVertex;
-  std::vector<KFParticle> *goodDaughters = new std::vector<KFParticle>[nTracks];
-  KFParticle candidate;
-  bool isGood;
   bool fixToPV = m_constrain_to_vertex && !isIntermediate;
 
   float required_unique_vertexID = 0;
@@ -432,9 +429,25 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
     required_unique_vertexID += m_daughter_charge[i] * kfp_Tools_evtReco.getParticleMass(m_daughter_name[i].c_str());
   }
 
-  for (auto& i_comb : goodTracksThatMeetCand)  // Loop over all good track combinations
+  // best candidate of each track combination
+  struct Selection
   {
-    KFParticle *daughterTracks = new KFParticle[nTracks];
+    bool found = false;
+    KFParticle mother;
+    KFParticle vertex;
+    std::vector<KFParticle> daughters;
+  };
+  std::vector<Selection> selections(goodTracksThatMeetCand.size());
+
+  // the combinations are independent, they are fitted in parallel and selected in order
+  auto processCombination = [&](size_t i_comb_index)
+  {
+    const auto& i_comb = goodTracksThatMeetCand[i_comb_index];
+    std::vector<KFParticle> goodCandidates, goodVertex;
+    std::vector<std::vector<KFParticle>> goodDaughters(nTracks);
+    std::vector<KFParticle> daughterTracks(nTracks);
+    KFParticle candidate;
+    bool isGood;
 
     for (int i_track = 0; i_track < nTracks; ++i_track)
     {
@@ -443,11 +456,29 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
 
     for (auto& uniqueCombination : uniqueCombinations)  // Loop over unique track PID assignments
     {
-      for (unsigned int i_pv = 0; i_pv < primaryVerticesCand.size(); ++i_pv)  // Loop over all PVs in the event
+      int* PDGIDofFirstParticleInCombination = &uniqueCombination[0];
+
+      // the charges are known before the fit, skip the PID assignments that do not match the decay
+      if (!isChargeAllowed(daughterTracks.data(), PDGIDofFirstParticleInCombination, nTracks, required_unique_vertexID))
       {
-        int* PDGIDofFirstParticleInCombination = &uniqueCombination[0];
-        std::tie(candidate, isGood) = getCombination(daughterTracks, PDGIDofFirstParticleInCombination, primaryVerticesCand[i_pv], m_constrain_to_vertex,
-                                                     isIntermediate, intermediateNumber, nTracks, constrainMass, required_unique_vertexID);
+        continue;
+      }
+
+      // the mother does not depend on the PV, only the vertex constraint does
+      KFParticle mother;
+      bool isGoodMother;
+      std::tie(mother, isGoodMother) = buildMother(daughterTracks.data(), PDGIDofFirstParticleInCombination,
+                                                   isIntermediate, intermediateNumber, nTracks, constrainMass, required_unique_vertexID);
+
+      for (const auto& primaryVertex : primaryVerticesCand)  // Loop over all PVs in the event
+      {
+        candidate = mother;
+        isGood = isGoodMother;
+        if (m_constrain_to_vertex && isGood && !isIntermediate)
+        {
+          KFParticle vertex = primaryVertex;
+          constrainToVertex(candidate, isGood, vertex);
+        }
 
         if (isIntermediate && isGood)
         {
@@ -463,7 +494,7 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
         if (isGood)
         {
           goodCandidates.push_back(candidate);
-          goodVertex.push_back(primaryVerticesCand[i_pv]);
+          goodVertex.push_back(primaryVertex);
           for (int i = 0; i < nTracks; ++i)
           {
             KFParticle intParticle;
@@ -505,34 +536,48 @@ void KFParticle_eventReconstruction::getCandidateDecay(std::vector<KFParticle>&
     {
       int bestCombinationIndex = selectBestCombination(fixToPV, isIntermediate, goodCandidates, goodVertex);
 
-      selectedMotherCand.push_back(goodCandidates[bestCombinationIndex]);
-      if (fixToPV)
-      {
-        selectedVertexCand.push_back(goodVertex[bestCombinationIndex]);
-      }
-      std::vector<KFParticle> particles;
-      particles.reserve(nTracks);
+      auto& selection = selections[i_comb_index];
+      selection.found = true;
+      selection.mother = goodCandidates[bestCombinationIndex];
+      selection.vertex = goodVertex[bestCombinationIndex];
+      selection.daughters.reserve(nTracks);
       for (int i = 0; i < nTracks; ++i)
       {
-        particles.push_back(goodDaughters[i][bestCombinationIndex]);
+        selection.daughters.push_back(goodDaughters[i][bestCombinationIndex]);
       }
-      selectedDaughtersCand.push_back(particles);
+    }
+  };
 
-      goodCandidates.clear();
-      goodVertex.clear();
-      for (int j = 0; j < nTracks; ++j)
-      {
-        goodDaughters[j].clear();
-      }
+  if (m_threadpool)
+  {
+    m_threadpool->parallel_for(goodTracksThatMeetCand.size(), processCombination);
+  }
+  else
+  {
+    for (size_t i_comb = 0; i_comb < goodTracksThatMeetCand.size(); ++i_comb)
+    {
+      processCombination(i_comb);
     }
-    delete [] daughterTracks;
   }
-  delete [] goodDaughters;
+
+  for (auto& selection : selections)
+  {
+    if (!selection.found)
+    {
+      continue;
+    }
+    selectedMotherCand.push_back(selection.mother);
+    if (fixToPV)
+    {
+      selectedVertexCand.push_back(selection.vertex);
+    }
+    selectedDaughtersCand.push_back(std::move(selection.daughters));
+  }
 }
 
 int KFParticle_eventReconstruction::selectBestCombination(bool PVconstraint, bool isAnInterMother,
-                                                          std::vector<KFParticle> possibleCandidates,
-                                                          std::vector<KFParticle> possibleVertex)
+                                                          const std::vector<KFParticle>& possibleCandidates,
+                                                          const std::vector<KFParticle>& possibleVertex)
 {
   KFParticle smallestMassError = possibleCandidates[0];
   int bestCombinationIndex = 0;
@@ -30,6 +30,7 @@
 
 #include <phool/getClass.h>
 
+#include <TDatabasePDG.h>
 #include <TEntryList.h>
 #include <TFile.h>
 #include <TLeaf.h>
@@ -48,6 +49,7 @@
 #include <filesystem>
 #include <iostream>  // for operator<<, endl, basi...
 #include <map>       // for map
+#include <memory>    // for make_unique
 #include <tuple>     // for tie, tuple
 
 class PHCompositeNode;
@@ -109,6 +111,14 @@ int KFParticle_sPHENIX::Init(PHCompositeNode *topNode)
     returnCode = parseDecayDescriptor();
   }
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    // the PDG code lookup table is built on first use, build it before the threads use it
+    TDatabasePDG::Instance()->GetParticle(211);
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+  }
+
   return returnCode;
 }
 
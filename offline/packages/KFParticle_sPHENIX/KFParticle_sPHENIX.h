@@ -276,6 +276,9 @@ class KFParticle_sPHENIX : public SubsysReco, public KFParticle_nTuple, public K
 
   void use2Dmatching(bool use_2D_matching_tools = true) { m_use_2D_matching_tools = use_2D_matching_tools; }
 
+  //! fit the candidates of different track combinations in parallel
+  void setNumberOfThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   void useMVA(bool require_mva = true) { m_require_mva = require_mva; }
 
   void setNumMVAPars(unsigned int nPars) { m_nPars = nPars; }
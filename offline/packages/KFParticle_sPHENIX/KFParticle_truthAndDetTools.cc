@@ -76,17 +76,7 @@ KFParticle_truthAndDetTools::~KFParticle_truthAndDetTools() = default;  // Destr
 
 SvtxTrack *KFParticle_truthAndDetTools::getTrack(unsigned int track_id, SvtxTrackMap *trackmap)
 {
-  SvtxTrack *matched_track = nullptr;
-
-  for (auto &iter : *trackmap)
-  {
-    if (iter.first == track_id)
-    {
-      matched_track = iter.second;
-    }
-  }
-
-  return matched_track;
+  return trackmap->get(track_id);
 }
 
 GlobalVertex *KFParticle_truthAndDetTools::getVertex(unsigned int vertex_id, GlobalVertexMap *vertexmap)
@@ -0,0 +1,33 @@
+#include "DumpPerformanceSummary.h"
+
+#include <phool/PHIODataNode.h>
+
+#include <ffaobjects/PerformanceSummary.h>
+
+#include <map>
+#include <ostream>
+#include <string>
+#include <utility>
+
+using MyNode_t = PHIODataNode<PerformanceSummary>;
+
+DumpPerformanceSummary::DumpPerformanceSummary(const std::string &NodeName)
+  : DumpObject(NodeName)
+{
+  return;
+}
+
+int DumpPerformanceSummary::process_Node(PHNode *myNode)
+{
+  PerformanceSummary *summary = nullptr;
+  MyNode_t *thisNode = static_cast<MyNode_t *>(myNode);
+  if (thisNode)
+  {
+    summary = thisNode->getData();
+  }
+  if (summary)
+  {
+    summary->identify(*fout);
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+#ifndef NODEDUMP_DUMPPERFORMANCESUMMARY_H
+#define NODEDUMP_DUMPPERFORMANCESUMMARY_H
+
+#include "DumpObject.h"
+
+#include <string>
+
+class PHNode;
+
+class DumpPerformanceSummary : public DumpObject
+{
+ public:
+  explicit DumpPerformanceSummary(const std::string &NodeName);
+  ~DumpPerformanceSummary() override {}
+
+ protected:
+  int process_Node(PHNode *mynode) override;
+};
+
+#endif
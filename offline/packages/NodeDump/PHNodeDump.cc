@@ -42,6 +42,7 @@
 #include "DumpParticleFlowElementContainer.h"
 #include "DumpPdbParameterMap.h"
 #include "DumpPdbParameterMapContainer.h"
+#include "DumpPerformanceSummary.h"
 #include "DumpRawClusterContainer.h"
 #include "DumpRawTowerContainer.h"
 #include "DumpRawTowerGeomContainer.h"
@@ -299,6 +300,10 @@ int PHNodeDump::AddDumpObject(const std::string &NodeName, PHNode *node)
       {
         newdump = new DumpPdbParameterMapContainer(NodeName);
       }
+      else if (tmp->InheritsFrom("PerformanceSummary"))
+      {
+        newdump = new DumpPerformanceSummary(NodeName);
+      }
       else if (tmp->InheritsFrom("PHFieldConfig"))
       {
         newdump = new DumpPHFieldConfig(NodeName);
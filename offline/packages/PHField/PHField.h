@@ -21,6 +21,19 @@ class PHField
       const double Point[4],
       double *Bfield) const = 0;
 
+  //! access field values for n points in one call
+  //! @param[in]  Points  n space time coordinates, stored as x0,y0,z0,t0,x1,...
+  //! @param[out] Bfields n field values, stored as Bx0,By0,Bz0,Bx1,...
+  //! the default loops over GetFieldValue, grid based maps override it
+  //! to avoid the virtual call per point
+  virtual void GetFieldValues(const double *Points, double *Bfields, const unsigned int n) const
+  {
+    for (unsigned int i = 0; i < n; ++i)
+    {
+      GetFieldValue(Points + 4 * i, Bfields + 3 * i);
+    }
+  }
+
   void Verbosity(const int i) { m_Verbosity = i; }
   int Verbosity() const { return m_Verbosity; }
 
@@ -15,36 +15,119 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
+#include <fcntl.h>  // for O_* constants
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cerrno>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <iterator>
-#include <set>
+#include <new>
+#include <sstream>
 #include <utility>
+#include <vector>
 
-PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
-  : filename(fname)
+namespace
 {
-  for (int i = 0; i < 2; i++)
+  //! FNV-1a hash, stable across builds and processes
+  uint64_t hash_string(const std::string &input)
   {
-    for (int j = 0; j < 2; j++)
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : input)
     {
-      for (int k = 0; k < 2; k++)
-      {
-        for (int l = 0; l < 3; l++)
-        {
-          xyz[i][j][k][l] = NAN;
-          bf[i][j][k][l] = NAN;
-        }
-      }
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
     }
+    return hash;
   }
+
+  //! layout of the shared memory segment, followed by the x, y, z axes and the bx, by, bz grids as floats
+  struct SharedGridHeader
+  {
+    uint32_t magic;
+    std::atomic<uint32_t> ready;
+    uint64_t nx;
+    uint64_t ny;
+    uint64_t nz;
+  };
+  constexpr uint32_t kSharedGridMagic = 0x50484633;  // "PHF3"
+
+  //! time to wait for the process filling the segment
+  constexpr int kSharedGridTimeout = 600;  // seconds
+}  // namespace
+
+PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z, const bool shared_memory)
+  : filename(fname)
+{
   std::cout << "\n================ Begin Construct Mag Field =====================" << std::endl;
   std::cout << "\n-----------------------------------------------------------"
             << "\n      Magnetic field Module - Verbosity:"
             << "\n-----------------------------------------------------------";
 
+  bool shared = false;
+  if (shared_memory)
+  {
+    // the segment is specific to the map file (incl. its size and modification time) and the reading parameters
+    std::ostringstream key;
+    key << filename << ":" << magfield_rescale << ":" << innerradius << ":" << outerradius << ":" << size_z;
+    struct stat filestat;
+    if (stat(filename.c_str(), &filestat) == 0)
+    {
+      key << ":" << filestat.st_size << ":" << filestat.st_mtime;
+    }
+    std::ostringstream name;
+    name << "/phfield3dcartesian_" << std::hex << hash_string(key.str());
+    shared = UseSharedGrid(name.str(), magfield_rescale, innerradius, outerradius, size_z);
+  }
+  if (!shared)
+  {
+    ReadFieldMap(magfield_rescale, innerradius, outerradius, size_z);
+    m_bx = bxgrid.data();
+    m_by = bygrid.data();
+    m_bz = bzgrid.data();
+  }
+
+  xmin = xaxis.front();
+  xmax = xaxis.back();
+
+  ymin = yaxis.front();
+  ymax = yaxis.back();
+  if (ymin != xmin || ymax != xmax)
+  {
+    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
+    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
+    exit(1);
+  }
+
+  zmin = zaxis.front();
+  zmax = zaxis.back();
+
+  xstepsize = (xmax - xmin) / (xaxis.size() - 1);
+  ystepsize = (ymax - ymin) / (yaxis.size() - 1);
+  zstepsize = (zmax - zmin) / (zaxis.size() - 1);
+
+  std::cout << "\n================= End Construct Mag Field ======================\n"
+            << std::endl;
+}
+
+PHField3DCartesian::~PHField3DCartesian()
+{
+  if (m_shm_addr)
+  {
+    munmap(m_shm_addr, m_shm_size);
+  }
+}
+
+void PHField3DCartesian::ReadFieldMap(const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+{
   // open file
   TFile *rootinput = TFile::Open(filename.c_str());
   if (!rootinput)
@@ -75,56 +158,231 @@ PHField3DCartesian::PHField3DCartesian(const std::string &fname, const float mag
   field_map->SetBranchAddress("bx", &ROOT_BX);
   field_map->SetBranchAddress("by", &ROOT_BY);
   field_map->SetBranchAddress("bz", &ROOT_BZ);
-  for (int i = 0; i < field_map->GetEntries(); i++)
+  // read the ntuple once into flat buffers, the grid axes are
+  // extracted afterwards by sort/unique instead of std::set inserts
+  const Long64_t nentries = field_map->GetEntries();
+  std::vector<float> xread;
+  std::vector<float> yread;
+  std::vector<float> zread;
+  std::vector<float> bxread;
+  std::vector<float> byread;
+  std::vector<float> bzread;
+  std::vector<bool> keep;
+  xread.reserve(nentries);
+  yread.reserve(nentries);
+  zread.reserve(nentries);
+  bxread.reserve(nentries);
+  byread.reserve(nentries);
+  bzread.reserve(nentries);
+  keep.reserve(nentries);
+  for (Long64_t i = 0; i < nentries; i++)
   {
     field_map->GetEntry(i);
-    trio coord_key(ROOT_X * cm, ROOT_Y * cm, ROOT_Z * cm);
-    trio field_val(ROOT_BX * tesla * magfield_rescale, ROOT_BY * tesla * magfield_rescale, ROOT_BZ * tesla * magfield_rescale);
-    xvals.insert(ROOT_X * cm);
-    yvals.insert(ROOT_Y * cm);
-    zvals.insert(ROOT_Z * cm);
-    if ((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
-         std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
-        std::abs(ROOT_Z * cm) > size_z)
+    xread.push_back(ROOT_X * cm);
+    yread.push_back(ROOT_Y * cm);
+    zread.push_back(ROOT_Z * cm);
+    bxread.push_back(ROOT_BX * tesla * magfield_rescale);
+    byread.push_back(ROOT_BY * tesla * magfield_rescale);
+    bzread.push_back(ROOT_BZ * tesla * magfield_rescale);
+    keep.push_back((std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) >= innerradius &&
+                    std::sqrt(ROOT_X * cm * ROOT_X * cm + ROOT_Y * cm * ROOT_Y * cm) <= outerradius) ||
+                   std::abs(ROOT_Z * cm) > size_z);
+  }
+  if (nentries <= 0)
+  {
+    std::cout << PHWHERE << " fieldmap ntuple in " << filename
+              << " is empty, exiting now" << std::endl;
+    gSystem->Exit(1);
+    exit(1);
+  }
+  auto make_axis = [](const std::vector<float> &vals)
+  {
+    std::vector<float> axis(vals);
+    std::sort(axis.begin(), axis.end());
+    axis.erase(std::unique(axis.begin(), axis.end()), axis.end());
+    return axis;
+  };
+  xaxis = make_axis(xread);
+  yaxis = make_axis(yread);
+  zaxis = make_axis(zread);
+
+  const size_t ngrid = xaxis.size() * yaxis.size() * zaxis.size();
+  bxgrid.assign(ngrid, NAN);
+  bygrid.assign(ngrid, NAN);
+  bzgrid.assign(ngrid, NAN);
+  for (size_t i = 0; i < xread.size(); i++)
+  {
+    if (!keep[i])
     {
-      fieldmap[coord_key] = field_val;
+      continue;
     }
+    unsigned int ix = std::lower_bound(xaxis.begin(), xaxis.end(), xread[i]) - xaxis.begin();
+    unsigned int iy = std::lower_bound(yaxis.begin(), yaxis.end(), yread[i]) - yaxis.begin();
+    unsigned int iz = std::lower_bound(zaxis.begin(), zaxis.end(), zread[i]) - zaxis.begin();
+    size_t index = GridIndex(ix, iy, iz);
+    bxgrid[index] = bxread[i];
+    bygrid[index] = byread[i];
+    bzgrid[index] = bzread[i];
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHField3DCartesian: grid " << xaxis.size() << " x " << yaxis.size()
+              << " x " << zaxis.size() << " nodes from " << nentries << " entries" << std::endl;
   }
-  xmin = *(xvals.begin());
-  xmax = *(xvals.rbegin());
 
-  ymin = *(yvals.begin());
-  ymax = *(yvals.rbegin());
-  if (ymin != xmin || ymax != xmax)
+  delete field_map;
+  delete rootinput;
+}
+
+bool PHField3DCartesian::UseSharedGrid(const std::string &name, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z)
+{
+  const size_t header_size = sizeof(SharedGridHeader);
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+  if (fd >= 0)
   {
-    std::cout << "PHField3DCartesian: Compiler bug!!!!!!!! Do not use inlining!!!!!!" << std::endl;
-    std::cout << "exiting now - recompile with -fno-inline" << std::endl;
-    exit(1);
+    // first process: read the map and publish it
+    ReadFieldMap(magfield_rescale, innerradius, outerradius, size_z);
+    const size_t ngrid = bxgrid.size();
+    const size_t nfloats = xaxis.size() + yaxis.size() + zaxis.size() + 3 * ngrid;
+    m_shm_size = header_size + nfloats * sizeof(float);
+    void *addr = MAP_FAILED;
+    if (ftruncate(fd, m_shm_size) == 0)
+    {
+      addr = mmap(nullptr, m_shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (addr == MAP_FAILED)
+    {
+      std::cout << PHWHERE << " cannot create shared memory segment " << name
+                << ", using a private copy of the field map" << std::endl;
+      shm_unlink(name.c_str());
+      m_bx = bxgrid.data();
+      m_by = bygrid.data();
+      m_bz = bzgrid.data();
+      return true;
+    }
+    SharedGridHeader *header = new (addr) SharedGridHeader;
+    header->magic = kSharedGridMagic;
+    header->nx = xaxis.size();
+    header->ny = yaxis.size();
+    header->nz = zaxis.size();
+    float *data = reinterpret_cast<float *>(static_cast<char *>(addr) + header_size);
+    data = std::copy(xaxis.begin(), xaxis.end(), data);
+    data = std::copy(yaxis.begin(), yaxis.end(), data);
+    data = std::copy(zaxis.begin(), zaxis.end(), data);
+    m_bx = data;
+    data = std::copy(bxgrid.begin(), bxgrid.end(), data);
+    m_by = data;
+    data = std::copy(bygrid.begin(), bygrid.end(), data);
+    m_bz = data;
+    std::copy(bzgrid.begin(), bzgrid.end(), data);
+    header->ready.store(1, std::memory_order_release);
+
+    // only the shared copy is used from now on
+    std::vector<float>().swap(bxgrid);
+    std::vector<float>().swap(bygrid);
+    std::vector<float>().swap(bzgrid);
+    m_shm_addr = addr;
+    std::cout << "PHField3DCartesian: published field map in shared memory segment " << name << std::endl;
+    return true;
   }
 
-  zmin = *(zvals.begin());
-  zmax = *(zvals.rbegin());
+  if (errno != EEXIST)
+  {
+    std::cout << PHWHERE << " cannot open shared memory segment " << name << ": " << strerror(errno)
+              << ", using a private copy of the field map" << std::endl;
+    return false;
+  }
 
-  xstepsize = (xmax - xmin) / (xvals.size() - 1);
-  ystepsize = (ymax - ymin) / (yvals.size() - 1);
-  zstepsize = (zmax - zmin) / (zvals.size() - 1);
+  // later processes: wait until the first one has filled the segment and attach to it
+  fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    return false;
+  }
+  void *addr = MAP_FAILED;
+  for (int iwait = 0; iwait < 10 * kSharedGridTimeout; iwait++)
+  {
+    struct stat segstat;
+    if (addr == MAP_FAILED && fstat(fd, &segstat) == 0 && static_cast<size_t>(segstat.st_size) > header_size)
+    {
+      m_shm_size = segstat.st_size;
+      addr = mmap(nullptr, m_shm_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if (addr != MAP_FAILED && static_cast<const SharedGridHeader *>(addr)->ready.load(std::memory_order_acquire))
+    {
+      break;
+    }
+    usleep(100000);
+  }
+  close(fd);
+  if (addr == MAP_FAILED || !static_cast<const SharedGridHeader *>(addr)->ready.load(std::memory_order_acquire))
+  {
+    std::cout << PHWHERE << " shared memory segment " << name << " was not filled in time (remove /dev/shm" << name
+              << " if no job is reading the field map), using a private copy of the field map" << std::endl;
+    if (addr != MAP_FAILED)
+    {
+      munmap(addr, m_shm_size);
+    }
+    return false;
+  }
 
-  delete field_map;
-  delete rootinput;
-  std::cout << "\n================= End Construct Mag Field ======================\n"
-            << std::endl;
+  const SharedGridHeader *header = static_cast<const SharedGridHeader *>(addr);
+  const size_t ngrid = header->nx * header->ny * header->nz;
+  if (header->magic != kSharedGridMagic || header->nx < 2 || header->ny < 2 || header->nz < 2 ||
+      m_shm_size < header_size + (header->nx + header->ny + header->nz + 3 * ngrid) * sizeof(float))
+  {
+    std::cout << PHWHERE << " invalid shared memory segment " << name
+              << ", using a private copy of the field map" << std::endl;
+    munmap(addr, m_shm_size);
+    return false;
+  }
+  const float *data = reinterpret_cast<const float *>(static_cast<const char *>(addr) + header_size);
+  xaxis.assign(data, data + header->nx);
+  data += header->nx;
+  yaxis.assign(data, data + header->ny);
+  data += header->ny;
+  zaxis.assign(data, data + header->nz);
+  data += header->nz;
+  m_bx = data;
+  m_by = data + ngrid;
+  m_bz = data + 2 * ngrid;
+  m_shm_addr = addr;
+  std::cout << "PHField3DCartesian: using field map from shared memory segment " << name << std::endl;
+  return true;
 }
 
-PHField3DCartesian::~PHField3DCartesian()
+void PHField3DCartesian::GetFieldValues(const double *points, double *Bfields, const unsigned int n) const
 {
-  if (Verbosity() > 0)
+  for (unsigned int i = 0; i < n; ++i)
   {
-    std::cout << "PHField3DCartesian: cache hits: " << cache_hits
-              << " cache misses: " << cache_misses
-              << std::endl;
+    // qualified call, no virtual dispatch per point
+    PHField3DCartesian::GetFieldValue(points + 4 * i, Bfields + 3 * i);
   }
 }
 
+unsigned int PHField3DCartesian::LowerIndex(const std::vector<float> &axis, const double minval, const double stepsize, const double val)
+{
+  const int nmax = axis.size() - 1;
+  if (nmax <= 0)
+  {
+    return 0;
+  }
+  // the grid is regular, compute the index directly and fix up
+  // floating point rounding against the stored node values
+  int index = std::floor((val - minval) / stepsize);
+  index = std::clamp(index, 0, nmax - 1);
+  while (index > 0 && axis[index] > val)
+  {
+    --index;
+  }
+  while (index < nmax - 1 && axis[index + 1] < val)
+  {
+    ++index;
+  }
+  return index;
+}
+
 void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) const
 {
   static double xsav = -1000000.;
@@ -172,113 +430,57 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
   {
     return;
   }
-  double xkey[2];
-  std::set<float>::const_iterator it = xvals.lower_bound(x);
-  xkey[0] = *it;
-  if (it == xvals.begin())
-  {
-    xkey[1] = *it;
-    if (x < xkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! x too small - outside range: " << x / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    xkey[1] = *it;
-  }
+  Interpolate(x, y, z, Bfield);
+  return;
+}
 
-  double ykey[2];
-  it = yvals.lower_bound(y);
-  ykey[0] = *it;
-  if (it == yvals.begin())
-  {
-    ykey[1] = *it;
-    if (y < ykey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! y too small - outside range: " << y / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    ykey[1] = *it;
-  }
-  double zkey[2];
-  it = zvals.lower_bound(z);
-  zkey[0] = *it;
-  if (it == zvals.begin())
-  {
-    zkey[1] = *it;
-    if (z < zkey[0])
-    {
-      std::cout << PHWHERE << ": This should not happen! z too small - outside range: " << z / cm << std::endl;
-      return;
-    }
-  }
-  else
-  {
-    --it;
-    zkey[1] = *it;
-  }
-  if (xkey_save != xkey[0] ||
-      ykey_save != ykey[0] ||
-      zkey_save != zkey[0])
+void PHField3DCartesian::Interpolate(const double x, const double y, const double z, double *Bfield) const
+{
+  const unsigned int ix0 = LowerIndex(xaxis, xmin, xstepsize, x);
+  const unsigned int iy0 = LowerIndex(yaxis, ymin, ystepsize, y);
+  const unsigned int iz0 = LowerIndex(zaxis, zmin, zstepsize, z);
+  const unsigned int ix1 = std::min<unsigned int>(ix0 + 1, xaxis.size() - 1);
+  const unsigned int iy1 = std::min<unsigned int>(iy0 + 1, yaxis.size() - 1);
+  const unsigned int iz1 = std::min<unsigned int>(iz0 + 1, zaxis.size() - 1);
+
+  // corner indices, [i][j][k] with 0 the lower and 1 the upper node
+  const unsigned int xi[2] = {ix0, ix1};
+  const unsigned int yi[2] = {iy0, iy1};
+  const unsigned int zi[2] = {iz0, iz1};
+  float bf[2][2][2][3];
+  for (int i = 0; i < 2; i++)
   {
-    cache_misses++;
-    xkey_save = xkey[0];
-    ykey_save = ykey[0];
-    zkey_save = zkey[0];
-
-    std::map<std::tuple<float, float, float>, std::tuple<float, float, float> >::const_iterator magval;
-    trio key;
-    for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 2; j++)
     {
-      for (int j = 0; j < 2; j++)
+      for (int k = 0; k < 2; k++)
       {
-        for (int k = 0; k < 2; k++)
+        size_t index = GridIndex(xi[i], yi[j], zi[k]);
+        bf[i][j][k][0] = m_bx[index];
+        bf[i][j][k][1] = m_by[index];
+        bf[i][j][k][2] = m_bz[index];
+        if (std::isnan(bf[i][j][k][0]))
         {
-          key = std::make_tuple(xkey[i], ykey[j], zkey[k]);
-          magval = fieldmap.find(key);
-          if (magval == fieldmap.end())
+          // points next to the nodes removed by the radius/z cut hit this
+          // all the time, report every one only for higher verbosity
+          static std::atomic<bool> reported{false};
+          if (Verbosity() > 1 || !reported.exchange(true))
           {
             std::cout << PHWHERE << " could not locate key in " << filename
-                      << " value: x: " << xkey[i] / cm
-                      << ", y: " << ykey[j] / cm
-                      << ", z: " << zkey[k] / cm << std::endl;
-            return;
-          }
-          xyz[i][j][k][0] = std::get<0>(magval->first);
-          xyz[i][j][k][1] = std::get<1>(magval->first);
-          xyz[i][j][k][2] = std::get<2>(magval->first);
-          bf[i][j][k][0] = std::get<0>(magval->second);
-          bf[i][j][k][1] = std::get<1>(magval->second);
-          bf[i][j][k][2] = std::get<2>(magval->second);
-          if (Verbosity() > 0)
-          {
-            std::cout << "read x/y/z: " << xyz[i][j][k][0] / cm << "/"
-                      << xyz[i][j][k][1] / cm << "/"
-                      << xyz[i][j][k][2] / cm << " bx/by/bz: "
-                      << bf[i][j][k][0] / tesla << "/"
-                      << bf[i][j][k][1] / tesla << "/"
-                      << bf[i][j][k][2] / tesla << std::endl;
+                      << " value: x: " << xaxis[xi[i]] / cm
+                      << ", y: " << yaxis[yi[j]] / cm
+                      << ", z: " << zaxis[zi[k]] / cm
+                      << (Verbosity() > 1 ? "" : ", further missing nodes are not reported") << std::endl;
           }
+          return;
         }
       }
     }
   }
-  else
-  {
-    cache_hits++;
-  }
 
   // how far are we away from the reference point
-  double xinblock = point[0] - xkey[1];
-  double yinblock = point[1] - ykey[1];
-  double zinblock = point[2] - zkey[1];
+  double xinblock = x - xaxis[ix0];
+  double yinblock = y - yaxis[iy0];
+  double zinblock = z - zaxis[iz0];
   // normalize distance to step size
   double fractionx = xinblock / xstepsize;
   double fractiony = yinblock / ystepsize;
@@ -290,28 +492,17 @@ void PHField3DCartesian::GetFieldValue(const double point[4], double *Bfield) co
     std::cout << "x/y/z fraction: " << fractionx << "/" << fractiony << "/" << fractionz << std::endl;
   }
 
-  // linear extrapolation in cube:
-
-  // Vxyz =
-  // V000 * x * y * z +
-  // V100 * (1 - x) * y * z +
-  // V010 * x * (1 - y) * z +
-  // V001 * x y * (1 - z) +
-  // V101 * (1 - x) * y * (1 - z) +
-  // V011 * x * (1 - y) * (1 - z) +
-  // V110 * (1 - x) * (1 - y) * z +
-  // V111 * (1 - x) * (1 - y) * (1 - z)
-
+  // linear interpolation in cube (0: lower node, 1: upper node)
   for (int i = 0; i < 3; i++)
   {
-    Bfield[i] = bf[0][0][0][i] * fractionx * fractiony * fractionz +
-                bf[1][0][0][i] * (1. - fractionx) * fractiony * fractionz +
-                bf[0][1][0][i] * fractionx * (1. - fractiony) * fractionz +
-                bf[0][0][1][i] * fractionx * fractiony * (1. - fractionz) +
-                bf[1][0][1][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
-                bf[0][1][1][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
-                bf[1][1][0][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
-                bf[1][1][1][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
+    Bfield[i] = bf[1][1][1][i] * fractionx * fractiony * fractionz +
+                bf[0][1][1][i] * (1. - fractionx) * fractiony * fractionz +
+                bf[1][0][1][i] * fractionx * (1. - fractiony) * fractionz +
+                bf[1][1][0][i] * fractionx * fractiony * (1. - fractionz) +
+                bf[0][1][0][i] * (1. - fractionx) * fractiony * (1. - fractionz) +
+                bf[1][0][0][i] * fractionx * (1. - fractiony) * (1. - fractionz) +
+                bf[0][0][1][i] * (1. - fractionx) * (1. - fractiony) * fractionz +
+                bf[0][0][0][i] * (1. - fractionx) * (1. - fractiony) * (1. - fractionz);
   }
 
   return;
@@ -4,15 +4,16 @@
 #include "PHField.h"
 
 #include <cmath>
-#include <map>
-#include <set>
+#include <cstddef>
 #include <string>
-#include <tuple>
+#include <vector>
 
 class PHField3DCartesian : public PHField
 {
  public:
-  explicit PHField3DCartesian(const std::string &fname, const float magfield_rescale = 1.0, const float innerradius = 0, const float outerradius = 1.e10, const float size_z = 1.e10);
+  //! with shared_memory the field grid is kept in a POSIX shared memory segment, the first
+  //! process on a node reads the map and publishes it, later processes attach to it read-only
+  explicit PHField3DCartesian(const std::string &fname, const float magfield_rescale = 1.0, const float innerradius = 0, const float outerradius = 1.e10, const float size_z = 1.e10, const bool shared_memory = false);
   ~PHField3DCartesian() override;
 
   //! access field value
@@ -21,7 +22,28 @@ class PHField3DCartesian : public PHField
   //! @param[out] Bfield  field value. In the case of magnetic field, the order is Bx, By, Bz in in Geant4/CLHEP units
   void GetFieldValue(const double Point[4], double *Bfield) const override;
 
+  //! batch access, Points holds n x/y/z/t quadruplets, Bfields n Bx/By/Bz triplets
+  void GetFieldValues(const double *Points, double *Bfields, const unsigned int n) const override;
+
  private:
+  //! read the field map file into the axes and the private grid
+  void ReadFieldMap(const float magfield_rescale, const float innerradius, const float outerradius, const float size_z);
+
+  //! attach to the shared memory segment or create and fill it, false if it cannot be used
+  bool UseSharedGrid(const std::string &name, const float magfield_rescale, const float innerradius, const float outerradius, const float size_z);
+
+  //! trilinear interpolation on the dense grid, point must be finite
+  void Interpolate(const double x, const double y, const double z, double *Bfield) const;
+
+  //! find lower grid index of the cell containing val
+  static unsigned int LowerIndex(const std::vector<float> &axis, const double minval, const double stepsize, const double val);
+
+  //! linear index of node (ix, iy, iz) in the field arrays
+  size_t GridIndex(const unsigned int ix, const unsigned int iy, const unsigned int iz) const
+  {
+    return (static_cast<size_t>(ix) * yaxis.size() + iy) * zaxis.size() + iz;
+  }
+
   std::string filename;
   double xmin = 1000000;
   double xmax = -1000000;
@@ -32,21 +54,25 @@ class PHField3DCartesian : public PHField
   double xstepsize = NAN;
   double ystepsize = NAN;
   double zstepsize = NAN;
-  // these are updated in a const method
-  // to cache previous values
-  mutable double xyz[2][2][2][3]{};
-  mutable double bf[2][2][2][3]{};
-  mutable double xkey_save = NAN;
-  mutable double ykey_save = NAN;
-  mutable double zkey_save = NAN;
-  mutable int cache_hits = 0;
-  mutable int cache_misses = 0;
-
-  typedef std::tuple<float, float, float> trio;
-  std::map<std::tuple<float, float, float>, std::tuple<float, float, float> > fieldmap;
-  std::set<float> xvals;
-  std::set<float> yvals;
-  std::set<float> zvals;
+
+  // grid node coordinates (sorted, unique)
+  std::vector<float> xaxis;
+  std::vector<float> yaxis;
+  std::vector<float> zaxis;
+  // field components on the dense x/y/z grid (z runs fastest),
+  // nodes not stored from the map (radius/z cut) are NAN
+  std::vector<float> bxgrid;
+  std::vector<float> bygrid;
+  std::vector<float> bzgrid;
+
+  // field components used by the interpolation, point to the grids above or into the shared memory segment
+  const float *m_bx = nullptr;
+  const float *m_by = nullptr;
+  const float *m_bz = nullptr;
+
+  // mapped shared memory segment
+  void *m_shm_addr = nullptr;
+  size_t m_shm_size = 0;
 };
 
 #endif
@@ -24,6 +24,8 @@
 #include <cstdlib>  // for getenv
 #include <iostream>
 
+bool PHFieldUtility::m_UseSharedMemory = false;
+
 PHField *
 PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, float inner_radius, float outer_radius, float size_z, const int verbosity)
 {
@@ -71,7 +73,8 @@ PHFieldUtility::BuildFieldMap(const PHFieldConfig *field_config, float inner_rad
         field_config->get_magfield_rescale(),
         inner_radius,
         outer_radius,
-        size_z);
+        size_z,
+        m_UseSharedMemory);
     break;
 
   default:
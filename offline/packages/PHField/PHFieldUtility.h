@@ -33,6 +33,10 @@ class PHFieldUtility
   static PHField *
   BuildFieldMap(const PHFieldConfig *field_config, float inner_radius = 0., float outer_radius = 1.e10, float size_z = 1.e10, const int verbosity = 0);
 
+  //! keep 3D Cartesian field maps in node wide shared memory, so concurrent jobs on a node
+  //! read the map once and share a single copy of the grid (off by default)
+  static void UseSharedMemory(const bool b) { m_UseSharedMemory = b; }
+
   //! DST node name for RunTime field map object
   static std::string
   GetDSTFieldMapNodeName()
@@ -51,6 +55,8 @@ class PHFieldUtility
   // static tool sets only
   PHFieldUtility() = delete;
   ~PHFieldUtility() = delete;
+
+  static bool m_UseSharedMemory;
 };
 
 #endif
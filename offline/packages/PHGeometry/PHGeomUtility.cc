@@ -14,6 +14,7 @@
 #include <phool/recoConsts.h>
 
 #include <TGeoManager.h>
+#include <RVersion.h>
 
 #include <uuid/uuid.h>
 
@@ -21,6 +22,7 @@
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -225,6 +227,88 @@ bool PHGeomUtility::RemoveGeometryFile(const std::string &file_name)
     return true;  // file do not exist
 }
 
+std::string PHGeomUtility::mg_GeometryCacheDir;
+
+//! cache file of the geometry with configuration hash
+std::string
+PHGeomUtility::CachedGeometryFileName(const std::string &hash)
+{
+  // TGeo ROOT files are not guaranteed to be readable by older ROOT versions
+  ostringstream file;
+  file << mg_GeometryCacheDir << "/"
+       << "PHGeomUtility_geom_" << hash << "_root" << ROOT_VERSION_CODE << ".root";
+  return file.str();
+}
+
+//! Geometry cache -> DST node
+bool PHGeomUtility::ImportCachedGeometry(PHCompositeNode *topNode, const std::string &hash)
+{
+  if (mg_GeometryCacheDir.empty() or hash.empty())
+  {
+    return false;
+  }
+
+  const string file_name = CachedGeometryFileName(hash);
+  error_code ec;
+  if (not filesystem::is_regular_file(file_name, ec))
+  {
+    return false;
+  }
+
+  if (GetVerbosity() > 0)
+  {
+    cout << __PRETTY_FUNCTION__ << " - reading cached geometry " << file_name << endl;
+  }
+  return ImportGeomFile(topNode, file_name) == Fun4AllReturnCodes::EVENT_OK;
+}
+
+//! DST node -> geometry cache
+bool PHGeomUtility::CacheGeometry(PHCompositeNode *topNode, const std::string &hash)
+{
+  if (mg_GeometryCacheDir.empty() or hash.empty())
+  {
+    return false;
+  }
+
+  PHGeomTGeo *dst_geom = GetGeomTGeoNode(topNode, false);
+  if (not dst_geom or not dst_geom->isValid())
+  {
+    cout << __PRETTY_FUNCTION__
+         << " - ERROR - no valid geometry to cache at RUN/GEOMETRY" << endl;
+    return false;
+  }
+
+  error_code ec;
+  filesystem::create_directories(mg_GeometryCacheDir, ec);
+
+  // TGeoManager::Export picks the format from the extension, keep .root on the temporary file.
+  // The rename is atomic, concurrent jobs never read a partial file
+  const string file_name = CachedGeometryFileName(hash);
+  const string tmp_name = file_name + ".tmp." + to_string(getpid()) + ".root";
+  if (dst_geom->GetGeometry()->Export(tmp_name.c_str()) <= 0)
+  {
+    cout << __PRETTY_FUNCTION__
+         << " - ERROR - can not write cached geometry " << tmp_name << endl;
+    filesystem::remove(tmp_name, ec);
+    return false;
+  }
+  filesystem::rename(tmp_name, file_name, ec);
+  if (ec)
+  {
+    cout << __PRETTY_FUNCTION__
+         << " - ERROR - can not rename cached geometry " << tmp_name
+         << ": " << ec.message() << endl;
+    filesystem::remove(tmp_name, ec);
+    return false;
+  }
+
+  if (GetVerbosity() > 0)
+  {
+    cout << __PRETTY_FUNCTION__ << " - cached geometry in " << file_name << endl;
+  }
+  return true;
+}
+
 //! Update persistent PHGeomIOTGeo node RUN/GEOMETRY_IO based on run-time object PHGeomTGeo at RUN/GEOMETRY
 //! \return the updated PHGeomIOTGeo from DST tree
 PHGeomIOTGeo *
@@ -56,6 +56,15 @@ class PHGeomUtility
   static bool
   RemoveGeometryFile(const std::string &file_name);
 
+  //! Geometry cache -> DST node, for the geometry with configuration hash made by the caller
+  //! \return false if the cache is disabled or has no valid entry for hash
+  static bool
+  ImportCachedGeometry(PHCompositeNode *topNode, const std::string &hash);
+
+  //! DST node -> geometry cache, under the configuration hash made by the caller
+  static bool
+  CacheGeometry(PHCompositeNode *topNode, const std::string &hash);
+
   //! Verbosity for geometry IO like, TGeoMangers
   static void SetVerbosity(int v);
 
@@ -80,6 +89,13 @@ class PHGeomUtility
   //! User can overwrite it to e.g. local directory with  PHGeomUtility::SetGenerateGeometryFileNameBase('./');
   static void SetGenerateGeometryFileNameBase(const std::string &base) { mg_GenerateGeometryFileNameBase = base; }
 
+  //! Directory of cached geometries, as TGeo ROOT files named after their configuration hash.
+  //! Empty (default) disables the cache. It can be shared by jobs, entries are written through a temporary file.
+  static void SetGeometryCacheDir(const std::string &dir) { mg_GeometryCacheDir = dir; }
+
+  //! Directory of cached geometries, empty if the cache is disabled
+  static const std::string &GetGeometryCacheDir() { return mg_GeometryCacheDir; }
+
  private:
   PHGeomUtility() = delete;
   ~PHGeomUtility() = delete;
@@ -87,6 +103,13 @@ class PHGeomUtility
   //! Base path name for temp geometry GDML file used in GenerateGeometryFileName().
   //! User can overwrite it to e.g. local directory with  PHGeomUtility::SetGenerateGeometryFileNameBase('./');
   static std::string mg_GenerateGeometryFileNameBase;
+
+  //! Directory of cached geometries, empty if the cache is disabled
+  static std::string mg_GeometryCacheDir;
+
+  //! cache file of the geometry with configuration hash
+  static std::string
+  CachedGeometryFileName(const std::string &hash);
 };
 
 #endif
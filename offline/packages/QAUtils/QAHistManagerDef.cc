@@ -80,7 +80,7 @@ namespace QAHistManagerDef
     auto rc = recoConsts::instance();
     std::string dbtag = rc->get_StringFlag("CDB_GLOBALTAG");
     std::string info = "Build: " + build + " , dbtag: " + dbtag;
-    TH1* h = new TH1I("h_QAHistManagerDef_ProductionInfo","",10,0,10);
+    TH1* h = new TH1I(ProductionInfoName.c_str(),"",10,0,10);
     h->SetTitle(info.c_str());
     getHistoManager()->registerHisto(h);
     
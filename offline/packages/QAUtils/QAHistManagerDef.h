@@ -28,6 +28,12 @@ namespace QAHistManagerDef
   //! default name for QA histogram manager
   static const std::string HistoManagerName = "QA_HISTOS";
 
+  //! provenance histogram added by saveQARootFile, the build and db tag are in its title
+  static const std::string ProductionInfoName = "h_QAHistManagerDef_ProductionInfo";
+
+  //! prefix of the histograms of a QA module: h_<module>_
+  inline std::string getHistoPrefix(const std::string& module) { return "h_" + module + "_"; }
+
   //! utility function to convert TAxis to log scale binning (usually for x axis)
   void useLogBins(TAxis* axis);
 
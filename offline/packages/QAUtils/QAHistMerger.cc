@@ -0,0 +1,233 @@
+#include "QAHistMerger.h"
+
+#include "QAHistManagerDef.h"
+
+#include <fun4all/TDirectoryHelper.h>
+
+#include <phool/PHThreadPool.h>
+#include <phool/phool.h>  // for PHWHERE
+
+#include <TClass.h>
+#include <TDirectory.h>
+#include <TFile.h>
+#include <TH1.h>
+#include <THnSparse.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TROOT.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <set>
+#include <utility>
+
+QAHistMerger::QAHistMerger(const std::string &outfile)
+  : m_OutFile(outfile)
+{
+}
+
+int QAHistMerger::AddListFile(const std::string &listfile)
+{
+  std::ifstream infile(listfile);
+  if (!infile.is_open())
+  {
+    std::cout << PHWHERE << " could not open list file " << listfile << std::endl;
+    return -1;
+  }
+  std::string line;
+  while (std::getline(infile, line))
+  {
+    // skip empty lines and comments
+    line.erase(0, line.find_first_not_of(" \t"));
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+    AddFile(line);
+  }
+  return 0;
+}
+
+bool QAHistMerger::Selected(const std::string &name) const
+{
+  if (m_Modules.empty() || name == QAHistManagerDef::ProductionInfoName)
+  {
+    return true;
+  }
+  return std::any_of(m_Modules.begin(), m_Modules.end(), [&name](const std::string &module)
+                     { return name.rfind(QAHistManagerDef::getHistoPrefix(module), 0) == 0; });
+}
+
+void QAHistMerger::ReadDirectory(TDirectory *dir, const std::string &path, HistoMap &histos) const
+{
+  // keys of the same name are sorted by cycle, the first one is the latest
+  std::set<std::string> done;
+  TIter next(dir->GetListOfKeys());
+  while (TKey *key = static_cast<TKey *>(next()))
+  {
+    const std::string name = key->GetName();
+    if (!done.insert(name).second)
+    {
+      continue;
+    }
+    const std::string keypath = path.empty() ? name : path + "/" + name;
+    TClass *cl = TClass::GetClass(key->GetClassName());
+    if (!cl)
+    {
+      continue;
+    }
+    if (cl->InheritsFrom(TDirectory::Class()))
+    {
+      ReadDirectory(dir->GetDirectory(name.c_str()), keypath, histos);
+    }
+    else if ((cl->InheritsFrom(TH1::Class()) || cl->InheritsFrom(THnSparse::Class())) && Selected(name))
+    {
+      histos[keypath].reset(key->ReadObj());
+    }
+    else if (m_Verbosity > 1)
+    {
+      std::cout << "QAHistMerger: skipping " << keypath << " (" << key->GetClassName() << ")" << std::endl;
+    }
+  }
+}
+
+int QAHistMerger::AddFileTo(const std::string &filename, HistoMap &sum)
+{
+  std::unique_ptr<TFile> file(TFile::Open(filename.c_str(), "READ"));
+  if (!file || !file->IsOpen() || file->IsZombie())
+  {
+    std::cout << PHWHERE << " could not open " << filename << std::endl;
+    return -1;
+  }
+  if (m_Verbosity > 0)
+  {
+    std::cout << "QAHistMerger: adding " << filename << std::endl;
+  }
+  HistoMap histos;
+  ReadDirectory(file.get(), "", histos);
+  file->Close();
+  AddHistos(sum, histos);
+  return 0;
+}
+
+void QAHistMerger::AddHistos(HistoMap &sum, HistoMap &other)
+{
+  for (auto &[path, obj] : other)
+  {
+    auto iter = sum.find(path);
+    if (iter == sum.end())
+    {
+      sum.emplace(path, std::move(obj));
+      continue;
+    }
+    if (path == QAHistManagerDef::ProductionInfoName)
+    {
+      if (std::string(iter->second->GetTitle()) != obj->GetTitle())
+      {
+        m_ProductionInfoMismatch++;
+      }
+      continue;
+    }
+    if (TH1 *h = dynamic_cast<TH1 *>(iter->second.get()))
+    {
+      // TH1::Merge also handles different axis ranges (e.g. from TH1::SetCanExtend)
+      TList list;
+      list.Add(obj.get());
+      h->Merge(&list);
+    }
+    else if (THnSparse *hs = dynamic_cast<THnSparse *>(iter->second.get()))
+    {
+      if (const THnSparse *otherhs = dynamic_cast<const THnSparse *>(obj.get()))
+      {
+        hs->Add(otherhs);
+      }
+    }
+  }
+  other.clear();
+}
+
+int QAHistMerger::Write(const HistoMap &sum) const
+{
+  TFile outfile(m_OutFile.c_str(), "RECREATE", "QAHistMerger", m_CompressionSetting);
+  if (!outfile.IsOpen())
+  {
+    std::cout << PHWHERE << " could not open output file " << m_OutFile << std::endl;
+    return -1;
+  }
+  for (const auto &[path, obj] : sum)
+  {
+    TDirectory *dir = &outfile;
+    std::string name = path;
+    std::string::size_type pos = path.find_last_of('/');
+    if (pos != std::string::npos)
+    {
+      dir = TDirectoryHelper::mkdir(&outfile, path.substr(0, pos));
+      name = path.substr(pos + 1);
+    }
+    dir->WriteTObject(obj.get(), name.c_str());
+  }
+  outfile.Close();
+  return 0;
+}
+
+int QAHistMerger::Merge()
+{
+  if (m_InputFiles.empty())
+  {
+    std::cout << PHWHERE << " no input files" << std::endl;
+    return -1;
+  }
+  // files are read on several threads, the histograms must not be attached to them
+  ROOT::EnableThreadSafety();
+  const bool adddirectory = TH1::AddDirectoryStatus();
+  TH1::AddDirectory(false);
+
+  PHThreadPool pool(m_NThreads);
+  const size_t ngroups = std::min<size_t>(pool.size(), m_InputFiles.size());
+  std::vector<HistoMap> sums(ngroups);
+  std::vector<unsigned int> nfailed(ngroups, 0);
+
+  // each thread adds a contiguous group of files
+  pool.parallel_for(ngroups, [this, ngroups, &sums, &nfailed](size_t igroup)
+                    {
+                      const size_t first = igroup * m_InputFiles.size() / ngroups;
+                      const size_t last = (igroup + 1) * m_InputFiles.size() / ngroups;
+                      for (size_t i = first; i < last; ++i)
+                      {
+                        if (AddFileTo(m_InputFiles[i], sums[igroup]))
+                        {
+                          nfailed[igroup]++;
+                        }
+                      } });
+
+  // tree reduction of the group sums: 0+1, 2+3, ... then 0+2, ... until all are in sums[0]
+  for (size_t stride = 1; stride < ngroups; stride *= 2)
+  {
+    std::vector<size_t> pairs;
+    for (size_t i = 0; i + stride < ngroups; i += 2 * stride)
+    {
+      pairs.push_back(i);
+    }
+    pool.parallel_for(pairs.size(), [this, stride, &pairs, &sums](size_t i)
+                      { AddHistos(sums[pairs[i]], sums[pairs[i] + stride]); });
+  }
+  TH1::AddDirectory(adddirectory);
+
+  if (m_ProductionInfoMismatch > 0)
+  {
+    std::cout << "QAHistMerger: inputs were produced with a different build or db tag than the first file, see "
+              << QAHistManagerDef::ProductionInfoName << " of the inputs" << std::endl;
+  }
+  const unsigned int nbad = std::accumulate(nfailed.begin(), nfailed.end(), 0U);
+  if (nbad)
+  {
+    std::cout << PHWHERE << " " << nbad << " of " << m_InputFiles.size() << " files could not be read" << std::endl;
+  }
+  std::cout << "QAHistMerger: writing " << sums.front().size() << " histograms from "
+            << m_InputFiles.size() << " files to " << m_OutFile << std::endl;
+  int ret = Write(sums.front());
+  return (ret || nbad) ? -1 : 0;
+}
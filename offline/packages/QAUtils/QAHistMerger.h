@@ -0,0 +1,75 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef QAUTILS_QAHISTMERGER_H
+#define QAUTILS_QAHISTMERGER_H
+
+/*!
+ * \file QAHistMerger.h
+ * \brief parallel merging of the QA histogram files of many jobs
+ *
+ * The input files are split into one group per thread. Each thread adds the
+ * histograms of its files into one copy, and these copies are then added
+ * pairwise (tree reduction). Only two sets of histograms per thread are in
+ * memory at any time, however many files are merged.
+ *
+ * Histograms are matched by their path in the file. The production info
+ * histogram of QAHistManagerDef::saveQARootFile is taken from the first file
+ * and not added, files with a different build or db tag are reported.
+ */
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class TDirectory;
+class TObject;
+
+class QAHistMerger
+{
+ public:
+  explicit QAHistMerger(const std::string &outfile);
+  virtual ~QAHistMerger() = default;
+
+  void AddFile(const std::string &filename) { m_InputFiles.push_back(filename); }
+  //! add the files listed in listfile, one per line
+  int AddListFile(const std::string &listfile);
+  //! merge only the histograms of this QA module (h_<module>_...), can be called for several modules
+  void SelectModule(const std::string &module) { m_Modules.push_back(module); }
+  //! number of threads including the caller, 0 uses all cores
+  void NThreads(const unsigned int n) { m_NThreads = n; }
+  //! compression setting of the output file, e.g. 505 for ZSTD level 5
+  void CompressionSetting(const int setting) { m_CompressionSetting = setting; }
+  void Verbosity(const int i) { m_Verbosity = i; }
+
+  //! merge the input files into the output file, 0 on success
+  int Merge();
+
+ private:
+  using HistoMap = std::map<std::string, std::unique_ptr<TObject>>;
+
+  //! true if the histogram belongs to one of the selected modules
+  bool Selected(const std::string &name) const;
+
+  //! read the histograms of dir (and its subdirectories) into histos
+  void ReadDirectory(TDirectory *dir, const std::string &path, HistoMap &histos) const;
+
+  //! add the histograms of filename to sum
+  int AddFileTo(const std::string &filename, HistoMap &sum);
+
+  //! add the histograms of other to sum, other is emptied
+  void AddHistos(HistoMap &sum, HistoMap &other);
+
+  int Write(const HistoMap &sum) const;
+
+  std::string m_OutFile;
+  std::vector<std::string> m_InputFiles;
+  std::vector<std::string> m_Modules;
+  unsigned int m_NThreads{0};
+  int m_CompressionSetting{9};
+  int m_Verbosity{0};
+  std::atomic<unsigned int> m_ProductionInfoMismatch{0};
+};
+
+#endif
@@ -0,0 +1,83 @@
+// merges QA histogram files with QAHistMerger
+//   qahistmerge [-j nthreads] [-c compression] [-m module]... [-l listfile] outfile [infile...]
+
+#include "QAHistMerger.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace
+{
+  void usage(const char *name)
+  {
+    std::cout << "usage: " << name << " [-j nthreads] [-c compression] [-m module]... [-l listfile] [-v] outfile [infile...]" << std::endl
+              << "  -j  number of threads (default: all cores)" << std::endl
+              << "  -c  compression setting of outfile, e.g. 505 for ZSTD level 5 (default: 9)" << std::endl
+              << "  -m  merge only the histograms of this QA module (h_<module>_...)" << std::endl
+              << "  -l  file with the input files, one per line" << std::endl
+              << "  -v  increase verbosity" << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char *argv[])
+{
+  unsigned int nthreads = 0;
+  int compression = 9;
+  int verbosity = 0;
+  std::vector<std::string> modules;
+  std::vector<std::string> listfiles;
+  int opt;
+  while ((opt = getopt(argc, argv, "j:c:m:l:vh")) != -1)
+  {
+    switch (opt)
+    {
+    case 'j':
+      nthreads = std::strtoul(optarg, nullptr, 10);
+      break;
+    case 'c':
+      compression = std::atoi(optarg);
+      break;
+    case 'm':
+      modules.emplace_back(optarg);
+      break;
+    case 'l':
+      listfiles.emplace_back(optarg);
+      break;
+    case 'v':
+      verbosity++;
+      break;
+    default:
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (optind >= argc)
+  {
+    usage(argv[0]);
+    return 1;
+  }
+  QAHistMerger merger(argv[optind]);
+  merger.NThreads(nthreads);
+  merger.CompressionSetting(compression);
+  merger.Verbosity(verbosity);
+  for (const auto &module : modules)
+  {
+    merger.SelectModule(module);
+  }
+  for (const auto &listfile : listfiles)
+  {
+    if (merger.AddListFile(listfile))
+    {
+      return 1;
+    }
+  }
+  for (int i = optind + 1; i < argc; ++i)
+  {
+    merger.AddFile(argv[i]);
+  }
+  return merger.Merge() ? 1 : 0;
+}
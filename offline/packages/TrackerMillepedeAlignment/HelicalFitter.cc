@@ -33,24 +33,63 @@
 #include <g4main/PHG4Particle.h>  // for PHG4Particle
 
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <TDirectory.h>
 #include <TF1.h>
 #include <TFile.h>
 #include <TNtuple.h>
+#include <TObjString.h>
 
 #include <climits>   // for UINT_MAX
 #include <cmath>     // for fabs, sqrt
 #include <iostream>  // for operator<<, basic_ostream
 #include <memory>
 #include <set>      // for _Rb_tree_const_iterator
+#include <sstream>
+#include <string>
 #include <utility>  // for pair
 
 using namespace std;
 
+namespace
+{
+  // data file name for thread i, the index is inserted before the extension
+  std::string thread_datafile_name(const std::string& filename, unsigned int i)
+  {
+    const auto suffix = "_" + std::to_string(i);
+    const auto pos = filename.rfind('.');
+    const auto slash = filename.rfind('/');
+    if (pos == std::string::npos || (slash != std::string::npos && pos < slash))
+    {
+      return filename + suffix;
+    }
+    return filename.substr(0, pos) + suffix + filename.substr(pos);
+  }
+}  // namespace
+
+//! helical fit of one tracklet, with the cluster positions used by the derivatives
+struct HelicalFitter::TrackletFit
+{
+  bool accepted = false;
+  std::vector<Acts::Vector3> global_vec;
+  std::vector<TrkrDefs::cluskey> cluskey_vec;
+  std::vector<float> fitpars;
+  Acts::Vector3 track_vtx;
+  TrackSeed_v2 someseed;
+  SvtxTrack_v4 newTrack;
+  SvtxAlignmentStateMap::StateVec statevec;
+
+  // cluster counts, negative if not set for this tracklet
+  int nsilicon = -1;
+  int ntpc = -1;
+  int nclus = -1;
+};
+
 // The derivative formulae used in this code follow the derivation in the ATLAS paper
 // Global chi^2 approach to the Alignment of the ATLAS Silicon Tracking Detectors
 // ATL-INDET-PUB-2005-002, 11 October 2005
@@ -59,7 +98,6 @@ using namespace std;
 HelicalFitter::HelicalFitter(const std::string& name)
   : SubsysReco(name)
   , PHParameterInterface(name)
-  , _mille(nullptr)
 {
   InitializeParameters();
 
@@ -87,19 +125,35 @@ int HelicalFitter::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
-  // Instantiate Mille and open output data file
-  if (test_output)
+  m_threadpool.reset();
+  if (m_nthreads != 1)
   {
-    _mille = new Mille(data_outfilename.c_str(), false);  // write text in data files, rather than binary, for debugging only
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    std::cout << "HelicalFitter::InitRun - fitting tracks with " << m_threadpool->size() << " threads" << std::endl;
   }
-  else
+
+  // Instantiate Mille and open output data file
+  // derivatives are computed in parallel only without the ntuple, each thread then writes its own data file
+  std::vector<std::string> datafiles = {data_outfilename};
+  if (m_threadpool && !make_ntuple)
   {
-    _mille = new Mille(data_outfilename.c_str());
+    for (unsigned int i = 1; i < m_threadpool->size(); ++i)
+    {
+      datafiles.push_back(thread_datafile_name(data_outfilename, i));
+    }
   }
 
-  // Write the steering file here, and add the data file path to it
+  // a job resumed from a checkpoint continues the data files, the records after the checkpoint are dropped in RestoreCheckpoint
+  const bool append = Fun4AllServer::instance()->ResumingFromCheckpoint();
+
+  // Write the steering file here, and add the data file paths to it
   std::ofstream steering_file(steering_outfilename);
-  steering_file << data_outfilename << std::endl;
+  for (const auto& datafile : datafiles)
+  {
+    // write text in data files, rather than binary, if test_output is set, for debugging only
+    _mille.push_back(new Mille(datafile.c_str(), !test_output, false, append));
+    steering_file << datafile << std::endl;
+  }
   steering_file.close();
 
   if (make_ntuple)
@@ -195,16 +249,6 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 
   // Decide whether we want to make a helical fit for silicon or TPC
   unsigned int maxtracks = 0;
-  unsigned int nsilicon = 0;
-  unsigned int ntpc = 0;
-  unsigned int nclus = 0;
-  std::vector<std::vector<Acts::Vector3>> cumulative_global_vec;
-  std::vector<std::vector<TrkrDefs::cluskey>> cumulative_cluskey_vec;
-  std::vector<std::vector<float>> cumulative_fitpars_vec;
-  std::vector<Acts::Vector3> cumulative_vertex;
-  std::vector<TrackSeed> cumulative_someseed;
-  std::vector<SvtxTrack_v4> cumulative_newTrack;
-
   if (fittpc && _track_map_tpc != nullptr)
   {
     maxtracks = _track_map_tpc->size();
@@ -213,55 +257,152 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
   {
     maxtracks = _track_map_silicon->size();
   }
+
+  // fit the tracklets
+  std::vector<TrackletFit> fits(maxtracks);
+  if (m_threadpool && Verbosity() == 0)
+  {
+    m_threadpool->parallel_for(maxtracks, [&](size_t trackid)
+                               { fitTracklet(trackid, fits[trackid]); });
+  }
+  else
+  {
+    for (unsigned int trackid = 0; trackid < maxtracks; ++trackid)
+    {
+      fitTracklet(trackid, fits[trackid]);
+    }
+  }
+
+  // accepted tracklets in order
+  // the cluster counts stored in the ntuple are those of the last tracklet that set them
+  unsigned int nsilicon = 0;
+  unsigned int ntpc = 0;
+  unsigned int nclus = 0;
+  std::vector<unsigned int> accepted;
   for (unsigned int trackid = 0; trackid < maxtracks; ++trackid)
   {
-    TrackSeed* tracklet = nullptr;
-    if (fitsilicon && _track_map_silicon != nullptr)
+    const auto& fit = fits[trackid];
+    if (fit.nsilicon >= 0)
     {
-      tracklet = _track_map_silicon->get(trackid);
+      nsilicon = fit.nsilicon;
     }
-    else if (fittpc && _track_map_tpc != nullptr)
+    if (fit.ntpc >= 0)
     {
-      tracklet = _track_map_tpc->get(trackid);
+      ntpc = fit.ntpc;
     }
-    if (!tracklet)
+    if (fit.nclus >= 0)
     {
-      continue;
+      nclus = fit.nclus;
     }
+    if (fit.accepted)
+    {
+      accepted.push_back(trackid);
+    }
+  }
 
-    std::vector<Acts::Vector3> global_vec;
-    std::vector<TrkrDefs::cluskey> cluskey_vec;
+  // terminate loop over tracks
+  // Collect fitpars for each track by intializing array of size maxtracks and populaating thorughout the loop
+  // Then start new loop over tracks and for each track go over clsutaer
+  //  make vector of global_vecs
+  float xsum = 0;
+  float ysum = 0;
+  float zsum = 0;
+  unsigned int accepted_tracks = accepted.size();
+
+  for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+  {
+    const auto& track_vtx = fits[accepted[trackid]].track_vtx;
+    xsum += track_vtx[0];
+    ysum += track_vtx[1];
+    zsum += track_vtx[2];
+  }
+  Acts::Vector3 averageVertex(xsum / accepted_tracks, ysum / accepted_tracks, zsum / accepted_tracks);
 
-    // Get a vector of cluster keys from the tracklet
-    getTrackletClusterList(tracklet, cluskey_vec);
-    if(cluskey_vec.size() < 3)
+  // residuals and derivatives
+  if (m_threadpool && _mille.size() > 1 && !make_ntuple && Verbosity() == 0)
+  {
+    // contiguous ranges of tracks, each written to the data file of its range
+    const size_t nchunks = _mille.size();
+    m_threadpool->parallel_for(nchunks, [&](size_t ichunk)
+                               {
+      for (unsigned int trackid = ichunk * accepted_tracks / nchunks; trackid < (ichunk + 1) * accepted_tracks / nchunks; ++trackid)
       {
-	continue;
-      }
-    int nintt = 0;
-    for (auto& key : cluskey_vec)
+        processTrack(trackid, fits[accepted[trackid]], _mille[ichunk], averageVertex, accepted_tracks, nsilicon, ntpc, nclus);
+      } });
+  }
+  else
+  {
+    for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
     {
-      if(TrkrDefs::getTrkrId(key) == TrkrDefs::inttId)
-      {
-        nintt++;
-      }
+      processTrack(trackid, fits[accepted[trackid]], _mille.front(), averageVertex, accepted_tracks, nsilicon, ntpc, nclus);
     }
+  }
 
-    // store cluster global positions in a vector global_vec and cluskey_vec
+  // store tracks and alignment states
+  for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+  {
+    auto& fit = fits[accepted[trackid]];
+    m_alignmentmap->insertWithKey(trackid, fit.statevec);
+    m_trackmap->insertWithKey(&fit.newTrack, trackid);
+  }
 
-    TrackFitUtils::getTrackletClusters(_tGeometry, _cluster_map, global_vec, cluskey_vec);
-     
-    correctTpcGlobalPositions(global_vec, cluskey_vec);
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//____________________________________________________________________________..
+void HelicalFitter::fitTracklet(unsigned int trackid, TrackletFit& fit)
+{
+  // cluster counts of this tracklet, the ones not used by the fit mode stay zero
+  unsigned int nsilicon = 0;
+  unsigned int ntpc = 0;
+
+  TrackSeed* tracklet = nullptr;
+  if (fitsilicon && _track_map_silicon != nullptr)
+  {
+    tracklet = _track_map_silicon->get(trackid);
+  }
+  else if (fittpc && _track_map_tpc != nullptr)
+  {
+    tracklet = _track_map_tpc->get(trackid);
+  }
+  if (!tracklet)
+  {
+    return;
+  }
+
+  std::vector<Acts::Vector3> global_vec;
+  std::vector<TrkrDefs::cluskey> cluskey_vec;
+
+  // Get a vector of cluster keys from the tracklet
+  getTrackletClusterList(tracklet, cluskey_vec);
+  if(cluskey_vec.size() < 3)
+    {
+	return;
+    }
+  int nintt = 0;
+  for (auto& key : cluskey_vec)
+  {
+    if(TrkrDefs::getTrkrId(key) == TrkrDefs::inttId)
+    {
+      nintt++;
+    }
+  }
+
+  // store cluster global positions in a vector global_vec and cluskey_vec
+
+  TrackFitUtils::getTrackletClusters(_tGeometry, _cluster_map, global_vec, cluskey_vec);
+   
+  correctTpcGlobalPositions(global_vec, cluskey_vec);
 
  
-    std::vector<float> fitpars;
-    if(straight_line_fit)
-      {
+  std::vector<float> fitpars;
+  if(straight_line_fit)
+    {
 	fitpars = TrackFitUtils::fitClustersZeroField(global_vec, cluskey_vec, use_intt_zfit);
 
 	if (fitpars.size() == 0)
 	  {
-	    continue;  // discard this track, not enough clusters to fit
+	    return;  // discard this track, not enough clusters to fit
 	  }
 
 	if (Verbosity() > 1)
@@ -269,19 +410,19 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	    std::cout << " Track " << trackid << " xy slope " << fitpars[0] << " y intercept " << fitpars[1] 
 		      << " zslope " << fitpars[2] << " Z0 " << fitpars[3] << std::endl;
 	  }
-      }
-    else
-      {
+    }
+  else
+    {
 	if(fitsilicon && nintt<2)
 	  {
-	    continue;   // discard incomplete seeds
+	    return;   // discard incomplete seeds
 	  }
 
 	fitpars = TrackFitUtils::fitClusters(global_vec, cluskey_vec);  // do helical fit
-      
+    
 	if (fitpars.size() == 0)
 	  {
-	    continue;  // discard this track, not enough clusters to fit
+	    return;  // discard this track, not enough clusters to fit
 	  }
 
 	if (Verbosity() > 1)
@@ -289,62 +430,64 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	    std::cout << " Track " << trackid << " radius " << fitpars[0] << " X0 " << fitpars[1] << " Y0 " << fitpars[2]
 		      << " zslope " << fitpars[3] << " Z0 " << fitpars[4] << std::endl;
 	  }
-      }
-    
-
-    //// Create a track map for diagnostics
-    SvtxTrack_v4 newTrack;
-    newTrack.set_id(trackid);
-    if (fitsilicon)
-    {
-      newTrack.set_silicon_seed(tracklet);
-    }
-    else if (fittpc)
-    {
-      newTrack.set_tpc_seed(tracklet);
     }
+  
 
-    // if a full track is requested, get the silicon clusters too and refit
-    if (fittpc && fitfulltrack)
-    {
-      // this associates silicon clusters and adds them to the vectors
-      ntpc = cluskey_vec.size();
+  //// Create a track map for diagnostics
+  SvtxTrack_v4 newTrack;
+  newTrack.set_id(trackid);
+  if (fitsilicon)
+  {
+    newTrack.set_silicon_seed(tracklet);
+  }
+  else if (fittpc)
+  {
+    newTrack.set_tpc_seed(tracklet);
+  }
 
-      if(straight_line_fit)
+  // if a full track is requested, get the silicon clusters too and refit
+  if (fittpc && fitfulltrack)
+  {
+    // this associates silicon clusters and adds them to the vectors
+    ntpc = cluskey_vec.size();
+    fit.ntpc = ntpc;
+
+    if(straight_line_fit)
 	{
 	  std::tuple<double, double> linefit_xy(fitpars[0], fitpars[1]); 
 	  nsilicon = TrackFitUtils::addClustersOnLine(linefit_xy, true, dca_cut, _tGeometry, _cluster_map, global_vec, cluskey_vec, 0, 6);
 	}
-      else
+    else
 	{
 	  nsilicon = TrackFitUtils::addClusters(fitpars, dca_cut, _tGeometry, _cluster_map, global_vec, cluskey_vec, 0, 6);
 	}
+    fit.nsilicon = nsilicon;
 
-      if (nsilicon < 5)
-      {
-        continue;  // discard this TPC seed, did not get a good match to silicon
-      }
-      auto trackseed = std::make_unique<TrackSeed_v2>();
-      for (auto& ckey : cluskey_vec)
+    if (nsilicon < 5)
+    {
+      return;  // discard this TPC seed, did not get a good match to silicon
+    }
+    auto trackseed = std::make_unique<TrackSeed_v2>();
+    for (auto& ckey : cluskey_vec)
+    {
+      if (TrkrDefs::getTrkrId(ckey) == TrkrDefs::TrkrId::mvtxId or
+          TrkrDefs::getTrkrId(ckey) == TrkrDefs::TrkrId::inttId)
       {
-        if (TrkrDefs::getTrkrId(ckey) == TrkrDefs::TrkrId::mvtxId or
-            TrkrDefs::getTrkrId(ckey) == TrkrDefs::TrkrId::inttId)
-        {
-          trackseed->insert_cluster_key(ckey);
-        }
+        trackseed->insert_cluster_key(ckey);
       }
+    }
 
-      newTrack.set_silicon_seed(trackseed.get());
+    newTrack.set_silicon_seed(trackseed.get());
 
-      // fit the full track now
-      fitpars.clear();
-      if(straight_line_fit)
+    // fit the full track now
+    fitpars.clear();
+    if(straight_line_fit)
 	{
 	  fitpars = TrackFitUtils::fitClustersZeroField(global_vec, cluskey_vec, use_intt_zfit);
 	    
 	  if (fitpars.size() == 0)
 	    {
-	      continue;  // discard this track, not enough clusters to fit
+	      return;  // discard this track, not enough clusters to fit
 	    }
 	  
 	  if (Verbosity() > 1)
@@ -353,13 +496,13 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 			<< " dx/dz " << fitpars[2] << " Z0 " << fitpars[3] << std::endl;
 	    }
 	}
-      else
+    else
 	{
 	  fitpars = TrackFitUtils::fitClusters(global_vec, cluskey_vec, use_intt_zfit);  // do helical fit
 
 	  if (fitpars.size() == 0)
 	    {
-	      continue;  // discard this track, fit failed
+	      return;  // discard this track, fit failed
 	    }
 
 	  if (Verbosity() > 1)
@@ -368,48 +511,50 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 			<< " zslope " << fitpars[3] << " Z0 " << fitpars[4] << std::endl;
 	    }
 	}
-    }
-    else if (fitsilicon)
-    {
-      nsilicon = cluskey_vec.size();
-    }
-    else if (fittpc && !fitfulltrack)
-    {
-      ntpc = cluskey_vec.size();
-    }
+  }
+  else if (fitsilicon)
+  {
+    nsilicon = cluskey_vec.size();
+    fit.nsilicon = nsilicon;
+  }
+  else if (fittpc && !fitfulltrack)
+  {
+    ntpc = cluskey_vec.size();
+    fit.ntpc = ntpc;
+  }
 
-    Acts::Vector3 beamline(0, 0, 0);
-    Acts::Vector2 pca2d;
-    Acts::Vector3 track_vtx;
-    if(straight_line_fit)
-      {
+  Acts::Vector3 beamline(0, 0, 0);
+  Acts::Vector2 pca2d;
+  Acts::Vector3 track_vtx;
+  if(straight_line_fit)
+    {
 	pca2d = TrackFitUtils::get_line_point_pca(fitpars[0], fitpars[1], beamline);
 	track_vtx(0) = pca2d(0);
 	track_vtx(1) = pca2d(1);
 	track_vtx(2) = fitpars[3];   // z axis intercept
-      }
-    else
-      {
+    }
+  else
+    {
 	pca2d = TrackFitUtils::get_circle_point_pca(fitpars[0], fitpars[1], fitpars[2], beamline);
 	track_vtx(0) = pca2d(0);
 	track_vtx(1) = pca2d(1);
 	track_vtx(2) = fitpars[4];   // z axis intercept
-      }
+    }
 
-    newTrack.set_crossing(tracklet->get_crossing());
-    newTrack.set_id(trackid);
+  newTrack.set_crossing(tracklet->get_crossing());
+  newTrack.set_id(trackid);
 
-    /// use the track seed functions to help get the track trajectory values
-    /// in the usual coordinates
+  /// use the track seed functions to help get the track trajectory values
+  /// in the usual coordinates
 
-    TrackSeed_v2 someseed;
-    for (auto& ckey : cluskey_vec)
-    {
-      someseed.insert_cluster_key(ckey);
-    }
+  TrackSeed_v2 someseed;
+  for (auto& ckey : cluskey_vec)
+  {
+    someseed.insert_cluster_key(ckey);
+  }
 
-    if(straight_line_fit)
-      {
+  if(straight_line_fit)
+    {
 	someseed.set_qOverR(1.0);
 	someseed.set_phi(tracklet->get_phi());
 	
@@ -426,9 +571,9 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	newTrack.set_py(tangent.second(1));
 	newTrack.set_pz(tangent.second(2));
 	newTrack.set_charge(tracklet->get_charge());
-      }
-    else
-      {
+    }
+  else
+    {
 	someseed.set_qOverR(tracklet->get_charge() / fitpars[0]);
 	someseed.set_phi(tracklet->get_phi());
 	
@@ -446,296 +591,281 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	newTrack.set_py(someseed.get_py());
 	newTrack.set_pz(someseed.get_pz());
 	newTrack.set_charge(tracklet->get_charge());
-      }	
+    }	
 	    
-    nclus = ntpc + nsilicon;
+  fit.nclus = ntpc + nsilicon;
 
-    // some basic track quality requirements
-    if (fittpc && ntpc < 35)
+  // some basic track quality requirements
+  if (fittpc && ntpc < 35)
+  {
+    if (Verbosity() > 1)
     {
-      if (Verbosity() > 1)
-      {
-        std::cout << " reject this track, ntpc = " << ntpc << std::endl;
-      }
-      continue;
+      std::cout << " reject this track, ntpc = " << ntpc << std::endl;
     }
-    if ((fitsilicon || fitfulltrack) && nsilicon < 3)
+    return;
+  }
+  if ((fitsilicon || fitfulltrack) && nsilicon < 3)
+  {
+    if (Verbosity() > 1)
     {
-      if (Verbosity() > 1)
-      {
-        std::cout << " reject this track, nsilicon = " << nsilicon << std::endl;
-      }
-      continue;
+      std::cout << " reject this track, nsilicon = " << nsilicon << std::endl;
     }
-
-    cumulative_global_vec.push_back(global_vec);
-    cumulative_cluskey_vec.push_back(cluskey_vec);
-    cumulative_vertex.push_back(track_vtx);
-    cumulative_fitpars_vec.push_back(fitpars);
-    cumulative_someseed.push_back(someseed);
-    cumulative_newTrack.push_back(newTrack);
+    return;
   }
 
-  // terminate loop over tracks
-  // Collect fitpars for each track by intializing array of size maxtracks and populaating thorughout the loop
-  // Then start new loop over tracks and for each track go over clsutaer
-  //  make vector of global_vecs
-  float xsum = 0;
-  float ysum = 0;
-  float zsum = 0;
-  unsigned int accepted_tracks = cumulative_fitpars_vec.size();
-
-  for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
-  {
-    xsum += cumulative_vertex[trackid][0];
-    ysum += cumulative_vertex[trackid][1];
-    zsum += cumulative_vertex[trackid][2];
-  }
-  Acts::Vector3 averageVertex(xsum / accepted_tracks, ysum / accepted_tracks, zsum / accepted_tracks);
+  fit.accepted = true;
+  fit.global_vec = global_vec;
+  fit.cluskey_vec = cluskey_vec;
+  fit.track_vtx = track_vtx;
+  fit.fitpars = fitpars;
+  fit.someseed = someseed;
+  fit.newTrack = newTrack;
+}
 
-  for (unsigned int trackid = 0; trackid < accepted_tracks; ++trackid)
+//____________________________________________________________________________..
+void HelicalFitter::processTrack(unsigned int trackid, TrackletFit& fit, Mille* mille, const Acts::Vector3& averageVertex, unsigned int accepted_tracks, unsigned int nsilicon, unsigned int ntpc, unsigned int nclus)
+{
+  auto& global_vec = fit.global_vec;
+  auto& cluskey_vec = fit.cluskey_vec;
+  auto& fitpars = fit.fitpars;
+  auto& someseed = fit.someseed;
+  auto& newTrack = fit.newTrack;
+  auto& statevec = fit.statevec;
+
+  // get the residuals and derivatives for all clusters
+  for (unsigned int ivec = 0; ivec < global_vec.size(); ++ivec)
   {
-    auto global_vec = cumulative_global_vec[trackid];
-    auto cluskey_vec = cumulative_cluskey_vec[trackid];
-    auto fitpars = cumulative_fitpars_vec[trackid];
-    auto someseed = cumulative_someseed[trackid];
-    auto newTrack = cumulative_newTrack[trackid];
-    SvtxAlignmentStateMap::StateVec statevec;
-
-    // get the residuals and derivatives for all clusters
-    for (unsigned int ivec = 0; ivec < global_vec.size(); ++ivec)
+    auto global = global_vec[ivec];
+    auto cluskey = cluskey_vec[ivec];
+    auto cluster = _cluster_map->findCluster(cluskey);
+    if (!cluster)
     {
-      auto global = global_vec[ivec];
-      auto cluskey = cluskey_vec[ivec];
-      auto cluster = _cluster_map->findCluster(cluskey);
-      if (!cluster)
-      {
-        continue;
-      }
+      continue;
+    }
 
-      unsigned int trkrid = TrkrDefs::getTrkrId(cluskey);
+    unsigned int trkrid = TrkrDefs::getTrkrId(cluskey);
 
-      // What we need now is to find the point on the surface at which the helix would intersect
-      // If we have that point, we can transform the fit back to local coords
-      // we have fitpars for the helix, and the cluster key - from which we get the surface
+    // What we need now is to find the point on the surface at which the helix would intersect
+    // If we have that point, we can transform the fit back to local coords
+    // we have fitpars for the helix, and the cluster key - from which we get the surface
 
-      Surface surf = _tGeometry->maps().getSurface(cluskey, cluster);
-      Acts::Vector3 helix_pca(0, 0, 0);
-      Acts::Vector3 helix_tangent(0, 0, 0);
-      Acts::Vector3 fitpoint;
-      if(straight_line_fit)
+    Surface surf = _tGeometry->maps().getSurface(cluskey, cluster);
+    Acts::Vector3 helix_pca(0, 0, 0);
+    Acts::Vector3 helix_tangent(0, 0, 0);
+    Acts::Vector3 fitpoint;
+    if(straight_line_fit)
 	{
 	  fitpoint = get_line_surface_intersection(surf, fitpars);
 	}
-      else
+    else
 	{
 	  fitpoint = get_helix_surface_intersection(surf, fitpars, global, helix_pca, helix_tangent);
 	}
 
-      // fitpoint is the point where the helical fit intersects the plane of the surface
-      // Now transform the helix fitpoint to local coordinates to compare with cluster local coordinates
-      Acts::Vector3 fitpoint_local = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (fitpoint * Acts::UnitConstants::cm);
+    // fitpoint is the point where the helical fit intersects the plane of the surface
+    // Now transform the helix fitpoint to local coordinates to compare with cluster local coordinates
+    Acts::Vector3 fitpoint_local = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (fitpoint * Acts::UnitConstants::cm);
 
-      fitpoint_local /= Acts::UnitConstants::cm;
+    fitpoint_local /= Acts::UnitConstants::cm;
 
-      auto xloc = cluster->getLocalX();  // in cm
-      auto zloc = cluster->getLocalY();
+    auto xloc = cluster->getLocalX();  // in cm
+    auto zloc = cluster->getLocalY();
 
-      if (trkrid == TrkrDefs::tpcId)
-      {
-        zloc = convertTimeToZ(cluskey, cluster);
-      }
+    if (trkrid == TrkrDefs::tpcId)
+    {
+      zloc = convertTimeToZ(cluskey, cluster);
+    }
 
-      Acts::Vector2 residual(xloc - fitpoint_local(0), zloc - fitpoint_local(1));
+    Acts::Vector2 residual(xloc - fitpoint_local(0), zloc - fitpoint_local(1));
 
-      unsigned int layer = TrkrDefs::getLayer(cluskey_vec[ivec]);
-      float phi = atan2(global(1), global(0));
+    unsigned int layer = TrkrDefs::getLayer(cluskey_vec[ivec]);
+    float phi = atan2(global(1), global(0));
 
-      SvtxTrackState_v1 svtxstate(fitpoint.norm());
-      svtxstate.set_x(fitpoint(0));
-      svtxstate.set_y(fitpoint(1));
-      svtxstate.set_z(fitpoint(2));
-      std::pair<Acts::Vector3, Acts::Vector3> tangent;
-      if(straight_line_fit)
+    SvtxTrackState_v1 svtxstate(fitpoint.norm());
+    svtxstate.set_x(fitpoint(0));
+    svtxstate.set_y(fitpoint(1));
+    svtxstate.set_z(fitpoint(2));
+    std::pair<Acts::Vector3, Acts::Vector3> tangent;
+    if(straight_line_fit)
 	{
 	  tangent = get_line_tangent(fitpars, global);
 	}
-      else
+    else
 	{
 	  tangent = get_helix_tangent(fitpars, global);
 	}
 
-      svtxstate.set_px(someseed.get_p() * tangent.second.x());
-      svtxstate.set_py(someseed.get_p() * tangent.second.y());
-      svtxstate.set_pz(someseed.get_p() * tangent.second.z());
-      newTrack.insert_state(&svtxstate);
+    svtxstate.set_px(someseed.get_p() * tangent.second.x());
+    svtxstate.set_py(someseed.get_p() * tangent.second.y());
+    svtxstate.set_pz(someseed.get_p() * tangent.second.z());
+    newTrack.insert_state(&svtxstate);
 
-      if (Verbosity() > 1)
-      {
-        Acts::Vector3 loc_check = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (global * Acts::UnitConstants::cm);
-        loc_check /= Acts::UnitConstants::cm;
-        std::cout << "    layer " << layer << std::endl
-                  << " cluster global " << global(0) << " " << global(1) << " " << global(2) << std::endl
-                  << " fitpoint " << fitpoint(0) << " " << fitpoint(1) << " " << fitpoint(2) << std::endl
-                  << " fitpoint_local " << fitpoint_local(0) << " " << fitpoint_local(1) << " " << fitpoint_local(2) << std::endl
-                  << " cluster local x " << cluster->getLocalX() << " cluster local y " << cluster->getLocalY() << std::endl
-                  << " cluster global to local x " << loc_check(0) << " local y " << loc_check(1) << "  local z " << loc_check(2) << std::endl
-                  << " cluster local residual x " << residual(0) << " cluster local residual y " << residual(1) << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      Acts::Vector3 loc_check = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (global * Acts::UnitConstants::cm);
+      loc_check /= Acts::UnitConstants::cm;
+      std::cout << "    layer " << layer << std::endl
+                << " cluster global " << global(0) << " " << global(1) << " " << global(2) << std::endl
+                << " fitpoint " << fitpoint(0) << " " << fitpoint(1) << " " << fitpoint(2) << std::endl
+                << " fitpoint_local " << fitpoint_local(0) << " " << fitpoint_local(1) << " " << fitpoint_local(2) << std::endl
+                << " cluster local x " << cluster->getLocalX() << " cluster local y " << cluster->getLocalY() << std::endl
+                << " cluster global to local x " << loc_check(0) << " local y " << loc_check(1) << "  local z " << loc_check(2) << std::endl
+                << " cluster local residual x " << residual(0) << " cluster local residual y " << residual(1) << std::endl;
+    }
 
-      if (Verbosity() > 1)
-      {
-        Acts::Transform3 transform = surf->transform(_tGeometry->geometry().getGeoContext());
-        std::cout << "Transform is:" << std::endl;
-        std::cout << transform.matrix() << std::endl;
-        Acts::Vector3 loc_check = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (global * Acts::UnitConstants::cm);
-        loc_check /= Acts::UnitConstants::cm;
-        unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
-        unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
-        std::cout << "    layer " << layer << " sector " << sector << " side " << side << " subsurf " << cluster->getSubSurfKey() << std::endl
-                  << " cluster global " << global(0) << " " << global(1) << " " << global(2) << std::endl
-                  << " fitpoint " << fitpoint(0) << " " << fitpoint(1) << " " << fitpoint(2) << std::endl
-                  << " fitpoint_local " << fitpoint_local(0) << " " << fitpoint_local(1) << " " << fitpoint_local(2) << std::endl
-                  << " cluster local x " << cluster->getLocalX() << " cluster local y " << cluster->getLocalY() << std::endl
-                  << " cluster global to local x " << loc_check(0) << " local y " << loc_check(1) << "  local z " << loc_check(2) << std::endl
-                  << " cluster local residual x " << residual(0) << " cluster local residual y " << residual(1) << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      Acts::Transform3 transform = surf->transform(_tGeometry->geometry().getGeoContext());
+      std::cout << "Transform is:" << std::endl;
+      std::cout << transform.matrix() << std::endl;
+      Acts::Vector3 loc_check = surf->transform(_tGeometry->geometry().getGeoContext()).inverse() * (global * Acts::UnitConstants::cm);
+      loc_check /= Acts::UnitConstants::cm;
+      unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
+      unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
+      std::cout << "    layer " << layer << " sector " << sector << " side " << side << " subsurf " << cluster->getSubSurfKey() << std::endl
+                << " cluster global " << global(0) << " " << global(1) << " " << global(2) << std::endl
+                << " fitpoint " << fitpoint(0) << " " << fitpoint(1) << " " << fitpoint(2) << std::endl
+                << " fitpoint_local " << fitpoint_local(0) << " " << fitpoint_local(1) << " " << fitpoint_local(2) << std::endl
+                << " cluster local x " << cluster->getLocalX() << " cluster local y " << cluster->getLocalY() << std::endl
+                << " cluster global to local x " << loc_check(0) << " local y " << loc_check(1) << "  local z " << loc_check(2) << std::endl
+                << " cluster local residual x " << residual(0) << " cluster local residual y " << residual(1) << std::endl;
+    }
 
-      // need standard deviation of measurements
-      Acts::Vector2 clus_sigma = getClusterError(cluster, cluskey, global);
-      if (isnan(clus_sigma(0)) || isnan(clus_sigma(1)))
-      {
-        continue;
-      }
+    // need standard deviation of measurements
+    Acts::Vector2 clus_sigma = getClusterError(cluster, cluskey, global);
+    if (isnan(clus_sigma(0)) || isnan(clus_sigma(1)))
+    {
+      continue;
+    }
 
-      int glbl_label[AlignmentDefs::NGL];
-      if (layer < 3)
-      {
-        AlignmentDefs::getMvtxGlobalLabels(surf, cluskey, glbl_label, mvtx_grp);
-      }
-      else if (layer > 2 && layer < 7)
-      {
-        AlignmentDefs::getInttGlobalLabels(surf, cluskey, glbl_label, intt_grp);
-      }
-      else if (layer < 55)
-      {
-        AlignmentDefs::getTpcGlobalLabels(surf, cluskey, glbl_label, tpc_grp);
-      }
-      else
-      {
-        continue;
-      }
+    int glbl_label[AlignmentDefs::NGL];
+    if (layer < 3)
+    {
+      AlignmentDefs::getMvtxGlobalLabels(surf, cluskey, glbl_label, mvtx_grp);
+    }
+    else if (layer > 2 && layer < 7)
+    {
+      AlignmentDefs::getInttGlobalLabels(surf, cluskey, glbl_label, intt_grp);
+    }
+    else if (layer < 55)
+    {
+      AlignmentDefs::getTpcGlobalLabels(surf, cluskey, glbl_label, tpc_grp);
+    }
+    else
+    {
+      continue;
+    }
 
-      // These derivatives are for the local parameters
-      float lcl_derivativeX[AlignmentDefs::NLC] = {0., 0., 0., 0., 0.};
-      float lcl_derivativeY[AlignmentDefs::NLC] = {0., 0., 0., 0., 0.};
-      if(straight_line_fit)
+    // These derivatives are for the local parameters
+    float lcl_derivativeX[AlignmentDefs::NLC] = {0., 0., 0., 0., 0.};
+    float lcl_derivativeY[AlignmentDefs::NLC] = {0., 0., 0., 0., 0.};
+    if(straight_line_fit)
 	{
 	  getLocalDerivativesZeroFieldXY(surf, global, fitpars, lcl_derivativeX, lcl_derivativeY, layer);
 	}
-      else
+    else
 	{
 	  getLocalDerivativesXY(surf, global, fitpars, lcl_derivativeX, lcl_derivativeY, layer);
 	}
 
-      // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
-      float glbl_derivativeX[AlignmentDefs::NGL];
-      float glbl_derivativeY[AlignmentDefs::NGL];
-      getGlobalDerivativesXY(surf, global, fitpoint, fitpars, glbl_derivativeX, glbl_derivativeY, layer);
-
-      auto alignmentstate = std::make_unique<SvtxAlignmentState_v1>();
-      alignmentstate->set_residual(residual);
-      alignmentstate->set_cluster_key(cluskey);
-      SvtxAlignmentState::GlobalMatrix svtxglob =
-          SvtxAlignmentState::GlobalMatrix::Zero();
-      SvtxAlignmentState::LocalMatrix svtxloc =
-          SvtxAlignmentState::LocalMatrix::Zero();
-      for (int i = 0; i < AlignmentDefs::NLC; i++)
-      {
-        svtxloc(0, i) = lcl_derivativeX[i];
-        svtxloc(1, i) = lcl_derivativeY[i];
-      }
-      for (int i = 0; i < AlignmentDefs::NGL; i++)
-      {
-        svtxglob(0, i) = glbl_derivativeX[i];
-        svtxglob(1, i) = glbl_derivativeY[i];
-      }
+    // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
+    float glbl_derivativeX[AlignmentDefs::NGL];
+    float glbl_derivativeY[AlignmentDefs::NGL];
+    getGlobalDerivativesXY(surf, global, fitpoint, fitpars, glbl_derivativeX, glbl_derivativeY, layer);
+
+    auto alignmentstate = std::make_unique<SvtxAlignmentState_v1>();
+    alignmentstate->set_residual(residual);
+    alignmentstate->set_cluster_key(cluskey);
+    SvtxAlignmentState::GlobalMatrix svtxglob =
+        SvtxAlignmentState::GlobalMatrix::Zero();
+    SvtxAlignmentState::LocalMatrix svtxloc =
+        SvtxAlignmentState::LocalMatrix::Zero();
+    for (int i = 0; i < AlignmentDefs::NLC; i++)
+    {
+      svtxloc(0, i) = lcl_derivativeX[i];
+      svtxloc(1, i) = lcl_derivativeY[i];
+    }
+    for (int i = 0; i < AlignmentDefs::NGL; i++)
+    {
+      svtxglob(0, i) = glbl_derivativeX[i];
+      svtxglob(1, i) = glbl_derivativeY[i];
+    }
 
-      alignmentstate->set_local_derivative_matrix(svtxloc);
-      alignmentstate->set_global_derivative_matrix(svtxglob);
+    alignmentstate->set_local_derivative_matrix(svtxloc);
+    alignmentstate->set_global_derivative_matrix(svtxglob);
 
-      statevec.push_back(alignmentstate.release());
+    statevec.push_back(alignmentstate.release());
 
-      for (unsigned int i = 0; i < AlignmentDefs::NGL; ++i)
+    for (unsigned int i = 0; i < AlignmentDefs::NGL; ++i)
+    {
+      if (trkrid == TrkrDefs::mvtxId)
       {
-        if (trkrid == TrkrDefs::mvtxId)
+        // need stave to get clamshell
+        auto stave = MvtxDefs::getStaveId(cluskey_vec[ivec]);
+        auto clamshell = AlignmentDefs::getMvtxClamshell(layer, stave);
+        if (is_layer_param_fixed(layer, i) || is_mvtx_layer_fixed(layer, clamshell))
         {
-          // need stave to get clamshell
-          auto stave = MvtxDefs::getStaveId(cluskey_vec[ivec]);
-          auto clamshell = AlignmentDefs::getMvtxClamshell(layer, stave);
-          if (is_layer_param_fixed(layer, i) || is_mvtx_layer_fixed(layer, clamshell))
-          {
-            glbl_derivativeX[i] = 0;
-            glbl_derivativeY[i] = 0;
-          }
+          glbl_derivativeX[i] = 0;
+          glbl_derivativeY[i] = 0;
         }
+      }
 
-        if (trkrid == TrkrDefs::inttId)
+      if (trkrid == TrkrDefs::inttId)
+      {
+        if (is_layer_param_fixed(layer, i) || is_intt_layer_fixed(layer))
         {
-          if (is_layer_param_fixed(layer, i) || is_intt_layer_fixed(layer))
-          {
-            glbl_derivativeX[i] = 0;
-            glbl_derivativeY[i] = 0;
-          }
+          glbl_derivativeX[i] = 0;
+          glbl_derivativeY[i] = 0;
         }
+      }
 
-        if (trkrid == TrkrDefs::tpcId)
+      if (trkrid == TrkrDefs::tpcId)
+      {
+        unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
+        unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
+        if (is_layer_param_fixed(layer, i) || is_tpc_sector_fixed(layer, sector, side))
         {
-          unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
-          unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
-          if (is_layer_param_fixed(layer, i) || is_tpc_sector_fixed(layer, sector, side))
-          {
-            glbl_derivativeX[i] = 0;
-            glbl_derivativeY[i] = 0;
-          }
+          glbl_derivativeX[i] = 0;
+          glbl_derivativeY[i] = 0;
         }
       }
+    }
 
-      // Add the measurement separately for each coordinate direction to Mille
-      // set the derivatives non-zero only for parameters we want to be optimized
-      // local parameter numbering is arbitrary:
-      float errinf = 1.0;
+    // Add the measurement separately for each coordinate direction to Mille
+    // set the derivatives non-zero only for parameters we want to be optimized
+    // local parameter numbering is arbitrary:
+    float errinf = 1.0;
 
-      if (_layerMisalignment.find(layer) != _layerMisalignment.end())
+    if (_layerMisalignment.find(layer) != _layerMisalignment.end())
+    {
+      errinf = _layerMisalignment.find(layer)->second;
+    }
+    if (make_ntuple)
+    {
+      // get the local parameters using the ideal transforms
+      alignmentTransformationContainer::use_alignment = false;
+      Acts::Vector3 ideal_center = surf->center(_tGeometry->geometry().getGeoContext()) * 0.1;
+      Acts::Vector3 ideal_norm = -surf->normal(_tGeometry->geometry().getGeoContext());
+      Acts::Vector3 ideal_local(xloc, zloc, 0.0);  // cm
+      Acts::Vector3 ideal_glob = surf->transform(_tGeometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
+      ideal_glob /= Acts::UnitConstants::cm;
+      alignmentTransformationContainer::use_alignment = true;
+
+      Acts::Vector3 sensorCenter = surf->center(_tGeometry->geometry().getGeoContext()) * 0.1;  // cm
+      Acts::Vector3 sensorNormal = -surf->normal(_tGeometry->geometry().getGeoContext());
+      unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
+      unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
+      unsigned int subsurf = cluster->getSubSurfKey();
+      if (layer < 3)
       {
-        errinf = _layerMisalignment.find(layer)->second;
+        sector = MvtxDefs::getStaveId(cluskey_vec[ivec]);
+        subsurf = MvtxDefs::getChipId(cluskey_vec[ivec]);
       }
-      if (make_ntuple)
+      else if (layer > 2 && layer < 7)
       {
-        // get the local parameters using the ideal transforms
-        alignmentTransformationContainer::use_alignment = false;
-        Acts::Vector3 ideal_center = surf->center(_tGeometry->geometry().getGeoContext()) * 0.1;
-        Acts::Vector3 ideal_norm = -surf->normal(_tGeometry->geometry().getGeoContext());
-        Acts::Vector3 ideal_local(xloc, zloc, 0.0);  // cm
-        Acts::Vector3 ideal_glob = surf->transform(_tGeometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
-        ideal_glob /= Acts::UnitConstants::cm;
-        alignmentTransformationContainer::use_alignment = true;
-
-        Acts::Vector3 sensorCenter = surf->center(_tGeometry->geometry().getGeoContext()) * 0.1;  // cm
-        Acts::Vector3 sensorNormal = -surf->normal(_tGeometry->geometry().getGeoContext());
-        unsigned int sector = TpcDefs::getSectorId(cluskey_vec[ivec]);
-        unsigned int side = TpcDefs::getSide(cluskey_vec[ivec]);
-        unsigned int subsurf = cluster->getSubSurfKey();
-        if (layer < 3)
-        {
-          sector = MvtxDefs::getStaveId(cluskey_vec[ivec]);
-          subsurf = MvtxDefs::getChipId(cluskey_vec[ivec]);
-        }
-        else if (layer > 2 && layer < 7)
-        {
-          sector = InttDefs::getLadderPhiId(cluskey_vec[ivec]);
-          subsurf = InttDefs::getLadderZId(cluskey_vec[ivec]);
-        }
+        sector = InttDefs::getLadderPhiId(cluskey_vec[ivec]);
+        subsurf = InttDefs::getLadderZId(cluskey_vec[ivec]);
+      }
 	if(straight_line_fit)
 	  {
 	    float ntp_data[72] = {
@@ -795,146 +925,144 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 		std::cout << std::endl;
 	      }
 	  }
-      }
-      
-      if (!isnan(residual(0)) && clus_sigma(0) < 1.0)  // discards crazy clusters
-      {
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
-      }
-      if (!isnan(residual(1)) && clus_sigma(1) < 1.0)
-      {
-        _mille->mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
-      }
     }
+    
+    if (!isnan(residual(0)) && clus_sigma(0) < 1.0)  // discards crazy clusters
+    {
+      mille->mille(AlignmentDefs::NLC, lcl_derivativeX, AlignmentDefs::NGL, glbl_derivativeX, glbl_label, residual(0), errinf * clus_sigma(0));
+    }
+    if (!isnan(residual(1)) && clus_sigma(1) < 1.0)
+    {
+      mille->mille(AlignmentDefs::NLC, lcl_derivativeY, AlignmentDefs::NGL, glbl_derivativeY, glbl_label, residual(1), errinf * clus_sigma(1));
+    }
+  }
 
-    m_alignmentmap->insertWithKey(trackid, statevec);
-    m_trackmap->insertWithKey(&newTrack, trackid);
-
-    // calculate vertex residual with perigee surface
-    //-------------------------------------------------------
+  // calculate vertex residual with perigee surface
+  //-------------------------------------------------------
 
-    Acts::Vector3 event_vtx(averageVertex(0), averageVertex(1), averageVertex(2));
+  Acts::Vector3 event_vtx(averageVertex(0), averageVertex(1), averageVertex(2));
 
-    for (const auto &[vtxkey, vertex] : *m_vertexmap)
-      {
+  for (const auto &[vtxkey, vertex] : *m_vertexmap)
+    {
 	for (auto trackiter = vertex->begin_tracks(); trackiter != vertex->end_tracks(); ++trackiter)
 	  {
-	    SvtxTrack *vtxtrack = m_trackmap->get(*trackiter);
-	    if (vtxtrack)
-	      {	    
-		unsigned int vtxtrackid = vtxtrack->get_id();
-		if(trackid == vtxtrackid)
+	    // tracks are stored in the output track map with their index as key and id
+	    if (*trackiter == trackid)
+	      {
+		event_vtx(0) = vertex->get_x();
+		event_vtx(1) = vertex->get_y();
+		event_vtx(2) = vertex->get_z();
+		if(Verbosity() > 0)
 		  {
-		    event_vtx(0) = vertex->get_x();
-		    event_vtx(1) = vertex->get_y();
-		    event_vtx(2) = vertex->get_z();
-		    if(Verbosity() > 0)
-		      {
-			std::cout << "     setting event_vertex for trackid " << trackid << " to vtxid " << vtxkey
-				  << " vtx " << event_vtx(0) << "  " << event_vtx(1) << "  " << event_vtx(2) << std::endl;
-		      }
+		    std::cout << "     setting event_vertex for trackid " << trackid << " to vtxid " << vtxkey
+			      << " vtx " << event_vtx(0) << "  " << event_vtx(1) << "  " << event_vtx(2) << std::endl;
 		  }
 	      }
 	  }
-      }
-    
-    //  skip the common vertex requirement for this track unless there are 3 tracks in the event
-    if(accepted_tracks < 3) {  continue; }
-    
-    // The residual for the vtx case is (event vtx - track vtx)
-    // that is -dca
-    float dca3dxy = 0;
-    float dca3dz = 0;
-    float dca3dxysigma = 0;
-    float dca3dzsigma = 0;
-    if(!straight_line_fit)
-      {
+    }
+  
+  //  skip the common vertex requirement for this track unless there are 3 tracks in the event
+  if(accepted_tracks < 3)
+  {
+    // close out this track
+    mille->end();
+    return;
+  }
+  
+  // The residual for the vtx case is (event vtx - track vtx)
+  // that is -dca
+  float dca3dxy = 0;
+  float dca3dz = 0;
+  float dca3dxysigma = 0;
+  float dca3dzsigma = 0;
+  if(!straight_line_fit)
+    {
 	get_dca(newTrack, dca3dxy, dca3dz, dca3dxysigma, dca3dzsigma, event_vtx);
-      }
-    else
-      {
+    }
+  else
+    {
 	get_dca_zero_field(newTrack, dca3dxy, dca3dz, dca3dxysigma, dca3dzsigma, event_vtx);
-      } 
-    
-    // These are local coordinate residuals in the perigee surface
-   Acts::Vector2 vtx_residual(-dca3dxy, -dca3dz);
+    } 
+  
+  // These are local coordinate residuals in the perigee surface
+ Acts::Vector2 vtx_residual(-dca3dxy, -dca3dz);
 
-    float lclvtx_derivativeX[AlignmentDefs::NLC];
-    float lclvtx_derivativeY[AlignmentDefs::NLC];
-    if(straight_line_fit)
-      {
+  float lclvtx_derivativeX[AlignmentDefs::NLC];
+  float lclvtx_derivativeY[AlignmentDefs::NLC];
+  if(straight_line_fit)
+    {
 	getLocalVtxDerivativesZeroFieldXY(newTrack, event_vtx, fitpars, lclvtx_derivativeX, lclvtx_derivativeY);
-      }
-    else
-      {
+    }
+  else
+    {
 	getLocalVtxDerivativesXY(newTrack, event_vtx, fitpars, lclvtx_derivativeX, lclvtx_derivativeY);
-      }
+    }
 
-    // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
-    float glblvtx_derivativeX[3];
-    float glblvtx_derivativeY[3];
-    getGlobalVtxDerivativesXY(newTrack, event_vtx, glblvtx_derivativeX, glblvtx_derivativeY);
+  // The global derivs dimensions are [alpha/beta/gamma](x/y/z)
+  float glblvtx_derivativeX[3];
+  float glblvtx_derivativeY[3];
+  getGlobalVtxDerivativesXY(newTrack, event_vtx, glblvtx_derivativeX, glblvtx_derivativeY);
 
-    if (use_event_vertex)
+  if (use_event_vertex)
+  {
+    for(int p = 0; p<3; p++)
     {
-      for(int p = 0; p<3; p++)
-      {
 
 
-      if(is_vertex_param_fixed(p))
-      {
-        glblvtx_derivativeX[p] = 0;
-        glblvtx_derivativeY[p] = 0;
-      }
+    if(is_vertex_param_fixed(p))
+    {
+      glblvtx_derivativeX[p] = 0;
+      glblvtx_derivativeY[p] = 0;
+    }
 
 
+    }
+    if (Verbosity() > 1)
+    {
+      std::cout << "vertex info for track " << trackid << " with charge " << newTrack.get_charge() << std::endl;
+
+      std::cout << "vertex is " << event_vtx.transpose() << std::endl;
+      std::cout << "vertex residuals " << vtx_residual.transpose()
+                << std::endl;
+      std::cout << "local derivatives " << std::endl;
+      for (float i : lclvtx_derivativeX)
+      {
+        std::cout << i << ", ";
       }
-      if (Verbosity() > 1)
+      std::cout << std::endl;
+      for (float i : lclvtx_derivativeY)
       {
-        std::cout << "vertex info for track " << trackid << " with charge " << newTrack.get_charge() << std::endl;
-
-        std::cout << "vertex is " << event_vtx.transpose() << std::endl;
-        std::cout << "vertex residuals " << vtx_residual.transpose()
-                  << std::endl;
-        std::cout << "local derivatives " << std::endl;
-        for (float i : lclvtx_derivativeX)
-        {
-          std::cout << i << ", ";
-        }
-        std::cout << std::endl;
-        for (float i : lclvtx_derivativeY)
-        {
-          std::cout << i << ", ";
-        }
-        std::cout << "global vtx derivaties " << std::endl;
-        for (float i : glblvtx_derivativeX)
-        {
-          std::cout << i << ", ";
-        }
-        std::cout << std::endl;
-        for (float i : glblvtx_derivativeY)
-        {
-          std::cout << i << ", ";
-        }
+        std::cout << i << ", ";
       }
-
-      if (!isnan(vtx_residual(0)))
+      std::cout << "global vtx derivaties " << std::endl;
+      for (float i : glblvtx_derivativeX)
       {
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
+        std::cout << i << ", ";
       }
-      if (!isnan(vtx_residual(1)))
+      std::cout << std::endl;
+      for (float i : glblvtx_derivativeY)
       {
-        _mille->mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
+        std::cout << i << ", ";
       }
     }
 
-    if (make_ntuple)
+    if (!isnan(vtx_residual(0)))
     {
-      Acts::Vector3 mom(newTrack.get_px(), newTrack.get_py(), newTrack.get_pz());
-      Acts::Vector3 r = mom.cross(Acts::Vector3(0., 0., 1.));
-      float perigee_phi = atan2(r(1), r(0));
-      float track_phi = atan2(newTrack.get_py(), newTrack.get_px());
-      if(straight_line_fit)
+      mille->mille(AlignmentDefs::NLC, lclvtx_derivativeX, AlignmentDefs::NGLVTX, glblvtx_derivativeX, AlignmentDefs::glbl_vtx_label, vtx_residual(0), vtx_sigma(0));
+    }
+    if (!isnan(vtx_residual(1)))
+    {
+      mille->mille(AlignmentDefs::NLC, lclvtx_derivativeY, AlignmentDefs::NGLVTX, glblvtx_derivativeY, AlignmentDefs::glbl_vtx_label, vtx_residual(1), vtx_sigma(1));
+    }
+  }
+
+  if (make_ntuple)
+  {
+    Acts::Vector3 mom(newTrack.get_px(), newTrack.get_py(), newTrack.get_pz());
+    Acts::Vector3 r = mom.cross(Acts::Vector3(0., 0., 1.));
+    float perigee_phi = atan2(r(1), r(0));
+    float track_phi = atan2(newTrack.get_py(), newTrack.get_px());
+    if(straight_line_fit)
 	{
 	  float ntp_data[27] = {(float) trackid, (float) vtx_residual(0), (float) vtx_residual(1), (float) vtx_sigma(0), (float) vtx_sigma(1),
 				lclvtx_derivativeX[0], lclvtx_derivativeX[1], lclvtx_derivativeX[2], lclvtx_derivativeX[3],
@@ -946,7 +1074,7 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	  
 	  track_ntp->Fill(ntp_data);
 	}
-      else
+    else
 	{
 	  float ntp_data[29] = {(float) trackid, (float) vtx_residual(0), (float) vtx_residual(1), (float) vtx_sigma(0), (float) vtx_sigma(1),
 				lclvtx_derivativeX[0], lclvtx_derivativeX[1], lclvtx_derivativeX[2], lclvtx_derivativeX[3], lclvtx_derivativeX[4],
@@ -958,20 +1086,16 @@ int HelicalFitter::process_event(PHCompositeNode* /*unused*/)
 	  
 	  track_ntp->Fill(ntp_data);
 	}
-    }
-
-    if (Verbosity() > 1)
-    {
-      std::cout << "vtx_residual xy: " << vtx_residual(0) << " vtx_residual z: " << vtx_residual(1) << " vtx_sigma xy: " << vtx_sigma(0) << " vtx_sigma z: " << vtx_sigma(1) << std::endl;
-      std::cout << "track_x " << newTrack.get_x() << "track_y " << newTrack.get_y() << "track_z " << newTrack.get_z() << std::endl;
-    }
-
-    // close out this track
-    _mille->end();
+  }
 
-  }  // end loop over tracks
+  if (Verbosity() > 1)
+  {
+    std::cout << "vtx_residual xy: " << vtx_residual(0) << " vtx_residual z: " << vtx_residual(1) << " vtx_sigma xy: " << vtx_sigma(0) << " vtx_sigma z: " << vtx_sigma(1) << std::endl;
+    std::cout << "track_x " << newTrack.get_x() << "track_y " << newTrack.get_y() << "track_z " << newTrack.get_z() << std::endl;
+  }
 
-  return Fun4AllReturnCodes::EVENT_OK;
+  // close out this track
+  mille->end();
 }
 /*
 std::make_pair<unsigned int, Acts::Vector3> HelicalFitter::getAverageVertex( std::vector<Acts::Vector3> cumulative_vertex)
@@ -1219,10 +1343,52 @@ std::pair<Acts::Vector3, Acts::Vector3> HelicalFitter::get_helix_tangent(const s
   return pair;
 }
 
+int HelicalFitter::SaveCheckpoint(TDirectory* dir)
+{
+  std::ostringstream state;
+  state << event;
+  for (auto mille : _mille)
+  {
+    state << " " << mille->position();
+  }
+  TObjString checkpoint(state.str().c_str());
+  dir->WriteTObject(&checkpoint, "HelicalFitter");
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int HelicalFitter::RestoreCheckpoint(TDirectory* dir)
+{
+  // the ntuple is not part of the checkpoint, it only has the events after it
+  TObjString* checkpoint = dynamic_cast<TObjString*>(dir->Get("HelicalFitter"));
+  if (!checkpoint)
+  {
+    std::cout << PHWHERE << " no HelicalFitter state in checkpoint" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+  std::istringstream state(checkpoint->GetString().Data());
+  state >> event;
+  for (auto mille : _mille)
+  {
+    std::streamoff position = -1;
+    state >> position;
+    if (position < 0 || !mille->truncate(position))
+    {
+      std::cout << PHWHERE << " could not continue the data files from the checkpoint,"
+                << " was the number of threads changed?" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
 int HelicalFitter::End(PHCompositeNode* /*unused*/)
 {
-  // closes output file in destructor
-  delete _mille;
+  // closes output files in destructor
+  for (auto mille : _mille)
+  {
+    delete mille;
+  }
+  _mille.clear();
 
   if (make_ntuple)
   {
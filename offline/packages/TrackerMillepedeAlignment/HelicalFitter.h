@@ -15,8 +15,12 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/PHThreadPool.h>
+
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -24,6 +28,7 @@ class TrackSeed;
 class TrkrClusterContainer;
 class TF1;
 class TNtuple;
+class TDirectory;
 class TFile;
 class Mille;
 class SvtxTrackSeed;
@@ -55,6 +60,10 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
 
   int End(PHCompositeNode*) override;
 
+  /// sizes of the data files, a job resumed from a checkpoint drops the records written after them
+  int SaveCheckpoint(TDirectory* dir) override;
+  int RestoreCheckpoint(TDirectory* dir) override;
+
   void set_silicon_track_map_name(const std::string& map_name) { _silicon_track_map_name = map_name; }
   void set_track_map_name(const std::string& map_name) { _track_map_name = map_name; }
 
@@ -107,8 +116,26 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
 
   void set_dca_cut(float dca) { dca_cut = dca; }
 
+  void set_make_ntuple(bool flag) { make_ntuple = flag; }
+
+  /// fit tracklets on nthreads threads, 0 uses all cores
+  /**
+   * derivatives are also computed in parallel if the ntuple is disabled,
+   * each thread then writes its own data file, all listed in the steering file
+   */
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
-  Mille* _mille;
+  /// one per thread computing derivatives
+  std::vector<Mille*> _mille;
+
+  struct TrackletFit;
+
+  /// helical fit of one tracklet
+  void fitTracklet(unsigned int trackid, TrackletFit& fit);
+
+  /// residuals and derivatives of an accepted track, written to mille
+  void processTrack(unsigned int trackid, TrackletFit& fit, Mille* mille, const Acts::Vector3& averageVertex, unsigned int accepted_tracks, unsigned int nsilicon, unsigned int ntpc, unsigned int nclus);
 
   int GetNodes(PHCompositeNode* topNode);
   int CreateNodes(PHCompositeNode* topNode);
@@ -221,6 +248,9 @@ class HelicalFitter : public SubsysReco, public PHParameterInterface
 
   int event{0};
 
+  unsigned int m_nthreads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   Acts::Vector3 vertexPosition;
   Acts::Vector3 vertexPosUncertainty;
   Acts::Vector2 vtx_sigma;
@@ -31,8 +31,10 @@
 
 #include "Mille.h"
 
+#include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <system_error>
 
 //___________________________________________________________________________
 
@@ -41,14 +43,25 @@
  * \param[in] outFileName  file name
  * \param[in] asBinary     flag for binary
  * \param[in] writeZero    flag for keeping of zeros
+ * \param[in] append       flag for appending to an existing file
  */
-Mille::Mille(const char *outFileName, bool asBinary, bool writeZero)
-  : myOutFile(outFileName, (asBinary ? (std::ios::binary | std::ios::out) : std::ios::out))
+Mille::Mille(const char *outFileName, bool asBinary, bool writeZero, bool append)
+  : myStreamBuffer(myStreamBufferSize)
+  , myFileName(outFileName)
   , myAsBinary(asBinary)
   , myWriteZero(writeZero)
   , myBufferPos(-1)
   , myHasSpecial(false)
 {
+  // the stream buffer must be set before opening the file
+  myOutFile.rdbuf()->pubsetbuf(myStreamBuffer.data(), myStreamBuffer.size());
+  std::ios::openmode mode = (asBinary ? (std::ios::binary | std::ios::out) : std::ios::out);
+  if (append)
+  {
+    mode |= std::ios::app;
+  }
+  myOutFile.open(outFileName, mode);
+
   // Instead myBufferPos(-1), myHasSpecial(false) and the following two lines
   // we could call newSet() and kill()...
   myBufferInt[0] = 0;
@@ -235,6 +248,42 @@ void Mille::end()
   //  std:: cout << " Mille::end() finished with myBufferPos " << myBufferPos << std::endl;
 }
 
+//___________________________________________________________________________
+/// Flush the records written so far.
+/**
+ * \return  size of the file, -1 if it is not open
+ */
+std::streamoff Mille::position()
+{
+  // the file position is not defined before the first write in append mode, use the file size
+  myOutFile.flush();
+  std::error_code ec;
+  const auto size = std::filesystem::file_size(myFileName, ec);
+  return (myOutFile.is_open() && !ec) ? static_cast<std::streamoff>(size) : -1;
+}
+
+//___________________________________________________________________________
+/// Drop the records after position and continue writing there.
+/**
+ * \param[in]   position  file size returned by position()
+ * \return      true if the file was truncated and reopened
+ */
+bool Mille::truncate(std::streamoff position)
+{
+  myOutFile.close();
+  std::error_code ec;
+  std::filesystem::resize_file(myFileName, position, ec);
+  if (ec)
+  {
+    std::cerr << "Mille::truncate: Could not truncate " << myFileName
+              << " to " << position << " bytes: " << ec.message() << std::endl;
+    return false;
+  }
+  myOutFile.rdbuf()->pubsetbuf(myStreamBuffer.data(), myStreamBuffer.size());
+  myOutFile.open(myFileName, (myAsBinary ? (std::ios::binary | std::ios::out | std::ios::app) : (std::ios::out | std::ios::app)));
+  return myOutFile.is_open();
+}
+
 //___________________________________________________________________________
 /// Initialize for new set of locals, e.g. new track.
 void Mille::newSet()
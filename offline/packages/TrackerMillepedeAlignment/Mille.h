@@ -26,6 +26,8 @@
 #include <climits>
 #include <fstream>
 #include <limits>
+#include <string>
+#include <vector>
 /**
  * \class Mille
  *
@@ -51,7 +53,7 @@
 class Mille
 {
  public:
-  Mille(const char *outFileName, bool asBinary = true, bool writeZero = false);
+  Mille(const char *outFileName, bool asBinary = true, bool writeZero = false, bool append = false);
   ~Mille();
 
   void mille(int NLC, const float *derLc, int NGL, const float *derGl,
@@ -60,11 +62,23 @@ class Mille
   void kill();
   void end();
 
+  /// flush the records and return the size of the file, e.g. for a checkpoint
+  std::streamoff position();
+  /// drop the records after position, e.g. when resuming from a checkpoint
+  bool truncate(std::streamoff position);
+
  private:
   void newSet();
   bool checkBufferSize(int nLocal, int nGlobal);
 
-  std::ofstream myOutFile;  ///< C-binary for output
+  /// stream buffer size, records are small and written once per track
+  enum
+  {
+    myStreamBufferSize = 1 << 20
+  };
+  std::vector<char> myStreamBuffer;  ///< buffer of the output stream, must outlive it
+  std::ofstream myOutFile;           ///< C-binary for output
+  std::string myFileName;            ///< name of the output file
   bool myAsBinary;          ///< if false output as text
   bool myWriteZero;         ///< if true also write out derivatives/labels ==0
   /// buffer size for ints and floats
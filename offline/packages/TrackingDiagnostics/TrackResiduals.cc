@@ -100,6 +100,10 @@ int TrackResiduals::Init(PHCompositeNode* /*unused*/)
 int TrackResiduals::InitRun(PHCompositeNode* topNode)
 {
   m_outfile = new TFile(m_outfileName.c_str(), "RECREATE");
+  if (m_compressionSettings >= 0)
+  {
+    m_outfile->SetCompressionSettings(m_compressionSettings);
+  }
   createBranches();
 
   // global position wrapper
@@ -961,14 +965,12 @@ void TrackResiduals::fillHitTree(TrkrHitSetContainer* hitmap,
 
 void TrackResiduals::fillClusterBranchesKF(TrkrDefs::cluskey ckey, SvtxTrack* track,
                                            const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>>& global,
+                                           const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>>& global_moved,
                                            PHCompositeNode* topNode)
 {
   auto clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
   auto geometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
 
-  // move the corrected cluster positions back to the original readout surface
-  auto global_moved = m_clusterMover.processTrack(global);
-
   ActsTransformations transformer;
   TrkrCluster* cluster = clustermap->findCluster(ckey);
 
@@ -1066,8 +1068,11 @@ void TrackResiduals::fillClusterBranchesKF(TrkrDefs::cluskey ckey, SvtxTrack* tr
   m_cluskeys.push_back(ckey);
 
   //! have cluster and state, fill vectors
-  m_clusedge.push_back(cluster->getEdge());
-  m_clusoverlap.push_back(cluster->getOverlap());
+  if (hasBranchGroup(kClusterDetails))
+  {
+    m_clusedge.push_back(cluster->getEdge());
+    m_clusoverlap.push_back(cluster->getOverlap());
+  }
 
   // get new local coords from moved cluster
   Surface surf = geometry->maps().getSurface(ckey, cluster);
@@ -1123,81 +1128,94 @@ void TrackResiduals::fillClusterBranchesKF(TrkrDefs::cluskey ckey, SvtxTrack* tr
   m_clusgy.push_back(clusglob_moved.y());
   m_clusgr.push_back(clusglob_moved.y() > 0 ? clusr : -1 * clusr);
   m_clusgz.push_back(clusglob_moved.z());
-  m_clusgxunmoved.push_back(clusglob.x());
-  m_clusgyunmoved.push_back(clusglob.y());
-  m_clusgzunmoved.push_back(clusglob.z());
-  m_clusAdc.push_back(cluster->getAdc());
-  m_clusMaxAdc.push_back(cluster->getMaxAdc());
   m_cluslayer.push_back(TrkrDefs::getLayer(ckey));
-  m_clusphisize.push_back(cluster->getPhiSize());
-  m_cluszsize.push_back(cluster->getZSize());
-  m_clussize.push_back(cluster->getPhiSize() * cluster->getZSize());
-  m_clushitsetkey.push_back(TrkrDefs::getHitSetKeyFromClusKey(ckey));
+  if (hasBranchGroup(kClusterDetails))
+  {
+    m_clusgxunmoved.push_back(clusglob.x());
+    m_clusgyunmoved.push_back(clusglob.y());
+    m_clusgzunmoved.push_back(clusglob.z());
+    m_clusAdc.push_back(cluster->getAdc());
+    m_clusMaxAdc.push_back(cluster->getMaxAdc());
+    m_clusphisize.push_back(cluster->getPhiSize());
+    m_cluszsize.push_back(cluster->getZSize());
+    m_clussize.push_back(cluster->getPhiSize() * cluster->getZSize());
+    m_clushitsetkey.push_back(TrkrDefs::getHitSetKeyFromClusKey(ckey));
+  }
 
-  auto misaligncenter = surf->center(geometry->geometry().getGeoContext());
   auto misalignnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
-  auto misrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
-
-  float mgamma = atan2(-misrot(1, 0), misrot(0, 0));
-  float mbeta = -asin(misrot(0, 1));
-  float malpha = atan2(misrot(1, 1), misrot(2, 1));
-
-  //! Switch to get ideal transforms
-  alignmentTransformationContainer::use_alignment = false;
-  auto idealcenter = surf->center(geometry->geometry().getGeoContext());
-  auto idealnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
-
-  // replace the corrected moved cluster local position with the readout position from ideal geometry for now
-  // This allows us to see the distortion corrections by subtracting this uncorrected position
-  // revisit this when looking at the alignment case
-  //  Acts::Vector3 ideal_local(loc.x(), loc.y(), 0.0);
-  auto nominal_loc = geometry->getLocalCoords(ckey, cluster);
-  Acts::Vector3 ideal_local(nominal_loc.x(), nominal_loc.y(), 0.0);
-  Acts::Vector3 ideal_glob = surf->transform(geometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
-  auto idealrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
-
-  //! These calculations are taken from the wikipedia page for Euler angles,
-  //! under the Tait-Bryan angle explanation. Formulas for the angles
-  //! calculated from the rotation matrices depending on what order the
-  //! rotation matrix is constructed are given
-  //! They need to be modified to conform to the Acts basis of (x,z,y), for
-  //! which the wiki page expects (x,y,z). This includes swapping the sign
-  //! of some elements to account for the permutation
-  //! https://en.wikipedia.org/wiki/Euler_angles#Conversion_to_other_orientation_representations
-  float igamma = atan2(-idealrot(1, 0), idealrot(0, 0));
-  float ibeta = -asin(idealrot(0, 1));
-  float ialpha = atan2(idealrot(1, 1), idealrot(2, 1));
-
-  alignmentTransformationContainer::use_alignment = true;
-
-  idealcenter /= Acts::UnitConstants::cm;
-  misaligncenter /= Acts::UnitConstants::cm;
-  ideal_glob /= Acts::UnitConstants::cm;
-
-  m_idealsurfalpha.push_back(ialpha);
-  m_idealsurfbeta.push_back(ibeta);
-  m_idealsurfgamma.push_back(igamma);
-  m_missurfalpha.push_back(malpha);
-  m_missurfbeta.push_back(mbeta);
-  m_missurfgamma.push_back(mgamma);
-
-  m_idealsurfcenterx.push_back(idealcenter.x());
-  m_idealsurfcentery.push_back(idealcenter.y());
-  m_idealsurfcenterz.push_back(idealcenter.z());
-  m_idealsurfnormx.push_back(idealnorm.x());
-  m_idealsurfnormy.push_back(idealnorm.y());
-  m_idealsurfnormz.push_back(idealnorm.z());
-  m_missurfcenterx.push_back(misaligncenter.x());
-  m_missurfcentery.push_back(misaligncenter.y());
-  m_missurfcenterz.push_back(misaligncenter.z());
-  m_missurfnormx.push_back(misalignnorm.x());
-  m_missurfnormy.push_back(misalignnorm.y());
-  m_missurfnormz.push_back(misalignnorm.z());
-  m_clusgxideal.push_back(ideal_glob.x());
-  m_clusgyideal.push_back(ideal_glob.y());
-  m_clusgzideal.push_back(ideal_glob.z());
-
-  if (state)
+
+  // ideal geometry and surfaces, only used by the surface branches
+  Acts::Vector3 ideal_glob(0, 0, 0);
+  if (hasBranchGroup(kSurfaces))
+  {
+    auto misaligncenter = surf->center(geometry->geometry().getGeoContext());
+    auto misrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
+
+    float mgamma = atan2(-misrot(1, 0), misrot(0, 0));
+    float mbeta = -asin(misrot(0, 1));
+    float malpha = atan2(misrot(1, 1), misrot(2, 1));
+
+    //! Switch to get ideal transforms
+    alignmentTransformationContainer::use_alignment = false;
+    auto idealcenter = surf->center(geometry->geometry().getGeoContext());
+    auto idealnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
+
+    // replace the corrected moved cluster local position with the readout position from ideal geometry for now
+    // This allows us to see the distortion corrections by subtracting this uncorrected position
+    // revisit this when looking at the alignment case
+    //  Acts::Vector3 ideal_local(loc.x(), loc.y(), 0.0);
+    auto nominal_loc = geometry->getLocalCoords(ckey, cluster);
+    Acts::Vector3 ideal_local(nominal_loc.x(), nominal_loc.y(), 0.0);
+    ideal_glob = surf->transform(geometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
+    auto idealrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
+
+    //! These calculations are taken from the wikipedia page for Euler angles,
+    //! under the Tait-Bryan angle explanation. Formulas for the angles
+    //! calculated from the rotation matrices depending on what order the
+    //! rotation matrix is constructed are given
+    //! They need to be modified to conform to the Acts basis of (x,z,y), for
+    //! which the wiki page expects (x,y,z). This includes swapping the sign
+    //! of some elements to account for the permutation
+    //! https://en.wikipedia.org/wiki/Euler_angles#Conversion_to_other_orientation_representations
+    float igamma = atan2(-idealrot(1, 0), idealrot(0, 0));
+    float ibeta = -asin(idealrot(0, 1));
+    float ialpha = atan2(idealrot(1, 1), idealrot(2, 1));
+
+    alignmentTransformationContainer::use_alignment = true;
+
+    idealcenter /= Acts::UnitConstants::cm;
+    misaligncenter /= Acts::UnitConstants::cm;
+    ideal_glob /= Acts::UnitConstants::cm;
+
+    m_idealsurfalpha.push_back(ialpha);
+    m_idealsurfbeta.push_back(ibeta);
+    m_idealsurfgamma.push_back(igamma);
+    m_missurfalpha.push_back(malpha);
+    m_missurfbeta.push_back(mbeta);
+    m_missurfgamma.push_back(mgamma);
+
+    m_idealsurfcenterx.push_back(idealcenter.x());
+    m_idealsurfcentery.push_back(idealcenter.y());
+    m_idealsurfcenterz.push_back(idealcenter.z());
+    m_idealsurfnormx.push_back(idealnorm.x());
+    m_idealsurfnormy.push_back(idealnorm.y());
+    m_idealsurfnormz.push_back(idealnorm.z());
+    m_missurfcenterx.push_back(misaligncenter.x());
+    m_missurfcentery.push_back(misaligncenter.y());
+    m_missurfcenterz.push_back(misaligncenter.z());
+    m_missurfnormx.push_back(misalignnorm.x());
+    m_missurfnormy.push_back(misalignnorm.y());
+    m_missurfnormz.push_back(misalignnorm.z());
+    m_clusgxideal.push_back(ideal_glob.x());
+    m_clusgyideal.push_back(ideal_glob.y());
+    m_clusgzideal.push_back(ideal_glob.z());
+  }
+
+  if (!hasBranchGroup(kStates))
+  {
+    // no state branches
+  }
+  else if (state)
   {
     Acts::Vector3 stateglob(state->get_x(), state->get_y(), state->get_z());
     Acts::Vector2 stateloc;
@@ -1283,6 +1301,7 @@ void TrackResiduals::fillClusterBranchesKF(TrkrDefs::cluskey ckey, SvtxTrack* tr
 
 void TrackResiduals::fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTrack* track,
                                               const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>>& global,
+                                              const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>>& global_moved,
                                               PHCompositeNode* topNode)
 {
   // The input map global contains the corrected cluster positions - NOT moved back to the surfacer.
@@ -1295,9 +1314,6 @@ void TrackResiduals::fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTr
   auto clustermap = findNode::getClass<TrkrClusterContainer>(topNode, "TRKR_CLUSTER");
   auto geometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
 
-  // move the cluster positions back to the original readout surface
-  auto global_moved = m_clusterMover.processTrack(global);
-
   TrkrCluster* cluster = clustermap->findCluster(ckey);
 
   // loop over global vectors and get this cluster
@@ -1355,8 +1371,11 @@ void TrackResiduals::fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTr
   }
 
   //! have cluster and state, fill vectors
-  m_clusedge.push_back(cluster->getEdge());
-  m_clusoverlap.push_back(cluster->getOverlap());
+  if (hasBranchGroup(kClusterDetails))
+  {
+    m_clusedge.push_back(cluster->getEdge());
+    m_clusoverlap.push_back(cluster->getOverlap());
+  }
 
   // This is the nominal position of the cluster in local coords, completely uncorrected - is that what we want?
   auto loc = geometry->getLocalCoords(ckey, cluster);
@@ -1373,16 +1392,19 @@ void TrackResiduals::fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTr
   m_clusgy.push_back(clusglob_moved.y());
   m_clusgr.push_back(clusglob_moved.y() > 0 ? clusr : -1 * clusr);
   m_clusgz.push_back(clusglob_moved.z());
-  m_clusgxunmoved.push_back(clusglob.x());
-  m_clusgyunmoved.push_back(clusglob.y());
-  m_clusgzunmoved.push_back(clusglob.z());
-  m_clusAdc.push_back(cluster->getAdc());
-  m_clusMaxAdc.push_back(cluster->getMaxAdc());
   m_cluslayer.push_back(TrkrDefs::getLayer(ckey));
-  m_clusphisize.push_back(cluster->getPhiSize());
-  m_cluszsize.push_back(cluster->getZSize());
-  m_clussize.push_back(cluster->getPhiSize() * cluster->getZSize());
-  m_clushitsetkey.push_back(TrkrDefs::getHitSetKeyFromClusKey(ckey));
+  if (hasBranchGroup(kClusterDetails))
+  {
+    m_clusgxunmoved.push_back(clusglob.x());
+    m_clusgyunmoved.push_back(clusglob.y());
+    m_clusgzunmoved.push_back(clusglob.z());
+    m_clusAdc.push_back(cluster->getAdc());
+    m_clusMaxAdc.push_back(cluster->getMaxAdc());
+    m_clusphisize.push_back(cluster->getPhiSize());
+    m_cluszsize.push_back(cluster->getZSize());
+    m_clussize.push_back(cluster->getPhiSize() * cluster->getZSize());
+    m_clushitsetkey.push_back(TrkrDefs::getHitSetKeyFromClusKey(ckey));
+  }
 
   if (Verbosity() > 1)
   {
@@ -1391,64 +1413,73 @@ void TrackResiduals::fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTr
               << clusglob.transpose() << std::endl;
   }
 
-  auto surf = geometry->maps().getSurface(ckey, cluster);
-
-  auto misaligncenter = surf->center(geometry->geometry().getGeoContext());
-  auto misalignnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
-  auto misrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
-
-  float mgamma = atan2(-misrot(1, 0), misrot(0, 0));
-  float mbeta = -asin(misrot(0, 1));
-  float malpha = atan2(misrot(1, 1), misrot(2, 1));
-
-  //! Switch to get ideal transforms
-  alignmentTransformationContainer::use_alignment = false;
-  auto idealcenter = surf->center(geometry->geometry().getGeoContext());
-  auto idealnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
-  Acts::Vector3 ideal_local(loc.x(), loc.y(), 0.0);
-  Acts::Vector3 ideal_glob = surf->transform(geometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
-  auto idealrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
-
-  //! These calculations are taken from the wikipedia page for Euler angles,
-  //! under the Tait-Bryan angle explanation. Formulas for the angles
-  //! calculated from the rotation matrices depending on what order the
-  //! rotation matrix is constructed are given
-  //! They need to be modified to conform to the Acts basis of (x,z,y), for
-  //! which the wiki page expects (x,y,z). This includes swapping the sign
-  //! of some elements to account for the permutation
-  //! https://en.wikipedia.org/wiki/Euler_angles#Conversion_to_other_orientation_representations
-  float igamma = atan2(-idealrot(1, 0), idealrot(0, 0));
-  float ibeta = -asin(idealrot(0, 1));
-  float ialpha = atan2(idealrot(1, 1), idealrot(2, 1));
-
-  alignmentTransformationContainer::use_alignment = true;
-
-  idealcenter /= Acts::UnitConstants::cm;
-  misaligncenter /= Acts::UnitConstants::cm;
-  ideal_glob /= Acts::UnitConstants::cm;
-
-  m_idealsurfalpha.push_back(ialpha);
-  m_idealsurfbeta.push_back(ibeta);
-  m_idealsurfgamma.push_back(igamma);
-  m_missurfalpha.push_back(malpha);
-  m_missurfbeta.push_back(mbeta);
-  m_missurfgamma.push_back(mgamma);
-
-  m_idealsurfcenterx.push_back(idealcenter.x());
-  m_idealsurfcentery.push_back(idealcenter.y());
-  m_idealsurfcenterz.push_back(idealcenter.z());
-  m_idealsurfnormx.push_back(idealnorm.x());
-  m_idealsurfnormy.push_back(idealnorm.y());
-  m_idealsurfnormz.push_back(idealnorm.z());
-  m_missurfcenterx.push_back(misaligncenter.x());
-  m_missurfcentery.push_back(misaligncenter.y());
-  m_missurfcenterz.push_back(misaligncenter.z());
-  m_missurfnormx.push_back(misalignnorm.x());
-  m_missurfnormy.push_back(misalignnorm.y());
-  m_missurfnormz.push_back(misalignnorm.z());
-  m_clusgxideal.push_back(ideal_glob.x());
-  m_clusgyideal.push_back(ideal_glob.y());
-  m_clusgzideal.push_back(ideal_glob.z());
+  // ideal geometry and surfaces, only used by the surface branches
+  if (hasBranchGroup(kSurfaces))
+  {
+    auto surf = geometry->maps().getSurface(ckey, cluster);
+
+    auto misaligncenter = surf->center(geometry->geometry().getGeoContext());
+    auto misalignnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
+    auto misrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
+
+    float mgamma = atan2(-misrot(1, 0), misrot(0, 0));
+    float mbeta = -asin(misrot(0, 1));
+    float malpha = atan2(misrot(1, 1), misrot(2, 1));
+
+    //! Switch to get ideal transforms
+    alignmentTransformationContainer::use_alignment = false;
+    auto idealcenter = surf->center(geometry->geometry().getGeoContext());
+    auto idealnorm = -1 * surf->normal(geometry->geometry().getGeoContext());
+    Acts::Vector3 ideal_local(loc.x(), loc.y(), 0.0);
+    Acts::Vector3 ideal_glob = surf->transform(geometry->geometry().getGeoContext()) * (ideal_local * Acts::UnitConstants::cm);
+    auto idealrot = surf->transform(geometry->geometry().getGeoContext()).rotation();
+
+    //! These calculations are taken from the wikipedia page for Euler angles,
+    //! under the Tait-Bryan angle explanation. Formulas for the angles
+    //! calculated from the rotation matrices depending on what order the
+    //! rotation matrix is constructed are given
+    //! They need to be modified to conform to the Acts basis of (x,z,y), for
+    //! which the wiki page expects (x,y,z). This includes swapping the sign
+    //! of some elements to account for the permutation
+    //! https://en.wikipedia.org/wiki/Euler_angles#Conversion_to_other_orientation_representations
+    float igamma = atan2(-idealrot(1, 0), idealrot(0, 0));
+    float ibeta = -asin(idealrot(0, 1));
+    float ialpha = atan2(idealrot(1, 1), idealrot(2, 1));
+
+    alignmentTransformationContainer::use_alignment = true;
+
+    idealcenter /= Acts::UnitConstants::cm;
+    misaligncenter /= Acts::UnitConstants::cm;
+    ideal_glob /= Acts::UnitConstants::cm;
+
+    m_idealsurfalpha.push_back(ialpha);
+    m_idealsurfbeta.push_back(ibeta);
+    m_idealsurfgamma.push_back(igamma);
+    m_missurfalpha.push_back(malpha);
+    m_missurfbeta.push_back(mbeta);
+    m_missurfgamma.push_back(mgamma);
+
+    m_idealsurfcenterx.push_back(idealcenter.x());
+    m_idealsurfcentery.push_back(idealcenter.y());
+    m_idealsurfcenterz.push_back(idealcenter.z());
+    m_idealsurfnormx.push_back(idealnorm.x());
+    m_idealsurfnormy.push_back(idealnorm.y());
+    m_idealsurfnormz.push_back(idealnorm.z());
+    m_missurfcenterx.push_back(misaligncenter.x());
+    m_missurfcentery.push_back(misaligncenter.y());
+    m_missurfcenterz.push_back(misaligncenter.z());
+    m_missurfnormx.push_back(misalignnorm.x());
+    m_missurfnormy.push_back(misalignnorm.y());
+    m_missurfnormz.push_back(misalignnorm.z());
+    m_clusgxideal.push_back(ideal_glob.x());
+    m_clusgyideal.push_back(ideal_glob.y());
+    m_clusgzideal.push_back(ideal_glob.z());
+  }
+
+  if (!hasBranchGroup(kStates))
+  {
+    return;
+  }
 
   if (m_zeroField)
   {
@@ -1689,24 +1720,6 @@ void TrackResiduals::createBranches()
   m_tree->Branch("trbco", &m_bcotr, "m_bcotr/l");
   m_tree->Branch("crossing", &m_crossing, "m_crossing/I");
   m_tree->Branch("crossing_estimate", &m_crossing_estimate, "m_crossing_estimate/I");
-  m_tree->Branch("silseedx", &m_silseedx, "m_silseedx/F");
-  m_tree->Branch("silseedy", &m_silseedy, "m_silseedy/F");
-  m_tree->Branch("silseedz", &m_silseedz, "m_silseedz/F");
-  m_tree->Branch("silseedpx", &m_silseedpx, "m_silseedpx/F");
-  m_tree->Branch("silseedpy", &m_silseedpy, "m_silseedpy/F");
-  m_tree->Branch("silseedpz", &m_silseedpz, "m_silseedpz/F");
-  m_tree->Branch("silseedphi", &m_silseedphi, "m_silseedphi/F");
-  m_tree->Branch("silseedeta", &m_silseedeta, "m_silseedeta/F");
-  m_tree->Branch("silseedcharge", &m_silseedcharge, "m_silseedcharge/I");
-  m_tree->Branch("tpcseedx", &m_tpcseedx, "m_tpcseedx/F");
-  m_tree->Branch("tpcseedy", &m_tpcseedy, "m_tpcseedy/F");
-  m_tree->Branch("tpcseedz", &m_tpcseedz, "m_tpcseedz/F");
-  m_tree->Branch("tpcseedpx", &m_tpcseedpx, "m_tpcseedpx/F");
-  m_tree->Branch("tpcseedpy", &m_tpcseedpy, "m_tpcseedpy/F");
-  m_tree->Branch("tpcseedpz", &m_tpcseedpz, "m_tpcseedpz/F");
-  m_tree->Branch("tpcseedphi", &m_tpcseedphi, "m_tpcseedphi/F");
-  m_tree->Branch("tpcseedeta", &m_tpcseedeta, "m_tpcseedeta/F");
-  m_tree->Branch("tpcseedcharge", &m_tpcseedcharge, "m_tpcseedcharge/I");
   m_tree->Branch("dedx", &m_dedx, "m_dedx/F");
   m_tree->Branch("tracklength", &m_tracklength, "m_tracklength/F");
   m_tree->Branch("px", &m_px, "m_px/F");
@@ -1748,10 +1761,7 @@ void TrackResiduals::createBranches()
   m_tree->Branch("Y0", &m_Y0, "m_Y0/F");
   m_tree->Branch("dcaxy", &m_dcaxy, "m_dcaxy/F");
   m_tree->Branch("dcaz", &m_dcaz, "m_dcaz/F");
-
   m_tree->Branch("cluskeys", &m_cluskeys);
-  m_tree->Branch("clusedge", &m_clusedge);
-  m_tree->Branch("clusoverlap", &m_clusoverlap);
   m_tree->Branch("cluslx", &m_cluslx);
   m_tree->Branch("cluslz", &m_cluslz);
   m_tree->Branch("cluselx", &m_cluselx);
@@ -1760,77 +1770,112 @@ void TrackResiduals::createBranches()
   m_tree->Branch("clusgy", &m_clusgy);
   m_tree->Branch("clusgz", &m_clusgz);
   m_tree->Branch("clusgr", &m_clusgr);
-  m_tree->Branch("clusgxunmoved", &m_clusgxunmoved);
-  m_tree->Branch("clusgyunmoved", &m_clusgyunmoved);
-  m_tree->Branch("clusgzunmoved", &m_clusgzunmoved);
   m_tree->Branch("clussector", &m_clsector);
   m_tree->Branch("clusside", &m_clside);
-  m_tree->Branch("clusAdc", &m_clusAdc);
-  m_tree->Branch("clusMaxAdc", &m_clusMaxAdc);
   m_tree->Branch("cluslayer", &m_cluslayer);
-  m_tree->Branch("clussize", &m_clussize);
-  m_tree->Branch("clusphisize", &m_clusphisize);
-  m_tree->Branch("cluszsize", &m_cluszsize);
-  m_tree->Branch("clushitsetkey", &m_clushitsetkey);
-  m_tree->Branch("idealsurfcenterx", &m_idealsurfcenterx);
-  m_tree->Branch("idealsurfcentery", &m_idealsurfcentery);
-  m_tree->Branch("idealsurfcenterz", &m_idealsurfcenterz);
-  m_tree->Branch("idealsurfnormx", &m_idealsurfnormx);
-  m_tree->Branch("idealsurfnormy", &m_idealsurfnormy);
-  m_tree->Branch("idealsurfnormz", &m_idealsurfnormz);
-  m_tree->Branch("missurfcenterx", &m_missurfcenterx);
-  m_tree->Branch("missurfcentery", &m_missurfcentery);
-  m_tree->Branch("missurfcenterz", &m_missurfcenterz);
-  m_tree->Branch("missurfnormx", &m_missurfnormx);
-  m_tree->Branch("missurfnormy", &m_missurfnormy);
-  m_tree->Branch("missurfnormz", &m_missurfnormz);
-  m_tree->Branch("clusgxideal", &m_clusgxideal);
-  m_tree->Branch("clusgyideal", &m_clusgyideal);
-  m_tree->Branch("clusgzideal", &m_clusgzideal);
-  m_tree->Branch("missurfalpha", &m_missurfalpha);
-  m_tree->Branch("missurfbeta", &m_missurfbeta);
-  m_tree->Branch("missurfgamma", &m_missurfgamma);
-  m_tree->Branch("idealsurfalpha", &m_idealsurfalpha);
-  m_tree->Branch("idealsurfbeta", &m_idealsurfbeta);
-  m_tree->Branch("idealsurfgamma", &m_idealsurfgamma);
-
-  m_tree->Branch("statelx", &m_statelx);
-  m_tree->Branch("statelz", &m_statelz);
-  m_tree->Branch("stateelx", &m_stateelx);
-  m_tree->Branch("stateelz", &m_stateelz);
-  m_tree->Branch("stategx", &m_stategx);
-  m_tree->Branch("stategy", &m_stategy);
-  m_tree->Branch("stategz", &m_stategz);
-  m_tree->Branch("statepx", &m_statepx);
-  m_tree->Branch("statepy", &m_statepy);
-  m_tree->Branch("statepz", &m_statepz);
-  m_tree->Branch("statepl", &m_statepl);
-
-  m_tree->Branch("statelxglobderivdx", &m_statelxglobderivdx);
-  m_tree->Branch("statelxglobderivdy", &m_statelxglobderivdy);
-  m_tree->Branch("statelxglobderivdz", &m_statelxglobderivdz);
-  m_tree->Branch("statelxglobderivdalpha", &m_statelxglobderivdalpha);
-  m_tree->Branch("statelxglobderivdbeta", &m_statelxglobderivdbeta);
-  m_tree->Branch("statelxglobderivdgamma", &m_statelxglobderivdgamma);
-
-  m_tree->Branch("statelxlocderivd0", &m_statelxlocderivd0);
-  m_tree->Branch("statelxlocderivz0", &m_statelxlocderivz0);
-  m_tree->Branch("statelxlocderivphi", &m_statelxlocderivphi);
-  m_tree->Branch("statelxlocderivtheta", &m_statelxlocderivtheta);
-  m_tree->Branch("statelxlocderivqop", &m_statelxlocderivqop);
-
-  m_tree->Branch("statelzglobderivdx", &m_statelzglobderivdx);
-  m_tree->Branch("statelzglobderivdy", &m_statelzglobderivdy);
-  m_tree->Branch("statelzglobderivdz", &m_statelzglobderivdz);
-  m_tree->Branch("statelzglobderivdalpha", &m_statelzglobderivdalpha);
-  m_tree->Branch("statelzglobderivdbeta", &m_statelzglobderivdbeta);
-  m_tree->Branch("statelzglobderivdgamma", &m_statelzglobderivdgamma);
-
-  m_tree->Branch("statelzlocderivd0", &m_statelzlocderivd0);
-  m_tree->Branch("statelzlocderivz0", &m_statelzlocderivz0);
-  m_tree->Branch("statelzlocderivphi", &m_statelzlocderivphi);
-  m_tree->Branch("statelzlocderivtheta", &m_statelzlocderivtheta);
-  m_tree->Branch("statelzlocderivqop", &m_statelzlocderivqop);
+
+  if (hasBranchGroup(kSeeds))
+  {
+    m_tree->Branch("silseedx", &m_silseedx, "m_silseedx/F");
+    m_tree->Branch("silseedy", &m_silseedy, "m_silseedy/F");
+    m_tree->Branch("silseedz", &m_silseedz, "m_silseedz/F");
+    m_tree->Branch("silseedpx", &m_silseedpx, "m_silseedpx/F");
+    m_tree->Branch("silseedpy", &m_silseedpy, "m_silseedpy/F");
+    m_tree->Branch("silseedpz", &m_silseedpz, "m_silseedpz/F");
+    m_tree->Branch("silseedphi", &m_silseedphi, "m_silseedphi/F");
+    m_tree->Branch("silseedeta", &m_silseedeta, "m_silseedeta/F");
+    m_tree->Branch("silseedcharge", &m_silseedcharge, "m_silseedcharge/I");
+    m_tree->Branch("tpcseedx", &m_tpcseedx, "m_tpcseedx/F");
+    m_tree->Branch("tpcseedy", &m_tpcseedy, "m_tpcseedy/F");
+    m_tree->Branch("tpcseedz", &m_tpcseedz, "m_tpcseedz/F");
+    m_tree->Branch("tpcseedpx", &m_tpcseedpx, "m_tpcseedpx/F");
+    m_tree->Branch("tpcseedpy", &m_tpcseedpy, "m_tpcseedpy/F");
+    m_tree->Branch("tpcseedpz", &m_tpcseedpz, "m_tpcseedpz/F");
+    m_tree->Branch("tpcseedphi", &m_tpcseedphi, "m_tpcseedphi/F");
+    m_tree->Branch("tpcseedeta", &m_tpcseedeta, "m_tpcseedeta/F");
+    m_tree->Branch("tpcseedcharge", &m_tpcseedcharge, "m_tpcseedcharge/I");
+  }
+
+  if (hasBranchGroup(kClusterDetails))
+  {
+    m_tree->Branch("clusedge", &m_clusedge);
+    m_tree->Branch("clusoverlap", &m_clusoverlap);
+    m_tree->Branch("clusgxunmoved", &m_clusgxunmoved);
+    m_tree->Branch("clusgyunmoved", &m_clusgyunmoved);
+    m_tree->Branch("clusgzunmoved", &m_clusgzunmoved);
+    m_tree->Branch("clusAdc", &m_clusAdc);
+    m_tree->Branch("clusMaxAdc", &m_clusMaxAdc);
+    m_tree->Branch("clussize", &m_clussize);
+    m_tree->Branch("clusphisize", &m_clusphisize);
+    m_tree->Branch("cluszsize", &m_cluszsize);
+    m_tree->Branch("clushitsetkey", &m_clushitsetkey);
+  }
+
+  if (hasBranchGroup(kSurfaces))
+  {
+    m_tree->Branch("idealsurfcenterx", &m_idealsurfcenterx);
+    m_tree->Branch("idealsurfcentery", &m_idealsurfcentery);
+    m_tree->Branch("idealsurfcenterz", &m_idealsurfcenterz);
+    m_tree->Branch("idealsurfnormx", &m_idealsurfnormx);
+    m_tree->Branch("idealsurfnormy", &m_idealsurfnormy);
+    m_tree->Branch("idealsurfnormz", &m_idealsurfnormz);
+    m_tree->Branch("missurfcenterx", &m_missurfcenterx);
+    m_tree->Branch("missurfcentery", &m_missurfcentery);
+    m_tree->Branch("missurfcenterz", &m_missurfcenterz);
+    m_tree->Branch("missurfnormx", &m_missurfnormx);
+    m_tree->Branch("missurfnormy", &m_missurfnormy);
+    m_tree->Branch("missurfnormz", &m_missurfnormz);
+    m_tree->Branch("clusgxideal", &m_clusgxideal);
+    m_tree->Branch("clusgyideal", &m_clusgyideal);
+    m_tree->Branch("clusgzideal", &m_clusgzideal);
+    m_tree->Branch("missurfalpha", &m_missurfalpha);
+    m_tree->Branch("missurfbeta", &m_missurfbeta);
+    m_tree->Branch("missurfgamma", &m_missurfgamma);
+    m_tree->Branch("idealsurfalpha", &m_idealsurfalpha);
+    m_tree->Branch("idealsurfbeta", &m_idealsurfbeta);
+    m_tree->Branch("idealsurfgamma", &m_idealsurfgamma);
+  }
+
+  if (hasBranchGroup(kStates))
+  {
+    m_tree->Branch("statelx", &m_statelx);
+    m_tree->Branch("statelz", &m_statelz);
+    m_tree->Branch("stateelx", &m_stateelx);
+    m_tree->Branch("stateelz", &m_stateelz);
+    m_tree->Branch("stategx", &m_stategx);
+    m_tree->Branch("stategy", &m_stategy);
+    m_tree->Branch("stategz", &m_stategz);
+    m_tree->Branch("statepx", &m_statepx);
+    m_tree->Branch("statepy", &m_statepy);
+    m_tree->Branch("statepz", &m_statepz);
+    m_tree->Branch("statepl", &m_statepl);
+  }
+
+  if (hasBranchGroup(kDerivatives))
+  {
+    m_tree->Branch("statelxglobderivdx", &m_statelxglobderivdx);
+    m_tree->Branch("statelxglobderivdy", &m_statelxglobderivdy);
+    m_tree->Branch("statelxglobderivdz", &m_statelxglobderivdz);
+    m_tree->Branch("statelxglobderivdalpha", &m_statelxglobderivdalpha);
+    m_tree->Branch("statelxglobderivdbeta", &m_statelxglobderivdbeta);
+    m_tree->Branch("statelxglobderivdgamma", &m_statelxglobderivdgamma);
+    m_tree->Branch("statelxlocderivd0", &m_statelxlocderivd0);
+    m_tree->Branch("statelxlocderivz0", &m_statelxlocderivz0);
+    m_tree->Branch("statelxlocderivphi", &m_statelxlocderivphi);
+    m_tree->Branch("statelxlocderivtheta", &m_statelxlocderivtheta);
+    m_tree->Branch("statelxlocderivqop", &m_statelxlocderivqop);
+    m_tree->Branch("statelzglobderivdx", &m_statelzglobderivdx);
+    m_tree->Branch("statelzglobderivdy", &m_statelzglobderivdy);
+    m_tree->Branch("statelzglobderivdz", &m_statelzglobderivdz);
+    m_tree->Branch("statelzglobderivdalpha", &m_statelzglobderivdalpha);
+    m_tree->Branch("statelzglobderivdbeta", &m_statelzglobderivdbeta);
+    m_tree->Branch("statelzglobderivdgamma", &m_statelzglobderivdgamma);
+    m_tree->Branch("statelzlocderivd0", &m_statelzlocderivd0);
+    m_tree->Branch("statelzlocderivz0", &m_statelzlocderivz0);
+    m_tree->Branch("statelzlocderivphi", &m_statelzlocderivphi);
+    m_tree->Branch("statelzlocderivtheta", &m_statelzlocderivtheta);
+    m_tree->Branch("statelzlocderivqop", &m_statelzlocderivqop);
+  }
 }
 
 void TrackResiduals::fillResidualTreeKF(PHCompositeNode* topNode)
@@ -1994,13 +2039,14 @@ void TrackResiduals::fillResidualTreeKF(PHCompositeNode* topNode)
       global_raw.emplace_back(std::make_pair(ckey, global));
     }
 
-    // move the cluster positions back to the original readout surface in the fillClusterBranchesKF method
+    // move the cluster positions back to the original readout surface, once per track
+    const auto global_moved = m_clusterMover.processTrack(global_raw);
 
     if (!m_doAlignment)
     {
       for (const auto& ckey : get_cluster_keys(track))
       {
-        fillClusterBranchesKF(ckey, track, global_raw, topNode);
+        fillClusterBranchesKF(ckey, track, global_raw, global_moved, topNode);
       }
     }
 
@@ -2019,7 +2065,12 @@ void TrackResiduals::fillResidualTreeKF(PHCompositeNode* topNode)
         {
           auto ckey = state->get_cluster_key();
 
-          fillClusterBranchesKF(ckey, track, global_raw, topNode);
+          fillClusterBranchesKF(ckey, track, global_raw, global_moved, topNode);
+
+          if (!hasBranchGroup(kDerivatives))
+          {
+            continue;
+          }
 
           auto& globderivs = state->get_global_derivative_matrix();
           auto& locderivs = state->get_local_derivative_matrix();
@@ -2356,7 +2407,9 @@ void TrackResiduals::fillResidualTreeSeeds(PHCompositeNode* topNode)
       }
     }
     m_tracklength = maxR - minR;
-    // ---- we move the global positions back to the surface in fillClusterBranchesSeeds
+
+    // move the cluster positions back to the original readout surface, once per track
+    const auto global_moved = m_clusterMover.processTrack(global_raw);
 
     if (!m_doAlignment)
     {
@@ -2378,7 +2431,7 @@ void TrackResiduals::fillResidualTreeSeeds(PHCompositeNode* topNode)
 
       for (const auto& ckey : get_cluster_keys(track))
       {
-        fillClusterBranchesSeeds(ckey, global_raw, topNode);
+        fillClusterBranchesSeeds(ckey, global_raw, global_moved, topNode);
       }
     }
 
@@ -2397,7 +2450,12 @@ void TrackResiduals::fillResidualTreeSeeds(PHCompositeNode* topNode)
         {
           auto ckey = state->get_cluster_key();
 
-          fillClusterBranchesSeeds(ckey, global_raw, topNode);
+          fillClusterBranchesSeeds(ckey, global_raw, global_moved, topNode);
+
+          if (!hasBranchGroup(kDerivatives))
+          {
+            continue;
+          }
 
           auto& globderivs = state->get_global_derivative_matrix();
           auto& locderivs = state->get_local_derivative_matrix();
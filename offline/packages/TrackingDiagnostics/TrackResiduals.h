@@ -33,6 +33,22 @@ class TpcDistortionCorrectionContainer;
 class TrackResiduals : public SubsysReco
 {
  public:
+  //! optional branch groups of the residual tree, a group which is not selected is neither booked nor filled
+  enum BranchGroup : unsigned int
+  {
+    //! silicon and tpc seed parameters
+    kSeeds = 1U << 0U,
+    //! cluster adc, sizes, edge and overlap flags, hitset key and unmoved positions
+    kClusterDetails = 1U << 1U,
+    //! ideal and misaligned surface centers, normals and angles, ideal cluster positions
+    kSurfaces = 1U << 2U,
+    //! track states at the clusters
+    kStates = 1U << 3U,
+    //! alignment derivatives of the states, only filled with alignment()
+    kDerivatives = 1U << 4U,
+    kAllBranches = kSeeds | kClusterDetails | kSurfaces | kStates | kDerivatives
+  };
+
   TrackResiduals(const std::string &name = "TrackResiduals");
 
   ~TrackResiduals() override;
@@ -63,6 +79,12 @@ class TrackResiduals : public SubsysReco
 
   void set_doMicromegasOnly( bool value ) { m_doMicromegasOnly = value; }
 
+  //! select the optional branch groups of the residual tree, as an or of BranchGroup
+  void branchGroups(unsigned int groups) { m_branchGroups = groups; }
+
+  //! output file compression settings, 100 * algorithm + level (e.g. 404 for LZ4), ROOT default if negative
+  void compressionSettings(int settings) { m_compressionSettings = settings; }
+
  private:
   void fillStatesWithLineFit(const TrkrDefs::cluskey &ckey,
                              TrkrCluster *cluster, ActsGeometry *geometry);
@@ -77,11 +99,14 @@ class TrackResiduals : public SubsysReco
   void fillResidualTreeKF(PHCompositeNode *topNode);
   void fillResidualTreeSeeds(PHCompositeNode *topNode);
   void fillClusterBranchesKF(TrkrDefs::cluskey ckey, SvtxTrack *track,
+                             const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> &global,
                              const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> &global_moved,
                              PHCompositeNode *topNode);
   void fillClusterBranchesSeeds(TrkrDefs::cluskey ckey,  // SvtxTrack* track,
                                 const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> &global,
+                                const std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> &global_moved,
                                 PHCompositeNode *topNode);
+  bool hasBranchGroup(BranchGroup group) const { return (m_branchGroups & group) != 0; }
   void lineFitClusters(std::vector<TrkrDefs::cluskey> &keys, TrkrClusterContainer *clusters, const short int &crossing);
   void circleFitClusters(std::vector<TrkrDefs::cluskey> &keys, TrkrClusterContainer *clusters, const short int &crossing);
   void fillStatesWithCircleFit(const TrkrDefs::cluskey &key, TrkrCluster *cluster,
@@ -122,6 +147,9 @@ class TrackResiduals : public SubsysReco
 
   bool m_doMicromegasOnly = false;
 
+  unsigned int m_branchGroups = kAllBranches;
+  int m_compressionSettings = -1;
+
   int m_event = 0;
   int m_segment = std::numeric_limits<int>::quiet_NaN();
   int m_runnumber = std::numeric_limits<int>::quiet_NaN();
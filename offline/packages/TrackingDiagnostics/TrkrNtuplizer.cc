@@ -273,7 +273,14 @@ int TrkrNtuplizer::Init(PHCompositeNode* /*topNode*/)
   _ievent = 0;
 
   _tfile = new TFile(_filename.c_str(), "RECREATE");
-  _tfile->SetCompressionLevel(7);
+  if (m_compression_settings >= 0)
+  {
+    _tfile->SetCompressionSettings(m_compression_settings);
+  }
+  else
+  {
+    _tfile->SetCompressionLevel(7);
+  }
   string str_vertex = {"vertexID:vx:vy:vz:ntracks:chi2:ndof"};
   string str_event = {"event:seed:run:seg:job"};
   string str_hit = {"hitID:e:adc:layer:phielem:zelem:cellID:ecell:phibin:tbin:phi:r:x:y:z"};
@@ -328,12 +335,32 @@ int TrkrNtuplizer::Init(PHCompositeNode* /*topNode*/)
     string ntp_varlist_ssee = str_event + ":" + str_seed + ":" + str_info;
     _ntp_siseed = new TNtuple("ntp_siseed", "seeds from truth", ntp_varlist_ssee.c_str());
   }
+  for (TNtuple* ntp : {_ntp_info, _ntp_vertex, _ntp_hit, _ntp_cluster, _ntp_clus_trk, _ntp_track, _ntp_tpcseed, _ntp_siseed})
+  {
+    configure_ntuple(ntp);
+  }
   _timer = new PHTimer("_eval_timer");
   _timer->stop();
   /**/
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void TrkrNtuplizer::configure_ntuple(TNtuple* ntp) const
+{
+  if (!ntp)
+  {
+    return;
+  }
+  if (m_basket_size > 0)
+  {
+    ntp->SetBasketSize("*", m_basket_size);
+  }
+  if (m_auto_flush != 0)
+  {
+    ntp->SetAutoFlush(m_auto_flush);
+  }
+}
+
 int TrkrNtuplizer::InitRun(PHCompositeNode* /*unused*/)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -84,10 +84,21 @@ class TrkrNtuplizer : public SubsysReco
   void runnumber(const int run) { m_runnumber = run; }
   void job(const int job) { m_job = job; }
 
+  //! ROOT compression settings of the output file, algorithm * 100 + level (e.g. 404 for LZ4, 505 for ZSTD)
+  //! values < 0 keep the default compression level 7
+  void set_compression_settings(const int i) { m_compression_settings = i; }
+  //! basket size in bytes of all ntuple branches, 0 keeps the ROOT default
+  void set_basket_size(const int i) { m_basket_size = i; }
+  //! flush baskets every n entries (n > 0) or every -n bytes (n < 0), 0 keeps the ROOT default
+  void set_auto_flush(const Long64_t n) { m_auto_flush = n; }
+
  private:
   int m_segment = 0;
   int m_runnumber = 0;
   int m_job = 0;
+  int m_compression_settings = -1;
+  int m_basket_size = 0;
+  Long64_t m_auto_flush = 0;
 
   unsigned int _ievent{0};
   unsigned int _iseed{0};
@@ -103,6 +114,9 @@ class TrkrNtuplizer : public SubsysReco
                float &dca3dxysigma, float &dca3dzsigma);
   // TrkrClusterContainer *cluster_map{nullptr};
 
+  //! apply the basket settings to an output ntuple
+  void configure_ntuple(TNtuple *ntp) const;
+
   void FillCluster(Float_t fXcluster[30], TrkrDefs::cluskey cluster_key);
   void FillTrack(Float_t fXcluster[30], SvtxTrack *track, GlobalVertexMap *vertexmap);
   //----------------------------------
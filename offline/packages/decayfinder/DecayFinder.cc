@@ -45,6 +45,29 @@
 #include <map>        // for map, map<>::mapped_type, _Rb...
 #include <memory>     // for allocator_traits<>::value_type
 
+namespace
+{
+  // orders the G4 particle index by parent barcode
+  struct ParentBarcodeLess
+  {
+    template <class T>
+    bool operator()(const T& lhs, const T& rhs) const
+    {
+      return lhs.parent_barcode < rhs.parent_barcode;
+    }
+    template <class T>
+    bool operator()(const T& lhs, int barcode) const
+    {
+      return lhs.parent_barcode < barcode;
+    }
+    template <class T>
+    bool operator()(int barcode, const T& rhs) const
+    {
+      return barcode < rhs.parent_barcode;
+    }
+  };
+}  // namespace
+
 int listOfResonantPIDs[] = {111, 113, 213, 333, 310, 311, 313, 323, 413, 423, 513, 523, 441, 443, 100443, 9000111, 9000211, 100111, 100211, 10111,
                             10211, 9010111, 9010211, 10113, 10213, 20113, 20213, 9000113, 9000213, 100113, 100213, 9010113, 9010213, 9020113, 9020213,
                             30113, 30213, 9030113, 9030213, 9040113, 9040213, 115, 215, 10115, 10215, 9000115, 9000215, 9010115, 9010215, 117, 217,
@@ -290,6 +313,8 @@ int DecayFinder::parseDecayDescriptor()
     }
   }
 
+  compileDecayDescriptor();
+
   if (ddCanBeParsed)
   {
     if (Verbosity() >= VERBOSITY_MORE)
@@ -323,20 +348,7 @@ bool DecayFinder::findDecay(PHCompositeNode* topNode)
   bool aMotherHasPhoton = false;
   bool aMotherHasPi0 = false;
   std::vector<int> correctMotherProducts;
-  std::vector<int> positive_motherDecayProducts;
-
-  int n = sizeof(listOfResonantPIDs) / sizeof(listOfResonantPIDs[0]);
-  for (int i : m_intermediates_ID)
-  {
-    n = deleteElement(listOfResonantPIDs, n, i);
-  }
-
-  n = deleteElement(listOfResonantPIDs, n, m_mother_ID);
-
-  for (int m_motherDecayProduct : m_motherDecayProducts)
-  {
-    positive_motherDecayProducts.push_back(std::abs(m_motherDecayProduct));
-  }
+  const std::vector<int>& positive_motherDecayProducts = m_positive_motherDecayProducts;
 
   m_truthinfo = findNode::getClass<PHG4TruthInfoContainer>(topNode, "G4TruthInfo");
   if (!m_truthinfo)
@@ -357,6 +369,8 @@ bool DecayFinder::findDecay(PHCompositeNode* topNode)
     exit(1);
   }
 
+  buildGeant4ChildIndex();
+
   if (m_truthinfo && !m_geneventmap)  // This should use the truth info container if we have no HepMC record
   {
     if (Verbosity() >= VERBOSITY_SOME)
@@ -533,7 +547,7 @@ bool DecayFinder::findDecay(PHCompositeNode* topNode)
  * Function to search HepMC record
  * Can switch to Geant4 search if needed
  */
-void DecayFinder::searchHepMCRecord(HepMC::GenParticle* particle, std::vector<int> decayProducts,
+void DecayFinder::searchHepMCRecord(HepMC::GenParticle* particle, const std::vector<int>& decayProducts,
                                     bool& breakLoop, bool& hasPhoton, bool& hasPi0, bool& failedPT, bool& failedETA,
                                     std::vector<int>& actualDecayProducts)
 {
@@ -568,45 +582,16 @@ void DecayFinder::searchHepMCRecord(HepMC::GenParticle* particle, std::vector<in
         std::cout << "This is a child you were looking for" << std::endl;
       }
       // Check if this is an internediate decay that didnt decay in the generator
-      std::vector<int> positive_intermediates_ID;
-      for (int i : m_intermediates_ID)
-      {
-        positive_intermediates_ID.push_back(abs(i));
-      }
-
-      if (!(*children)->end_vertex() && std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(),
-                                                  abs((*children)->pdg_id())) != positive_intermediates_ID.end())
+      const int intermediate = (*children)->end_vertex() ? -1 : findIntermediate((*children)->pdg_id());
+      if (intermediate >= 0)
       {
-        std::vector<int> requiredIntermediateDecayProducts;
-        std::vector<int> positive_requiredIntermediateDecayProducts;
+        const IntermediateDecay& intermediateDecay = m_intermediateDecays[intermediate];
         std::vector<int> actualIntermediateDecayProducts;
-        // Which intermediate decay list to we need
-        auto it = std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(), abs((*children)->pdg_id()));
-        int index = std::distance(positive_intermediates_ID.begin(), it);
-
-        unsigned int trackStart = 0, trackStop = 0;
-        if (index == 0)
-        {
-          trackStop = m_nTracksFromIntermediates[0];
-        }
-        else
-        {
-          for (int i = 0; i < index; ++i)
-          {
-            trackStart += m_nTracksFromIntermediates[i];
-          }
-          trackStop = trackStart + m_nTracksFromIntermediates[index];
-        }
-        for (unsigned int i = trackStart; i < trackStop; ++i)
-        {
-          requiredIntermediateDecayProducts.push_back(m_daughters_ID[i]);
-          positive_requiredIntermediateDecayProducts.push_back(abs(m_daughters_ID[i]));
-        }
 
-        searchGeant4Record((*children)->barcode(), (*children)->pdg_id(), positive_requiredIntermediateDecayProducts,
+        searchGeant4Record((*children)->barcode(), (*children)->pdg_id(), intermediateDecay.positive_products,
                            breakLoop, hasPhoton, hasPi0, failedPT, failedETA, actualIntermediateDecayProducts);
 
-        bool needThisParticle = compareDecays(requiredIntermediateDecayProducts, actualIntermediateDecayProducts);
+        bool needThisParticle = compareDecays(intermediateDecay.products, actualIntermediateDecayProducts);
         if (needThisParticle)
         {
           actualDecayProducts.push_back((*children)->pdg_id());
@@ -630,8 +615,7 @@ void DecayFinder::searchHepMCRecord(HepMC::GenParticle* particle, std::vector<in
         }
       }
     }  // Now check if it's part of the resonance list
-    else if (std::find(std::begin(listOfResonantPIDs), std::end(listOfResonantPIDs),
-                       std::abs((*children)->pdg_id())) != std::end(listOfResonantPIDs))
+    else if (isResonance((*children)->pdg_id()))
     {
       if (Verbosity() >= VERBOSITY_MAX)
       {
@@ -668,10 +652,17 @@ void DecayFinder::searchHepMCRecord(HepMC::GenParticle* particle, std::vector<in
  *Function to search Geant4 record
  * Cannot switch to HepMC search (doesn't make sense to)
  */
-void DecayFinder::searchGeant4Record(int barcode, int pid, std::vector<int> decayProducts, bool& breakLoop, bool& hasPhoton, bool& hasPi0, bool& failedPT, bool& failedETA, std::vector<int>& actualDecayProducts)
+void DecayFinder::searchGeant4Record(int barcode, int pid, const std::vector<int>& decayProducts, bool& breakLoop, bool& hasPhoton, bool& hasPi0, bool& failedPT, bool& failedETA, std::vector<int>& actualDecayProducts)
 {
-  PHG4TruthInfoContainer::ConstRange range = m_truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+  if (decayChain.size() == 100)
+  {
+    breakLoop = true;  // Stuck in loop. Sympton not cause!
+    return;
+  }
+
+  // only the particles whose parent has this barcode
+  auto children = std::equal_range(m_geant4Children.begin(), m_geant4Children.end(), barcode, ParentBarcodeLess());
+  for (auto iter = children.first; iter != children.second; ++iter)
   {
     if (decayChain.size() == 100)
     {
@@ -679,17 +670,8 @@ void DecayFinder::searchGeant4Record(int barcode, int pid, std::vector<int> deca
       break;
     }
 
-    PHG4Particle* g4particle = iter->second;
-    PHG4Particle* mother = nullptr;
-    if (g4particle->get_parent_id() != 0)
-    {
-      mother = m_truthinfo->GetParticle(g4particle->get_parent_id());
-    }
-    else
-    {
-      continue;
-    }
-    if (mother->get_barcode() == barcode && abs(mother->get_pid()) == abs(pid))
+    PHG4Particle* g4particle = iter->particle;
+    if (abs(iter->parent_pid) == abs(pid))
     {
       int particleID = g4particle->get_pid();
       if (Verbosity() >= VERBOSITY_MAX)
@@ -730,8 +712,7 @@ void DecayFinder::searchGeant4Record(int barcode, int pid, std::vector<int> deca
       {
         continue;
       }
-      else if (std::find(std::begin(listOfResonantPIDs), std::end(listOfResonantPIDs),
-                         std::abs(particleID)) != std::end(listOfResonantPIDs))
+      else if (isResonance(particleID))
       {
         if (Verbosity() >= VERBOSITY_MAX)
         {
@@ -756,40 +737,12 @@ bool DecayFinder::checkIfCorrectHepMCParticle(HepMC::GenParticle* particle, bool
 {
   bool acceptParticle = false;
 
-  std::vector<int> positive_intermediates_ID;
-  for (int i : m_intermediates_ID)
-  {
-    positive_intermediates_ID.push_back(abs(i));
-  }
-
   // Check if it is an intermediate or a final track
-  if (std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(),
-                abs(particle->pdg_id())) != positive_intermediates_ID.end())
+  const int intermediate = findIntermediate(particle->pdg_id());
+  if (intermediate >= 0)
   {
-    std::vector<int> requiredIntermediateDecayProducts;
+    const std::vector<int>& requiredIntermediateDecayProducts = m_intermediateDecays[intermediate].products;
     std::vector<int> actualIntermediateDecayProducts;
-    // Which intermediate decay list to we need
-    auto it = std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(), abs(particle->pdg_id()));
-    int index = std::distance(positive_intermediates_ID.begin(), it);
-
-    unsigned int trackStart = 0, trackStop = 0;
-    if (index == 0)
-    {
-      trackStop = m_nTracksFromIntermediates[0];
-    }
-    else
-    {
-      for (int i = 0; i < index; ++i)
-      {
-        trackStart += m_nTracksFromIntermediates[i];
-      }
-      trackStop = trackStart + m_nTracksFromIntermediates[index];
-    }
-
-    for (unsigned int i = trackStart; i < trackStop; ++i)
-    {
-      requiredIntermediateDecayProducts.push_back(m_daughters_ID[i]);
-    }
 
     for (HepMC::GenVertex::particle_iterator grandchildren = particle->end_vertex()->particles_begin(HepMC::children);
          grandchildren != particle->end_vertex()->particles_end(HepMC::children); ++grandchildren)
@@ -799,8 +752,7 @@ bool DecayFinder::checkIfCorrectHepMCParticle(HepMC::GenParticle* particle, bool
         std::cout << "----grandchildren->pdg_id(): " << (*grandchildren)->pdg_id() << std::endl;
       }
 
-      if (std::find(std::begin(listOfResonantPIDs), std::end(listOfResonantPIDs),
-                    std::abs((*grandchildren)->pdg_id())) != std::end(listOfResonantPIDs))
+      if (isResonance((*grandchildren)->pdg_id()))
       {
         for (HepMC::GenVertex::particle_iterator greatgrandchildren = (*grandchildren)->end_vertex()->particles_begin(HepMC::children);
              greatgrandchildren != (*grandchildren)->end_vertex()->particles_end(HepMC::children); ++greatgrandchildren)
@@ -941,47 +893,18 @@ bool DecayFinder::checkIfCorrectGeant4Particle(PHG4Particle* particle, bool& has
 {
   bool acceptParticle = false;
 
-  std::vector<int> positive_intermediates_ID;
-  for (int i : m_intermediates_ID)
-  {
-    positive_intermediates_ID.push_back(abs(i));
-  }
   // Check if it is an intermediate or a final track
-  if (std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(),
-                abs(particle->get_pid())) != positive_intermediates_ID.end())
+  const int intermediate = findIntermediate(particle->get_pid());
+  if (intermediate >= 0)
   {
-    std::vector<int> requiredIntermediateDecayProducts;
+    const IntermediateDecay& intermediateDecay = m_intermediateDecays[intermediate];
     std::vector<int> actualIntermediateDecayProducts;
-    // Which intermediate decay list to we need
-    auto it = std::find(positive_intermediates_ID.begin(), positive_intermediates_ID.end(), abs(particle->get_pid()));
-    int index = std::distance(positive_intermediates_ID.begin(), it);
-
-    unsigned int trackStart = 0, trackStop = 0;
-    if (index == 0)
-    {
-      trackStop = m_nTracksFromIntermediates[0];
-    }
-    else
-    {
-      for (int i = 0; i < index; ++i)
-      {
-        trackStart += m_nTracksFromIntermediates[i];
-      }
-      trackStop = trackStart + m_nTracksFromIntermediates[index];
-    }
-
-    std::vector<int> positive_intermediateDecayProducts;
-    for (unsigned int i = trackStart; i < trackStop; ++i)
-    {
-      positive_intermediateDecayProducts.push_back(abs(m_daughters_ID[i]));
-      requiredIntermediateDecayProducts.push_back(m_daughters_ID[i]);
-    }
 
     bool fakeBreak = false;
-    searchGeant4Record(particle->get_barcode(), particle->get_pid(), positive_intermediateDecayProducts, fakeBreak,
+    searchGeant4Record(particle->get_barcode(), particle->get_pid(), intermediateDecay.positive_products, fakeBreak,
                        hasPhoton, hasPi0, trackFailedPT, trackFailedETA, actualIntermediateDecayProducts);
 
-    acceptParticle = compareDecays(requiredIntermediateDecayProducts, actualIntermediateDecayProducts);
+    acceptParticle = compareDecays(intermediateDecay.products, actualIntermediateDecayProducts);
   }
   else if ((particle->get_pid() == 22) || (particle->get_pid() == 111))
   {
@@ -1099,6 +1022,87 @@ bool DecayFinder::compareDecays(std::vector<int> required, std::vector<int> actu
 /*
  * Everything below this is helper functions
  */
+void DecayFinder::compileDecayDescriptor()
+{
+  // resonances to look through, the particles of the decay descriptor are searched for explicitly
+  int n = sizeof(listOfResonantPIDs) / sizeof(listOfResonantPIDs[0]);
+  m_resonantPIDs.assign(std::begin(listOfResonantPIDs), std::end(listOfResonantPIDs));
+  for (int i : m_intermediates_ID)
+  {
+    n = deleteElement(m_resonantPIDs.data(), n, i);
+  }
+  n = deleteElement(m_resonantPIDs.data(), n, m_mother_ID);
+  m_resonantPIDs.resize(n);
+  std::sort(m_resonantPIDs.begin(), m_resonantPIDs.end());
+
+  m_intermediateDecays.clear();
+  unsigned int trackStart = 0;
+  for (unsigned int i = 0; i < m_intermediates_ID.size(); ++i)
+  {
+    IntermediateDecay intermediateDecay;
+    intermediateDecay.positive_id = abs(m_intermediates_ID[i]);
+    const unsigned int trackStop = trackStart + m_nTracksFromIntermediates[i];
+    for (unsigned int j = trackStart; j < trackStop; ++j)
+    {
+      intermediateDecay.products.push_back(m_daughters_ID[j]);
+      intermediateDecay.positive_products.push_back(abs(m_daughters_ID[j]));
+    }
+    m_intermediateDecays.push_back(intermediateDecay);
+    trackStart = trackStop;
+  }
+
+  m_positive_motherDecayProducts.clear();
+  for (int m_motherDecayProduct : m_motherDecayProducts)
+  {
+    m_positive_motherDecayProducts.push_back(std::abs(m_motherDecayProduct));
+  }
+}
+
+int DecayFinder::findIntermediate(int pid) const
+{
+  for (unsigned int i = 0; i < m_intermediateDecays.size(); ++i)
+  {
+    if (m_intermediateDecays[i].positive_id == abs(pid))
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool DecayFinder::isResonance(int pid) const
+{
+  return std::binary_search(m_resonantPIDs.begin(), m_resonantPIDs.end(), std::abs(pid));
+}
+
+void DecayFinder::buildGeant4ChildIndex()
+{
+  m_geant4Children.clear();
+  if (!m_truthinfo)
+  {
+    return;
+  }
+
+  PHG4TruthInfoContainer::ConstRange range = m_truthinfo->GetParticleRange();
+  for (PHG4TruthInfoContainer::ConstIterator iter = range.first; iter != range.second; ++iter)
+  {
+    PHG4Particle* g4particle = iter->second;
+    if (g4particle->get_parent_id() == 0)
+    {
+      continue;
+    }
+    PHG4Particle* mother = m_truthinfo->GetParticle(g4particle->get_parent_id());
+    if (!mother)
+    {
+      continue;
+    }
+    m_geant4Children.push_back({mother->get_barcode(), mother->get_pid(), g4particle});
+  }
+
+  // stable, so the children of a parent keep the order of the truth container
+  std::stable_sort(m_geant4Children.begin(), m_geant4Children.end(), ParentBarcodeLess());
+}
+
 int DecayFinder::deleteElement(int arr[], int n, int x)
 {
   // https://www.geeksforgeeks.org/delete-an-element-from-array-using-two-traversals-and-one-traversal/
@@ -45,11 +45,11 @@ class DecayFinder : public SubsysReco
 
   bool findParticle(const std::string &particle);
 
-  void searchHepMCRecord(HepMC::GenParticle *particle, std::vector<int> decayProducts,
+  void searchHepMCRecord(HepMC::GenParticle *particle, const std::vector<int> &decayProducts,
                          bool &breakLoop, bool &hasPhoton, bool &hasPi0, bool &failedPT, bool &failedETA,
                          std::vector<int> &correctDecayProducts);
 
-  void searchGeant4Record(int barcode, int pid, std::vector<int> decayProducts,
+  void searchGeant4Record(int barcode, int pid, const std::vector<int> &decayProducts,
                           bool &breakLoop, bool &hasPhoton, bool &hasPi0, bool &failedPT, bool &failedETA,
                           std::vector<int> &correctDecayProducts);
 
@@ -157,6 +157,41 @@ class DecayFinder : public SubsysReco
   PHHepMCGenEvent *m_genevt = nullptr;
   PHG4TruthInfoContainer *m_truthinfo = nullptr;
 
+  //! lookup tables built once from the parsed decay descriptor
+  void compileDecayDescriptor();
+
+  //! index of the intermediate with this pid (either charge), -1 if none
+  int findIntermediate(int pid) const;
+
+  //! true if a particle with this pid is a resonance to look through
+  bool isResonance(int pid) const;
+
+  //! per event index of the G4 particles by the barcode of their parent
+  void buildGeant4ChildIndex();
+
+  struct IntermediateDecay
+  {
+    int positive_id = 0;
+    std::vector<int> products;
+    std::vector<int> positive_products;
+  };
+  std::vector<IntermediateDecay> m_intermediateDecays;
+
+  //! sorted resonances, without the particles of the decay descriptor
+  std::vector<int> m_resonantPIDs;
+
+  std::vector<int> m_positive_motherDecayProducts;
+
+  struct Geant4Child
+  {
+    int parent_barcode = 0;
+    int parent_pid = 0;
+    PHG4Particle *particle = nullptr;
+  };
+
+  //! G4 particles sorted by parent barcode, in container order for each parent
+  std::vector<Geant4Child> m_geant4Children;
+
   void recalculateEta(double py, double vertex[3]);
   void calculateEffectiveTPCradius(double vertex[3], double &effective_top_r, double &effective_bottom_r);
   bool m_recalcualteEtaRange = true;
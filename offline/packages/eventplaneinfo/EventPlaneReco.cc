@@ -32,6 +32,7 @@
 #include <phool/phool.h> // for PHWHERE
 #include <phool/recoConsts.h>
 
+#include <algorithm>
 #include <array> // for array
 #include <cfloat>
 #include <cmath>
@@ -55,6 +56,12 @@ EventPlaneReco::EventPlaneReco(const std::string &name) : SubsysReco(name) {
 }
 
 int EventPlaneReco::InitRun(PHCompositeNode *topNode) {
+  // the number of orders can be changed after the constructor
+  south_q.assign(m_MaxOrder, std::vector<double>(2, 0.));
+  north_q.assign(m_MaxOrder, std::vector<double>(2, 0.));
+  m_sepd_table.geom = nullptr;
+  m_mbd_table.geom = nullptr;
+
   if (!m_overrideSEPDMapName) {
     m_sEPDMapName = "SEPD_CHANNELMAP";
   }
@@ -123,7 +130,21 @@ int EventPlaneReco::process_event(PHCompositeNode *topNode) {
                   << std::endl;
       }
 
-      unsigned int ntowers = epd_towerinfo->size();
+      // tile phi only changes with the geometry
+      if (m_sepd_table.geom != _epdgeom) {
+        std::vector<float> tile_phi(vkey.size());
+        std::vector<int> tile_arm(vkey.size());
+        for (unsigned int ch = 0; ch < vkey.size(); ch++) {
+          tile_phi[ch] = _epdgeom->get_phi(vkey[ch]);
+          tile_arm[ch] = TowerInfoDefs::get_epd_arm(vkey[ch]);
+        }
+        BuildTable(m_sepd_table, tile_phi, tile_arm);
+        m_sepd_table.geom = _epdgeom;
+      }
+
+      m_south_w.assign(vkey.size(), 0.);
+      m_north_w.assign(vkey.size(), 0.);
+      unsigned int ntowers = std::min<unsigned int>(epd_towerinfo->size(), vkey.size());
       for (unsigned int ch = 0; ch < ntowers; ch++) {
         TowerInfo *_tower = epd_towerinfo->get_tower_at_channel(ch);
         float epd_e = _tower->get_energy();
@@ -134,27 +155,16 @@ int EventPlaneReco::process_event(PHCompositeNode *topNode) {
           {
             continue;
           }
-          float tile_phi = _epdgeom->get_phi(vkey[ch]);
-          int arm = TowerInfoDefs::get_epd_arm(vkey[ch]);
           float truncated_e =
               (epd_e < _epd_e) ? epd_e : _epd_e; // set cutoff at _epd_e
-          if (arm == 0) {
-            for (unsigned int order = 0; order < m_MaxOrder; order++) {
-              double Cosine = cos(tile_phi * (double)(order + 1));
-              double Sine = sin(tile_phi * (double)(order + 1));
-              south_q[order][0] += truncated_e * Cosine; // south Qn,x
-              south_q[order][1] += truncated_e * Sine;   // south Qn,y
-            }
-          } else if (arm == 1) {
-            for (unsigned int order = 0; order < m_MaxOrder; order++) {
-              double Cosine = cos(tile_phi * (double)(order + 1));
-              double Sine = sin(tile_phi * (double)(order + 1));
-              north_q[order][0] += truncated_e * Cosine; // north Qn,x
-              north_q[order][1] += truncated_e * Sine;   // north Qn,y
-            }
+          if (m_sepd_table.arm[ch] == 0) {
+            m_south_w[ch] = truncated_e;
+          } else if (m_sepd_table.arm[ch] == 1) {
+            m_north_w[ch] = truncated_e;
           }
         }
       }
+      AccumulateQ(m_sepd_table);
     }
     for (unsigned int order = 0; order < m_MaxOrder; order++) {
       south_Qvec.emplace_back(south_q[order][0], south_q[order][1]);
@@ -208,30 +218,30 @@ int EventPlaneReco::process_event(PHCompositeNode *topNode) {
         mbdQ += mbd_q;
       }
 
-      for (int ipmt = 0; ipmt < mbdpmts->get_npmt(); ipmt++) {
-        float mbd_q = mbdpmts->get_pmt(ipmt)->get_q();
-        float phi = mbdgeom->get_phi(ipmt);
-        int arm = mbdgeom->get_arm(ipmt);
-
-        if (mbdQ < _mbd_e) {
-          continue;
+      if (!(mbdQ < _mbd_e)) {
+        const unsigned int npmt = mbdpmts->get_npmt();
+        if (m_mbd_table.geom != mbdgeom || m_mbd_table.arm.size() != npmt) {
+          std::vector<float> pmt_phi(npmt);
+          std::vector<int> pmt_arm(npmt);
+          for (unsigned int ipmt = 0; ipmt < npmt; ipmt++) {
+            pmt_phi[ipmt] = mbdgeom->get_phi(ipmt);
+            pmt_arm[ipmt] = mbdgeom->get_arm(ipmt);
+          }
+          BuildTable(m_mbd_table, pmt_phi, pmt_arm);
+          m_mbd_table.geom = mbdgeom;
         }
 
-        if (arm == 0) {
-          for (unsigned int order = 0; order < m_MaxOrder; order++) {
-            double Cosine = cos(phi * (double)(order + 1));
-            double Sine = sin(phi * (double)(order + 1));
-            south_q[order][0] += mbd_q * Cosine; // south Qn,x
-            south_q[order][1] += mbd_q * Sine;   // south Qn,y
-          }
-        } else if (arm == 1) {
-          for (unsigned int order = 0; order < m_MaxOrder; order++) {
-            double Cosine = cos(phi * (double)(order + 1));
-            double Sine = sin(phi * (double)(order + 1));
-            north_q[order][0] += mbd_q * Cosine; // north Qn,x
-            north_q[order][1] += mbd_q * Sine;   // north Qn,y
+        m_south_w.assign(npmt, 0.);
+        m_north_w.assign(npmt, 0.);
+        for (unsigned int ipmt = 0; ipmt < npmt; ipmt++) {
+          float mbd_q = mbdpmts->get_pmt(ipmt)->get_q();
+          if (m_mbd_table.arm[ipmt] == 0) {
+            m_south_w[ipmt] = mbd_q;
+          } else if (m_mbd_table.arm[ipmt] == 1) {
+            m_north_w[ipmt] = mbd_q;
           }
         }
+        AccumulateQ(m_mbd_table);
       }
     }
 
@@ -293,6 +303,49 @@ int EventPlaneReco::CreateNodes(PHCompositeNode *topNode) {
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void EventPlaneReco::BuildTable(HarmonicTable &table,
+                                const std::vector<float> &phi,
+                                const std::vector<int> &arm) {
+  const unsigned int nch = phi.size();
+  table.cosine.assign(m_MaxOrder * nch, 0.);
+  table.sine.assign(m_MaxOrder * nch, 0.);
+  table.arm = arm;
+  for (unsigned int ch = 0; ch < nch; ch++) {
+    // channels without geometry are not used
+    if (!std::isfinite(phi[ch])) {
+      table.arm[ch] = -1;
+      continue;
+    }
+    for (unsigned int order = 0; order < m_MaxOrder; order++) {
+      table.cosine[order * nch + ch] = cos(phi[ch] * (double)(order + 1));
+      table.sine[order * nch + ch] = sin(phi[ch] * (double)(order + 1));
+    }
+  }
+}
+
+void EventPlaneReco::AccumulateQ(const HarmonicTable &table) {
+  // same summation order over channels as a loop over the towers
+  const unsigned int nch = table.arm.size();
+  for (unsigned int order = 0; order < m_MaxOrder; order++) {
+    const double *Cosine = table.cosine.data() + order * nch;
+    const double *Sine = table.sine.data() + order * nch;
+    double sqx = 0;
+    double sqy = 0;
+    double nqx = 0;
+    double nqy = 0;
+    for (unsigned int ch = 0; ch < nch; ch++) {
+      sqx += m_south_w[ch] * Cosine[ch]; // south Qn,x
+      sqy += m_south_w[ch] * Sine[ch];   // south Qn,y
+      nqx += m_north_w[ch] * Cosine[ch]; // north Qn,x
+      nqy += m_north_w[ch] * Sine[ch];   // north Qn,y
+    }
+    south_q[order][0] += sqx;
+    south_q[order][1] += sqy;
+    north_q[order][0] += nqx;
+    north_q[order][1] += nqy;
+  }
+}
+
 void EventPlaneReco::ResetMe() {
   for (auto &vec : south_q) {
     std::fill(vec.begin(), vec.end(), 0.);
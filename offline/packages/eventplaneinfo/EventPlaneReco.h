@@ -13,6 +13,8 @@
 #include <string> // for string
 #include <vector> // for vector
 
+class EpdGeom;
+class MbdGeom;
 class PHCompositeNode;
 
 class EventPlaneReco : public SubsysReco {
@@ -33,8 +35,25 @@ public:
 private:
   int CreateNodes(PHCompositeNode *topNode);
 
+  // cos(n phi) and sin(n phi) of each channel for all orders, order major
+  struct HarmonicTable {
+    std::vector<double> cosine;
+    std::vector<double> sine;
+    std::vector<int> arm;
+    const void *geom{nullptr}; // geometry the table was built from
+  };
+  void BuildTable(HarmonicTable &table, const std::vector<float> &phi,
+                  const std::vector<int> &arm);
+  // add the Q-vectors of the channel weights of each arm
+  void AccumulateQ(const HarmonicTable &table);
+
   unsigned int m_MaxOrder{3};
 
+  HarmonicTable m_sepd_table;
+  HarmonicTable m_mbd_table;
+  std::vector<double> m_south_w;
+  std::vector<double> m_north_w;
+
   std::vector<std::vector<double>> south_q;
   std::vector<std::vector<double>> north_q;
   std::vector<std::pair<double, double>> south_Qvec;
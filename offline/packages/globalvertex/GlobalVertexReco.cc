@@ -23,15 +23,75 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <algorithm>
 #include <cfloat>
+#include <climits>
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <set>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
+#include <vector>
 
 using namespace std;
 
+namespace
+{
+  //! MBD vertex used for the SVTX matching
+  struct MbdCandidate
+  {
+    float z = 0;
+    float zerr2 = 0;
+    unsigned int key = 0;
+    const MbdVertex *vertex = nullptr;
+  };
+
+  //! global vertex z and id
+  using ZVertex = std::pair<float, unsigned int>;
+
+  //! id of the vertex nearest in z from z sorted vertices, the first in id order for ties
+  unsigned int nearest_in_z(const std::vector<ZVertex> &vertices, const float z)
+  {
+    unsigned int vtxid = std::numeric_limits<unsigned int>::max();
+    float mindz = std::numeric_limits<float>::max();
+    const auto iter = std::lower_bound(vertices.begin(), vertices.end(), ZVertex(z, 0));
+
+    // the nearest vertex is next to z, all vertices at the same z are tested for the smallest id
+    auto check = [&](const ZVertex &vertex)
+    {
+      const float dz = fabs(z - vertex.first);
+      if (dz < mindz || (dz == mindz && vertex.second < vtxid))
+      {
+        mindz = dz;
+        vtxid = vertex.second;
+      }
+    };
+    if (iter != vertices.end())
+    {
+      for (auto next = iter; next != vertices.end() && next->first == iter->first; ++next)
+      {
+        check(*next);
+      }
+    }
+    if (iter != vertices.begin())
+    {
+      const float zprev = std::prev(iter)->first;
+      for (auto prev = std::prev(iter); prev->first == zprev; --prev)
+      {
+        check(*prev);
+        if (prev == vertices.begin())
+        {
+          break;
+        }
+      }
+    }
+    return vtxid;
+  }
+}  // namespace
+
 GlobalVertexReco::GlobalVertexReco(const string &name)
   : SubsysReco(name)
 {
@@ -88,6 +148,9 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
   std::set<unsigned int> used_svtx_vtxids;
   std::set<unsigned int> used_mbd_vtxids;
 
+  // beam crossing of the global vertices, for the association of the remaining tracks
+  std::map<unsigned int, unsigned int> vertex_crossings;
+
   if (svtxmap && mbdmap)
   {
     if (Verbosity())
@@ -95,27 +158,55 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
       cout << "GlobalVertexReco::process_event - svtxmap && mbdmap" << endl;
     }
 
+    // MBD vertices sorted in z. The matching sigma of a MBD vertex is above |dz| over the combined
+    // error with the largest MBD error, which stops the search on both sides of the SVTX z
+    std::vector<MbdCandidate> mbd_candidates;
+    float max_mbd_zerr2 = 0;
+    for (const auto &[mbdkey, mbd] : *mbdmap)
+    {
+      // a nan z never gives the best match
+      if (isnan(mbd->get_z()))
+      {
+        continue;
+      }
+      mbd_candidates.push_back({mbd->get_z(), static_cast<float>(pow(mbd->get_z_err(), 2)), mbdkey, mbd});
+      max_mbd_zerr2 = std::max(max_mbd_zerr2, mbd_candidates.back().zerr2);
+    }
+    std::sort(mbd_candidates.begin(), mbd_candidates.end(), [](const MbdCandidate &lhs, const MbdCandidate &rhs)
+              { return lhs.z < rhs.z; });
+
     for (SvtxVertexMap::ConstIter svtxiter = svtxmap->begin();
          svtxiter != svtxmap->end();
          ++svtxiter)
     {
       const SvtxVertex *svtx = svtxiter->second;
 
+      // closest in sigma, the first in the MBD map for ties
       const MbdVertex *mbd_best = nullptr;
+      unsigned int mbd_best_key = 0;
       float min_sigma = FLT_MAX;
-      for (MbdVertexMap::ConstIter mbditer = mbdmap->begin();
-           mbditer != mbdmap->end();
-           ++mbditer)
+      const float max_combined_error = sqrt(svtx->get_error(2, 2) + max_mbd_zerr2);
+      auto check = [&](const MbdCandidate &candidate)
       {
-        const MbdVertex *mbd = mbditer->second;
-
-        float combined_error = sqrt(svtx->get_error(2, 2) + pow(mbd->get_z_err(), 2));
-        float sigma = fabs(svtx->get_z() - mbd->get_z()) / combined_error;
-        if (sigma < min_sigma)
+        float combined_error = sqrt(svtx->get_error(2, 2) + candidate.zerr2);
+        float sigma = fabs(svtx->get_z() - candidate.z) / combined_error;
+        if (sigma < min_sigma || (sigma == min_sigma && mbd_best && candidate.key < mbd_best_key))
         {
           min_sigma = sigma;
-          mbd_best = mbd;
+          mbd_best = candidate.vertex;
+          mbd_best_key = candidate.key;
         }
+      };
+
+      const auto first_above = std::lower_bound(mbd_candidates.begin(), mbd_candidates.end(), svtx->get_z(), [](const MbdCandidate &candidate, float z)
+                                                { return candidate.z < z; });
+      for (auto iter = first_above; iter != mbd_candidates.end() && !(fabs(svtx->get_z() - iter->z) / max_combined_error > min_sigma); ++iter)
+      {
+        check(*iter);
+      }
+      for (auto iter = std::make_reverse_iterator(first_above); iter != mbd_candidates.rend() && !(fabs(svtx->get_z() - iter->z) / max_combined_error > min_sigma); ++iter)
+      {
+        check(*iter);
       }
 
       if (min_sigma > 3.0 || !mbd_best)
@@ -132,6 +223,7 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
       used_svtx_vtxids.insert(svtx->get_id());
       used_mbd_vtxids.insert(mbd_best->get_id());
       vertex->set_id(globalmap->size());
+      vertex_crossings[vertex->get_id()] = svtx->get_beam_crossing();
 
       globalmap->insert(vertex);
 
@@ -183,6 +275,7 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
 
       vertex->insert_vtx(GlobalVertex::SVTX, svtx);
       used_svtx_vtxids.insert(svtx->get_id());
+      vertex_crossings[vertex->get_id()] = svtx->get_beam_crossing();
 
       //! Reset track ids to the new vertex object
       if (trackmap)
@@ -231,6 +324,7 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
 
       vertex->insert_vtx(GlobalVertex::MBD, mbd);
       used_mbd_vtxids.insert(mbd->get_id());
+      vertex_crossings[vertex->get_id()] = 0;
 
       globalmap->insert(vertex);
 
@@ -244,6 +338,26 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
   /// Associate any tracks that were not assigned a track-vertex
   if (trackmap)
   {
+    // global vertices sorted in z, per beam crossing of their SVTX vertex. MBD only vertices belong to the triggered crossing
+    std::map<unsigned int, std::vector<ZVertex>> crossing_vertices;
+    std::vector<ZVertex> all_vertices;
+    for (const auto &[vkey, vertex] : *globalmap)
+    {
+      // a nan z is never the nearest
+      if (isnan(vertex->get_z()))
+      {
+        continue;
+      }
+      const auto crossing = vertex_crossings.find(vkey);
+      crossing_vertices[crossing == vertex_crossings.end() ? std::numeric_limits<unsigned int>::max() : crossing->second].emplace_back(vertex->get_z(), vkey);
+      all_vertices.emplace_back(vertex->get_z(), vkey);
+    }
+    for (auto &[crossing, vertices] : crossing_vertices)
+    {
+      std::sort(vertices.begin(), vertices.end());
+    }
+    std::sort(all_vertices.begin(), all_vertices.end());
+
     for (const auto &[tkey, track] : *trackmap)
     {
       //! Check that the vertex hasn't already been assigned
@@ -253,18 +367,18 @@ int GlobalVertexReco::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      float maxdz = std::numeric_limits<float>::max();
-      unsigned int vtxid = std::numeric_limits<unsigned int>::max();
-
-      for (const auto &[vkey, vertex] : *globalmap)
+      // nearest vertex in z from the crossing of the track if known, from all vertices otherwise
+      const std::vector<ZVertex> *vertices = &all_vertices;
+      if (track->get_crossing() != SHRT_MAX)
       {
-        float dz = track->get_z() - vertex->get_z();
-        if (fabs(dz) < maxdz)
+        // same conversion as for the SVTX vertex beam crossing
+        const auto crossing = crossing_vertices.find(static_cast<unsigned int>(track->get_crossing()));
+        if (crossing != crossing_vertices.end())
         {
-          maxdz = dz;
-          vtxid = vkey;
+          vertices = &crossing->second;
         }
       }
+      unsigned int vtxid = nearest_in_z(*vertices, track->get_z());
 
       track->set_vertex_id(vtxid);
       if (Verbosity())
@@ -14,6 +14,7 @@
 #include <boost/format.hpp>
 
 #include <algorithm>
+#include <cmath>
 #include <filesystem>
 #include <iostream>
 #include <numeric>
@@ -210,6 +211,15 @@ void INTTZvtx::Characterize_Pad(TPad* pad, float left, float right, float top, f
 
 void INTTZvtx::Init()
 {
+  if (m_fast_mode)
+  {
+    // note : no histogram, canvas or output file in the fast mode
+    draw_event_display = false;
+    m_enable_qa = false;
+    m_initialized = true;
+    return;
+  }
+
   if (!std::filesystem::exists(out_folder_directory))
   {
     std::filesystem::create_directory(out_folder_directory);
@@ -236,8 +246,8 @@ void INTTZvtx::InitHist()
   evt_possible_z->GetXaxis()->SetTitle("Z [mm]");
   evt_possible_z->GetYaxis()->SetTitle("Entry");
 
-  int N = 1200;        // note : N bins for each side, regardless the bin at zero
-  double width = 0.5;  // note : bin width with the unit [mm]
+  int N = line_breakdown_N;          // note : N bins for each side, regardless the bin at zero
+  double width = line_breakdown_width;  // note : bin width with the unit [mm]
   line_breakdown_hist = new TH1F("line_breakdown_hist", "line_breakdown_hist", 2 * N + 1, -1 * (width * N + width / 2.), width * N + width / 2.);
   line_breakdown_hist->SetLineWidth(1);
   line_breakdown_hist->GetXaxis()->SetTitle("Z [mm]");
@@ -689,6 +699,13 @@ bool INTTZvtx::ProcessEvt(
     return false;
   }
 
+  if (m_fast_mode)
+  {
+    ProcessEvtFast(temp_sPH_inner_nocolumn_vec, temp_sPH_outer_nocolumn_vec);
+    m_zvtxinfo.nclus = total_NClus;
+    return true;
+  }
+
   //--std::cout<<"--1--"<<std::endl;
   //-----------------
   // cluster pair
@@ -1338,6 +1355,12 @@ void INTTZvtx::ClearEvt()
   N_group_info.clear();
   N_group_info_detail = {-1., -1., -1., -1.};
 
+  if (m_fast_mode)
+  {
+    // note : the fast mode buffers are refilled by each event
+    return;
+  }
+
   evt_possible_z->Reset("ICESM");
   line_breakdown_hist->Reset("ICESM");
 
@@ -1358,6 +1381,175 @@ void INTTZvtx::ClearEvt()
   // line_breakdown_gaus_ratio_hist -> Reset("ICESM");
 }
 
+void INTTZvtx::Fill_fast_clu(const std::vector<clu_info>& clu_in, std::vector<fast_clu_info>& clu_out)
+{
+  clu_out.clear();
+  for (const auto& clu : clu_in)
+  {
+    double phi = (clu.y - beam_origin.second < 0)
+                     ? atan2(clu.y - beam_origin.second, clu.x - beam_origin.first) * (180. / TMath::Pi()) + 360
+                     : atan2(clu.y - beam_origin.second, clu.x - beam_origin.first) * (180. / TMath::Pi());
+    clu_out.push_back({phi, clu.x, clu.y, get_radius(clu.x - beam_origin.first, clu.y - beam_origin.second), clu.z});
+
+    if (clu.z > 0)
+    {
+      out_N_cluster_north += 1;
+    }
+    else
+    {
+      out_N_cluster_south += 1;
+    }
+  }
+  std::sort(clu_out.begin(), clu_out.end(), [](const fast_clu_info& lhs, const fast_clu_info& rhs)
+            { return lhs.phi < rhs.phi; });
+}
+
+void INTTZvtx::ProcessEvtFast(const std::vector<clu_info>& inner_clu, const std::vector<clu_info>& outer_clu)
+{
+  Fill_fast_clu(inner_clu, fast_inner_clu);
+  Fill_fast_clu(outer_clu, fast_outer_clu);
+
+  // note : same binning as line_breakdown_hist, bin 0 and nbins + 1 are the under and overflow.
+  // note : filled as a difference array, each tracklet only changes the bins at its edges
+  const int nbins = 2 * line_breakdown_N + 1;
+  const double xmin = -1 * (line_breakdown_width * line_breakdown_N + line_breakdown_width / 2.);
+  const double xmax = line_breakdown_width * line_breakdown_N + line_breakdown_width / 2.;
+  const double bin_width = (xmax - xmin) / nbins;
+  fast_line_breakdown.assign(nbins + 3, 0);
+
+  // note : same binning as evt_possible_z
+  const int nbins_possible_z = 50;
+  fast_possible_z.assign(nbins_possible_z, 0.);
+
+  unsigned int ntracklets = 0;
+  auto pair_clusters = [&](const fast_clu_info& inner, const fast_clu_info& outer)
+  {
+    if (fabs(get_delta_phi(inner.phi, outer.phi)) >= phi_diff_cut)
+    {
+      return;
+    }
+
+    double DCA_sign = calculateAngleBetweenVectors(outer.x, outer.y, inner.x, inner.y, beam_origin.first, beam_origin.second);
+    if (!(DCA_cut.first < DCA_sign && DCA_sign < DCA_cut.second))
+    {
+      return;
+    }
+
+    std::pair<double, double> z_range_info = Get_possible_zvtx(0., inner.r, inner.z, outer.r, outer.z);
+    if (!(evt_possible_z_range.first < z_range_info.first && z_range_info.first < evt_possible_z_range.second))
+    {
+      return;
+    }
+
+    ++ntracklets;
+    fast_possible_z[int(nbins_possible_z * (z_range_info.first - evt_possible_z_range.first) / (evt_possible_z_range.second - evt_possible_z_range.first))] += 1;
+
+    // note : same bin range as line_breakdown
+    int first_bin = int((z_range_info.first - z_range_info.second - xmin) / bin_width) + 1;
+    int last_bin = int((z_range_info.first + z_range_info.second - xmin) / bin_width) + 1;
+    first_bin = std::clamp(first_bin, 0, nbins + 1);
+    last_bin = std::clamp(last_bin, 0, nbins + 1);
+    fast_line_breakdown[first_bin] += 1;
+    fast_line_breakdown[last_bin + 1] -= 1;
+  };
+
+  // note : the outer clusters within the phi window of each inner cluster, the window can wrap around 0 / 360 degree
+  auto scan_outer = [&](const fast_clu_info& inner, double phi_min, double phi_max)
+  {
+    auto outer = std::lower_bound(fast_outer_clu.begin(), fast_outer_clu.end(), phi_min, [](const fast_clu_info& clu, double phi)
+                                  { return clu.phi < phi; });
+    for (; outer != fast_outer_clu.end() && outer->phi <= phi_max; ++outer)
+    {
+      pair_clusters(inner, *outer);
+    }
+  };
+
+  for (const auto& inner : fast_inner_clu)
+  {
+    if (phi_diff_cut >= 180)
+    {
+      scan_outer(inner, 0, 360);
+      continue;
+    }
+
+    scan_outer(inner, std::max(0., inner.phi - phi_diff_cut), std::min(360., inner.phi + phi_diff_cut));
+    if (inner.phi - phi_diff_cut < 0)
+    {
+      scan_outer(inner, inner.phi - phi_diff_cut + 360, 360);
+    }
+    else if (inner.phi + phi_diff_cut > 360)
+    {
+      scan_outer(inner, 0, inner.phi + phi_diff_cut - 360);
+    }
+  }
+
+  for (int i = 1; i < nbins + 2; i++)
+  {
+    fast_line_breakdown[i] += fast_line_breakdown[i - 1];
+  }
+
+  m_zvtxinfo.ntracklets = ntracklets;
+  if (ntracklets <= zvtx_cal_require)
+  {
+    return;
+  }
+
+  // note : first highest bin, as TH1::GetMaximumBin
+  std::vector<double> content(fast_line_breakdown.begin() + 1, fast_line_breakdown.begin() + nbins + 1);
+  const int peak_bin = std::distance(content.begin(), std::max_element(content.begin(), content.end()));
+  const double peak_content = content[peak_bin];
+  const double peak_center = xmin + (peak_bin + 0.5) * bin_width;
+
+  // note : weighted mean and rms around the peak, with the same background suppression (half of the peak) as find_Ngroup
+  double sum_weight = 0;
+  double sum_z = 0;
+  double sum_z2 = 0;
+  for (int i = 0; i < nbins; i++)
+  {
+    const double center = xmin + (i + 0.5) * bin_width;
+    if (fabs(center - peak_center) > fast_peak_window || content[i] <= peak_content / 2.)
+    {
+      continue;
+    }
+    const double weight = content[i] - peak_content / 2.;
+    sum_weight += weight;
+    sum_z += weight * center;
+    sum_z2 += weight * center * center;
+  }
+  const double mean = sum_z / sum_weight;
+  const double width = sqrt(std::max(0., sum_z2 / sum_weight - mean * mean));
+
+  N_group_info = find_Ngroup(fast_possible_z, evt_possible_z_range.first, evt_possible_z_range.second);
+  N_group_info_detail = find_Ngroup(content, xmin, xmax);
+
+  // note : same group requirements as the fit method, the width of the gaussian fit is not available
+  good_zvtx_tag = N_group_info[0] < 4 &&
+                  N_group_info[1] >= 0.6 &&
+                  N_group_info_detail[0] < 7 &&
+                  N_group_info_detail[1] > 0.9 &&
+                  100 < fabs(N_group_info_detail[3] - N_group_info_detail[2]) &&
+                  fabs(N_group_info_detail[3] - N_group_info_detail[2]) < 190;
+  good_zvtx_tag_int = (good_zvtx_tag == true) ? 1 : 0;
+
+  // note : the tracklets crossing the peak bin give the statistics of the estimate
+  loose_offset_peak = mean;
+  loose_offset_peakE = width / sqrt(peak_content);
+  final_zvtx = loose_offset_peak;
+
+  m_zvtxinfo.zvtx = loose_offset_peak;
+  m_zvtxinfo.zvtx_err = loose_offset_peakE;
+  m_zvtxinfo.width = width;
+  m_zvtxinfo.good = good_zvtx_tag;
+  m_zvtxinfo.ngroup = N_group_info_detail[0];
+  m_zvtxinfo.peakratio = N_group_info_detail[1];
+  m_zvtxinfo.peakwidth = fabs(N_group_info_detail[3] - N_group_info_detail[2]) / 2.;
+
+  if (print_message_opt)
+  {
+    std::cout << "INTTZvtx fast mode, zvtx : " << m_zvtxinfo.zvtx << " +- " << m_zvtxinfo.zvtx_err << ", width : " << m_zvtxinfo.width << ", ntracklets : " << ntracklets << std::endl;
+  }
+}
+
 void INTTZvtx::PrintPlots()
 {
   if (!m_initialized)
@@ -1732,11 +1924,16 @@ double INTTZvtx::Get_extrapolation(double given_y, double p0x, double p0y, doubl
 
 std::pair<double, double> INTTZvtx::Get_possible_zvtx(double rvtx, std::vector<double> p0, std::vector<double> p1)  // note : inner p0, outer p1, vector {r,z}, -> {y,x}
 {
-  std::vector<double> p0_z_edge = {(fabs(p0[1]) < 130) ? p0[1] - 8. : p0[1] - 10., (fabs(p0[1]) < 130) ? p0[1] + 8. : p0[1] + 10.};  // note : vector {left edge, right edge}
-  std::vector<double> p1_z_edge = {(fabs(p1[1]) < 130) ? p1[1] - 8. : p1[1] - 10., (fabs(p1[1]) < 130) ? p1[1] + 8. : p1[1] + 10.};  // note : vector {left edge, right edge}
+  return Get_possible_zvtx(rvtx, p0[0], p0[1], p1[0], p1[1]);
+}
+
+std::pair<double, double> INTTZvtx::Get_possible_zvtx(double rvtx, double p0_r, double p0_z, double p1_r, double p1_z)
+{
+  const double p0_z_edge[2] = {(fabs(p0_z) < 130) ? p0_z - 8. : p0_z - 10., (fabs(p0_z) < 130) ? p0_z + 8. : p0_z + 10.};  // note : {left edge, right edge}
+  const double p1_z_edge[2] = {(fabs(p1_z) < 130) ? p1_z - 8. : p1_z - 10., (fabs(p1_z) < 130) ? p1_z + 8. : p1_z + 10.};  // note : {left edge, right edge}
 
-  double edge_first = Get_extrapolation(rvtx, p0_z_edge[0], p0[0], p1_z_edge[1], p1[0]);
-  double edge_second = Get_extrapolation(rvtx, p0_z_edge[1], p0[0], p1_z_edge[0], p1[0]);
+  double edge_first = Get_extrapolation(rvtx, p0_z_edge[0], p0_r, p1_z_edge[1], p1_r);
+  double edge_second = Get_extrapolation(rvtx, p0_z_edge[1], p0_r, p1_z_edge[0], p1_r);
 
   double mid_point = (edge_first + edge_second) / 2.;
   double possible_width = fabs(edge_first - edge_second) / 2.;
@@ -1824,8 +2021,22 @@ double INTTZvtx::LB_geo_mean(TH1* hist_in, std::pair<double, double> search_rang
 // note : {N_group, ratio (if two), peak widthL, peak widthR}
 std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
 {
-  double Highest_bin_Content = hist_in->GetBinContent(hist_in->GetMaximumBin());
-  double Highest_bin_Center = hist_in->GetBinCenter(hist_in->GetMaximumBin());
+  std::vector<double> content(hist_in->GetNbinsX());
+  for (int i = 0; i < hist_in->GetNbinsX(); i++)
+  {
+    content[i] = hist_in->GetBinContent(i + 1);
+  }
+  return find_Ngroup(content, hist_in->GetXaxis()->GetXmin(), hist_in->GetXaxis()->GetXmax());
+}
+
+// note : same as above on the bin contents of a histogram with fixed bins, without under and overflow
+std::vector<double> INTTZvtx::find_Ngroup(const std::vector<double>& content, double xmin, double xmax)
+{
+  const int nbins = content.size();
+  const double bin_width = (xmax - xmin) / nbins;
+  const int highest_bin = std::distance(content.begin(), std::max_element(content.begin(), content.end()));
+  double Highest_bin_Content = content[highest_bin];
+  double Highest_bin_Center = xmin + (highest_bin + 0.5) * bin_width;
 
   int group_Nbin = 0;
   int peak_group_ID = 0;  // =0 added by TH 20240418
@@ -1840,16 +2051,16 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
   std::vector<double> group_widthR_vec;
   group_widthR_vec.clear();
 
-  for (int i = 0; i < hist_in->GetNbinsX(); i++)
+  for (int i = 0; i < nbins; i++)
   {
     // todo : the background rejection is here : Highest_bin_Content/2. for the time being
-    double bin_content = (hist_in->GetBinContent(i + 1) <= Highest_bin_Content / 2.) ? 0. : (hist_in->GetBinContent(i + 1) - Highest_bin_Content / 2.);
+    double bin_content = (content[i] <= Highest_bin_Content / 2.) ? 0. : (content[i] - Highest_bin_Content / 2.);
 
     if (bin_content != 0)
     {
       if (group_Nbin == 0)
       {
-        group_widthL_vec.push_back(hist_in->GetBinCenter(i + 1) - (hist_in->GetBinWidth(i + 1) / 2.));
+        group_widthL_vec.push_back(xmin + (i + 0.5) * bin_width - (bin_width / 2.));
       }
 
       group_Nbin += 1;
@@ -1857,7 +2068,7 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
     }
     else if (bin_content == 0 && group_Nbin != 0)
     {
-      group_widthR_vec.push_back(hist_in->GetBinCenter(i + 1) - (hist_in->GetBinWidth(i + 1) / 2.));
+      group_widthR_vec.push_back(xmin + (i + 0.5) * bin_width - (bin_width / 2.));
       group_Nbin_vec.push_back(group_Nbin);
       group_entry_vec.push_back(group_entry);
       group_Nbin = 0;
@@ -1868,7 +2079,7 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
   {
     group_Nbin_vec.push_back(group_Nbin);
     group_entry_vec.push_back(group_entry);
-    group_widthR_vec.push_back(hist_in->GetXaxis()->GetXmax());
+    group_widthR_vec.push_back(xmax);
   }  // note : the last group at the edge
 
   // note : find the peak group
@@ -1903,9 +2114,17 @@ std::vector<double> INTTZvtx::find_Ngroup(TH1* hist_in)
 
 double INTTZvtx::get_delta_phi(double angle_1, double angle_2)
 {
-  std::vector<double> vec_abs = {fabs(angle_1 - angle_2), fabs(angle_1 - angle_2 + 360), fabs(angle_1 - angle_2 - 360)};
-  std::vector<double> vec = {(angle_1 - angle_2), (angle_1 - angle_2 + 360), (angle_1 - angle_2 - 360)};
-  return vec[std::distance(vec_abs.begin(), std::min_element(vec_abs.begin(), vec_abs.end()))];
+  // note : the one of (angle_1 - angle_2), (angle_1 - angle_2 + 360), (angle_1 - angle_2 - 360) closest to zero, the first one for ties
+  double delta = angle_1 - angle_2;
+  if (fabs(angle_1 - angle_2 + 360) < fabs(delta))
+  {
+    delta = angle_1 - angle_2 + 360;
+  }
+  if (fabs(angle_1 - angle_2 - 360) < fabs(delta))
+  {
+    delta = angle_1 - angle_2 - 360;
+  }
+  return delta;
 }
 
 double INTTZvtx::get_track_phi(double inner_clu_phi_in, double delta_phi_in)
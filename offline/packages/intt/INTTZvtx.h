@@ -104,6 +104,10 @@ class INTTZvtx
   void EnableEventDisplay(const bool enableEvtDisp) { draw_event_display = enableEvtDisp; }
   void EnableQA(const bool enableQA) { m_enable_qa = enableQA; }
 
+  // note : production mode, no ROOT objects are created. Tracklets are formed within the phi window on phi sorted clusters,
+  // note : the z vertex is the weighted mean around the peak of an integer line breakdown histogram, without fit
+  void EnableFastMode(const bool enableFast) { m_fast_mode = enableFast; }
+
   double GetZdiffPeakMC();
   double GetZdiffWidthMC();
 
@@ -128,6 +132,7 @@ class INTTZvtx
   std::pair<double, double> zvtx_QA_width;  // note : for the zvtx range Quality check, check the width
   bool draw_event_display{false};
   bool m_enable_qa{false};
+  bool m_fast_mode{false};
   bool print_message_opt;
 
   std::pair<double, double> evt_possible_z_range = {-700, 700};
@@ -139,6 +144,9 @@ class INTTZvtx
   double zvtx_hist_l = -500;              // histogram range for QA
   double zvtx_hist_r = 500;               // histogram range for QA
   int print_rate = 50;                    // if_print in processEvt, todo : the print rate is here
+  int line_breakdown_N = 1200;            // note : N bins for each side of the line breakdown histogram, regardless the bin at zero
+  double line_breakdown_width = 0.5;      // note : bin width of the line breakdown histogram with the unit [mm]
+  double fast_peak_window = 90;           // note : half range around the peak used by the fast mode estimator [mm], same as the fit range
 
   std::vector<std::vector<std::pair<bool, clu_info>>> inner_clu_phi_map{};  // note: phi
   std::vector<std::vector<std::pair<bool, clu_info>>> outer_clu_phi_map{};  // note: phi
@@ -256,9 +264,28 @@ class INTTZvtx
   std::vector<float> z_mid{};        // tracklet
   std::vector<float> z_range{};      // tracklet
 
+  // note : for the fast mode
+  struct fast_clu_info
+  {
+    double phi;  // note : unit degree, w.r.t. the beam origin
+    double x;
+    double y;
+    double r;  // note : w.r.t. the beam origin
+    double z;
+  };
+  std::vector<fast_clu_info> fast_inner_clu{};  // note : sorted in phi
+  std::vector<fast_clu_info> fast_outer_clu{};  // note : sorted in phi
+  std::vector<int> fast_line_breakdown{};       // note : same binning as line_breakdown_hist, including under and overflow
+  std::vector<double> fast_possible_z{};        // note : same binning as evt_possible_z, without under and overflow
+
+  void ProcessEvtFast(const std::vector<clu_info>& inner_clu, const std::vector<clu_info>& outer_clu);
+  void Fill_fast_clu(const std::vector<clu_info>& clu_in, std::vector<fast_clu_info>& clu_out);
+
   // function for analysis
   std::pair<double, double> Get_possible_zvtx(double rvtx, std::vector<double> p0, std::vector<double> p1);
+  std::pair<double, double> Get_possible_zvtx(double rvtx, double p0_r, double p0_z, double p1_r, double p1_z);
   std::vector<double> find_Ngroup(TH1* hist_in);
+  std::vector<double> find_Ngroup(const std::vector<double>& content, double xmin, double xmax);
   double get_radius(double x, double y);
   double calculateAngleBetweenVectors(double x1, double y1, double x2, double y2, double targetX, double targetY);
   double Get_extrapolation(double given_y, double p0x, double p0y, double p1x, double p1y);
@@ -2,9 +2,10 @@
 #include "CylinderGeomIntt.h"
 
 #include <trackbase/InttDefs.h>
+#include <trackbase/PixelClusterLabeler.h>
 #include <trackbase/TrkrClusterContainerv4.h>
 #include <trackbase/TrkrClusterCrossingAssocv1.h>
-#include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterHitAssocv4.h>
 #include <trackbase/TrkrClusterv5.h>
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
@@ -27,16 +28,13 @@
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
 #include <phool/getClass.h>
+#include <phool/PHThreadPool.h>
 #include <phool/phool.h>
 
-#include <boost/graph/adjacency_list.hpp>
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <iostream>
 #include <limits>
-#include <memory>  // for unique_ptr, make_...
 #include <set>
 #include <vector>  // for vector
 
@@ -51,52 +49,6 @@ namespace
   }
 }  // namespace
 
-bool InttClusterizer::ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit*>& lhs, const std::pair<TrkrDefs::hitkey, TrkrHit*>& rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) <= 1)
-    {
-      if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs(InttDefs::getCol(lhs.first) - InttDefs::getCol(rhs.first)) == 0)
-  {
-    if (std::abs(InttDefs::getRow(lhs.first) - InttDefs::getRow(rhs.first)) <= 1)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
-bool InttClusterizer::ladder_are_adjacent(RawHit* lhs, RawHit* rhs, const int layer)
-{
-  if (get_z_clustering(layer))
-  {
-    if (std::abs((int) (lhs->getPhiBin()) - (int) (rhs->getPhiBin())) <= 1)  // col
-    {
-      if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else if (std::abs((int) (lhs->getPhiBin()) - (int)(rhs->getPhiBin())) <= 1)
-  {
-    if (std::abs((int) (lhs->getTBin()) - (int) (rhs->getTBin())) == 0)
-    {
-      return true;
-    }
-  }
-
-  return false;
-}
-
 InttClusterizer::InttClusterizer(const std::string& name,
                                  unsigned int /*min_layer*/,
                                  unsigned int /*max_layer*/)
@@ -104,6 +56,8 @@ InttClusterizer::InttClusterizer(const std::string& name,
 {
 }
 
+InttClusterizer::~InttClusterizer() = default;
+
 int InttClusterizer::InitRun(PHCompositeNode* topNode)
 {
   /*
@@ -162,7 +116,7 @@ int InttClusterizer::InitRun(PHCompositeNode* topNode)
       dstNode->addNode(DetNode);
     }
 
-    clusterhitassoc = new TrkrClusterHitAssocv3;
+    clusterhitassoc = new TrkrClusterHitAssocv4;
     PHIODataNode<PHObject>* newNode = new PHIODataNode<PHObject>(clusterhitassoc, "TRKR_CLUSTERHITASSOC", "PHObject");
     DetNode->addNode(newNode);
   }
@@ -231,6 +185,15 @@ int InttClusterizer::InitRun(PHCompositeNode* topNode)
     }
   }
 
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "InttClusterizer::InitRun - clustering with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -357,249 +320,275 @@ void InttClusterizer::ClusterLadderCells(PHCompositeNode* topNode)
   // Clustering
   //-----------
 
-  // loop over the InttHitSet objects
+  // the InttHitSet objects (sensors) are clustered independently
+  std::vector<TrkrHitSet*> hitsets;
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::inttId);
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
        ++hitsetitr)
   {
-    // Each hitset contains only hits that are clusterizable - i.e. belong to a single sensor
-    TrkrHitSet* hitset = hitsetitr->second;
-
-    if (Verbosity() > 1)
-    {
-      std::cout << "InttClusterizer found hitsetkey " << hitsetitr->first << std::endl;
-    }
-    if (Verbosity() > 2)
-    {
-      hitset->identify();
-    }
-
-    // we have a single hitset, get the info that identifies the sensor
-    int layer = TrkrDefs::getLayer(hitsetitr->first);
-    int ladder_z_index = InttDefs::getLadderZId(hitsetitr->first);
-    int type = (ladder_z_index == 0 || ladder_z_index == 2) ? 0 : 1; // ladder ID 0 and 2 are type-A (1.6 cm), ladder ID 1 and 3 are type-B (2.0 cm)
+    hitsets.push_back(hitsetitr->second);
+  }
 
-    // we will need the geometry object for this layer to get the global position
-    CylinderGeomIntt* geom = dynamic_cast<CylinderGeomIntt*>(geom_container->GetLayerGeom(layer));
-    float pitch = geom->get_strip_y_spacing();
-    float length = geom->get_strip_z_spacing(type);
+  std::vector<std::vector<LadderCluster>> ladder_clusters(hitsets.size());
 
-    // fill a vector of hits to make things easier - gets every hit in the hitset
-    std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*>> hitvec;
-    TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-    for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-         hitr != hitrangei.second;
-         ++hitr)
-    {
-      hitvec.emplace_back(hitr->first, hitr->second);
-    }
-    if (Verbosity() > 2)
+  // the verbose printout is only readable when running serially
+  if (!m_threadpool || Verbosity() > 2)
+  {
+    PixelClusterLabeler labeler;
+    for (unsigned int i = 0; i < hitsets.size(); ++i)
     {
-      std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
+      ClusterLadder(hitsets[i], geom_container, labeler, ladder_clusters[i]);
     }
+  }
+  else
+  {
+    // one labeler per task, the labeling buffers are small
+    m_threadpool->parallel_for(hitsets.size(), [this, &hitsets, geom_container, &ladder_clusters](size_t i)
+                               {
+                                 PixelClusterLabeler labeler;
+                                 ClusterLadder(hitsets[i], geom_container, labeler, ladder_clusters[i]); });
+  }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+  // store the clusters and associations in hitset order
+  for (const auto& clusters : ladder_clusters)
+  {
+    for (const auto& ladder_cluster : clusters)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
+      const TrkrDefs::cluskey ckey = ladder_cluster.ckey;
+      for (const auto hitkey : ladder_cluster.hitkeys)
       {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
-    }
+        // Add clusterkey/bunch crossing to mmap
+        m_clustercrossingassoc->addAssoc(ckey, ladder_cluster.crossing);
 
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
+        // add this cluster-hit association to the association map of (clusterkey,hitkey)
+        m_clusterhitassoc->addAssoc(ckey, hitkey);
+      }
 
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+      auto clus = m_clusterlist->newClusterv5();
+      clus->setAdc(ladder_cluster.adc);
+      clus->setMaxAdc(ladder_cluster.maxadc);
+      clus->setLocalX(ladder_cluster.localy);
+      clus->setLocalY(ladder_cluster.localz);
+      clus->setPhiError(ladder_cluster.phierror);
+      clus->setZError(ladder_cluster.zerror);
+      clus->setPhiSize(ladder_cluster.phisize);
+      clus->setZSize(ladder_cluster.zsize);
+      // All silicon surfaces have a 1-1 map to hitsetkey.
+      // So set subsurface key to 0
+      clus->setSubSurfKey(0);
 
-    // Loop over the components(hit cells) compiling a list of the
-    // unique connected groups (ie. clusters).
-    std::set<int> cluster_ids;  // unique components
+      if (Verbosity() > 2)
+      {
+        clus->identify();
+      }
 
-    std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>> clusters;
-    for (unsigned int i = 0; i < component.size(); i++)
-    {
-      cluster_ids.insert(component[i]);                          // one entry per unique cluster id
-      clusters.insert(std::make_pair(component[i], hitvec[i]));  // multiple entries per unique cluster id
+      m_clusterlist->addClusterSpecifyKey(ckey, clus);
     }
+  }
 
-    // loop over the cluster ID's and make the clusters from the connected hits
-    for (int clusid : cluster_ids)
-    {
-      // std::cout << " intt clustering: add cluster number " << clusid << std::endl;
-      // get all hits for this cluster ID only
-      std::pair<std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator,
-                std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator>
-          clusrange = clusters.equal_range(clusid);
-
-      // make the cluster directly in the node tree
-      TrkrDefs::cluskey ckey = TrkrDefs::genClusKey(hitset->getHitSetKey(), clusid);
+  if (Verbosity() > 2)
+  {
+    // check that the associations were written correctly
+    std::cout << "After InttClusterizer, cluster-hit associations are:" << std::endl;
+    m_clusterhitassoc->identify();
+  }
 
-      if (Verbosity() > 2)
-      {
-        std::cout << "Filling cluster with key " << ckey << std::endl;
-      }
+  if (Verbosity() > 0)
+  {
+    std::cout << " Cluster-crossing associations are:" << std::endl;
+    m_clustercrossingassoc->identify();
+  }
 
-      // get the bunch crossing number from the hitsetkey
-      short int crossing = InttDefs::getTimeBucketId(hitset->getHitSetKey());
+  return;
+}
 
-      // determine the size of the cluster in phi and z, useful for track fitting the cluster
-      std::set<int> phibins;
-      std::set<int> zbins;
+void InttClusterizer::ClusterLadder(TrkrHitSet* hitset, PHG4CylinderGeomContainer* geom_container, PixelClusterLabeler& labeler, std::vector<LadderCluster>& ladder_clusters) const
+{
+  // Each hitset contains only hits that are clusterizable - i.e. belong to a single sensor
+  const TrkrDefs::hitsetkey hitsetkey = hitset->getHitSetKey();
 
-      // determine the cluster position...
-      double xlocalsum = 0.0;
-      double ylocalsum = 0.0;
-      double zlocalsum = 0.0;
-      unsigned int clus_adc = 0.0;
-      unsigned int clus_maxadc = 0.0;
-      unsigned nhits = 0;
-      // std::cout << PHWHERE << " ckey " << ckey << ":" << std::endl;
-      for (std::multimap<int, std::pair<TrkrDefs::hitkey, TrkrHit*>>::iterator mapiter = clusrange.first; mapiter != clusrange.second; ++mapiter)
-      {
-        // mapiter->second.first  is the hit key
-        // std::cout << " adding hitkey " << mapiter->second.first << std::endl;
-        int col = InttDefs::getCol((mapiter->second).first);
-        int row = InttDefs::getRow((mapiter->second).first);
-        zbins.insert(col);
-        phibins.insert(row);
+  if (Verbosity() > 1)
+  {
+    std::cout << "InttClusterizer found hitsetkey " << hitsetkey << std::endl;
+  }
+  if (Verbosity() > 2)
+  {
+    hitset->identify();
+  }
 
-        // mapiter->second.second is the hit
-        unsigned int hit_adc = (mapiter->second).second->getAdc();
+  // we have a single hitset, get the info that identifies the sensor
+  int layer = TrkrDefs::getLayer(hitsetkey);
+  int ladder_z_index = InttDefs::getLadderZId(hitsetkey);
+  int type = (ladder_z_index == 0 || ladder_z_index == 2) ? 0 : 1; // ladder ID 0 and 2 are type-A (1.6 cm), ladder ID 1 and 3 are type-B (2.0 cm)
+  const bool make_e_weights = get_energy_weighting(layer);
+
+  // we will need the geometry object for this layer to get the global position
+  CylinderGeomIntt* geom = dynamic_cast<CylinderGeomIntt*>(geom_container->GetLayerGeom(layer));
+  float pitch = geom->get_strip_y_spacing();
+  float length = geom->get_strip_z_spacing(type);
+
+  // fill a vector of hits to make things easier - gets every hit in the hitset
+  std::vector<std::pair<TrkrDefs::hitkey, TrkrHit*>> hitvec;
+  TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+  for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+       hitr != hitrangei.second;
+       ++hitr)
+  {
+    hitvec.emplace_back(hitr->first, hitr->second);
+  }
+  if (Verbosity() > 2)
+  {
+    std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
+  }
 
-        // Add clusterkey/bunch crossing to mmap
-        m_clustercrossingassoc->addAssoc(ckey, crossing);
+  // Find groups of adjacent strips: same column (z) and neighbouring rows, or
+  // neighbouring columns with z clustering
+  std::vector<PixelClusterLabeler::Pixel> pixels;
+  pixels.reserve(hitvec.size());
+  for (const auto& hit : hitvec)
+  {
+    pixels.emplace_back(InttDefs::getCol(hit.first), InttDefs::getRow(hit.first));
+  }
+  std::vector<int> component;
+  const int nclusters = labeler.label(pixels, get_z_clustering(layer), component);
 
-        // now get the positions from the geometry
-        double local_hit_location[3] = {0., 0., 0.};
-        geom->find_strip_center_localcoords(ladder_z_index,
-                                            row, col,
-                                            local_hit_location);
+  // hits of each cluster, in hit order
+  std::vector<std::vector<unsigned int>> cluster_hits(nclusters);
+  for (unsigned int i = 0; i < component.size(); i++)
+  {
+    cluster_hits[component[i]].push_back(i);
+  }
 
-        if (_make_e_weights[layer])
-        {
-          xlocalsum += local_hit_location[0] * (double) hit_adc;
-          ylocalsum += local_hit_location[1] * (double) hit_adc;
-          zlocalsum += local_hit_location[2] * (double) hit_adc;
-        }
-        else
-        {
-          xlocalsum += local_hit_location[0];
-          ylocalsum += local_hit_location[1];
-          zlocalsum += local_hit_location[2];
-        }
-        if (hit_adc > clus_maxadc)
-        {
-          clus_maxadc = hit_adc;
-        }
-        clus_adc += hit_adc;
-        ++nhits;
+  // get the bunch crossing number from the hitsetkey
+  short int crossing = InttDefs::getTimeBucketId(hitsetkey);
 
-        // add this cluster-hit association to the association map of (clusterkey,hitkey)
-        m_clusterhitassoc->addAssoc(ckey, mapiter->second.first);
+  // loop over the cluster ID's and make the clusters from the connected hits
+  ladder_clusters.reserve(nclusters);
+  for (int clusid = 0; clusid < nclusters; ++clusid)
+  {
+    LadderCluster ladder_cluster;
+    ladder_cluster.ckey = TrkrDefs::genClusKey(hitsetkey, clusid);
+    ladder_cluster.crossing = crossing;
 
-        if (Verbosity() > 2)
-        {
-          std::cout << "     nhits = " << nhits << std::endl;
-        }
-        if (Verbosity() > 2)
-        {
-          std::cout << "  From  geometry object: hit x " << local_hit_location[0] << " hit y " << local_hit_location[1] << " hit z " << local_hit_location[2] << std::endl;
-          std::cout << "     nhits " << nhits << " clusx  = " << xlocalsum / nhits << " clusy " << ylocalsum / nhits << " clusz " << zlocalsum / nhits << " hit_adc " << hit_adc << std::endl;
-        }
-      }
+    if (Verbosity() > 2)
+    {
+      std::cout << "Filling cluster with key " << ladder_cluster.ckey << std::endl;
+    }
 
-      static const float invsqrt12 = 1. / sqrt(12);
+    // determine the size of the cluster in phi and z, useful for track fitting the cluster
+    std::set<int> phibins;
+    std::set<int> zbins;
+
+    // determine the cluster position...
+    double xlocalsum = 0.0;
+    double ylocalsum = 0.0;
+    double zlocalsum = 0.0;
+    unsigned int clus_adc = 0.0;
+    unsigned int clus_maxadc = 0.0;
+    unsigned nhits = 0;
+    for (const unsigned int ihit : cluster_hits[clusid])
+    {
+      const auto& hit = hitvec[ihit];
+      int col = InttDefs::getCol(hit.first);
+      int row = InttDefs::getRow(hit.first);
+      zbins.insert(col);
+      phibins.insert(row);
 
-      // scale factors (phi direction)
-      /*
-        they corresponds to clusters of size 1 and 2 in phi
-        other clusters, which are very few and pathological, get a scale factor of 1
-        These scale factors are applied to produce cluster pulls with width unity
-      */
+      unsigned int hit_adc = hit.second->getAdc();
 
-      float phierror = pitch * invsqrt12;
+      // now get the positions from the geometry
+      double local_hit_location[3] = {0., 0., 0.};
+      geom->find_strip_center_localcoords(ladder_z_index,
+                                          row, col,
+                                          local_hit_location);
 
-      static constexpr std::array<double, 3> scalefactors_phi = {{0.85, 0.4, 0.33}};
-      if (phibins.size() == 1 && layer < 5)
+      if (make_e_weights)
       {
-        phierror *= scalefactors_phi[0];
+        xlocalsum += local_hit_location[0] * (double) hit_adc;
+        ylocalsum += local_hit_location[1] * (double) hit_adc;
+        zlocalsum += local_hit_location[2] * (double) hit_adc;
       }
-      else if (phibins.size() == 2 && layer < 5)
+      else
       {
-        phierror *= scalefactors_phi[1];
+        xlocalsum += local_hit_location[0];
+        ylocalsum += local_hit_location[1];
+        zlocalsum += local_hit_location[2];
       }
-      else if (phibins.size() == 2 && layer > 4)
+      if (hit_adc > clus_maxadc)
       {
-        phierror *= scalefactors_phi[2];
+        clus_maxadc = hit_adc;
       }
-      // z error.
-      const float zerror = zbins.size() * length * invsqrt12;
+      clus_adc += hit_adc;
+      ++nhits;
 
-      double cluslocaly = std::numeric_limits<double>::quiet_NaN();
-      double cluslocalz = std::numeric_limits<double>::quiet_NaN();
+      ladder_cluster.hitkeys.push_back(hit.first);
 
-      if (_make_e_weights[layer])
+      if (Verbosity() > 2)
       {
-        cluslocaly = ylocalsum / (double) clus_adc;
-        cluslocalz = zlocalsum / (double) clus_adc;
+        std::cout << "     nhits = " << nhits << std::endl;
       }
-      else
+      if (Verbosity() > 2)
       {
-        cluslocaly = ylocalsum / nhits;
-        cluslocalz = zlocalsum / nhits;
+        std::cout << "  From  geometry object: hit x " << local_hit_location[0] << " hit y " << local_hit_location[1] << " hit z " << local_hit_location[2] << std::endl;
+        std::cout << "     nhits " << nhits << " clusx  = " << xlocalsum / nhits << " clusy " << ylocalsum / nhits << " clusz " << zlocalsum / nhits << " hit_adc " << hit_adc << std::endl;
       }
+    }
 
-      auto clus = std::make_unique<TrkrClusterv5>();
-      clus->setAdc(clus_adc);
-      clus->setMaxAdc(clus_maxadc);
-      clus->setLocalX(cluslocaly);
-      clus->setLocalY(cluslocalz);
-      clus->setPhiError(phierror);
-      clus->setZError(zerror);
-      clus->setPhiSize(phibins.size());
-      clus->setZSize(zbins.size());
-      // All silicon surfaces have a 1-1 map to hitsetkey.
-      // So set subsurface key to 0
-      clus->setSubSurfKey(0);
+    static const float invsqrt12 = 1. / sqrt(12);
 
-      if (Verbosity() > 2)
-      {
-        clus->identify();
-      }
+    // scale factors (phi direction)
+    /*
+      they corresponds to clusters of size 1 and 2 in phi
+      other clusters, which are very few and pathological, get a scale factor of 1
+      These scale factors are applied to produce cluster pulls with width unity
+    */
 
-      m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
+    float phierror = pitch * invsqrt12;
 
-    }  // end loop over cluster ID's
-  }    // end loop over hitsets
+    static constexpr std::array<double, 3> scalefactors_phi = {{0.85, 0.4, 0.33}};
+    if (phibins.size() == 1 && layer < 5)
+    {
+      phierror *= scalefactors_phi[0];
+    }
+    else if (phibins.size() == 2 && layer < 5)
+    {
+      phierror *= scalefactors_phi[1];
+    }
+    else if (phibins.size() == 2 && layer > 4)
+    {
+      phierror *= scalefactors_phi[2];
+    }
+    // z error.
+    const float zerror = zbins.size() * length * invsqrt12;
 
-  if (Verbosity() > 2)
-  {
-    // check that the associations were written correctly
-    std::cout << "After InttClusterizer, cluster-hit associations are:" << std::endl;
-    m_clusterhitassoc->identify();
-  }
+    double cluslocaly = std::numeric_limits<double>::quiet_NaN();
+    double cluslocalz = std::numeric_limits<double>::quiet_NaN();
 
-  if (Verbosity() > 0)
-  {
-    std::cout << " Cluster-crossing associations are:" << std::endl;
-    m_clustercrossingassoc->identify();
-  }
+    if (make_e_weights)
+    {
+      cluslocaly = ylocalsum / (double) clus_adc;
+      cluslocalz = zlocalsum / (double) clus_adc;
+    }
+    else
+    {
+      cluslocaly = ylocalsum / nhits;
+      cluslocalz = zlocalsum / nhits;
+    }
 
-  return;
+    ladder_cluster.adc = clus_adc;
+    ladder_cluster.maxadc = clus_maxadc;
+    ladder_cluster.localy = cluslocaly;
+    ladder_cluster.localz = cluslocalz;
+    ladder_cluster.phierror = phierror;
+    ladder_cluster.zerror = zerror;
+    ladder_cluster.phisize = phibins.size();
+    ladder_cluster.zsize = zbins.size();
+    ladder_clusters.push_back(std::move(ladder_cluster));
+  }  // end loop over cluster ID's
 }
+
 void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
 {
   if (Verbosity() > 0)
@@ -622,6 +611,11 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
   // Clustering
   //-----------
 
+  // clustering buffers, reused for all hitsets
+  PixelClusterLabeler labeler;
+  std::vector<PixelClusterLabeler::Pixel> pixels;
+  std::vector<int> component;
+
   // loop over the InttHitSet objects
   RawHitSetContainer::ConstRange hitsetrange =
       m_rawhits->getHitSets(TrkrDefs::TrkrId::inttId);
@@ -671,29 +665,14 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
       std::cout << "hitvec.size(): " << hitvec.size() << std::endl;
     }
 
-    using Graph = boost::adjacency_list<boost::vecS, boost::vecS, boost::undirectedS>;
-    Graph G;
-
-    // Find adjacent strips
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    // Find groups of adjacent strips: same row and neighbouring
+    // columns, or neighbouring rows with z clustering
+    pixels.clear();
+    for (auto* hit : hitvec)
     {
-      for (unsigned int j = i + 1; j < hitvec.size(); j++)
-      {
-        if (ladder_are_adjacent(hitvec[i], hitvec[j], layer))
-        {
-          add_edge(i, j, G);
-        }
-      }
-
-      add_edge(i, i, G);
+      pixels.emplace_back(hit->getTBin(), hit->getPhiBin());  // row, col
     }
-
-    // Find the connections between the vertices of the graph (vertices are the rawhits,
-    // connections are made when they are adjacent to one another)
-    std::vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    labeler.label(pixels, get_z_clustering(layer), component);
 
     // Loop over the components(hit cells) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -867,7 +846,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
         cluslocalz = zlocalsum / nhits;
       }
 
-      auto clus = std::make_unique<TrkrClusterv5>();
+      auto clus = m_clusterlist->newClusterv5();
       clus->setAdc(clus_adc);
       clus->setLocalX(cluslocaly);
       clus->setLocalY(cluslocalz);
@@ -884,7 +863,7 @@ void InttClusterizer::ClusterLadderCellsRaw(PHCompositeNode* topNode)
         clus->identify();
       }
 
-      m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
+      m_clusterlist->addClusterSpecifyKey(ckey, clus);
 
     }  // end loop over cluster ID's
   }    // end loop over hitsets
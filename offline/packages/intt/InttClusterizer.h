@@ -7,17 +7,21 @@
 
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
+class PHG4CylinderGeomContainer;
+class PHThreadPool;
+class PixelClusterLabeler;
+class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrClusterContainer;
 class TrkrClusterHitAssoc;
 class TrkrClusterCrossingAssoc;
-class TrkrHit;
-class RawHit;
 class RawHitSetContainer;
 
 class InttClusterizer : public SubsysReco
@@ -25,7 +29,7 @@ class InttClusterizer : public SubsysReco
  public:
   InttClusterizer(const std::string &name = "InttClusterizer",
                   unsigned int min_layer = 0, unsigned int max_layer =  std::numeric_limits<unsigned int>::max());
-  ~InttClusterizer() override {}
+  ~InttClusterizer() override;
 
   //! run initialization
   int InitRun(PHCompositeNode *topNode) override;
@@ -72,17 +76,36 @@ class InttClusterizer : public SubsysReco
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
 
+  //! cluster the sensors on nthreads threads, 0 uses all cores, 1 (default) runs serially
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   // for saving verbose clusters
   void set_ClusHitsVerbose(bool set = true) { record_ClusHitsVerbose = set; };
   ClusHitsVerbosev1 *mClusHitsVerbose{nullptr};
 
  private:
+  //! cluster of one sensor, stored in the node tree after all sensors are done
+  struct LadderCluster
+  {
+    TrkrDefs::cluskey ckey = 0;
+    short int crossing = 0;
+    unsigned int adc = 0;
+    unsigned int maxadc = 0;
+    float localy = 0;
+    float localz = 0;
+    float phierror = 0;
+    float zerror = 0;
+    unsigned int phisize = 0;
+    unsigned int zsize = 0;
+    std::vector<TrkrDefs::hitkey> hitkeys;
+  };
+
   bool record_ClusHitsVerbose{false};
-  bool ladder_are_adjacent(const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs, const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs, const int layer);
-  bool ladder_are_adjacent(RawHit *lhs, RawHit *rhs, const int layer);
 
   void CalculateLadderThresholds(PHCompositeNode *topNode);
   void ClusterLadderCells(PHCompositeNode *topNode);
+  //! clusters of one sensor, only reads shared data so sensors can be done concurrently
+  void ClusterLadder(TrkrHitSet *hitset, PHG4CylinderGeomContainer *geom_container, PixelClusterLabeler &labeler, std::vector<LadderCluster> &ladder_clusters) const;
   void ClusterLadderCellsRaw(PHCompositeNode *topNode);
   void PrintClusters(PHCompositeNode *topNode);
 
@@ -100,6 +123,9 @@ class InttClusterizer : public SubsysReco
   std::map<int, bool> _make_e_weights;        // layer->energy_weighting_option
   bool do_hit_assoc = true;
   bool do_read_raw = false;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
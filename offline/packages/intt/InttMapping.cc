@@ -6,6 +6,7 @@
 
 #include <Event/packet.h>
 
+#include <array>
 #include <utility>  // for pair
 
 const std::map<int, int> InttNameSpace::Packet_Id =
@@ -20,6 +21,47 @@ const std::map<int, int> InttNameSpace::Packet_Id =
         {3008, 7},
 };
 
+namespace
+{
+  const int NFELIXSERVERS = 8;
+  const int NFELIXCHANNELS = 14;
+
+  //! InttFelix::RawDataToOnline() as a table, built once instead of a nested switch per hit
+  struct FelixLadder
+  {
+    int lyr{0};
+    int ldr{0};
+    int arm{0};
+    int ret{1};
+  };
+  using FelixTable = std::array<FelixLadder, NFELIXSERVERS * NFELIXCHANNELS>;
+
+  const FelixTable &felix_table()
+  {
+    static const FelixTable table = []
+    {
+      FelixTable t{};
+      for (int server = 0; server < NFELIXSERVERS; ++server)
+      {
+        for (int channel = 0; channel < NFELIXCHANNELS; ++channel)
+        {
+          InttNameSpace::RawData_s raw;
+          raw.felix_server = server;
+          raw.felix_channel = channel;
+          InttNameSpace::Online_s onl;
+          FelixLadder &ladder = t[server * NFELIXCHANNELS + channel];
+          ladder.ret = InttFelix::RawDataToOnline(raw, onl);
+          ladder.lyr = onl.lyr;
+          ladder.ldr = onl.ldr;
+          ladder.arm = onl.arm;
+        }
+      }
+      return t;
+    }();
+    return table;
+  }
+}  // namespace
+
 int InttNameSpace::FelixFromPacket(int packetid)
 {
   packetid -= 3001;
@@ -46,8 +88,9 @@ struct InttNameSpace::RawData_s InttNameSpace::RawFromPacket(int const _i, int c
   }
 
   // s.felix_server = _i;
-  std::map<int, int>::const_iterator itr = Packet_Id.find(_i);
-  s.felix_server = itr != Packet_Id.end() ? itr->second : -1;
+  // same as Packet_Id, without the map lookup for every hit
+  const int felix_server = FelixFromPacket(_i);
+  s.felix_server = felix_server < NFELIXSERVERS ? felix_server : -1;
   s.felix_channel = _p->iValue(_n, "FEE");
   s.chip = (_p->iValue(_n, "CHIP_ID") + 25) % 26;
   s.channel = _p->iValue(_n, "CHANNEL_ID");
@@ -152,7 +195,16 @@ struct InttNameSpace::Online_s InttNameSpace::ToOnline(struct RawData_s const& _
 {
   struct Online_s s;
 
-  InttFelix::RawDataToOnline(_s, s);
+  if (_s.felix_server >= 0 && _s.felix_server < NFELIXSERVERS && _s.felix_channel >= 0 && _s.felix_channel < NFELIXCHANNELS)
+  {
+    const FelixLadder &ladder = felix_table()[_s.felix_server * NFELIXCHANNELS + _s.felix_channel];
+    if (ladder.ret == 0)
+    {
+      s.lyr = ladder.lyr;
+      s.ldr = ladder.ldr;
+      s.arm = ladder.arm;
+    }
+  }
   s.chp = _s.chip;
   s.chn = _s.channel;
 
@@ -379,3 +379,11 @@ void InttZVertexFinder::EnableEventDisplay(const bool enableEvtDisp)
     m_inttzvtx->EnableEventDisplay(enableEvtDisp);
   }
 }
+
+void InttZVertexFinder::EnableFastMode(const bool enableFast)
+{
+  if (m_inttzvtx != nullptr)
+  {
+    m_inttzvtx->EnableFastMode(enableFast);
+  }
+}
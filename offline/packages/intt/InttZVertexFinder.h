@@ -35,6 +35,8 @@ class InttZVertexFinder : public SubsysReco
 
   void EnableQA(const bool enableQA);
   void EnableEventDisplay(const bool enableEvtDisp);
+  //! no QA objects, z vertex from the line breakdown peak without fit, see INTTZvtx::EnableFastMode
+  void EnableFastMode(const bool enableFast);
 
  private:
   int createNodes(PHCompositeNode *topNode);
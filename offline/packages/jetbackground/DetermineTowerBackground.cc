@@ -384,19 +384,28 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
     _UE[1].resize(_HCAL_NETA, 0);
     _UE[2].resize(_HCAL_NETA, 0);
 
-    _EMCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-    _IHCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
-    _OHCAL_E.resize(_HCAL_NETA, std::vector<float>(_HCAL_NPHI, 0));
+    _TOWER_E.resize(3, std::vector<float>(_HCAL_NETA * _HCAL_NPHI, 0));
+    _TOWER_ISBAD.resize(3, std::vector<char>(_HCAL_NETA * _HCAL_NPHI, 0));
+    _TOWER_EXCLUDED.resize(_HCAL_NETA * _HCAL_NPHI, 0);
 
-    _EMCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-    _IHCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
-    _OHCAL_ISBAD.resize(_HCAL_NETA, std::vector<int>(_HCAL_NPHI, 0));
+    // tower centers do not change, look them up only once
+    _ETA_CENTER.resize(_HCAL_NETA, 0);
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      _ETA_CENTER[eta] = geomIH->get_etacenter(eta);
+    }
+    _PHI_CENTER.resize(_HCAL_NPHI, 0);
+    for (int phi = 0; phi < _HCAL_NPHI; phi++)
+    {
+      _PHI_CENTER[phi] = geomIH->get_phicenter(phi);
+    }
+    _FLOW_WEIGHT.resize(_HCAL_NPHI, 1);
 
     // for flow determination, build up a 1-D phi distribution of
     // energies from all layers summed together, populated only from eta
     // strips which do not have any excluded phi towers
     _FULLCALOFLOW_PHI_E.resize(_HCAL_NPHI, 0);
-    _FULLCALOFLOW_PHI_VAL.resize(_HCAL_NPHI, 0);
+    _FULLCALOFLOW_PHI_VAL = _PHI_CENTER;
 
     if (Verbosity() > 0)
     {
@@ -405,24 +414,16 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
   }
 
   // reset all maps map
-  for (int ieta = 0; ieta < _HCAL_NETA; ieta++)
+  for (int layer = 0; layer < 3; layer++)
   {
-    for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-    {
-      _EMCAL_E[ieta][iphi] = 0;
-      _IHCAL_E[ieta][iphi] = 0;
-      _OHCAL_E[ieta][iphi] = 0;
-      _EMCAL_ISBAD[ieta][iphi] = 0;
-      _IHCAL_ISBAD[ieta][iphi] = 0;
-      _OHCAL_ISBAD[ieta][iphi] = 0;
-    }
+    std::fill(_TOWER_E[layer].begin(), _TOWER_E[layer].end(), 0);
+    std::fill(_TOWER_ISBAD[layer].begin(), _TOWER_ISBAD[layer].end(), 0);
   }
+  std::fill(_FULLCALOFLOW_PHI_E.begin(), _FULLCALOFLOW_PHI_E.end(), 0);
 
-  for (int iphi = 0; iphi < _HCAL_NPHI; iphi++)
-  {
-    _FULLCALOFLOW_PHI_E[iphi] = 0;
-    _FULLCALOFLOW_PHI_VAL[iphi] = 0;
-  }
+  // mark towers close to a seed once, the mask is the same for all layers
+  // and for the flow and UE determination below
+  FillExclusionMask();
 
   if (m_use_towerinfo)
   {
@@ -441,8 +442,8 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       TowerInfo *tower = towerinfosEM3->get_tower_at_channel(channel);
       float this_E = tower->get_energy();
       int this_isBad = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2();
-      _EMCAL_E[this_etabin][this_phibin] += this_E;
-      _EMCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
+      _TOWER_E[0][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
+      _TOWER_ISBAD[0][this_etabin * _HCAL_NPHI + this_phibin] = this_isBad;
     }
 
     // iterate over IHCal towerinfos
@@ -455,8 +456,8 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       TowerInfo *tower = towerinfosIH3->get_tower_at_channel(channel);
       float this_E = tower->get_energy();
       int this_isBad = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2();
-      _IHCAL_E[this_etabin][this_phibin] += this_E;
-      _IHCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
+      _TOWER_E[1][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
+      _TOWER_ISBAD[1][this_etabin * _HCAL_NPHI + this_phibin] = this_isBad;
     }
 
     // iterate over OHCal towerinfos
@@ -469,8 +470,8 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       TowerInfo *tower = towerinfosOH3->get_tower_at_channel(channel);
       float this_E = tower->get_energy();
       int this_isBad = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2();
-      _OHCAL_E[this_etabin][this_phibin] += this_E;
-      _OHCAL_ISBAD[this_etabin][this_phibin] = this_isBad;
+      _TOWER_E[2][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
+      _TOWER_ISBAD[2][this_etabin * _HCAL_NPHI + this_phibin] = this_isBad;
     }
   }
   else
@@ -489,7 +490,7 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       int this_phibin = geomIH->get_phibin(this_phi);
       float this_E = tower->get_energy();
 
-      _EMCAL_E[this_etabin][this_phibin] += this_E;
+      _TOWER_E[0][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
 
       if (Verbosity() > 2 && tower->get_energy() > 1)
       {
@@ -510,7 +511,7 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       int this_phibin = geomIH->get_phibin(this_phi);
       float this_E = tower->get_energy();
 
-      _IHCAL_E[this_etabin][this_phibin] += this_E;
+      _TOWER_E[1][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
 
       if (Verbosity() > 2 && tower->get_energy() > 1)
       {
@@ -531,7 +532,7 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
       int this_phibin = geomOH->get_phibin(this_phi);
       float this_E = tower->get_energy();
 
-      _OHCAL_E[this_etabin][this_phibin] += this_E;
+      _TOWER_E[2][this_etabin * _HCAL_NPHI + this_phibin] += this_E;
 
       if (Verbosity() > 2 && tower->get_energy() > 1)
       {
@@ -561,57 +562,20 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
 
     for (int layer = 0; layer < 3; layer++)
     {
-      int local_max_eta = _HCAL_NETA;
-      int local_max_phi = _HCAL_NPHI;
+      const std::vector<float> &layer_E = _TOWER_E[layer];
+      const std::vector<char> &layer_isBad = _TOWER_ISBAD[layer];
 
-      for (int eta = 0; eta < local_max_eta; eta++)
+      for (int eta = 0; eta < _HCAL_NETA; eta++)
       {
-        bool isAnyTowerExcluded = false;
+        const int first = eta * _HCAL_NPHI;
 
-        for (int phi = 0; phi < local_max_phi; phi++)
+        // if even a single tower in this eta strip is masked or excluded,
+        // we can't use the strip for flow determination
+        bool isAnyTowerExcluded = false;
+        for (int phi = 0; phi < _HCAL_NPHI; phi++)
         {
-          float this_eta = geomIH->get_etacenter(eta);
-          float this_phi = geomIH->get_phicenter(phi);
-
-          bool isExcluded = false;
-
-          // if the tower is masked, exclude it
-          int this_isBad = (layer == 0 ? _EMCAL_ISBAD[eta][phi] : (layer == 1 ? _IHCAL_ISBAD[eta][phi] : _OHCAL_ISBAD[eta][phi]));
-          if (this_isBad)
-          {
-            isExcluded = true;
-          }
-          for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
-          {
-            float deta = this_eta - _seed_eta[iseed];
-            float dphi = this_phi - _seed_phi[iseed];
-            if (dphi > M_PI)
-            {
-              dphi -= 2 * M_PI;
-            }
-            if (dphi < -M_PI)
-            {
-              dphi += 2 * M_PI;
-            }
-            float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
-            if (dR < 0.4)
-            {
-              isExcluded = true;
-              if (Verbosity() > 10)
-              {
-                float my_E = (layer == 0 ? _EMCAL_E[eta][phi] : (layer == 1 ? _IHCAL_E[eta][phi] : _OHCAL_E[eta][phi]));
-                std::cout << " setting excluded mark for tower with E / eta / phi = " << my_E << " / " << this_eta << " / " << this_phi << " from seed at eta / phi = " << _seed_eta[iseed] << " / " << _seed_phi[iseed] << std::endl;
-              }
-            }
-          }
-
-          // if even a single tower in this eta strip is excluded, we
-          // can't use the strip for flow determination
-          if (isExcluded)
-          {
-            isAnyTowerExcluded = true;
-          }
-        }  // close phi loop
+          isAnyTowerExcluded |= (layer_isBad[first + phi] || _TOWER_EXCLUDED[first + phi]);
+        }
 
         // if this eta strip can be used for flow determination, fill it now
         if (!isAnyTowerExcluded)
@@ -622,24 +586,9 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
           }
           nStripsAvailableForFlow++;
 
-          for (int phi = 0; phi < local_max_phi; phi++)
+          for (int phi = 0; phi < _HCAL_NPHI; phi++)
           {
-            float this_phi = geomIH->get_phicenter(phi);
-
-            if (layer == 0)
-            {
-              _FULLCALOFLOW_PHI_E[phi] += _EMCAL_E[eta][phi];
-            }
-            if (layer == 1)
-            {
-              _FULLCALOFLOW_PHI_E[phi] += _IHCAL_E[eta][phi];
-            }
-            if (layer == 2)
-            {
-              _FULLCALOFLOW_PHI_E[phi] += _OHCAL_E[eta][phi];
-            }
-
-            _FULLCALOFLOW_PHI_VAL[phi] = this_phi;  // should really set this globally only one time
+            _FULLCALOFLOW_PHI_E[phi] += layer_E[first + phi];
           }
         }
         else
@@ -766,83 +715,39 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
   // now calculate energy densities...
   _nTowers = 0;  // store how many towers were used to determine bkg
 
+  // the flow modulation only depends on phi
+  for (int phi = 0; phi < _HCAL_NPHI; phi++)
+  {
+    _FLOW_WEIGHT[phi] = 1 / (1 + 2 * _v2 * cos(2 * (_PHI_CENTER[phi] - _Psi2)));
+  }
+
   // starting with the EMCal first...
   for (int layer = 0; layer < 3; layer++)
   {
-    int local_max_eta = _HCAL_NETA;
-    int local_max_phi = _HCAL_NPHI;
+    const std::vector<float> &layer_E = _TOWER_E[layer];
+    const std::vector<char> &layer_isBad = _TOWER_ISBAD[layer];
 
-    for (int eta = 0; eta < local_max_eta; eta++)
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
     {
+      const int first = eta * _HCAL_NPHI;
       float total_E = 0;
       int total_tower = 0;
 
-      for (int phi = 0; phi < local_max_phi; phi++)
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
       {
-        float this_eta = geomIH->get_etacenter(eta);
-        float this_phi = geomIH->get_phicenter(phi);
-
-        bool isExcluded = false;
-
-        float my_E = (layer == 0 ? _EMCAL_E[eta][phi] : (layer == 1 ? _IHCAL_E[eta][phi] : _OHCAL_E[eta][phi]));
-        int this_isBad = (layer == 0 ? _EMCAL_ISBAD[eta][phi] : (layer == 1 ? _IHCAL_ISBAD[eta][phi] : _OHCAL_ISBAD[eta][phi]));
-        // if the tower is masked (energy identically zero), exclude it
-        if (this_isBad)
-        {
-          isExcluded = true;
-          if (Verbosity() > 10)
-          {
-            std::cout << " tower in layer " << layer << " at eta / phi = " << this_eta << " / " << this_phi << " with E = " << my_E << " excluded due to masking" << std::endl;
-          }
-        }
-        for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
-        {
-          float deta = this_eta - _seed_eta[iseed];
-          float dphi = this_phi - _seed_phi[iseed];
-          if (dphi > M_PI)
-          {
-            dphi -= 2 * M_PI;
-          }
-          if (dphi < -M_PI)
-          {
-            dphi += 2 * M_PI;
-          }
-          float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
-          if (dR < 0.4)
-          {
-            isExcluded = true;
-            if (Verbosity() > 10)
-            {
-              std::cout << " setting excluded mark from seed at eta / phi = " << _seed_eta[iseed] << " / " << _seed_phi[iseed] << std::endl;
-            }
-          }
-        }
-
+        // masked towers and towers close to a seed are excluded
+        const bool isExcluded = layer_isBad[first + phi] || _TOWER_EXCLUDED[first + phi];
         if (!isExcluded)
         {
-          if (layer == 0)
-          {
-            total_E += _EMCAL_E[eta][phi] / (1 + 2 * _v2 * cos(2 * (this_phi - _Psi2)));
-          }
-          if (layer == 1)
-          {
-            total_E += _IHCAL_E[eta][phi] / (1 + 2 * _v2 * cos(2 * (this_phi - _Psi2)));
-          }
-          if (layer == 2)
-          {
-            total_E += _OHCAL_E[eta][phi] / (1 + 2 * _v2 * cos(2 * (this_phi - _Psi2)));
-          }
+          total_E += layer_E[first + phi] * _FLOW_WEIGHT[phi];
           total_tower++;  // towers in this eta range & layer
-          _nTowers++;     // towers in entire calorimeter
         }
-        else
+        else if (Verbosity() > 10)
         {
-          if (Verbosity() > 10)
-          {
-            std::cout << " tower at eta / phi = " << this_eta << " / " << this_phi << " with E = " << total_E << " excluded due to seed " << std::endl;
-          }
+          std::cout << " tower in layer " << layer << " at eta / phi = " << _ETA_CENTER[eta] << " / " << _PHI_CENTER[phi] << " with E = " << layer_E[first + phi] << " excluded due to " << (layer_isBad[first + phi] ? "masking" : "seed") << std::endl;
         }
       }
+      _nTowers += total_tower;  // towers in entire calorimeter
 
       std::pair<float, float> etabounds = geomIH->get_etabounds(eta);
       std::pair<float, float> phibounds = geomIH->get_phibounds(0);
@@ -885,6 +790,45 @@ int DetermineTowerBackground::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void DetermineTowerBackground::FillExclusionMask()
+{
+  std::fill(_TOWER_EXCLUDED.begin(), _TOWER_EXCLUDED.end(), 0);
+
+  for (unsigned int iseed = 0; iseed < _seed_eta.size(); iseed++)
+  {
+    for (int eta = 0; eta < _HCAL_NETA; eta++)
+    {
+      float deta = _ETA_CENTER[eta] - _seed_eta[iseed];
+      // dR can not be below the eta distance, skip strips far from the seed
+      if (std::fabs(deta) >= 0.4)
+      {
+        continue;
+      }
+      for (int phi = 0; phi < _HCAL_NPHI; phi++)
+      {
+        float dphi = _PHI_CENTER[phi] - _seed_phi[iseed];
+        if (dphi > M_PI)
+        {
+          dphi -= 2 * M_PI;
+        }
+        if (dphi < -M_PI)
+        {
+          dphi += 2 * M_PI;
+        }
+        float dR = sqrt(pow(deta, 2) + pow(dphi, 2));
+        if (dR < 0.4)
+        {
+          _TOWER_EXCLUDED[eta * _HCAL_NPHI + phi] = 1;
+          if (Verbosity() > 10)
+          {
+            std::cout << " setting excluded mark for tower at eta / phi = " << _ETA_CENTER[eta] << " / " << _PHI_CENTER[phi] << " from seed at eta / phi = " << _seed_eta[iseed] << " / " << _seed_phi[iseed] << std::endl;
+          }
+        }
+      }
+    }
+  }
+}
+
 int DetermineTowerBackground::CreateNode(PHCompositeNode *topNode)
 {
   PHNodeIterator iter(topNode);
@@ -53,6 +53,7 @@ class DetermineTowerBackground : public SubsysReco
  private:
   int CreateNode(PHCompositeNode *topNode);
   void FillNode(PHCompositeNode *topNode);
+  void FillExclusionMask();
 
   int _do_flow{0};
   float _v2{0};
@@ -64,13 +65,20 @@ class DetermineTowerBackground : public SubsysReco
   int _HCAL_NETA{-1};
   int _HCAL_NPHI{-1};
 
-  std::vector<std::vector<float> > _EMCAL_E;
-  std::vector<std::vector<float> > _IHCAL_E;
-  std::vector<std::vector<float> > _OHCAL_E;
+  // tower energies and masks of the three layers (retowered EMCal, IHCal, OHCal),
+  // flat in eta * _HCAL_NPHI + phi
+  std::vector<std::vector<float> > _TOWER_E;
+  std::vector<std::vector<char> > _TOWER_ISBAD;
 
-  std::vector<std::vector<int> > _EMCAL_ISBAD;
-  std::vector<std::vector<int> > _IHCAL_ISBAD;
-  std::vector<std::vector<int> > _OHCAL_ISBAD;
+  // towers within dR < 0.4 of any seed, the same for all layers
+  std::vector<char> _TOWER_EXCLUDED;
+
+  // tower centers, looked up once from the geometry
+  std::vector<float> _ETA_CENTER;
+  std::vector<float> _PHI_CENTER;
+
+  // 1 / (1 + 2 v2 cos(2 (phi - Psi2))) vs. phi
+  std::vector<float> _FLOW_WEIGHT;
 
   // 1-D energies vs. phi (integrated over eta strips with complete
   // phi coverage, and all layers)
@@ -18,12 +18,12 @@
 #include <phool/phool.h>
 
 // fastjet includes
-#include <fastjet/AreaDefinition.hh>
-#include <fastjet/ClusterSequenceArea.hh>
+#include <fastjet/ClusterSequenceActiveAreaExplicitGhosts.hh>
 #include <fastjet/GhostedAreaSpec.hh>
 #include <fastjet/JetDefinition.hh>
 #include <fastjet/PseudoJet.hh>
 #include <fastjet/Selector.hh>
+#include <fastjet/tools/GridMedianBackgroundEstimator.hh>
 #include <fastjet/tools/JetMedianBackgroundEstimator.hh>
 
 // standard includes
@@ -31,6 +31,7 @@
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -87,16 +88,31 @@ int DetermineTowerRho::process_event(PHCompositeNode *topNode)
                                  fastjet::E_scheme,
                                  fastjet::Best);
 
-  // area definition
-  fastjet::AreaDefinition area_def(fastjet::active_area_explicit_ghosts,
-                                   fastjet::GhostedAreaSpec(m_abs_ghost_eta, 1, m_ghost_area));
-
   fastjet::Selector jet_selector = ((!fastjet::SelectorNHardest(m_omit_nhardest)) *
                                     (fastjet::SelectorAbsEtaMax(m_abs_jet_eta_range) && fastjet::SelectorPtMin(m_jet_min_pT)));
 
   // Not pure ghost function
   fastjet::Selector not_pure_ghost = (!fastjet::SelectorIsPureGhost());
 
+  // the area and multiplicity methods share the background jets, clustered
+  // with explicit ghosts. The ghosts are the same for all events
+  std::unique_ptr<fastjet::ClusterSequenceActiveAreaExplicitGhosts> cs;
+  if (std::find(_rho_methods.begin(), _rho_methods.end(), TowerRho::Method::AREA) != _rho_methods.end() ||
+      std::find(_rho_methods.begin(), _rho_methods.end(), TowerRho::Method::MULT) != _rho_methods.end())
+  {
+    if (m_ghosts.empty())
+    {
+      fastjet::GhostedAreaSpec ghost_spec(m_abs_ghost_eta, 1, m_ghost_area);
+      ghost_spec.add_ghosts(m_ghosts);
+      m_actual_ghost_area = ghost_spec.actual_ghost_area();
+      if (Verbosity() > 0)
+      {
+        std::cout << "DetermineTowerRho::process_event - made " << m_ghosts.size() << " ghosts of area " << m_actual_ghost_area << std::endl;
+      }
+    }
+    cs = std::make_unique<fastjet::ClusterSequenceActiveAreaExplicitGhosts>(calo_pseudojets, jet_def, m_ghosts, m_actual_ghost_area);
+  }
+
   for (unsigned int ipos = 0; ipos < _rho_methods.size(); ipos++)
   {
     TowerRho::Method _rho_method = _rho_methods.at(ipos);
@@ -105,16 +121,14 @@ int DetermineTowerRho::process_event(PHCompositeNode *topNode)
 
     if (_rho_method == TowerRho::Method::AREA)
     {
-      fastjet::JetMedianBackgroundEstimator bge{jet_selector, jet_def, area_def};
-      bge.set_particles(calo_pseudojets);
+      fastjet::JetMedianBackgroundEstimator bge{jet_selector, *cs};
       rho = bge.rho();
       sigma = bge.sigma();
     }
     else if (_rho_method == TowerRho::Method::MULT)
     {
-      // reconstruct the background jets
-      fastjet::ClusterSequenceArea cs(calo_pseudojets, jet_def, area_def);
-      std::vector<fastjet::PseudoJet> jets = fastjet::sorted_by_pt(jet_selector(cs.inclusive_jets()));
+      // the background jets
+      std::vector<fastjet::PseudoJet> jets = fastjet::sorted_by_pt(jet_selector(cs->inclusive_jets()));
 
       std::vector<float> pt_over_nConstituents;
       int nfj_jets = 0;
@@ -151,6 +165,14 @@ int DetermineTowerRho::process_event(PHCompositeNode *topNode)
       sigma = float(std_tmp * std::sqrt(mean_N));
       rho = med_tmp;
     }
+    else if (_rho_method == TowerRho::Method::GRID)
+    {
+      // median pT/area of the grid cells, no clustering needed
+      fastjet::GridMedianBackgroundEstimator bge{m_abs_tower_eta_range, m_grid_spacing};
+      bge.set_particles(calo_pseudojets);
+      rho = bge.rho();
+      sigma = bge.sigma();
+    }
     else
     {
       rho = 0;
@@ -423,6 +445,7 @@ void DetermineTowerRho::print_settings(std::ostream &os) const
   os << "Tower eta range: " << m_abs_tower_eta_range << std::endl;
   os << "Jet eta range: " << m_abs_jet_eta_range << std::endl;
   os << "Ghost area: " << m_ghost_area << std::endl;
+  os << "Grid spacing: " << m_grid_spacing << std::endl;
   os << "Omit n hardest: " << m_omit_nhardest << std::endl;
   os << "Tower min pT: " << m_tower_min_pT << std::endl;
   os << "Jet min pT: " << m_jet_min_pT << std::endl;
@@ -18,7 +18,7 @@
 #include <fun4all/SubsysReco.h>
 
 #include <fastjet/JetDefinition.hh>
-//#include <fastjet/PseudoJet.hh>
+#include <fastjet/PseudoJet.hh>
 
 // system includes
 #include <iostream>
@@ -28,16 +28,16 @@
 // forward declarations
 class PHCompositeNode;
 class JetInput;
-namespace fastjet
-{
-  class PseudoJet;
-}
 
 /// \class DetermineTowerRho
 ///
 /// \brief UE background calculator
 ///
-/// This module estimates rho for the area and multiplicty methods using kt jets
+/// This module estimates rho for the area and multiplicty methods using kt jets.
+/// The background jets are clustered once per event for both methods, with
+/// explicit ghosts which are made on the first event and reused afterwards.
+/// The grid method is a cheap alternative without clustering, it takes the
+/// median pT/area of eta-phi cells of size set_grid_spacing
 ///
 
 class DetermineTowerRho : public SubsysReco
@@ -50,7 +50,7 @@ class DetermineTowerRho : public SubsysReco
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
 
-  // add rho method (Area or Multiplicity)
+  // add rho method (Area, Multiplicity or Grid)
   void add_method(TowerRho::Method rho_method, std::string output = "")
   {
     // get method name
@@ -112,6 +112,10 @@ class DetermineTowerRho : public SubsysReco
   void set_ghost_area(float ghost_area) { m_ghost_area = ghost_area; }  // default is 0.01
   float get_ghost_area() const { return m_ghost_area; }
 
+  // set the cell size for the grid method // default is 0.55
+  void set_grid_spacing(float grid_spacing) { m_grid_spacing = grid_spacing; }
+  float get_grid_spacing() const { return m_grid_spacing; }
+
   // print settings
   void print_settings(std::ostream &os = std::cout) const;
 
@@ -154,6 +158,12 @@ class DetermineTowerRho : public SubsysReco
 
   float m_ghost_area{0.01};
 
+  float m_grid_spacing{0.55};
+
+  // ghosts of the background jet clustering, made on the first event
+  std::vector<fastjet::PseudoJet> m_ghosts;
+  double m_actual_ghost_area{0};
+
   // tower threshold
   // bool m_do_tower_cut { false };
   // float m_tower_threshold { 0.0 };
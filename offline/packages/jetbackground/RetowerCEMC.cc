@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <utility>
+#include <vector>
 
 RetowerCEMC::RetowerCEMC(const std::string &name)
   : SubsysReco(name)
@@ -44,6 +45,8 @@ int RetowerCEMC::InitRun(PHCompositeNode *topNode)
   {
     get_fraction(topNode);
   }
+  // the retowering map is rebuilt from the new fractions on the first event
+  m_map_offset.clear();
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -77,75 +80,55 @@ int RetowerCEMC::process_event(PHCompositeNode *topNode)
 
   if (m_use_towerinfo)
   {
+    EMRetowerName = m_towerNodePrefix + "_CEMC_RETOWER";
+    TowerInfoContainer *emcal_retower = findNode::getClass<TowerInfoContainer>(topNode, EMRetowerName);
+    if (m_map_offset.empty())
+    {
+      build_retower_map(towerinfosEM3, emcal_retower);
+    }
+
     unsigned int nchannels = towerinfosEM3->size();
+    m_rawtower_e.resize(nchannels);
+    m_rawtower_status.resize(nchannels);
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfosEM3->get_tower_at_channel(channel);
-      unsigned int channelkey = towerinfosEM3->encode_key(channel);
-      int ieta = towerinfosEM3->getTowerEtaBin(channelkey);
-      int iphi = towerinfosEM3->getTowerPhiBin(channelkey);
-      rawtower_e[ieta][iphi] = tower->get_energy();
-      rawtower_status[ieta][iphi] = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2();
+      m_rawtower_e[channel] = tower->get_energy();
+      m_rawtower_status[channel] = tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2();
     }
-    EMRetowerName = m_towerNodePrefix + "_CEMC_RETOWER";
-    TowerInfoContainer *emcal_retower = findNode::getClass<TowerInfoContainer>(topNode, EMRetowerName);
     if (Verbosity() > 0)
     {
       std::cout << "RetowerCEMC::process_event: filling " << EMRetowerName << " node" << std::endl;
     }
-    for (int ieta_ihcal = 0; ieta_ihcal < neta_ihcal; ++ieta_ihcal)
+    for (unsigned int iretower = 0; iretower < m_retower_channel.size(); ++iretower)
     {
-      for (int iphi_ihcal = 0; iphi_ihcal < nphi_ihcal; ++iphi_ihcal)
+      double retower_e_temp = 0;
+      double retower_badarea = 0;
+      for (unsigned int imap = m_map_offset[iretower]; imap < m_map_offset[iretower + 1]; ++imap)
       {
-        double retower_e_temp = 0;
-        double retower_badarea = 0;
-        for (int ieta_emcal = retower_lowerbound_originaltower_ieta[ieta_ihcal]; ieta_emcal <= retower_upperbound_originaltower_ieta[ieta_ihcal]; ++ieta_emcal)
+        unsigned int channel = m_map_channel[imap];
+        if (m_rawtower_status[channel])
         {
-          for (int iphi_emcal = retower_first_lowerbound_originaltower_iphi + iphi_ihcal * 4; iphi_emcal < retower_first_lowerbound_originaltower_iphi + iphi_ihcal * 4 + 4; ++iphi_emcal)
-          {
-            int iphi_emcal_wrap = iphi_emcal;
-            if (iphi_emcal > nphi_emcal - 1)
-            {
-              iphi_emcal_wrap -= nphi_emcal;
-            }
-            double fraction_temp;
-            if (ieta_emcal == retower_lowerbound_originaltower_ieta[ieta_ihcal])
-            {
-              fraction_temp = retower_lowerbound_originaltower_fraction[ieta_ihcal];
-            }
-            else if (ieta_emcal == retower_upperbound_originaltower_ieta[ieta_ihcal])
-            {
-              fraction_temp = retower_upperbound_originaltower_fraction[ieta_ihcal];
-            }
-            else
-            {
-              fraction_temp = 1;
-            }
-            if (rawtower_status[ieta_emcal][iphi_emcal_wrap])
-            {
-              retower_badarea += fraction_temp;
-            }
-            else
-            {
-              retower_e_temp += rawtower_e[ieta_emcal][iphi_emcal_wrap] * fraction_temp;
-            }
-          }
-        }
-        unsigned int towerkey = TowerInfoDefs::encode_hcal(ieta_ihcal, iphi_ihcal);
-        unsigned int towerindex = emcal_retower->decode_key(towerkey);
-        TowerInfo *towerinfo = emcal_retower->get_tower_at_channel(towerindex);
-        double scalefactor = retower_badarea / (double) retower_totalarea[ieta_ihcal];
-        if (scalefactor > _frac_cut)
-        {
-          towerinfo->set_energy(0);
-          towerinfo->set_isHot(true);
+          retower_badarea += m_map_fraction[imap];
         }
         else
         {
-          towerinfo->set_energy(retower_e_temp / (double) (1 - scalefactor));
-          towerinfo->set_chi2(scalefactor);
+          retower_e_temp += m_rawtower_e[channel] * m_map_fraction[imap];
         }
       }
+      TowerInfo *towerinfo = emcal_retower->get_tower_at_channel(m_retower_channel[iretower]);
+      int ieta_ihcal = iretower / nphi_ihcal;
+      double scalefactor = retower_badarea / (double) retower_totalarea[ieta_ihcal];
+      if (scalefactor > _frac_cut)
+      {
+        towerinfo->set_energy(0);
+        towerinfo->set_isHot(true);
+      }
+      else
+      {
+        towerinfo->set_energy(retower_e_temp / (double) (1 - scalefactor));
+        towerinfo->set_chi2(scalefactor);
+      }
     }
   }
   else
@@ -263,6 +246,72 @@ int RetowerCEMC::CreateNode(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void RetowerCEMC::build_retower_map(TowerInfoContainer *towerinfosEM, TowerInfoContainer *emcal_retower)
+{
+  // EMCal channel at each eta / phi bin
+  std::vector<int> emcal_channel(neta_emcal * nphi_emcal, -1);
+  unsigned int nchannels = towerinfosEM->size();
+  for (unsigned int channel = 0; channel < nchannels; channel++)
+  {
+    unsigned int channelkey = towerinfosEM->encode_key(channel);
+    int ieta = towerinfosEM->getTowerEtaBin(channelkey);
+    int iphi = towerinfosEM->getTowerPhiBin(channelkey);
+    emcal_channel[ieta * nphi_emcal + iphi] = channel;
+  }
+
+  // the EMCal towers of each retowered tower only depend on the geometry,
+  // keep the order of the sums the same as in the loops over eta and phi
+  m_retower_channel.clear();
+  m_map_offset.assign(1, 0);
+  m_map_channel.clear();
+  m_map_fraction.clear();
+  for (int ieta_ihcal = 0; ieta_ihcal < neta_ihcal; ++ieta_ihcal)
+  {
+    for (int iphi_ihcal = 0; iphi_ihcal < nphi_ihcal; ++iphi_ihcal)
+    {
+      for (int ieta_emcal = retower_lowerbound_originaltower_ieta[ieta_ihcal]; ieta_emcal <= retower_upperbound_originaltower_ieta[ieta_ihcal]; ++ieta_emcal)
+      {
+        for (int iphi_emcal = retower_first_lowerbound_originaltower_iphi + iphi_ihcal * 4; iphi_emcal < retower_first_lowerbound_originaltower_iphi + iphi_ihcal * 4 + 4; ++iphi_emcal)
+        {
+          int iphi_emcal_wrap = iphi_emcal;
+          if (iphi_emcal > nphi_emcal - 1)
+          {
+            iphi_emcal_wrap -= nphi_emcal;
+          }
+          double fraction_temp;
+          if (ieta_emcal == retower_lowerbound_originaltower_ieta[ieta_ihcal])
+          {
+            fraction_temp = retower_lowerbound_originaltower_fraction[ieta_ihcal];
+          }
+          else if (ieta_emcal == retower_upperbound_originaltower_ieta[ieta_ihcal])
+          {
+            fraction_temp = retower_upperbound_originaltower_fraction[ieta_ihcal];
+          }
+          else
+          {
+            fraction_temp = 1;
+          }
+          // towers missing in the container have no energy and do not count as bad
+          int channel = emcal_channel[ieta_emcal * nphi_emcal + iphi_emcal_wrap];
+          if (channel < 0)
+          {
+            continue;
+          }
+          m_map_channel.push_back(channel);
+          m_map_fraction.push_back(fraction_temp);
+        }
+      }
+      m_map_offset.push_back(m_map_channel.size());
+      unsigned int towerkey = TowerInfoDefs::encode_hcal(ieta_ihcal, iphi_ihcal);
+      m_retower_channel.push_back(emcal_retower->decode_key(towerkey));
+    }
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << "RetowerCEMC::build_retower_map: " << m_map_channel.size() << " EMCal towers mapped to " << m_retower_channel.size() << " retowered towers" << std::endl;
+  }
+}
+
 void RetowerCEMC::get_first_phi_index(PHCompositeNode *topNode)
 {
   RawTowerGeomContainer *geomEM = findNode::getClass<RawTowerGeomContainer>(topNode, "TOWERGEOM_CEMC");
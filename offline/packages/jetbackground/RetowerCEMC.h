@@ -4,8 +4,10 @@
 #include <fun4all/SubsysReco.h>
 
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
+class TowerInfoContainer;
 
 class RetowerCEMC : public SubsysReco
 {
@@ -30,6 +32,7 @@ class RetowerCEMC : public SubsysReco
   void get_first_phi_index(PHCompositeNode *topNode);
   void get_fraction(PHCompositeNode *topNode);
   void get_weighted_fraction(PHCompositeNode *topNode);
+  void build_retower_map(TowerInfoContainer *towerinfosEM, TowerInfoContainer *emcal_retower);
 
   int _weighted_energy_distribution{1};
   double _frac_cut{0.5};
@@ -48,8 +51,17 @@ class RetowerCEMC : public SubsysReco
   double retower_totalarea[neta_ihcal] = {0.0};
   int retower_first_lowerbound_originaltower_iphi{-1};
 
-  double rawtower_e[neta_emcal][nphi_emcal] = {{0.0}};
-  int rawtower_status[neta_emcal][nphi_emcal] = {{0}};
+  // retowering map for towerinfos, built on the first event. Retowered channel
+  // m_retower_channel[i] sums the EMCal channels m_map_channel[m_map_offset[i] ... m_map_offset[i + 1] - 1]
+  // weighted by the eta fractions in m_map_fraction
+  std::vector<unsigned int> m_retower_channel;
+  std::vector<unsigned int> m_map_offset;
+  std::vector<unsigned int> m_map_channel;
+  std::vector<double> m_map_fraction;
+
+  // energy and status of the EMCal channels of the current event
+  std::vector<double> m_rawtower_e;
+  std::vector<char> m_rawtower_status;
 
   std::string EMTowerName;
   std::string IHTowerName;
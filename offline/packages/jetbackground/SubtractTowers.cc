@@ -140,6 +140,10 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
   // read these in to use, even if we don't use flow modulation in the subtraction
   float background_v2 = towerbackground->get_v2();
   float background_Psi2 = towerbackground->get_Psi2();
+  // get_UE returns a copy, take it once instead of for every tower
+  const std::vector<float> background_UE_0 = towerbackground->get_UE(0);
+  const std::vector<float> background_UE_1 = towerbackground->get_UE(1);
+  const std::vector<float> background_UE_2 = towerbackground->get_UE(2);
 
   // EMCal
 
@@ -154,7 +158,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
       int ieta = towerinfosEM3->getTowerEtaBin(towerkey);
       int iphi = towerinfosEM3->getTowerPhiBin(towerkey);
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(0).at(ieta);
+      float UE = background_UE_0.at(ieta);
       if (_use_flow_modulation)
       {
         const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
@@ -212,7 +216,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
     {
       RawTower *tower = rtiter->second;
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(0).at(tower->get_bineta());
+      float UE = background_UE_0.at(tower->get_bineta());
       if (_use_flow_modulation)
       {
         float tower_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
@@ -243,7 +247,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
       int iphi = towerinfosIH3->getTowerPhiBin(towerkey);
 
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(1).at(ieta);
+      float UE = background_UE_1.at(ieta);
       if (_use_flow_modulation)
       {
         const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALIN, ieta, iphi);
@@ -301,7 +305,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
     {
       RawTower *tower = rtiter->second;
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(1).at(tower->get_bineta());
+      float UE = background_UE_1.at(tower->get_bineta());
       if (_use_flow_modulation)
       {
         float tower_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
@@ -328,7 +332,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
       int ieta = towerinfosOH3->getTowerEtaBin(towerkey);
       int iphi = towerinfosOH3->getTowerPhiBin(towerkey);
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(2).at(ieta);
+      float UE = background_UE_2.at(ieta);
       if (_use_flow_modulation)
       {
         const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::HCALOUT, ieta, iphi);
@@ -386,7 +390,7 @@ int SubtractTowers::process_event(PHCompositeNode *topNode)
     {
       RawTower *tower = rtiter->second;
       float raw_energy = tower->get_energy();
-      float UE = towerbackground->get_UE(2).at(tower->get_bineta());
+      float UE = background_UE_2.at(tower->get_bineta());
       if (_use_flow_modulation)
       {
         float tower_phi = geomOH->get_tower_geometry(tower->get_key())->get_phi();
@@ -20,13 +20,12 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
-#include <fastjet/PseudoJet.hh>
-#include <fastjet/contrib/ConstituentSubtractor.hh>
-
 // standard includes
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -39,6 +38,16 @@ int SubtractTowersCS::InitRun(PHCompositeNode *topNode)
 {
   CreateNode(topNode);
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "SubtractTowersCS::InitRun - subtracting the calorimeter layers with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -82,457 +91,359 @@ int SubtractTowersCS::process_event(PHCompositeNode *topNode)
   // read these in to use, even if we don't use flow modulation in the subtraction
   float background_v2 = towerbackground->get_v2();
   float background_Psi2 = towerbackground->get_Psi2();
+  // get_UE returns a copy, take it once instead of for every tower
+  const std::vector<float> background_UE_0 = towerbackground->get_UE(0);
+  const std::vector<float> background_UE_1 = towerbackground->get_UE(1);
+  const std::vector<float> background_UE_2 = towerbackground->get_UE(2);
 
-  // set up constituent subtraction
-  fastjet::contrib::ConstituentSubtractor subtractor;
-
-  // free parameter for the type of distance between particle i and
-  // ghost k. There are two options: "deltaR" or "angle" which are
-  // defined as deltaR=sqrt((y_i-y_k)^2+(phi_i-phi_k)^2) or Euclidean
-  // angle between the momenta
-  subtractor.set_distance_type(fastjet::contrib::ConstituentSubtractor::deltaR);
-
-  // free parameter for the maximal allowed distance between particle i and ghost k
-  subtractor.set_max_distance(_DeltaRmax);
-
-  // free parameter for the distance measure (the exponent of particle
-  // pt). The larger the parameter alpha, the more are favoured the
-  // lower pt particles in the subtraction process
-  subtractor.set_alpha(_alpha);
-
-  // free parameter for the density of ghosts. The smaller, the better
-  // - but also the computation is slower.
-  subtractor.set_ghost_area(0.01);
-
-  // EM layer first
-  std::vector<fastjet::PseudoJet> backgroundProxies_EM;
-  std::vector<fastjet::PseudoJet> fullEvent_EM;
-  std::vector<fastjet::PseudoJet> *backgroundProxies_EM_remaining = new std::vector<fastjet::PseudoJet>;
-
-  // create PseudoJet version of EM towers in unsubtracted event
-  RawTowerContainer::ConstRange begin_end_EM = towersEM3->getTowers();
-
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_EM.first; rtiter != begin_end_EM.second; ++rtiter)
+  // constituent subtraction, the layers write to different tower containers
+  auto subtract = [&](size_t layer)
   {
-    RawTower *tower = rtiter->second;
-
-    double this_eta = geomIH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
-    double this_E = tower->get_energy();
-
-    double this_pz = this_E * tanh(this_eta);
-    double this_pt = sqrt(pow(this_E, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, this_E);
-
-    fullEvent_EM.push_back(this_pj);
+    switch (layer)
+    {
+    case 0:
+      SubtractLayer("EM", m_grids[0], towersEM3, emcal_towers, geomIH, background_UE_0, background_v2, background_Psi2);
+      break;
+    case 1:
+      SubtractLayer("IH", m_grids[1], towersIH3, ihcal_towers, geomIH, background_UE_1, background_v2, background_Psi2);
+      break;
+    default:
+      SubtractLayer("OH", m_grids[2], towersOH3, ohcal_towers, geomOH, background_UE_2, background_v2, background_Psi2);
+      break;
+    }
+  };
+  // the printouts of the layers would interleave
+  if (m_threadpool && Verbosity() == 0)
+  {
+    m_threadpool->parallel_for(m_grids.size(), subtract);
   }
-
-  // create all new towers
-  for (int eta = 0; eta < geomIH->get_etabins(); eta++)
+  else
   {
-    for (int phi = 0; phi < geomIH->get_phibins(); phi++)
+    for (size_t layer = 0; layer < m_grids.size(); ++layer)
     {
-      RawTower *new_tower = new RawTowerv1();
-      new_tower->set_energy(0);
-      emcal_towers->AddTower(eta, phi, new_tower);
+      subtract(layer);
     }
   }
 
-  // create PseudoJet version of estimated background in EM layer
-  for (RawTowerContainer::ConstIterator rtiter = emcal_towers->getTowers().first; rtiter != emcal_towers->getTowers().second; ++rtiter)
+  if (Verbosity() > 0)
   {
-    RawTower *tower = rtiter->second;
-
-    double this_eta = geomIH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
+    std::cout << "SubtractTowersCS::process_event: ending with " << emcal_towers->size() << " TOWER_CALIB_CEMC_RETOWER_SUB1CS towers" << std::endl;
 
-    double UE = towerbackground->get_UE(0).at(tower->get_bineta());
-    if (_use_flow_modulation)
+    float EM_old_E = 0;
+    float EM_new_E = 0;
     {
-      UE = UE * (1 + 2 * background_v2 * cos(2 * (this_phi - background_Psi2)));
+      RawTowerContainer::ConstRange begin_end_EM_1 = towersEM3->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_1.first; rtiter != begin_end_EM_1.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        EM_old_E += tower->get_energy();
+      }
     }
-
-    double this_pz = UE * tanh(this_eta);
-    double this_pt = sqrt(pow(UE, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, UE);
-
-    backgroundProxies_EM.push_back(this_pj);
-
-    if (Verbosity() > 5)
     {
-      std::cout << " SubtractTowersCS::process_event : background tower EM estimate for eta / phi = " << tower->get_bineta() << " / " << tower->get_binphi() << ", UE = " << UE << std::endl;
+      RawTowerContainer::ConstRange begin_end_EM_2 = emcal_towers->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_2.first; rtiter != begin_end_EM_2.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        EM_new_E += tower->get_energy();
+      }
     }
-  }
-
-  // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_EM = subtractor.do_subtraction(fullEvent_EM, backgroundProxies_EM, backgroundProxies_EM_remaining);
-
-  if (Verbosity() > 0)
-  {
-    std::cout << " SubtractTowersCS::process_event : vector lengths fullEvent_EM = " << fullEvent_EM.size() << " , backgroundProxies_EM = " << backgroundProxies_EM.size() << " , correctedEvent_EM = " << correctedEvent_EM.size() << ", backgroundProxies_EM_remaining = " << backgroundProxies_EM_remaining->size() << std::endl;
+    std::cout << "SubtractTowersCS::process_event: old / new total E in EM layer = " << EM_old_E << " / " << EM_new_E << std::endl;
 
-    double E_0 = 0, E_1 = 0, E_2 = 0, E_3 = 0;
+    std::cout << "SubtractTowersCS::process_event: ending with " << ihcal_towers->size() << " TOWER_CALIB_HCALIN_SUB1CS towers" << std::endl;
 
-    for (auto &n : fullEvent_EM)
+    float IH_old_E = 0;
+    float IH_new_E = 0;
     {
-      E_0 += n.E();
+      RawTowerContainer::ConstRange begin_end_EM_3 = towersIH3->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_3.first; rtiter != begin_end_EM_3.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        IH_old_E += tower->get_energy();
+      }
     }
-    for (auto &n : backgroundProxies_EM)
     {
-      E_1 += n.E();
+      RawTowerContainer::ConstRange begin_end_EM_4 = ihcal_towers->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_4.first; rtiter != begin_end_EM_4.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        IH_new_E += tower->get_energy();
+      }
     }
-    for (auto &n : correctedEvent_EM)
+    std::cout << "SubtractTowersCS::process_event: old / new total E in IH layer = " << IH_old_E << " / " << IH_new_E << std::endl;
+
+    std::cout << "SubtractTowersCS::process_event: ending with " << ohcal_towers->size() << " TOWER_CALIB_HCALOUT_SUB1CS towers" << std::endl;
+
+    float OH_old_E = 0;
+    float OH_new_E = 0;
     {
-      E_2 += n.E();
+      RawTowerContainer::ConstRange begin_end_EM_5 = towersOH3->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_5.first; rtiter != begin_end_EM_5.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        OH_old_E += tower->get_energy();
+      }
     }
-    for (auto &n : *backgroundProxies_EM_remaining)
     {
-      E_3 += n.E();
+      RawTowerContainer::ConstRange begin_end_EM_6 = ohcal_towers->getTowers();
+      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_6.first; rtiter != begin_end_EM_6.second; ++rtiter)
+      {
+        RawTower *tower = rtiter->second;
+        OH_new_E += tower->get_energy();
+      }
     }
-
-    std::cout << "SubtractTowersCS::process_event EM : full event E - background E = " << E_0 << " - " << E_1 << " = " << E_0 - E_1 << ", subtracted E - remaining bkg E = " << E_2 << " - " << E_3 << " = " << E_2 - E_3 << std::endl;
+    std::cout << "SubtractTowersCS::process_event: old / new total E in OH layer = " << OH_old_E << " / " << OH_new_E << std::endl;
   }
 
-  // load subtracted towers into grid
-
-  for (auto &n : correctedEvent_EM)
+  if (Verbosity() > 0)
   {
-    float this_eta = n.eta();
-    float this_phi = n.phi();
-    float this_E = n.E();
-
-    // look up tower by eta / phi...
-
-    int this_etabin = geomIH->get_etabin(this_eta);
-    int this_phibin = geomIH->get_phibin(this_phi);
-    RawTower *tower = emcal_towers->getTower(this_etabin, this_phibin);
-    tower->set_energy(this_E);
-
-    if (Verbosity() > 5 || this_E < 0)
-    {
-      std::cout << " SubtractTowersCS::process_event : creating subtracted EM tower for eta / phi = " << this_eta << " / " << this_phi << " ( " << tower->get_binphi() << " , " << this_phibin << " ) , sub. E  = " << this_E << (this_E < 0 ? " -- WARNING: negative E" : "") << std::endl;
-    }
+    std::cout << "SubtractTowersCS::process_event: exiting" << std::endl;
   }
 
-  // IHCal layer
-  std::vector<fastjet::PseudoJet> backgroundProxies_IH;
-  std::vector<fastjet::PseudoJet> fullEvent_IH;
-  std::vector<fastjet::PseudoJet> *backgroundProxies_IH_remaining = new std::vector<fastjet::PseudoJet>;
-
-  // create PseudoJet version of IH towers in unsubtracted event
-  RawTowerContainer::ConstRange begin_end_IH = towersIH3->getTowers();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_IH.first; rtiter != begin_end_IH.second; ++rtiter)
+void SubtractTowersCS::FillGhostGrid(GhostGrid &grid, RawTowerGeomContainer *geom) const
+{
+  if (grid.geom == geom && grid.DeltaRmax == _DeltaRmax && !grid.neighbors.empty())
   {
-    RawTower *tower = rtiter->second;
-
-    double this_eta = geomIH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
-    double this_E = tower->get_energy();
-
-    double this_pz = this_E * tanh(this_eta);
-    double this_pt = sqrt(pow(this_E, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, this_E);
-
-    fullEvent_IH.push_back(this_pj);
+    return;
   }
-
-  // create all new towers
-  for (int eta = 0; eta < geomIH->get_etabins(); eta++)
+  grid.geom = geom;
+  grid.DeltaRmax = _DeltaRmax;
+  grid.phibins = geom->get_phibins();
+  const int nbins = geom->get_etabins() * grid.phibins;
+  grid.eta.assign(nbins, 0);
+  grid.phi.assign(nbins, 0);
+  grid.neighbors.assign(nbins, {});
+
+  std::vector<bool> filled(nbins, false);
+  double etamin = 0;
+  double etamax = 0;
+  bool first = true;
+  RawTowerGeomContainer::ConstRange begin_end = geom->get_tower_geometries();
+  for (RawTowerGeomContainer::ConstIterator iter = begin_end.first; iter != begin_end.second; ++iter)
   {
-    for (int phi = 0; phi < geomIH->get_phibins(); phi++)
+    const int bin = iter->second->get_bineta() * grid.phibins + iter->second->get_binphi();
+    if (bin < 0 || bin >= nbins)
     {
-      RawTower *new_tower = new RawTowerv1();
-      new_tower->set_energy(0);
-      ihcal_towers->AddTower(eta, phi, new_tower);
+      continue;
     }
+    grid.eta[bin] = iter->second->get_eta();
+    grid.phi[bin] = iter->second->get_phi();
+    etamin = first ? grid.eta[bin] : std::min(etamin, grid.eta[bin]);
+    etamax = first ? grid.eta[bin] : std::max(etamax, grid.eta[bin]);
+    first = false;
+    filled[bin] = true;
   }
 
-  // create PseudoJet version of estimated background in IH layer
-  for (RawTowerContainer::ConstIterator rtiter = ihcal_towers->getTowers().first; rtiter != ihcal_towers->getTowers().second; ++rtiter)
+  // cells of at least DeltaRmax in eta and phi, only the neighboring cells can hold ghosts within DeltaRmax.
+  // Without a maximal distance all ghosts are paired with all particles
+  const bool limited = std::isfinite(_DeltaRmax) && _DeltaRmax > 0;
+  const int netacells = limited ? std::max(1, static_cast<int>((etamax - etamin) / _DeltaRmax) + 1) : 1;
+  const int nphicells = limited ? std::max(1, static_cast<int>(2 * M_PI / _DeltaRmax)) : 1;
+  auto etacell = [&](double eta)
+  { return std::min(netacells - 1, static_cast<int>((eta - etamin) / (limited ? _DeltaRmax : 1))); };
+  auto phicell = [&](double phi)
   {
-    RawTower *tower = rtiter->second;
-
-    double this_eta = geomIH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomIH->get_tower_geometry(tower->get_key())->get_phi();
-
-    double UE = towerbackground->get_UE(1).at(tower->get_bineta());
-    if (_use_flow_modulation)
-    {
-      UE = UE * (1 + 2 * background_v2 * cos(2 * (this_phi - background_Psi2)));
-    }
+    const double phi02pi = phi - 2 * M_PI * std::floor(phi / (2 * M_PI));
+    return std::min(nphicells - 1, static_cast<int>(phi02pi / (2 * M_PI) * nphicells));
+  };
 
-    double this_pz = UE * tanh(this_eta);
-    double this_pt = sqrt(pow(UE, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, UE);
-
-    backgroundProxies_IH.push_back(this_pj);
-
-    if (Verbosity() > 5)
+  std::vector<std::vector<int>> cells(netacells * nphicells);
+  for (int bin = 0; bin < nbins; ++bin)
+  {
+    if (filled[bin])
     {
-      std::cout << " SubtractTowersCS::process_event : background tower IH estimate for eta / phi = " << tower->get_bineta() << " / " << tower->get_binphi() << ", UE = " << UE << std::endl;
+      cells[etacell(grid.eta[bin]) * nphicells + phicell(grid.phi[bin])].push_back(bin);
     }
   }
 
-  // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_IH = subtractor.do_subtraction(fullEvent_IH, backgroundProxies_IH, backgroundProxies_IH_remaining);
-
-  if (Verbosity() > 0)
+  for (int bin = 0; bin < nbins; ++bin)
   {
-    std::cout << " SubtractTowersCS::process_event : vector lengths fullEvent_IH = " << fullEvent_IH.size() << " , backgroundProxies_IH = " << backgroundProxies_IH.size() << " , correctedEvent_IH = " << correctedEvent_IH.size() << ", backgroundProxies_IH_remaining = " << backgroundProxies_IH_remaining->size() << std::endl;
-
-    double E_0 = 0, E_1 = 0, E_2 = 0, E_3 = 0;
-
-    for (auto &n : fullEvent_IH)
-    {
-      E_0 += n.E();
-    }
-    for (auto &n : backgroundProxies_IH)
-    {
-      E_1 += n.E();
-    }
-    for (auto &n : correctedEvent_IH)
+    if (!filled[bin])
     {
-      E_2 += n.E();
+      continue;
     }
-    for (auto &n : *backgroundProxies_IH_remaining)
+    const int ieta = etacell(grid.eta[bin]);
+    const int iphi = phicell(grid.phi[bin]);
+    for (int jeta = std::max(0, ieta - 1); jeta <= std::min(netacells - 1, ieta + 1); ++jeta)
     {
-      E_3 += n.E();
+      // with less than 3 phi cells all of them are neighbors
+      for (int dphi = (nphicells < 3 ? 0 : -1); dphi <= (nphicells < 3 ? nphicells - 1 : 1); ++dphi)
+      {
+        const int jphi = (iphi + dphi + nphicells) % nphicells;
+        for (const int ghost : cells[jeta * nphicells + jphi])
+        {
+          const double deta = grid.eta[bin] - grid.eta[ghost];
+          double dphi_ghost = std::fabs(grid.phi[bin] - grid.phi[ghost]);
+          if (dphi_ghost > M_PI)
+          {
+            dphi_ghost = 2 * M_PI - dphi_ghost;
+          }
+          const double deltaR = std::sqrt(deta * deta + dphi_ghost * dphi_ghost);
+          if (!limited || deltaR <= _DeltaRmax)
+          {
+            grid.neighbors[bin].emplace_back(ghost, deltaR);
+          }
+        }
+      }
     }
-
-    std::cout << "SubtractTowersCS::process_event IH : full event E - background E = " << E_0 << " - " << E_1 << " = " << E_0 - E_1 << ", subtracted E - remaining bkg E = " << E_2 << " - " << E_3 << " = " << E_2 - E_3 << std::endl;
   }
 
-  // load subtracted towers into grid
-
-  for (auto &n : correctedEvent_IH)
+  if (Verbosity() > 0)
   {
-    float this_eta = n.eta();
-    float this_phi = n.phi();
-    float this_E = n.E();
-
-    // look up tower by eta / phi...
-
-    int this_etabin = geomIH->get_etabin(this_eta);
-    int this_phibin = geomIH->get_phibin(this_phi);
-    RawTower *tower = ihcal_towers->getTower(this_etabin, this_phibin);
-    tower->set_energy(this_E);
-
-    if (Verbosity() > 5 || this_E < 0)
+    size_t npairs = 0;
+    for (const auto &neighbors : grid.neighbors)
     {
-      std::cout << " SubtractTowersCS::process_event : creating subtracted IH tower for eta / phi = " << this_eta << " / " << this_phi << " ( " << tower->get_binphi() << " , " << this_phibin << " ) , sub. E  = " << this_E << (this_E < 0 ? " -- WARNING: negative E" : "") << std::endl;
+      npairs += neighbors.size();
     }
+    std::cout << "SubtractTowersCS::FillGhostGrid - " << nbins << " bins, " << npairs << " tower-ghost pairs within DeltaRmax = " << _DeltaRmax << std::endl;
   }
+}
 
-  // OHCal layer
-  std::vector<fastjet::PseudoJet> backgroundProxies_OH;
-  std::vector<fastjet::PseudoJet> fullEvent_OH;
-  std::vector<fastjet::PseudoJet> *backgroundProxies_OH_remaining = new std::vector<fastjet::PseudoJet>;
-
-  // create PseudoJet version of OH towers in unsubtracted event
-  RawTowerContainer::ConstRange begin_end_OH = towersOH3->getTowers();
-
-  for (RawTowerContainer::ConstIterator rtiter = begin_end_OH.first; rtiter != begin_end_OH.second; ++rtiter)
-  {
-    RawTower *tower = rtiter->second;
-
-    double this_eta = geomOH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomOH->get_tower_geometry(tower->get_key())->get_phi();
-    double this_E = tower->get_energy();
-
-    double this_pz = this_E * tanh(this_eta);
-    double this_pt = sqrt(pow(this_E, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, this_E);
-
-    fullEvent_OH.push_back(this_pj);
-  }
+void SubtractTowersCS::SubtractLayer(const std::string &layer, GhostGrid &grid, RawTowerContainer *towers, RawTowerContainer *sub_towers,
+                                     RawTowerGeomContainer *geom, const std::vector<float> &background_UE,
+                                     float background_v2, float background_Psi2) const
+{
+  FillGhostGrid(grid, geom);
 
   // create all new towers
-  for (int eta = 0; eta < geomOH->get_etabins(); eta++)
+  for (int eta = 0; eta < geom->get_etabins(); eta++)
   {
-    for (int phi = 0; phi < geomOH->get_phibins(); phi++)
+    for (int phi = 0; phi < geom->get_phibins(); phi++)
     {
       RawTower *new_tower = new RawTowerv1();
       new_tower->set_energy(0);
-      ohcal_towers->AddTower(eta, phi, new_tower);
+      sub_towers->AddTower(eta, phi, new_tower);
     }
   }
 
-  // create PseudoJet version of estimated background in OH layer
-  for (RawTowerContainer::ConstIterator rtiter = ohcal_towers->getTowers().first; rtiter != ohcal_towers->getTowers().second; ++rtiter)
+  // transverse momentum of the estimated background (the ghosts) in this layer
+  const size_t nbins = grid.neighbors.size();
+  std::vector<double> ghost_pt(nbins, 0);
+  double E_1 = 0;
+  for (RawTowerContainer::ConstIterator rtiter = sub_towers->getTowers().first; rtiter != sub_towers->getTowers().second; ++rtiter)
   {
     RawTower *tower = rtiter->second;
+    const int bin = tower->get_bineta() * grid.phibins + tower->get_binphi();
 
-    double this_eta = geomOH->get_tower_geometry(tower->get_key())->get_eta();
-    double this_phi = geomOH->get_tower_geometry(tower->get_key())->get_phi();
+    double this_eta = geom->get_tower_geometry(tower->get_key())->get_eta();
+    double this_phi = geom->get_tower_geometry(tower->get_key())->get_phi();
 
-    double UE = towerbackground->get_UE(2).at(tower->get_bineta());
+    double UE = background_UE.at(tower->get_bineta());
     if (_use_flow_modulation)
     {
       UE = UE * (1 + 2 * background_v2 * cos(2 * (this_phi - background_Psi2)));
     }
 
     double this_pz = UE * tanh(this_eta);
-    double this_pt = sqrt(pow(UE, 2) - pow(this_pz, 2));
-    double this_px = this_pt * cos(this_phi);
-    double this_py = this_pt * sin(this_phi);
-
-    fastjet::PseudoJet this_pj(this_px, this_py, this_pz, UE);
-
-    backgroundProxies_OH.push_back(this_pj);
+    ghost_pt.at(bin) = sqrt(pow(UE, 2) - pow(this_pz, 2));
+    E_1 += UE;
 
     if (Verbosity() > 5)
     {
-      std::cout << " SubtractTowersCS::process_event : background tower OH estimate for eta / phi = " << tower->get_bineta() << " / " << tower->get_binphi() << ", UE = " << UE << std::endl;
+      std::cout << " SubtractTowersCS::process_event : background tower " << layer << " estimate for eta / phi = " << tower->get_bineta() << " / " << tower->get_binphi() << ", UE = " << UE << std::endl;
     }
   }
 
-  // constituent subtraction
-  std::vector<fastjet::PseudoJet> correctedEvent_OH = subtractor.do_subtraction(fullEvent_OH, backgroundProxies_OH, backgroundProxies_OH_remaining);
-
-  if (Verbosity() > 0)
+  // the towers of the unsubtracted event are the particles
+  struct Particle
   {
-    std::cout << " SubtractTowersCS::process_event : vector lengths fullEvent_OH = " << fullEvent_OH.size() << " , backgroundProxies_OH = " << backgroundProxies_OH.size() << " , correctedEvent_OH = " << correctedEvent_OH.size() << ", backgroundProxies_OH_remaining = " << backgroundProxies_OH_remaining->size() << std::endl;
-
-    double E_0 = 0, E_1 = 0, E_2 = 0, E_3 = 0;
+    RawTower *tower;
+    int bin;
+    double eta;
+    double pt;
+  };
+  std::vector<Particle> particles;
+  particles.reserve(towers->size());
+  double E_0 = 0;
+  RawTowerContainer::ConstRange begin_end = towers->getTowers();
+  for (RawTowerContainer::ConstIterator rtiter = begin_end.first; rtiter != begin_end.second; ++rtiter)
+  {
+    RawTower *tower = rtiter->second;
+    const int bin = tower->get_bineta() * grid.phibins + tower->get_binphi();
 
-    for (auto &n : fullEvent_OH)
-    {
-      E_0 += n.E();
-    }
-    for (auto &n : backgroundProxies_OH)
-    {
-      E_1 += n.E();
-    }
-    for (auto &n : correctedEvent_OH)
-    {
-      E_2 += n.E();
-    }
-    for (auto &n : *backgroundProxies_OH_remaining)
-    {
-      E_3 += n.E();
-    }
+    double this_eta = geom->get_tower_geometry(tower->get_key())->get_eta();
+    double this_E = tower->get_energy();
 
-    std::cout << "SubtractTowersCS::process_event OH : full event E - background E = " << E_0 << " - " << E_1 << " = " << E_0 - E_1 << ", subtracted E - remaining bkg E = " << E_2 << " - " << E_3 << " = " << E_2 - E_3 << std::endl;
+    double this_pz = this_E * tanh(this_eta);
+    double this_pt = sqrt(pow(this_E, 2) - pow(this_pz, 2));
+    particles.push_back({tower, bin, this_eta, this_pt});
+    E_0 += this_E;
   }
 
-  // load subtracted towers into grid
-
-  for (auto &n : correctedEvent_OH)
+  // all particle-ghost pairs within DeltaRmax, the distance measure
+  // pt^alpha * DeltaR favours the lower pt particles for alpha > 0
+  const double alpha = std::isfinite(_alpha) ? _alpha : 0;
+  std::vector<std::tuple<double, unsigned int, int>> pairs;
+  for (unsigned int i = 0; i < particles.size(); ++i)
   {
-    float this_eta = n.eta();
-    float this_phi = n.phi();
-    float this_E = n.E();
-
-    // look up tower by eta / phi...
-
-    int this_etabin = geomOH->get_etabin(this_eta);
-    int this_phibin = geomOH->get_phibin(this_phi);
-    RawTower *tower = ohcal_towers->getTower(this_etabin, this_phibin);
-    tower->set_energy(this_E);
-
-    if (Verbosity() > 5 || this_E < 0)
+    const Particle &particle = particles[i];
+    if (particle.bin < 0 || static_cast<size_t>(particle.bin) >= nbins || particle.pt <= 0)
+    {
+      continue;
+    }
+    const double weight = (alpha == 0) ? 1 : std::pow(particle.pt, alpha);
+    for (const auto &[ghost, deltaR] : grid.neighbors[particle.bin])
     {
-      std::cout << " SubtractTowersCS::process_event : creating subtracted OH tower for eta / phi = " << this_eta << " / " << this_phi << " ( " << tower->get_binphi() << " , " << this_phibin << " ) , sub. E  = " << this_E << (this_E < 0 ? " -- WARNING: negative E" : "") << std::endl;
+      pairs.emplace_back(weight * deltaR, i, ghost);
     }
   }
+  // ties are ordered by particle and ghost so the result is reproducible
+  std::sort(pairs.begin(), pairs.end());
 
-  // cleanup
-
-  delete backgroundProxies_EM_remaining;
-  delete backgroundProxies_IH_remaining;
-  delete backgroundProxies_OH_remaining;
-
-  if (Verbosity() > 0)
+  // going through the pairs from the closest one, the softer of particle
+  // and ghost gives all its pt to the harder one
+  for (const auto &[distance, i, ghost] : pairs)
   {
-    std::cout << "SubtractTowersCS::process_event: ending with " << emcal_towers->size() << " TOWER_CALIB_CEMC_RETOWER_SUB1CS towers" << std::endl;
-
-    float EM_old_E = 0;
-    float EM_new_E = 0;
+    double &pt = particles[i].pt;
+    double &gpt = ghost_pt[ghost];
+    if (pt <= 0 || gpt <= 0)
     {
-      RawTowerContainer::ConstRange begin_end_EM_1 = towersEM3->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_1.first; rtiter != begin_end_EM_1.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        EM_old_E += tower->get_energy();
-      }
+      continue;
     }
+    if (pt >= gpt)
     {
-      RawTowerContainer::ConstRange begin_end_EM_2 = emcal_towers->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_2.first; rtiter != begin_end_EM_2.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        EM_new_E += tower->get_energy();
-      }
+      pt -= gpt;
+      gpt = 0;
     }
-    std::cout << "SubtractTowersCS::process_event: old / new total E in EM layer = " << EM_old_E << " / " << EM_new_E << std::endl;
-
-    std::cout << "SubtractTowersCS::process_event: ending with " << ihcal_towers->size() << " TOWER_CALIB_HCALIN_SUB1CS towers" << std::endl;
-
-    float IH_old_E = 0;
-    float IH_new_E = 0;
+    else
     {
-      RawTowerContainer::ConstRange begin_end_EM_3 = towersIH3->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_3.first; rtiter != begin_end_EM_3.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        IH_old_E += tower->get_energy();
-      }
+      gpt -= pt;
+      pt = 0;
     }
+  }
+
+  // load subtracted towers into grid, the subtracted particles are massless
+  double E_2 = 0;
+  for (const Particle &particle : particles)
+  {
+    if (particle.pt <= 0)
     {
-      RawTowerContainer::ConstRange begin_end_EM_4 = ihcal_towers->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_4.first; rtiter != begin_end_EM_4.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        IH_new_E += tower->get_energy();
-      }
+      continue;
     }
-    std::cout << "SubtractTowersCS::process_event: old / new total E in IH layer = " << IH_old_E << " / " << IH_new_E << std::endl;
+    const float this_E = particle.pt * cosh(particle.eta);
+    E_2 += this_E;
 
-    std::cout << "SubtractTowersCS::process_event: ending with " << ohcal_towers->size() << " TOWER_CALIB_HCALOUT_SUB1CS towers" << std::endl;
+    RawTower *tower = sub_towers->getTower(particle.tower->get_bineta(), particle.tower->get_binphi());
+    tower->set_energy(this_E);
 
-    float OH_old_E = 0;
-    float OH_new_E = 0;
-    {
-      RawTowerContainer::ConstRange begin_end_EM_5 = towersOH3->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_5.first; rtiter != begin_end_EM_5.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        OH_old_E += tower->get_energy();
-      }
-    }
+    if (Verbosity() > 5)
     {
-      RawTowerContainer::ConstRange begin_end_EM_6 = ohcal_towers->getTowers();
-      for (RawTowerContainer::ConstIterator rtiter = begin_end_EM_6.first; rtiter != begin_end_EM_6.second; ++rtiter)
-      {
-        RawTower *tower = rtiter->second;
-        OH_new_E += tower->get_energy();
-      }
+      std::cout << " SubtractTowersCS::process_event : creating subtracted " << layer << " tower for eta / phi = " << particle.tower->get_bineta() << " / " << particle.tower->get_binphi() << " , sub. E  = " << this_E << std::endl;
     }
-    std::cout << "SubtractTowersCS::process_event: old / new total E in OH layer = " << OH_old_E << " / " << OH_new_E << std::endl;
   }
 
   if (Verbosity() > 0)
   {
-    std::cout << "SubtractTowersCS::process_event: exiting" << std::endl;
+    double E_3 = 0;
+    for (size_t bin = 0; bin < nbins; ++bin)
+    {
+      E_3 += ghost_pt[bin] * cosh(grid.eta[bin]);
+    }
+    std::cout << "SubtractTowersCS::process_event " << layer << " : " << particles.size() << " towers, " << nbins << " background bins, " << pairs.size() << " tower-ghost pairs" << std::endl;
+    std::cout << "SubtractTowersCS::process_event " << layer << " : full event E - background E = " << E_0 << " - " << E_1 << " = " << E_0 - E_1 << ", subtracted E - remaining bkg E = " << E_2 << " - " << E_3 << " = " << E_2 - E_3 << std::endl;
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 int SubtractTowersCS::CreateNode(PHCompositeNode *topNode)
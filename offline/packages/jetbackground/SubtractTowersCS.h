@@ -9,11 +9,19 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/PHThreadPool.h>
+
+#include <array>
 #include <limits>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 // forward declarations
 class PHCompositeNode;
+class RawTowerContainer;
+class RawTowerGeomContainer;
 
 /// \class SubtractTowersCS
 ///
@@ -23,6 +31,13 @@ class PHCompositeNode;
 /// constructs a new set of towers by subtracting the background from
 /// existing raw towers. CS parameters are configurable
 ///
+/// The towers are the particles and the background estimate of every
+/// tower bin the ghosts of the constituent subtraction. The pairs of
+/// particles and ghosts closer than DeltaRmax are found once per
+/// geometry on a grid of DeltaRmax sized cells and reused for all
+/// events, the three calorimeter layers are subtracted in parallel
+/// when more than one thread is requested
+///
 class SubtractTowersCS : public SubsysReco
 {
  public:
@@ -36,13 +51,42 @@ class SubtractTowersCS : public SubsysReco
   void SetAlpha(float alpha) { _alpha = alpha; }
   void SetDeltaRmax(float DeltaRmax) { _DeltaRmax = DeltaRmax; }
 
+  //! number of threads for the three calorimeter layers, 1 subtracts them one after the other
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
+  //! ghost positions and the ghosts within DeltaRmax of every tower bin
+  struct GhostGrid
+  {
+    const RawTowerGeomContainer *geom{nullptr};
+    float DeltaRmax{std::numeric_limits<float>::quiet_NaN()};
+    int phibins{0};
+    std::vector<double> eta;
+    std::vector<double> phi;
+    //! (ghost bin, DeltaR) pairs, indexed by bin = etabin * phibins + phibin
+    std::vector<std::vector<std::pair<int, double>>> neighbors;
+  };
+
   int CreateNode(PHCompositeNode *topNode);
 
+  //! (re)build the ghost grid if the geometry or DeltaRmax changed
+  void FillGhostGrid(GhostGrid &grid, RawTowerGeomContainer *geom) const;
+
+  //! constituent subtraction of one calorimeter layer, fills the towers of sub_towers
+  void SubtractLayer(const std::string &layer, GhostGrid &grid, RawTowerContainer *towers, RawTowerContainer *sub_towers,
+                     RawTowerGeomContainer *geom, const std::vector<float> &background_UE,
+                     float background_v2, float background_Psi2) const;
+
   bool _use_flow_modulation{false};
 
   float _alpha{std::numeric_limits<float>::quiet_NaN()};
   float _DeltaRmax{std::numeric_limits<float>::quiet_NaN()};
+
+  //! one ghost grid per layer (EM, IH, OH)
+  std::array<GhostGrid, 3> m_grids;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
@@ -16,7 +16,7 @@
 /// \brief PHObject to store rho and sigma for calorimeter towers on an event-by-event basis
 ///
 /// This class is a PHObject to store rho and sigma for calorimeter towers on an event-by-event basis
-/// Options for rho calculation are AREA and MULT or NONE
+/// Options for rho calculation are AREA, MULT, GRID or NONE
 
 class TowerRho : public PHObject
 {
@@ -26,7 +26,8 @@ class TowerRho : public PHObject
   {
     NONE = 0,
     AREA = 1,
-    MULT = 2
+    MULT = 2,
+    GRID = 3
   };
 
   ~TowerRho() override{};
@@ -32,9 +32,12 @@ std::string TowerRhov1::get_method_string(TowerRho::Method method)
   case TowerRho::Method::MULT:
     return "MULT";
     break;
+  case TowerRho::Method::GRID:
+    return "GRID";
+    break;
   default:
     std::cout << "ERROR: rho method not recognized" << std::endl;
-    std::cout << "rho method must be 1 (area) or 2 (mult)" << std::endl;
+    std::cout << "rho method must be 1 (area), 2 (mult) or 3 (grid)" << std::endl;
     exit(-1);
   }
   return "NONE";
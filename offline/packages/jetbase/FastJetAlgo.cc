@@ -166,16 +166,39 @@ float FastJetAlgo::calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents
 
 std::vector<fastjet::PseudoJet>
 FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles)
+{
+  return select_pseudojets(particles, make_pseudojets(particles));
+}
+
+std::vector<fastjet::PseudoJet>
+FastJetAlgo::make_pseudojets(std::vector<Jet*>& particles)
 {
   std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(particles.size());
   for (unsigned int ipart = 0; ipart < particles.size(); ++ipart)
+  {
+    pseudojets.emplace_back(particles[ipart]->get_px(),
+                            particles[ipart]->get_py(),
+                            particles[ipart]->get_pz(),
+                            particles[ipart]->get_e());
+    pseudojets.back().set_user_index(ipart);
+  }
+  return pseudojets;
+}
+
+std::vector<fastjet::PseudoJet>
+FastJetAlgo::select_pseudojets(std::vector<Jet*>& particles, const std::vector<fastjet::PseudoJet>& all_pseudojets)
+{
+  std::vector<fastjet::PseudoJet> pseudojets;
+  pseudojets.reserve(all_pseudojets.size());
+  for (const auto& pseudojet : all_pseudojets)
   {
     // fastjet performs strangely with exactly (px,py,pz,E) =
     // (0,0,0,0) inputs, such as placeholder towers or those with
     // zero'd out energy after CS. this catch also in FastJetAlgoSub
 
     // Ignore particles with negative/small energies
-    
+    const int ipart = pseudojet.user_index();
     if (particles[ipart]->get_e() < m_opt.constituent_min_E)
     {
       continue;
@@ -192,15 +215,10 @@ FastJetAlgo::jets_to_pseudojets(std::vector<Jet*>& particles)
                 << " e: " << particles[ipart]->get_e() << std::endl;
       gSystem->Exit(1);
     }
-    fastjet::PseudoJet pseudojet(particles[ipart]->get_px(),
-                                 particles[ipart]->get_py(),
-                                 particles[ipart]->get_pz(),
-                                 particles[ipart]->get_e());
     if (m_opt.use_constituent_min_pt && pseudojet.perp() < m_opt.constituent_min_pt)
     {
       continue;
     }
-    pseudojet.set_user_index(ipart);
     pseudojets.push_back(pseudojet);
   }
   return pseudojets;
@@ -257,6 +275,11 @@ void FastJetAlgo::first_call_init(JetContainer* jetcont)
 }
 
 void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* jetcont)
+{
+  cluster_and_fill(particles, make_pseudojets(particles), jetcont);
+}
+
+void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, const std::vector<fastjet::PseudoJet>& all_pseudojets, JetContainer* jetcont)
 {
   if (m_first_cluster_call)
   {
@@ -273,8 +296,8 @@ void FastJetAlgo::cluster_and_fill(std::vector<Jet*>& particles, JetContainer* j
     std::cout << "   Verbosity>8 #input particles: " << particles.size() << std::endl;
   }
 
-  // translate input jets to input fastjets
-  auto pseudojets = jets_to_pseudojets(particles);
+  // apply the constituent cuts of this algorithm
+  auto pseudojets = select_pseudojets(particles, all_pseudojets);
 
   // if using constituent subtraction, oberve maximum eta and subtract the constituents
   if (m_opt.cs_calc_constsub)
@@ -51,6 +51,17 @@ class FastJetAlgo : public JetAlgo
   std::vector<Jet*> get_jets(std::vector<Jet*> particles) override;
   void cluster_and_fill(std::vector<Jet*>& part_in, JetContainer* jets_out) override;
 
+  // same as above, but starting from pseudojets of all particles made by make_pseudojets,
+  // so several algorithms can share them. The constituent cuts of this algorithm are applied here
+  void cluster_and_fill(std::vector<Jet*>& part_in, const std::vector<fastjet::PseudoJet>& all_pseudojets, JetContainer* jets_out);
+
+  // one pseudojet per particle, without any selection. The user index is the position in particles
+  static std::vector<fastjet::PseudoJet> make_pseudojets(std::vector<Jet*>& particles);
+
+  // the ghosts of area and background calculations come from a random generator which is
+  // shared by all fastjet instances, only algorithms without them can run concurrently
+  bool is_concurrent_safe() const { return !m_opt.calc_area && !m_opt.calc_jetmedbkgdens && !m_opt.cs_calc_constsub; }
+
  private:
   FastJetOptions m_opt{};
   bool m_first_cluster_call{true};
@@ -63,6 +74,7 @@ class FastJetAlgo : public JetAlgo
 
   // Internal processes
   std::vector<fastjet::PseudoJet> jets_to_pseudojets(std::vector<Jet*>& particles);
+  std::vector<fastjet::PseudoJet> select_pseudojets(std::vector<Jet*>& particles, const std::vector<fastjet::PseudoJet>& all_pseudojets);
   std::vector<fastjet::PseudoJet> cluster_jets(std::vector<fastjet::PseudoJet>& constituents);
   std::vector<fastjet::PseudoJet> cluster_area_jets(std::vector<fastjet::PseudoJet>& constituents);
   float calc_rhomeddens(std::vector<fastjet::PseudoJet>& constituents);
@@ -49,6 +49,15 @@ void JetContainerv1::Reset()
   m_RhoMedian = NAN;
 }
 
+void JetContainerv1::Trim()
+{
+  // Reset only clears the jets, they are constructed again in add_jet
+  if (m_njets == 0)
+  {
+    m_clones->Delete();
+  }
+}
+
 Jet* JetContainerv1::add_jet()
 {
   auto jet = (Jet*) m_clones->ConstructedAt(m_njets++, "C");
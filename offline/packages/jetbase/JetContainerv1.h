@@ -14,6 +14,8 @@ class JetContainerv1 : public JetContainer
   explicit JetContainerv1(const JetContainer& jets);
   JetContainerv1& operator=(const JetContainer& jets);
   void Reset() override;
+  //! deletes the cleared jets which Reset keeps for the next event
+  void Trim() override;
   TClonesArray* clone_data() const override
   {
     return (TClonesArray*) m_clones->Clone();
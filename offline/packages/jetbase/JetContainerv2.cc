@@ -0,0 +1,319 @@
+#include "JetContainerv2.h"
+
+#include "JetView.h"
+#include "Jetv2.h"
+
+#include <TClonesArray.h>
+
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <string>
+
+JetContainerv2::~JetContainerv2()
+{
+  delete m_views;
+}
+
+void JetContainerv2::identify(std::ostream& os) const
+{
+  os << "JetContainerv2: size = " << size() << " constituents = " << m_comp.size() << std::endl
+     << "  Contains jets with the following properties:" << std::endl;
+  print_property_types(os);
+  return;
+}
+
+void JetContainerv2::Reset()
+{
+  m_id.clear();
+  m_px.clear();
+  m_py.clear();
+  m_pz.clear();
+  m_e.clear();
+  m_isCalib.clear();
+  m_comp_sorted.clear();
+  m_properties.clear();
+  m_comp.clear();
+  m_comp_offset.assign(1, 0);
+  if (m_views)
+  {
+    m_views->Clear();
+  }
+  m_RhoMedian = NAN;
+}
+
+void JetContainerv2::Trim()
+{
+  // Reset only clears the arrays, their memory is reused in add_jet
+  if (empty())
+  {
+    m_id.shrink_to_fit();
+    m_px.shrink_to_fit();
+    m_py.shrink_to_fit();
+    m_pz.shrink_to_fit();
+    m_e.shrink_to_fit();
+    m_isCalib.shrink_to_fit();
+    m_comp_sorted.shrink_to_fit();
+    m_properties.shrink_to_fit();
+    m_comp.shrink_to_fit();
+    m_comp_offset.shrink_to_fit();
+    if (m_views)
+    {
+      m_views->Delete();
+    }
+  }
+}
+
+TClonesArray* JetContainerv2::clone_data() const
+{
+  auto clones = new TClonesArray("Jetv2", std::max<int>(size(), 1));
+  for (unsigned int ijet = 0; ijet < size(); ++ijet)
+  {
+    auto jet = static_cast<Jetv2*>(clones->ConstructedAt(ijet));
+    jet->set_id(m_id[ijet]);
+    jet->set_px(m_px[ijet]);
+    jet->set_py(m_py[ijet]);
+    jet->set_pz(m_pz[ijet]);
+    jet->set_e(m_e[ijet]);
+    jet->set_isCalib(m_isCalib[ijet]);
+    jet->get_property_vec().assign(m_properties.begin() + ijet * m_psize, m_properties.begin() + (ijet + 1) * m_psize);
+    Jet::TYPE_comp_vec comp(m_comp.begin() + m_comp_offset[ijet], m_comp.begin() + m_comp_offset[ijet + 1]);
+    jet->insert_comp(comp, true);
+    jet->set_comp_sort_flag(m_comp_sorted[ijet]);
+  }
+  return clones;
+}
+
+Jet* JetContainerv2::add_jet()
+{
+  m_id.push_back(~0x0);
+  m_px.push_back(NAN);
+  m_py.push_back(NAN);
+  m_pz.push_back(NAN);
+  m_e.push_back(NAN);
+  m_isCalib.push_back(0);
+  m_comp_sorted.push_back(0);
+  m_properties.resize(m_properties.size() + m_psize, NAN);
+  m_comp_offset.push_back(m_comp.size());
+  return view(size() - 1);
+}
+
+Jet* JetContainerv2::get_jet(unsigned int ijet)
+{
+  if (ijet < size())
+  {
+    return view(ijet);
+  }
+  else
+  {
+    return nullptr;
+  }
+}
+
+Jet* JetContainerv2::get_UncheckedAt(unsigned int index)
+{
+  return view(index);
+}
+
+Jet* JetContainerv2::view(unsigned int index)
+{
+  if (!m_views)
+  {
+    m_views = new TClonesArray("JetView", 50);
+  }
+
+  // views of the jets before index are needed too, for the jet loop
+  for (unsigned int ijet = m_views->GetEntriesFast(); ijet <= index; ++ijet)
+  {
+    static_cast<JetView*>(m_views->ConstructedAt(ijet))->set_jet(this, ijet);
+  }
+  return static_cast<Jet*>(m_views->UncheckedAt(index));
+}
+
+void JetContainerv2::update_views()
+{
+  // after reading, the views can be left from a larger event
+  if (m_views && m_views->GetEntriesFast() > static_cast<int>(size()))
+  {
+    m_views->Clear();
+  }
+  if (!empty())
+  {
+    view(size() - 1);
+  }
+  else if (!m_views)
+  {
+    m_views = new TClonesArray("JetView", 50);
+  }
+}
+
+// ----------------------------------------------------------------------------------------
+//  Constituents
+// ----------------------------------------------------------------------------------------
+
+void JetContainerv2::insert_comp(unsigned int ijet, const Jet::TYPE_comp* first, const Jet::TYPE_comp* last)
+{
+  const auto ncomp = static_cast<unsigned int>(last - first);
+  m_comp.insert(comp_end(ijet), first, last);
+
+  // constituents of the later jets are moved
+  for (auto offset = m_comp_offset.begin() + ijet + 1; offset != m_comp_offset.end(); ++offset)
+  {
+    *offset += ncomp;
+  }
+}
+
+void JetContainerv2::clear_comp(unsigned int ijet)
+{
+  const unsigned int ncomp = m_comp_offset[ijet + 1] - m_comp_offset[ijet];
+  m_comp.erase(comp_begin(ijet), comp_end(ijet));
+  for (auto offset = m_comp_offset.begin() + ijet + 1; offset != m_comp_offset.end(); ++offset)
+  {
+    *offset -= ncomp;
+  }
+}
+
+void JetContainerv2::sort_comp(unsigned int ijet)
+{
+  if (!m_comp_sorted[ijet])
+  {
+    std::sort(comp_begin(ijet), comp_end(ijet), Jetv2::CompareSRC());
+    m_comp_sorted[ijet] = 1;
+  }
+}
+
+// ----------------------------------------------------------------------------------------
+//  Interface for adding, setting, and getting jet properties
+// ----------------------------------------------------------------------------------------
+
+void JetContainerv2::print_jets(std::ostream& os)
+{
+  os << " No. of jets: " << size();
+  if (!std::isnan(m_RhoMedian))
+  {
+    os << " rho median " << m_RhoMedian;
+  }
+  os << std::endl;
+
+  int ijet = 0;
+  for (auto jet : *this)
+  {
+    os << (boost::format("  jet(%2i) : pT(%6.2f)  eta(%6.2f)  phi(%6.2f)") % ijet % jet->get_pt() % jet->get_eta() % jet->get_phi()).str();
+    ++ijet;
+    for (auto prop : m_pindex)
+    {
+      os << (boost::format("  %8s(%6.2f)") % (str_Jet_PROPERTY(prop.first)) % (jet->get_property(prop.second))).str();
+    }
+    os << std::endl;
+  }
+  os << std::endl;
+}
+
+void JetContainerv2::print_property_types(std::ostream& os) const
+{
+  os << " Jet properties in Jet vectors: " << std::endl;
+  int i = 0;
+  for (auto p : m_pindex)
+  {
+    os << " (" << i++ << ") -> " << str_Jet_PROPERTY(p.first) << std::endl;
+  }
+  return;
+}
+
+// Add properties to the jets.
+size_t JetContainerv2::add_property(Jet::PROPERTY prop)
+{
+  auto [iter, is_new] = m_pindex.try_emplace(prop, static_cast<Jet::PROPERTY>(m_psize));
+  if (is_new)
+  {
+    ++m_psize;
+    resize_jet_pvecs(m_psize - 1);
+  }
+  return m_psize;
+}
+
+size_t JetContainerv2::add_property(std::set<Jet::PROPERTY> props)
+{
+  const size_t old_psize = m_psize;
+  for (auto prop : props)
+  {
+    auto [iter, is_new] = m_pindex.try_emplace(prop, static_cast<Jet::PROPERTY>(m_psize));
+    if (is_new)
+    {
+      ++m_psize;
+    }
+  }
+  if (m_psize != old_psize)
+  {
+    resize_jet_pvecs(old_psize);
+  }
+  return m_psize;
+}
+
+// get the index for a given property
+Jet::PROPERTY JetContainerv2::property_index(Jet::PROPERTY prop)
+{
+  if (!has_property(prop))
+  {
+    add_property(prop);
+  }
+  return m_pindex[prop];
+}
+
+Jet::IterJetTCA JetContainerv2::begin()
+{
+  update_views();
+  return Jet::IterJetTCA(m_views);
+}
+
+Jet::IterJetTCA JetContainerv2::end()  // dummy implementation -- don't anticipate that it will ever be checked
+{
+  update_views();
+  auto rval = Jet::IterJetTCA(m_views);
+  rval.index = rval.size;
+  return rval;
+}
+
+void JetContainerv2::resize_jet_pvecs(size_t old_psize)
+{
+  // properties are stored jet by jet, the new ones are added at the end of each jet
+  std::vector<float> properties(size() * m_psize, NAN);
+  for (size_t ijet = 0; ijet < size(); ++ijet)
+  {
+    std::copy(m_properties.begin() + ijet * old_psize, m_properties.begin() + (ijet + 1) * old_psize, properties.begin() + ijet * m_psize);
+  }
+  m_properties.swap(properties);
+  return;
+}
+
+std::string JetContainerv2::str_Jet_PROPERTY(Jet::PROPERTY prop) const
+{
+  switch (prop)
+  {
+  case Jet::PROPERTY::prop_JetCharge:
+    return "JetCharge";
+  case Jet::PROPERTY::prop_BFrac:
+    return "BFrac";
+  case Jet::PROPERTY::prop_SeedD:
+    return "SeedD";
+  case Jet::PROPERTY::prop_SeedItr:
+    return "SeedItr";
+  case Jet::PROPERTY::prop_zg:
+    return "zg";
+  case Jet::PROPERTY::prop_Rg:
+    return "Rg";
+  case Jet::PROPERTY::prop_mu:
+    return "mu";
+  case Jet::PROPERTY::prop_gamma:
+    return "gamma";
+  case Jet::PROPERTY::prop_JetHadronFlavor:
+    return "JetHadronFlavor";
+  case Jet::PROPERTY::prop_JetHadronZT:
+    return "JetHadronZT";
+  case Jet::PROPERTY::prop_area:
+    return "area";
+  default:
+    return "no_property";
+  }
+  return "";
+}
@@ -0,0 +1,179 @@
+#ifndef JETBASE_JETCONTAINERV2_H
+#define JETBASE_JETCONTAINERV2_H
+
+#include "JetContainer.h"
+
+#include "Jet.h"
+
+#include <cmath>
+#include <cstddef>  // for size_t
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+class TClonesArray;
+
+// ---------------------------------------------------------------------------------------
+// JetContainerv2 -- columnar storage of the jets
+// ---------------------------------------------------------------------------------------
+// The id, momentum, energy and properties of all jets are kept in contiguous arrays
+// indexed by the jet position, and the constituents of all jets in one (SRC, index)
+// buffer with per jet offsets. add_jet(), get_jet() and the jet loop return JetView
+// objects, which only point to a position in this container. The views are transient
+// and only made when the jets are accessed, so nothing is allocated per jet when the
+// container is read back.
+//
+// Constituents are appended to the jet most recently added, as the jet algorithms do.
+// Adding constituents to an earlier jet is possible, but moves those of all later jets.
+// ---------------------------------------------------------------------------------------
+class JetContainerv2 : public JetContainer
+{
+  friend class JetView;
+
+ public:
+  JetContainerv2() = default;
+  ~JetContainerv2() override;
+  JetContainerv2(const JetContainerv2&) = delete;
+  JetContainerv2& operator=(const JetContainerv2&) = delete;
+  void identify(std::ostream& os = std::cout) const override;
+  void Reset() override;
+  //! releases the memory of the arrays which Reset keeps for the next event
+  void Trim() override;
+  //! TClonesArray of Jetv2 copies of the jets
+  TClonesArray* clone_data() const override;
+
+  // status of jet contents
+  bool empty() const override { return m_id.empty(); }
+  size_t size() const override { return m_id.size(); }
+
+  // adding/access jets
+  Jet* add_jet() override;                            // Add a new jet and return its view
+  Jet* get_jet(unsigned int index) override;          // Get view of jet at location. nullptr if out of range
+  Jet* get_UncheckedAt(unsigned int index) override;  // Get view of jet at location, no range checking
+
+  // convenience shortcuts of get_{jet,UncheckedAt}
+  inline Jet* operator()(int index) override { return get_jet(index); };          // synonym for get_jet()
+  inline Jet* operator[](int index) override { return get_UncheckedAt(index); };  // get jet, don't check for length
+
+  // ----------------------------------------------------------------------------------------
+  //  Interface for adding properties to jets, and getting the index to those properties
+  //  (same as JetContainerv1)
+  // ----------------------------------------------------------------------------------------
+  std::map<Jet::PROPERTY, Jet::PROPERTY> property_indices() const override { return m_pindex; };
+  bool has_property(Jet::PROPERTY prop) const override { return m_pindex.find(prop) != m_pindex.end(); };
+  size_t size_properties() const override { return m_psize; };
+  size_t add_property(Jet::PROPERTY) override;                             // add property, if not already there, to all jets
+  size_t add_property(std::set<Jet::PROPERTY>) override;                   // same as above, convenience for other code using ::set
+  Jet::PROPERTY property_index(Jet::PROPERTY) override;                    // get the propery index
+  void print_property_types(std::ostream& os = std::cout) const override;  // print the order of properties in jet
+
+  // ---------------------------------------------------------------------------------------
+  //  Loop over jets, as for JetContainerv1:
+  //     for (jet : *jet_containter) { ... }
+  // ---------------------------------------------------------------------------------------
+  Jet::IterJetTCA begin() override;
+  Jet::IterJetTCA end() override;
+
+  // ---------------------------------------------------------------------------------------
+  //  Columnar access, arrays are indexed with the jet position.
+  //  The properties of jet i are [i*size_properties(), (i+1)*size_properties()), and its
+  //  constituents [get_comp_offsets()[i], get_comp_offsets()[i+1]) of get_comp_vec()
+  // ---------------------------------------------------------------------------------------
+  const std::vector<unsigned int>& get_id_vec() const { return m_id; }
+  const std::vector<float>& get_px_vec() const { return m_px; }
+  const std::vector<float>& get_py_vec() const { return m_py; }
+  const std::vector<float>& get_pz_vec() const { return m_pz; }
+  const std::vector<float>& get_e_vec() const { return m_e; }
+  const std::vector<float>& get_property_vec() const { return m_properties; }
+  const Jet::TYPE_comp_vec& get_comp_vec() const { return m_comp; }
+  const std::vector<unsigned int>& get_comp_offsets() const { return m_comp_offset; }
+
+  // -legacy-set-parameters-----------------------------------------------------------------
+  void set_algo(Jet::ALGO algo) override { m_algo = algo; };
+  Jet::ALGO get_algo() const override { return m_algo; };
+
+  void set_par(float par) override { set_jetpar_R(par); }
+  float get_par() const override { return get_jetpar_R(); }
+
+  void set_jetpar_R(float par) override { m_jetpar_R = par; }
+  float get_jetpar_R() const override { return m_jetpar_R; }
+
+  // set access to source identifiers ------------------------------------------
+
+  bool empty_src() const override { return m_src.empty(); }
+  void insert_src(Jet::SRC src) override { m_src.insert(src); }
+
+  ConstSrcIter begin_src() const override { return m_src.begin(); }
+  ConstSrcIter find_src(Jet::SRC src) const override { return m_src.find(src); }
+  ConstSrcIter end_src() const override { return m_src.end(); }
+
+  SrcIter begin_src() override { return m_src.begin(); }
+  SrcIter find_src(Jet::SRC src) override { return m_src.find(src); }
+  SrcIter end_src() override { return m_src.end(); }
+
+  void print_jets(std::ostream&) override;
+
+  void set_rho_median(float _) override { m_RhoMedian = _; };
+  float get_rho_median() const override { return m_RhoMedian; };
+
+ private:
+  std::string str_Jet_PROPERTY(Jet::PROPERTY) const;
+
+  //! view of jet at index, made if needed
+  Jet* view(unsigned int index);
+
+  //! make the views of all jets, so that they can be iterated over
+  void update_views();
+
+  //! constituents of jet ijet
+  Jet::ITER_comp_vec comp_begin(unsigned int ijet) { return m_comp.begin() + m_comp_offset[ijet]; }
+  Jet::ITER_comp_vec comp_end(unsigned int ijet) { return m_comp.begin() + m_comp_offset[ijet + 1]; }
+
+  //! add constituents [first, last) at the end of those of ijet
+  void insert_comp(unsigned int ijet, const Jet::TYPE_comp* first, const Jet::TYPE_comp* last);
+
+  //! remove constituents of ijet
+  void clear_comp(unsigned int ijet);
+
+  //! sort constituents of ijet by source, if not already
+  void sort_comp(unsigned int ijet);
+
+  // columns, one entry per jet
+  std::vector<unsigned int> m_id;
+  std::vector<float> m_px;
+  std::vector<float> m_py;
+  std::vector<float> m_pz;
+  std::vector<float> m_e;
+  std::vector<int> m_isCalib;
+  std::vector<unsigned char> m_comp_sorted;
+
+  // properties of all jets, m_psize per jet
+  std::vector<float> m_properties;
+
+  // constituents of all jets, and offset of each jet constituents (one more entry than jets)
+  Jet::TYPE_comp_vec m_comp;
+  std::vector<unsigned int> m_comp_offset{0};
+
+  // properties contained in all jets
+  std::map<Jet::PROPERTY, Jet::PROPERTY /*really index for vectors in jets*/> m_pindex{};  // indices of properties in each jet
+  size_t m_psize{0};                                                                       // size of p_index
+
+  void resize_jet_pvecs(size_t old_psize);
+
+  // status
+  Jet::ALGO m_algo{Jet::NONE};
+  float m_jetpar_R{0.4};
+
+  std::set<Jet::SRC> m_src;  //< set of sources (clusters, towers, etc)
+
+  float m_RhoMedian{NAN};
+
+  //! views of the jets, not stored
+  TClonesArray* m_views{nullptr};  //!
+
+  ClassDefOverride(JetContainerv2, 1);
+};
+
+#endif
@@ -1,10 +1,12 @@
 
 #include "JetReco.h"
 
+#include "FastJetAlgo.h"
 #include "Jet.h"
 #include "JetAlgo.h"
 #include "JetContainer.h"
 #include "JetContainerv1.h"
+#include "JetContainerv2.h"
 #include "JetInput.h"
 #include "JetMap.h"
 #include "JetMapv1.h"
@@ -22,11 +24,16 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
+#include <TROOT.h>
+
+#include <fastjet/PseudoJet.hh>
+
 #include <boost/format.hpp>
 
 // standard includes
 #include <cstdlib>  // for exit
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <memory>  // for allocator_traits<>::value_type
 #include <vector>
@@ -79,6 +86,12 @@ int JetReco::InitRun(PHCompositeNode *topNode)
     std::cout << "===========================================================================" << std::endl;
   }
 
+  if (m_concurrent)
+  {
+    // jets are added to the TClonesArrays of the containers from several threads
+    ROOT::EnableThreadSafety();
+  }
+
   return CreateNodes(topNode);
 }
 
@@ -108,18 +121,14 @@ int JetReco::process_event(PHCompositeNode *topNode)
   //---------------------------
   // Run the jet reconstruction
   //---------------------------
+  // send the output somewhere on the DST
+  /* if (_fill_JetContainer) { */
+  if (use_jetcon)
+  {
+    FillJetContainers(topNode, inputs);
+  }
   for (unsigned int ialgo = 0; ialgo < _algos.size(); ++ialgo)
   {
-    // send the output somewhere on the DST
-    /* if (_fill_JetContainer) { */
-    if (use_jetcon)
-    {
-      if (Verbosity() > 5)
-      {
-        std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ialgo]) << std::endl;
-      }
-      FillJetContainer(topNode, ialgo, inputs);
-    }
     if (use_jetmap)
     {
       if (Verbosity() > 5)
@@ -240,7 +249,14 @@ int JetReco::CreateNodes(PHCompositeNode *topNode)
       JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_output));
       if (!jetconn)
       {
-        jetconn = new JetContainerv1();
+        if (m_columnar)
+        {
+          jetconn = new JetContainerv2();
+        }
+        else
+        {
+          jetconn = new JetContainerv1();
+        }
         PHIODataNode<PHObject> *JetContainerNode = new PHIODataNode<PHObject>(jetconn, JC_name(_output), "PHObject");
         InputNode->addNode(JetContainerNode);
       }
@@ -284,24 +300,73 @@ void JetReco::FillJetNode(PHCompositeNode *topNode, int ipos, const std::vector<
   return;
 }
 
-void JetReco::FillJetContainer(PHCompositeNode *topNode, int ipos, std::vector<Jet *> &inputs)
+void JetReco::FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs)
 {
-  JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ipos]));
-  if (!jetconn)
+  // look up all containers before clustering, the node tree is only used here
+  std::vector<JetContainer *> jetconns;
+  std::vector<FastJetAlgo *> fastjetalgos;
+  bool any_fastjet = false;
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
   {
-    std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ipos] << std::endl;
-    exit(-1);
+    JetContainer *jetconn = findNode::getClass<JetContainer>(topNode, JC_name(_outputs[ipos]));
+    if (!jetconn)
+    {
+      std::cout << PHWHERE << " ERROR: Can't find JetContainer: " << _outputs[ipos] << std::endl;
+      exit(-1);
+    }
+    jetconns.push_back(jetconn);
+    fastjetalgos.push_back(dynamic_cast<FastJetAlgo *>(_algos[ipos]));
+    any_fastjet |= (fastjetalgos.back() != nullptr);
   }
-  _algos[ipos]->cluster_and_fill(inputs, jetconn);  // fills the jet container with clustered jets
-  for (auto &_input : _inputs)
+
+  // the inputs are converted to pseudojets once and shared by all FastJetAlgos
+  std::vector<fastjet::PseudoJet> pseudojets;
+  if (any_fastjet)
+  {
+    pseudojets = FastJetAlgo::make_pseudojets(inputs);
+  }
+
+  // algorithms using ghosts always run here, in the order they were added,
+  // so they draw the same random numbers as before
+  std::vector<std::future<void>> running;
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
+  {
+    if (Verbosity() > 5)
+    {
+      std::cout << " Verbosity>5:: filling JetContainter for " << JC_name(_outputs[ipos]) << std::endl;
+    }
+    FastJetAlgo *fastjetalgo = fastjetalgos[ipos];
+    if (!fastjetalgo)
+    {
+      _algos[ipos]->cluster_and_fill(inputs, jetconns[ipos]);  // fills the jet container with clustered jets
+    }
+    else if (m_concurrent && fastjetalgo->is_concurrent_safe())
+    {
+      running.push_back(std::async(std::launch::async, [&inputs, &pseudojets, fastjetalgo, jetconn = jetconns[ipos]]()
+                                   { fastjetalgo->cluster_and_fill(inputs, pseudojets, jetconn); }));
+    }
+    else
+    {
+      fastjetalgo->cluster_and_fill(inputs, pseudojets, jetconns[ipos]);
+    }
+  }
+  for (auto &result : running)
   {
-    jetconn->insert_src(_input->get_src());
+    result.get();
   }
 
-  if (Verbosity() > 7)
+  for (unsigned int ipos = 0; ipos < _algos.size(); ++ipos)
   {
-    std::cout << " Verbosity()>7:: jets in container " << _outputs[ipos] << std::endl;
-    jetconn->print_jets();
+    for (auto &_input : _inputs)
+    {
+      jetconns[ipos]->insert_src(_input->get_src());
+    }
+
+    if (Verbosity() > 7)
+    {
+      std::cout << " Verbosity()>7:: jets in container " << _outputs[ipos] << std::endl;
+      jetconns[ipos]->print_jets();
+    }
   }
 
   return;
@@ -54,6 +54,12 @@ class JetReco : public SubsysReco
 
   void set_algo_node(const std::string &algonode) { _algonode = algonode; }
   void set_input_node(const std::string &inputnode) { _inputnode = inputnode; }
+
+  // run the FastJetAlgos which do not use ghosts in parallel threads when filling JetContainers
+  void set_concurrent(bool b) { m_concurrent = b; }
+
+  // store the jets in columnar JetContainerv2 instead of JetContainerv1
+  void set_columnar_container(bool b) { m_columnar = b; }
   /* void set_fill_JetContainer(bool b) { _fill_JetContainer = b; } */
 
   JetAlgo *get_algo(unsigned int which_algo = 0);
@@ -61,7 +67,7 @@ class JetReco : public SubsysReco
  private:
   int CreateNodes(PHCompositeNode *topNode);
   void FillJetNode(PHCompositeNode *topNode, int ialgo, const std::vector<Jet *> &jets);
-  void FillJetContainer(PHCompositeNode *topNode, int ialgo, std::vector<Jet *> &jets);
+  void FillJetContainers(PHCompositeNode *topNode, std::vector<Jet *> &inputs);
 
   std::vector<JetInput *> _inputs;
   std::vector<JetAlgo *> _algos;
@@ -82,6 +88,8 @@ class JetReco : public SubsysReco
   TRANSITION which_fill;  // fill both container and map
   bool use_jetcon;
   bool use_jetmap;
+  bool m_concurrent{false};
+  bool m_columnar{false};
 };
 
 #endif  // JETBASE_JETRECO_H
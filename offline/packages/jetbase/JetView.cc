@@ -0,0 +1,264 @@
+#include "JetView.h"
+
+#include "JetContainerv2.h"
+#include "Jetv2.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <utility>  // for make_pair
+
+void JetView::identify(std::ostream& os) const
+{
+  os << "---Jet view-----------------------" << std::endl;
+  os << "jetid: " << get_id() << " index: " << m_index << std::endl;
+  os << " (px,py,pz,e) =  (" << get_px() << ", " << get_py() << ", ";
+  os << get_pz() << ", " << get_e() << ") GeV" << std::endl;
+
+  os << " Jet Properties:";
+  for (size_t i = 0; i < size_properties(); ++i)
+  {
+    os << " " << get_property(static_cast<Jet::PROPERTY>(i));
+  }
+  os << std::endl;
+
+  os << " Jet Components: " << size_comp() << std::endl;
+  return;
+}
+
+void JetView::Reset()
+{
+  set_id(0xFFFFFFFF);
+  set_px(NAN);
+  set_py(NAN);
+  set_pz(NAN);
+  set_e(NAN);
+  clear_comp();
+  auto first = m_container->m_properties.begin() + m_index * m_container->m_psize;
+  std::fill(first, first + m_container->m_psize, NAN);
+}
+
+int JetView::isValid() const
+{
+  if (get_id() == 0xFFFFFFFF)
+  {
+    return 0;
+  }
+  if (std::isnan(get_px()) || std::isnan(get_py()) || std::isnan(get_pz()) || std::isnan(get_e()))
+  {
+    return 0;
+  }
+  if (size_comp() == 0)
+  {
+    return 0;
+  }
+  return 1;
+}
+
+PHObject* JetView::CloneMe() const
+{
+  auto jet = new Jetv2(size_properties());
+  jet->set_id(get_id());
+  jet->set_px(get_px());
+  jet->set_py(get_py());
+  jet->set_pz(get_pz());
+  jet->set_e(get_e());
+  jet->set_isCalib(m_container->m_isCalib[m_index]);
+  for (size_t i = 0; i < size_properties(); ++i)
+  {
+    jet->set_property(static_cast<Jet::PROPERTY>(i), get_property(static_cast<Jet::PROPERTY>(i)));
+  }
+  Jet::TYPE_comp_vec comp(
+      m_container->m_comp.begin() + m_container->m_comp_offset[m_index],
+      m_container->m_comp.begin() + m_container->m_comp_offset[m_index + 1]);
+  jet->insert_comp(comp, true);
+  jet->set_comp_sort_flag(m_container->m_comp_sorted[m_index]);
+  return jet;
+}
+
+unsigned int JetView::get_id() const { return m_container->m_id[m_index]; }
+void JetView::set_id(unsigned int id) { m_container->m_id[m_index] = id; }
+
+float JetView::get_px() const { return m_container->m_px[m_index]; }
+void JetView::set_px(float px) { m_container->m_px[m_index] = px; }
+
+float JetView::get_py() const { return m_container->m_py[m_index]; }
+void JetView::set_py(float py) { m_container->m_py[m_index] = py; }
+
+float JetView::get_pz() const { return m_container->m_pz[m_index]; }
+void JetView::set_pz(float pz) { m_container->m_pz[m_index] = pz; }
+
+float JetView::get_e() const { return m_container->m_e[m_index]; }
+void JetView::set_e(float e) { m_container->m_e[m_index] = e; }
+
+int JetView::get_isCalib() { return m_container->m_isCalib[m_index]; }
+void JetView::set_isCalib(int calib) { m_container->m_isCalib[m_index] = calib; }
+
+float JetView::get_p() const
+{
+  return std::sqrt(get_px() * get_px() + get_py() * get_py() + get_pz() * get_pz());
+}
+
+float JetView::get_pt() const
+{
+  return std::sqrt(get_px() * get_px() + get_py() * get_py());
+}
+
+float JetView::get_et() const
+{
+  return get_pt() / get_p() * get_e();
+}
+
+float JetView::get_eta() const
+{
+  return std::asinh(get_pz() / get_pt());
+}
+
+float JetView::get_phi() const
+{
+  return std::atan2(get_py(), get_px());
+}
+
+float JetView::get_mass() const
+{
+  // follow CLHEP convention and return negative mass if E^2 - p^2 < 0
+  float mass2 = get_mass2();
+  if (mass2 < 0)
+  {
+    return -1 * std::sqrt(std::fabs(mass2));
+  }
+  return std::sqrt(mass2);
+}
+
+float JetView::get_mass2() const
+{
+  float p2 = get_px() * get_px() + get_py() * get_py() + get_pz() * get_pz();
+  return get_e() * get_e() - p2;
+}
+
+std::vector<float>& JetView::get_property_vec()
+{
+  auto first = m_container->m_properties.begin() + m_index * m_container->m_psize;
+  m_property_copy.assign(first, first + m_container->m_psize);
+  return m_property_copy;
+}
+
+size_t JetView::size_properties() const { return m_container->m_psize; }
+
+float JetView::get_property(Jet::PROPERTY index) const
+{
+  return m_container->m_properties[m_index * m_container->m_psize + static_cast<int>(index)];
+}
+
+void JetView::set_property(Jet::PROPERTY index, float value)
+{
+  m_container->m_properties[m_index * m_container->m_psize + static_cast<int>(index)] = value;
+}
+
+size_t JetView::size_comp() const
+{
+  return m_container->m_comp_offset[m_index + 1] - m_container->m_comp_offset[m_index];
+}
+
+void JetView::clear_comp() { m_container->clear_comp(m_index); }
+
+void JetView::insert_comp(SRC iSRC, unsigned int compid)
+{
+  set_comp_sort_flag(false);
+  insert_comp(iSRC, compid, true);
+}
+
+void JetView::insert_comp(SRC iSRC, unsigned int compid, bool /*skip_flag*/)
+{
+  const Jet::TYPE_comp comp(iSRC, compid);
+  m_container->insert_comp(m_index, &comp, &comp + 1);
+}
+
+// same as above, but add whole vector
+void JetView::insert_comp(Jet::TYPE_comp_vec& added)
+{
+  set_comp_sort_flag(false);
+  insert_comp(added, true);
+}
+
+void JetView::insert_comp(Jet::TYPE_comp_vec& added, bool /*skip_nosort_flag_set*/)
+{
+  m_container->insert_comp(m_index, added.data(), added.data() + added.size());
+}
+
+void JetView::set_comp_sort_flag(bool f) { m_container->m_comp_sorted[m_index] = f; }
+
+void JetView::print_comp(std::ostream& os, bool single_line)
+{
+  for (auto iter = comp_begin(); iter != comp_end(); ++iter)
+  {
+    os << " (" << iter->first << "->" << static_cast<int>(iter->second) << ")";
+    if (!single_line)
+    {
+      os << std::endl;
+    }
+  }
+  if (single_line)
+  {
+    os << std::endl;
+  }
+}
+
+size_t JetView::num_comp(Jet::SRC iSRC)
+{
+  if (iSRC == Jet::SRC::VOID)
+  {
+    return (comp_end() - comp_begin());
+  }
+  return (comp_end(iSRC) - comp_begin(iSRC));
+}
+
+std::vector<Jet::SRC> JetView::comp_src_vec()
+{
+  std::vector<Jet::SRC> vec{};
+  auto iter = comp_begin();
+  auto iter_end = comp_end();
+  while (iter != iter_end)
+  {
+    Jet::SRC src = iter->first;
+    vec.push_back(src);
+    iter = comp_end(src);
+  }
+  return vec;
+}
+
+std::map<Jet::SRC, size_t> JetView::comp_src_sizemap()
+{
+  std::map<Jet::SRC, size_t> sizemap{};
+  auto iter = comp_begin();
+  auto iter_end = comp_end();
+  while (iter != iter_end)
+  {
+    Jet::SRC src = iter->first;
+    auto iter_ub = comp_end(src);
+    sizemap.insert(std::make_pair(src, static_cast<size_t>(iter_ub - iter)));
+    iter = iter_ub;
+  }
+  return sizemap;
+}
+
+Jet::ITER_comp_vec JetView::comp_begin() { return m_container->comp_begin(m_index); }
+Jet::ITER_comp_vec JetView::comp_end() { return m_container->comp_end(m_index); }
+
+Jet::ITER_comp_vec JetView::comp_begin(Jet::SRC iSRC)
+{
+  m_container->sort_comp(m_index);
+  return std::lower_bound(comp_begin(), comp_end(), iSRC, Jetv2::CompareSRC());
+}
+
+Jet::ITER_comp_vec JetView::comp_end(Jet::SRC iSRC)
+{
+  m_container->sort_comp(m_index);
+  return std::upper_bound(comp_begin(), comp_end(), iSRC, Jetv2::CompareSRC());
+}
+
+Jet::TYPE_comp_vec& JetView::get_comp_vec()
+{
+  m_comp_copy.assign(comp_begin(), comp_end());
+  return m_comp_copy;
+}
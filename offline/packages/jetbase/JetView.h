@@ -0,0 +1,110 @@
+#ifndef JETBASE_JETVIEW_H
+#define JETBASE_JETVIEW_H
+
+#include "Jet.h"
+
+#include <cstddef>  // for size_t
+#include <iostream>
+#include <map>
+#include <vector>
+
+class JetContainerv2;
+class PHObject;
+
+/*!
+ * \brief Jet stored in a JetContainerv2
+ *
+ * Only keeps the container and the jet position. All values are read from and written to
+ * the columns of the container. get_property_vec() and get_comp_vec() return copies,
+ * changing them does not change the jet.
+ */
+class JetView : public Jet
+{
+ public:
+  JetView() = default;
+
+  //! point to jet at index of container
+  void set_jet(JetContainerv2* container, unsigned int index)
+  {
+    m_container = container;
+    m_index = index;
+  }
+
+  // PHObject virtual overloads
+
+  void identify(std::ostream& os = std::cout) const override;
+  void Reset() override;
+  int isValid() const override;
+  //! Jetv2 copy of the jet
+  PHObject* CloneMe() const override;
+
+  // jet info
+
+  unsigned int get_id() const override;
+  void set_id(unsigned int id) override;
+
+  float get_px() const override;
+  void set_px(float px) override;
+
+  float get_py() const override;
+  void set_py(float py) override;
+
+  float get_pz() const override;
+  void set_pz(float pz) override;
+
+  float get_e() const override;
+  void set_e(float e) override;
+
+  int get_isCalib() override;
+  void set_isCalib(int calib) override;
+
+  float get_p() const override;
+  float get_pt() const override;
+  float get_et() const override;
+  float get_eta() const override;
+  float get_phi() const override;
+  float get_mass() const override;
+  float get_mass2() const override;
+
+  // Jet properties, sized by the container
+  void resize_properties(size_t /*size*/) override {}
+  std::vector<float>& get_property_vec() override;
+  size_t size_properties() const override;
+
+  float get_property(Jet::PROPERTY index) const override;
+  void set_property(Jet::PROPERTY index, float value) override;
+
+  // Jet components
+  size_t size_comp() const override;
+  void clear_comp() override;
+  void insert_comp(SRC iSRC, unsigned int compid) override;
+  void insert_comp(Jet::SRC, unsigned int compid, bool) override;  // skips setting the sorted flag
+  void insert_comp(TYPE_comp_vec&) override;
+  void insert_comp(TYPE_comp_vec&, bool) override;
+  void set_comp_sort_flag(bool f = false) override;
+
+  void print_comp(std::ostream& os = std::cout, bool single_line = false) override;
+  size_t num_comp(SRC iSRC = Jet::SRC::VOID) override;
+  std::vector<Jet::SRC> comp_src_vec() override;
+  std::map<Jet::SRC, size_t> comp_src_sizemap() override;
+
+  ITER_comp_vec comp_begin() override;
+  ITER_comp_vec comp_begin(Jet::SRC) override;
+  ITER_comp_vec comp_end() override;
+  ITER_comp_vec comp_end(Jet::SRC) override;
+  TYPE_comp_vec& get_comp_vec() override;
+
+  inline void Clear(Option_t* = nullptr) override {}
+
+ private:
+  JetContainerv2* m_container{nullptr};  //!
+  unsigned int m_index{0};               //!
+
+  // copies returned by get_property_vec() and get_comp_vec()
+  std::vector<float> m_property_copy;  //!
+  TYPE_comp_vec m_comp_copy;           //!
+
+  ClassDefOverride(JetView, 1);
+};
+
+#endif  // JETBASE_JETVIEW_H
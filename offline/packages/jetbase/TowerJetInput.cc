@@ -18,6 +18,7 @@
 #include <cassert>
 #include <cmath>  // for asinh, atan2, cos, cosh
 #include <iostream>
+#include <limits>
 #include <map>      // for _Rb_tree_const_iterator
 #include <utility>  // for pair
 #include <vector>
@@ -468,16 +469,20 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       return std::vector<Jet *>();
     }
 
+    // the retowered EMCal uses the EMCal radius for the vertex correction
+    double EMCal_r = std::numeric_limits<double>::quiet_NaN();
+    if (EMCal_geom)
+    {
+      const RawTowerGeomContainer::TowerCenter *EMCal_center = EMCal_geom->get_tower_center(0, 0);
+      assert(EMCal_center);
+      EMCal_r = EMCal_center->r;
+    }
     unsigned int nchannels = towerinfos->size();
     for (unsigned int channel = 0; channel < nchannels; channel++)
     {
       TowerInfo *tower = towerinfos->get_tower_at_channel(channel);
       assert(tower);
 
-      unsigned int calokey = towerinfos->encode_key(channel);
-      int ieta = towerinfos->getTowerEtaBin(calokey);
-      int iphi = towerinfos->getTowerPhiBin(calokey);
-      const RawTowerDefs::keytype key = RawTowerDefs::encode_towerid(geocaloid, ieta, iphi);
       // skip masked towers
       if (tower->get_isHot() || tower->get_isNoCalib() || tower->get_isNotInstr() || tower->get_isBadChi2())
       {
@@ -487,26 +492,19 @@ std::vector<Jet *> TowerJetInput::get_input(PHCompositeNode *topNode)
       {
         continue;
       }
-      RawTowerGeom *tower_geom = geom->get_tower_geometry(key);
-      assert(tower_geom);
+      // geometry by (eta, phi) bin from the dense table, with cos and sin of phi precomputed
+      const RawTowerGeomContainer::TowerCenter *center = geom->get_tower_center(towerinfos, channel);
+      assert(center);
 
-      double r = tower_geom->get_center_radius();
-      if(m_input == Jet::CEMC_TOWER_RETOWER || m_input == Jet::CEMC_TOWERINFO_RETOWER || m_input == Jet::CEMC_TOWER_SUB1 || m_input ==Jet::CEMC_TOWERINFO_SUB1 || m_input == Jet::CEMC_TOWER_SUB1CS)
-      {
-        const RawTowerDefs::keytype EMCal_key = RawTowerDefs::encode_towerid(RawTowerDefs::CalorimeterId::CEMC, 0, 0);
-        RawTowerGeom *EMCal_tower_geom = EMCal_geom->get_tower_geometry(EMCal_key );
-        assert(EMCal_tower_geom);
-        r = EMCal_tower_geom->get_center_radius();
-      }
-      double phi = atan2(tower_geom->get_center_y(), tower_geom->get_center_x());
-      double towereta = tower_geom->get_eta();
+      double r = EMCal_geom ? EMCal_r : center->r;
+      double towereta = center->eta;
       double z0 = sinh(towereta) * r;
       double z = z0 - vtxz;
       double eta = asinh(z / r);  // eta after shift from vertex
       double pt = tower->get_energy() / cosh(eta);
       double e = tower->get_energy();
-      double px = pt * cos(phi);
-      double py = pt * sin(phi);
+      double px = pt * center->cosphi;
+      double py = pt * center->sinphi;
       double pz = pt * sinh(eta);
 
       Jet *jet = new Jetv2();
@@ -7,6 +7,7 @@
 
 #ifndef ONLINE
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <phool/PHThreadPool.h>
 #include <phool/phool.h>
 #include <phool/recoConsts.h>
 #include <ffarawobjects/CaloPacket.h>
@@ -24,6 +25,9 @@
 #include <TGraphErrors.h>
 #include <TSystem.h>
 #include <TDirectory.h>
+#ifndef ONLINE
+#include <TROOT.h>
+#endif
 
 #include <cmath>
 #include <iomanip>
@@ -148,6 +152,7 @@ int MbdEvent::InitRun()
   for (int ifeech = 0; ifeech < MbdDefs::BBC_N_FEECH; ifeech++)
   {
     _mbdsig[ifeech].SetCalib(_mbdcal);
+    _mbdsig[ifeech].SetFastFit(_fastfit);
 
     // Do evt-by-evt pedestal using sample range below
     if ( _calpass==1 || _is_online || _no_sampmax>0 )
@@ -173,6 +178,17 @@ int MbdEvent::InitRun()
     }
   }
 
+#ifndef ONLINE
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    // the histograms, graphs and splines of the signals are used from the worker threads
+    ROOT::EnableThreadSafety();
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    std::cout << "MbdEvent: processing the arms with " << m_threadpool->size() << " threads"
+              << (_fastfit ? "" : " needs SetFastFit(1), processing them serially") << std::endl;
+  }
+#endif
+
   if ( _calpass > 0 )
   {
     _caldir = "results/"; _caldir += _runnum; _caldir += "/";
@@ -581,10 +597,72 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
     return -1001; // stop processing event (negative return values end event processing)
   }
 
-  std::array<Double_t,MbdDefs::MBD_N_FEECH> tdc{0.};
-  tdc.fill( 0. );
+#ifndef ONLINE
+  // the arms have their own packet and no channels in common, the fast fits
+  // do not use the ROOT fitters (which are not reentrant)
+  if (m_threadpool && _fastfit && !_verbose)
+  {
+    m_threadpool->parallel_for(MbdDefs::MBD_N_ARMS, [this](size_t iarm)
+                               { ProcessChannels(iarm * NCHPERPKT, (iarm + 1) * NCHPERPKT); });
+  }
+  else
+#endif
+  {
+    ProcessChannels(0, MbdDefs::BBC_N_FEECH);
+  }
 
-  for (int ifeech = 0; ifeech < MbdDefs::BBC_N_FEECH; ifeech++)
+  // bbcpmts->Reset();
+  //std::cout << "q10 " << bbcpmts->get_tower_at_channel(10)->get_q() << std::endl;
+
+  // Copy to output
+  for (int ipmt = 0; ipmt < MbdDefs::BBC_N_PMT; ipmt++)
+  {
+    bbcpmts->get_pmt(ipmt)->set_pmt(ipmt, m_pmtq[ipmt], m_pmttt[ipmt], m_pmttq[ipmt]);
+  }
+  bbcpmts->set_npmt(MbdDefs::BBC_N_PMT);
+
+  m_evt++;
+
+  // Have uncalibrated charge and time at this pass
+  if ( _calpass == 2 )
+  {
+    for (int ifeech = 0; ifeech<MbdDefs::MBD_N_FEECH; ifeech++)
+    {
+      // determine the trig_samp board by board
+      int type = _mbdgeom->get_type(ifeech);  // 0 = T-channel, 1 = Q-channel
+      int pmtch = _mbdgeom->get_pmt(ifeech);
+
+      // fill the h2_trange histograms
+      if ( type==0 )
+      {
+        int samp_max = _mbdcal->get_sampmax( ifeech );
+
+        h2_trange_raw->Fill( m_adc[ifeech][samp_max], pmtch );
+
+        /*
+        if ( pmtch == 127 )
+        {
+          std::cout << "xxx " << samp_max << "\t" << m_adc[ifeech][samp_max] << std::endl;
+        }
+        */
+
+        TGraphErrors *gsubpulse = _mbdsig[ifeech].GetGraph();
+        Double_t *y = gsubpulse->GetY();
+        h2_trange->Fill( y[samp_max], pmtch );  // fill ped-subtracted tdc
+      }
+    }
+
+    return -1002;
+  }
+
+  return m_evt;
+}
+
+// time and charge of the fee channels [firstch, lastch), whole boards (the
+// charge channels use the time of the time channels on their board)
+void MbdEvent::ProcessChannels(const int firstch, const int lastch)
+{
+  for (int ifeech = firstch; ifeech < lastch; ifeech++)
   {
     int pmtch = _mbdgeom->get_pmt(ifeech);
     int type = _mbdgeom->get_type(ifeech);  // 0 = T-channel, 1 = Q-channel
@@ -592,15 +670,15 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
     // time channel
     if (type == 0)
     {
-      tdc[pmtch] = _mbdsig[ifeech].MBDTDC(_mbdcal->get_sampmax(ifeech));
+      Double_t tdc = _mbdsig[ifeech].MBDTDC(_mbdcal->get_sampmax(ifeech));
 
-      if ( tdc[pmtch] < 40. || std::isnan(tdc[pmtch]) || fabs(_mbdcal->get_tt0(pmtch))>100. )
+      if ( tdc < 40. || std::isnan(tdc) || fabs(_mbdcal->get_tt0(pmtch))>100. )
       {
         m_pmttt[pmtch] = std::numeric_limits<Float_t>::quiet_NaN();  // no hit
       }
       else
       {
-        m_pmttt[pmtch] = _mbdcal->get_tcorr(ifeech,tdc[pmtch]);
+        m_pmttt[pmtch] = _mbdcal->get_tcorr(ifeech,tdc);
 
         // at calpass 2, we use tcorr (uncal_mbd pass). make sure tt_t0 = 0.
         m_pmttt[pmtch] -= _mbdcal->get_tt0(pmtch);
@@ -682,53 +760,6 @@ int MbdEvent::ProcessRawPackets(MbdPmtContainer *bbcpmts)
       m_pmttq[pmtch] = std::numeric_limits<Float_t>::quiet_NaN();
     }
   }
-
-
-  // bbcpmts->Reset();
-  //std::cout << "q10 " << bbcpmts->get_tower_at_channel(10)->get_q() << std::endl;
-
-  // Copy to output
-  for (int ipmt = 0; ipmt < MbdDefs::BBC_N_PMT; ipmt++)
-  {
-    bbcpmts->get_pmt(ipmt)->set_pmt(ipmt, m_pmtq[ipmt], m_pmttt[ipmt], m_pmttq[ipmt]);
-  }
-  bbcpmts->set_npmt(MbdDefs::BBC_N_PMT);
-
-  m_evt++;
-
-  // Have uncalibrated charge and time at this pass
-  if ( _calpass == 2 )
-  {
-    for (int ifeech = 0; ifeech<MbdDefs::MBD_N_FEECH; ifeech++)
-    {
-      // determine the trig_samp board by board
-      int type = _mbdgeom->get_type(ifeech);  // 0 = T-channel, 1 = Q-channel
-      int pmtch = _mbdgeom->get_pmt(ifeech);
-
-      // fill the h2_trange histograms
-      if ( type==0 )
-      {
-        int samp_max = _mbdcal->get_sampmax( ifeech );
-
-        h2_trange_raw->Fill( m_adc[ifeech][samp_max], pmtch );
-
-        /*
-        if ( pmtch == 127 )
-        {
-          std::cout << "xxx " << samp_max << "\t" << m_adc[ifeech][samp_max] << std::endl;
-        }
-        */
-
-        TGraphErrors *gsubpulse = _mbdsig[ifeech].GetGraph();
-        Double_t *y = gsubpulse->GetY();
-        h2_trange->Fill( y[samp_max], pmtch );  // fill ped-subtracted tdc
-      }
-    }
-
-    return -1002;
-  }
-
-  return m_evt;
 }
 
 ///
@@ -870,7 +901,11 @@ int MbdEvent::Calculate(MbdPmtContainer *bbcpmts, MbdOut *bbcout)
       ac->cd(iarm + 1);
     }
 
-    hevt_bbct[iarm]->Fit(gausfit[iarm], "BNQLR");
+    // the fit is only looked at when debugging, m_bbct is the mean of the earliest cluster
+    if (_verbose)
+    {
+      hevt_bbct[iarm]->Fit(gausfit[iarm], "BNQLR");
+    }
 
     // m_bbct[iarm] = m_bbct[iarm] / m_bbcn[iarm];
     //m_bbct[iarm] = gausfit[iarm]->GetParameter(1);  // gaus fit
@@ -11,6 +11,7 @@
 #include <fun4all/Fun4AllBase.h>
 #endif
 
+#include <memory>
 #include <vector>
 
 class PHCompositeNode;
@@ -25,6 +26,7 @@ class TCanvas;
 #ifndef ONLINE
 class CaloPacketContainer;
 class Gl1Packet;
+class PHThreadPool;
 #endif
 
 class MbdEvent
@@ -44,6 +46,12 @@ class MbdEvent
 
   void SetSim(const int s) { _simflag = s; }
 
+  /** pedestal and template fits without ROOT fitting, see MbdSig::SetFastFit */
+  void SetFastFit(const int f) { _fastfit = f; }
+
+  /** threads for the signal processing of the two arms (0 = all cores), needs SetFastFit(1) */
+  void SetNumThreads(const unsigned int n) { m_nthreads = n; }
+
   float get_bbcz() { return m_bbcz; }
   float get_bbczerr() { return m_bbczerr; }
   float get_bbct0() { return m_bbct0; }
@@ -78,6 +86,8 @@ class MbdEvent
  private:
   static const int NCHPERPKT = 128;
 
+  void ProcessChannels(const int firstch, const int lastch);
+
   MbdGeom *_mbdgeom{nullptr};
   MbdCalib *_mbdcal{nullptr};
 
@@ -124,6 +134,11 @@ class MbdEvent
   Float_t m_pmttq[MbdDefs::MBD_N_PMT]{};  // time in each arm
 
   int do_templatefit{1};
+  int _fastfit{0};
+  unsigned int m_nthreads{1};
+#ifndef ONLINE
+  std::unique_ptr<PHThreadPool> m_threadpool;
+#endif
 
   // output data
   Short_t m_bbcn[2]{};                                            // num hits for each arm (north and south)
@@ -57,6 +57,8 @@ int MbdReco::InitRun(PHCompositeNode *topNode)
   int ret = getNodes(topNode);
 
   m_mbdevent->SetSim(_simflag);
+  m_mbdevent->SetFastFit(_fastfit);
+  m_mbdevent->SetNumThreads(_nthreads);
   m_mbdevent->InitRun();
 
   return ret;
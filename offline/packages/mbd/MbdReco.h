@@ -33,12 +33,20 @@ class MbdReco : public SubsysReco
   void SetCalPass(const int calpass) { _calpass = calpass; }
   void SetMbdTrigOnly(const int m) { _mbdonly = m; }
 
+  /** pedestal and template fits without ROOT fitting */
+  void SetFastFit(const int f) { _fastfit = f; }
+
+  /** process the two arms concurrently (0 = all cores), only with SetFastFit(1) */
+  void set_num_threads(const unsigned int n) { _nthreads = n; }
+
  private:
   int createNodes(PHCompositeNode *topNode);
   int getNodes(PHCompositeNode *topNode);
   int _simflag{0};
   int _calpass{0};
   int _mbdonly{0};  // only use mbd triggers
+  int _fastfit{0};
+  unsigned int _nthreads{1};
 
   float m_tres = 0.05;
   std::unique_ptr<TF1> m_gaussian = nullptr;
@@ -13,6 +13,8 @@
 #include <TSpline.h>
 #include <TTree.h>
 
+#include <algorithm>
+#include <cfloat>
 #include <fstream>
 #include <iostream>
 #include <limits>
@@ -498,6 +500,10 @@ void MbdSig::CalcEventPed0_PreSamp(const int presample, const int nsamps)
       PadUpdate();
     }
   }
+  else if ( _fastfit )
+  {
+    FitPed0Fast();
+  }
   else
   {
     //std::cout << PHWHERE << std::endl;
@@ -1047,7 +1053,11 @@ int MbdSig::FitTemplate( const Int_t sampmax )
     std::cout << PHWHERE << " gSubPulse 0" << std::endl;
   }
 
-  if (_verbose == 0)
+  if (_verbose == 0 && _fastfit)
+  {
+    FitTemplateFast();
+  }
+  else if (_verbose == 0)
   {
     //std::cout << PHWHERE << std::endl;
     gSubPulse->Fit(template_fcn, "RNQ");
@@ -1087,7 +1097,7 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   if (_verbose == 0)
   {
     //std::cout << PHWHERE << std::endl;
-    int fit_status = gSubPulse->Fit(template_fcn, "RNQ");
+    int fit_status = _fastfit ? FitTemplateFast() : static_cast<int>(gSubPulse->Fit(template_fcn, "RNQ"));
     if ( fit_status<0 && _verbose )
     {
       std::cout << PHWHERE << "\t" << fit_status << std::endl;
@@ -1132,6 +1142,236 @@ int MbdSig::FitTemplate( const Int_t sampmax )
   return 1;
 }
 
+// Fit of the constant ped_fcn to gRawPulse, the weighted mean of the points in range
+int MbdSig::FitPed0Fast()
+{
+  Double_t xmin, xmax;
+  ped_fcn->GetRange(xmin, xmax);
+
+  Int_t n = gRawPulse->GetN();
+  Double_t *x = gRawPulse->GetX();
+  Double_t *y = gRawPulse->GetY();
+  Double_t *ey = gRawPulse->GetEY();
+
+  Double_t sumw = 0.;
+  Double_t sumwy = 0.;
+  Double_t sumwyy = 0.;
+  int npts = 0;
+  for (int i = 0; i < n; i++)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      continue;
+    }
+    // points without errors count with unit error
+    Double_t w = (ey != nullptr && ey[i] > 0.) ? 1.0 / (ey[i] * ey[i]) : 1.0;
+    sumw += w;
+    sumwy += w * y[i];
+    sumwyy += w * y[i] * y[i];
+    npts++;
+  }
+
+  if (npts == 0)
+  {
+    ped_fcn->SetChisquare(0.);
+    ped_fcn->SetNDF(0);
+    return -1;
+  }
+
+  Double_t mean = sumwy / sumw;
+  ped_fcn->SetParameter(0, mean);
+  ped_fcn->SetChisquare(std::max(0., sumwyy - (sumwy * mean)));
+  ped_fcn->SetNDF(npts - 1);
+
+  return 0;
+}
+
+// Template shape without amplitude, same interpolation and rejections as TemplateFcn
+Double_t MbdSig::TemplateShape(const Double_t x, const Double_t t, bool &reject) const
+{
+  Double_t xx = x - t;
+  reject = false;
+
+  if (xx < template_begintime || xx > template_endtime || std::isnan(xx))
+  {
+    reject = true;
+    if (std::isnan(xx))
+    {
+      return 0.;
+    }
+    if (xx < template_begintime)
+    {
+      return template_y[0];
+    }
+    return template_y[template_npointsx - 1];
+  }
+
+  Double_t step = (template_endtime - template_begintime) / (template_npointsx - 1);
+  Double_t index = (xx - template_begintime) / step;
+
+  int ilow = TMath::FloorNint(index);
+  int ihigh = TMath::CeilNint(index);
+  if (ilow < 0)
+  {
+    ilow = 0;
+  }
+  else if (ihigh >= template_npointsx)
+  {
+    ihigh = template_npointsx - 1;
+  }
+
+  Double_t f = 0.;
+  if (ilow == ihigh)
+  {
+    f = template_y[ilow];
+  }
+  else
+  {
+    Double_t x0 = template_begintime + ilow * step;
+    Double_t y0 = template_y[ilow];
+    Double_t x1 = template_begintime + ihigh * step;
+    Double_t y1 = template_y[ihigh];
+    f = y0 + ((y1 - y0) / (x1 - x0)) * (xx - x0);  // linear interpolation
+  }
+
+  // reject points with very bad rms in shape
+  if (template_yrms[ilow] >= 1.0 || template_yrms[ihigh] >= 1.0)
+  {
+    reject = true;
+  }
+
+  return f;
+}
+
+int MbdSig::TemplateChi2(const Double_t t, Double_t &ampl, Double_t &chi2) const
+{
+  Double_t stt = 0.;
+  Double_t sty = 0.;
+  Double_t syy = 0.;
+  int npts = 0;
+  int n = _fit_x.size();
+  for (int i = 0; i < n; i++)
+  {
+    if (_fit_saturated[i])
+    {
+      continue;
+    }
+    bool reject = false;
+    Double_t f = TemplateShape(_fit_x[i], t, reject);
+    if (reject)
+    {
+      continue;
+    }
+    stt += f * f;
+    sty += f * _fit_y[i];
+    syy += _fit_y[i] * _fit_y[i];
+    npts++;
+  }
+
+  if (stt <= 0.)
+  {
+    ampl = 0.;
+    chi2 = syy;
+    return npts;
+  }
+  ampl = sty / stt;
+  chi2 = std::max(0., syy - ampl * sty);
+  return npts;
+}
+
+// Fit of template_fcn to gSubPulse in its range, starting from its parameters.
+// The amplitude at a given time is a linear fit, the time is scanned around the start
+// value and refined with a parabola through the best scan point and its neighbours.
+int MbdSig::FitTemplateFast()
+{
+  Double_t xmin, xmax;
+  template_fcn->GetRange(xmin, xmax);
+
+  Int_t n = gSubPulse->GetN();
+  Double_t *x = gSubPulse->GetX();
+  Double_t *y = gSubPulse->GetY();
+  Int_t nraw = gRawPulse->GetN();
+  Double_t *rawy = gRawPulse->GetY();
+
+  _fit_x.clear();
+  _fit_y.clear();
+  _fit_saturated.clear();
+  for (int i = 0; i < n; i++)
+  {
+    if (x[i] < xmin || x[i] > xmax)
+    {
+      continue;
+    }
+    // Reject points where ADC saturates
+    int samp_point = static_cast<int>(x[i]);
+    bool saturated = (samp_point >= 0 && samp_point < nraw && rawy[samp_point] > 16370);
+    _fit_x.push_back(x[i]);
+    _fit_y.push_back(y[i]);
+    _fit_saturated.push_back(saturated);
+  }
+
+  const Double_t tstart = template_fcn->GetParameter(1);
+  const Double_t window = 3.0;  // scan range around the start time, in samples
+  const Double_t dt = 0.05;
+  const int nscan = static_cast<int>(2 * window / dt) + 1;
+
+  _scan_chi2.resize(nscan);
+  int best = -1;
+  for (int iscan = 0; iscan < nscan; iscan++)
+  {
+    Double_t ampl = 0.;
+    Double_t chi2 = 0.;
+    if (TemplateChi2(tstart - window + iscan * dt, ampl, chi2) < 3)
+    {
+      chi2 = DBL_MAX;  // not enough points
+    }
+    _scan_chi2[iscan] = chi2;
+    if (chi2 < DBL_MAX && (best < 0 || chi2 < _scan_chi2[best]))
+    {
+      best = iscan;
+    }
+  }
+
+  if (best < 0)
+  {
+    // nothing to fit, parameters are left unchanged
+    return -1;
+  }
+
+  Double_t tbest = tstart - window + best * dt;
+  Double_t best_chi2 = _scan_chi2[best];
+  Double_t prev_chi2 = (best > 0) ? _scan_chi2[best - 1] : DBL_MAX;
+  Double_t next_chi2 = (best < nscan - 1) ? _scan_chi2[best + 1] : DBL_MAX;
+  if (prev_chi2 < DBL_MAX && next_chi2 < DBL_MAX)
+  {
+    Double_t den = prev_chi2 - 2 * best_chi2 + next_chi2;
+    if (den > 0.)
+    {
+      Double_t tref = tbest + 0.5 * dt * (prev_chi2 - next_chi2) / den;
+      Double_t ampl = 0.;
+      Double_t chi2 = 0.;
+      if (TemplateChi2(tref, ampl, chi2) >= 3 && chi2 < best_chi2)
+      {
+        tbest = tref;
+        best_chi2 = chi2;
+      }
+    }
+  }
+
+  Double_t ampl = 0.;
+  Double_t chi2 = 0.;
+  int npts = TemplateChi2(tbest, ampl, chi2);
+  template_fcn->SetParameters(ampl, tbest);
+  if (ped0rms > 0.)
+  {
+    chi2 /= (ped0rms * ped0rms);
+  }
+  template_fcn->SetChisquare(chi2);
+  template_fcn->SetNDF(npts - 2);
+
+  return 0;
+}
+
 int MbdSig::SetTemplate(const std::vector<float>& shape, const std::vector<float>& sherr)
 {
   template_y = shape;
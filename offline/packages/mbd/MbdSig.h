@@ -115,6 +115,9 @@ class MbdSig
   TF1 *GetTemplateFcn() { return template_fcn; }
   void SetMinMaxFitTime(const Double_t mintime, const Double_t maxtime);
 
+  /** Do the pedestal and template fits without ROOT fitting (except in verbose mode) */
+  void SetFastFit(const int f) { _fastfit = f; }
+
   void WritePedHist();
 
   void PadUpdate();
@@ -124,6 +127,18 @@ class MbdSig
  private:
   void Init();
 
+  /** Same as gRawPulse->Fit(ped_fcn,"RNQ"), analytic weighted mean */
+  int FitPed0Fast();
+
+  /** Same as gSubPulse->Fit(template_fcn,"RNQ"), closed form amplitude and scan of the time */
+  int FitTemplateFast();
+
+  /** Template at x for start time t, reject is set for points the fit has to skip */
+  Double_t TemplateShape(const Double_t x, const Double_t t, bool &reject) const;
+
+  /** chi2 of the best amplitude for start time t, returns the number of points used */
+  int TemplateChi2(const Double_t t, Double_t &ampl, Double_t &chi2) const;
+
   int _ch;
   int _nsamples;
   int _status{0};
@@ -188,6 +203,12 @@ class MbdSig
   Double_t fit_min_time{};  //! min time for fit, in original units of waveform data
   Double_t fit_max_time{};  //! max time for fit, in original units of waveform data
 
+  int _fastfit{0};
+  std::vector<Double_t> _fit_x;        //! points in the range of the fast template fit
+  std::vector<Double_t> _fit_y;        //!
+  std::vector<char> _fit_saturated;    //!
+  std::vector<Double_t> _scan_chi2;    //!
+
   int _verbose{0};
 };
 
@@ -0,0 +1,83 @@
+// cases for the calorimeter waveform fits, the template fits need --calotemplate=file
+
+#include "MicroBenchmark.h"
+
+#include <caloreco/CaloWaveformFitting.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+  constexpr unsigned int seed = 12345;
+
+  // one packet worth of channels
+  constexpr size_t nchannels = 192;
+  constexpr int nsamples = 12;
+
+  //! pulses on a pedestal with noise, the peak is around sample 6
+  std::vector<std::vector<float>> waveforms()
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> amplitude(20, 3000);
+    std::uniform_real_distribution<float> peaktime(5, 7);
+    std::normal_distribution<float> noise(0, 3);
+    std::vector<std::vector<float>> channels;
+    for (size_t ich = 0; ich < nchannels; ++ich)
+    {
+      const float amp = amplitude(rng);
+      const float t0 = peaktime(rng) - 2;
+      std::vector<float> v;
+      for (int i = 0; i < nsamples; ++i)
+      {
+        const float t = (i - t0) / 2;
+        v.push_back(1500 + noise(rng) + (t > 0 ? amp * t * t * std::exp(2 - 2 * t) : 0));
+      }
+      channels.push_back(v);
+    }
+    return channels;
+  }
+
+  void template_fit(MicroBenchmark::State &state, const bool fast)
+  {
+    if (MicroBenchmark::Option("calotemplate").empty())
+    {
+      state.SkipWithMessage("no --calotemplate given");
+      return;
+    }
+    CaloWaveformFitting fitter;
+    fitter.set_fastTemplateFit(fast);
+    fitter.initialize_processing(MicroBenchmark::Option("calotemplate"));
+    const auto channels = waveforms();
+    while (state.KeepRunning())
+    {
+      MicroBenchmark::DoNotOptimize(fitter.process_waveform(channels));
+    }
+    state.SetItemsProcessed(nchannels);
+  }
+}  // namespace
+
+void BM_CaloWaveformFittingFast(MicroBenchmark::State &state)
+{
+  CaloWaveformFitting fitter;
+  const auto channels = waveforms();
+  while (state.KeepRunning())
+  {
+    MicroBenchmark::DoNotOptimize(fitter.calo_processing_fast(channels));
+  }
+  state.SetItemsProcessed(nchannels);
+}
+MICROBENCHMARK(BM_CaloWaveformFittingFast);
+
+void BM_CaloWaveformFittingTemplate(MicroBenchmark::State &state)
+{
+  template_fit(state, false);
+}
+MICROBENCHMARK(BM_CaloWaveformFittingTemplate);
+
+void BM_CaloWaveformFittingTemplateFast(MicroBenchmark::State &state)
+{
+  template_fit(state, true);
+}
+MICROBENCHMARK(BM_CaloWaveformFittingTemplateFast);
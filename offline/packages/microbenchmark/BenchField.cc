@@ -0,0 +1,90 @@
+// cases for the field map interpolation, the map is given with --fieldmap=file
+
+#include "MicroBenchmark.h"
+
+#include <phfield/PHField3DCartesian.h>
+
+#include <Geant4/G4SystemOfUnits.hh>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+  constexpr unsigned int seed = 12345;
+  constexpr size_t npoints = 4096;
+
+  //! the map is read once, for all cases
+  const PHField3DCartesian *fieldmap()
+  {
+    static std::unique_ptr<PHField3DCartesian> field;
+    if (!field && !MicroBenchmark::Option("fieldmap").empty())
+    {
+      field = std::make_unique<PHField3DCartesian>(MicroBenchmark::Option("fieldmap"));
+    }
+    return field.get();
+  }
+
+  //! x, y, z, t quadruplets inside the tracking volume
+  std::vector<double> field_points()
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> rdist(2, 80);
+    std::uniform_real_distribution<double> phidist(-M_PI, M_PI);
+    std::uniform_real_distribution<double> zdist(-105, 105);
+    std::vector<double> points;
+    points.reserve(4 * npoints);
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      const double r = rdist(rng) * cm;
+      const double phi = phidist(rng);
+      points.insert(points.end(), {r * std::cos(phi), r * std::sin(phi), zdist(rng) * cm, 0});
+    }
+    return points;
+  }
+}  // namespace
+
+void BM_PHField3DCartesianGetFieldValue(MicroBenchmark::State &state)
+{
+  const PHField3DCartesian *field = fieldmap();
+  if (!field)
+  {
+    state.SkipWithMessage("no --fieldmap given");
+    return;
+  }
+  const auto points = field_points();
+  while (state.KeepRunning())
+  {
+    double sum = 0;
+    double bfield[3];
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      field->GetFieldValue(&points[4 * i], bfield);
+      sum += bfield[2];
+    }
+    MicroBenchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(npoints);
+}
+MICROBENCHMARK(BM_PHField3DCartesianGetFieldValue);
+
+void BM_PHField3DCartesianGetFieldValues(MicroBenchmark::State &state)
+{
+  const PHField3DCartesian *field = fieldmap();
+  if (!field)
+  {
+    state.SkipWithMessage("no --fieldmap given");
+    return;
+  }
+  const auto points = field_points();
+  std::vector<double> bfields(3 * npoints);
+  while (state.KeepRunning())
+  {
+    field->GetFieldValues(points.data(), bfields.data(), npoints);
+    MicroBenchmark::DoNotOptimize(bfields.data());
+  }
+  state.SetItemsProcessed(npoints);
+}
+MICROBENCHMARK(BM_PHField3DCartesianGetFieldValues);
@@ -0,0 +1,86 @@
+// cases for the raw data decoding: TPC FEE packet crc and MVTX ALPIDE lane decoding
+
+#include "MicroBenchmark.h"
+
+#include <fun4allraw/TpcTimeFrameBuilder.h>
+
+#include <mvtx_decoder/GBTLink.h>
+#include <mvtx_decoder/PayLoadCont.h>
+
+#include <cstdint>
+#include <deque>
+#include <random>
+
+namespace
+{
+  constexpr unsigned int seed = 12345;
+}
+
+void BM_TpcTimeFrameBuilderCrc16(MicroBenchmark::State &state)
+{
+  // a full size FEE packet: header and 10 bit ADC words
+  std::mt19937 rng(seed);
+  std::deque<uint16_t> packet;
+  constexpr uint16_t length = 1024;
+  for (uint16_t i = 0; i <= length; ++i)
+  {
+    packet.push_back(rng() & 0x3ffU);
+  }
+  while (state.KeepRunning())
+  {
+    MicroBenchmark::DoNotOptimize(TpcTimeFrameBuilder::crc16_parity(packet, length));
+  }
+  state.SetItemsProcessed(length);
+  state.SetBytesProcessed(length * sizeof(uint16_t));
+}
+MICROBENCHMARK(BM_TpcTimeFrameBuilderCrc16);
+
+void BM_MvtxGBTLinkDecodeLane(MicroBenchmark::State &state)
+{
+  // one chip: header, 32 regions with 8 data shorts and 2 data longs each, trailer
+  std::mt19937 rng(seed);
+  constexpr uint8_t chipid = 0;
+  mvtx::PayLoadCont buffer;
+  buffer.add(static_cast<uint8_t>(0xA0U | chipid));
+  buffer.add(static_cast<uint8_t>(0x10U));
+  uint64_t nhits = 0;
+  for (uint8_t region = 0; region < 32; ++region)
+  {
+    buffer.add(static_cast<uint8_t>(0xC0U | region));
+    for (int i = 0; i < 10; ++i)
+    {
+      const uint16_t addr = rng() & 0x3fffU;
+      if (i < 8)
+      {
+        buffer.add(static_cast<uint8_t>(0x40U | (addr >> 8U)));
+        buffer.add(static_cast<uint8_t>(addr & 0xffU));
+        ++nhits;
+      }
+      else
+      {
+        // address and a hit map of the following 7 pixels
+        const uint8_t hitmap = rng() & 0x7fU;
+        buffer.add(static_cast<uint8_t>(addr >> 8U));
+        buffer.add(static_cast<uint8_t>(addr & 0xffU));
+        buffer.add(hitmap);
+        nhits += 1 + __builtin_popcount(hitmap);
+      }
+    }
+  }
+  buffer.add(static_cast<uint8_t>(0xB0U));
+
+  mvtx::GBTLink link(0, 0);
+  link.mTrgData.emplace_back(0, 0);
+  while (state.KeepRunning())
+  {
+    link.decode_lane(chipid, buffer);
+    MicroBenchmark::DoNotOptimize(link.mTrgData.back().hit_vector.size());
+    state.PauseTiming();
+    link.mTrgData.back().clear();
+    buffer.rewind();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(nhits);
+  state.SetBytesProcessed(buffer.getSize());
+}
+MICROBENCHMARK(BM_MvtxGBTLinkDecodeLane);
@@ -0,0 +1,128 @@
+// cases for the TPC distortion correction
+
+#include "MicroBenchmark.h"
+
+#include <tpc/TpcDistortionCorrection.h>
+#include <tpc/TpcDistortionCorrectionContainer.h>
+
+#include <TH3.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+  constexpr unsigned int seed = 12345;
+  constexpr size_t npoints = 4096;
+
+  //! smooth synthetic corrections with the binning of the static distortion maps
+  class DistortionMaps
+  {
+   public:
+    DistortionMaps()
+    {
+      TH1::AddDirectory(false);
+      for (int side = 0; side < 2; ++side)
+      {
+        const double zmin = side ? 0 : -105.5;
+        const double zmax = side ? 105.5 : 0;
+        const std::array<std::array<TH1 *, 2> *, 3> targets = {{&container.m_hDPint, &container.m_hDRint, &container.m_hDZint}};
+        for (size_t i = 0; i < targets.size(); ++i)
+        {
+          auto h = std::make_unique<TH3F>(Form("h%zu_%i", i, side), "", 82, -2 * M_PI / 80, 2 * M_PI * 81 / 80, 56, 20, 78, 42, zmin, zmax);
+          for (int ix = 0; ix <= h->GetNbinsX() + 1; ++ix)
+          {
+            for (int iy = 0; iy <= h->GetNbinsY() + 1; ++iy)
+            {
+              for (int iz = 0; iz <= h->GetNbinsZ() + 1; ++iz)
+              {
+                const double phi = h->GetXaxis()->GetBinCenter(ix);
+                const double r = h->GetYaxis()->GetBinCenter(iy);
+                const double z = h->GetZaxis()->GetBinCenter(iz);
+                h->SetBinContent(ix, iy, iz, 1e-3 * (i + 1) * std::sin(3 * phi) * (78 - r) * (1 - std::abs(z) / 105.5));
+              }
+            }
+          }
+          (*targets[i])[side] = h.get();
+          histograms.push_back(std::move(h));
+        }
+      }
+      container.m_dimensions = 3;
+    }
+
+    TpcDistortionCorrectionContainer container;
+    std::vector<std::unique_ptr<TH1>> histograms;
+  };
+
+  std::vector<Acts::Vector3> tpc_points()
+  {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> rdist(30, 76);
+    std::uniform_real_distribution<double> phidist(-M_PI, M_PI);
+    std::uniform_real_distribution<double> zdist(-100, 100);
+    std::vector<Acts::Vector3> points;
+    points.reserve(npoints);
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      const double r = rdist(rng);
+      const double phi = phidist(rng);
+      points.emplace_back(r * std::cos(phi), r * std::sin(phi), zdist(rng));
+    }
+    return points;
+  }
+
+  void corrected_position(MicroBenchmark::State &state, const bool packed)
+  {
+    DistortionMaps maps;
+    if (packed)
+    {
+      maps.container.pack();
+    }
+    const TpcDistortionCorrection correction;
+    const auto points = tpc_points();
+    while (state.KeepRunning())
+    {
+      double sum = 0;
+      for (const auto &point : points)
+      {
+        sum += correction.get_corrected_position(point, &maps.container).z();
+      }
+      MicroBenchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(npoints);
+  }
+}  // namespace
+
+void BM_TpcDistortionCorrection(MicroBenchmark::State &state)
+{
+  corrected_position(state, true);
+}
+MICROBENCHMARK(BM_TpcDistortionCorrection);
+
+// reference, interpolation in the histograms
+void BM_TpcDistortionCorrectionHistograms(MicroBenchmark::State &state)
+{
+  corrected_position(state, false);
+}
+MICROBENCHMARK(BM_TpcDistortionCorrectionHistograms);
+
+void BM_TpcDistortionCorrectionBatch(MicroBenchmark::State &state)
+{
+  DistortionMaps maps;
+  maps.container.pack();
+  const TpcDistortionCorrection correction;
+  const auto points = tpc_points();
+  std::vector<Acts::Vector3> work;
+  while (state.KeepRunning())
+  {
+    state.PauseTiming();
+    work = points;
+    state.ResumeTiming();
+    correction.get_corrected_positions(work, &maps.container);
+    MicroBenchmark::DoNotOptimize(work.data());
+  }
+  state.SetItemsProcessed(npoints);
+}
+MICROBENCHMARK(BM_TpcDistortionCorrectionBatch);
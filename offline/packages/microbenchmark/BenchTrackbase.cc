@@ -0,0 +1,215 @@
+// cases for the track base kernels: key encoding, cluster error parametrization and circle fits
+
+#include "MicroBenchmark.h"
+
+#include <trackbase/ClusterErrorPara.h>
+#include <trackbase/MvtxDefs.h>
+#include <trackbase/TpcDefs.h>
+#include <trackbase/TrackFitUtils.h>
+#include <trackbase/TrkrClusterv5.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // fixed seed, all runs see the same inputs
+  constexpr unsigned int seed = 12345;
+  constexpr size_t nkeys = 4096;
+
+  std::vector<TrkrDefs::cluskey> tpc_keys()
+  {
+    std::mt19937 rng(seed);
+    std::vector<TrkrDefs::cluskey> keys;
+    keys.reserve(nkeys);
+    for (size_t i = 0; i < nkeys; ++i)
+    {
+      keys.push_back(TpcDefs::genClusKey(7 + rng() % 48, rng() % 12, rng() % 2, rng() % 100000));
+    }
+    return keys;
+  }
+
+  // points on an arc of radius r through the origin, with gaussian scatter
+  void make_arc(std::mt19937 &rng, const double r, const size_t npoints, std::vector<double> &x, std::vector<double> &y)
+  {
+    std::normal_distribution<double> smear(0, 0.01);
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      const double radius = 3 + 75. * i / npoints;
+      const double phi = std::asin(radius / (2 * r));
+      x.push_back(radius * std::cos(phi) + smear(rng));
+      y.push_back(radius * std::sin(phi) + smear(rng));
+    }
+  }
+}  // namespace
+
+void BM_TrkrDefsGenClusKey(MicroBenchmark::State &state)
+{
+  std::mt19937 rng(seed);
+  std::vector<uint8_t> layers;
+  std::vector<uint8_t> sectors;
+  std::vector<uint32_t> indexes;
+  for (size_t i = 0; i < nkeys; ++i)
+  {
+    layers.push_back(7 + rng() % 48);
+    sectors.push_back(rng() % 12);
+    indexes.push_back(rng() % 100000);
+  }
+  std::vector<TrkrDefs::cluskey> keys(nkeys);
+  while (state.KeepRunning())
+  {
+    for (size_t i = 0; i < nkeys; ++i)
+    {
+      keys[i] = TpcDefs::genClusKey(layers[i], sectors[i], i & 1U, indexes[i]);
+    }
+    MicroBenchmark::DoNotOptimize(keys.data());
+    MicroBenchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(nkeys);
+}
+MICROBENCHMARK(BM_TrkrDefsGenClusKey);
+
+void BM_TrkrDefsDecode(MicroBenchmark::State &state)
+{
+  const auto keys = tpc_keys();
+  while (state.KeepRunning())
+  {
+    unsigned int sum = 0;
+    for (const auto key : keys)
+    {
+      sum += TrkrDefs::getTrkrId(key) + TrkrDefs::getLayer(key) + TrkrDefs::getClusIndex(key) +
+             TpcDefs::getSectorId(key) + TpcDefs::getSide(key);
+    }
+    MicroBenchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(nkeys);
+}
+MICROBENCHMARK(BM_TrkrDefsDecode);
+
+void BM_TrkrDefsDecodeArray(MicroBenchmark::State &state)
+{
+  const auto keys = tpc_keys();
+  std::vector<uint8_t> layers(nkeys);
+  std::vector<uint8_t> sectors(nkeys);
+  while (state.KeepRunning())
+  {
+    TrkrDefs::getLayer(keys.data(), nkeys, layers.data());
+    TpcDefs::getSectorId(keys.data(), nkeys, sectors.data());
+    MicroBenchmark::DoNotOptimize(layers.data());
+    MicroBenchmark::DoNotOptimize(sectors.data());
+    MicroBenchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(nkeys);
+}
+MICROBENCHMARK(BM_TrkrDefsDecodeArray);
+
+namespace
+{
+  void cluster_error_tpc(MicroBenchmark::State &state, const bool use_tf1)
+  {
+    ClusterErrorPara errors(use_tf1);
+    std::mt19937 rng(seed);
+    const auto keys = tpc_keys();
+    std::vector<TrkrClusterv5> clusters(nkeys);
+    for (auto &cluster : clusters)
+    {
+      cluster.setPhiSize(1 + rng() % 6);
+      cluster.setZSize(1 + rng() % 8);
+      cluster.setMaxAdc(50 + rng() % 500);
+      cluster.setEdge(rng() % 20 == 0);
+      cluster.setOverlap(rng() % 10 == 0);
+    }
+    while (state.KeepRunning())
+    {
+      double sum = 0;
+      for (size_t i = 0; i < nkeys; ++i)
+      {
+        const double r = 30 + TrkrDefs::getLayer(keys[i]) - 7;
+        const auto error = errors.get_cluster_error(&clusters[i], r, keys[i], 0.002, 0.3);
+        sum += error.first + error.second;
+      }
+      MicroBenchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(nkeys);
+  }
+}  // namespace
+
+void BM_ClusterErrorParaTpc(MicroBenchmark::State &state)
+{
+  cluster_error_tpc(state, false);
+}
+MICROBENCHMARK(BM_ClusterErrorParaTpc);
+
+// reference, evaluation through the TF1s
+void BM_ClusterErrorParaTpcTF1(MicroBenchmark::State &state)
+{
+  cluster_error_tpc(state, true);
+}
+MICROBENCHMARK(BM_ClusterErrorParaTpcTF1);
+
+void BM_ClusterErrorParaSilicon(MicroBenchmark::State &state)
+{
+  ClusterErrorPara errors;
+  std::mt19937 rng(seed);
+  std::vector<TrkrDefs::cluskey> keys;
+  std::vector<TrkrClusterv5> clusters(nkeys);
+  for (auto &cluster : clusters)
+  {
+    keys.push_back(MvtxDefs::genClusKey(rng() % 3, rng() % 20, rng() % 9, 0, rng() % 1000));
+    cluster.setPhiSize(1 + rng() % 4);
+    cluster.setZSize(1 + rng() % 4);
+  }
+  while (state.KeepRunning())
+  {
+    double sum = 0;
+    for (size_t i = 0; i < nkeys; ++i)
+    {
+      const auto error = errors.get_si_cluster_error(&clusters[i], keys[i]);
+      sum += error.first + error.second;
+    }
+    MicroBenchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(nkeys);
+}
+MICROBENCHMARK(BM_ClusterErrorParaSilicon);
+
+void BM_TrackFitUtilsCircleFit(MicroBenchmark::State &state)
+{
+  // one TPC seed
+  std::mt19937 rng(seed);
+  std::vector<double> x;
+  std::vector<double> y;
+  make_arc(rng, 150, 48, x, y);
+  while (state.KeepRunning())
+  {
+    MicroBenchmark::DoNotOptimize(TrackFitUtils::circle_fit_by_taubin(x.data(), y.data(), x.size()));
+  }
+  state.SetItemsProcessed(1);
+}
+MICROBENCHMARK(BM_TrackFitUtilsCircleFit);
+
+void BM_TrackFitUtilsCircleFitBatch(MicroBenchmark::State &state)
+{
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<double> radius(50, 2000);
+  std::vector<double> x;
+  std::vector<double> y;
+  std::vector<size_t> offsets = {0};
+  constexpr size_t nseeds = 256;
+  for (size_t i = 0; i < nseeds; ++i)
+  {
+    make_arc(rng, radius(rng), 48, x, y);
+    offsets.push_back(x.size());
+  }
+  std::vector<TrackFitUtils::circle_fit_output_t> output;
+  while (state.KeepRunning())
+  {
+    TrackFitUtils::circle_fit_by_taubin(x, y, offsets, output);
+    MicroBenchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(nseeds);
+}
+MICROBENCHMARK(BM_TrackFitUtilsCircleFitBatch);
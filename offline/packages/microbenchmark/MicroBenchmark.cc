@@ -0,0 +1,222 @@
+#include "MicroBenchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  // function local statics, the cases register during static initialization of other files
+  std::vector<std::pair<std::string, MicroBenchmark::Function>> &registry()
+  {
+    static std::vector<std::pair<std::string, MicroBenchmark::Function>> cases;
+    return cases;
+  }
+
+  std::map<std::string, std::string> &options()
+  {
+    static std::map<std::string, std::string> opts;
+    return opts;
+  }
+
+  class Result
+  {
+   public:
+    std::string name;
+    std::string skipped;
+    uint64_t iterations = 0;
+
+    // ns per iteration over the repetitions
+    double median = 0;
+    double min = 0;
+    double stddev = 0;
+
+    // per second
+    double items = 0;
+    double bytes = 0;
+  };
+
+  double option_value(const std::string &name, const double defaultval)
+  {
+    const std::string &value = MicroBenchmark::Option(name);
+    return value.empty() ? defaultval : std::stod(value);
+  }
+
+  Result run_case(const std::string &name, const MicroBenchmark::Function &function, const double min_time, const unsigned int repetitions)
+  {
+    Result result;
+    result.name = name;
+
+    // grow the number of iterations until one run is long enough
+    uint64_t niter = 1;
+    static constexpr uint64_t max_iterations = 1000000000;
+    while (true)
+    {
+      MicroBenchmark::State state(niter);
+      function(state);
+      if (!state.skipped().empty())
+      {
+        result.skipped = state.skipped();
+        return result;
+      }
+      if (state.elapsed() >= min_time || niter >= max_iterations)
+      {
+        break;
+      }
+      const double factor = state.elapsed() > 0 ? 1.4 * min_time / state.elapsed() : 10.;
+      niter = std::min(max_iterations, static_cast<uint64_t>(std::ceil(niter * std::clamp(factor, 2., 10.))));
+    }
+
+    std::vector<double> times;
+    uint64_t items = 0;
+    uint64_t bytes = 0;
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      MicroBenchmark::State state(niter);
+      function(state);
+      times.push_back(1e9 * state.elapsed() / niter);
+      items = state.items();
+      bytes = state.bytes();
+    }
+    std::sort(times.begin(), times.end());
+    double mean = 0;
+    for (const double t : times)
+    {
+      mean += t;
+    }
+    mean /= times.size();
+    double var = 0;
+    for (const double t : times)
+    {
+      var += (t - mean) * (t - mean);
+    }
+    result.iterations = niter;
+    result.median = times.size() % 2 ? times[times.size() / 2] : 0.5 * (times[times.size() / 2 - 1] + times[times.size() / 2]);
+    result.min = times.front();
+    result.stddev = times.size() > 1 ? std::sqrt(var / (times.size() - 1)) : 0;
+    if (result.median > 0)
+    {
+      result.items = 1e9 * items / result.median;
+      result.bytes = 1e9 * bytes / result.median;
+    }
+    return result;
+  }
+
+  void print_usage(const char *program)
+  {
+    std::cout << "usage: " << program << " [--filter=regex] [--min_time=seconds] [--repetitions=n] [--json=file] [--list]" << std::endl;
+    std::cout << "       other --name=value options are passed to the cases (e.g. input files)" << std::endl;
+  }
+}  // namespace
+
+int MicroBenchmark::Register(const std::string &name, Function function)
+{
+  registry().emplace_back(name, std::move(function));
+  return static_cast<int>(registry().size());
+}
+
+const std::string &MicroBenchmark::Option(const std::string &name)
+{
+  static const std::string empty;
+  const auto iter = options().find(name);
+  return iter == options().end() ? empty : iter->second;
+}
+
+int MicroBenchmark::RunAll(int argc, char **argv)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    if (arg == "--help" || arg.rfind("--", 0) != 0)
+    {
+      print_usage(argv[0]);
+      return arg == "--help" ? 0 : 1;
+    }
+    const auto pos = arg.find('=');
+    options()[arg.substr(2, pos == std::string::npos ? std::string::npos : pos - 2)] =
+        pos == std::string::npos ? "1" : arg.substr(pos + 1);
+  }
+
+  auto cases = registry();
+  std::sort(cases.begin(), cases.end(), [](const auto &a, const auto &b)
+            { return a.first < b.first; });
+  const std::regex filter(Option("filter").empty() ? std::string(".*") : Option("filter"));
+  if (!Option("list").empty())
+  {
+    for (const auto &[name, function] : cases)
+    {
+      if (std::regex_search(name, filter))
+      {
+        std::cout << name << std::endl;
+      }
+    }
+    return 0;
+  }
+
+  const double min_time = option_value("min_time", 0.5);
+  const unsigned int repetitions = std::max(1, static_cast<int>(option_value("repetitions", 5)));
+
+  std::vector<Result> results;
+  std::cout << std::left << std::setw(48) << "case" << std::right
+            << std::setw(14) << "ns/iter" << std::setw(14) << "min ns" << std::setw(10) << "stddev"
+            << std::setw(14) << "iterations" << std::setw(16) << "items/s" << std::setw(16) << "MB/s" << std::endl;
+  for (const auto &[name, function] : cases)
+  {
+    if (!std::regex_search(name, filter))
+    {
+      continue;
+    }
+    const Result result = run_case(name, function, min_time, repetitions);
+    std::cout << std::left << std::setw(48) << result.name << std::right;
+    if (!result.skipped.empty())
+    {
+      std::cout << "  skipped: " << result.skipped << std::endl;
+    }
+    else
+    {
+      std::cout << std::fixed << std::setprecision(2)
+                << std::setw(14) << result.median << std::setw(14) << result.min
+                << std::setw(9) << (result.median > 0 ? 100 * result.stddev / result.median : 0) << "%"
+                << std::setw(14) << result.iterations << std::scientific
+                << std::setw(16) << result.items << std::fixed << std::setw(16) << result.bytes / 1e6
+                << std::defaultfloat << std::endl;
+    }
+    results.push_back(result);
+  }
+
+  const std::string &jsonfile = Option("json");
+  if (!jsonfile.empty())
+  {
+    std::ofstream out(jsonfile);
+    if (!out.is_open())
+    {
+      std::cout << "could not open " << jsonfile << std::endl;
+      return 1;
+    }
+    out << "{\n  \"min_time\": " << min_time << ",\n  \"repetitions\": " << repetitions << ",\n  \"cases\": [";
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      const Result &r = results[i];
+      out << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\"";
+      if (!r.skipped.empty())
+      {
+        out << ", \"skipped\": \"" << r.skipped << "\"}";
+        continue;
+      }
+      out << ", \"iterations\": " << r.iterations
+          << ", \"ns_per_iteration\": " << r.median
+          << ", \"ns_min\": " << r.min
+          << ", \"ns_stddev\": " << r.stddev
+          << ", \"items_per_second\": " << r.items
+          << ", \"bytes_per_second\": " << r.bytes << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef MICROBENCHMARK_MICROBENCHMARK_H
+#define MICROBENCHMARK_MICROBENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+//! small harness to time the innermost kernels, in the style of google benchmark
+/*!
+  A case is a function of a State, the timed loop runs while
+  State::KeepRunning() returns true, setup before the loop is not timed:
+
+    void BM_TrkrDefsGetLayer(MicroBenchmark::State &state)
+    {
+      std::vector<TrkrDefs::cluskey> keys = ...;
+      while (state.KeepRunning())
+      {
+        for (const auto key : keys)
+        {
+          MicroBenchmark::DoNotOptimize(TrkrDefs::getLayer(key));
+        }
+      }
+      state.SetItemsProcessed(keys.size());
+    }
+    MICROBENCHMARK(BM_TrkrDefsGetLayer);
+
+  The number of iterations grows until a run takes at least --min_time
+  seconds (these runs are the warm-up), then the run is repeated
+  --repetitions times. The median time per iteration is reported in ns
+  with the items (bytes) per second given by SetItemsProcessed
+  (SetBytesProcessed). --filter=regex selects cases, --json=file writes
+  the results.
+*/
+namespace MicroBenchmark
+{
+  class State
+  {
+   public:
+    explicit State(const uint64_t max_iterations)
+      : m_MaxIterations(max_iterations)
+    {
+    }
+
+    //! true while the loop should go on, the first call starts the timer
+    bool KeepRunning()
+    {
+      if (m_Iterations < m_MaxIterations)
+      {
+        if (m_Iterations == 0)
+        {
+          m_Start = std::chrono::steady_clock::now();
+        }
+        ++m_Iterations;
+        return true;
+      }
+      if (!m_Stopped)
+      {
+        m_Elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+        m_Stopped = true;
+      }
+      return false;
+    }
+
+    //! exclude the code until ResumeTiming from the time, e.g. re-filling an input buffer
+    void PauseTiming()
+    {
+      m_Elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - m_Start).count();
+    }
+
+    void ResumeTiming()
+    {
+      m_Start = std::chrono::steady_clock::now();
+    }
+
+    //! items or bytes processed per iteration, for the throughput
+    void SetItemsProcessed(const uint64_t n) { m_Items = n; }
+    void SetBytesProcessed(const uint64_t n) { m_Bytes = n; }
+
+    //! the case cannot run (e.g. input file not given), the message is reported instead
+    void SkipWithMessage(const std::string &message)
+    {
+      m_Skipped = message;
+      m_Iterations = m_MaxIterations;
+      m_Stopped = true;
+    }
+
+    uint64_t iterations() const { return m_Iterations; }
+    double elapsed() const { return m_Elapsed; }
+    uint64_t items() const { return m_Items; }
+    uint64_t bytes() const { return m_Bytes; }
+    const std::string &skipped() const { return m_Skipped; }
+
+   private:
+    uint64_t m_Iterations = 0;
+    uint64_t m_MaxIterations = 0;
+    std::chrono::steady_clock::time_point m_Start;
+
+    //! seconds
+    double m_Elapsed = 0;
+    bool m_Stopped = false;
+
+    uint64_t m_Items = 0;
+    uint64_t m_Bytes = 0;
+    std::string m_Skipped;
+  };
+
+  using Function = std::function<void(State &)>;
+
+  //! add a case, returns a dummy so it can be called at static initialization (MICROBENCHMARK)
+  int Register(const std::string &name, Function function);
+
+  //! value of --name=value on the command line, empty if not given
+  const std::string &Option(const std::string &name);
+
+  //! parse the command line and run the cases, returns the exit code
+  int RunAll(int argc, char **argv);
+
+  //! keep the compiler from dropping the computation of value
+  template <class T>
+  inline void DoNotOptimize(const T &value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  //! force pending writes to memory
+  inline void ClobberMemory()
+  {
+    asm volatile("" : : : "memory");
+  }
+}  // namespace MicroBenchmark
+
+#define MICROBENCHMARK(function) \
+  [[maybe_unused]] static const int microbenchmark_##function = MicroBenchmark::Register(#function, function)
+
+#endif
@@ -0,0 +1,8 @@
+// runs the registered kernel cases, see MicroBenchmark.h for the options
+
+#include "MicroBenchmark.h"
+
+int main(int argc, char **argv)
+{
+  return MicroBenchmark::RunAll(argc, argv);
+}
@@ -9,6 +9,7 @@
 #include <cdbobjects/CDBTTree.h>
 
 #include <TFile.h>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 #include <iostream>
@@ -24,13 +25,14 @@ std::ostream& operator << (std::ostream& out, const MicromegasCalibrationData& c
 {
   out << "MicromegasCalibrationData" << std::endl;
   size_t total_entries = 0;
-  for( const auto& [fee_id, data_array] : calib_data.m_raw_calibration_map )
+  for( int fee_id = 0; fee_id < MicromegasCalibrationData::m_nfee_max; ++fee_id )
   {
-    total_entries += data_array.size();
-    out << "fee_id: " << fee_id << " entries: " << data_array.size() << std::endl;
-    for( size_t i=0; i<data_array.size(); ++i )
+    if( !calib_data.m_raw_calibration_valid[fee_id] ) { continue; }
+    total_entries += MicromegasCalibrationData::m_nchannels_fee;
+    out << "fee_id: " << fee_id << " entries: " << MicromegasCalibrationData::m_nchannels_fee << std::endl;
+    for( int i=0; i<MicromegasCalibrationData::m_nchannels_fee; ++i )
     {
-      const auto& data = data_array[i];
+      const auto& data = calib_data.m_raw_calibration[fee_id*MicromegasCalibrationData::m_nchannels_fee + i];
       out << "fee_id: " << fee_id << " channel: " << i << " pedestal: " << data.m_pedestal << " rms: " << data.m_rms << std::endl;
     }
 
@@ -47,7 +49,8 @@ void MicromegasCalibrationData::read( const std::string& filename )
   std::cout << "MicromegasCalibrationData::read - filename: " << filename << std::endl;
 
   // clear existing data
-  m_raw_calibration_map.clear();
+  m_raw_calibration.fill( calibration_data_t() );
+  m_raw_calibration_valid.fill( false );
   m_mapped_calibration_map.clear();
 
   // make sure file exists before loading, otherwise crashes
@@ -68,8 +71,7 @@ void MicromegasCalibrationData::read( const std::string& filename )
   const auto fee_id_list( mapping.get_fee_id_list() );
 
   // loop over all possible fee ids
-  static constexpr int m_fee_count_max = 26;
-  for( int fee_id = 0; fee_id < m_fee_count_max; ++ fee_id )
+  for( int fee_id = 0; fee_id < m_nfee_max; ++ fee_id )
   {
 
     // convert to new ids, for backward compatibility, and check if listed
@@ -95,7 +97,8 @@ void MicromegasCalibrationData::read( const std::string& filename )
         const calibration_data_t calibration_data( pedestal, rms );
 
         // insert in fee,channel structure
-        m_raw_calibration_map[fee_id_new].at(i) = calibration_data;
+        m_raw_calibration.at(fee_id_new*m_nchannels_fee + i) = calibration_data;
+        m_raw_calibration_valid.at(fee_id_new) = true;
 
         // also insert in hitsetkey, strip structure
         const auto strip = mapping.get_physical_strip( fee_id_new, i );
@@ -108,28 +111,35 @@ void MicromegasCalibrationData::read( const std::string& filename )
 
 //________________________________________________________________________-
 void MicromegasCalibrationData::set_pedestal( int fee, int channel, double value )
-{ m_raw_calibration_map[fee].at(channel).m_pedestal = value; }
+{
+  m_raw_calibration_valid.at(fee) = true;
+  m_raw_calibration.at(fee*m_nchannels_fee + channel).m_pedestal = value;
+}
 
 //________________________________________________________________________-
 void MicromegasCalibrationData::set_rms( int fee, int channel, double value )
-{ m_raw_calibration_map[fee].at(channel).m_rms = value; }
+{
+  m_raw_calibration_valid.at(fee) = true;
+  m_raw_calibration.at(fee*m_nchannels_fee + channel).m_rms = value;
+}
 
 //________________________________________________________________________-
 void MicromegasCalibrationData::write( const std::string& filename ) const
 {
   std::cout << "MicromegasCalibrationData::write - filename: " << filename << std::endl;
-  if( m_raw_calibration_map.empty() ) { return;
+  if( std::find( m_raw_calibration_valid.begin(), m_raw_calibration_valid.end(), true ) == m_raw_calibration_valid.end() ) { return;
 }
 
   // use generic CDBTree to load
   CDBTTree cdbttree( filename );
-  for( const auto& [fee,array]:m_raw_calibration_map )
+  for( int fee = 0; fee < m_nfee_max; ++fee )
   {
-    for( size_t i = 0; i < array.size(); ++i )
+    if( !m_raw_calibration_valid[fee] ) { continue; }
+    for( int i = 0; i < m_nchannels_fee; ++i )
     {
-      int channel = static_cast<unsigned long>(fee*m_nchannels_fee) + i;
-      const auto& pedestal =  array[i].m_pedestal;
-      const auto& rms =  array[i].m_rms;
+      int channel = fee*m_nchannels_fee + i;
+      const auto& pedestal =  m_raw_calibration[channel].m_pedestal;
+      const auto& rms =  m_raw_calibration[channel].m_rms;
       cdbttree.SetDoubleValue( channel, m_pedestal_key, pedestal );
       cdbttree.SetDoubleValue( channel, m_rms_key, rms );
     }
@@ -143,15 +153,15 @@ void MicromegasCalibrationData::write( const std::string& filename ) const
 //________________________________________________________________________-
 double MicromegasCalibrationData::get_pedestal( int fee, int channel ) const
 {
-  const auto iter = m_raw_calibration_map.find(fee);
-  return (iter != m_raw_calibration_map.end()) ? iter->second.at(channel).m_pedestal: -1;
+  if( fee < 0 || fee >= m_nfee_max || !m_raw_calibration_valid[fee] ) { return -1; }
+  return m_raw_calibration.at(fee*m_nchannels_fee + channel).m_pedestal;
 }
 
 //________________________________________________________________________-
 double MicromegasCalibrationData::get_rms( int fee, int channel ) const
 {
-  const auto iter = m_raw_calibration_map.find(fee);
-  return (iter != m_raw_calibration_map.end()) ? iter->second.at(channel).m_rms: -1;
+  if( fee < 0 || fee >= m_nfee_max || !m_raw_calibration_valid[fee] ) { return -1; }
+  return m_raw_calibration.at(fee*m_nchannels_fee + channel).m_rms;
 }
 
 //________________________________________________________________________-
@@ -73,11 +73,14 @@ class MicromegasCalibrationData
   };
 
   static constexpr int m_nchannels_fee = 256;
+  static constexpr int m_nfee_max = 26;
   using calibration_vector_t = std::array<calibration_data_t,m_nchannels_fee>;
 
-  /// map fee id to channel based calibration vector
-  using raw_calibration_map_t = std::map<int, calibration_vector_t>;
-  raw_calibration_map_t m_raw_calibration_map;
+  /// fee id, channel based calibration, flat array indexed by fee*m_nchannels_fee + channel
+  std::array<calibration_data_t,m_nfee_max*m_nchannels_fee> m_raw_calibration{};
+
+  /// true if some calibration is set for a given fee id
+  std::array<bool,m_nfee_max> m_raw_calibration_valid{};
 
   /// map hitset key to strip based calibration vector
   using mapped_calibration_map_t = std::map<TrkrDefs::hitsetkey,calibration_vector_t>;
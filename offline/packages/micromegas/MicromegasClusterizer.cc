@@ -17,7 +17,7 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSetContainer.h>
-#include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterHitAssocv4.h>
 
 #include <Acts/Definitions/Units.hpp>
 #include <Acts/Surfaces/Surface.hpp>
@@ -31,6 +31,7 @@
 #include <phool/PHNode.h>                           // for PHNode
 #include <phool/PHNodeIterator.h>                   // for PHNodeIterator
 #include <phool/PHObject.h>                         // for PHObject
+#include <phool/PHThreadPool.h>
 
 #include <Eigen/Dense>
 
@@ -41,6 +42,7 @@
 #include <cstdint>                                 // for uint16_t
 #include <iterator>                                 // for distance
 #include <map>                                      // for _Rb_tree_const_it...
+#include <memory>
 #include <utility>                                  // for pair, make_pair
 #include <vector>
 
@@ -86,6 +88,9 @@ MicromegasClusterizer::MicromegasClusterizer(const std::string &name )
   : SubsysReco(name)
 {}
 
+//_______________________________________________________________________________
+MicromegasClusterizer::~MicromegasClusterizer() = default;
+
 //_____________________________________________________________________
 int MicromegasClusterizer::Init(PHCompositeNode* /*topNode*/ )
 {
@@ -143,10 +148,16 @@ int MicromegasClusterizer::InitRun(PHCompositeNode *topNode)
       dstNode->addNode(trkrNode);
     }
 
-    trkrClusterHitAssoc = new TrkrClusterHitAssocv3;
+    trkrClusterHitAssoc = new TrkrClusterHitAssocv4;
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(trkrClusterHitAssoc, "TRKR_CLUSTERHITASSOC", "PHObject");
     trkrNode->addNode(newNode);
   }
+
+  if( m_nthreads != 1 && !m_threadpool )
+  {
+    m_threadpool = std::make_unique<PHThreadPool>( m_nthreads );
+    std::cout << "MicromegasClusterizer::InitRun - clustering with " << m_threadpool->size() << " threads" << std::endl;
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -177,234 +188,273 @@ int MicromegasClusterizer::process_event(PHCompositeNode *topNode)
   auto acts_geometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
   assert( acts_geometry );
 
-  // loop over micromegas hitsets
+  // micromegas hitsets (tiles) are clustered independently
+  std::vector<std::pair<TrkrDefs::hitsetkey,TrkrHitSet*>> hitsets;
   const auto hitset_range = trkrhitsetcontainer->getHitSets(TrkrDefs::TrkrId::micromegasId);
   for( auto hitset_it = hitset_range.first; hitset_it != hitset_range.second; ++hitset_it )
+  { hitsets.emplace_back( hitset_it->first, hitset_it->second ); }
+
+  std::vector<std::vector<TileCluster>> tile_clusters( hitsets.size() );
+  if( !m_threadpool )
   {
-    // get hitset, key and layer
-    TrkrHitSet* hitset = hitset_it->second;
-    const TrkrDefs::hitsetkey hitsetkey = hitset_it->first;
-    const auto layer = TrkrDefs::getLayer(hitsetkey);
-    const auto tileid = MicromegasDefs::getTileId(hitsetkey);
-
-    // get micromegas geometry object
-    const auto layergeom = dynamic_cast<CylinderGeomMicromegas*>(geonode->GetLayerGeom(layer));
-    assert(layergeom);
-
-    // get micromegas acts surface
-    const auto acts_surface = acts_geometry->maps().getMMSurface( hitsetkey);
-    if( !acts_surface )
+    for( size_t i = 0; i < hitsets.size(); ++i )
+    { ClusterTile( hitsets[i].first, hitsets[i].second, geonode, acts_geometry, tile_clusters[i] ); }
+  } else {
+    m_threadpool->parallel_for( hitsets.size(), [this, &hitsets, geonode, acts_geometry, &tile_clusters]( size_t i )
+      { ClusterTile( hitsets[i].first, hitsets[i].second, geonode, acts_geometry, tile_clusters[i] ); } );
+  }
+
+  // store clusters and associations in hitset order
+  for( size_t i = 0; i < hitsets.size(); ++i )
+  {
+    for( const auto& tile_cluster : tile_clusters[i] )
     {
-      std::cout
-        << "MicromegasClusterizer::process_event -"
-        << " could not find surface for layer " << (int) layer << " tile: " << (int) tileid
-        << " skipping hitset"
-        << std::endl;
-      continue;
+      for( const auto& hitkey : tile_cluster.hitkeys )
+      { trkrClusterHitAssoc->addAssoc( tile_cluster.ckey, hitkey ); }
+
+      auto cluster = trkrClusterContainer->newClusterv5();
+      cluster->setAdc( tile_cluster.adc );
+      cluster->setMaxAdc( tile_cluster.maxadc );
+      cluster->setLocalX( tile_cluster.localx );
+      cluster->setLocalY( tile_cluster.localy );
+      cluster->setPhiError( tile_cluster.phierror );
+      cluster->setZError( tile_cluster.zerror );
+      cluster->setPhiSize( tile_cluster.phisize );
+      cluster->setZSize( tile_cluster.zsize );
+      trkrClusterContainer->addClusterSpecifyKey( tile_cluster.ckey, cluster );
+
+      // increment counter
+      ++m_clustercounts[hitsets[i].first];
     }
+  }
 
-    /*
-     * get segmentation type, layer thickness, strip length and pitch.
-     * They are used to calculate cluster errors
-     */
-    const auto segmentation_type = layergeom->get_segmentation_type();
-    const double pitch = layergeom->get_pitch();
-    const double strip_length = layergeom->get_strip_length( tileid, acts_geometry );
+  // done
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-    // keep a list of ranges corresponding to each cluster
-    using range_list_t = std::vector<TrkrHitSet::ConstRange>;
-    range_list_t ranges;
+//_______________________________________________________________________________
+void MicromegasClusterizer::ClusterTile( TrkrDefs::hitsetkey hitsetkey, TrkrHitSet* hitset, PHG4CylinderGeomContainer* geonode, ActsGeometry* acts_geometry, std::vector<TileCluster>& tile_clusters ) const
+{
+  // get key and layer
+  const auto layer = TrkrDefs::getLayer(hitsetkey);
+  const auto tileid = MicromegasDefs::getTileId(hitsetkey);
 
-    // loop over hits
-    const auto hit_range = hitset->getHits();
+  // get micromegas geometry object
+  const auto layergeom = dynamic_cast<CylinderGeomMicromegas*>(geonode->GetLayerGeom(layer));
+  assert(layergeom);
 
-    // keep track of first iterator of runing cluster
-    auto begin = hit_range.first;
+  // get micromegas acts surface
+  const auto acts_surface = acts_geometry->maps().getMMSurface( hitsetkey);
+  if( !acts_surface )
+  {
+    std::cout
+      << "MicromegasClusterizer::ClusterTile -"
+      << " could not find surface for layer " << (int) layer << " tile: " << (int) tileid
+      << " skipping hitset"
+      << std::endl;
+    return;
+  }
 
-    // keep track of previous strip
-    uint16_t previous_strip = 0;
-    bool first = true;
+  /*
+   * get segmentation type, layer thickness, strip length and pitch.
+   * They are used to calculate cluster errors
+   */
+  const auto segmentation_type = layergeom->get_segmentation_type();
+  const double pitch = layergeom->get_pitch();
+  const double strip_length = layergeom->get_strip_length( tileid, acts_geometry );
 
-    for( auto hit_it = hit_range.first; hit_it != hit_range.second; ++hit_it )
-    {
+  // keep a list of ranges corresponding to each cluster
+  using range_list_t = std::vector<TrkrHitSet::ConstRange>;
+  range_list_t ranges;
 
-      // get hit key
-      const auto hitkey = hit_it->first;
-
-      // get strip number
-      const auto strip = MicromegasDefs::getStrip( hitkey );
+  // loop over hits
+  const auto hit_range = hitset->getHits();
 
-      if( first )
-      {
+  // keep track of first iterator of runing cluster
+  auto begin = hit_range.first;
 
-        previous_strip = strip;
-        first = false;
-        continue;
+  // keep track of previous strip
+  uint16_t previous_strip = 0;
+  bool first = true;
 
-      } else if( strip - previous_strip > 1 ) {
+  for( auto hit_it = hit_range.first; hit_it != hit_range.second; ++hit_it )
+  {
 
-        // store current cluster range
-        ranges.push_back( std::make_pair( begin, hit_it ) );
+    // get hit key
+    const auto hitkey = hit_it->first;
 
-        // reinitialize begin of next cluster range
-        begin = hit_it;
+    // get strip number
+    const auto strip = MicromegasDefs::getStrip( hitkey );
 
-      }
+    if( first )
+    {
 
-      // update previous strip
       previous_strip = strip;
+      first = false;
+      continue;
+
+    } else if( strip - previous_strip > 1 ) {
+
+      // store current cluster range
+      ranges.push_back( std::make_pair( begin, hit_it ) );
+
+      // reinitialize begin of next cluster range
+      begin = hit_it;
 
     }
 
-    // store last cluster
-    if( begin != hit_range.second ) { ranges.push_back( std::make_pair( begin, hit_range.second ) );
+    // update previous strip
+    previous_strip = strip;
+
+  }
+
+  // store last cluster
+  if( begin != hit_range.second ) { ranges.push_back( std::make_pair( begin, hit_range.second ) );
 }
 
-    // initialize cluster count
-    int cluster_count = 0;
+  // initialize cluster count
+  int cluster_count = 0;
 
-    // loop over found hit ranges and create clusters
-    for( const auto& range : ranges )
+  // loop over found hit ranges and create clusters
+  for( const auto& range : ranges )
+  {
+    // create cluster key and corresponding cluster
+    const auto ckey = TrkrDefs::genClusKey( hitsetkey, cluster_count++ );
+
+    TVector2 local_coordinates;
+    double weight_sum = 0;
+
+    // needed for proper error calculation
+    // it is either the sum over z, or phi, depending on segmentation
+    double coord_sum = 0;
+    double coordsquare_sum = 0;
+
+    // also store adc value
+    unsigned int adc_sum = 0;
+    unsigned int max_adc = 0;
+    const unsigned int strip_count = std::distance(range.first,range.second);
+    if(m_drop_single_strips && strip_count < 2)
+    { continue; }
+
+    // loop over constituting hits
+    std::vector<TrkrDefs::hitkey> hitkeys;
+    hitkeys.reserve( strip_count );
+    for( auto hit_it = range.first; hit_it != range.second; ++hit_it )
     {
-      // create cluster key and corresponding cluster
-      const auto ckey = TrkrDefs::genClusKey( hitsetkey, cluster_count++ );
-
-      TVector2 local_coordinates;
-      double weight_sum = 0;
-
-      // needed for proper error calculation
-      // it is either the sum over z, or phi, depending on segmentation
-      double coord_sum = 0;
-      double coordsquare_sum = 0;
-
-      // also store adc value
-      unsigned int adc_sum = 0;
-      unsigned int max_adc = 0;
-      const unsigned int strip_count = std::distance(range.first,range.second);
-      if(m_drop_single_strips && strip_count < 2)
-      { continue; }
-
-      // loop over constituting hits
-      for( auto hit_it = range.first; hit_it != range.second; ++hit_it )
-      {
-        // get hit key
-        const auto hitkey = hit_it->first;
-        const auto hit = hit_it->second;
-
-        // associate cluster key to hit key
-        trkrClusterHitAssoc->addAssoc(ckey, hitkey );
-
-        // get strip number
-        const auto strip = MicromegasDefs::getStrip( hitkey );
-
-        // get adc, remove pedestal
-        const double pedestal = m_use_default_pedestal ?
-          m_default_pedestal:
-          m_calibration_data.get_pedestal_mapped(hitsetkey, strip);
-        const double weight = double(hit->getAdc()) - pedestal;
-
-        // increment cluster adc
-        const auto hit_adc = hit->getAdc();
-        if( hit_adc > max_adc) { max_adc = hit_adc; }
-        adc_sum += hit_adc;
-
-        // get strip local coordinate and update relevant sums
-        const auto strip_local_coordinate = layergeom->get_local_coordinates( tileid, acts_geometry, strip );
-        local_coordinates += strip_local_coordinate*weight;
-        switch( segmentation_type )
-        {
-          case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
-          {
-
-            coord_sum += strip_local_coordinate.X()*weight;
-            coordsquare_sum += square(strip_local_coordinate.X())*weight;
-            break;
-          }
-
-          case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
-          {
-            coord_sum += strip_local_coordinate.Y()*weight;
-            coordsquare_sum += square(strip_local_coordinate.Y())*weight;
-            break;
-          }
-        }
+      // get hit key
+      const auto hitkey = hit_it->first;
+      const auto hit = hit_it->second;
 
-        weight_sum += weight;
+      // associate cluster key to hit key
+      hitkeys.push_back( hitkey );
 
-      }
-
-      local_coordinates *= (1./weight_sum);
+      // get strip number
+      const auto strip = MicromegasDefs::getStrip( hitkey );
 
-      // dimension and error in r, rphi and z coordinates
-      static const float invsqrt12 = 1./std::sqrt(12);
-      static constexpr float error_scale_phi = 1.6;
-      static constexpr float error_scale_z = 0.8;
+      // get adc, remove pedestal
+      const double pedestal = m_use_default_pedestal ?
+        m_default_pedestal:
+        m_calibration_data.get_pedestal_mapped(hitsetkey, strip);
+      const double weight = double(hit->getAdc()) - pedestal;
 
-      auto coord_cov = coordsquare_sum/weight_sum - square( coord_sum/weight_sum );
-      auto coord_error_sq = coord_cov/weight_sum;
+      // increment cluster adc
+      const auto hit_adc = hit->getAdc();
+      if( hit_adc > max_adc) { max_adc = hit_adc; }
+      adc_sum += hit_adc;
 
-      // local errors (x is along rphi, y is along z)
-      double error_sq_x = 0;
-      double error_sq_y = 0;
+      // get strip local coordinate and update relevant sums
+      const auto strip_local_coordinate = layergeom->get_local_coordinates( tileid, acts_geometry, strip );
+      local_coordinates += strip_local_coordinate*weight;
       switch( segmentation_type )
       {
         case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
         {
-          if( coord_error_sq == 0 ) { coord_error_sq = square(pitch)/12;
-          } else { coord_error_sq *= square(error_scale_phi);
-}
-          error_sq_x = coord_error_sq;
-          error_sq_y = square(strip_length*invsqrt12);
+
+          coord_sum += strip_local_coordinate.X()*weight;
+          coordsquare_sum += square(strip_local_coordinate.X())*weight;
           break;
         }
 
         case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
         {
-          if( coord_error_sq == 0 ) { coord_error_sq = square(pitch)/12;
-          } else { coord_error_sq *= square(error_scale_z);
-}
-          error_sq_x = square(strip_length*invsqrt12);
-          error_sq_y = coord_error_sq;
+          coord_sum += strip_local_coordinate.Y()*weight;
+          coordsquare_sum += square(strip_local_coordinate.Y())*weight;
           break;
         }
       }
 
-      auto cluster = std::make_unique<TrkrClusterv5>();
-      cluster->setAdc( adc_sum );
-      cluster->setMaxAdc( max_adc );
-      cluster->setLocalX(local_coordinates.X());
-      cluster->setLocalY(local_coordinates.Y());
-      cluster->setPhiError(sqrt(error_sq_x));
-      cluster->setZError(sqrt(error_sq_y));
+      weight_sum += weight;
 
-      // store cluster size
-      switch( segmentation_type )
-      {
-        case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
-        {
-          cluster->setPhiSize(strip_count);
-          cluster->setZSize(1);
-          break;
-        }
+    }
 
-        case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
-        {
-          cluster->setPhiSize(1);
-          cluster->setZSize(strip_count);
-          break;
-        }
+    local_coordinates *= (1./weight_sum);
+
+    // dimension and error in r, rphi and z coordinates
+    static const float invsqrt12 = 1./std::sqrt(12);
+    static constexpr float error_scale_phi = 1.6;
+    static constexpr float error_scale_z = 0.8;
+
+    auto coord_cov = coordsquare_sum/weight_sum - square( coord_sum/weight_sum );
+    auto coord_error_sq = coord_cov/weight_sum;
+
+    // local errors (x is along rphi, y is along z)
+    double error_sq_x = 0;
+    double error_sq_y = 0;
+    switch( segmentation_type )
+    {
+      case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
+      {
+        if( coord_error_sq == 0 ) { coord_error_sq = square(pitch)/12;
+        } else { coord_error_sq *= square(error_scale_phi);
+}
+        error_sq_x = coord_error_sq;
+        error_sq_y = square(strip_length*invsqrt12);
+        break;
       }
 
-      trkrClusterContainer->addClusterSpecifyKey( ckey, cluster.release() );
+      case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
+      {
+        if( coord_error_sq == 0 ) { coord_error_sq = square(pitch)/12;
+        } else { coord_error_sq *= square(error_scale_z);
+}
+        error_sq_x = square(strip_length*invsqrt12);
+        error_sq_y = coord_error_sq;
+        break;
+      }
+    }
 
-      // increment counter
-      ++m_clustercounts[hitsetkey];
+    TileCluster tile_cluster;
+    tile_cluster.ckey = ckey;
+    tile_cluster.adc = adc_sum;
+    tile_cluster.maxadc = max_adc;
+    tile_cluster.localx = local_coordinates.X();
+    tile_cluster.localy = local_coordinates.Y();
+    tile_cluster.phierror = sqrt(error_sq_x);
+    tile_cluster.zerror = sqrt(error_sq_y);
+
+    // store cluster size
+    switch( segmentation_type )
+    {
+      case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
+      {
+        tile_cluster.phisize = strip_count;
+        tile_cluster.zsize = 1;
+        break;
+      }
 
+      case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
+      {
+        tile_cluster.phisize = 1;
+        tile_cluster.zsize = strip_count;
+        break;
+      }
     }
 
+    tile_cluster.hitkeys = std::move( hitkeys );
+    tile_clusters.push_back( std::move(tile_cluster) );
+
   }
-  // done
-  return Fun4AllReturnCodes::EVENT_OK;
+
 }
 
 //_____________________________________________________________________
@@ -10,9 +10,17 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TrkrDefs.h>
+
+#include <memory>
 #include <string>
+#include <vector>
 
+class ActsGeometry;
 class PHCompositeNode;
+class PHG4CylinderGeomContainer;
+class PHThreadPool;
+class TrkrHitSet;
 
 //! micromegas clusterizer
 class MicromegasClusterizer : public SubsysReco
@@ -22,6 +30,9 @@ class MicromegasClusterizer : public SubsysReco
   //! constructor
   MicromegasClusterizer( const std::string &name = "MicromegasClusterizer" );
 
+  //! destructor
+  ~MicromegasClusterizer() override;
+
   /// global initialization
   int Init(PHCompositeNode*) override;
 
@@ -49,8 +60,30 @@ class MicromegasClusterizer : public SubsysReco
   void set_calibration_file( const std::string& value )
   { m_calibration_filename = value; }
 
+  /// cluster the tiles on nthreads threads, 0 uses all cores, 1 (default) runs serially
+  void set_num_threads( unsigned int nthreads )
+  { m_nthreads = nthreads; }
+
   private:
 
+  /// cluster of one tile, stored in the node tree once all tiles are done
+  struct TileCluster
+  {
+    TrkrDefs::cluskey ckey = 0;
+    unsigned int adc = 0;
+    unsigned int maxadc = 0;
+    double localx = 0;
+    double localy = 0;
+    double phierror = 0;
+    double zerror = 0;
+    unsigned int phisize = 0;
+    unsigned int zsize = 0;
+    std::vector<TrkrDefs::hitkey> hitkeys;
+  };
+
+  /// clusters of one tile, only reads shared data so tiles can be done concurrently
+  void ClusterTile( TrkrDefs::hitsetkey, TrkrHitSet*, PHG4CylinderGeomContainer*, ActsGeometry*, std::vector<TileCluster>& ) const;
+
   //!@name calibration filename
   //@{
 
@@ -76,6 +109,10 @@ class MicromegasClusterizer : public SubsysReco
   using clustercountmap_t = std::map<TrkrDefs::hitsetkey, int>;
   clustercountmap_t m_clustercounts;
 
+  /// number of clustering threads
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
 };
 
 #endif
@@ -202,26 +202,25 @@ int MicromegasCombinedDataDecoder::process_event(PHCompositeNode* topNode)
     }
 
     // loop over sample_range find maximum
+    /* TODO: use more advanced signal processing */
     const auto sample_range = std::make_pair(rawhit->get_sample_begin(), rawhit->get_sample_end());
-    std::vector<uint16_t> adc_list;
+    uint16_t max_adc = 0;
+    bool has_adc = false;
     for (auto is = std::max(m_sample_min, sample_range.first); is < std::min(m_sample_max, sample_range.second); ++is)
     {
       const uint16_t adc = rawhit->get_adc(is);
       if (adc != MicromegasDefs::m_adc_invalid)
       {
-        adc_list.push_back(adc);
+        max_adc = has_adc ? std::max(max_adc, adc) : adc;
+        has_adc = true;
       }
     }
 
-    if (adc_list.empty())
+    if (!has_adc)
     {
       continue;
     }
 
-    // get max adc value in range
-    /* TODO: use more advanced signal processing */
-    auto max_adc = *std::max_element(adc_list.begin(), adc_list.end());
-
     // compare to hard min_adc value
     if (max_adc < m_min_adc)
     {
@@ -12,8 +12,9 @@
 
 #include <trackbase/ClusHitsVerbosev1.h>
 #include <trackbase/MvtxDefs.h>
+#include <trackbase/PixelClusterLabeler.h>
 #include <trackbase/TrkrClusterContainerv4.h>
-#include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterHitAssocv4.h>
 #include <trackbase/TrkrClusterv3.h>
 #include <trackbase/TrkrClusterv4.h>
 #include <trackbase/TrkrClusterv5.h>
@@ -42,13 +43,6 @@
 #include <TMatrixTUtils.h>  // for TMatrixTRow
 #include <TVector3.h>
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-#include <boost/graph/adjacency_list.hpp>
-#pragma GCC diagnostic pop
-
-#include <boost/graph/connected_components.hpp>
-
 #include <array>
 #include <cmath>
 #include <cstdlib>  // for exit
@@ -58,7 +52,6 @@
 #include <string>
 #include <vector>  // for vector
 
-using namespace boost;
 using namespace std;
 
 namespace
@@ -72,64 +65,6 @@ namespace
   }
 }  // namespace
 
-bool MvtxClusterizer::are_adjacent(
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &lhs,
-    const std::pair<TrkrDefs::hitkey, TrkrHit *> &rhs)
-{
-  if (GetZClustering())
-  {
-    // column is first, row is second
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) <= 1)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
-  }
-  else
-  {
-    if (fabs(MvtxDefs::getCol(lhs.first) - MvtxDefs::getCol(rhs.first)) == 0)
-    {
-      if (fabs(MvtxDefs::getRow(lhs.first) - MvtxDefs::getRow(rhs.first)) <=
-          1)
-      {
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
-bool MvtxClusterizer::are_adjacent(RawHit *lhs, RawHit *rhs)
-{
-  if (GetZClustering())
-  {
-    // column is first, row is second
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) <= 1)  // col
-    {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)  // Row
-      {
-        return true;
-      }
-    }
-  }
-  else
-  {
-    if (fabs(lhs->getPhiBin() - rhs->getPhiBin()) == 0)
-    {
-      if (fabs(lhs->getTBin() - rhs->getTBin()) <= 1)
-      {
-        return true;
-      }
-    }
-  }
-
-  return false;
-}
-
 MvtxClusterizer::MvtxClusterizer(const string &name)
   : SubsysReco(name)
   , m_hits(nullptr)
@@ -200,7 +135,7 @@ int MvtxClusterizer::InitRun(PHCompositeNode *topNode)
       dstNode->addNode(DetNode);
     }
 
-    clusterhitassoc = new TrkrClusterHitAssocv3;
+    clusterhitassoc = new TrkrClusterHitAssocv4;
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(
         clusterhitassoc, "TRKR_CLUSTERHITASSOC", "PHObject");
     DetNode->addNode(newNode);
@@ -324,6 +259,11 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
   // Clustering
   //-----------
 
+  // clustering buffers, reused for all chips
+  PixelClusterLabeler labeler;
+  std::vector<PixelClusterLabeler::Pixel> pixels;
+  std::vector<int> component;
+
   // loop over each MvtxHitSet object (chip)
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::mvtxId);
@@ -375,28 +315,12 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    pixels.clear();
+    for (const auto &hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      pixels.emplace_back(MvtxDefs::getCol(hit.first), MvtxDefs::getRow(hit.first));
     }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    labeler.label(pixels, GetZClustering(), component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -596,7 +520,14 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
              << endl;
       }
 
-      auto clus = std::make_unique<TrkrClusterv5>();
+      // clusters too long in z cannot be stored
+      if (zbins.size() > 127)
+      {
+        continue;
+      }
+
+      // cluster is owned by the container from here on
+      auto clus = m_clusterlist->newClusterv5();
       clus->setAdc(nhits);
       clus->setMaxAdc(1);
       clus->setLocalX(locclusx);
@@ -614,10 +545,7 @@ void MvtxClusterizer::ClusterMvtx(PHCompositeNode *topNode)
         clus->identify();
       }
 
-      if (zbins.size() <= 127)
-      {
-        m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
-      }
+      m_clusterlist->addClusterSpecifyKey(ckey, clus);
 
     }  // clusitr loop
   }    // loop over hitsets
@@ -650,6 +578,11 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
   // Clustering
   //-----------
 
+  // clustering buffers, reused for all chips
+  PixelClusterLabeler labeler;
+  std::vector<PixelClusterLabeler::Pixel> pixels;
+  std::vector<int> component;
+
   // loop over each MvtxHitSet object (chip)
   RawHitSetContainer::ConstRange hitsetrange =
       m_rawhits->getHitSets(TrkrDefs::TrkrId::mvtxId);
@@ -689,28 +622,12 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
     }
 
     // do the clustering
-    using Graph = adjacency_list<vecS, vecS, undirectedS>;
-    Graph G;
-
-    // loop over hits in this chip
-    for (unsigned int i = 0; i < hitvec.size(); i++)
+    pixels.clear();
+    for (const auto *hit : hitvec)
     {
-      for (unsigned int j = 0; j < hitvec.size(); j++)
-      {
-        if (are_adjacent(hitvec[i], hitvec[j]))
-        {
-          add_edge(i, j, G);
-        }
-      }
+      pixels.emplace_back(hit->getPhiBin(), hit->getTBin());  // col, row
     }
-
-    // Find the connections between the vertices of the graph (vertices are the
-    // rawhits,
-    // connections are made when they are adjacent to one another)
-    vector<int> component(num_vertices(G));
-
-    // this is the actual clustering, performed by boost
-    connected_components(G, &component[0]);
+    labeler.label(pixels, GetZClustering(), component);
 
     // Loop over the components(hits) compiling a list of the
     // unique connected groups (ie. clusters).
@@ -876,7 +793,14 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
              << endl;
       }
 
-      auto clus = std::make_unique<TrkrClusterv5>();
+      // clusters too long in z cannot be stored
+      if (zbins.size() > 127)
+      {
+        continue;
+      }
+
+      // cluster is owned by the container from here on
+      auto clus = m_clusterlist->newClusterv5();
       clus->setAdc(nhits);
       clus->setMaxAdc(1);
       clus->setLocalX(locclusx);
@@ -894,10 +818,7 @@ void MvtxClusterizer::ClusterMvtxRaw(PHCompositeNode *topNode)
         clus->identify();
       }
 
-      if (zbins.size() <= 127)
-      {
-        m_clusterlist->addClusterSpecifyKey(ckey, clus.release());
-      }
+      m_clusterlist->addClusterSpecifyKey(ckey, clus);
     }  // clusitr loop
   }    // loop over hitsets
 
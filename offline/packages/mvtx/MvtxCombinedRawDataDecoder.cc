@@ -20,6 +20,7 @@
 #include <ffarawobjects/MvtxRawEvtHeader.h>
 #include <ffarawobjects/MvtxRawHit.h>
 #include <ffarawobjects/MvtxRawHitContainer.h>
+#include <ffarawobjects/MvtxRawHitContainerv2.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 
@@ -196,11 +197,6 @@ int MvtxCombinedRawDataDecoder::process_event(PHCompositeNode *topNode)
   }
 
   uint64_t strobe = -1;  // Initialise to -1 for debugging
-  uint8_t layer = 0;
-  uint8_t stave = 0;
-  uint8_t chip = 0;
-  uint16_t row = 0;
-  uint16_t col = 0;
   std::vector<std::pair<uint64_t, uint32_t> > strobe_bc_pairs;
   std::set<uint64_t> l1BCOs = mvtx_raw_event_header->getMvtxLvL1BCO();
   auto mvtxbco = *l1BCOs.begin();
@@ -217,70 +213,98 @@ int MvtxCombinedRawDataDecoder::process_event(PHCompositeNode *topNode)
     assert(mvtx_event_header);
   }
 
-  for (unsigned int i = 0; i < mvtx_hit_container->get_nhits(); i++)
+  // hitset of a chip readout, nullptr if outside of the strobe range
+  auto get_hitset = [&](const uint64_t bco, const uint8_t layer, const uint8_t stave, const uint8_t chip) -> TrkrHitSet *
   {
-    mvtx_hit = mvtx_hit_container->get_hit(i);
-    strobe = mvtx_hit->get_bco();
-    layer = mvtx_hit->get_layer_id();
-    stave = mvtx_hit->get_stave_id();
-    chip = mvtx_hit->get_chip_id();
-    row = mvtx_hit->get_row();
-    col = mvtx_hit->get_col();
-
-    int bcodiff = gl1 ? gl1bco - strobe : 0;
+    int bcodiff = gl1 ? gl1bco - bco : 0;
     double timeElapsed = bcodiff * 0.106;  // 106 ns rhic clock
     int index = m_mvtx_is_triggered ? 0 : std::floor(timeElapsed / m_strobeWidth);
 
     if (index < -16 || index > 15)
     {
-      continue; //Index is out of the 5-bit signed range
-    }
-
-    if (Verbosity() >= 10)
-    {
-      mvtx_hit->identify();
+      return nullptr; //Index is out of the 5-bit signed range
     }
 
     const TrkrDefs::hitsetkey hitsetkey =
         MvtxDefs::genHitSetKey(layer, stave, chip, index);
     if (!hitsetkey)
     {
-      continue;
+      return nullptr;
     }
 
     // get matching hitset
-    const auto hitset_it = hit_set_container->findOrAddHitSet(hitsetkey);
+    return hit_set_container->findOrAddHitSet(hitsetkey)->second;
+  };
 
+  auto add_hit = [&](TrkrHitSet *hitset, const uint8_t layer, const uint8_t stave, const uint8_t chip, const uint16_t row, const uint16_t col)
+  {
     // generate hit key
     const TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(col, row);
 
     // find existing hit, or create
-    auto hit = hitset_it->second->getHit(hitkey);
+    auto hit = hitset->getHit(hitkey);
     if (hit)
     {
       if(Verbosity() > 1)
       {
-        std::cout << PHWHERE << "::" << __func__
-                  << " - duplicated hit, hitsetkey: " << hitsetkey
+        std::cout << PHWHERE << "::process_event"
+                  << " - duplicated hit, hitsetkey: " << hitset->getHitSetKey()
                   << " hitkey: " << hitkey << std::endl;
       }
-      continue;
+      return;
     }
 
-    if(m_doOfflineMasking)
+    // Check if the pixel is masked
+    if (m_doOfflineMasking && m_hot_pixel_mask->is_masked(layer, stave, chip, row, col))
     {
-      if (!m_hot_pixel_mask->is_masked(mvtx_hit))
-      { // Check if the pixel is masked
-        hit = new TrkrHitv2;
-        hitset_it->second->addHitSpecificKey(hitkey, hit);
-      }
+      return;
     }
-    else
+    hit = new TrkrHitv2;
+    hitset->addHitSpecificKey(hitkey, hit);
+  };
+
+  if (auto packed = dynamic_cast<MvtxRawHitContainerv2 *>(mvtx_hit_container))
+  {
+    // pixels are decoded per chip readout, without hit objects
+    for (unsigned int i = 0; i < packed->get_nchips(); ++i)
     {
-      hit = new TrkrHitv2;
-      hitset_it->second->addHitSpecificKey(hitkey, hit);
+      const uint8_t layer = packed->get_chip_layer_id(i);
+      const uint8_t stave = packed->get_chip_stave_id(i);
+      const uint8_t chip = packed->get_chip_chip_id(i);
+      strobe = packed->get_chip_bco(i);
+
+      TrkrHitSet *hitset = get_hitset(strobe, layer, stave, chip);
+      if (!hitset)
+      {
+        continue;
+      }
+      packed->for_each_pixel(i, [&](const uint16_t row, const uint16_t col)
+                             { add_hit(hitset, layer, stave, chip, row, col); });
     }
+  }
+  else
+  {
+    for (unsigned int i = 0; i < mvtx_hit_container->get_nhits(); i++)
+    {
+      mvtx_hit = mvtx_hit_container->get_hit(i);
+      strobe = mvtx_hit->get_bco();
+      const uint8_t layer = mvtx_hit->get_layer_id();
+      const uint8_t stave = mvtx_hit->get_stave_id();
+      const uint8_t chip = mvtx_hit->get_chip_id();
+
+      TrkrHitSet *hitset = get_hitset(strobe, layer, stave, chip);
+      if (!hitset)
+      {
+        continue;
+      }
 
+      if (Verbosity() >= 10)
+      {
+        mvtx_hit->identify();
+      }
+
+      add_hit(hitset, layer, stave, chip, mvtx_hit->get_row(), mvtx_hit->get_col());
+    }
   }
 
   mvtx_event_header->set_strobe_BCO(strobe);
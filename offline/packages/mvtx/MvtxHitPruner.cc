@@ -47,8 +47,7 @@
 #include <cmath>
 #include <cstdlib>  // for exit
 #include <iostream>
-#include <map>  // for multimap<>::iterator
-#include <set>  // for set, set<>::iterator
+#include <map>  // for map<>::iterator
 #include <string>
 #include <vector>  // for vector
 
@@ -71,6 +70,8 @@ int MvtxHitPruner::InitRun(PHCompositeNode * /*topNode*/)
   // Report Settings
   //----------------
 
+  m_pixel_bitmap.assign(MvtxDefs::MAXROW * MvtxDefs::MAXCOL / 64, 0);
+
   if (Verbosity() > 0)
   {
     cout << "====================== MvtxHitPruner::InitRun() "
@@ -95,11 +96,10 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
   // Start by looping over all MVTX hitsets and making a map of physical sensor
   // to hitsetkey-with-strobe
   //=============================================================================
-  std::multimap<TrkrDefs::hitsetkey, TrkrDefs::hitsetkey>
-      hitset_multimap;                            // will map (bare hitset, hitset with strobe)
-  std::set<TrkrDefs::hitsetkey> bare_hitset_set;  // list of all physical sensor
-                                                  // hitsetkeys (i.e. with strobe
-                                                  // set to zero)
+  std::map<TrkrDefs::hitsetkey, std::vector<TrkrDefs::hitsetkey>>
+      hitset_map;  // will map (bare hitset, hitsets with strobe), the bare
+                   // hitsetkeys are the physical sensors (i.e. with strobe
+                   // set to zero)
 
   TrkrHitSetContainer::ConstRange hitsetrange =
       m_hits->getHitSets(TrkrDefs::TrkrId::mvtxId);
@@ -114,8 +114,7 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
     unsigned int chip = MvtxDefs::getChipId(hitsetitr->first);
     auto bare_hitsetkey = MvtxDefs::genHitSetKey(layer, stave, chip, 0);
 
-    hitset_multimap.insert(std::make_pair(bare_hitsetkey, hitsetkey));
-    bare_hitset_set.insert(bare_hitsetkey);
+    hitset_map[bare_hitsetkey].push_back(hitsetkey);
 
     if (Verbosity() > 0)
     {
@@ -127,7 +126,7 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
   // Now consolidate all hits into the hitset with strobe 0, and delete the
   // other hitsets
   //==============================================================
-  for (unsigned int bare_hitsetkey : bare_hitset_set)
+  for (const auto &[bare_hitsetkey, hitsetkeys] : hitset_map)
   {
     TrkrHitSet *bare_hitset = (m_hits->findOrAddHitSet(bare_hitsetkey))->second;
     if (Verbosity() > 0)
@@ -137,11 +136,21 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
                 << std::endl;
     }
 
-    auto bare_hitsetrange = hitset_multimap.equal_range(bare_hitsetkey);
-    for (auto it = bare_hitsetrange.first; it != bare_hitsetrange.second;
-         ++it)
+    // nothing to merge
+    if (hitsetkeys.size() == 1 && MvtxDefs::getStrobeId(hitsetkeys.front()) == 0)
+    {
+      continue;
+    }
+
+    // duplicates are found in the pixel bitmap of the chip instead of the hit map
+    TrkrHitSet::ConstRange bare_hitrange = bare_hitset->getHits();
+    for (auto hitr = bare_hitrange.first; hitr != bare_hitrange.second; ++hitr)
+    {
+      test_and_set_pixel(hitr->first);
+    }
+
+    for (const auto hitsetkey : hitsetkeys)
     {
-      auto hitsetkey = it->second;
 
       int strobe = MvtxDefs::getStrobeId(hitsetkey);
       if (strobe != 0)
@@ -174,8 +183,7 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
           }
 
           // if it is already there, leave it alone, this is a duplicate hit
-          auto tmp_hit = bare_hitset->getHit(hitkey);
-          if (tmp_hit)
+          if (test_and_set_pixel(hitkey))
           {
             if (Verbosity() > 0)
             {
@@ -203,7 +211,30 @@ int MvtxHitPruner::process_event(PHCompositeNode *topNode)
         m_hits->removeHitSet(hitsetkey);
       }
     }
+
+    // reset the bitmap for the next chip, all merged hits are in the bare hitset now
+    bare_hitrange = bare_hitset->getHits();
+    for (auto hitr = bare_hitrange.first; hitr != bare_hitrange.second; ++hitr)
+    {
+      clear_pixel(hitr->first);
+    }
   }
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
+
+bool MvtxHitPruner::test_and_set_pixel(TrkrDefs::hitkey hitkey)
+{
+  const unsigned int index = MvtxDefs::getRow(hitkey) * MvtxDefs::MAXCOL + MvtxDefs::getCol(hitkey);
+  uint64_t &word = m_pixel_bitmap[index >> 6U];
+  const uint64_t bit = uint64_t(1) << (index & 63U);
+  const bool was_set = (word & bit) != 0;
+  word |= bit;
+  return was_set;
+}
+
+void MvtxHitPruner::clear_pixel(TrkrDefs::hitkey hitkey)
+{
+  const unsigned int index = MvtxDefs::getRow(hitkey) * MvtxDefs::MAXCOL + MvtxDefs::getCol(hitkey);
+  m_pixel_bitmap[index >> 6U] &= ~(uint64_t(1) << (index & 63U));
+}
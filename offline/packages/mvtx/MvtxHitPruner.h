@@ -10,8 +10,10 @@
 #include <fun4all/SubsysReco.h>
 #include <trackbase/TrkrDefs.h>
 
+#include <cstdint>
 #include <string>  // for string
 #include <utility>
+#include <vector>
 class PHCompositeNode;
 class TrkrHit;
 class TrkrHitSetContainer;
@@ -40,9 +42,19 @@ class MvtxHitPruner : public SubsysReco
   int End(PHCompositeNode * /*topNode*/) override { return 0; }
 
  private:
+  //! set the bit of a pixel in the chip bitmap, returns true if it was already set
+  bool test_and_set_pixel(TrkrDefs::hitkey hitkey);
+
+  //! clear the bit of a pixel in the chip bitmap
+  void clear_pixel(TrkrDefs::hitkey hitkey);
+
   // node tree storage pointers
   TrkrHitSetContainer *m_hits;
 
+  //! pixels of the chip being merged, one bit per pixel. Only the bits of
+  //! the merged hits are cleared afterwards, not the whole 64 kB
+  std::vector<uint64_t> m_pixel_bitmap;
+
   // settings
 };
 
@@ -43,21 +43,19 @@ void MvtxPixelMask::load_from_CDB()
     masked_pixels.insert(this_pixel_key);
   }
 
-  // Copy the masked pixels to the hot pixel map
-  // m_hot_pixel_map.assign(masked_pixels.begin(), masked_pixels.end());
-  for (unsigned long masked_pixel : masked_pixels)
-  {
-    m_hot_pixel_map.push_back(masked_pixel);
-  }
+  // Copy the masked pixels to the hot pixel map, the set is sorted already
+  m_hot_pixel_map.assign(masked_pixels.begin(), masked_pixels.end());
 
   return;
 }
 
 void MvtxPixelMask::add_pixel(MvtxPixelDefs::pixelkey key)
 {
-  if (std::find(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), key) == m_hot_pixel_map.end())
+  // the map is kept sorted for the binary search in is_masked
+  auto it = std::lower_bound(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), key);
+  if (it == m_hot_pixel_map.end() || *it != key)
   {
-    m_hot_pixel_map.push_back(key);
+    m_hot_pixel_map.insert(it, key);
   }
 
   return;
@@ -65,8 +63,8 @@ void MvtxPixelMask::add_pixel(MvtxPixelDefs::pixelkey key)
 
 void MvtxPixelMask::remove_pixel(MvtxPixelDefs::pixelkey key)
 {
-  auto it = std::find(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), key);
-  if (it != m_hot_pixel_map.end())
+  auto it = std::lower_bound(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), key);
+  if (it != m_hot_pixel_map.end() && *it == key)
   {
     m_hot_pixel_map.erase(it);
   }
@@ -82,16 +80,15 @@ void MvtxPixelMask::clear()
 
 bool MvtxPixelMask::is_masked(MvtxRawHit* hit) const
 {
-  uint8_t layer = hit->get_layer_id();
-  uint8_t stave = hit->get_stave_id();
-  uint8_t chip = hit->get_chip_id();
-  uint16_t row = hit->get_row();
-  uint16_t col = hit->get_col();
+  return is_masked(hit->get_layer_id(), hit->get_stave_id(), hit->get_chip_id(), hit->get_row(), hit->get_col());
+}
 
+bool MvtxPixelMask::is_masked(uint8_t layer, uint8_t stave, uint8_t chip, uint16_t row, uint16_t col) const
+{
   // generate hit key and hitset key
   const TrkrDefs::hitkey this_pixel_hitkey = MvtxDefs::genHitKey(col, row);
   const TrkrDefs::hitsetkey this_pixel_hitsetkey = MvtxDefs::genHitSetKey(layer, stave, chip, 0);
   MvtxPixelDefs::pixelkey this_pixel_key = MvtxPixelDefs::gen_pixelkey(this_pixel_hitsetkey, this_pixel_hitkey);
 
-  return std::find(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), this_pixel_key) != m_hot_pixel_map.end();
+  return std::binary_search(m_hot_pixel_map.begin(), m_hot_pixel_map.end(), this_pixel_key);
 }
\ No newline at end of file
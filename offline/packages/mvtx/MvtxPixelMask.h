@@ -4,6 +4,7 @@
 #include "MvtxPixelDefs.h"
 
 #include <climits>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -15,6 +16,7 @@ class MvtxPixelMask
   MvtxPixelMask() {}
   ~MvtxPixelMask() { clear(); }
 
+  //! sorted list of masked pixels
   typedef std::vector<MvtxPixelDefs::pixelkey> hot_pixel_map_t;
 
   void load_from_CDB();
@@ -25,8 +27,9 @@ class MvtxPixelMask
   void clear();
 
   bool is_masked(MvtxRawHit* hit) const;
+  bool is_masked(uint8_t layer, uint8_t stave, uint8_t chip, uint16_t row, uint16_t col) const;
 
-  hot_pixel_map_t get_hot_pixel_map() const { return m_hot_pixel_map; }
+  const hot_pixel_map_t &get_hot_pixel_map() const { return m_hot_pixel_map; }
 
  private:
   hot_pixel_map_t m_hot_pixel_map{};
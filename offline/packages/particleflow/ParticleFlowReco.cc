@@ -27,9 +27,154 @@
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>  // for gsl_rng_uniform_pos
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
+namespace
+{
+  // clusters binned in (eta, phi), to find the clusters within a distance of a point
+  class EtaPhiGrid
+  {
+   public:
+    EtaPhiGrid(const std::vector<float> &eta, const std::vector<float> &phi, float distance)
+    {
+      // cells slightly larger than the distance, so the neighbouring cells contain all clusters within it
+      m_cell_size = 1.01 * distance;
+      m_nphi = std::floor(2 * M_PI / m_cell_size);
+      if (m_nphi < 3)
+      {
+        m_nphi = 1;
+      }
+
+      m_size = eta.size();
+      std::vector<int> cells(m_size, -1);
+      bool first = true;
+      float eta_max = 0;
+      for (unsigned int i = 0; i < m_size; ++i)
+      {
+        if (!std::isfinite(eta[i]) || !std::isfinite(phi[i]))
+        {
+          continue;
+        }
+        m_eta_min = first ? eta[i] : std::min(m_eta_min, eta[i]);
+        eta_max = first ? eta[i] : std::max(eta_max, eta[i]);
+        first = false;
+      }
+      m_neta = first ? 0 : std::floor((eta_max - m_eta_min) / m_cell_size) + 1;
+
+      // count, then fill the clusters of each cell in index order
+      m_cell_start.assign(m_neta * m_nphi + 1, 0);
+      for (unsigned int i = 0; i < m_size; ++i)
+      {
+        if (!std::isfinite(eta[i]) || !std::isfinite(phi[i]))
+        {
+          m_always.push_back(i);
+          continue;
+        }
+        cells[i] = eta_bin(eta[i]) * m_nphi + phi_bin(phi[i]);
+        ++m_cell_start[cells[i] + 1];
+      }
+      for (unsigned int cell = 0; cell + 1 < m_cell_start.size(); ++cell)
+      {
+        m_cell_start[cell + 1] += m_cell_start[cell];
+      }
+      m_entries.resize(m_cell_start.back());
+      std::vector<unsigned int> fill(m_cell_start.begin(), m_cell_start.end() - 1);
+      for (unsigned int i = 0; i < m_size; ++i)
+      {
+        if (cells[i] >= 0)
+        {
+          m_entries[fill[cells[i]]++] = i;
+        }
+      }
+    }
+
+    // clusters which can be within the distance of (eta, phi), in increasing index order
+    void find(float eta, float phi, std::vector<unsigned int> &candidates) const
+    {
+      candidates.clear();
+      if (!std::isfinite(eta) || !std::isfinite(phi))
+      {
+        for (unsigned int i = 0; i < m_size; ++i)
+        {
+          candidates.push_back(i);
+        }
+        return;
+      }
+
+      candidates = m_always;
+      const int ieta = std::clamp<double>(std::floor((eta - m_eta_min) / m_cell_size), -2, m_neta + 1);
+      const int iphi = phi_bin(phi);
+      const int dphi_max = m_nphi < 3 ? 0 : 1;
+      for (int jeta = std::max(0, ieta - 1); jeta <= std::min(m_neta - 1, ieta + 1); ++jeta)
+      {
+        for (int dphi = -dphi_max; dphi <= dphi_max; ++dphi)
+        {
+          const int cell = jeta * m_nphi + (iphi + dphi + m_nphi) % m_nphi;
+          candidates.insert(candidates.end(), m_entries.begin() + m_cell_start[cell], m_entries.begin() + m_cell_start[cell + 1]);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+    }
+
+   private:
+    int eta_bin(float eta) const
+    {
+      return std::min<int>(m_neta - 1, std::floor((eta - m_eta_min) / m_cell_size));
+    }
+
+    int phi_bin(float phi) const
+    {
+      float wrapped = std::fmod(phi, 2 * M_PI);
+      if (wrapped < 0)
+      {
+        wrapped += 2 * M_PI;
+      }
+      return std::min<int>(m_nphi - 1, std::floor(wrapped * m_nphi / (2 * M_PI)));
+    }
+
+    float m_cell_size = 0;
+    float m_eta_min = 0;
+    int m_neta = 0;
+    int m_nphi = 1;
+    unsigned int m_size = 0;
+
+    // clusters of each cell, those of cell c are in [ m_cell_start[c], m_cell_start[c+1] )
+    std::vector<unsigned int> m_cell_start;
+    std::vector<unsigned int> m_entries;
+
+    // clusters without a valid position, always tested
+    std::vector<unsigned int> m_always;
+  };
+
+  // true if a tower of the cluster is within window in eta and phi
+  bool has_tower_overlap(const std::vector<float> &tower_eta, const std::vector<float> &tower_phi,
+                         const std::vector<unsigned int> &tower_offset, unsigned int cluster,
+                         float eta, float phi, double window)
+  {
+    for (unsigned int tow = tower_offset[cluster]; tow < tower_offset[cluster + 1]; tow++)
+    {
+      float deta = tower_eta[tow] - eta;
+      float dphi = tower_phi[tow] - phi;
+      if (dphi > M_PI)
+      {
+        dphi -= 2 * M_PI;
+      }
+      if (dphi < -M_PI)
+      {
+        dphi += 2 * M_PI;
+      }
+
+      if (fabs(deta) < window && fabs(dphi) < window)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+}  // namespace
+
 // examine second value of std::pair, sort by smallest
 bool sort_by_pair_second_lowest(const std::pair<int, float> &a, const std::pair<int, float> &b)
 {
@@ -136,6 +281,7 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
   _pflow_EM_phi.clear();
   _pflow_EM_tower_eta.clear();
   _pflow_EM_tower_phi.clear();
+  _pflow_EM_tower_offset.assign(1, 0);
   _pflow_EM_match_HAD.clear();
   _pflow_EM_match_TRK.clear();
   _pflow_EM_cluster.clear();
@@ -145,6 +291,7 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
   _pflow_HAD_phi.clear();
   _pflow_HAD_tower_eta.clear();
   _pflow_HAD_tower_phi.clear();
+  _pflow_HAD_tower_offset.assign(1, 0);
   _pflow_HAD_match_EM.clear();
   _pflow_HAD_match_TRK.clear();
   _pflow_HAD_cluster.clear();
@@ -262,9 +409,6 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         std::cout << " EM topoCluster with E = " << cluster_E << ", eta / phi = " << cluster_eta << " / " << cluster_phi << " , nTow = " << hiter->second->getNTowers() << std::endl;
       }
 
-      std::vector<float> this_cluster_tower_eta;
-      std::vector<float> this_cluster_tower_phi;
-
       // read in towers
       RawCluster::TowerConstRange begin_end_towers = hiter->second->get_towers();
       for (RawCluster::TowerConstIterator iter = begin_end_towers.first; iter != begin_end_towers.second; ++iter)
@@ -273,8 +417,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         {
           RawTowerGeom *tower_geom = geomEM->get_tower_geometry(iter->first);
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          _pflow_EM_tower_phi.push_back(tower_geom->get_phi());
+          _pflow_EM_tower_eta.push_back(tower_geom->get_eta());
         }
         else
         {
@@ -283,8 +427,7 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         }
       }  // close tower loop
 
-      _pflow_EM_tower_eta.push_back(this_cluster_tower_eta);
-      _pflow_EM_tower_phi.push_back(this_cluster_tower_phi);
+      _pflow_EM_tower_offset.push_back(_pflow_EM_tower_eta.size());
 
     }  // close cluster loop
 
@@ -323,9 +466,6 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         std::cout << " HAD topoCluster with E = " << cluster_E << ", eta / phi = " << cluster_eta << " / " << cluster_phi << " , nTow = " << hiter->second->getNTowers() << std::endl;
       }
 
-      std::vector<float> this_cluster_tower_eta;
-      std::vector<float> this_cluster_tower_phi;
-
       // read in towers
       RawCluster::TowerConstRange begin_end_towers = hiter->second->get_towers();
       for (RawCluster::TowerConstIterator iter = begin_end_towers.first; iter != begin_end_towers.second; ++iter)
@@ -334,16 +474,16 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         {
           RawTowerGeom *tower_geom = geomIH->get_tower_geometry(iter->first);
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          _pflow_HAD_tower_phi.push_back(tower_geom->get_phi());
+          _pflow_HAD_tower_eta.push_back(tower_geom->get_eta());
         }
 
         else if (RawTowerDefs::decode_caloid(iter->first) == RawTowerDefs::CalorimeterId::HCALOUT)
         {
           RawTowerGeom *tower_geom = geomOH->get_tower_geometry(iter->first);
 
-          this_cluster_tower_phi.push_back(tower_geom->get_phi());
-          this_cluster_tower_eta.push_back(tower_geom->get_eta());
+          _pflow_HAD_tower_phi.push_back(tower_geom->get_phi());
+          _pflow_HAD_tower_eta.push_back(tower_geom->get_eta());
         }
         else
         {
@@ -353,8 +493,7 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
 
       }  // close tower loop
 
-      _pflow_HAD_tower_eta.push_back(this_cluster_tower_eta);
-      _pflow_HAD_tower_phi.push_back(this_cluster_tower_phi);
+      _pflow_HAD_tower_offset.push_back(_pflow_HAD_tower_eta.size());
 
     }  // close cluster loop
 
@@ -362,6 +501,11 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
 
   // BEGIN LINKING STEP
 
+  // clusters binned by position, so each object is only compared to the clusters around it
+  const EtaPhiGrid gridEM(_pflow_EM_eta, _pflow_EM_phi, 0.2);
+  const EtaPhiGrid gridHAD(_pflow_HAD_eta, _pflow_HAD_phi, 0.5);
+  std::vector<unsigned int> candidates;
+
   // Link TRK -> EM (best match, but keep reserve of others), and TRK -> HAD (best match)
   if (Verbosity() > 2)
   {
@@ -379,7 +523,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     float min_em_dR = 0.2;
     int min_em_index = -1;
 
-    for (unsigned int em = 0; em < _pflow_EM_E.size(); em++)
+    gridEM.find(_pflow_TRK_EMproj_eta[trk], _pflow_TRK_EMproj_phi[trk], candidates);
+    for (unsigned int em : candidates)
     {
       float dR = calculate_dR(_pflow_TRK_EMproj_eta[trk], _pflow_EM_eta[em], _pflow_TRK_EMproj_phi[trk], _pflow_EM_phi[em]);
 
@@ -388,30 +533,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      bool has_overlap = false;
-
-      for (unsigned int tow = 0; tow < _pflow_EM_tower_eta.at(em).size(); tow++)
-      {
-        float tower_eta = _pflow_EM_tower_eta.at(em).at(tow);
-        float tower_phi = _pflow_EM_tower_phi.at(em).at(tow);
-
-        float deta = tower_eta - _pflow_TRK_EMproj_eta[trk];
-        float dphi = tower_phi - _pflow_TRK_EMproj_phi[trk];
-        if (dphi > M_PI)
-        {
-          dphi -= 2 * M_PI;
-        }
-        if (dphi < -M_PI)
-        {
-          dphi += 2 * M_PI;
-        }
-
-        if (fabs(deta) < 0.025 * 2.5 && fabs(dphi) < 0.025 * 2.5)
-        {
-          has_overlap = true;
-          break;
-        }
-      }
+      bool has_overlap = has_tower_overlap(_pflow_EM_tower_eta, _pflow_EM_tower_phi, _pflow_EM_tower_offset, em,
+                                           _pflow_TRK_EMproj_eta[trk], _pflow_TRK_EMproj_phi[trk], 0.025 * 2.5);
 
       if (has_overlap)
       {
@@ -475,7 +598,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     float max_had_pt = 0;
 
     // TODO: sequential linking should better happen here -- i.e. allow EM-matched HAD's into the possible pool
-    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
+    gridHAD.find(_pflow_TRK_HADproj_eta[trk], _pflow_TRK_HADproj_phi[trk], candidates);
+    for (unsigned int had : candidates)
     {
       float dR = calculate_dR(_pflow_TRK_HADproj_eta[trk], _pflow_HAD_eta[had], _pflow_TRK_HADproj_phi[trk], _pflow_HAD_phi[had]);
 
@@ -484,30 +608,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      bool has_overlap = false;
-
-      for (unsigned int tow = 0; tow < _pflow_HAD_tower_eta.at(had).size(); tow++)
-      {
-        float tower_eta = _pflow_HAD_tower_eta.at(had).at(tow);
-        float tower_phi = _pflow_HAD_tower_phi.at(had).at(tow);
-
-        float deta = tower_eta - _pflow_TRK_HADproj_eta[trk];
-        float dphi = tower_phi - _pflow_TRK_HADproj_phi[trk];
-        if (dphi > M_PI)
-        {
-          dphi -= 2 * M_PI;
-        }
-        if (dphi < -M_PI)
-        {
-          dphi += 2 * M_PI;
-        }
-
-        if (fabs(deta) < 0.1 * 1.5 && fabs(dphi) < 0.1 * 1.5)
-        {
-          has_overlap = true;
-          break;
-        }
-      }
+      bool has_overlap = has_tower_overlap(_pflow_HAD_tower_eta, _pflow_HAD_tower_phi, _pflow_HAD_tower_offset, had,
+                                           _pflow_TRK_HADproj_eta[trk], _pflow_TRK_HADproj_phi[trk], 0.1 * 1.5);
 
       if (has_overlap)
       {
@@ -569,7 +671,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
     int min_had_index = -1;
     float max_had_pt = 0;
 
-    for (unsigned int had = 0; had < _pflow_HAD_E.size(); had++)
+    gridHAD.find(_pflow_EM_eta[em], _pflow_EM_phi[em], candidates);
+    for (unsigned int had : candidates)
     {
       float dR = calculate_dR(_pflow_EM_eta[em], _pflow_HAD_eta[had], _pflow_EM_phi[em], _pflow_HAD_phi[had]);
       if (dR > 0.5)
@@ -577,30 +680,8 @@ int ParticleFlowReco::process_event(PHCompositeNode *topNode)
         continue;
       }
 
-      bool has_overlap = false;
-
-      for (unsigned int tow = 0; tow < _pflow_HAD_tower_eta.at(had).size(); tow++)
-      {
-        float tower_eta = _pflow_HAD_tower_eta.at(had).at(tow);
-        float tower_phi = _pflow_HAD_tower_phi.at(had).at(tow);
-
-        float deta = tower_eta - _pflow_EM_eta[em];
-        float dphi = tower_phi - _pflow_EM_phi[em];
-        if (dphi > M_PI)
-        {
-          dphi -= 2 * M_PI;
-        }
-        if (dphi < -M_PI)
-        {
-          dphi += 2 * M_PI;
-        }
-
-        if (fabs(deta) < 0.1 * 1.5 && fabs(dphi) < 0.1 * 1.5)
-        {
-          has_overlap = true;
-          break;
-        }
-      }
+      bool has_overlap = has_tower_overlap(_pflow_HAD_tower_eta, _pflow_HAD_tower_phi, _pflow_HAD_tower_offset, had,
+                                           _pflow_EM_eta[em], _pflow_EM_phi[em], 0.1 * 1.5);
 
       if (has_overlap)
       {
@@ -61,8 +61,10 @@ class ParticleFlowReco : public SubsysReco
   std::vector<float> _pflow_EM_eta;
   std::vector<float> _pflow_EM_phi;
   std::vector<RawCluster *> _pflow_EM_cluster;
-  std::vector<std::vector<float> > _pflow_EM_tower_eta;
-  std::vector<std::vector<float> > _pflow_EM_tower_phi;
+  // towers of all clusters, those of cluster i are in [ _pflow_EM_tower_offset[i], _pflow_EM_tower_offset[i+1] )
+  std::vector<float> _pflow_EM_tower_eta;
+  std::vector<float> _pflow_EM_tower_phi;
+  std::vector<unsigned int> _pflow_EM_tower_offset;
   std::vector<std::vector<int> > _pflow_EM_match_HAD;
   std::vector<std::vector<int> > _pflow_EM_match_TRK;
 
@@ -70,8 +72,9 @@ class ParticleFlowReco : public SubsysReco
   std::vector<float> _pflow_HAD_eta;
   std::vector<float> _pflow_HAD_phi;
   std::vector<RawCluster *> _pflow_HAD_cluster;
-  std::vector<std::vector<float> > _pflow_HAD_tower_eta;
-  std::vector<std::vector<float> > _pflow_HAD_tower_phi;
+  std::vector<float> _pflow_HAD_tower_eta;
+  std::vector<float> _pflow_HAD_tower_phi;
+  std::vector<unsigned int> _pflow_HAD_tower_offset;
   std::vector<std::vector<int> > _pflow_HAD_match_EM;
   std::vector<std::vector<int> > _pflow_HAD_match_TRK;
 
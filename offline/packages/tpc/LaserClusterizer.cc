@@ -1,6 +1,7 @@
 #include "LaserClusterizer.h"
 
 #include "LaserEventInfo.h"
+#include "TpcVoxelGrid.h"
 
 #include <trackbase/LaserCluster.h>
 #include <trackbase/LaserClusterContainer.h>
@@ -10,6 +11,7 @@
 #include <trackbase/RawHitSet.h>
 #include <trackbase/RawHitSetContainer.h>
 #include <trackbase/TpcDefs.h>
+#include <trackbase/TpcSparseFrameContainer.h>
 #include <trackbase/TrkrDefs.h>  // for hitkey, getLayer
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
@@ -37,28 +39,17 @@
 #include <TF1.h>
 #include <TFile.h>
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/index/rtree.hpp>
-
+#include <algorithm>
 #include <array>
 #include <cmath>  // for sqrt, cos, sin
 #include <iostream>
 #include <limits>
 #include <map>  // for _Rb_tree_cons...
+#include <numeric>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
-using point = bg::model::point<float, 3, bg::cs::cartesian>;
-using box = bg::model::box<point>;
-using specHitKey = std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>;
-using pointKeyLaser = std::pair<point, specHitKey>;
-
 LaserClusterizer::LaserClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -180,7 +171,18 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
     std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
-  if (!do_read_raw)
+  m_sparse_frames = nullptr;
+  if (m_read_sparse_frame)
+  {
+    // zero suppressed runs from the unpacker
+    m_sparse_frames = findNode::getClass<TpcSparseFrameContainer>(topNode, "TRKR_TPCSPARSEFRAME");
+    if (!m_sparse_frames)
+    {
+      std::cout << PHWHERE << "ERROR: Can't find node TRKR_TPCSPARSEFRAME" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  else if (!do_read_raw)
   {
     // get node containing the digitized hits
     m_hits = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
@@ -243,7 +245,7 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   TrkrHitSetContainer::ConstRange hitsetrange;
   RawHitSetContainer::ConstRange rawhitsetrange;
-  if (!do_read_raw)
+  if (!m_sparse_frames && !do_read_raw)
   {
     hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
   }
@@ -252,11 +254,9 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
     rawhitsetrange = m_rawhits->getHitSets(TrkrDefs::TrkrId::tpcId);
   }
 
-  bgi::rtree<pointKeyLaser, bgi::quadratic<16>> rtree;
-  std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> adcMap;
-
-  bgi::rtree<pointKeyLaser, bgi::quadratic<16>> rtreeLaminations;
-  std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> adcMapLaminations;
+  // the hits above threshold and their index in the voxel grid, both cluster passes use the same hits
+  std::vector<clusterHit> hits;
+  TpcVoxelGrid grid;
 
   if (!do_read_raw)
   {
@@ -325,26 +325,20 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
       return Fun4AllReturnCodes::EVENT_OK;
     }
 
-    for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-         hitsetitr != hitsetrange.second;
-         ++hitsetitr)
+    // all hits of one hitset, from either the hits or the sparse frames
+    auto add_hits = [&](const TrkrDefs::hitsetkey hitsetkey, TrkrHitSet *hitset, const TpcSparseFrame *sparseframe)
     {
-      TrkrHitSet *hitset = hitsetitr->second;
-      unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-      int side = TpcDefs::getSide(hitsetitr->first);
-      unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
+      unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+      int side = TpcDefs::getSide(hitsetkey);
+      unsigned int sector = TpcDefs::getSectorId(hitsetkey);
       PHG4TpcCylinderGeom *layergeom = m_geom_container->GetLayerCellGeom(layer);
       double r = layergeom->get_radius();
 
       TrkrDefs::hitsetkey hitsetKey = TpcDefs::genHitSetKey(layer, sector, side);
 
-      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-
-      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-           hitr != hitrangei.second;
-           ++hitr)
+      auto add_hit = [&](const uint16_t hitpad, const uint16_t hittbin, const float hitadc)
       {
-        float_t fadc = hitr->second->getAdc();  // proper int rounding +0.5
+        float_t fadc = hitadc;  // proper int rounding +0.5
         unsigned short adc = 0;
         if (fadc > m_adc_threshold)
         {
@@ -352,21 +346,21 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
         }
         if (adc <= m_adc_threshold)
         {
-          continue;
+          return;
         }
 
-        int iphi = TpcDefs::getPad(hitr->first);
-        int it = TpcDefs::getTBin(hitr->first);
+        int iphi = hitpad;
+        int it = hittbin;
 
         // if (side == 0 && fabs(it - itMax_0) > 10)
         if (side == 0 && fabs(it - m_laserEventInfo->getPeakSample(false)) > 3)
         {
-          continue;
+          return;
         }
         // if (side == 1 && fabs(it - itMax_1) > 10)
         if (side == 1 && fabs(it - m_laserEventInfo->getPeakSample(true)) > 3)
         {
-          continue;
+          return;
         }
 
         // std::cout << "iphi: " << iphi << std::endl;
@@ -397,25 +391,52 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
         std::array<int, 3> coords = {(int) layer, iphi, it};
 
-        std::vector<pointKeyLaser> testduplicate;
-        rtree.query(bgi::intersects(box(point(layer - 0.001, iphi - 0.001, it - 0.001),
-                                        point(layer + 0.001, iphi + 0.001, it + 0.001))),
-                    std::back_inserter(testduplicate));
-        if (!testduplicate.empty())
+        // duplicate
+        if (grid.get(layer, iphi, it) != TpcVoxelGrid::EMPTY)
         {
-          testduplicate.clear();
-          continue;
+          return;
         }
 
         TrkrDefs::hitkey hitKey = TpcDefs::genHitKey(iphi, it);
 
         auto spechitkey = std::make_pair(hitKey, hitsetKey);
-        auto keyCoords = std::make_pair(spechitkey, coords);
-        adcMap.insert(std::make_pair(adc, keyCoords));
-        adcMapLaminations.insert(std::make_pair(adc, keyCoords));
+        grid.set(layer, iphi, it, hits.size());
+        hits.push_back({spechitkey, coords, adc, false});
+      };
 
-        rtree.insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
-        rtreeLaminations.insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
+      if (sparseframe)
+      {
+        sparseframe->for_each_hit(add_hit);
+      }
+      else
+      {
+        TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          add_hit(TpcDefs::getPad(hitr->first), TpcDefs::getTBin(hitr->first), hitr->second->getAdc());
+        }
+      }
+    };
+
+    if (m_sparse_frames)
+    {
+      for (const auto &[hitsetkey, sparseframe] : *m_sparse_frames)
+      {
+        if (!sparseframe.empty())
+        {
+          add_hits(hitsetkey, nullptr, &sparseframe);
+        }
+      }
+    }
+    else
+    {
+      for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
+           hitsetitr != hitsetrange.second;
+           ++hitsetitr)
+      {
+        add_hits(hitsetitr->first, hitsetitr->second, nullptr);
       }
     }
   }
@@ -423,96 +444,72 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
   if (Verbosity() > 1)
   {
     std::cout << "finished looping over hits" << std::endl;
-    std::cout << "map size: " << adcMap.size() << std::endl;
-    std::cout << "rtree size: " << rtree.size() << std::endl;
+    std::cout << "number of hits: " << hits.size() << std::endl;
   }
 
-  // done filling rTree
+  // done filling the voxel grid
 
   t_all->restart();
 
-  while (adcMap.size() > 0)
+  // seeds in decreasing adc, for equal adc the later hit first
+  std::vector<unsigned int> seeds(hits.size());
+  std::iota(seeds.begin(), seeds.end(), 0);
+  std::stable_sort(seeds.begin(), seeds.end(), [&hits](const unsigned int a, const unsigned int b)
+                   { return hits[a].adc < hits[b].adc; });
+
+  // the laminations are clustered from all hits again, with a larger box in layer
+  for (const bool isLamination : {false, true})
   {
-    auto iterKey = adcMap.rbegin();
-    if (iterKey == adcMap.rend())
+    const int layerRange = isLamination ? 2 : 1;
+    for (auto &hit : hits)
     {
-      break;
+      hit.removed = false;
     }
 
-    auto coords = iterKey->second.second;
-
-    int layer = coords[0];
-    int iphi = coords[1];
-    int it = coords[2];
-
-    int layerMax = layer + 1;
-    if ((layer <= 22 && layerMax > 22) || (layer > 22 && layer <= 38 && layerMax > 38) || (layer > 38 && layer <= 54 && layerMax > 54))
-    {
-      layerMax = layer;
-    }
-    int layerMin = layer - 1;
-    if ((layer >= 7 && layer <= 22 && layerMin < 7) || (layer >= 23 && layer <= 38 && layerMin < 23) || (layer >= 38 && layer <= 54 && layerMin < 38))
+    std::vector<clusterHit *> clusHits;
+    for (auto iterSeed = seeds.rbegin(); iterSeed != seeds.rend(); ++iterSeed)
     {
-      layerMin = layer;
-    }
-
-    std::vector<pointKeyLaser> clusHits;
-
-    t_search->restart();
-    rtree.query(bgi::intersects(box(point(layerMin, iphi - 2, it - 5), point(layerMax, iphi + 2, it + 5))), std::back_inserter(clusHits));
-    t_search->stop();
+      if (hits[*iterSeed].removed)
+      {
+        continue;
+      }
 
-    t_clus->restart();
-    calc_cluster_parameter(clusHits, adcMap, false);
-    t_clus->stop();
+      const auto &coords = hits[*iterSeed].coords;
 
-    t_erase->restart();
-    remove_hits(clusHits, rtree, adcMap);
-    t_erase->stop();
+      int layer = coords[0];
+      int iphi = coords[1];
+      int it = coords[2];
 
-    clusHits.clear();
-  }
+      int layerMax = layer + layerRange;
+      if ((layer <= 22 && layerMax > 22) || (layer > 22 && layer <= 38 && layerMax > 38) || (layer > 38 && layer <= 54 && layerMax > 54))
+      {
+        layerMax = layer;
+      }
+      int layerMin = layer - layerRange;
+      if ((layer >= 7 && layer <= 22 && layerMin < 7) || (layer >= 23 && layer <= 38 && layerMin < 23) || (layer >= 38 && layer <= 54 && layerMin < 38))
+      {
+        layerMin = layer;
+      }
 
-  while (adcMapLaminations.size() > 0)
-  {
-    auto iterKey = adcMapLaminations.rbegin();
-    if (iterKey == adcMapLaminations.rend())
-    {
-      break;
-    }
+      clusHits.clear();
 
-    auto coords = iterKey->second.second;
+      t_search->restart();
+      grid.for_each_in_box(layerMin, layerMax, iphi - 2, iphi + 2, it - 5, it + 5, [&hits, &clusHits](const int index)
+                           {
+                             if (!hits[index].removed)
+                             {
+                               clusHits.push_back(&hits[index]);
+                             } });
+      t_search->stop();
 
-    int layer = coords[0];
-    int iphi = coords[1];
-    int it = coords[2];
+      t_clus->restart();
+      calc_cluster_parameter(clusHits, isLamination);
+      t_clus->stop();
 
-    int layerMax = layer + 2;
-    if ((layer <= 22 && layerMax > 22) || (layer > 22 && layer <= 38 && layerMax > 38) || (layer > 38 && layer <= 54 && layerMax > 54))
-    {
-      layerMax = layer;
-    }
-    int layerMin = layer - 2;
-    if ((layer >= 7 && layer <= 22 && layerMin < 7) || (layer >= 23 && layer <= 38 && layerMin < 23) || (layer >= 38 && layer <= 54 && layerMin < 38))
-    {
-      layerMin = layer;
+      t_erase->restart();
+      remove_hits(clusHits);
+      t_erase->stop();
     }
-
-    std::vector<pointKeyLaser> clusHitsLaminations;
-
-    t_search->restart();
-    rtreeLaminations.query(bgi::intersects(box(point(layerMin, iphi - 2, it - 5), point(layerMax, iphi + 2, it + 5))), std::back_inserter(clusHitsLaminations));
-    t_search->stop();
-
-    t_clus->restart();
-    calc_cluster_parameter(clusHitsLaminations, adcMapLaminations, true);
-    t_clus->stop();
-
-    t_erase->restart();
-    remove_hits(clusHitsLaminations, rtreeLaminations, adcMapLaminations);
-    t_erase->stop();
-
-    clusHitsLaminations.clear();
   }
 
   if (m_debug)
@@ -534,7 +531,7 @@ int LaserClusterizer::process_event(PHCompositeNode *topNode)
 
   if (Verbosity() > 2)
   {
-    std::cout << "rtree search time: " << t_search->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "search time: " << t_search->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "clustering time: " << t_clus->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "erasing time: " << t_erase->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "total time: " << t_all->get_accumulated_time() / 1000. << " sec" << std::endl;
@@ -563,7 +560,7 @@ int LaserClusterizer::End(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap, bool isLamination)
+void LaserClusterizer::calc_cluster_parameter(const std::vector<clusterHit *> &clusHits, bool isLamination)
 {
   double rSum = 0.0;
   double phiSum = 0.0;
@@ -592,10 +589,10 @@ void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
   double meanIPhi = 0.0;
   double meanIT = 0.0;
 
-  for (auto &clusHit : clusHits)
+  for (const auto *clusHit : clusHits)
   {
-    float coords[3] = {clusHit.first.get<0>(), clusHit.first.get<1>(), clusHit.first.get<2>()};
-    std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> spechitkey = clusHit.second;
+    float coords[3] = {(float) clusHit->coords[0], (float) clusHit->coords[1], (float) clusHit->coords[2]};
+    std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> spechitkey = clusHit->key;
 
     int side = TpcDefs::getSide(spechitkey.second);
     // unsigned int sector= TpcDefs::getSectorId(spechitkey.second);
@@ -618,88 +615,80 @@ void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
     double hitzdriftlength = t * m_tGeometry->get_drift_velocity();
     double hitZ = m_tdriftmax * m_tGeometry->get_drift_velocity() - hitzdriftlength;
 
-    for (auto &iterKey : adcMap)
+    double adc = clusHit->adc;
+
+    bool foundLayer = false;
+    for (float i : usedLayer)
     {
-      if (iterKey.second.first == spechitkey)
+      if (coords[0] == i)
       {
-        double adc = iterKey.first;
-
-        bool foundLayer = false;
-        for (float i : usedLayer)
-        {
-          if (coords[0] == i)
-          {
-            foundLayer = true;
-            break;
-          }
-        }
-
-        if (!foundLayer)
-        {
-          usedLayer.push_back(coords[0]);
-        }
+        foundLayer = true;
+        break;
+      }
+    }
 
-        bool foundIPhi = false;
-        for (float i : usedIPhi)
-        {
-          if (coords[1] == i)
-          {
-            foundIPhi = true;
-            break;
-          }
-        }
+    if (!foundLayer)
+    {
+      usedLayer.push_back(coords[0]);
+    }
 
-        if (!foundIPhi)
-        {
-          usedIPhi.push_back(coords[1]);
-        }
+    bool foundIPhi = false;
+    for (float i : usedIPhi)
+    {
+      if (coords[1] == i)
+      {
+        foundIPhi = true;
+        break;
+      }
+    }
 
-        bool foundIT = false;
-        for (float i : usedIT)
-        {
-          if (coords[2] == i)
-          {
-            foundIT = true;
-            break;
-          }
-        }
+    if (!foundIPhi)
+    {
+      usedIPhi.push_back(coords[1]);
+    }
 
-        if (!foundIT)
-        {
-          usedIT.push_back(coords[2]);
-        }
+    bool foundIT = false;
+    for (float i : usedIT)
+    {
+      if (coords[2] == i)
+      {
+        foundIT = true;
+        break;
+      }
+    }
 
-        clus->addHit();
-        clus->setHitLayer(clus->getNhits() - 1, coords[0]);
-        clus->setHitIPhi(clus->getNhits() - 1, coords[1]);
-        clus->setHitIT(clus->getNhits() - 1, coords[2]);
-        clus->setHitX(clus->getNhits() - 1, r * cos(phi));
-        clus->setHitY(clus->getNhits() - 1, r * sin(phi));
-        clus->setHitZ(clus->getNhits() - 1, hitZ);
-        clus->setHitAdc(clus->getNhits() - 1, (float) adc);
+    if (!foundIT)
+    {
+      usedIT.push_back(coords[2]);
+    }
 
-        rSum += r * adc;
-        phiSum += phi * adc;
-        tSum += t * adc;
+    clus->addHit();
+    clus->setHitLayer(clus->getNhits() - 1, coords[0]);
+    clus->setHitIPhi(clus->getNhits() - 1, coords[1]);
+    clus->setHitIT(clus->getNhits() - 1, coords[2]);
+    clus->setHitX(clus->getNhits() - 1, r * cos(phi));
+    clus->setHitY(clus->getNhits() - 1, r * sin(phi));
+    clus->setHitZ(clus->getNhits() - 1, hitZ);
+    clus->setHitAdc(clus->getNhits() - 1, (float) adc);
 
-        layerSum += coords[0] * adc;
-        iphiSum += coords[1] * adc;
-        itSum += coords[2] * adc;
+    rSum += r * adc;
+    phiSum += phi * adc;
+    tSum += t * adc;
 
-        meanLayer += coords[0];
-        meanIPhi += coords[1];
-        meanIT += coords[2];
+    layerSum += coords[0] * adc;
+    iphiSum += coords[1] * adc;
+    itSum += coords[2] * adc;
 
-        adcSum += adc;
+    meanLayer += coords[0];
+    meanIPhi += coords[1];
+    meanIT += coords[2];
 
-        if (adc > maxAdc)
-        {
-          maxAdc = adc;
-          maxKey = spechitkey.second;
-        }
+    adcSum += adc;
 
-        break;
-      }
+    if (adc > maxAdc)
+    {
+      maxAdc = adc;
+      maxKey = spechitkey.second;
     }
   }
 
@@ -781,25 +770,10 @@ void LaserClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
   }
 }
 
-void LaserClusterizer::remove_hits(std::vector<pointKeyLaser> &clusHits, bgi::rtree<pointKeyLaser, bgi::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap)
+void LaserClusterizer::remove_hits(const std::vector<clusterHit *> &clusHits)
 {
-  for (auto &clusHit : clusHits)
+  for (auto *clusHit : clusHits)
   {
-    auto spechitkey = clusHit.second;
-
-    rtree.remove(clusHit);
-
-    for (auto iterAdc = adcMap.begin(); iterAdc != adcMap.end();)
-    {
-      if (iterAdc->second.first == spechitkey)
-      {
-        iterAdc = adcMap.erase(iterAdc);
-        break;
-      }
-      else
-      {
-        ++iterAdc;
-      }
-    }
+    clusHit->removed = true;
   }
 }
@@ -13,12 +13,7 @@
 #include <TH1I.h>
 #include <TTree.h>
 
-// BOOST for combi seeding
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/index/rtree.hpp>
-
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
@@ -32,16 +27,23 @@ class TrkrHitSet;
 class TrkrHitSetContainer;
 class RawHitSet;
 class RawHitSetContainer;
+class TpcSparseFrameContainer;
 class PHG4TpcCylinderGeom;
 class PHG4TpcCylinderGeomContainer;
 
 class LaserClusterizer : public SubsysReco
 {
  public:
-  typedef boost::geometry::model::point<float, 3, boost::geometry::cs::cartesian> point;
-  typedef boost::geometry::model::box<point> box;
   typedef std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> specHitKey;
-  typedef std::pair<point, specHitKey> pointKeyLaser;
+
+  //! hit above threshold, coords are layer, pad and time bin (negative on side 0)
+  struct clusterHit
+  {
+    specHitKey key;
+    std::array<int, 3> coords;
+    unsigned int adc;
+    bool removed;
+  };
 
   LaserClusterizer(const std::string &name = "LaserClusterizer");
   ~LaserClusterizer() override = default;
@@ -51,10 +53,8 @@ class LaserClusterizer : public SubsysReco
   int ResetEvent(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
-  // void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int,std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap);
-  void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap, bool isLamination);
-  // void remove_hits(std::vector<pointKeyLaser> &clusHits,  boost::geometry::index::rtree<pointKeyLaser, boost::geometry::index::quadratic<16> > &rtree, std::multimap <unsigned int, std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap, std::multimap <unsigned int, float*> &adcCoords);
-  void remove_hits(std::vector<pointKeyLaser> &clusHits, boost::geometry::index::rtree<pointKeyLaser, boost::geometry::index::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap);
+  void calc_cluster_parameter(const std::vector<clusterHit *> &clusHits, bool isLamination);
+  void remove_hits(const std::vector<clusterHit *> &clusHits);
 
   void set_debug(bool debug) { m_debug = debug; }
   void set_debug_name(const std::string &name) { m_debugFileName = name; }
@@ -63,6 +63,8 @@ class LaserClusterizer : public SubsysReco
   void set_min_clus_size(float val) { min_clus_size = val; }
   void set_min_adc_sum(float val) { min_adc_sum = val; }
   void set_max_time_samples(int val) { m_time_samples_max = val; }
+  //! read the zero suppressed runs of TpcCombinedRawDataUnpacker::setSparseFrame() from TRKR_TPCSPARSEFRAME
+  void set_read_sparse_frame(bool val) { m_read_sparse_frame = val; }
 
  private:
   int m_event {-1};
@@ -74,6 +76,7 @@ class LaserClusterizer : public SubsysReco
 
   TrkrHitSetContainer *m_hits {nullptr};
   RawHitSetContainer *m_rawhits {nullptr};
+  TpcSparseFrameContainer *m_sparse_frames {nullptr};
   LaserClusterContainer *m_clusterlist {nullptr};
   LaserClusterContainer *m_clusterlistLaminations {nullptr};
   ActsGeometry *m_tGeometry {nullptr};
@@ -87,6 +90,7 @@ class LaserClusterizer : public SubsysReco
   double NZBinsSide {249};
 
   bool do_read_raw {false};
+  bool m_read_sparse_frame {false};
 
   // TPC shaping offset correction parameter
   // From Tony Frawley July 5, 2022
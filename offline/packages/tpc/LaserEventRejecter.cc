@@ -4,6 +4,7 @@
 
 #include <ffaobjects/EventHeader.h>
 #include <fun4all/Fun4AllReturnCodes.h>
+#include <fun4all/Fun4AllServer.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 
 #include <phool/PHCompositeNode.h>
@@ -23,6 +24,12 @@ int LaserEventRejecter::process_event(PHCompositeNode *topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  if (!m_laserClass.empty())
+  {
+    Fun4AllServer::instance()->SetEventClass(m_laserEventInfo->isLaserEvent() ? m_laserClass : m_noLaserClass);
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   if(m_laserEventInfo->isLaserEvent())
   {
     return Fun4AllReturnCodes::ABORTEVENT;
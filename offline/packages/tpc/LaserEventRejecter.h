@@ -3,6 +3,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <string>
+
 class LaserEventInfo;
 class PHCompositeNode;
 
@@ -14,8 +16,20 @@ class LaserEventRejecter : public SubsysReco
 
   int process_event(PHCompositeNode *topNode) override;
 
+  //! tag the events with Fun4AllServer event classes instead of rejecting the laser events
+  /*! register with Fun4AllServer::registerFilter() and select the modules with
+      Fun4AllServer::RequireEventClass(), e.g. the laser clusterizer on laserclass */
+  void TagEvents(const std::string &laserclass = "LASER", const std::string &nolaserclass = "NOLASER")
+  {
+    m_laserClass = laserclass;
+    m_noLaserClass = nolaserclass;
+  }
+
  private:
   LaserEventInfo *m_laserEventInfo = nullptr;
+
+  std::string m_laserClass;
+  std::string m_noLaserClass;
 };
 
 #endif
@@ -1,4 +1,5 @@
 #include "Tpc3DClusterizer.h"
+#include "TpcVoxelGrid.h"
 
 #include <trackbase/LaserCluster.h>
 #include <trackbase/LaserClusterContainer.h>
@@ -32,28 +33,17 @@
 #include <TF1.h>
 #include <TFile.h>
 
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/index/rtree.hpp>
-
+#include <algorithm>
 #include <array>
 #include <cmath>  // for sqrt, cos, sin
 #include <iostream>
 #include <limits>
 #include <map>  // for _Rb_tree_cons...
+#include <numeric>
 #include <string>
 #include <utility>  // for pair
 #include <vector>
 
-namespace bg = boost::geometry;
-namespace bgi = boost::geometry::index;
-
-using point = bg::model::point<float, 3, bg::cs::cartesian>;
-using box = bg::model::box<point>;
-using specHitKey = std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>;
-using pointKeyLaser = std::pair<point, specHitKey>;
-
 Tpc3DClusterizer::Tpc3DClusterizer(const std::string &name)
   : SubsysReco(name)
 {
@@ -186,16 +176,13 @@ int Tpc3DClusterizer::process_event(PHCompositeNode *topNode)
   TrkrHitSetContainer::ConstRange hitsetrange;
   hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
 
-  bgi::rtree<pointKeyLaser, bgi::quadratic<16>> rtree;
-  bgi::rtree<pointKeyLaser, bgi::quadratic<16>> rtree_reject;
+  // number of hits in each voxel (both sides share the voxels), for the isolation test
+  TpcVoxelGrid rejectgrid;
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
        hitsetitr != hitsetrange.second;
        ++hitsetitr){
     TrkrHitSet *hitset = hitsetitr->second;
     unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-    int side = TpcDefs::getSide(hitsetitr->first);
-    unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
-    TrkrDefs::hitsetkey hitsetKey = TpcDefs::genHitSetKey(layer, sector, side);
 
     TrkrHitSet::ConstRange hitrangei = hitset->getHits();
     for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
@@ -212,24 +199,15 @@ int Tpc3DClusterizer::process_event(PHCompositeNode *topNode)
       if (adc <= 0){
 	continue;
       }
-      
-      std::vector<pointKeyLaser> testduplicate;
-      rtree.query(bgi::intersects(box(point(layer - 0.001, iphi - 0.001, it - 0.001),
-				      point(layer + 0.001, iphi + 0.001, it + 0.001))),
-		  std::back_inserter(testduplicate));
-      if (!testduplicate.empty()){
-	testduplicate.clear();
-	continue;
-      }
 
-      TrkrDefs::hitkey hitKey = TpcDefs::genHitKey(iphi, it);
-      
-      auto spechitkey = std::make_pair(hitKey, hitsetKey);
-      rtree_reject.insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
+      const int nvoxel = rejectgrid.get(layer, iphi, it);
+      rejectgrid.set(layer, iphi, it, (nvoxel == TpcVoxelGrid::EMPTY) ? 1 : nvoxel + 1);
     }
   }
   
-  std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> adcMap;
+  // the hits to cluster and their index in the voxel grid
+  std::vector<clusterHit> hits;
+  TpcVoxelGrid grid;
   //  std::cout << "n hitsets: " << std::distance(hitsetrange.first,hitsetrange.second)
   //          << std::endl;
   for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
@@ -280,52 +258,50 @@ int Tpc3DClusterizer::process_event(PHCompositeNode *topNode)
       */
       std::array<int, 3> coords = {(int) layer, iphi, it};
       
-      std::vector<pointKeyLaser> testduplicate;
-      rtree.query(bgi::intersects(box(point(layer - 0.001, iphi - 0.001, it - 0.001),
-				      point(layer + 0.001, iphi + 0.001, it + 0.001))),
-		  std::back_inserter(testduplicate));
-      if (!testduplicate.empty()){
-	testduplicate.clear();
+      // duplicate
+      if (grid.get(layer, iphi, it) != TpcVoxelGrid::EMPTY){
 	continue;
       }
       
       //test for isolated hit
-      std::vector<pointKeyLaser> testisolated;
-      rtree_reject.query(bgi::intersects(box(point(layer - 1.001, iphi - 1.001, it - 1.001),
-				      point(layer + 1.001, iphi + 1.001, it + 1.001))),
-		  std::back_inserter(testisolated));
-      if(testisolated.size()==1){
-	//testisolated.clear();
+      int nisolated = 0;
+      rejectgrid.for_each_in_box(layer - 1, layer + 1, iphi - 1, iphi + 1, it - 1, it + 1,
+				 [&nisolated](const int nvoxel) { nisolated += nvoxel; });
+      if(nisolated==1){
 	continue;
       }
       
       TrkrDefs::hitkey hitKey = TpcDefs::genHitKey(iphi, it);
       
       auto spechitkey = std::make_pair(hitKey, hitsetKey);
-      auto keyCoords = std::make_pair(spechitkey, coords);
-      adcMap.insert(std::make_pair(adc, keyCoords));
       // std::cout << "inserting " << " l: " << layer << " iphi: " <<iphi << " t: " << it << std::endl;
-      rtree.insert(std::make_pair(point(1.0 * layer, 1.0 * iphi, 1.0 * it), spechitkey));
+      grid.set(layer, iphi, it, hits.size());
+      hits.push_back({spechitkey, coords, adc, false});
     }
   }
   
   if (Verbosity() > 1){
     std::cout << "finished looping over hits" << std::endl;
-    std::cout << "map size: " << adcMap.size() << std::endl;
-    std::cout << "rtree size: " << rtree.size() << std::endl;
+    std::cout << "number of hits: " << hits.size() << std::endl;
   }
   
-  // done filling rTree
+  // done filling the voxel grid
   
   t_all->restart();
   
-  while (adcMap.size() > 0){
-    auto iterKey = adcMap.rbegin();
-    if (iterKey == adcMap.rend()){
-      break;
+  // seeds in decreasing adc, for equal adc the later hit first
+  std::vector<unsigned int> seeds(hits.size());
+  std::iota(seeds.begin(), seeds.end(), 0);
+  std::stable_sort(seeds.begin(), seeds.end(), [&hits](const unsigned int a, const unsigned int b)
+		   { return hits[a].adc < hits[b].adc; });
+
+  std::vector<clusterHit *> clusHits;
+  for (auto iterSeed = seeds.rbegin(); iterSeed != seeds.rend(); ++iterSeed){
+    if (hits[*iterSeed].removed){
+      continue;
     }
     
-    auto coords = iterKey->second.second;
+    const auto &coords = hits[*iterSeed].coords;
 
     int layer = coords[0];
     int iphi = coords[1];
@@ -340,21 +316,21 @@ int Tpc3DClusterizer::process_event(PHCompositeNode *topNode)
       layerMin = layer;
     }
     
-    std::vector<pointKeyLaser> clusHits;
+    clusHits.clear();
 
+    // hits of earlier clusters are kept, they count for the size and extent of the cluster
     t_search->restart();
-    rtree.query(bgi::intersects(box(point(layerMin, iphi - 2, it - 5), point(layerMax, iphi + 2, it + 5))), std::back_inserter(clusHits));
+    grid.for_each_in_box(layerMin, layerMax, iphi - 2, iphi + 2, it - 5, it + 5,
+			 [&hits, &clusHits](const int index) { clusHits.push_back(&hits[index]); });
     t_search->stop();
 
     t_clus->restart();
-    calc_cluster_parameter(clusHits, adcMap);
+    calc_cluster_parameter(clusHits);
     t_clus->stop();
 
     t_erase->restart();
-    remove_hits(clusHits, rtree, adcMap);
+    remove_hits(clusHits);
     t_erase->stop();
-
-    clusHits.clear();
   }
 
   if (m_debug){
@@ -372,7 +348,7 @@ int Tpc3DClusterizer::process_event(PHCompositeNode *topNode)
   }
   
   if (Verbosity()){
-    std::cout << "rtree search time: " << t_search->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "search time: " << t_search->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "clustering time: " << t_clus->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "erasing time: " << t_erase->get_accumulated_time() / 1000. << " sec" << std::endl;
     std::cout << "total time: " << t_all->get_accumulated_time() / 1000. << " sec" << std::endl;
@@ -412,7 +388,7 @@ int Tpc3DClusterizer::End(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void Tpc3DClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap)
+void Tpc3DClusterizer::calc_cluster_parameter(const std::vector<clusterHit *> &clusHits)
 {
   //std::cout << "nu clus" << std::endl;
   double rSum = 0.0;
@@ -434,10 +410,10 @@ void Tpc3DClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
   float itmin = 66666666.6, itmax = -6666666666.6;
   auto *clus = new LaserClusterv1;
 
-  for (auto &clusHit : clusHits)
+  for (const auto *clusHit : clusHits)
   {
-    float coords[3] = {clusHit.first.get<0>(), clusHit.first.get<1>(), clusHit.first.get<2>()};
-    std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> spechitkey = clusHit.second;
+    float coords[3] = {(float) clusHit->coords[0], (float) clusHit->coords[1], (float) clusHit->coords[2]};
+    std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> spechitkey = clusHit->key;
 
     //    int side = TpcDefs::getSide(spechitkey.second);
     // unsigned int sector= TpcDefs::getSectorId(spechitkey.second);
@@ -464,39 +440,35 @@ void Tpc3DClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
     if(tbin<itmin){itmin = tbin;}
     if(tbin>itmax){itmax = tbin;}
 
-    for (auto &iterKey : adcMap)
+    if (clusHit->removed)
     {
-      if (iterKey.second.first == spechitkey)
-      {
-        double adc = iterKey.first;
-
-        clus->addHit();
-        clus->setHitLayer(clus->getNhits() - 1, coords[0]);
-        clus->setHitIPhi(clus->getNhits() - 1, coords[1]);
-        clus->setHitIT(clus->getNhits() - 1, coords[2]);
-        clus->setHitX(clus->getNhits() - 1, r * cos(phi));
-        clus->setHitY(clus->getNhits() - 1, r * sin(phi));
-        clus->setHitZ(clus->getNhits() - 1, hitZ);
-        clus->setHitAdc(clus->getNhits() - 1, (float) adc);
-
-        rSum += r * adc;
-        phiSum += phi * adc;
-        tSum += t * adc;
-
-        layerSum += coords[0] * adc;
-        iphiSum += coords[1] * adc;
-        itSum += coords[2] * adc;
-
-        adcSum += adc;
-
-        if (adc > maxAdc)
-        {
-          maxAdc = adc;
-          maxKey = spechitkey.second;
-        }
-
-        break;
-      }
+      continue;
+    }
+    double adc = clusHit->adc;
+
+    clus->addHit();
+    clus->setHitLayer(clus->getNhits() - 1, coords[0]);
+    clus->setHitIPhi(clus->getNhits() - 1, coords[1]);
+    clus->setHitIT(clus->getNhits() - 1, coords[2]);
+    clus->setHitX(clus->getNhits() - 1, r * cos(phi));
+    clus->setHitY(clus->getNhits() - 1, r * sin(phi));
+    clus->setHitZ(clus->getNhits() - 1, hitZ);
+    clus->setHitAdc(clus->getNhits() - 1, (float) adc);
+
+    rSum += r * adc;
+    phiSum += phi * adc;
+    tSum += t * adc;
+
+    layerSum += coords[0] * adc;
+    iphiSum += coords[1] * adc;
+    itSum += coords[2] * adc;
+
+    adcSum += adc;
+
+    if (adc > maxAdc)
+    {
+      maxAdc = adc;
+      maxKey = spechitkey.second;
     }
   }
 
@@ -584,28 +556,10 @@ void Tpc3DClusterizer::calc_cluster_parameter(std::vector<pointKeyLaser> &clusHi
     // }
 }
 
-void Tpc3DClusterizer::remove_hits(std::vector<pointKeyLaser> &clusHits, bgi::rtree<pointKeyLaser, bgi::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap)
+void Tpc3DClusterizer::remove_hits(const std::vector<clusterHit *> &clusHits)
 {
-  for (auto &clusHit : clusHits)
+  for (auto *clusHit : clusHits)
   {
-    auto spechitkey = clusHit.second;
-
-    if(rtree.size()==0){
-      std::cout << "not good" << std::endl;
-    }
-    //rtree.remove(clusHit);
-
-    for (auto iterAdc = adcMap.begin(); iterAdc != adcMap.end();)
-    {
-      if (iterAdc->second.first == spechitkey)
-      {
-        iterAdc = adcMap.erase(iterAdc);
-        break;
-      }
-      else
-      {
-        ++iterAdc;
-      }
-    }
+    clusHit->removed = true;
   }
 }
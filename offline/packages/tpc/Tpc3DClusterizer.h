@@ -13,12 +13,7 @@
 #include <TTree.h>
 #include <TNtuple.h>
 
-// BOOST for combi seeding
-#include <boost/geometry.hpp>
-#include <boost/geometry/geometries/box.hpp>
-#include <boost/geometry/geometries/point.hpp>
-#include <boost/geometry/index/rtree.hpp>
-
+#include <array>
 #include <map>
 #include <string>
 #include <vector>
@@ -34,10 +29,16 @@ class PHG4TpcCylinderGeomContainer;
 class Tpc3DClusterizer : public SubsysReco
 {
  public:
-typedef boost::geometry::model::point<float, 3, boost::geometry::cs::cartesian> point;
-typedef boost::geometry::model::box<point> box;
 typedef std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey> specHitKey;
-typedef std::pair<point, specHitKey> pointKeyLaser;
+
+  //! hit which is not isolated, coords are layer, pad and time bin
+  struct clusterHit
+  {
+    specHitKey key;
+    std::array<int, 3> coords;
+    unsigned int adc;
+    bool removed;
+  };
 
   Tpc3DClusterizer(const std::string &name = "Tpc3DClusterizer");
   ~Tpc3DClusterizer() override = default;
@@ -47,10 +48,9 @@ typedef std::pair<point, specHitKey> pointKeyLaser;
   int ResetEvent(PHCompositeNode *topNode) override;
   int End(PHCompositeNode *topNode) override;
 
-  // void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int,std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap);
-  void calc_cluster_parameter(std::vector<pointKeyLaser> &clusHits, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap);
-  // void remove_hits(std::vector<pointKeyLaser> &clusHits,  boost::geometry::index::rtree<pointKeyLaser, boost::geometry::index::quadratic<16> > &rtree, std::multimap <unsigned int, std::pair<TrkrDefs::hitkey,TrkrDefs::hitsetkey>> &adcMap, std::multimap <unsigned int, float*> &adcCoords);
-  void remove_hits(std::vector<pointKeyLaser> &clusHits, boost::geometry::index::rtree<pointKeyLaser, boost::geometry::index::quadratic<16>> &rtree, std::multimap<unsigned int, std::pair<std::pair<TrkrDefs::hitkey, TrkrDefs::hitsetkey>, std::array<int, 3>>> &adcMap);
+  //! clusHits are all hits in the box of the seed, the ones removed by earlier clusters only count for size and extent
+  void calc_cluster_parameter(const std::vector<clusterHit *> &clusHits);
+  void remove_hits(const std::vector<clusterHit *> &clusHits);
 
   void set_debug(bool debug) { m_debug = debug; }
   void set_debug_name(const std::string &name) { m_debugFileName = name; }
@@ -12,7 +12,7 @@
 #include <trackbase/ClusHitsVerbosev1.h>
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrClusterContainerv4.h>
-#include <trackbase/TrkrClusterHitAssocv3.h>
+#include <trackbase/TrkrClusterHitAssocv4.h>
 #include <trackbase/TrkrClusterv3.h>
 #include <trackbase/TrkrClusterv4.h>
 #include <trackbase/TrkrClusterv5.h>
@@ -20,6 +20,8 @@
 #include <trackbase/TrkrHit.h>
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
+#include <trackbase/TrkrHitSetTpc.h>
+#include <trackbase/TpcSparseFrameContainer.h>
 #include <trackbase/alignmentTransformationContainer.h>
 
 #include <trackbase/RawHit.h>
@@ -41,6 +43,8 @@
 #include <phool/PHNode.h>        // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
+#include <phool/PHTrace.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -58,8 +62,6 @@
 #include <string>
 #include <utility>  // for pair
 #include <vector>
-// Terra incognita....
-#include <pthread.h>
 
 namespace
 {
@@ -92,6 +94,7 @@ namespace
     PHG4TpcCylinderGeom *layergeom = nullptr;
     TrkrHitSet *hitset = nullptr;
     RawHitSet *rawhitset = nullptr;
+    const TpcSparseFrame *sparseframe = nullptr;
     ActsGeometry *tGeometry = nullptr;
     unsigned int layer = 0;
     int side = 0;
@@ -128,8 +131,6 @@ namespace
     vec_dVerbose zvec_ClusHitsVerbose;    // only fill if fillClusHitsVerbose
   };
 
-  pthread_mutex_t mythreadlock;
-
   void remove_hit(double adc, int phibin, int tbin, int edge, std::multimap<unsigned short, ihit> &all_hit_map, std::vector<std::vector<unsigned short>> &adcval)
   {
     using hit_iterator = std::multimap<unsigned short, ihit>::iterator;
@@ -782,6 +783,7 @@ namespace
 
   void ProcessSectorData(thread_data *my_data)
   {
+    PHTRACE_SCOPE("TpcClusterizer::sector");
     const auto &pedestal = my_data->pedestal;
     const auto &phibins = my_data->phibins;
     const auto &phioffset = my_data->phioffset;
@@ -812,55 +814,43 @@ namespace
       }
     }
 
-    if (my_data->hitset != nullptr)
+    if (my_data->hitset != nullptr || my_data->sparseframe != nullptr)
     {
-      TrkrHitSet *hitset = my_data->hitset;
-      TrkrHitSet::ConstRange hitrangei = hitset->getHits();
-
-      for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
-           hitr != hitrangei.second;
-           ++hitr)
+      // global pad and time bin of a hit
+      auto add_hit = [&](const uint16_t hitpad, const uint16_t hittbin, const float hitadc)
       {
-        if (TpcDefs::getPad(hitr->first) - phioffset < 0)
+        if (hitpad - phioffset < 0)
         {
-          // std::cout << "WARNING phibin out of range: " << TpcDefs::getPad(hitr->first) - phioffset << " | " << phibins << std::endl;
-          continue;
+          // std::cout << "WARNING phibin out of range: " << hitpad - phioffset << " | " << phibins << std::endl;
+          return;
         }
-        if (TpcDefs::getTBin(hitr->first) - toffset < 0)
+        if (hittbin - toffset < 0)
         {
-          // std::cout << "WARNING tbin out of range: " << TpcDefs::getTBin(hitr->first) - toffset  << " | " << tbins <<std::endl;
+          // std::cout << "WARNING tbin out of range: " << hittbin - toffset  << " | " << tbins <<std::endl;
         }
-        unsigned short phibin = TpcDefs::getPad(hitr->first) - phioffset;
-        unsigned short tbin = TpcDefs::getTBin(hitr->first) - toffset;
-        unsigned short tbinorg = TpcDefs::getTBin(hitr->first);
+        unsigned short phibin = hitpad - phioffset;
+        unsigned short tbin = hittbin - toffset;
+        unsigned short tbinorg = hittbin;
         if (phibin >= phibins)
         {
           // std::cout << "WARNING phibin out of range: " << phibin << " | " << phibins << std::endl;
-          continue;
+          return;
         }
         if (tbin >= tbins)
         {
           // std::cout << "WARNING z bin out of range: " << tbin << " | " << tbins << std::endl;
-          continue;
+          return;
         }
         if (tbinorg > tbinmax || tbinorg < tbinmin)
         {
-          continue;
+          return;
         }
-        float_t fadc = (hitr->second->getAdc()) - pedestal;  // proper int rounding +0.5
+        float_t fadc = hitadc - pedestal;  // proper int rounding +0.5
         unsigned short adc = 0;
         if (fadc > 0)
         {
           adc = (unsigned short) fadc;
         }
-        if (phibin >= phibins)
-        {
-          continue;
-        }
-        if (tbin >= tbins)
-        {
-          continue;  // tbin is unsigned int, <0 cannot happen
-        }
 
         if (adc > 0)
         {
@@ -879,6 +869,41 @@ namespace
             adcval[phibin][tbin] = (unsigned short) adc;
           }
         }
+      };
+
+      TrkrHitSet *hitset = my_data->hitset;
+      if (my_data->sparseframe != nullptr)
+      {
+        // runs of time bins from TpcCombinedRawDataUnpacker, pad major like the hit keys
+        my_data->sparseframe->for_each_hit(add_hit);
+      }
+      else if (TrkrHitSetTpc *frame = dynamic_cast<TrkrHitSetTpc *>(hitset))
+      {
+        // dense frame from TpcCombinedRawDataUnpacker, pad major like the hit keys
+        const TrkrHitSetTpc::TimeFrameADCDataType &frameadc = frame->getTimeFrameAdcData();
+        const uint16_t padstart = frame->getPadIndexStart();
+        const uint16_t tbinstart = frame->getTBinIndexStart();
+        for (unsigned int ipad = 0; ipad < frameadc.size(); ++ipad)
+        {
+          const std::vector<TpcDefs::ADCDataType> &padadc = frameadc[ipad];
+          for (unsigned int it = 0; it < padadc.size(); ++it)
+          {
+            if (padadc[it] > 0)
+            {
+              add_hit(padstart + ipad, tbinstart + it, padadc[it]);
+            }
+          }
+        }
+      }
+      else
+      {
+        TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+        for (TrkrHitSet::ConstIterator hitr = hitrangei.first;
+             hitr != hitrangei.second;
+             ++hitr)
+        {
+          add_hit(TpcDefs::getPad(hitr->first), TpcDefs::getTBin(hitr->first), hitr->second->getAdc());
+        }
       }
     }
     else if (my_data->rawhitset != nullptr)
@@ -1075,12 +1100,6 @@ namespace
     */
     // pthread_exit(nullptr);
   }
-  void *ProcessSector(void *threadarg)
-  {
-    auto my_data = static_cast<thread_data *>(threadarg);
-    ProcessSectorData(my_data);
-    pthread_exit(nullptr);
-  }
 }  // namespace
 
 TpcClusterizer::TpcClusterizer(const std::string &name)
@@ -1089,6 +1108,8 @@ TpcClusterizer::TpcClusterizer(const std::string &name)
 {
 }
 
+TpcClusterizer::~TpcClusterizer() = default;
+
 bool TpcClusterizer::is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const
 {
   bool reject_it = false;
@@ -1163,7 +1184,7 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
       dstNode->addNode(DetNode);
     }
 
-    clusterhitassoc = new TrkrClusterHitAssocv3;
+    clusterhitassoc = new TrkrClusterHitAssocv4;
     PHIODataNode<PHObject> *newNode = new PHIODataNode<PHObject>(clusterhitassoc, "TRKR_CLUSTERHITASSOC", "PHObject");
     DetNode->addNode(newNode);
   }
@@ -1229,6 +1250,16 @@ int TpcClusterizer::InitRun(PHCompositeNode *topNode)
     }
   }
 
+  // start the worker threads once, they are reused for every event
+  if (!do_sequential && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << "clustering with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -1253,13 +1284,24 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     std::cout << PHWHERE << "DST Node missing, doing nothing." << std::endl;
     return Fun4AllReturnCodes::ABORTRUN;
   }
-  if (!do_read_raw)
+  if (m_read_sparse_frame)
   {
-    // get node containing the digitized hits
-    m_hits = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_HITSET");
+    // zero suppressed runs from the unpacker
+    m_sparse_frames = findNode::getClass<TpcSparseFrameContainer>(topNode, "TRKR_TPCSPARSEFRAME");
+    if (!m_sparse_frames)
+    {
+      std::cout << PHWHERE << "ERROR: Can't find node TRKR_TPCSPARSEFRAME" << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+  }
+  else if (!do_read_raw)
+  {
+    // get node containing the digitized hits, or their dense frames
+    const std::string hitnodename = m_read_frame ? "TRKR_TPCFRAME" : "TRKR_HITSET";
+    m_hits = findNode::getClass<TrkrHitSetContainer>(topNode, hitnodename);
     if (!m_hits)
     {
-      std::cout << PHWHERE << "ERROR: Can't find node TRKR_HITSET" << std::endl;
+      std::cout << PHWHERE << "ERROR: Can't find node " << hitnodename << std::endl;
       return Fun4AllReturnCodes::ABORTRUN;
     }
   }
@@ -1330,7 +1372,11 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
   RawHitSetContainer::ConstRange rawhitsetrange;
   int num_hitsets = 0;
 
-  if (!do_read_raw)
+  if (m_read_sparse_frame)
+  {
+    num_hitsets = std::distance(m_sparse_frames->begin(), m_sparse_frames->end());
+  }
+  else if (!do_read_raw)
   {
     hitsetrange = m_hits->getHitSets(TrkrDefs::TrkrId::tpcId);
     num_hitsets = std::distance(hitsetrange.first, hitsetrange.second);
@@ -1341,71 +1387,52 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
     num_hitsets = std::distance(rawhitsetrange.first, rawhitsetrange.second);
   }
 
-  // create structure to store given thread and associated data
-  struct thread_pair_t
-  {
-    pthread_t thread{};
-    thread_data data;
-  };
-
-  // create vector of thread pairs and reserve the right size upfront to avoid reallocation
-  std::vector<thread_pair_t> threads;
-  threads.reserve(num_hitsets);
-
-  pthread_attr_t attr;
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  if (pthread_mutex_init(&mythreadlock, nullptr) != 0)
-  {
-    std::cout << std::endl
-              << " mutex init failed" << std::endl;
-    return 1;
-  }
-//  int count = 0;
+  // one data block per hitset, each task only writes into its own block
+  // so the results can be merged afterwards without locking.
+  // reserve the right size upfront to avoid reallocation
+  std::vector<thread_data> sectors;
+  sectors.reserve(num_hitsets);
 
   if (!do_read_raw)
   {
-    for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
-         hitsetitr != hitsetrange.second;
-         ++hitsetitr)
+    // one data block per hitset, from either the hits or the sparse frames
+    auto add_sector = [&](const TrkrDefs::hitsetkey hitsetkey, TrkrHitSet *hitset, const TpcSparseFrame *sparseframe)
     {
-      // if(count>0)continue;
-      TrkrHitSet *hitset = hitsetitr->second;
-      unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
-      int side = TpcDefs::getSide(hitsetitr->first);
-      unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
+      unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+      int side = TpcDefs::getSide(hitsetkey);
+      unsigned int sector = TpcDefs::getSectorId(hitsetkey);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
+      // instanciate new data block, at the end of the vector
+      thread_data &data = sectors.emplace_back();
       if (mClusHitsVerbose)
       {
-        thread_pair.data.fillClusHitsVerbose = true;
+        data.fillClusHitsVerbose = true;
       };
 
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = hitset;
-      thread_pair.data.rawhitset = nullptr;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.seed_threshold = seed_threshold;
-      thread_pair.data.edge_threshold = edge_threshold;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.do_singles = do_singles;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
-      thread_pair.data.do_split = do_split;
-      thread_pair.data.FixedWindow = do_fixed_window;
-      thread_pair.data.min_err_squared = min_err_squared;
-      thread_pair.data.min_clus_size = min_clus_size;
-      thread_pair.data.min_adc_sum = min_adc_sum;
+      data.layergeom = layergeom;
+      data.hitset = hitset;
+      data.rawhitset = nullptr;
+      data.sparseframe = sparseframe;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.seed_threshold = seed_threshold;
+      data.edge_threshold = edge_threshold;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.do_singles = do_singles;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
+      data.do_split = do_split;
+      data.FixedWindow = do_fixed_window;
+      data.min_err_squared = min_err_squared;
+      data.min_clus_size = min_clus_size;
+      data.min_adc_sum = min_adc_sum;
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
       unsigned short NTBins = 0;
@@ -1423,73 +1450,37 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
+      data.m_tdriftmax = m_tdriftmax;
 
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
 
-      thread_pair.data.radius = layergeom->get_radius();
-      thread_pair.data.drift_velocity = m_tGeometry->get_drift_velocity();
-      thread_pair.data.pads_per_sector = 0;
-      thread_pair.data.phistep = 0;
-      int rc;
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
+      data.radius = layergeom->get_radius();
+      data.drift_velocity = m_tGeometry->get_drift_velocity();
+      data.pads_per_sector = 0;
+      data.phistep = 0;
+    };
 
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-      if (do_sequential)
+    if (m_read_sparse_frame)
+    {
+      for (const auto &[hitsetkey, sparseframe] : *m_sparse_frames)
       {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
+        if (!sparseframe.empty())
         {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-
-          if (mClusHitsVerbose)
-          {
-            for (auto &hit : data.phivec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addPhiHit(hit.first, hit.second);
-            }
-            for (auto &hit : data.zvec_ClusHitsVerbose[index])
-            {
-              mClusHitsVerbose->addZHit(hit.first, hit.second);
-            }
-            mClusHitsVerbose->push_hits(ckey);
-          }
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
+          add_sector(hitsetkey, nullptr, &sparseframe);
         }
       }
-//      count++;
+    }
+    else
+    {
+      for (TrkrHitSetContainer::ConstIterator hitsetitr = hitsetrange.first;
+           hitsetitr != hitsetrange.second;
+           ++hitsetitr)
+      {
+        add_sector(hitsetitr->first, hitsetitr->second, nullptr);
+      }
     }
   }
   else
@@ -1498,33 +1489,29 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
          hitsetitr != rawhitsetrange.second;
          ++hitsetitr)
     {
-      //	if(count>0)continue;
-      //    const auto hitsetid = hitsetitr->first;
-      //	std::cout << " starting thread # " << count << std::endl;
-
       RawHitSet *hitset = hitsetitr->second;
       unsigned int layer = TrkrDefs::getLayer(hitsetitr->first);
       int side = TpcDefs::getSide(hitsetitr->first);
       unsigned int sector = TpcDefs::getSectorId(hitsetitr->first);
       PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
 
-      // instanciate new thread pair, at the end of thread vector
-      thread_pair_t &thread_pair = threads.emplace_back();
-
-      thread_pair.data.layergeom = layergeom;
-      thread_pair.data.hitset = nullptr;
-      thread_pair.data.rawhitset = hitset;
-      thread_pair.data.layer = layer;
-      thread_pair.data.pedestal = pedestal;
-      thread_pair.data.sector = sector;
-      thread_pair.data.side = side;
-      thread_pair.data.do_assoc = do_hit_assoc;
-      thread_pair.data.do_wedge_emulation = do_wedge_emulation;
-      thread_pair.data.tGeometry = m_tGeometry;
-      thread_pair.data.maxHalfSizeT = MaxClusterHalfSizeT;
-      thread_pair.data.maxHalfSizePhi = MaxClusterHalfSizePhi;
-      thread_pair.data.sampa_tbias = m_sampa_tbias;
-      thread_pair.data.verbosity = Verbosity();
+      // instanciate new data block, at the end of the vector
+      thread_data &data = sectors.emplace_back();
+
+      data.layergeom = layergeom;
+      data.hitset = nullptr;
+      data.rawhitset = hitset;
+      data.layer = layer;
+      data.pedestal = pedestal;
+      data.sector = sector;
+      data.side = side;
+      data.do_assoc = do_hit_assoc;
+      data.do_wedge_emulation = do_wedge_emulation;
+      data.tGeometry = m_tGeometry;
+      data.maxHalfSizeT = MaxClusterHalfSizeT;
+      data.maxHalfSizePhi = MaxClusterHalfSizePhi;
+      data.sampa_tbias = m_sampa_tbias;
+      data.verbosity = Verbosity();
 
       unsigned short NPhiBins = (unsigned short) layergeom->get_phibins();
       unsigned short NPhiBinsSector = NPhiBins / 12;
@@ -1535,148 +1522,79 @@ int TpcClusterizer::process_event(PHCompositeNode *topNode)
       unsigned short TOffset = NTBinsMin;
 
       m_tdriftmax = AdcClockPeriod * NZBinsSide;
-      thread_pair.data.m_tdriftmax = m_tdriftmax;
-
-      thread_pair.data.phibins = NPhiBinsSector;
-      thread_pair.data.phioffset = PhiOffset;
-      thread_pair.data.tbins = NTBinsSide;
-      thread_pair.data.toffset = TOffset;
-
-      /*
-      PHG4TpcCylinderGeom *testlayergeom = geom_container->GetLayerCellGeom(32);
-      for( float iphi = 1408; iphi < 1408+ 128;iphi+=0.1){
-        double clusiphi = iphi;
-        double clusphi = testlayergeom->get_phi(clusiphi);
-        double radius = layergeom->get_radius();
-        float clusx = radius * cos(clusphi);
-        float clusy = radius * sin(clusphi);
-        float clusz  = -37.524;
-
-        TrkrDefs::hitsetkey tpcHitSetKey = TpcDefs::genHitSetKey( 32,11, 0 );
-        Acts::Vector3 global(clusx, clusy, clusz);
-        TrkrDefs::subsurfkey subsurfkey = 0;
-
-        Surface surface = m_tGeometry->get_tpc_surface_from_coords(
-                                                                   tpcHitSetKey,
-                                                                   global,
-                                                                   subsurfkey);
-        std::cout << " iphi: " << iphi << " clusphi: " << clusphi << " surfkey " << subsurfkey << std::endl;
-        //	std::cout << "surfkey" << subsurfkey << std::endl;
-      }
-      continue;
-      */
-      int rc = 0;
-      //      if(layer==32)
-      rc = pthread_create(&thread_pair.thread, &attr, ProcessSector, (void *) &thread_pair.data);
-      //      else
-      // continue;
-
-      if (rc)
-      {
-        std::cout << "Error:unable to create thread," << rc << std::endl;
-      }
-
-      if (do_sequential)
-      {
-        int rc2 = pthread_join(thread_pair.thread, nullptr);
-        if (rc2)
-        {
-          std::cout << "Error:unable to join," << rc2 << std::endl;
-        }
-
-        // get the hitsetkey from thread data
-        const auto &data(thread_pair.data);
-        const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
-
-        // copy clusters to map
-        for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+      data.m_tdriftmax = m_tdriftmax;
 
-          // get cluster
-          auto cluster = data.cluster_vector[index];
-
-          // insert in map
-          m_clusterlist->addClusterSpecifyKey(ckey, cluster);
-        }
-
-        // copy hit associations to map
-        for (const auto &[index, hkey] : thread_pair.data.association_vector)
-        {
-          // generate cluster key
-          const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
-
-          // add to association table
-          m_clusterhitassoc->addAssoc(ckey, hkey);
-        }
-      }
-//      count++;
+      data.phibins = NPhiBinsSector;
+      data.phioffset = PhiOffset;
+      data.tbins = NTBinsSide;
+      data.toffset = TOffset;
     }
   }
 
-  pthread_attr_destroy(&attr);
-//  count = 0;
-  // wait for completion of all threads
-  if (!do_sequential)
+  // cluster all hitsets, on the persistent thread pool unless
+  // sequential processing was requested
+  if (do_sequential || !m_threadpool)
   {
-    for (const auto &thread_pair : threads)
+    for (auto &data : sectors)
     {
-      int rc2 = pthread_join(thread_pair.thread, nullptr);
-      if (rc2)
-      {
-        std::cout << "Error:unable to join," << rc2 << std::endl;
-      }
+      ProcessSectorData(&data);
+    }
+  }
+  else
+  {
+    m_threadpool->parallel_for(sectors.size(), [&sectors](size_t i)
+                               { ProcessSectorData(&sectors[i]); });
+  }
 
-      // get the hitsetkey from thread data
-      const auto &data(thread_pair.data);
-      const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
+  // merge the per hitset results, in hitset order
+  for (auto &data : sectors)
+  {
+    // get the hitsetkey from thread data
+    const auto hitsetkey = TpcDefs::genHitSetKey(data.layer, data.sector, data.side);
 
-      // copy clusters to map
-      for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy clusters to map
+    for (uint32_t index = 0; index < data.cluster_vector.size(); ++index)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // get cluster
-        auto cluster = data.cluster_vector[index];
+      // get cluster
+      auto cluster = data.cluster_vector[index];
 
-        // insert in map
-        // std::cout << "X: " << cluster->getLocalX() << "Y: " << cluster->getLocalY() << std::endl;
-        m_clusterlist->addClusterSpecifyKey(ckey, cluster);
+      // insert in map
+      m_clusterlist->addClusterSpecifyKey(ckey, cluster);
 
-        if (mClusHitsVerbose)
+      if (mClusHitsVerbose && data.fillClusHitsVerbose)
+      {
+        for (auto &hit : data.phivec_ClusHitsVerbose[index])
         {
-          for (auto &hit : data.phivec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
-          }
-          for (auto &hit : data.zvec_ClusHitsVerbose[index])
-          {
-            mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
-          }
-          mClusHitsVerbose->push_hits(ckey);
+          mClusHitsVerbose->addPhiHit(hit.first, (float) hit.second);
+        }
+        for (auto &hit : data.zvec_ClusHitsVerbose[index])
+        {
+          mClusHitsVerbose->addZHit(hit.first, (float) hit.second);
         }
+        mClusHitsVerbose->push_hits(ckey);
       }
+    }
 
-      // copy hit associations to map
-      for (const auto &[index, hkey] : thread_pair.data.association_vector)
-      {
-        // generate cluster key
-        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+    // copy hit associations to map
+    for (const auto &[index, hkey] : data.association_vector)
+    {
+      // generate cluster key
+      const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
 
-        // add to association table
-        m_clusterhitassoc->addAssoc(ckey, hkey);
-      }
+      // add to association table
+      m_clusterhitassoc->addAssoc(ckey, hkey);
+    }
 
-      for (auto v_hit : thread_pair.data.v_hits)
+    for (auto v_hit : data.v_hits)
+    {
+      if (_store_hits)
       {
-        if (_store_hits)
-        {
-          m_training->v_hits.emplace_back(*v_hit);
-        }
-        delete v_hit;
+        m_training->v_hits.emplace_back(*v_hit);
       }
+      delete v_hit;
     }
   }
 
@@ -6,15 +6,18 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class ClusHitsVerbosev1;
 class PHCompositeNode;
+class PHThreadPool;
 class TrkrHitSet;
 class TrkrHitSetContainer;
 class RawHitSet;
 class RawHitSetContainer;
+class TpcSparseFrameContainer;
 class TrkrClusterContainer;
 class TrkrClusterHitAssoc;
 class TrainingHitsContainer;
@@ -28,7 +31,7 @@ public:
   typedef std::pair<unsigned short, iphiz> ihit;
 
   TpcClusterizer(const std::string &name = "TpcClusterizer");
-  ~TpcClusterizer() override = default;
+  ~TpcClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -40,6 +43,8 @@ public:
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
   void set_do_wedge_emulation(bool do_wedge) { do_wedge_emulation = do_wedge; }
   void set_do_sequential(bool do_seq) { do_sequential = do_seq; }
+  //! number of clustering threads, 0 (default) uses all cores
+  void set_num_threads(unsigned int n) { m_nthreads = n; }
   void set_do_split(bool split) { do_split = split; }
   void set_fixed_window(int fixed) { do_fixed_window = fixed; }
   void set_pedestal(float val) { pedestal = val; }
@@ -50,6 +55,10 @@ public:
   void set_min_adc_sum(float val) { min_adc_sum = val; }
   void set_remove_singles(bool do_sing) { do_singles = do_sing; }
   void set_read_raw(bool read_raw) { do_read_raw = read_raw; }
+  //! read the dense ADC frames of TpcCombinedRawDataUnpacker::setDenseFrame() from TRKR_TPCFRAME
+  void set_read_frame(bool read_frame) { m_read_frame = read_frame; }
+  //! read the zero suppressed runs of TpcCombinedRawDataUnpacker::setSparseFrame() from TRKR_TPCSPARSEFRAME
+  void set_read_sparse_frame(bool read_sparse_frame) { m_read_sparse_frame = read_sparse_frame; }
   void set_max_cluster_half_size_phi(unsigned short size) { MaxClusterHalfSizePhi = size; }
   void set_max_cluster_half_size_z(unsigned short size) { MaxClusterHalfSizeT = size; }
   void set_reject_event(bool reject) { m_rejectEvent = reject; }
@@ -79,6 +88,7 @@ public:
 
   TrkrHitSetContainer *m_hits = nullptr;
   RawHitSetContainer *m_rawhits = nullptr;
+  TpcSparseFrameContainer *m_sparse_frames = nullptr;
   TrkrClusterContainer *m_clusterlist = nullptr;
   TrkrClusterHitAssoc *m_clusterhitassoc = nullptr;
   ActsGeometry *m_tGeometry = nullptr;
@@ -89,6 +99,8 @@ public:
   bool do_wedge_emulation = false;
   bool do_sequential = false;
   bool do_read_raw = false;
+  bool m_read_frame = false;
+  bool m_read_sparse_frame = false;
   bool do_singles = true;
   bool do_split = false;
   bool is_reco = false;
@@ -112,6 +124,9 @@ public:
   double m_sampa_tbias = 39.6;  // ns
 
   TrainingHitsContainer *m_training;
+
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  unsigned int m_nthreads = 0;
 };
 
 #endif
@@ -6,6 +6,9 @@
 #include <trackbase/TrkrHitSet.h>
 #include <trackbase/TrkrHitSetContainer.h>
 #include <trackbase/TrkrHitSetContainerv1.h>
+#include <trackbase/TrkrHitSetContainerv2.h>
+#include <trackbase/TrkrHitSetTpcv1.h>
+#include <trackbase/TpcSparseFrameContainer.h>
 #include <trackbase/TrkrHitv2.h>
 
 #include <g4detectors/PHG4TpcCylinderGeom.h>
@@ -22,6 +25,7 @@
 #include <fun4all/Fun4AllServer.h>
 
 #include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
 #include <phool/PHIODataNode.h>  // for PHIODataNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
@@ -34,6 +38,7 @@
 #include <TNtuple.h>
 #include <TSystem.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cstdint>   // for exit
 #include <cstdlib>   // for exit
@@ -44,6 +49,12 @@
 
 #define dEBUG
 
+namespace
+{
+  //! pedestal subtracted from the zero suppressed data
+  constexpr int kZSPedestal = 60;
+}  // namespace
+
 TpcCombinedRawDataUnpacker::TpcCombinedRawDataUnpacker(std::string const& name, std::string const& outF)
   : SubsysReco(name)
   , outfile_name(outF)
@@ -70,6 +81,26 @@ int TpcCombinedRawDataUnpacker::Init(PHCompositeNode* /*topNode*/)
     exit(1);
   }
 
+  // the CDBTTree lookups go through maps keyed by strings, far too slow for every hit
+  for (unsigned int fee = 0; fee < NFEES; fee++)
+  {
+    int feeM = FEE_map[fee];
+    if (FEE_R[fee] == 2)
+    {
+      feeM += 6;
+    }
+    if (FEE_R[fee] == 3)
+    {
+      feeM += 14;
+    }
+    for (unsigned int channel = 0; channel < NCHANNELS; channel++)
+    {
+      const int key = 256 * feeM + channel;
+      m_ChannelLayer[fee * NCHANNELS + channel] = m_cdbttree->GetIntValue(key, "layer", 0);
+      m_ChannelPhi[fee * NCHANNELS + channel] = m_cdbttree->GetDoubleValue(key, "phi", 0);
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -128,6 +159,35 @@ int TpcCombinedRawDataUnpacker::InitRun(PHCompositeNode* topNode)
     trkr_node->addNode(new_node);
   }
 
+  if ((m_dense_frame || m_sparse_frame) && (m_do_baseline_corr || m_writeTree))
+  {
+    std::cout << "TpcCombinedRawDataUnpacker::InitRun - frames are not available with baseline correction or the debug tree, writing TrkrHits" << std::endl;
+    m_dense_frame = false;
+    m_sparse_frame = false;
+  }
+  if (m_dense_frame)
+  {
+    auto frames = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_TPCFRAME");
+    if (!frames)
+    {
+      // the frames are kept between events and only zeroed, 48 layers x 24 sectors
+      frames = new TrkrHitSetContainerv2("TrkrHitSetTpcv1", 48 * 24);
+      PHIODataNode<PHObject>* new_node = new PHIODataNode<PHObject>(frames, "TRKR_TPCFRAME", "PHObject");
+      trkr_node->addNode(new_node);
+    }
+  }
+  if (m_sparse_frame)
+  {
+    auto frames = findNode::getClass<TpcSparseFrameContainer>(topNode, "TRKR_TPCSPARSEFRAME");
+    if (!frames)
+    {
+      // transient, not written out
+      frames = new TpcSparseFrameContainer;
+      auto new_node = new PHDataNode<TpcSparseFrameContainer>(frames, "TRKR_TPCSPARSEFRAME");
+      trkr_node->addNode(new_node);
+    }
+  }
+
   TpcRawHitContainer* tpccont = findNode::getClass<TpcRawHitContainer>(topNode, m_TpcRawNodeName);
   if (!tpccont)
   {
@@ -213,6 +273,32 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTRUN;
   }
 
+  TrkrHitSetContainer* frames = nullptr;
+  if (m_dense_frame)
+  {
+    frames = findNode::getClass<TrkrHitSetContainer>(topNode, "TRKR_TPCFRAME");
+    if (!frames)
+    {
+      std::cout << PHWHERE << " Could not get \"TRKR_TPCFRAME\" from Node Tree, exiting" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    frames->Reset();
+  }
+
+  TpcSparseFrameContainer* sparse_frames = nullptr;
+  if (m_sparse_frame)
+  {
+    sparse_frames = findNode::getClass<TpcSparseFrameContainer>(topNode, "TRKR_TPCSPARSEFRAME");
+    if (!sparse_frames)
+    {
+      std::cout << PHWHERE << " Could not get \"TRKR_TPCSPARSEFRAME\" from Node Tree, exiting" << std::endl;
+      gSystem->Exit(1);
+      exit(1);
+    }
+    sparse_frames->Reset();
+  }
+
   TrkrDefs::hitsetkey hit_set_key = 0;
   TrkrDefs::hitkey hit_key = 0;
   TrkrHitSetContainer::Iterator hit_set_container_itr;
@@ -238,17 +324,13 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       bco_max = gtm_bco;
     }
 
-    int fee = tpchit->get_fee();
-    int channel = tpchit->get_channel();
-    int feeM = FEE_map[fee];
-    if (FEE_R[fee] == 2)
+    const unsigned int fee = tpchit->get_fee();
+    const unsigned int channel = tpchit->get_channel();
+    if (fee >= NFEES || channel >= NCHANNELS)
     {
-      feeM += 6;
-    }
-    if (FEE_R[fee] == 3)
-    {
-      feeM += 14;
+      continue;
     }
+    const unsigned int mapindex = fee * NCHANNELS + channel;
 
     int side = 1;
     int32_t packet_id = tpchit->get_packetid();
@@ -259,9 +341,7 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
       side = 0;
     }
 
-    unsigned int key = 256 * (feeM) + channel;
-    std::string varname = "layer";
-    int layer = m_cdbttree->GetIntValue(key, varname);
+    int layer = m_ChannelLayer[mapindex];
     // antenna pads will be in 0 layer
     if (layer <= 0)
     {
@@ -272,12 +352,44 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     // uint16_t sampch = tpchit->get_sampachannel();
     //    uint16_t sam = tpchit->get_samples();
     max_time_range = tpchit->get_samples();
-    varname = "phi";  // + std::to_string(key);
-    double phi = -1 * pow(-1, side) * m_cdbttree->GetDoubleValue(key, varname) + (sector % 12) * M_PI / 6;
+    double phi = -1 * pow(-1, side) * m_ChannelPhi[mapindex] + (sector % 12) * M_PI / 6;
     PHG4TpcCylinderGeom* layergeom = geom_container->GetLayerCellGeom(layer);
     unsigned int phibin = layergeom->get_phibin(phi);
    
     hit_set_key = TpcDefs::genHitSetKey(layer, (mc_sectors[sector % 12]), side);
+
+    if (m_dense_frame || m_sparse_frame)
+    {
+      // frame of the sector, pads outside of it are not clustered
+      const int npads = layergeom->get_phibins() / 12;
+      const int pad = (int) phibin - npads * mc_sectors[sector % 12];
+      if (pad < 0 || pad >= npads)
+      {
+        continue;
+      }
+      if (m_sparse_frame)
+      {
+        TpcSparseFrame& sparse_frame = sparse_frames->findOrAddFrame(hit_set_key);
+        sparse_frame.set_pad_start(npads * mc_sectors[sector % 12]);
+        fill_sparse_frame(tpchit, sparse_frame, pad);
+      }
+      if (!m_dense_frame)
+      {
+        continue;
+      }
+      // the container reuses its frames for other hitsets, the allocation is only changed if they grow
+      TrkrHitSetTpc* frame = dynamic_cast<TrkrHitSetTpc*>(frames->findOrAddHitSet(hit_set_key)->second);
+      frame->setPadIndexStart(npads * mc_sectors[sector % 12]);
+      frame->setTBinIndexStart(0);
+      if (frame->getNPads() != npads || frame->getNTBins() < max_time_range)
+      {
+        frame->setNPads(npads);
+        frame->setNTBins(std::max<int>(frame->getNTBins(), max_time_range));
+        frame->Resize();
+      }
+      fill_frame(tpchit, frame->getTimeFrameAdcData()[pad]);
+      continue;
+    }
     hit_set_container_itr = trkr_hit_set_container->findOrAddHitSet(hit_set_key);
 
     float hpedestal = 0;
@@ -330,14 +442,10 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
     
     float threshold_cut =  m_zs_threshold;
     
-    for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
-	 !adc_iterator->IsDone();
-	 adc_iterator->Next()){
-      const uint16_t s = adc_iterator->CurrentTimeBin();
-      const uint16_t adc = adc_iterator->CurrentAdc();
+    auto process_sample = [&](const uint16_t s, const uint16_t adc){
       int t = s - m_presampleShift - m_t0;
       if (t < 0){
-	continue;
+	return;
       }
       if (feehist != nullptr){
 	if (adc > 0){
@@ -382,9 +490,34 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
 	}
 	
       }
+    };
+
+    const unsigned int nwaveforms = tpchit->get_n_waveforms();
+    if (nwaveforms > 0){
+      // read the samples in place
+      for (unsigned int iwf = 0; iwf < nwaveforms; ++iwf){
+	const uint16_t start = tpchit->get_waveform_start(iwf);
+	const uint16_t length = tpchit->get_waveform_length(iwf);
+	const uint16_t* adcs = tpchit->get_waveform_adc(iwf);
+	for (uint16_t isample = 0; isample < length; ++isample){
+	  process_sample(start + isample, adcs[isample]);
+	}
+      }
+    }
+    else{
+      for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+	   !adc_iterator->IsDone();
+	   adc_iterator->Next()){
+	process_sample(adc_iterator->CurrentTimeBin(), adc_iterator->CurrentAdc());
+      }
     }
   }
 
+  if (sparse_frames)
+  {
+    sparse_frames->sort();
+  }
+
   if (m_do_baseline_corr == true){
     // Histos filled now process them for fee local baselines
     
@@ -573,6 +706,113 @@ int TpcCombinedRawDataUnpacker::process_event(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void TpcCombinedRawDataUnpacker::fill_frame(TpcRawHit* tpchit, std::vector<TpcDefs::ADCDataType>& pad_adc) const
+{
+  const int ntbins = pad_adc.size();
+  const int threshold = m_zs_threshold;
+
+  // same selection as for TrkrHits: adc - pedestal above threshold, first sample of a time bin wins
+  auto store = [&pad_adc, ntbins, threshold, this](const uint16_t start, const uint16_t* adcs, const int length)
+  {
+    const int tfirst = start - m_presampleShift - m_t0;
+    const int begin = std::max(0, -tfirst);
+    const int end = std::min(length, ntbins - tfirst);
+    if (begin >= end)
+    {
+      return;
+    }
+    // only form pointers inside the arrays, tfirst can be negative
+    // branch free so the compiler can vectorize it
+    TpcDefs::ADCDataType* out = pad_adc.data() + (tfirst + begin);
+    const uint16_t* in = adcs + begin;
+    const int n = end - begin;
+    for (int i = 0; i < n; ++i)
+    {
+      const int adc = (int) in[i] - kZSPedestal;
+      const TpcDefs::ADCDataType value = (adc > threshold) ? adc : 0;
+      out[i] = (out[i] != 0) ? out[i] : value;
+    }
+  };
+
+  const unsigned int nwaveforms = tpchit->get_n_waveforms();
+  if (nwaveforms > 0)
+  {
+    // read the samples in place
+    for (unsigned int iwf = 0; iwf < nwaveforms; ++iwf)
+    {
+      store(tpchit->get_waveform_start(iwf), tpchit->get_waveform_adc(iwf), tpchit->get_waveform_length(iwf));
+    }
+  }
+  else
+  {
+    for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+         !adc_iterator->IsDone();
+         adc_iterator->Next())
+    {
+      const uint16_t adc = adc_iterator->CurrentAdc();
+      store(adc_iterator->CurrentTimeBin(), &adc, 1);
+    }
+  }
+}
+
+void TpcCombinedRawDataUnpacker::fill_sparse_frame(TpcRawHit* tpchit, TpcSparseFrame& frame, const uint16_t pad)
+{
+  const int threshold = m_zs_threshold;
+
+  // same selection as for TrkrHits, stored as runs of consecutive time bins above threshold
+  auto store = [&frame, pad, threshold, this](const uint16_t start, const uint16_t* adcs, const int length)
+  {
+    const int tfirst = start - m_presampleShift - m_t0;
+    const int begin = std::max(0, -tfirst);
+    if (begin >= length)
+    {
+      return;
+    }
+    // branch free so the compiler can vectorize it
+    m_run_adcs.resize(length);
+    uint16_t* values = m_run_adcs.data();
+    for (int i = begin; i < length; ++i)
+    {
+      const int adc = (int) adcs[i] - kZSPedestal;
+      values[i] = (adc > threshold) ? adc : 0;
+    }
+    int i = begin;
+    while (i < length)
+    {
+      if (values[i] == 0)
+      {
+        ++i;
+        continue;
+      }
+      const int first = i;
+      while (i < length && values[i] != 0)
+      {
+        ++i;
+      }
+      frame.add_run(pad, tfirst + first, values + first, i - first);
+    }
+  };
+
+  const unsigned int nwaveforms = tpchit->get_n_waveforms();
+  if (nwaveforms > 0)
+  {
+    for (unsigned int iwf = 0; iwf < nwaveforms; ++iwf)
+    {
+      store(tpchit->get_waveform_start(iwf), tpchit->get_waveform_adc(iwf), tpchit->get_waveform_length(iwf));
+    }
+  }
+  else
+  {
+    for (std::unique_ptr<TpcRawHit::AdcIterator> adc_iterator(tpchit->CreateAdcIterator());
+         !adc_iterator->IsDone();
+         adc_iterator->Next())
+    {
+      const uint16_t adc = adc_iterator->CurrentAdc();
+      store(adc_iterator->CurrentTimeBin(), &adc, 1);
+    }
+  }
+}
+
 int TpcCombinedRawDataUnpacker::End(PHCompositeNode* /*topNode*/)
 {
   if (m_writeTree)
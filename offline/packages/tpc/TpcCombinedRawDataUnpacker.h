@@ -5,6 +5,9 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase/TpcDefs.h>
+
+#include <array>
 #include <limits>
 #include <map>
 #include <string>
@@ -17,6 +20,8 @@ class TH2I;
 class TH2C;
 class TFile;
 class TNtuple;
+class TpcRawHit;
+class TpcSparseFrame;
 
 class TpcCombinedRawDataUnpacker : public SubsysReco
 {
@@ -41,6 +46,16 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   void skipNevent(int b) { startevt = b; }
   void useRawHitNodeName(const std::string &name) { m_TpcRawNodeName = name; }
 
+  //! write the zero suppressed ADCs into dense (pad x time bin) frames per hitset, stored as
+  //! TrkrHitSetTpcv1 in the TRKR_TPCFRAME node, instead of one TrkrHitv2 per sample in TRKR_HITSET.
+  //! Read by TpcClusterizer::set_read_frame(). Not available with baseline correction or the debug tree.
+  void setDenseFrame(bool val) { m_dense_frame = val; }
+
+  //! also store the zero suppressed ADCs as runs of time bins per pad in the transient
+  //! TpcSparseFrameContainer node TRKR_TPCSPARSEFRAME, read by the TPC clusterizers
+  //! with set_read_sparse_frame(). Same restrictions as setDenseFrame()
+  void setSparseFrame(bool val) { m_sparse_frame = val; }
+
   void event_range(int a, int b)
   {
     startevt = a;
@@ -90,6 +105,12 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   }
 
  private:
+  //! zero suppressed samples of one channel into the time bins of its pad
+  void fill_frame(TpcRawHit *tpchit, std::vector<TpcDefs::ADCDataType> &pad_adc) const;
+
+  //! runs of zero suppressed samples of one channel into the sparse frame of its sector
+  void fill_sparse_frame(TpcRawHit *tpchit, TpcSparseFrame &frame, const uint16_t pad);
+
   TNtuple *m_ntup{nullptr};
   TNtuple *m_ntup_hits = nullptr;
   TNtuple *m_ntup_hits_corr = nullptr;
@@ -106,12 +127,21 @@ class TpcCombinedRawDataUnpacker : public SubsysReco
   int FEE_map[26]{4, 5, 0, 2, 1, 11, 9, 10, 8, 7, 6, 0, 1, 3, 7, 6, 5, 4, 3, 2, 0, 2, 1, 3, 5, 4};
   int FEE_R[26]{2, 2, 1, 1, 1, 3, 3, 3, 3, 3, 3, 2, 2, 1, 2, 2, 1, 1, 2, 2, 3, 3, 3, 3, 3, 3};
 
+  //! layer and phi of the channel map indexed by fee * NCHANNELS + channel, filled in Init
+  static constexpr unsigned int NFEES = 26;
+  static constexpr unsigned int NCHANNELS = 256;
+  std::array<int, NFEES * NCHANNELS> m_ChannelLayer{};
+  std::array<double, NFEES * NCHANNELS> m_ChannelPhi{};
+
   float m_ped_sig_cut{4.0};
 
   bool m_writeTree{false};
   bool m_do_baseline_corr{false};
   int m_baseline_nsigma{2};
   bool m_do_zs_emulation{false};
+  bool m_dense_frame{false};
+  bool m_sparse_frame{false};
+  std::vector<uint16_t> m_run_adcs;
   int m_zs_threshold{20};
   std::string m_TpcRawNodeName{"TPCRAWHIT"};
   std::string outfile_name;
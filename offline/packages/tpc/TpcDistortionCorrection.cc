@@ -10,6 +10,7 @@
 #include <TH1.h>
 #include <cmath>
 
+#include <array>
 #include <iostream>
 
 namespace
@@ -42,6 +43,51 @@ namespace
     return check_boundaries(h->GetXaxis(), r) && check_boundaries(h->GetYaxis(), phi);
   }
 
+  // interpolate all three corrections from packed grid, at once
+  /*
+   * equivalent to calling TH3::Interpolate (TH2::Interpolate in 2D) on each of the dphi, dr and dz histograms,
+   * provided that the point passes the boundary check. Returns false otherwise
+   */
+  bool interpolate(const TpcDistortionCorrectionContainer::PackedGrid& grid, double phi, double r, double z, std::array<double, 3>& out)
+  {
+    const auto& axes = grid.m_axes;
+    const bool has_z = axes[2].size() > 1;
+    if (!(axes[0].contains(phi) && axes[1].contains(r) && (!has_z || axes[2].contains(z))))
+    {
+      return false;
+    }
+
+    // lower nodes and weights along each axis
+    const auto iphi = axes[0].lower_index(phi);
+    const auto ir = axes[1].lower_index(r);
+    const auto iz = has_z ? axes[2].lower_index(z) : 0;
+
+    const auto& cphi = axes[0].m_centers;
+    const auto& cr = axes[1].m_centers;
+    const auto& cz = axes[2].m_centers;
+    const double fphi = (phi - cphi[iphi]) / (cphi[iphi + 1] - cphi[iphi]);
+    const double fr = (r - cr[ir]) / (cr[ir + 1] - cr[ir]);
+    const double fz = has_z ? (z - cz[iz]) / (cz[iz + 1] - cz[iz]) : 0;
+
+    // strides between neighboring nodes, in floats. In 2D the z neighbor is the node itself
+    const size_t sz = has_z ? 3 : 0;
+    const size_t sr = 3 * axes[2].size();
+    const size_t sphi = sr * axes[1].size();
+
+    const float* v = &grid.m_values[3 * grid.index(iphi, ir, iz)];
+    for (size_t i = 0; i < 3; ++i)
+    {
+      const double c00 = v[i] * (1 - fz) + v[i + sz] * fz;
+      const double c01 = v[i + sr] * (1 - fz) + v[i + sr + sz] * fz;
+      const double c10 = v[i + sphi] * (1 - fz) + v[i + sphi + sz] * fz;
+      const double c11 = v[i + sphi + sr] * (1 - fz) + v[i + sphi + sr + sz] * fz;
+      const double c0 = c00 * (1 - fr) + c01 * fr;
+      const double c1 = c10 * (1 - fr) + c11 * fr;
+      out[i] = c0 * (1 - fphi) + c1 * fphi;
+    }
+    return true;
+  }
+
 }  // namespace
 
 //________________________________________________________
@@ -82,8 +128,29 @@ Acts::Vector3 TpcDistortionCorrection::get_corrected_position(const Acts::Vector
   dr=0;
   dz=0;
   
-  //get the corrections from the histograms
-  if (dcc->m_dimensions == 3)
+  //get the corrections from the packed grid if available, from the histograms otherwise
+  if (dcc->m_packed[index].valid())
+  {
+    std::array<double, 3> corrections = {{0, 0, 0}};
+    if (interpolate(dcc->m_packed[index], phi, r, z, corrections))
+    {
+      // 2D corrections are scaled with z
+      const double zterm = (dcc->m_dimensions == 2 && dcc->m_interpolate_z) ? (1. - std::abs(z) / 105.5) : 1.0;
+      if (mask & COORD_PHI)
+      {
+        dphi = corrections[0] * zterm / divisor;
+      }
+      if (mask & COORD_R)
+      {
+        dr = corrections[1] * zterm;
+      }
+      if (mask & COORD_Z)
+      {
+        dz = corrections[2] * zterm;
+      }
+    }
+  }
+  else if (dcc->m_dimensions == 3)
   {
     if (dcc->m_hDPint[index] && (mask & COORD_PHI) && check_boundaries(dcc->m_hDPint[index], phi, r, z))
     {
@@ -138,3 +205,12 @@ if(dcc->m_use_scalefactor)
 
   return {x_new, y_new, z_new};
 }
+
+//________________________________________________________
+void TpcDistortionCorrection::get_corrected_positions(std::vector<Acts::Vector3>& positions, const TpcDistortionCorrectionContainer* dcc, unsigned int mask) const
+{
+  for (auto& position : positions)
+  {
+    position = get_corrected_position(position, dcc, mask);
+  }
+}
@@ -0,0 +1,161 @@
+/*!
+ * \file TpcDistortionCorrectionContainer.cc
+ * \brief stores distortion correction histograms on the node tree
+ * \author Hugo Pereira Da Costa <hugo.pereira-da-costa@cea.fr>
+ */
+
+#include "TpcDistortionCorrectionContainer.h"
+
+#include <TAxis.h>
+#include <TH1.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // get histogram axis from index
+  const TAxis* get_axis(const TH1* h, int i)
+  {
+    switch (i)
+    {
+    case 0:
+      return h->GetXaxis();
+    case 1:
+      return h->GetYaxis();
+    default:
+      return h->GetZaxis();
+    }
+  }
+
+  // true if two axes have the same binning
+  bool same_binning(const TAxis* first, const TAxis* second)
+  {
+    return first->GetNbins() == second->GetNbins() &&
+           first->GetXmin() == second->GetXmin() &&
+           first->GetXmax() == second->GetXmax() &&
+           first->IsVariableBinSize() == second->IsVariableBinSize();
+  }
+
+  // create packed axis from histogram axis
+  TpcDistortionCorrectionContainer::PackedGrid::Axis make_axis(const TAxis* axis)
+  {
+    TpcDistortionCorrectionContainer::PackedGrid::Axis out;
+    const int nbins = axis->GetNbins();
+    out.m_centers.reserve(nbins);
+    for (int i = 1; i <= nbins; ++i)
+    {
+      out.m_centers.push_back(axis->GetBinCenter(i));
+    }
+
+    // same as check_boundaries in TpcDistortionCorrection: value must be in bins [2, nbins[
+    if (nbins >= 3)
+    {
+      out.m_min = axis->GetBinLowEdge(2);
+      out.m_max = axis->GetBinLowEdge(nbins);
+    }
+
+    if (!axis->IsVariableBinSize())
+    {
+      out.m_step = axis->GetBinWidth(1);
+    }
+    return out;
+  }
+
+  // single node axis, used for z in 2D histograms
+  TpcDistortionCorrectionContainer::PackedGrid::Axis make_flat_axis()
+  {
+    TpcDistortionCorrectionContainer::PackedGrid::Axis out;
+    out.m_centers.push_back(0);
+    return out;
+  }
+
+}  // namespace
+
+//________________________________________________________
+size_t TpcDistortionCorrectionContainer::PackedGrid::Axis::lower_index(double value) const
+{
+  size_t i = 0;
+  if (m_step > 0)
+  {
+    i = static_cast<size_t>(std::max(0., std::floor((value - m_centers.front()) / m_step)));
+  }
+  else
+  {
+    const auto iter = std::upper_bound(m_centers.begin(), m_centers.end(), value);
+    i = iter == m_centers.begin() ? 0 : static_cast<size_t>(std::distance(m_centers.begin(), iter) - 1);
+  }
+
+  // guard against rounding, so that both i and i+1 are valid nodes
+  i = std::min(i, m_centers.size() - 2);
+  if (i > 0 && value < m_centers[i])
+  {
+    --i;
+  }
+  return i;
+}
+
+//________________________________________________________
+void TpcDistortionCorrectionContainer::pack()
+{
+  for (int side = 0; side < 2; ++side)
+  {
+    auto& grid = m_packed[side];
+    grid = PackedGrid();
+
+    const std::array<const TH1*, 3> histograms = {{m_hDPint[side], m_hDRint[side], m_hDZint[side]}};
+    if (std::find(histograms.begin(), histograms.end(), nullptr) != histograms.end())
+    {
+      continue;
+    }
+
+    // all histograms must share dimension and binning
+    const int dimensions = histograms[0]->GetDimension();
+    if (dimensions != m_dimensions)
+    {
+      continue;
+    }
+
+    bool consistent = true;
+    for (const auto& h : histograms)
+    {
+      if (h->GetDimension() != dimensions)
+      {
+        consistent = false;
+        break;
+      }
+      for (int i = 0; i < dimensions; ++i)
+      {
+        consistent &= same_binning(get_axis(h, i), get_axis(histograms[0], i));
+      }
+    }
+    if (!consistent)
+    {
+      continue;
+    }
+
+    for (int i = 0; i < 3; ++i)
+    {
+      grid.m_axes[i] = i < dimensions ? make_axis(get_axis(histograms[0], i)) : make_flat_axis();
+    }
+
+    const auto nphi = grid.m_axes[0].size();
+    const auto nr = grid.m_axes[1].size();
+    const auto nz = grid.m_axes[2].size();
+    grid.m_values.reserve(3 * nphi * nr * nz);
+    for (size_t iphi = 0; iphi < nphi; ++iphi)
+    {
+      for (size_t ir = 0; ir < nr; ++ir)
+      {
+        for (size_t iz = 0; iz < nz; ++iz)
+        {
+          for (const auto& h : histograms)
+          {
+            const auto value = dimensions == 3 ? h->GetBinContent(iphi + 1, ir + 1, iz + 1) : h->GetBinContent(iphi + 1, ir + 1);
+            grid.m_values.push_back(value);
+          }
+        }
+      }
+    }
+  }
+}
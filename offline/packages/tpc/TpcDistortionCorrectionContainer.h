@@ -8,6 +8,8 @@
  */
 
 #include <array>
+#include <cstddef>
+#include <vector>
 
 class TH1;
 
@@ -17,6 +19,70 @@ class TpcDistortionCorrectionContainer
   //! constructor
   TpcDistortionCorrectionContainer() = default;
 
+  //! copy the three distortion histograms, for each side, into a packed interpolation grid
+  /**
+   * must be called again whenever the histograms are modified.
+   * If the histograms are missing or do not share the same binning, the grid is left empty
+   * and TpcDistortionCorrection falls back to histogram interpolation
+   */
+  void pack();
+
+  //! packed interpolation grid
+  /**
+   * holds the (dphi, dr, dz) triplet at each bin center, without under and overflow bins,
+   * so that all three components are interpolated with a single bin lookup.
+   * Axes are ordered as in the histograms: phi, r, z. For 2D histograms the z axis has a single node
+   */
+  class PackedGrid
+  {
+   public:
+    class Axis
+    {
+     public:
+      //! bin centers
+      std::vector<double> m_centers;
+
+      //! interpolation range. Matches the histograms boundary check: first and last bins are excluded
+      double m_min = 0;
+      double m_max = 0;
+
+      //! bin size, for uniform binning. Zero otherwise
+      double m_step = 0;
+
+      //! true if value can be interpolated
+      bool contains(double value) const
+      {
+        return value >= m_min && value < m_max;
+      }
+
+      //! index of the bin center immediately below value. Value must be in range
+      size_t lower_index(double value) const;
+
+      size_t size() const
+      {
+        return m_centers.size();
+      }
+    };
+
+    //! true if grid was filled
+    bool valid() const
+    {
+      return !m_values.empty();
+    }
+
+    //! linear (phi, r, z) node index
+    size_t index(size_t iphi, size_t ir, size_t iz) const
+    {
+      return (iphi * m_axes[1].size() + ir) * m_axes[2].size() + iz;
+    }
+
+    //! phi, r and z axes
+    std::array<Axis, 3> m_axes;
+
+    //! (dphi, dr, dz) at each node, z fastest
+    std::vector<float> m_values;
+  };
+
   //! flag to tell us whether to read z data or just 2d data
   int m_dimensions = 3;
 
@@ -41,6 +107,9 @@ class TpcDistortionCorrectionContainer
    */
   std::array<TH1*, 2> m_hentries = {{nullptr, nullptr}};
   //@}
+
+  //! packed grids, for each side
+  std::array<PackedGrid, 2> m_packed;
 };
 
 #endif
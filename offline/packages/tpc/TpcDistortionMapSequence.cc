@@ -0,0 +1,333 @@
+/*!
+ * \file TpcDistortionMapSequence.cc
+ * \brief indexed file of time ordered distortion maps, read on demand from a memory mapped file
+ */
+
+#include "TpcDistortionMapSequence.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+  // file header
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    uint32_t dimensions;
+    uint64_t nmaps;
+    uint64_t naxis[2][3];
+  };
+
+  constexpr char kMagic[8] = {'T', 'P', 'C', 'D', 'M', 'S', 'E', 'Q'};
+  constexpr uint32_t kVersion = 1;
+
+  // per axis: min, max, step, then the bin centers
+  constexpr size_t kAxisParameters = 3;
+
+  // read a value from the mapped file, false if past its end
+  template <class T>
+  bool read_at(const char* base, size_t file_size, size_t& offset, T* value, size_t count = 1)
+  {
+    if (offset + count * sizeof(T) > file_size)
+    {
+      return false;
+    }
+    std::memcpy(value, base + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+    return true;
+  }
+
+  // number of nodes of a grid
+  size_t grid_size(const std::array<TpcDistortionCorrectionContainer::PackedGrid::Axis, 3>& axes)
+  {
+    return axes[0].size() * axes[1].size() * axes[2].size();
+  }
+
+  // true if two packed axes are identical
+  bool same_axis(const TpcDistortionCorrectionContainer::PackedGrid::Axis& first, const TpcDistortionCorrectionContainer::PackedGrid::Axis& second)
+  {
+    return first.m_centers == second.m_centers && first.m_min == second.m_min && first.m_max == second.m_max && first.m_step == second.m_step;
+  }
+
+}  // namespace
+
+//_____________________________________________________________________
+TpcDistortionMapSequence::~TpcDistortionMapSequence()
+{
+  close();
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapSequence::write(const std::string& filename, const std::vector<Range>& ranges, const std::vector<const TpcDistortionCorrectionContainer*>& maps)
+{
+  if (maps.empty() || ranges.size() != maps.size())
+  {
+    std::cout << "TpcDistortionMapSequence::write - need one key range per map" << std::endl;
+    return false;
+  }
+
+  // all maps must be packed on both sides with the axes of the first
+  const auto reference = maps.front();
+  for (const auto& map : maps)
+  {
+    if (!map || map->m_dimensions != reference->m_dimensions)
+    {
+      std::cout << "TpcDistortionMapSequence::write - inconsistent map dimensions" << std::endl;
+      return false;
+    }
+    for (int side = 0; side < 2; ++side)
+    {
+      if (!map->m_packed[side].valid())
+      {
+        std::cout << "TpcDistortionMapSequence::write - map is not packed" << std::endl;
+        return false;
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        if (!same_axis(map->m_packed[side].m_axes[i], reference->m_packed[side].m_axes[i]))
+        {
+          std::cout << "TpcDistortionMapSequence::write - maps do not share the same axes" << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+
+  // maps sorted by first key
+  std::vector<size_t> order(maps.size());
+  for (size_t i = 0; i < order.size(); ++i)
+  {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&ranges](size_t lhs, size_t rhs)
+            { return ranges[lhs].first < ranges[rhs].first; });
+
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dimensions = reference->m_dimensions;
+  header.nmaps = maps.size();
+  size_t offset = sizeof(FileHeader);
+  size_t map_size = 0;
+  for (int side = 0; side < 2; ++side)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto& axis = reference->m_packed[side].m_axes[i];
+      header.naxis[side][i] = axis.size();
+      offset += (kAxisParameters + axis.size()) * sizeof(double);
+    }
+    map_size += reference->m_packed[side].m_values.size() * sizeof(float);
+  }
+  offset += maps.size() * sizeof(Entry);
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    std::cout << "TpcDistortionMapSequence::write - cannot open " << filename << std::endl;
+    return false;
+  }
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (int side = 0; side < 2; ++side)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      const auto& axis = reference->m_packed[side].m_axes[i];
+      const double parameters[kAxisParameters] = {axis.m_min, axis.m_max, axis.m_step};
+      out.write(reinterpret_cast<const char*>(parameters), sizeof(parameters));
+      out.write(reinterpret_cast<const char*>(axis.m_centers.data()), axis.m_centers.size() * sizeof(double));
+    }
+  }
+  for (const auto& i : order)
+  {
+    const Entry entry = {ranges[i].first, ranges[i].last, offset};
+    out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    offset += map_size;
+  }
+  for (const auto& i : order)
+  {
+    for (int side = 0; side < 2; ++side)
+    {
+      const auto& values = maps[i]->m_packed[side].m_values;
+      out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+    }
+  }
+  return out.good();
+}
+
+//_____________________________________________________________________
+bool TpcDistortionMapSequence::open(const std::string& filename)
+{
+  close();
+
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "TpcDistortionMapSequence::open - cannot open " << filename << std::endl;
+    return false;
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0 || static_cast<size_t>(filestat.st_size) < sizeof(FileHeader))
+  {
+    std::cout << "TpcDistortionMapSequence::open - " << filename << " is too short" << std::endl;
+    ::close(fd);
+    return false;
+  }
+  m_file_size = filestat.st_size;
+  m_address = mmap(nullptr, m_file_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (m_address == MAP_FAILED)
+  {
+    std::cout << "TpcDistortionMapSequence::open - cannot map " << filename << std::endl;
+    m_address = nullptr;
+    m_file_size = 0;
+    return false;
+  }
+
+  // header, axes and index
+  const char* base = static_cast<const char*>(m_address);
+  size_t offset = 0;
+  FileHeader header{};
+  read_at(base, m_file_size, offset, &header);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || (header.dimensions != 2 && header.dimensions != 3))
+  {
+    std::cout << "TpcDistortionMapSequence::open - " << filename << " is not a distortion map sequence" << std::endl;
+    close();
+    return false;
+  }
+  m_dimensions = header.dimensions;
+
+  bool valid = true;
+  for (int side = 0; side < 2; ++side)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      auto& axis = m_axes[side][i];
+      double parameters[kAxisParameters] = {0, 0, 0};
+      valid &= header.naxis[side][i] > 0 && offset + (kAxisParameters + header.naxis[side][i]) * sizeof(double) <= m_file_size;
+      if (!valid)
+      {
+        break;
+      }
+      read_at(base, m_file_size, offset, parameters, kAxisParameters);
+      axis.m_min = parameters[0];
+      axis.m_max = parameters[1];
+      axis.m_step = parameters[2];
+      axis.m_centers.resize(header.naxis[side][i]);
+      read_at(base, m_file_size, offset, axis.m_centers.data(), axis.m_centers.size());
+    }
+  }
+
+  valid &= offset + header.nmaps * sizeof(Entry) <= m_file_size;
+  if (valid)
+  {
+    m_index.resize(header.nmaps);
+    read_at(base, m_file_size, offset, m_index.data(), m_index.size());
+  }
+
+  // maps must be inside the file, ordered and not overlapping
+  for (size_t i = 0; valid && i < m_index.size(); ++i)
+  {
+    valid &= m_index[i].first <= m_index[i].last &&
+             m_index[i].offset % sizeof(float) == 0 &&
+             m_index[i].offset + map_size() <= m_file_size &&
+             (i == 0 || m_index[i].first > m_index[i - 1].last);
+  }
+  if (!valid)
+  {
+    std::cout << "TpcDistortionMapSequence::open - " << filename << " is corrupted" << std::endl;
+    close();
+    return false;
+  }
+
+  std::cout << "TpcDistortionMapSequence::open - " << filename << " holds " << m_index.size() << " maps" << std::endl;
+  return true;
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapSequence::close()
+{
+  if (m_address)
+  {
+    munmap(m_address, m_file_size);
+  }
+  m_address = nullptr;
+  m_file_size = 0;
+  m_index.clear();
+  m_loaded = -1;
+}
+
+//_____________________________________________________________________
+int TpcDistortionMapSequence::find(uint64_t key) const
+{
+  // last map starting at or before key
+  const auto iter = std::upper_bound(m_index.begin(), m_index.end(), key, [](uint64_t value, const Entry& entry)
+                                     { return value < entry.first; });
+  if (iter == m_index.begin())
+  {
+    return -1;
+  }
+  const auto index = std::distance(m_index.begin(), iter) - 1;
+  return key <= m_index[index].last ? static_cast<int>(index) : -1;
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapSequence::load(int index, TpcDistortionCorrectionContainer* container)
+{
+  if (index < 0 || index >= static_cast<int>(m_index.size()))
+  {
+    return;
+  }
+
+  container->m_dimensions = m_dimensions;
+  const float* values = map_values(index);
+  for (int side = 0; side < 2; ++side)
+  {
+    auto& grid = container->m_packed[side];
+    grid.m_axes = m_axes[side];
+    const size_t nvalues = 3 * grid_size(m_axes[side]);
+    grid.m_values.assign(values, values + nvalues);
+    values += nvalues;
+  }
+
+  // the values are copied, the pages of the previous map are not needed any more
+  if (m_loaded >= 0 && m_loaded != index)
+  {
+    advise(m_loaded, MADV_DONTNEED);
+  }
+  m_loaded = index;
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapSequence::prefetch(int index) const
+{
+  if (index >= 0 && index < static_cast<int>(m_index.size()))
+  {
+    advise(index, MADV_WILLNEED);
+  }
+}
+
+//_____________________________________________________________________
+size_t TpcDistortionMapSequence::map_size() const
+{
+  return 3 * (grid_size(m_axes[0]) + grid_size(m_axes[1])) * sizeof(float);
+}
+
+//_____________________________________________________________________
+void TpcDistortionMapSequence::advise(int index, int advice) const
+{
+  // madvise works on whole pages
+  const size_t page = sysconf(_SC_PAGESIZE);
+  const size_t begin = m_index[index].offset / page * page;
+  const size_t end = std::min(m_file_size, m_index[index].offset + map_size());
+  madvise(static_cast<char*>(m_address) + begin, end - begin, advice);
+}
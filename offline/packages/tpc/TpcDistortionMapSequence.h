@@ -0,0 +1,111 @@
+#ifndef TPC_TPCDISTORTIONMAPSEQUENCE_H
+#define TPC_TPCDISTORTIONMAPSEQUENCE_H
+
+/*!
+ * \file TpcDistortionMapSequence.h
+ * \brief indexed file of time ordered distortion maps, read on demand from a memory mapped file
+ */
+
+#include "TpcDistortionCorrectionContainer.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*!
+ * The file holds a sequence of packed distortion grids (see TpcDistortionCorrectionContainer::PackedGrid)
+ * sharing the same axes, each valid for a range of keys (typically the GL1 BCO).
+ * Layout: header, axes of both sides, index of (first key, last key, offset) sorted by first key,
+ * then the (dphi, dr, dz) values of each map, negative z side first.
+ *
+ * Only the map of the current key range is copied to the correction container.
+ * The file is mapped into memory, so pages are read when first used, and the pages of
+ * the previous map are released when switching.
+ */
+class TpcDistortionMapSequence
+{
+ public:
+  //! constructor
+  TpcDistortionMapSequence() = default;
+
+  //! destructor
+  ~TpcDistortionMapSequence();
+
+  // no copy, the class owns the mapping
+  TpcDistortionMapSequence(const TpcDistortionMapSequence&) = delete;
+  TpcDistortionMapSequence& operator=(const TpcDistortionMapSequence&) = delete;
+
+  //! key range of a map, first and last key included
+  struct Range
+  {
+    uint64_t first = 0;
+    uint64_t last = 0;
+  };
+
+  //! write maps and their key ranges. All containers must be packed, with the same dimensions and axes
+  static bool write(const std::string& filename, const std::vector<Range>& ranges, const std::vector<const TpcDistortionCorrectionContainer*>& maps);
+
+  //! map the file into memory and read the index
+  bool open(const std::string& filename);
+
+  //! release the mapping
+  void close();
+
+  //! number of maps
+  size_t size() const
+  {
+    return m_index.size();
+  }
+
+  //! histogram dimensions of the maps (2 or 3)
+  int dimensions() const
+  {
+    return m_dimensions;
+  }
+
+  //! index of the map covering key, -1 if none
+  int find(uint64_t key) const;
+
+  //! copy map into the packed grids of the container, release the pages of the map previously loaded
+  void load(int index, TpcDistortionCorrectionContainer* container);
+
+  //! ask the kernel to read the pages of a map ahead of its use
+  void prefetch(int index) const;
+
+ private:
+  //! index entry
+  struct Entry
+  {
+    uint64_t first = 0;
+    uint64_t last = 0;
+    uint64_t offset = 0;
+  };
+
+  //! location of the values of a map in the file
+  const float* map_values(int index) const
+  {
+    return reinterpret_cast<const float*>(static_cast<const char*>(m_address) + m_index[index].offset);
+  }
+
+  //! size of the values of a map in bytes
+  size_t map_size() const;
+
+  //! advise the kernel on the pages of a map
+  void advise(int index, int advice) const;
+
+  //! axes of each side
+  std::array<std::array<TpcDistortionCorrectionContainer::PackedGrid::Axis, 3>, 2> m_axes;
+
+  std::vector<Entry> m_index;
+  int m_dimensions = 3;
+
+  //! last loaded map
+  int m_loaded = -1;
+
+  void* m_address = nullptr;
+  size_t m_file_size = 0;
+};
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef TPC_TPCGLOBALPOSITIONCACHE_H
+#define TPC_TPCGLOBALPOSITIONCACHE_H
+
+/*!
+ * \file TpcGlobalPositionCache.h
+ * \brief per event cache of the corrected global positions of the TPC clusters
+ *
+ * filled by TpcGlobalPositionCacheMaker, read by TpcGlobalPositionWrapper
+ */
+
+#include <trackbase/ActsGeometry.h>
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrDefs.h>
+
+#include <unordered_map>
+
+class TpcGlobalPositionCache
+{
+ public:
+  //! constructor
+  TpcGlobalPositionCache() = default;
+
+  //! remove all positions
+  void clear() { m_entries.clear(); }
+
+  //! reserve space for n clusters
+  void reserve(size_t n) { m_entries.reserve(n); }
+
+  //! number of cached clusters
+  size_t size() const { return m_entries.size(); }
+
+  //! store the corrected position of a cluster for a given crossing
+  void insert(TrkrDefs::cluskey key, const TrkrCluster* cluster, short int crossing, const Acts::Vector3& position)
+  {
+    m_entries[key] = {cluster, cluster->getLocalX(), cluster->getLocalY(), crossing, position};
+  }
+
+  /*!
+   * corrected position of a cluster, nullptr if it was not cached for this cluster object and crossing,
+   * or if the local position of the cluster was changed since (e.g. by PHTpcDeltaZCorrection)
+   */
+  const Acts::Vector3* find(TrkrDefs::cluskey key, const TrkrCluster* cluster, short int crossing) const
+  {
+    const auto iter = m_entries.find(key);
+    if (iter == m_entries.end())
+    {
+      return nullptr;
+    }
+    const Entry& entry = iter->second;
+    if (entry.cluster != cluster || entry.crossing != crossing ||
+        entry.localX != cluster->getLocalX() || entry.localY != cluster->getLocalY())
+    {
+      return nullptr;
+    }
+    return &entry.position;
+  }
+
+ private:
+  struct Entry
+  {
+    //! cluster the position was computed from, to detect replaced clusters
+    const TrkrCluster* cluster = nullptr;
+    //! local position the global position was computed from, to detect clusters modified in place
+    float localX = 0;
+    float localY = 0;
+    short int crossing = 0;
+    Acts::Vector3 position;
+  };
+
+  std::unordered_map<TrkrDefs::cluskey, Entry> m_entries;
+};
+
+#endif
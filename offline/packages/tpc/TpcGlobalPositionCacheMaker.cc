@@ -0,0 +1,108 @@
+/*!
+ * \file TpcGlobalPositionCacheMaker.cc
+ * \brief computes the corrected global positions of all TPC clusters once per event
+ */
+
+#include "TpcGlobalPositionCacheMaker.h"
+#include "TpcGlobalPositionCache.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+
+#include <trackbase/TrkrCluster.h>
+#include <trackbase/TrkrClusterContainer.h>
+
+#include <iostream>
+#include <utility>
+#include <vector>
+
+//_____________________________________________________________________
+TpcGlobalPositionCacheMaker::TpcGlobalPositionCacheMaker(const std::string& name)
+  : SubsysReco(name)
+{
+}
+
+//_____________________________________________________________________
+int TpcGlobalPositionCacheMaker::InitRun(PHCompositeNode* topNode)
+{
+  PHNodeIterator iter(topNode);
+  auto dstNode = dynamic_cast<PHCompositeNode*>(iter.findFirst("PHCompositeNode", "DST"));
+  if (!dstNode)
+  {
+    std::cout << "TpcGlobalPositionCacheMaker::InitRun - DST Node missing, quitting" << std::endl;
+    return Fun4AllReturnCodes::ABORTRUN;
+  }
+
+  PHNodeIterator dstIter(dstNode);
+  auto trkrNode = dynamic_cast<PHCompositeNode*>(dstIter.findFirst("PHCompositeNode", "TRKR"));
+  if (!trkrNode)
+  {
+    trkrNode = new PHCompositeNode("TRKR");
+    dstNode->addNode(trkrNode);
+  }
+
+  m_cache = findNode::getClass<TpcGlobalPositionCache>(topNode, "TpcGlobalPositionCache");
+  if (!m_cache)
+  {
+    // transient, not written out
+    m_cache = new TpcGlobalPositionCache;
+    trkrNode->addNode(new PHDataNode<TpcGlobalPositionCache>(m_cache, "TpcGlobalPositionCache"));
+  }
+
+  m_globalPositionWrapper.set_verbosity(Verbosity());
+  m_globalPositionWrapper.loadNodes(topNode);
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________
+int TpcGlobalPositionCacheMaker::process_event(PHCompositeNode* topNode)
+{
+  m_cache->clear();
+
+  auto clusterMap = findNode::getClass<TrkrClusterContainer>(topNode, m_clusterMapName);
+  if (!clusterMap)
+  {
+    std::cout << "TpcGlobalPositionCacheMaker::process_event - " << m_clusterMapName << " not found" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>> clusters;
+  for (const auto& hitsetkey : clusterMap->getHitSetKeys(TrkrDefs::TrkrId::tpcId))
+  {
+    const auto range = clusterMap->getClusters(hitsetkey);
+    for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+    {
+      clusters.emplace_back(clusIter->first, clusIter->second);
+    }
+  }
+
+  std::vector<Acts::Vector3> positions;
+  m_globalPositionWrapper.getGlobalPositionsDistortionCorrected(clusters, m_crossing, positions);
+
+  m_cache->reserve(clusters.size());
+  for (size_t i = 0; i < clusters.size(); ++i)
+  {
+    m_cache->insert(clusters[i].first, clusters[i].second, m_crossing, positions[i]);
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "TpcGlobalPositionCacheMaker::process_event - cached " << m_cache->size() << " cluster positions" << std::endl;
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_____________________________________________________________________
+int TpcGlobalPositionCacheMaker::ResetEvent(PHCompositeNode* /*topNode*/)
+{
+  if (m_cache)
+  {
+    m_cache->clear();
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
@@ -0,0 +1,53 @@
+#ifndef TPC_TPCGLOBALPOSITIONCACHEMAKER_H
+#define TPC_TPCGLOBALPOSITIONCACHEMAKER_H
+
+/*!
+ * \file TpcGlobalPositionCacheMaker.h
+ * \brief computes the corrected global positions of all TPC clusters once per event
+ *
+ * Register after the clustering (and TpcLoadDistortionCorrection). The
+ * TpcGlobalPositionWrapper of the modules that run afterwards return the
+ * cached positions for the same cluster and crossing instead of applying
+ * the crossing and distortion corrections again.
+ */
+
+#include "TpcGlobalPositionWrapper.h"
+
+#include <fun4all/SubsysReco.h>
+
+#include <string>
+
+class TpcGlobalPositionCache;
+
+class TpcGlobalPositionCacheMaker : public SubsysReco
+{
+ public:
+  //! constructor
+  TpcGlobalPositionCacheMaker(const std::string& name = "TpcGlobalPositionCacheMaker");
+
+  //! global initialization
+  int InitRun(PHCompositeNode*) override;
+
+  //! event processing
+  int process_event(PHCompositeNode*) override;
+
+  //! clear the cache, so that the positions of an event are never returned for the next one
+  int ResetEvent(PHCompositeNode*) override;
+
+  //! crossing the positions are computed for. The seeding uses crossing 0
+  void set_crossing(short int crossing) { m_crossing = crossing; }
+
+  //! cluster container name
+  void set_cluster_map_name(const std::string& name) { m_clusterMapName = name; }
+
+ private:
+  TpcGlobalPositionWrapper m_globalPositionWrapper;
+
+  TpcGlobalPositionCache* m_cache = nullptr;
+
+  short int m_crossing = 0;
+
+  std::string m_clusterMapName = "TRKR_CLUSTER";
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "TpcGlobalPositionWrapper.h"
 
 #include "TpcDistortionCorrectionContainer.h"
+#include "TpcGlobalPositionCache.h"
 
 #include <phool/getClass.h>
 #include <phool/PHCompositeNode.h>
@@ -42,6 +43,13 @@ void TpcGlobalPositionWrapper::loadNodes( PHCompositeNode* topNode )
   {
     std::cout << "TpcGlobalPositionWrapper::loadNodes - found fluctuation TPC distortion correction container" << std::endl;
   }
+
+  // corrected positions of the event, see TpcGlobalPositionCacheMaker
+  m_cache = findNode::getClass<TpcGlobalPositionCache>(topNode, "TpcGlobalPositionCache");
+  if (m_cache && m_verbosity > 0)
+  {
+    std::cout << "TpcGlobalPositionWrapper::loadNodes - found TPC cluster position cache" << std::endl;
+  }
 }
 
 //____________________________________________________________________________________________________________________
@@ -71,6 +79,19 @@ Acts::Vector3 TpcGlobalPositionWrapper::applyDistortionCorrections(Acts::Vector3
   return global;
 }
 
+//____________________________________________________________________________________________________________________
+void TpcGlobalPositionWrapper::applyDistortionCorrections(std::vector<Acts::Vector3>& positions) const
+{
+  // apply each correction to all positions before moving to the next one
+  for (const auto& dcc : {m_dcc_module_edge, m_dcc_static, m_dcc_average, m_dcc_fluctuation})
+  {
+    if (dcc)
+    {
+      m_distortionCorrection.get_corrected_positions(positions, dcc);
+    }
+  }
+}
+
 //____________________________________________________________________________________________________________________
 Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey& key, TrkrCluster* cluster, short int crossing ) const
 {
@@ -81,11 +102,22 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
     return {0,0,0};
   }
 
+  const bool is_tpc = TrkrDefs::getTrkrId(key) == TrkrDefs::TrkrId::tpcId;
+
+  // position already computed for this event
+  if( is_tpc && m_cache )
+  {
+    if( const auto cached = m_cache->find(key, cluster, crossing) )
+    {
+      return *cached;
+    }
+  }
+
   // get global position from acts
   Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
 
   // make sure cluster is from TPC
-  if( TrkrDefs::getTrkrId(key) == TrkrDefs::TrkrId::tpcId )
+  if( is_tpc )
   {
 
     // verify crossing validity
@@ -104,3 +136,46 @@ Acts::Vector3 TpcGlobalPositionWrapper::getGlobalPositionDistortionCorrected(con
 
   return global;
 }
+
+//____________________________________________________________________________________________________________________
+void TpcGlobalPositionWrapper::getGlobalPositionsDistortionCorrected(
+  const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& clusters,
+  short int crossing, std::vector<Acts::Vector3>& positions ) const
+{
+  positions.clear();
+  if( !m_tGeometry )
+  {
+    std::cout << "TpcGlobalPositionWrapper::getGlobalPositionsDistortionCorrected - m_tGeometry not set" << std::endl;
+    positions.resize(clusters.size(), {0,0,0});
+    return;
+  }
+
+  // global positions from acts, crossing correction for TPC clusters
+  positions.reserve(clusters.size());
+  std::vector<size_t> tpc_index;
+  std::vector<Acts::Vector3> tpc_positions;
+  for( const auto& [key, cluster] : clusters )
+  {
+    Acts::Vector3 global = m_tGeometry->getGlobalPosition(key, cluster);
+    if( TrkrDefs::getTrkrId(key) == TrkrDefs::TrkrId::tpcId && crossing != SHRT_MAX )
+    {
+      global.z() = m_crossingCorrection.correctZ(global.z(), TpcDefs::getSide(key), crossing);
+      tpc_index.push_back(positions.size());
+      tpc_positions.push_back(global);
+    }
+    positions.push_back(global);
+  }
+
+  if( crossing == SHRT_MAX )
+  {
+    std::cout << "TpcGlobalPositionWrapper::getGlobalPositionsDistortionCorrected - invalid crossing." << std::endl;
+    return;
+  }
+
+  // distortion corrections, one correction at a time for all TPC clusters
+  applyDistortionCorrections(tpc_positions);
+  for( size_t i = 0; i < tpc_index.size(); ++i )
+  {
+    positions[tpc_index[i]] = tpc_positions[i];
+  }
+}
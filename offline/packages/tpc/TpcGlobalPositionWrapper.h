@@ -11,10 +11,13 @@
 
 #include <trackbase/TrkrDefs.h>
 
+#include <utility>
+#include <vector>
 
 class ActsGeometry;
 class PHCompositeNode;
 class TpcDistortionCorrectionContainer;
+class TpcGlobalPositionCache;
 class TrkrCluster;
 
 class TpcGlobalPositionWrapper
@@ -42,6 +45,9 @@ class TpcGlobalPositionWrapper
   //! apply all loaded distortion corrections to a given position
   Acts::Vector3 applyDistortionCorrections( Acts::Vector3 /*source*/ ) const;
 
+  //! apply all loaded distortion corrections to a set of positions, in place
+  void applyDistortionCorrections( std::vector<Acts::Vector3>& /*positions*/ ) const;
+
   //! get distortion corrected global position from cluster
   /**
    * first converts cluster position local coordinate to global coordinates
@@ -49,6 +55,14 @@ class TpcGlobalPositionWrapper
    */
   Acts::Vector3 getGlobalPositionDistortionCorrected(const TrkrDefs::cluskey&, TrkrCluster*, short int /*crossing*/ ) const;
 
+  //! get distortion corrected global positions for a set of clusters
+  /**
+   * same as above, the distortion corrections are applied to all TPC clusters in one pass.
+   * The position cache is not used
+   */
+  void getGlobalPositionsDistortionCorrected(const std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>>& /*clusters*/,
+    short int /*crossing*/, std::vector<Acts::Vector3>& /*positions*/ ) const;
+
   private:
 
   //! verbosity
@@ -75,6 +89,9 @@ class TpcGlobalPositionWrapper
   //! fluctuation distortion container
   TpcDistortionCorrectionContainer* m_dcc_fluctuation{nullptr};
 
+  //! positions computed by TpcGlobalPositionCacheMaker for this event, if present
+  TpcGlobalPositionCache* m_cache{nullptr};
+
 };
 
 #endif
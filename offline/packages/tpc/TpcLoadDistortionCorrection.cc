@@ -6,6 +6,10 @@
 
 #include "TpcLoadDistortionCorrection.h"
 #include "TpcDistortionCorrectionContainer.h"
+#include "TpcDistortionMapSequence.h"
+
+#include <ffarawobjects/Gl1Packet.h>
+#include <ffarawobjects/Gl1RawHit.h>
 
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <phool/PHCompositeNode.h>
@@ -15,6 +19,9 @@
 #include <TFile.h>
 #include <TH1.h>
 
+#include <algorithm>
+#include <cstdint>
+
 namespace
 {
 
@@ -45,6 +52,9 @@ TpcLoadDistortionCorrection::TpcLoadDistortionCorrection(const std::string& name
 {
 }
 
+//_____________________________________________________________________
+TpcLoadDistortionCorrection::~TpcLoadDistortionCorrection() = default;
+
 //_____________________________________________________________________
 int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
 {
@@ -83,6 +93,27 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
       runNode->addNode(node);
     }
 
+    // time ordered maps are loaded event by event
+    if (!m_sequence_filename[i].empty())
+    {
+      std::cout << "TpcLoadDistortionCorrection::InitRun - reading time ordered corrections from " << m_sequence_filename[i] << std::endl;
+      m_sequence[i] = std::make_unique<TpcDistortionMapSequence>();
+      if (!m_sequence[i]->open(m_sequence_filename[i]))
+      {
+        std::cout << "TpcLoadDistortionCorrection::InitRun - cannot open " << m_sequence_filename[i] << std::endl;
+        exit(1);
+      }
+      distortion_correction_object->m_dimensions = m_sequence[i]->dimensions();
+      distortion_correction_object->m_phi_hist_in_radians = m_phi_hist_in_radians[i];
+      distortion_correction_object->m_interpolate_z = m_interpolate_z[i];
+      distortion_correction_object->m_use_scalefactor = m_use_scalefactor[i];
+      distortion_correction_object->m_scalefactor = m_scalefactor[i];
+      m_sequence_container[i] = distortion_correction_object;
+      m_sequence_index[i] = -1;
+      m_sequence[i]->prefetch(0);
+      continue;
+    }
+
     std::cout << "TpcLoadDistortionCorrection::InitRun - reading corrections from " << m_correction_filename[i] << std::endl;
     auto distortion_tfile = TFile::Open(m_correction_filename[i].c_str());
     if (!distortion_tfile)
@@ -118,6 +149,8 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
     distortion_correction_object->m_use_scalefactor = m_use_scalefactor[i];
     distortion_correction_object->m_scalefactor = m_scalefactor[i];
 
+    // copy histograms into packed interpolation grids
+    distortion_correction_object->pack();
 
     if (Verbosity())
     {
@@ -134,7 +167,61 @@ int TpcLoadDistortionCorrection::InitRun(PHCompositeNode* topNode)
 }
 
 //_____________________________________________________________________
-int TpcLoadDistortionCorrection::process_event(PHCompositeNode* /*unused*/)
+int TpcLoadDistortionCorrection::process_event(PHCompositeNode* topNode)
 {
+  if (std::none_of(m_sequence.begin(), m_sequence.end(), [](const auto& sequence) { return bool(sequence); }))
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
+  // BCO of the current event
+  uint64_t bco = 0;
+  if (auto gl1 = findNode::getClass<Gl1RawHit>(topNode, "GL1RAWHIT"))
+  {
+    bco = gl1->get_bco();
+  }
+  else if (auto gl1packet = findNode::getClass<Gl1Packet>(topNode, "GL1RAWHIT"))
+  {
+    bco = gl1packet->getBCO();
+  }
+  else
+  {
+    std::cout << "TpcLoadDistortionCorrection::process_event - GL1RAWHIT node missing, cannot select time ordered corrections" << std::endl;
+    return Fun4AllReturnCodes::ABORTEVENT;
+  }
+
+  for (int i = 0; i < nDistortionTypes; ++i)
+  {
+    if (!m_sequence[i])
+    {
+      continue;
+    }
+
+    const int index = m_sequence[i]->find(bco);
+    if (index == m_sequence_index[i])
+    {
+      continue;
+    }
+
+    if (index < 0)
+    {
+      // no map for this BCO, no correction
+      if (Verbosity())
+      {
+        std::cout << "TpcLoadDistortionCorrection::process_event - no " << m_node_name[i] << " map for bco " << bco << std::endl;
+      }
+      m_sequence_container[i]->m_packed = {};
+    }
+    else
+    {
+      if (Verbosity())
+      {
+        std::cout << "TpcLoadDistortionCorrection::process_event - loading " << m_node_name[i] << " map " << index << " for bco " << bco << std::endl;
+      }
+      m_sequence[i]->load(index, m_sequence_container[i]);
+      m_sequence[i]->prefetch(index + 1);
+    }
+    m_sequence_index[i] = index;
+  }
   return Fun4AllReturnCodes::EVENT_OK;
 }
@@ -13,8 +13,11 @@
 #include <trackbase/TrkrDefs.h>
 
 #include <array>
+#include <memory>
 
 class TH3;
+class TpcDistortionCorrectionContainer;
+class TpcDistortionMapSequence;
 
 class TpcLoadDistortionCorrection : public SubsysReco
 {
@@ -22,6 +25,9 @@ class TpcLoadDistortionCorrection : public SubsysReco
   //! constructor
   TpcLoadDistortionCorrection(const std::string& = "TpcLoadDistortionCorrection");
 
+  //! destructor
+  ~TpcLoadDistortionCorrection() override;
+
   //! global initialization
   int InitRun(PHCompositeNode*) override;
 
@@ -47,6 +53,18 @@ class TpcLoadDistortionCorrection : public SubsysReco
     m_correction_in_use[i] = true;
   }
 
+  //! time ordered correction file, see TpcDistortionMapSequence
+  /**
+   * replaces the histogram file for this distortion type.
+   * The map covering the GL1 BCO of each event is loaded on demand
+   */
+  void set_correction_sequence_filename(DistortionType i, const std::string& value)
+  {
+    if (i < 0 || i >= nDistortionTypes) return;
+    m_sequence_filename[i] = value;
+    m_correction_in_use[i] = true;
+  }
+
   //! set the scale factor to be applied to the correction
   void set_scale_factor(DistortionType i, float value)
   {
@@ -105,6 +123,18 @@ class TpcLoadDistortionCorrection : public SubsysReco
   //! z interpolation
   std::array<bool,nDistortionTypes> m_interpolate_z = {true,true,true,true};
 
+  //! time ordered correction filename
+  std::array<std::string,nDistortionTypes> m_sequence_filename = {};
+
+  //! time ordered maps, for the distortion types read from a sequence file
+  std::array<std::unique_ptr<TpcDistortionMapSequence>,nDistortionTypes> m_sequence;
+
+  //! distortion objects filled from a sequence
+  std::array<TpcDistortionCorrectionContainer*,nDistortionTypes> m_sequence_container = {};
+
+  //! index of the map currently loaded from each sequence
+  std::array<int,nDistortionTypes> m_sequence_index = {-1,-1,-1,-1};
+
   //! distortion object node name
   std::array<std::string,nDistortionTypes> m_node_name = {"TpcDistortionCorrectionContainerStatic", "TpcDistortionCorrectionContainerAverage", "TpcDistortionCorrectionContainerFluctuation","TpcDistortionCorrectionContainerModuleEdge"};
 };
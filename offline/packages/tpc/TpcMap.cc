@@ -161,7 +161,14 @@ int TpcMap::digest_map(const std::string &fileName, const unsigned int section_o
     x.PadR = PadR;
     x.PadPhi = PadPhi;
 
-    unsigned int key = 256 * (FEE) + FEE_Chan;
+    x.valid = true;
+
+    if (FEE < 0 || FEE_Chan < 0 || FEE >= (int) NFEE || FEE_Chan >= (int) NFEECHANNEL)
+    {
+      std::cout << "TpcMap: FEE " << FEE << " channel " << FEE_Chan << " out of range in " << fileName << std::endl;
+      continue;
+    }
+    unsigned int key = NFEECHANNEL * (FEE) + FEE_Chan;
     tmap[key] = x;
     //if(Radius<0){
     //  std::cout << " " << key << " " << FEE << " " << FEE_Chan << " " << PadR << "  " << PadPhi << " " << Radius << std::endl;
@@ -170,66 +177,48 @@ int TpcMap::digest_map(const std::string &fileName, const unsigned int section_o
   return 0;
 }
 
-unsigned int TpcMap::getLayer(const unsigned int FEE, const unsigned int FEEChannel, const unsigned int /* packetid */) const
+const struct TpcMap::tpc_map *TpcMap::find(const unsigned int FEE, const unsigned int FEEChannel) const
 {
-  if (FEE >= 26 || FEEChannel > 255)
+  if (FEE >= NFEE || FEEChannel >= NFEECHANNEL)
   {
-    return 0.;
+    return nullptr;
   }
-  unsigned int key = 256 * FEE + FEEChannel;
+  const struct tpc_map *entry = &tmap[NFEECHANNEL * FEE + FEEChannel];
+  return entry->valid ? entry : nullptr;
+}
 
-  std::map<unsigned int, struct tpc_map>::const_iterator itr = tmap.find(key);
-  if (itr == tmap.end())
-  {
-    return 0;
-  }
-  return itr->second.layer;
+unsigned int TpcMap::getLayer(const unsigned int FEE, const unsigned int FEEChannel, const unsigned int /* packetid */) const
+{
+  const struct tpc_map *entry = find(FEE, FEEChannel);
+  return entry ? entry->layer : 0;
 }
 
 unsigned int TpcMap::getPad(const unsigned int FEE, const unsigned int FEEChannel, const unsigned int /* packetid */) const
 {
-  if (FEE >= 26 || FEEChannel > 255)
+  if (FEE >= NFEE || FEEChannel >= NFEECHANNEL)
   {
     return 0.;
   }
-  unsigned int key = 256 * FEE + FEEChannel;
-
-  std::map<unsigned int, struct tpc_map>::const_iterator itr = tmap.find(key);
-  if (itr == tmap.end())
-  {
-    return -100;
-  }
-  return itr->second.padnr;
+  const struct tpc_map *entry = find(FEE, FEEChannel);
+  return entry ? entry->padnr : -100;
 }
 
 double TpcMap::getR(const unsigned int FEE, const unsigned int FEEChannel, const unsigned int /* packetid */) const
 {
-  if (FEE >= 26 || FEEChannel > 255)
+  if (FEE >= NFEE || FEEChannel >= NFEECHANNEL)
   {
     return 0.;
   }
-  unsigned int key = 256 * FEE + FEEChannel;
-
-  std::map<unsigned int, struct tpc_map>::const_iterator itr = tmap.find(key);
-  if (itr == tmap.end())
-  {
-    return -100;
-  }
-  return itr->second.PadR;
+  const struct tpc_map *entry = find(FEE, FEEChannel);
+  return entry ? entry->PadR : -100;
 }
 
 double TpcMap::getPhi(const unsigned int FEE, const unsigned int FEEChannel, const unsigned int /* packetid */) const
 {
-  if (FEE > 25 || FEEChannel > 255)
+  if (FEE >= NFEE || FEEChannel >= NFEECHANNEL)
   {
     return 0.;
   }
-  unsigned int key = 256 * FEE + FEEChannel;
-
-  std::map<unsigned int, struct tpc_map>::const_iterator itr = tmap.find(key);
-  if (itr == tmap.end())
-  {
-    return -100;
-  }
-  return itr->second.PadPhi;
+  const struct tpc_map *entry = find(FEE, FEEChannel);
+  return entry ? entry->PadPhi : -100;
 }
@@ -1,7 +1,7 @@
 #ifndef __TpcMap_H__
 #define __TpcMap_H__
 
-#include <map>
+#include <array>
 #include <string>
 
 class TpcMap
@@ -20,6 +20,9 @@ class TpcMap
  private:
   int digest_map(const std::string &fileName, const unsigned int section_offset);
 
+  static constexpr unsigned int NFEE = 26;
+  static constexpr unsigned int NFEECHANNEL = 256;
+
   int _broken = 0;
   struct tpc_map
   {
@@ -29,9 +32,14 @@ class TpcMap
     unsigned int FEEChannel;
     double PadR;
     double PadPhi;
+    bool valid{false};
   };
 
-  std::map<unsigned int, struct tpc_map> tmap;
+  // indexed by 256 * FEE + FEEChannel, queried for every hit
+  std::array<struct tpc_map, NFEE * NFEECHANNEL> tmap{};
+
+  //! entry of FEE, FEEChannel or nullptr if out of range or not in the map
+  const struct tpc_map *find(const unsigned int FEE, const unsigned int FEEChannel) const;
 };
 
 #endif
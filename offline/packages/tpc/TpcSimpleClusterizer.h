@@ -6,10 +6,12 @@
 #include <trackbase/TrkrCluster.h>
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 class PHCompositeNode;
+class PHThreadPool;
 class TrkrHitSet;
 class TrkrHitSetContainer;
 class TrkrClusterContainer;
@@ -26,7 +28,7 @@ class TpcSimpleClusterizer : public SubsysReco
 {
  public:
   TpcSimpleClusterizer(const std::string &name = "TpcSimpleClusterizer");
-  ~TpcSimpleClusterizer() override = default;
+  ~TpcSimpleClusterizer() override;
 
   int InitRun(PHCompositeNode *topNode) override;
   int process_event(PHCompositeNode *topNode) override;
@@ -34,6 +36,8 @@ class TpcSimpleClusterizer : public SubsysReco
 
   void set_sector_fiducial_cut(const double cut) { SectorFiducialCut = cut; }
   void set_do_hit_association(bool do_assoc) { do_hit_assoc = do_assoc; }
+  //! number of clustering threads, 0 (default) uses all cores
+  void set_num_threads(unsigned int n) { m_nthreads = n; }
 
  private:
   bool is_in_sector_boundary(int phibin, int sector, PHG4TpcCylinderGeom *layergeom) const;
@@ -51,6 +55,9 @@ class TpcSimpleClusterizer : public SubsysReco
   // From Tony Frawley May 13, 2021
   double par0_neg = 0.0503;
   double par0_pos = -0.0503;
+
+  std::unique_ptr<PHThreadPool> m_threadpool;
+  unsigned int m_nthreads = 0;
 };
 
 #endif
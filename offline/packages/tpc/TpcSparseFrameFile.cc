@@ -0,0 +1,366 @@
+/*!
+ * \file TpcSparseFrameFile.cc
+ * \brief binary file of zero suppressed TPC frames (TpcSparseFrameContainer), one record per event, read from a memory mapped file
+ */
+
+#include "TpcSparseFrameFile.h"
+
+#include <trackbase/TpcDefs.h>
+#include <trackbase/TpcSparseFrame.h>
+#include <trackbase/TpcSparseFrameContainer.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <tuple>
+
+namespace
+{
+  // file header
+  struct FileHeader
+  {
+    char magic[8];
+    uint32_t version;
+    int32_t runnumber;
+    uint64_t nevents;
+    uint64_t index_offset;
+  };
+
+  // header of an event record
+  struct EventHeader
+  {
+    uint32_t nframes;
+    uint32_t reserved;
+  };
+
+  // directory entry of a frame, offset relative to the start of the event record
+  struct FrameEntry
+  {
+    uint32_t hitsetkey;
+    uint16_t pad_start;
+    uint16_t reserved;
+    uint32_t nruns;
+    uint32_t nadcs;
+    uint64_t offset;
+  };
+
+  // stored run, the offset of the ADCs follows from the run lengths
+  struct StoredRun
+  {
+    uint16_t pad;
+    uint16_t tbin;
+    uint16_t length;
+  };
+
+  constexpr char kMagic[8] = {'T', 'P', 'C', 'S', 'P', 'F', 'R', 'M'};
+  constexpr uint32_t kVersion = 1;
+
+  // all records are multiples of two bytes, so the mapped ADCs are aligned
+  static_assert(sizeof(FileHeader) % 8 == 0 && sizeof(EventHeader) % 8 == 0 && sizeof(FrameEntry) % 8 == 0 && sizeof(StoredRun) == 6);
+
+  // read a value from the mapped file, false if past its end
+  template <class T>
+  bool read_at(const char* base, size_t file_size, size_t offset, T* value, size_t count = 1)
+  {
+    if (offset > file_size || count * sizeof(T) > file_size - offset)
+    {
+      return false;
+    }
+    std::memcpy(value, base + offset, count * sizeof(T));
+    return true;
+  }
+
+  // sector major order of the frames
+  auto sector_major(const TrkrDefs::hitsetkey key)
+  {
+    return std::make_tuple(TpcDefs::getSide(key), TpcDefs::getSectorId(key), TrkrDefs::getLayer(key));
+  }
+}  // namespace
+
+//_____________________________________________________________________
+TpcSparseFrameFile::Writer::~Writer()
+{
+  if (m_out.is_open())
+  {
+    close();
+  }
+}
+
+//_____________________________________________________________________
+bool TpcSparseFrameFile::Writer::open(const std::string& filename, const int runnumber)
+{
+  if (m_out.is_open())
+  {
+    close();
+  }
+  m_index.clear();
+  m_runnumber = runnumber;
+  m_out.open(filename, std::ios::binary | std::ios::trunc);
+  if (!m_out)
+  {
+    std::cout << "TpcSparseFrameFile::Writer::open - cannot open " << filename << std::endl;
+    return false;
+  }
+  // placeholder, rewritten with the event count and index offset by close()
+  FileHeader header{};
+  m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  return m_out.good();
+}
+
+//_____________________________________________________________________
+bool TpcSparseFrameFile::Writer::write(const TpcSparseFrameContainer& frames)
+{
+  if (!m_out.is_open())
+  {
+    return false;
+  }
+
+  // non empty frames in sector major order
+  std::vector<std::pair<TrkrDefs::hitsetkey, const TpcSparseFrame*>> ordered;
+  for (const auto& [hitsetkey, frame] : frames)
+  {
+    if (!frame.empty())
+    {
+      ordered.emplace_back(hitsetkey, &frame);
+    }
+  }
+  std::sort(ordered.begin(), ordered.end(), [](const auto& lhs, const auto& rhs)
+            { return sector_major(lhs.first) < sector_major(rhs.first); });
+
+  // directory
+  const EventHeader eventheader = {static_cast<uint32_t>(ordered.size()), 0};
+  uint64_t offset = sizeof(EventHeader) + ordered.size() * sizeof(FrameEntry);
+  std::vector<FrameEntry> directory;
+  directory.reserve(ordered.size());
+  for (const auto& [hitsetkey, frame] : ordered)
+  {
+    // sorting may shorten runs, only the ADCs still covered by a run are stored
+    uint32_t nadcs = 0;
+    for (const auto& run : frame->get_runs())
+    {
+      nadcs += run.length;
+    }
+    const FrameEntry entry = {hitsetkey, frame->get_pad_start(), 0,
+                              static_cast<uint32_t>(frame->get_runs().size()),
+                              nadcs, offset};
+    directory.push_back(entry);
+    offset += entry.nruns * sizeof(StoredRun) + entry.nadcs * sizeof(uint16_t);
+  }
+
+  Event event;
+  event.offset = m_out.tellp();
+  event.size = offset;
+
+  m_out.write(reinterpret_cast<const char*>(&eventheader), sizeof(eventheader));
+  m_out.write(reinterpret_cast<const char*>(directory.data()), directory.size() * sizeof(FrameEntry));
+  std::vector<StoredRun> runs;
+  for (const auto& [hitsetkey, frame] : ordered)
+  {
+    runs.clear();
+    for (const auto& run : frame->get_runs())
+    {
+      runs.push_back({run.pad, run.tbin, run.length});
+    }
+    m_out.write(reinterpret_cast<const char*>(runs.data()), runs.size() * sizeof(StoredRun));
+    // the ADCs of a sorted frame are stored in run order
+    for (const auto& run : frame->get_runs())
+    {
+      m_out.write(reinterpret_cast<const char*>(frame->get_adcs().data() + run.offset), run.length * sizeof(uint16_t));
+    }
+  }
+  m_index.push_back(event);
+  return m_out.good();
+}
+
+//_____________________________________________________________________
+bool TpcSparseFrameFile::Writer::close()
+{
+  if (!m_out.is_open())
+  {
+    return false;
+  }
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.runnumber = m_runnumber;
+  header.nevents = m_index.size();
+  header.index_offset = m_out.tellp();
+  m_out.write(reinterpret_cast<const char*>(m_index.data()), m_index.size() * sizeof(Event));
+  m_out.seekp(0);
+  m_out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  const bool good = m_out.good();
+  m_out.close();
+  return good;
+}
+
+//_____________________________________________________________________
+TpcSparseFrameFile::Reader::~Reader()
+{
+  close();
+}
+
+//_____________________________________________________________________
+bool TpcSparseFrameFile::Reader::open(const std::string& filename)
+{
+  close();
+
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    std::cout << "TpcSparseFrameFile::Reader::open - cannot open " << filename << std::endl;
+    return false;
+  }
+  struct stat filestat;
+  if (fstat(fd, &filestat) != 0 || static_cast<size_t>(filestat.st_size) < sizeof(FileHeader))
+  {
+    std::cout << "TpcSparseFrameFile::Reader::open - " << filename << " is too short" << std::endl;
+    ::close(fd);
+    return false;
+  }
+  m_file_size = filestat.st_size;
+  m_address = mmap(nullptr, m_file_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (m_address == MAP_FAILED)
+  {
+    std::cout << "TpcSparseFrameFile::Reader::open - cannot map " << filename << std::endl;
+    m_address = nullptr;
+    m_file_size = 0;
+    return false;
+  }
+
+  // header and index
+  const char* base = static_cast<const char*>(m_address);
+  FileHeader header{};
+  read_at(base, m_file_size, 0, &header);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion)
+  {
+    std::cout << "TpcSparseFrameFile::Reader::open - " << filename << " is not a TPC sparse frame file (or was not closed)" << std::endl;
+    close();
+    return false;
+  }
+  m_runnumber = header.runnumber;
+  bool valid = header.nevents <= m_file_size / sizeof(Event);
+  if (valid)
+  {
+    m_index.resize(header.nevents);
+    valid = read_at(base, m_file_size, header.index_offset, m_index.data(), m_index.size());
+  }
+
+  // records must be inside the file, before the index
+  for (size_t i = 0; valid && i < m_index.size(); ++i)
+  {
+    valid = m_index[i].offset >= sizeof(FileHeader) &&
+            m_index[i].size >= sizeof(EventHeader) &&
+            m_index[i].offset % 2 == 0 &&
+            m_index[i].offset + m_index[i].size <= header.index_offset;
+  }
+  if (!valid)
+  {
+    std::cout << "TpcSparseFrameFile::Reader::open - " << filename << " is corrupted" << std::endl;
+    close();
+    return false;
+  }
+  return true;
+}
+
+//_____________________________________________________________________
+void TpcSparseFrameFile::Reader::close()
+{
+  if (m_address)
+  {
+    munmap(m_address, m_file_size);
+  }
+  m_address = nullptr;
+  m_file_size = 0;
+  m_index.clear();
+}
+
+//_____________________________________________________________________
+bool TpcSparseFrameFile::Reader::read(const size_t i, TpcSparseFrameContainer& frames, const Selection& select) const
+{
+  frames.Reset();
+  if (i >= m_index.size())
+  {
+    return false;
+  }
+
+  const char* record = static_cast<const char*>(m_address) + m_index[i].offset;
+  const size_t record_size = m_index[i].size;
+  EventHeader eventheader{};
+  read_at(record, record_size, 0, &eventheader);
+  if (eventheader.nframes > (record_size - sizeof(EventHeader)) / sizeof(FrameEntry))
+  {
+    std::cout << "TpcSparseFrameFile::Reader::read - corrupted event " << i << std::endl;
+    return false;
+  }
+  std::vector<FrameEntry> directory(eventheader.nframes);
+  read_at(record, record_size, sizeof(EventHeader), directory.data(), directory.size());
+
+  std::vector<StoredRun> runs;
+  for (const auto& entry : directory)
+  {
+    if (select && !select(entry.hitsetkey))
+    {
+      continue;
+    }
+    runs.resize(entry.nruns);
+    const uint64_t adc_offset = entry.offset + entry.nruns * sizeof(StoredRun);
+    if (!read_at(record, record_size, entry.offset, runs.data(), runs.size()) ||
+        adc_offset + entry.nadcs * sizeof(uint16_t) > record_size)
+    {
+      std::cout << "TpcSparseFrameFile::Reader::read - corrupted frame " << entry.hitsetkey << " in event " << i << std::endl;
+      return false;
+    }
+
+    // ADCs are used in place, the records are 2 byte aligned
+    const uint16_t* adcs = reinterpret_cast<const uint16_t*>(record + adc_offset);
+    const uint16_t* adcs_end = adcs + entry.nadcs;
+    TpcSparseFrame& frame = frames.findOrAddFrame(entry.hitsetkey);
+    frame.set_pad_start(entry.pad_start);
+    for (const auto& run : runs)
+    {
+      if (adcs + run.length > adcs_end)
+      {
+        std::cout << "TpcSparseFrameFile::Reader::read - corrupted frame " << entry.hitsetkey << " in event " << i << std::endl;
+        return false;
+      }
+      // runs were written sorted, no need to sort again
+      frame.add_run(run.pad, run.tbin, adcs, run.length);
+      adcs += run.length;
+    }
+  }
+  return true;
+}
+
+//_____________________________________________________________________
+void TpcSparseFrameFile::Reader::prefetch(const size_t i) const
+{
+  if (i < m_index.size())
+  {
+    advise(i, MADV_WILLNEED);
+  }
+}
+
+//_____________________________________________________________________
+void TpcSparseFrameFile::Reader::release(const size_t i) const
+{
+  if (i < m_index.size())
+  {
+    advise(i, MADV_DONTNEED);
+  }
+}
+
+//_____________________________________________________________________
+void TpcSparseFrameFile::Reader::advise(const size_t i, const int advice) const
+{
+  // madvise works on whole pages
+  const size_t page = sysconf(_SC_PAGESIZE);
+  const size_t begin = m_index[i].offset / page * page;
+  const size_t end = std::min(m_file_size, m_index[i].offset + m_index[i].size);
+  madvise(static_cast<char*>(m_address) + begin, end - begin, advice);
+}
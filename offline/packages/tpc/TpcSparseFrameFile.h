@@ -0,0 +1,117 @@
+#ifndef TPC_TPCSPARSEFRAMEFILE_H
+#define TPC_TPCSPARSEFRAMEFILE_H
+
+/*!
+ * \file TpcSparseFrameFile.h
+ * \brief binary file of zero suppressed TPC frames (TpcSparseFrameContainer), one record per event, read from a memory mapped file
+ */
+
+#include <trackbase/TrkrDefs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+class TpcSparseFrameContainer;
+
+/*!
+ * Layout (version 1), all integers little endian as written by the host:
+ * - file header: magic, version, run number, number of events, offset of the event index
+ * - per event: number of frames, then a directory of (hitsetkey, pad start, number of runs,
+ *   number of ADCs, offset) ordered by side, sector and layer, then the runs
+ *   (pad, first time bin, length) and ADCs of each frame in directory order
+ * - event index: (offset, size) of each event record
+ *
+ * The frames of one sector are contiguous, so reading a subset of sectors only
+ * touches their pages. No ROOT streaming is involved in either direction.
+ */
+namespace TpcSparseFrameFile
+{
+  //! index entry of one event record
+  struct Event
+  {
+    uint64_t offset = 0;
+    uint64_t size = 0;
+  };
+
+  //! writes the records sequentially, the index and the final header are written by close()
+  class Writer
+  {
+   public:
+    Writer() = default;
+    ~Writer();
+
+    // no copy, the class owns the stream
+    Writer(const Writer&) = delete;
+    Writer& operator=(const Writer&) = delete;
+
+    //! create file, false on failure
+    bool open(const std::string& filename, const int runnumber);
+
+    //! append one event, empty frames are skipped
+    bool write(const TpcSparseFrameContainer& frames);
+
+    //! write index and header and close the file
+    bool close();
+
+    bool is_open() const { return m_out.is_open(); }
+    size_t size() const { return m_index.size(); }
+
+   private:
+    std::ofstream m_out;
+    std::vector<Event> m_index;
+    int m_runnumber = 0;
+  };
+
+  //! maps the file into memory, events are decoded from the mapped pages
+  class Reader
+  {
+   public:
+    Reader() = default;
+    ~Reader();
+
+    // no copy, the class owns the mapping
+    Reader(const Reader&) = delete;
+    Reader& operator=(const Reader&) = delete;
+
+    //! map the file and read the index
+    bool open(const std::string& filename);
+
+    //! release the mapping
+    void close();
+
+    bool is_open() const { return m_address != nullptr; }
+
+    //! number of events
+    size_t size() const { return m_index.size(); }
+
+    int runnumber() const { return m_runnumber; }
+
+    //! selection of frames by hitset key, all frames if empty
+    using Selection = std::function<bool(TrkrDefs::hitsetkey)>;
+
+    //! reset frames and fill them with the (selected) frames of event i
+    bool read(const size_t i, TpcSparseFrameContainer& frames, const Selection& select = nullptr) const;
+
+    //! ask the kernel to read the pages of event i ahead of its use
+    void prefetch(const size_t i) const;
+
+    //! pages of event i are not needed anymore
+    void release(const size_t i) const;
+
+   private:
+    void advise(const size_t i, const int advice) const;
+
+    std::vector<Event> m_index;
+    int m_runnumber = 0;
+
+    void* m_address = nullptr;
+    size_t m_file_size = 0;
+  };
+
+}  // namespace TpcSparseFrameFile
+
+#endif
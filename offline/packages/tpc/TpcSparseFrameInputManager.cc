@@ -0,0 +1,184 @@
+#include "TpcSparseFrameInputManager.h"
+
+#include <trackbase/TpcDefs.h>
+#include <trackbase/TpcSparseFrameContainer.h>
+
+#include <fun4all/Fun4AllServer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/PHNodeIterator.h>
+#include <phool/getClass.h>
+#include <phool/phool.h>
+
+#include <algorithm>
+#include <iostream>
+
+//______________________________________________________
+TpcSparseFrameInputManager::TpcSparseFrameInputManager(const std::string &name, const std::string &nodename, const std::string &topnodename)
+  : Fun4AllInputManager(name, nodename, topnodename)
+{
+}
+
+//______________________________________________________
+int TpcSparseFrameInputManager::fileopen(const std::string &filenam)
+{
+  if (IsOpen())
+  {
+    std::cout << "Closing currently open file "
+              << FileName()
+              << " and opening " << filenam << std::endl;
+    fileclose();
+  }
+  FileName(filenam);
+  if (!m_Reader.open(FileName()))
+  {
+    std::cout << PHWHERE << ": " << Name() << " Could not open file "
+              << FileName() << std::endl;
+    return -1;
+  }
+  if (Verbosity() > 0)
+  {
+    std::cout << Name() << ": opening file " << FileName() << " with "
+              << m_Reader.size() << " events" << std::endl;
+  }
+  SetRunNumber(m_Reader.runnumber());
+  m_Event = 0;
+  m_Reader.prefetch(m_Event);
+  IsOpen(1);
+  AddToFileOpened(FileName());
+  return 0;
+}
+
+//______________________________________________________
+int TpcSparseFrameInputManager::fileclose()
+{
+  if (!IsOpen())
+  {
+    std::cout << Name() << ": fileclose: No Input file open" << std::endl;
+    return -1;
+  }
+  m_Reader.close();
+  IsOpen(0);
+  UpdateFileList();
+  return 0;
+}
+
+//______________________________________________________
+TpcSparseFrameContainer *TpcSparseFrameInputManager::getFrames()
+{
+  Fun4AllServer *se = Fun4AllServer::instance();
+  PHCompositeNode *dstNode = se->getNode(InputNode(), TopNodeName());
+  auto frames = findNode::getClass<TpcSparseFrameContainer>(dstNode, "TRKR_TPCSPARSEFRAME");
+  if (!frames)
+  {
+    // same place as TpcCombinedRawDataUnpacker puts it, transient
+    PHNodeIterator iter(dstNode);
+    auto trkrNode = dynamic_cast<PHCompositeNode *>(iter.findFirst("PHCompositeNode", "TRKR"));
+    if (!trkrNode)
+    {
+      trkrNode = new PHCompositeNode("TRKR");
+      dstNode->addNode(trkrNode);
+    }
+    frames = new TpcSparseFrameContainer;
+    trkrNode->addNode(new PHDataNode<TpcSparseFrameContainer>(frames, "TRKR_TPCSPARSEFRAME"));
+  }
+  return frames;
+}
+
+//______________________________________________________
+int TpcSparseFrameInputManager::run(const int nevents)
+{
+  TpcSparseFrameContainer *frames = getFrames();
+  TpcSparseFrameFile::Reader::Selection select;
+  if (m_FirstSector >= 0 || m_LastSector >= 0)
+  {
+    select = [this](const TrkrDefs::hitsetkey key)
+    {
+      const int sector = TpcDefs::getSectorId(key);
+      return (m_FirstSector < 0 || sector >= m_FirstSector) && (m_LastSector < 0 || sector <= m_LastSector);
+    };
+  }
+
+  int ncount = 0;
+  while (true)
+  {
+    if (!IsOpen() || m_Event >= m_Reader.size())
+    {
+      if (IsOpen())
+      {
+        fileclose();
+      }
+      if (FileListEmpty() || OpenNextFile())
+      {
+        if (Verbosity() > 0)
+        {
+          std::cout << Name() << ": No Input file open" << std::endl;
+        }
+        return -1;
+      }
+      continue;
+    }
+
+    // the pages of the previous event are not needed anymore
+    if (m_Event > 0)
+    {
+      m_Reader.release(m_Event - 1);
+    }
+    m_Reader.prefetch(m_Event + 1);
+    if (!m_Reader.read(m_Event, *frames, select))
+    {
+      std::cout << PHWHERE << Name() << ": could not read event " << m_Event << " of " << FileName() << std::endl;
+      ++m_Event;
+      continue;
+    }
+    ++m_Event;
+    ++m_EventsTotal;
+    ++ncount;
+    if (nevents > 0 && ncount < nevents)
+    {
+      continue;
+    }
+    // check if the local SubsysReco discards this event
+    if (RejectEvent() != Fun4AllReturnCodes::EVENT_OK)
+    {
+      continue;
+    }
+    return 0;
+  }
+}
+
+//______________________________________________________
+int TpcSparseFrameInputManager::PushBackEvents(const int i)
+{
+  if (!IsOpen())
+  {
+    std::cout << PHWHERE << Name() << ": could not push back events, no file open" << std::endl;
+    return -1;
+  }
+  // negative i skips ahead
+  if (i > 0)
+  {
+    m_Event -= std::min(m_Event, static_cast<size_t>(i));
+  }
+  else
+  {
+    m_Event = std::min(m_Reader.size(), m_Event + static_cast<size_t>(-i));
+  }
+  return 0;
+}
+
+//______________________________________________________
+void TpcSparseFrameInputManager::Print(const std::string &what) const
+{
+  if (what == "ALL" || what == "FILE")
+  {
+    std::cout << Name() << ": read " << m_EventsTotal << " events";
+    if (IsOpen())
+    {
+      std::cout << ", at event " << m_Event << " of " << m_Reader.size() << " in " << FileName();
+    }
+    std::cout << std::endl;
+  }
+  Fun4AllInputManager::Print(what);
+}
@@ -0,0 +1,55 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TPC_TPCSPARSEFRAMEINPUTMANAGER_H
+#define TPC_TPCSPARSEFRAMEINPUTMANAGER_H
+
+#include "TpcSparseFrameFile.h"
+
+#include <fun4all/Fun4AllInputManager.h>
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <cstddef>
+#include <string>
+
+class PHCompositeNode;
+class SyncObject;
+class TpcSparseFrameContainer;
+
+//! reads events of a TpcSparseFrameFile into the TpcSparseFrameContainer node TRKR_TPCSPARSEFRAME
+/*!
+  The file is memory mapped, each event is decoded from the mapped pages which
+  are released once the next event is read. Run the clusterizer with
+  TpcClusterizer::setReadSparseFrame(true). Files are opened directly (no file catalog lookup).
+*/
+class TpcSparseFrameInputManager : public Fun4AllInputManager
+{
+ public:
+  TpcSparseFrameInputManager(const std::string &name = "TPCSPARSEFRAMEIN", const std::string &nodename = "DST", const std::string &topnodename = "TOP");
+  ~TpcSparseFrameInputManager() override = default;
+
+  int fileopen(const std::string &filenam) override;
+  int fileclose() override;
+  int run(const int nevents = 0) override;
+  int GetSyncObject(SyncObject ** /*mastersync*/) override { return Fun4AllReturnCodes::SYNC_NOOBJECT; }
+  int SyncIt(const SyncObject * /*mastersync*/) override { return Fun4AllReturnCodes::SYNC_OK; }
+  int PushBackEvents(const int i) override;
+  void Print(const std::string &what = "ALL") const override;
+
+  //! only read the frames of sectors first to last (0-11, both included), e.g. to split a job by sector
+  void SelectSectors(const int first, const int last)
+  {
+    m_FirstSector = first;
+    m_LastSector = last;
+  }
+
+ private:
+  TpcSparseFrameContainer *getFrames();
+
+  TpcSparseFrameFile::Reader m_Reader;
+  size_t m_Event = 0;
+  int m_EventsTotal = 0;
+  int m_FirstSector = -1;
+  int m_LastSector = -1;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "TpcSparseFrameOutputManager.h"
+
+#include <trackbase/TpcSparseFrameContainer.h>
+
+#include <phool/getClass.h>
+#include <phool/phool.h>
+#include <phool/recoConsts.h>
+
+#include <iostream>
+
+//______________________________________________________
+TpcSparseFrameOutputManager::TpcSparseFrameOutputManager(const std::string &myname, const std::string &filename)
+  : Fun4AllOutputManager(myname, filename)
+{
+}
+
+//______________________________________________________
+TpcSparseFrameOutputManager::~TpcSparseFrameOutputManager()
+{
+  // the index is written when the file is closed
+  if (m_Writer.is_open())
+  {
+    m_Writer.close();
+  }
+}
+
+//______________________________________________________
+int TpcSparseFrameOutputManager::outfileopen(const std::string &fname)
+{
+  if (m_Writer.is_open())
+  {
+    if (Verbosity())
+    {
+      std::cout << Name() << ": closing " << OutFileName() << " with " << m_Writer.size() << " events" << std::endl;
+    }
+    m_Writer.close();
+  }
+  OutFileName(fname);
+  return 0;
+}
+
+//______________________________________________________
+int TpcSparseFrameOutputManager::Write(PHCompositeNode *startNode)
+{
+  auto frames = findNode::getClass<TpcSparseFrameContainer>(startNode, m_NodeName);
+  if (!frames)
+  {
+    std::cout << PHWHERE << Name() << ": Could not get \"" << m_NodeName << "\" from Node Tree" << std::endl;
+    return -1;
+  }
+  if (!m_Writer.is_open())
+  {
+    recoConsts *rc = recoConsts::instance();
+    int runnumber = 0;
+    if (rc->FlagExist("RUNNUMBER"))
+    {
+      runnumber = rc->get_IntFlag("RUNNUMBER");
+    }
+    if (!m_Writer.open(OutFileName(), runnumber))
+    {
+      std::cout << PHWHERE << " Could not open " << OutFileName() << std::endl;
+      return -1;
+    }
+  }
+  return m_Writer.write(*frames) ? 0 : -1;
+}
@@ -0,0 +1,38 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef TPC_TPCSPARSEFRAMEOUTPUTMANAGER_H
+#define TPC_TPCSPARSEFRAMEOUTPUTMANAGER_H
+
+#include "TpcSparseFrameFile.h"
+
+#include <fun4all/Fun4AllOutputManager.h>
+
+#include <string>
+
+class PHCompositeNode;
+
+//! writes the TpcSparseFrameContainer (TRKR_TPCSPARSEFRAME) of each event to a TpcSparseFrameFile
+/*!
+  The unpacker has to fill the sparse frames (TpcCombinedRawDataUnpacker::setSparseFrame).
+  Read the file back with TpcSparseFrameInputManager.
+*/
+class TpcSparseFrameOutputManager : public Fun4AllOutputManager
+{
+ public:
+  TpcSparseFrameOutputManager(const std::string &myname = "TPCSPARSEFRAMEOUT", const std::string &filename = "tpcsparseframes.bin");
+  ~TpcSparseFrameOutputManager() override;
+
+  //! close the current file, the next event goes to fname
+  int outfileopen(const std::string &fname) override;
+
+  int Write(PHCompositeNode *startNode) override;
+
+  //! name of the frame container node
+  void SetNodeName(const std::string &name) { m_NodeName = name; }
+
+ private:
+  TpcSparseFrameFile::Writer m_Writer;
+  std::string m_NodeName = "TRKR_TPCSPARSEFRAME";
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef TPC_TPCVOXELGRID_H
+#define TPC_TPCVOXELGRID_H
+
+/*!
+ * \file TpcVoxelGrid.h
+ * \brief (layer, pad, time bin) voxel grid for the 3D clusterizers
+ *
+ * Each voxel holds an int, EMPTY if it was not set. The voxels are stored in
+ * dense blocks of 8x8x8 which are only allocated where something is set, so
+ * a full TPC side does not need a voxel for every pad and time bin. Lookups
+ * and box queries are array accesses within a block, one hash lookup per block.
+ * Coordinates may be negative (LaserClusterizer flips the time bins of side 0).
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class TpcVoxelGrid
+{
+ public:
+  static constexpr int EMPTY = -1;
+
+  //! remove all voxels
+  void clear()
+  {
+    m_index.clear();
+    m_blocks.clear();
+  }
+
+  //! value of a voxel, EMPTY if it was not set
+  int get(const int layer, const int pad, const int tbin) const
+  {
+    const Block* block = find(blockkey(layer >> BITS, pad >> BITS, tbin >> BITS));
+    return block ? (*block)[offset(layer, pad, tbin)] : EMPTY;
+  }
+
+  void set(const int layer, const int pad, const int tbin, const int value)
+  {
+    const uint64_t key = blockkey(layer >> BITS, pad >> BITS, tbin >> BITS);
+    auto iter = m_index.find(key);
+    if (iter == m_index.end())
+    {
+      iter = m_index.emplace(key, m_blocks.size()).first;
+      m_blocks.emplace_back();
+      m_blocks.back().fill(EMPTY);
+    }
+    m_blocks[iter->second][offset(layer, pad, tbin)] = value;
+  }
+
+  //! calls f(value) for all voxels in the box (bounds included) which are not EMPTY
+  template <class F>
+  void for_each_in_box(const int layermin, const int layermax, const int padmin, const int padmax,
+                       const int tbinmin, const int tbinmax, F&& f) const
+  {
+    for (int bl = layermin >> BITS; bl <= layermax >> BITS; ++bl)
+    {
+      for (int bp = padmin >> BITS; bp <= padmax >> BITS; ++bp)
+      {
+        for (int bt = tbinmin >> BITS; bt <= tbinmax >> BITS; ++bt)
+        {
+          const Block* block = find(blockkey(bl, bp, bt));
+          if (!block)
+          {
+            continue;
+          }
+          for (int layer = std::max(layermin, bl << BITS); layer <= std::min(layermax, (bl << BITS) + MASK); ++layer)
+          {
+            for (int pad = std::max(padmin, bp << BITS); pad <= std::min(padmax, (bp << BITS) + MASK); ++pad)
+            {
+              for (int tbin = std::max(tbinmin, bt << BITS); tbin <= std::min(tbinmax, (bt << BITS) + MASK); ++tbin)
+              {
+                const int value = (*block)[offset(layer, pad, tbin)];
+                if (value != EMPTY)
+                {
+                  f(value);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+ private:
+  static constexpr int BITS = 3;
+  static constexpr int MASK = (1 << BITS) - 1;
+  using Block = std::array<int, 1 << (3 * BITS)>;
+
+  //! shifts of negative coordinates round down, the bias keeps the block indices positive
+  static uint64_t blockkey(const int bl, const int bp, const int bt)
+  {
+    constexpr int64_t bias = 1 << 20;
+    return (static_cast<uint64_t>(bl + bias) << 42U) | (static_cast<uint64_t>(bp + bias) << 21U) | static_cast<uint64_t>(bt + bias);
+  }
+
+  static int offset(const int layer, const int pad, const int tbin)
+  {
+    return ((layer & MASK) << (2 * BITS)) | ((pad & MASK) << BITS) | (tbin & MASK);
+  }
+
+  const Block* find(const uint64_t key) const
+  {
+    const auto iter = m_index.find(key);
+    return iter == m_index.end() ? nullptr : &m_blocks[iter->second];
+  }
+
+  std::unordered_map<uint64_t, unsigned int> m_index;
+  std::vector<Block> m_blocks;
+};
+
+#endif
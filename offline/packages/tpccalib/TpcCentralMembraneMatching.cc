@@ -34,6 +34,7 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <set>
@@ -1251,10 +1252,41 @@ for (int j = 0; j < nRadii; ++j)
   }
 }
 
+build_truth_grid();
+
 int ret = GetNodes(topNode);
 return ret;
 }
 
+//____________________________________________________________________________..
+void TpcCentralMembraneMatching::build_truth_grid()
+{
+  double rmax = 0;
+  for (const auto& truth : m_truth_pos)
+  {
+    rmax = std::max(rmax, get_r(truth.X(), truth.Y()));
+  }
+  m_truth_grid_nr = static_cast<int>(rmax / m_truth_grid_dr) + 1;
+
+  // positions at z = 0 belong to both sides, as in the matching cuts
+  for (int side = 0; side < 2; ++side)
+  {
+    auto& grid = m_truth_grid[side];
+    grid.assign(m_truth_grid_nr * m_truth_grid_nphi, std::vector<int>());
+    for (int i = 0; i < (int) m_truth_pos.size(); ++i)
+    {
+      const auto& truth = m_truth_pos[i];
+      if ((!side && truth.Z() > 0) || (side && truth.Z() < 0))
+      {
+        continue;
+      }
+      const int ir = static_cast<int>(get_r(truth.X(), truth.Y()) / m_truth_grid_dr);
+      const int iphi = static_cast<int>(std::floor((truth.Phi() + M_PI) / (2 * M_PI / m_truth_grid_nphi))) % m_truth_grid_nphi;
+      grid[ir * m_truth_grid_nphi + iphi].push_back(i);
+    }
+  }
+}
+
 //____________________________________________________________________________..
 int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
 {
@@ -1455,23 +1487,75 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
 
 
 
-    for (const auto& truth : m_truth_pos)
+    // radius, rotated phi and radial peak match of each cluster, radial peak of each truth position
+    std::vector<double> reco_R(reco_pos.size(), 0);
+    std::vector<double> reco_rotPhi(reco_pos.size(), 0);
+    std::vector<int> reco_RMatch(reco_pos.size(), -1);
+    std::vector<std::vector<int>> reco_byRMatch(m_truth_RPeaks.size());
+    for (int i = 0; i < (int) reco_pos.size(); i++)
     {
-      double tR = get_r(truth.X(), truth.Y());
-      double tPhi = truth.Phi();
-      double tZ = truth.Z();
+      double rR = get_r(reco_pos[i].X(), reco_pos[i].Y());
+      double rPhi = reco_pos[i].Phi();
+      bool side = reco_side[i];
 
-      int truthRIndex = -1;
+      int region = -1;
+
+      if (rR < 41)
+      {
+        region = 0;
+      }
+      else if (rR >= 41 && rR < 58)
+      {
+        region = 1;
+      }
+      else if (rR >= 58)
+      {
+        region = 2;
+      }
 
+      if (region != -1)
+      {
+        if (side)
+        {
+          rPhi -= m_recoRotation[1][region];
+        }
+        else
+        {
+          rPhi -= m_recoRotation[0][region];
+        }
+      }
+
+      reco_R[i] = rR;
+      reco_rotPhi[i] = rPhi;
+      reco_RMatch[i] = getClusterRMatch(rR, (int) (side ? 1 : 0));
+      if (reco_RMatch[i] >= 0 && reco_RMatch[i] < (int) reco_byRMatch.size())
+      {
+        reco_byRMatch[reco_RMatch[i]].push_back(i);
+      }
+    }
+
+    std::vector<int> truth_RIndex(m_truth_pos.size(), -1);
+    for (int i = 0; i < (int) m_truth_pos.size(); i++)
+    {
       // get which hit radial index this it
+      double tR = get_r(m_truth_pos[i].X(), m_truth_pos[i].Y());
       for (int k = 0; k < (int) m_truth_RPeaks.size(); k++)
       {
         if (std::abs(tR - m_truth_RPeaks[k]) < 0.5)
         {
-          truthRIndex = k;
+          truth_RIndex[i] = k;
           break;
         }
       }
+    }
+
+    for (const auto& truth : m_truth_pos)
+    {
+      double tR = get_r(truth.X(), truth.Y());
+      double tPhi = truth.Phi();
+      double tZ = truth.Z();
+
+      int truthRIndex = truth_RIndex[truth_index];
 
       if (truthRIndex == -1)
       {
@@ -1481,66 +1565,24 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
 
       double prev_dphi = 10000.0;
 
+      // only clusters matched to the same radial peak can pass, in cluster order
       int recoMatchIndex = -1;
-      unsigned int reco_index = 0;
-      for (const auto& reco : reco_pos)
+      for (const int reco_index : reco_byRMatch[truthRIndex])
       {
         if (reco_matched[reco_index] || reco_nhits[reco_index] < m_nHitsInCuster_minimum)
         {
-          reco_index++;
           continue;
         }
 
-        double rR = get_r(reco.X(), reco.Y());
-        double rPhi = reco.Phi();
         bool side = reco_side[reco_index];
-
-        int region = -1;
-
-        if (rR < 41)
-        {
-          region = 0;
-        }
-        else if (rR >= 41 && rR < 58)
-        {
-          region = 1;
-        }
-        else if (rR >= 58)
-        {
-          region = 2;
-        }
-
-        if (region != -1)
-        {
-          if (side)
-          {
-            rPhi -= m_recoRotation[1][region];
-          }
-          else
-          {
-            rPhi -= m_recoRotation[0][region];
-          }
-        }
-
-        int clustRMatchIndex = -1;
-        clustRMatchIndex = getClusterRMatch(rR, (int) (side ? 1 : 0));
-
-        if (clustRMatchIndex == -1 || truthRIndex != clustRMatchIndex)
-        {
-          reco_index++;
-          continue;
-        }
-
         if ((!side && tZ > 0) || (side && tZ < 0))
         {
-          reco_index++;
           continue;
         }
 
-        auto dphi = delta_phi(tPhi - rPhi);
+        auto dphi = delta_phi(tPhi - reco_rotPhi[reco_index]);
         if (fabs(dphi) > m_phi_cut)
         {
-          reco_index++;
           continue;
         }
 
@@ -1550,8 +1592,6 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
           recoMatchIndex = reco_index;
           truth_matched[truth_index] = true;
         }
-
-        reco_index++;
       }  // end loop over reco
 
       if (recoMatchIndex != -1)
@@ -1577,40 +1617,11 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     int recoIndex = 0;
     for (const auto& reco : reco_pos)
     {
-      double rR = get_r(reco.X(), reco.Y());
-      double rPhi = reco.Phi();
+      double rR = reco_R[recoIndex];
+      double rPhi = reco_rotPhi[recoIndex];
       bool side = reco_side[recoIndex];
 
-      int region = -1;
-
-      if (rR < 41)
-      {
-        region = 0;
-      }
-      else if (rR >= 41 && rR < 58)
-      {
-        region = 1;
-      }
-      else if (rR >= 58)
-      {
-        region = 2;
-      }
-
-      if (region != -1)
-      {
-        if (side)
-        {
-          rPhi -= m_recoRotation[1][region];
-        }
-        else
-        {
-          rPhi -= m_recoRotation[0][region];
-        }
-      }
-
-      int clustRMatchIndex = -1;
-      clustRMatchIndex = getClusterRMatch(rR, (int) (side ? 1 : 0));
-
+      int clustRMatchIndex = reco_RMatch[recoIndex];
 
       int truthMatchIndex = -1;
       truth_index = 0;
@@ -1653,17 +1664,7 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
         }
        }
 
-      int truthRIndex = -1;
-
-      // get which hit radial index this it
-      for (int k = 0; k < (int) m_truth_RPeaks.size(); k++)
-      {
-        if (std::abs(tR - m_truth_RPeaks[k]) < 0.5)
-        {
-          truthRIndex = k;
-          break;
-        }
-      }
+      int truthRIndex = truth_RIndex[truth_index];
 
       if (truthRIndex == -1 || truthRIndex != clustRMatchIndex)
       {
@@ -1712,44 +1713,47 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
       double rPhi = reco.Phi();
       bool side = reco_side[reco_index];
 
-      truth_index = 0;
       double minNNDist = 100000.0;
       int match_localTruth = -1;
-      for (const auto& truth : m_truth_pos)
-      {
-	//std::cout << "reco_index " << reco_index << "   truth_index " << truth_index << std::endl;
-	double tR = get_r(truth.X(), truth.Y());
-        double tPhi = truth.Phi();
-        double tZ = truth.Z();
 
-        if ((!side && tZ > 0) || (side && tZ < 0))
+      // truth positions of the grid cells covering the search window, first one wins on equal distance
+      const double phi_step = 2 * M_PI / m_truth_grid_nphi;
+      const int ir_min = std::max(0, static_cast<int>(std::floor((rR - 5.0 - 1e-6) / m_truth_grid_dr)));
+      const int ir_max = std::min(m_truth_grid_nr - 1, static_cast<int>(std::floor((rR + 5.0 + 1e-6) / m_truth_grid_dr)));
+      const int iphi_min = static_cast<int>(std::floor((rPhi - 0.05 - 1e-6 + M_PI) / phi_step));
+      const int iphi_max = static_cast<int>(std::floor((rPhi + 0.05 + 1e-6 + M_PI) / phi_step));
+      for (int ir = ir_min; ir <= ir_max; ++ir)
+      {
+        for (int iphi = iphi_min; iphi <= iphi_max; ++iphi)
         {
-          truth_index++;
-          continue;
-        }
+          const auto& cell = m_truth_grid[side][ir * m_truth_grid_nphi + (iphi % m_truth_grid_nphi + m_truth_grid_nphi) % m_truth_grid_nphi];
+          for (const int cell_index : cell)
+          {
+            const auto& truth = m_truth_pos[cell_index];
+            double tR = get_r(truth.X(), truth.Y());
+            double tPhi = truth.Phi();
 
-        auto dR = fabs(tR - rR);
-        if (dR > 5.0)
-        {
-          truth_index++;
-          continue;
-        }
+            auto dR = fabs(tR - rR);
+            if (dR > 5.0)
+            {
+              continue;
+            }
 
-        auto dphi = delta_phi(tPhi - rPhi);
-        if (fabs(dphi) > 0.05)
-        {
-          truth_index++;
-          continue;
-        }
+            auto dphi = delta_phi(tPhi - rPhi);
+            if (fabs(dphi) > 0.05)
+            {
+              continue;
+            }
 
-        double dist = sqrt(pow(truth.X() - reco.X(),2) + pow(truth.Y() - reco.Y(),2));
-        if (dist < minNNDist)
-        {
-          minNNDist = dist;
-          match_localTruth = truth_index;
+            double dist = sqrt(pow(truth.X() - reco.X(), 2) + pow(truth.Y() - reco.Y(), 2));
+            if (dist < minNNDist || (dist == minNNDist && cell_index < match_localTruth))
+            {
+              minNNDist = dist;
+              match_localTruth = cell_index;
+            }
+          }
         }
-	truth_index++;
-      } // end truth loop
+      }  // end truth loop
 
       if(match_localTruth == -1)
       {
@@ -1889,6 +1893,9 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
     }
   }
 
+  // residuals of each side, filled into the distortion histograms after the loop
+  std::array<std::array<std::vector<double>, 5>, 2> residuals;
+
   unsigned int ckey = 0;
   for (unsigned int i = 0; i < m_truth_pos.size(); i++)
   {
@@ -1949,15 +1956,31 @@ int TpcCentralMembraneMatching::process_event(PHCompositeNode* topNode)
      * - we might need to only fill the histograms for cm clusters that have 2 clusters only
      * - we might need a smoothing procedure to fill the bins that have no entries using neighbors
      */
+    auto& values = residuals[side];
+    values[0].push_back(clus_phi);
+    values[1].push_back(clus_r);
+    values[2].push_back(dr);
+    values[3].push_back(rdphi);
+    values[4].push_back(dz);
+
+    ckey++;
+  }
+
+  for (int side = 0; side < 2; ++side)
+  {
+    const auto& [phis, rs, drs, rdphis, dzs] = residuals[side];
+    const int n = phis.size();
+    if (n == 0)
+    {
+      continue;
+    }
     for (const auto& dcc : {m_dcc_out, m_dcc_out_aggregated.get()})
     {
-      static_cast<TH2*>(dcc->m_hDRint[side])->Fill(clus_phi, clus_r, dr);
-      static_cast<TH2*>(dcc->m_hDPint[side])->Fill(clus_phi, clus_r, rdphi);
-      static_cast<TH2*>(dcc->m_hDZint[side])->Fill(clus_phi, clus_r, dz);
-      static_cast<TH2*>(dcc->m_hentries[side])->Fill(clus_phi, clus_r);
+      static_cast<TH2*>(dcc->m_hDRint[side])->FillN(n, phis.data(), rs.data(), drs.data());
+      static_cast<TH2*>(dcc->m_hDPint[side])->FillN(n, phis.data(), rs.data(), rdphis.data());
+      static_cast<TH2*>(dcc->m_hDZint[side])->FillN(n, phis.data(), rs.data(), dzs.data());
+      static_cast<TH2*>(dcc->m_hentries[side])->FillN(n, phis.data(), rs.data(), nullptr);
     }
-
-    ckey++;
   }
 
   if (Verbosity())
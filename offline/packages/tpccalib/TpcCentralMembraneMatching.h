@@ -19,8 +19,10 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <array>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 // class CMFlashClusterContainer;
@@ -318,6 +320,15 @@ class TpcCentralMembraneMatching : public SubsysReco
   std::vector<TVector3> m_truth_pos;
   std::vector<int> m_truth_index;
 
+  /// m_truth_pos indices of each side in (r, phi) cells, for the nearest neighbor search
+  void build_truth_grid();
+  std::array<std::vector<std::vector<int>>, 2> m_truth_grid;
+  int m_truth_grid_nr{0};
+
+  /// cells are at least as large as the search window around each cluster
+  static constexpr int m_truth_grid_nphi{125};   // 2pi/125 > 0.05 rad
+  static constexpr double m_truth_grid_dr{5.0};  // cm
+
   std::vector<double> m_truth_RPeaks{22.709, 23.841, 24.973, 26.1049, 27.2369, 28.3689, 29.5009, 30.6328, 31.7648, 32.8968, 34.0288, 35.1607, 36.2927, 37.4247, 38.5566, 39.6886, 42.1706, 44.2119, 46.2533, 48.2947, 50.3361, 52.3774, 54.4188, 56.4602, 59.4605, 61.6546, 63.8487, 66.0428, 68.2369, 70.431, 72.6251, 74.8192};
 
   //@}
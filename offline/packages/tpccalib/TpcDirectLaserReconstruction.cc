@@ -33,6 +33,7 @@
 
 #include <boost/format.hpp>
 
+#include <algorithm>
 #include <cassert>
 
 namespace
@@ -101,6 +102,48 @@ namespace
     */
   }
 
+  // z range containing all points within distance dca of a line that are on a cylinder of given radius
+  /*
+   * the point of closest approach on the line is at most radius + dca from the z axis, and within dca in z of the point.
+   * returns false if no point of the cylinder can be within dca of the line
+   */
+  bool line_cylinder_zrange(const TVector3& p, const TVector3& d, double radius, double dca, double& zmin, double& zmax)
+  {
+    // rounding margin
+    static constexpr double epsilon = 1e-6;
+
+    zmin = -std::numeric_limits<double>::infinity();
+    zmax = std::numeric_limits<double>::infinity();
+    if (!(dca >= 0))
+    {
+      // no dca cut
+      return true;
+    }
+
+    const double A = square(d.x()) + square(d.y());
+    const double B = 2 * p.x() * d.x() + 2 * p.y() * d.y();
+    const double C = square(p.x()) + square(p.y()) - square(radius + dca);
+    if (A == 0)
+    {
+      // line parallel to the z axis
+      return C <= 0;
+    }
+
+    const double delta = square(B) - 4 * A * C;
+    if (delta < 0)
+    {
+      return false;
+    }
+
+    const double t1 = (-B - std::sqrt(delta)) / (2 * A);
+    const double t2 = (-B + std::sqrt(delta)) / (2 * A);
+    const double z1 = p.z() + d.z() * t1;
+    const double z2 = p.z() + d.z() * t2;
+    zmin = std::min(z1, z2) - dca - epsilon;
+    zmax = std::max(z1, z2) + dca + epsilon;
+    return true;
+  }
+
   /// TVector3 stream
   inline std::ostream& operator<<(std::ostream& out, const TVector3& vector)
   {
@@ -448,6 +491,66 @@ void TpcDirectLaserReconstruction::create_histograms()
   }
 }
 
+//_____________________________________________________________________
+void TpcDirectLaserReconstruction::fill_hits()
+{
+  m_hits.clear();
+  m_hits_by_layer.clear();
+
+  TrkrHitSetContainer::ConstRange hitsetrange = m_hit_map->getHitSets(TrkrDefs::TrkrId::tpcId);
+  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  {
+    const TrkrDefs::hitsetkey& hitsetkey = hitsetitr->first;
+    const int side = TpcDefs::getSide(hitsetkey);
+
+    auto hitset = hitsetitr->second;
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    const auto layergeom = m_geom_container->GetLayerCellGeom(layer);
+    const auto layer_center_radius = layergeom->get_radius();
+
+    // maximum drift time.
+    /* it is needed to calculate a given hit position from its drift time */
+    static constexpr double AdcClockPeriod = 53.0;  // ns
+    const unsigned short NTBins = (unsigned short) layergeom->get_zbins();
+    const float tdriftmax = AdcClockPeriod * NTBins / 2.0;
+
+    auto& layer_hits = m_hits_by_layer[layer];
+
+    // get corresponding hits
+    TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+    for (auto hitr = hitrangei.first; hitr != hitrangei.second; ++hitr)
+    {
+      const unsigned short phibin = TpcDefs::getPad(hitr->first);
+      const unsigned short zbin = TpcDefs::getTBin(hitr->first);
+
+      LaserHit hit;
+      hit.layer = layer;
+      hit.phi = layergeom->get_phicenter(phibin);
+      hit.x = layer_center_radius * cos(hit.phi);
+      hit.y = layer_center_radius * sin(hit.phi);
+
+      const double zdriftlength = layergeom->get_zcenter(zbin) * m_tGeometry->get_drift_velocity();
+      hit.z = tdriftmax * m_tGeometry->get_drift_velocity() - zdriftlength;
+      if (side == 0)
+      {
+        hit.z *= -1;
+      }
+
+      hit.adc = hitr->second->getAdc();
+
+      layer_hits.push_back(m_hits.size());
+      m_hits.push_back(hit);
+    }
+  }
+
+  // sort by z, for the lookup of hits along a given track
+  for (auto& [layer, indices] : m_hits_by_layer)
+  {
+    std::sort(indices.begin(), indices.end(), [this](unsigned int lhs, unsigned int rhs)
+              { return m_hits[lhs].z < m_hits[rhs].z; });
+  }
+}
+
 //_____________________________________________________________________
 void TpcDirectLaserReconstruction::process_tracks()
 {
@@ -456,6 +559,9 @@ void TpcDirectLaserReconstruction::process_tracks()
     return;
   }
 
+  // hit positions do not depend on the track
+  fill_hits();
+
   // loop over tracks and process
   for (auto& iter : *m_track_map)
   {
@@ -526,9 +632,6 @@ void TpcDirectLaserReconstruction::process_track(SvtxTrack* track)
 
   int GEM_Mod_Arr[72] = {0};
 
-  // loop over hits
-  TrkrHitSetContainer::ConstRange hitsetrange = m_hit_map->getHitSets(TrkrDefs::TrkrId::tpcId);
-
   float max_adc = 0.;
   float sum_adc_truth = 0;
   float sum_adc_truth_all = 0;
@@ -536,250 +639,223 @@ void TpcDirectLaserReconstruction::process_track(SvtxTrack* track)
   float sum_n_hits_truth = 0;
   float sum_n_hits_truth_all = 0;
 
-  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  // loop over hits
+  for (const auto& hit : m_hits)
   {
-    const TrkrDefs::hitsetkey& hitsetkey = hitsetitr->first;
-    const int side = TpcDefs::getSide(hitsetkey);
+    ++m_total_hits;
+    sum_n_hits_truth_all++;
 
-    auto hitset = hitsetitr->second;
-    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
-    const auto layergeom = m_geom_container->GetLayerCellGeom(layer);
-    const auto layer_center_radius = layergeom->get_radius();
+    const unsigned int layer = hit.layer;
+    const double phi = hit.phi;
+    const double x = hit.x;
+    const double y = hit.y;
+    const double z = hit.z;
 
-    // maximum drift time.
-    /* it is needed to calculate a given hit position from its drift time */
-    static constexpr double AdcClockPeriod = 53.0;  // ns
-    const unsigned short NTBins = (unsigned short) layergeom->get_zbins();
-    const float tdriftmax = AdcClockPeriod * NTBins / 2.0;
+    const TVector3 global(x, y, z);
 
-    // get corresponding hits
-    TrkrHitSet::ConstRange hitrangei = hitset->getHits();
+    float adc = hit.adc - m_pedestal;
+    float adc_unsub = hit.adc;
+    sum_adc_truth_all += adc_unsub;
+    /*
+            if(h_hits && trkid == 0)
+              {
+                h_hits->Fill(x,y,z,adc);
+              }
+    */
+    if (adc > max_adc)
+    {
+      max_adc = adc;
+    }
 
-    for (auto hitr = hitrangei.first; hitr != hitrangei.second; ++hitr)
+    // calculate dca
+    // origin is track origin, direction is track direction
+    bool sameside = sameSign(global.z(), origin.z());
+    const TVector3 oc(global.x() - origin.x(), global.y() - origin.y(), global.z() - origin.z());  // vector from track origin to cluster
+    auto t = direction.Dot(oc) / square(direction.Mag());
+    auto om = direction * t;  // vector from track origin to PCA
+    const auto dca = (oc - om).Mag();
+
+    if (sameside)
     {
-      ++m_total_hits;
-      sum_n_hits_truth_all++;
+      h_adc_vs_DCA_true->Fill(dca, adc);
+    }
 
-      const unsigned short phibin = TpcDefs::getPad(hitr->first);
-      const unsigned short zbin = TpcDefs::getTBin(hitr->first);
+    // rotate displacement vector by the rotation of the coordinates:
+    // oc2.RotateY(-theta_orig * trkzdir); //undoing rotation in PHG4TpcDirectLaser
 
-      const double phi = layergeom->get_phicenter(phibin);
-      const double x = layer_center_radius * cos(phi);
-      const double y = layer_center_radius * sin(phi);
+    // global2.RotateZ(-phi_orig);
+    // origin2.RotateZ(-phi_orig);
 
-      const double zdriftlength = layergeom->get_zcenter(zbin) * m_tGeometry->get_drift_velocity();
-      double z = tdriftmax * m_tGeometry->get_drift_velocity() - zdriftlength;
-      if (side == 0)
-      {
-        z *= -1;
-      }
+    TVector3 oc2(global.x() - origin.x(), global.y() - origin.y(), global.z() - origin.z());  // vector from track origin to cluster
+    // const double xt = x-xo;
+    // const double yt = y-yo;
+    // const double zt = z-zo;
+    oc2.RotateZ(-phi_orig);
 
-      const TVector3 global(x, y, z);
-
-      float adc = (hitr->second->getAdc()) - m_pedestal;
-      float adc_unsub = (hitr->second->getAdc());
-      sum_adc_truth_all += adc_unsub;
-      /*
-              if(h_hits && trkid == 0)
-                {
-                  h_hits->Fill(x,y,z,adc);
-                }
-      */
-      if (adc > max_adc)
-      {
-        max_adc = adc;
-      }
+    // auto theta1 = origin.Theta()*(180./M_PI);
+    // auto theta2 = global.Theta()*(180./M_PI);
 
-      // calculate dca
-      // origin is track origin, direction is track direction
-      bool sameside = sameSign(global.z(), origin.z());
-      const TVector3 oc(global.x() - origin.x(), global.y() - origin.y(), global.z() - origin.z());  // vector from track origin to cluster
-      auto t = direction.Dot(oc) / square(direction.Mag());
-      auto om = direction * t;  // vector from track origin to PCA
-      const auto dca = (oc - om).Mag();
+    // auto phi1 = origin.Phi()*(180./M_PI);
+    // auto phi2 = global.Phi()*(180./M_PI);
 
-      if (sameside)
-      {
-        h_adc_vs_DCA_true->Fill(dca, adc);
-      }
+    // float deltheta = GetRelTheta( origin.x() , origin.y(), origin.z(), global.x() , global.y() , global.z() , origin.Theta(), origin.Phi()) *(180./M_PI);
+    // float delphi = GetRelPhi(origin.x() , origin.y() , global.x() , global.y() , origin.Phi()) *(180./M_PI);
 
-      // rotate displacement vector by the rotation of the coordinates:
-      // oc2.RotateY(-theta_orig * trkzdir); //undoing rotation in PHG4TpcDirectLaser
+    float deltheta = oc2.Theta();
+    float delphi = oc2.Phi();
 
-      // global2.RotateZ(-phi_orig);
-      // origin2.RotateZ(-phi_orig);
+    if (deltheta > M_PI / 2.)
+    {
+      deltheta = M_PI - deltheta;
+    }
 
-      TVector3 oc2(global.x() - origin.x(), global.y() - origin.y(), global.z() - origin.z());  // vector from track origin to cluster
-      // const double xt = x-xo;
-      // const double yt = y-yo;
-      // const double zt = z-zo;
-      oc2.RotateZ(-phi_orig);
+    while (delphi < m_phimin)
+    {
+      delphi += 2. * M_PI;
+    }
+    while (delphi >= m_phimax)
+    {
+      delphi -= 2. * M_PI;
+    }
 
-      // auto theta1 = origin.Theta()*(180./M_PI);
-      // auto theta2 = global.Theta()*(180./M_PI);
+    if (track->get_id() > 3)
+    {
+      delphi = (2 * M_PI) - delphi;
+    }
 
-      // auto phi1 = origin.Phi()*(180./M_PI);
-      // auto phi2 = global.Phi()*(180./M_PI);
+    // if (delphi < 0) delphi*=-1;
 
-      // float deltheta = GetRelTheta( origin.x() , origin.y(), origin.z(), global.x() , global.y() , global.z() , origin.Theta(), origin.Phi()) *(180./M_PI);
-      // float delphi = GetRelPhi(origin.x() , origin.y() , global.x() , global.y() , origin.Phi()) *(180./M_PI);
+    deltheta *= (180. / M_PI);
+    delphi *= (180. / M_PI);
 
-      float deltheta = oc2.Theta();
-      float delphi = oc2.Phi();
+    /*
+            if( trkid < 4)
+            {
+              deltheta = 180 - theta2;
+              if ( trkid == 1) delphi = fabs(phi2 - phi);
+              else delphi = phi2 - phi1;
+            }
+            else
+            {
+              deltheta = theta2;
+              if (trkid == 7 ) delphi = 360. - fabs(phi2 - phi1);
+              else delphi = fabs(phi2 - phi1);
+            }
+    */
 
-      if (deltheta > M_PI / 2.)
-      {
-        deltheta = M_PI - deltheta;
-      }
+    // relative angle histogram - only fill for hits in the same side as origin
+
+    if (sameside)
+    {
+      // std::cout<<"Trk ID = "<<trkid<<std::endl;
+
+      h_deltheta_delphi->Fill(deltheta, delphi);
 
-      while (delphi < m_phimin)
+      if (track->get_id() == 0)  // only fill for 1 laser !!!
       {
-        delphi += 2. * M_PI;
+        // std::cout<<"Trk ID = "<<trkid<<std::endl;
+        h_deltheta_delphi_1->Fill(deltheta, delphi);
+        /*
+                    //if( h_bright_hits && deltheta > 80 && deltheta < 95 && delphi > 130 && delphi < 150)
+                    //filling bright_hits for theta = 75, phi = 80 (simple debugging only - to be removed)
+                    if( h_bright_hits_laser1 )
+                    {
+                      h_bright_hits_laser1->Fill(x,y,z,deltheta,delphi);
+                    }
+        */
       }
-      while (delphi >= m_phimax)
+      if (trkid == 1)  // only fill for 1 laser !!!
       {
-        delphi -= 2. * M_PI;
+        h_deltheta_delphi_2->Fill(deltheta, delphi);
+        /*
+                    if( h_bright_hits_laser2 )
+                    {
+                      h_bright_hits_laser2->Fill(x,y,z,deltheta,delphi);
+                    }
+        */
       }
-
-      if (track->get_id() > 3)
+      if (trkid == 2)  // only fill for 1 laser !!!
       {
-        delphi = (2 * M_PI) - delphi;
+        h_deltheta_delphi_3->Fill(deltheta, delphi);
+        /*
+                    if( h_bright_hits_laser3 )
+                    {
+                      h_bright_hits_laser3->Fill(x,y,z,deltheta,delphi);
+                    }
+        */
       }
-
-      // if (delphi < 0) delphi*=-1;
-
-      deltheta *= (180. / M_PI);
-      delphi *= (180. / M_PI);
-
-      /*
-              if( trkid < 4)
-              {
-                deltheta = 180 - theta2;
-                if ( trkid == 1) delphi = fabs(phi2 - phi);
-                else delphi = phi2 - phi1;
-              }
-              else
-              {
-                deltheta = theta2;
-                if (trkid == 7 ) delphi = 360. - fabs(phi2 - phi1);
-                else delphi = fabs(phi2 - phi1);
-              }
-      */
-
-      // relative angle histogram - only fill for hits in the same side as origin
-
-      if (sameside)
+      if (trkid == 3)  // only fill for 1 laser !!!
       {
-        // std::cout<<"Trk ID = "<<trkid<<std::endl;
-
-        h_deltheta_delphi->Fill(deltheta, delphi);
-
-        if (track->get_id() == 0)  // only fill for 1 laser !!!
-        {
-          // std::cout<<"Trk ID = "<<trkid<<std::endl;
-          h_deltheta_delphi_1->Fill(deltheta, delphi);
-          /*
-                      //if( h_bright_hits && deltheta > 80 && deltheta < 95 && delphi > 130 && delphi < 150)
-                      //filling bright_hits for theta = 75, phi = 80 (simple debugging only - to be removed)
-                      if( h_bright_hits_laser1 )
-                      {
-                        h_bright_hits_laser1->Fill(x,y,z,deltheta,delphi);
-                      }
-          */
-        }
-        if (trkid == 1)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_2->Fill(deltheta, delphi);
-          /*
-                      if( h_bright_hits_laser2 )
-                      {
-                        h_bright_hits_laser2->Fill(x,y,z,deltheta,delphi);
-                      }
-          */
-        }
-        if (trkid == 2)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_3->Fill(deltheta, delphi);
-          /*
-                      if( h_bright_hits_laser3 )
-                      {
-                        h_bright_hits_laser3->Fill(x,y,z,deltheta,delphi);
-                      }
-          */
-        }
-        if (trkid == 3)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_4->Fill(deltheta, delphi);
-          /*
-                      if( h_bright_hits_laser4 )
-                      {
-                        h_bright_hits_laser4->Fill(x,y,z,deltheta,delphi);
-                      }
-          */
-        }
-        if (trkid == 4)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_5->Fill(deltheta, delphi);
-        }
-        if (trkid == 5)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_6->Fill(deltheta, delphi);
-        }
-        if (trkid == 6)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_7->Fill(deltheta, delphi);
-        }
-        if (trkid == 7)  // only fill for 1 laser !!!
-        {
-          h_deltheta_delphi_8->Fill(deltheta, delphi);
-        }
+        h_deltheta_delphi_4->Fill(deltheta, delphi);
+        /*
+                    if( h_bright_hits_laser4 )
+                    {
+                      h_bright_hits_laser4->Fill(x,y,z,deltheta,delphi);
+                    }
+        */
       }
-
-      // do not associate if dca is too large
-      if (dca > m_max_dca)
+      if (trkid == 4)  // only fill for 1 laser !!!
       {
-        continue;
+        h_deltheta_delphi_5->Fill(deltheta, delphi);
       }
-
-      if (sameside)
+      if (trkid == 5)  // only fill for 1 laser !!!
       {
-        sum_n_hits_truth++;
-        h_adc->Fill(adc);
-        sum_adc_truth += adc_unsub;
-      }  // increment truth BUT ONLY for hits on the same side as origin CHARLES 10.31.23
-
-      ++m_matched_hits;
-      /*
-              if(h_assoc_hits){
-                h_assoc_hits->Fill( x,y,z);
-              }
-      */
-      // for locating the associated hits
-      float r2 = std::sqrt((x * x) + (y * y));
-      float phi3 = phi;
-      float z2 = z;
-      while (phi3 < m_phimin)
+        h_deltheta_delphi_6->Fill(deltheta, delphi);
+      }
+      if (trkid == 6)  // only fill for 1 laser !!!
       {
-        phi3 += 2. * M_PI;
+        h_deltheta_delphi_7->Fill(deltheta, delphi);
       }
-      while (phi3 >= m_phimax)
+      if (trkid == 7)  // only fill for 1 laser !!!
       {
-        phi3 -= 2. * M_PI;
+        h_deltheta_delphi_8->Fill(deltheta, delphi);
       }
+    }
+
+    // do not associate if dca is too large
+    if (dca > m_max_dca)
+    {
+      continue;
+    }
 
-      const int locateid = Locate(r2, phi3, z2);  // find where the cluster is
+    if (sameside)
+    {
+      sum_n_hits_truth++;
+      h_adc->Fill(adc);
+      sum_adc_truth += adc_unsub;
+    }  // increment truth BUT ONLY for hits on the same side as origin CHARLES 10.31.23
 
-      if (z2 > m_zmin || z2 < m_zmax)
-      {
-        GEM_Mod_Arr[locateid - 1]++;  // the array ath the cluster location - counts the number of clusters in each array, (IFF its in the volume !!!)
-      }
+    ++m_matched_hits;
+    /*
+            if(h_assoc_hits){
+              h_assoc_hits->Fill( x,y,z);
+            }
+    */
+    // for locating the associated hits
+    float r2 = std::sqrt((x * x) + (y * y));
+    float phi3 = phi;
+    float z2 = z;
+    while (phi3 < m_phimin)
+    {
+      phi3 += 2. * M_PI;
+    }
+    while (phi3 >= m_phimax)
+    {
+      phi3 -= 2. * M_PI;
+    }
+
+    const int locateid = Locate(r2, phi3, z2);  // find where the cluster is
+
+    if (z2 > m_zmin || z2 < m_zmax)
+    {
+      GEM_Mod_Arr[locateid - 1]++;  // the array ath the cluster location - counts the number of clusters in each array, (IFF its in the volume !!!)
+    }
 
-      // bin hits by layer
-      const auto cluspos_pair = std::make_pair(adc, global);
-      cluspos_map.insert(std::make_pair(layer, cluspos_pair));
-      layer_bin_set.insert(layer);
-    }  // end looping over hits
-  }    // end looping over hitset
+    // bin hits by layer
+    const auto cluspos_pair = std::make_pair(adc, global);
+    cluspos_map.insert(std::make_pair(layer, cluspos_pair));
+    layer_bin_set.insert(layer);
+  }  // end looping over hits
 
   h_adc_sum->Fill(sum_adc_truth);
   h_num_sum->Fill(sum_n_hits_truth);
@@ -1024,51 +1100,29 @@ void TpcDirectLaserReconstruction::process_track(SvtxTrack* track)
   ////////////////////////////////////////////////
 
   // now loop over hits AGAIN and get ADC spectrum
-
-  float sum_adc_reco = 0;
-  float sum_n_hits_reco = 0;
-
-  for (auto hitsetitr = hitsetrange.first; hitsetitr != hitsetrange.second; ++hitsetitr)
+  /*
+   * only hits in the z range where the reconstructed direction crosses a layer can pass the dca cut.
+   * selected hits are processed in hitset order, as when looping over all hits
+   */
+  std::vector<unsigned int> selected_hits;
+  for (const auto& [layer_2, indices] : m_hits_by_layer)
   {
-    const TrkrDefs::hitsetkey& hitsetkey_2 = hitsetitr->first;
-    const int side_2 = TpcDefs::getSide(hitsetkey_2);
-
-    auto hitset_2 = hitsetitr->second;
-    const unsigned int layer_2 = TrkrDefs::getLayer(hitsetkey_2);
-    const auto layergeom_2 = m_geom_container->GetLayerCellGeom(layer_2);
-    const auto layer_center_radius_2 = layergeom_2->get_radius();
-
-    // maximum drift time.
-    /* it is needed to calculate a given hit position from its drift time */
-    static constexpr double AdcClockPeriod_2 = 53.0;  // ns
-    const unsigned short NTBins_2 = (unsigned short) layergeom_2->get_zbins();
-    const float tdriftmax_2 = AdcClockPeriod_2 * NTBins_2 / 2.0;
-
-    // get corresponding hits
-    TrkrHitSet::ConstRange hitrangei_2 = hitset_2->getHits();
-
-    for (auto hitr = hitrangei_2.first; hitr != hitrangei_2.second; ++hitr)
+    const auto layer_center_radius_2 = m_geom_container->GetLayerCellGeom(layer_2)->get_radius();
+    double zmin_2 = 0;
+    double zmax_2 = 0;
+    if (!line_cylinder_zrange(origin, dir, layer_center_radius_2, m_max_dca, zmin_2, zmax_2))
     {
-      const unsigned short phibin_2 = TpcDefs::getPad(hitr->first);
-      const unsigned short zbin_2 = TpcDefs::getTBin(hitr->first);
-
-      const double phi_2 = layergeom_2->get_phicenter(phibin_2);
-      const double x_2 = layer_center_radius_2 * cos(phi_2);
-      const double y_2 = layer_center_radius_2 * sin(phi_2);
-
-      const double zdriftlength_2 = layergeom_2->get_zcenter(zbin_2) * m_tGeometry->get_drift_velocity();
-      double z_2 = tdriftmax_2 * m_tGeometry->get_drift_velocity() - zdriftlength_2;
-      if (side_2 == 0)
-      {
-        z_2 *= -1;
-      }
-
-      const TVector3 global_2(x_2, y_2, z_2);
-
-      bool sameside_reco = sameSign(global_2.z(), origin.z());
+      continue;
+    }
 
-      float adc_2 = (hitr->second->getAdc()) - m_pedestal;
-      float adc_2_unsub = (hitr->second->getAdc());
+    const auto begin = std::lower_bound(indices.begin(), indices.end(), zmin_2, [this](unsigned int index, double value)
+                                        { return m_hits[index].z < value; });
+    const auto end = std::upper_bound(begin, indices.end(), zmax_2, [this](double value, unsigned int index)
+                                      { return value < m_hits[index].z; });
+    for (auto iter = begin; iter != end; ++iter)
+    {
+      const auto& hit = m_hits[*iter];
+      const TVector3 global_2(hit.x, hit.y, hit.z);
 
       // calculate dca
       // origin is track origin, direction is track direction
@@ -1081,20 +1135,35 @@ void TpcDirectLaserReconstruction::process_track(SvtxTrack* track)
       {
         continue;  // do not record if hit is outside DCA, proceed to next hit
       }
-      if (sameside_reco)
-      {
-        sum_n_hits_reco++;
-        h_adc_reco->Fill(adc_2);
-        sum_adc_reco += adc_2_unsub;
-      }  // increment reco but only if hits are on the same side
-      /*
-              if(h_hits_reco && trkid == 0)
-              {
-                  h_hits_reco->Fill(x_2,y_2,z_2,adc_2);
-              }
-      */
-    }  // end loop over hits again
-  }    // end loop over hitset again
+      selected_hits.push_back(*iter);
+    }
+  }
+  std::sort(selected_hits.begin(), selected_hits.end());
+
+  float sum_adc_reco = 0;
+  float sum_n_hits_reco = 0;
+
+  for (const auto& index : selected_hits)
+  {
+    const auto& hit = m_hits[index];
+    bool sameside_reco = sameSign(hit.z, origin.z());
+
+    float adc_2 = hit.adc - m_pedestal;
+    float adc_2_unsub = hit.adc;
+
+    if (sameside_reco)
+    {
+      sum_n_hits_reco++;
+      h_adc_reco->Fill(adc_2);
+      sum_adc_reco += adc_2_unsub;
+    }  // increment reco but only if hits are on the same side
+    /*
+            if(h_hits_reco && trkid == 0)
+            {
+                h_hits_reco->Fill(hit.x,hit.y,hit.z,adc_2);
+            }
+    */
+  }  // end loop over hits again
 
   h_adc_sum_reco->Fill(sum_adc_reco);
   h_num_sum_reco->Fill(sum_n_hits_reco);
@@ -12,7 +12,9 @@
 #include <trackbase_historic/ActsTransformations.h>
 
 #include <limits>
+#include <map>
 #include <memory>
+#include <vector>
 
 class SvtxTrack;
 class SvtxTrackMap;
@@ -87,6 +89,9 @@ class TpcDirectLaserReconstruction : public SubsysReco, public PHParameterInterf
   /// create evaluation histograms
   void create_histograms();
 
+  /// fill hit positions and per layer index, once per event
+  void fill_hits();
+
   /// process tracks
   void process_tracks();
 
@@ -153,6 +158,28 @@ class TpcDirectLaserReconstruction : public SubsysReco, public PHParameterInterf
 
   //@}
 
+  ///@name hits of the current event
+  //@{
+
+  /// hit position and ADC
+  struct LaserHit
+  {
+    unsigned int layer {0};
+    double phi {0};
+    double x {0};
+    double y {0};
+    double z {0};
+    unsigned int adc {0};
+  };
+
+  /// hits, in hitset order
+  std::vector<LaserHit> m_hits;
+
+  /// per layer, hit indices sorted by z
+  std::map<unsigned int, std::vector<unsigned int>> m_hits_by_layer;
+
+  //@}
+
   ///@name evaluation
   //@{
   bool m_savehistograms {false};
@@ -141,9 +141,9 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
   unsigned int layer = TrkrDefs::getLayer(hitsetkey);
   unsigned int side = TpcDefs::getSide(hitsetkey);
 
-  auto mapIter = maps().m_tpcSurfaceMap.find(layer);
+  const auto surf_vec_ptr = maps().getTpcSurfaceVector(layer);
 
-  if (mapIter == maps().m_tpcSurfaceMap.end())
+  if (!surf_vec_ptr)
   {
     std::cout << "Error: hitsetkey not found in ActsGeometry::get_tpc_surface_from_coords, hitsetkey = "
               << hitsetkey << std::endl;
@@ -152,7 +152,7 @@ Surface ActsGeometry::get_tpc_surface_from_coords(
 
   double world_phi = atan2(world[1], world[0]);
 
-  std::vector<Surface>& surf_vec = mapIter->second;
+  const std::vector<Surface>& surf_vec = *surf_vec_ptr;
   unsigned int surf_index = 999;
 
   // Predict which surface index this phi and side will correspond to
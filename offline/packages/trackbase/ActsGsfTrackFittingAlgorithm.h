@@ -54,6 +54,9 @@ namespace
     bool disableAllMaterialHandling = false;
     Acts::MixtureReductionMethod reductionMethod =
         Acts::MixtureReductionMethod::eMaxWeight;
+    /// drop the lightest components instead of merging the closest ones
+    /// (KL distance) when there are more than maxComponents
+    bool reduceByWeight = false;
 
     ActsSourceLink::SurfaceAccessor m_slSurfaceAccessor;
 
@@ -89,7 +92,14 @@ namespace
       gsfOptions.extensions.calibrator.connect<&calibrator_t::calibrate>(
           &calibrator);
       gsfOptions.extensions.surfaceAccessor.connect<&ActsSourceLink::SurfaceAccessor::operator()>(&m_slSurfaceAccessor);
-      gsfOptions.extensions.mixtureReducer.connect<&Acts::reduceMixtureWithKLDistance>();
+      if (reduceByWeight)
+      {
+        gsfOptions.extensions.mixtureReducer.connect<&Acts::reduceMixtureLargestWeights>();
+      }
+      else
+      {
+        gsfOptions.extensions.mixtureReducer.connect<&Acts::reduceMixtureWithKLDistance>();
+      }
 
       return gsfOptions;
     }
@@ -130,5 +140,6 @@ class ActsGsfTrackFittingAlgorithm
       BetheHeitlerApprox betheHeitlerApprox, std::size_t maxComponents,
       double weightCutoff,
       Acts::MixtureReductionMethod finalReductionMethod, bool abortOnError,
-      bool disableAllMaterialHandling, const Acts::Logger& logger = *Acts::getDefaultLogger("GSF", Acts::Logging::FATAL));
+      bool disableAllMaterialHandling, bool reduceByWeight = false,
+      const Acts::Logger& logger = *Acts::getDefaultLogger("GSF", Acts::Logging::FATAL));
 };
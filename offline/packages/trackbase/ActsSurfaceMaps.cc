@@ -88,11 +88,22 @@ Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 
   // std::cout << "tmpkey = " << tmpkey << std::endl;
 
-  auto iter = m_siliconSurfaceMap.find(tmpkey);
-  if (iter != m_siliconSurfaceMap.end())
+  if (!m_siliconSurfaceTable.empty())
   {
-    // std::cout << "Found silicon surface for hitsetkey " << hitsetkey << " tmpkey " << tmpkey << std::endl;
-    return iter->second;
+    const auto iter = m_siliconSurfaceTable.find(tmpkey);
+    if (iter != m_siliconSurfaceTable.end())
+    {
+      return iter->second;
+    }
+  }
+  else
+  {
+    auto iter = m_siliconSurfaceMap.find(tmpkey);
+    if (iter != m_siliconSurfaceMap.end())
+    {
+      // std::cout << "Found silicon surface for hitsetkey " << hitsetkey << " tmpkey " << tmpkey << std::endl;
+      return iter->second;
+    }
   }
 
   /// If it can't be found, return nullptr
@@ -105,19 +116,45 @@ Surface ActsSurfaceMaps::getSiliconSurface(TrkrDefs::hitsetkey hitsetkey) const
 Surface ActsSurfaceMaps::getTpcSurface(TrkrDefs::hitsetkey hitsetkey,
                                        TrkrDefs::subsurfkey surfkey) const
 {
-  unsigned int layer = TrkrDefs::getLayer(hitsetkey);
-  const auto iter = m_tpcSurfaceMap.find(layer);
-
-  if (iter != m_tpcSurfaceMap.end())
+  const auto surfvec = getTpcSurfaceVector(TrkrDefs::getLayer(hitsetkey));
+  if (surfvec)
   {
-    auto surfvec = iter->second;
-    return surfvec.at(surfkey);
+    return surfvec->at(surfkey);
   }
 
   /// If it can't be found, return nullptr to skip this cluster
   return nullptr;
 }
 
+const SurfaceVec* ActsSurfaceMaps::getTpcSurfaceVector(unsigned int layer) const
+{
+  if (!m_tpcSurfaceTable.empty())
+  {
+    return (layer < m_tpcSurfaceTable.size() && !m_tpcSurfaceTable[layer].empty()) ? &m_tpcSurfaceTable[layer] : nullptr;
+  }
+
+  // tables not built, use the map
+  const auto iter = m_tpcSurfaceMap.find(layer);
+  return (iter == m_tpcSurfaceMap.end()) ? nullptr : &iter->second;
+}
+
+void ActsSurfaceMaps::buildLookupTables()
+{
+  m_tpcSurfaceTable.clear();
+  if (!m_tpcSurfaceMap.empty())
+  {
+    m_tpcSurfaceTable.resize(m_tpcSurfaceMap.rbegin()->first + 1);
+    for (const auto& [layer, surfaces] : m_tpcSurfaceMap)
+    {
+      m_tpcSurfaceTable[layer] = surfaces;
+    }
+  }
+
+  m_siliconSurfaceTable.clear();
+  m_siliconSurfaceTable.reserve(m_siliconSurfaceMap.size());
+  m_siliconSurfaceTable.insert(m_siliconSurfaceMap.begin(), m_siliconSurfaceMap.end());
+}
+
 Surface ActsSurfaceMaps::getMMSurface(TrkrDefs::hitsetkey hitsetkey) const
 {
   const auto iter = m_mmSurfaceMap.find(hitsetkey);
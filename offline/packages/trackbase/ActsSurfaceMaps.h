@@ -24,6 +24,7 @@ class TrkrCluster;
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 using Surface = std::shared_ptr<const Acts::Surface>;
@@ -49,6 +50,13 @@ struct ActsSurfaceMaps
 
   Surface getMMSurface(TrkrDefs::hitsetkey hitsetkey) const;
 
+  //! TPC surfaces of a given layer, ordered by subsurface key, nullptr if not found
+  const SurfaceVec* getTpcSurfaceVector(unsigned int layer) const;
+
+  //! fill the lookup tables below from the surface maps
+  /** must be called again whenever the maps are modified */
+  void buildLookupTables();
+
   //! map hitset to Surface for the silicon detectors (MVTX and INTT)
   std::map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceMap;
 
@@ -68,6 +76,13 @@ struct ActsSurfaceMaps
   //! stores all acts volume ids relevant to the micromegas
   /** it is used to quickly tell if a given Acts Surface belongs to micromegas */
   std::set<int> m_micromegasVolumeIds;
+
+  //! TPC surfaces indexed by layer, then by subsurface key (phi bin and z segment)
+  /** filled by buildLookupTables from m_tpcSurfaceMap, empty for layers without TPC surfaces */
+  std::vector<SurfaceVec> m_tpcSurfaceTable;
+
+  //! hashed copy of m_siliconSurfaceMap, filled by buildLookupTables
+  std::unordered_map<TrkrDefs::hitsetkey, Surface> m_siliconSurfaceTable;
 };
 
 #endif
@@ -25,8 +25,10 @@
 #include <Eigen/Geometry>
 #include <Eigen/LU>
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
+#include <future>
 #include <sstream>
 
 void AlignmentTransformation::createMap(PHCompositeNode* topNode)
@@ -44,11 +46,6 @@ void AlignmentTransformation::createMap(PHCompositeNode* topNode)
     alignmentTransformationContainer::use_alignment = false;
   }
 
-  // Define Parsing Variables
-  TrkrDefs::hitsetkey hitsetkey = 0;
-  //  float alpha = 0.0, beta = 0.0, gamma = 0.0, dr = 0.0, rdphi = 0.0, dz = 0.0;
-  float alpha = 0.0, beta = 0.0, gamma = 0.0, dx = 0.0, dy = 0.0, dz = 0.0;
-
   // load alignment constants file
   std::ifstream datafile;
   datafile.open(alignmentParamsFile);  //  looks for default file name on disk
@@ -70,10 +67,98 @@ void AlignmentTransformation::createMap(PHCompositeNode* topNode)
   // If it is old, there will only be six. In that case, set the global rotation pars to zero, and issue a warning.
 
 
-  ActsSurfaceMaps surfMaps = m_tGeometry->maps();
-  Surface surf;
+  std::vector<AlignmentParameters> params;
+  readAlignmentParameters(datafile, params);
+  m_lastParams.clear();
+
+  std::vector<SurfaceTransform> tasks;
+  for (const auto& par : params)
+  {
+    addSurfaceTasks(par, tasks);
+    m_lastParams[par.hitsetkey] = par;
+  }
+  computeTransforms(tasks);
+
+  for (const auto& task : tasks)
+  {
+    if (localVerbosity)
+    {
+      std::cout << " Add transform for surface GeometryIdentifier " << task.id << " trkrid " << (unsigned int) TrkrDefs::getTrkrId(task.hitsetkey)
+                << " hitsetkey " << task.hitsetkey << std::endl;
+      std::cout << " final transform:" << std::endl
+                << task.transform.matrix() << std::endl;
+    }
+    transformMap->addTransform(task.id, task.transform);
+    transformMapTransient->addTransform(task.id, task.transform);
+  }
+
+  // copy map into geoContext
+  m_tGeometry->geometry().geoContext = transformMap;
+
+  // map is created, now we can use the transforms
+  alignmentTransformationContainer::use_alignment = true;
+}
+
+void AlignmentTransformation::updateMap(PHCompositeNode* topNode)
+{
+  if (!transformMap || m_lastParams.empty())
+  {
+    // nothing to update yet
+    if (!transformMap)
+    {
+      createAlignmentTransformContainer(topNode);
+    }
+    createMap(topNode);
+    return;
+  }
+
+  std::ifstream datafile(alignmentParamsFile);
+  if (!datafile.is_open())
+  {
+    std::cout << PHWHERE << " cannot open alignment parameters file " << alignmentParamsFile
+              << ", alignment transforms not updated" << std::endl;
+    return;
+  }
+  std::vector<AlignmentParameters> params;
+  readAlignmentParameters(datafile, params);
+
+  // only surfaces whose parameters changed, randomly perturbed detectors are always redone
+  std::vector<SurfaceTransform> tasks;
+  for (const auto& par : params)
+  {
+    auto iter = m_lastParams.find(par.hitsetkey);
+    if (iter != m_lastParams.end() && !isPerturbed(par.hitsetkey) &&
+        iter->second.angles == par.angles && iter->second.translation == par.translation)
+    {
+      continue;
+    }
+    addSurfaceTasks(par, tasks);
+    m_lastParams[par.hitsetkey] = par;
+  }
+
+  // transforms are built on top of the construction transforms
+  alignmentTransformationContainer::use_alignment = false;
+  computeTransforms(tasks);
+  for (const auto& task : tasks)
+  {
+    transformMap->replaceTransform(task.id, task.transform);
+    transformMapTransient->replaceTransform(task.id, task.transform);
+  }
+  alignmentTransformationContainer::use_alignment = true;
+
+  std::cout << "AlignmentTransformation: updated " << tasks.size() << " surface transforms from "
+            << alignmentParamsFile << std::endl;
+}
+
+void AlignmentTransformation::readAlignmentParameters(std::ifstream& datafile, std::vector<AlignmentParameters>& params)
+{
+  // Define Parsing Variables
+  TrkrDefs::hitsetkey hitsetkey = 0;
+  //  float alpha = 0.0, beta = 0.0, gamma = 0.0, dr = 0.0, rdphi = 0.0, dz = 0.0;
+  float alpha = 0.0, beta = 0.0, gamma = 0.0, dx = 0.0, dy = 0.0, dz = 0.0;
 
   int fileLines = 1824;
+  params.reserve(fileLines);
   for (int i = 0; i < fileLines; i++)
   {
     // guard against reading in bad parameter files
@@ -103,149 +188,158 @@ void AlignmentTransformation::createMap(PHCompositeNode* topNode)
 		   << std::endl;  
       }
 
-    // Perturbation translations and angles for stave and sensor
-    Eigen::Vector3d sensorAngles(alpha, beta, gamma);
-    Eigen::Vector3d millepedeTranslation(dx, dy, dz);
+    AlignmentParameters par;
+    par.hitsetkey = hitsetkey;
+    par.angles = Eigen::Vector3d(alpha, beta, gamma);
+    par.translation = Eigen::Vector3d(dx, dy, dz);
+    params.push_back(par);
+  }
+}
 
-    unsigned int trkrId = TrkrDefs::getTrkrId(hitsetkey);  // specify between detectors
+bool AlignmentTransformation::isPerturbed(TrkrDefs::hitsetkey hitsetkey) const
+{
+  switch (TrkrDefs::getTrkrId(hitsetkey))
+  {
+  case TrkrDefs::mvtxId:
+    return perturbMVTX;
+  case TrkrDefs::inttId:
+    return perturbINTT;
+  case TrkrDefs::tpcId:
+    return perturbTPC;
+  case TrkrDefs::micromegasId:
+    return perturbMM;
+  default:
+    return false;
+  }
+}
 
-    perturbationAngles = Eigen::Vector3d(0.0, 0.0, 0.0);
-    perturbationAnglesGlobal = Eigen::Vector3d(0.0, 0.0, 0.0);
-    perturbationTranslation = Eigen::Vector3d(0.0, 0.0, 0.0);
+void AlignmentTransformation::addSurfaceTasks(const AlignmentParameters& par, std::vector<SurfaceTransform>& tasks)
+{
+  const TrkrDefs::hitsetkey hitsetkey = par.hitsetkey;
+  const ActsSurfaceMaps& surfMaps = m_tGeometry->maps();
 
-    if (trkrId == TrkrDefs::mvtxId)
-    {
-      if (perturbMVTX)
-      {
-        generateRandomPerturbations(mvtxAngleDev, mvtxTransDev);
-        sensorAngles = sensorAngles + perturbationAngles;
-        millepedeTranslation = millepedeTranslation + perturbationTranslation;
-      }
+  // Perturbation translations and angles for stave and sensor
+  Eigen::Vector3d sensorAngles = par.angles;
+  Eigen::Vector3d millepedeTranslation = par.translation;
 
-      surf = surfMaps.getSiliconSurface(hitsetkey);
+  unsigned int trkrId = TrkrDefs::getTrkrId(hitsetkey);  // specify between detectors
 
-      Acts::Transform3 transform;
-      transform = newMakeTransform(surf, millepedeTranslation, sensorAngles, false);
+  perturbationAngles = Eigen::Vector3d(0.0, 0.0, 0.0);
+  perturbationAnglesGlobal = Eigen::Vector3d(0.0, 0.0, 0.0);
+  perturbationTranslation = Eigen::Vector3d(0.0, 0.0, 0.0);
 
-      Acts::GeometryIdentifier id = surf->geometryId();
+  SurfaceTransform task;
+  task.hitsetkey = hitsetkey;
 
-      if (localVerbosity)
-      {
-        std::cout << " Add transform for MVTX with surface GeometryIdentifier " << id << " trkrid " << trkrId << std::endl;
-        std::cout << " final mvtx transform:" << std::endl
-                  << transform.matrix() << std::endl;
-      }
-      transformMap->addTransform(id, transform);
-      transformMapTransient->addTransform(id, transform);
+  if (trkrId == TrkrDefs::mvtxId)
+  {
+    if (perturbMVTX)
+    {
+      generateRandomPerturbations(mvtxAngleDev, mvtxTransDev);
+      sensorAngles = sensorAngles + perturbationAngles;
+      millepedeTranslation = millepedeTranslation + perturbationTranslation;
     }
-
-    else if (trkrId == TrkrDefs::inttId)
+    task.surf = surfMaps.getSiliconSurface(hitsetkey);
+  }
+  else if (trkrId == TrkrDefs::inttId)
+  {
+    if (perturbINTT)
     {
-      if (perturbINTT)
-      {
-        generateRandomPerturbations(inttAngleDev, inttTransDev);
-        sensorAngles = sensorAngles + perturbationAngles;
-        millepedeTranslation = millepedeTranslation + perturbationTranslation;
-      }
-
-      surf = surfMaps.getSiliconSurface(hitsetkey);
-
-      Acts::Transform3 transform;
-      transform = newMakeTransform(surf, millepedeTranslation, sensorAngles, use_intt_survey_geometry);
-      Acts::GeometryIdentifier id = surf->geometryId();
-
-      if (localVerbosity)
-      {
-        std::cout << " Add transform for INTT with surface GeometryIdentifier " << id << " trkrid " << trkrId << std::endl;
-      }
-
-      transformMap->addTransform(id, transform);
-      transformMapTransient->addTransform(id, transform);
+      generateRandomPerturbations(inttAngleDev, inttTransDev);
+      sensorAngles = sensorAngles + perturbationAngles;
+      millepedeTranslation = millepedeTranslation + perturbationTranslation;
+    }
+    task.surf = surfMaps.getSiliconSurface(hitsetkey);
+    task.survey = use_intt_survey_geometry;
+  }
+  else if (trkrId == TrkrDefs::tpcId)
+  {
+    if (perturbTPC)
+    {
+      generateRandomPerturbations(tpcAngleDev, tpcTransDev);
+      sensorAngles = sensorAngles + perturbationAngles;
+      millepedeTranslation = millepedeTranslation + perturbationTranslation;
     }
+    task.angles = sensorAngles;
+    task.translation = millepedeTranslation;
 
-    else if (trkrId == TrkrDefs::tpcId)
+    unsigned int sector = TpcDefs::getSectorId(hitsetkey);
+    unsigned int side = TpcDefs::getSide(hitsetkey);
+    int subsurfkey_min = (1 - side) * 144 + (144 - sector * 12) - 12 - 6;
+    int subsurfkey_max = subsurfkey_min + 12;
+    // std::cout << " sector " << sector << " side " << side << " subsurfkey_min " << subsurfkey_min << " subsurfkey_max " << subsurfkey_max << std::endl;
+
+    for (int subsurfkey = subsurfkey_min; subsurfkey < subsurfkey_max; subsurfkey++)
     {
-      if (perturbTPC)
+      int sskey = subsurfkey;
+      if (sskey < 0)
       {
-        generateRandomPerturbations(tpcAngleDev, tpcTransDev);
-        sensorAngles = sensorAngles + perturbationAngles;
-        millepedeTranslation = millepedeTranslation + perturbationTranslation;
+        sskey += 288;
       }
-      unsigned int sector = TpcDefs::getSectorId(hitsetkey);
-      unsigned int side = TpcDefs::getSide(hitsetkey);
-      int subsurfkey_min = (1 - side) * 144 + (144 - sector * 12) - 12 - 6;
-      int subsurfkey_max = subsurfkey_min + 12;
-      // std::cout << " sector " << sector << " side " << side << " subsurfkey_min " << subsurfkey_min << " subsurfkey_max " << subsurfkey_max << std::endl;
 
-      for (int subsurfkey = subsurfkey_min; subsurfkey < subsurfkey_max; subsurfkey++)
-      {
-        int sskey = subsurfkey;
-        if (sskey < 0)
-        {
-          sskey += 288;
-        }
-
-        surf = surfMaps.getTpcSurface(hitsetkey, (unsigned int) sskey);
-
-        Acts::Transform3 transform;
-        transform = newMakeTransform(surf, millepedeTranslation, sensorAngles, false);
-        Acts::GeometryIdentifier id = surf->geometryId();
-
-        if (localVerbosity)
-        {
-          unsigned int layer = TrkrDefs::getLayer(hitsetkey);
-          std::cout << " Add transform for TPC with surface GeometryIdentifier " << id << std::endl
-                    << " trkrid " << trkrId << " hitsetkey " << hitsetkey << " layer " << layer << " sector " << sector << " side " << side
-                    << " subsurfkey " << subsurfkey << std::endl;
-          Acts::Vector3 center = surf->center(m_tGeometry->geometry().getGeoContext()) * 0.1;  // convert to cm
-          std::cout << "Ideal surface center: " << std::endl
-                    << center << std::endl;
-          std::cout << "transform matrix: " << std::endl
-                    << transform.matrix() << std::endl;
-        }
-        transformMap->addTransform(id, transform);
-        transformMapTransient->addTransform(id, transform);
-      }
+      task.surf = surfMaps.getTpcSurface(hitsetkey, (unsigned int) sskey);
+      task.id = task.surf->geometryId();
+      tasks.push_back(task);
     }
-    else if (trkrId == TrkrDefs::micromegasId)
+    return;
+  }
+  else if (trkrId == TrkrDefs::micromegasId)
+  {
+    if (perturbMM)
     {
-      if (perturbMM)
-      {
-        generateRandomPerturbations(mmAngleDev, mmTransDev);
+      generateRandomPerturbations(mmAngleDev, mmTransDev);
 
-        sensorAngles = sensorAngles + perturbationAngles;
-        millepedeTranslation = millepedeTranslation + perturbationTranslation;
-      }
-      surf = surfMaps.getMMSurface(hitsetkey);
-
-      Acts::Transform3 transform;
-      transform = newMakeTransform(surf, millepedeTranslation, sensorAngles,  false);
-      Acts::GeometryIdentifier id = surf->geometryId();
-
-      if (localVerbosity)
-      {
-        std::cout << " Add transform for Micromegas with surface GeometryIdentifier " << id << " trkrid " << trkrId << std::endl;
-      }
-
-      transformMap->addTransform(id, transform);
-      transformMapTransient->addTransform(id, transform);
+      sensorAngles = sensorAngles + perturbationAngles;
+      millepedeTranslation = millepedeTranslation + perturbationTranslation;
     }
+    task.surf = surfMaps.getMMSurface(hitsetkey);
+  }
+  else
+  {
+    std::cout << "Error: Invalid Hitsetkey" << std::endl;
+    return;
+  }
 
-    else
+  task.angles = sensorAngles;
+  task.translation = millepedeTranslation;
+  task.id = task.surf->geometryId();
+  tasks.push_back(task);
+}
+
+void AlignmentTransformation::computeTransforms(std::vector<SurfaceTransform>& tasks)
+{
+  auto compute = [this, &tasks](const size_t begin, const size_t end)
+  {
+    for (size_t i = begin; i < end; ++i)
     {
-      std::cout << "Error: Invalid Hitsetkey" << std::endl;
+      auto& task = tasks[i];
+      task.transform = newMakeTransform(task.surf, task.translation, task.angles, task.survey);
     }
-  }
+  };
 
-  // copy map into geoContext
-  m_tGeometry->geometry().geoContext = transformMap;
+  // the verbose printout of newMakeTransform is only readable in order
+  const size_t nthreads = (localVerbosity || m_nthreads < 2) ? 1 : std::min<size_t>(m_nthreads, tasks.size());
+  if (nthreads < 2)
+  {
+    compute(0, tasks.size());
+    return;
+  }
 
-  // map is created, now we can use the transforms
-  alignmentTransformationContainer::use_alignment = true;
+  // contiguous chunks, each surface is only written by one thread
+  const size_t chunk = (tasks.size() + nthreads - 1) / nthreads;
+  std::vector<std::future<void>> futures;
+  for (size_t begin = 0; begin < tasks.size(); begin += chunk)
+  {
+    futures.push_back(std::async(std::launch::async, compute, begin, std::min(begin + chunk, tasks.size())));
+  }
+  for (auto& future : futures)
+  {
+    future.get();
+  }
 }
 
 // currently used as the transform maker
-Acts::Transform3 AlignmentTransformation::newMakeTransform(const Surface& surf, Eigen::Vector3d& millepedeTranslation, Eigen::Vector3d& sensorAngles, bool survey)
+Acts::Transform3 AlignmentTransformation::newMakeTransform(const Surface& surf, const Eigen::Vector3d& millepedeTranslation, const Eigen::Vector3d& sensorAngles, bool survey)
 {
   // define null matrices
   Eigen::Vector3d nullTranslation(0, 0, 0);
@@ -7,8 +7,11 @@
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
+#include <fstream>
 #include <map>
 #include <random>
+#include <string>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -22,6 +25,11 @@ class AlignmentTransformation
   ~AlignmentTransformation() {}
 
   void createMap(PHCompositeNode* topNode);
+
+  //! re-read the alignment parameters file after createMap and recompute only the
+  //! transforms of surfaces whose parameters changed, e.g. between alignment iterations
+  void updateMap(PHCompositeNode* topNode);
+
   void createAlignmentTransformContainer(PHCompositeNode* topNode);
 
   void generateRandomPerturbations(Eigen::Vector3d angleDev, Eigen::Vector3d transformDev);
@@ -105,7 +113,40 @@ class AlignmentTransformation
   void misalignmentFactor(uint8_t layer, const double factor);
   void useInttSurveyGeometry(bool sur) { use_intt_survey_geometry = sur; }
 
+  //! number of threads used to compute the surface transforms, 1 (default) runs serially
+  void setNThreads(int n) { m_nthreads = n; }
+
  private:
+  //! parameters of one line of the alignment file
+  struct AlignmentParameters
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    Eigen::Vector3d angles = Eigen::Vector3d(0.0, 0.0, 0.0);
+    Eigen::Vector3d translation = Eigen::Vector3d(0.0, 0.0, 0.0);
+  };
+
+  //! input and result of the transform computation of one surface
+  struct SurfaceTransform
+  {
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    Surface surf;
+    Acts::GeometryIdentifier id;
+    Eigen::Vector3d angles = Eigen::Vector3d(0.0, 0.0, 0.0);
+    Eigen::Vector3d translation = Eigen::Vector3d(0.0, 0.0, 0.0);
+    bool survey = false;
+    Acts::Transform3 transform = Acts::Transform3::Identity();
+  };
+
+  void readAlignmentParameters(std::ifstream& datafile, std::vector<AlignmentParameters>& params);
+
+  //! surfaces of one hitset with perturbed parameters, random perturbations are drawn here in file order
+  void addSurfaceTasks(const AlignmentParameters& par, std::vector<SurfaceTransform>& tasks);
+
+  //! fill the transforms of the tasks, in parallel if requested
+  void computeTransforms(std::vector<SurfaceTransform>& tasks);
+
+  bool isPerturbed(TrkrDefs::hitsetkey hitsetkey) const;
+
   Eigen::Vector3d mvtxAngleDev;
   Eigen::Vector3d mvtxTransDev;
   Eigen::Vector3d inttAngleDev;
@@ -123,7 +164,12 @@ class AlignmentTransformation
 
   bool use_intt_survey_geometry = false;
 
-  Acts::Transform3 newMakeTransform(const Surface& surf, Eigen::Vector3d& millepedeTranslation, Eigen::Vector3d& sensorAngles, bool survey);
+  int m_nthreads = 1;
+
+  //! parameters used for the current transforms, by hitsetkey
+  std::map<TrkrDefs::hitsetkey, AlignmentParameters> m_lastParams;
+
+  Acts::Transform3 newMakeTransform(const Surface& surf, const Eigen::Vector3d& millepedeTranslation, const Eigen::Vector3d& sensorAngles, bool survey);
 
   alignmentTransformationContainer* transformMap = NULL;
   alignmentTransformationContainer* transformMapTransient = NULL;
@@ -3,6 +3,7 @@
 #include <trackbase/TrkrClusterv4.h>
 
 #include <TF1.h>
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <string>
@@ -18,7 +19,20 @@ namespace
   }
 }  // namespace
 
-ClusterErrorPara::ClusterErrorPara()
+//_________________________________________________________________________________
+void ClusterErrorPara::Function::set(const TF1* f, bool inverse_square)
+{
+  m_inverse_square = inverse_square;
+  m_npar = std::min<int>(f->GetNpar(), m_par.size());
+  for (int i = 0; i < m_npar; ++i)
+  {
+    m_par[i] = f->GetParameter(i);
+  }
+}
+
+//_________________________________________________________________________________
+ClusterErrorPara::ClusterErrorPara(bool use_tf1)
+  : m_use_tf1(use_tf1)
 {
   f0 = new TF1("f0", "pol1", 0, 10);
   f0->SetParameter(0, 0.0163943);
@@ -469,6 +483,36 @@ ClusterErrorPara::ClusterErrorPara()
   pull_fine_z[4] *= 1.127752;
   pull_fine_z[5] *= 0.804010;
   pull_fine_z[6] *= 0.567351;
+
+  // compiled copies of the parametrizations
+  f0_fn.set(f0);
+  f1_fn.set(f1);
+  f2_fn.set(f2);
+  f0fine_fn.set(f0fine);
+  f1fine_fn.set(f1fine);
+  f2fine_fn.set(f2fine);
+  fz0_fn.set(fz0);
+  fz1_fn.set(fz1);
+  fz2_fn.set(fz2);
+  fz0fine_fn.set(fz0fine);
+  fz1fine_fn.set(fz1fine);
+  fz2fine_fn.set(fz2fine);
+  fmm_55_2_fn.set(fmm_55_2);
+  fmm_56_2_fn.set(fmm_56_2);
+  fmm_3_fn.set(fmm_3);
+  fadcz0_fn.set(fadcz0);
+  fadcz1_fn.set(fadcz1);
+  fadcz2_fn.set(fadcz2);
+  fadcz0fine_fn.set(fadcz0fine, true);
+  fadcz1fine_fn.set(fadcz1fine, true);
+  fadcz2fine_fn.set(fadcz2fine, true);
+  fadcphi0_fn.set(fadcphi0);
+  fadcphi0fine_fn.set(fadcphi0fine);
+  fadcphi1_fn.set(fadcphi1);
+  fadcphi1fine_fn.set(fadcphi1fine);
+  fadcphi2_fn.set(fadcphi2);
+  fadcphi2fine1_fn.set(fadcphi2fine1);
+  fadcphi2fine2_fn.set(fadcphi2fine2);
 }
 
 //_________________________________________________________________________________
@@ -551,7 +595,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
   if (sector == 0)
   {
     // phierror = 0.019886;
-    phierror = f0->Eval(alpha);
+    phierror = eval(f0, f0_fn, alpha);
     if (cluster->getMaxAdc() != 0)
     {
       if (cluster->getMaxAdc() > 150)
@@ -560,8 +604,8 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi0->Eval(cluster->getMaxAdc());
-        phierror *= fadcphi0fine->Eval(cluster->getMaxAdc());
+        phierror *= eval(fadcphi0, fadcphi0_fn, cluster->getMaxAdc());
+        phierror *= eval(fadcphi0fine, fadcphi0fine_fn, cluster->getMaxAdc());
       }
     }
     if (cluster->getEdge() >= 5)
@@ -582,13 +626,13 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 2.5;
     }
 
-    phierror *= f0fine->Eval(alpha);
+    phierror *= eval(f0fine, f0fine_fn, alpha);
   }
 
   if (sector == 1)
   {
     // phierror = 0.018604;
-    phierror = f1->Eval(alpha);
+    phierror = eval(f1, f1_fn, alpha);
     if (cluster->getMaxAdc() != 0)
     {
       if (cluster->getMaxAdc() > 160)
@@ -597,7 +641,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi1->Eval(cluster->getMaxAdc());
+        phierror *= eval(fadcphi1, fadcphi1_fn, cluster->getMaxAdc());
       }
       if (cluster->getEdge() >= 5)
       {
@@ -609,7 +653,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi1fine->Eval(cluster->getMaxAdc());
+        phierror *= eval(fadcphi1fine, fadcphi1fine_fn, cluster->getMaxAdc());
       }
     }
     phierror *= 0.975;
@@ -626,14 +670,14 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 2;
     }
 
-    phierror *= f1fine->Eval(alpha);
+    phierror *= eval(f1fine, f1fine_fn, alpha);
   }
 
   if (sector == 2)
   {
     // phierror = 0.02043;
 
-    phierror = f2->Eval(alpha);
+    phierror = eval(f2, f2_fn, alpha);
     if (cluster->getMaxAdc())
     {
       if (cluster->getMaxAdc() > 170)
@@ -642,10 +686,10 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       }
       else
       {
-        phierror *= fadcphi2->Eval(cluster->getMaxAdc());
+        phierror *= eval(fadcphi2, fadcphi2_fn, cluster->getMaxAdc());
         if (cluster->getMaxAdc() < 100)
         {
-          phierror *= fadcphi2fine1->Eval(cluster->getMaxAdc());
+          phierror *= eval(fadcphi2fine1, fadcphi2fine1_fn, cluster->getMaxAdc());
         }
       }
     }
@@ -663,7 +707,7 @@ double ClusterErrorPara::tpc_phi_error(int layer, double alpha, TrkrCluster* clu
       phierror *= 10;
     }
 
-    phierror *= f2fine->Eval(alpha);
+    phierror *= eval(f2fine, f2fine_fn, alpha);
   }
   if (layer == 7)
   {
@@ -717,48 +761,48 @@ double ClusterErrorPara::tpc_z_error(int layer, double beta, TrkrCluster* cluste
 
   if (sector == 0)
   {
-    zerror = fz0->Eval(beta);
+    zerror = eval(fz0, fz0_fn, beta);
     if (cluster->getMaxAdc() > 180)
     {
       zerror *= 0.5;
     }
     else
     {
-      zerror *= fadcz0->Eval(cluster->getMaxAdc());
+      zerror *= eval(fadcz0, fadcz0_fn, cluster->getMaxAdc());
     }
-    zerror *= fz0fine->Eval(beta);
-    zerror *= fadcz0fine->Eval(cluster->getMaxAdc());
+    zerror *= eval(fz0fine, fz0fine_fn, beta);
+    zerror *= eval(fadcz0fine, fadcz0fine_fn, cluster->getMaxAdc());
   }
 
   if (sector == 1)
   {
-    zerror = fz1->Eval(beta);
+    zerror = eval(fz1, fz1_fn, beta);
     if (cluster->getMaxAdc() > 180)
     {
       zerror *= 0.6;
     }
     else
     {
-      zerror *= fadcz1->Eval(cluster->getMaxAdc());
+      zerror *= eval(fadcz1, fadcz1_fn, cluster->getMaxAdc());
     }
-    zerror *= fz1fine->Eval(beta);
-    zerror *= fadcz1fine->Eval(cluster->getMaxAdc());
+    zerror *= eval(fz1fine, fz1fine_fn, beta);
+    zerror *= eval(fadcz1fine, fadcz1fine_fn, cluster->getMaxAdc());
     zerror *= 0.98;
     //    zerror *= 1.05913
   }
   if (sector == 2)
   {
-    zerror = fz2->Eval(beta);
+    zerror = eval(fz2, fz2_fn, beta);
     if (cluster->getMaxAdc() > 170)
     {
       zerror *= 0.6;
     }
     else
     {
-      zerror *= fadcz2->Eval(cluster->getMaxAdc());
+      zerror *= eval(fadcz2, fadcz2_fn, cluster->getMaxAdc());
     }
-    zerror *= fz2fine->Eval(beta);
-    zerror *= fadcz2fine->Eval(cluster->getMaxAdc());
+    zerror *= eval(fz2fine, fz2fine_fn, beta);
+    zerror *= eval(fadcz2fine, fadcz2fine_fn, cluster->getMaxAdc());
     // zerrror *= 1.15575;
   }
   if (layer == 7)
@@ -801,11 +845,11 @@ double ClusterErrorPara::mm_phi_error(int layer, double alpha, TrkrCluster* clus
     }
     else if (cluster->getPhiSize() == 2)
     {
-      phierror = fmm_55_2->Eval(alpha);
+      phierror = eval(fmm_55_2, fmm_55_2_fn, alpha);
     }
     else if (cluster->getPhiSize() >= 3)
     {
-      phierror = fmm_3->Eval(alpha);
+      phierror = eval(fmm_3, fmm_3_fn, alpha);
     }
     phierror *= scale_mm_0;
   }
@@ -831,11 +875,11 @@ double ClusterErrorPara::mm_z_error(int layer, double beta, TrkrCluster* cluster
     }
     else if (cluster->getZSize() == 2)
     {
-      zerror = fmm_56_2->Eval(beta);
+      zerror = eval(fmm_56_2, fmm_56_2_fn, beta);
     }
     else if (cluster->getZSize() >= 3)
     {
-      zerror = fmm_3->Eval(beta);
+      zerror = eval(fmm_3, fmm_3_fn, beta);
     }
     zerror *= scale_mm_1;
   }
@@ -5,6 +5,7 @@
 
 #include <TF1.h>
 #include <trackbase/TrkrClusterv5.h>
+#include <array>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -15,7 +16,9 @@ class TrkrCluster;
 class ClusterErrorPara
 {
  public:
-  ClusterErrorPara();
+  //! the parametrizations are evaluated from compiled copies of the TF1s,
+  //! use_tf1 evaluates the TF1s themselves, for validation
+  explicit ClusterErrorPara(bool use_tf1 = false);
   // delete copy ctor and assignment operator (cppcheck)
   explicit ClusterErrorPara(const ClusterErrorPara &) = delete;
   ClusterErrorPara &operator=(const ClusterErrorPara &) = delete;
@@ -76,6 +79,43 @@ class ClusterErrorPara
   double tpc_z_error(int layer, double beta, TrkrCluster *cluster);
 
  private:
+  //! compiled copy of a polynomial or [0]+[1]/(x-[2])^2 TF1
+  class Function
+  {
+   public:
+    void set(const TF1 *f, bool inverse_square = false);
+
+    double operator()(double x) const
+    {
+      if (m_inverse_square)
+      {
+        return m_par[0] + m_par[1] / square(x - m_par[2]);
+      }
+      // Horner
+      double value = 0;
+      for (int i = m_npar - 1; i >= 0; --i)
+      {
+        value = value * x + m_par[i];
+      }
+      return value;
+    }
+
+   private:
+    static double square(double x) { return x * x; }
+
+    std::array<double, 6> m_par{};
+    int m_npar = 0;
+    bool m_inverse_square = false;
+  };
+
+  //! evaluate either the TF1 or its compiled copy
+  double eval(const TF1 *f, const Function &fn, double x) const
+  {
+    return m_use_tf1 ? f->Eval(x) : fn(x);
+  }
+
+  bool m_use_tf1 = false;
+
   TF1 *f0 = nullptr;
   TF1 *f1 = nullptr;
   TF1 *f2 = nullptr;
@@ -105,6 +145,35 @@ class ClusterErrorPara
   TF1 *fadcphi2 = nullptr;
   TF1 *fadcphi2fine1 = nullptr;
   TF1 *fadcphi2fine2 = nullptr;
+
+  Function f0_fn;
+  Function f1_fn;
+  Function f2_fn;
+  Function f0fine_fn;
+  Function f1fine_fn;
+  Function f2fine_fn;
+  Function fz0_fn;
+  Function fz1_fn;
+  Function fz2_fn;
+  Function fz0fine_fn;
+  Function fz1fine_fn;
+  Function fz2fine_fn;
+  Function fmm_55_2_fn;
+  Function fmm_56_2_fn;
+  Function fmm_3_fn;
+  Function fadcz0_fn;
+  Function fadcz1_fn;
+  Function fadcz2_fn;
+  Function fadcz0fine_fn;
+  Function fadcz1fine_fn;
+  Function fadcz2fine_fn;
+  Function fadcphi0_fn;
+  Function fadcphi0fine_fn;
+  Function fadcphi1_fn;
+  Function fadcphi1fine_fn;
+  Function fadcphi2_fn;
+  Function fadcphi2fine1_fn;
+  Function fadcphi2fine2_fn;
   double pitcherr_phi_mvtx;
   double pitcherr_z_mvtx;
 
@@ -9,6 +9,7 @@
 
 #include "TrkrDefs.h"
 
+#include <cstddef>
 #include <cstdint>  // for uint8_t, uint16_t, uint32_t
 
 /**
@@ -39,26 +40,42 @@ namespace InttDefs
   static const unsigned int kBitShiftCol __attribute__((unused)) = 16;
   static const unsigned int kBitShiftRow __attribute__((unused)) = 0;
 
+  static_assert(kBitShiftLadderZIdOffset + kBitShiftLadderZIdWidth == TrkrDefs::kBitShiftLayer, "ladder z id must be the bits below the layer");
+  static_assert(kBitShiftLadderPhiIdOffset + kBitShiftLadderPhiIdWidth == kBitShiftLadderZIdOffset, "ladder phi id must be the bits below the ladder z id");
+  static_assert(kBitShiftTimeBucketIdOffset + kBitShiftTimeBucketIdWidth == kBitShiftLadderPhiIdOffset, "time bucket must be the bits below the ladder phi id");
+  static_assert(2 * crossingOffset == (1 << kBitShiftTimeBucketIdWidth), "crossing offset must center the signed crossing in its bits");
+  static_assert(kBitShiftCol + 16 == 8 * sizeof(TrkrDefs::hitkey), "column must be the upper 16 bits of the hitkey");
+  static_assert(kBitShiftRow + 16 == kBitShiftCol, "row must be the lower 16 bits of the hitkey");
+
   /**
    * @brief Get the ladder id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] ladder id
    */
-  uint8_t getLadderZId(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getLadderZId(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>((key >> kBitShiftLadderZIdOffset) & ((1U << kBitShiftLadderZIdWidth) - 1));
+  }
 
   /**
    * @brief Get the ladder id from cluskey
    * @param[in] cluskey
    * @param[out] ladder id
    */
-  uint8_t getLadderZId(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getLadderZId(TrkrDefs::cluskey key)
+  {
+    return getLadderZId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the sensor id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] sensor id
    */
-  uint8_t getLadderPhiId(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getLadderPhiId(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>((key >> kBitShiftLadderPhiIdOffset) & ((1U << kBitShiftLadderPhiIdWidth) - 1));
+  }
 
   /**
    * @brief Get the sensor id from cluskey
@@ -66,7 +83,10 @@ namespace InttDefs
    * @param[out] sensor id
    */
 
-  uint8_t getLadderPhiId(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getLadderPhiId(TrkrDefs::cluskey key)
+  {
+    return getLadderPhiId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Generate a hitkey from a strip id
@@ -74,7 +94,11 @@ namespace InttDefs
    * @param[out] hitkey
    */
 
-  int getTimeBucketId(TrkrDefs::hitsetkey key);
+  inline constexpr int getTimeBucketId(TrkrDefs::hitsetkey key)
+  {
+    // get back to signed crossing
+    return static_cast<int>((key >> kBitShiftTimeBucketIdOffset) & ((1U << kBitShiftTimeBucketIdWidth) - 1)) - crossingOffset;
+  }
 
   /**
    * @brief Get the time bucket id from the hitsetkey
@@ -82,7 +106,10 @@ namespace InttDefs
    * @param[out] time bucket id
    */
 
-  int getTimeBucketId(TrkrDefs::cluskey key);
+  inline constexpr int getTimeBucketId(TrkrDefs::cluskey key)
+  {
+    return getTimeBucketId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the time bucket id from the cluskey
@@ -95,16 +122,25 @@ namespace InttDefs
    * @param[in] hitkey
    * @param[out] column index
    */
-  uint16_t getCol(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getCol(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftCol);
+  }
 
   /**
    * @brief Get the row index from hitkey
    * @param[in] hitkey
    * @param[out] row index
    */
-  uint16_t getRow(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getRow(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftRow);
+  }
 
-  TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row);
+  inline constexpr TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row)
+  {
+    return (static_cast<TrkrDefs::hitkey>(col) << kBitShiftCol) | (static_cast<TrkrDefs::hitkey>(row) << kBitShiftRow);
+  }
 
   /**
    * @brief Generate a hitsetkey for the intt
@@ -116,7 +152,23 @@ namespace InttDefs
    * Generate a hitsetkey for the intt. The tracker id is known
    * implicitly and used in the function.
    */
-  TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index, const int time_bucket);
+  inline constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index, const int time_bucket)
+  {
+    // offset crossing to make it positive, fit inside 10 bits
+    int ucrossing = time_bucket + crossingOffset;
+    if (ucrossing < 0)
+    {
+      ucrossing = 0;
+    }
+    if (ucrossing > 1023)
+    {
+      ucrossing = 1023;
+    }
+    return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::inttId, lyr) |
+           (static_cast<TrkrDefs::hitsetkey>(ladder_z_index) << kBitShiftLadderZIdOffset) |
+           (static_cast<TrkrDefs::hitsetkey>(ladder_phi_index) << kBitShiftLadderPhiIdOffset) |
+           (static_cast<TrkrDefs::hitsetkey>(ucrossing) << kBitShiftTimeBucketIdOffset);
+  }
 
   /**
    * @brief Generate a cluster key from indeces
@@ -127,14 +179,28 @@ namespace InttDefs
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-  TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index, const int crossing, const uint32_t clusid);
+  inline constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t ladder_z_index, const uint8_t ladder_phi_index, const int crossing, const uint32_t clusid)
+  {
+    return TrkrDefs::genClusKey(genHitSetKey(lyr, ladder_z_index, ladder_phi_index, crossing), clusid);
+  }
 
   /**
    * @brief Zero the crossing bits in a copy of the  hitsetkey
    * @param[in] hitsetkey
    * @param[out] hitsetkey
    */
-  TrkrDefs::hitsetkey resetCrossingHitSetKey(const TrkrDefs::hitsetkey hitsetkey);
+  inline constexpr TrkrDefs::hitsetkey resetCrossingHitSetKey(const TrkrDefs::hitsetkey hitsetkey)
+  {
+    // Note: this method uses the fact that the crossing is in the first 10 bits
+    // zero the crossing bits, then set the crossing 0
+    return ((hitsetkey >> kBitShiftTimeBucketIdWidth) << kBitShiftTimeBucketIdWidth) |
+           (static_cast<TrkrDefs::hitsetkey>(crossingOffset) << kBitShiftTimeBucketIdOffset);
+  }
+
+  /// decode n cluster keys at once, the loops are compiled in the library where they can be vectorized
+  void getLadderZId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* ladderZIds);
+  void getLadderPhiId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* ladderPhiIds);
+  void getTimeBucketId(const TrkrDefs::cluskey* keys, std::size_t n, int* timeBuckets);
 
 }  // namespace InttDefs
 
@@ -9,6 +9,7 @@
 
 #include "TrkrDefs.h"
 
+#include <cstddef>
 #include <cstdint>  // for uint8_t, uint16_t, uint32_t
 
 /**
@@ -43,61 +44,93 @@ namespace MvtxDefs
   static const uint16_t MAXCOL __attribute__((unused)) = 1024;
   static const uint16_t MAXROW __attribute__((unused)) = 512;
 
+  static_assert(kBitShiftStaveIdOffset + kBitShiftStaveIdWidth == TrkrDefs::kBitShiftLayer, "stave id must be the bits below the layer");
+  static_assert(kBitShiftChipIdOffset + kBitShiftChipIdWidth == kBitShiftStaveIdOffset, "chip id must be the bits below the stave id");
+  static_assert(kBitShiftStrobeIdOffset + kBitShiftStrobeIdWidth == kBitShiftChipIdOffset, "strobe id must be the bits below the chip id");
+  static_assert(2 * strobeOffset == (1 << kBitShiftStrobeIdWidth), "strobe offset must center the signed strobe in its bits");
+  static_assert(kBitShiftCol + 16 == 8 * sizeof(TrkrDefs::hitkey), "column must be the upper 16 bits of the hitkey");
+  static_assert(kBitShiftRow + 16 == kBitShiftCol, "row must be the lower 16 bits of the hitkey");
+
   /**
    * @brief Get the stave id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] stave id
    */
-  uint8_t getStaveId(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getStaveId(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>((key >> kBitShiftStaveIdOffset) & ((1U << kBitShiftStaveIdWidth) - 1));
+  }
 
   /**
    * @brief Get the stave id from cluskey
    * @param[in] cluskey
    * @param[out] stave id
    */
-  uint8_t getStaveId(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getStaveId(TrkrDefs::cluskey key)
+  {
+    return getStaveId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the chip id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] chip id
    */
-  uint8_t getChipId(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getChipId(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>((key >> kBitShiftChipIdOffset) & ((1U << kBitShiftChipIdWidth) - 1));
+  }
 
   /**
    * @brief Get the chip id from cluskey
    * @param[in] cluskey
    * @param[out] chip id
    */
-  uint8_t getChipId(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getChipId(TrkrDefs::cluskey key)
+  {
+    return getChipId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the chip id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] chip id
    */
-  int getStrobeId(TrkrDefs::hitsetkey key);
+  inline constexpr int getStrobeId(TrkrDefs::hitsetkey key)
+  {
+    // get back to the signed strobe
+    return static_cast<int>((key >> kBitShiftStrobeIdOffset) & ((1U << kBitShiftStrobeIdWidth) - 1)) - strobeOffset;
+  }
 
   /**
    * @brief Get the strobe id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] strobe id
    */
-  int getStrobeId(TrkrDefs::cluskey key);
+  inline constexpr int getStrobeId(TrkrDefs::cluskey key)
+  {
+    return getStrobeId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the strobe id from the cluskey
    * @param[in] cluskey
    * @param[out] strobe id
    */
-  uint16_t getCol(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getCol(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftCol);
+  }
 
   /**
    * @brief Get the row index from hitkey
    * @param[in] hitkey
    * @param[out] row index
    */
-  uint16_t getRow(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getRow(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftRow);
+  }
 
   /**
    * @brief Generate a hitkey from a pixels column and row index
@@ -105,7 +138,10 @@ namespace MvtxDefs
    * @param[in] row Row index
    * @param[out] hitkey
    */
-  TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row);
+  inline constexpr TrkrDefs::hitkey genHitKey(const uint16_t col, const uint16_t row)
+  {
+    return (static_cast<TrkrDefs::hitkey>(col) << kBitShiftCol) | (static_cast<TrkrDefs::hitkey>(row) << kBitShiftRow);
+  }
 
   /**
    * @brief Generate a hitsetkey for the mvtx
@@ -117,7 +153,23 @@ namespace MvtxDefs
    * Generate a hitsetkey for the mvtx. The tracker id is known
    * implicitly and used in the function.
    */
-  TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const int strobe);
+  inline constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const int strobe)
+  {
+    // offset strobe to make it positive, fit inside 5 bits
+    int ustrobe = strobe + strobeOffset;
+    if (ustrobe < 0)
+    {
+      ustrobe = 0;
+    }
+    if (ustrobe > 31)
+    {
+      ustrobe = 31;
+    }
+    return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::mvtxId, lyr) |
+           (static_cast<TrkrDefs::hitsetkey>(stave) << kBitShiftStaveIdOffset) |
+           (static_cast<TrkrDefs::hitsetkey>(chip) << kBitShiftChipIdOffset) |
+           (static_cast<TrkrDefs::hitsetkey>(ustrobe) << kBitShiftStrobeIdOffset);
+  }
 
   /**
    * @brief Generate a cluster key from indeces
@@ -128,14 +180,28 @@ namespace MvtxDefs
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-  TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const int strobe, const uint32_t clusid);
+  inline constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t stave, const uint8_t chip, const int strobe, const uint32_t clusid)
+  {
+    return TrkrDefs::genClusKey(genHitSetKey(lyr, stave, chip, strobe), clusid);
+  }
 
   /**
    * @brief Zero the strobe bits in the hitsetkey
    * @param[in] hskey hitsetkey
    * @param[out] hitsetkey with strobe bits set to zero
    */
-  TrkrDefs::hitsetkey resetStrobeHitSetKey(const TrkrDefs::hitsetkey hitsetkey);
+  inline constexpr TrkrDefs::hitsetkey resetStrobeHitSetKey(const TrkrDefs::hitsetkey hitsetkey)
+  {
+    // Note: this method uses the fact that the strobe is in the first 5 bits
+    // zero the strobe bits, then set the strobe 0
+    return ((hitsetkey >> kBitShiftStrobeIdWidth) << kBitShiftStrobeIdWidth) |
+           (static_cast<TrkrDefs::hitsetkey>(strobeOffset) << kBitShiftStrobeIdOffset);
+  }
+
+  /// decode n cluster keys at once, the loops are compiled in the library where they can be vectorized
+  void getStaveId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* staves);
+  void getChipId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* chips);
+  void getStrobeId(const TrkrDefs::cluskey* keys, std::size_t n, int* strobes);
 
 }  // namespace MvtxDefs
 
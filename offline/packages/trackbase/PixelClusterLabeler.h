@@ -0,0 +1,121 @@
+#ifndef TRACKBASE_PIXELCLUSTERLABELER_H
+#define TRACKBASE_PIXELCLUSTERLABELER_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+//! connected groups of adjacent pixels or strips of one sensor
+/*!
+  Pixels are given as (major, minor) index pairs. Two pixels are adjacent if their minor
+  indices differ by at most one and their major indices are equal, or differ by at most
+  one if cross_major is set.
+
+  The pixels are sorted and each pixel is only compared with its predecessors in its own
+  and the previous major index, joined with a union-find. This is linear up to the sort,
+  instead of testing all pairs as a boost graph does.
+
+  Clusters are numbered in order of their first pixel, the same numbering as
+  boost::connected_components, so cluster keys do not depend on the algorithm.
+
+  The buffers are kept between calls, use one labeler per thread.
+*/
+class PixelClusterLabeler
+{
+ public:
+  using Pixel = std::pair<int, int>;
+
+  //! cluster index of each pixel, returns the number of clusters
+  int label(const std::vector<Pixel> &pixels, const bool cross_major, std::vector<int> &component)
+  {
+    const unsigned int npixels = pixels.size();
+    m_order.resize(npixels);
+    m_parent.resize(npixels);
+    for (unsigned int i = 0; i < npixels; ++i)
+    {
+      m_order[i] = i;
+      m_parent[i] = i;
+    }
+    std::sort(m_order.begin(), m_order.end(), [&pixels](const unsigned int lhs, const unsigned int rhs)
+              { return pixels[lhs] < pixels[rhs]; });
+
+    // range of the previous and first pixel of the current major index in sorted order
+    unsigned int prev_first = 0;
+    unsigned int prev_end = 0;
+    unsigned int cur_first = 0;
+    // first pixel of the previous major index that can still touch the current one
+    unsigned int prev_pos = 0;
+    for (unsigned int k = 0; k < npixels; ++k)
+    {
+      const auto &[major, minor] = pixels[m_order[k]];
+      if (k > 0 && pixels[m_order[k - 1]].first != major)
+      {
+        prev_first = cur_first;
+        prev_end = k;
+        cur_first = k;
+        prev_pos = prev_first;
+      }
+
+      // same major index, minor indices are sorted
+      for (unsigned int m = k; m > cur_first && pixels[m_order[m - 1]].second >= minor - 1; --m)
+      {
+        unite(m_order[k], m_order[m - 1]);
+      }
+
+      // previous major index, minor indices within one
+      if (cross_major && prev_end > prev_first && pixels[m_order[prev_first]].first == major - 1)
+      {
+        while (prev_pos < prev_end && pixels[m_order[prev_pos]].second < minor - 1)
+        {
+          ++prev_pos;
+        }
+        for (unsigned int m = prev_pos; m < prev_end && pixels[m_order[m]].second <= minor + 1; ++m)
+        {
+          unite(m_order[k], m_order[m]);
+        }
+      }
+    }
+
+    // the root is the smallest index of each group, number groups in order of their root
+    m_label.assign(npixels, -1);
+    component.resize(npixels);
+    int nclusters = 0;
+    for (unsigned int i = 0; i < npixels; ++i)
+    {
+      const unsigned int root = find_root(i);
+      if (m_label[root] < 0)
+      {
+        m_label[root] = nclusters++;
+      }
+      component[i] = m_label[root];
+    }
+    return nclusters;
+  }
+
+ private:
+  unsigned int find_root(unsigned int i)
+  {
+    while (m_parent[i] != i)
+    {
+      m_parent[i] = m_parent[m_parent[i]];
+      i = m_parent[i];
+    }
+    return i;
+  }
+
+  void unite(const unsigned int i, const unsigned int j)
+  {
+    const unsigned int ri = find_root(i);
+    const unsigned int rj = find_root(j);
+    if (ri != rj)
+    {
+      m_parent[std::max(ri, rj)] = std::min(ri, rj);
+    }
+  }
+
+  std::vector<unsigned int> m_order;
+  std::vector<unsigned int> m_parent;
+  std::vector<int> m_label;
+};
+
+#endif  // TRACKBASE_PIXELCLUSTERLABELER_H
@@ -8,71 +8,34 @@
 
 #include "TrkrDefs.h"  // for hitsetkey, cluskey, hitkey, kBitShif...
 
-uint8_t
-TpcDefs::getSectorId(TrkrDefs::hitsetkey key)
+void TpcDefs::getSectorId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* sectors)
 {
-  TrkrDefs::hitsetkey tmp = (key >> TpcDefs::kBitShiftSectorId);
-  return tmp;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    sectors[i] = getSectorId(keys[i]);
+  }
 }
 
-uint8_t
-TpcDefs::getSectorId(TrkrDefs::cluskey key)
+void TpcDefs::getSide(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* sides)
 {
-  TrkrDefs::hitsetkey tmp = (key >> TrkrDefs::kBitShiftClusId);
-  return getSectorId(tmp);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    sides[i] = getSide(keys[i]);
+  }
 }
 
-uint8_t
-TpcDefs::getSide(TrkrDefs::hitsetkey key)
+void TpcDefs::getPad(const TrkrDefs::hitkey* keys, std::size_t n, uint16_t* pads)
 {
-  TrkrDefs::hitsetkey tmp = (key >> TpcDefs::kBitShiftSide);
-  return tmp;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    pads[i] = getPad(keys[i]);
+  }
 }
 
-uint8_t
-TpcDefs::getSide(TrkrDefs::cluskey key)
+void TpcDefs::getTBin(const TrkrDefs::hitkey* keys, std::size_t n, uint16_t* tbins)
 {
-  TrkrDefs::hitsetkey tmp = (key >> TrkrDefs::kBitShiftClusId);
-  return getSide(tmp);
-}
-
-uint16_t
-TpcDefs::getPad(TrkrDefs::hitkey key)
-{
-  TrkrDefs::hitkey tmp = (key >> TpcDefs::kBitShiftPad);
-  return tmp;
-}
-
-uint16_t
-TpcDefs::getTBin(TrkrDefs::hitkey key)
-{
-  TrkrDefs::hitkey tmp = (key >> TpcDefs::kBitShiftTBin);
-  return tmp;
-}
-
-TrkrDefs::hitkey
-TpcDefs::genHitKey(const uint16_t pad, const uint16_t tbin)
-{
-  TrkrDefs::hitkey key = (pad << TpcDefs::kBitShiftPad);
-  TrkrDefs::hitkey tmp = (tbin << TpcDefs::kBitShiftTBin);
-  key |= tmp;
-  return key;
-}
-
-TrkrDefs::hitsetkey
-TpcDefs::genHitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side)
-{
-  TrkrDefs::hitsetkey key = TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::tpcId, lyr);
-  TrkrDefs::hitsetkey tmp = sector;
-  key |= (tmp << TpcDefs::kBitShiftSectorId);
-  tmp = side;
-  key |= (tmp << TpcDefs::kBitShiftSide);
-  return key;
-}
-
-TrkrDefs::cluskey
-TpcDefs::genClusKey(const uint8_t lyr, const uint8_t sector, const uint8_t side, const uint32_t clusid)
-{
-  const auto key = genHitSetKey(lyr, sector, side);
-  return TrkrDefs::genClusKey(key, clusid);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    tbins[i] = getTBin(keys[i]);
+  }
 }
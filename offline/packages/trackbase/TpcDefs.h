@@ -9,6 +9,7 @@
 
 #include "TrkrDefs.h"
 
+#include <cstddef>
 #include <cstdint>  // for uint8_t, uint16_t, uint32_t
 
 /**
@@ -49,47 +50,70 @@ namespace TpcDefs
   static const uint16_t MAXPAD __attribute__((unused)) = 1024;
   static const uint16_t MAXTBIN __attribute__((unused)) = 512;
 
+  static_assert(kBitShiftSectorId + 8 == TrkrDefs::kBitShiftLayer, "sector id must be the 8 bits below the layer");
+  static_assert(kBitShiftSide + 8 == kBitShiftSectorId, "side must be the 8 bits below the sector id");
+  static_assert(kBitShiftPad + 16 == 8 * sizeof(TrkrDefs::hitkey), "pad must be the upper 16 bits of the hitkey");
+  static_assert(kBitShiftTBin + 16 == kBitShiftPad, "time bin must be the lower 16 bits of the hitkey");
+
   /**
    * @brief Get the sector id from hitsetkey
    * @param[in] hitsetkey
    * @param[out] sector id
    */
-  uint8_t getSectorId(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getSectorId(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>(key >> kBitShiftSectorId);
+  }
 
   /**
    * @brief Get the sector id from cluskey
    * @param[in] cluskey
    * @param[out] sector id
    */
-  uint8_t getSectorId(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getSectorId(TrkrDefs::cluskey key)
+  {
+    return getSectorId(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the side from hitsetkey
    * @param[in] hitsetkey
    * @param[out] side
    */
-  uint8_t getSide(TrkrDefs::hitsetkey key);
+  inline constexpr uint8_t getSide(TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>(key >> kBitShiftSide);
+  }
 
   /**
    * @brief Get the side id from cluskey
    * @param[in] cluskey
    * @param[out] side id
    */
-  uint8_t getSide(TrkrDefs::cluskey key);
+  inline constexpr uint8_t getSide(TrkrDefs::cluskey key)
+  {
+    return getSide(static_cast<TrkrDefs::hitsetkey>(key >> TrkrDefs::kBitShiftClusId));
+  }
 
   /**
    * @brief Get the pad index from hitkey
    * @param[in] hitkey
    * @param[out] pad index
    */
-  uint16_t getPad(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getPad(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftPad);
+  }
 
   /**
    * @brief Get the time bin from hitkey
    * @param[in] hitkey
    * @param[out] time bin
    */
-  uint16_t getTBin(TrkrDefs::hitkey key);
+  inline constexpr uint16_t getTBin(TrkrDefs::hitkey key)
+  {
+    return static_cast<uint16_t>(key >> kBitShiftTBin);
+  }
 
   /**
    * @brief Generate a hitkey from a pad index and time bin
@@ -97,7 +121,10 @@ namespace TpcDefs
    * @param[in] tbin Time bin
    * @param[out] hitkey
    */
-  TrkrDefs::hitkey genHitKey(const uint16_t pad, const uint16_t tbin);
+  inline constexpr TrkrDefs::hitkey genHitKey(const uint16_t pad, const uint16_t tbin)
+  {
+    return (static_cast<TrkrDefs::hitkey>(pad) << kBitShiftPad) | (static_cast<TrkrDefs::hitkey>(tbin) << kBitShiftTBin);
+  }
 
   /**
    * @brief Generate a hitsetkey for the tpc
@@ -109,7 +136,12 @@ namespace TpcDefs
    * Generate a hitsetkey for the tpc. The tracker id is known
    * implicitly and used in the function.
    */
-  TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side);
+  inline constexpr TrkrDefs::hitsetkey genHitSetKey(const uint8_t lyr, const uint8_t sector, const uint8_t side)
+  {
+    return TrkrDefs::genHitSetKey(TrkrDefs::TrkrId::tpcId, lyr) |
+           (static_cast<TrkrDefs::hitsetkey>(sector) << kBitShiftSectorId) |
+           (static_cast<TrkrDefs::hitsetkey>(side) << kBitShiftSide);
+  }
 
   /**
    * @brief Generate a cluster key from indeces
@@ -119,7 +151,16 @@ namespace TpcDefs
    * @param[in] clusid Cluster id
    * @param[out] cluskey
    */
-  TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t sector, const uint8_t side, const uint32_t clusid);
+  inline constexpr TrkrDefs::cluskey genClusKey(const uint8_t lyr, const uint8_t sector, const uint8_t side, const uint32_t clusid)
+  {
+    return TrkrDefs::genClusKey(genHitSetKey(lyr, sector, side), clusid);
+  }
+
+  /// decode n keys at once, the loops are compiled in the library where they can be vectorized
+  void getSectorId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* sectors);
+  void getSide(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* sides);
+  void getPad(const TrkrDefs::hitkey* keys, std::size_t n, uint16_t* pads);
+  void getTBin(const TrkrDefs::hitkey* keys, std::size_t n, uint16_t* tbins);
 
 }  // namespace TpcDefs
 
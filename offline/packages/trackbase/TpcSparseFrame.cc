@@ -0,0 +1,40 @@
+#include "TpcSparseFrame.h"
+
+#include <algorithm>
+
+void TpcSparseFrame::sort()
+{
+  auto before = [](const Run &lhs, const Run &rhs)
+  { return (lhs.pad < rhs.pad) || (lhs.pad == rhs.pad && lhs.tbin < rhs.tbin); };
+
+  // the unpacker fills pad by pad, so this is usually a no-op
+  if (!std::is_sorted(m_runs.begin(), m_runs.end(), before))
+  {
+    std::stable_sort(m_runs.begin(), m_runs.end(), before);
+  }
+
+  // trim time bins already covered by the previous run of the same pad
+  size_t nkept = 0;
+  for (size_t i = 0; i < m_runs.size(); ++i)
+  {
+    Run run = m_runs[i];
+    if (nkept > 0)
+    {
+      const Run &last = m_runs[nkept - 1];
+      const unsigned int last_end = last.tbin + last.length;
+      if (last.pad == run.pad && run.tbin < last_end)
+      {
+        if (last_end - run.tbin >= run.length)
+        {
+          continue;
+        }
+        const uint16_t skip = last_end - run.tbin;
+        run.tbin += skip;
+        run.offset += skip;
+        run.length -= skip;
+      }
+    }
+    m_runs[nkept++] = run;
+  }
+  m_runs.resize(nkept);
+}
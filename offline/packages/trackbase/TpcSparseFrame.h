@@ -0,0 +1,79 @@
+#ifndef TRACKBASE_TPCSPARSEFRAME_H
+#define TRACKBASE_TPCSPARSEFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//! zero suppressed ADCs of one TPC readout (layer, sector, side)
+/*!
+  The ADCs above threshold are stored as runs of consecutive time bins of one pad.
+  After sort() the runs are pad major and ordered in time, the same order as the
+  TPC hit keys, so for_each_hit visits the hits like a loop over a TrkrHitSet.
+
+  Pads are local to the frame, get_pad_start() gives the global pad of pad 0.
+*/
+class TpcSparseFrame
+{
+ public:
+  struct Run
+  {
+    uint16_t pad{0};
+    uint16_t tbin{0};
+    uint16_t length{0};
+    uint32_t offset{0};  // of the first ADC in get_adcs()
+  };
+
+  //! remove all runs, keeps the allocation
+  void clear()
+  {
+    m_runs.clear();
+    m_adcs.clear();
+  }
+
+  bool empty() const { return m_runs.empty(); }
+
+  uint16_t get_pad_start() const { return m_pad_start; }
+  void set_pad_start(const uint16_t pad) { m_pad_start = pad; }
+
+  //! number of stored ADCs
+  size_t size() const { return m_adcs.size(); }
+
+  //! append length ADCs of local pad, starting at tbin
+  void add_run(const uint16_t pad, const uint16_t tbin, const uint16_t *adcs, const uint16_t length)
+  {
+    if (length == 0)
+    {
+      return;
+    }
+    m_runs.push_back({pad, tbin, length, static_cast<uint32_t>(m_adcs.size())});
+    m_adcs.insert(m_adcs.end(), adcs, adcs + length);
+  }
+
+  //! order the runs by pad and time bin, time bins already covered by an earlier run of the pad are removed
+  void sort();
+
+  const std::vector<Run> &get_runs() const { return m_runs; }
+  const std::vector<uint16_t> &get_adcs() const { return m_adcs; }
+
+  //! call f(global pad, tbin, adc) for all stored ADCs
+  template <class F>
+  void for_each_hit(F &&f) const
+  {
+    for (const auto &run : m_runs)
+    {
+      const uint16_t *adcs = m_adcs.data() + run.offset;
+      for (uint16_t i = 0; i < run.length; ++i)
+      {
+        f(static_cast<uint16_t>(m_pad_start + run.pad), static_cast<uint16_t>(run.tbin + i), adcs[i]);
+      }
+    }
+  }
+
+ private:
+  uint16_t m_pad_start{0};
+  std::vector<Run> m_runs;
+  std::vector<uint16_t> m_adcs;
+};
+
+#endif  // TRACKBASE_TPCSPARSEFRAME_H
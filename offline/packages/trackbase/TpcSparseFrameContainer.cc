@@ -0,0 +1,30 @@
+#include "TpcSparseFrameContainer.h"
+
+void TpcSparseFrameContainer::Reset()
+{
+  for (auto &[key, frame] : m_frames)
+  {
+    frame.clear();
+  }
+}
+
+void TpcSparseFrameContainer::sort()
+{
+  for (auto &[key, frame] : m_frames)
+  {
+    frame.sort();
+  }
+}
+
+unsigned int TpcSparseFrameContainer::size() const
+{
+  unsigned int nframes = 0;
+  for (const auto &[key, frame] : m_frames)
+  {
+    if (!frame.empty())
+    {
+      ++nframes;
+    }
+  }
+  return nframes;
+}
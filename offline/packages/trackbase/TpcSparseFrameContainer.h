@@ -0,0 +1,42 @@
+#ifndef TRACKBASE_TPCSPARSEFRAMECONTAINER_H
+#define TRACKBASE_TPCSPARSEFRAMECONTAINER_H
+
+#include "TpcSparseFrame.h"
+#include "TrkrDefs.h"
+
+#include <map>
+
+//! transient zero suppressed TPC data, one TpcSparseFrame per hitset key
+/*!
+  Filled by TpcCombinedRawDataUnpacker and read by the TPC clusterizers, stored
+  on the node tree as PHDataNode (not written out).
+
+  Frames are kept between events and only cleared, so their buffers are reused.
+  Consumers skip empty frames.
+*/
+class TpcSparseFrameContainer
+{
+ public:
+  using Map = std::map<TrkrDefs::hitsetkey, TpcSparseFrame>;
+  using ConstIterator = Map::const_iterator;
+
+  //! clear all frames
+  void Reset();
+
+  //! find or add the frame of a hitset
+  TpcSparseFrame &findOrAddFrame(const TrkrDefs::hitsetkey key) { return m_frames[key]; }
+
+  //! sort the runs of all frames, to be called once the frames are filled
+  void sort();
+
+  //! number of non empty frames
+  unsigned int size() const;
+
+  ConstIterator begin() const { return m_frames.begin(); }
+  ConstIterator end() const { return m_frames.end(); }
+
+ private:
+  Map m_frames;
+};
+
+#endif  // TRACKBASE_TPCSPARSEFRAMECONTAINER_H
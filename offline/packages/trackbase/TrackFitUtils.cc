@@ -24,6 +24,181 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  //! true for the clusters used in the z line fit, INTT strip z positions are too coarse
+  inline bool use_in_line_fit(const TrkrDefs::cluskey key)
+  {
+    return TrkrDefs::getTrkrId(key) != TrkrDefs::inttId and key != 0;
+  }
+
+  // the fit kernels take the number of points and an accessor point(i) returning (x, y),
+  // so that every input layout is fitted in place and gives the same result, without copies
+
+  //! Taubin circle fit, see circle_fit_by_taubin
+  template <class F>
+  TrackFitUtils::circle_fit_output_t taubin_kernel(const size_t npoints, F&& point)
+  {
+    // Compute x- and y- sample means
+    double meanX = 0;
+    double meanY = 0;
+    double weight = 0;
+
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      const auto [x, y] = point(i);
+      meanX += x;
+      meanY += y;
+      ++weight;
+    }
+    meanX /= weight;
+    meanY /= weight;
+
+    //     computing moments
+
+    double Mxx = 0;
+    double Myy = 0;
+    double Mxy = 0;
+    double Mxz = 0;
+    double Myz = 0;
+    double Mzz = 0;
+
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      const auto [x, y] = point(i);
+      double Xi = x - meanX;  //  centered x-coordinates
+      double Yi = y - meanY;  //  centered y-coordinates
+      double Zi = square(Xi) + square(Yi);
+
+      Mxy += Xi * Yi;
+      Mxx += Xi * Xi;
+      Myy += Yi * Yi;
+      Mxz += Xi * Zi;
+      Myz += Yi * Zi;
+      Mzz += Zi * Zi;
+    }
+    Mxx /= weight;
+    Myy /= weight;
+    Mxy /= weight;
+    Mxz /= weight;
+    Myz /= weight;
+    Mzz /= weight;
+
+    //  computing coefficients of the characteristic polynomial
+
+    const double Mz = Mxx + Myy;
+    const double Cov_xy = Mxx * Myy - Mxy * Mxy;
+    const double Var_z = Mzz - Mz * Mz;
+    const double A3 = 4 * Mz;
+    const double A2 = -3 * Mz * Mz - Mzz;
+    const double A1 = Var_z * Mz + 4 * Cov_xy * Mz - Mxz * Mxz - Myz * Myz;
+    const double A0 = Mxz * (Mxz * Myy - Myz * Mxy) + Myz * (Myz * Mxx - Mxz * Mxy) - Var_z * Cov_xy;
+    const double A22 = A2 + A2;
+    const double A33 = A3 + A3 + A3;
+
+    //    finding the root of the characteristic polynomial
+    //    using Newton's method starting at x=0
+    //    (it is guaranteed to converge to the right root)
+    static constexpr int iter_max = 99;
+    double x = 0;
+    double y = A0;
+
+    // usually, 4-6 iterations are enough
+    for (int iter = 0; iter < iter_max; ++iter)
+    {
+      const double Dy = A1 + x * (A22 + A33 * x);
+      const double xnew = x - y / Dy;
+      if ((xnew == x) || (!std::isfinite(xnew)))
+      {
+        break;
+      }
+
+      const double ynew = A0 + xnew * (A1 + xnew * (A2 + xnew * A3));
+      if (std::abs(ynew) >= std::abs(y))
+      {
+        break;
+      }
+
+      x = xnew;
+      y = ynew;
+    }
+
+    //  computing parameters of the fitting circle
+    const double DET = square(x) - x * Mz + Cov_xy;
+    const double Xcenter = (Mxz * (Myy - x) - Myz * Mxy) / DET / 2;
+    const double Ycenter = (Myz * (Mxx - x) - Mxz * Mxy) / DET / 2;
+
+    //  assembling the output
+    double X0 = Xcenter + meanX;
+    double Y0 = Ycenter + meanY;
+    double R = std::sqrt(square(Xcenter) + square(Ycenter) + Mz);
+    return std::make_tuple(R, X0, Y0);
+  }
+
+  //! Deming line fit, see line_fit. Only the points with accept(i) true are used
+  template <class F, class A>
+  TrackFitUtils::line_fit_output_t deming_kernel(const size_t npoints, F&& point, A&& accept)
+  {
+    // get the mean values
+    double xmean = 0.;
+    double ymean = 0.;
+    double n = 0;
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      if (!accept(i))
+      {
+        continue;
+      }
+      const auto [x, y] = point(i);
+      xmean = xmean + x;
+      ymean = ymean + y;
+      ++n;
+    }
+    xmean /= n;
+    ymean /= n;
+
+    // calculate the standard deviations
+    double ssd_x = 0.;
+    double ssd_y = 0.;
+    double ssd_xy = 0.;
+    for (size_t i = 0; i < npoints; ++i)
+    {
+      if (!accept(i))
+      {
+        continue;
+      }
+      const auto [x, y] = point(i);
+      ssd_x += square(x - xmean);
+      ssd_y += square(y - ymean);
+      ssd_xy += (x - xmean) * (y - ymean);
+    }
+    const double slope = (ssd_y - ssd_x + sqrt(square(ssd_y - ssd_x) + 4 * square(ssd_xy))) / 2. / ssd_xy;
+    const double intercept = ymean - slope * xmean;
+    return std::make_tuple(slope, intercept);
+  }
+
+  //! Deming line fit of all points
+  template <class F>
+  TrackFitUtils::line_fit_output_t deming_kernel(const size_t npoints, F&& point)
+  {
+    return deming_kernel(npoints, std::forward<F>(point), [](size_t) { return true; });
+  }
+
+  //! accessors of a vector of 3D positions
+  inline auto xy_of(const std::vector<Acts::Vector3>& positions)
+  {
+    return [&positions](size_t i) { return TrackFitUtils::position_t(positions[i].x(), positions[i].y()); };
+  }
+
+  inline auto xz_of(const std::vector<Acts::Vector3>& positions)
+  {
+    return [&positions](size_t i) { return TrackFitUtils::position_t(positions[i].x(), positions[i].z()); };
+  }
+
+  inline auto rz_of(const std::vector<Acts::Vector3>& positions)
+  {
+    return [&positions](size_t i) { return TrackFitUtils::position_t(std::sqrt(square(positions[i].x()) + square(positions[i].y())), positions[i].z()); };
+  }
+
 }  // namespace
 
 std::pair<Acts::Vector3, Acts::Vector3> TrackFitUtils::get_helix_tangent(const std::vector<float>& fitpars, Acts::Vector3& global)
@@ -116,180 +291,77 @@ Acts::Vector3 TrackFitUtils::surface_3Dline_intersection(const TrkrDefs::cluskey
 //_________________________________________________________________________________
 TrackFitUtils::circle_fit_output_t TrackFitUtils::circle_fit_by_taubin(const TrackFitUtils::position_vector_t& positions)
 {
-  // Compute x- and y- sample means
-  double meanX = 0;
-  double meanY = 0;
-  double weight = 0;
-
-  for (const auto& [x, y] : positions)
-  {
-    meanX += x;
-    meanY += y;
-    ++weight;
-  }
-  meanX /= weight;
-  meanY /= weight;
-
-  //     computing moments
-
-  double Mxx = 0;
-  double Myy = 0;
-  double Mxy = 0;
-  double Mxz = 0;
-  double Myz = 0;
-  double Mzz = 0;
-
-  for (auto& [x, y] : positions)
-  {
-    double Xi = x - meanX;  //  centered x-coordinates
-    double Yi = y - meanY;  //  centered y-coordinates
-    double Zi = square(Xi) + square(Yi);
-
-    Mxy += Xi * Yi;
-    Mxx += Xi * Xi;
-    Myy += Yi * Yi;
-    Mxz += Xi * Zi;
-    Myz += Yi * Zi;
-    Mzz += Zi * Zi;
-  }
-  Mxx /= weight;
-  Myy /= weight;
-  Mxy /= weight;
-  Mxz /= weight;
-  Myz /= weight;
-  Mzz /= weight;
-
-  //  computing coefficients of the characteristic polynomial
-
-  const double Mz = Mxx + Myy;
-  const double Cov_xy = Mxx * Myy - Mxy * Mxy;
-  const double Var_z = Mzz - Mz * Mz;
-  const double A3 = 4 * Mz;
-  const double A2 = -3 * Mz * Mz - Mzz;
-  const double A1 = Var_z * Mz + 4 * Cov_xy * Mz - Mxz * Mxz - Myz * Myz;
-  const double A0 = Mxz * (Mxz * Myy - Myz * Mxy) + Myz * (Myz * Mxx - Mxz * Mxy) - Var_z * Cov_xy;
-  const double A22 = A2 + A2;
-  const double A33 = A3 + A3 + A3;
-
-  //    finding the root of the characteristic polynomial
-  //    using Newton's method starting at x=0
-  //    (it is guaranteed to converge to the right root)
-  static constexpr int iter_max = 99;
-  double x = 0;
-  double y = A0;
-
-  // usually, 4-6 iterations are enough
-  for (int iter = 0; iter < iter_max; ++iter)
-  {
-    const double Dy = A1 + x * (A22 + A33 * x);
-    const double xnew = x - y / Dy;
-    if ((xnew == x) || (!std::isfinite(xnew)))
-    {
-      break;
-    }
-
-    const double ynew = A0 + xnew * (A1 + xnew * (A2 + xnew * A3));
-    if (std::abs(ynew) >= std::abs(y))
-    {
-      break;
-    }
-
-    x = xnew;
-    y = ynew;
-  }
+  return taubin_kernel(positions.size(), [&positions](size_t i) { return positions[i]; });
+}
 
-  //  computing parameters of the fitting circle
-  const double DET = square(x) - x * Mz + Cov_xy;
-  const double Xcenter = (Mxz * (Myy - x) - Myz * Mxy) / DET / 2;
-  const double Ycenter = (Myz * (Mxx - x) - Mxz * Mxy) / DET / 2;
+//_________________________________________________________________________________
+TrackFitUtils::circle_fit_output_t TrackFitUtils::circle_fit_by_taubin(const std::vector<Acts::Vector3>& positions)
+{
+  return taubin_kernel(positions.size(), xy_of(positions));
+}
 
-  //  assembling the output
-  double X0 = Xcenter + meanX;
-  double Y0 = Ycenter + meanY;
-  double R = std::sqrt(square(Xcenter) + square(Ycenter) + Mz);
-  return std::make_tuple(R, X0, Y0);
+//_________________________________________________________________________________
+TrackFitUtils::circle_fit_output_t TrackFitUtils::circle_fit_by_taubin(const double* x, const double* y, size_t npoints)
+{
+  return taubin_kernel(npoints, [x, y](size_t i) { return position_t(x[i], y[i]); });
 }
 
 //_________________________________________________________________________________
-TrackFitUtils::circle_fit_output_t TrackFitUtils::circle_fit_by_taubin(const std::vector<Acts::Vector3>& positions)
+void TrackFitUtils::circle_fit_by_taubin(const std::vector<double>& x, const std::vector<double>& y,
+                                         const std::vector<size_t>& offsets, std::vector<circle_fit_output_t>& output)
 {
-  position_vector_t positions_2d;
-  for (const auto& position : positions)
+  output.resize(offsets.empty() ? 0 : offsets.size() - 1);
+  for (size_t iseed = 0; iseed < output.size(); ++iseed)
   {
-    positions_2d.emplace_back(position.x(), position.y());
+    output[iseed] = circle_fit_by_taubin(x.data() + offsets[iseed], y.data() + offsets[iseed], offsets[iseed + 1] - offsets[iseed]);
   }
-
-  return circle_fit_by_taubin(positions_2d);
 }
 
-
 //_________________________________________________________________________________
 TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit(const TrackFitUtils::position_vector_t& positions)
 {
   // calculate the best line fit to an array of x and y points,
-  // which minimizing the square of the distances orthogonally 
+  // which minimizing the square of the distances orthogonally
   // from the points to the line. Assume that the variances of x and y
   //  are equal (this is the Deming method)
-    // get the mean values
-    double xmean = 0.;
-    double ymean = 0.;
-    for (const auto& [x, y] : positions)
-    {
-      xmean = xmean + x;
-      ymean = ymean + y;
-    }
-    double n = positions.size();
-    xmean /= n;
-    ymean /= n;
-
-    // calculate the standard deviations
-    double ssd_x = 0.;
-    double ssd_y = 0.;
-    double ssd_xy = 0.;
-    for (const auto& [x, y] : positions) {
-      ssd_x += square(x-xmean);
-      ssd_y += square(y-ymean);
-      ssd_xy += (x-xmean)*(y-ymean);
-    }
-    const double slope = (ssd_y-ssd_x+sqrt(square(ssd_y-ssd_x)+4*square(ssd_xy)))/2./ssd_xy;
-    const double intercept = ymean - slope * xmean;
-    return std::make_tuple(slope, intercept);
+  return deming_kernel(positions.size(), [&positions](size_t i) { return positions[i]; });
 }
 
 //_________________________________________________________________________________
 TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit(const std::vector<Acts::Vector3>& positions)
 {
-  position_vector_t positions_2d;
-  for (const auto& position : positions)
-  {
-    positions_2d.emplace_back(std::sqrt(square(position.x()) + square(position.y())), position.z());
-  }
+  return deming_kernel(positions.size(), rz_of(positions));
+}
 
-  return line_fit(positions_2d);
+//_________________________________________________________________________________
+TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit(const double* x, const double* y, size_t npoints)
+{
+  return deming_kernel(npoints, [x, y](size_t i) { return position_t(x[i], y[i]); });
 }
 
 //_________________________________________________________________________________
-TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit_xz(const std::vector<Acts::Vector3>& positions)
+void TrackFitUtils::line_fit(const std::vector<double>& x, const std::vector<double>& y,
+                             const std::vector<size_t>& offsets, std::vector<line_fit_output_t>& output)
 {
-  position_vector_t positions_2d;
-  for (const auto& position : positions)
+  output.resize(offsets.empty() ? 0 : offsets.size() - 1);
+  for (size_t iseed = 0; iseed < output.size(); ++iseed)
   {
-    positions_2d.emplace_back(position.x(), position.z());  // returns dx/dz and z intercept
+    output[iseed] = line_fit(x.data() + offsets[iseed], y.data() + offsets[iseed], offsets[iseed + 1] - offsets[iseed]);
   }
+}
 
-  return line_fit(positions_2d);
+//_________________________________________________________________________________
+TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit_xz(const std::vector<Acts::Vector3>& positions)
+{
+  // returns dx/dz and z intercept
+  return deming_kernel(positions.size(), xz_of(positions));
 }
 
 //_________________________________________________________________________________
 TrackFitUtils::line_fit_output_t TrackFitUtils::line_fit_xy(const std::vector<Acts::Vector3>& positions)
 {
-  position_vector_t positions_2d;
-  for (const auto& position : positions)
-  {
-    positions_2d.emplace_back(position.x(), position.y());   // returns dx/dy and y intercept
-  }
-
-  return line_fit(positions_2d);
+  // returns dx/dy and y intercept
+  return deming_kernel(positions.size(), xy_of(positions));
 }
 
 //_________________________________________________________________________________
@@ -600,8 +672,8 @@ Acts::Vector2 TrackFitUtils::get_circle_point_pca(float radius, float x0, float
 }
 
 //_________________________________________________________________________________
-std::vector<float> TrackFitUtils::fitClusters(std::vector<Acts::Vector3>& global_vec,
-                                              std::vector<TrkrDefs::cluskey> cluskey_vec,
+std::vector<float> TrackFitUtils::fitClusters(const std::vector<Acts::Vector3>& global_vec,
+                                              const std::vector<TrkrDefs::cluskey>& cluskey_vec,
                                               bool use_intt)
 {
   std::vector<float> fitpars;
@@ -614,27 +686,21 @@ std::vector<float> TrackFitUtils::fitClusters(std::vector<Acts::Vector3>& global
   std::tuple<double, double, double> circle_fit_pars = TrackFitUtils::circle_fit_by_taubin(global_vec);
 
   // It is problematic that the large errors on the INTT strip z values are not allowed for - drop the INTT from the z line fit
-  std::vector<Acts::Vector3> global_vec_noINTT;
+  // the clusters are selected in place rather than copied
+  const auto accept = [&cluskey_vec, use_intt](size_t ivec)
+  { return use_intt || use_in_line_fit(cluskey_vec[ivec]); };
+  unsigned int nline = 0;
   for (unsigned int ivec = 0; ivec < global_vec.size(); ++ivec)
   {
-    unsigned int trkrid = TrkrDefs::getTrkrId(cluskey_vec[ivec]);
-
-    if (trkrid != TrkrDefs::inttId and cluskey_vec[ivec] != 0)
-    {
-      global_vec_noINTT.push_back(global_vec[ivec]);
-    }
+    nline += accept(ivec);
   }
-  //  std::cout << " use_intt = " << use_intt << std::endl;
-  if(use_intt)
-    {
-      global_vec_noINTT = global_vec;
-    }
-  if (global_vec_noINTT.size() < 3)
+  if (nline < 3)
     {
       return fitpars;
     }
-  std::tuple<double, double> line_fit_pars = TrackFitUtils::line_fit(global_vec_noINTT);
+  std::tuple<double, double> line_fit_pars = deming_kernel(global_vec.size(), rz_of(global_vec), accept);
 
+  fitpars.reserve(5);
   fitpars.push_back(std::get<0>(circle_fit_pars));
   fitpars.push_back(std::get<1>(circle_fit_pars));
   fitpars.push_back(std::get<2>(circle_fit_pars));
@@ -645,8 +711,8 @@ std::vector<float> TrackFitUtils::fitClusters(std::vector<Acts::Vector3>& global
 }
 
 //_________________________________________________________________________________
-std::vector<float> TrackFitUtils::fitClustersZeroField(std::vector<Acts::Vector3>& global_vec,
-						       std::vector<TrkrDefs::cluskey> cluskey_vec, bool use_intt)
+std::vector<float> TrackFitUtils::fitClustersZeroField(const std::vector<Acts::Vector3>& global_vec,
+						       const std::vector<TrkrDefs::cluskey>& cluskey_vec, bool use_intt)
 {
   std::vector<float> fitpars;
 
@@ -659,43 +725,27 @@ std::vector<float> TrackFitUtils::fitClustersZeroField(std::vector<Acts::Vector3
   std::tuple<double, double> xy_fit_pars = TrackFitUtils::line_fit_xy(global_vec);
 
   // It is problematic that the large errors on the INTT strip z values are not allowed for - drop the INTT from the z line fit
-  std::vector<Acts::Vector3> global_vec_noINTT;
+  // the clusters are selected in place rather than copied
+  const auto accept = [&cluskey_vec, use_intt](size_t ivec)
+  { return use_intt || use_in_line_fit(cluskey_vec[ivec]); };
+  unsigned int nline = 0;
   for (unsigned int ivec = 0; ivec < global_vec.size(); ++ivec)
   {
-    unsigned int trkrid = TrkrDefs::getTrkrId(cluskey_vec[ivec]);
-
-    if (trkrid != TrkrDefs::inttId and cluskey_vec[ivec] != 0)
-    {
-      global_vec_noINTT.push_back(global_vec[ivec]);
-    }
+    nline += accept(ivec);
   }
-  //  std::cout << " use_intt = " << use_intt << std::endl;
-  if(use_intt)
-    {
-      global_vec_noINTT = global_vec;
-    }
-  if (global_vec_noINTT.size() < 3)
+  if (nline < 3)
     {
-       std::cout << " TrackFitUtils::fitClustersZeroField failed for <3 non-INTT cluskeys " << ((int)global_vec_noINTT.size()) << std::endl;
+       std::cout << " TrackFitUtils::fitClustersZeroField failed for <3 non-INTT cluskeys " << ((int)nline) << std::endl;
       return fitpars;
     }
-  std::tuple<double, double> xz_fit_pars = TrackFitUtils::line_fit_xz(global_vec_noINTT);
+  std::tuple<double, double> xz_fit_pars = deming_kernel(global_vec.size(), xz_of(global_vec), accept);
 
+  fitpars.reserve(4);
   fitpars.push_back(std::get<0>(xy_fit_pars));
   fitpars.push_back(std::get<1>(xy_fit_pars));
   fitpars.push_back(std::get<0>(xz_fit_pars));
   fitpars.push_back(std::get<1>(xz_fit_pars));
 
-  /*
-  std::cout << "   dy/dx " << fitpars[0]
-	    << " y0 " << fitpars[1]
-	    << " dz/dx " << fitpars[2]
-	    << " z0 " << fitpars[3]
-	    << std::endl;
-  std::cout << " global (layer 0): " << std::endl << global_vec_noINTT[0] << std::endl;
-  std::cout << " global (layer 2): " << std::endl << global_vec_noINTT[2] << std::endl;
-  */
-
   return fitpars;
 }
 
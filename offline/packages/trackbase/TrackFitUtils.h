@@ -6,6 +6,7 @@
 
 #include <Acts/Definitions/Algebra.hpp>
 
+#include <cstddef>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -38,6 +39,16 @@ namespace TrackFitUtils
   /// convenient overload
   circle_fit_output_t circle_fit_by_taubin(const std::vector<Acts::Vector3>&);
 
+  /// overload on separate x and y arrays of npoints entries, without copy
+  circle_fit_output_t circle_fit_by_taubin(const double* x, const double* y, size_t npoints);
+
+  /**
+   * fit many seeds at once. The points of all seeds are concatenated in x and y,
+   * the points of seed i are in [offsets[i], offsets[i+1]), output is resized to the number of seeds
+   */
+  void circle_fit_by_taubin(const std::vector<double>& x, const std::vector<double>& y,
+                            const std::vector<size_t>& offsets, std::vector<circle_fit_output_t>& output);
+
   /// line fit output [slope, intercept]
   using line_fit_output_t = std::tuple<double, double>;
 
@@ -64,6 +75,13 @@ namespace TrackFitUtils
   /// convenient overload
   line_fit_output_t line_fit(const std::vector<Acts::Vector3>&);
 
+  /// overload on separate x and y arrays of npoints entries, without copy
+  line_fit_output_t line_fit(const double* x, const double* y, size_t npoints);
+
+  /// fit many seeds at once, same layout as the batched circle_fit_by_taubin
+  void line_fit(const std::vector<double>& x, const std::vector<double>& y,
+                const std::vector<size_t>& offsets, std::vector<line_fit_output_t>& output);
+
   line_fit_output_t line_fit_xy(const std::vector<Acts::Vector3>& positions);
   line_fit_output_t line_fit_xz(const std::vector<Acts::Vector3>& positions);
 
@@ -124,8 +142,8 @@ namespace TrackFitUtils
 
   Acts::Vector2 get_circle_point_pca(float radius, float x0, float y0, Acts::Vector3 global);
 
-  std::vector<float> fitClusters(std::vector<Acts::Vector3>& global_vec,
-                                        std::vector<TrkrDefs::cluskey> cluskey_vec,
+  std::vector<float> fitClusters(const std::vector<Acts::Vector3>& global_vec,
+                                        const std::vector<TrkrDefs::cluskey>& cluskey_vec,
                                         bool use_intt = false);
   void getTrackletClusters(ActsGeometry* _tGeometry,
                                   TrkrClusterContainer* _cluster_map,
@@ -144,8 +162,8 @@ namespace TrackFitUtils
   std::vector<double> getCircleClusterResiduals(position_vector_t& xy_pts, float R, float X0, float Y0);
 
   Acts::Vector2 get_line_point_pca(double slope, double intercept, Acts::Vector3 global);
-  std::vector<float> fitClustersZeroField(std::vector<Acts::Vector3>& global_vec,
-						       std::vector<TrkrDefs::cluskey> cluskey_vec, bool use_intt);
+  std::vector<float> fitClustersZeroField(const std::vector<Acts::Vector3>& global_vec,
+						       const std::vector<TrkrDefs::cluskey>& cluskey_vec, bool use_intt);
 
   float get_helix_pathlength(std::vector<float>& fitpars, const Acts::Vector3& start_point, const Acts::Vector3& end_point);
   float get_helix_surface_pathlength(const Surface& surf, std::vector<float>& fitpars, const Acts::Vector3& start_point, ActsGeometry* tGeometry);
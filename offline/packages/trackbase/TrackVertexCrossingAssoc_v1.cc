@@ -28,6 +28,8 @@ void TrackVertexCrossingAssoc_v1::Reset()
   empty_vertexmap.swap(_vertex_assoc_map);
   empty_vertexmap.clear();
   _vertex_assoc_map.clear();
+
+  _crossing_set.clear();
 }
 
 //_________________________________________________________________________
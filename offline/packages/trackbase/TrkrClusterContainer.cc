@@ -4,12 +4,19 @@
  * @date June 2018
  */
 #include "TrkrClusterContainer.h"
+#include "TrkrClusterv5.h"
 
 namespace
 {
   TrkrClusterContainer::Map dummy_map;
 }
 
+//__________________________________________________________
+TrkrClusterv5* TrkrClusterContainer::newClusterv5()
+{
+  return new TrkrClusterv5;
+}
+
 //__________________________________________________________
 TrkrClusterContainer::ConstRange TrkrClusterContainer::getClusters() const
 {
@@ -15,8 +15,10 @@
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for pair
+#include <vector>
 
 class TrkrCluster;
+class TrkrClusterv5;
 
 /**
  * @brief Cluster container object
@@ -45,6 +47,15 @@ class TrkrClusterContainer : public PHObject
   //! add a cluster with specific key
   virtual void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) {}
 
+  /**
+   * create a new cluster to be handed to addClusterSpecifyKey.
+   * Containers may serve it from an event scoped pool, in which case
+   * it stays owned by the container even if it is never added.
+   * The default allocates on the heap.
+   * Not thread safe.
+   */
+  virtual TrkrClusterv5* newClusterv5();
+
   //! remove cluster
   virtual void removeCluster(TrkrDefs::cluskey) {}
 
@@ -78,6 +89,9 @@ class TrkrClusterContainer : public PHObject
   //! total number of clusters
   virtual unsigned int size() const { return 0; }
 
+  //! make all clusters available in memory, call before looking up clusters from several threads
+  virtual void decodeAll() const {}
+
  protected:
   //! constructor
   TrkrClusterContainer() = default;
@@ -6,33 +6,54 @@
  */
 #include "TrkrClusterContainerv4.h"
 #include "TrkrCluster.h"
+#include "TrkrClusterv5.h"
 #include "TrkrDefs.h"
 
 #include <algorithm>
+#include <functional>
+#include <utility>
 
 namespace
 {
   TrkrClusterContainer::Map dummy_map;
 }
 
+//_________________________________________________________________
+TrkrClusterContainerv4::~TrkrClusterContainerv4()
+{
+  TrkrClusterContainerv4::Reset();
+  for (auto& slab : m_slabs)
+  {
+    delete[] slab;
+  }
+}
+
 //_________________________________________________________________
 void TrkrClusterContainerv4::Reset()
 {
-  // delete all clusters
+  // delete all clusters which do not come from the pool
   for (auto&& [key, clus_vector] : m_clusmap)
   {
     for (auto&& cluster : clus_vector)
     {
-      delete cluster;
+      if (!isPoolCluster(cluster))
+      {
+        delete cluster;
+      }
     }
   }
 
-  // clear the maps
-  /* using swap ensures that the memory is properly de-allocated */
+  // rewind the pool, the slabs are reused in the next event
+  m_currentSlab = 0;
+  m_usedInSlab = 0;
+
+  // keep the cluster vectors with their capacity for the next event
+  for (auto&& [key, clus_vector] : m_clusmap)
   {
-    std::map<TrkrDefs::hitsetkey, Vector> empty;
-    m_clusmap.swap(empty);
+    clus_vector.clear();
+    m_spareVectors.push_back(std::move(clus_vector));
   }
+  m_clusmap.clear();
 
   // also clear temporary map
   {
@@ -41,6 +62,24 @@ void TrkrClusterContainerv4::Reset()
   }
 }
 
+//_________________________________________________________________
+void TrkrClusterContainerv4::Trim()
+{
+  // pool clusters still in use must stay valid
+  if (m_clusmap.empty())
+  {
+    for (auto& slab : m_slabs)
+    {
+      delete[] slab;
+    }
+    m_slabs.clear();
+    m_currentSlab = 0;
+    m_usedInSlab = 0;
+  }
+  std::vector<Vector> empty;
+  m_spareVectors.swap(empty);
+}
+
 //_________________________________________________________________
 void TrkrClusterContainerv4::identify(std::ostream& os) const
 {
@@ -84,7 +123,10 @@ void TrkrClusterContainerv4::removeCluster(TrkrDefs::cluskey key)
     if (index < clus_vector.size())
     {
       // delete corresponding element and set to null
-      delete clus_vector[index];
+      if (!isPoolCluster(clus_vector[index]))
+      {
+        delete clus_vector[index];
+      }
       clus_vector[index] = nullptr;
     }
   }
@@ -96,8 +138,19 @@ void TrkrClusterContainerv4::addClusterSpecifyKey(const TrkrDefs::cluskey key, T
   // get hitsetkey from cluster
   const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
 
-  // find relevant vector or create one if not found
-  auto& clus_vector = m_clusmap[hitsetkey];
+  // find relevant vector or create one if not found, reusing a vector of a previous event
+  auto iter = m_clusmap.lower_bound(hitsetkey);
+  if (iter == m_clusmap.end() || hitsetkey < iter->first)
+  {
+    Vector spare;
+    if (!m_spareVectors.empty())
+    {
+      spare = std::move(m_spareVectors.back());
+      m_spareVectors.pop_back();
+    }
+    iter = m_clusmap.emplace_hint(iter, hitsetkey, std::move(spare));
+  }
+  auto& clus_vector = iter->second;
 
   // get cluster index in vector
   const auto index = TrkrDefs::getClusIndex(key);
@@ -133,6 +186,48 @@ void TrkrClusterContainerv4::addClusterSpecifyKey(const TrkrDefs::cluskey key, T
   }
 }
 
+//_________________________________________________________________
+TrkrClusterv5* TrkrClusterContainerv4::newClusterv5()
+{
+  if (m_currentSlab < m_slabs.size() && m_usedInSlab == (s_firstSlabSize << m_currentSlab))
+  {
+    ++m_currentSlab;
+    m_usedInSlab = 0;
+  }
+  if (m_currentSlab == m_slabs.size())
+  {
+    // slabs double in size, so only a handful are needed
+    m_slabs.push_back(new TrkrClusterv5[s_firstSlabSize << m_currentSlab]);
+  }
+  TrkrClusterv5* cluster = m_slabs[m_currentSlab] + m_usedInSlab;
+  ++m_usedInSlab;
+
+  // clusters recycled from a previous event are returned in default state
+  *cluster = TrkrClusterv5();
+  return cluster;
+}
+
+//_________________________________________________________________
+bool TrkrClusterContainerv4::isPoolCluster(const TrkrCluster* cluster) const
+{
+  if (!cluster)
+  {
+    return false;
+  }
+  const std::less<const TrkrCluster*> less;
+  for (size_t i = 0; i < m_slabs.size(); ++i)
+  {
+    const TrkrCluster* begin = m_slabs[i];
+    const TrkrCluster* end = m_slabs[i] + (s_firstSlabSize << i);
+    if (!less(cluster, begin) && less(cluster, end))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//_________________________________________________________________
 TrkrClusterContainerv4::ConstRange
 TrkrClusterContainerv4::getClusters() const
 {
@@ -12,7 +12,11 @@
 
 #include <phool/PHObject.h>
 
+#include <cstddef>
+#include <vector>
+
 class TrkrCluster;
+class TrkrClusterv5;
 
 /**
  * @brief Cluster container object
@@ -22,12 +26,20 @@ class TrkrClusterContainerv4 : public TrkrClusterContainer
  public:
   TrkrClusterContainerv4() = default;
 
+  ~TrkrClusterContainerv4() override;
+
   void Reset() override;
 
+  //! frees the cluster pool and the spare cluster vectors
+  void Trim() override;
+
   void identify(std::ostream& os = std::cout) const override;
 
   void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) override;
 
+  //! cluster from the event pool, recycled (not deleted) in Reset()
+  TrkrClusterv5* newClusterv5() override;
+
   void removeCluster(TrkrDefs::cluskey) override;
 
   ConstRange getClusters() const override;  // deprecated
@@ -48,6 +60,9 @@ class TrkrClusterContainerv4 : public TrkrClusterContainer
   /// convenient alias
   using Vector = std::vector<TrkrCluster*>;
 
+  /// true if cluster was served by newClusterv5()
+  bool isPoolCluster(const TrkrCluster*) const;
+
   /// the actual container
   std::map<TrkrDefs::hitsetkey, Vector> m_clusmap;
 
@@ -59,6 +74,21 @@ class TrkrClusterContainerv4 : public TrkrClusterContainer
    */
   Map m_tmpmap;  //! transient. The temporary map does not get written to the output
 
+  /// cluster pool, slab i holds (s_firstSlabSize << i) clusters
+  /**
+   * slabs are kept between events, Reset() only rewinds the pool.
+   * Clusters read back from file or added from the heap are still
+   * owned and deleted one by one.
+   */
+  std::vector<TrkrClusterv5*> m_slabs;  //! transient
+  size_t m_currentSlab = 0;             //! transient
+  size_t m_usedInSlab = 0;              //! transient
+
+  static constexpr size_t s_firstSlabSize = 1024;
+
+  /// cluster vectors of the previous events, emptied but with their capacity
+  std::vector<Vector> m_spareVectors;  //! transient
+
   ClassDefOverride(TrkrClusterContainerv4, 1)
 };
 
@@ -0,0 +1,538 @@
+/**
+ * @file trackbase/TrkrClusterContainerv5.cc
+ * @brief Implementation of TrkrClusterContainerv5
+ */
+#include "TrkrClusterContainerv5.h"
+#include "TrkrCluster.h"
+#include "TrkrClusterv5.h"
+#include "TrkrDefs.h"
+
+#include <TBuffer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace
+{
+  TrkrClusterContainer::Map dummy_map;
+
+  // quantized value, rounded to the closest step
+  int32_t quantize(const float value, const float step)
+  {
+    return static_cast<int32_t>(std::lround(value / step));
+  }
+
+  // quantized error, saturates instead of wrapping around
+  uint16_t quantize_error(const float value, const float step)
+  {
+    if (!(value > 0))
+    {
+      return 0;
+    }
+    const long quantized = std::lround(value / step);
+    return static_cast<uint16_t>(std::min<long>(quantized, std::numeric_limits<uint16_t>::max()));
+  }
+
+  // adc, saturates (older cluster versions return UINT_MAX for unset values)
+  uint16_t to_uint16(const unsigned int value)
+  {
+    return static_cast<uint16_t>(std::min<unsigned int>(value, std::numeric_limits<uint16_t>::max()));
+  }
+
+  // cluster size, older cluster versions return NaN
+  char to_char(const float value)
+  {
+    return std::isfinite(value) ? static_cast<char>(std::clamp<float>(value, 0, std::numeric_limits<char>::max())) : 0;
+  }
+}  // namespace
+
+//_________________________________________________________________
+TrkrClusterContainerv5::~TrkrClusterContainerv5()
+{
+  clearClusters();
+  for (auto& slab : m_slabs)
+  {
+    delete[] slab;
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Reset()
+{
+  clearClusters();
+  clearEncoded();
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::clearClusters()
+{
+  // delete all clusters which do not come from the pool
+  for (auto&& [key, clus_vector] : m_clusmap)
+  {
+    for (auto&& cluster : clus_vector)
+    {
+      if (!isPoolCluster(cluster))
+      {
+        delete cluster;
+      }
+    }
+  }
+
+  // rewind the pool, the slabs are reused in the next event
+  m_currentSlab = 0;
+  m_usedInSlab = 0;
+
+  // clear the maps
+  /* using swap ensures that the memory is properly de-allocated */
+  {
+    std::map<TrkrDefs::hitsetkey, Vector> empty;
+    m_clusmap.swap(empty);
+  }
+  m_encoded.clear();
+  m_nencoded = 0;
+
+  // also clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::clearEncoded()
+{
+  // clear keeps the capacity, the arrays have about the same size every event
+  m_hitsetkeys.clear();
+  m_nclusters.clear();
+  m_index.clear();
+  m_local0.clear();
+  m_local1.clear();
+  m_phierr.clear();
+  m_zerr.clear();
+  m_subsurfkey.clear();
+  m_adc.clear();
+  m_maxadc.clear();
+  m_phisize.clear();
+  m_zsize.clear();
+  m_overlap.clear();
+  m_edge.clear();
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::Streamer(TBuffer& buffer)
+{
+  if (buffer.IsReading())
+  {
+    // clusters of the previous event are dropped, the new ones are decoded on access
+    clearClusters();
+    buffer.ReadClassBuffer(TrkrClusterContainerv5::Class(), this);
+    indexEncoded();
+  }
+  else
+  {
+    encode();
+    buffer.WriteClassBuffer(TrkrClusterContainerv5::Class(), this);
+    // the encoded arrays are only needed for writing
+    clearEncoded();
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::encode()
+{
+  // hitsets read but never accessed are part of the output too
+  decodeAll();
+  clearEncoded();
+
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    uint32_t count = 0;
+    uint32_t previous_index = 0;
+    int32_t previous_local0 = 0;
+    int32_t previous_local1 = 0;
+    for (uint32_t index = 0; index < clus_vector.size(); ++index)
+    {
+      const TrkrCluster* cluster = clus_vector[index];
+      if (!cluster)
+      {
+        continue;
+      }
+      const int32_t local0 = quantize(cluster->getLocalX(), m_position_step);
+      const int32_t local1 = quantize(cluster->getLocalY(), m_position_step);
+      m_index.push_back(index - previous_index);
+      m_local0.push_back(local0 - previous_local0);
+      m_local1.push_back(local1 - previous_local1);
+      previous_index = index;
+      previous_local0 = local0;
+      previous_local1 = local1;
+
+      m_phierr.push_back(quantize_error(cluster->getRPhiError(), m_error_step));
+      m_zerr.push_back(quantize_error(cluster->getZError(), m_error_step));
+      m_subsurfkey.push_back(cluster->getSubSurfKey());
+      m_adc.push_back(to_uint16(cluster->getAdc()));
+      m_maxadc.push_back(to_uint16(cluster->getMaxAdc()));
+      m_phisize.push_back(to_char(cluster->getPhiSize()));
+      m_zsize.push_back(to_char(cluster->getZSize()));
+      m_overlap.push_back(cluster->getOverlap());
+      m_edge.push_back(cluster->getEdge());
+      ++count;
+    }
+    if (count)
+    {
+      m_hitsetkeys.push_back(hitsetkey);
+      m_nclusters.push_back(count);
+    }
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::indexEncoded()
+{
+  m_encoded.clear();
+  const size_t nhitsets = std::min(m_hitsetkeys.size(), m_nclusters.size());
+  size_t offset = 0;
+  for (size_t i = 0; i < nhitsets; ++i)
+  {
+    const size_t count = m_nclusters[i];
+    if (offset + count > m_index.size())
+    {
+      std::cout << "TrkrClusterContainerv5::indexEncoded - inconsistent encoded clusters, dropping hitsets from " << m_hitsetkeys[i] << std::endl;
+      break;
+    }
+    m_encoded[m_hitsetkeys[i]] = {offset, count};
+    offset += count;
+  }
+  m_nencoded = m_encoded.size();
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::Vector* TrkrClusterContainerv5::decode(TrkrDefs::hitsetkey hitsetkey) const
+{
+  // nothing left to decode, the maps are only read
+  if (m_nencoded.load(std::memory_order_acquire) == 0)
+  {
+    const auto iter = m_clusmap.find(hitsetkey);
+    return iter == m_clusmap.end() ? nullptr : &iter->second;
+  }
+  std::lock_guard<std::mutex> lock(m_decode_mutex);
+  return decodeLocked(hitsetkey);
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::Vector* TrkrClusterContainerv5::decodeLocked(TrkrDefs::hitsetkey hitsetkey) const
+{
+  const auto encoded = m_encoded.find(hitsetkey);
+  if (encoded == m_encoded.end())
+  {
+    const auto iter = m_clusmap.find(hitsetkey);
+    return iter == m_clusmap.end() ? nullptr : &iter->second;
+  }
+
+  const Location location = encoded->second;
+  m_encoded.erase(encoded);
+
+  auto& clus_vector = m_clusmap[hitsetkey];
+  uint32_t index = 0;
+  int32_t local0 = 0;
+  int32_t local1 = 0;
+  for (size_t i = location.offset; i < location.offset + location.count; ++i)
+  {
+    index += m_index[i];
+    local0 += m_local0[i];
+    local1 += m_local1[i];
+
+    TrkrClusterv5* cluster = poolCluster();
+    cluster->setLocalX(local0 * m_position_step);
+    cluster->setLocalY(local1 * m_position_step);
+    cluster->setPhiError(m_phierr[i] * m_error_step);
+    cluster->setZError(m_zerr[i] * m_error_step);
+    cluster->setSubSurfKey(m_subsurfkey[i]);
+    cluster->setAdc(m_adc[i]);
+    cluster->setMaxAdc(m_maxadc[i]);
+    cluster->setPhiSize(m_phisize[i]);
+    cluster->setZSize(m_zsize[i]);
+    cluster->setOverlap(m_overlap[i]);
+    cluster->setEdge(m_edge[i]);
+
+    if (index >= clus_vector.size())
+    {
+      clus_vector.resize(index + 1, nullptr);
+    }
+    clus_vector[index] = cluster;
+  }
+  // published after the clusters are in place
+  m_nencoded.store(m_encoded.size(), std::memory_order_release);
+  return &clus_vector;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::decodeAll() const
+{
+  std::lock_guard<std::mutex> lock(m_decode_mutex);
+  while (!m_encoded.empty())
+  {
+    decodeLocked(m_encoded.begin()->first);
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::identify(std::ostream& os) const
+{
+  os << "-----TrkrClusterContainerv5-----" << std::endl;
+  os << "Number of clusters: " << size() << std::endl;
+
+  decodeAll();
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    os << "layer: " << layer << " hitsetkey: " << hitsetkey << std::endl;
+
+    for (const auto& cluster : clus_vector)
+    {
+      if (cluster)
+      {
+        cluster->identify(os);
+      }
+    }
+  }
+
+  os << "------------------------------" << std::endl;
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::removeCluster(TrkrDefs::cluskey key)
+{
+  // get hitset key from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // find relevant cluster vector if any and remove corresponding cluster
+  Vector* clus_vector = decode(hitsetkey);
+  if (clus_vector)
+  {
+    // cluster index in vector
+    const auto index = TrkrDefs::getClusIndex(key);
+
+    // compare to vector size
+    if (index < clus_vector->size())
+    {
+      // delete corresponding element and set to null
+      if (!isPoolCluster((*clus_vector)[index]))
+      {
+        delete (*clus_vector)[index];
+      }
+      (*clus_vector)[index] = nullptr;
+    }
+  }
+}
+
+//_________________________________________________________________
+void TrkrClusterContainerv5::addClusterSpecifyKey(const TrkrDefs::cluskey key, TrkrCluster* newclus)
+{
+  // get hitsetkey from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  // clusters read from file come first
+  decode(hitsetkey);
+
+  // find relevant vector or create one if not found
+  auto& clus_vector = m_clusmap[hitsetkey];
+
+  // get cluster index in vector
+  const auto index = TrkrDefs::getClusIndex(key);
+
+  // compare index to vector size
+  if (index < clus_vector.size())
+  {
+    /*
+     * if index is already contained in vector, check corresponding element
+     * and assign newclus if null
+     * print error message and exit otherwise
+     */
+    if (!clus_vector[index])
+    {
+      clus_vector[index] = newclus;
+    }
+    else
+    {
+      std::cout << "TrkrClusterContainerv5::AddClusterSpecifyKey: duplicate key: " << key << " exiting now" << std::endl;
+      exit(1);
+    }
+  }
+  else if (index == clus_vector.size())
+  {
+    // if index matches the vector size, just push back the new cluster
+    clus_vector.push_back(newclus);
+  }
+  else
+  {
+    // if index exceeds the vector size, resize cluster to the right size with nullptr, and assign
+    clus_vector.resize(index + 1, nullptr);
+    clus_vector[index] = newclus;
+  }
+}
+
+//_________________________________________________________________
+TrkrClusterv5* TrkrClusterContainerv5::newClusterv5()
+{
+  return poolCluster();
+}
+
+//_________________________________________________________________
+TrkrClusterv5* TrkrClusterContainerv5::poolCluster() const
+{
+  if (m_currentSlab < m_slabs.size() && m_usedInSlab == (s_firstSlabSize << m_currentSlab))
+  {
+    ++m_currentSlab;
+    m_usedInSlab = 0;
+  }
+  if (m_currentSlab == m_slabs.size())
+  {
+    // slabs double in size, so only a handful are needed
+    m_slabs.push_back(new TrkrClusterv5[s_firstSlabSize << m_currentSlab]);
+  }
+  TrkrClusterv5* cluster = m_slabs[m_currentSlab] + m_usedInSlab;
+  ++m_usedInSlab;
+
+  // clusters recycled from a previous event are returned in default state
+  *cluster = TrkrClusterv5();
+  return cluster;
+}
+
+//_________________________________________________________________
+bool TrkrClusterContainerv5::isPoolCluster(const TrkrCluster* cluster) const
+{
+  if (!cluster)
+  {
+    return false;
+  }
+  const std::less<const TrkrCluster*> less;
+  for (size_t i = 0; i < m_slabs.size(); ++i)
+  {
+    const TrkrCluster* begin = m_slabs[i];
+    const TrkrCluster* end = m_slabs[i] + (s_firstSlabSize << i);
+    if (!less(cluster, begin) && less(cluster, end))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters() const
+{
+  std::cout << "deprecated function in TrkrClusterContainerv5, user getClusters(TrkrDefs:hitsetkey)"
+            << std::endl;
+  return std::make_pair(dummy_map.begin(), dummy_map.begin());
+}
+
+//_________________________________________________________________
+TrkrClusterContainerv5::ConstRange
+TrkrClusterContainerv5::getClusters(TrkrDefs::hitsetkey hitsetkey)
+{
+  // clear temporary map
+  {
+    Map empty;
+    m_tmpmap.swap(empty);
+  }
+
+  // find relevant vector
+  const Vector* clusters = decode(hitsetkey);
+  if (clusters)
+  {
+    // copy content in temporary map
+    for (size_t index = 0; index < clusters->size(); ++index)
+    {
+      const auto& cluster = (*clusters)[index];
+      if (cluster)
+      {
+        // generate cluster key from hitset and index
+        const auto ckey = TrkrDefs::genClusKey(hitsetkey, index);
+
+        // insert in map
+        m_tmpmap.insert(m_tmpmap.end(), std::make_pair(ckey, cluster));
+      }
+    }
+  }
+
+  // return temporary map range
+  return std::make_pair(m_tmpmap.cbegin(), m_tmpmap.cend());
+}
+
+//_________________________________________________________________
+TrkrCluster* TrkrClusterContainerv5::findCluster(TrkrDefs::cluskey key) const
+{
+  // get hitsetkey from cluster
+  const TrkrDefs::hitsetkey hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(key);
+
+  const Vector* clus_vector = decode(hitsetkey);
+  if (!clus_vector)
+  {
+    return nullptr;
+  }
+
+  // compare cluster position to vector size
+  const auto index = TrkrDefs::getClusIndex(key);
+  return index < clus_vector->size() ? (*clus_vector)[index] : nullptr;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::hitSetKeys(const TrkrDefs::hitsetkey keylo, const TrkrDefs::hitsetkey keyhi) const
+{
+  // the keys of decoded and not yet decoded hitsets are disjoint, merge them in order
+  std::lock_guard<std::mutex> lock(m_decode_mutex);
+  HitSetKeyList decoded;
+  std::transform(
+      m_clusmap.lower_bound(keylo), m_clusmap.upper_bound(keyhi), std::back_inserter(decoded),
+      [](const std::pair<const TrkrDefs::hitsetkey, Vector>& pair)
+      { return pair.first; });
+  HitSetKeyList encoded;
+  std::transform(
+      m_encoded.lower_bound(keylo), m_encoded.upper_bound(keyhi), std::back_inserter(encoded),
+      [](const std::pair<const TrkrDefs::hitsetkey, Location>& pair)
+      { return pair.first; });
+
+  HitSetKeyList out;
+  out.reserve(decoded.size() + encoded.size());
+  std::merge(decoded.begin(), decoded.end(), encoded.begin(), encoded.end(), std::back_inserter(out));
+  return out;
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys() const
+{
+  return hitSetKeys(std::numeric_limits<TrkrDefs::hitsetkey>::min(), std::numeric_limits<TrkrDefs::hitsetkey>::max());
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid) const
+{
+  return hitSetKeys(TrkrDefs::getHitSetKeyLo(trackerid), TrkrDefs::getHitSetKeyHi(trackerid));
+}
+
+//_________________________________________________________________
+TrkrClusterContainer::HitSetKeyList TrkrClusterContainerv5::getHitSetKeys(const TrkrDefs::TrkrId trackerid, const uint8_t layer) const
+{
+  return hitSetKeys(TrkrDefs::getHitSetKeyLo(trackerid, layer), TrkrDefs::getHitSetKeyHi(trackerid, layer));
+}
+
+//_________________________________________________________________
+unsigned int TrkrClusterContainerv5::size() const
+{
+  std::lock_guard<std::mutex> lock(m_decode_mutex);
+  unsigned int size = 0;
+  for (const auto& [hitsetkey, clus_vector] : m_clusmap)
+  {
+    size += std::count_if(clus_vector.begin(), clus_vector.end(), [](TrkrCluster* cluster)
+                          { return cluster; });
+  }
+  // encoded hitsets only hold existing clusters
+  for (const auto& [hitsetkey, location] : m_encoded)
+  {
+    size += location.count;
+  }
+  return size;
+}
@@ -0,0 +1,166 @@
+#ifndef TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+#define TRACKBASE_TRKRCLUSTERCONTAINERV5_H
+
+/**
+ * @file trackbase/TrkrClusterContainerv5.h
+ * @brief Cluster container with compact (quantized) storage on file
+ */
+
+#include "TrkrClusterContainer.h"
+
+#include <phool/PHObject.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+class TrkrCluster;
+class TrkrClusterv5;
+
+/**
+ * @brief Cluster container with compact storage on file
+ *
+ * In memory the container behaves like TrkrClusterContainerv4. When written, the
+ * clusters are encoded per hitset as integers: the local position (already relative
+ * to the cluster surface) and errors quantized with a fixed step, positions and cluster
+ * indices delta encoded in index order, ADCs, sizes and flags copied as small integers.
+ * The arrays compress much better than the floats of TrkrClusterv5.
+ *
+ * When read back, a hitset is only decoded into TrkrClusterv5 objects once it is
+ * accessed (findCluster, getClusters, add or remove), so passes touching a few
+ * detectors do not pay for the others. Decoding is guarded by a mutex, so lookups
+ * (findCluster, getHitSetKeys, size) can be made from several threads. Once all
+ * hitsets are decoded (decodeAll) lookups take no lock.
+ */
+class TrkrClusterContainerv5 : public TrkrClusterContainer
+{
+ public:
+  TrkrClusterContainerv5() = default;
+
+  ~TrkrClusterContainerv5() override;
+
+  void Reset() override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void addClusterSpecifyKey(const TrkrDefs::cluskey, TrkrCluster*) override;
+
+  //! cluster from the event pool, recycled (not deleted) in Reset()
+  TrkrClusterv5* newClusterv5() override;
+
+  void removeCluster(TrkrDefs::cluskey) override;
+
+  ConstRange getClusters() const override;  // deprecated
+
+  ConstRange getClusters(TrkrDefs::hitsetkey) override;
+
+  TrkrCluster* findCluster(TrkrDefs::cluskey) const override;
+
+  HitSetKeyList getHitSetKeys() const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId) const override;
+
+  HitSetKeyList getHitSetKeys(const TrkrDefs::TrkrId, const uint8_t /* layer */) const override;
+
+  unsigned int size(void) const override;
+
+  //! decode all hitsets, later lookups take no lock
+  void decodeAll() const override;
+
+  //! quantization step of the local positions [cm], stored in the file
+  void setPositionStep(const float step) { m_position_step = step; }
+  float getPositionStep() const { return m_position_step; }
+
+  //! quantization step of the errors [cm], stored in the file
+  void setErrorStep(const float step) { m_error_step = step; }
+  float getErrorStep() const { return m_error_step; }
+
+ private:
+  /// convenient alias
+  using Vector = std::vector<TrkrCluster*>;
+
+  /// location of a hitset not yet decoded in the encoded arrays
+  struct Location
+  {
+    size_t offset = 0;
+    size_t count = 0;
+  };
+
+  /// next cluster of the pool, also used when decoding
+  TrkrClusterv5* poolCluster() const;
+
+  /// true if cluster was served by the pool
+  bool isPoolCluster(const TrkrCluster*) const;
+
+  /// delete the clusters not from the pool, rewind the pool and clear decoded and encoded hitsets
+  void clearClusters();
+
+  /// fill encoded arrays from all clusters
+  void encode();
+
+  /// clear encoded arrays
+  void clearEncoded();
+
+  /// locate hitsets in the encoded arrays after reading
+  void indexEncoded();
+
+  /// decode hitset if not done yet, returns its cluster vector or nullptr
+  Vector* decode(TrkrDefs::hitsetkey) const;
+
+  /// decode hitset, m_decode_mutex must be held
+  Vector* decodeLocked(TrkrDefs::hitsetkey) const;
+
+  /// hitset keys of decoded and encoded hitsets in range
+  HitSetKeyList hitSetKeys(const TrkrDefs::hitsetkey keylo, const TrkrDefs::hitsetkey keyhi) const;
+
+  //!@name encoded clusters, the persistent content
+  //@{
+  float m_position_step = 1e-4;  // 1 um
+  float m_error_step = 1e-4;     // 1 um
+
+  std::vector<TrkrDefs::hitsetkey> m_hitsetkeys;  // encoded hitsets
+  std::vector<uint32_t> m_nclusters;              // number of clusters per encoded hitset
+
+  std::vector<uint32_t> m_index;   // cluster index, difference to the previous one in the hitset
+  std::vector<int32_t> m_local0;   // quantized local x, difference to the previous cluster in the hitset
+  std::vector<int32_t> m_local1;   // quantized local y, difference to the previous cluster in the hitset
+  std::vector<uint16_t> m_phierr;  // quantized errors
+  std::vector<uint16_t> m_zerr;
+  std::vector<uint16_t> m_subsurfkey;
+  std::vector<uint16_t> m_adc;
+  std::vector<uint16_t> m_maxadc;
+  std::vector<char> m_phisize;
+  std::vector<char> m_zsize;
+  std::vector<char> m_overlap;
+  std::vector<char> m_edge;
+  //@}
+
+  /// decoded clusters
+  mutable std::map<TrkrDefs::hitsetkey, Vector> m_clusmap;  //! transient
+
+  /// hitsets read from file and not yet decoded
+  mutable std::map<TrkrDefs::hitsetkey, Location> m_encoded;  //! transient
+
+  /// size of m_encoded, lookups need no lock when it is 0
+  mutable std::atomic<size_t> m_nencoded{0};  //! transient
+
+  /// guards m_encoded and m_clusmap while hitsets are decoded
+  mutable std::mutex m_decode_mutex;  //! transient
+
+  /// temporary map
+  Map m_tmpmap;  //! transient. The temporary map does not get written to the output
+
+  /// cluster pool, slab i holds (s_firstSlabSize << i) clusters, see TrkrClusterContainerv4
+  mutable std::vector<TrkrClusterv5*> m_slabs;  //! transient
+  mutable size_t m_currentSlab = 0;             //! transient
+  mutable size_t m_usedInSlab = 0;              //! transient
+
+  static constexpr size_t s_firstSlabSize = 1024;
+
+  ClassDefOverride(TrkrClusterContainerv5, 1)
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERCONTAINERV5_H
@@ -0,0 +1,6 @@
+#ifdef __CINT__
+
+// custom streamer: clusters are encoded before writing and decoded on access after reading
+#pragma link C++ class TrkrClusterContainerv5 - ;
+
+#endif /* __CINT__ */
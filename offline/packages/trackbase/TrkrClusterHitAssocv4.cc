@@ -0,0 +1,139 @@
+/**
+ * @file trackbase/TrkrClusterHitAssocv4.cc
+ * @brief TrkrClusterHitAssocv4 implementation
+ */
+
+#include "TrkrClusterHitAssocv4.h"
+#include "TrkrDefs.h"
+
+#include <algorithm>
+#include <iterator>
+#include <ostream>  // for operator<<, endl, basic_ostream, ostream, basic_o...
+
+//_________________________________________________________________________
+void TrkrClusterHitAssocv4::Reset()
+{
+  m_clusters.clear();
+  m_offsets.clear();
+  m_hits.clear();
+  m_pending_clusters.clear();
+  m_pending_hits.clear();
+  m_scratch.clear();
+}
+
+//_________________________________________________________________________
+void TrkrClusterHitAssocv4::identify(std::ostream& os) const
+{
+  os << "-----TrkrClusterHitAssocv4-----" << std::endl;
+  os << "Number of associations: " << size() << std::endl;
+  for (size_t i = 0; i < m_clusters.size(); ++i)
+  {
+    for (unsigned int ihit = m_offsets[i]; ihit < m_offsets[i + 1]; ++ihit)
+    {
+      os << "clus key " << m_clusters[i] << std::dec
+         << " layer " << (unsigned int) TrkrDefs::getLayer(m_clusters[i])
+         << " hit key: " << m_hits[ihit] << std::endl;
+    }
+  }
+  for (size_t i = 0; i < m_pending_clusters.size(); ++i)
+  {
+    os << "clus key " << m_pending_clusters[i] << std::dec
+       << " layer " << (unsigned int) TrkrDefs::getLayer(m_pending_clusters[i])
+       << " hit key: " << m_pending_hits[i] << std::endl;
+  }
+  os << "------------------------------" << std::endl;
+
+  return;
+}
+
+//_________________________________________________________________________
+void TrkrClusterHitAssocv4::addAssoc(TrkrDefs::cluskey ckey, unsigned int hidx)
+{
+  if (!m_pending_clusters.empty() || (!m_clusters.empty() && ckey < m_clusters.back()))
+  {
+    m_pending_clusters.push_back(ckey);
+    m_pending_hits.push_back(hidx);
+    return;
+  }
+
+  // in order, append to the arrays
+  if (m_offsets.empty())
+  {
+    m_offsets.push_back(0);
+  }
+  if (m_clusters.empty() || ckey != m_clusters.back())
+  {
+    m_clusters.push_back(ckey);
+    m_offsets.push_back(m_offsets.back());
+  }
+  m_hits.push_back(hidx);
+  ++m_offsets.back();
+}
+
+//_________________________________________________________________________
+void TrkrClusterHitAssocv4::consolidate()
+{
+  if (m_pending_clusters.empty())
+  {
+    return;
+  }
+
+  // all associations as (cluster, hit), the stable sort keeps the hits of a cluster
+  // in the order they were added, like the multimap of the previous versions
+  std::vector<std::pair<TrkrDefs::cluskey, TrkrDefs::hitkey>> assocs;
+  assocs.reserve(m_hits.size() + m_pending_hits.size());
+  for (size_t i = 0; i < m_clusters.size(); ++i)
+  {
+    for (unsigned int ihit = m_offsets[i]; ihit < m_offsets[i + 1]; ++ihit)
+    {
+      assocs.emplace_back(m_clusters[i], m_hits[ihit]);
+    }
+  }
+  for (size_t i = 0; i < m_pending_clusters.size(); ++i)
+  {
+    assocs.emplace_back(m_pending_clusters[i], m_pending_hits[i]);
+  }
+  std::stable_sort(assocs.begin(), assocs.end(), [](const auto& lhs, const auto& rhs)
+                   { return lhs.first < rhs.first; });
+
+  m_clusters.clear();
+  m_offsets.clear();
+  m_hits.clear();
+  m_pending_clusters.clear();
+  m_pending_hits.clear();
+  for (const auto& [ckey, hidx] : assocs)
+  {
+    addAssoc(ckey, hidx);
+  }
+}
+
+//_________________________________________________________________________
+TrkrClusterHitAssocv4::HitKeyRange TrkrClusterHitAssocv4::getHitKeys(TrkrDefs::cluskey ckey)
+{
+  consolidate();
+  const auto iter = std::lower_bound(m_clusters.begin(), m_clusters.end(), ckey);
+  if (iter == m_clusters.end() || *iter != ckey)
+  {
+    return std::make_pair(nullptr, nullptr);
+  }
+  const auto index = std::distance(m_clusters.begin(), iter);
+  return std::make_pair(m_hits.data() + m_offsets[index], m_hits.data() + m_offsets[index + 1]);
+}
+
+//_________________________________________________________________________
+TrkrClusterHitAssocv4::ConstRange TrkrClusterHitAssocv4::getHits(TrkrDefs::cluskey ckey)
+{
+  m_scratch.clear();
+  const auto range = getHitKeys(ckey);
+  for (const auto* hit = range.first; hit != range.second; ++hit)
+  {
+    m_scratch.emplace_hint(m_scratch.end(), ckey, *hit);
+  }
+  return std::make_pair(m_scratch.cbegin(), m_scratch.cend());
+}
+
+//_________________________________________________________________________
+unsigned int TrkrClusterHitAssocv4::size() const
+{
+  return m_hits.size() + m_pending_hits.size();
+}
@@ -0,0 +1,70 @@
+#ifndef TRACKBASE_TRKRCLUSTERHITASSOCV4_H
+#define TRACKBASE_TRKRCLUSTERHITASSOCV4_H
+/**
+ * @file trackbase/TrkrClusterHitAssocv4.h
+ * @brief Version 4 of class for associating clusters to the hits that went into them
+ */
+
+#include "TrkrClusterHitAssoc.h"
+#include "TrkrDefs.h"
+
+#include <phool/PHObject.h>
+
+#include <iostream>  // for cout, ostream
+#include <utility>   // for pair
+#include <vector>
+
+/**
+ * @brief Class for associating clusters to the hits that went into them
+ *
+ * The associations are stored in flat arrays: the sorted cluster keys,
+ * the offset of their first hit and one array of all hit keys (compressed
+ * sparse rows). Clusters added in ascending key order, which is what the
+ * clusterizers do for a hitset, are appended directly. Others are kept
+ * in a buffer which is merged in before the first read.
+ * Reset keeps the allocated memory for the next event.
+ */
+class TrkrClusterHitAssocv4 : public TrkrClusterHitAssoc
+{
+ public:
+  using HitKeyRange = std::pair<const TrkrDefs::hitkey*, const TrkrDefs::hitkey*>;
+
+  TrkrClusterHitAssocv4() = default;
+
+  void Reset() override;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void addAssoc(TrkrDefs::cluskey, unsigned int) override;
+
+  //! the range points into a map filled for this cluster, it is valid until the next call
+  ConstRange getHits(TrkrDefs::cluskey) override;
+
+  //! hit keys of a cluster, without filling a map
+  HitKeyRange getHitKeys(TrkrDefs::cluskey);
+
+  unsigned int size(void) const override;
+
+ private:
+  //! merge the out of order associations into the sorted arrays
+  void consolidate();
+
+  //! sorted cluster keys
+  std::vector<TrkrDefs::cluskey> m_clusters;
+
+  //! index of the first hit of each cluster in m_hits, one more entry than clusters
+  std::vector<unsigned int> m_offsets;
+
+  std::vector<TrkrDefs::hitkey> m_hits;
+
+  //! associations added out of order since the last consolidation
+  std::vector<TrkrDefs::cluskey> m_pending_clusters;
+  std::vector<TrkrDefs::hitkey> m_pending_hits;
+
+  //! range returned by getHits
+  Map m_scratch;  //!
+
+  ClassDefOverride(TrkrClusterHitAssocv4, 1);
+};
+
+#endif  // TRACKBASE_TRKRCLUSTERHITASSOCV4_H
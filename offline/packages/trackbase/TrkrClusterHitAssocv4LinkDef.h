@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class TrkrClusterHitAssocv4 + ;
+
+#endif /* __CINT__ */
@@ -7,6 +7,7 @@
 #ifndef TRACKBASE_TRKRDEFS_H
 #define TRACKBASE_TRKRDEFS_H
 
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <map>
@@ -47,6 +48,11 @@ namespace TrkrDefs
   //  cluster id lower 32 bits
   static const unsigned int kBitShiftClusId __attribute__((unused)) = 32;
 
+  static_assert(kBitShiftTrkrId + 8 == 8 * sizeof(hitsetkey), "tracker id must be the upper 8 bits of the hitsetkey");
+  static_assert(kBitShiftLayer + 8 == kBitShiftTrkrId, "layer must be the 8 bits below the tracker id");
+  static_assert(kBitShiftClusId == 8 * sizeof(hitsetkey), "hitsetkey must be the upper half of the cluskey");
+  static_assert(kBitShiftClusId + 32 == 8 * sizeof(cluskey), "cluster index must be the lower 32 bits of the cluskey");
+
   /// Enumeration for tracker id to easily maintain consistency
   enum TrkrId
   {
@@ -70,45 +76,131 @@ namespace TrkrDefs
   void printBits(const TrkrDefs::cluskey key, std::ostream& os = std::cout);
   // void print_bits(const TrkrDefs::hitkey key, std::ostream& os = std::cout);
 
+  /*
+   * the key manipulations are inlined, they are called for every hit and
+   * cluster by the clusterizers, the seeding and the evaluators
+   */
+
   /// Get the tracker ID from either key type
-  uint8_t getTrkrId(const TrkrDefs::hitsetkey key);
-  uint8_t getTrkrId(const TrkrDefs::cluskey key);
+  inline constexpr uint8_t getTrkrId(const TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>(key >> kBitShiftTrkrId);
+  }
+
+  inline constexpr uint8_t getTrkrId(const TrkrDefs::cluskey key)
+  {
+    return getTrkrId(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId));
+  }
 
   /// Get the layer number from either key type
-  uint8_t getLayer(const TrkrDefs::hitsetkey key);
-  uint8_t getLayer(const TrkrDefs::cluskey key);
+  inline constexpr uint8_t getLayer(const TrkrDefs::hitsetkey key)
+  {
+    return static_cast<uint8_t>(key >> kBitShiftLayer);
+  }
+
+  inline constexpr uint8_t getLayer(const TrkrDefs::cluskey key)
+  {
+    return getLayer(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId));
+  }
 
   /// Get the lower 32 bits for cluster keys only
-  uint32_t getClusIndex(const TrkrDefs::cluskey key);
+  inline constexpr uint32_t getClusIndex(const TrkrDefs::cluskey key)
+  {
+    return static_cast<uint32_t>(key);
+  }
 
   /// generate the common upper 16 bits for hitsetkey
-  TrkrDefs::hitsetkey genHitSetKey(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
+  inline constexpr TrkrDefs::hitsetkey genHitSetKey(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return (static_cast<TrkrDefs::hitsetkey>(trkrId) << kBitShiftTrkrId) |
+           (static_cast<TrkrDefs::hitsetkey>(lyr) << kBitShiftLayer);
+  }
 
   /// generate cluster key from hitset key and cluster index
-  TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid);
+  inline constexpr TrkrDefs::cluskey genClusKey(const TrkrDefs::hitsetkey hskey, const uint32_t clusid)
+  {
+    return (static_cast<TrkrDefs::cluskey>(hskey) << kBitShiftClusId) | clusid;
+  }
 
   /// Get the upper 32 bits from cluster keys
-  uint32_t getHitSetKeyFromClusKey(const TrkrDefs::cluskey key);
+  inline constexpr uint32_t getHitSetKeyFromClusKey(const TrkrDefs::cluskey key)
+  {
+    return static_cast<uint32_t>(key >> kBitShiftClusId);
+  }
 
   /// Get a valid low / hi range for hitsetkey given tracker id & layer
-  TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId);
-  TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId);
-  TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
-  TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
+  inline constexpr TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId)
+  {
+    return genHitSetKey(trkrId, 0);
+  }
+
+  inline constexpr TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId)
+  {
+    return genHitSetKey(static_cast<TrkrDefs::TrkrId>(trkrId + 1), 0) - 1;
+  }
+
+  inline constexpr TrkrDefs::hitsetkey getHitSetKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return genHitSetKey(trkrId, lyr);
+  }
+
+  inline constexpr TrkrDefs::hitsetkey getHitSetKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return genHitSetKey(trkrId, lyr + 1) - 1;
+  }
 
   /// Get a valid low / hi range for cluskey given tracker id & layer
-  TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId);
-  TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId);
-  TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
-  TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr);
+  inline constexpr TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId)
+  {
+    return static_cast<TrkrDefs::cluskey>(genHitSetKey(trkrId, 0)) << kBitShiftClusId;
+  }
+
+  inline constexpr TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId)
+  {
+    return (static_cast<TrkrDefs::cluskey>(genHitSetKey(static_cast<TrkrDefs::TrkrId>(trkrId + 1), 0)) << kBitShiftClusId) - 1;
+  }
+
+  inline constexpr TrkrDefs::cluskey getClusKeyLo(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return static_cast<TrkrDefs::cluskey>(genHitSetKey(trkrId, lyr)) << kBitShiftClusId;
+  }
+
+  inline constexpr TrkrDefs::cluskey getClusKeyHi(const TrkrDefs::TrkrId trkrId, const uint8_t lyr)
+  {
+    return (static_cast<TrkrDefs::cluskey>(genHitSetKey(trkrId, lyr + 1)) << kBitShiftClusId) - 1;
+  }
 
   static const unsigned int kBitShiftPhiElement __attribute__((unused)) = 8;  // sector
   static const unsigned int kBitShiftZElement __attribute__((unused)) = 0;    // side
 
-  uint8_t getPhiElement(TrkrDefs::hitsetkey key);  // sector
-  uint8_t getZElement(TrkrDefs::hitsetkey key);    // side
-  uint8_t getPhiElement(TrkrDefs::cluskey key);    // sector
-  uint8_t getZElement(TrkrDefs::cluskey key);      // side
+  static_assert(kBitShiftPhiElement + 8 == kBitShiftLayer, "phi element must be the 8 bits below the layer");
+  static_assert(kBitShiftZElement + 8 == kBitShiftPhiElement, "z element must be the 8 bits below the phi element");
+
+  inline constexpr uint8_t getPhiElement(TrkrDefs::hitsetkey key)  // sector
+  {
+    return static_cast<uint8_t>(key >> kBitShiftPhiElement);
+  }
+
+  inline constexpr uint8_t getZElement(TrkrDefs::hitsetkey key)  // side
+  {
+    return static_cast<uint8_t>(key >> kBitShiftZElement);
+  }
+
+  inline constexpr uint8_t getPhiElement(TrkrDefs::cluskey key)  // sector
+  {
+    return getPhiElement(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId));
+  }
+
+  inline constexpr uint8_t getZElement(TrkrDefs::cluskey key)  // side
+  {
+    return getZElement(static_cast<TrkrDefs::hitsetkey>(key >> kBitShiftClusId));
+  }
+
+  /// decode n cluster keys at once, the loops are compiled in the library where they can be vectorized
+  void getTrkrId(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* trkrIds);
+  void getLayer(const TrkrDefs::cluskey* keys, std::size_t n, uint8_t* layers);
+  void getClusIndex(const TrkrDefs::cluskey* keys, std::size_t n, uint32_t* indices);
+  void getHitSetKeyFromClusKey(const TrkrDefs::cluskey* keys, std::size_t n, TrkrDefs::hitsetkey* hitsetkeys);
 
 }  // namespace TrkrDefs
 
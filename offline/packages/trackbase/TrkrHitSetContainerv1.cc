@@ -10,17 +10,43 @@
 #include "TrkrHitSetv1.h"
 
 #include <cstdlib>
+#include <typeinfo>
+
+TrkrHitSetContainerv1::~TrkrHitSetContainerv1()
+{
+  TrkrHitSetContainerv1::Reset();
+  TrkrHitSetContainerv1::Trim();
+}
 
 void TrkrHitSetContainerv1::Reset()
 {
   for (auto&& [key, hitset] : m_hitmap)
   {
-    delete hitset;
+    // plain TrkrHitSetv1 are emptied and kept, other types are deleted
+    if (hitset && typeid(*hitset) == typeid(TrkrHitSetv1))
+    {
+      hitset->Reset();
+      m_spareHitSets.push_back(static_cast<TrkrHitSetv1*>(hitset));
+    }
+    else
+    {
+      delete hitset;
+    }
   }
 
   m_hitmap.clear();
 }
 
+void TrkrHitSetContainerv1::Trim()
+{
+  for (auto& hitset : m_spareHitSets)
+  {
+    delete hitset;
+  }
+  m_spareHitSets.clear();
+  m_spareHitSets.shrink_to_fit();
+}
+
 void TrkrHitSetContainerv1::identify(std::ostream& os) const
 {
   ConstIterator iter;
@@ -99,7 +125,17 @@ TrkrHitSetContainerv1::findOrAddHitSet(TrkrDefs::hitsetkey key)
   auto it = m_hitmap.lower_bound(key);
   if (it == m_hitmap.end() || (key < it->first))
   {
-    it = m_hitmap.insert(it, std::make_pair(key, new TrkrHitSetv1));
+    TrkrHitSetv1* hitset = nullptr;
+    if (m_spareHitSets.empty())
+    {
+      hitset = new TrkrHitSetv1;
+    }
+    else
+    {
+      hitset = m_spareHitSets.back();
+      m_spareHitSets.pop_back();
+    }
+    it = m_hitmap.insert(it, std::make_pair(key, hitset));
     it->second->setHitSetKey(key);
   }
   return it;
@@ -12,8 +12,10 @@
 #include <iostream>  // for cout, ostream
 #include <map>
 #include <utility>  // for pair
+#include <vector>
 
 class TrkrHitSet;
+class TrkrHitSetv1;
 
 /**
  * Container for TrkrHitSet objects
@@ -23,13 +25,14 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
  public:
   TrkrHitSetContainerv1() = default;
 
-  ~TrkrHitSetContainerv1() override
-  {
-    TrkrHitSetContainerv1::Reset();
-  }
+  ~TrkrHitSetContainerv1() override;
 
+  //! hit sets made by findOrAddHitSet are kept for the next event
   void Reset() override;
 
+  //! frees the kept hit sets
+  void Trim() override;
+
   void identify(std::ostream& = std::cout) const override;
 
   ConstIterator addHitSet(TrkrHitSet*) override;
@@ -58,6 +61,9 @@ class TrkrHitSetContainerv1 : public TrkrHitSetContainer
  private:
   Map m_hitmap;
 
+  //! emptied hit sets of the previous events, reused by findOrAddHitSet
+  std::vector<TrkrHitSetv1*> m_spareHitSets;  //! transient
+
   ClassDefOverride(TrkrHitSetContainerv1, 1)
 };
 
@@ -0,0 +1,139 @@
+/**
+ * @file trackbase/TrkrHitSetv2.cc
+ * @brief Implementation of TrkrHitSetv2
+ */
+#include "TrkrHitSetv2.h"
+
+#include <algorithm>
+#include <cstdlib>  // for exit
+#include <iostream>
+
+void TrkrHitSetv2::Reset()
+{
+  m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+  // keep the capacity for the next event
+  m_hits.clear();
+  m_sorted = true;
+}
+
+void TrkrHitSetv2::identify(std::ostream& os) const
+{
+  const unsigned int layer = TrkrDefs::getLayer(m_hitSetKey);
+  const unsigned int trkrid = TrkrDefs::getTrkrId(m_hitSetKey);
+  os
+      << "TrkrHitSetv2: "
+      << "       hitsetkey " << getHitSetKey()
+      << " TrkrId " << trkrid
+      << " layer " << layer
+      << " nhits: " << m_hits.size()
+      << std::endl;
+
+  sort();
+  for (const auto& word : m_hits)
+  {
+    os << " hitkey " << unpackKey(word) << " adc " << unpackAdc(word) << std::endl;
+  }
+}
+
+void TrkrHitSetv2::addHitAdc(const TrkrDefs::hitkey key, const AdcType adc)
+{
+  // appending in key order (the usual case for unpackers) keeps the
+  // vector sorted, otherwise sorting is deferred to the first read
+  if (m_sorted && !m_hits.empty() && unpackKey(m_hits.back()) >= key)
+  {
+    m_sorted = false;
+  }
+  m_hits.push_back(pack(key, adc));
+}
+
+void TrkrHitSetv2::sort() const
+{
+  if (m_sorted)
+  {
+    return;
+  }
+  if (!std::is_sorted(m_hits.begin(), m_hits.end()))
+  {
+    std::sort(m_hits.begin(), m_hits.end());
+  }
+  // keys are in the upper bits, duplicates end up next to each other
+  const auto dup = std::adjacent_find(m_hits.begin(), m_hits.end(),
+                                      [](const uint64_t a, const uint64_t b)
+                                      { return unpackKey(a) == unpackKey(b); });
+  if (dup != m_hits.end())
+  {
+    std::cout << "TrkrHitSetv2::addHitAdc: duplicate key: " << unpackKey(*dup) << " exiting now" << std::endl;
+    exit(1);
+  }
+  m_sorted = true;
+}
+
+unsigned int TrkrHitSetv2::find(const TrkrDefs::hitkey key) const
+{
+  sort();
+  const auto it = std::lower_bound(m_hits.begin(), m_hits.end(), pack(key, 0));
+  if (it != m_hits.end() && unpackKey(*it) == key)
+  {
+    return it - m_hits.begin();
+  }
+  return m_hits.size();
+}
+
+TrkrHitSetv2::AdcType TrkrHitSetv2::getHitAdc(const TrkrDefs::hitkey key) const
+{
+  const unsigned int index = find(key);
+  return (index < m_hits.size()) ? unpackAdc(m_hits[index]) : 0;
+}
+
+bool TrkrHitSetv2::hasHit(const TrkrDefs::hitkey key) const
+{
+  return find(key) < m_hits.size();
+}
+
+void TrkrHitSetv2::removeHit(TrkrDefs::hitkey key)
+{
+  const unsigned int index = find(key);
+  if (index < m_hits.size())
+  {
+    m_hits.erase(m_hits.begin() + index);
+  }
+  else
+  {
+    identify();
+    std::cout << "TrkrHitSetv2::removeHit: deleting a nonexist key: " << key << " exiting now" << std::endl;
+    exit(1);
+  }
+}
+
+TrkrHitSetv2::ConstIterator
+TrkrHitSetv2::addHitSpecificKey(const TrkrDefs::hitkey key, TrkrHit* hit)
+{
+  std::cout << __PRETTY_FUNCTION__
+            << " : TrkrHit objects are not stored, use addHitAdc(TrkrDefs::hitkey, adc)" << std::endl;
+
+  exit(1);
+
+  return TrkrHitSet::addHitSpecificKey(key, hit);
+}
+
+TrkrHit*
+TrkrHitSetv2::getHit(const TrkrDefs::hitkey key) const
+{
+  std::cout << __PRETTY_FUNCTION__
+            << " : TrkrHit objects are not stored, use getHitAdc(TrkrDefs::hitkey)" << std::endl;
+
+  exit(1);
+
+  return TrkrHitSet::getHit(key);
+}
+
+TrkrHitSetv2::ConstRange
+TrkrHitSetv2::getHits() const
+{
+  std::cout << __PRETTY_FUNCTION__
+            << " : TrkrHit objects are not stored, use getHitKey(i)/getAdc(i)" << std::endl;
+
+  exit(1);
+
+  return TrkrHitSet::getHits();
+}
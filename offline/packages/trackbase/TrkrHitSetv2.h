@@ -0,0 +1,130 @@
+#ifndef TRACKBASE_TRKRHITSETV2_H
+#define TRACKBASE_TRKRHITSETV2_H
+
+/**
+ * @file trackbase/TrkrHitSetv2.h
+ * @brief Flat container for storing (hitkey, adc) pairs
+ */
+#include "TrkrDefs.h"
+#include "TrkrHitSet.h"
+
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+/**
+ * @brief Flat storage of digitized hits
+ *
+ * Hits are stored as packed (hitkey, adc) words in a single contiguous
+ * vector which is sorted by hitkey on first access. No TrkrHit object is
+ * allocated per hit. Reset() (and the TClonesArray Clear() used by
+ * TrkrHitSetContainerv2) keep the capacity, so a hitset which is reused
+ * from event to event does not touch the heap once it has grown to
+ * the occupancy of the detector element.
+ *
+ * Hits are added with addHitAdc() and read back with getHitAdc() or by
+ * index with getHitKey(i)/getAdc(i) in ascending hitkey order. The
+ * TrkrHit pointer based interface of TrkrHitSet is not supported.
+ */
+class TrkrHitSetv2 : public TrkrHitSet
+{
+ public:
+  using AdcType = uint16_t;
+
+  TrkrHitSetv2() = default;
+
+  ~TrkrHitSetv2() override = default;
+
+  void identify(std::ostream& os = std::cout) const override;
+
+  void Reset() override;
+
+  //! For ROOT TClonesArray end of event Operation
+  void Clear(Option_t* /*option*/ = "") override { Reset(); }
+
+  void setHitSetKey(const TrkrDefs::hitsetkey key) override
+  {
+    m_hitSetKey = key;
+  }
+
+  TrkrDefs::hitsetkey getHitSetKey() const override
+  {
+    return m_hitSetKey;
+  }
+
+  //! add hit with given key and adc, the key must not exist yet
+  void addHitAdc(const TrkrDefs::hitkey key, const AdcType adc);
+
+  //! adc for given key, 0 if there is no such hit
+  AdcType getHitAdc(const TrkrDefs::hitkey key) const;
+
+  //! true if a hit with this key exists
+  bool hasHit(const TrkrDefs::hitkey key) const;
+
+  //! hitkey of i-th hit, hits are sorted by hitkey
+  TrkrDefs::hitkey getHitKey(const unsigned int i) const
+  {
+    sort();
+    return unpackKey(m_hits[i]);
+  }
+
+  //! adc of i-th hit, hits are sorted by hitkey
+  AdcType getAdc(const unsigned int i) const
+  {
+    sort();
+    return unpackAdc(m_hits[i]);
+  }
+
+  //! reserve space for n hits
+  void reserve(const unsigned int n) { m_hits.reserve(n); }
+
+  void removeHit(TrkrDefs::hitkey) override;
+
+  unsigned int size() const override
+  {
+    return m_hits.size();
+  }
+
+  //! deprecated TrkrHit based interface
+  ConstIterator addHitSpecificKey(const TrkrDefs::hitkey, TrkrHit*) override;
+  TrkrHit* getHit(const TrkrDefs::hitkey) const override;
+  ConstRange getHits() const override;
+
+ private:
+  static uint64_t pack(const TrkrDefs::hitkey key, const AdcType adc)
+  {
+    return (static_cast<uint64_t>(key) << kAdcBits) | adc;
+  }
+
+  static TrkrDefs::hitkey unpackKey(const uint64_t word)
+  {
+    return word >> kAdcBits;
+  }
+
+  static AdcType unpackAdc(const uint64_t word)
+  {
+    return word & kAdcMask;
+  }
+
+  //! sort hits by key if needed, duplicate keys are fatal
+  void sort() const;
+
+  //! position of hit with given key, size() if not found
+  unsigned int find(const TrkrDefs::hitkey key) const;
+
+  static constexpr unsigned int kAdcBits = 16;
+  static constexpr uint64_t kAdcMask = (1ULL << kAdcBits) - 1;
+
+  /// unique key for this object
+  TrkrDefs::hitsetkey m_hitSetKey = TrkrDefs::HITSETKEYMAX;
+
+  /// packed hits, adc in the lower kAdcBits (16) bits, the 32 bit hitkey in the 32 bits above
+  mutable std::vector<uint64_t> m_hits;
+
+  /// true if m_hits is known to be sorted, checked again after readback
+  mutable bool m_sorted = false;  //!
+
+  ClassDefOverride(TrkrHitSetv2, 1);
+};
+
+#endif  // TRACKBASE_TRKRHITSETV2_H
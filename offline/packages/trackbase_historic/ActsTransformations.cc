@@ -2,6 +2,7 @@
 #include "SvtxTrack.h"
 #include "SvtxTrackState.h"
 #include "SvtxTrackState_v2.h"
+#include "SvtxTrackState_v3.h"
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/InttDefs.h>
@@ -304,7 +305,9 @@ void ActsTransformations::fillSvtxTrackStates(const Acts::ConstVectorMultiTrajec
 
       // create svtx state vector with relevant pathlength
       const float pathlength = state.pathLength() / Acts::UnitConstants::cm;  
-      SvtxTrackState_v2 out( pathlength );
+      SvtxTrackState_v2 state_v2( pathlength );
+      SvtxTrackState_v3 state_v3( pathlength );
+      SvtxTrackState& out = m_compactStates ? static_cast<SvtxTrackState&>(state_v3) : state_v2;
     
       // get smoothed fitted parameters
       const Acts::BoundTrackParameters params(
@@ -54,6 +54,9 @@ class ActsTransformations
 
   void setVerbosity(int verbosity) { m_verbosity = verbosity; }
 
+  /// fill the track states as SvtxTrackState_v3, with the covariance written in reduced precision
+  void setCompactStates(bool value) { m_compactStates = value; }
+
   void printMatrix(const std::string& message, const Acts::BoundSquareMatrix& matrix) const;
 
   /// Calculate the DCA for a given Acts fitted track parameters and
@@ -74,6 +77,7 @@ class ActsTransformations
 
  private:
   int m_verbosity = 0;
+  bool m_compactStates = false;
 };
 
 #endif
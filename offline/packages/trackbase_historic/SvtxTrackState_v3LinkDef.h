@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class SvtxTrackState_v3 + ;
+
+#endif /* __CINT__ */
@@ -0,0 +1,151 @@
+/*!
+ * \file TrackSeedArray.cc
+ * \brief transient, structure-of-arrays copy of a set of track seeds
+ */
+
+#include "TrackSeedArray.h"
+
+#include <cmath>
+
+//_______________________________________________________________
+float TrackSeedArray::View::get_pt() const
+{
+  /// same scaling as in TrackSeed_v2, for a 1.4T field
+  return 0.3 * 1.4 / 100. * std::fabs(1. / get_qOverR());
+}
+
+//_______________________________________________________________
+float TrackSeedArray::View::get_eta() const
+{
+  float theta = std::atan(1. / get_slope());
+  if (theta < 0)
+  {
+    theta += M_PI;
+  }
+  return -std::log(std::tan(theta / 2.));
+}
+
+//_______________________________________________________________
+void TrackSeedArray::clear()
+{
+  m_qOverR.clear();
+  m_X0.clear();
+  m_Y0.clear();
+  m_Z0.clear();
+  m_slope.clear();
+  m_phi.clear();
+  m_crossing.clear();
+  m_valid.clear();
+  m_offsets.assign(1, 0);
+  m_cluster_keys.clear();
+}
+
+//_______________________________________________________________
+void TrackSeedArray::reserve(size_t nseeds, size_t nkeys)
+{
+  m_qOverR.reserve(nseeds);
+  m_X0.reserve(nseeds);
+  m_Y0.reserve(nseeds);
+  m_Z0.reserve(nseeds);
+  m_slope.reserve(nseeds);
+  m_phi.reserve(nseeds);
+  m_crossing.reserve(nseeds);
+  m_valid.reserve(nseeds);
+  m_offsets.reserve(nseeds + 1);
+  m_cluster_keys.reserve(nkeys);
+}
+
+//_______________________________________________________________
+size_t TrackSeedArray::add(const TrackSeed* seed)
+{
+  if (seed)
+  {
+    m_cluster_keys.insert(m_cluster_keys.end(), seed->begin_cluster_keys(), seed->end_cluster_keys());
+  }
+  return add_parameters(seed);
+}
+
+//_______________________________________________________________
+void TrackSeedArray::fill(const TrackSeedContainer* container)
+{
+  clear();
+  if (!container)
+  {
+    return;
+  }
+
+  // first pass to size the key buffer
+  size_t nkeys = 0;
+  for (const auto& seed : *container)
+  {
+    if (seed)
+    {
+      nkeys += seed->size_cluster_keys();
+    }
+  }
+  reserve(container->size(), nkeys);
+
+  for (const auto& seed : *container)
+  {
+    add(seed);
+  }
+}
+
+//_______________________________________________________________
+size_t TrackSeedArray::count_common_keys(const View& first, const View& second)
+{
+  // merge walk over the two sorted ranges
+  size_t count = 0;
+  auto iter1 = first.begin_cluster_keys();
+  auto iter2 = second.begin_cluster_keys();
+  const auto end1 = first.end_cluster_keys();
+  const auto end2 = second.end_cluster_keys();
+  while (iter1 != end1 && iter2 != end2)
+  {
+    if (*iter1 < *iter2)
+    {
+      ++iter1;
+    }
+    else if (*iter2 < *iter1)
+    {
+      ++iter2;
+    }
+    else
+    {
+      ++count;
+      ++iter1;
+      ++iter2;
+    }
+  }
+  return count;
+}
+
+//_______________________________________________________________
+size_t TrackSeedArray::add_parameters(const TrackSeed* seed)
+{
+  if (seed)
+  {
+    m_qOverR.push_back(seed->get_qOverR());
+    m_X0.push_back(seed->get_X0());
+    m_Y0.push_back(seed->get_Y0());
+    m_Z0.push_back(seed->get_Z0());
+    m_slope.push_back(seed->get_slope());
+    m_phi.push_back(seed->get_phi());
+    m_crossing.push_back(seed->get_crossing());
+    m_valid.push_back(true);
+  }
+  else
+  {
+    m_qOverR.push_back(NAN);
+    m_X0.push_back(NAN);
+    m_Y0.push_back(NAN);
+    m_Z0.push_back(NAN);
+    m_slope.push_back(NAN);
+    m_phi.push_back(NAN);
+    m_crossing.push_back(0);
+    m_valid.push_back(false);
+  }
+
+  m_offsets.push_back(m_cluster_keys.size());
+  return m_valid.size() - 1;
+}
@@ -0,0 +1,168 @@
+#ifndef TRACKBASEHISTORIC_TRACKSEEDARRAY_H
+#define TRACKBASEHISTORIC_TRACKSEEDARRAY_H
+
+/*!
+ * \file TrackSeedArray.h
+ * \brief transient, structure-of-arrays copy of a set of track seeds
+ * \detail
+ * seed parameters are stored in one contiguous array per parameter, and the cluster keys of
+ * all seeds in a single flat buffer, sorted within each seed. Filling costs two vector
+ * appends per seed instead of a heap allocation per seed and per cluster key, and loops
+ * over seeds or over the keys of a seed run on contiguous memory.
+ * Seeds are read back through the lightweight View class, which does not allocate.
+ * The array is not stored on the node tree.
+ */
+
+#include "TrackSeed.h"
+#include "TrackSeedContainer.h"
+
+#include <trackbase/TrkrDefs.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+class TrackSeedArray
+{
+ public:
+  using ConstClusterKeyIter = std::vector<TrkrDefs::cluskey>::const_iterator;
+
+  /// read only access to one seed of the array
+  class View
+  {
+   public:
+    View(const TrackSeedArray* array, size_t index)
+      : m_array(array)
+      , m_index(index)
+    {
+    }
+
+    /// index of the seed in the array, identical to its index in the source container
+    size_t index() const { return m_index; }
+
+    /// false if the source container had no seed at this index
+    bool valid() const { return m_array->m_valid[m_index]; }
+
+    ///@name accessors, same meaning as in TrackSeed
+    //@{
+    float get_qOverR() const { return m_array->m_qOverR[m_index]; }
+    float get_X0() const { return m_array->m_X0[m_index]; }
+    float get_Y0() const { return m_array->m_Y0[m_index]; }
+    float get_Z0() const { return m_array->m_Z0[m_index]; }
+    float get_slope() const { return m_array->m_slope[m_index]; }
+    float get_phi() const { return m_array->m_phi[m_index]; }
+    short int get_crossing() const { return m_array->m_crossing[m_index]; }
+    int get_charge() const { return (get_qOverR() < 0) ? -1 : 1; }
+    float get_pt() const;
+    float get_eta() const;
+    //@}
+
+    ///@name cluster keys, sorted
+    //@{
+    bool empty_cluster_keys() const { return begin_cluster_keys() == end_cluster_keys(); }
+    size_t size_cluster_keys() const { return end_cluster_keys() - begin_cluster_keys(); }
+    ConstClusterKeyIter begin_cluster_keys() const { return m_array->m_cluster_keys.begin() + m_array->m_offsets[m_index]; }
+    ConstClusterKeyIter end_cluster_keys() const { return m_array->m_cluster_keys.begin() + m_array->m_offsets[m_index + 1]; }
+    bool has_cluster_key(TrkrDefs::cluskey key) const { return std::binary_search(begin_cluster_keys(), end_cluster_keys(), key); }
+    //@}
+
+   private:
+    const TrackSeedArray* m_array = nullptr;
+    size_t m_index = 0;
+  };
+
+  /// remove all seeds, keep allocated memory
+  void clear();
+
+  /// reserve memory
+  void reserve(size_t nseeds, size_t nkeys);
+
+  /// append one seed. A null seed is stored as an invalid entry, to keep indices aligned. Returns its index
+  size_t add(const TrackSeed* seed);
+
+  /// append one seed, keeping only the cluster keys for which selection(key) is true
+  template <class F>
+  size_t add(const TrackSeed* seed, F&& selection);
+
+  /// replace the content with all seeds of a container, index by index
+  void fill(const TrackSeedContainer* container);
+
+  /// replace the content with all seeds of a container, keeping only selected cluster keys
+  template <class F>
+  void fill(const TrackSeedContainer* container, F&& selection);
+
+  /// number of seeds, including invalid ones
+  size_t size() const { return m_valid.size(); }
+
+  /// true if there are no seeds
+  bool empty() const { return m_valid.empty(); }
+
+  /// access seed by index
+  View operator[](size_t index) const { return View(this, index); }
+
+  /// total number of stored cluster keys
+  size_t size_cluster_keys() const { return m_cluster_keys.size(); }
+
+  ///@name contiguous parameter arrays, for vectorized loops over seeds
+  //@{
+  const std::vector<float>& get_qOverR() const { return m_qOverR; }
+  const std::vector<float>& get_X0() const { return m_X0; }
+  const std::vector<float>& get_Y0() const { return m_Y0; }
+  const std::vector<float>& get_Z0() const { return m_Z0; }
+  const std::vector<float>& get_slope() const { return m_slope; }
+  const std::vector<float>& get_phi() const { return m_phi; }
+  const std::vector<short int>& get_crossing() const { return m_crossing; }
+  //@}
+
+  /// number of cluster keys common to two seeds
+  static size_t count_common_keys(const View& first, const View& second);
+
+ private:
+  /// store seed parameters and close the key range of the seed
+  size_t add_parameters(const TrackSeed* seed);
+
+  std::vector<float> m_qOverR;
+  std::vector<float> m_X0;
+  std::vector<float> m_Y0;
+  std::vector<float> m_Z0;
+  std::vector<float> m_slope;
+  std::vector<float> m_phi;
+  std::vector<short int> m_crossing;
+  std::vector<uint8_t> m_valid;
+
+  /// cluster keys of seed i are in [m_offsets[i], m_offsets[i+1])
+  std::vector<uint32_t> m_offsets = {0};
+  std::vector<TrkrDefs::cluskey> m_cluster_keys;
+};
+
+//_______________________________________________________________
+template <class F>
+size_t TrackSeedArray::add(const TrackSeed* seed, F&& selection)
+{
+  if (seed)
+  {
+    // cluster keys from a TrackSeed are already sorted
+    std::copy_if(seed->begin_cluster_keys(), seed->end_cluster_keys(),
+                 std::back_inserter(m_cluster_keys), selection);
+  }
+  return add_parameters(seed);
+}
+
+//_______________________________________________________________
+template <class F>
+void TrackSeedArray::fill(const TrackSeedContainer* container, F&& selection)
+{
+  clear();
+  if (!container)
+  {
+    return;
+  }
+  for (const auto& seed : *container)
+  {
+    add(seed, selection);
+  }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef TRACKBASEHISTORIC_TRACKSEEDCLUSTERINDEX_H
+#define TRACKBASEHISTORIC_TRACKSEEDCLUSTERINDEX_H
+
+/*!
+ * \file TrackSeedClusterIndex.h
+ * \brief transient cluster key to seed index, to find the seeds sharing clusters
+ * \detail
+ * the index is a flat array of (cluster key, seed) pairs sorted by key then seed, filled once
+ * per event. Duplicate searches which compared every pair of seeds only need to compare a
+ * seed to the ones returned by shared_seeds(), since seeds without a common cluster key
+ * cannot be duplicates.
+ */
+
+#include <trackbase/TrkrDefs.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+class TrackSeedClusterIndex
+{
+ public:
+  /// remove all entries, keep allocated memory
+  void clear() { m_entries.clear(); }
+
+  /// add the cluster keys [begin, end) of seed. Call build() once all seeds are added
+  template <class Iter>
+  void add(unsigned int seed, Iter begin, Iter end)
+  {
+    for (; begin != end; ++begin)
+    {
+      m_entries.emplace_back(*begin, seed);
+    }
+  }
+
+  /// sort the entries
+  void build() { std::sort(m_entries.begin(), m_entries.end()); }
+
+  /// seeds above minseed sharing at least one of the cluster keys [begin, end), sorted and unique
+  template <class Iter>
+  void shared_seeds(Iter begin, Iter end, unsigned int minseed, std::vector<unsigned int>& seeds) const
+  {
+    seeds.clear();
+    for (; begin != end; ++begin)
+    {
+      // entries of a key are sorted by seed
+      const TrkrDefs::cluskey key = *begin;
+      for (auto iter = std::upper_bound(m_entries.begin(), m_entries.end(), Entry(key, minseed));
+           iter != m_entries.end() && iter->first == key; ++iter)
+      {
+        seeds.push_back(iter->second);
+      }
+    }
+    std::sort(seeds.begin(), seeds.end());
+    seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+  }
+
+  /// number of (cluster key, seed) entries
+  size_t size() const { return m_entries.size(); }
+
+ private:
+  using Entry = std::pair<TrkrDefs::cluskey, unsigned int>;
+  std::vector<Entry> m_entries;
+};
+
+#endif
@@ -58,6 +58,10 @@ double ALICEKF::get_Bz(double x, double y, double z) const
   {
     return _const_field;
   }
+  if (_bz_table)
+  {
+    return _bz_table->get(x, y, z);
+  }
   double p[4] = {x * cm, y * cm, z * cm, 0. * cm};
   double bfield[3];
   _B->GetFieldValue(p, bfield);
@@ -9,6 +9,7 @@
 #include <trackbase/TrkrClusterContainer.h>
 #include <trackbase/TrkrDefs.h>
 #include <trackbase_historic/TrackSeed_v2.h>
+#include "BzRZTable.h"
 #include "GPUTPCTrackParam.h"
 
 #include <Acts/Definitions/Algebra.hpp>
@@ -66,6 +67,8 @@ class ALICEKF
   double get_Bz(double x, double y, double z) const;
   void useConstBField(bool opt) { _use_const_field = opt; }
   void setConstBField(float b) { _const_field = b; }
+  /// look up Bz in table instead of the field map, the table must outlive the fitter
+  void setBzTable(const BzRZTable* table) { _bz_table = table; }
   void useFixedClusterError(bool opt) { _use_fixed_clus_error = opt; }
   void setFixedClusterError(int i, double val) { _fixed_clus_error.at(i) = val; }
   double getClusterError(TrkrCluster* c, TrkrDefs::cluskey key, Acts::Vector3 global, int i, int j) const;
@@ -77,6 +80,7 @@ class ALICEKF
 
  private:
   PHField* _B = nullptr;
+  const BzRZTable* _bz_table = nullptr;
   size_t _min_clusters_per_track = 20;
   TrkrClusterContainer* _cluster_map = nullptr;
   int Verbosity() const
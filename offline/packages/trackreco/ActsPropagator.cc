@@ -194,6 +194,43 @@ ActsPropagator::propagateTrackFast(const Acts::BoundTrackParameters& params,
   return result.error();
 }
 
+std::vector<ActsPropagator::BTPPairResult>
+ActsPropagator::propagateTrackFast(const Acts::BoundTrackParameters& params,
+                                   const std::vector<SurfacePtr>& surfaces)
+{
+  if (m_verbosity > 1)
+  {
+    printTrackParams(params);
+  }
+
+  auto propagator = makeFastPropagator();
+
+  Acts::PropagatorOptions<> options(m_geometry->geometry().getGeoContext(),
+                                    m_geometry->geometry().magFieldContext);
+
+  std::vector<BTPPairResult> results;
+  results.reserve(surfaces.size());
+
+  /// a failed surface does not move the starting point for the next one
+  BoundTrackParam start = params;
+  float pathlength = 0;
+  for (const auto& surface : surfaces)
+  {
+    auto result = propagator.propagate(start, *surface, options);
+    if (!result.ok())
+    {
+      results.push_back(result.error());
+      continue;
+    }
+
+    start = *result.value().endParameters;
+    pathlength += result.value().pathLength;
+    results.push_back(Acts::Result<BoundTrackParamPair>::success(std::make_pair(pathlength, start)));
+  }
+
+  return results;
+}
+
 ActsPropagator::FastPropagator ActsPropagator::makeFastPropagator()
 {
   auto field = m_geometry->geometry().magField;
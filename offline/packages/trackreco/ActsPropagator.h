@@ -22,6 +22,8 @@
 
 #include <trackbase/ActsGeometry.h>
 
+#include <vector>
+
 class SvtxTrack;
 class SvtxVertex;
 class SvtxVertexMap;
@@ -72,6 +74,11 @@ class ActsPropagator
   /// target surface
   BTPPairResult propagateTrackFast(const Acts::BoundTrackParameters& params,
                                            const SurfacePtr& surface);
+  /// Same for several surfaces of increasing radius in a single pass: each
+  /// surface is reached from the parameters at the previous one. Returns one
+  /// result per surface, the path lengths are counted from params
+  std::vector<BTPPairResult> propagateTrackFast(const Acts::BoundTrackParameters& params,
+                                                const std::vector<SurfacePtr>& surfaces);
 
   bool checkLayer(const unsigned int& sphenixlayer,
                   unsigned int& actsvolume,
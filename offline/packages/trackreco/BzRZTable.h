@@ -0,0 +1,80 @@
+#ifndef TRACKRECO_BZRZTABLE_H
+#define TRACKRECO_BZRZTABLE_H
+
+/*!
+ *  \file BzRZTable.h
+ *  \brief Bz of the field map tabulated in (r, z) for the Kalman propagation
+ *  \detail
+ *  the seed propagation asks for Bz at every step, which otherwise goes through the full
+ *  3D interpolation of the field map. The table is filled once per run by averaging the
+ *  field map over a few azimuthal angles (the solenoid field is azimuthally symmetric)
+ *  and a lookup is a bilinear interpolation. It is read only after build(), so it can be
+ *  shared between threads.
+ */
+
+#include <phfield/PHField.h>
+
+#include <Geant4/G4SystemOfUnits.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+class BzRZTable
+{
+ public:
+  /// tabulate Bz of field for r in [0, rmax] and z in [zmin, zmax] (cm), nodes every step cm
+  void build(const PHField* field, double rmax, double zmin, double zmax, double step, unsigned int nphi = 8)
+  {
+    m_zmin = zmin;
+    m_inv_step = 1. / step;
+    m_nr = std::max(2, static_cast<int>(std::ceil(rmax / step)) + 1);
+    m_nz = std::max(2, static_cast<int>(std::ceil((zmax - zmin) / step)) + 1);
+    m_bz.assign(static_cast<size_t>(m_nr) * m_nz, 0);
+    for (int ir = 0; ir < m_nr; ++ir)
+    {
+      const double r = ir * step;
+      for (int iz = 0; iz < m_nz; ++iz)
+      {
+        const double z = zmin + iz * step;
+        double sum = 0;
+        for (unsigned int iphi = 0; iphi < nphi; ++iphi)
+        {
+          const double phi = 2. * M_PI * iphi / nphi;
+          const double p[4] = {r * std::cos(phi) * cm, r * std::sin(phi) * cm, z * cm, 0. * cm};
+          double bfield[3];
+          field->GetFieldValue(p, bfield);
+          sum += bfield[2] / tesla;
+        }
+        m_bz[index(ir, iz)] = sum / nphi;
+      }
+    }
+  }
+
+  bool empty() const { return m_bz.empty(); }
+
+  /// Bz (tesla) at x, y, z (cm), points outside the table take the value at its edge
+  double get(double x, double y, double z) const
+  {
+    const double fr = std::sqrt(x * x + y * y) * m_inv_step;
+    const double fz = (z - m_zmin) * m_inv_step;
+    const int ir = std::clamp(static_cast<int>(fr), 0, m_nr - 2);
+    const int iz = std::clamp(static_cast<int>(std::floor(fz)), 0, m_nz - 2);
+    const double tr = std::clamp(fr - ir, 0., 1.);
+    const double tz = std::clamp(fz - iz, 0., 1.);
+    const double b0 = m_bz[index(ir, iz)] * (1. - tz) + m_bz[index(ir, iz + 1)] * tz;
+    const double b1 = m_bz[index(ir + 1, iz)] * (1. - tz) + m_bz[index(ir + 1, iz + 1)] * tz;
+    return b0 * (1. - tr) + b1 * tr;
+  }
+
+ private:
+  size_t index(int ir, int iz) const { return static_cast<size_t>(ir) * m_nz + iz; }
+
+  double m_zmin = 0;
+  double m_inv_step = 1;
+  int m_nr = 0;
+  int m_nz = 0;
+  std::vector<double> m_bz;
+};
+
+#endif
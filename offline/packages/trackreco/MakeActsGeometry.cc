@@ -193,6 +193,7 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   surfMaps.m_tpcSurfaceMap = m_clusterSurfaceMapTpcEdit;
   surfMaps.m_mmSurfaceMap = m_clusterSurfaceMapMmEdit;
   surfMaps.m_tGeoNodeMap = m_clusterNodeMap;
+  surfMaps.buildLookupTables();
 
   // fill TPC volume ids
   for (const auto &[hitsetid, surfaceVector] : m_clusterSurfaceMapTpcEdit)
@@ -217,6 +218,7 @@ int MakeActsGeometry::InitRun(PHCompositeNode *topNode)
   {
     alignment_transformation.verbosity();
   }
+  alignment_transformation.setNThreads(m_alignmentNThreads);
   alignment_transformation.createMap(topNode);
 
   for (auto &[layer, factor] : m_misalignmentFactor)
@@ -147,6 +147,9 @@ class MakeActsGeometry : public SubsysReco
   void set_mvtx_applymisalign(bool b) { m_mvtxapplymisalign = b; }
   void set_intt_survey(bool surv) { m_inttSurvey = surv; }
 
+  //! threads used to build the alignment transforms
+  void set_alignment_nthreads(int n) { m_alignmentNThreads = n; }
+
  private:
   /// Main function to build all acts geometry for use in the fitting modules
   int buildAllGeometry(PHCompositeNode *topNode);
@@ -228,6 +231,7 @@ class MakeActsGeometry : public SubsysReco
 
   bool m_useField = true;
   std::map<uint8_t, double> m_misalignmentFactor;
+  int m_alignmentNThreads = 1;
 
   /// Several maps that connect Acts world to sPHENIX G4 world
   std::map<TrkrDefs::hitsetkey, TGeoNode *> m_clusterNodeMap;
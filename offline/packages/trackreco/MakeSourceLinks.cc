@@ -124,11 +124,11 @@ SourceLinkVec MakeSourceLinks::getSourceLinks(
       Acts::Vector3 correction_rotation(0,0,0);   // null rotation
       Acts::Transform3 tcorr = tGeometry->makeAffineTransform(correction_rotation, correction_translation);
 
-      auto this_surf = tGeometry->maps().getSurface(key, cluster);
+      // surface and cluster were already looked up above
+      const auto& this_surf = surf;
       Acts::GeometryIdentifier id = this_surf->geometryId();
 
-      auto check_cluster = clusterContainer->findCluster(key);
-      Acts::Vector2 check_local2d = tGeometry->getLocalCoords(key, check_cluster) * Acts::UnitConstants::cm; // need mm
+      Acts::Vector2 check_local2d = tGeometry->getLocalCoords(key, cluster) * Acts::UnitConstants::cm; // need mm
       Acts::Vector3 check_local3d (check_local2d(0), check_local2d(1), 0);
       Acts::GeometryContext temp_transient_geocontext;
       temp_transient_geocontext =  transformMapTransient;
@@ -366,13 +366,10 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
     }
 
     auto cluster = clusterContainer->findCluster(cluskey);
-    Surface surf = tGeometry->maps().getSurface(cluskey, cluster);
-
-    //    std::cout << " Initial surface " <<  std::endl;
-    //surf.get()->toStream(tGeometry->geometry().getGeoContext(), std::cout);
-    //std::cout << std::endl;
 
     // if this is a TPC cluster, the crossing correction may have moved it across the central membrane, check the surface
+    // the default surface is only needed for the other detectors
+    Surface surf;
     auto trkrid = TrkrDefs::getTrkrId(cluskey);
     if (trkrid == TrkrDefs::tpcId)
     {
@@ -380,6 +377,10 @@ SourceLinkVec MakeSourceLinks::getSourceLinksClusterMover(
       TrkrDefs::subsurfkey new_subsurfkey = 0;
       surf = tGeometry->get_tpc_surface_from_coords(hitsetkey, global, new_subsurfkey);
     }
+    else
+    {
+      surf = tGeometry->maps().getSurface(cluskey, cluster);
+    }
 
     if (!surf)
     {
@@ -44,6 +44,8 @@
 
 #include <TDatabasePDG.h>
 
+#include <atomic>
+
 //____________________________________________________________________________..
 PHActsGSF::PHActsGSF(const std::string& name)
   : SubsysReco(name)
@@ -101,7 +103,8 @@ int PHActsGSF::InitRun(PHCompositeNode* topNode)
       m_tGeometry->geometry().tGeometry,
       m_tGeometry->geometry().magField,
       bha,
-      12, 1e-4, Acts::MixtureReductionMethod::eMaxWeight, false, false);
+      m_maxComponents, m_weightCutoff, Acts::MixtureReductionMethod::eMaxWeight, false, false,
+      m_reduceByWeight);
 
   if (m_actsEvaluator)
   {
@@ -110,6 +113,37 @@ int PHActsGSF::InitRun(PHCompositeNode* topNode)
     m_evaluator->verbosity(Verbosity());
   }
 
+  if (m_timeAnalysis)
+  {
+    m_timeFile = new TFile(std::string(Name() + ".root").c_str(),
+                           "RECREATE");
+    h_fitTime = new TH2F("h_fitTime", ";p_{T} [GeV];time [ms]",
+                         80, 0, 40, 100000, 0, 1000);
+  }
+
+  // slot 0 works directly on the node tree transient transforms
+  m_workspaces.clear();
+  m_workspaces.resize(1);
+  m_workspaces.front().transformMapTransient = m_alignmentTransformationMapTransient;
+
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    if (m_actsEvaluator)
+    {
+      std::cout << PHWHERE << "concurrent fitting is not available with the evaluator, fitting one track at a time" << std::endl;
+    }
+    else
+    {
+      m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+      m_workspaces.resize(m_threadpool->size());
+      if (Verbosity() > 0)
+      {
+        std::cout << "PHActsGSF::InitRun - fitting tracks with " << m_threadpool->size() << " threads" << std::endl;
+      }
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -143,122 +177,182 @@ int PHActsGSF::process_event(PHCompositeNode* topNode)
 
   auto logger = Acts::getDefaultLogger("PHActsGSF", logLevel);
 
+  std::vector<SvtxTrack*> svtxTracks;
+  svtxTracks.reserve(m_trackMap->size());
   for (const auto& [key, track] : *m_trackMap)
   {
-    auto pSurface = makePerigee(track);
-    if (!pSurface)
-    {
-      //! If no vertex was assigned to track, just skip it
-      continue;
-    }
-    const auto seed = makeSeed(track, pSurface);
+    svtxTracks.push_back(track);
+  }
 
-    auto svtxseed = new TrackSeed_v2();
-    std::map<TrkrDefs::cluskey, Acts::Vector3> clusterPositions;
-    for (auto& cKey : get_cluster_keys(track))
+  std::vector<double> fitTimes(svtxTracks.size(), -1);
+  if (m_threadpool)
+  {
+    // each thread slot owns a copy of the transient transforms, which are modified
+    // by the source link creation. Slot 0 uses the node tree transforms
+    for (auto& ws : m_workspaces)
     {
-      auto cluster = m_clusterContainer->findCluster(cKey);
-      auto globalPosition = m_tGeometry->getGlobalPosition(cKey, cluster);
-      clusterPositions.insert(std::make_pair(cKey, globalPosition));
-      svtxseed->insert_cluster_key(cKey);
-    }
-    svtxseed->set_phi(track->get_phi());
-    TrackSeedHelper::circleFitByTaubin(svtxseed,clusterPositions, 0, 57);
-    TrackSeedHelper::lineFit(svtxseed, clusterPositions, 7, 57);
-
-    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
-    TrackSeed* tpcseed = track->get_tpc_seed();
-    TrackSeed* silseed = track->get_silicon_seed();
+      if (!ws.transformMapTransient)
+      {
+        ws.ownedTransformMap = std::make_unique<alignmentTransformationContainer>(*m_alignmentTransformationMapTransient);
+        ws.transformMapTransient = ws.ownedTransformMap.get();
 
-    /// We only fit full sPHENIX tracks
-    if (!silseed or !tpcseed)
-    {
-      continue;
+        // transforms left modified by the last track fitted on slot 0 must be reset in the copy too
+        ws.transient_id_set = m_workspaces.front().transient_id_set;
+      }
     }
 
-    auto crossing = silseed->get_crossing();
-    if (crossing == SHRT_MAX)
+    // tracks are handed out one at a time, the GSF cost varies a lot between tracks
+    std::atomic<size_t> next_track{0};
+    m_threadpool->parallel_for(m_workspaces.size(), [&](size_t islot)
+                               {
+      auto& ws = m_workspaces[islot];
+      for (size_t itrack = next_track++; itrack < svtxTracks.size(); itrack = next_track++)
+      {
+        fitTimes[itrack] = fitSvtxTrack(svtxTracks[itrack], ws);
+      } });
+  }
+  else
+  {
+    for (size_t itrack = 0; itrack < svtxTracks.size(); ++itrack)
     {
-      continue;
+      fitTimes[itrack] = fitSvtxTrack(svtxTracks[itrack], m_workspaces.front());
     }
+  }
 
-    /*
-    auto sourceLinks = getSourceLinks(tpcseed, measurements, crossing);
-    auto silSourceLinks = getSourceLinks(silseed, measurements, crossing);
-    */
-
-    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-    MakeSourceLinks makeSourceLinks;
-    makeSourceLinks.setVerbosity(Verbosity());
-    makeSourceLinks.set_pp_mode(m_pp_mode);
-
-    makeSourceLinks.resetTransientTransformMap(
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        m_tGeometry);
-
-    // TPC source links
-    auto sourceLinks = makeSourceLinks.getSourceLinks(
-        tpcseed,
-        measurements,
-        m_clusterContainer,
-        m_tGeometry,
-        m_globalPositionWrapper,
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        crossing);
-
-    // silicon source links
-    auto silSourceLinks = makeSourceLinks.getSourceLinks(
-        silseed,
-        measurements,
-        m_clusterContainer,
-        m_tGeometry,
-        m_globalPositionWrapper,
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        crossing);
-
-    // copy transient map for this track into transient geoContext
-    m_transient_geocontext = m_alignmentTransformationMapTransient;
-
-    for (auto& siSL : silSourceLinks)
+  if (m_timeAnalysis)
+  {
+    for (size_t itrack = 0; itrack < svtxTracks.size(); ++itrack)
     {
-      sourceLinks.push_back(siSL);
+      if (fitTimes[itrack] >= 0)
+      {
+        h_fitTime->Fill(svtxTracks[itrack]->get_pt(), fitTimes[itrack]);
+      }
     }
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
 
-    auto calibptr = std::make_unique<Calibrator>();
-    CalibratorAdapter calibrator(*calibptr, measurements);
-    auto magcontext = m_tGeometry->geometry().magFieldContext;
-    auto calcontext = m_tGeometry->geometry().calibContext;
+double PHActsGSF::fitSvtxTrack(SvtxTrack* track, FitWorkspace& ws)
+{
+  auto pSurface = makePerigee(track);
+  if (!pSurface)
+  {
+    //! If no vertex was assigned to track, just skip it
+    return -1;
+  }
+  const auto seed = makeSeed(track, pSurface);
 
-    auto ppoptions = Acts::PropagatorPlainOptions();
+  auto svtxseed = std::make_unique<TrackSeed_v2>();
+  std::map<TrkrDefs::cluskey, Acts::Vector3> clusterPositions;
+  for (auto& cKey : get_cluster_keys(track))
+  {
+    auto cluster = m_clusterContainer->findCluster(cKey);
+    auto globalPosition = m_tGeometry->getGlobalPosition(cKey, cluster);
+    clusterPositions.insert(std::make_pair(cKey, globalPosition));
+    svtxseed->insert_cluster_key(cKey);
+  }
+  svtxseed->set_phi(track->get_phi());
+  TrackSeedHelper::circleFitByTaubin(svtxseed.get(), clusterPositions, 0, 57);
+  TrackSeedHelper::lineFit(svtxseed.get(), clusterPositions, 7, 57);
 
-    ActsTrackFittingAlgorithm::GeneralFitterOptions options{
-        m_transient_geocontext,
-        magcontext,
-        calcontext,
-        &(*pSurface),
-        ppoptions};
-    if (Verbosity() > 2)
-    {
-      std::cout << "calling gsf with position "
-                << seed.position(m_transient_geocontext).transpose()
-                << " and momentum " << seed.momentum().transpose()
-                << std::endl;
-    }
-    auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
-    auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
-    ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
-    auto result = fitTrack(sourceLinks, seed, options, calibrator, tracks);
+  ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+  TrackSeed* tpcseed = track->get_tpc_seed();
+  TrackSeed* silseed = track->get_silicon_seed();
 
-    if (result.ok())
-    {
-      updateTrack(result, track, tracks, svtxseed, measurements);
-    }
+  /// We only fit full sPHENIX tracks
+  if (!silseed or !tpcseed)
+  {
+    return -1;
   }
 
-  return Fun4AllReturnCodes::EVENT_OK;
+  auto crossing = silseed->get_crossing();
+  if (crossing == SHRT_MAX)
+  {
+    return -1;
+  }
+
+  /*
+  auto sourceLinks = getSourceLinks(tpcseed, measurements, crossing);
+  auto silSourceLinks = getSourceLinks(silseed, measurements, crossing);
+  */
+
+  // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+  MakeSourceLinks makeSourceLinks;
+  makeSourceLinks.setVerbosity(Verbosity());
+  makeSourceLinks.set_pp_mode(m_pp_mode);
+
+  makeSourceLinks.resetTransientTransformMap(
+      ws.transformMapTransient,
+      ws.transient_id_set,
+      m_tGeometry);
+
+  // TPC source links
+  auto sourceLinks = makeSourceLinks.getSourceLinks(
+      tpcseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      ws.transformMapTransient,
+      ws.transient_id_set,
+      crossing);
+
+  // silicon source links
+  auto silSourceLinks = makeSourceLinks.getSourceLinks(
+      silseed,
+      measurements,
+      m_clusterContainer,
+      m_tGeometry,
+      m_globalPositionWrapper,
+      ws.transformMapTransient,
+      ws.transient_id_set,
+      crossing);
+
+  // copy transient map for this track into transient geoContext
+  ws.transient_geocontext = ws.transformMapTransient;
+
+  for (auto& siSL : silSourceLinks)
+  {
+    sourceLinks.push_back(siSL);
+  }
+
+  auto calibptr = std::make_unique<Calibrator>();
+  CalibratorAdapter calibrator(*calibptr, measurements);
+  auto magcontext = m_tGeometry->geometry().magFieldContext;
+  auto calcontext = m_tGeometry->geometry().calibContext;
+
+  auto ppoptions = Acts::PropagatorPlainOptions();
+
+  ActsTrackFittingAlgorithm::GeneralFitterOptions options{
+      ws.transient_geocontext,
+      magcontext,
+      calcontext,
+      &(*pSurface),
+      ppoptions};
+  if (Verbosity() > 2)
+  {
+    std::cout << "calling gsf with position "
+              << seed.position(ws.transient_geocontext).transpose()
+              << " and momentum " << seed.momentum().transpose()
+              << std::endl;
+  }
+  auto trackContainer = std::make_shared<Acts::VectorTrackContainer>();
+  auto trackStateContainer = std::make_shared<Acts::VectorMultiTrajectory>();
+  ActsTrackFittingAlgorithm::TrackContainer tracks(trackContainer, trackStateContainer);
+
+  PHTimer fitTimer("FitTimer");
+  fitTimer.stop();
+  fitTimer.restart();
+  auto result = fitTrack(sourceLinks, seed, options, calibrator, tracks);
+  fitTimer.stop();
+
+  if (result.ok())
+  {
+    updateTrack(result, track, tracks, svtxseed.get(), measurements, ws.transient_geocontext);
+  }
+
+  return fitTimer.get_accumulated_time();
 }
 
 std::shared_ptr<Acts::PerigeeSurface> PHActsGSF::makePerigee(SvtxTrack* track) const
@@ -317,7 +411,8 @@ ActsTrackFittingAlgorithm::TrackFitterResult PHActsGSF::fitTrack(
 void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
                             ActsTrackFittingAlgorithm::TrackContainer& tracks,
                             const TrackSeed* seed,
-                            const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+                            const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                            const Acts::GeometryContext& geocontext)
 {
   std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
   trackTips.reserve(1);
@@ -329,7 +424,7 @@ void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
                                   ActsExamples::TrackParameters{outtrack.referenceSurface().getSharedPtr(),
                                                                 outtrack.parameters(), outtrack.covariance(), Acts::ParticleHypothesis::electron()}});
 
-  updateSvtxTrack(trackTips, indexedParams, tracks, track);
+  updateSvtxTrack(trackTips, indexedParams, tracks, track, geocontext);
 
   if (m_actsEvaluator)
   {
@@ -341,7 +436,8 @@ void PHActsGSF::updateTrack(FitResult& result, SvtxTrack* track,
 void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                                 Trajectory::IndexedParameters& paramsMap,
                                 ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                SvtxTrack* track)
+                                SvtxTrack* track,
+                                const Acts::GeometryContext& geocontext)
 {
   const auto& mj = tracks.trackStateContainer();
   const auto& tracktip = tips.front();
@@ -358,7 +454,7 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
               << "   (" << track->get_px() << ", " << track->get_py()
               << ", " << track->get_pz() << ")" << std::endl;
     std::cout << "New GSF track parameters: " << std::endl
-              << "   " << params.position(m_transient_geocontext).transpose()
+              << "   " << params.position(geocontext).transpose()
               << std::endl
               << "   " << params.momentum().transpose()
               << std::endl;
@@ -376,9 +472,9 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
   out.set_z(0.0);
   track->insert_state(&out);
 
-  track->set_x(params.position(m_transient_geocontext)(0) / Acts::UnitConstants::cm);
-  track->set_y(params.position(m_transient_geocontext)(1) / Acts::UnitConstants::cm);
-  track->set_z(params.position(m_transient_geocontext)(2) / Acts::UnitConstants::cm);
+  track->set_x(params.position(geocontext)(0) / Acts::UnitConstants::cm);
+  track->set_y(params.position(geocontext)(1) / Acts::UnitConstants::cm);
+  track->set_z(params.position(geocontext)(2) / Acts::UnitConstants::cm);
 
   track->set_px(params.momentum()(0));
   track->set_py(params.momentum()(1));
@@ -402,7 +498,7 @@ void PHActsGSF::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexTy
     }
   }
 
-  transformer.fillSvtxTrackStates(mj, tracktip, track, m_transient_geocontext);
+  transformer.fillSvtxTrackStates(mj, tracktip, track, geocontext);
 }
 
 //____________________________________________________________________________..
@@ -423,6 +519,14 @@ std::vector<TrkrDefs::cluskey> PHActsGSF::get_cluster_keys(SvtxTrack* track)
 //____________________________________________________________________________..
 int PHActsGSF::End(PHCompositeNode* /*unused*/)
 {
+  if (m_timeAnalysis)
+  {
+    m_timeFile->cd();
+    h_fitTime->Write();
+    m_timeFile->Write();
+    m_timeFile->Close();
+  }
+
   if (m_actsEvaluator)
   {
     m_evaluator->End();
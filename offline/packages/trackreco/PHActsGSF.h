@@ -7,12 +7,15 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/PHThreadPool.h>
+
 #include <tpc/TpcGlobalPositionWrapper.h>
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
 #include <trackbase/Calibrator.h>
 #include <trackbase/ClusterErrorPara.h>
+#include <trackbase/alignmentTransformationContainer.h>
 
 #include <Acts/Definitions/Algebra.hpp>
 #include <Acts/EventData/VectorMultiTrajectory.hpp>
@@ -24,8 +27,13 @@
 
 #include <ActsExamples/EventData/Trajectories.hpp>
 
+#include <TFile.h>
+#include <TH2.h>
 
+#include <memory>
+#include <set>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class ActsGeometry;
@@ -59,7 +67,37 @@ class PHActsGSF : public SubsysReco
     m_actsEvaluator = actsEvaluator;
   }
 
+  /// fit tracks concurrently on nthreads threads, 0 uses all cores.
+  /// Not available with the evaluator, which is filled during the fit
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
+  /// maximum number of mixture components kept after an update
+  void setMaxComponents(unsigned int n) { m_maxComponents = n; }
+
+  /// components below this weight are dropped, which lets a track with one
+  /// dominant component continue at the cost of a Kalman filter
+  void setWeightCutoff(double cutoff) { m_weightCutoff = cutoff; }
+
+  /// reduce the mixture by dropping the lightest components, cheaper than the
+  /// default merging of the closest components
+  void reduceByWeight(bool flag) { m_reduceByWeight = flag; }
+
+  /// write the fit time of each track vs pT to Name().root
+  void doTimeAnalysis(bool timeAnalysis) { m_timeAnalysis = timeAnalysis; }
+
  private:
+  /// transient transforms and geometry context used for the fit of one track at a time
+  struct FitWorkspace
+  {
+    /// TPC surface transforms are modified to apply the corrections of the current track
+    alignmentTransformationContainer* transformMapTransient = nullptr;
+    std::set<Acts::GeometryIdentifier> transient_id_set;
+    Acts::GeometryContext transient_geocontext;
+
+    /// per thread copy of the node tree transient transforms
+    std::unique_ptr<alignmentTransformationContainer> ownedTransformMap;
+  };
+
   int getNodes(PHCompositeNode* topNode);
   std::shared_ptr<Acts::PerigeeSurface> makePerigee(SvtxTrack* track) const;
   ActsTrackFittingAlgorithm::TrackParameters makeSeed(
@@ -68,6 +106,9 @@ class PHActsGSF : public SubsysReco
   //  SourceLinkVec getSourceLinks(TrackSeed* track,
   //                         ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
   //                         const short int& crossing);
+  /// refit one track in place, returns the fit time in ms or a negative value if it was not fitted
+  double fitSvtxTrack(SvtxTrack* track, FitWorkspace& ws);
+
   ActsTrackFittingAlgorithm::TrackFitterResult fitTrack(
       const std::vector<Acts::SourceLink>& sourceLinks,
       const ActsTrackFittingAlgorithm::TrackParameters& seed,
@@ -77,11 +118,13 @@ class PHActsGSF : public SubsysReco
 
   void updateTrack(FitResult& result, SvtxTrack* track,
                    ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                   const TrackSeed* seed, const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+                   const TrackSeed* seed, const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                   const Acts::GeometryContext& geocontext);
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                       SvtxTrack* track);
+                       SvtxTrack* track,
+                       const Acts::GeometryContext& geocontext);
   std::vector<TrkrDefs::cluskey> get_cluster_keys(SvtxTrack* track);
 
   ActsGeometry* m_tGeometry = nullptr;
@@ -91,8 +134,20 @@ class PHActsGSF : public SubsysReco
 
 //  alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
-  std::set< Acts::GeometryIdentifier> m_transient_id_set;
-  Acts::GeometryContext m_transient_geocontext;
+
+  /// one workspace per thread slot
+  std::vector<FitWorkspace> m_workspaces;
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
+  /// mixture reduction
+  unsigned int m_maxComponents = 12;
+  double m_weightCutoff = 1e-4;
+  bool m_reduceByWeight = false;
+
+  bool m_timeAnalysis = false;
+  TFile* m_timeFile = nullptr;
+  TH2* h_fitTime = nullptr;
 
   // Tpc Global position wrapper
   TpcGlobalPositionWrapper m_globalPositionWrapper;
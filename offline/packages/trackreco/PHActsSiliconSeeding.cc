@@ -45,6 +45,9 @@
 #include <Acts/Seeding/Seed.hpp>
 #include <Acts/Seeding/SeedFilter.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 namespace
 {
   template <class T>
@@ -100,6 +103,16 @@ int PHActsSiliconSeeding::InitRun(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHActsSiliconSeeding::InitRun - running the seed finder with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -132,6 +145,7 @@ int PHActsSiliconSeeding::process_event(PHCompositeNode* topNode)
   auto seederTime = eventTimer->get_accumulated_time();
   eventTimer->restart();
 
+  makeSensorIndex();
   makeSvtxTracks(seedVector);
 
   eventTimer->stop();
@@ -226,28 +240,106 @@ GridSeeds PHActsSiliconSeeding::runSeeder(std::vector<const SpacePoint*>& spVec)
       std::floor(rRangeSPExtent.min(Acts::binR) / 2) * 2 + 1.5,
       std::floor(rRangeSPExtent.max(Acts::binR) / 2) * 2 - 1.5);
 
-  GridSeeds seedVector;
-  SeedContainer seeds;
-  seeds.clear();
-  decltype(seedFinder)::SeedingState state;
-  state.spacePointData.resize(spVec.size(),
-                              m_seedFinderCfg.useDetailedDoubleMeasurementInfo);
-  for (const auto [bottom, middle, top] : spGroup)
+  /// the groups are ordered in phi, then z. Contiguous chunks of them
+  /// are phi sectors that can be searched independently
+  std::vector<std::decay_t<decltype(*spGroup.begin())>> groups;
+  for (const auto group : spGroup)
   {
-    seedFinder.createSeedsForGroup(m_seedFinderOptions,
-                                   state, spGroup.grid(),
-                                   std::back_inserter(seeds),
-                                   bottom,
-                                   middle,
-                                   top,
-                                   rMiddleSPRange);
+    groups.push_back(group);
   }
 
-  seedVector.push_back(seeds);
+  auto findSeeds = [&](size_t first, size_t last, SeedContainer& seeds)
+  {
+    /// the state keeps the seed quality of each space point
+    decltype(seedFinder)::SeedingState state;
+    state.spacePointData.resize(spVec.size(),
+                                m_seedFinderCfg.useDetailedDoubleMeasurementInfo);
+    for (size_t igroup = first; igroup < last; ++igroup)
+    {
+      const auto& [bottom, middle, top] = groups[igroup];
+      seedFinder.createSeedsForGroup(m_seedFinderOptions,
+                                     state, spGroup.grid(),
+                                     std::back_inserter(seeds),
+                                     bottom,
+                                     middle,
+                                     top,
+                                     rMiddleSPRange);
+    }
+  };
+
+  GridSeeds seedVector;
+  if (m_threadpool && groups.size() > 1)
+  {
+    const size_t nchunks = std::min<size_t>(groups.size(), 4 * m_threadpool->size());
+    std::vector<SeedContainer> chunkSeeds(nchunks);
+    m_threadpool->parallel_for(nchunks, [&](size_t ichunk)
+                               { findSeeds(ichunk * groups.size() / nchunks, (ichunk + 1) * groups.size() / nchunks, chunkSeeds[ichunk]); });
+
+    SeedContainer seeds;
+    for (auto& chunk : chunkSeeds)
+    {
+      seeds.insert(seeds.end(), chunk.begin(), chunk.end());
+    }
+    seedVector.push_back(seeds);
+  }
+  else
+  {
+    SeedContainer seeds;
+    findSeeds(0, groups.size(), seeds);
+    seedVector.push_back(seeds);
+  }
 
   return seedVector;
 }
 
+void PHActsSiliconSeeding::makeSensorIndex()
+{
+  for (auto& sensors : m_sensorIndex)
+  {
+    sensors.clear();
+  }
+
+  for (auto& det : {TrkrDefs::TrkrId::mvtxId, TrkrDefs::TrkrId::inttId})
+  {
+    for (const auto& hitsetkey : m_clusterMap->getHitSetKeys(det))
+    {
+      const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+      if (layer >= m_sensorIndex.size())
+      {
+        continue;
+      }
+
+      SensorClusters sensor;
+      sensor.surface = m_tGeometry->maps().getSiliconSurface(hitsetkey);
+      auto surfcenter = sensor.surface->center(m_tGeometry->geometry().geoContext);
+      sensor.phi = atan2(surfcenter.y(), surfcenter.x());
+
+      auto range = m_clusterMap->getClusters(hitsetkey);
+      for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+      {
+        const auto cluskey = clusIter->first;
+        if (_iteration_map != nullptr && m_nIteration > 0)
+        {
+          if (_iteration_map->getIteration(cluskey) < m_nIteration)
+          {
+            continue;  // skip clusters used in a previous iteration
+          }
+        }
+        sensor.clusters.emplace_back(cluskey, clusIter->second);
+        sensor.globalPositions.push_back(m_tGeometry->getGlobalPosition(cluskey, clusIter->second));
+      }
+
+      m_sensorIndex[layer].push_back(std::move(sensor));
+    }
+  }
+
+  for (auto& sensors : m_sensorIndex)
+  {
+    std::sort(sensors.begin(), sensors.end(), [](const SensorClusters& lhs, const SensorClusters& rhs)
+              { return lhs.phi < rhs.phi; });
+  }
+}
+
 void PHActsSiliconSeeding::makeSvtxTracks(GridSeeds& seedVector)
 {
   int numSeeds = 0;
@@ -603,36 +695,44 @@ std::vector<TrkrDefs::cluskey> PHActsSiliconSeeding::findMatches(
         layer++;
         continue;
       }
-      for (const auto& hitsetkey : m_clusterMap->getHitSetKeys(det, layer))
+      /// Check that the projection is within some reasonable amount of the segment
+      /// to reject e.g. looking at segments in the opposite hemisphere. This is about
+      /// the size of one intt segment (256 * 80 micron strips in a segment)
+      const double maxdphi = 0.2;
+      const auto& sensors = m_sensorIndex[layer];
+      std::vector<const SensorClusters*> candidates;
+      auto addSensors = [&](double phimin, double phimax)
       {
-        auto surf = m_tGeometry->maps().getSiliconSurface(hitsetkey);
-        auto surfcenter = surf->center(m_tGeometry->geometry().geoContext);
-        float surfphi = atan2(surfcenter.y(), surfcenter.x());
-        float dphi = normPhi2Pi(trackphi - surfphi);
-
-        /// Check that the projection is within some reasonable amount of the segment
-        /// to reject e.g. looking at segments in the opposite hemisphere. This is about
-        /// the size of one intt segment (256 * 80 micron strips in a segment)
-        if (fabs(dphi) > 0.2)
-        {
-          continue;
-        }
-
-        auto range = m_clusterMap->getClusters(hitsetkey);
-        for (auto clusIter = range.first; clusIter != range.second; ++clusIter)
+        auto low = std::lower_bound(sensors.begin(), sensors.end(), phimin, [](const SensorClusters& sensor, double phi)
+                                    { return sensor.phi < phi; });
+        for (auto iter = low; iter != sensors.end() && iter->phi <= phimax; ++iter)
         {
-          const auto cluskey = clusIter->first;
-          if (_iteration_map != nullptr && m_nIteration > 0)
+          if (fabs(normPhi2Pi(trackphi - iter->phi)) <= maxdphi)
           {
-            if (_iteration_map->getIteration(cluskey) < m_nIteration)
-            {
-              continue;  // skip clusters used in a previous iteration
-            }
+            candidates.push_back(&*iter);
           }
+        }
+      };
+      /// the sensor phi is in [-pi, pi], the window wraps around
+      const double phicenter = std::remainder(trackphi, 2. * M_PI);
+      addSensors(phicenter - maxdphi, phicenter + maxdphi);
+      if (phicenter - maxdphi < -M_PI)
+      {
+        addSensors(phicenter - maxdphi + 2. * M_PI, M_PI);
+      }
+      if (phicenter + maxdphi > M_PI)
+      {
+        addSensors(-M_PI, phicenter + maxdphi - 2. * M_PI);
+      }
 
-          const auto cluster = clusIter->second;
-          auto glob = m_tGeometry->getGlobalPosition(
-              cluskey, cluster);
+      for (const auto* sensor : candidates)
+      {
+        const auto& surf = sensor->surface;
+        for (size_t iclus = 0; iclus < sensor->clusters.size(); ++iclus)
+        {
+          const auto cluskey = sensor->clusters[iclus].first;
+          const auto cluster = sensor->clusters[iclus].second;
+          auto glob = sensor->globalPositions[iclus];
           auto intersection = TrackFitUtils::get_helix_surface_intersection(surf, fitpars, glob, m_tGeometry);
           auto local = (surf->transform(m_tGeometry->geometry().getGeoContext())).inverse() * (intersection * Acts::UnitConstants::cm);
           local /= Acts::UnitConstants::cm;
@@ -649,8 +749,7 @@ std::vector<TrkrDefs::cluskey> PHActsSiliconSeeding::findMatches(
           /// Diagnostic
           if (m_seedAnalysis)
           {
-            const auto globalP = m_tGeometry->getGlobalPosition(
-                cluskey, cluster);
+            const auto& globalP = glob;
             m_clusgx = globalP.x();
             m_clusgy = globalP.y();
             m_clusgr = std::sqrt(square(globalP.x()) + square(globalP.y()));
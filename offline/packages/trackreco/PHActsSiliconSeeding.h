@@ -2,6 +2,7 @@
 #define TRACKRECO_PHACTSSILICONSEEDING_H
 
 #include <fun4all/SubsysReco.h>
+#include <phool/PHThreadPool.h>
 #include <trackbase/ActsGeometry.h>
 #include <trackbase/ClusterErrorPara.h>
 #include <trackbase/TrkrDefs.h>
@@ -20,8 +21,12 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <TTree.h>
+#include <array>
 #include <map>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 class PHCompositeNode;
 class PHG4CylinderGeomContainer;
@@ -158,12 +163,28 @@ class PHActsSiliconSeeding : public SubsysReco
   void iteration(int iter) { m_nIteration = iter; }
   void searchInIntt() { m_searchInIntt = true; }
 
+  /// number of threads the Acts seed finder runs with, split in phi
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
   int getNodes(PHCompositeNode *topNode);
   int createNodes(PHCompositeNode *topNode);
 
   GridSeeds runSeeder(std::vector<const SpacePoint *> &spVec);
 
+  /// Clusters of one silicon sensor, with their global positions
+  struct SensorClusters
+  {
+    Surface surface;
+    float phi = 0;
+    std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster *>> clusters;
+    std::vector<Acts::Vector3> globalPositions;
+  };
+
+  /// Index the silicon clusters of the event by layer and sensor phi
+  /// for the seed projections in findMatches
+  void makeSensorIndex();
+
   /// Configure the seeding parameters for Acts. There
   /// are a number of tunable parameters for the seeder here
   void configureSeeder();
@@ -307,6 +328,12 @@ class PHActsSiliconSeeding : public SubsysReco
   int m_nBadInitialFits = 0;
   TrkrClusterIterationMapv1 *_iteration_map = nullptr;
   int m_nIteration = 0;
+
+  /// sensors of each silicon layer sorted by phi, filled every event
+  std::array<std::vector<SensorClusters>, 7> m_sensorIndex;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
   std::string _track_map_name = "SiliconTrackSeedContainer";
   ClusterErrorPara _ClusErrPara;
 
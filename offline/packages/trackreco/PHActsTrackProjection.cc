@@ -35,6 +35,8 @@
 #include <CLHEP/Vector/ThreeVector.h>
 #include <math.h>
 
+#include <algorithm>
+
 PHActsTrackProjection::PHActsTrackProjection(const std::string& name)
   : SubsysReco(name)
 {
@@ -70,6 +72,16 @@ int PHActsTrackProjection::InitRun(PHCompositeNode* topNode)
     ret = Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHActsTrackProjection::InitRun - projecting tracks with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   if (Verbosity() > 1)
   {
     std::cout << "PHActsTrackProjection finished Init" << std::endl;
@@ -86,6 +98,8 @@ int PHActsTrackProjection::process_event(PHCompositeNode* topNode)
               << m_event << std::endl;
   }
 
+  /// inner and outer surfaces of all calos present in this event
+  std::vector<int> caloLayers;
   for (int layer = 0; layer < m_nCaloLayers; layer++)
   {
     if (Verbosity() > 1)
@@ -99,12 +113,23 @@ int PHActsTrackProjection::process_event(PHCompositeNode* topNode)
       continue;
     }
 
-    int ret = projectTracks(layer);
-    if (ret != Fun4AllReturnCodes::EVENT_OK)
+    /// surfaces are only made for the calos present at InitRun
+    if (m_caloSurfaces.find(m_caloNames.at(layer)) == m_caloSurfaces.end())
     {
-      return Fun4AllReturnCodes::ABORTEVENT;
+      continue;
     }
-    ret = projectTracks(layer+m_nCaloLayers);
+
+    caloLayers.push_back(layer);
+    caloLayers.push_back(layer + m_nCaloLayers);
+  }
+
+  /// the surfaces are visited from the inside out by a single propagation
+  std::stable_sort(caloLayers.begin(), caloLayers.end(), [this](int lhs, int rhs)
+                   { return m_caloRadii.at(m_caloTypes.at(lhs)) < m_caloRadii.at(m_caloTypes.at(rhs)); });
+
+  if (!caloLayers.empty())
+  {
+    int ret = projectTracks(caloLayers);
     if (ret != Fun4AllReturnCodes::EVENT_OK)
     {
       return Fun4AllReturnCodes::ABORTEVENT;
@@ -132,23 +157,55 @@ int PHActsTrackProjection::End(PHCompositeNode* /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-int PHActsTrackProjection::projectTracks(const int caloLayer)
+int PHActsTrackProjection::projectTracks(const std::vector<int>& caloLayers)
 {
+  std::vector<SurfacePtr> surfaces;
+  for (const auto& caloLayer : caloLayers)
+  {
+    surfaces.push_back(m_caloSurfaces.find(m_caloNames.at(caloLayer))->second);
+  }
+
   ActsPropagator prop(m_tGeometry);
+  prop.constField();
+  prop.verbosity(Verbosity());
+  prop.setConstFieldValue(m_constFieldVal * Acts::UnitConstants::T);
+
+  std::vector<SvtxTrack*> tracks;
+  tracks.reserve(m_trackMap->size());
   for (const auto& [key, track] : *m_trackMap)
   {
+    tracks.push_back(track);
+  }
+
+  /// the tracks are independent, each task only adds states to its own track
+  auto project = [&](size_t itrack)
+  {
+    SvtxTrack* track = tracks[itrack];
     auto params = prop.makeTrackParams(track, m_vertexMap);
-    if(!params.ok())
+    if (!params.ok())
+    {
+      return;
+    }
+
+    auto results = prop.propagateTrackFast(params.value(), surfaces);
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      if (results[i].ok())
       {
-	continue;
+        updateSvtxTrack(results[i].value(), track, caloLayers[i]);
       }
-    auto cylSurf =
-        m_caloSurfaces.find(m_caloNames.at(caloLayer))->second;
+    }
+  };
 
-    auto result = propagateTrack(params.value(), caloLayer, cylSurf);
-    if (result.ok())
+  if (m_threadpool && Verbosity() <= 1 && tracks.size() > 1)
+  {
+    m_threadpool->parallel_for(tracks.size(), project);
+  }
+  else
+  {
+    for (size_t itrack = 0; itrack < tracks.size(); ++itrack)
     {
-      updateSvtxTrack(result.value(), track, caloLayer);
+      project(itrack);
     }
   }
 
@@ -213,8 +270,7 @@ void PHActsTrackProjection::getClusterProperties(double phi,
     }
     return;
   }
-  auto clusterMap = m_clusterContainer->getClustersMap();
-  for (const auto& [key, cluster] : clusterMap)
+  for (const auto& [key, cluster] : m_clusterContainer->getClustersMap())
   {
     const auto clusterEta =
         RawClusterUtility::GetPseudorapidity(*cluster,
@@ -271,20 +327,6 @@ void PHActsTrackProjection::getSquareTowerEnergies(int phiBin,
   return;
 }
 
-PHActsTrackProjection::BoundTrackParamResult
-PHActsTrackProjection::propagateTrack(
-    const Acts::BoundTrackParameters& params,
-    const int /*caloLayer*/,
-    const SurfacePtr& targetSurf)
-{
-  ActsPropagator propagator(m_tGeometry);
-  propagator.constField();
-  propagator.verbosity(Verbosity());
-  propagator.setConstFieldValue(m_constFieldVal * Acts::UnitConstants::T);
-
-  return propagator.propagateTrackFast(params, targetSurf);
-}
-
 int PHActsTrackProjection::setCaloContainerNodes(PHCompositeNode* topNode,
                                                  const int caloLayer)
 {
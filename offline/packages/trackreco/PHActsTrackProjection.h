@@ -2,6 +2,7 @@
 #define TRACKRECO_PHACTSTRACKPROJECTION_H
 
 #include <fun4all/SubsysReco.h>
+#include <phool/PHThreadPool.h>
 #include <trackbase/TrkrDefs.h>
 #include <trackbase_historic/SvtxTrack.h>
 
@@ -27,6 +28,7 @@ class SvtxVertexMap;
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 /**
  * This class takes final fitted tracks from the Acts track fitting
@@ -54,6 +56,9 @@ class PHActsTrackProjection : public SubsysReco
   void useConstField(bool field) { m_constField = field; }
   void setConstFieldVal(float b) { m_constFieldVal = b; }
 
+  /// number of threads the tracks are projected with
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
   /// Set an arbitrary radius to project to, in cm
   void setLayerRadius(SvtxTrack::CAL_LAYER layer,
                       const float rad)
@@ -70,13 +75,8 @@ class PHActsTrackProjection : public SubsysReco
 
  private:
   int getNodes(PHCompositeNode *topNode);
-  int projectTracks(int caloLayer);
-
-  /// Propagate the fitted track parameters to a surface with Acts
-  BoundTrackParamResult propagateTrack(
-      const Acts::BoundTrackParameters &params,
-      const int caloLayer,
-      const SurfacePtr &targetSurf);
+  /// Project all tracks to the given calo layers, sorted by radius
+  int projectTracks(const std::vector<int> &caloLayers);
 
   /// Set the particular calo nodes depending on which layer
   int setCaloContainerNodes(PHCompositeNode *topNode,
@@ -125,6 +125,9 @@ class PHActsTrackProjection : public SubsysReco
   bool m_useCemcPosRecalib = false;
   bool m_calosAvailable = true;
 
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   int m_event = 0;
 };
 
@@ -41,7 +41,9 @@
 #include <phool/PHNode.h>
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>
+#include <phool/PHCounter.h>
 #include <phool/PHTimer.h>
+#include <phool/PHTrace.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
@@ -54,6 +56,7 @@
 #include <Acts/TrackFitting/GainMatrixSmoother.hpp>
 #include <Acts/TrackFitting/GainMatrixUpdater.hpp>
 
+#include <atomic>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
@@ -73,7 +76,6 @@ namespace
   }
 }  // namespace
 
-#include <trackbase/alignmentTransformationContainer.h>
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
 
@@ -140,6 +142,12 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
     m_fitCfg.fit->outlierFinder(m_outlierFinder);
   }
 
+  PHCounterRegistry* counters = PHCounterRegistry::instance();
+  m_cnt_fits = counters->get(Name(), "fits");
+  m_cnt_failed_fits = counters->get(Name(), "failed_fits");
+  m_cnt_measurements = counters->get(Name(), "measurements");
+  m_cnt_outliers = counters->get(Name(), "outliers");
+
   if (m_timeAnalysis)
   {
     m_timeFile = new TFile(std::string(Name() + ".root").c_str(),
@@ -166,6 +174,30 @@ int PHActsTrkFitter::InitRun(PHCompositeNode* topNode)
 
   _tpccellgeo = findNode::getClass<PHG4TpcCylinderGeomContainer>(topNode, "CYLINDERCELLGEOM_SVTX");
 
+  // slot 0 works directly on the node tree transient transforms
+  m_workspaces.clear();
+  m_workspaces.resize(1);
+  m_workspaces.front().transformMapTransient = m_alignmentTransformationMapTransient;
+
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    // the evaluator, alignment states and timing histograms are filled during the fit
+    if (m_actsEvaluator || m_commissioning || m_timeAnalysis)
+    {
+      std::cout << PHWHERE << "concurrent fitting is not available with the evaluator, commissioning or time analysis, fitting one seed at a time" << std::endl;
+    }
+    else
+    {
+      m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+      m_workspaces.resize(m_threadpool->size());
+      if (Verbosity() > 0)
+      {
+        std::cout << "PHActsTrkFitter::InitRun - fitting seeds with " << m_threadpool->size() << " threads" << std::endl;
+      }
+    }
+  }
+
   if (Verbosity() > 1)
   {
     std::cout << "Finish PHActsTrkFitter Setup" << std::endl;
@@ -294,96 +326,173 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
     std::cout << " seed map size " << m_seedMap->size() << std::endl;
   }
 
+  if (m_threadpool)
+  {
+    loopTracksConcurrent();
+    return;
+  }
+
   for (auto track : *m_seedMap)
   {
-    if (!track)
+    SeedFitOutput output;
+    fitSeed(track, m_workspaces.front(), output);
+    storeSeedFit(output);
+  }
+
+  return;
+}
+
+void PHActsTrkFitter::loopTracksConcurrent()
+{
+  // each thread slot owns a copy of the transient transforms, which are modified
+  // by the source link creation. Slot 0 uses the node tree transforms
+  for (auto& ws : m_workspaces)
+  {
+    if (!ws.transformMapTransient)
     {
-      continue;
+      ws.ownedTransformMap = std::make_unique<alignmentTransformationContainer>(*m_alignmentTransformationMapTransient);
+      ws.transformMapTransient = ws.ownedTransformMap.get();
+
+      // transforms left modified by the last track fitted on slot 0 must be reset in the copy too
+      ws.transient_id_set = m_workspaces.front().transient_id_set;
     }
+  }
 
-    unsigned int tpcid = track->get_tpc_seed_index();
-    unsigned int siid = track->get_silicon_seed_index();
+  // seeds are handed out one at a time, results are stored in seed order
+  const size_t nseeds = m_seedMap->size();
+  std::vector<SeedFitOutput> outputs(nseeds);
+  std::atomic<size_t> next_seed{0};
+  m_threadpool->parallel_for(m_workspaces.size(), [&](size_t islot)
+                             {
+    auto& ws = m_workspaces[islot];
+    for (size_t iseed = next_seed++; iseed < nseeds; iseed = next_seed++)
+    {
+      fitSeed(m_seedMap->get(iseed), ws, outputs[iseed]);
+    } });
 
-    // capture the input crossing value, and set crossing parameters
-    //==============================
-    short silicon_crossing =  SHRT_MAX;
-    auto siseed = m_siliconSeeds->get(siid);
-    if(siseed)
-      {
+  for (auto& output : outputs)
+  {
+    storeSeedFit(output);
+  }
+}
+
+void PHActsTrkFitter::storeSeedFit(SeedFitOutput& output)
+{
+  m_nBadFits += output.nBadFits;
+
+  SvtxTrackMap* trackMap = output.directed ? m_directedTrackMap : m_trackMap;
+  unsigned int trid = 0;
+  unsigned int fit_trid = 0;
+  if (output.track)
+  {
+    // the id used during the fit is only final when fitting one seed at a time
+    trid = trackMap->size();
+    fit_trid = output.track->get_id();
+    output.track->set_id(trid);
+  }
+
+  for (auto& [key, trajectory] : output.trajectories)
+  {
+    const unsigned int id = (output.track && key == fit_trid) ? trid : key;
+    m_trajectories->insert(std::make_pair(id, trajectory));
+  }
+
+  if (output.track)
+  {
+    trackMap->insertWithKey(output.track.get(), trid);
+  }
+}
+
+void PHActsTrkFitter::fitSeed(TrackSeed* track, FitWorkspace& ws, SeedFitOutput& output)
+{
+  if (!track)
+  {
+    return;
+  }
+
+  unsigned int tpcid = track->get_tpc_seed_index();
+  unsigned int siid = track->get_silicon_seed_index();
+
+  // capture the input crossing value, and set crossing parameters
+  //==============================
+  short silicon_crossing =  SHRT_MAX;
+  auto siseed = m_siliconSeeds->get(siid);
+  if(siseed)
+    {
 	silicon_crossing = siseed->get_crossing();
-      }
-    short crossing = silicon_crossing;
-    short int crossing_estimate = crossing;
+    }
+  short crossing = silicon_crossing;
+  short int crossing_estimate = crossing;
 
-    if(m_enable_crossing_estimate)
-      {
+  if(m_enable_crossing_estimate)
+    {
 	crossing_estimate = track->get_crossing_estimate();  // geometric crossing estimate from matcher
-     }
-    //===============================
+   }
+  //===============================
 
 
-    // must have silicon seed with valid crossing if we are doing a SC calibration fit
-    if (m_fitSiliconMMs)
-      {
+  // must have silicon seed with valid crossing if we are doing a SC calibration fit
+  if (m_fitSiliconMMs)
+    {
 	if( (siid == std::numeric_limits<unsigned int>::max()) || (silicon_crossing == SHRT_MAX))
 	  {
-	    continue;
+	    return;
 	  }
-      }
+    }
 
-    // do not skip TPC only tracks, just set crossing to the nominal zero
-    if(!siseed)
-      {
+  // do not skip TPC only tracks, just set crossing to the nominal zero
+  if(!siseed)
+    {
 	crossing = 0;
-      }
+    }
 
-    if (Verbosity() > 1)
-    {
-      if(siseed)
+  if (Verbosity() > 1)
+  {
+    if(siseed)
 	{
 	  std::cout << "tpc and si id " << tpcid << ", " << siid << " silicon_crossing " << silicon_crossing
 		    << " crossing " << crossing << " crossing estimate " << crossing_estimate << std::endl;
 	}
-    }
+  }
 
-    auto tpcseed = m_tpcSeeds->get(tpcid);
+  auto tpcseed = m_tpcSeeds->get(tpcid);
 
-    /// Need to also check that the tpc seed wasn't removed by the ghost finder
-    if (!tpcseed)
-    {
-      std::cout << "no tpc seed" << std::endl;
-      continue;
-    }
+  /// Need to also check that the tpc seed wasn't removed by the ghost finder
+  if (!tpcseed)
+  {
+    std::cout << "no tpc seed" << std::endl;
+    return;
+  }
 
-    if (Verbosity() > 0)
+  if (Verbosity() > 0)
+  {
+    if (siseed)
     {
-      if (siseed)
-      {
-        const auto si_position = TrackSeedHelper::get_xyz(siseed);
-        const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
-        std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
-        std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
-      }
+      const auto si_position = TrackSeedHelper::get_xyz(siseed);
+      const auto tpc_position = TrackSeedHelper::get_xyz(tpcseed);
+      std::cout << "    silicon seed position is (x,y,z) = " << si_position.x() << "  " << si_position.y() << "  " << si_position.z() << std::endl;
+      std::cout << "    tpc seed position is (x,y,z) = " << tpc_position.x() << "  " << tpc_position.y() << "  " << tpc_position.z() << std::endl;
     }
+  }
 
-    PHTimer trackTimer("TrackTimer");
-    trackTimer.stop();
-    trackTimer.restart();
+  PHTimer trackTimer("TrackTimer");
+  trackTimer.stop();
+  trackTimer.restart();
 
-    if (Verbosity() > 1 && siseed)
-    {
-      std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
-        << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
-    }
+  if (Verbosity() > 1 && siseed)
+  {
+    std::cout << " m_pp_mode " << m_pp_mode << " m_enable_crossing_estimate " << m_enable_crossing_estimate
+      << " INTT crossing " << crossing << " crossing_estimate " << crossing_estimate << std::endl;
+  }
 
-    short int this_crossing = crossing;
-    bool use_estimate = false;
-    short int nvary = 0;
-    std::vector<float> chisq_ndf;
-    std::vector<SvtxTrack_v4> svtx_vec;
+  short int this_crossing = crossing;
+  bool use_estimate = false;
+  short int nvary = 0;
+  std::vector<float> chisq_ndf;
+  std::vector<SvtxTrack_v4> svtx_vec;
 
-    if(m_pp_mode)
-      {
+  if(m_pp_mode)
+    {
 	if (m_enable_crossing_estimate && crossing == SHRT_MAX)
 	  {
 	    // this only happens if there is a silicon seed but no assigned INTT crossing, and only in pp_mode
@@ -400,366 +509,376 @@ void PHActsTrkFitter::loopTracks(Acts::Logging::Level logLevel)
 	    // use INTT crossing
 	    crossing_estimate = crossing;
 	  }
-      }
-    else
-      {
+    }
+  else
+    {
 	// non pp mode, we want only crossing zero, veto others
 	if(siseed && silicon_crossing != 0)
 	  {
-	    continue;
+	    return;
 	  }
 	crossing_estimate = crossing;
-      }
+    }
 
-    // Fit this track assuming either:
-    //    crossing = INTT value, if it exists (uses nvary = 0)
-    //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
+  // Fit this track assuming either:
+  //    crossing = INTT value, if it exists (uses nvary = 0)
+  //    crossing = crossing_estimate +/- max_bunch_search, if no INTT value exists and m_enable_crossing_estimate flag is set.
 
-    for (short int ivary = -nvary; ivary <= nvary; ++ivary)
-    {
-      this_crossing = crossing_estimate + ivary;
+  for (short int ivary = -nvary; ivary <= nvary; ++ivary)
+  {
+    this_crossing = crossing_estimate + ivary;
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      std::cout << "   nvary " << nvary << " trial fit with ivary " << ivary << " this_crossing = " << this_crossing << std::endl;
+    }
 
-      ActsTrackFittingAlgorithm::MeasurementContainer measurements;
+    ActsTrackFittingAlgorithm::MeasurementContainer measurements;
 
-      SourceLinkVec sourceLinks;
+    SourceLinkVec sourceLinks;
 
-      MakeSourceLinks makeSourceLinks;
-      makeSourceLinks.initialize(_tpccellgeo);
-      makeSourceLinks.setVerbosity(Verbosity());
-      makeSourceLinks.set_pp_mode(m_pp_mode);
+    MakeSourceLinks makeSourceLinks;
+    makeSourceLinks.initialize(_tpccellgeo);
+    makeSourceLinks.setVerbosity(Verbosity());
+    makeSourceLinks.set_pp_mode(m_pp_mode);
 
-      // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
-      // does nothing if m_transient_id_set is empty
-      makeSourceLinks.resetTransientTransformMap(
-        m_alignmentTransformationMapTransient,
-        m_transient_id_set,
-        m_tGeometry);
+    // loop over modifiedTransformSet and replace transient elements modified for the previous track with the default transforms
+    // does nothing if the transient id set is empty
+    makeSourceLinks.resetTransientTransformMap(
+      ws.transformMapTransient,
+      ws.transient_id_set,
+      m_tGeometry);
 
-      // make source links using cluster mover
-      if (m_use_clustermover)
+    // make source links using cluster mover
+    if (m_use_clustermover)
+    {
+      if (siseed && !m_ignoreSilicon)
       {
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            this_crossing);
-        }
-
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
-          tpcseed,
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+          siseed,
           measurements,
           m_clusterContainer,
           m_tGeometry,
           m_globalPositionWrapper,
           this_crossing);
-
-        // add silicon seeds
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
-      else
-      {
-        if (siseed && !m_ignoreSilicon)
-        {
-          // silicon source links
-          sourceLinks = makeSourceLinks.getSourceLinks(
-            siseed,
-            measurements,
-            m_clusterContainer,
-            m_tGeometry,
-            m_globalPositionWrapper,
-            m_alignmentTransformationMapTransient,
-            m_transient_id_set,
-            this_crossing);
-        }
 
-        // tpc source links
-        const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
-          tpcseed,
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinksClusterMover(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        this_crossing);
+
+      // add silicon seeds
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
+    else
+    {
+      if (siseed && !m_ignoreSilicon)
+      {
+        // silicon source links
+        sourceLinks = makeSourceLinks.getSourceLinks(
+          siseed,
           measurements,
           m_clusterContainer,
           m_tGeometry,
           m_globalPositionWrapper,
-          m_alignmentTransformationMapTransient,
-          m_transient_id_set,
+          ws.transformMapTransient,
+          ws.transient_id_set,
           this_crossing);
-
-        // insert silicons
-        sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
       }
 
-      // copy transient map for this track into transient geoContext
-      m_transient_geocontext = m_alignmentTransformationMapTransient;
+      // tpc source links
+      const auto tpcSourceLinks = makeSourceLinks.getSourceLinks(
+        tpcseed,
+        measurements,
+        m_clusterContainer,
+        m_tGeometry,
+        m_globalPositionWrapper,
+        ws.transformMapTransient,
+        ws.transient_id_set,
+        this_crossing);
+
+      // insert silicons
+      sourceLinks.insert(sourceLinks.end(), tpcSourceLinks.begin(), tpcSourceLinks.end());
+    }
 
-      // position comes from the silicon seed, unless there is no silicon seed
-      Acts::Vector3 position(0, 0, 0);
-      if (siseed)
-      {
-        position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
-      }
-      if(!siseed || !is_valid(position) || m_ignoreSilicon)
-      {
-        position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
-      }
-      if (!is_valid(position))
-      {
-       if(Verbosity() > 4)
-        {
-          std::cout << "Invalid position of " << position.transpose() << std::endl;
-        }
-        continue;
-      }
+    // copy transient map for this track into transient geoContext
+    ws.transient_geocontext = ws.transformMapTransient;
 
-      if (sourceLinks.empty())
+    // position comes from the silicon seed, unless there is no silicon seed
+    Acts::Vector3 position(0, 0, 0);
+    if (siseed)
+    {
+      position = TrackSeedHelper::get_xyz(siseed)*Acts::UnitConstants::cm;
+    }
+    if(!siseed || !is_valid(position) || m_ignoreSilicon)
+    {
+      position = TrackSeedHelper::get_xyz(tpcseed)*Acts::UnitConstants::cm;
+    }
+    if (!is_valid(position))
+    {
+     if(Verbosity() > 4)
       {
-        continue;
+        std::cout << "Invalid position of " << position.transpose() << std::endl;
       }
+      continue;
+    }
 
-      /// If using directed navigation, collect surface list to navigate
-      SurfacePtrVec surfaces;
-      if (m_fitSiliconMMs)
-      {
-        sourceLinks = getSurfaceVector(sourceLinks, surfaces);
-
-        // skip if there is no surfaces
-        if (surfaces.empty())
-        {
-          continue;
-        }
+    if (sourceLinks.empty())
+    {
+      continue;
+    }
 
-        // make sure micromegas are in the tracks, if required
-        if (m_useMicromegas &&
-            std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
-                         { return m_tGeometry->maps().isMicromegasSurface(surface); }))
-        {
-          continue;
-        }
-      }
+    /// If using directed navigation, collect surface list to navigate
+    SurfacePtrVec surfaces;
+    if (m_fitSiliconMMs)
+    {
+      sourceLinks = getSurfaceVector(sourceLinks, surfaces);
 
-      float px = std::numeric_limits<float>::quiet_NaN();
-      float py = std::numeric_limits<float>::quiet_NaN();
-      float pz = std::numeric_limits<float>::quiet_NaN();
-      if (m_ConstField)
+      // skip if there is no surfaces
+      if (surfaces.empty())
       {
-        float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
-        float phi = tpcseed->get_phi();
-        px = pt * std::cos(phi);
-        py = pt * std::sin(phi);
-        pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
+        continue;
       }
-      else
+
+      // make sure micromegas are in the tracks, if required
+      if (m_useMicromegas &&
+          std::none_of(surfaces.begin(), surfaces.end(), [this](const auto& surface)
+                       { return m_tGeometry->maps().isMicromegasSurface(surface); }))
       {
-        px = tpcseed->get_px();
-        py = tpcseed->get_py();
-        pz = tpcseed->get_pz();
+        continue;
       }
+    }
 
-      Acts::Vector3 momentum(px, py, pz);
-      if (!is_valid(momentum))
+    float px = std::numeric_limits<float>::quiet_NaN();
+    float py = std::numeric_limits<float>::quiet_NaN();
+    float pz = std::numeric_limits<float>::quiet_NaN();
+    if (m_ConstField)
+    {
+      float pt = fabs(1. / tpcseed->get_qOverR()) * (0.3 / 100) * fieldstrength;
+      float phi = tpcseed->get_phi();
+      px = pt * std::cos(phi);
+      py = pt * std::sin(phi);
+      pz = pt * std::cosh(tpcseed->get_eta()) * std::cos(tpcseed->get_theta());
+    }
+    else
+    {
+      px = tpcseed->get_px();
+      py = tpcseed->get_py();
+      pz = tpcseed->get_pz();
+    }
+
+    Acts::Vector3 momentum(px, py, pz);
+    if (!is_valid(momentum))
+    {
+      if(Verbosity() > 4)
       {
-        if(Verbosity() > 4)
-        {
-          std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
-        }
-        continue;
+        std::cout << "Invalid momentum of " << momentum.transpose() << std::endl;
       }
+      continue;
+    }
 
-      auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
-          position);
+    auto pSurface = Acts::Surface::makeShared<Acts::PerigeeSurface>(
+        position);
 
-      auto actsFourPos = Acts::Vector4(position(0), position(1),
-                                       position(2),
-                                       10 * Acts::UnitConstants::ns);
-      Acts::BoundSquareMatrix cov = setDefaultCovariance();
+    auto actsFourPos = Acts::Vector4(position(0), position(1),
+                                     position(2),
+                                     10 * Acts::UnitConstants::ns);
+    Acts::BoundSquareMatrix cov = setDefaultCovariance();
 
-      int charge = tpcseed->get_charge();
+    int charge = tpcseed->get_charge();
 
-      /// Reset the track seed with the dummy covariance
-      auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
-                      pSurface,
-                      m_transient_geocontext,
-                      actsFourPos,
-                      momentum,
-                      charge / momentum.norm(),
-                      cov,
-                      Acts::ParticleHypothesis::pion())
-                      .value();
+    /// Reset the track seed with the dummy covariance
+    auto seed = ActsTrackFittingAlgorithm::TrackParameters::create(
+                    pSurface,
+                    ws.transient_geocontext,
+                    actsFourPos,
+                    momentum,
+                    charge / momentum.norm(),
+                    cov,
+                    Acts::ParticleHypothesis::pion())
+                    .value();
 
-      if (Verbosity() > 2)
-      {
-        printTrackSeed(seed);
-      }
+    if (Verbosity() > 2)
+    {
+      printTrackSeed(seed, ws.transient_geocontext);
+    }
 
-      /// Set host of propagator options for Acts to do e.g. material integration
-      Acts::PropagatorPlainOptions ppPlainOptions;
+    /// Set host of propagator options for Acts to do e.g. material integration
+    Acts::PropagatorPlainOptions ppPlainOptions;
 
-      auto calibptr = std::make_unique<Calibrator>();
-      CalibratorAdapter calibrator{*calibptr, measurements};
+    auto calibptr = std::make_unique<Calibrator>();
+    CalibratorAdapter calibrator{*calibptr, measurements};
 
-      auto magcontext = m_tGeometry->geometry().magFieldContext;
-      auto calibcontext = m_tGeometry->geometry().calibContext;
+    auto magcontext = m_tGeometry->geometry().magFieldContext;
+    auto calibcontext = m_tGeometry->geometry().calibContext;
 
-      ActsTrackFittingAlgorithm::GeneralFitterOptions
-          kfOptions{
-              m_transient_geocontext,
-              magcontext,
-              calibcontext,
-              pSurface.get(),
-              ppPlainOptions};
+    ActsTrackFittingAlgorithm::GeneralFitterOptions
+        kfOptions{
+            ws.transient_geocontext,
+            magcontext,
+            calibcontext,
+            pSurface.get(),
+            ppPlainOptions};
 
-      PHTimer fitTimer("FitTimer");
-      fitTimer.stop();
-      fitTimer.restart();
+    PHTimer fitTimer("FitTimer");
+    fitTimer.stop();
+    fitTimer.restart();
 
-      auto trackContainer =
-          std::make_shared<Acts::VectorTrackContainer>();
-      auto trackStateContainer =
-          std::make_shared<Acts::VectorMultiTrajectory>();
-      ActsTrackFittingAlgorithm::TrackContainer
-          tracks(trackContainer, trackStateContainer);
+    auto trackContainer =
+        std::make_shared<Acts::VectorTrackContainer>();
+    auto trackStateContainer =
+        std::make_shared<Acts::VectorMultiTrajectory>();
+    ActsTrackFittingAlgorithm::TrackContainer
+        tracks(trackContainer, trackStateContainer);
 
-      auto result = fitTrack(sourceLinks, seed, kfOptions,
-                             surfaces, calibrator, tracks);
-      fitTimer.stop();
-      auto fitTime = fitTimer.get_accumulated_time();
+    auto result = [&]
+    {
+      PHTRACE_SCOPE("PHActsTrkFitter::fitTrack");
+      m_cnt_fits->add();
+      return fitTrack(sourceLinks, seed, kfOptions,
+                      surfaces, calibrator, tracks);
+    }();
+    fitTimer.stop();
+    auto fitTime = fitTimer.get_accumulated_time();
 
-      if (Verbosity() > 1)
-      {
-        std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
-      }
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHActsTrkFitter Acts fit time " << fitTime << std::endl;
+    }
 
-      /// Check that the track fit result did not return an error
-      if (result.ok())
+    /// Check that the track fit result did not return an error
+    if (result.ok())
+    {
+      if (use_estimate)  // trial variation case
       {
-        if (use_estimate)  // trial variation case
-        {
-          // this is a trial variation of the crossing estimate for this track
-          // Capture the chisq/ndf so we can choose the best one after all trials
+        // this is a trial variation of the crossing estimate for this track
+        // Capture the chisq/ndf so we can choose the best one after all trials
 
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+        SvtxTrack_v4 newTrack;
+        newTrack.set_tpc_seed(tpcseed);
+        newTrack.set_crossing(this_crossing);
+        newTrack.set_silicon_seed(siseed);
 
-          if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
+        if (getTrackFitResult(result, track, &newTrack, tracks, measurements, ws.transient_geocontext, output.trajectories))
+        {
+          float chi2ndf = newTrack.get_quality();
+          chisq_ndf.push_back(chi2ndf);
+          svtx_vec.push_back(newTrack);
+          if (Verbosity() > 1)
           {
-            float chi2ndf = newTrack.get_quality();
-            chisq_ndf.push_back(chi2ndf);
-            svtx_vec.push_back(newTrack);
-            if (Verbosity() > 1)
-            {
-              std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
-            }
+            std::cout << "   tpcid " << tpcid << " siid " << siid << " ivary " << ivary << " this_crossing " << this_crossing << " chi2ndf " << chi2ndf << std::endl;
           }
+        }
 
-          if (ivary != nvary)
+        if (ivary != nvary)
+        {
+          if(Verbosity() > 3)
           {
-            if(Verbosity() > 3)
-            {
-              std::cout << "Skipping track fit for trial variation" << std::endl;
-            }
-            continue;
+            std::cout << "Skipping track fit for trial variation" << std::endl;
           }
+          continue;
+        }
 
-          // if we are here this is the last crossing iteration, evaluate the results
-          if (Verbosity() > 1)
+        // if we are here this is the last crossing iteration, evaluate the results
+        if (Verbosity() > 1)
+        {
+          std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+        }
+        float best_chisq = 1000.0;
+        short int best_ivary = 0;
+        for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+        {
+          if (chisq_ndf[i] < best_chisq)
           {
-            std::cout << "Finished with trial fits, chisq_ndf size is " << chisq_ndf.size() << " chisq_ndf values are:" << std::endl;
+            best_chisq = chisq_ndf[i];
+            best_ivary = i;
           }
-          float best_chisq = 1000.0;
-          short int best_ivary = 0;
-          for (unsigned int i = 0; i < chisq_ndf.size(); ++i)
+          if (Verbosity() > 1)
           {
-            if (chisq_ndf[i] < best_chisq)
-            {
-              best_chisq = chisq_ndf[i];
-              best_ivary = i;
-            }
-            if (Verbosity() > 1)
-            {
-              std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
-            }
+            std::cout << "  trial " << i << " chisq_ndf " << chisq_ndf[i] << " best_chisq " << best_chisq << " best_ivary " << best_ivary << std::endl;
           }
+        }
+        if (!svtx_vec.empty())
+        {
           unsigned int trid = m_trackMap->size();
           svtx_vec[best_ivary].set_id(trid);
-
-          m_trackMap->insertWithKey(&svtx_vec[best_ivary], trid);
+          output.track = std::make_unique<SvtxTrack_v4>(svtx_vec[best_ivary]);
         }
-        else  // case where INTT crossing is known
+      }
+      else  // case where INTT crossing is known
+      {
+        SvtxTrack_v4 newTrack;
+        newTrack.set_tpc_seed(tpcseed);
+        newTrack.set_crossing(this_crossing);
+        newTrack.set_silicon_seed(siseed);
+
+        if (m_fitSiliconMMs)
         {
-          SvtxTrack_v4 newTrack;
-          newTrack.set_tpc_seed(tpcseed);
-          newTrack.set_crossing(this_crossing);
-          newTrack.set_silicon_seed(siseed);
+          unsigned int trid = m_directedTrackMap->size();
+          newTrack.set_id(trid);
 
-          if (m_fitSiliconMMs)
+          if (getTrackFitResult(result, track, &newTrack, tracks, measurements, ws.transient_geocontext, output.trajectories))
           {
-            unsigned int trid = m_directedTrackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_directedTrackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for SC calib fit
-          else
+            output.track = std::make_unique<SvtxTrack_v4>(newTrack);
+            output.directed = true;
+          }
+        }  // end insert track for SC calib fit
+        else
+        {
+          unsigned int trid = m_trackMap->size();
+          newTrack.set_id(trid);
+
+          if (getTrackFitResult(result, track, &newTrack, tracks, measurements, ws.transient_geocontext, output.trajectories))
           {
-            unsigned int trid = m_trackMap->size();
-            newTrack.set_id(trid);
-
-            if (getTrackFitResult(result, track, &newTrack, tracks, measurements))
-            {
-              m_trackMap->insertWithKey(&newTrack, trid);
-            }
-          }  // end insert track for normal fit
-        }    // end case where INTT crossing is known
-      }
-      else if (!m_fitSiliconMMs)
+            output.track = std::make_unique<SvtxTrack_v4>(newTrack);
+          }
+        }  // end insert track for normal fit
+      }    // end case where INTT crossing is known
+    }
+    else if (!m_fitSiliconMMs)
+    {
+      /// Track fit failed, get rid of the track from the map
+      ++output.nBadFits;
+      m_cnt_failed_fits->add();
+      if (Verbosity() > 1)
       {
-        /// Track fit failed, get rid of the track from the map
-        m_nBadFits++;
-        if (Verbosity() > 1)
-        {
-          std::cout << "Track fit failed for track " << m_seedMap->find(track)
-                    << " with Acts error message "
-                    << result.error() << ", " << result.error().message()
-                    << std::endl;
-        }
-      }  // end fit failed case
-    }    // end ivary loop
+        std::cout << "Track fit failed for track " << m_seedMap->find(track)
+                  << " with Acts error message "
+                  << result.error() << ", " << result.error().message()
+                  << std::endl;
+      }
+    }  // end fit failed case
+  }    // end ivary loop
 
-    trackTimer.stop();
-    auto trackTime = trackTimer.get_accumulated_time();
+  trackTimer.stop();
+  auto trackTime = trackTimer.get_accumulated_time();
 
-    if (Verbosity() > 1)
-    {
-      std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
-    }
+  if (Verbosity() > 1)
+  {
+    std::cout << "PHActsTrkFitter total single track time " << trackTime << std::endl;
   }
-
-  return;
 }
 
 bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
                                         TrackSeed* seed, SvtxTrack* track,
                                         ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                        const ActsTrackFittingAlgorithm::MeasurementContainer& measurements)
+                                        const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                                        const Acts::GeometryContext& geocontext,
+                                        std::vector<std::pair<unsigned int, Trajectory>>& trajectories)
 {
   /// Make a trajectory state for storage, which conforms to Acts track fit
   /// analysis tool
   std::vector<Acts::MultiTrajectoryTraits::IndexType> trackTips;
   trackTips.reserve(1);
   auto& outtrack = fitOutput.value();
+  m_cnt_measurements->add(outtrack.nMeasurements());
+  m_cnt_outliers->add(outtrack.nOutliers());
   if (outtrack.hasReferenceSurface())
   {
     trackTips.emplace_back(outtrack.tipIndex());
@@ -771,7 +890,7 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     if (Verbosity() > 2)
     {
       std::cout << "Fitted parameters for track" << std::endl;
-      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(m_transient_geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
+      std::cout << " position : " << outtrack.referenceSurface().localToGlobal(geocontext, Acts::Vector2(outtrack.loc0(), outtrack.loc1()), Acts::Vector3(1, 1, 1)).transpose()
 
                 << std::endl;
       int otcharge = outtrack.qOverP() > 0 ? 1 : -1;
@@ -786,7 +905,7 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     PHTimer updateTrackTimer("UpdateTrackTimer");
     updateTrackTimer.stop();
     updateTrackTimer.restart();
-    updateSvtxTrack(trackTips, indexedParams, tracks, track);
+    updateSvtxTrack(trackTips, indexedParams, tracks, track, geocontext);
 
     if (m_commissioning)
     {
@@ -814,7 +933,7 @@ bool PHActsTrkFitter::getTrackFitResult(FitResult& fitOutput,
     Trajectory trajectory(tracks.trackStateContainer(),
                           trackTips, indexedParams);
 
-    m_trajectories->insert(std::make_pair(track->get_id(), trajectory));
+    trajectories.emplace_back(track->get_id(), trajectory);
 
     if (m_actsEvaluator)
     {
@@ -952,7 +1071,8 @@ void PHActsTrkFitter::checkSurfaceVec(SurfacePtrVec& surfaces) const
 void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                                       Trajectory::IndexedParameters& paramsMap,
                                       ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                                      SvtxTrack* track)
+                                      SvtxTrack* track,
+                                      const Acts::GeometryContext& geocontext)
 {
   const auto& mj = tracks.trackStateContainer();
 
@@ -985,9 +1105,9 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
   const auto& params = paramsMap.find(trackTip)->second;
 
   /// Acts default unit is mm. So convert to cm
-  track->set_x(params.position(m_transient_geocontext)(0) / Acts::UnitConstants::cm);
-  track->set_y(params.position(m_transient_geocontext)(1) / Acts::UnitConstants::cm);
-  track->set_z(params.position(m_transient_geocontext)(2) / Acts::UnitConstants::cm);
+  track->set_x(params.position(geocontext)(0) / Acts::UnitConstants::cm);
+  track->set_y(params.position(geocontext)(1) / Acts::UnitConstants::cm);
+  track->set_z(params.position(geocontext)(2) / Acts::UnitConstants::cm);
 
   track->set_px(params.momentum()(0));
   track->set_py(params.momentum()(1));
@@ -1021,8 +1141,9 @@ void PHActsTrkFitter::updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::I
 
   if (m_fillSvtxTrackStates)
   {
+    rotater.setCompactStates(m_compactSvtxTrackStates);
     rotater.fillSvtxTrackStates(mj, trackTip, track,
-                                m_transient_geocontext);
+                                geocontext);
   }
 
   trackStateTimer.stop();
@@ -1094,7 +1215,7 @@ Acts::BoundSquareMatrix PHActsTrkFitter::setDefaultCovariance() const
   return cov;
 }
 
-void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const
+void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const
 {
   std::cout
       << PHWHERE
@@ -1102,7 +1223,7 @@ void PHActsTrkFitter::printTrackSeed(const ActsTrackFittingAlgorithm::TrackParam
       << std::endl;
 
   std::cout
-      << "position: " << seed.position(m_transient_geocontext).transpose()
+      << "position: " << seed.position(geocontext).transpose()
       << std::endl
       << "momentum: " << seed.momentum().transpose()
       << std::endl;
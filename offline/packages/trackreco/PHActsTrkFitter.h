@@ -15,6 +15,11 @@
 
 #include <trackbase/ActsSourceLink.h>
 #include <trackbase/ActsTrackFittingAlgorithm.h>
+#include <trackbase/alignmentTransformationContainer.h>
+
+#include <trackbase_historic/SvtxTrack_v4.h>
+
+#include <phool/PHThreadPool.h>
 
 #include <tpc/TpcGlobalPositionWrapper.h>
 
@@ -29,9 +34,11 @@
 #include <TH1.h>
 #include <TH2.h>
 #include <memory>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
-class alignmentTransformationContainer;
 class ActsGeometry;
 class SvtxTrack;
 class SvtxTrackMap;
@@ -40,6 +47,7 @@ class TrackSeedContainer;
 class TrkrClusterContainer;
 class SvtxAlignmentStateMap;
 class PHG4TpcCylinderGeomContainer;
+class PHCounter;
 
 using SourceLink = ActsSourceLink;
 using FitResult = ActsTrackFittingAlgorithm::TrackFitterResult;
@@ -90,6 +98,11 @@ class PHActsTrkFitter : public SubsysReco
   {
     m_fillSvtxTrackStates = fillSvtxTrackStates;
   }
+  /// write the track state covariances with reduced precision, for smaller DSTs
+  void setCompactSvtxTrackStates(bool value)
+  {
+    m_compactSvtxTrackStates = value;
+  }
 
   void useActsEvaluator(bool actsEvaluator)
   {
@@ -122,7 +135,32 @@ class PHActsTrkFitter : public SubsysReco
   void set_use_clustermover(bool use) { m_use_clustermover = use; }
   void ignoreLayer(int layer) { m_ignoreLayer.insert(layer); }
 
+  /// fit seeds concurrently on nthreads threads, 0 uses all cores. Tracks are stored in seed order.
+  /// Not available with the evaluator, commissioning or time analysis, which are filled during the fit
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
+  /// transient transforms and geometry context used for the fit of one seed at a time
+  struct FitWorkspace
+  {
+    /// TPC surface transforms are modified to apply the corrections of the current seed
+    alignmentTransformationContainer* transformMapTransient = nullptr;
+    std::set<Acts::GeometryIdentifier> transient_id_set;
+    Acts::GeometryContext transient_geocontext;
+
+    /// per thread copy of the node tree transient transforms
+    std::unique_ptr<alignmentTransformationContainer> ownedTransformMap;
+  };
+
+  /// fit result for one seed, copied to the track maps by storeSeedFit
+  struct SeedFitOutput
+  {
+    std::unique_ptr<SvtxTrack_v4> track;  // null if there is no good fit
+    bool directed = false;                // goes to the SiliconMM track map
+    std::vector<std::pair<unsigned int, Trajectory>> trajectories;
+    int nBadFits = 0;
+  };
+
   /// Get all the nodes
   int getNodes(PHCompositeNode* topNode);
 
@@ -130,12 +168,20 @@ class PHActsTrkFitter : public SubsysReco
   int createNodes(PHCompositeNode* topNode);
 
   void loopTracks(Acts::Logging::Level logLevel);
+  void loopTracksConcurrent();
+
+  /// fit one seed, trying several crossings if needed
+  void fitSeed(TrackSeed* track, FitWorkspace& ws, SeedFitOutput& output);
+
+  /// assign the track id and store track and trajectories on the node tree
+  void storeSeedFit(SeedFitOutput& output);
 
   /// Convert the acts track fit result to an svtx track
   void updateSvtxTrack(std::vector<Acts::MultiTrajectoryTraits::IndexType>& tips,
                        Trajectory::IndexedParameters& paramsMap,
                        ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                       SvtxTrack* track);
+                       SvtxTrack* track,
+                       const Acts::GeometryContext& geocontext);
 
   /// Helper function to call either the regular navigation or direct
   /// navigation, depending on m_fitSiliconMMs
@@ -157,10 +203,12 @@ class PHActsTrkFitter : public SubsysReco
   bool getTrackFitResult(FitResult& fitOutput, TrackSeed* seed,
                          SvtxTrack* track,
                          ActsTrackFittingAlgorithm::TrackContainer& tracks,
-                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements);
+                         const ActsTrackFittingAlgorithm::MeasurementContainer& measurements,
+                         const Acts::GeometryContext& geocontext,
+                         std::vector<std::pair<unsigned int, Trajectory>>& trajectories);
 
   Acts::BoundSquareMatrix setDefaultCovariance() const;
-  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed) const;
+  void printTrackSeed(const ActsTrackFittingAlgorithm::TrackParameters& seed, const Acts::GeometryContext& geocontext) const;
 
   /// Event counter
   int m_event = 0;
@@ -174,8 +222,11 @@ class PHActsTrkFitter : public SubsysReco
   /// TrackMap containing SvtxTracks
   alignmentTransformationContainer* m_alignmentTransformationMap = nullptr;  // added for testing purposes
   alignmentTransformationContainer* m_alignmentTransformationMapTransient = nullptr;
-  std::set<Acts::GeometryIdentifier> m_transient_id_set;
-  Acts::GeometryContext m_transient_geocontext;
+
+  /// one workspace per thread slot
+  std::vector<FitWorkspace> m_workspaces;
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
   SvtxTrackMap* m_trackMap = nullptr;
   SvtxTrackMap* m_directedTrackMap = nullptr;
   TrkrClusterContainer* m_clusterContainer = nullptr;
@@ -186,6 +237,12 @@ class PHActsTrkFitter : public SubsysReco
   /// Number of acts fits that returned an error
   int m_nBadFits = 0;
 
+  /// per event counts for profiling (PHCounterRegistry), added from the worker threads
+  PHCounter* m_cnt_fits = nullptr;
+  PHCounter* m_cnt_failed_fits = nullptr;
+  PHCounter* m_cnt_measurements = nullptr;
+  PHCounter* m_cnt_outliers = nullptr;
+
   /// Boolean to use normal tracking geometry navigator or the
   /// Acts::DirectedNavigator with a list of sorted silicon+MM surfaces
   bool m_fitSiliconMMs = false;
@@ -195,6 +252,7 @@ class PHActsTrkFitter : public SubsysReco
 
   /// A bool to update the SvtxTrackState information (or not)
   bool m_fillSvtxTrackStates = true;
+  bool m_compactSvtxTrackStates = false;
 
   /// bool to ignore the silicon clusters in the fit
   bool m_ignoreSilicon = false;
@@ -13,6 +13,7 @@
 // sPHENIX includes
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <phool/PHCounter.h>
 #include <phool/PHTimer.h>  // for PHTimer
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -55,6 +56,7 @@
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <unordered_set>
@@ -208,8 +210,16 @@ Acts::Vector3 PHCASeeding::getGlobalPosition(TrkrDefs::cluskey key, TrkrCluster*
   return _pp_mode ? m_tGeometry->getGlobalPosition(key, cluster) : m_globalPositionWrapper.getGlobalPositionDistortionCorrected(key, cluster, 0);
 }
 
-void PHCASeeding::QueryTree(const bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& rtree, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
+void PHCASeeding::QueryTree(const PHCASeeding::LayerTree& tree, double phimin, double z_min, double phimax, double z_max, std::vector<pointKey>& returned_values) const
 {
+  if (_use_binned_grid)
+  {
+    tree.grid.query(phimin, z_min, phimax, z_max, [&returned_values](const PhiZGrid<TrkrDefs::cluskey>::Entry& entry)
+                    { returned_values.emplace_back(point(entry.phi, entry.z), entry.value); });
+    return;
+  }
+
+  const auto& rtree = tree.rtree;
   bool query_both_ends = false;
   if (phimin < 0)
   {
@@ -278,35 +288,89 @@ std::pair<PHCASeeding::PositionMap, PHCASeeding::keyListPerLayer> PHCASeeding::F
   return std::make_pair(cachedPositions, ckeys);
 }
 
-std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer)
+std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(PHCASeeding::LayerTree& tree, const PHCASeeding::keyList& ckeys, const PHCASeeding::PositionMap& globalPositions, const int layer, PHTimer& fill_timer) const
 {
-  // Fill _rtree with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
+  // Fill the rtree or grid with the clusters in ckeys; remove duplicates, and return a vector of the coordKeys
   // Note that layer is only used for a cout statement
   int n_dupli = 0;
   std::vector<coordKey> coords;
+  auto& _rtree = tree.rtree;
   _rtree.clear();
+  tree.grid.clear();
   /* _rtree.reserve(ckeys.size()); */
-  for (const auto& ckey : ckeys)
+
+  if (_use_binned_grid)
   {
-    const auto& globalpos_d = globalPositions.at(ckey);
-    const double clus_phi = get_phi(globalpos_d);
-    const double clus_z = globalpos_d.z();
-    if (Verbosity() > 5)
+    fill_timer.restart();
+
+    // all candidates, indexed by position in ckeys
+    std::vector<PhiZGrid<size_t>::Entry> candidates;
+    candidates.reserve(ckeys.size());
+    for (const auto& ckey : ckeys)
     {
-      /* int layer = TrkrDefs::getLayer(ckey); */
-      std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
+      const auto& globalpos_d = globalPositions.at(ckey);
+      candidates.push_back({static_cast<float>(get_phi(globalpos_d)), static_cast<float>(globalpos_d.z()), candidates.size()});
     }
-    std::vector<pointKey> testduplicate;
-    QueryTree(_rtree, clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, testduplicate);
-    if (!testduplicate.empty())
+    PhiZGrid<size_t> candidate_grid;
+    candidate_grid.set_bin_size(_grid_phi_size, _grid_z_size);
+    candidate_grid.fill(candidates);
+
+    // a cluster is a duplicate if a prior cluster which was kept is in the window,
+    // same as when filling the rtree one cluster at a time
+    std::vector<bool> kept(ckeys.size(), false);
+    std::vector<PhiZGrid<TrkrDefs::cluskey>::Entry> entries;
+    entries.reserve(ckeys.size());
+    for (size_t i = 0; i < ckeys.size(); ++i)
     {
-      ++n_dupli;
-      continue;
+      const auto& ckey = ckeys[i];
+      const auto& globalpos_d = globalPositions.at(ckey);
+      const double clus_phi = get_phi(globalpos_d);
+      const double clus_z = globalpos_d.z();
+      if (Verbosity() > 5)
+      {
+        std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
+      }
+      bool duplicate = false;
+      candidate_grid.query(clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001,
+                           [&](const PhiZGrid<size_t>::Entry& entry)
+                           { duplicate |= (entry.value < i && kept[entry.value]); });
+      if (duplicate)
+      {
+        ++n_dupli;
+        continue;
+      }
+      kept[i] = true;
+      coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
+      entries.push_back({static_cast<float>(clus_phi), static_cast<float>(clus_z), ckey});
+    }
+    tree.grid.set_bin_size(_grid_phi_size, _grid_z_size);
+    tree.grid.fill(entries);
+    fill_timer.stop();
+  }
+  else
+  {
+    for (const auto& ckey : ckeys)
+    {
+      const auto& globalpos_d = globalPositions.at(ckey);
+      const double clus_phi = get_phi(globalpos_d);
+      const double clus_z = globalpos_d.z();
+      if (Verbosity() > 5)
+      {
+        /* int layer = TrkrDefs::getLayer(ckey); */
+        std::cout << "Found cluster " << ckey << " in layer " << layer << std::endl;
+      }
+      std::vector<pointKey> testduplicate;
+      QueryTree(tree, clus_phi - 0.00001, clus_z - 0.00001, clus_phi + 0.00001, clus_z + 0.00001, testduplicate);
+      if (!testduplicate.empty())
+      {
+        ++n_dupli;
+        continue;
+      }
+      coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
+      fill_timer.restart();
+      _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
+      fill_timer.stop();
     }
-    coords.push_back({{static_cast<float>(clus_phi), static_cast<float>(clus_z)}, ckey});
-    t_fill->restart();
-    _rtree.insert(std::make_pair(point(clus_phi, globalpos_d.z()), ckey));
-    t_fill->stop();
   }
   if (Verbosity() > 5)
   {
@@ -314,7 +378,7 @@ std::vector<PHCASeeding::coordKey> PHCASeeding::FillTree(bgi::rtree<PHCASeeding:
   }
   if (Verbosity() > 3)
   {
-    std::cout << "fill time: " << t_fill->get_accumulated_time() / 1000. << " sec" << std::endl;
+    std::cout << "fill time: " << fill_timer.get_accumulated_time() / 1000. << " sec" << std::endl;
   }
   if (Verbosity() > 3)
   {
@@ -374,14 +438,24 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
 {
   t_seed->restart();
 
-  keyLinks trackSeedPairs;
-  keyLinkPerLayer bodyLinks;
-  std::tie(trackSeedPairs, bodyLinks) = CreateBiLinks(globalPositions, ckeys);
-  PHCASEEDING_PRINT_TIME(t_makebilinks, "init and make bilinks");
-
-  t_makeseeds->restart();
-  keyLists trackSeedKeyLists = FollowBiLinks(trackSeedPairs, bodyLinks, globalPositions);
-  PHCASEEDING_PRINT_TIME(t_makeseeds, "make seeds");
+  keyLists trackSeedKeyLists;
+  if (_partition_nphi > 0 && m_threadpool)
+  {
+    t_makeseeds->restart();
+    trackSeedKeyLists = FindChainsPartitioned(globalPositions, ckeys);
+    PHCASEEDING_PRINT_TIME(t_makeseeds, "make bilinks and seeds in partitions");
+  }
+  else
+  {
+    keyLinks trackSeedPairs;
+    keyLinkPerLayer bodyLinks;
+    std::tie(trackSeedPairs, bodyLinks) = CreateBiLinks(globalPositions, ckeys, _rtrees, *t_seed, *t_fill, true);
+    PHCASEEDING_PRINT_TIME(t_makebilinks, "init and make bilinks");
+
+    t_makeseeds->restart();
+    trackSeedKeyLists = FollowBiLinks(trackSeedPairs, bodyLinks, globalPositions, *t_seed, true);
+    PHCASEEDING_PRINT_TIME(t_makeseeds, "make seeds");
+  }
   if (Verbosity() > 0)
   {
     t_makeseeds->stop();
@@ -393,7 +467,9 @@ int PHCASeeding::FindSeedsWithMerger(const PHCASeeding::PositionMap& globalPosit
   return seeds.size();
 }
 
-std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinks(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys)
+std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::CreateBiLinks(
+    const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys,
+    PHCASeeding::LayerTreeArray& trees, PHTimer& seed_timer, PHTimer& fill_timer, bool print_timing) const
 {
   keyLinks startLinks;        // bilinks at start of chains
   keyLinkPerLayer bodyLinks;  //  bilinks to build chains
@@ -403,6 +479,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   double transform_time = 0;
   double compute_best_angle_time = 0;
   double set_insert_time = 0;
+  long nqueries = 0;
 
   // there are three coord_array (only the current layer is used at a time,
   // but it is filled the same time as the _rtrees, which are used two at
@@ -418,8 +495,8 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
   // fill the current and prior row coord and ttrees for the first iteration
   int _index_above = (outer_index + 1) % 3;
   int _index_current = (outer_index) % 3;
-  coord_arr[_index_above] = FillTree(_rtrees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1);
-  coord_arr[_index_current] = FillTree(_rtrees[_index_current], ckeys[outer_index], globalPositions, outer_index);
+  coord_arr[_index_above] = FillTree(trees[_index_above], ckeys[outer_index + 1], globalPositions, outer_index + 1, fill_timer);
+  coord_arr[_index_current] = FillTree(trees[_index_current], ckeys[outer_index], globalPositions, outer_index, fill_timer);
 
   for (int layer_index = outer_index; layer_index >= inner_index; --layer_index)
   {
@@ -431,13 +508,13 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
     int index_current = (layer_index) % 3;
     int index_below = (layer_index - 1) % 3;
 
-    coord_arr[index_below] = FillTree(_rtrees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1);
+    coord_arr[index_below] = FillTree(trees[index_below], ckeys[layer_index - 1], globalPositions, layer_index - 1, fill_timer);
 
     // NO DUPLICATES FOUND IN COORD_ARR
 
-    auto& _rtree_above = _rtrees[index_above];
+    auto& _rtree_above = trees[index_above];
     const std::vector<coordKey>& coord = coord_arr[index_current];
-    auto& _rtree_below = _rtrees[index_below];
+    auto& _rtree_below = trees[index_below];
 
     auto& curr_downlinks = previous_downlinks_arr[layer_index % 2];
     auto& last_downlinks = previous_downlinks_arr[(layer_index + 1) % 2];
@@ -462,9 +539,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       double StartX = globalpos(0);
       double StartY = globalpos(1);
       double StartZ = globalpos(2);
-      t_seed->stop();
-      cluster_find_time += t_seed->elapsed();
-      t_seed->restart();
+      seed_timer.stop();
+      cluster_find_time += seed_timer.elapsed();
+      seed_timer.restart();
       LogDebug(" starting cluster:" << std::endl);
       LogDebug(" z: " << StartZ << std::endl);
       LogDebug(" phi: " << StartPhi << std::endl);
@@ -478,6 +555,7 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
                 StartPhi + dphi_per_layer[LAYER],
                 StartZ + dZ_per_layer[LAYER],
                 ClustersBelow);
+      nqueries += 2;
 
       FillTupWinLink(_rtree_below, StartCluster, globalPositions);
 
@@ -488,9 +566,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
                 StartZ + dZ_per_layer[LAYER + 1],
                 ClustersAbove);
 
-      t_seed->stop();
-      rtree_query_time += t_seed->elapsed();
-      t_seed->restart();
+      seed_timer.stop();
+      rtree_query_time += seed_timer.elapsed();
+      seed_timer.restart();
       LogDebug(" entries in below layer: " << ClustersBelow.size() << std::endl);
       LogDebug(" entries in above layer: " << ClustersAbove.size() << std::endl);
       std::vector<std::array<double, 3>> delta_below;
@@ -516,9 +594,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
           return std::array<double,3>{abovepos(0)-StartX,
           abovepos(1)-StartY,
           abovepos(2)-StartZ}; });
-      t_seed->stop();
-      transform_time += t_seed->elapsed();
-      t_seed->restart();
+      seed_timer.stop();
+      transform_time += seed_timer.elapsed();
+      seed_timer.restart();
 
       // find the three clusters closest to a straight line
       // (by maximizing the cos of the angle between the (delta_z_,delta_phi) vectors)
@@ -559,9 +637,9 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       // There was some old commented-out code here for allowing layers to be skipped. This
       // may be useful in the future. This chunk of code has been moved towards the
       // end fo the file under the title: "---OLD CODE 0: SKIP_LAYERS---"
-      t_seed->stop();
-      compute_best_angle_time += t_seed->elapsed();
-      t_seed->restart();
+      seed_timer.stop();
+      compute_best_angle_time += seed_timer.elapsed();
+      seed_timer.restart();
 
       for (auto cluster : bestAboveClusters)
       {
@@ -588,29 +666,129 @@ std::pair<PHCASeeding::keyLinks, PHCASeeding::keyLinkPerLayer> PHCASeeding::Crea
       }  // end loop over all up-links
     }    // end loop over start clusters
 
-    t_seed->stop();
-    set_insert_time += t_seed->elapsed();
-    t_seed->restart();
+    seed_timer.stop();
+    set_insert_time += seed_timer.elapsed();
+    seed_timer.restart();
     LogDebug(" max collinearity: " << maxCosPlaneAngle << std::endl);
   }  // end loop over layers (to make links)
 
-  t_seed->stop();
-  if (Verbosity() > 0)
+  seed_timer.stop();
+  if (print_timing && Verbosity() > 0)
   {
-    std::cout << "triplet forming time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
+    std::cout << "triplet forming time: " << seed_timer.get_accumulated_time() / 1000 << " s" << std::endl;
     std::cout << "starting cluster setup: " << cluster_find_time / 1000 << " s" << std::endl;
     std::cout << "RTree query: " << rtree_query_time / 1000 << " s" << std::endl;
     std::cout << "Transform: " << transform_time / 1000 << " s" << std::endl;
     std::cout << "Compute best triplet: " << compute_best_angle_time / 1000 << " s" << std::endl;
     std::cout << "Set insert: " << set_insert_time / 1000 << " s" << std::endl;
   }
-  t_seed->restart();
+  seed_timer.restart();
+
+  m_cnt_tree_queries->add(nqueries);
+  long nbilinks = startLinks.size();
+  for (const auto& layer : bodyLinks)
+  {
+    nbilinks += layer.size();
+  }
+  m_cnt_bilinks->add(nbilinks);
 
   // sort the body links per layer so that links can be binary-searched per layer
   /* for (auto& layer : bodyLinks) { std::sort(layer.begin(), layer.end()); } */
   return std::make_pair(startLinks, bodyLinks);
 }
 
+PHCASeeding::keyLists PHCASeeding::FindChainsPartitioned(const PHCASeeding::PositionMap& globalPositions, const PHCASeeding::keyListPerLayer& ckeys) const
+{
+  const unsigned int nphi = _partition_nphi;
+  const unsigned int nregions = 2 * nphi;
+  const double wedge = 2. * M_PI / nphi;
+
+  // phi wedge and side of a cluster
+  auto get_region = [&](const Acts::Vector3& pos, unsigned int& iphi, double& phi_offset)
+  {
+    const double phi = get_phi(pos);
+    iphi = std::min<unsigned int>(phi / wedge, nphi - 1);
+    phi_offset = phi - iphi * wedge;
+    return (pos.z() >= 0 ? 1 : 0) * nphi + iphi;
+  };
+
+  // give each cluster to its own region and to the neighbors it overlaps with.
+  // The cluster order inside each layer is kept
+  std::vector<keyListPerLayer> region_ckeys(nregions);
+  for (size_t layer = 0; layer < ckeys.size(); ++layer)
+  {
+    for (const auto& ckey : ckeys[layer])
+    {
+      const auto& pos = globalPositions.at(ckey);
+      unsigned int iphi = 0;
+      double phi_offset = 0;
+      get_region(pos, iphi, phi_offset);
+
+      std::array<unsigned int, 3> wedges = {{iphi, iphi, iphi}};
+      if (phi_offset < _partition_phi_overlap)
+      {
+        wedges[1] = (iphi + nphi - 1) % nphi;
+      }
+      if (wedge - phi_offset < _partition_phi_overlap)
+      {
+        wedges[2] = (iphi + 1) % nphi;
+      }
+
+      for (unsigned int side = 0; side < 2; ++side)
+      {
+        if ((side == 0 && pos.z() >= _partition_z_overlap) ||
+            (side == 1 && pos.z() < -_partition_z_overlap))
+        {
+          continue;
+        }
+        for (size_t i = 0; i < wedges.size(); ++i)
+        {
+          // skip repeated wedges, when there is no overlap or less than three wedges
+          if (std::find(wedges.begin(), wedges.begin() + i, wedges[i]) != wedges.begin() + i)
+          {
+            continue;
+          }
+          region_ckeys[side * nphi + wedges[i]][layer].push_back(ckey);
+        }
+      }
+    }
+  }
+
+  // each region has its own search trees and timers, chains are kept
+  // by the region containing their outermost cluster
+  std::vector<keyLists> region_chains(nregions);
+  m_threadpool->parallel_for(nregions, [&](size_t iregion)
+                             {
+    LayerTreeArray trees;
+    PHTimer seed_timer("t_seed_region");
+    PHTimer fill_timer("t_fill_region");
+
+    keyLinks trackSeedPairs;
+    keyLinkPerLayer bodyLinks;
+    std::tie(trackSeedPairs, bodyLinks) = CreateBiLinks(globalPositions, region_ckeys[iregion], trees, seed_timer, fill_timer, false);
+    for (auto& chain : FollowBiLinks(trackSeedPairs, bodyLinks, globalPositions, seed_timer, false))
+    {
+      unsigned int iphi = 0;
+      double phi_offset = 0;
+      if (get_region(globalPositions.at(chain.front()), iphi, phi_offset) == iregion)
+      {
+        region_chains[iregion].push_back(std::move(chain));
+      }
+    } });
+
+  keyLists chains;
+  for (auto& region : region_chains)
+  {
+    std::move(region.begin(), region.end(), std::back_inserter(chains));
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << "PHCASeeding::FindChainsPartitioned - regions: " << nregions << " chains: " << chains.size() << std::endl;
+  }
+  return chains;
+}
+
 double PHCASeeding::getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PHCASeeding::PositionMap& globalPositions) const
 {
   // Menger curvature = 1/R for circumcircle of triangle formed by most recent three clusters
@@ -629,7 +807,9 @@ double PHCASeeding::getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b,
   return 2 * sin(break_angle) / hypot_length;
 }
 
-PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& trackSeedPairs, const PHCASeeding::keyLinkPerLayer& bilinks, const PHCASeeding::PositionMap& globalPositions) const
+PHCASeeding::keyLists PHCASeeding::FollowBiLinks(
+    const PHCASeeding::keyLinks& trackSeedPairs, const PHCASeeding::keyLinkPerLayer& bilinks, const PHCASeeding::PositionMap& globalPositions,
+    PHTimer& seed_timer, bool print_timing) const
 {
   // form all possible starting 3-cluster tracks (we need that to calculate curvature)
   keyLists seeds;
@@ -662,12 +842,12 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   // - grow every seed in the seedlist, up to the maximum number of clusters per seed
   // - the algorithm is that every cluster is allowed to be used by any number of chains, so there is no penalty in which order they are added
 
-  t_seed->stop();
-  if (Verbosity() > 0)
+  seed_timer.stop();
+  if (print_timing && Verbosity() > 0)
   {
-    std::cout << "starting cluster finding time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
+    std::cout << "starting cluster finding time: " << seed_timer.get_accumulated_time() / 1000 << " s" << std::endl;
   }
-  t_seed->restart();
+  seed_timer.restart();
   // assemble track cluster chains from starting cluster keys (ordered from outside in)
 
   // std::cout << "STARTING SEED ASSEMBLY" << std::endl;
@@ -681,6 +861,7 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   //  std::vector<keyList> seeds;
   // std::vector<keyList> tempSeedKeyLists = seeds;
   // seeds.clear();
+  m_cnt_triplets->add(seeds.size());
   if (seeds.size() == 0)
   {
     return seeds;
@@ -864,14 +1045,15 @@ PHCASeeding::keyLists PHCASeeding::FollowBiLinks(const PHCASeeding::keyLinks& tr
   }  // end of looping over all seeds
 
   // old code block move to end of code under the title: "---OLD CODE 1: SKIP_LAYERS---"
-  t_seed->stop();
-  if (Verbosity() > 1)
+  seed_timer.stop();
+  if (print_timing && Verbosity() > 1)
   {
-    std::cout << "keychain assembly time: " << t_seed->get_accumulated_time() / 1000 << " s" << std::endl;
+    std::cout << "keychain assembly time: " << seed_timer.get_accumulated_time() / 1000 << " s" << std::endl;
   }
-  t_seed->restart();
+  seed_timer.restart();
   LogDebug(" track key chains assembled: " << trackSeedKeyLists.size() << std::endl);
   LogDebug(" track key chain lengths: " << std::endl);
+  m_cnt_chains->add(grown_seeds.size());
   return grown_seeds;
 }
 
@@ -925,6 +1107,8 @@ std::vector<TrackSeed_v2> PHCASeeding::RemoveBadClusters(const std::vector<PHCAS
       std::cout << "pushed clean chain with " << trackseed.size_cluster_keys() << " clusters" << std::endl;
     }
   }
+  m_cnt_seeds->add(clean_chains.size());
+  m_cnt_seeds_rejected->add(chains.size() - clean_chains.size());
 
   return clean_chains;
 }
@@ -972,6 +1156,28 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
   t_makeseeds = std::make_unique<PHTimer>("t_makeseeds");
   t_makeseeds->stop();
 
+  PHCounterRegistry* counters = PHCounterRegistry::instance();
+  m_cnt_tree_queries = counters->get(Name(), "tree_queries");
+  m_cnt_bilinks = counters->get(Name(), "bilinks");
+  m_cnt_triplets = counters->get(Name(), "triplets");
+  m_cnt_chains = counters->get(Name(), "chains");
+  m_cnt_seeds = counters->get(Name(), "seeds");
+  m_cnt_seeds_rejected = counters->get(Name(), "seeds_rejected");
+
+  if (_partition_nphi > 0)
+  {
+    // the debugging ntuples are not thread safe
+#if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_) || defined(_PHCASEEDING_CHAIN_FORKS_)
+    _partition_nthreads = 1;
+#endif
+    m_threadpool = std::make_unique<PHThreadPool>(_partition_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHCASeeding::Setup - partitioned seeding with " << _partition_nphi << " phi wedges per side, "
+                << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   //  fcfg.set_rescale(1);
   std::unique_ptr<PHField> field_map;
   if (_use_const_field)
@@ -1023,6 +1229,10 @@ int PHCASeeding::Setup(PHCompositeNode* topNode)  // This is called by ::InitRun
     dphi_per_layer[i] = _neighbor_phi_width * delta_rad;
   }
 
+  // grid bins are as large as the largest search window half width
+  _grid_phi_size = *std::max_element(dphi_per_layer.begin(), dphi_per_layer.end());
+  _grid_z_size = *std::max_element(dZ_per_layer.begin(), dZ_per_layer.end());
+
 #if defined(_PHCASEEDING_CLUSTERLOG_TUPOUT_)
   std::cout << " Writing _CLUSTER_LOG_TUPOUT.root file " << std::endl;
   _f_clustering_process = new TFile("_CLUSTER_LOG_TUPOUT.root", "recreate");
@@ -1191,7 +1401,7 @@ void PHCASeeding::process_tupout_count()
   _search_windows->Fill(_neighbor_z_width, _neighbor_phi_width, _start_layer, _end_layer, _clusadd_delta_dzdr_window, _clusadd_delta_dphidr2_window);
 }
 
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
+void PHCASeeding::FillTupWinLink(const PHCASeeding::LayerTree& _rtree_below, const PHCASeeding::coordKey& StartCluster, const PHCASeeding::PositionMap& globalPositions) const
 {
   double StartPhi = StartCluster.first[0];
   const auto& P0 = globalPositions.at(StartCluster.second);
@@ -1279,7 +1489,7 @@ void PHCASeeding::write_tuples(){};
 void PHCASeeding::fill_tuple(TNtuple* /**/, float /**/, TrkrDefs::cluskey /**/, const Acts::Vector3& /**/) const {};
 void PHCASeeding::fill_tuple_with_seed(TNtuple* /**/, const PHCASeeding::keyList& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::process_tupout_count(){};
-void PHCASeeding::FillTupWinLink(bgi::rtree<PHCASeeding::pointKey, bgi::quadratic<16>>& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
+void PHCASeeding::FillTupWinLink(const PHCASeeding::LayerTree& /**/, const PHCASeeding::coordKey& /**/, const PHCASeeding::PositionMap& /**/) const {};
 void PHCASeeding::FillTupWinCosAngle(const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const TrkrDefs::cluskey /**/, const PHCASeeding::PositionMap& /**/, double /**/, bool /**/) const {};
 void PHCASeeding::FillTupWinGrowSeed(const PHCASeeding::keyList& /**/, const PHCASeeding::keyLink& /**/, const PHCASeeding::PositionMap& /**/) const {};
 #endif  // defined _PHCASEEDING_CLUSTERLOG_TUPOUT_
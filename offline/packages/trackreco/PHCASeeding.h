@@ -15,11 +15,13 @@
 
 #include "ALICEKF.h"
 #include "PHTrackSeeding.h"  // for PHTrackSeeding
+#include "PhiZGrid.h"
 
 #include <tpc/TpcGlobalPositionWrapper.h>
 
 #include <trackbase/TrkrDefs.h>  // for cluskey
 
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>  // for PHTimer
 
 #include <Eigen/Core>
@@ -49,6 +51,7 @@
 
 class ActsGeometry;
 class PHCompositeNode;
+class PHCounter;
 class PHTimer;
 class SvtxTrack_v3;
 class TpcDistortionCorrectionContainer;
@@ -80,6 +83,15 @@ class PHCASeeding : public PHTrackSeeding
 
   using PositionMap = std::unordered_map<TrkrDefs::cluskey, Acts::Vector3>;
 
+  // neighbor search structure for the clusters of one layer. Only the grid
+  // or only the rtree is filled, depending on useBinnedGrid()
+  struct LayerTree
+  {
+    bgi::rtree<pointKey, bgi::quadratic<16>> rtree;
+    PhiZGrid<TrkrDefs::cluskey> grid;
+  };
+  using LayerTreeArray = std::array<LayerTree, 3>;
+
   std::array<float, 55> dZ_per_layer{};
   std::array<float, 55> dphi_per_layer{};
 
@@ -140,6 +152,8 @@ class PHCASeeding : public PHTrackSeeding
   void magFieldFile(const std::string& fname) { m_magField = fname; }
   void useConstBField(bool opt) { _use_const_field = opt; }
   void constBField(float b) { _const_field = b; }
+  /// use a uniform (phi, z) binned grid instead of an rtree to find neighboring clusters
+  void useBinnedGrid(bool opt) { _use_binned_grid = opt; }
   void useFixedClusterError(bool opt) { _use_fixed_clus_err = opt; }
   void setFixedClusterError(int i, double val) { _fixed_clus_err.at(i) = val; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
@@ -150,6 +164,23 @@ class PHCASeeding : public PHTrackSeeding
   void setNitrogenFraction(double frac) { N2_frac = frac; };
   void setIsobutaneFraction(double frac) { isobutane_frac = frac; };
 
+  /// build links and follow chains separately for each TPC side and phi wedge, in parallel
+  /**
+   * clusters closer than phi_overlap (rad) or z_overlap (cm) to a region boundary are given to both regions.
+   * A chain is only kept by the region which contains its outermost cluster, so that chains found
+   * in the overlap are not duplicated. Chains crossing the central membrane or leaving the overlap are lost.
+   * nphi_wedges = 0 (default) processes the whole TPC at once
+   */
+  void SetPartitionedSeeding(unsigned int nphi_wedges, float phi_overlap = 0.1, float z_overlap = 2.)
+  {
+    _partition_nphi = nphi_wedges;
+    _partition_phi_overlap = phi_overlap;
+    _partition_z_overlap = z_overlap;
+  }
+
+  /// number of threads used by partitioned seeding, 0 uses all cores
+  void SetNumThreads(unsigned int nthreads) { _partition_nthreads = nthreads; }
+
  protected:
   int Setup(PHCompositeNode* topNode) override;
   int Process(PHCompositeNode* topNode) override;
@@ -184,7 +215,7 @@ class PHCASeeding : public PHTrackSeeding
   void fill_tuple(TNtuple*, float, TrkrDefs::cluskey, const Acts::Vector3&) const;
   void fill_tuple_with_seed(TNtuple*, const keyList&, const PositionMap&) const;
   void process_tupout_count();
-  void FillTupWinLink(bgi::rtree<pointKey, bgi::quadratic<16>>&, const coordKey&, const PositionMap&) const;
+  void FillTupWinLink(const LayerTree&, const coordKey&, const PositionMap&) const;
   void FillTupWinCosAngle(const TrkrDefs::cluskey, const TrkrDefs::cluskey, const TrkrDefs::cluskey, const PositionMap&, double cos_angle, bool isneg) const;
   void FillTupWinGrowSeed(const keyList& seed, const keyLink& link, const PositionMap& globalPositions) const;
   void fill_split_chains(const keyList& chain, const keyList& keylinks, const PositionMap& globalPositions, int& nchains) const;
@@ -216,12 +247,19 @@ class PHCASeeding : public PHTrackSeeding
    */
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey, TrkrCluster*) const;
   std::pair<PositionMap, keyListPerLayer> FillGlobalPositions();
-  std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys);
-  PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions) const;
-  std::vector<coordKey> FillTree(bgi::rtree<pointKey, bgi::quadratic<16>>&, const keyList&, const PositionMap&, int layer);
+  // the search trees and timers are passed explicitly so that several regions can be processed at the same time.
+  // Timing printouts are only done when print_timing is true
+  std::pair<keyLinks, keyLinkPerLayer> CreateBiLinks(const PositionMap& globalPositions, const keyListPerLayer& ckeys,
+                                                     LayerTreeArray& trees, PHTimer& seed_timer, PHTimer& fill_timer, bool print_timing) const;
+  PHCASeeding::keyLists FollowBiLinks(const keyLinks& trackSeedPairs, const keyLinkPerLayer& bilinks, const PositionMap& globalPositions,
+                                      PHTimer& seed_timer, bool print_timing) const;
+  std::vector<coordKey> FillTree(LayerTree&, const keyList&, const PositionMap&, int layer, PHTimer& fill_timer) const;
   int FindSeedsWithMerger(const PositionMap&, const keyListPerLayer&);
 
-  void QueryTree(const bgi::rtree<pointKey, bgi::quadratic<16>>& rtree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
+  /// run CreateBiLinks and FollowBiLinks per (side, phi wedge) region on the thread pool
+  keyLists FindChainsPartitioned(const PositionMap&, const keyListPerLayer&) const;
+
+  void QueryTree(const LayerTree& tree, double phimin, double zmin, double phimax, double zmax, std::vector<pointKey>& returned_values) const;
   std::vector<TrackSeed_v2> RemoveBadClusters(const std::vector<keyList>& seeds, const PositionMap& globalPositions) const;
   double getMengerCurvature(TrkrDefs::cluskey a, TrkrDefs::cluskey b, TrkrDefs::cluskey c, const PositionMap& globalPositions) const;
 
@@ -252,6 +290,9 @@ class PHCASeeding : public PHTrackSeeding
   double _xy_outlier_threshold = 0.1;
   double _fieldDir = -1;
   bool _use_const_field = false;
+  bool _use_binned_grid = false;
+  float _grid_phi_size = 0.02;  // grid binning, from the largest search window
+  float _grid_z_size = 1.;
   bool _split_seeds = true;
   bool _reject_zsize1 = false;
   float _const_field = 1.4;
@@ -273,8 +314,23 @@ class PHCASeeding : public PHTrackSeeding
   std::unique_ptr<PHTimer> t_fill;
   std::unique_ptr<PHTimer> t_makebilinks;
   std::unique_ptr<PHTimer> t_makeseeds;
+
+  // per event counts for profiling (PHCounterRegistry)
+  PHCounter* m_cnt_tree_queries{nullptr};
+  PHCounter* m_cnt_bilinks{nullptr};
+  PHCounter* m_cnt_triplets{nullptr};
+  PHCounter* m_cnt_chains{nullptr};
+  PHCounter* m_cnt_seeds{nullptr};
+  PHCounter* m_cnt_seeds_rejected{nullptr};
   /* std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, _NLAYERS_TPC> _rtrees; */
-  std::array<bgi::rtree<pointKey, bgi::quadratic<16>>, 3> _rtrees;  // need three layers at a time
+  LayerTreeArray _rtrees;  // need three layers at a time
+
+  // partitioned seeding
+  unsigned int _partition_nphi = 0;
+  float _partition_phi_overlap = 0.1;
+  float _partition_z_overlap = 2.;
+  unsigned int _partition_nthreads = 0;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 
   double Ne_frac = 0.00;
   double Ar_frac = 0.75;
@@ -21,7 +21,12 @@
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 namespace
 {
   template <class T>
@@ -34,6 +39,81 @@ namespace
   {
     return std::sqrt(square(x) + square(y));
   }
+
+  //! number of common keys of two seeds, without building the intersection
+  unsigned int count_common(const std::set<TrkrDefs::cluskey>& a, const std::set<TrkrDefs::cluskey>& b)
+  {
+    unsigned int count = 0;
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() && ib != b.end())
+    {
+      if (*ia < *ib)
+      {
+        ++ia;
+      }
+      else if (*ib < *ia)
+      {
+        ++ib;
+      }
+      else
+      {
+        ++count;
+        ++ia;
+        ++ib;
+      }
+    }
+    return count;
+  }
+
+  //! cubic cells of a given size, to find the clusters close to a position
+  /*! a cluster within one cell size of a position is in the 27 cells around it */
+  class ClusterGrid
+  {
+   public:
+    explicit ClusterGrid(double cellsize)
+      : m_cellsize(cellsize)
+    {
+    }
+
+    void insert(unsigned int index, const Acts::Vector3& pos)
+    {
+      m_cells[cell(pos, 0, 0, 0)].push_back(index);
+    }
+
+    //! indices of the clusters in the 27 cells around pos, appended to neighbors
+    void neighbors(const Acts::Vector3& pos, std::vector<unsigned int>& neighbors) const
+    {
+      for (int ix = -1; ix <= 1; ++ix)
+      {
+        for (int iy = -1; iy <= 1; ++iy)
+        {
+          for (int iz = -1; iz <= 1; ++iz)
+          {
+            auto iter = m_cells.find(cell(pos, ix, iy, iz));
+            if (iter != m_cells.end())
+            {
+              neighbors.insert(neighbors.end(), iter->second.begin(), iter->second.end());
+            }
+          }
+        }
+      }
+    }
+
+   private:
+    int64_t cell(const Acts::Vector3& pos, int dx, int dy, int dz) const
+    {
+      // 21 bits per coordinate are plenty for cm sized cells
+      static constexpr int64_t offset = 1 << 20;
+      const int64_t ix = static_cast<int64_t>(std::floor(pos.x() / m_cellsize)) + dx + offset;
+      const int64_t iy = static_cast<int64_t>(std::floor(pos.y() / m_cellsize)) + dy + offset;
+      const int64_t iz = static_cast<int64_t>(std::floor(pos.z() / m_cellsize)) + dz + offset;
+      return (ix << 42) | (iy << 21) | iz;
+    }
+
+    double m_cellsize;
+    std::unordered_map<int64_t, std::vector<unsigned int>> m_cells;
+  };
 }  // namespace
 //____________________________________________________________________________..
 PHCosmicSeeder::PHCosmicSeeder(const std::string& name)
@@ -174,15 +254,12 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::findIntersections(PHCosmicSeeder::See
         continue;
       }
       auto& seed2 = initialSeeds[j];
-      std::vector<TrkrDefs::cluskey> intersection;
       unsigned int intersection_size_limit = 3;
       if (m_trackerId == TrkrDefs::TrkrId::mvtxId)
       {
         intersection_size_limit = 2; 
       }
-      std::set_intersection(seed1.ckeys.begin(), seed1.ckeys.end(),
-                            seed2.ckeys.begin(), seed2.ckeys.end(), std::back_inserter(intersection));
-      if (intersection.size() > intersection_size_limit)
+      if (count_common(seed1.ckeys, seed2.ckeys) > intersection_size_limit)
       {
         //! If they share at least 4 (3 for MVTX only) clusters they are likely the same track,
         //! so merge and delete
@@ -220,9 +297,11 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::chainSeeds(PHCosmicSeeder::SeedVector
 {
   PHCosmicSeeder::SeedVector returnseeds;
   std::set<int> seedsToDelete;
+  updateSeedLineParameters(initialSeeds, clusterPositions);
   for (unsigned int i = 0; i < initialSeeds.size(); ++i)
   {
     auto& seed1 = initialSeeds[i];
+    bool modified = false;
     for (unsigned int j = i; j < initialSeeds.size(); ++j)
     {
       if (i == j)
@@ -230,10 +309,13 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::chainSeeds(PHCosmicSeeder::SeedVector
         continue;
       }
       auto& seed2 = initialSeeds[j];
-      recalculateSeedLineParameters(seed1, clusterPositions, true);
-      recalculateSeedLineParameters(seed2, clusterPositions, true);
-      recalculateSeedLineParameters(seed1, clusterPositions, false);
-      recalculateSeedLineParameters(seed2, clusterPositions, false);
+      //! only seed1 gains keys, seed2 is unchanged since its parameters were calculated
+      if (modified)
+      {
+        recalculateSeedLineParameters(seed1, clusterPositions, true);
+        recalculateSeedLineParameters(seed1, clusterPositions, false);
+        modified = false;
+      }
 
       float longestxyslope = seed1.xyslope;
       float longestxyint = seed1.xyintercept;
@@ -258,6 +340,7 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::chainSeeds(PHCosmicSeeder::SeedVector
         {
           seed1.ckeys.insert(key);
         }
+        modified = true;
       }
     }
   }
@@ -293,22 +376,26 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::combineSeeds(PHCosmicSeeder::SeedVect
   SeedVector prunedSeeds;
   std::set<int> seedsToDelete;
 
+  updateSeedLineParameters(initialSeeds, clusterPositions);
   for (unsigned int i = 0; i < initialSeeds.size(); ++i)
   {
+    auto& seed1 = initialSeeds[i];
+    bool modified = false;
     for (unsigned int j = i; j < initialSeeds.size(); ++j)
     {
       if (i == j)
       {
         continue;
       }
-      auto& seed1 = initialSeeds[i];
       auto& seed2 = initialSeeds[j];
 
-      // recalculate seed parameters
-      recalculateSeedLineParameters(seed1, clusterPositions, true);
-      recalculateSeedLineParameters(seed2, clusterPositions, true);
-      recalculateSeedLineParameters(seed1, clusterPositions, false);
-      recalculateSeedLineParameters(seed2, clusterPositions, false);
+      // recalculate seed parameters after seed1 got new keys
+      if (modified)
+      {
+        recalculateSeedLineParameters(seed1, clusterPositions, true);
+        recalculateSeedLineParameters(seed1, clusterPositions, false);
+        modified = false;
+      }
 
       float slope_tol = 0.1;
       float incept_tol = 3.0;
@@ -328,6 +415,7 @@ PHCosmicSeeder::SeedVector PHCosmicSeeder::combineSeeds(PHCosmicSeeder::SeedVect
           seed1.ckeys.insert(key);
         }
         seedsToDelete.insert(j);
+        modified = true;
       }
     }
   }
@@ -363,10 +451,25 @@ PHCosmicSeeder::makeSeeds(PHCosmicSeeder::PositionMap& clusterPositions)
   {
     dist_check = 1.5;
   }
-  for (auto& [key1, pos1] : clusterPositions)
+
+  //! flat copy of the positions, in key order, and a grid to find the close ones
+  std::vector<std::pair<TrkrDefs::cluskey, Acts::Vector3>> clusters(clusterPositions.begin(), clusterPositions.end());
+  ClusterGrid grid(dist_check);
+  for (unsigned int i = 0; i < clusters.size(); ++i)
   {
-    for (auto& [key2, pos2] : clusterPositions)
+    grid.insert(i, clusters[i].second);
+  }
+
+  std::vector<unsigned int> neighbors;
+  for (auto& [key1, pos1] : clusters)
+  {
+    // sorted so the doublets come in the same order as from a loop over all clusters
+    neighbors.clear();
+    grid.neighbors(pos1, neighbors);
+    std::sort(neighbors.begin(), neighbors.end());
+    for (const auto index : neighbors)
     {
+      const auto& [key2, pos2] = clusters[index];
       if (key1 == key2)
       {
         continue;
@@ -402,6 +505,15 @@ PHCosmicSeeder::makeSeeds(PHCosmicSeeder::PositionMap& clusterPositions)
 //      seednum++;
     }
   }
+  if (m_maxDoublets > 0 && seeds.size() > m_maxDoublets)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << PHWHERE << " " << seeds.size() << " doublets exceed the limit of "
+                << m_maxDoublets << ", no seeds for this event" << std::endl;
+    }
+    return PHCosmicSeeder::SeedVector();
+  }
   if (Verbosity() > 2)
   {
     std::cout << "doublet sizes " << seeds.size() << std::endl;
@@ -421,10 +533,17 @@ PHCosmicSeeder::makeSeeds(PHCosmicSeeder::PositionMap& clusterPositions)
     std::advance(begin, 1);
     auto pos2 = clusterPositions.find(*(begin))->second;
 
-    for (auto& [key, pos] : clusterPositions)
+    //! the clusters within 2cm (1cm for MVTX) of a doublet cluster are in the grid cells around it
+    neighbors.clear();
+    grid.neighbors(pos1, neighbors);
+    grid.neighbors(pos2, neighbors);
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    for (const auto index : neighbors)
     {
+      const auto& [key, pos] = clusters[index];
       //! skip existing keys
-      if (std::find(dub.ckeys.begin(), dub.ckeys.end(), key) != dub.ckeys.end())
+      if (dub.ckeys.find(key) != dub.ckeys.end())
       {
         continue;
       }
@@ -518,10 +637,9 @@ void PHCosmicSeeder::recalculateSeedLineParameters(seed& seed_A,
 {
   float avgx = 0;
   float avgy = 0;
-  PHCosmicSeeder::PositionMap seedClusters;
   for (auto& key : seed_A.ckeys)
   {
-    auto glob = clusters.find(key)->second;
+    const auto& glob = clusters.find(key)->second;
     if (isXY)
     {
       avgx += glob.x();
@@ -532,15 +650,15 @@ void PHCosmicSeeder::recalculateSeedLineParameters(seed& seed_A,
       avgx += glob.z();
       avgy += r(glob.x(), glob.y());
     }
-    seedClusters.insert(std::make_pair(key, glob));
   }
 
   avgx /= seed_A.ckeys.size();
   avgy /= seed_A.ckeys.size();
   float num = 0;
   float denom = 0;
-  for (auto& [key, glob] : seedClusters)
+  for (auto& key : seed_A.ckeys)
   {
+    const auto& glob = clusters.find(key)->second;
     if (isXY)
     {
       num += (glob.x() - avgx) * (glob.y() - avgy);
@@ -563,6 +681,19 @@ void PHCosmicSeeder::recalculateSeedLineParameters(seed& seed_A,
     seed_A.rzintercept = avgy - seed_A.rzslope * avgx;
   }
 }
+void PHCosmicSeeder::updateSeedLineParameters(SeedVector& seeds, PHCosmicSeeder::PositionMap& clusters)
+{
+  //! a single seed is never compared, its parameters stay the ones it got
+  if (seeds.size() < 2)
+  {
+    return;
+  }
+  for (auto& seed_A : seeds)
+  {
+    recalculateSeedLineParameters(seed_A, clusters, true);
+    recalculateSeedLineParameters(seed_A, clusters, false);
+  }
+}
 int PHCosmicSeeder::getNodes(PHCompositeNode* topNode)
 {
   m_tGeometry = findNode::getClass<ActsGeometry>(topNode, "ActsGeometry");
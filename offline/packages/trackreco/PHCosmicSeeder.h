@@ -39,6 +39,8 @@ class PHCosmicSeeder : public SubsysReco
   void seedAnalysis() { m_analysis = true; }
   void trackMapName(const std::string &name) { m_trackMapName = name; }
   void trackerId(TrkrDefs::TrkrId trackerId) { m_trackerId = trackerId; }
+  //! events with more cluster doublets get no seeds, 0 means no limit
+  void maxDoublets(unsigned int n) { m_maxDoublets = n; }
 
  private:
   int getNodes(PHCompositeNode *topNode);
@@ -48,8 +50,11 @@ class PHCosmicSeeder : public SubsysReco
   SeedVector findIntersections(SeedVector &initialSeeds);
   SeedVector chainSeeds(SeedVector &initialSeeds, PositionMap &clusterPositions);
   void recalculateSeedLineParameters(seed &seed, PositionMap &clusters, bool isXY);
+  //! xy and rz line parameters of all seeds which are compared pairwise
+  void updateSeedLineParameters(SeedVector &seeds, PositionMap &clusters);
 
   float m_xyTolerance = 2.;  //! cm
+  unsigned int m_maxDoublets = 0;
 //  float m_rzTolerance = 2.;  //! cm
   std::string m_trackMapName = "TpcTrackSeedContainer";
   TrkrDefs::TrkrId m_trackerId = TrkrDefs::TrkrId::tpcId;
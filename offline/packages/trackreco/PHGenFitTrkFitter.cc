@@ -289,7 +289,7 @@ int PHGenFitTrkFitter::process_event(PHCompositeNode* topNode)
 
     // This is the final track (re)fit. It does not include the collision vertex. If fit_primary_track is set, a refit including the vertex is done below.
     // rf_phgf_track stands for Refit_PHGenFit_Track
-    const auto rf_phgf_track = ReFitTrack(topNode, svtx_track);
+    const auto rf_phgf_track = ReFitTrack(svtx_track);
     if (rf_phgf_track)
     {
       svtxtrack_genfittrack_map[svtx_track->get_id()] = rf_phgf_tracks.size();
@@ -523,6 +523,16 @@ int PHGenFitTrkFitter::GetNodes(PHCompositeNode* topNode)
     return Fun4AllReturnCodes::ABORTEVENT;
   }
 
+  // silicon geometry
+  m_geom_container_intt = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_INTT");
+  assert(m_geom_container_intt);
+
+  m_geom_container_mvtx = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_MVTX");
+  assert(m_geom_container_mvtx);
+
+  /* no need to check for the container validity here. The check is done if micromegas clusters are actually found in the track */
+  m_geom_container_micromegas = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_MICROMEGAS_FULL");
+
   // global position wrapper
   m_globalPositionWrapper.loadNodes(topNode);
 
@@ -533,7 +543,7 @@ int PHGenFitTrkFitter::GetNodes(PHCompositeNode* topNode)
  * fit track with SvtxTrack as input seed.
  * \param intrack Input SvtxTrack
  */
-std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode* topNode, const SvtxTrack* intrack)
+std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(const SvtxTrack* intrack)
 {
   // std::shared_ptr<PHGenFit::Track> empty_track(nullptr);
   if (!intrack)
@@ -542,15 +552,6 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
     return nullptr;
   }
 
-  auto geom_container_intt = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_INTT");
-  assert(geom_container_intt);
-
-  auto geom_container_mvtx = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_MVTX");
-  assert(geom_container_mvtx);
-
-  /* no need to check for the container validity here. The check is done if micromegas clusters are actually found in the track */
-  auto geom_container_micromegas = findNode::getClass<PHG4CylinderGeomContainer>(topNode, "CYLINDERGEOM_MICROMEGAS_FULL");
-
   // get crossing from track
   const auto crossing = intrack->get_crossing();
   assert(crossing != SHRT_MAX);
@@ -575,7 +576,8 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
   {
     intrack->identify();
   }
-  std::map<float, TrkrDefs::cluskey> m_r_cluster_id;
+  /* the distortion corrected position is kept, so that it is calculated only once per cluster */
+  std::map<float, std::pair<TrkrDefs::cluskey, TVector3>> m_r_cluster_id;
 
   unsigned int n_silicon_clusters = 0;
   unsigned int n_micromegas_clusters = 0;
@@ -601,7 +603,7 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
     const auto cluster = m_clustermap->findCluster(cluster_key);
     const auto globalPosition = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(cluster_key, cluster, crossing);
     const float r = get_r(globalPosition.x(), globalPosition.y());
-    m_r_cluster_id.emplace(r, cluster_key);
+    m_r_cluster_id.emplace(r, std::make_pair(cluster_key, TVector3(globalPosition.x(), globalPosition.y(), globalPosition.z())));
     if (Verbosity() > 10)
     {
       const int layer_out = TrkrDefs::getLayer(cluster_key);
@@ -622,8 +624,9 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
     }
   }
 
-  for (const auto& [r, cluster_key] : m_r_cluster_id)
+  for (const auto& [r, cluster] : m_r_cluster_id)
   {
+    const auto& [cluster_key, pos] = cluster;
     const int layer = TrkrDefs::getLayer(cluster_key);
 
     // skip disabled layers
@@ -632,18 +635,15 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
       continue;
     }
 
-    auto cluster = m_clustermap->findCluster(cluster_key);
-    if (!cluster)
+    auto trkr_cluster = m_clustermap->findCluster(cluster_key);
+    if (!trkr_cluster)
     {
       LogError("No cluster Found!");
       continue;
     }
 
-    const auto globalPosition_acts = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(cluster_key, cluster, crossing);
-    const TVector3 pos(globalPosition_acts.x(), globalPosition_acts.y(), globalPosition_acts.z());
-
-    const double cluster_rphi_error = cluster->getRPhiError();
-    const double cluster_z_error = cluster->getZError();
+    const double cluster_rphi_error = trkr_cluster->getRPhiError();
+    const double cluster_z_error = trkr_cluster->getZError();
 
     seed_mom.SetPhi(pos.Phi());
     seed_mom.SetTheta(pos.Theta());
@@ -654,7 +654,7 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
     case TrkrDefs::mvtxId:
     {
       double ladder_location[3] = {0.0, 0.0, 0.0};
-      auto geom = static_cast<CylinderGeom_Mvtx*>(geom_container_mvtx->GetLayerGeom(layer));
+      auto geom = static_cast<CylinderGeom_Mvtx*>(m_geom_container_mvtx->GetLayerGeom(layer));
       auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
       auto surf = m_tgeometry->maps().getSiliconSurface(hitsetkey);
 	  CylinderGeom_MvtxHelper::find_sensor_center(surf, m_tgeometry, ladder_location);
@@ -668,7 +668,7 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
 
     case TrkrDefs::inttId:
     {
-      auto geom = static_cast<CylinderGeomIntt*>(geom_container_intt->GetLayerGeom(layer));
+      auto geom = static_cast<CylinderGeomIntt*>(m_geom_container_intt->GetLayerGeom(layer));
       double hit_location[3] = {0.0, 0.0, 0.0};
       auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(cluster_key);
       auto surf = m_tgeometry->maps().getSiliconSurface(hitsetkey);
@@ -686,8 +686,8 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
 
       // get geometry
       /* a situation where micromegas clusters are found, but not the geometry, should not happen */
-      assert(geom_container_micromegas);
-      auto geom = static_cast<CylinderGeomMicromegas*>(geom_container_micromegas->GetLayerGeom(layer));
+      assert(m_geom_container_micromegas);
+      auto geom = static_cast<CylinderGeomMicromegas*>(m_geom_container_micromegas->GetLayerGeom(layer));
       const auto tileid = MicromegasDefs::getTileId(cluster_key);
       const auto u = geom->get_world_from_local_vect(tileid, m_tgeometry, TVector3(1, 0, 0));
       const auto v = geom->get_world_from_local_vect(tileid, m_tgeometry, TVector3(0, 1, 0));
@@ -698,7 +698,7 @@ std::shared_ptr<PHGenFit::Track> PHGenFitTrkFitter::ReFitTrack(PHCompositeNode*
     default:
     {
       // create measurement
-      const TVector3 n(globalPosition_acts.x(), globalPosition_acts.y(), 0);
+      const TVector3 n(pos.x(), pos.y(), 0);
       meas.reset( new PHGenFit::PlanarMeasurement(pos, n, cluster_rphi_error, cluster_z_error) );
       break;
     }
@@ -47,6 +47,7 @@ namespace PHGenFit
 
 class ActsGeometry;
 class PHCompositeNode;
+class PHG4CylinderGeomContainer;
 class SvtxTrackMap;
 class TrkrClusterContainer;
 class TrackSeedContainer;
@@ -152,7 +153,7 @@ class PHGenFitTrkFitter : public SubsysReco
    * \param intrack Input SvtxTrack
    * \param invertex Input Vertex, if fit track as a primary vertex
    */
-  std::shared_ptr<PHGenFit::Track> ReFitTrack(PHCompositeNode*, const SvtxTrack* intrack);
+  std::shared_ptr<PHGenFit::Track> ReFitTrack(const SvtxTrack* intrack);
 
   //! Make SvtxTrack from PHGenFit::Track and SvtxTrack
   std::shared_ptr<SvtxTrack> MakeSvtxTrack(const SvtxTrack* svtxtrack, const std::shared_ptr<PHGenFit::Track>& genfit_track );
@@ -191,6 +192,11 @@ class PHGenFitTrkFitter : public SubsysReco
   /// acts geometry
   ActsGeometry* m_tgeometry = nullptr;
 
+  //! silicon and micromegas geometry containers
+  PHG4CylinderGeomContainer* m_geom_container_mvtx = nullptr;
+  PHG4CylinderGeomContainer* m_geom_container_intt = nullptr;
+  PHG4CylinderGeomContainer* m_geom_container_micromegas = nullptr;
+
   //! Input Node pointers
   TrkrClusterContainer* m_clustermap = nullptr;
 
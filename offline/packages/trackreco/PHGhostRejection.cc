@@ -10,6 +10,7 @@
 
 #include <trackbase_historic/TrackSeed.h>
 #include <trackbase_historic/TrackSeed_v2.h>
+#include <trackbase_historic/TrackSeedClusterIndex.h>
 #include <trackbase_historic/TrackSeedContainer.h>
 #include <trackbase_historic/TrackSeedHelper.h>
 
@@ -105,43 +106,82 @@ void PHGhostRejection::find_ghosts(std::vector<float>& trackChi2)
   std::set<unsigned int> matches_set;
   std::multimap<unsigned int, unsigned int> matches;
 
-  for (unsigned int trid1 = 0;
-       trid1 != seeds.size();
-       ++trid1)
+  // seed positions, calculated once
+  std::vector<Acts::Vector3> positions;
+  positions.reserve(seeds.size());
+  for (const auto& seed : seeds)
   {
-    if (m_rejected[trid1]) { continue; }
-    const auto& track1 = seeds[trid1];
-    const float track1phi = track1.get_phi();
+    positions.push_back(TrackSeedHelper::get_xyz(&seed));
+  }
 
-    const auto track1_pos = TrackSeedHelper::get_xyz(&track1);
-    const float track1eta = track1.get_eta();
-    for (unsigned int trid2 = trid1; trid2 != seeds.size(); ++trid2)
+  // seeds without clusters would count as sharing with any other seed,
+  // fall back to comparing all pairs if any is left
+  bool use_cluster_index = _use_cluster_index;
+  for (unsigned int trid = 0; use_cluster_index && trid != seeds.size(); ++trid)
+  {
+    if (!m_rejected[trid] && seeds[trid].size_cluster_keys() == 0)
     {
-      if (m_rejected[trid2] ||  (trid1 == trid2))
-      {
-        continue;
-      }
+      use_cluster_index = false;
+    }
+  }
 
-      const auto& track2 = seeds[trid2];
-      const auto track2_pos = TrackSeedHelper::get_xyz(&track2);
-      const float track2eta = track2.get_eta();
-      auto delta_phi = std::abs(track1phi - track2.get_phi());
+  if (use_cluster_index)
+  {
+    // map each cluster to the seeds using it
+    TrackSeedClusterIndex cluster_seeds;
+    for (unsigned int trid = 0; trid != seeds.size(); ++trid)
+    {
+      if (m_rejected[trid]) { continue; }
+      cluster_seeds.add(trid, seeds[trid].begin_cluster_keys(), seeds[trid].end_cluster_keys());
+    }
+    cluster_seeds.build();
+
+    // candidates are the seeds sharing a cluster with trid1, processed
+    // in increasing order as in the pairwise loop
+    std::vector<unsigned int> candidates;
+    for (unsigned int trid1 = 0; trid1 != seeds.size(); ++trid1)
+    {
+      if (m_rejected[trid1]) { continue; }
+      cluster_seeds.shared_seeds(seeds[trid1].begin_cluster_keys(), seeds[trid1].end_cluster_keys(), trid1, candidates);
+
+      for (const auto& trid2 : candidates)
+      {
+        if (pass_matching_cuts(trid1, trid2, positions))
+        {
+          matches_set.insert(trid1);
+          matches.insert(std::pair(trid1, trid2));
 
-      if (delta_phi > 2 * M_PI) {
-        delta_phi = delta_phi - 2*M_PI;
+          if (m_verbosity > 1)
+          {
+            std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
+          }
+        }
       }
-      if (delta_phi < _phi_cut &&
-          std::fabs(track1eta - track2eta) < _eta_cut &&
-          std::fabs(track1_pos.x() - track2_pos.x()) < _x_cut &&
-          std::fabs(track1_pos.y() - track2_pos.y()) < _y_cut &&
-          std::fabs(track1_pos.z() - track2_pos.z()) < _z_cut)
+    }
+  }
+  else
+  {
+    for (unsigned int trid1 = 0;
+         trid1 != seeds.size();
+         ++trid1)
+    {
+      if (m_rejected[trid1]) { continue; }
+      for (unsigned int trid2 = trid1; trid2 != seeds.size(); ++trid2)
       {
-        matches_set.insert(trid1);
-        matches.insert(std::pair(trid1, trid2));
+        if (m_rejected[trid2] ||  (trid1 == trid2))
+        {
+          continue;
+        }
 
-        if (m_verbosity > 1)
+        if (pass_matching_cuts(trid1, trid2, positions))
         {
-          std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
+          matches_set.insert(trid1);
+          matches.insert(std::pair(trid1, trid2));
+
+          if (m_verbosity > 1)
+          {
+            std::cout << "Found match for tracks " << trid1 << " and " << trid2 << std::endl;
+          }
         }
       }
     }
@@ -152,7 +192,7 @@ void PHGhostRejection::find_ghosts(std::vector<float>& trackChi2)
     if (m_rejected[set_it]) { continue; } // already rejected
     auto match_list = matches.equal_range(set_it);
 
-    auto tr1 = seeds[set_it];
+    auto& tr1 = seeds[set_it];
     double best_qual = trackChi2.at(set_it);
     unsigned int best_track = set_it;
 
@@ -168,7 +208,7 @@ void PHGhostRejection::find_ghosts(std::vector<float>& trackChi2)
         std::cout << "    match of track " << it->first << " to track " << it->second << std::endl;
       }
 
-      auto tr2 = seeds[it->second];
+      auto& tr2 = seeds[it->second];
 
       // Check that these two tracks actually share the same clusters, if not skip this pair
       bool is_same_track = checkClusterSharing(tr1, tr2);
@@ -237,6 +277,24 @@ void PHGhostRejection::find_ghosts(std::vector<float>& trackChi2)
   }
 }
 
+bool PHGhostRejection::pass_matching_cuts(unsigned int trid1, unsigned int trid2, const std::vector<Acts::Vector3>& positions) const
+{
+  const auto& track1 = seeds[trid1];
+  const auto& track2 = seeds[trid2];
+  const auto& track1_pos = positions[trid1];
+  const auto& track2_pos = positions[trid2];
+
+  auto delta_phi = std::abs(track1.get_phi() - track2.get_phi());
+  if (delta_phi > 2 * M_PI) {
+    delta_phi = delta_phi - 2*M_PI;
+  }
+  return delta_phi < _phi_cut &&
+         std::fabs(track1.get_eta() - track2.get_eta()) < _eta_cut &&
+         std::fabs(track1_pos.x() - track2_pos.x()) < _x_cut &&
+         std::fabs(track1_pos.y() - track2_pos.y()) < _y_cut &&
+         std::fabs(track1_pos.z() - track2_pos.z()) < _z_cut;
+}
+
 // there is no check, at this point, about which is the best chi2 track
 bool PHGhostRejection::checkClusterSharing(TrackSeed& tr1, TrackSeed& tr2)
 {
@@ -58,6 +58,10 @@ class PHGhostRejection
   void set_y_cut(double d) { _y_cut = d; }
   void set_z_cut(double d) { _z_cut = d; }
 
+  // only compare seeds that share at least one cluster, found from a cluster key to seed index map.
+  // Gives the same result as comparing all pairs, since ghosts must share clusters
+  void set_use_cluster_index(bool _setting) { _use_cluster_index = _setting; }
+
  private:
   unsigned int m_verbosity;
   std::vector<TrackSeed_v2>& seeds;
@@ -74,6 +78,11 @@ class PHGhostRejection
   bool   _must_span_sectors = false;
   size_t _min_clusters = 3;
 
+  bool _use_cluster_index = true;
+
+  // candidate pairs (trid1 < trid2) passing the phi, eta and position cuts
+  bool pass_matching_cuts(unsigned int trid1, unsigned int trid2, const std::vector<Acts::Vector3>& positions) const;
+
 
   /* TrackSeedContainer *m_trackMap = nullptr; */
 
@@ -26,12 +26,17 @@
 #include <fun4all/Fun4AllReturnCodes.h>
 #include <fun4all/SubsysReco.h>  // for SubsysReco
 
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <Acts/Definitions/Units.hpp>
+#include <Acts/Surfaces/Surface.hpp>
+
 #include <TF1.h>
 #include <TVector3.h>
 
+#include <algorithm>
 #include <array>
 #include <cmath>     // for sqrt, std::abs, atan2, cos
 #include <iostream>  // for operator<<, basic_ostream
@@ -57,6 +62,21 @@ namespace
     return std::sqrt(square(x) + square(y));
   }
 
+  //! bind angle to [-M_PI,+M_PI[
+  template <class T>
+  inline T bind_angle(const T& angle)
+  {
+    if (angle >= M_PI)
+    {
+      return angle - 2 * M_PI;
+    }
+    if (angle < -M_PI)
+    {
+      return angle + 2 * M_PI;
+    }
+    return angle;
+  }
+
   /// calculate intersection from circle to line, in 2d. return true on success
   /**
   * circle is defined as (x-xc)**2 + (y-yc)**2 = r**2
@@ -155,6 +175,9 @@ PHMicromegasTpcTrackMatching::PHMicromegasTpcTrackMatching(const std::string& na
 {
 }
 
+//____________________________________________________________________________..
+PHMicromegasTpcTrackMatching::~PHMicromegasTpcTrackMatching() = default;
+
 //____________________________________________________________________________..
 int PHMicromegasTpcTrackMatching::InitRun(PHCompositeNode* topNode)
 {
@@ -191,6 +214,18 @@ int PHMicromegasTpcTrackMatching::InitRun(PHCompositeNode* topNode)
     return ret;
   }
 
+  // tile surfaces do not change during the run
+  SetupTileSurfaces();
+
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHMicromegasTpcTrackMatching::InitRun - matching seeds with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return ret;
 }
 
@@ -217,393 +252,500 @@ int PHMicromegasTpcTrackMatching::process_event(PHCompositeNode* topNode)
   }
 
   // loop over the seed tracks - these are the seeds formed from matched tpc and silicon track seeds
-  for (unsigned int seedID = 0;
-       seedID != _svtx_seed_map->size(); ++seedID)
+  // the matches are added to the tpc tracklets in seed order, after all seeds are matched when threaded
+  const unsigned int nseeds = _svtx_seed_map->size();
+  auto add_match = [this](const SeedMatch& match)
+  {
+    if (!match.first)
+    {
+      return;
+    }
+    for (const auto& ckey : match.second)
+    {
+      match.first->insert_cluster_key(ckey);
+    }
+    if (Verbosity() > 3)
+    {
+      match.first->identify();
+    }
+  };
+  if (m_threadpool && Verbosity() == 0 && !_test_windows && !_zero_field)
   {
-    auto seed = _svtx_seed_map->get(seedID);
-    auto siID = seed->get_silicon_seed_index();
-    auto tracklet_si = _si_track_map->get(siID);
+    std::vector<SeedMatch> matches(nseeds);
+    // the workers look up clusters, decode them all first
+    _cluster_map->decodeAll();
+    m_threadpool->parallel_for(nseeds, [this, &matches](size_t seedID)
+                               { matches[seedID] = MatchSeed(seedID); });
+    for (const auto& match : matches)
+    {
+      add_match(match);
+    }
+  }
+  else
+  {
+    for (unsigned int seedID = 0; seedID != nseeds; ++seedID)
+    {
+      add_match(MatchSeed(seedID));
+    }
+  }
+
+  if (Verbosity() > 0)
+  {
+    std::cout << " Final seed map size " << _svtx_seed_map->size() << std::endl;
+  }
 
-    short int crossing = 0;
-    if (_pp_mode)
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+//_________________________________________________________________________________________________
+PHMicromegasTpcTrackMatching::SeedMatch PHMicromegasTpcTrackMatching::MatchSeed(const unsigned int seedID) const
+{
+  SeedMatch match{nullptr, {}};
+  auto seed = _svtx_seed_map->get(seedID);
+  auto siID = seed->get_silicon_seed_index();
+  auto tracklet_si = _si_track_map->get(siID);
+
+  short int crossing = 0;
+  if (_pp_mode)
+  {
+    if (!tracklet_si)
     {
-      if (!tracklet_si)
-      {
-        continue;  // cannot use tracks not matched to silicon because crossing is unknown
-      }
+      return match;  // cannot use tracks not matched to silicon because crossing is unknown
+    }
 
-      crossing = tracklet_si->get_crossing();
-      if (crossing == SHRT_MAX)
+    crossing = tracklet_si->get_crossing();
+    if (crossing == SHRT_MAX)
+    {
+      if (Verbosity() > 0)
       {
-        if (Verbosity() > 0)
-        {
-          std::cout << " svtx seed " << seedID << " with si seed " << siID
-                    << " crossing not defined: crossing = " << crossing << " skip this track" << std::endl;
-        }
-        continue;
+        std::cout << " svtx seed " << seedID << " with si seed " << siID
+                  << " crossing not defined: crossing = " << crossing << " skip this track" << std::endl;
       }
+      return match;
     }
+  }
+
+  auto tpcID = seed->get_tpc_seed_index();
+
+  auto tracklet_tpc = _tpc_track_map->get(tpcID);
+  if (!tracklet_tpc)
+  {
+    return match;
+  }
 
-    auto tpcID = seed->get_tpc_seed_index();
+  if (Verbosity() >= 1)
+  {
+    std::cout << std::endl
+              << __LINE__
+              << ": Processing TPC seed track: " << tpcID
+              << ": crossing: " << crossing
+              << ": nhits: " << tracklet_tpc->size_cluster_keys()
+              << ": Total TPC tracks: " << _tpc_track_map->size()
+              << ": phi: " << tracklet_tpc->get_phi()
+              << std::endl;
+  }
+
+  // Get the outermost TPC clusters for this tracklet
+  std::map<unsigned int, TrkrCluster*> outer_clusters;
+  std::vector<std::pair<TrkrDefs::cluskey, TrkrCluster*>> clusters;
+  std::vector<Acts::Vector3> clusGlobPos;
+
+  for (auto key_iter = tracklet_tpc->begin_cluster_keys(); key_iter != tracklet_tpc->end_cluster_keys(); ++key_iter)
+  {
+    const auto& cluster_key = *key_iter;
+    unsigned int layer = TrkrDefs::getLayer(cluster_key);
 
-    auto tracklet_tpc = _tpc_track_map->get(tpcID);
-    if (!tracklet_tpc)
+    if (layer < _min_tpc_layer)
     {
       continue;
     }
-
-    if (Verbosity() >= 1)
+    if (layer >= _min_mm_layer)
     {
-      std::cout << std::endl
-                << __LINE__
-                << ": Processing TPC seed track: " << tpcID
-                << ": crossing: " << crossing
-                << ": nhits: " << tracklet_tpc->size_cluster_keys()
-                << ": Total TPC tracks: " << _tpc_track_map->size()
-                << ": phi: " << tracklet_tpc->get_phi()
-                << std::endl;
+      continue;
     }
 
-    // Get the outermost TPC clusters for this tracklet
-    std::map<unsigned int, TrkrCluster*> outer_clusters;
-    std::vector<TrkrCluster*> clusters;
-    std::vector<Acts::Vector3> clusGlobPos;
-
-    for (auto key_iter = tracklet_tpc->begin_cluster_keys(); key_iter != tracklet_tpc->end_cluster_keys(); ++key_iter)
+    // get the cluster
+    TrkrCluster* tpc_clus = _cluster_map->findCluster(cluster_key);
+    if (!tpc_clus)
     {
-        const auto& cluster_key = *key_iter;
-        unsigned int layer = TrkrDefs::getLayer(cluster_key);
+      continue;
+    }
+    outer_clusters.insert(std::make_pair(layer, tpc_clus));
+    clusters.emplace_back(cluster_key, tpc_clus);
+  }
 
-        if (layer < _min_tpc_layer)
-        {
-          continue;
-        }
-        if (layer >= _min_mm_layer)
-        {
-          continue;
-        }
+  if (clusters.empty())
+  {
+    return match;
+  }
 
-        // get the cluster
-        TrkrCluster* tpc_clus = _cluster_map->findCluster(cluster_key);
-        if (!tpc_clus)
-        {
-          continue;
-        }
-        outer_clusters.insert(std::make_pair(layer, tpc_clus));
-        clusters.push_back(tpc_clus);
-        // make necessary corrections to the global position
-        clusGlobPos.push_back( m_globalPositionWrapper.getGlobalPositionDistortionCorrected(cluster_key, tpc_clus, crossing) );
-        
-    }
+  // make necessary corrections to the global position, the outermost cluster
+  // first, to skip the tracklets which cannot reach any tile
+  const auto last_clus_pos = m_globalPositionWrapper.getGlobalPositionDistortionCorrected(clusters.back().first, clusters.back().second, crossing);
+  if (_phi_prefilter && !can_reach_tile(last_clus_pos))
+  {
+    return match;
+  }
+  for (size_t i = 0; i + 1 < clusters.size(); ++i)
+  {
+    clusGlobPos.push_back( m_globalPositionWrapper.getGlobalPositionDistortionCorrected(clusters[i].first, clusters[i].second, crossing) );
+  }
+  clusGlobPos.push_back(last_clus_pos);
 
-    double xy_m = 0, xy_b = 0;   
-    double R = 0, X0 = 0, Y0 = 0;
-    double A = 0, B = 0;
+  double xy_m = 0, xy_b = 0;   
+  double R = 0, X0 = 0, Y0 = 0;
+  double A = 0, B = 0;
 
-    if(_zero_field) { // start _zero_field
+  if(_zero_field) { // start _zero_field
 
-      if (Verbosity() > 10)
-      {
-        std::cout << "zero field is ON, starting TPC clusters linear fit" << std::endl;
-      }
-      auto cluster_list = getTrackletClusterList(tracklet_tpc);
+    if (Verbosity() > 10)
+    {
+      std::cout << "zero field is ON, starting TPC clusters linear fit" << std::endl;
+    }
+    auto cluster_list = getTrackletClusterList(tracklet_tpc);
 
-      // need at least 3 clusters to fit a line
-      if (outer_clusters.size() < 3)
-      {
-        if (Verbosity() > 3)
-        {
-          std::cout << PHWHERE << "  -- skip this tpc tracklet, not enough outer clusters " << std::endl;
-        }
-        continue;  // skip to the next TPC tracklet
-      }
-      
-      const auto params = TrackFitUtils::fitClustersZeroField(clusGlobPos, cluster_list, true); // This is for the intersection
-      xy_m = params[0];
-      xy_b = params[1];
- 
-      // get the straight line representing the z trajectory in the form of z vs radius
-      std::tie(A, B) = TrackFitUtils::line_fit(clusGlobPos);
-      if (Verbosity() > 10)
+    // need at least 3 clusters to fit a line
+    if (outer_clusters.size() < 3)
+    {
+      if (Verbosity() > 3)
       {
-        std::cout << " zero field fitted line has A " << A << " B " << B << " xy_m " << xy_m << " xy_b " << xy_b << std::endl;
+        std::cout << PHWHERE << "  -- skip this tpc tracklet, not enough outer clusters " << std::endl;
       }
+      return match;  // skip to the next TPC tracklet
+    }
 
-    } else { // start !_zero_field
+    const auto params = TrackFitUtils::fitClustersZeroField(clusGlobPos, cluster_list, true); // This is for the intersection
+    xy_m = params[0];
+    xy_b = params[1];
 
-      if(Verbosity() > 10)
-      {
-        std::cout << "zero field is OFF, starting TPC clusters circle fit" << std::endl;
-      }
-      // need at least 3 clusters to fit a circle
-      if (outer_clusters.size() < 3)
-      {
-        if (Verbosity() > 3)
-        {
-          std::cout << PHWHERE << "  -- skip this tpc tracklet, not enough outer clusters " << std::endl;
-        }
-        continue;  // skip to the next TPC tracklet
-      }
+    // get the straight line representing the z trajectory in the form of z vs radius
+    std::tie(A, B) = TrackFitUtils::line_fit(clusGlobPos);
+    if (Verbosity() > 10)
+    {
+      std::cout << " zero field fitted line has A " << A << " B " << B << " xy_m " << xy_m << " xy_b " << xy_b << std::endl;
+    }
 
-      // fit a circle to the clusters
-      std::tie(R, X0, Y0) = TrackFitUtils::circle_fit_by_taubin(clusGlobPos);
-      if (Verbosity() > 10)
-      {
-        std::cout << " Fitted circle has R " << R << " X0 " << X0 << " Y0 " << Y0 << std::endl;
-      }
+  } else { // start !_zero_field
 
-      // toss tracks for which the fitted circle could not have come from the vertex
-      if (R < 40.0)
+    if(Verbosity() > 10)
+    {
+      std::cout << "zero field is OFF, starting TPC clusters circle fit" << std::endl;
+    }
+    // need at least 3 clusters to fit a circle
+    if (outer_clusters.size() < 3)
+    {
+      if (Verbosity() > 3)
       {
-        continue;
+        std::cout << PHWHERE << "  -- skip this tpc tracklet, not enough outer clusters " << std::endl;
       }
+      return match;  // skip to the next TPC tracklet
+    }
 
-      // get the straight line representing the z trajectory in the form of z vs radius
-      std::tie(A, B) = TrackFitUtils::line_fit(clusGlobPos);
-      if (Verbosity() > 10)
-      {
-        std::cout << " non-zero field fitted line has A " << A << " B " << B << std::endl;
-      }
-  
-    } // end !_zero_field
+    // fit a circle to the clusters
+    std::tie(R, X0, Y0) = TrackFitUtils::circle_fit_by_taubin(clusGlobPos);
+    if (Verbosity() > 10)
+    {
+      std::cout << " Fitted circle has R " << R << " X0 " << X0 << " Y0 " << Y0 << std::endl;
+    }
+
+    // toss tracks for which the fitted circle could not have come from the vertex
+    if (R < 40.0)
+    {
+      return match;
+    }
 
-    // loop over micromegas layer
-    for (unsigned int imm = 0; imm < _n_mm_layers; ++imm)
+    // get the straight line representing the z trajectory in the form of z vs radius
+    std::tie(A, B) = TrackFitUtils::line_fit(clusGlobPos);
+    if (Verbosity() > 10)
     {
-      // get micromegas geometry object
-      const unsigned int layer = _min_mm_layer + imm;
-      const auto layergeom = static_cast<CylinderGeomMicromegas*>(_geomContainerMicromegas->GetLayerGeom(layer));
-      const auto layer_radius = layergeom->get_radius();
+      std::cout << " non-zero field fitted line has A " << A << " B " << B << std::endl;
+    }
 
-      double xplus, yplus, xminus, yminus;
-      if(_zero_field) { // start _zero_field
-      
-        // method to find where the fitted line intersects this layer
-        std::tie(xplus, yplus, xminus, yminus) = TrackFitUtils::line_circle_intersection(layer_radius, xy_m, xy_b);
-        
-      } else { // start _zero_field!
+  } // end !_zero_field
 
-        // method to find where fitted circle intersects this layer
-        std::tie(xplus, yplus, xminus, yminus) = TrackFitUtils::circle_circle_intersection(layer_radius, R, X0, Y0);
+  // from here on the tracklet can get micromegas clusters
+  match.first = tracklet_tpc;
 
-        // finds the intersection of the fitted circle with the micromegas layer
-      } // end _zero_field!
+  // loop over micromegas layer
+  for (unsigned int imm = 0; imm < _n_mm_layers; ++imm)
+  {
+    // get micromegas geometry object
+    const unsigned int layer = _min_mm_layer + imm;
+    const auto layergeom = static_cast<CylinderGeomMicromegas*>(_geomContainerMicromegas->GetLayerGeom(layer));
+    const auto layer_radius = layergeom->get_radius();
 
-      if (Verbosity() > 10)
-      {
-        std::cout << "xplus: " << xplus << " yplus " << yplus << " xminus " << xminus << " yminus " << std::endl;
-      }
- 
-      if (!std::isfinite(xplus))
+    double xplus, yplus, xminus, yminus;
+    if(_zero_field) { // start _zero_field
+
+      // method to find where the fitted line intersects this layer
+      std::tie(xplus, yplus, xminus, yminus) = TrackFitUtils::line_circle_intersection(layer_radius, xy_m, xy_b);
+
+    } else { // start _zero_field!
+
+      // method to find where fitted circle intersects this layer
+      std::tie(xplus, yplus, xminus, yminus) = TrackFitUtils::circle_circle_intersection(layer_radius, R, X0, Y0);
+
+      // finds the intersection of the fitted circle with the micromegas layer
+    } // end _zero_field!
+
+    if (Verbosity() > 10)
+    {
+      std::cout << "xplus: " << xplus << " yplus " << yplus << " xminus " << xminus << " yminus " << std::endl;
+    }
+
+    if (!std::isfinite(xplus))
+     {
+       if (Verbosity() > 10)
        {
-         if (Verbosity() > 10)
-         {
-           std::cout << PHWHERE << " circle/circle intersection calculation failed, skip this case" << std::endl;
-           std::cout << PHWHERE << " mm_radius " << layer_radius << " fitted R " << R << " fitted X0 " << X0 << " fitted Y0 " << Y0 << std::endl;
-         }
+         std::cout << PHWHERE << " circle/circle intersection calculation failed, skip this case" << std::endl;
+         std::cout << PHWHERE << " mm_radius " << layer_radius << " fitted R " << R << " fitted X0 " << X0 << " fitted Y0 " << Y0 << std::endl;
+       }
 
-         continue; 
-      }
-      // we can figure out which solution is correct based on the last cluster position in the TPC
-      const double last_clus_phi = std::atan2(clusGlobPos.back()(1), clusGlobPos.back()(0));
-      double phi_plus = std::atan2(yplus, xplus);
-      double phi_minus = std::atan2(yminus, xminus);
+       continue; 
+    }
+    // we can figure out which solution is correct based on the last cluster position in the TPC
+    const double last_clus_phi = std::atan2(clusGlobPos.back()(1), clusGlobPos.back()(0));
+    double phi_plus = std::atan2(yplus, xplus);
+    double phi_minus = std::atan2(yminus, xminus);
+
+      // calculate z
+    double r = layer_radius;
+    double z = B + A * r;
 
-        // calculate z
-      double r = layer_radius;
-      double z = B + A * r;
+    // select the angle that is the closest to last cluster
+    // store phi, apply coarse space charge corrections in calibration mode
+    double phi = std::abs(last_clus_phi - phi_plus) < std::abs(last_clus_phi - phi_minus) ? phi_plus : phi_minus;
 
-      // select the angle that is the closest to last cluster
-      // store phi, apply coarse space charge corrections in calibration mode
-      double phi = std::abs(last_clus_phi - phi_plus) < std::abs(last_clus_phi - phi_minus) ? phi_plus : phi_minus;
+    // create cylinder intersection point in world coordinates
+    const TVector3 world_intersection_cylindrical(r * std::cos(phi), r * std::sin(phi), z);
 
-      // create cylinder intersection point in world coordinates
-      const TVector3 world_intersection_cylindrical(r * std::cos(phi), r * std::sin(phi), z);
+    // find matching tile
+    int tileid = layergeom->find_tile_cylindrical(world_intersection_cylindrical);
+    if (tileid < 0)
+    {
+      continue;
+    }
 
-      // find matching tile
-      int tileid = layergeom->find_tile_cylindrical(world_intersection_cylindrical);
-      if (tileid < 0)
+    // get tile center and norm vector
+    const auto& tile = _tile_surfaces[imm][tileid];
+    const double x0 = tile.x0;
+    const double y0 = tile.y0;
+    const double nx = tile.nx;
+    const double ny = tile.ny;
+
+    if(_zero_field) {
+
+      // calculate intersection to tile
+      if (!line_line_intersection(xy_m, xy_b, x0, y0, nx, ny, xplus, yplus, xminus, yminus))
       {
+        if (Verbosity() > 10)
+        {
+          std::cout << PHWHERE << "line_line_intersection - failed" << std::endl;
+        }
         continue;
       }
 
-      // get tile center and norm vector
-      const auto tile_center = layergeom->get_world_from_local_coords(tileid, _tGeometry, {0, 0});
-      const double x0 = tile_center.x();
-      const double y0 = tile_center.y();
-
-      const auto tile_norm = layergeom->get_world_from_local_vect(tileid, _tGeometry, {0, 0, 1});
-      const double nx = tile_norm.x();
-      const double ny = tile_norm.y();
-
-      if(_zero_field) {
+    } else {
 
-        // calculate intersection to tile
-        if (!line_line_intersection(xy_m, xy_b, x0, y0, nx, ny, xplus, yplus, xminus, yminus))
+      // calculate intersection to tile
+      if (!circle_line_intersection(R, X0, Y0, x0, y0, nx, ny, xplus, yplus, xminus, yminus))
+      {
+        if (Verbosity() > 10)
         {
-          if (Verbosity() > 10)
-          {
-            std::cout << PHWHERE << "line_line_intersection - failed" << std::endl;
-          }
-          continue;
+          std::cout << PHWHERE << "circle_line_intersection - failed" << std::endl;
         }
+        continue;
+      }
 
-      } else {
+    }
 
-        // calculate intersection to tile
-        if (!circle_line_intersection(R, X0, Y0, x0, y0, nx, ny, xplus, yplus, xminus, yminus))
+    // select again angle closest to last cluster
+    phi_plus = std::atan2(yplus, xplus);
+    phi_minus = std::atan2(yminus, xminus);
+    const bool is_plus = (std::abs(last_clus_phi - phi_plus) < std::abs(last_clus_phi - phi_minus));
+
+    // calculate x, y and z
+    const double x = (is_plus ? xplus : xminus);
+    const double y = (is_plus ? yplus : yminus);
+    r = get_r(x, y);
+    z = B + A * r;
+
+    /*
+     * create planar intersection point in world coordinates
+     * this is the position to be compared to the clusters
+     */
+    const TVector3 world_intersection_planar(x, y, z);
+
+    // convert to tile local reference frame, apply SC correction
+    const Acts::Vector3 global(x * Acts::UnitConstants::cm, y * Acts::UnitConstants::cm, z * Acts::UnitConstants::cm);
+    const Acts::Vector3 local_intersection_planar = (tile.world_to_local * global) / Acts::UnitConstants::cm;
+
+    // store segmentation type
+    const auto segmentation_type = layergeom->get_segmentation_type();
+
+    // get clusters of the tile
+    const auto mm_clusrange = _cluster_map->getClusters(tile.tilesetid);
+
+    // do nothing if cluster range is empty
+    if( mm_clusrange.first == mm_clusrange.second )
+    { continue; }
+
+    // keep track of cluster with smallest distance to local intersection
+    double drphi_min = 0;
+    double dz_min = 0;
+    TrkrDefs::cluskey ckey_min = 0;
+    bool first = true;
+    for (auto clusiter = mm_clusrange.first; clusiter != mm_clusrange.second; ++clusiter)
+    {
+      const auto& [ckey, cluster] = *clusiter;
+      if (_iteration_map)
+      {
+        if (_iteration_map->getIteration(ckey) > 0)
         {
-          if (Verbosity() > 10)
-          {
-            std::cout << PHWHERE << "circle_line_intersection - failed" << std::endl;
-          }
           continue;
         }
-
       }
 
-      // select again angle closest to last cluster
-      phi_plus = std::atan2(yplus, xplus);
-      phi_minus = std::atan2(yminus, xminus);
-      const bool is_plus = (std::abs(last_clus_phi - phi_plus) < std::abs(last_clus_phi - phi_minus));
-
-      // calculate x, y and z
-      const double x = (is_plus ? xplus : xminus);
-      const double y = (is_plus ? yplus : yminus);
-      r = get_r(x, y);
-      z = B + A * r;
-
-      /*
-       * create planar intersection point in world coordinates
-       * this is the position to be compared to the clusters
-       */
-      const TVector3 world_intersection_planar(x, y, z);
-
-      // convert to tile local reference frame, apply SC correction
-      const auto local_intersection_planar = layergeom->get_local_from_world_coords(tileid, _tGeometry, world_intersection_planar);
-
-      // store segmentation type
-      const auto segmentation_type = layergeom->get_segmentation_type();
-
-      // generate tilesetid and get corresponding clusters
-      const auto tilesetid = MicromegasDefs::genHitSetKey(layer, segmentation_type, tileid);
-      const auto mm_clusrange = _cluster_map->getClusters(tilesetid);
-
-      // do nothing if cluster range is empty
-      if( mm_clusrange.first == mm_clusrange.second )
-      { continue; }
-
-      // keep track of cluster with smallest distance to local intersection
-      double drphi_min = 0;
-      double dz_min = 0;
-      TrkrDefs::cluskey ckey_min = 0;
-      bool first = true;
-      for (auto clusiter = mm_clusrange.first; clusiter != mm_clusrange.second; ++clusiter)
+      // compute residuals and store
+      /* in local tile coordinate, x is along rphi, and z is along y) */
+      const double drphi = local_intersection_planar.x() - cluster->getLocalX();
+      const double dz = local_intersection_planar.y() - cluster->getLocalY();
+      switch( segmentation_type )
       {
-        const auto& [ckey, cluster] = *clusiter;
-        if (_iteration_map)
+        case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
         {
-          if (_iteration_map->getIteration(ckey) > 0)
+          // reject if outside of strip boundary
+          if( std::abs(dz)>_z_search_win[imm] )
+          { continue; }
+
+          // keep as best if closer to projection
+          if( first || std::abs(drphi) < std::abs(drphi_min) )
           {
-            continue;
+            first = false;
+            drphi_min = drphi;
+            dz_min = dz;
+            ckey_min = ckey;
           }
+          break;
         }
 
-        // compute residuals and store
-        /* in local tile coordinate, x is along rphi, and z is along y) */
-        const double drphi = local_intersection_planar.x() - cluster->getLocalX();
-        const double dz = local_intersection_planar.y() - cluster->getLocalY();
-        switch( segmentation_type )
+        case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
         {
-          case MicromegasDefs::SegmentationType::SEGMENTATION_PHI:
-          {
-            // reject if outside of strip boundary
-            if( std::abs(dz)>_z_search_win[imm] )
-            { continue; }
-
-            // keep as best if closer to projection
-            if( first || std::abs(drphi) < std::abs(drphi_min) )
-            {
-              first = false;
-              drphi_min = drphi;
-              dz_min = dz;
-              ckey_min = ckey;
-            }
-            break;
-          }
+          // reject if outside of strip boundary
+          if( std::abs(drphi)>_rphi_search_win[imm] )
+          { continue; }
 
-          case MicromegasDefs::SegmentationType::SEGMENTATION_Z:
+          // keep as best if closer to projection
+          if( first || std::abs(dz) < std::abs(dz_min) )
           {
-            // reject if outside of strip boundary
-            if( std::abs(drphi)>_rphi_search_win[imm] )
-            { continue; }
-
-            // keep as best if closer to projection
-            if( first || std::abs(dz) < std::abs(dz_min) )
-            {
-              first = false;
-              drphi_min = drphi;
-              dz_min = dz;
-              ckey_min = ckey;
-            }
-            break;
+            first = false;
+            drphi_min = drphi;
+            dz_min = dz;
+            ckey_min = ckey;
           }
+          break;
         }
+      }
 
-        // prints out a line that can be grep-ed from the output file to feed to a display macro
-        // compare to cuts and add to track if matching
-        if( _test_windows && std::abs(drphi) < _rphi_search_win[imm] && std::abs(dz) < _z_search_win[imm])
-        {
-          // cluster rphi and z
-          const auto glob = _tGeometry->getGlobalPosition(ckey, cluster);
-          const double mm_clus_rphi = get_r(glob.x(), glob.y()) * std::atan2(glob.y(), glob.x());
-          const double mm_clus_z = glob.z();
-
-          // projection phi and z, without correction
-          const double rphi_proj = get_r(world_intersection_planar.x(), world_intersection_planar.y()) * std::atan2(world_intersection_planar.y(), world_intersection_planar.x());
-          const double z_proj = world_intersection_planar.z();
-
-          /*
-           * Note: drphi and dz might not match the difference of the rphi and z quoted values. This is because
-           * 1/ drphi and dz are actually calculated in Tile's local reference frame, not in world coordinates
-           * 2/ drphi also includes SC distortion correction, which the world coordinates don't
-          */
-          std::cout
-            << "  Try_mms: " << (int) layer
-            << " drphi " << drphi
-            << " dz " << dz
-            << " mm_clus_rphi " << mm_clus_rphi << " mm_clus_z " << mm_clus_z
-            << " rphi_proj " << rphi_proj << " z_proj " << z_proj
-            << " pt " << tracklet_tpc->get_pt()
-            << " charge " << tracklet_tpc->get_charge()
-            << std::endl;
-        }
-      }  // end loop over clusters
-
+      // prints out a line that can be grep-ed from the output file to feed to a display macro
       // compare to cuts and add to track if matching
-      if( (!first) && ckey_min > 0 && std::abs(drphi_min) < _rphi_search_win[imm] && std::abs(dz_min) < _z_search_win[imm])
+      if( _test_windows && std::abs(drphi) < _rphi_search_win[imm] && std::abs(dz) < _z_search_win[imm])
       {
-        tracklet_tpc->insert_cluster_key(ckey_min);
-        if (Verbosity() > 0)
-        {
-          std::cout << " Match to MM's found for seedID " << seedID << " tpcID " << tpcID << " siID " << siID << std::endl;
-        }
+        // cluster rphi and z
+        const auto glob = _tGeometry->getGlobalPosition(ckey, cluster);
+        const double mm_clus_rphi = get_r(glob.x(), glob.y()) * std::atan2(glob.y(), glob.x());
+        const double mm_clus_z = glob.z();
+
+        // projection phi and z, without correction
+        const double rphi_proj = get_r(world_intersection_planar.x(), world_intersection_planar.y()) * std::atan2(world_intersection_planar.y(), world_intersection_planar.x());
+        const double z_proj = world_intersection_planar.z();
+
+        /*
+         * Note: drphi and dz might not match the difference of the rphi and z quoted values. This is because
+         * 1/ drphi and dz are actually calculated in Tile's local reference frame, not in world coordinates
+         * 2/ drphi also includes SC distortion correction, which the world coordinates don't
+        */
+        std::cout
+          << "  Try_mms: " << (int) layer
+          << " drphi " << drphi
+          << " dz " << dz
+          << " mm_clus_rphi " << mm_clus_rphi << " mm_clus_z " << mm_clus_z
+          << " rphi_proj " << rphi_proj << " z_proj " << z_proj
+          << " pt " << tracklet_tpc->get_pt()
+          << " charge " << tracklet_tpc->get_charge()
+          << std::endl;
       }
+    }  // end loop over clusters
 
-    }  // end loop over Micromegas layers
+    // compare to cuts and add to track if matching
+    if( (!first) && ckey_min > 0 && std::abs(drphi_min) < _rphi_search_win[imm] && std::abs(dz_min) < _z_search_win[imm])
+    {
+      match.second.push_back(ckey_min);
+      if (Verbosity() > 0)
+      {
+        std::cout << " Match to MM's found for seedID " << seedID << " tpcID " << tpcID << " siID " << siID << std::endl;
+      }
+    }
 
-    if (Verbosity() > 3)
+  }  // end loop over Micromegas layers
+
+  return match;
+}
+
+//_________________________________________________________________________________________________
+void PHMicromegasTpcTrackMatching::SetupTileSurfaces()
+{
+  for (unsigned int imm = 0; imm < _n_mm_layers; ++imm)
+  {
+    const unsigned int layer = _min_mm_layer + imm;
+    const auto layergeom = static_cast<CylinderGeomMicromegas*>(_geomContainerMicromegas->GetLayerGeom(layer));
+    _mm_layer_radius[imm] = layergeom->get_radius();
+
+    auto& tiles = _tile_surfaces[imm];
+    tiles.clear();
+    for (unsigned int tileid = 0; tileid < layergeom->get_tiles_count(); ++tileid)
     {
-      tracklet_tpc->identify();
+      TileSurface tile;
+      tile.tilesetid = MicromegasDefs::genHitSetKey(layer, layergeom->get_segmentation_type(), tileid);
+      tile.center_phi = layergeom->get_tile(tileid).m_centerPhi;
+      tile.half_size_phi = layergeom->get_tile(tileid).m_sizePhi / 2;
+
+      const auto tile_center = layergeom->get_world_from_local_coords(tileid, _tGeometry, {0, 0});
+      tile.x0 = tile_center.x();
+      tile.y0 = tile_center.y();
+
+      const auto tile_norm = layergeom->get_world_from_local_vect(tileid, _tGeometry, {0, 0, 1});
+      tile.nx = tile_norm.x();
+      tile.ny = tile_norm.y();
+
+      const auto surface = _tGeometry->maps().getMMSurface(tile.tilesetid);
+      tile.world_to_local = surface->transform(_tGeometry->geometry().getGeoContext()).inverse();
+      tiles.push_back(tile);
     }
   }
+}
 
-  if (Verbosity() > 0)
+//_________________________________________________________________________________________________
+bool PHMicromegasTpcTrackMatching::can_reach_tile(const Acts::Vector3& position) const
+{
+  const double phi = std::atan2(position.y(), position.x());
+  const double r = get_r(position.x(), position.y());
+  for (unsigned int imm = 0; imm < _n_mm_layers; ++imm)
   {
-    std::cout << " Final seed map size " << _svtx_seed_map->size() << std::endl;
+    /*
+     * largest change of phi between r and the layer radius for a track from the beam line,
+     * reached by a straight line or circle tangent to the layer
+     */
+    const double dphi_max = M_PI / 2 - std::asin(std::min(1., r / _mm_layer_radius[imm])) + 0.1;
+    for (const auto& tile : _tile_surfaces[imm])
+    {
+      if (std::abs(bind_angle(phi - tile.center_phi)) < tile.half_size_phi + dphi_max)
+      {
+        return true;
+      }
+    }
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
+  return false;
 }
 
 //_________________________________________________________________________________________________
@@ -677,7 +819,7 @@ int PHMicromegasTpcTrackMatching::GetNodes(PHCompositeNode* topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-std::vector<TrkrDefs::cluskey> PHMicromegasTpcTrackMatching::getTrackletClusterList(TrackSeed* tracklet)
+std::vector<TrkrDefs::cluskey> PHMicromegasTpcTrackMatching::getTrackletClusterList(TrackSeed* tracklet) const
 {
   std::vector<TrkrDefs::cluskey> cluskey_vec;
   for (auto clusIter = tracklet->begin_cluster_keys();
@@ -9,8 +9,12 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <Acts/Definitions/Algebra.hpp>
+
 #include <array>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 class ActsGeometry;
@@ -19,6 +23,7 @@ class TrkrClusterIterationMapv1;
 class TrackSeedContainer;
 class PHCompositeNode;
 class PHG4CylinderGeomContainer;
+class PHThreadPool;
 class TrackSeed;
 class TrkrCluster;
 class TF1;
@@ -28,7 +33,7 @@ class PHMicromegasTpcTrackMatching : public SubsysReco
 {
  public:
   PHMicromegasTpcTrackMatching(const std::string& name = "PHMicromegasTpcTrackMatching");
-  ~PHMicromegasTpcTrackMatching() override = default;
+  ~PHMicromegasTpcTrackMatching() override;
 
   void set_rphi_search_window_lyr1(const double win) { _rphi_search_win[0] = win; }
   void set_z_search_window_lyr1(const double win) { _z_search_win[0] = win; }
@@ -39,6 +44,12 @@ class PHMicromegasTpcTrackMatching : public SubsysReco
   void set_pp_mode(const bool mode) { _pp_mode = mode; }
   void SetIteration(int iter) { _n_iteration = iter; }
 
+  //! match the seeds on nthreads threads, 0 uses all cores, 1 (default) runs serially
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
+
+  //! skip the tracklets whose outermost cluster is too far in phi from all tiles (default true)
+  void set_phi_prefilter(const bool flag) { _phi_prefilter = flag; }
+
   void zeroField(const bool flag) { _zero_field = flag; }
 
   int InitRun(PHCompositeNode* topNode) override;
@@ -55,6 +66,18 @@ class PHMicromegasTpcTrackMatching : public SubsysReco
 
   void copyMicromegasClustersToCorrectedMap();
 
+  //! tpc tracklet of a seed and the micromegas clusters to add to it
+  using SeedMatch = std::pair<TrackSeed*, std::vector<TrkrDefs::cluskey>>;
+
+  //! find the micromegas clusters matching a seed, does not modify the tracklet
+  SeedMatch MatchSeed(const unsigned int seedID) const;
+
+  //! tile positions and transformations, computed once per run
+  void SetupTileSurfaces();
+
+  //! true if a track through position can reach one of the tiles in phi
+  bool can_reach_tile(const Acts::Vector3& position) const;
+
   //! number of layers in the micromegas
   static constexpr unsigned int _n_mm_layers{2};
   
@@ -74,7 +97,7 @@ class PHMicromegasTpcTrackMatching : public SubsysReco
   std::array<double, _n_mm_layers> _z_search_win{26.0, 0.25};
 
   // get the cluster list for zeroField
-  std::vector<TrkrDefs::cluskey> getTrackletClusterList(TrackSeed* tracklet);
+  std::vector<TrkrDefs::cluskey> getTrackletClusterList(TrackSeed* tracklet) const;
   // range of TPC layers to use in projection to micromegas
   unsigned int _min_tpc_layer{38};
 
@@ -87,6 +110,32 @@ class PHMicromegasTpcTrackMatching : public SubsysReco
 
   //! micomegas geometry
   PHG4CylinderGeomContainer* _geomContainerMicromegas{nullptr};
+
+  //! tile geometry in world coordinates (cm)
+  class TileSurface
+  {
+   public:
+    TrkrDefs::hitsetkey tilesetid{0};
+    double center_phi{0};
+    double half_size_phi{0};
+    double x0{0};
+    double y0{0};
+    double nx{0};
+    double ny{0};
+    Acts::Transform3 world_to_local{Acts::Transform3::Identity()};
+  };
+
+  //! tiles of each micromegas layer
+  std::array<std::vector<TileSurface>, _n_mm_layers> _tile_surfaces;
+
+  //! radius of each micromegas layer
+  std::array<double, _n_mm_layers> _mm_layer_radius{};
+
+  bool _phi_prefilter{true};
+
+  unsigned int m_nthreads{1};
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   TrkrClusterIterationMapv1* _iteration_map{nullptr};
   int _n_iteration{0};
 
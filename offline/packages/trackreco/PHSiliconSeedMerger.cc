@@ -52,94 +52,69 @@ int PHSiliconSeedMerger::process_event(PHCompositeNode *)
       std::cout << "Silicon seed track container has " << m_siliconTracks->size() << std::endl;
     }
   
+  /// flat copy of the seed cluster keys, so that the pair loop below
+  /// does not rebuild a std::set for every pair of seeds
+  const bool mvtxOnly = m_mvtxOnly;
+  m_seedArray.fill(m_siliconTracks, [mvtxOnly](TrkrDefs::cluskey ckey)
+    { return !(mvtxOnly && TrkrDefs::getTrkrId(ckey) == TrkrDefs::TrkrId::inttId); });
+
+  /// seeds without a common cluster key cannot pass the overlap cut,
+  /// so each seed is only compared to the seeds sharing one of its keys
+  m_clusterIndex.clear();
+  for(unsigned int trackID = 0; trackID != m_seedArray.size(); ++trackID)
+    {
+      const auto seed = m_seedArray[trackID];
+      if(seed.valid())
+	{ m_clusterIndex.add(trackID, seed.begin_cluster_keys(), seed.end_cluster_keys()); }
+    }
+  m_clusterIndex.build();
+
   for(unsigned int track1ID = 0;
-      track1ID != m_siliconTracks->size(); 
+      track1ID != m_seedArray.size();
       ++track1ID)
     {
-      TrackSeed* track1 = m_siliconTracks->get(track1ID);
-
       if(seedsToDelete.find(track1ID) != seedsToDelete.end())
 	{ continue; }
 
-      std::set<TrkrDefs::cluskey> mvtx1Keys;
-      for (TrackSeed::ConstClusterKeyIter iter = track1->begin_cluster_keys();
-           iter != track1->end_cluster_keys();
-           ++iter)
-	{
-	  TrkrDefs::cluskey ckey = *iter;
-          auto trkrid = TrkrDefs::getTrkrId(ckey);
-		  if(m_mvtxOnly && trkrid == TrkrDefs::TrkrId::inttId)
-		  {
-                    continue;
-                  }
-
-            mvtx1Keys.insert(ckey); 
-			}
-	
-   
+      const auto seed1 = m_seedArray[track1ID];
+      if(!seed1.valid())
+	{ continue; }
+
       /// We can speed up the code by only iterating over the track seeds
       /// that are further in the map container from the current track,
       /// since the comparison of e.g. track 1 with track 2 doesn't need
-      /// to be repeated with track 2 to track 1.
-      for(unsigned int track2ID = track1ID;
-	  track2ID != m_siliconTracks->size();
-	  ++track2ID) 
+      /// to be repeated with track 2 to track 1. Candidates are sorted,
+      /// so the first match is the same as in a loop over all seeds
+      m_clusterIndex.shared_seeds(seed1.begin_cluster_keys(), seed1.end_cluster_keys(), track1ID, m_candidates);
+      for(const auto track2ID : m_candidates)
 	{
-	  if(track1ID == track2ID)
-	    { continue; }
-
-	  TrackSeed* track2 = m_siliconTracks->get(track2ID);
-	  std::set<TrkrDefs::cluskey> mvtx2Keys;
-	  for (TrackSeed::ConstClusterKeyIter iter = track2->begin_cluster_keys();
-	       iter != track2->end_cluster_keys();
-	       ++iter)
-	    {
-	      TrkrDefs::cluskey ckey = *iter;
-              auto trkrid = TrkrDefs::getTrkrId(ckey);
-              if (m_mvtxOnly && trkrid == TrkrDefs::TrkrId::inttId)
-              {
-                continue;
-              }
-         mvtx2Keys.insert(ckey); 
-	    }
-
-	  std::vector<TrkrDefs::cluskey> intersection;
-	  std::set_intersection(mvtx1Keys.begin(),
-				mvtx1Keys.end(),
-				mvtx2Keys.begin(),
-				mvtx2Keys.end(),
-				std::back_inserter(intersection));
+	  const auto seed2 = m_seedArray[track2ID];
 
 	  /// If we have two clusters in common in the triplet, it is likely
 	  /// from the same track
-	  if(intersection.size() > m_clusterOverlap) 
+	  if(TrackSeedArray::count_common_keys(seed1, seed2) > m_clusterOverlap)
 	    {
-	      if(Verbosity() > 2) 
+	      if(Verbosity() > 2)
 		{
 		  std::cout << "Track " << track1ID << " keys " << std::endl;
-		  for(auto& key : mvtx1Keys) 
-		    { std::cout << "   ckey: " << key << std::endl; }
+		  for(auto iter = seed1.begin_cluster_keys(); iter != seed1.end_cluster_keys(); ++iter)
+		    { std::cout << "   ckey: " << *iter << std::endl; }
 		  std::cout << "Track " << track2ID << " keys " << std::endl;
-		  for(auto& key : mvtx2Keys) 
-		    { std::cout << "   ckey: " << key << std::endl; }
-		  std::cout << "Intersection keys " << std::endl;
-		  for(auto& key : intersection)
-		    { std::cout << "   ckey: " << key << std::endl; }
+		  for(auto iter = seed2.begin_cluster_keys(); iter != seed2.end_cluster_keys(); ++iter)
+		    { std::cout << "   ckey: " << *iter << std::endl; }
 		}
 
-	      for(auto& key : mvtx2Keys)
-		{
-		  mvtx1Keys.insert(key); 
-		}
-	      
+	      std::set<TrkrDefs::cluskey> mvtx1Keys(seed1.begin_cluster_keys(), seed1.end_cluster_keys());
+	      mvtx1Keys.insert(seed2.begin_cluster_keys(), seed2.end_cluster_keys());
+
 	      if(Verbosity() > 2)
-		{ 
-		  std::cout << "Match IDed"<<std::endl; 
+		{
+		  std::cout << "Match IDed"<<std::endl;
 		  for(auto& key : mvtx1Keys)
 		    { std::cout << "  total track keys " << key << std::endl; }
 		}
 
-	      matches.insert(std::make_pair(track1ID, mvtx1Keys)); 
+	      matches.insert(std::make_pair(track1ID, mvtx1Keys));
 	      seedsToDelete.insert(track2ID);
 	      break;
 	    }
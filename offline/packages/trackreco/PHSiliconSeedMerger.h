@@ -5,6 +5,9 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <trackbase_historic/TrackSeedArray.h>
+#include <trackbase_historic/TrackSeedClusterIndex.h>
+
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -38,6 +41,15 @@ class PHSiliconSeedMerger : public SubsysReco
   std::string m_trackMapName {"SiliconTrackSeedContainer"};
   unsigned int m_clusterOverlap {1};
   bool m_mvtxOnly {true};
+
+  /// flat copy of the seeds, reused across events
+  TrackSeedArray m_seedArray;
+
+  /// seeds of each cluster key, reused across events
+  TrackSeedClusterIndex m_clusterIndex;
+
+  /// seeds sharing a cluster with the current one
+  std::vector<unsigned int> m_candidates;
 };
 
 #endif // PHSILICONSEEDMERGER_H
@@ -25,12 +25,14 @@
 
 #include <phool/PHCompositeNode.h>
 #include <phool/getClass.h>
+#include <phool/PHTimer.h>
 #include <phool/phool.h>
 
 #include <TF1.h>
 #include <TFile.h>
 #include <TNtuple.h>
 
+#include <algorithm>
 #include <climits>   // for UINT_MAX
 #include <cmath>     // for fabs, sqrt
 #include <iostream>  // for operator<<, basic_ostream
@@ -136,12 +138,25 @@ int PHSiliconTpcTrackMatching::process_event(PHCompositeNode * /*unused*/)
   std::multimap<unsigned int, unsigned int> tpc_matches;
   std::set<unsigned int> tpc_matched_set;
   std::set<unsigned int> tpc_unmatched_set;
+
+  PHTimer matchTimer("matchTimer");
+  matchTimer.restart();
+
+  fillSiliconParams();
   findEtaPhiMatches(tpc_matched_set, tpc_unmatched_set, tpc_matches);
 
   // Check that the crossing number is consistent with the tracklet z mismatch, removethe match otherwise
   // This does nothing if the crossing number is not set
   checkCrossingMatches(tpc_matches);
 
+  matchTimer.stop();
+  _matching_time += matchTimer.get_accumulated_time();
+  if (Verbosity() > 0)
+  {
+    std::cout << PHWHERE << " matching time " << matchTimer.get_accumulated_time() << " ms"
+              << " for " << tpc_matches.size() << " matches" << std::endl;
+  }
+
   // We have a complete list of all eta/phi matched tracks in the map "tpc_matches"
   // make the combined track seeds from tpc_matches
   for (auto [tpcid, si_id] : tpc_matches)
@@ -272,6 +287,11 @@ double PHSiliconTpcTrackMatching::getBunchCrossing(unsigned int trid, double z_m
 
 int PHSiliconTpcTrackMatching::End(PHCompositeNode * /*unused*/)
 {
+  if (Verbosity() > 0)
+  {
+    std::cout << PHWHERE << " total matching time " << _matching_time << " ms for " << m_event << " events" << std::endl;
+  }
+
   if(_test_windows)
   {
   _file->cd();
@@ -356,6 +376,80 @@ int PHSiliconTpcTrackMatching::GetNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHSiliconTpcTrackMatching::fillSiliconParams()
+{
+  _silicon_params.assign(_track_map_silicon->size(), SiliconSeedParams());
+
+  std::vector<PhiZGrid<unsigned int>::Entry> entries;
+  entries.reserve(_track_map_silicon->size());
+
+  for (unsigned int phtrk_iter_si = 0;
+       phtrk_iter_si < _track_map_silicon->size();
+       ++phtrk_iter_si)
+  {
+    auto tracklet_si = _track_map_silicon->get(phtrk_iter_si);
+    if (!tracklet_si)
+    {
+      continue;
+    }
+
+    auto &params = _silicon_params[phtrk_iter_si];
+    if (_zero_field)
+    {
+      auto cluster_list = getTrackletClusterList(tracklet_si);
+
+      Acts::Vector3 mom;
+      bool ok_track;
+      double si_pt;
+
+      std::tie(ok_track, params.phi, params.eta, si_pt, params.pos, mom) =
+          TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
+      if (!ok_track)
+      {
+        continue;
+      }
+      params.px = mom.x();
+      params.py = mom.y();
+      params.pz = mom.z();
+      params.q = -100;
+    }
+    else
+    {
+      params.eta = tracklet_si->get_eta();
+      params.phi = tracklet_si->get_phi();
+
+      params.pos = TrackSeedHelper::get_xyz(tracklet_si);
+      params.px = tracklet_si->get_px();
+      params.py = tracklet_si->get_py();
+      params.pz = tracklet_si->get_pz();
+      params.q = tracklet_si->get_charge();
+    }
+    params.crossing = tracklet_si->get_crossing();
+    params.valid = true;
+
+    // seeds with undefined direction can never pass the eta and phi cuts
+    if (std::isfinite(params.phi) && std::isfinite(params.eta))
+    {
+      entries.push_back({static_cast<float>(normalize_phi(params.phi)), static_cast<float>(params.eta), phtrk_iter_si});
+    }
+  }
+
+  _silicon_grid.set_bin_size(_phi_search_win, _eta_search_win);
+  _silicon_grid.fill(entries);
+}
+
+//_________________________________________________________________________________
+double PHSiliconTpcTrackMatching::normalize_phi(double phi)
+{
+  phi = std::fmod(phi, 2. * M_PI);
+  if (phi < 0)
+  {
+    phi += 2. * M_PI;
+  }
+  return phi;
+}
+
+//_________________________________________________________________________________
 void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     std::set<unsigned int> &tpc_matched_set,
     std::set<unsigned int> &tpc_unmatched_set,
@@ -453,47 +547,59 @@ void PHSiliconTpcTrackMatching::findEtaPhiMatches(
     bool matched = false;
 
     // Now search the silicon track list for a match in eta and phi
-    for (unsigned int phtrk_iter_si = 0;
-         phtrk_iter_si < _track_map_silicon->size();
-         ++phtrk_iter_si)
+    // only the silicon seeds from the neighboring grid bins are tested, unless all pairs are needed for the test ntuple
+    std::vector<unsigned int> candidates;
+    if (_use_silicon_grid && !_test_windows)
     {
-      _tracklet_si = _track_map_silicon->get(phtrk_iter_si);
-      if (!_tracklet_si)
+      // the windows are slightly enlarged so that float rounding in the grid never removes a valid pair
+      static constexpr double grid_margin = 1e-4;
+      const double phi_win = _phi_search_win * mag + grid_margin;
+      const double eta_win = _eta_search_win * mag + grid_margin;
+      const double phi = normalize_phi(tpc_phi);
+      // seeds with undefined direction or window cannot pass the cuts
+      if (std::isfinite(phi) && std::isfinite(tpc_eta) && std::isfinite(phi_win) && std::isfinite(eta_win))
       {
-
-        continue;
+        const auto add_candidate = [&candidates](const PhiZGrid<unsigned int>::Entry &entry)
+        { candidates.push_back(entry.value); };
+        if (phi_win < M_PI)
+        {
+          _silicon_grid.query(phi - phi_win, tpc_eta - eta_win, phi + phi_win, tpc_eta + eta_win, add_candidate);
+        }
+        else
+        {
+          _silicon_grid.query(0, tpc_eta - eta_win, 2. * M_PI, tpc_eta + eta_win, add_candidate);
+        }
       }
-      bool eta_match = false;
 
-    double si_phi, si_eta, si_pt;
-    float si_px, si_py, si_pz;
-    int si_q;
-    Acts::Vector3 si_pos;
-    if (_zero_field) {
-      auto cluster_list = getTrackletClusterList(_tracklet_si);
+      // same order as the loop over all silicon seeds
+      std::sort(candidates.begin(), candidates.end());
+    }
+    else
+    {
+      candidates.reserve(_silicon_params.size());
+      for (unsigned int phtrk_iter_si = 0; phtrk_iter_si < _silicon_params.size(); ++phtrk_iter_si)
+      {
+        if (_silicon_params[phtrk_iter_si].valid)
+        {
+          candidates.push_back(phtrk_iter_si);
+        }
+      }
+    }
 
-      Acts::Vector3  mom;
-      bool ok_track;
+    for (const auto& siid : candidates)
+    {
+      _tracklet_si = _track_map_silicon->get(siid);
+      bool eta_match = false;
 
-      std::tie(ok_track, si_phi, si_eta, si_pt, si_pos, mom) = 
-        TrackFitUtils::zero_field_track_params(_tGeometry, _cluster_map, cluster_list);
-      if (!ok_track) { continue; }
-      si_px = mom.x();
-      si_py = mom.y();
-      si_pz = mom.z();
-      si_q = -100;
-    } else {
-      si_eta = _tracklet_si->get_eta();
-      si_phi = _tracklet_si->get_phi();
-
-      si_pos = TrackSeedHelper::get_xyz(_tracklet_si);
-      si_px = _tracklet_si->get_px();
-      si_py = _tracklet_si->get_py();
-      si_pz = _tracklet_si->get_pz();
-	    si_q = _tracklet_si->get_charge();
-    }
-	  int si_crossing = _tracklet_si->get_crossing();
-    unsigned int siid = phtrk_iter_si;
+      const auto& si_params = _silicon_params[siid];
+      const double si_phi = si_params.phi;
+      const double si_eta = si_params.eta;
+      const Acts::Vector3& si_pos = si_params.pos;
+      const float si_px = si_params.px;
+      const float si_py = si_params.py;
+      const float si_pz = si_params.pz;
+      const int si_q = si_params.q;
+      const int si_crossing = si_params.crossing;
 
   if(_test_windows)
   {
@@ -7,8 +7,11 @@
 #include <phparameter/PHParameterInterface.h>
 #include <trackbase/ActsGeometry.h>
 
+#include "PhiZGrid.h"
+
 #include <map>
 #include <string>
+#include <vector>
 
 class PHCompositeNode;
 class TrackSeedContainer;
@@ -54,6 +57,13 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   void set_pp_mode(const bool flag) { _pp_mode = flag; }
   void set_use_intt_crossing(const bool flag) { _use_intt_crossing = flag; }
 
+  /// if true (default), silicon seeds are binned in (phi, eta) once per event and each TPC seed
+  /// only tests the silicon seeds of neighboring bins. The matching windows are unchanged
+  void set_use_silicon_grid(const bool flag) { _use_silicon_grid = flag; }
+
+  /// accumulated time spent in matching (ms)
+  double get_matching_time() const { return _matching_time; }
+
   int InitRun(PHCompositeNode *topNode) override;
 
   int process_event(PHCompositeNode *) override;
@@ -69,6 +79,26 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
  private:
   int GetNodes(PHCompositeNode *topNode);
 
+  /// silicon seed parameters used for matching, computed once per event
+  struct SiliconSeedParams
+  {
+    bool valid = false;
+    double phi = 0;
+    double eta = 0;
+    Acts::Vector3 pos = Acts::Vector3::Zero();
+    float px = 0;
+    float py = 0;
+    float pz = 0;
+    int q = 0;
+    short int crossing = 0;
+  };
+
+  /// fill silicon seed parameters and the (phi, eta) grid
+  void fillSiliconParams();
+
+  /// map phi to [0, 2pi[
+  static double normalize_phi(double phi);
+
   void findEtaPhiMatches(std::set<unsigned int> &tpc_matched_set,
                          std::set<unsigned int> &tpc_unmatched_set,
                          std::multimap<unsigned int, unsigned int> &tpc_matches);
@@ -118,6 +148,11 @@ class PHSiliconTpcTrackMatching : public SubsysReco, public PHParameterInterface
   bool _test_windows = false;
   bool _pp_mode = false;
   bool _use_intt_crossing = true;  // should always be true except for testing
+  bool _use_silicon_grid = true;
+
+  std::vector<SiliconSeedParams> _silicon_params;
+  PhiZGrid<unsigned int> _silicon_grid;
+  double _matching_time = 0;
 
   int _n_iteration = 0;
   std::string _track_map_name = "TpcTrackSeedContainer";
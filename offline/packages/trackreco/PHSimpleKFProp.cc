@@ -38,6 +38,8 @@
 
 #include <fun4all/Fun4AllReturnCodes.h>
 
+#include <phool/PHCounter.h>
+#include <phool/PHThreadPool.h>
 #include <phool/PHTimer.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
@@ -74,6 +76,8 @@ PHSimpleKFProp::PHSimpleKFProp(const std::string& name)
 {
 }
 
+PHSimpleKFProp::~PHSimpleKFProp() = default;
+
 int PHSimpleKFProp::End(PHCompositeNode* /*unused*/)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -116,6 +120,11 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   }
   //  fcfg.set_rescale(1);
   _field_map = std::unique_ptr<PHField>(PHFieldUtility::BuildFieldMap(&fcfg));
+  if (!_use_const_field && _use_bz_table)
+  {
+    // r beyond the TPC outer radius, z up to where get_Bz switches to the constant field
+    _bz_table.build(_field_map.get(), 85., -105.5, 105.5, 0.5);
+  }
 
   fitter = std::make_unique<ALICEKF>(topNode, _cluster_map, _field_map.get(), _fieldDir,
                                      _min_clusters_per_track, _max_sin_phi, Verbosity());
@@ -130,6 +139,26 @@ int PHSimpleKFProp::InitRun(PHCompositeNode* topNode)
   fitter->setFixedClusterError(0, _fixed_clus_err.at(0));
   fitter->setFixedClusterError(1, _fixed_clus_err.at(1));
   fitter->setFixedClusterError(2, _fixed_clus_err.at(2));
+  if (!_bz_table.empty())
+  {
+    fitter->setBzTable(&_bz_table);
+  }
+
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHSimpleKFProp::InitRun - propagating seeds with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
+  PHCounterRegistry* counters = PHCounterRegistry::instance();
+  m_cnt_seeds = counters->get(Name(), "seeds");
+  m_cnt_kdtree_queries = counters->get(Name(), "kdtree_queries");
+  m_cnt_clusters_added = counters->get(Name(), "clusters_added");
+  m_cnt_chains_rejected = counters->get(Name(), "chains_rejected");
+  m_cnt_ghosts_rejected = counters->get(Name(), "ghosts_rejected");
   //  _field_map = PHFieldUtility::GetFieldMapNode(nullptr,topNode);
   // m_Cache = magField->makeCache(m_tGeometry->magFieldContext);
 
@@ -142,6 +171,10 @@ double PHSimpleKFProp::get_Bz(double x, double y, double z) const
   {
     return _const_field;
   }
+  if (!_bz_table.empty())
+  {
+    return _bz_table.get(x, y, z);
+  }
   double p[4] = {x * cm, y * cm, z * cm, 0. * cm};
   double bfield[3];
   _field_map->GetFieldValue(p, bfield);
@@ -252,10 +285,21 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       return Fun4AllReturnCodes::ABORTEVENT;
     }
   }
-  std::vector<std::vector<TrkrDefs::cluskey>> new_chains;
-  std::vector<TrackSeed_v2> unused_tracks;
-  for (size_t track_it = 0; track_it != _track_map->size(); ++track_it)
-  {
+  m_cnt_seeds->add(_track_map->size());
+  // the seeds are propagated independently (the KD trees and the Bz table are
+  // read only), the chains are collected in seed order
+  enum class SeedState : char
+  {
+    Skipped,
+    Propagated,
+    NotTpc
+  };
+  const size_t nseeds = _track_map->size();
+  std::vector<std::vector<TrkrDefs::cluskey>> seed_chains(nseeds);
+  std::vector<SeedState> seed_state(nseeds, SeedState::Skipped);
+  auto propagate_counted = [&](const size_t track_it, PropagationCounts& counts)
+  {
+    PHTimer seedtimer("KFPropSeedTimer");
     if (Verbosity())
     {
       std::cout << "TPC seed " << track_it << std::endl;
@@ -278,44 +322,44 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       // copy seed clusters position into local map
       std::map<TrkrDefs::cluskey, Acts::Vector3> trackClusPositions;
       std::transform(track->begin_cluster_keys(), track->end_cluster_keys(), std::inserter(trackClusPositions, trackClusPositions.end()),
-        [globalPositions](const auto& key)
+        [&globalPositions](const auto& key)
         { return std::make_pair(key, globalPositions.at(key)); });
 
       /// Can't circle fit a seed with less than 3 clusters, skip it
       if (keylist_A[0].size() < 3)
       {
-        continue;
+        return;
       }
 
       /// This will by definition return a single pair with each vector
       /// in the pair length 1 corresponding to the seed info
       std::vector<float> trackChi2;
-      timer.stop();
-      timer.restart();
+      seedtimer.stop();
+      seedtimer.restart();
 
       auto seedpair = fitter->ALICEKalmanFilter(keylist_A, false,
                                                 trackClusPositions, trackChi2);
 
-      timer.stop();
+      seedtimer.stop();
       if (Verbosity() > 3)
       {
-        std::cout << "single track ALICEKF time " << timer.elapsed()
+        std::cout << "single track ALICEKF time " << seedtimer.elapsed()
                   << std::endl;
       }
-      timer.restart();
+      seedtimer.restart();
 
       /// circle fit back to update track parameters
       TrackSeedHelper::circleFitByTaubin(track, trackClusPositions, 7, 55);
       TrackSeedHelper::lineFit(track, trackClusPositions, 7, 55);
       track->set_phi(TrackSeedHelper::get_phi(track, trackClusPositions));
-      timer.stop();
+      seedtimer.stop();
       if (Verbosity() > 3)
       {
-        std::cout << "single track circle fit time " << timer.elapsed() << std::endl;
+        std::cout << "single track circle fit time " << seedtimer.elapsed() << std::endl;
       }
       if (seedpair.first.empty()|| seedpair.second.empty())
       {
-        continue;
+        return;
       }
 
       if (Verbosity())
@@ -323,15 +367,15 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
         std::cout << "is tpc track" << std::endl;
       }
 
-      timer.stop();
-      timer.restart();
+      seedtimer.stop();
+      seedtimer.restart();
 
       if (Verbosity())
       {
         std::cout << "propagate first round" << std::endl;
       }
 
-      auto preseed = PropagateTrack(track, PropagationDirection::Inward, seedpair.second.at(0), globalPositions);
+      auto preseed = PropagateTrack(track, PropagationDirection::Inward, seedpair.second.at(0), globalPositions, counts);
       if (Verbosity())
       {
         std::cout << "preseed size " << preseed.size() << std::endl;
@@ -346,7 +390,7 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       auto prepair = fitter->ALICEKalmanFilter(kl, false, globalPositions, pretrackChi2);
       if (prepair.first.empty() || prepair.second.empty())
       {
-        continue;
+        return;
       }
 
       std::reverse(kl.at(0).begin(), kl.at(0).end());
@@ -356,7 +400,7 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       // copy seed clusters position into local map
       std::map<TrkrDefs::cluskey, Acts::Vector3> pretrackClusPositions;
       std::transform(pretrack.begin_cluster_keys(), pretrack.end_cluster_keys(), std::inserter(pretrackClusPositions, pretrackClusPositions.end()),
-        [globalPositions](const auto& key)
+        [&globalPositions](const auto& key)
         { return std::make_pair(key, globalPositions.at(key)); });
 
       // fit seed
@@ -365,33 +409,68 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
       pretrack.set_phi(TrackSeedHelper::get_phi(&pretrack, pretrackClusPositions));
 
       prepair.second.at(0).SetDzDs(-prepair.second.at(0).GetDzDs());
-      auto finalchain = PropagateTrack(&pretrack, kl.at(0), PropagationDirection::Outward, prepair.second.at(0), globalPositions);
+      auto finalchain = PropagateTrack(&pretrack, kl.at(0), PropagationDirection::Outward, prepair.second.at(0), globalPositions, counts);
 
       if (finalchain.size() > kl.at(0).size())
       {
-        new_chains.push_back(finalchain);
+        seed_chains[track_it] = std::move(finalchain);
       }
       else
       {
-        new_chains.push_back(kl.at(0));
+        seed_chains[track_it] = std::move(kl.at(0));
       }
+      seed_state[track_it] = SeedState::Propagated;
 
-      timer.stop();
+      seedtimer.stop();
 
       if (Verbosity() > 3)
       {
-        const auto propagatetime = timer.elapsed();
+        const auto propagatetime = seedtimer.elapsed();
         std::cout << "propagate track time " << propagatetime << std::endl;
       }
     }
     else
     {
-      // this is bad: it copies the track to its base class, which is essentially empty
       if (Verbosity())
       {
         std::cout << "is NOT tpc track" << std::endl;
       }
-      unused_tracks.emplace_back(*track);
+      seed_state[track_it] = SeedState::NotTpc;
+    }
+  };
+  auto propagate_seed = [&](const size_t track_it)
+  {
+    PropagationCounts counts;
+    propagate_counted(track_it, counts);
+    m_cnt_kdtree_queries->add(counts.kdtree_queries);
+    m_cnt_clusters_added->add(counts.clusters_added);
+  };
+  if (m_threadpool && Verbosity() == 0)
+  {
+    // the workers look up clusters, decode them all first
+    _cluster_map->decodeAll();
+    m_threadpool->parallel_for(nseeds, propagate_seed);
+  }
+  else
+  {
+    for (size_t track_it = 0; track_it != nseeds; ++track_it)
+    {
+      propagate_seed(track_it);
+    }
+  }
+
+  std::vector<std::vector<TrkrDefs::cluskey>> new_chains;
+  std::vector<TrackSeed_v2> unused_tracks;
+  for (size_t track_it = 0; track_it != nseeds; ++track_it)
+  {
+    if (seed_state[track_it] == SeedState::Propagated)
+    {
+      new_chains.push_back(std::move(seed_chains[track_it]));
+    }
+    else if (seed_state[track_it] == SeedState::NotTpc)
+    {
+      // this is bad: it copies the track to its base class, which is essentially empty
+      unused_tracks.emplace_back(*_track_map->get(track_it));
     }
   }
 
@@ -400,6 +479,7 @@ int PHSimpleKFProp::process_event(PHCompositeNode* topNode)
   timer.restart();
 
   const auto clean_chains = RemoveBadClusters(new_chains, globalPositions);
+  m_cnt_chains_rejected->add(new_chains.size() - clean_chains.size());
   if (Verbosity() > 1)
   {
     std::cout << "clean_chains size: " << clean_chains.size() << std::endl;
@@ -625,7 +705,7 @@ bool PHSimpleKFProp::TransportAndRotate(double old_radius, double new_radius, do
   return true;
 }
 
-bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const
+bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions, PropagationCounts& counts) const
 {
   // give up if position vector is NaN (propagation failed)
   if (std::isnan(kftrack.GetX()) ||
@@ -900,6 +980,7 @@ bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_
   std::vector<long unsigned int> index_out(1);
   std::vector<double> distance_out(1);
   int n_results = _kdtrees[next_layer]->knnSearch(&query_pt[0], 1, &index_out[0], &distance_out[0]);
+  ++counts.kdtree_queries;
   // if no results, then no cluster to add, but propagation is not necessarily done
   if (!n_results)
   {
@@ -953,6 +1034,7 @@ bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_
       std::cout << "added cluster" << std::endl;
     }
     propagated_track.push_back(closest_ckey);
+    ++counts.clusters_added;
 
     // don't re-filter clusters that are already in original seed
     if (std::find(ckeys.begin(), ckeys.end(), closest_ckey) == ckeys.end())
@@ -994,7 +1076,7 @@ bool PHSimpleKFProp::PropagateStep(unsigned int& current_layer, double& current_
   return true;
 }
 
-std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const
+std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions, PropagationCounts& counts) const
 {
   // extract cluster list
 
@@ -1006,10 +1088,10 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
     std::reverse(ckeys.begin(), ckeys.end());
   }
 
-  return PropagateTrack(track, ckeys, direction, aliceSeed, globalPositions);
+  return PropagateTrack(track, ckeys, direction, aliceSeed, globalPositions, counts);
 }
 
-std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const
+std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions, PropagationCounts& counts) const
 {
   if (direction == PropagationDirection::Inward)
   {
@@ -1279,7 +1361,7 @@ std::vector<TrkrDefs::cluskey> PHSimpleKFProp::PropagateTrack(TrackSeed* track,
                 << "------------------------" << std::endl
                 << "step " << step << std::endl;
     }
-    if (!PropagateStep(old_layer, old_phi, direction, propagated_track, ckeys, aliceSeed, fp, globalPositions))
+    if (!PropagateStep(old_layer, old_phi, direction, propagated_track, ckeys, aliceSeed, fp, globalPositions, counts))
     {
       break;
     }
@@ -1403,6 +1485,7 @@ void PHSimpleKFProp::rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, con
   {
     if (rejector.is_rejected(itrack))
     {
+      m_cnt_ghosts_rejected->add();
       if (Verbosity() > 0)
       {
         std::cout << " Seed " << ((int) itrack) << " rejected. Not getting published." << std::endl;
@@ -8,6 +8,7 @@
 #define TRACKRECO_PHSIMPLEKFPROP_H
 
 #include "ALICEKF.h"
+#include "BzRZTable.h"
 #include "nanoflann.hpp"
 
 // PHENIX includes
@@ -31,7 +32,9 @@
 
 class ActsGeometry;
 class PHCompositeNode;
+class PHCounter;
 class PHField;
+class PHThreadPool;
 class TrkrClusterContainer;
 class TrkrClusterIterationMapv1;
 class SvtxTrackMap;
@@ -44,7 +47,7 @@ class PHSimpleKFProp : public SubsysReco
 {
  public:
   PHSimpleKFProp(const std::string& name = "PHSimpleKFProp");
-  ~PHSimpleKFProp() override = default;
+  ~PHSimpleKFProp() override;
 
   int InitRun(PHCompositeNode* topNode) override;
   int process_event(PHCompositeNode* topNode) override;
@@ -62,6 +65,8 @@ class PHSimpleKFProp : public SubsysReco
   void magFieldFile(const std::string& fname) { m_magField = fname; }
   void set_max_window(double s) { _max_dist = s; }
   void useConstBField(bool opt) { _use_const_field = opt; }
+  /// Bz from a (r, z) table built from the field map in InitRun (default), instead of the full field map
+  void useBzTable(bool opt) { _use_bz_table = opt; }
   void setConstBField(float b) { _const_field = b; }
   void useFixedClusterError(bool opt) { _use_fixed_clus_err = opt; }
   void setFixedClusterError(int i, double val) { _fixed_clus_err.at(i) = val; }
@@ -72,6 +77,8 @@ class PHSimpleKFProp : public SubsysReco
   void SetIteration(int iter) { _n_iteration = iter; }
   void set_pp_mode(bool mode) { _pp_mode = mode; }
   void set_max_seeds(unsigned int ui) { _max_seeds = ui; }
+  //! propagate the seeds on nthreads threads, 0 uses all cores, 1 (default) runs serially
+  void set_num_threads(unsigned int nthreads) { m_nthreads = nthreads; }
   enum class PropagationDirection
   {
     Outward,
@@ -117,6 +124,11 @@ class PHSimpleKFProp : public SubsysReco
   TrackSeedContainer* _track_map = nullptr;
 
   std::unique_ptr<PHField> _field_map = nullptr;
+  BzRZTable _bz_table;
+  bool _use_bz_table = true;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 
   /// acts geometry
   ActsGeometry* m_tgeometry = nullptr;
@@ -135,12 +147,19 @@ class PHSimpleKFProp : public SubsysReco
 
   bool TransportAndRotate(double old_layer, double new_layer, double& phi, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp) const;
 
-  bool PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions) const;
+  //! counted per seed and added to the (shared) counters once the seed is done
+  struct PropagationCounts
+  {
+    long kdtree_queries{0};
+    long clusters_added{0};
+  };
+
+  bool PropagateStep(unsigned int& current_layer, double& current_phi, PropagationDirection& direction, std::vector<TrkrDefs::cluskey>& propagated_track, std::vector<TrkrDefs::cluskey>& ckeys, GPUTPCTrackParam& kftrack, GPUTPCTrackParam::GPUTPCTrackFitParam& fp, const PositionMap& globalPositions, PropagationCounts& counts) const;
 
   // TrackSeed objects store clusters in order of increasing cluster key (std::set<TrkrDefs::cluskey>),
   // which means we have to have a way to directly pass a list of clusters in order to extend looping tracks
-  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const;
-  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions) const;
+  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions, PropagationCounts& counts) const;
+  std::vector<TrkrDefs::cluskey> PropagateTrack(TrackSeed* track, std::vector<TrkrDefs::cluskey>& ckeys, PropagationDirection direction, GPUTPCTrackParam& aliceSeed, const PositionMap& globalPositions, PropagationCounts& counts) const;
   std::vector<std::vector<TrkrDefs::cluskey>> RemoveBadClusters(const std::vector<std::vector<TrkrDefs::cluskey>>& seeds, const PositionMap& globalPositions) const;
   template <typename T>
   struct KDPointCloud
@@ -180,6 +199,13 @@ class PHSimpleKFProp : public SubsysReco
   void rejectAndPublishSeeds(std::vector<TrackSeed_v2>& seeds, const PositionMap& positions, std::vector<float>& trackChi2, PHTimer& timer);
   void publishSeeds(const std::vector<TrackSeed_v2>&);
 
+  // per event counts for profiling (PHCounterRegistry)
+  PHCounter* m_cnt_seeds{nullptr};
+  PHCounter* m_cnt_kdtree_queries{nullptr};
+  PHCounter* m_cnt_clusters_added{nullptr};
+  PHCounter* m_cnt_chains_rejected{nullptr};
+  PHCounter* m_cnt_ghosts_rejected{nullptr};
+
   int _max_propagation_steps = 200;
   std::string m_magField;
   bool _use_const_field = false;
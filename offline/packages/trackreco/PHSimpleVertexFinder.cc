@@ -35,6 +35,7 @@
 #include <functional>
 #include <iostream>
 #include <numeric>
+#include <tuple>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -58,6 +59,16 @@ int PHSimpleVertexFinder::InitRun(PHCompositeNode *topNode)
   {
     return ret;
   }
+
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHSimpleVertexFinder::InitRun - computing track pair DCAs with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
   return ret;
 }
 
@@ -69,9 +80,7 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
     std::cout << PHWHERE << " track map size " << _track_map->size() << std::endl;
   }
 
-  _active_dcacut = _base_dcacut;
-
-  if (_vertex_track_map.size() > 0)
+  if (_vertices_made)
   {
     _svtx_vertex_map->clear();
   }
@@ -101,140 +110,38 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
     crossings.insert(crossing);
     _track_vertex_crossing_map->addTrackAssoc(crossing, trackkey);    
   }
-  
-  unsigned int vertex_id = 0;
 
-  for (auto cross : crossings)
+  // the crossings do not share tracks, their vertices are found concurrently
+  // and written to the vertex map afterwards in crossing order
+  const std::vector<short int> crossing_list(crossings.begin(), crossings.end());
+  std::vector<CrossingVertices> results(crossing_list.size());
+  const auto find_vertices = [&](size_t icross)
+  { findCrossingVertices(crossing_list[icross], results[icross]); };
+  if (m_threadpool && Verbosity() == 0 && crossing_list.size() > 1)
   {
-    // reset maps for each crossing
-    _vertex_track_map.clear();
-    _track_pair_map.clear();
-    _track_pair_pca_map.clear();
-    _vertex_position_map.clear();
-    _vertex_covariance_map.clear();
-    _vertex_set.clear();
-
-    if (Verbosity() > 0)
-    {
-      std::cout << "process tracks for beam crossing " << cross << std::endl;
-    }
-
-    // get the subset of tracks for this crossing
-    auto crossing_track_index = _track_vertex_crossing_map->getTracks(cross);
-    SvtxTrackMap *crossing_tracks = new SvtxTrackMap_v2;
-    for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
-    {
-      unsigned int trackkey = (*iter).second;
-      SvtxTrack *track = _track_map->get(trackkey);
-      if(!track)
-      {
-        continue;
-      }
-      crossing_tracks->insertWithKey(track, trackkey);
-    }
-
-    // Find all instances where two tracks have a dca of < _dcacut,  and capture the pair details
-    // Fills _track_pair_map and _track_pair_pca_map
-    if(_zero_field)
-      {
-	checkDCAsZF(crossing_tracks);
-      }
-    else
-      {
-	checkDCAs(crossing_tracks);
-      }
-
-    /// If we didn't find any matches, try again with a slightly larger DCA cut
-    if (_track_pair_map.size() == 0)
-    {
-      _active_dcacut = 3.0 * _base_dcacut;
-      if(_zero_field)
-	{
-	  checkDCAsZF(crossing_tracks);
-	}
-      else
-	{
-	  checkDCAs(crossing_tracks);
-	}
-    }
-    
-    if (Verbosity() > 0)
-    {
-      std::cout << "crossing " << cross << " track pair map size " << _track_pair_map.size() << std::endl;
-    }
-
-    // get all connected pairs of tracks by looping over the track_pair map
-    std::vector<std::set<unsigned int>> connected_tracks = findConnectedTracks();
-
-    // make vertices - each set of connected tracks is a vertex
-    for (unsigned int ivtx = 0; ivtx < connected_tracks.size(); ++ivtx)
-    {
-      if (Verbosity() > 0)
-      {
-        std::cout << "process vertex " << ivtx + vertex_id << std::endl;
-      }
-
-      for (auto it : connected_tracks[ivtx])
-      {
-        unsigned int id = it;
-        _vertex_track_map.insert(std::make_pair(ivtx, id));
-        if (Verbosity() > 0)
-        {
-          std::cout << "  adding track " << id << " to vertex " << ivtx + vertex_id << std::endl;
-        }
-      }
-    }
-
-    // make a list of vertices
-    for (auto it : _vertex_track_map)
+    // the parallel loop in checkDCAs runs serially inside the tasks
+    m_threadpool->parallel_for(crossing_list.size(), find_vertices);
+  }
+  else
+  {
+    for (size_t icross = 0; icross < crossing_list.size(); ++icross)
     {
-      if (Verbosity() > 1)
-      {
-        std::cout << " vertex " << it.first + vertex_id << " track " << it.second << std::endl;
-      }
-      _vertex_set.insert(it.first);
+      find_vertices(icross);
     }
+  }
 
-    // this finds average vertex positions after removal of outlying track pairs
-    removeOutlierTrackPairs();
-
-    // average covariance for accepted tracks
-    for (auto it : _vertex_set)
-    {
-      matrix_t avgCov = matrix_t::Zero();
-      double cov_wt = 0.0;
-
-      auto ret = _vertex_track_map.equal_range(it);
-      for (auto cit = ret.first; cit != ret.second; ++cit)
-      {
-        unsigned int trid = cit->second;
-        matrix_t cov;
-        auto track = _track_map->get(trid);
-        for (int i = 0; i < 3; ++i)
-        {
-          for (int j = 0; j < 3; ++j)
-          {
-            cov(i, j) = track->get_error(i, j);
-          }
-        }
-
-        avgCov += cov;
-        cov_wt++;
-      }
+  unsigned int vertex_id = 0;
+  _vertices_made = false;
 
-      avgCov /= sqrt(cov_wt);
-      if (Verbosity() > 2)
-      {
-        std::cout << "Average covariance for vertex " << it << " is:" << std::endl;
-        std::cout << std::setprecision(8) << avgCov << std::endl;
-      }
-      _vertex_covariance_map.insert(std::make_pair(it, avgCov));
-    }
+  for (size_t icross = 0; icross < crossing_list.size(); ++icross)
+  {
+    const short int cross = crossing_list[icross];
+    CrossingVertices &result = results[icross];
 
     // Write the vertices to the vertex map on the node tree
     //==============================================
 
-    for (auto it : _vertex_set)
+    for (auto it : result.vertex_set)
     {
       unsigned int thisid = it + vertex_id;  // the address of the vertex in the event
 
@@ -246,7 +153,7 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
       svtxVertex->set_id(thisid);
       svtxVertex->set_beam_crossing(cross);
 
-      auto ret = _vertex_track_map.equal_range(it);
+      auto ret = result.vertex_track_map.equal_range(it);
       for (auto cit = ret.first; cit != ret.second; ++cit)
       {
         unsigned int trid = cit->second;
@@ -259,7 +166,7 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
         _track_map->get(trid)->set_vertex_id(thisid);
       }
 
-      Eigen::Vector3d pos = _vertex_position_map.find(it)->second;
+      Eigen::Vector3d pos = result.vertex_position_map.find(it)->second;
       svtxVertex->set_x(pos.x());
       svtxVertex->set_y(pos.y());
       svtxVertex->set_z(pos.z());
@@ -268,7 +175,7 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
         std::cout << "   vertex " << thisid << " insert pos.x " << pos.x() << " pos.y " << pos.y() << " pos.z " << pos.z() << std::endl;
       }
 
-      auto vtxCov = _vertex_covariance_map.find(it)->second;
+      auto vtxCov = result.vertex_covariance_map.find(it)->second;
       for (int i = 0; i < 3; ++i)
       {
         for (int j = 0; j < 3; ++j)
@@ -278,16 +185,17 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
       }
 
       _svtx_vertex_map->insert(svtxVertex.release());
+      _vertices_made = true;
     }
 
-    vertex_id += _vertex_set.size();
+    vertex_id += result.vertex_set.size();
 
     /// Iterate through the tracks and assign the closest vtx id to
     /// the track position for propagating back to the vtx. Catches any
     /// tracks that were missed or were not  compatible with any of the
     /// identified vertices
     //=================================================
-    for (const auto &[trackkey, track] : *crossing_tracks)
+    for (const auto &[trackkey, track] : *result.tracks)
     {
       auto thistrack = _track_map->get(trackkey);  // get the original, not the copy
       auto vtxid = thistrack->get_vertex_id();
@@ -305,9 +213,9 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
       float maxdz = std::numeric_limits<float>::max();
       unsigned int newvtxid = std::numeric_limits<unsigned int>::max();
 
-      for (auto it : _vertex_set)
+      for (auto it : result.vertex_set)
       {
-        unsigned int thisid = it + vertex_id - _vertex_set.size();
+        unsigned int thisid = it + vertex_id - result.vertex_set.size();
 
         if (Verbosity() > 1)
         {
@@ -333,9 +241,6 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
         }
       }
     }
-
-    delete crossing_tracks;
-
   }  // end loop over crossings
 
   // update the crossing vertex map with the results
@@ -386,6 +291,127 @@ int PHSimpleVertexFinder::process_event(PHCompositeNode * /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void PHSimpleVertexFinder::findCrossingVertices(const short int cross, CrossingVertices &result) const
+{
+  if (Verbosity() > 0)
+  {
+    std::cout << "process tracks for beam crossing " << cross << std::endl;
+  }
+
+  // get the subset of tracks for this crossing
+  auto crossing_track_index = _track_vertex_crossing_map->getTracks(cross);
+  result.tracks = std::make_unique<SvtxTrackMap_v2>();
+  for (auto iter = crossing_track_index.first; iter != crossing_track_index.second; ++iter)
+  {
+    unsigned int trackkey = (*iter).second;
+    SvtxTrack *track = _track_map->get(trackkey);
+    if(!track)
+    {
+      continue;
+    }
+    result.tracks->insertWithKey(track, trackkey);
+  }
+
+  // Find all instances where two tracks have a dca of < dcacut,  and capture the pair details
+  // Fills the track pair and track pair pca maps
+  result.dcacut = _base_dcacut;
+  if(_zero_field)
+    {
+      checkDCAsZF(result.tracks.get(), result);
+    }
+  else
+    {
+      checkDCAs(result.tracks.get(), result);
+    }
+
+  /// If we didn't find any matches, try again with a slightly larger DCA cut
+  if (result.track_pair_map.size() == 0)
+  {
+    result.dcacut = 3.0 * _base_dcacut;
+    if(_zero_field)
+      {
+	checkDCAsZF(result.tracks.get(), result);
+      }
+    else
+      {
+	checkDCAs(result.tracks.get(), result);
+      }
+  }
+  
+  if (Verbosity() > 0)
+  {
+    std::cout << "crossing " << cross << " track pair map size " << result.track_pair_map.size() << std::endl;
+  }
+
+  // get all connected pairs of tracks by looping over the track_pair map
+  std::vector<std::set<unsigned int>> connected_tracks = findConnectedTracks(result);
+
+  // make vertices - each set of connected tracks is a vertex
+  for (unsigned int ivtx = 0; ivtx < connected_tracks.size(); ++ivtx)
+  {
+    if (Verbosity() > 0)
+    {
+      std::cout << "process vertex " << ivtx << " of crossing " << cross << std::endl;
+    }
+
+    for (auto it : connected_tracks[ivtx])
+    {
+      unsigned int id = it;
+      result.vertex_track_map.insert(std::make_pair(ivtx, id));
+      if (Verbosity() > 0)
+      {
+        std::cout << "  adding track " << id << " to vertex " << ivtx << " of crossing " << cross << std::endl;
+      }
+    }
+  }
+
+  // make a list of vertices
+  for (auto it : result.vertex_track_map)
+  {
+    if (Verbosity() > 1)
+    {
+      std::cout << " vertex " << it.first << " of crossing " << cross << " track " << it.second << std::endl;
+    }
+    result.vertex_set.insert(it.first);
+  }
+
+  // this finds average vertex positions after removal of outlying track pairs
+  removeOutlierTrackPairs(result);
+
+  // average covariance for accepted tracks
+  for (auto it : result.vertex_set)
+  {
+    matrix_t avgCov = matrix_t::Zero();
+    double cov_wt = 0.0;
+
+    auto ret = result.vertex_track_map.equal_range(it);
+    for (auto cit = ret.first; cit != ret.second; ++cit)
+    {
+      unsigned int trid = cit->second;
+      matrix_t cov;
+      auto track = _track_map->get(trid);
+      for (int i = 0; i < 3; ++i)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          cov(i, j) = track->get_error(i, j);
+        }
+      }
+
+      avgCov += cov;
+      cov_wt++;
+    }
+
+    avgCov /= sqrt(cov_wt);
+    if (Verbosity() > 2)
+    {
+      std::cout << "Average covariance for vertex " << it << " is:" << std::endl;
+      std::cout << std::setprecision(8) << avgCov << std::endl;
+    }
+    result.vertex_covariance_map.insert(std::make_pair(it, avgCov));
+  }
+}
+
 int PHSimpleVertexFinder::End(PHCompositeNode * /*topNode*/)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -463,98 +489,176 @@ int PHSimpleVertexFinder::GetNodes(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
-void PHSimpleVertexFinder::checkDCAs(SvtxTrackMap *track_map)
+bool PHSimpleVertexFinder::passTrackCuts(unsigned int id, SvtxTrack *track) const
 {
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = track_map->begin(); tr1_it != track_map->end(); ++tr1_it)
+  if (track->get_quality() > _qual_cut)
   {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-    if (tr1->get_quality() > _qual_cut)
+    return false;
+  }
+  if (_require_mvtx)
+  {
+    unsigned int nmvtx = 0;
+    TrackSeed *siliconseed = track->get_silicon_seed();
+    if (!siliconseed)
     {
-      continue;
+      return false;
     }
-    if (_require_mvtx)
-    {
-      unsigned int nmvtx = 0;
-      TrackSeed *siliconseed = tr1->get_silicon_seed();
-      if (!siliconseed)
-      {
-        continue;
-      }
 
-      for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
+    for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
+    {
+      if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
       {
-        if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-        {
-          nmvtx++;
-        }
-        if (nmvtx >= _nmvtx_required)
-        {
-          break;
-        }
+        nmvtx++;
       }
-      if (nmvtx < _nmvtx_required)
+      if (nmvtx >= _nmvtx_required)
       {
-        continue;
-      }
-      if (Verbosity() > 3)
-      {
-        std::cout << " tr1 id " << id1 << " has nmvtx at least " << nmvtx << std::endl;
+        break;
       }
     }
+    if (nmvtx < _nmvtx_required)
+    {
+      return false;
+    }
+    if (Verbosity() > 3)
+    {
+      std::cout << " track id " << id << " has nmvtx at least " << nmvtx << std::endl;
+    }
+  }
+
+  return !(track->get_pt() < _track_pt_cut);
+}
+
+void PHSimpleVertexFinder::checkDCAs(SvtxTrackMap *track_map, CrossingVertices &result) const
+{
+  // select the tracks once, in map order
+  std::vector<TrackLine> lines;
+  lines.reserve(track_map->size());
+  for (const auto &[id, track] : *track_map)
+  {
+    if (!passTrackCuts(id, track))
+    {
+      continue;
+    }
 
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != track_map->end(); ++tr2_it)
+    TrackLine line;
+    line.id = id;
+    line.track = track;
+    line.a = Eigen::Vector3d(track->get_x(), track->get_y(), track->get_z());
+    line.b = Eigen::Vector3d(track->get_px() / track->get_p(), track->get_py() / track->get_p(), track->get_pz() / track->get_p());
+
+    // The PCA of a good pair is within sqrt(2)*_beamline_xy_cut of the beam axis for the first track, and
+    // at most the dca cut further for the second one. Along a straight line this limits the z of
+    // both PCAs to a window around the z where the line passes closest to the beam axis, so that
+    // only tracks with overlapping windows have to be paired
+    const double bt2 = line.b.x() * line.b.x() + line.b.y() * line.b.y();
+    if (bt2 > 0)
     {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
-      if (_require_mvtx)
-      {
-        unsigned int nmvtx = 0;
-        TrackSeed *siliconseed = tr2->get_silicon_seed();
-        if (!siliconseed)
-        {
-          continue;
-        }
+      const double t = -(line.a.x() * line.b.x() + line.a.y() * line.b.y()) / bt2;
+      const double rmax = M_SQRT2 * _beamline_xy_cut + result.dcacut;
+      line.zbeam = line.a.z() + t * line.b.z();
+      line.zwindow = rmax * std::abs(line.b.z()) / std::sqrt(bt2) + result.dcacut / 2;
+
+      // safety margin against rounding
+      line.zwindow = line.zwindow * (1. + 1e-6) + 1e-6;
+    }
+    lines.push_back(line);
+  }
+
+  // sort by z at the beam axis. Lines without a finite window go last and are paired with all others
+  std::vector<unsigned int> order(lines.size());
+  std::iota(order.begin(), order.end(), 0);
+  const auto bounded = [&lines](unsigned int i)
+  { return std::isfinite(lines[i].zbeam) && std::isfinite(lines[i].zwindow); };
+  const auto first_unbounded = std::partition(order.begin(), order.end(), bounded);
+  std::sort(order.begin(), first_unbounded, [&lines](unsigned int i, unsigned int j)
+            { return lines[i].zbeam < lines[j].zbeam; });
+  const size_t nbounded = std::distance(order.begin(), first_unbounded);
+
+  double max_window = 0;
+  for (size_t k = 0; k < nbounded; ++k)
+  {
+    max_window = std::max(max_window, lines[order[k]].zwindow);
+  }
 
-        for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
+  // pairs for all tracks in [begin, end) of the z ordered list
+  const auto find_pairs = [&](size_t begin, size_t end, std::vector<TrackPair> &pairs)
+  {
+    for (size_t k = begin; k < end; ++k)
+    {
+      const auto &line1 = lines[order[k]];
+      const bool is_bounded = k < nbounded;
+      for (size_t m = k + 1; m < order.size(); ++m)
+      {
+        const auto &line2 = lines[order[m]];
+        if (is_bounded && m < nbounded)
         {
-          if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
+          const double dz = line2.zbeam - line1.zbeam;
+          if (dz > line1.zwindow + max_window)
           {
-            nmvtx++;
+            // skip to the unbounded lines
+            m = nbounded - 1;
+            continue;
           }
-          if (nmvtx >= _nmvtx_required)
+          if (dz > line1.zwindow + line2.zwindow)
           {
-            break;
+            continue;
           }
         }
-        if (nmvtx < _nmvtx_required)
+
+        // keep the map order of the original pairing, the beam line cut applies to the first track
+        TrackPair pair;
+        if (order[k] < order[m])
         {
-          continue;
+          pair.first = order[k];
+          pair.second = order[m];
         }
-        if (Verbosity() > 3)
+        else
         {
-          std::cout << " tr2 id " << id2 << " has nmvtx at least " << nmvtx << std::endl;
+          pair.first = order[m];
+          pair.second = order[k];
+        }
+        if (findDcaTwoTracks(lines[pair.first], lines[pair.second], result.dcacut, pair))
+        {
+          pairs.push_back(pair);
         }
       }
+    }
+  };
 
-      // find DCA of these two tracks
-      if (Verbosity() > 3)
-      {
-        std::cout << "Check DCA for tracks " << id1 << " and  " << id2 << std::endl;
-      }
+  std::vector<std::vector<TrackPair>> chunk_pairs;
+  if (m_threadpool && Verbosity() <= 3 && order.size() > 1)
+  {
+    // several chunks per thread, since the number of pairs per track varies
+    const size_t nchunks = std::min<size_t>(order.size(), 4 * m_threadpool->size());
+    chunk_pairs.resize(nchunks);
+    m_threadpool->parallel_for(nchunks, [&](size_t ichunk)
+                               { find_pairs(ichunk * order.size() / nchunks, (ichunk + 1) * order.size() / nchunks, chunk_pairs[ichunk]); });
+  }
+  else
+  {
+    chunk_pairs.resize(1);
+    find_pairs(0, order.size(), chunk_pairs.front());
+  }
 
-      findDcaTwoTracks(tr1, tr2);
-    }
+  // store the pairs in the order of the track map
+  std::vector<TrackPair> pairs;
+  for (auto &chunk : chunk_pairs)
+  {
+    pairs.insert(pairs.end(), chunk.begin(), chunk.end());
+  }
+  std::sort(pairs.begin(), pairs.end(), [](const TrackPair &lhs, const TrackPair &rhs)
+            { return std::tie(lhs.first, lhs.second) < std::tie(rhs.first, rhs.second); });
+
+  for (const auto &pair : pairs)
+  {
+    const auto id1 = lines[pair.first].id;
+    const auto id2 = lines[pair.second].id;
+    result.track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, pair.dca)));
+    result.track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(pair.PCA1, pair.PCA2))));
   }
 }
 
-void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
+void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map, CrossingVertices &result) const
 {
   // ZF tracks do not have an Acts fit, and the seeding does not give
   // reliable track parameters - refit clusters with straight lines
@@ -675,7 +779,7 @@ void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
 
 
 	  // check dca cut is satisfied, and that PCA is close to beam line
-	  if (fabs(dca) < _active_dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
+	  if (fabs(dca) < result.dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
 	    {
 	      int id1 = cumulative_trackid_vec[i1];
 	      int id2 = cumulative_trackid_vec[i2];
@@ -691,8 +795,8 @@ void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
 		}
 	      
 	      // capture the results for successful matches
-	      _track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
-	      _track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
+	      result.track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
+	      result.track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
 	    }	  	  
 	}
     }
@@ -700,7 +804,7 @@ void PHSimpleVertexFinder::checkDCAsZF(SvtxTrackMap *track_map)
   return; 
 }
 
-void PHSimpleVertexFinder::getTrackletClusterList(TrackSeed* tracklet, std::vector<TrkrDefs::cluskey>& cluskey_vec)
+void PHSimpleVertexFinder::getTrackletClusterList(TrackSeed* tracklet, std::vector<TrkrDefs::cluskey>& cluskey_vec) const
 {
   for (auto clusIter = tracklet->begin_cluster_keys();
        clusIter != tracklet->end_cluster_keys();
@@ -740,117 +844,13 @@ void PHSimpleVertexFinder::getTrackletClusterList(TrackSeed* tracklet, std::vect
   }  // end loop over clusters for this track
 }
 
-void PHSimpleVertexFinder::checkDCAs()
-{
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = _track_map->begin(); tr1_it != _track_map->end(); ++tr1_it)
-  {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-    if (tr1->get_quality() > _qual_cut)
-    {
-      continue;
-    }
-    if (_require_mvtx)
-    {
-      unsigned int nmvtx = 0;
-      TrackSeed *siliconseed = tr1->get_silicon_seed();
-      if (!siliconseed)
-      {
-        continue;
-      }
-
-      for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-      {
-        if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-        {
-          nmvtx++;
-        }
-        if (nmvtx >= _nmvtx_required)
-        {
-          break;
-        }
-      }
-      if (nmvtx < _nmvtx_required)
-      {
-        continue;
-      }
-      if (Verbosity() > 3)
-      {
-        std::cout << " tr1 id " << id1 << " has nmvtx at least " << nmvtx << std::endl;
-      }
-    }
-
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != _track_map->end(); ++tr2_it)
-    {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
-      if (_require_mvtx)
-      {
-        unsigned int nmvtx = 0;
-        TrackSeed *siliconseed = tr2->get_silicon_seed();
-        if (!siliconseed)
-        {
-          continue;
-        }
-
-        for (auto clusit = siliconseed->begin_cluster_keys(); clusit != siliconseed->end_cluster_keys(); ++clusit)
-        {
-          if (TrkrDefs::getTrkrId(*clusit) == TrkrDefs::mvtxId)
-          {
-            nmvtx++;
-          }
-          if (nmvtx >= _nmvtx_required)
-          {
-            break;
-          }
-        }
-        if (nmvtx < _nmvtx_required)
-        {
-          continue;
-        }
-        if (Verbosity() > 3)
-        {
-          std::cout << " tr2 id " << id2 << " has nmvtx at least " << nmvtx << std::endl;
-        }
-      }
-
-      // find DCA of these two tracks
-      if (Verbosity() > 3)
-      {
-        std::cout << "Check DCA for tracks " << id1 << " and  " << id2 << std::endl;
-      }
-
-      findDcaTwoTracks(tr1, tr2);
-    }
-  }
-}
-
-void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
+bool PHSimpleVertexFinder::findDcaTwoTracks(const TrackLine &line1, const TrackLine &line2, const double dcacut, TrackPair &pair) const
 {
-  if (tr1->get_pt() < _track_pt_cut)
-  {
-    return;
-  }
-  if (tr2->get_pt() < _track_pt_cut)
-  {
-    return;
-  }
-
-  unsigned int id1 = tr1->get_id();
-  unsigned int id2 = tr2->get_id();
-
   // get the line equations for the tracks
-
-  Eigen::Vector3d a1(tr1->get_x(), tr1->get_y(), tr1->get_z());
-  Eigen::Vector3d b1(tr1->get_px() / tr1->get_p(), tr1->get_py() / tr1->get_p(), tr1->get_pz() / tr1->get_p());
-  Eigen::Vector3d a2(tr2->get_x(), tr2->get_y(), tr2->get_z());
-  Eigen::Vector3d b2(tr2->get_px() / tr2->get_p(), tr2->get_py() / tr2->get_p(), tr2->get_pz() / tr2->get_p());
+  const Eigen::Vector3d &a1 = line1.a;
+  const Eigen::Vector3d &b1 = line1.b;
+  const Eigen::Vector3d &a2 = line2.a;
+  const Eigen::Vector3d &b2 = line2.b;
 
   Eigen::Vector3d PCA1(0, 0, 0);
   Eigen::Vector3d PCA2(0, 0, 0);
@@ -858,17 +858,18 @@ void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
 
   if (Verbosity() > 3)
   {
-    std::cout << " pair dca is " << dca << " _active_dcacut is " << _active_dcacut
+    std::cout << "Check DCA for tracks " << line1.id << " and  " << line2.id << std::endl;
+    std::cout << " pair dca is " << dca << " dca cut is " << dcacut
               << " PCA1.x " << PCA1.x() << " PCA1.y " << PCA1.y()
               << " PCA2.x " << PCA2.x() << " PCA2.y " << PCA2.y() << std::endl;
   }
 
   // check dca cut is satisfied, and that PCA is close to beam line
-  if (fabs(dca) < _active_dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
+  if (fabs(dca) < dcacut && (fabs(PCA1.x()) < _beamline_xy_cut && fabs(PCA1.y()) < _beamline_xy_cut))
   {
     if (Verbosity() > 3)
     {
-      std::cout << " good match for tracks " << tr1->get_id() << " and " << tr2->get_id() << " with pT " << tr1->get_pt() << " and " << tr2->get_pt() << std::endl;
+      std::cout << " good match for tracks " << line1.id << " and " << line2.id << " with pT " << line1.track->get_pt() << " and " << line2.track->get_pt() << std::endl;
       std::cout << "    a1.x " << a1.x() << " a1.y " << a1.y() << " a1.z " << a1.z() << std::endl;
       std::cout << "    a2.x  " << a2.x() << " a2.y " << a2.y() << " a2.z " << a2.z() << std::endl;
       std::cout << "    PCA1.x() " << PCA1.x() << " PCA1.y " << PCA1.y() << " PCA1.z " << PCA1.z() << std::endl;
@@ -877,16 +878,18 @@ void PHSimpleVertexFinder::findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2)
     }
 
     // capture the results for successful matches
-    _track_pair_map.insert(std::make_pair(id1, std::make_pair(id2, dca)));
-    _track_pair_pca_map.insert(std::make_pair(id1, std::make_pair(id2, std::make_pair(PCA1, PCA2))));
+    pair.dca = dca;
+    pair.PCA1 = PCA1;
+    pair.PCA2 = PCA2;
+    return true;
   }
 
-  return;
+  return false;
 }
 
 double PHSimpleVertexFinder::dcaTwoLines(const Eigen::Vector3d &a1, const Eigen::Vector3d &b1,
                                          const Eigen::Vector3d &a2, const Eigen::Vector3d &b2,
-                                         Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2)
+                                         Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2) const
 {
   // The shortest distance between two skew lines described by
   //  a1 + c * b1
@@ -944,74 +947,64 @@ double PHSimpleVertexFinder::dcaTwoLines(const Eigen::Vector3d &a1, const Eigen:
   return dca;
 }
 
-std::vector<std::set<unsigned int>> PHSimpleVertexFinder::findConnectedTracks()
+std::vector<std::set<unsigned int>> PHSimpleVertexFinder::findConnectedTracks(const CrossingVertices &result) const
 {
-  std::vector<std::set<unsigned int>> connected_tracks;
-  std::set<unsigned int> connected;
-  std::set<unsigned int> used;
-  for (auto it : _track_pair_map)
+  // union-find over the tracks of all pairs. Tracks are numbered in order of first appearance in
+  // the pair map, and the root of each set is its lowest number, so that connected sets come out
+  // in the same order as the pair map
+  std::map<unsigned int, unsigned int> index;
+  std::vector<unsigned int> ids;
+  std::vector<unsigned int> parent;
+
+  const auto get_index = [&](unsigned int id)
   {
-    unsigned int id1 = it.first;
-    unsigned int id2 = it.second.first;
-
-    if ((used.find(id1) != used.end()) && (used.find(id2) != used.end()))
+    const auto [iter, inserted] = index.emplace(id, ids.size());
+    if (inserted)
     {
-      if (Verbosity() > 3)
-      {
-        std::cout << " tracks " << id1 << " and " << id2 << " are both in used , skip them" << std::endl;
-      }
-      continue;
+      ids.push_back(id);
+      parent.push_back(iter->second);
     }
-    else if ((used.find(id1) == used.end()) && (used.find(id2) == used.end()))
+    return iter->second;
+  };
+
+  const auto find_root = [&parent](unsigned int i)
+  {
+    while (parent[i] != i)
     {
-      if (Verbosity() > 3)
-      {
-        std::cout << " tracks " << id1 << " and " << id2 << " are both not in used , start a new connected set" << std::endl;
-      }
-      // close out and start a new connections set
-      if (connected.size() > 0)
-      {
-        connected_tracks.push_back(connected);
-        connected.clear();
-        if (Verbosity() > 3)
-        {
-          std::cout << "           closing out set " << std::endl;
-        }
-      }
+      // path halving
+      parent[i] = parent[parent[i]];
+      i = parent[i];
     }
+    return i;
+  };
 
-    // get everything connected to id1 and id2
-    connected.insert(id1);
-    used.insert(id1);
-    connected.insert(id2);
-    used.insert(id2);
-    for (auto cit : _track_pair_map)
+  for (const auto &it : result.track_pair_map)
+  {
+    unsigned int id1 = it.first;
+    unsigned int id2 = it.second.first;
+    const auto root1 = find_root(get_index(id1));
+    const auto root2 = find_root(get_index(id2));
+    if (root1 != root2)
     {
-      unsigned int id3 = cit.first;
-      unsigned int id4 = cit.second.first;
-      if ((connected.find(id3) != connected.end()) || (connected.find(id4) != connected.end()))
+      if (Verbosity() > 3)
       {
-        if (Verbosity() > 3)
-        {
-          std::cout << " found connection to " << id3 << " and " << id4 << std::endl;
-        }
-        connected.insert(id3);
-        used.insert(id3);
-        connected.insert(id4);
-        used.insert(id4);
+        std::cout << " connecting tracks " << id1 << " and " << id2 << std::endl;
       }
+      parent[std::max(root1, root2)] = std::min(root1, root2);
     }
   }
 
-  // close out the last set
-  if (connected.size() > 0)
+  std::vector<std::set<unsigned int>> connected_tracks;
+  std::vector<unsigned int> set_index(ids.size(), 0);
+  for (unsigned int i = 0; i < ids.size(); ++i)
   {
-    connected_tracks.push_back(connected);
-    connected.clear();
-    if (Verbosity() > 3)
+    const auto root = find_root(i);
+    if (root == i)
     {
-      std::cout << "           closing out last set " << std::endl;
+      set_index[i] = connected_tracks.size();
+      connected_tracks.emplace_back();
     }
+    connected_tracks[set_index[root]].insert(ids[i]);
   }
 
   if (Verbosity() > 3)
@@ -1022,11 +1015,11 @@ std::vector<std::set<unsigned int>> PHSimpleVertexFinder::findConnectedTracks()
   return connected_tracks;
 }
 
-void PHSimpleVertexFinder::removeOutlierTrackPairs()
+void PHSimpleVertexFinder::removeOutlierTrackPairs(CrossingVertices &result) const
 {
-  //  Note: std::multimap<unsigned int, std::pair<unsigned int, std::pair<Eigen::Vector3d,  Eigen::Vector3d>>>  _track_pair_pca_map
+  //  Note: std::multimap<unsigned int, std::pair<unsigned int, std::pair<Eigen::Vector3d,  Eigen::Vector3d>>>  track_pair_pca_map
 
-  for (auto it : _vertex_set)
+  for (auto it : result.vertex_set)
   {
     unsigned int vtxid = it;
     if (Verbosity() > 1)
@@ -1046,7 +1039,7 @@ void PHSimpleVertexFinder::removeOutlierTrackPairs()
     Eigen::Vector3d new_pca_avge(0., 0., 0.);
     double new_wt = 0.0;
 
-    auto ret = _vertex_track_map.equal_range(vtxid);
+    auto ret = result.vertex_track_map.equal_range(vtxid);
 
     // Start by getting the positions for this vertex into vectors for the median calculation
     for (auto cit = ret.first; cit != ret.second; ++cit)
@@ -1058,7 +1051,7 @@ void PHSimpleVertexFinder::removeOutlierTrackPairs()
       }
 
       // find all pairs for this vertex with tr1id
-      auto pca_range = _track_pair_pca_map.equal_range(tr1id);
+      auto pca_range = result.track_pair_pca_map.equal_range(tr1id);
       for (auto pit = pca_range.first; pit != pca_range.second; ++pit)
       {
         unsigned int tr2id = pit->second.first;
@@ -1090,7 +1083,7 @@ void PHSimpleVertexFinder::removeOutlierTrackPairs()
       new_pca_avge.x() = getAverage(vx);
       new_pca_avge.y() = getAverage(vy);
       new_pca_avge.z() = getAverage(vz);
-      _vertex_position_map.insert(std::make_pair(vtxid, new_pca_avge));
+      result.vertex_position_map.insert(std::make_pair(vtxid, new_pca_avge));
       if (Verbosity() > 1)
       {
         std::cout << " Vertex has only 2 tracks, use average for PCA: " << new_pca_avge.x() << "  " << new_pca_avge.y() << "  " << new_pca_avge.z() << std::endl;
@@ -1118,7 +1111,7 @@ void PHSimpleVertexFinder::removeOutlierTrackPairs()
       }
 
       // find all pairs for this vertex with tr1id
-      auto pca_range = _track_pair_pca_map.equal_range(tr1id);
+      auto pca_range = result.track_pair_pca_map.equal_range(tr1id);
       for (auto pit = pca_range.first; pit != pca_range.second; ++pit)
       {
         unsigned int tr2id = pit->second.first;
@@ -1160,13 +1153,13 @@ void PHSimpleVertexFinder::removeOutlierTrackPairs()
       new_pca_avge.z() = pca_median_z;
     }
 
-    _vertex_position_map.insert(std::make_pair(vtxid, new_pca_avge));
+    result.vertex_position_map.insert(std::make_pair(vtxid, new_pca_avge));
   }
 
   return;
 }
 
-double PHSimpleVertexFinder::getMedian(std::vector<double> &v)
+double PHSimpleVertexFinder::getMedian(std::vector<double> &v) const
 {
   double median = 0.0;
 
@@ -1205,7 +1198,7 @@ double PHSimpleVertexFinder::getMedian(std::vector<double> &v)
 
   return median;
 }
-double PHSimpleVertexFinder::getAverage(std::vector<double> &v)
+double PHSimpleVertexFinder::getAverage(std::vector<double> &v) const
 {
   double avge = 0.0;
   double wt = 0.0;
@@ -14,7 +14,12 @@
 #include <trackbase/TrkrDefs.h>
 #include <trackbase/ActsGeometry.h>
 
+#include <phool/PHThreadPool.h>
+
+#include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -53,24 +58,72 @@ class PHSimpleVertexFinder : public SubsysReco
   void setVertexMapName(const std::string &name) { _vertex_map_name = name; }
   void zeroField(const bool flag) { _zero_field = flag; }
 
+  /// find the vertices of the crossings and compute track pair DCAs on nthreads threads, 0 uses all cores
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
   int GetNodes(PHCompositeNode *topNode);
   int CreateNodes(PHCompositeNode *topNode);
 
-  void checkDCAs(SvtxTrackMap *track_map);
-  void checkDCAsZF(SvtxTrackMap *track_map);
-  void checkDCAs();
+  /// straight line approximation of a track at its reference point
+  struct TrackLine
+  {
+    unsigned int id = 0;
+    SvtxTrack *track = nullptr;
+    Eigen::Vector3d a = Eigen::Vector3d::Zero();
+    Eigen::Vector3d b = Eigen::Vector3d::Zero();
+
+    /// z where the line is closest to the beam axis, and half width of the z range a track pair can be found in
+    double zbeam = std::numeric_limits<double>::quiet_NaN();
+    double zwindow = std::numeric_limits<double>::infinity();
+  };
+
+  /// track pair passing the dca and beam line cuts, tracks are indexed in the TrackLine vector
+  struct TrackPair
+  {
+    unsigned int first = 0;
+    unsigned int second = 0;
+    double dca = 0;
+    Eigen::Vector3d PCA1 = Eigen::Vector3d::Zero();
+    Eigen::Vector3d PCA2 = Eigen::Vector3d::Zero();
+  };
+
+  using matrix_t = Eigen::Matrix<double, 3, 3>;
 
-  void getTrackletClusterList(TrackSeed* tracklet, std::vector<TrkrDefs::cluskey>& cluskey_vec);
+  /// vertices of one beam crossing, the crossings do not share tracks and are processed independently
+  struct CrossingVertices
+  {
+    /// copies of the tracks of the crossing
+    std::unique_ptr<SvtxTrackMap> tracks;
+    double dcacut = 0;
+    std::multimap<unsigned int, unsigned int> vertex_track_map;
+    std::multimap<unsigned int, std::pair<unsigned int, double>> track_pair_map;
+    // Eigen::Vector3d is an Eigen::Matrix<double,3,1>
+    std::multimap<unsigned int, std::pair<unsigned int, std::pair<Eigen::Vector3d,
+                                                                  Eigen::Vector3d>>>
+        track_pair_pca_map;
+    std::map<unsigned int, Eigen::Vector3d> vertex_position_map;
+    std::map<unsigned int, matrix_t> vertex_covariance_map;
+    std::set<unsigned int> vertex_set;
+  };
+
+  /// finds the vertices of a crossing, only reads the node tree
+  void findCrossingVertices(const short int cross, CrossingVertices &result) const;
+
+  bool passTrackCuts(unsigned int id, SvtxTrack *track) const;
+  void checkDCAs(SvtxTrackMap *track_map, CrossingVertices &result) const;
+  void checkDCAsZF(SvtxTrackMap *track_map, CrossingVertices &result) const;
+
+  void getTrackletClusterList(TrackSeed* tracklet, std::vector<TrkrDefs::cluskey>& cluskey_vec) const;
   
-  void findDcaTwoTracks(SvtxTrack *tr1, SvtxTrack *tr2);
+  bool findDcaTwoTracks(const TrackLine &line1, const TrackLine &line2, const double dcacut, TrackPair &pair) const;
   double dcaTwoLines(const Eigen::Vector3d &p1, const Eigen::Vector3d &v1,
                      const Eigen::Vector3d &p2, const Eigen::Vector3d &v2,
-                     Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2);
-  std::vector<std::set<unsigned int>> findConnectedTracks();
-  void removeOutlierTrackPairs();
-  double getMedian(std::vector<double> &v);
-  double getAverage(std::vector<double> &v);
+                     Eigen::Vector3d &PCA1, Eigen::Vector3d &PCA2) const;
+  std::vector<std::set<unsigned int>> findConnectedTracks(const CrossingVertices &result) const;
+  void removeOutlierTrackPairs(CrossingVertices &result) const;
+  double getMedian(std::vector<double> &v) const;
+  double getAverage(std::vector<double> &v) const;
 
   SvtxTrackMap *_track_map{nullptr};
   TrkrClusterContainer* _cluster_map{nullptr};
@@ -78,7 +131,6 @@ class PHSimpleVertexFinder : public SubsysReco
   ActsGeometry* _tGeometry{nullptr};
 
   double _base_dcacut = 0.0080;  // 80 microns
-  double _active_dcacut = 0.080;
   double _beamline_xy_cut = 0.2;  // must be within 2 mm of beam line
   double _qual_cut = 10.0;
   bool _require_mvtx = true;
@@ -90,18 +142,13 @@ class PHSimpleVertexFinder : public SubsysReco
 
   std::string _track_map_name = "SvtxTrackMap";
   std::string _vertex_map_name = "SvtxVertexMap";
-  std::multimap<unsigned int, unsigned int> _vertex_track_map;
-  using matrix_t = Eigen::Matrix<double, 3, 3>;
-  std::multimap<unsigned int, std::pair<unsigned int, double>> _track_pair_map;
-  // Eigen::Vector3d is an Eigen::Matrix<double,3,1>
-  std::multimap<unsigned int, std::pair<unsigned int, std::pair<Eigen::Vector3d,
-                                                                Eigen::Vector3d>>>
-      _track_pair_pca_map;
-  std::map<unsigned int, Eigen::Vector3d> _vertex_position_map;
-  std::map<unsigned int, matrix_t> _vertex_covariance_map;
-  std::set<unsigned int> _vertex_set;
+  /// vertices were written in the last event
+  bool _vertices_made = false;
 
   TrackVertexCrossingAssoc *_track_vertex_crossing_map{nullptr};
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif  // PHSIMPLEVERTEXFINDER_H
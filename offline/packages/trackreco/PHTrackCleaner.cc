@@ -16,12 +16,44 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>
 
+#include <algorithm>
 #include <cmath>     // for sqrt, fabs, atan2, cos
 #include <iostream>  // for operator<<, basic_ostream
 #include <map>       // for map
 #include <set>       // for _Rb_tree_const_iterator
+#include <unordered_map>
 #include <utility>   // for pair, make_pair
 
+namespace
+{
+  //! index of each seed of a container, same result as TrackSeedContainer::find without its linear search
+  class SeedIndex
+  {
+   public:
+    explicit SeedIndex(const TrackSeedContainer* container)
+      : m_size(container->size())
+    {
+      m_index.reserve(m_size);
+      unsigned int index = 0;
+      for (const auto& seed : *container)
+      {
+        // keep the first occurrence, as std::find does
+        m_index.emplace(seed, index++);
+      }
+    }
+
+    unsigned int find(const TrackSeed* seed) const
+    {
+      const auto iter = m_index.find(seed);
+      return iter == m_index.end() ? m_size : iter->second;
+    }
+
+   private:
+    unsigned int m_size = 0;
+    std::unordered_map<const TrackSeed*, unsigned int> m_index;
+  };
+}  // namespace
+
 //____________________________________________________________________________..
 PHTrackCleaner::PHTrackCleaner(const std::string &name)
   : SubsysReco(name)
@@ -57,8 +89,11 @@ int PHTrackCleaner::process_event(PHCompositeNode * /*topNode*/)
   unsigned int good_track = 0;  // for diagnostic output only
   unsigned int ok_track = 0;    // tracks to keep
 
-  std::multimap<unsigned int, unsigned int> tpcid_track_mmap;
-  std::set<unsigned int> tpc_id_set;
+  // (tpc seed index, track id) of all tracks, sorted by tpc seed index
+  std::vector<std::pair<unsigned int, unsigned int>> tpcid_tracks;
+  tpcid_tracks.reserve(_track_map->size());
+  const SeedIndex tpc_seed_index(_tpc_seed_map);
+  const SeedIndex silicon_seed_index(_silicon_seed_map);
   // loop over the fitted tracks
   for (auto &it : *_track_map)
   {
@@ -70,34 +105,38 @@ int PHTrackCleaner::process_event(PHCompositeNode * /*topNode*/)
     }
 
     auto tpc_seed = track->get_tpc_seed();
-    unsigned int tpc_index = _tpc_seed_map->find(tpc_seed);
+    unsigned int tpc_index = tpc_seed_index.find(tpc_seed);
 
-    auto tpc_track_pair = std::make_pair(tpc_index, track_id);
-
-    tpc_id_set.insert(tpc_index);
-    tpcid_track_mmap.insert(tpc_track_pair);
+    tpcid_tracks.emplace_back(tpc_index, track_id);
   }
 
+  // track ids are increasing in the map, the stable sort keeps that order within a tpc seed
+  std::stable_sort(tpcid_tracks.begin(), tpcid_tracks.end(),
+                   [](const auto& lhs, const auto& rhs)
+                   { return lhs.first < rhs.first; });
+
   if (Verbosity() > 0)
   {
-    std::cout << " tpcid_track_mmap  size " << tpcid_track_mmap.size() << std::endl;
+    std::cout << " tpcid_track_mmap  size " << tpcid_tracks.size() << std::endl;
   }
 
   // loop over the TPC seed ID's
 
-  for (unsigned int tpc_id : tpc_id_set)
+  for (auto tpc_begin = tpcid_tracks.begin(); tpc_begin != tpcid_tracks.end();)
   {
+    const unsigned int tpc_id = tpc_begin->first;
+    auto tpc_end = std::find_if(tpc_begin, tpcid_tracks.end(),
+                                [tpc_id](const auto& entry)
+                                { return entry.first != tpc_id; });
     if (Verbosity() > 1)
     {
       std::cout << " TPC ID " << tpc_id << std::endl;
     }
 
-    auto tpc_range = tpcid_track_mmap.equal_range(tpc_id);
-
     unsigned int best_id = 99999;
     double min_chisq_df = 99999.0;
     unsigned int best_ndf = 1;
-    for (auto it = tpc_range.first; it != tpc_range.second; ++it)
+    for (auto it = tpc_begin; it != tpc_end; ++it)
     {
       unsigned int track_id = it->second;
 
@@ -110,7 +149,7 @@ int PHTrackCleaner::process_event(PHCompositeNode * /*topNode*/)
         auto si_seed = _track->get_silicon_seed();
         if (si_seed)
 	  {
-	    si_index = _silicon_seed_map->find(si_seed);
+	    si_index = silicon_seed_index.find(si_seed);
 	  }
 	else
 	  {
@@ -198,6 +237,7 @@ int PHTrackCleaner::process_event(PHCompositeNode * /*topNode*/)
         std::cout << "        no track exists  for tpc_id " << tpc_id << std::endl;
       }
     }
+    tpc_begin = tpc_end;
   }
 
   if (Verbosity() > 0)
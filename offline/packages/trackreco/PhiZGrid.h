@@ -0,0 +1,211 @@
+#ifndef TRACKRECO_PHIZGRID_H
+#define TRACKRECO_PHIZGRID_H
+
+/*!
+ *  \file PhiZGrid.h
+ *  \brief uniform (phi, z) binned grid for window queries on the clusters of one layer
+ *  \detail
+ *  the grid is filled once per layer and event: the entries are counting-sorted by bin into a
+ *  single contiguous array, so that all entries of a phi row inside a z window are adjacent
+ *  in memory. It replaces the boost rtree in cases where the geometry is fixed and the
+ *  windows are small, for which build and query are much cheaper.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+template <class T>
+class PhiZGrid
+{
+ public:
+  /// entry stored in the grid
+  struct Entry
+  {
+    float phi = 0;
+    float z = 0;
+    T value{};
+  };
+
+  /// smallest bin size in phi (rad) and z (cm)
+  /**
+   * typically the search window half width, so that a query touches three bins per direction.
+   * the binning is made coarser in fill() if there would be many more bins than entries
+   */
+  void set_bin_size(float phi_size, float z_size)
+  {
+    m_phi_size = phi_size;
+    m_z_size = z_size;
+  }
+
+  /// fill the grid. phi must be in [0, 2pi], the z range is taken from the entries.
+  /// the order of entries within a bin is preserved
+  void fill(const std::vector<Entry>& entries)
+  {
+    clear();
+    if (entries.empty())
+    {
+      return;
+    }
+
+    const auto zrange = std::minmax_element(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+                                            { return a.z < b.z; });
+    m_z_min = zrange.first->z;
+    const float z_max = zrange.second->z;
+
+    m_nphi = get_nbins(2. * M_PI, m_phi_size);
+    m_nz = get_nbins(z_max - m_z_min, m_z_size);
+
+    const size_t max_bins = 2 * entries.size() + 16;
+    while (static_cast<size_t>(m_nphi) * m_nz > max_bins)
+    {
+      if (m_nphi >= m_nz)
+      {
+        m_nphi = (m_nphi + 1) / 2;
+      }
+      else
+      {
+        m_nz = (m_nz + 1) / 2;
+      }
+    }
+
+    m_phi_step = 2. * M_PI / m_nphi;
+    m_z_step = z_max > m_z_min ? (z_max - m_z_min) / m_nz : 1;
+
+    // count entries per bin, then scatter
+    m_offsets.assign(static_cast<size_t>(m_nphi) * m_nz + 1, 0);
+    std::vector<unsigned int> bins;
+    bins.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+      bins.push_back(phi_bin(entry.phi) * m_nz + z_bin(entry.z));
+      ++m_offsets[bins.back() + 1];
+    }
+    for (size_t i = 1; i < m_offsets.size(); ++i)
+    {
+      m_offsets[i] += m_offsets[i - 1];
+    }
+
+    m_entries.resize(entries.size());
+    std::vector<unsigned int> position(m_offsets.begin(), m_offsets.end() - 1);
+    for (size_t i = 0; i < entries.size(); ++i)
+    {
+      m_entries[position[bins[i]]++] = entries[i];
+    }
+  }
+
+  /// remove all entries
+  void clear()
+  {
+    m_entries.clear();
+    m_offsets.clear();
+    m_nphi = 0;
+    m_nz = 0;
+  }
+
+  /// number of entries
+  size_t size() const { return m_entries.size(); }
+
+  /// true if there are no entries
+  bool empty() const { return m_entries.empty(); }
+
+  /// call func(entry) for all entries with phimin <= phi <= phimax and zmin <= z <= zmax
+  /**
+   * phi windows extending below 0 or above 2pi are wrapped. The window boundaries are
+   * converted to float before comparing, the same way as for the float rtree boxes
+   */
+  template <class F>
+  void query(double phimin, double zmin, double phimax, double zmax, F&& func) const
+  {
+    if (m_entries.empty())
+    {
+      return;
+    }
+
+    bool query_both_ends = false;
+    if (phimin < 0)
+    {
+      query_both_ends = true;
+      phimin += 2 * M_PI;
+    }
+    if (phimax > 2 * M_PI)
+    {
+      query_both_ends = true;
+      phimax -= 2 * M_PI;
+    }
+    if (query_both_ends)
+    {
+      query_range(phimin, zmin, 2 * M_PI, zmax, func);
+      query_range(0., zmin, phimax, zmax, func);
+    }
+    else
+    {
+      query_range(phimin, zmin, phimax, zmax, func);
+    }
+  }
+
+ private:
+  static unsigned int get_nbins(double range, double size)
+  {
+    if (!(size > 0) || !(range > 0))
+    {
+      return 1;
+    }
+    return std::clamp<double>(std::ceil(range / size), 1, 4096);
+  }
+
+  unsigned int phi_bin(float phi) const
+  {
+    return std::clamp<int>(std::floor(phi / m_phi_step), 0, m_nphi - 1);
+  }
+
+  unsigned int z_bin(float z) const
+  {
+    return std::clamp<int>(std::floor((z - m_z_min) / m_z_step), 0, m_nz - 1);
+  }
+
+  template <class F>
+  void query_range(float phimin, float zmin, float phimax, float zmax, F& func) const
+  {
+    if (phimax < phimin || zmax < zmin)
+    {
+      return;
+    }
+
+    const unsigned int iz_min = z_bin(zmin);
+    const unsigned int iz_max = z_bin(zmax);
+    for (unsigned int iphi = phi_bin(phimin); iphi <= phi_bin(phimax); ++iphi)
+    {
+      // bins of a phi row are contiguous in z
+      const auto begin = m_entries.begin() + m_offsets[iphi * m_nz + iz_min];
+      const auto end = m_entries.begin() + m_offsets[iphi * m_nz + iz_max + 1];
+      for (auto iter = begin; iter != end; ++iter)
+      {
+        if (iter->phi >= phimin && iter->phi <= phimax && iter->z >= zmin && iter->z <= zmax)
+        {
+          func(*iter);
+        }
+      }
+    }
+  }
+
+  /// smallest bin sizes
+  float m_phi_size = 0.02;
+  float m_z_size = 1.;
+
+  /// binning of the current fill
+  unsigned int m_nphi = 0;
+  unsigned int m_nz = 0;
+  double m_phi_step = 1;
+  float m_z_min = 0;
+  float m_z_step = 1;
+
+  /// first entry of each bin, phi major
+  std::vector<unsigned int> m_offsets;
+
+  /// entries sorted by bin
+  std::vector<Entry> m_entries;
+};
+
+#endif
@@ -40,6 +40,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
 #include <vector>
 
@@ -85,6 +86,16 @@ int SecondaryVertexFinder::InitRun(PHCompositeNode* topNode)
     ntp = new TNtuple("ntp", "decay_pairs", "x1:y1:z1:px1:py1:pz1:dca3dxy1:dca3dz1:vposx1:vposy1:vposz1:vmomx1:vmomy1:vmomz1:pca_relx_1:pca_rely_1:pca_relz_1:eta1:charge1:tpcClusters_1:quality1:eta1:x2:y2:z2:px2:py2:pz2:dca3dxy2:dca3dz2:vposx2:vposy2:vposz2:vmomx2:vmomy2:vmomz2:pca_relx_2:pca_rely_2:pca_relz_2:eta2:charge2:tpcClusters_2:quality2:eta2:vertex_x:vertex_y:vertex_z:pair_dca:invariant_mass:invariant_pt:path:has_silicon1:has_silicon2");
   }
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "SecondaryVertexFinder::InitRun - finding pair vertices with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return ret;
 }
 
@@ -141,334 +152,131 @@ int SecondaryVertexFinder::process_event(PHCompositeNode* /*topNode*/)
     std::cout << PHWHERE << " track map size " << _track_map->size() << std::endl;
   }
 
-  // Loop over tracks and check for close DCA match with all other tracks
-  for (auto tr1_it = _track_map->begin(); tr1_it != _track_map->end(); ++tr1_it)
+  // single track cuts, once per track
+  std::vector<TrackCandidate> candidates;
+  candidates.reserve(_track_map->size());
+  for (const auto& [id, tr] : *_track_map)
   {
-    auto id1 = tr1_it->first;
-    auto tr1 = tr1_it->second;
-
-    auto vertexId = tr1->get_vertex_id();
-    const SvtxVertex* svtxVertex = _svtx_vertex_map->get(vertexId);
-    if (!svtxVertex)
+    TrackCandidate candidate;
+    if (makeTrackCandidate(tr, candidate))
     {
-      if (Verbosity() > 1)
-      {
-        std::cout << PHWHERE << " Failed to find vertex id " << vertexId << " skip this track " << std::endl;
-      }
-      continue;
-    }
-    if (svtxVertex->size_tracks() == 0)
-    {
-      continue;  // event did not have a reconstructed vertex, vertex is bogus
-    }
-
-    // Reverse or remove this to consider TPC-only tracks too
-    if (_require_mvtx && !hasSiliconSeed(tr1))
-    {
-      continue;
+      candidates.push_back(candidate);
     }
+  }
 
-    int has_silicon_1 = 0;
-    if (hasSiliconSeed(tr1))
-    {
-      has_silicon_1 = 1;
-    }
-
-    if (Verbosity() > 3)
-    {
-      std::cout << "Track1 " << id1 << " details: " << std::endl;
-      outputTrackDetails(tr1);
-    }
-
-    if (tr1->get_quality() > _qual_cut)
-    {
-      continue;
-    }
-
-    auto tpc_seed1 = tr1->get_tpc_seed();
-    int ntpc1 = tpc_seed1->size_cluster_keys();
-    if (ntpc1 < 20)
-    {
-      continue;
-    }
-
-    float dca3dxy1, dca3dz1, dca3dxysigma1, dca3dzsigma1;
-    get_dca(tr1, dca3dxy1, dca3dz1, dca3dxysigma1, dca3dzsigma1);
-    // std::cout << "   tr1 " << id1 << " dca3dxy1 = " << dca3dxy1 << " dca3dz1 = " << dca3dz1 << std::endl;
-
-    if (!dca3dxy1)
-    {
-      std::cout << " get_dca returned NAN " << std::endl;
-      continue;
-    }
-    if (fabs(dca3dxy1) < _track_dcaxy_cut)
-    {
-      continue;
-    }
-    if (fabs(dca3dz1) < _track_dcaz_cut)
-    {
-      continue;
-    }
+  // pairs of opposite charge tracks, the z ranges of both tracks at the circle intersections must overlap.
+  // The negative tracks are sorted in zmin, so only those with zmin below the zmax of the positive track are tested
+  std::vector<size_t> positive;
+  std::vector<size_t> negative;
+  for (size_t i = 0; i < candidates.size(); ++i)
+  {
+    (candidates[i].track->get_charge() > 0 ? positive : negative).push_back(i);
+  }
+  std::sort(negative.begin(), negative.end(), [&candidates](size_t lhs, size_t rhs)
+            { return candidates[lhs].zmin < candidates[rhs].zmin; });
 
-    // look for close DCA matches with all other such tracks
-    for (auto tr2_it = std::next(tr1_it); tr2_it != _track_map->end(); ++tr2_it)
+  std::vector<std::pair<size_t, size_t>> pairs;
+  for (const auto& ipos : positive)
+  {
+    const auto& pos = candidates[ipos];
+    for (auto ineg = negative.begin(); ineg != negative.end() && candidates[*ineg].zmin <= pos.zmax; ++ineg)
     {
-      auto id2 = tr2_it->first;
-      auto tr2 = tr2_it->second;
-
-      // Reverse or remove this to consider TPC tracks too
-      if (_require_mvtx && !hasSiliconSeed(tr2))
+      const auto& neg = candidates[*ineg];
+      if (neg.zmax < pos.zmin)
       {
         continue;
       }
 
-      int has_silicon_2 = 0;
-      if (hasSiliconSeed(tr2))
-      {
-        has_silicon_2 = 1;
-      }
-
-      if (Verbosity() > 3)
-      {
-        std::cout << "Track2 " << id2 << " details: " << std::endl;
-        outputTrackDetails(tr2);
-      }
-
-      if (tr2->get_charge() == tr1->get_charge())
+      // the first track is the one first in the track map, as in the loop over all pairs
+      const size_t first = std::min(ipos, *ineg);
+      const size_t second = std::max(ipos, *ineg);
+      if (candidates[first].first)
       {
-        continue;
+        pairs.emplace_back(first, second);
       }
+    }
+  }
+  std::sort(pairs.begin(), pairs.end());
 
-      if (tr2->get_quality() > _qual_cut)
-      {
-        continue;
-      }
+  // find DCA and PCA of the pairs, the track projections dominate
+  std::vector<std::vector<PairVertex>> pair_vertices(pairs.size());
+  if (m_threadpool && Verbosity() == 0 && pairs.size() > 1)
+  {
+    m_threadpool->parallel_for(pairs.size(), [&](size_t ipair)
+                               { findPairVertices(candidates[pairs[ipair].first], candidates[pairs[ipair].second], pair_vertices[ipair]); });
+  }
+  else
+  {
+    for (size_t ipair = 0; ipair < pairs.size(); ++ipair)
+    {
+      findPairVertices(candidates[pairs[ipair].first], candidates[pairs[ipair].second], pair_vertices[ipair]);
+    }
+  }
 
-      auto tpc2_seed = tr2->get_tpc_seed();
-      int ntpc2 = tpc2_seed->size_cluster_keys();
-      if (ntpc2 < 20)
-      {
-        continue;
-      }
+  // output in pair order
+  for (size_t ipair = 0; ipair < pairs.size(); ++ipair)
+  {
+    const auto& candidate1 = candidates[pairs[ipair].first];
+    const auto& candidate2 = candidates[pairs[ipair].second];
+    auto tr1 = candidate1.track;
+    auto tr2 = candidate2.track;
+    for (const auto& pair_vertex : pair_vertices[ipair])
+    {
+      const auto& [vpos1, vmom1, vpos2, vmom2, PCA1, PCA2, pair_dca] = pair_vertex;
 
-      float dca3dxy2, dca3dz2, dca3dxysigma2, dca3dzsigma2;
-      get_dca(tr2, dca3dxy2, dca3dz2, dca3dxysigma2, dca3dzsigma2);
-      // std::cout << " tr2 " << id2 << " dca3dxy2 = " << dca3dxy2 << " dca3dz2 = " << dca3dz2 << std::endl;
-      if (!dca3dxy2)
-      {
-        std::cout << " get_dca returned NAN " << std::endl;
-        continue;
-      }
-      if (fabs(dca3dxy2) < _track_dcaxy_cut)
-      {
-        continue;
-      }
-      if (fabs(dca3dz2) < _track_dcaz_cut)
-      {
-        continue;
-      }
+      // calculate the invariant mass using the track states at the decay vertex
 
-      // find DCA and PCA of these two tracks
-      if (Verbosity() > 3)
-      {
-        std::cout << "Check pair DCA for tracks " << id1 << " and  " << id2 << std::endl;
-      }
+      TLorentzVector t1;
+      Float_t E1 = sqrt(pow(vmom1(0), 2) + pow(vmom1(1), 2) + pow(vmom1(2), 2) + pow(_decaymass, 2));
+      t1.SetPxPyPzE(vmom1(0), vmom1(1), vmom1(2), E1);
 
-      double R1;
-      Eigen::Vector2d center1;
-      getCircleXYTrack(tr1, R1, center1);
-      if (Verbosity() > 2)
-      {
-        std::cout << std::endl
-                  << "Track 1 circle: " << std::endl;
-        std::cout << "  tr1.x " << tr1->get_x() << " tr1.y " << tr1->get_y() << " tr1.z " << tr1->get_z() << " charge " << tr1->get_charge() << std::endl;
-        std::cout << "   tr1.px " << tr1->get_px() << " tr1.py " << tr1->get_py() << " tr1.pz " << tr1->get_pz() << std::endl;
-        std::cout << "         track1 " << tr1->get_id() << " circle R " << R1 << " (x, y)  " << center1(0) << "  " << center1(1) << std::endl;
-      }
-      double R2;
-      Eigen::Vector2d center2;
-      getCircleXYTrack(tr2, R2, center2);
-      if (Verbosity() > 2)
-      {
-        std::cout << "Track 2 circle: " << std::endl;
-        std::cout << "   tr2.x " << tr2->get_x() << " tr2.y " << tr2->get_y() << " tr2.z " << tr2->get_z() << " charge " << tr2->get_charge() << std::endl;
-        std::cout << "   tr2.px " << tr2->get_px() << " tr2.py " << tr2->get_py() << " tr2.pz " << tr2->get_pz() << std::endl;
-        std::cout << "         track2 " << tr2->get_id() << " circle R " << R2 << " (x, y)  " << center2(0) << "  " << center2(1) << std::endl;
-      }
+      TLorentzVector t2;
+      Float_t E2 = sqrt(pow(vmom2(0), 2) + pow(vmom2(1), 2) + pow(vmom2(2), 2) + pow(_decaymass, 2));
+      t2.SetPxPyPzE(vmom2(0), vmom2(1), vmom2(2), E2);
 
-      std::vector<double> intersections;
-      if (!circle_circle_intersection(R1, center1(0), center1(1), R2, center2(0), center2(1), intersections))
-      {
-        if (Verbosity() > 2)
-        {
-          std::cout << "    - no intersections, skip this pair" << std::endl;
-        }
-        continue;
-      }
+      TLorentzVector tsum = t1 + t2;
 
-      Eigen::Vector2d intersection[2];
-      if (intersections.size() == 2)
-      {
-        intersection[0](0) = intersections[0];
-        intersection[0](1) = intersections[1];
-      }
-      if (intersections.size() == 4)
-      {
-        intersection[1](0) = intersections[2];
-        intersection[1](1) = intersections[3];
-      }
+      // calculate the decay length
+      Eigen::Vector3d PCA = (vpos1 + vpos2) / 2.0;  // average the PCA of the track pair
+      auto vtxid = tr1->get_vertex_id();
+      auto vertex1 = _svtx_vertex_map->get(vtxid);
+      Eigen::Vector3d VTX(vertex1->get_x(), vertex1->get_y(), vertex1->get_z());
+      Eigen::Vector3d path = PCA - VTX;
+      double decay_radius = sqrt(pow(PCA(0), 2) + pow(PCA(1), 2));
 
-      // process both intersections
-      for (int i = 0; i < 2; ++i)
+      if (path.norm() > _min_path_cut)
       {
-        if (intersection[i].norm() == 0)
-        {
-          continue;
-        }
-
-        double vradius = sqrt(intersection[i](0) * intersection[i](0) + intersection[i](1) * intersection[i](1));
-        if (vradius > _max_intersection_radius)
-        {
-          continue;
-        }
-
-        double z1 = getZFromIntersectionXY(tr1, R1, center1, intersection[i]);
-        double z2 = getZFromIntersectionXY(tr2, R2, center2, intersection[i]);
-        if (Verbosity() > 2)
-        {
-          std::cout << " track intersection " << i << " at (x,y) " << intersection[i](0) << "  " << intersection[i](1)
-                    << " radius " << vradius << " est. z1 " << z1 << " est. z2 " << z2 << std::endl;
-        }
-
-        if (fabs(z1 - z2) > 2.0)  // skip this intersection, it is not good
-        {
-          if (Verbosity() > 2)
-          {
-            std::cout << "    z-mismatch - wrong intersection, skip it " << std::endl;
-          }
-          continue;
-        }
-
-        Eigen::Vector3d vpos1(0, 0, 0), vmom1(0, 0, 0);
-        Eigen::Vector3d vpos2(0, 0, 0), vmom2(0, 0, 0);
-
-        // Project the tracks to the intersection
-        Eigen::Vector3d intersect1(intersection[i](0), intersection[i](1), z1);
-        if (!projectTrackToPoint(tr1, intersect1, vpos1, vmom1))
-        {
-          continue;
-        }
-        if (Verbosity() > 2)
-        {
-          std::cout << "  Projected track 1 to point " << intersect1(0) << "  " << intersect1(1) << "  " << intersect1(2) << std::endl;
-          std::cout << "                                 has vpos " << vpos1(0) << "  " << vpos1(1) << "  " << vpos1(2) << std::endl;
-        }
-        Eigen::Vector3d intersect2(intersection[i](0), intersection[i](1), z2);
-        if (!projectTrackToPoint(tr2, intersect2, vpos2, vmom2))
-        {
-          continue;
-        }
-        if (Verbosity() > 2)
-        {
-          std::cout << "  Projected track 2 to point " << intersect2(0) << "  " << intersect2(1) << "  " << intersect2(2) << std::endl;
-          std::cout << "                                 has vpos " << vpos2(0) << "  " << vpos2(1) << "  " << vpos2(2) << std::endl;
-        }
-
-        // check that the z positions are close
-        if (fabs(vpos1(2) - vpos2(2)) > _projected_track_z_cut)
-        {
-          if (Verbosity() > 0)
-          {
-            std::cout << "    Warning: projected z positions are screwed up, should not be" << std::endl;
-          }
-          continue;
-        }
-
-        if (Verbosity() > 2)
-        {
-          std::cout << "Summary for projected pair:" << std::endl;
-          std::cout << " Fitted tracks: " << std::endl;
-          std::cout << "   tr1.x " << tr1->get_x() << " tr1.y " << tr1->get_y() << " tr1.z " << tr1->get_z() << std::endl;
-          std::cout << "   tr2.x " << tr2->get_x() << " tr2.y " << tr2->get_y() << " tr2.z " << tr2->get_z() << std::endl;
-          std::cout << "   tr1.px " << tr1->get_px() << " tr1.py " << tr1->get_py() << " tr1.pz " << tr1->get_pz() << std::endl;
-          std::cout << "   tr2.px " << tr2->get_px() << " tr2.py " << tr2->get_py() << " tr2.pz " << tr2->get_pz() << std::endl;
-          std::cout << " Projected tracks: " << std::endl;
-          std::cout << "   pos1.x " << vpos1(0) << " pos1.y " << vpos1(1) << " pos1.z " << vpos1(2) << std::endl;
-          std::cout << "   pos2.x " << vpos2(0) << " pos2.y " << vpos2(1) << " pos2.z " << vpos2(2) << std::endl;
-          std::cout << "   mom1.x " << vmom1(0) << " mom1.y " << vmom1(1) << " mom1.z " << vmom1(2) << std::endl;
-          std::cout << "   mom2.x " << vmom2(0) << " mom2.y " << vmom2(1) << " mom2.z " << vmom2(2) << std::endl;
-        }
-
-        // Improve the pair dca using a local straight line approximation
-        double pair_dca;
-        Eigen::Vector3d PCA1(0, 0, 0), PCA2(0, 0, 0);
-        findPcaTwoLines(vpos1, vmom1, vpos2, vmom2, pair_dca, PCA1, PCA2);
-        if (Verbosity() > 2)
+        if (Verbosity() > 0)
         {
-          std::cout << "       pair_dca " << pair_dca << " two_track_dcacut " << _two_track_dcacut << std::endl;
-          std::cout << "       PCA1 " << PCA1(0) << "  " << PCA1(1) << "  " << PCA1(2) << std::endl;
-          std::cout << "       PCA2 " << PCA2(0) << "  " << PCA2(1) << "  " << PCA2(2) << std::endl;
+          std::cout << "    Pair mass " << tsum.M() << " pair pT " << tsum.Pt()
+                    << " decay length " << path.norm() << std::endl;
         }
 
-        if (fabs(pair_dca) > _two_track_dcacut)
+        if (_write_ntuple)
         {
-          continue;
+          fillNtp(tr1, tr2, candidate1.dca3dxy, candidate1.dca3dz, candidate2.dca3dxy, candidate2.dca3dz, vpos1, vmom1, vpos2, vmom2,
+                  PCA1, PCA2, pair_dca, tsum.M(), tsum.Pt(), path.norm(), candidate1.has_silicon, candidate2.has_silicon);
         }
 
-        // calculate the invariant mass using the track states at the decay vertex
-
-        TLorentzVector t1;
-        Float_t E1 = sqrt(pow(vmom1(0), 2) + pow(vmom1(1), 2) + pow(vmom1(2), 2) + pow(_decaymass, 2));
-        t1.SetPxPyPzE(vmom1(0), vmom1(1), vmom1(2), E1);
-
-        TLorentzVector t2;
-        Float_t E2 = sqrt(pow(vmom2(0), 2) + pow(vmom2(1), 2) + pow(vmom2(2), 2) + pow(_decaymass, 2));
-        t2.SetPxPyPzE(vmom2(0), vmom2(1), vmom2(2), E2);
-
-        TLorentzVector tsum = t1 + t2;
-
-        // calculate the decay length
-        Eigen::Vector3d PCA = (vpos1 + vpos2) / 2.0;  // average the PCA of the track pair
-        auto vtxid = tr1->get_vertex_id();
-        auto vertex1 = _svtx_vertex_map->get(vtxid);
-        Eigen::Vector3d VTX(vertex1->get_x(), vertex1->get_y(), vertex1->get_z());
-        Eigen::Vector3d path = PCA - VTX;
-        double decay_radius = sqrt(pow(PCA(0), 2) + pow(PCA(1), 2));
-
-        if (path.norm() > _min_path_cut)
+        if (_write_electrons_node)
         {
-          if (Verbosity() > 0)
+          if (passConversionElectronCuts(tsum, tr1, tr2, pair_dca, PCA, VTX))
           {
-            std::cout << "    Pair mass " << tsum.M() << " pair pT " << tsum.Pt()
-                      << " decay length " << path.norm() << std::endl;
-          }
+            if (Verbosity() > 0)
+            {
+              std::cout << "     **** inserting tracks " << tr1->get_id() << "  and " << tr2->get_id() << std::endl;
+            }
 
-          if (_write_ntuple)
-          {
-            fillNtp(tr1, tr2, dca3dxy1, dca3dz1, dca3dxy2, dca3dz2, vpos1, vmom1, vpos2, vmom2,
-                    PCA1, PCA2, pair_dca, tsum.M(), tsum.Pt(), path.norm(), has_silicon_1, has_silicon_2);
-          }
+            // Add decay particles to output node
+            _track_map_electrons->insertWithKey(tr1, tr1->get_id());
+            _track_map_electrons->insertWithKey(tr2, tr2->get_id());
 
-          if (_write_electrons_node)
-          {
-            if (passConversionElectronCuts(tsum, tr1, tr2, pair_dca, PCA, VTX))
+            if (_write_ntuple)
             {
-              if (Verbosity() > 0)
-              {
-                std::cout << "     **** inserting tracks " << tr1->get_id() << "  and " << tr2->get_id() << std::endl;
-              }
-
-              // Add decay particles to output node
-              _track_map_electrons->insertWithKey(tr1, tr1->get_id());
-              _track_map_electrons->insertWithKey(tr2, tr2->get_id());
-
-              if (_write_ntuple)
-              {
-                // these are just to check on the effect of the cuts
-                recomass->Fill(tsum.Pt(), tsum.M());
-                hdecay_radius->Fill(decay_radius);
-                hdecaypos->Fill(PCA(0), PCA(1));
-              }
+              // these are just to check on the effect of the cuts
+              recomass->Fill(tsum.Pt(), tsum.M());
+              hdecay_radius->Fill(decay_radius);
+              hdecaypos->Fill(PCA(0), PCA(1));
             }
           }
         }
@@ -494,6 +302,232 @@ int SecondaryVertexFinder::process_event(PHCompositeNode* /*topNode*/)
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+bool SecondaryVertexFinder::makeTrackCandidate(SvtxTrack* tr, TrackCandidate& candidate)
+{
+  // Reverse or remove this to consider TPC-only tracks too
+  if (_require_mvtx && !hasSiliconSeed(tr))
+  {
+    return false;
+  }
+
+  if (Verbosity() > 3)
+  {
+    std::cout << "Track " << tr->get_id() << " details: " << std::endl;
+    outputTrackDetails(tr);
+  }
+
+  // neutral tracks have no circle
+  if (tr->get_charge() == 0)
+  {
+    return false;
+  }
+
+  if (tr->get_quality() > _qual_cut)
+  {
+    return false;
+  }
+
+  auto tpc_seed = tr->get_tpc_seed();
+  int ntpc = tpc_seed->size_cluster_keys();
+  if (ntpc < 20)
+  {
+    return false;
+  }
+
+  float dca3dxy, dca3dz, dca3dxysigma, dca3dzsigma;
+  get_dca(tr, dca3dxy, dca3dz, dca3dxysigma, dca3dzsigma);
+  if (!dca3dxy)
+  {
+    std::cout << " get_dca returned NAN " << std::endl;
+    return false;
+  }
+  if (fabs(dca3dxy) < _track_dcaxy_cut)
+  {
+    return false;
+  }
+  if (fabs(dca3dz) < _track_dcaz_cut)
+  {
+    return false;
+  }
+
+  candidate.track = tr;
+  candidate.has_silicon = hasSiliconSeed(tr) ? 1 : 0;
+  candidate.dca3dxy = dca3dxy;
+  candidate.dca3dz = dca3dz;
+
+  // the first track of a pair needs a reconstructed vertex
+  auto vertexId = tr->get_vertex_id();
+  const SvtxVertex* svtxVertex = _svtx_vertex_map->get(vertexId);
+  if (!svtxVertex)
+  {
+    if (Verbosity() > 1)
+    {
+      std::cout << PHWHERE << " Failed to find vertex id " << vertexId << " track can only be the second of a pair " << std::endl;
+    }
+  }
+  candidate.first = svtxVertex && svtxVertex->size_tracks() > 0;
+
+  getCircleXYTrack(tr, candidate.R, candidate.center);
+  if (Verbosity() > 2)
+  {
+    std::cout << "  track " << tr->get_id() << " circle R " << candidate.R << " (x, y)  " << candidate.center(0) << "  " << candidate.center(1) << std::endl;
+  }
+
+  // the xy path to any intersection is below 2 pi R, which bounds the z of the track at the intersections
+  const double zpath = 2 * M_PI * candidate.R * fabs(tr->get_pz() / tr->get_pt());
+  if (std::isfinite(zpath))
+  {
+    candidate.zmin = tr->get_z() - zpath - _intersection_z_cut / 2.;
+    candidate.zmax = tr->get_z() + zpath + _intersection_z_cut / 2.;
+  }
+  else
+  {
+    candidate.zmin = -std::numeric_limits<double>::infinity();
+    candidate.zmax = std::numeric_limits<double>::infinity();
+  }
+
+  return true;
+}
+
+void SecondaryVertexFinder::findPairVertices(const TrackCandidate& candidate1, const TrackCandidate& candidate2, std::vector<PairVertex>& vertices)
+{
+  auto tr1 = candidate1.track;
+  auto tr2 = candidate2.track;
+
+  // find DCA and PCA of these two tracks
+  if (Verbosity() > 3)
+  {
+    std::cout << "Check pair DCA for tracks " << tr1->get_id() << " and  " << tr2->get_id() << std::endl;
+  }
+
+  std::vector<double> intersections;
+  if (!circle_circle_intersection(candidate1.R, candidate1.center(0), candidate1.center(1), candidate2.R, candidate2.center(0), candidate2.center(1), intersections))
+  {
+    if (Verbosity() > 2)
+    {
+      std::cout << "    - no intersections, skip this pair" << std::endl;
+    }
+    return;
+  }
+
+  Eigen::Vector2d intersection[2] = {Eigen::Vector2d::Zero(), Eigen::Vector2d::Zero()};
+  if (intersections.size() == 2)
+  {
+    intersection[0](0) = intersections[0];
+    intersection[0](1) = intersections[1];
+  }
+  if (intersections.size() == 4)
+  {
+    intersection[1](0) = intersections[2];
+    intersection[1](1) = intersections[3];
+  }
+
+  double R1 = candidate1.R;
+  double R2 = candidate2.R;
+  Eigen::Vector2d center1 = candidate1.center;
+  Eigen::Vector2d center2 = candidate2.center;
+
+  // process both intersections
+  for (int i = 0; i < 2; ++i)
+  {
+    if (intersection[i].norm() == 0)
+    {
+      continue;
+    }
+
+    double vradius = sqrt(intersection[i](0) * intersection[i](0) + intersection[i](1) * intersection[i](1));
+    if (vradius > _max_intersection_radius)
+    {
+      continue;
+    }
+
+    double z1 = getZFromIntersectionXY(tr1, R1, center1, intersection[i]);
+    double z2 = getZFromIntersectionXY(tr2, R2, center2, intersection[i]);
+    if (Verbosity() > 2)
+    {
+      std::cout << " track intersection " << i << " at (x,y) " << intersection[i](0) << "  " << intersection[i](1)
+                << " radius " << vradius << " est. z1 " << z1 << " est. z2 " << z2 << std::endl;
+    }
+
+    if (fabs(z1 - z2) > _intersection_z_cut)  // skip this intersection, it is not good
+    {
+      if (Verbosity() > 2)
+      {
+        std::cout << "    z-mismatch - wrong intersection, skip it " << std::endl;
+      }
+      continue;
+    }
+
+    Eigen::Vector3d vpos1(0, 0, 0), vmom1(0, 0, 0);
+    Eigen::Vector3d vpos2(0, 0, 0), vmom2(0, 0, 0);
+
+    // Project the tracks to the intersection
+    Eigen::Vector3d intersect1(intersection[i](0), intersection[i](1), z1);
+    if (!projectTrackToPoint(tr1, intersect1, vpos1, vmom1))
+    {
+      continue;
+    }
+    if (Verbosity() > 2)
+    {
+      std::cout << "  Projected track 1 to point " << intersect1(0) << "  " << intersect1(1) << "  " << intersect1(2) << std::endl;
+      std::cout << "                                 has vpos " << vpos1(0) << "  " << vpos1(1) << "  " << vpos1(2) << std::endl;
+    }
+    Eigen::Vector3d intersect2(intersection[i](0), intersection[i](1), z2);
+    if (!projectTrackToPoint(tr2, intersect2, vpos2, vmom2))
+    {
+      continue;
+    }
+    if (Verbosity() > 2)
+    {
+      std::cout << "  Projected track 2 to point " << intersect2(0) << "  " << intersect2(1) << "  " << intersect2(2) << std::endl;
+      std::cout << "                                 has vpos " << vpos2(0) << "  " << vpos2(1) << "  " << vpos2(2) << std::endl;
+    }
+
+    // check that the z positions are close
+    if (fabs(vpos1(2) - vpos2(2)) > _projected_track_z_cut)
+    {
+      if (Verbosity() > 0)
+      {
+        std::cout << "    Warning: projected z positions are screwed up, should not be" << std::endl;
+      }
+      continue;
+    }
+
+    if (Verbosity() > 2)
+    {
+      std::cout << "Summary for projected pair:" << std::endl;
+      std::cout << " Fitted tracks: " << std::endl;
+      std::cout << "   tr1.x " << tr1->get_x() << " tr1.y " << tr1->get_y() << " tr1.z " << tr1->get_z() << std::endl;
+      std::cout << "   tr2.x " << tr2->get_x() << " tr2.y " << tr2->get_y() << " tr2.z " << tr2->get_z() << std::endl;
+      std::cout << "   tr1.px " << tr1->get_px() << " tr1.py " << tr1->get_py() << " tr1.pz " << tr1->get_pz() << std::endl;
+      std::cout << "   tr2.px " << tr2->get_px() << " tr2.py " << tr2->get_py() << " tr2.pz " << tr2->get_pz() << std::endl;
+      std::cout << " Projected tracks: " << std::endl;
+      std::cout << "   pos1.x " << vpos1(0) << " pos1.y " << vpos1(1) << " pos1.z " << vpos1(2) << std::endl;
+      std::cout << "   pos2.x " << vpos2(0) << " pos2.y " << vpos2(1) << " pos2.z " << vpos2(2) << std::endl;
+      std::cout << "   mom1.x " << vmom1(0) << " mom1.y " << vmom1(1) << " mom1.z " << vmom1(2) << std::endl;
+      std::cout << "   mom2.x " << vmom2(0) << " mom2.y " << vmom2(1) << " mom2.z " << vmom2(2) << std::endl;
+    }
+
+    // Improve the pair dca using a local straight line approximation
+    double pair_dca;
+    Eigen::Vector3d PCA1(0, 0, 0), PCA2(0, 0, 0);
+    findPcaTwoLines(vpos1, vmom1, vpos2, vmom2, pair_dca, PCA1, PCA2);
+    if (Verbosity() > 2)
+    {
+      std::cout << "       pair_dca " << pair_dca << " two_track_dcacut " << _two_track_dcacut << std::endl;
+      std::cout << "       PCA1 " << PCA1(0) << "  " << PCA1(1) << "  " << PCA1(2) << std::endl;
+      std::cout << "       PCA2 " << PCA2(0) << "  " << PCA2(1) << "  " << PCA2(2) << std::endl;
+    }
+
+    if (fabs(pair_dca) > _two_track_dcacut)
+    {
+      continue;
+    }
+
+    vertices.push_back({vpos1, vmom1, vpos2, vmom2, PCA1, PCA2, pair_dca});
+  }
+}
+
 bool SecondaryVertexFinder::passConversionElectronCuts(const TLorentzVector& tsum, SvtxTrack* tr1, SvtxTrack* tr2, float pair_dca, const Eigen::Vector3d& PCA, const Eigen::Vector3d& VTX)
 {
   bool pass = false;
@@ -698,6 +732,7 @@ void SecondaryVertexFinder::get_dca(SvtxTrack* track,
                                     float& dca3dxysigma, float& dca3dzsigma)
 {
   dca3dxy = NAN;
+  dca3dz = NAN;
   Acts::Vector3 pos(track->get_x(),
                     track->get_y(),
                     track->get_z());
@@ -12,6 +12,8 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <phool/PHThreadPool.h>
+
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrDefs.h>
 
@@ -31,6 +33,7 @@
 #include <ActsExamples/EventData/Trajectories.hpp>
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -81,7 +84,36 @@ class SecondaryVertexFinder : public SubsysReco
   void set_write_electrons_node(bool flag) { _write_electrons_node = flag; }
   void set_write_ntuple(bool flag) { _write_ntuple = flag; }
 
+  /// find the vertices of track pairs on nthreads threads, 0 uses all cores. Pairs are stored in track map order
+  void setNumThreads(unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
+  /// track passing the single track cuts, with the quantities used by the pair loop
+  struct TrackCandidate
+  {
+    SvtxTrack* track = nullptr;
+    int has_silicon = 0;
+    bool first = false;  // can be the first track of a pair, needs a reconstructed vertex
+    float dca3dxy = 0;
+    float dca3dz = 0;
+    double R = 0;
+    Eigen::Vector2d center = Eigen::Vector2d::Zero();
+    double zmin = 0;  // range of z of the track at any circle intersection, including half of the z cut
+    double zmax = 0;
+  };
+
+  /// pair vertex at one circle intersection passing the pair dca cut
+  struct PairVertex
+  {
+    Eigen::Vector3d vpos1;
+    Eigen::Vector3d vmom1;
+    Eigen::Vector3d vpos2;
+    Eigen::Vector3d vmom2;
+    Eigen::Vector3d PCA1;
+    Eigen::Vector3d PCA2;
+    double pair_dca = 0;
+  };
+
   int GetNodes(PHCompositeNode* topNode);
   int CreateOutputNode(PHCompositeNode* topNode);
 
@@ -90,6 +122,8 @@ class SecondaryVertexFinder : public SubsysReco
                                   const Eigen::Vector3d& PCA, const Eigen::Vector3d& VTX);
 
   bool hasSiliconSeed(SvtxTrack* tr);
+  bool makeTrackCandidate(SvtxTrack* tr, TrackCandidate& candidate);
+  void findPairVertices(const TrackCandidate& candidate1, const TrackCandidate& candidate2, std::vector<PairVertex>& vertices);
   void outputTrackDetails(SvtxTrack* tr);
   void get_dca(SvtxTrack* track, float& dca3dxy, float& dca3dz, float& dca3dxysigma, float& dca3dzsigma);
   bool circle_circle_intersection(double r0, double x0, double y0, double r1, double x1, double y1, std::vector<double>& intersectionXY);
@@ -126,6 +160,7 @@ class SecondaryVertexFinder : public SubsysReco
   double _two_track_dcacut = 0.5;          // 5000 microns
   double _max_intersection_radius = 40.0;  // discard intersections at greater than 40 cm radius
   double _projected_track_z_cut = 1.0;
+  double _intersection_z_cut = 2.0;  // z of the two tracks at the circle intersection
 
   // decay vertex cuts
   double _min_path_cut = 0.2;
@@ -143,6 +178,9 @@ class SecondaryVertexFinder : public SubsysReco
   TH1D* hdecay_radius{nullptr};
   TNtuple* ntp{nullptr};
   std::string outfile;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif  // SECONDARYVERTEXFINDER_H
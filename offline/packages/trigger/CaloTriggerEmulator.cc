@@ -41,9 +41,11 @@
 #include <TH1I.h>
 #include <TNtuple.h>
 
+#include <array>
 #include <bitset>
 #include <cassert>
 #include <cstdint>
+#include <future>
 #include <sstream>
 #include <string>
 
@@ -531,8 +533,88 @@ int CaloTriggerEmulator::Download_Calibrations()
       }
     }
   }
+
+  m_lut_tables.clear();
+  if (m_do_emcal)
+  {
+    BuildLUTTables(TriggerDefs::DetectorId::emcalDId, TriggerDefs::GetDetectorId("EMCAL"), h_emcal_lut, m_default_lut_emcal, m_lut_index_emcal);
+  }
+  if (m_do_hcalin)
+  {
+    BuildLUTTables(TriggerDefs::DetectorId::hcalinDId, TriggerDefs::GetDetectorId("HCAL"), h_hcalin_lut, m_default_lut_hcalin, m_lut_index_hcalin);
+  }
+  if (m_do_hcalout)
+  {
+    BuildLUTTables(TriggerDefs::DetectorId::hcaloutDId, TriggerDefs::GetDetectorId("HCAL"), h_hcalout_lut, m_default_lut_hcalout, m_lut_index_hcalout);
+  }
   return 0;
 }
+
+// compress the LUT histograms into 8 bit tables, indexed by primitive, sum and tower.
+// Towers with identical LUTs share one table, table 0 is the default identity table.
+void CaloTriggerEmulator::BuildLUTTables(TriggerDefs::DetectorId primid, TriggerDefs::DetectorId towerid, const std::map<unsigned int, TH1I *> &luts, bool use_default, std::vector<unsigned int> &lut_index)
+{
+  if (m_lut_tables.empty())
+  {
+    std::array<uint8_t, 1024> identity{};
+    for (unsigned int i = 0; i < 1024; i++)
+    {
+      identity[i] = (m_l1_adc_table[i] >> 2U) & 0xffU;
+    }
+    m_lut_tables.push_back(identity);
+  }
+
+  int nprimitives = m_prim_map[primid];
+  lut_index.assign(nprimitives * m_n_sums * 4, 0);
+  if (use_default)
+  {
+    return;
+  }
+
+  std::map<std::array<uint8_t, 1024>, unsigned int> unique_tables;
+  for (unsigned int it = 0; it < m_lut_tables.size(); it++)
+  {
+    unique_tables.emplace(m_lut_tables[it], it);
+  }
+
+  int nmissing = 0;
+  std::array<uint8_t, 1024> table{};
+  for (int ip = 0; ip < nprimitives; ip++)
+  {
+    for (int isum = 0; isum < m_n_sums; isum++)
+    {
+      for (int j = 0; j < 4; j++)
+      {
+        unsigned int key = TriggerDefs::GetTowerInfoKey(towerid, ip, isum, j);
+        auto iter = luts.find(key);
+        if (iter == luts.end() || !iter->second)
+        {
+          nmissing++;
+          continue;
+        }
+        for (int i = 0; i < 1024; i++)
+        {
+          unsigned int lut_output = ((unsigned int) iter->second->GetBinContent(i + 1)) & 0x3ffU;
+          table[i] = (lut_output >> 2U);
+        }
+        auto [unique, inserted] = unique_tables.emplace(table, m_lut_tables.size());
+        if (inserted)
+        {
+          m_lut_tables.push_back(table);
+        }
+        lut_index[(ip * m_n_sums + isum) * 4 + j] = unique->second;
+      }
+    }
+  }
+  if (nmissing > 0)
+  {
+    std::cout << PHWHERE << " " << nmissing << " towers without LUT histogram, using the identity table for them" << std::endl;
+  }
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: " << m_lut_tables.size() << " distinct LUTs" << std::endl;
+  }
+}
 // process event procedure
 int CaloTriggerEmulator::process_event(PHCompositeNode *topNode)
 {
@@ -1237,9 +1319,6 @@ int CaloTriggerEmulator::process_sim()
 // procedure to process the peak - pedestal into primitives.
 int CaloTriggerEmulator::process_primitives()
 {
-  int ip;
-  int i;
-  bool mask;
   int nsample = m_nsamples - 1;
   if (m_trig_sample > 0)
   {
@@ -1251,196 +1330,224 @@ int CaloTriggerEmulator::process_primitives()
     std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives" << std::endl;
   }
 
+  // the detectors fill their own primitive containers, so they can be processed concurrently
+  if (m_parallel_detectors)
+  {
+    std::vector<std::future<void>> jobs;
+    if (m_do_emcal)
+    {
+      jobs.push_back(std::async(std::launch::async, &CaloTriggerEmulator::process_primitives_emcal, this, nsample));
+    }
+    if (m_do_hcalout)
+    {
+      jobs.push_back(std::async(std::launch::async, &CaloTriggerEmulator::process_primitives_hcalout, this, nsample));
+    }
+    if (m_do_hcalin)
+    {
+      jobs.push_back(std::async(std::launch::async, &CaloTriggerEmulator::process_primitives_hcalin, this, nsample));
+    }
+    for (auto &job : jobs)
+    {
+      job.get();
+    }
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+
   if (m_do_emcal)
+  {
+    process_primitives_emcal(nsample);
+  }
+  if (m_do_hcalout)
+  {
+    process_primitives_hcalout(nsample);
+  }
+  if (m_do_hcalin)
+  {
+    process_primitives_hcalin(nsample);
+  }
+
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+// peak - pedestal samples and 8 bit LUT of the four towers of a sum
+void CaloTriggerEmulator::get_sum_inputs(std::map<unsigned int, std::vector<unsigned int> > &peak_sub_ped, const std::vector<unsigned int> &lut_index, TriggerDefs::DetectorId detid, int ip, int isum, const std::vector<unsigned int> *peaks[4], const uint8_t *luts[4])
+{
+  for (int j = 0; j < 4; j++)
+  {
+    unsigned int key = TriggerDefs::GetTowerInfoKey(detid, ip, isum, j);
+    peaks[j] = &peak_sub_ped[key];
+    luts[j] = m_lut_tables[lut_index[(ip * m_n_sums + isum) * 4 + j]].data();
+  }
+}
+
+void CaloTriggerEmulator::process_primitives_emcal(int nsample)
+{
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: emcal" << std::endl;
+  }
+
+  // get the number of primitives needed to process
+  int nprimitives = m_prim_map.at(TriggerDefs::DetectorId::emcalDId);
+  for (int ip = 0; ip < nprimitives; ip++)
   {
     if (Verbosity())
     {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: emcal" << std::endl;
+      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding " << ip << std::endl;
     }
+    // get the primitive key of what we are making, in order of the packet ID and channel number
+    TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip);
 
-    ip = 0;
+    TriggerPrimitive *primitive = m_primitives_emcal->get_primitive_at_key(primkey);
+    // check if masked Fiber;
+    bool mask = CheckFiberMasks(primkey);
 
-    // get the number of primitives needed to process
-    m_n_primitives = m_prim_map[TriggerDefs::DetectorId::emcalDId];
-    for (i = 0; i < m_n_primitives; i++, ip++)
+    // calculate 16 sums
+    for (int isum = 0; isum < m_n_sums; isum++)
     {
-      if (Verbosity())
-      {
-        std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding " << i << std::endl;
-      }
-      unsigned int tmp = 0;
-      // get the primitive key of what we are making, in order of the packet ID and channel number
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip);
+      // get sum key
+      TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip, isum);
 
-      TriggerPrimitive *primitive = m_primitives_emcal->get_primitive_at_key(primkey);
-      unsigned int sum = 0;
-      // check if masked Fiber;
-      mask = CheckFiberMasks(primkey);
+      // calculate sums for all samples, hense the vector.
+      std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
+      t_sum->clear();
 
-      // calculate 16 sums
-      for (int isum = 0; isum < m_n_sums; isum++)
-      {
-        // get sum key
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("EMCAL"), TriggerDefs::GetPrimitiveId("EMCAL"), ip, isum);
+      // check to mask channel (if fiber masked, automatically mask the channel)
+      bool mask_channel = mask || CheckChannelMasks(sumkey);
 
-        // calculate sums for all samples, hense the vector.
-        std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
-        t_sum->clear();
+      // the towers are looked up once for all samples
+      const std::vector<unsigned int> *peaks[4] = {nullptr};
+      const uint8_t *luts[4] = {nullptr};
+      if (!mask_channel)
+      {
+        get_sum_inputs(m_peak_sub_ped_emcal, m_lut_index_emcal, TriggerDefs::GetDetectorId("EMCAL"), ip, isum, peaks, luts);
+      }
+      for (int is = 0; is < nsample; is++)
+      {
+        unsigned int sum = 0;
 
-        // check to mask channel (if fiber masked, automatically mask the channel)
-        bool mask_channel = mask || CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        // if masked, just fill with 0s
+        if (!mask_channel)
         {
-          sum = 0;
           unsigned int temp_sum = 0;
-
-          // if masked, just fill with 0s
-          if (!mask_channel)
+          for (int j = 0; j < 4; j++)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              // unsigned int iwave = 64*ip + isum*4 + j;
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("EMCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_emcal[key].at(is) >> 4U) & 0x3ffU;
-              if (m_default_lut_emcal)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_emcal_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0xffU);
-            }
-            sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
-            if (Verbosity() >= 10 && sum >= 1)
-            {
-              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: emcal sum " << sumkey << " = " << sum << std::endl;
-            }
+            unsigned int lut_input = (peaks[j]->at(is) >> 4U) & 0x3ffU;
+            temp_sum += luts[j][lut_input];
           }
-          if (Verbosity())
+          sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
+          if (Verbosity() >= 10 && sum >= 1)
           {
-            std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding" << std::endl;
+            std::cout << __FILE__ << "::" << __FUNCTION__ << ":: emcal sum " << sumkey << " = " << sum << std::endl;
           }
-
-          t_sum->push_back(sum);
         }
+        if (Verbosity())
+        {
+          std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: adding" << std::endl;
+        }
+
+        t_sum->push_back(sum);
       }
     }
   }
-  if (m_do_hcalout)
-  {
-    if (Verbosity())
-    {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ohcal" << std::endl;
-    }
+}
 
-    ip = 0;
+void CaloTriggerEmulator::process_primitives_hcalout(int nsample)
+{
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ohcal" << std::endl;
+  }
 
-    m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcaloutDId];
+  int nprimitives = m_prim_map.at(TriggerDefs::DetectorId::hcaloutDId);
 
-    for (i = 0; i < m_n_primitives; i++, ip++)
+  for (int ip = 0; ip < nprimitives; ip++)
+  {
+    TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip);
+    TriggerPrimitive *primitive = m_primitives_hcalout->get_primitive_at_key(primkey);
+    bool mask = CheckFiberMasks(primkey);
+    for (int isum = 0; isum < m_n_sums; isum++)
     {
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip);
-      TriggerPrimitive *primitive = m_primitives_hcalout->get_primitive_at_key(primkey);
-      unsigned int sum;
-      mask = CheckFiberMasks(primkey);
-      for (int isum = 0; isum < m_n_sums; isum++)
+      TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip, isum);
+      std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
+      mask |= CheckChannelMasks(sumkey);
+
+      const std::vector<unsigned int> *peaks[4] = {nullptr};
+      const uint8_t *luts[4] = {nullptr};
+      if (!mask)
       {
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALOUT"), TriggerDefs::GetPrimitiveId("HCALOUT"), ip, isum);
-        std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
-        mask |= CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        get_sum_inputs(m_peak_sub_ped_hcalout, m_lut_index_hcalout, TriggerDefs::GetDetectorId("HCAL"), ip, isum, peaks, luts);
+      }
+      for (int is = 0; is < nsample; is++)
+      {
+        unsigned int sum = 0;
+        if (!mask)
         {
-          sum = 0;
           unsigned int temp_sum = 0;
-          if (!mask)
+          for (int j = 0; j < 4; j++)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalout[key].at(is) >> 4U) & 0x3ffU;
-              unsigned int tmp = 0;
-              if (m_default_lut_hcalout)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_hcalout_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0xffU);
-            }
-            sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
-            if (Verbosity() >= 10 && sum >= 1)
-            {
-              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalout sum " << sumkey << " = " << sum << std::endl;
-            }
+            unsigned int lut_input = (peaks[j]->at(is) >> 4U) & 0x3ffU;
+            temp_sum += luts[j][lut_input];
+          }
+          sum = ((temp_sum & 0x3ffU) >> 2U) & 0xffU;
+          if (Verbosity() >= 10 && sum >= 1)
+          {
+            std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalout sum " << sumkey << " = " << sum << std::endl;
           }
-          t_sum->push_back(sum);
         }
+        t_sum->push_back(sum);
       }
     }
   }
-  if (m_do_hcalin)
-  {
-    ip = 0;
+}
 
-    if (Verbosity())
-    {
-      std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ihcal" << std::endl;
-    }
+void CaloTriggerEmulator::process_primitives_hcalin(int nsample)
+{
+  if (Verbosity())
+  {
+    std::cout << __FILE__ << "::" << __FUNCTION__ << ":: Processing primitives:: ihcal" << std::endl;
+  }
 
-    m_n_primitives = m_prim_map[TriggerDefs::DetectorId::hcalinDId];
+  int nprimitives = m_prim_map.at(TriggerDefs::DetectorId::hcalinDId);
 
-    for (i = 0; i < m_n_primitives; i++, ip++)
+  for (int ip = 0; ip < nprimitives; ip++)
+  {
+    TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip);
+    TriggerPrimitive *primitive = m_primitives_hcalin->get_primitive_at_key(primkey);
+    bool mask = CheckFiberMasks(primkey);
+    for (int isum = 0; isum < m_n_sums; isum++)
     {
-      TriggerDefs::TriggerPrimKey primkey = TriggerDefs::getTriggerPrimKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip);
-      TriggerPrimitive *primitive = m_primitives_hcalin->get_primitive_at_key(primkey);
-      unsigned int sum;
-      mask = CheckFiberMasks(primkey);
-      for (int isum = 0; isum < m_n_sums; isum++)
+      TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip, isum);
+      std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
+      mask |= CheckChannelMasks(sumkey);
+
+      const std::vector<unsigned int> *peaks[4] = {nullptr};
+      const uint8_t *luts[4] = {nullptr};
+      if (!mask)
       {
-        TriggerDefs::TriggerSumKey sumkey = TriggerDefs::getTriggerSumKey(TriggerDefs::GetTriggerId("NONE"), TriggerDefs::GetDetectorId("HCALIN"), TriggerDefs::GetPrimitiveId("HCALIN"), ip, isum);
-        std::vector<unsigned int> *t_sum = primitive->get_sum_at_key(sumkey);
-        mask |= CheckChannelMasks(sumkey);
-        for (int is = 0; is < nsample; is++)
+        get_sum_inputs(m_peak_sub_ped_hcalin, m_lut_index_hcalin, TriggerDefs::GetDetectorId("HCAL"), ip, isum, peaks, luts);
+      }
+      for (int is = 0; is < nsample; is++)
+      {
+        unsigned int sum = 0;
+        if (!mask)
         {
-          sum = 0;
           unsigned int temp_sum = 0;
-          if (!mask)
+          for (int j = 0; j < 4; j++)
           {
-            for (int j = 0; j < 4; j++)
-            {
-              unsigned int key = TriggerDefs::GetTowerInfoKey(TriggerDefs::GetDetectorId("HCAL"), ip, isum, j);
-              unsigned int lut_input = (m_peak_sub_ped_hcalin[key].at(is) >> 4U) & 0x3ffU;
-              unsigned int tmp = 0;
-              if (m_default_lut_hcalin)
-              {
-                tmp = (m_l1_adc_table[lut_input] >> 2U);
-              }
-              else
-              {
-                unsigned int lut_output = ((unsigned int) h_hcalin_lut[key]->GetBinContent(lut_input + 1)) & 0x3ffU;
-                tmp = (lut_output >> 2U);
-              }
-              temp_sum += (tmp & 0x3ffU);
-            }
-            sum = ((temp_sum & 0xfffU) >> 2U) & 0xffU;
-            if (Verbosity() >= 10 && sum >= 1)
-            {
-              std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalin sum " << sumkey << " = " << sum << std::endl;
-            }
+            unsigned int lut_input = (peaks[j]->at(is) >> 4U) & 0x3ffU;
+            temp_sum += luts[j][lut_input];
+          }
+          sum = ((temp_sum & 0xfffU) >> 2U) & 0xffU;
+          if (Verbosity() >= 10 && sum >= 1)
+          {
+            std::cout << __FILE__ << "::" << __FUNCTION__ << ":: hcalin sum " << sumkey << " = " << sum << std::endl;
           }
-          t_sum->push_back(sum);
         }
+        t_sum->push_back(sum);
       }
     }
   }
-
-  return Fun4AllReturnCodes::EVENT_OK;
 }
 
 // Unless this is the MBD or HCAL Cosmics trigger, EMCAL and HCAL will go through here.
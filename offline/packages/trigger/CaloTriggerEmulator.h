@@ -6,6 +6,7 @@
 
 #include <fun4all/SubsysReco.h>
 
+#include <array>
 #include <cstdint>
 #include <map>
 #include <vector>
@@ -66,6 +67,10 @@ class CaloTriggerEmulator : public SubsysReco
 
   //! MakeTriggerOutput
   int process_primitives();
+  void process_primitives_emcal(int nsample);
+  void process_primitives_hcalout(int nsample);
+  void process_primitives_hcalin(int nsample);
+  void get_sum_inputs(std::map<unsigned int, std::vector<unsigned int> > &peak_sub_ped, const std::vector<unsigned int> &lut_index, TriggerDefs::DetectorId detid, int ip, int isum, const std::vector<unsigned int> *peaks[4], const uint8_t *luts[4]);
 
   int process_organizer();
 
@@ -91,6 +96,9 @@ class CaloTriggerEmulator : public SubsysReco
   void useHCALINDefaultLUT(bool def) { m_default_lut_hcalin = def; }
   void useHCALOUTDefaultLUT(bool def) { m_default_lut_hcalout = def; }
 
+  //! process the primitives of EMCal, IHCal and OHCal concurrently, off by default
+  void setParallelDetectors(bool b) { m_parallel_detectors = b; }
+
   void setTriggerSample(int s) { m_trig_sample = s; }
   void setTriggerDelay(int d) { m_trig_sub_delay = d + 1; }
 
@@ -132,6 +140,8 @@ class CaloTriggerEmulator : public SubsysReco
   void SetIsData(bool isd) { m_isdata = isd; }
   bool CheckChannelMasks(TriggerDefs::TriggerSumKey key);
 
+  void BuildLUTTables(TriggerDefs::DetectorId primid, TriggerDefs::DetectorId towerid, const std::map<unsigned int, TH1I *> &luts, bool use_default, std::vector<unsigned int> &lut_index);
+
   void identify();
 
  private:
@@ -154,6 +164,7 @@ class CaloTriggerEmulator : public SubsysReco
   bool m_do_hcalin{false};
   bool m_do_hcalout{false};
   bool m_do_emcal{false};
+  bool m_parallel_detectors{false};
 
 
   bool m_default_lut_hcalin{false};
@@ -211,6 +222,12 @@ class CaloTriggerEmulator : public SubsysReco
   std::map<unsigned int, TH1I*> h_hcalin_lut{};
   std::map<unsigned int, TH1I*> h_hcalout_lut{};
 
+  //! distinct 8 bit LUTs and the table of each tower, indexed by (primitive * sums + sum) * 4 + tower
+  std::vector<std::array<uint8_t, 1024> > m_lut_tables{};
+  std::vector<unsigned int> m_lut_index_emcal{};
+  std::vector<unsigned int> m_lut_index_hcalin{};
+  std::vector<unsigned int> m_lut_index_hcalout{};
+
   CDBTTree *cdbttree_adcmask{nullptr};
   CDBHistos *cdbttree_emcal{nullptr};
   CDBHistos *cdbttree_hcalin{nullptr};
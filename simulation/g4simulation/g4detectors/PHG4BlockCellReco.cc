@@ -36,6 +36,8 @@
 using namespace std;
 
 static vector<PHG4Cell *> cellptarray;
+// bins of cellptarray with a cell, only those are visited when the cells are stored
+static vector<unsigned int> touchedcells;
 
 PHG4BlockCellReco::PHG4BlockCellReco(const string &name)
   : SubsysReco(name)
@@ -445,6 +447,7 @@ int PHG4BlockCellReco::process_event(PHCompositeNode *topNode)
           {
             PHG4CellDefs::keytype key = PHG4CellDefs::EtaXsizeBinning::genkey(*layer, ixbin, ietabin);
             cellptarray[ibin] = new PHG4Cellv1(key);
+            touchedcells.push_back(ibin);
           }
           cellptarray[ibin]->add_edep(hiter->first, hiter->second->get_edep() * vdedx[i1]);
           cellptarray[ibin]->add_edep(hiter->second->get_edep() * vdedx[i1]);
@@ -467,30 +470,25 @@ int PHG4BlockCellReco::process_event(PHCompositeNode *topNode)
       }  // end loop over g4hits
 
       int numcells = 0;
-      for (int ix = 0; ix < nxbins; ix++)
+      for (const unsigned int ibin : touchedcells)
       {
-        for (int iz = 0; iz < nzbins; iz++)
+        cells->AddCell(cellptarray[ibin]);
+        numcells++;
+        if (Verbosity() > 1)
         {
-          int ibin = ix * nzbins + iz;
-
-          if (cellptarray[ibin])
-          {
-            cells->AddCell(cellptarray[ibin]);
-            numcells++;
-            if (Verbosity() > 1)
-            {
-              cout << "Adding cell in bin x: " << ix
-                   << " x: " << geo->get_xcenter(ix) * 180. / M_PI
-                   << ", eta bin: " << iz
-                   << ", eta: " << geo->get_etacenter(iz)
-                   << ", energy dep: " << cellptarray[ibin]->get_edep()
-                   << endl;
-            }
-
-            cellptarray[ibin] = nullptr;
-          }
+          const int ix = ibin / nzbins;
+          const int iz = ibin % nzbins;
+          cout << "Adding cell in bin x: " << ix
+               << " x: " << geo->get_xcenter(ix) * 180. / M_PI
+               << ", eta bin: " << iz
+               << ", eta: " << geo->get_etacenter(iz)
+               << ", energy dep: " << cellptarray[ibin]->get_edep()
+               << endl;
         }
+
+        cellptarray[ibin] = nullptr;
       }
+      touchedcells.clear();
 
       if (Verbosity() > 0)
       {
@@ -401,6 +401,13 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
     PHG4CylinderCellGeom *geo = seggeo->GetLayerCellGeom(*layer);
     int nphibins = n_phi_z_bins[*layer].first;
     int nzbins = n_phi_z_bins[*layer].second;
+    // the array is kept between layers and events, it only grows
+    const size_t ncells = static_cast<size_t>(nphibins) * nzbins;
+    if (m_CellArray.size() < ncells)
+    {
+      m_CellArray.resize(ncells, nullptr);
+    }
+    m_TouchedCells.clear();
 
     // ------- eta/phi binning ------------------------------------------------------------------------
     if (binning[*layer] == PHG4CellDefs::etaphibinning)
@@ -553,27 +560,20 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
           int iphibin = vphi[i1];
           int ietabin = veta[i1];
 
-          // This is the key for cellptmap
+          // index in the dense cell array
           // It is constructed using the phi and z (or eta) bin index values
           // It will be unique for a given phi and z (or eta) bin combination
-          unsigned long long tmp = iphibin;
-          unsigned long long key = tmp << 32U;  // clang-tidy: U for unsigned int
-          key += ietabin;
+          const unsigned int ibin = iphibin * nzbins + ietabin;
           if (Verbosity() > 1)
           {
-            std::cout << " iphibin " << iphibin << " ietabin " << ietabin << " key 0x" << std::hex << key << std::dec << std::endl;
-          }
-          PHG4Cell *cell = nullptr;
-          it = cellptmap.find(key);
-          if (it != cellptmap.end())
-          {
-            cell = it->second;
+            std::cout << " iphibin " << iphibin << " ietabin " << ietabin << " bin " << ibin << std::endl;
           }
-          else
+          PHG4Cell *&cell = m_CellArray[ibin];
+          if (!cell)
           {
             PHG4CellDefs::keytype cellkey = PHG4CellDefs::EtaPhiBinning::genkey(*layer, ietabin, iphibin);
             cell = new PHG4Cellv1(cellkey);
-            cellptmap[key] = cell;
+            m_TouchedCells.push_back(ibin);
           }
           if (!std::isfinite(hiter->second->get_edep() * vdedx[i1]))
           {
@@ -601,17 +601,18 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
       int numcells = 0;
 
-      for (it = cellptmap.begin(); it != cellptmap.end(); ++it)
+      for (const unsigned int ibin : m_TouchedCells)
       {
-        cells->AddCell(it->second);
+        PHG4Cell *cell = m_CellArray[ibin];
+        cells->AddCell(cell);
         numcells++;
         if (Verbosity() > 1)
         {
-          std::cout << "Adding cell in bin phi: " << PHG4CellDefs::EtaPhiBinning::get_phibin(it->second->get_cellid())
-                    << " phi: " << geo->get_phicenter(PHG4CellDefs::EtaPhiBinning::get_phibin(it->second->get_cellid())) * 180. / M_PI
-                    << ", eta bin: " << PHG4CellDefs::EtaPhiBinning::get_etabin(it->second->get_cellid())
-                    << ", eta: " << geo->get_etacenter(PHG4CellDefs::EtaPhiBinning::get_etabin(it->second->get_cellid()))
-                    << ", energy dep: " << it->second->get_edep()
+          std::cout << "Adding cell in bin phi: " << PHG4CellDefs::EtaPhiBinning::get_phibin(cell->get_cellid())
+                    << " phi: " << geo->get_phicenter(PHG4CellDefs::EtaPhiBinning::get_phibin(cell->get_cellid())) * 180. / M_PI
+                    << ", eta bin: " << PHG4CellDefs::EtaPhiBinning::get_etabin(cell->get_cellid())
+                    << ", eta: " << geo->get_etacenter(PHG4CellDefs::EtaPhiBinning::get_etabin(cell->get_cellid()))
+                    << ", energy dep: " << cell->get_edep()
                     << std::endl;
         }
       }
@@ -815,23 +816,19 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
           int iphibin = vphi[i1];
           int izbin = vz[i1];
 
-          unsigned long long tmp = iphibin;
-          unsigned long long key = tmp << 32U;  // clang-tidy: U for unsigned int
-          key += izbin;
+          const unsigned int ibin = iphibin * nzbins + izbin;
           if (Verbosity() > 1)
           {
-            std::cout << " iphibin " << iphibin << " izbin " << izbin << " key 0x" << std::hex << key << std::dec << std::endl;
+            std::cout << " iphibin " << iphibin << " izbin " << izbin << " bin " << ibin << std::endl;
           }
           // check to see if there is already an entry for this cell
-          PHG4Cell *cell = nullptr;
-          it = cellptmap.find(key);
+          PHG4Cell *&cell = m_CellArray[ibin];
 
-          if (it != cellptmap.end())
+          if (cell)
           {
-            cell = it->second;
             if (Verbosity() > 1)
             {
-              std::cout << "  add energy to existing cell for key = " << cellptmap.find(key)->first << std::endl;
+              std::cout << "  add energy to existing cell for bin = " << ibin << std::endl;
             }
 
             if (Verbosity() > 1 && hiter->second->has_property(PHG4Hit::prop_light_yield) && std::isnan(hiter->second->get_light_yield() * vdedx[i1]))
@@ -844,11 +841,11 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
           {
             if (Verbosity() > 1)
             {
-              std::cout << "    did not find a previous entry for key = 0x" << std::hex << key << std::dec << " create a new one" << std::endl;
+              std::cout << "    did not find a previous entry for bin = " << ibin << " create a new one" << std::endl;
             }
             PHG4CellDefs::keytype cellkey = PHG4CellDefs::SizeBinning::genkey(*layer, izbin, iphibin);
             cell = new PHG4Cellv1(cellkey);
-            cellptmap[key] = cell;
+            m_TouchedCells.push_back(ibin);
           }
           if (!std::isfinite(hiter->second->get_edep() * vdedx[i1]))
           {
@@ -875,17 +872,18 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
 
       int numcells = 0;
 
-      for (it = cellptmap.begin(); it != cellptmap.end(); ++it)
+      for (const unsigned int ibin : m_TouchedCells)
       {
-        cells->AddCell(it->second);
+        PHG4Cell *cell = m_CellArray[ibin];
+        cells->AddCell(cell);
         numcells++;
         if (Verbosity() > 1)
         {
-          std::cout << "Adding cell for key " << std::hex << it->first << std::dec << " in bin phi: " << PHG4CellDefs::SizeBinning::get_phibin(it->second->get_cellid())
-                    << " phi: " << geo->get_phicenter(PHG4CellDefs::SizeBinning::get_phibin(it->second->get_cellid())) * 180. / M_PI
-                    << ", z bin: " << PHG4CellDefs::SizeBinning::get_zbin(it->second->get_cellid())
-                    << ", z: " << geo->get_zcenter(PHG4CellDefs::SizeBinning::get_zbin(it->second->get_cellid()))
-                    << ", energy dep: " << it->second->get_edep()
+          std::cout << "Adding cell for bin " << ibin << " in bin phi: " << PHG4CellDefs::SizeBinning::get_phibin(cell->get_cellid())
+                    << " phi: " << geo->get_phicenter(PHG4CellDefs::SizeBinning::get_phibin(cell->get_cellid())) * 180. / M_PI
+                    << ", z bin: " << PHG4CellDefs::SizeBinning::get_zbin(cell->get_cellid())
+                    << ", z: " << geo->get_zcenter(PHG4CellDefs::SizeBinning::get_zbin(cell->get_cellid()))
+                    << ", energy dep: " << cell->get_edep()
                     << std::endl;
         }
       }
@@ -897,20 +895,17 @@ int PHG4CylinderCellReco::process_event(PHCompositeNode *topNode)
     }
 
     //==========================================================
-    // now reset the cell map before moving on to the next layer
+    // now reset the touched cells before moving on to the next layer
     if (Verbosity() > 1)
     {
-      std::cout << "cellptmap for layer " << *layer << " has final length " << cellptmap.size();
+      std::cout << "cell array for layer " << *layer << " has " << m_TouchedCells.size() << " touched cells" << std::endl;
     }
-    while (cellptmap.begin() != cellptmap.end())
+    for (const unsigned int ibin : m_TouchedCells)
     {
       // Assumes that memmory is freed by the cylinder cell container when it is destroyed
-      cellptmap.erase(cellptmap.begin());
-    }
-    if (Verbosity() > 1)
-    {
-      std::cout << " reset it to " << cellptmap.size() << std::endl;
+      m_CellArray[ibin] = nullptr;
     }
+    m_TouchedCells.clear();
   }
   if (chkenergyconservation)
   {
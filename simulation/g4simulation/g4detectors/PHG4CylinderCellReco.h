@@ -11,6 +11,7 @@
 #include <set>
 #include <string>
 #include <utility>  // for pair
+#include <vector>
 
 class PHCompositeNode;
 class PHG4Cell;
@@ -60,8 +61,10 @@ class PHG4CylinderCellReco : public SubsysReco, public PHParameterContainerInter
   std::string geonodename;
   std::string seggeonodename;
   std::map<int, std::pair<int, int>> n_phi_z_bins;
-  std::map<unsigned long long, PHG4Cell *> cellptmap;  // This map holds the hit cells
-  std::map<unsigned long long, PHG4Cell *>::iterator it;
+  // dense (phi, z) array of the cells of the current layer and the list of touched bins,
+  // only touched cells are created and handed to the cell container
+  std::vector<PHG4Cell *> m_CellArray;
+  std::vector<unsigned int> m_TouchedCells;
   std::map<int, std::pair<double, double>> tmin_max;
   std::map<int, double> m_DeltaTMap;
 
@@ -47,6 +47,7 @@
 #include <cstdlib>
 #include <exception>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <utility>  // for pair
 
@@ -394,7 +395,7 @@ int PHG4FullProjSpacalCellReco::process_event(PHCompositeNode *topNode)
 
     unsigned int key = static_cast<unsigned int>(scint_id);
     PHG4Cell *cell = nullptr;
-    std::map<unsigned int, PHG4Cell *>::iterator it = celllist.find(key);
+    auto it = celllist.find(key);
     if (it != celllist.end())
     {
       cell = it->second;
@@ -457,9 +458,7 @@ int PHG4FullProjSpacalCellReco::process_event(PHCompositeNode *topNode)
 
   }  // end loop over g4hits
   int numcells = 0;
-  for (std::map<unsigned int, PHG4Cell *>::const_iterator mapiter =
-           celllist.begin();
-       mapiter != celllist.end(); ++mapiter)
+  for (auto mapiter = celllist.begin(); mapiter != celllist.end(); ++mapiter)
   {
     cells->AddCell(mapiter->second);
     numcells++;
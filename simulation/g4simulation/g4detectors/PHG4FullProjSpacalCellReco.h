@@ -10,8 +10,8 @@
 #include <fun4all/SubsysReco.h>
 
 #include <cmath>
-#include <map>
 #include <string>
+#include <unordered_map>
 
 class LightCollectionModel;
 class PHCompositeNode;
@@ -56,7 +56,8 @@ class PHG4FullProjSpacalCellReco : public SubsysReco, public PHParameterInterfac
 
   double sum_energy_g4hit = 0;
   int chkenergyconservation = 0;
-  std::map<unsigned int, PHG4Cell *> celllist;
+  // cells by scint id, hashed since the ids are sparse, the buckets are kept from event to event
+  std::unordered_map<unsigned int, PHG4Cell *> celllist;
 
   //! timing window size in ns. This is for a simple simulation of the ADC integration window starting from 0ns to this value. Default to infinity, i.e. include all hits
   double tmin = NAN;
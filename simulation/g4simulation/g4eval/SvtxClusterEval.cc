@@ -23,6 +23,7 @@
 
 #include <TVector3.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cfloat>
 #include <cmath>
@@ -49,21 +50,28 @@ SvtxClusterEval::~SvtxClusterEval()
 
 void SvtxClusterEval::next_event(PHCompositeNode* topNode)
 {
-  _cache_all_truth_hits.clear();
   _cache_all_truth_clusters.clear();
   _cache_max_truth_hit_by_energy.clear();
   _cache_max_truth_cluster_by_energy.clear();
-  _cache_all_truth_particles.clear();
   _cache_max_truth_particle_by_energy.clear();
   _cache_max_truth_particle_by_cluster_energy.clear();
-  _cache_all_clusters_from_particle.clear();
-  _cache_all_clusters_from_g4hit.clear();
   _cache_best_cluster_from_g4hit.clear();
   _cache_get_energy_contribution_g4particle.clear();
   _cache_get_energy_contribution_g4hit.clear();
   _cache_best_cluster_from_gtrackid_layer.clear();
   _clusters_per_layer.clear();
   //  _g4hits_per_layer.clear();
+
+  // keep the allocated memory of the truth table for the next event
+  _truth_table_filled = false;
+  _table_clusters.clear();
+  _table_hit_offset.clear();
+  _table_hits.clear();
+  _table_particle_offset.clear();
+  _table_particles.clear();
+  _table_clusters_from_g4hit.clear();
+  _table_clusters_from_particle.clear();
+
   _hiteval.next_event(topNode);
 
   get_node_pointers(topNode);
@@ -345,14 +353,20 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>>::iterator iter =
-        _cache_all_truth_hits.find(cluster_key);
-    if (iter != _cache_all_truth_hits.end())
+    fill_truth_table();
+    const int row = find_truth_table_row(cluster_key);
+    if (row < 0)
     {
-      return iter->second;
+      return std::set<PHG4Hit*>();
     }
+    return std::set<PHG4Hit*>(_table_hits.begin() + _table_hit_offset[row], _table_hits.begin() + _table_hit_offset[row + 1]);
   }
 
+  return find_truth_hits(cluster_key);
+}
+
+std::set<PHG4Hit*> SvtxClusterEval::find_truth_hits(TrkrDefs::cluskey cluster_key)
+{
   std::set<PHG4Hit*> truth_hits;
 
   // get all truth hits for this cluster
@@ -403,11 +417,6 @@ std::set<PHG4Hit*> SvtxClusterEval::all_truth_hits(TrkrDefs::cluskey cluster_key
     }  // end loop over g4hits associated with hitsetkey and hitkey
   }    // end loop over hits associated with cluskey
 
-  if (_do_cache)
-  {
-    _cache_all_truth_hits.insert(std::make_pair(cluster_key, truth_hits));
-  }
-
   return truth_hits;
 }
 
@@ -787,17 +796,21 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
 
   if (_do_cache)
   {
-    std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>>::iterator iter =
-        _cache_all_truth_particles.find(cluster_key);
-    if (iter != _cache_all_truth_particles.end())
+    fill_truth_table();
+    const int row = find_truth_table_row(cluster_key);
+    if (row < 0)
     {
-      return iter->second;
+      return std::set<PHG4Particle*>();
     }
+    return std::set<PHG4Particle*>(_table_particles.begin() + _table_particle_offset[row], _table_particles.begin() + _table_particle_offset[row + 1]);
   }
 
-  std::set<PHG4Particle*> truth_particles;
+  return find_truth_particles(find_truth_hits(cluster_key));
+}
 
-  std::set<PHG4Hit*> g4hits = all_truth_hits(cluster_key);
+std::set<PHG4Particle*> SvtxClusterEval::find_truth_particles(const std::set<PHG4Hit*>& g4hits)
+{
+  std::set<PHG4Particle*> truth_particles;
 
   for (auto hit : g4hits)
   {
@@ -817,11 +830,6 @@ std::set<PHG4Particle*> SvtxClusterEval::all_truth_particles(TrkrDefs::cluskey c
     truth_particles.insert(particle);
   }
 
-  if (_do_cache)
-  {
-    _cache_all_truth_particles.insert(std::make_pair(cluster_key, truth_particles));
-  }
-
   return truth_particles;
 }
 
@@ -936,68 +944,87 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Particle* tru
     ++_errors;
     return std::set<TrkrDefs::cluskey>();
   }
-  // check if cache is filled, if not fill it.
-  //   if(_cache_all_clusters_from_particle.count(truthparticle)==0){
-  if (_cache_all_clusters_from_particle.empty())
-  {
-    FillRecoClusterFromG4HitCache();
-  }
 
-  if (_do_cache)
+  fill_truth_table();
+
+  std::set<TrkrDefs::cluskey> clusters;
+  auto range = std::equal_range(_table_clusters_from_particle.begin(), _table_clusters_from_particle.end(),
+                                std::make_pair(truthparticle, TrkrDefs::cluskey(0)),
+                                [](const auto& lhs, const auto& rhs)
+                                { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>>::iterator iter =
-        _cache_all_clusters_from_particle.find(truthparticle);
-    if (iter != _cache_all_clusters_from_particle.end())
-    {
-      return iter->second;
-    }
+    clusters.insert(clusters.end(), iter->second);
   }
-  std::set<TrkrDefs::cluskey> clusters;
   return clusters;
 }
 
-void SvtxClusterEval::FillRecoClusterFromG4HitCache()
+void SvtxClusterEval::fill_truth_table()
 {
+  if (_truth_table_filled)
+  {
+    return;
+  }
+  _truth_table_filled = true;
+
   auto Mytimer = std::make_unique<PHTimer>("ReCl_timer");
   Mytimer->stop();
   Mytimer->restart();
 
-  std::multimap<PHG4Particle*, TrkrDefs::cluskey> temp_clusters_from_particles;
-  // loop over all the clusters
+  // rows are sorted by cluster key so a row is found by binary search
   for (const auto& hitsetkey : _clustermap->getHitSetKeys())
   {
     auto range = _clustermap->getClusters(hitsetkey);
     for (auto iter = range.first; iter != range.second; ++iter)
     {
-      TrkrDefs::cluskey cluster_key = iter->first;
-
-      // loop over all truth particles connected to this cluster
-      std::set<PHG4Particle*> particles = all_truth_particles(cluster_key);
-      for (auto candidate : particles)
-      {
-        temp_clusters_from_particles.insert(std::make_pair(candidate, cluster_key));
-      }
+      _table_clusters.push_back(iter->first);
     }
   }
-  // Loop over particles and fill cache
-  PHG4TruthInfoContainer::ConstRange range = _truthinfo->GetParticleRange();
-  for (PHG4TruthInfoContainer::ConstIterator iter = range.first;
-       iter != range.second; ++iter)
-  {
-    PHG4Particle* g4particle = iter->second;
-    std::set<TrkrDefs::cluskey> clusters;
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator lower_bound = temp_clusters_from_particles.lower_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator upper_bound = temp_clusters_from_particles.upper_bound(g4particle);
-    std::multimap<PHG4Particle*, TrkrDefs::cluskey>::const_iterator cfp_iter;
-    for (cfp_iter = lower_bound; cfp_iter != upper_bound; ++cfp_iter)
+  std::sort(_table_clusters.begin(), _table_clusters.end());
+
+  _table_hit_offset.reserve(_table_clusters.size() + 1);
+  _table_particle_offset.reserve(_table_clusters.size() + 1);
+  _table_hit_offset.push_back(0);
+  _table_particle_offset.push_back(0);
+  for (const auto& cluster_key : _table_clusters)
+  {
+    // the truth hits were obtained from TrkrAssoc maps
+    const std::set<PHG4Hit*> hits = find_truth_hits(cluster_key);
+    for (auto hit : hits)
+    {
+      _table_hits.push_back(hit);
+      _table_clusters_from_g4hit.emplace_back(hit, cluster_key);
+    }
+    _table_hit_offset.push_back(_table_hits.size());
+
+    for (auto particle : find_truth_particles(hits))
     {
-      TrkrDefs::cluskey cluster_key = cfp_iter->second;
-      clusters.insert(cluster_key);
+      _table_particles.push_back(particle);
+      _table_clusters_from_particle.emplace_back(particle, cluster_key);
     }
-    _cache_all_clusters_from_particle.insert(std::make_pair(g4particle, clusters));
+    _table_particle_offset.push_back(_table_particles.size());
   }
 
+  std::sort(_table_clusters_from_g4hit.begin(), _table_clusters_from_g4hit.end());
+  std::sort(_table_clusters_from_particle.begin(), _table_clusters_from_particle.end());
+
   Mytimer->stop();
+  if (_verbosity > 1)
+  {
+    std::cout << "SvtxClusterEval::fill_truth_table - " << _table_clusters.size() << " clusters, "
+              << _table_hits.size() << " truth hits, " << _table_particles.size() << " truth particles, "
+              << Mytimer->get_accumulated_time() << " ms" << std::endl;
+  }
+}
+
+int SvtxClusterEval::find_truth_table_row(TrkrDefs::cluskey cluster_key) const
+{
+  auto iter = std::lower_bound(_table_clusters.begin(), _table_clusters.end(), cluster_key);
+  if (iter == _table_clusters.end() || *iter != cluster_key)
+  {
+    return -1;
+  }
+  return std::distance(_table_clusters.begin(), iter);
 }
 
 std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit)
@@ -1018,110 +1045,23 @@ std::set<TrkrDefs::cluskey> SvtxClusterEval::all_clusters_from(PHG4Hit* truthhit
     return std::set<TrkrDefs::cluskey>();
   }
 
-  // one time, fill cache of g4hit/cluster pairs
-  if (_cache_all_clusters_from_g4hit.size() == 0)
-  {
-    // make a map of truthhit, cluster_key inside this loop
-    std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey> truth_cluster_map;
-    std::set<PHG4HitDefs::keytype> all_g4hits_set;
-    std::map<PHG4HitDefs::keytype, PHG4Hit*> all_g4hits_map;
-
-    // get all reco clusters
-    if (_verbosity > 1)
-    {
-      std::cout << "all_clusters_from_g4hit: list all reco clusters " << std::endl;
-    }
-
-    for (const auto& hitsetkey : _clustermap->getHitSetKeys())
-    {
-      auto range = _clustermap->getClusters(hitsetkey);
-      for (auto iter = range.first; iter != range.second; ++iter)
-      {
-        TrkrDefs::cluskey cluster_key = iter->first;
-        int layer = TrkrDefs::getLayer(cluster_key);
-        TrkrCluster* clus = iter->second;
-        if (_verbosity > 1)
-        {
-          std::cout << " layer " << layer << " cluster_key " << cluster_key << " adc " << clus->getAdc()
-                    << " localx " << clus->getLocalX()
-                    << " localy " << clus->getLocalY()
-                    << std::endl;
-          std::cout << "  associated hits:";
-          std::pair<std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator, std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator>
-              hitrange = _cluster_hit_map->getHits(cluster_key);  // returns range of pairs {cluster key, hit key} for this cluskey
-          for (std::multimap<TrkrDefs::cluskey, TrkrDefs::hitkey>::const_iterator
-                   clushititer = hitrange.first;
-               clushititer != hitrange.second; ++clushititer)
-          {
-            TrkrDefs::hitkey hitkey = clushititer->second;
-            std::cout << " " << hitkey;
-          }
-          std::cout << std::endl;
-        }
-
-        // the returned truth hits were obtained from TrkrAssoc maps
-        std::set<PHG4Hit*> hits = all_truth_hits(cluster_key);
-        for (auto candidate : hits)
-        {
-          PHG4HitDefs::keytype g4hit_key = candidate->get_hit_id();
-
-          if (_verbosity > 5)
-          {
-            int gtrackID = candidate->get_trkid();
-            std::cout << "   adding cluster with cluster_key " << cluster_key << " g4hit with g4hit_key " << g4hit_key
-                      << " gtrackID " << gtrackID
-                      << std::endl;
-          }
-
-          all_g4hits_set.insert(g4hit_key);
-          all_g4hits_map.insert(std::make_pair(g4hit_key, candidate));
-
-          truth_cluster_map.insert(std::make_pair(g4hit_key, cluster_key));
-        }
-      }
-    }
-
-    // now fill the cache
-    // loop over all entries in all_g4hits
-    for (unsigned long long g4hit_key : all_g4hits_set)
-    {
-      if (_verbosity > 5)
-      {
-        std::cout << " associations for g4hit_key " << g4hit_key << std::endl;
-      }
-
-      std::map<PHG4HitDefs::keytype, PHG4Hit*>::iterator it = all_g4hits_map.find(g4hit_key);
-      PHG4Hit* g4hit = it->second;
-
-      std::set<TrkrDefs::cluskey> assoc_clusters;
+  fill_truth_table();
 
-      std::pair<std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator,
-                std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator>
-          ret = truth_cluster_map.equal_range(g4hit_key);
-      for (std::multimap<PHG4HitDefs::keytype, TrkrDefs::cluskey>::iterator jter = ret.first; jter != ret.second; ++jter)
-      {
-        assoc_clusters.insert(jter->second);
-
-        if (_verbosity > 5)
-        {
-          std::cout << "             g4hit_key " << g4hit_key << " associated with cluster_key " << jter->second << std::endl;
-        }
-      }
-      // done with this g4hit
-      _cache_all_clusters_from_g4hit.insert(std::make_pair(g4hit, assoc_clusters));
-    }
-  }
-
-  // get the clusters
   std::set<TrkrDefs::cluskey> clusters;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>>::iterator iter =
-      _cache_all_clusters_from_g4hit.find(truthhit);
-  if (iter != _cache_all_clusters_from_g4hit.end())
+  auto range = std::equal_range(_table_clusters_from_g4hit.begin(), _table_clusters_from_g4hit.end(),
+                                std::make_pair(truthhit, TrkrDefs::cluskey(0)),
+                                [](const auto& lhs, const auto& rhs)
+                                { return lhs.first < rhs.first; });
+  for (auto iter = range.first; iter != range.second; ++iter)
   {
-    return iter->second;
+    if (_verbosity > 5)
+    {
+      std::cout << "             g4hit_key " << truthhit->get_hit_id() << " associated with cluster_key " << iter->second << std::endl;
+    }
+    clusters.insert(clusters.end(), iter->second);
   }
 
-  if (_clusters_per_layer.size() == 0)
+  if (clusters.empty() && _clusters_per_layer.size() == 0)
   {
     fill_cluster_layer_map();
   }
@@ -10,6 +10,7 @@
 #include <memory>  // for shared_ptr, less
 #include <set>
 #include <utility>
+#include <vector>
 
 class PHCompositeNode;
 
@@ -75,7 +76,8 @@ class SvtxClusterEval
   std::set<TrkrDefs::cluskey> all_clusters_from(PHG4Hit* truthhit);
   TrkrDefs::cluskey best_cluster_from(PHG4Hit* truthhit);
   TrkrDefs::cluskey best_cluster_by_nhit(int gid, int layer);
-  void FillRecoClusterFromG4HitCache();
+  //! fill the truth association table of all clusters of the event
+  void FillRecoClusterFromG4HitCache() { fill_truth_table(); }
   // overlap calculations
   float get_energy_contribution(TrkrDefs::cluskey cluster_key, PHG4Particle* truthparticle);
   float get_energy_contribution(TrkrDefs::cluskey cluster_key, PHG4Hit* truthhit);
@@ -90,6 +92,18 @@ class SvtxClusterEval
   //  void fill_g4hit_layer_map();
   bool has_node_pointers();
 
+  //! truth hits of a cluster from the hit and truth association maps
+  std::set<PHG4Hit*> find_truth_hits(TrkrDefs::cluskey cluster_key);
+
+  //! truth particles of a set of truth hits
+  std::set<PHG4Particle*> find_truth_particles(const std::set<PHG4Hit*>& g4hits);
+
+  //! one pass over all clusters of the event to fill the truth association table
+  void fill_truth_table();
+
+  //! row of a cluster in the truth association table, -1 if not found
+  int find_truth_table_row(TrkrDefs::cluskey cluster_key) const;
+
   //! Fast approximation of atan2() for cluster searching
   //! From https://www.dsprelated.com/showarticle/1052.php
   float fast_approx_atan2(float y, float x);
@@ -113,21 +127,31 @@ class SvtxClusterEval
   Acts::Vector3 getGlobalPosition(TrkrDefs::cluskey cluster_key, TrkrCluster* cluster);
 
   bool _do_cache = true;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Hit*>> _cache_all_truth_hits;
   std::map<TrkrDefs::cluskey, std::map<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_all_truth_clusters;
   std::map<TrkrDefs::cluskey, PHG4Hit*> _cache_max_truth_hit_by_energy;
   std::map<TrkrDefs::cluskey, std::pair<TrkrDefs::cluskey, std::shared_ptr<TrkrCluster>>> _cache_max_truth_cluster_by_energy;
-  std::map<TrkrDefs::cluskey, std::set<PHG4Particle*>> _cache_all_truth_particles;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_energy;
   std::map<TrkrDefs::cluskey, PHG4Particle*> _cache_max_truth_particle_by_cluster_energy;
-  std::map<PHG4Particle*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_particle;
-  std::map<PHG4Hit*, std::set<TrkrDefs::cluskey>> _cache_all_clusters_from_g4hit;
   std::map<PHG4Hit*, TrkrDefs::cluskey> _cache_best_cluster_from_g4hit;
   std::map<std::pair<int, int>, TrkrDefs::cluskey> _cache_best_cluster_from_gtrackid_layer;
   std::map<std::pair<TrkrDefs::cluskey, PHG4Particle*>, float> _cache_get_energy_contribution_g4particle;
   std::map<std::pair<TrkrDefs::cluskey, PHG4Hit*>, float> _cache_get_energy_contribution_g4hit;
   std::map<std::shared_ptr<TrkrCluster>, std::pair<TrkrDefs::cluskey, TrkrCluster*>> _cache_reco_cluster_from_truth_cluster;
 
+  //! truth association table of the event, replaces the per cluster caches.
+  //! rows are the sorted cluster keys, the truth hits and particles of row i are in
+  //! [offset[i], offset[i+1]) of the hit and particle arrays (compressed sparse rows)
+  bool _truth_table_filled = false;
+  std::vector<TrkrDefs::cluskey> _table_clusters;
+  std::vector<unsigned int> _table_hit_offset;
+  std::vector<PHG4Hit*> _table_hits;
+  std::vector<unsigned int> _table_particle_offset;
+  std::vector<PHG4Particle*> _table_particles;
+
+  //! reverse associations sorted by truth hit and particle
+  std::vector<std::pair<PHG4Hit*, TrkrDefs::cluskey>> _table_clusters_from_g4hit;
+  std::vector<std::pair<PHG4Particle*, TrkrDefs::cluskey>> _table_clusters_from_particle;
+
   // measured for low occupancy events, all in cm
   const float sig_tpc_rphi_inner = 220e-04;
   const float sig_tpc_rphi_mid = 155e-04;
@@ -1,11 +1,44 @@
 #include "SvtxEvalStack.h"
 
+#include <fun4all/Fun4AllServer.h>
+
+#include <phool/PHCompositeNode.h>
+#include <phool/PHDataNode.h>
+#include <phool/getClass.h>
+
+#include <string>
+
 SvtxEvalStack::SvtxEvalStack(PHCompositeNode* topNode)
   : _vertexeval(topNode)
 {
 }
 
+SvtxEvalStack* SvtxEvalStack::get_shared(PHCompositeNode* topNode, bool strict, int verbosity)
+{
+  const std::string nodename = strict ? "SvtxEvalStackStrict" : "SvtxEvalStack";
+  auto stack = findNode::getClass<SvtxEvalStack>(topNode, nodename);
+  if (!stack)
+  {
+    stack = new SvtxEvalStack(topNode);
+    stack->set_strict(strict);
+    stack->set_verbosity(verbosity);
+    stack->_shared = true;
+    topNode->addNode(new PHDataNode<SvtxEvalStack>(stack, nodename));
+  }
+  return stack;
+}
+
 void SvtxEvalStack::next_event(PHCompositeNode* topNode)
 {
+  if (_shared)
+  {
+    Fun4AllServer* se = Fun4AllServer::instance();
+    if (se->RunNumber() == _run && se->EventCounter() == _event)
+    {
+      return;
+    }
+    _run = se->RunNumber();
+    _event = se->EventCounter();
+  }
   _vertexeval.next_event(topNode);
 }
@@ -23,6 +23,11 @@ class SvtxEvalStack
   SvtxEvalStack(PHCompositeNode* topNode);
   virtual ~SvtxEvalStack() {}
 
+  //! stack shared by all modules asking for the same strictness, owned by the node tree.
+  //! It is made, with the given verbosity, by the first module asking for it
+  static SvtxEvalStack* get_shared(PHCompositeNode* topNode, bool strict, int verbosity = 0);
+
+  //! a shared stack is only moved to the next event once, by the first module of the event
   void next_event(PHCompositeNode* topNode);
   void do_caching(bool do_cache) { _vertexeval.do_caching(do_cache); }
   void set_strict(bool strict) { _vertexeval.set_strict(strict); }
@@ -43,6 +48,10 @@ class SvtxEvalStack
 
  private:
   SvtxVertexEval _vertexeval;  // right now this is the top-level eval
+
+  bool _shared = false;
+  int _run = -1;
+  int _event = -1;
 };
 
 #endif  // G4EVAL_SVTXEVALSTACK_H
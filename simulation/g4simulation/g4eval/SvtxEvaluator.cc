@@ -86,7 +86,14 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
   _ievent = 0;
 
   _tfile = new TFile(_filename.c_str(), "RECREATE");
-  _tfile->SetCompressionLevel(0);
+  if (_compression_settings >= 0)
+  {
+    _tfile->SetCompressionSettings(_compression_settings);
+  }
+  else
+  {
+    _tfile->SetCompressionLevel(0);
+  }
   if (_do_info_eval)
   {
     _ntp_info = new TNtuple("ntp_info", "event info",
@@ -210,12 +217,33 @@ int SvtxEvaluator::Init(PHCompositeNode* /*topNode*/)
                              "nhittpcall:nhittpcin:nhittpcmid:nhittpcout:nclusall:nclustpc:nclusintt:nclusmaps:nclusmms");
   }
 
+  for (TNtuple* ntp : {_ntp_info, _ntp_vertex, _ntp_gpoint, _ntp_g4hit, _ntp_hit, _ntp_cluster, _ntp_g4cluster, _ntp_gtrack, _ntp_track, _ntp_gseed})
+  {
+    configure_ntuple(ntp);
+  }
+
   _timer = new PHTimer("_eval_timer");
   _timer->stop();
 
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
+void SvtxEvaluator::configure_ntuple(TNtuple* ntp) const
+{
+  if (!ntp)
+  {
+    return;
+  }
+  if (_basket_size > 0)
+  {
+    ntp->SetBasketSize("*", _basket_size);
+  }
+  if (_auto_flush != 0)
+  {
+    ntp->SetAutoFlush(_auto_flush);
+  }
+}
+
 int SvtxEvaluator::InitRun(PHCompositeNode* /*topNode*/)
 {
   return Fun4AllReturnCodes::EVENT_OK;
@@ -72,6 +72,14 @@ class SvtxEvaluator : public SubsysReco
   void do_vtx_eval_light(bool b) { _do_vtx_eval_light = b; }
   void scan_for_embedded(bool b) { _scan_for_embedded = b; }
   void scan_for_primaries(bool b) { _scan_for_primaries = b; }
+
+  //! ROOT compression settings of the output file, algorithm * 100 + level (e.g. 404 for LZ4, 505 for ZSTD)
+  //! values < 0 keep the default (no compression)
+  void set_compression_settings(const int i) { _compression_settings = i; }
+  //! basket size in bytes of all ntuple branches, 0 keeps the ROOT default
+  void set_basket_size(const int i) { _basket_size = i; }
+  //! flush baskets every n entries (n > 0) or every -n bytes (n < 0), 0 keeps the ROOT default
+  void set_auto_flush(const Long64_t n) { _auto_flush = n; }
   
  private:
   unsigned int _ievent = 0;
@@ -132,6 +140,12 @@ class SvtxEvaluator : public SubsysReco
   // Track map name
   std::string _trackmapname;
   TFile *_tfile = nullptr;
+  int _compression_settings = -1;
+  int _basket_size = 0;
+  Long64_t _auto_flush = 0;
+
+  //! apply the basket settings to an output ntuple
+  void configure_ntuple(TNtuple *ntp) const;
 
   PHTimer *_timer = nullptr;
 
@@ -41,6 +41,8 @@
 #include <boost/format.hpp>
 
 #include <algorithm>
+#include <functional>  // for std::ref
+#include <future>
 
 // To change:
 // Make the definition of matching clusters to be if the truth cluster center is withing 1/2 of width of the reco track center
@@ -108,6 +110,8 @@ int TruthRecoTrackMatching::process_event(PHCompositeNode* topnode)
   }
 
   m_nmatched_index_true.clear();
+  m_truth_keys.clear();
+  m_reco_keys.clear();
 
   // -------------------------------------------------------------------------------
   // Build recoData
@@ -556,95 +560,102 @@ void TruthRecoTrackMatching::match_tracks_in_box(
   std::sort(box_pairs.begin(), box_pairs.end());  // sorted by first index_true, then id_reco
   std::vector<PossibleMatch> poss_matches;
 
-  auto ipair = box_pairs.begin();  // save current examined pair for sorting/unsorting purposes
-  while (ipair != box_pairs.end())
+  // pairs to compare: skip truth and reco tracks which already have the maximum number of matches.
+  // The match counts only change after all pairs of the box are compared.
+  std::vector<std::pair<unsigned short, unsigned short>> comp_pairs;
+  comp_pairs.reserve(box_pairs.size());
+  for (auto& box_pair : box_pairs)
   {
-    auto id_true = ipair->first;
-
-    // See if this track already has the maximum number of matches. If it does, then skip all pairs using this truth-track-index;
-    if (at_nmax_index_true(id_true))
+    if (at_nmax_index_true(box_pair.first) || at_nmax_id_reco(box_pair.second))
     {
-      while (ipair != box_pairs.end())
-      {
-        ++ipair;
-        if (ipair->first != id_true)
-        {
-          break;
-        }
-      }
       continue;
     }
+    comp_pairs.push_back(box_pair);
 
-    // make all possible reco matches matched for this track
-    /* std::map<TrkrDefs::hitsetkey,TrkrDefs::cluskey> truth_keys; */
-    m_TCEval.addClusKeys(m_TrkrTruthTrackContainer->getTruthTrack(id_true));
-    // add the truth keys into the track counter
-    /* auto truth_track = m_TrkrTruthTrackContainer->getTruthTrack(id_true); */
-    /* for (auto& key : truth_track->getClusters()) { */
-    /*   truth_keys[TrkrDefs::getHitSetKeyFromClusKey(key)] = key; */
-    /* } */
-    /* unsigned short nclus_true = truth_keys.size(); */
-
-    while (ipair != box_pairs.end())
-    {  // Loop over all possible matches only for this index_true
-      //(subsequent true tracks will be caught on following loops)
-      if (ipair->first != id_true)
-      {
-        break;  // never true on first iteration
-      }
-      if (at_nmax_id_reco(ipair->second))
-      {
-        ++ipair;
-        continue;
-      }  // make sure the reco-track isn't alread matched
-      // ok, make a possible match: compare the clusters in the truth track and the reco track
-      SvtxTrack* reco_track = m_SvtxTrackMap->get(ipair->second);
-      m_TCEval.addClusKeys(reco_track);
-      m_TCEval.find_matches();
-
-      /* unsigned short nclus_match   = 0; // fill in the comparison loop */
-      /* unsigned short nclus_nomatch = 0; // number of reco and truth cluster
-       *             // that share a hitsetkey, but still fair matching criteria */
-      /* unsigned short nclus_reco    = 0; // count in the comparison loop */
-      // do the comparison of the tracks
-      /* for (auto reco_ckey : G4Eval::ClusKeyIter(reco_track)) { */
-      /*   ++nclus_reco; */
-      /*   auto hitsetkey = TrkrDefs::getHitSetKeyFromClusKey(reco_ckey); */
-      /*   if (truth_keys.count(hitsetkey) != 0) { */
-      /*     // reco and truth cluster are in same hitsetkey-indexed subsurface. */
-      /*     // See if they match (++nclus_match) or not (++nclus_nomatch) */
-      /*     if (m_cluster_comp(truth_keys[hitsetkey], reco_ckey).first) { */
-      /*       ++nclus_match; */
-      /*     } else { */
-      /*       ++nclus_nomatch; */
-      /*     } */
-      /*   } */
-      /* } */
-      unsigned short nclus_match = m_TCEval.phg4_n_matched();
-      unsigned short nclus_true = m_TCEval.phg4_nclus();
-      unsigned short nclus_reco = m_TCEval.svtx_nclus();
-      unsigned short nclus_nomatch = (int) (m_TCEval.svtx_keys.size() - nclus_match);
-
-      if (Verbosity() > 100)
-      {
-        auto truth_track = m_TrkrTruthTrackContainer->getTruthTrack(id_true);
-        std::cout << (boost::format(
-                         "possmatch:(phi,eta,pT:id) true(%5.2f,%5.2f,%4.2f:%2i) reco(%5.2f,%5.2f,%4.2f:%2i) "
-                         "nCl(match:true:reco:nomatch)(%2i-%2i-%2i-%2i)")
-                         %truth_track->getPhi() %truth_track->getPseudoRapidity() %truth_track->getPt()
-		      %((int) truth_track->getTrackid())
-                         %reco_track->get_phi() %reco_track->get_eta() %reco_track->get_pt()
-                         %ipair->second
-		      %((int) nclus_match) %((int) nclus_true) %((int) nclus_reco) %((int) nclus_nomatch)).str()
-                  << std::endl;
-      }
-      if (nclus_match >= m_nmincluster_match && (static_cast<float>(nclus_match) / nclus_true >= m_nmincluster_ratio))
-      {
-        poss_matches.push_back(
-            {nclus_match, nclus_true, nclus_reco,
-             ipair->first, ipair->second});
-      }
-      ++ipair;
+    // sorted cluster keys of each track, collected once per event
+    if (m_truth_keys.find(box_pair.first) == m_truth_keys.end())
+    {
+      m_TCEval.addClusKeys(m_TrkrTruthTrackContainer->getTruthTrack(box_pair.first));
+      m_truth_keys[box_pair.first] = m_TCEval.phg4_keys;
+    }
+    if (m_reco_keys.find(box_pair.second) == m_reco_keys.end())
+    {
+      m_TCEval.addClusKeys(m_SvtxTrackMap->get(box_pair.second));
+      m_reco_keys[box_pair.second] = m_TCEval.svtx_keys;
+    }
+  }
+
+  // compare the clusters in the truth track and the reco track of each pair.
+  // The pairs are independent, so they are split in contiguous ranges over the threads,
+  // each with its own evaluator and cluster matcher.
+  std::vector<std::array<unsigned short, 3>> comp_results(comp_pairs.size());  // nclus match, true, reco
+  auto compare_range = [this, &comp_pairs, &comp_results](TrackClusEvaluator& eval, size_t first, size_t last)
+  {
+    for (size_t i = first; i < last; ++i)
+    {
+      eval.phg4_keys = m_truth_keys.at(comp_pairs[i].first);
+      eval.svtx_keys = m_reco_keys.at(comp_pairs[i].second);
+      eval.find_matches();
+      comp_results[i] = {static_cast<unsigned short>(eval.phg4_n_matched()),
+                         static_cast<unsigned short>(eval.phg4_nclus()),
+                         static_cast<unsigned short>(eval.svtx_nclus())};
+    }
+  };
+  const size_t nthreads = std::max(1, std::min<int>(m_nthreads, comp_pairs.size()));
+  if (nthreads == 1 || !m_TCEval.ismatcher)
+  {
+    compare_range(m_TCEval, 0, comp_pairs.size());
+  }
+  else
+  {
+    std::vector<TrkrClusterIsMatcher> matchers(nthreads, *m_TCEval.ismatcher);
+    std::vector<TrackClusEvaluator> evals;
+    evals.reserve(nthreads);
+    for (auto& matcher : matchers)
+    {
+      evals.emplace_back(&matcher);
+    }
+    std::vector<std::future<void>> jobs;
+    const size_t chunk = (comp_pairs.size() + nthreads - 1) / nthreads;
+    for (size_t ithread = 0; ithread < nthreads; ++ithread)
+    {
+      const size_t first = ithread * chunk;
+      const size_t last = std::min(comp_pairs.size(), first + chunk);
+      jobs.push_back(std::async(std::launch::async, compare_range, std::ref(evals[ithread]), first, last));
+    }
+    for (auto& job : jobs)
+    {
+      job.get();
+    }
+  }
+
+  for (size_t i = 0; i < comp_pairs.size(); ++i)
+  {
+    const auto& [id_true, id_reco] = comp_pairs[i];
+    const unsigned short nclus_match = comp_results[i][0];
+    const unsigned short nclus_true = comp_results[i][1];
+    const unsigned short nclus_reco = comp_results[i][2];
+    const unsigned short nclus_nomatch = nclus_reco - nclus_match;
+
+    if (Verbosity() > 100)
+    {
+      auto truth_track = m_TrkrTruthTrackContainer->getTruthTrack(id_true);
+      SvtxTrack* reco_track = m_SvtxTrackMap->get(id_reco);
+      std::cout << (boost::format(
+                       "possmatch:(phi,eta,pT:id) true(%5.2f,%5.2f,%4.2f:%2i) reco(%5.2f,%5.2f,%4.2f:%2i) "
+                       "nCl(match:true:reco:nomatch)(%2i-%2i-%2i-%2i)")
+                       %truth_track->getPhi() %truth_track->getPseudoRapidity() %truth_track->getPt()
+                    %((int) truth_track->getTrackid())
+                       %reco_track->get_phi() %reco_track->get_eta() %reco_track->get_pt()
+                       %id_reco
+                    %((int) nclus_match) %((int) nclus_true) %((int) nclus_reco) %((int) nclus_nomatch)).str()
+                << std::endl;
+    }
+    if (nclus_match >= m_nmincluster_match && (static_cast<float>(nclus_match) / nclus_true >= m_nmincluster_ratio))
+    {
+      poss_matches.push_back(
+          {nclus_match, nclus_true, nclus_reco,
+           id_true, id_reco});
     }
   }
 
@@ -84,6 +84,9 @@ class TruthRecoTrackMatching : public SubsysReco
   void set_max_nreco_per_truth(unsigned short val) { m_max_nreco_per_truth = val; };
   void set_max_ntruth_per_reco(unsigned short val) { m_max_ntruth_per_reco = val; };
 
+  // number of threads comparing the clusters of truth-reco track pairs, default 1
+  void set_nthreads(int val) { m_nthreads = val; };
+
  private:
   //--------------------------------------------------
   // Internal functions
@@ -112,6 +115,12 @@ class TruthRecoTrackMatching : public SubsysReco
 
   std::map<unsigned short, unsigned short> m_nmatched_index_true;
 
+  // sorted {hitsetkey, cluskey} of the truth and reco tracks, filled once per event
+  std::map<unsigned short, decltype(TrackClusEvaluator::phg4_keys)> m_truth_keys;
+  std::map<unsigned short, decltype(TrackClusEvaluator::svtx_keys)> m_reco_keys;
+
+  int m_nthreads = 1;
+
   std::map<unsigned short, unsigned short>* m_nmatched_id_reco = nullptr;
   std::map<unsigned short, unsigned short>* m_nmatched_id_true = nullptr;
 
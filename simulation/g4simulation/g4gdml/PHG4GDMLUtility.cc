@@ -20,16 +20,101 @@
 #include <phool/PHObject.h>  // for PHObject
 #include <phool/getClass.h>
 
-#include <Geant4/G4VPhysicalVolume.hh>
+#include <Geant4/G4Element.hh>
 #include <Geant4/G4GDMLWriteStructure.hh>
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Material.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+#include <Geant4/G4VSolid.hh>
+#include <Geant4/G4Version.hh>
 
 #include <cassert>
+#include <cstdint>
+#include <iomanip>
 #include <iostream>  // for operator<<, stringstream
+#include <set>
 #include <sstream>
 #include <stdexcept>
 
 using namespace std;
 
+namespace
+{
+  //! FNV-1a hash, stable across builds and processes
+  uint64_t fnv1a(const std::string &data)
+  {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : data)
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  //! describe a logical volume and its daughters, skipping the same volumes as PHG4GDMLWriteStructure
+  void describe_volume(std::ostream &out, const G4LogicalVolume *volume, const PHG4GDMLConfig *config, std::set<const G4LogicalVolume *> &described)
+  {
+    out << "volume " << volume->GetName() << "\n";
+    if (!described.insert(volume).second)
+    {
+      // already described, the name is enough
+      return;
+    }
+    if (config->get_excluded_logical_vol().find(volume) != config->get_excluded_logical_vol().end())
+    {
+      out << "excluded\n";
+      return;
+    }
+
+    const G4Material *material = volume->GetMaterial();
+    out << "material " << material->GetName() << " " << material->GetDensity() << " " << material->GetState()
+        << " " << material->GetTemperature() << " " << material->GetPressure() << "\n";
+    for (size_t i = 0; i < material->GetNumberOfElements(); ++i)
+    {
+      const G4Element *element = material->GetElement(i);
+      out << "element " << element->GetName() << " " << element->GetZ() << " " << element->GetN()
+          << " " << element->GetA() << " " << material->GetFractionVector()[i] << "\n";
+    }
+
+    // solid parameters, including the constituents of boolean and displaced solids
+    volume->GetSolid()->StreamInfo(out);
+
+    const auto ndaughters = volume->GetNoDaughters();
+    for (decltype(ndaughters) i = 0; i < ndaughters; ++i)
+    {
+      const G4VPhysicalVolume *physvol = volume->GetDaughter(i);
+      if (config->get_excluded_physical_vol().find(physvol) != config->get_excluded_physical_vol().end())
+      {
+        continue;
+      }
+
+      const G4ThreeVector translation = physvol->GetTranslation();
+      out << "daughter " << physvol->GetName() << " " << physvol->GetCopyNo()
+          << " " << translation.x() << " " << translation.y() << " " << translation.z();
+      if (const G4RotationMatrix *rotation = physvol->GetRotation())
+      {
+        out << " " << rotation->xx() << " " << rotation->xy() << " " << rotation->xz()
+            << " " << rotation->yx() << " " << rotation->yy() << " " << rotation->yz()
+            << " " << rotation->zx() << " " << rotation->zy() << " " << rotation->zz();
+      }
+      if (physvol->IsReplicated())
+      {
+        EAxis axis = kUndefined;
+        G4int nreplicas = 0;
+        G4double width = 0;
+        G4double offset = 0;
+        G4bool consuming = false;
+        physvol->GetReplicationData(axis, nreplicas, width, offset, consuming);
+        out << " replica " << axis << " " << nreplicas << " " << width << " " << offset << " " << consuming;
+      }
+      out << "\n";
+
+      describe_volume(out, physvol->GetLogicalVolume(), config, described);
+    }
+  }
+}  // namespace
+
 void PHG4GDMLUtility::Dump_GDML(const std::string &filename, G4VPhysicalVolume *vol, PHCompositeNode *topNode)
 {
   if (topNode == nullptr)
@@ -63,6 +148,33 @@ void PHG4GDMLUtility::Dump_G4_GDML(const std::string &filename, G4VPhysicalVolum
   xercesc::XMLPlatformUtils::Terminate();
 }
 
+std::string PHG4GDMLUtility::Get_Geometry_Hash(G4VPhysicalVolume *vol, PHCompositeNode *topNode)
+{
+  if (topNode == nullptr)
+  {
+    Fun4AllServer *se = Fun4AllServer::instance();
+    topNode = se->topNode();
+  }
+
+  const PHG4GDMLConfig *config =
+      GetOrMakeConfigNode(topNode);
+  assert(config);
+  assert(vol);
+  assert(vol->GetLogicalVolume());
+
+  // the description changes with the Geant4 version, whose GDML writer may change as well
+  ostringstream description;
+  description << setprecision(17)
+              << "PHG4GDMLUtility geometry hash 1 geant4 " << G4VERSION_NUMBER << "\n"
+              << "world " << vol->GetName() << "\n";
+  set<const G4LogicalVolume *> described;
+  describe_volume(description, vol->GetLogicalVolume(), config, described);
+
+  ostringstream hash;
+  hash << hex << setw(16) << setfill('0') << fnv1a(description.str());
+  return hash.str();
+}
+
 PHG4GDMLConfig *PHG4GDMLUtility::GetOrMakeConfigNode(PHCompositeNode *topNode, bool build_new)
 {
   PHNodeIterator iter(topNode);
@@ -31,6 +31,10 @@ class PHG4GDMLUtility
   //! same as above but use default Geant functions as much as possible
   static void Dump_G4_GDML(const std::string &filename, G4VPhysicalVolume *vol);
 
+  //! hash of the geometry Dump_GDML would write (volume tree, placements, solids and materials), as hex string.
+  //! Much faster than writing the GDML file, used as key of cached geometries
+  static std::string Get_Geometry_Hash(G4VPhysicalVolume *vol, PHCompositeNode *topNode = nullptr);
+
   static constexpr const char *get_PHG4GDML_Schema()
   {
     return "http://service-spi.web.cern.ch/service-spi/app/releases/GDML/schema/gdml.xsd";
@@ -39,6 +39,7 @@
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>  // for PHObject
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -71,16 +72,10 @@ PHG4InttHitReco::PHG4InttHitReco(const std::string &name)
   m_HitNodeName = "G4HIT_" + m_Detector;
   m_CellNodeName = "G4CELL_" + m_Detector;
   m_GeoNodeName = "CYLINDERGEOM_" + m_Detector;
-  m_LocalOutVec = gsl_vector_alloc(3);
-  m_PathVec = gsl_vector_alloc(3);
-  m_SegmentVec = gsl_vector_alloc(3);
 }
 
 PHG4InttHitReco::~PHG4InttHitReco()
 {
-  gsl_vector_free(m_LocalOutVec);
-  gsl_vector_free(m_PathVec);
-  gsl_vector_free(m_SegmentVec);
   delete m_truth_hits;
 }
 
@@ -277,6 +272,16 @@ int PHG4InttHitReco::InitRun(PHCompositeNode *topNode)
     std::cout<<std::endl;
   }
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity())
+    {
+      std::cout << "PHG4InttHitReco::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -319,7 +324,33 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
   }
   PHG4HitContainer::ConstRange hit_begin_end = g4hit->getHits();
 
-  for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+  // the charge sharing only depends on the g4hit and the geometry, with threads it is
+  // done for all hits first. Truth tracking and the hitsets are filled below in the
+  // original hit order, so the output does not depend on the threads
+  std::vector<std::vector<StripDeposit>> deposits;
+  std::vector<char> deposit_ok;
+  const bool precomputed = m_threadpool && Verbosity() < 2;
+  if (precomputed)
+  {
+    std::vector<PHG4Hit *> g4hits;
+    for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter)
+    {
+      g4hits.push_back(hiter->second);
+    }
+    deposits.resize(g4hits.size());
+    deposit_ok.assign(g4hits.size(), 1);
+    m_threadpool->parallel_for(g4hits.size(), [&](size_t i)
+                               {
+      if (g4hits[i]->get_t(0) > m_Tmax || g4hits[i]->get_t(1) < m_Tmin)
+      {
+        return;
+      }
+      CylinderGeomIntt *hitgeom = dynamic_cast<CylinderGeomIntt *>(geo->GetLayerGeom(g4hits[i]->get_detid()));
+      deposit_ok[i] = share_charge(g4hits[i], hitgeom, deposits[i]); });
+  }
+
+  size_t ihit = 0;
+  for (PHG4HitContainer::ConstIterator hiter = hit_begin_end.first; hiter != hit_begin_end.second; ++hiter, ++ihit)
   {
     const int sphxlayer = hiter->second->get_detid();
     CylinderGeomIntt *layergeom = dynamic_cast<CylinderGeomIntt *>(geo->GetLayerGeom(sphxlayer));
@@ -340,198 +371,22 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
 
     float time = (hiter->second->get_t(0) + hiter->second->get_t(1)) / 2.0;
 
-    // I made this (small) diffusion up for now, we will get actual values for the Intt later
-    double diffusion_width = 5.0e-04;  // diffusion radius 5 microns, in cm
-
     const int ladder_z_index = hiter->second->get_ladder_z_index();
     const int ladder_phi_index = hiter->second->get_ladder_phi_index();
 
-    // What we have is a hit in the sensor. We have not yet assigned the strip(s) that were hit, we do that here
-    //========================================================================
-
-    // initialize them. In case find_strip_index_values does not set them we can pick this up
-    int strip_y_index_in = -99999;
-    int strip_z_index_in = -99999;
-    int strip_y_index_out = -99999;
-    int strip_z_index_out = -99999;
-
-    layergeom->find_strip_index_values(ladder_z_index, hiter->second->get_local_y(0), hiter->second->get_local_z(0), strip_y_index_in, strip_z_index_in);
-    layergeom->find_strip_index_values(ladder_z_index, hiter->second->get_local_y(1), hiter->second->get_local_z(1), strip_y_index_out, strip_z_index_out);
-    if (strip_y_index_in == -99999 ||
-        strip_z_index_in == -99999 ||
-        strip_y_index_out == -99999 ||
-        strip_z_index_out == -99999)
+    // strip energies from the charge sharing, computed up front when running with threads
+    std::vector<StripDeposit> local_deposits;
+    if (precomputed ? !deposit_ok[ihit] : !share_charge(hiter->second, layergeom, local_deposits))
     {
-      std::cout << "setting of strip indices failed" << std::endl;
-      std::cout << "strip_y_index_in: " << strip_y_index_in << std::endl;
-      std::cout << "strip_z_index_in: " << strip_z_index_in << std::endl;
-      std::cout << "strip_y_index_out: " << strip_y_index_out << std::endl;
-      std::cout << "strip_z_index_out: " << strip_y_index_out << std::endl;
       gSystem->Exit(1);
       exit(1);
     }
-    if (Verbosity() > 5)
-    {
-      // check to see if we get back the positions from these strip index values
-      double check_location[3] = {-1, -1, -1};
-      layergeom->find_strip_center_localcoords(ladder_z_index, strip_y_index_in, strip_z_index_in, check_location);
-      std::cout << " G4 entry location = " << hiter->second->get_local_x(0) << "  " << hiter->second->get_local_y(0) << "  " << hiter->second->get_local_z(0) << std::endl;
-      std::cout << " Check entry location = " << check_location[0] << "  " << check_location[1] << "  " << check_location[2] << std::endl;
-      layergeom->find_strip_center_localcoords(ladder_z_index, strip_y_index_out, strip_z_index_out, check_location);
-      std::cout << " G4 exit location = " << hiter->second->get_local_x(1) << " " << hiter->second->get_local_y(1) << "  " << hiter->second->get_local_z(1) << std::endl;
-      std::cout << " Check exit location = " << check_location[0] << "  " << check_location[1] << "  " << check_location[2] << std::endl;
-    }
-
-    // Now we find how many strips were crossed by this track, and divide the energy between them
-    int minstrip_z = strip_z_index_in;
-    int maxstrip_z = strip_z_index_out;
-    if (minstrip_z > maxstrip_z)
-    {
-      std::swap(minstrip_z, maxstrip_z);
-    }
-
-    int minstrip_y = strip_y_index_in;
-    int maxstrip_y = strip_y_index_out;
-    if (minstrip_y > maxstrip_y)
-    {
-      std::swap(minstrip_y, maxstrip_y);
-    }
-
-    // Use an algorithm similar to the one for the MVTX pixels, since it facilitates adding charge diffusion
-    // for now we assume small charge diffusion
-    std::vector<int> vybin;
-    std::vector<int> vzbin;
-    // std::vector<double> vlen;
-    std::vector<std::pair<double, double> > venergy;
-
-    //====================================================
-    // Beginning of charge sharing implementation
-    //    Find tracklet line inside sensor
-    //    Divide tracklet line into n segments (vary n until answer stabilizes)
-    //    Find centroid of each segment
-    //    Diffuse charge at each centroid
-    //    Apportion charge between neighboring pixels
-    //    Add the pixel energy contributions from different track segments together
-    //====================================================
-
-    // skip this hit if it involves an unreasonable  number of pixels
-    // this skips it if either the xbin or ybin range traversed is greater than 8 (for 8 adding two pixels at each end makes the range 12)
-    if (maxstrip_y - minstrip_y > 12 || maxstrip_z - minstrip_z > 12)
-    {
-      continue;
-    }
-    // this hit is skipped above if this dimensioning would be exceeded
-    double stripenergy[13][13] = {};  // init to 0
-    double stripeion[13][13] = {};    // init to 0
-
-    int nsegments = 10;
-    // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
-    // Get the entry point of the hit in sensor local coordinates
-    gsl_vector_set(m_PathVec, 0, hiter->second->get_local_x(0));
-    gsl_vector_set(m_PathVec, 1, hiter->second->get_local_y(0));
-    gsl_vector_set(m_PathVec, 2, hiter->second->get_local_z(0));
-    gsl_vector_set(m_LocalOutVec, 0, hiter->second->get_local_x(1));
-    gsl_vector_set(m_LocalOutVec, 1, hiter->second->get_local_y(1));
-    gsl_vector_set(m_LocalOutVec, 2, hiter->second->get_local_z(1));
-    gsl_vector_sub(m_PathVec, m_LocalOutVec);
-    for (int i = 0; i < nsegments; i++)
-    {
-      // Find the tracklet segment location
-      // If there are n segments of equal length, we want 2*n intervals
-      // The 1st segment is centered at interval 1, the 2nd at interval 3, the nth at interval 2n -1
-      double interval = 2 * (double) i + 1;
-      double frac = interval / (double) (2 * nsegments);
-      gsl_vector_memcpy(m_SegmentVec, m_PathVec);
-      gsl_vector_scale(m_SegmentVec, frac);
-      gsl_vector_add(m_SegmentVec, m_LocalOutVec);
-      // Caculate the charge diffusion over this drift distance
-      // increases from diffusion width_min to diffusion_width_max
-      double diffusion_radius = diffusion_width;
-
-      if (Verbosity() > 5)
-      {
-        std::cout << " segment " << i
-                  << " interval " << interval
-                  << " frac " << frac
-                  << " local_in.X " << hiter->second->get_local_x(0)
-                  << " local_in.Z " << hiter->second->get_local_z(0)
-                  << " local_in.Y " << hiter->second->get_local_y(0)
-                  << " pathvec.X " << gsl_vector_get(m_PathVec, 0)
-                  << " pathvec.Z " << gsl_vector_get(m_PathVec, 2)
-                  << " pathvec.Y " << gsl_vector_get(m_PathVec, 1)
-                  << " segvec.X " << gsl_vector_get(m_SegmentVec, 0)
-                  << " segvec.Z " << gsl_vector_get(m_SegmentVec, 2)
-                  << " segvec.Y " << gsl_vector_get(m_SegmentVec, 1) << std::endl
-                  << " diffusion_radius " << diffusion_radius
-                  << std::endl;
-      }
-
-      // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-      for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
-      {
-        for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
-        {
-          // Find the pixel corners for this pixel number
-          double location[3] = {-1, -1, -1};
-          layergeom->find_strip_center_localcoords(ladder_z_index, iy, iz, location);
-          // note that (y1,z1) is the top left corner, (y2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-          int type = (ladder_z_index == 0 || ladder_z_index == 2) ? 0 : 1; // ladder ID 0 and 2 are type-A (1.6 cm), ladder ID 1 and 3 are type-B (2.0 cm)
-          double y1 = location[1] - layergeom->get_strip_y_spacing() / 2.0;
-          double y2 = location[1] + layergeom->get_strip_y_spacing() / 2.0;
-          double z1 = location[2] + layergeom->get_strip_z_spacing(type) / 2.0;
-          double z2 = location[2] - layergeom->get_strip_z_spacing(type) / 2.0;
-
-          if (Verbosity() > 5)
-          {
-            std::cout << PHWHERE << " ladder_z_index " << ladder_z_index  << " strip size in z (from CylinderGeomIntt) " << fabs(z1 - z2) << " strip size in y (from CylinderGeomIntt) " << fabs(y1 - y2) << std::endl;
-          }
-
-          // here m_SegmentVec.1 (Y) and m_SegmentVec.2 (Z) are the center of the circle, and diffusion_radius is the circle radius
-          // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-          double striparea_frac = PHG4Utils::circle_rectangle_intersection(y1, z1, y2, z2, gsl_vector_get(m_SegmentVec, 1), gsl_vector_get(m_SegmentVec, 2), diffusion_radius) / (M_PI * (diffusion_radius * diffusion_radius));
-          // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-          stripenergy[iy - minstrip_y][iz - minstrip_z] += striparea_frac * hiter->second->get_edep() / (float) nsegments;
-          if (hiter->second->has_property(PHG4Hit::prop_eion))
-          {
-            stripeion[iy - minstrip_y][iz - minstrip_z] += striparea_frac * hiter->second->get_eion() / (float) nsegments;
-          }
-          if (Verbosity() > 5)
-          {
-            std::cout << "    strip y index " << iy << " strip z index  " << iz
-                      << " strip area fraction of circle " << striparea_frac << " accumulated pixel energy " << stripenergy[iy - minstrip_y][iz - minstrip_z]
-                      << std::endl;
-          }
-        }
-      }
-    }  // end loop over segments
-    // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-
-    for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
-    {
-      for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
-      {
-        if (stripenergy[iy - minstrip_y][iz - minstrip_z] > 0.0)
-        {
-          vybin.push_back(iy);
-          vzbin.push_back(iz);
-          std::pair<double, double> tmppair = std::make_pair(stripenergy[iy - minstrip_y][iz - minstrip_z], stripeion[iy - minstrip_y][iz - minstrip_z]);
-          venergy.push_back(tmppair);
-          if (Verbosity() > 1)
-          {
-            std::cout << " Added ybin " << iy << " zbin " << iz << " to vectors with energy " << stripenergy[iy - minstrip_y][iz - minstrip_z] << std::endl;
-          }
-        }
-      }
-    }
-
-    //===================================
-    // End of charge sharing implementation
-    //===================================
+    const std::vector<StripDeposit> &hit_deposits = precomputed ? deposits[ihit] : local_deposits;
 
     InttNameSpace::RawData_s raw;
     InttNameSpace::Offline_s ofl;
 
-    for (unsigned int i1 = 0; i1 < vybin.size(); i1++)  // loop over all fired cells
+    for (const auto &deposit : hit_deposits)  // loop over all fired cells
     {
       // We add the Intt TrkrHitsets directly to the node using hitsetcontainer
 
@@ -554,16 +409,16 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
       TrkrHitSetContainer::Iterator hitsetit = hitsetcontainer->findOrAddHitSet(hitsetkey);
 
       // generate the key for this hit
-      TrkrDefs::hitkey hitkey = InttDefs::genHitKey(vzbin[i1], vybin[i1]);
+      TrkrDefs::hitkey hitkey = InttDefs::genHitKey(deposit.zbin, deposit.ybin);
       // See if this hit already exists and is not a raw hit
       ofl.layer = sphxlayer;
       ofl.ladder_z = ladder_z_index;
       ofl.ladder_phi = ladder_phi_index;
-      ofl.strip_x = vybin[i1]; //vzbin is the col
-      ofl.strip_y = vzbin[i1]; //vybin is the row
+      ofl.strip_x = deposit.ybin; //zbin is the col
+      ofl.strip_y = deposit.zbin; //ybin is the row
       raw = InttNameSpace::ToRawData(ofl);
 
-      double hit_energy = venergy[i1].first * TrkrDefs::InttEnergyScaleup;
+      double hit_energy = deposit.energy * TrkrDefs::InttEnergyScaleup;
       addtruthhitset(hitsetkey, hitkey, hit_energy);
 
       if (m_HotChannelSet.find(raw) != m_HotChannelSet.end())
@@ -582,7 +437,7 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
       // Either way, add the energy to it
       if (Verbosity() > 2)
       {
-        std::cout << "add energy " << venergy[i1].first << " to intthit " << std::endl;
+        std::cout << "add energy " << deposit.energy << " to intthit " << std::endl;
       }
 
       hit->addEnergy(hit_energy);
@@ -615,6 +470,184 @@ int PHG4InttHitReco::process_event(PHCompositeNode *topNode)
   return Fun4AllReturnCodes::EVENT_OK;
 }  // end process_event
 
+bool PHG4InttHitReco::share_charge(PHG4Hit *g4hit, CylinderGeomIntt *layergeom, std::vector<StripDeposit> &deposits) const
+{
+  deposits.clear();
+
+  // I made this (small) diffusion up for now, we will get actual values for the Intt later
+  double diffusion_width = 5.0e-04;  // diffusion radius 5 microns, in cm
+
+  const int ladder_z_index = g4hit->get_ladder_z_index();
+
+  // What we have is a hit in the sensor. We have not yet assigned the strip(s) that were hit, we do that here
+  //========================================================================
+
+  // initialize them. In case find_strip_index_values does not set them we can pick this up
+  int strip_y_index_in = -99999;
+  int strip_z_index_in = -99999;
+  int strip_y_index_out = -99999;
+  int strip_z_index_out = -99999;
+
+  layergeom->find_strip_index_values(ladder_z_index, g4hit->get_local_y(0), g4hit->get_local_z(0), strip_y_index_in, strip_z_index_in);
+  layergeom->find_strip_index_values(ladder_z_index, g4hit->get_local_y(1), g4hit->get_local_z(1), strip_y_index_out, strip_z_index_out);
+  if (strip_y_index_in == -99999 ||
+      strip_z_index_in == -99999 ||
+      strip_y_index_out == -99999 ||
+      strip_z_index_out == -99999)
+  {
+    std::cout << "setting of strip indices failed" << std::endl;
+    std::cout << "strip_y_index_in: " << strip_y_index_in << std::endl;
+    std::cout << "strip_z_index_in: " << strip_z_index_in << std::endl;
+    std::cout << "strip_y_index_out: " << strip_y_index_out << std::endl;
+    std::cout << "strip_z_index_out: " << strip_y_index_out << std::endl;
+    return false;
+  }
+  if (Verbosity() > 5)
+  {
+    // check to see if we get back the positions from these strip index values
+    double check_location[3] = {-1, -1, -1};
+    layergeom->find_strip_center_localcoords(ladder_z_index, strip_y_index_in, strip_z_index_in, check_location);
+    std::cout << " G4 entry location = " << g4hit->get_local_x(0) << "  " << g4hit->get_local_y(0) << "  " << g4hit->get_local_z(0) << std::endl;
+    std::cout << " Check entry location = " << check_location[0] << "  " << check_location[1] << "  " << check_location[2] << std::endl;
+    layergeom->find_strip_center_localcoords(ladder_z_index, strip_y_index_out, strip_z_index_out, check_location);
+    std::cout << " G4 exit location = " << g4hit->get_local_x(1) << " " << g4hit->get_local_y(1) << "  " << g4hit->get_local_z(1) << std::endl;
+    std::cout << " Check exit location = " << check_location[0] << "  " << check_location[1] << "  " << check_location[2] << std::endl;
+  }
+
+  // Now we find how many strips were crossed by this track, and divide the energy between them
+  int minstrip_z = strip_z_index_in;
+  int maxstrip_z = strip_z_index_out;
+  if (minstrip_z > maxstrip_z)
+  {
+    std::swap(minstrip_z, maxstrip_z);
+  }
+
+  int minstrip_y = strip_y_index_in;
+  int maxstrip_y = strip_y_index_out;
+  if (minstrip_y > maxstrip_y)
+  {
+    std::swap(minstrip_y, maxstrip_y);
+  }
+
+  // Use an algorithm similar to the one for the MVTX pixels, since it facilitates adding charge diffusion
+  // for now we assume small charge diffusion
+
+  //====================================================
+  // Beginning of charge sharing implementation
+  //    Find tracklet line inside sensor
+  //    Divide tracklet line into n segments (vary n until answer stabilizes)
+  //    Find centroid of each segment
+  //    Diffuse charge at each centroid
+  //    Apportion charge between neighboring pixels
+  //    Add the pixel energy contributions from different track segments together
+  //====================================================
+
+  // skip this hit if it involves an unreasonable  number of pixels
+  // this skips it if either the xbin or ybin range traversed is greater than 8 (for 8 adding two pixels at each end makes the range 12)
+  if (maxstrip_y - minstrip_y > 12 || maxstrip_z - minstrip_z > 12)
+  {
+    return true;
+  }
+  // this hit is skipped above if this dimensioning would be exceeded
+  double stripenergy[13][13] = {};  // init to 0
+  double stripeion[13][13] = {};    // init to 0
+
+  int nsegments = 10;
+  // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
+  // Get the entry point of the hit in sensor local coordinates
+  const double localout[3] = {g4hit->get_local_x(1), g4hit->get_local_y(1), g4hit->get_local_z(1)};
+  const double pathvec[3] = {g4hit->get_local_x(0) - localout[0], g4hit->get_local_y(0) - localout[1], g4hit->get_local_z(0) - localout[2]};
+  for (int i = 0; i < nsegments; i++)
+  {
+    // Find the tracklet segment location
+    // If there are n segments of equal length, we want 2*n intervals
+    // The 1st segment is centered at interval 1, the 2nd at interval 3, the nth at interval 2n -1
+    double interval = 2 * (double) i + 1;
+    double frac = interval / (double) (2 * nsegments);
+    double segvec[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      segvec[j] = pathvec[j] * frac + localout[j];
+    }
+    // Caculate the charge diffusion over this drift distance
+    // increases from diffusion width_min to diffusion_width_max
+    double diffusion_radius = diffusion_width;
+
+    if (Verbosity() > 5)
+    {
+      std::cout << " segment " << i
+                << " interval " << interval
+                << " frac " << frac
+                << " local_in.X " << g4hit->get_local_x(0)
+                << " local_in.Z " << g4hit->get_local_z(0)
+                << " local_in.Y " << g4hit->get_local_y(0)
+                << " pathvec.X " << pathvec[0]
+                << " pathvec.Z " << pathvec[2]
+                << " pathvec.Y " << pathvec[1]
+                << " segvec.X " << segvec[0]
+                << " segvec.Z " << segvec[2]
+                << " segvec.Y " << segvec[1] << std::endl
+                << " diffusion_radius " << diffusion_radius
+                << std::endl;
+    }
+
+    // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
+    for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
+    {
+      for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
+      {
+        // Find the pixel corners for this pixel number
+        double location[3] = {-1, -1, -1};
+        layergeom->find_strip_center_localcoords(ladder_z_index, iy, iz, location);
+        // note that (y1,z1) is the top left corner, (y2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
+        int type = (ladder_z_index == 0 || ladder_z_index == 2) ? 0 : 1; // ladder ID 0 and 2 are type-A (1.6 cm), ladder ID 1 and 3 are type-B (2.0 cm)
+        double y1 = location[1] - layergeom->get_strip_y_spacing() / 2.0;
+        double y2 = location[1] + layergeom->get_strip_y_spacing() / 2.0;
+        double z1 = location[2] + layergeom->get_strip_z_spacing(type) / 2.0;
+        double z2 = location[2] - layergeom->get_strip_z_spacing(type) / 2.0;
+
+        if (Verbosity() > 5)
+        {
+          std::cout << PHWHERE << " ladder_z_index " << ladder_z_index  << " strip size in z (from CylinderGeomIntt) " << fabs(z1 - z2) << " strip size in y (from CylinderGeomIntt) " << fabs(y1 - y2) << std::endl;
+        }
+
+        // here segvec[1] (Y) and segvec[2] (Z) are the center of the circle, and diffusion_radius is the circle radius
+        // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
+        double striparea_frac = PHG4Utils::circle_rectangle_intersection(y1, z1, y2, z2, segvec[1], segvec[2], diffusion_radius) / (M_PI * (diffusion_radius * diffusion_radius));
+        // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
+        stripenergy[iy - minstrip_y][iz - minstrip_z] += striparea_frac * g4hit->get_edep() / (float) nsegments;
+        if (g4hit->has_property(PHG4Hit::prop_eion))
+        {
+          stripeion[iy - minstrip_y][iz - minstrip_z] += striparea_frac * g4hit->get_eion() / (float) nsegments;
+        }
+        if (Verbosity() > 5)
+        {
+          std::cout << "    strip y index " << iy << " strip z index  " << iz
+                    << " strip area fraction of circle " << striparea_frac << " accumulated pixel energy " << stripenergy[iy - minstrip_y][iz - minstrip_z]
+                    << std::endl;
+        }
+      }
+    }
+  }  // end loop over segments
+  // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
+
+  for (int iz = minstrip_z; iz <= maxstrip_z; iz++)
+  {
+    for (int iy = minstrip_y; iy <= maxstrip_y; iy++)
+    {
+      if (stripenergy[iy - minstrip_y][iz - minstrip_z] > 0.0)
+      {
+        deposits.push_back({iy, iz, stripenergy[iy - minstrip_y][iz - minstrip_z], stripeion[iy - minstrip_y][iz - minstrip_z]});
+        if (Verbosity() > 1)
+        {
+          std::cout << " Added ybin " << iy << " zbin " << iz << " to vectors with energy " << stripenergy[iy - minstrip_y][iz - minstrip_z] << std::endl;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 void PHG4InttHitReco::SetDefaultParameters()
 {
   // if we ever need separate timing windows, don't patch around here!
@@ -4,21 +4,24 @@
 #define G4INTT_PHG4INTTHITRECO_H
 
 #include <fun4all/SubsysReco.h>
-#include <gsl/gsl_vector.h>  // for gsl_vector
 #include <phparameter/PHParameterInterface.h>
 #include <trackbase/TrkrDefs.h>
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include <intt/InttMapping.h>
 
 class PHCompositeNode;
 
 class ClusHitsVerbosev1;
+class CylinderGeomIntt;
 class PHG4Hit;
 class PHG4TruthInfoContainer;
+class PHThreadPool;
 class TrkrClusterContainer;
 class TrkrHitSetContainer;
 class TrkrTruthTrack;
@@ -45,6 +48,9 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
 
   void setLocalHotStripMaskFile(const std::string& name) { m_localHotStripFileName = name; }
 
+  //! number of threads for the charge sharing, 1 (default) runs without a thread pool
+  void setNumThreads(unsigned int n) { m_nthreads = n; }
+
  protected:
   std::string m_Detector = "INTT";
   std::string m_HitNodeName;
@@ -55,9 +61,8 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
   double m_Tmax;
   double m_crossingPeriod;
 
-  gsl_vector* m_LocalOutVec = nullptr;
-  gsl_vector* m_PathVec = nullptr;
-  gsl_vector* m_SegmentVec = nullptr;
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 
   // needed for clustering truth tracks
  private:
@@ -76,6 +81,18 @@ class PHG4InttHitReco : public SubsysReco, public PHParameterInterface
   typedef std::set<InttNameSpace::RawData_s, InttNameSpace::RawDataComparator> Set_t;
   Set_t m_HotChannelSet;
 
+  //! energy deposited in one strip by a g4hit
+  struct StripDeposit
+  {
+    int ybin;
+    int zbin;
+    double energy;
+    double eion;
+  };
+
+  //! charge sharing of a g4hit over the strips, false if the strip indices cannot be found
+  bool share_charge(PHG4Hit*, CylinderGeomIntt*, std::vector<StripDeposit>&) const;
+
   PHG4Hit* prior_g4hit{nullptr};  // used to check for jumps in g4hits for loopers;
   void truthcheck_g4hit(PHG4Hit*, PHCompositeNode* topNode);
   void addtruthhitset(TrkrDefs::hitsetkey, TrkrDefs::hitkey, float neffelectrons);
@@ -36,6 +36,7 @@
 #include <iterator>
 #include <limits>
 #include <utility>
+#include <vector>
 
 // convenient aliases for deep copying nodes
 namespace
@@ -327,6 +328,9 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
     }
     {
       // hits
+      // source hits are ordered by key, so hits of the same layer come in a row and are added together
+      std::vector<PHG4Hit *> newhits;
+      int detid = -1;
       const auto range = container_hit->getHits();
       for (auto iter = range.first; iter != range.second; ++iter)
       {
@@ -360,8 +364,15 @@ void Fun4AllDstPileupMerger::copy_background_event(PHCompositeNode *dstNode, dou
          * this will generate a new key for the hit and assign it to the hit
          * this ensures that there is no conflict with the hits from the 'main' event
          */
-        pair.second->AddHit(newHit->get_detid(), newHit);
+        if (newHit->get_detid() != detid)
+        {
+          pair.second->AddHits(detid, newhits);
+          newhits.clear();
+          detid = newHit->get_detid();
+        }
+        newhits.push_back(newHit);
       }
+      pair.second->AddHits(detid, newhits);
     }
 
     {
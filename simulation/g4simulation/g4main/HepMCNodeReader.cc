@@ -203,7 +203,8 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
       genevt->set_collision_vertex(collisionVertex);  // save used vertex in HepMC
     }
     const int embed_flag = genevt->get_embedding_id();
-    HepMC::GenEvent *evt = genevt->getEvent();
+    // const access, the particles are only read and shared pile up events are not copied
+    const HepMC::GenEvent *evt = static_cast<const PHHepMCGenEvent *>(genevt)->getEvent();
     if (!evt)
     {
       std::cout << PHWHERE << " no evt pointer under HEPMC Node found";
@@ -259,7 +260,7 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
     const double length_factor = HepMC::Units::conversion_factor(evt->length_unit(), HepMC::Units::CM);
     const double time_factor = HepMC::Units::conversion_factor(evt->length_unit(), HepMC::Units::CM) / GSL_CONST_CGS_SPEED_OF_LIGHT * 1e9;  // from length_unit()/c to ns
 
-    for (HepMC::GenEvent::vertex_iterator v = evt->vertices_begin();
+    for (HepMC::GenEvent::vertex_const_iterator v = evt->vertices_begin();
          v != evt->vertices_end();
          ++v)
     {
@@ -409,7 +410,7 @@ int HepMCNodeReader::process_event(PHCompositeNode *topNode)
         }
       }  //      if (!finalstateparticles.empty())
 
-    }  //    for (HepMC::GenEvent::vertex_iterator v = evt->vertices_begin();
+    }  //    for (HepMC::GenEvent::vertex_const_iterator v = evt->vertices_begin();
 
   }  // For pile-up simulation: loop end for PHHepMC event map
   if (Verbosity() > 0)
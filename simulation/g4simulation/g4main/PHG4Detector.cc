@@ -12,6 +12,7 @@
 #include <Geant4/G4PVPlacement.hh>
 #include <Geant4/G4RotationMatrix.hh>  // for G4RotationMatrix
 #include <Geant4/G4ThreeVector.hh>     // for G4ThreeVector
+#include <Geant4/G4VPhysicalVolume.hh>
 #include <Geant4/G4VisAttributes.hh>
 
 #pragma GCC diagnostic push
@@ -19,6 +20,7 @@
 #include <boost/stacktrace.hpp>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
 #include <cstdlib>
 
 PHG4Detector::PHG4Detector(PHG4Subsystem *subsys, PHCompositeNode *Node, const std::string &nam)
@@ -31,13 +33,19 @@ PHG4Detector::PHG4Detector(PHG4Subsystem *subsys, PHCompositeNode *Node, const s
 void PHG4Detector::Construct(G4LogicalVolume *world)
 {
   PHG4Subsystem *MyMotherSubsystem = m_MySubsystem->GetMotherSubsystem();
-  if (MyMotherSubsystem)
+  G4LogicalVolume *mothervolume = (MyMotherSubsystem) ? MyMotherSubsystem->GetLogicalVolume() : world;
+  // the daughters added by ConstructMe are the top volumes of this detector,
+  // PHG4Reco uses them for the regions and the stepping action dispatch
+  const size_t ndaughters = mothervolume->GetNoDaughters();
+  ConstructMe(mothervolume);
+  m_RootLogicalVolumes.clear();
+  for (size_t i = ndaughters; i < mothervolume->GetNoDaughters(); ++i)
   {
-    ConstructMe(MyMotherSubsystem->GetLogicalVolume());
-  }
-  else
-  {
-    ConstructMe(world);
+    G4LogicalVolume *logvol = mothervolume->GetDaughter(i)->GetLogicalVolume();
+    if (std::find(m_RootLogicalVolumes.begin(), m_RootLogicalVolumes.end(), logvol) == m_RootLogicalVolumes.end())
+    {
+      m_RootLogicalVolumes.push_back(logvol);
+    }
   }
   return;
 }
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 
 class G4LogicalVolume;
 class G4Material;
@@ -41,6 +42,9 @@ class PHG4Detector
 
   virtual void ConstructMe(G4LogicalVolume *mothervolume) = 0;
 
+  //! logical volumes this detector placed into its mother volume (filled by Construct)
+  const std::vector<G4LogicalVolume *> &GetRootLogicalVolumes() const { return m_RootLogicalVolumes; }
+
   //! Optional PostConstruction call after all geometry is constructed
   virtual void PostConstruction(){};
 
@@ -69,6 +73,7 @@ class PHG4Detector
   bool m_OverlapCheck = false;
   int m_ColorIndex = 0;
   std::string m_Name;
+  std::vector<G4LogicalVolume *> m_RootLogicalVolumes;
 };
 
 #endif  // G4MAIN_PHG4DETECTOR_H
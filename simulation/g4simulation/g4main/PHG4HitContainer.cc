@@ -2,12 +2,14 @@
 
 #include "PHG4Hit.h"
 #include "PHG4Hitv1.h"
+#include "PHG4Hitv2.h"
 
 #include <phool/phool.h>
 
 #include <TSystem.h>
 
 #include <cstdlib>
+#include <functional>
 
 using namespace std;
 
@@ -25,16 +27,87 @@ PHG4HitContainer::PHG4HitContainer(const std::string &nodename)
 {
 }
 
+PHG4HitContainer::~PHG4HitContainer()
+{
+  PHG4HitContainer::Reset();
+  for (auto &slab : slabs)
+  {
+    delete[] slab;
+  }
+}
+
 void PHG4HitContainer::Reset()
 {
-  while (hitmap.begin() != hitmap.end())
+  // delete all hits which do not come from the pool
+  for (auto &iter : hitmap)
   {
-    delete hitmap.begin()->second;
-    hitmap.erase(hitmap.begin());
+    if (!isPoolHit(iter.second))
+    {
+      delete iter.second;
+    }
   }
+  hitmap.clear();
+
+  // rewind the pool, the slabs are reused in the next event
+  current_slab = 0;
+  used_in_slab = 0;
   return;
 }
 
+void PHG4HitContainer::Trim()
+{
+  if (!hitmap.empty())
+  {
+    return;
+  }
+  for (auto &slab : slabs)
+  {
+    delete[] slab;
+  }
+  slabs.clear();
+  current_slab = 0;
+  used_in_slab = 0;
+}
+
+PHG4Hitv2 *PHG4HitContainer::newHitv2()
+{
+  if (current_slab < slabs.size() && used_in_slab == (first_slab_size << current_slab))
+  {
+    ++current_slab;
+    used_in_slab = 0;
+  }
+  if (current_slab == slabs.size())
+  {
+    // slabs double in size, so only a handful are needed
+    slabs.push_back(new PHG4Hitv2[first_slab_size << current_slab]);
+  }
+  PHG4Hitv2 *hit = slabs[current_slab] + used_in_slab;
+  ++used_in_slab;
+
+  // hits recycled from a previous event are returned in default state
+  hit->Reset();
+  return hit;
+}
+
+bool PHG4HitContainer::isPoolHit(const PHG4Hit *hit) const
+{
+  if (!hit)
+  {
+    return false;
+  }
+  const std::less<const PHG4Hit *> less;
+  for (size_t i = 0; i < slabs.size(); ++i)
+  {
+    const PHG4Hit *begin = slabs[i];
+    const PHG4Hit *end = slabs[i] + (first_slab_size << i);
+    if (!less(hit, begin) && less(hit, end))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
 void PHG4HitContainer::identify(ostream &os) const
 {
   ConstIterator iter;
@@ -129,6 +202,34 @@ PHG4HitContainer::AddHit(const unsigned int detid, PHG4Hit *newhit)
   return hitmap.insert(std::make_pair(key, newhit)).first;
 }
 
+void PHG4HitContainer::AddHits(const unsigned int detid, const std::vector<PHG4Hit *> &newhits)
+{
+  if (newhits.empty())
+  {
+    return;
+  }
+  // the new keys follow the last key of this layer, all of them go right before
+  // the first existing hit with a larger key
+  PHG4HitDefs::keytype key = genkey(detid);
+  layers.insert(detid);
+  Iterator hint = hitmap.upper_bound(key);
+  for (PHG4Hit *newhit : newhits)
+  {
+    if (hint != hitmap.end() && hint->first == key)
+    {
+      cout << PHWHERE << " duplicate key: 0x"
+           << hex << key << dec
+           << " for detector " << detid
+           << " hitmap.size: " << hitmap.size()
+           << " exiting now" << endl;
+      exit(1);
+    }
+    newhit->set_hit_id(key);
+    hitmap.insert(hint, std::make_pair(key, newhit));
+    ++key;
+  }
+}
+
 PHG4HitContainer::ConstRange PHG4HitContainer::getHits(const unsigned int detid) const
 {
   PHG4HitDefs::keytype detidlong = detid;
@@ -186,7 +287,10 @@ void PHG4HitContainer::RemoveZeroEDep()
     PHG4Hit *hit = itr->second;
     if (hit->get_edep() == 0)
     {
-      delete hit;
+      if (!isPoolHit(hit))
+      {
+        delete hit;
+      }
       hitmap.erase(itr++);
     }
     else
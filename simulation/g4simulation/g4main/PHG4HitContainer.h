@@ -12,8 +12,10 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 class PHG4Hit;
+class PHG4Hitv2;
 
 class PHG4HitContainer : public PHObject
 {
@@ -28,10 +30,17 @@ class PHG4HitContainer : public PHObject
   PHG4HitContainer();  //< used only by ROOT for DST readback
   PHG4HitContainer(const std::string &nodename);
 
-  ~PHG4HitContainer() override {}
+  ~PHG4HitContainer() override;
+
+  // the hit pool cannot be shared
+  PHG4HitContainer(const PHG4HitContainer &) = delete;
+  PHG4HitContainer &operator=(const PHG4HitContainer &) = delete;
 
   void Reset() override;
 
+  //! frees the hit pool when no pool hit is in use
+  void Trim() override;
+
   void identify(std::ostream &os = std::cout) const override;
 
   //! container ID should follow definition of PHG4HitDefs::get_volume_id(DST nodename)
@@ -42,6 +51,15 @@ class PHG4HitContainer : public PHObject
 
   ConstIterator AddHit(const unsigned int detid, PHG4Hit *newhit);
 
+  //! same as calling AddHit(detid, hit) for each hit, but the keys are generated
+  //! and the hits inserted in one pass
+  void AddHits(const unsigned int detid, const std::vector<PHG4Hit *> &newhits);
+
+  //! create a new hit to be handed to AddHit.
+  //! It is served from an event scoped pool and stays owned by the container
+  //! even if it is never added. Not thread safe
+  PHG4Hitv2 *newHitv2();
+
   Iterator findOrAddHit(PHG4HitDefs::keytype key);
 
   PHG4Hit *findHit(PHG4HitDefs::keytype key);
@@ -75,6 +93,18 @@ class PHG4HitContainer : public PHObject
   Map hitmap;
   std::set<unsigned int> layers;  // layers is not reset since layers must not change event by event
 
+  //! true if the hit was served by newHitv2()
+  bool isPoolHit(const PHG4Hit *hit) const;
+
+  //! hit pool, slab i holds (first_slab_size << i) hits.
+  //! Slabs are kept between events, Reset() only rewinds the pool.
+  //! Hits read back from file or added from the heap are still deleted one by one
+  std::vector<PHG4Hitv2 *> slabs;  //! transient
+  size_t current_slab = 0;         //! transient
+  size_t used_in_slab = 0;         //! transient
+
+  static constexpr size_t first_slab_size = 4096;
+
   ClassDefOverride(PHG4HitContainer, 1)
 };
 
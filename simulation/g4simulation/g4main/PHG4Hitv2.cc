@@ -0,0 +1,222 @@
+#include "PHG4Hitv2.h"
+
+#include <limits>
+#include <string>
+#include <utility>
+
+namespace
+{
+  //! properties stored in fixed members, in the order of PHG4Hitv2::fixed_prop
+  const PHG4Hit::PROPERTY fixed_props[] = {
+      PHG4Hit::prop_eion,
+      PHG4Hit::prop_light_yield,
+      PHG4Hit::prop_px_0,
+      PHG4Hit::prop_px_1,
+      PHG4Hit::prop_py_0,
+      PHG4Hit::prop_py_1,
+      PHG4Hit::prop_pz_0,
+      PHG4Hit::prop_pz_1,
+      PHG4Hit::prop_path_length,
+      PHG4Hit::prop_layer,
+      PHG4Hit::prop_scint_id};
+}  // namespace
+
+PHG4Hitv2::PHG4Hitv2(const PHG4Hit* g4hit)
+{
+  CopyFrom(g4hit);
+}
+
+void PHG4Hitv2::Reset()
+{
+  PHG4Hitv1::Reset();
+  fixed_prop_set = 0;
+}
+
+int PHG4Hitv2::fixed_index(const PROPERTY prop_id)
+{
+  switch (prop_id)
+  {
+  case prop_eion:
+    return 0;
+  case prop_light_yield:
+    return 1;
+  case prop_px_0:
+    return 2;
+  case prop_px_1:
+    return 3;
+  case prop_py_0:
+    return 4;
+  case prop_py_1:
+    return 5;
+  case prop_pz_0:
+    return 6;
+  case prop_pz_1:
+    return 7;
+  case prop_path_length:
+    return 8;
+  case prop_layer:
+    return 9;
+  case prop_scint_id:
+    return 10;
+  default:
+    return -1;
+  }
+}
+
+bool PHG4Hitv2::has_property(const PROPERTY prop_id) const
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0)
+  {
+    return PHG4Hitv1::has_property(prop_id);
+  }
+  return fixed_prop_set & (1U << index);
+}
+
+// properties of the wrong type are passed on to PHG4Hitv1, which reports them
+float PHG4Hitv2::get_property_float(const PROPERTY prop_id) const
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_float))
+  {
+    return PHG4Hitv1::get_property_float(prop_id);
+  }
+  if (fixed_prop_set & (1U << index))
+  {
+    return u_property(fixed_prop[index]).fdata;
+  }
+  return std::numeric_limits<float>::quiet_NaN();
+}
+
+int PHG4Hitv2::get_property_int(const PROPERTY prop_id) const
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_int))
+  {
+    return PHG4Hitv1::get_property_int(prop_id);
+  }
+  if (fixed_prop_set & (1U << index))
+  {
+    return u_property(fixed_prop[index]).idata;
+  }
+  return std::numeric_limits<int>::min();
+}
+
+unsigned int
+PHG4Hitv2::get_property_uint(const PROPERTY prop_id) const
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_uint))
+  {
+    return PHG4Hitv1::get_property_uint(prop_id);
+  }
+  if (fixed_prop_set & (1U << index))
+  {
+    return u_property(fixed_prop[index]).uidata;
+  }
+  return std::numeric_limits<unsigned int>::max();
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const float value)
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_float))
+  {
+    PHG4Hitv1::set_property(prop_id, value);
+    return;
+  }
+  fixed_prop[index] = u_property(value).get_storage();
+  fixed_prop_set |= (1U << index);
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const int value)
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_int))
+  {
+    PHG4Hitv1::set_property(prop_id, value);
+    return;
+  }
+  fixed_prop[index] = u_property(value).get_storage();
+  fixed_prop_set |= (1U << index);
+}
+
+void PHG4Hitv2::set_property(const PROPERTY prop_id, const unsigned int value)
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0 || !check_property(prop_id, type_uint))
+  {
+    PHG4Hitv1::set_property(prop_id, value);
+    return;
+  }
+  fixed_prop[index] = u_property(value).get_storage();
+  fixed_prop_set |= (1U << index);
+}
+
+unsigned int
+PHG4Hitv2::get_property_nocheck(const PROPERTY prop_id) const
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0)
+  {
+    return PHG4Hitv1::get_property_nocheck(prop_id);
+  }
+  if (fixed_prop_set & (1U << index))
+  {
+    return fixed_prop[index];
+  }
+  return std::numeric_limits<unsigned int>::max();
+}
+
+void PHG4Hitv2::set_property_nocheck(const PROPERTY prop_id, const unsigned int ui)
+{
+  const int index = fixed_index(prop_id);
+  if (index < 0)
+  {
+    PHG4Hitv1::set_property_nocheck(prop_id, ui);
+    return;
+  }
+  fixed_prop[index] = ui;
+  fixed_prop_set |= (1U << index);
+}
+
+void PHG4Hitv2::print_fixed(std::ostream& os) const
+{
+  for (int i = 0; i < n_fixed; i++)
+  {
+    if (!(fixed_prop_set & (1U << i)))
+    {
+      continue;
+    }
+    PROPERTY prop_id = fixed_props[i];
+    std::pair<const std::string, PROPERTY_TYPE> property_info = get_property_info(prop_id);
+    os << "\t" << prop_id << ":\t" << property_info.first << " = \t";
+    switch (property_info.second)
+    {
+    case type_int:
+      os << get_property_int(prop_id);
+      break;
+    case type_uint:
+      os << get_property_uint(prop_id);
+      break;
+    case type_float:
+      os << get_property_float(prop_id);
+      break;
+    default:
+      os << " unknown type ";
+    }
+    os << std::endl;
+  }
+}
+
+void PHG4Hitv2::print() const
+{
+  PHG4Hitv1::print();
+  print_fixed(std::cout);
+}
+
+void PHG4Hitv2::identify(std::ostream& os) const
+{
+  PHG4Hitv1::identify(os);
+  print_fixed(os);
+}
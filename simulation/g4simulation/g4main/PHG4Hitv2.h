@@ -0,0 +1,52 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4HITV2_H
+#define G4MAIN_PHG4HITV2_H
+
+#include "PHG4Hitv1.h"
+
+#include <cstdint>
+#include <iostream>
+
+// same as PHG4Hitv1, but the properties most stepping actions set (ionization energy,
+// light yield, momenta, path length, layer and scintillator id) are stored in
+// fixed members instead of the property map, so filling a hit does not allocate.
+// All other properties still go to the property map
+class PHG4Hitv2 : public PHG4Hitv1
+{
+ public:
+  PHG4Hitv2() = default;
+  explicit PHG4Hitv2(const PHG4Hit* g4hit);
+  ~PHG4Hitv2() override = default;
+  void identify(std::ostream& os = std::cout) const override;
+  void Reset() override;
+
+  void print() const override;
+
+  bool has_property(const PROPERTY prop_id) const override;
+  float get_property_float(const PROPERTY prop_id) const override;
+  int get_property_int(const PROPERTY prop_id) const override;
+  unsigned int get_property_uint(const PROPERTY prop_id) const override;
+  void set_property(const PROPERTY prop_id, const float value) override;
+  void set_property(const PROPERTY prop_id, const int value) override;
+  void set_property(const PROPERTY prop_id, const unsigned int value) override;
+
+ protected:
+  unsigned int get_property_nocheck(const PROPERTY prop_id) const override;
+  void set_property_nocheck(const PROPERTY prop_id, const unsigned int ui) override;
+
+ private:
+  //! position of a property in fixed_prop, -1 if it is kept in the property map
+  static int fixed_index(const PROPERTY prop_id);
+
+  void print_fixed(std::ostream& os) const;
+
+  static const int n_fixed = 11;
+  prop_storage_t fixed_prop[n_fixed] = {0};
+  //! bit i is set if fixed_prop[i] has been set
+  uint16_t fixed_prop_set = 0;
+
+  ClassDefOverride(PHG4Hitv2, 1)
+};
+
+#endif
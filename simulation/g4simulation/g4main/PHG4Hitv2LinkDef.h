@@ -0,0 +1,5 @@
+#ifdef __CINT__
+
+#pragma link C++ class PHG4Hitv2 + ;
+
+#endif /* __CINT__ */
@@ -1,6 +1,10 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4SteppingAction.h"
 
+#include <Geant4/G4Step.hh>
+#include <Geant4/G4StepPoint.hh>
+#include <Geant4/G4VTouchable.hh>
+
 PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
 {
   while (actions_.begin() != actions_.end())
@@ -10,11 +14,39 @@ PHG4PhenixSteppingAction::~PHG4PhenixSteppingAction()
   }
 }
 
+//_________________________________________________________________
+void PHG4PhenixSteppingAction::SetVolumeDispatch(const std::map<const G4VPhysicalVolume*, std::vector<PHG4SteppingAction*>>& dispatch, const std::vector<PHG4SteppingAction*>& always)
+{
+  m_VolumeDispatch = true;
+  m_VolumeActions = dispatch;
+  m_AlwaysActions = always;
+  m_LastTopVolume = nullptr;
+  m_LastActions = &m_AlwaysActions;
+}
+
 //_________________________________________________________________
 void PHG4PhenixSteppingAction::UserSteppingAction(const G4Step* aStep)
 {
   // loop over registered actions, and process
   bool hit_was_used = false;
+  if (m_VolumeDispatch)
+  {
+    // the pre step point decides, like in the subsystem stepping actions
+    const G4VTouchable* touch = aStep->GetPreStepPoint()->GetTouchable();
+    const int depth = touch->GetHistoryDepth();
+    const G4VPhysicalVolume* topvolume = (depth > 0) ? touch->GetVolume(depth - 1) : nullptr;
+    if (topvolume != m_LastTopVolume)
+    {
+      auto iter = m_VolumeActions.find(topvolume);
+      m_LastActions = (iter == m_VolumeActions.end()) ? &m_AlwaysActions : &iter->second;
+      m_LastTopVolume = topvolume;
+    }
+    for (PHG4SteppingAction* action : *m_LastActions)
+    {
+      hit_was_used |= action->UserSteppingAction(aStep, hit_was_used);
+    }
+    return;
+  }
   for (ActionList::const_iterator iter = actions_.begin(); iter != actions_.end(); ++iter)
   {
     if (*iter)
@@ -4,9 +4,13 @@
 #define G4MAIN_PHG4PHENIXSTEPPINGACTION_H
 
 #include <Geant4/G4UserSteppingAction.hh>
+
 #include <list>
+#include <map>
+#include <vector>
 
 class G4Step;
+class G4VPhysicalVolume;
 class PHG4SteppingAction;
 
 class PHG4PhenixSteppingAction : public G4UserSteppingAction
@@ -27,12 +31,28 @@ class PHG4PhenixSteppingAction : public G4UserSteppingAction
     }
   }
 
+  //! only call the actions of the subsystems inside the top level (world daughter) volume of the step.
+  /*!
+  dispatch gives the actions (in registration order) for each top level volume,
+  always the ones called in the world and in volumes not in the map
+  */
+  void SetVolumeDispatch(const std::map<const G4VPhysicalVolume*, std::vector<PHG4SteppingAction*>>& dispatch, const std::vector<PHG4SteppingAction*>& always);
+
   void UserSteppingAction(const G4Step*) override;
 
  private:
   //! list of subsystem specific stepping actions
   typedef std::list<PHG4SteppingAction*> ActionList;
   ActionList actions_;
+
+  //! volume dispatch
+  bool m_VolumeDispatch = false;
+  std::map<const G4VPhysicalVolume*, std::vector<PHG4SteppingAction*>> m_VolumeActions;
+  std::vector<PHG4SteppingAction*> m_AlwaysActions;
+
+  //! steps mostly stay in the same top level volume, cache the last lookup
+  const G4VPhysicalVolume* m_LastTopVolume = nullptr;
+  const std::vector<PHG4SteppingAction*>* m_LastActions = nullptr;
 };
 
 #endif
@@ -3,6 +3,7 @@
 #include "Fun4AllMessenger.h"
 #include "G4TBMagneticFieldSetup.hh"
 #include "PHG4DisplayAction.h"
+#include "PHG4Detector.h"
 #include "PHG4InEvent.h"
 #include "PHG4PhenixDetector.h"
 #include "PHG4PhenixDisplayAction.h"
@@ -11,6 +12,7 @@
 #include "PHG4PhenixSteppingAction.h"
 #include "PHG4PhenixTrackingAction.h"
 #include "PHG4PrimaryGeneratorAction.h"
+#include "PHG4SteppingAction.h"
 #include "PHG4Subsystem.h"
 #include "PHG4TrackingAction.h"
 #include "PHG4UIsession.h"
@@ -46,6 +48,8 @@
 #include <phool/phool.h>  // for PHWHERE
 #include <phool/recoConsts.h>
 
+#include <TDirectory.h>
+#include <TObjString.h>
 #include <TSystem.h>  // for TSystem, gSystem
 
 #include <CLHEP/Random/Random.h>
@@ -54,8 +58,10 @@
 #include <Geant4/G4Cerenkov.hh>
 #include <Geant4/G4Element.hh>       // for G4Element
 #include <Geant4/G4EventManager.hh>  // for G4EventManager
+#include <Geant4/G4FastSimulationPhysics.hh>
 #include <Geant4/G4HadronicProcessStore.hh>
 #include <Geant4/G4IonisParamMat.hh>  // for G4IonisParamMat
+#include <Geant4/G4LogicalVolume.hh>
 #include <Geant4/G4LossTableManager.hh>
 #include <Geant4/G4Material.hh>
 #include <Geant4/G4NistManager.hh>
@@ -69,6 +75,9 @@
 #include <Geant4/G4ParticleTable.hh>
 #include <Geant4/G4PhotoElectricEffect.hh>  // for G4PhotoElectricEffect
 #include <Geant4/G4ProcessManager.hh>
+#include <Geant4/G4ProductionCuts.hh>
+#include <Geant4/G4Region.hh>
+#include <Geant4/G4RegionStore.hh>
 #include <Geant4/G4RunManager.hh>
 #include <Geant4/G4Scintillation.hh>
 #include <Geant4/G4StepLimiterPhysics.hh>
@@ -78,7 +87,10 @@
 #include <Geant4/G4UIExecutive.hh>
 #include <Geant4/G4UImanager.hh>
 #include <Geant4/G4UImessenger.hh>          // for G4UImessenger
+#include <Geant4/G4UserLimits.hh>
+#include <Geant4/G4VFastSimulationModel.hh>
 #include <Geant4/G4VModularPhysicsList.hh>  // for G4VModularPhysicsList
+#include <Geant4/G4VPhysicalVolume.hh>
 #include <Geant4/G4Version.hh>
 #include <Geant4/G4VisExecutive.hh>
 #include <Geant4/G4VisManager.hh>  // for G4VisManager
@@ -97,11 +109,17 @@
 #include <Geant4/QGSP_INCLXX_HP.hh>
 
 #include <cassert>
+#include <cfloat>
 #include <cstdlib>
 #include <exception>  // for exception
 #include <filesystem>
+#include <functional>
 #include <iostream>   // for operator<<, endl
+#include <map>
 #include <memory>
+#include <set>
+#include <sstream>
+#include <vector>
 
 class G4EmSaturation;
 class G4TrackingManager;
@@ -251,6 +269,15 @@ int PHG4Reco::Init(PHCompositeNode *topNode)
   }
 
   myphysicslist->RegisterPhysics(new G4StepLimiterPhysics());
+  if (!m_FastSimulationModels.empty())
+  {
+    // the models are attached to the subsystem regions in InitRun
+    G4FastSimulationPhysics *fastsimphysics = new G4FastSimulationPhysics();
+    fastsimphysics->ActivateFastSimulation("e-");
+    fastsimphysics->ActivateFastSimulation("e+");
+    fastsimphysics->ActivateFastSimulation("gamma");
+    myphysicslist->RegisterPhysics(fastsimphysics);
+  }
   // initialize cuts so we can ask the world region for it's default
   // cuts to propagate them to other regions in DefineRegions()
   myphysicslist->SetCutsWithDefault();
@@ -488,6 +515,9 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   // initialize
   m_RunManager->Initialize();
 
+  // needs the constructed geometry
+  DefineSubsystemRegions();
+
 #if G4VERSION_NUMBER >= 1033
   G4EmSaturation *emSaturation = G4LossTableManager::Instance()->EmSaturation();
   if (!emSaturation)
@@ -576,14 +606,30 @@ int PHG4Reco::InitRun(PHCompositeNode *topNode)
   // Geometry export to DST
   if (m_SaveDstGeometryFlag)
   {
-    const std::string filename = PHGeomUtility::GenerateGeometryFileName("gdml");
-    std::cout << "PHG4Reco::InitRun - export geometry to DST via tmp file " << filename << std::endl;
+    // with a geometry cache, the same geometry is read back without going through GDML
+    std::string geometry_hash;
+    if (!PHGeomUtility::GetGeometryCacheDir().empty())
+    {
+      geometry_hash = PHG4GDMLUtility::Get_Geometry_Hash(m_Detector->GetPhysicalVolume(), topNode);
+    }
 
-    Dump_GDML(filename);
+    if (PHGeomUtility::ImportCachedGeometry(topNode, geometry_hash))
+    {
+      std::cout << "PHG4Reco::InitRun - export geometry to DST from cache, hash " << geometry_hash << std::endl;
+    }
+    else
+    {
+      const std::string filename = PHGeomUtility::GenerateGeometryFileName("gdml");
+      std::cout << "PHG4Reco::InitRun - export geometry to DST via tmp file " << filename << std::endl;
+
+      Dump_GDML(filename);
 
-    PHGeomUtility::ImportGeomFile(topNode, filename);
+      PHGeomUtility::ImportGeomFile(topNode, filename);
 
-    PHGeomUtility::RemoveGeometryFile(filename);
+      PHGeomUtility::RemoveGeometryFile(filename);
+
+      PHGeomUtility::CacheGeometry(topNode, geometry_hash);
+    }
   }
 
   if (Verbosity() > 0)
@@ -726,6 +772,32 @@ int PHG4Reco::ResetEvent(PHCompositeNode *topNode)
   return 0;
 }
 
+int PHG4Reco::SaveCheckpoint(TDirectory *dir)
+{
+  std::ostringstream engine;
+  G4Random::getTheEngine()->put(engine);
+  TObjString state(engine.str().c_str());
+  dir->WriteTObject(&state, "G4RandomEngine");
+  return 0;
+}
+
+int PHG4Reco::RestoreCheckpoint(TDirectory *dir)
+{
+  TObjString *state = dynamic_cast<TObjString *>(dir->Get("G4RandomEngine"));
+  if (!state)
+  {
+    std::cout << PHWHERE << " no Geant4 random engine state in checkpoint" << std::endl;
+    return -1;
+  }
+  std::istringstream engine(state->GetString().Data());
+  G4Random::getTheEngine()->get(engine);
+  if (PHRandomSeed::Verbosity() >= 2)
+  {
+    G4Random::showEngineStatus();
+  }
+  return 0;
+}
+
 void PHG4Reco::Print(const std::string &what) const
 {
   for (SubsysReco *reco : m_SubsystemList)
@@ -1050,6 +1122,192 @@ void PHG4Reco::DefineRegions()
   return;
 }
 
+G4Region *PHG4Reco::GetSubsystemRegion(PHG4Subsystem *subsys)
+{
+  const std::string regionname = "REGION_" + subsys->Name();
+  G4Region *region = G4RegionStore::GetInstance()->GetRegion(regionname, false);
+  if (region)
+  {
+    return region;
+  }
+  PHG4Detector *detector = subsys->GetDetector();
+  if (!detector || detector->GetRootLogicalVolumes().empty())
+  {
+    return nullptr;
+  }
+  region = new G4Region(regionname);
+  for (G4LogicalVolume *logvol : detector->GetRootLogicalVolumes())
+  {
+    if (logvol->IsRootRegion())
+    {
+      std::cout << PHWHERE << " " << logvol->GetName() << " is already in region "
+                << logvol->GetRegion()->GetName() << ", not added to " << regionname << std::endl;
+      continue;
+    }
+    region->AddRootLogicalVolume(logvol);
+  }
+  return region;
+}
+
+void PHG4Reco::DefineSubsystemRegions()
+{
+  // production cuts of the subsystem regions
+  for (const auto &[name, cut] : m_RegionCuts)
+  {
+    PHG4Subsystem *subsys = getSubsystem(name);
+    G4Region *region = (subsys) ? GetSubsystemRegion(subsys) : nullptr;
+    if (!region)
+    {
+      std::cout << PHWHERE << " no volumes for subsystem " << name << ", cannot set its production cuts" << std::endl;
+      gSystem->Exit(1);
+    }
+    G4ProductionCuts *cuts = new G4ProductionCuts();
+    cuts->SetProductionCut(cut * cm);
+    region->SetProductionCuts(cuts);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4Reco::InitRun - range cut " << cut << " cm in " << region->GetName() << std::endl;
+    }
+  }
+
+  // fast simulation, the model registers itself with the G4FastSimulationManager of the region
+  for (const auto &[name, factory] : m_FastSimulationModels)
+  {
+    PHG4Subsystem *subsys = getSubsystem(name);
+    G4Region *region = (subsys) ? GetSubsystemRegion(subsys) : nullptr;
+    G4VFastSimulationModel *model = (region) ? factory(region) : nullptr;
+    if (!model)
+    {
+      std::cout << PHWHERE << " cannot create fast simulation model for subsystem " << name << std::endl;
+      gSystem->Exit(1);
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4Reco::InitRun - fast simulation model " << model->GetName() << " in " << region->GetName() << std::endl;
+    }
+  }
+
+  if (!m_RegionCuts.empty() || !m_FastSimulationModels.empty())
+  {
+    m_RunManager->PhysicsHasBeenModified();
+  }
+
+  // kill low energy tracks in passive material, G4UserSpecialCuts comes with G4StepLimiterPhysics.
+  // Volumes of active subsystems are not touched, also not if they are inside a passive mother
+  if (m_PassiveMinEkin > 0)
+  {
+    std::set<G4LogicalVolume *> active;
+    for (PHG4Subsystem *g4sub : m_SubsystemList)
+    {
+      if (g4sub->GetSteppingAction() && g4sub->GetDetector())
+      {
+        active.insert(g4sub->GetDetector()->GetRootLogicalVolumes().begin(), g4sub->GetDetector()->GetRootLogicalVolumes().end());
+      }
+    }
+    G4UserLimits *limits = new G4UserLimits(DBL_MAX, DBL_MAX, DBL_MAX, m_PassiveMinEkin * GeV);
+    std::set<G4LogicalVolume *> visited;
+    std::function<void(G4LogicalVolume *)> setlimits = [&](G4LogicalVolume *logvol)
+    {
+      if (active.find(logvol) != active.end() || !visited.insert(logvol).second)
+      {
+        return;
+      }
+      // keep step limits set by the detector
+      if (!logvol->GetUserLimits())
+      {
+        logvol->SetUserLimits(limits);
+      }
+      for (size_t i = 0; i < logvol->GetNoDaughters(); ++i)
+      {
+        setlimits(logvol->GetDaughter(i)->GetLogicalVolume());
+      }
+    };
+    for (PHG4Subsystem *g4sub : m_SubsystemList)
+    {
+      if (!g4sub->GetSteppingAction() && g4sub->GetDetector())
+      {
+        for (G4LogicalVolume *logvol : g4sub->GetDetector()->GetRootLogicalVolumes())
+        {
+          setlimits(logvol);
+        }
+      }
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4Reco::InitRun - killing tracks below " << m_PassiveMinEkin << " GeV in " << visited.size() << " passive volumes" << std::endl;
+    }
+  }
+
+  // stepping action dispatch on the top level volume of a step. Subsystems without
+  // volumes get all steps, so do steps in the world and in volumes of no subsystem
+  if (m_SteppingDispatch && !m_disableUserActions)
+  {
+    G4LogicalVolume *world = m_Detector->GetPhysicalVolume()->GetLogicalVolume();
+    std::map<const G4VPhysicalVolume *, std::set<G4LogicalVolume *>> toplevel;
+    for (size_t i = 0; i < world->GetNoDaughters(); ++i)
+    {
+      std::set<G4LogicalVolume *> &volumes = toplevel[world->GetDaughter(i)];
+      std::vector<G4LogicalVolume *> todo = {world->GetDaughter(i)->GetLogicalVolume()};
+      while (!todo.empty())
+      {
+        G4LogicalVolume *logvol = todo.back();
+        todo.pop_back();
+        if (!volumes.insert(logvol).second)
+        {
+          continue;
+        }
+        for (size_t j = 0; j < logvol->GetNoDaughters(); ++j)
+        {
+          todo.push_back(logvol->GetDaughter(j)->GetLogicalVolume());
+        }
+      }
+    }
+
+    // same order as the registration in the stepping action
+    std::map<const G4VPhysicalVolume *, std::vector<PHG4SteppingAction *>> dispatch;
+    std::vector<PHG4SteppingAction *> always;
+    for (const auto &iter : toplevel)
+    {
+      dispatch[iter.first];
+    }
+    for (PHG4Subsystem *g4sub : m_SubsystemList)
+    {
+      PHG4SteppingAction *action = g4sub->GetSteppingAction();
+      if (!action)
+      {
+        continue;
+      }
+      PHG4Detector *detector = g4sub->GetDetector();
+      if (!detector || detector->GetRootLogicalVolumes().empty())
+      {
+        always.push_back(action);
+        for (auto &[topvolume, actions] : dispatch)
+        {
+          actions.push_back(action);
+        }
+        continue;
+      }
+      for (const auto &[topvolume, volumes] : toplevel)
+      {
+        for (G4LogicalVolume *logvol : detector->GetRootLogicalVolumes())
+        {
+          if (volumes.find(logvol) != volumes.end())
+          {
+            dispatch[topvolume].push_back(action);
+            break;
+          }
+        }
+      }
+    }
+    m_SteppingAction->SetVolumeDispatch(dispatch, always);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4Reco::InitRun - stepping action dispatch for " << dispatch.size() << " top level volumes, "
+                << always.size() << " actions called everywhere" << std::endl;
+    }
+  }
+}
+
 PHG4Subsystem *
 PHG4Reco::getSubsystem(const std::string &name)
 {
@@ -9,14 +9,19 @@
 
 #include <phfield/PHFieldConfig.h>
 
+#include <functional>
 #include <list>
+#include <map>
 #include <string>  // for string
+#include <vector>
 
 // Forward declerations
+class G4Region;
 class G4RunManager;
 class G4TBMagneticFieldSetup;
 class G4UImanager;
 class G4UImessenger;
+class G4VFastSimulationModel;
 class G4VisManager;
 class PHCompositeNode;
 class PHG4DisplayAction;
@@ -28,6 +33,7 @@ class PHG4PhenixTrackingAction;
 class PHG4PrimaryGeneratorAction;
 class PHG4Subsystem;
 class PHG4UIsession;
+class TDirectory;
 
 /*!
   \class   PHG4Reco
@@ -62,6 +68,10 @@ class PHG4Reco : public SubsysReco
   //! Clean up after each event.
   int ResetEvent(PHCompositeNode *) override;
 
+  //! state of the Geant4 random engine, a job resumed from a checkpoint simulates the same events
+  int SaveCheckpoint(TDirectory *dir) override;
+  int RestoreCheckpoint(TDirectory *dir) override;
+
   //! print info
   void Print(const std::string &what = std::string()) const override;
 
@@ -146,11 +156,28 @@ class PHG4Reco : public SubsysReco
     if (!EvtGenDecayFile.empty()) CustomizeDecay = true;
   }
 
+  //! put the volumes of a subsystem into their own region REGION_<subsystem> with this range cut [cm] for gammas, e-, e+ and protons
+  void set_region_cuts(const std::string &subsystem, const double cut) { m_RegionCuts[subsystem] = cut; }
+
+  //! kill tracks below this kinetic energy [GeV] in subsystems without stepping action (passive material), 0 disables
+  void set_passive_min_ekin(const double ekin) { m_PassiveMinEkin = ekin; }
+
+  //! only call the stepping actions of the subsystems inside the top level volume of a step
+  void set_stepping_dispatch(const bool b = true) { m_SteppingDispatch = b; }
+
+  //! factory of a fast simulation model (parametrized or library showers) for the region of a subsystem
+  typedef std::function<G4VFastSimulationModel *(G4Region *)> FastSimulationModelFactory;
+
+  //! attach a fast simulation model to REGION_<subsystem>, fast simulation is enabled for e-, e+ and gammas
+  void add_fast_simulation_model(const std::string &subsystem, const FastSimulationModelFactory &factory) { m_FastSimulationModels.push_back(std::make_pair(subsystem, factory)); }
+
  private:
   static void g4guithread(void *ptr);
   int InitUImanager();
   void DefineMaterials();
   void DefineRegions();
+  void DefineSubsystemRegions();
+  G4Region *GetSubsystemRegion(PHG4Subsystem *subsys);
 
   float m_MagneticField {std::numeric_limits<float>::signaling_NaN()};
   float m_MagneticFieldRescale = 1.0;
@@ -220,6 +247,12 @@ class PHG4Reco : public SubsysReco
 
   bool m_SaveDstGeometryFlag = true;
   bool m_disableUserActions = false;
+
+  //! subsystem regions, passive track killing and fast simulation
+  std::map<std::string, double> m_RegionCuts;
+  double m_PassiveMinEkin = 0;
+  bool m_SteppingDispatch = false;
+  std::vector<std::pair<std::string, FastSimulationModelFactory>> m_FastSimulationModels;
 };
 
 #endif
@@ -0,0 +1,249 @@
+#include "PHG4ShowerLibrary.h"
+
+#include <TAxis.h>
+#include <TFile.h>
+#include <TH3.h>
+#include <TTree.h>
+
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+PHG4ShowerLibrary::PHG4ShowerLibrary()
+{
+  set_binning(14, 0.5, 64., 24, -1.2, 1.2, 4, 0.6);
+}
+
+PHG4ShowerLibrary::~PHG4ShowerLibrary() = default;
+
+void PHG4ShowerLibrary::set_binning(const int nebins, const double emin, const double emax,
+                                    const int netabins, const double etamin, const double etamax,
+                                    const int nanglebins, const double cosanglemin)
+{
+  std::vector<double> ebins(nebins + 1);
+  for (int i = 0; i <= nebins; ++i)
+  {
+    ebins[i] = emin * std::pow(emax / emin, static_cast<double>(i) / nebins);
+  }
+  std::vector<double> etabins(netabins + 1);
+  for (int i = 0; i <= netabins; ++i)
+  {
+    etabins[i] = etamin + (etamax - etamin) * i / netabins;
+  }
+  std::vector<double> anglebins(nanglebins + 1);
+  for (int i = 0; i <= nanglebins; ++i)
+  {
+    anglebins[i] = cosanglemin + (1. - cosanglemin) * i / nanglebins;
+  }
+  // the largest cosine belongs to the last bin
+  anglebins.back() = 1. + 1e-6;
+  m_Binning = std::make_unique<TH3F>("binning", "shower library binning;E [GeV];#eta;cos(#alpha)",
+                                     nebins, ebins.data(), netabins, etabins.data(), nanglebins, anglebins.data());
+  m_Binning->SetDirectory(nullptr);
+  m_Showers.assign(kNParticleTypes * nbins_per_type(), std::vector<Shower>());
+}
+
+int PHG4ShowerLibrary::nbins_per_type() const
+{
+  return m_Binning->GetNbinsX() * m_Binning->GetNbinsY() * m_Binning->GetNbinsZ();
+}
+
+int PHG4ShowerLibrary::particle_type(const int pdg)
+{
+  switch (std::abs(pdg))
+  {
+  case 11:
+    return kElectron;
+  case 22:
+    return kPhoton;
+  default:
+    return -1;
+  }
+}
+
+int PHG4ShowerLibrary::find_bin(const int type, const double energy, const double eta, const double cosangle) const
+{
+  if (type < 0 || type >= kNParticleTypes)
+  {
+    return -1;
+  }
+  const int ie = m_Binning->GetXaxis()->FindFixBin(energy);
+  const int ieta = m_Binning->GetYaxis()->FindFixBin(eta);
+  const int iangle = m_Binning->GetZaxis()->FindFixBin(cosangle);
+  if (ie < 1 || ie > m_Binning->GetNbinsX() ||
+      ieta < 1 || ieta > m_Binning->GetNbinsY() ||
+      iangle < 1 || iangle > m_Binning->GetNbinsZ())
+  {
+    return -1;
+  }
+  return type * nbins_per_type() + ((ie - 1) * m_Binning->GetNbinsY() + (ieta - 1)) * m_Binning->GetNbinsZ() + (iangle - 1);
+}
+
+bool PHG4ShowerLibrary::add(const int type, Shower &&shower)
+{
+  const int bin = find_bin(type, shower.energy, shower.eta, shower.cosangle);
+  if (bin < 0 || m_Showers[bin].size() >= m_MaxShowers)
+  {
+    return false;
+  }
+  m_Showers[bin].push_back(std::move(shower));
+  return true;
+}
+
+size_t PHG4ShowerLibrary::nshowers(const int bin) const
+{
+  return (bin < 0) ? 0 : m_Showers[bin].size();
+}
+
+size_t PHG4ShowerLibrary::nshowers() const
+{
+  size_t n = 0;
+  for (const auto &showers : m_Showers)
+  {
+    n += showers.size();
+  }
+  return n;
+}
+
+namespace
+{
+  // one tree entry per shower, the spots are stored as vectors
+  struct ShowerBranches
+  {
+    int type = 0;
+    float energy = 0;
+    float eta = 0;
+    float cosangle = 0;
+    std::array<std::vector<float> *, 9> values{};
+    std::vector<int> *pdg = nullptr;
+  };
+
+  const std::array<std::string, 9> value_names = {"u0", "v0", "w0", "u1", "v1", "w1", "dt", "edep", "eion"};
+}  // namespace
+
+bool PHG4ShowerLibrary::write(const std::string &filename) const
+{
+  TFile f(filename.c_str(), "RECREATE");
+  if (!f.IsOpen())
+  {
+    std::cout << "PHG4ShowerLibrary::write - cannot open " << filename << std::endl;
+    return false;
+  }
+  m_Binning->Write();
+
+  ShowerBranches branches;
+  std::array<std::vector<float>, 9> values;
+  std::vector<int> pdg;
+  TTree *tree = new TTree("showers", "shower library");
+  tree->Branch("type", &branches.type);
+  tree->Branch("energy", &branches.energy);
+  tree->Branch("eta", &branches.eta);
+  tree->Branch("cosangle", &branches.cosangle);
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    tree->Branch(value_names[i].c_str(), &values[i]);
+  }
+  tree->Branch("pdg", &pdg);
+
+  for (size_t bin = 0; bin < m_Showers.size(); ++bin)
+  {
+    branches.type = bin / nbins_per_type();
+    for (const auto &shower : m_Showers[bin])
+    {
+      branches.energy = shower.energy;
+      branches.eta = shower.eta;
+      branches.cosangle = shower.cosangle;
+      for (auto &value : values)
+      {
+        value.clear();
+      }
+      pdg.clear();
+      for (const auto &spot : shower.spots)
+      {
+        for (int j = 0; j < 3; ++j)
+        {
+          values[j].push_back(spot.pre[j]);
+          values[3 + j].push_back(spot.post[j]);
+        }
+        values[6].push_back(spot.dt);
+        values[7].push_back(spot.edep);
+        values[8].push_back(spot.eion);
+        pdg.push_back(spot.pdg);
+      }
+      tree->Fill();
+    }
+  }
+  tree->Write();
+  f.Close();
+  return true;
+}
+
+bool PHG4ShowerLibrary::read(const std::string &filename)
+{
+  TFile f(filename.c_str(), "READ");
+  if (!f.IsOpen())
+  {
+    std::cout << "PHG4ShowerLibrary::read - cannot open " << filename << std::endl;
+    return false;
+  }
+  TH3F *binning = dynamic_cast<TH3F *>(f.Get("binning"));
+  TTree *tree = dynamic_cast<TTree *>(f.Get("showers"));
+  if (!binning || !tree)
+  {
+    std::cout << "PHG4ShowerLibrary::read - " << filename << " is not a shower library" << std::endl;
+    return false;
+  }
+  binning->SetDirectory(nullptr);
+  m_Binning.reset(binning);
+  m_Showers.assign(kNParticleTypes * nbins_per_type(), std::vector<Shower>());
+
+  ShowerBranches branches;
+  tree->SetBranchAddress("type", &branches.type);
+  tree->SetBranchAddress("energy", &branches.energy);
+  tree->SetBranchAddress("eta", &branches.eta);
+  tree->SetBranchAddress("cosangle", &branches.cosangle);
+  for (size_t i = 0; i < branches.values.size(); ++i)
+  {
+    tree->SetBranchAddress(value_names[i].c_str(), &branches.values[i]);
+  }
+  tree->SetBranchAddress("pdg", &branches.pdg);
+
+  // read all showers, the maximum number per bin only applies to recording
+  const unsigned int maxshowers = m_MaxShowers;
+  m_MaxShowers = std::numeric_limits<unsigned int>::max();
+  for (Long64_t entry = 0; entry < tree->GetEntries(); ++entry)
+  {
+    tree->GetEntry(entry);
+    Shower shower;
+    shower.energy = branches.energy;
+    shower.eta = branches.eta;
+    shower.cosangle = branches.cosangle;
+    shower.spots.resize(branches.pdg->size());
+    for (size_t j = 0; j < shower.spots.size(); ++j)
+    {
+      Spot &spot = shower.spots[j];
+      for (int k = 0; k < 3; ++k)
+      {
+        spot.pre[k] = branches.values[k]->at(j);
+        spot.post[k] = branches.values[3 + k]->at(j);
+      }
+      spot.dt = branches.values[6]->at(j);
+      spot.edep = branches.values[7]->at(j);
+      spot.eion = branches.values[8]->at(j);
+      spot.pdg = branches.pdg->at(j);
+    }
+    add(branches.type, std::move(shower));
+  }
+  m_MaxShowers = maxshowers;
+  tree->ResetBranchAddresses();
+  for (auto *value : branches.values)
+  {
+    delete value;
+  }
+  delete branches.pdg;
+  f.Close();
+  return true;
+}
@@ -0,0 +1,103 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SHOWERLIBRARY_H
+#define G4MAIN_PHG4SHOWERLIBRARY_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class TH3F;
+
+//! frozen showers recorded at the front face of a calorimeter
+/*!
+  A shower is the list of energy deposits (spots) of a full simulation of an
+  electron or photon, with positions in the frame of the entry point
+  (w along the incoming direction, u = w x z, v = w x u). Showers are binned in
+  particle type, energy, pseudorapidity of the entry point and cosine of the
+  incidence angle to the radial direction. Energies are in GeV, lengths in cm,
+  times in ns.
+*/
+class PHG4ShowerLibrary
+{
+ public:
+  //! energy deposit of one recorded step
+  struct Spot
+  {
+    float pre[3] = {0, 0, 0};   //!< pre step point (u, v, w)
+    float post[3] = {0, 0, 0};  //!< post step point (u, v, w)
+    float dt = 0;               //!< time after the entry
+    float edep = 0;             //!< total energy deposit
+    float eion = 0;             //!< ionization energy deposit
+    int pdg = 0;                //!< particle which made the step
+  };
+
+  struct Shower
+  {
+    float energy = 0;  //!< kinetic energy of the incoming particle
+    float eta = 0;
+    float cosangle = 0;
+    std::vector<Spot> spots;
+  };
+
+  //! electrons and positrons share showers
+  enum ParticleType
+  {
+    kElectron = 0,
+    kPhoton = 1,
+    kNParticleTypes = 2
+  };
+
+  PHG4ShowerLibrary();
+  ~PHG4ShowerLibrary();
+
+  PHG4ShowerLibrary(const PHG4ShowerLibrary &) = delete;
+  PHG4ShowerLibrary &operator=(const PHG4ShowerLibrary &) = delete;
+
+  //! binning, removes all showers. Energy bins are logarithmic
+  void set_binning(const int nebins, const double emin, const double emax,
+                   const int netabins, const double etamin, const double etamax,
+                   const int nanglebins, const double cosanglemin);
+
+  //! maximum number of showers per bin, recording stops for full bins
+  void set_max_showers(const unsigned int n) { m_MaxShowers = n; }
+  unsigned int get_max_showers() const { return m_MaxShowers; }
+
+  //! particle type for a pdg code, -1 if not in the library
+  static int particle_type(const int pdg);
+
+  //! bin of an incoming particle, -1 outside of the binning
+  int find_bin(const int type, const double energy, const double eta, const double cosangle) const;
+
+  //! add a shower, false if its bin is full or it is outside of the binning
+  bool add(const int type, Shower &&shower);
+
+  //! number of showers in a bin
+  size_t nshowers(const int bin) const;
+
+  //! total number of showers
+  size_t nshowers() const;
+
+  //! shower i of a bin
+  const Shower &get(const int bin, const size_t i) const { return m_Showers[bin][i]; }
+
+  //! write the binning and the showers to a ROOT file
+  bool write(const std::string &filename) const;
+
+  //! read a library written by write(), replaces binning and showers
+  bool read(const std::string &filename);
+
+ private:
+  //! bins of the histogram without under and overflows
+  int nbins_per_type() const;
+
+  //! binning in energy, eta, cos(angle), only used to find bins
+  std::unique_ptr<TH3F> m_Binning;
+
+  //! showers per bin, particle types one after the other
+  std::vector<std::vector<Shower>> m_Showers;
+
+  unsigned int m_MaxShowers = 50;
+};
+
+#endif  // G4MAIN_PHG4SHOWERLIBRARY_H
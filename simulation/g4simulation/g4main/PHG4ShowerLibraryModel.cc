@@ -0,0 +1,184 @@
+#include "PHG4ShowerLibraryModel.h"
+
+#include "PHG4Detector.h"
+#include "PHG4ShowerLibrary.h"
+#include "PHG4SteppingAction.h"
+
+#include <Geant4/G4DynamicParticle.hh>
+#include <Geant4/G4FastStep.hh>
+#include <Geant4/G4FastTrack.hh>
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4Navigator.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4ParticleTable.hh>
+#include <Geant4/G4Proton.hh>
+#include <Geant4/G4StepPoint.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4TouchableHandle.hh>
+#include <Geant4/G4Track.hh>
+#include <Geant4/G4TransportationManager.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+#include <Geant4/G4VSolid.hh>
+#include <Geant4/Randomize.hh>
+
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+PHG4ShowerLibraryModel::PHG4ShowerLibraryModel(const std::string &name, G4Region *region, const PHG4ShowerLibrary *library,
+                                               PHG4SteppingAction *steppingaction, const std::set<G4LogicalVolume *> &volumes)
+  : G4VFastSimulationModel(name, region)
+  , m_Library(library)
+  , m_SteppingAction(steppingaction)
+  , m_Volumes(volumes)
+  , m_Navigator(new G4Navigator())
+{
+  m_Navigator->SetWorldVolume(G4TransportationManager::GetTransportationManager()->GetNavigatorForTracking()->GetWorldVolume());
+}
+
+PHG4ShowerLibraryModel::~PHG4ShowerLibraryModel() = default;
+
+G4bool PHG4ShowerLibraryModel::IsApplicable(const G4ParticleDefinition &particle)
+{
+  return PHG4ShowerLibrary::particle_type(particle.GetPDGEncoding()) >= 0;
+}
+
+G4bool PHG4ShowerLibraryModel::ModelTrigger(const G4FastTrack &fastTrack)
+{
+  // only when entering the envelope, particles made or scattered inside are simulated
+  m_Bin = -1;
+  if (fastTrack.OnTheBoundaryButExiting() ||
+      fastTrack.GetEnvelopeSolid()->Inside(fastTrack.GetPrimaryTrackLocalPosition()) != kSurface)
+  {
+    return false;
+  }
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  m_Bin = m_Library->find_bin(PHG4ShowerLibrary::particle_type(track->GetDefinition()->GetPDGEncoding()),
+                              track->GetKineticEnergy() / GeV, track->GetPosition().eta(),
+                              CosAngle(track->GetPosition(), track->GetMomentumDirection()));
+  return m_Library->nshowers(m_Bin) > 0;
+}
+
+void PHG4ShowerLibraryModel::DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep)
+{
+  const G4Track *track = fastTrack.GetPrimaryTrack();
+  fastStep.KillPrimaryTrack();
+  fastStep.ProposePrimaryTrackPathLength(0);
+
+  const size_t nshowers = m_Library->nshowers(m_Bin);
+  const size_t ishower = std::min(nshowers - 1, static_cast<size_t>(G4UniformRand() * nshowers));
+  const PHG4ShowerLibrary::Shower &shower = m_Library->get(m_Bin, ishower);
+  const double scale = track->GetKineticEnergy() / GeV / shower.energy;
+
+  const G4ThreeVector origin = track->GetPosition();
+  const G4ThreeVector w = track->GetMomentumDirection();
+  G4ThreeVector u;
+  G4ThreeVector v;
+  Frame(w, u, v);
+  const double t0 = track->GetGlobalTime();
+
+  G4StepPoint *prePoint = m_Step.GetPreStepPoint();
+  G4StepPoint *postPoint = m_Step.GetPostStepPoint();
+  for (const auto &spot : shower.spots)
+  {
+    const G4ThreeVector pre = origin + (spot.pre[0] * u + spot.pre[1] * v + spot.pre[2] * w) * cm;
+    const G4ThreeVector post = origin + (spot.post[0] * u + spot.post[1] * v + spot.post[2] * w) * cm;
+    G4VPhysicalVolume *volume = m_Navigator->LocateGlobalPointAndSetup(0.5 * (pre + post), nullptr, false, true);
+    if (!volume || m_Volumes.find(volume->GetLogicalVolume()) == m_Volumes.end())
+    {
+      continue;
+    }
+    G4TouchableHandle touchable = m_Navigator->CreateTouchableHistoryHandle();
+    const double time = t0 + spot.dt * ns;
+
+    // the hits belong to the incoming particle, like the ones of its secondaries in a full simulation
+    G4Track *spottrack = GetTrack(spot.pdg);
+    spottrack->SetTrackID(track->GetTrackID());
+    spottrack->SetParentID(track->GetParentID());
+    spottrack->SetUserInformation(track->GetUserInformation());
+    spottrack->SetTouchableHandle(touchable);
+    spottrack->SetPosition(post);
+    spottrack->SetGlobalTime(time);
+    spottrack->SetTrackStatus(fAlive);
+    m_Step.SetTrack(spottrack);
+
+    // a step through the volume, so the stepping action makes and saves one hit
+    for (G4StepPoint *point : {prePoint, postPoint})
+    {
+      point->SetTouchableHandle(touchable);
+      point->SetMaterial(volume->GetLogicalVolume()->GetMaterial());
+      point->SetMaterialCutsCouple(volume->GetLogicalVolume()->GetMaterialCutsCouple());
+      point->SetGlobalTime(time);
+      point->SetStepStatus(fGeomBoundary);
+    }
+    prePoint->SetPosition(pre);
+    postPoint->SetPosition(post);
+    m_Step.SetStepLength((post - pre).mag());
+    m_Step.SetTotalEnergyDeposit(scale * spot.edep * GeV);
+    m_Step.SetNonIonizingEnergyDeposit(scale * (spot.edep - spot.eion) * GeV);
+
+    m_SteppingAction->UserSteppingAction(&m_Step, false);
+
+    // the user information belongs to the incoming track
+    spottrack->SetUserInformation(nullptr);
+  }
+  ++m_NReplayed;
+}
+
+void PHG4ShowerLibraryModel::Frame(const G4ThreeVector &direction, G4ThreeVector &u, G4ThreeVector &v)
+{
+  u = direction.cross(G4ThreeVector(0, 0, 1));
+  if (u.mag2() < 1e-12)
+  {
+    u = G4ThreeVector(1, 0, 0);
+  }
+  u = u.unit();
+  v = direction.cross(u);
+}
+
+double PHG4ShowerLibraryModel::CosAngle(const G4ThreeVector &position, const G4ThreeVector &direction)
+{
+  const double rho = position.perp();
+  if (rho <= 0)
+  {
+    return 1;
+  }
+  return (direction.x() * position.x() + direction.y() * position.y()) / rho;
+}
+
+void PHG4ShowerLibraryModel::FindVolumes(const PHG4Detector *detector, std::set<G4LogicalVolume *> &volumes)
+{
+  std::vector<G4LogicalVolume *> todo = detector->GetRootLogicalVolumes();
+  while (!todo.empty())
+  {
+    G4LogicalVolume *logvol = todo.back();
+    todo.pop_back();
+    if (!volumes.insert(logvol).second)
+    {
+      continue;
+    }
+    for (size_t i = 0; i < logvol->GetNoDaughters(); ++i)
+    {
+      todo.push_back(logvol->GetDaughter(i)->GetLogicalVolume());
+    }
+  }
+}
+
+G4Track *PHG4ShowerLibraryModel::GetTrack(const int pdg)
+{
+  auto iter = m_Tracks.find(pdg);
+  if (iter != m_Tracks.end())
+  {
+    return iter->second.get();
+  }
+  G4ParticleDefinition *particle = G4ParticleTable::GetParticleTable()->FindParticle(pdg);
+  if (!particle)
+  {
+    // nuclear fragments, the stepping action sees them as protons
+    particle = G4Proton::Definition();
+  }
+  auto track = std::make_unique<G4Track>(new G4DynamicParticle(particle, G4ThreeVector(0, 0, 1), 0), 0, G4ThreeVector());
+  track->SetStep(&m_Step);
+  return m_Tracks.emplace(pdg, std::move(track)).first->second.get();
+}
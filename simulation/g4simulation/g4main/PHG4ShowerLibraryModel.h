@@ -0,0 +1,81 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SHOWERLIBRARYMODEL_H
+#define G4MAIN_PHG4SHOWERLIBRARYMODEL_H
+
+#include <Geant4/G4Step.hh>
+#include <Geant4/G4ThreeVector.hh>
+#include <Geant4/G4VFastSimulationModel.hh>
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+class G4FastStep;
+class G4FastTrack;
+class G4LogicalVolume;
+class G4Navigator;
+class G4ParticleDefinition;
+class G4Region;
+class G4Track;
+class PHG4Detector;
+class PHG4ShowerLibrary;
+class PHG4SteppingAction;
+
+//! replays showers of a PHG4ShowerLibrary for electrons and photons entering a calorimeter
+/*!
+  The particle is killed at the envelope surface and the spots of a library
+  shower (energies scaled to the particle energy) are handed to the stepping
+  action of the calorimeter as steps in the volume at their position. The
+  stepping action makes the G4Hits like for a full simulation, so the hit
+  containers and everything downstream are unchanged.
+*/
+class PHG4ShowerLibraryModel : public G4VFastSimulationModel
+{
+ public:
+  PHG4ShowerLibraryModel(const std::string &name, G4Region *region, const PHG4ShowerLibrary *library,
+                         PHG4SteppingAction *steppingaction, const std::set<G4LogicalVolume *> &volumes);
+
+  ~PHG4ShowerLibraryModel() override;
+
+  G4bool IsApplicable(const G4ParticleDefinition &particle) override;
+  G4bool ModelTrigger(const G4FastTrack &fastTrack) override;
+  void DoIt(const G4FastTrack &fastTrack, G4FastStep &fastStep) override;
+
+  //! shower frame: w along direction, u = w x z (x if w is along z), v = w x u
+  static void Frame(const G4ThreeVector &direction, G4ThreeVector &u, G4ThreeVector &v);
+
+  //! incidence angle to the radial direction at the entry point
+  static double CosAngle(const G4ThreeVector &position, const G4ThreeVector &direction);
+
+  //! all logical volumes of a detector
+  static void FindVolumes(const PHG4Detector *detector, std::set<G4LogicalVolume *> &volumes);
+
+  //! number of replayed showers
+  unsigned long GetNReplayed() const { return m_NReplayed; }
+
+ private:
+  //! stand-in track for the particle which made a spot
+  G4Track *GetTrack(const int pdg);
+
+  const PHG4ShowerLibrary *m_Library = nullptr;
+  PHG4SteppingAction *m_SteppingAction = nullptr;
+
+  //! volumes of the calorimeter, spots elsewhere are dropped
+  std::set<G4LogicalVolume *> m_Volumes;
+
+  //! locates the spots, separate from the tracking navigator
+  std::unique_ptr<G4Navigator> m_Navigator;
+
+  //! step handed to the stepping action
+  G4Step m_Step;
+  std::map<int, std::unique_ptr<G4Track>> m_Tracks;
+
+  //! library bin found by ModelTrigger for DoIt
+  int m_Bin = -1;
+
+  unsigned long m_NReplayed = 0;
+};
+
+#endif  // G4MAIN_PHG4SHOWERLIBRARYMODEL_H
@@ -0,0 +1,94 @@
+#include "PHG4ShowerLibrarySteppingAction.h"
+
+#include "PHG4Detector.h"
+#include "PHG4ShowerLibraryModel.h"
+
+#include <Geant4/G4LogicalVolume.hh>
+#include <Geant4/G4ParticleDefinition.hh>
+#include <Geant4/G4Step.hh>
+#include <Geant4/G4StepPoint.hh>
+#include <Geant4/G4StepStatus.hh>
+#include <Geant4/G4SystemOfUnits.hh>
+#include <Geant4/G4TouchableHandle.hh>
+#include <Geant4/G4Track.hh>
+#include <Geant4/G4VPhysicalVolume.hh>
+
+PHG4ShowerLibrarySteppingAction::PHG4ShowerLibrarySteppingAction(PHG4Detector *calorimeter)
+  : PHG4SteppingAction("SHOWERLIBRARY")
+  , m_Calorimeter(calorimeter)
+{
+}
+
+bool PHG4ShowerLibrarySteppingAction::UserSteppingAction(const G4Step *aStep, bool /*was_used*/)
+{
+  if (m_TopLevelVolumes.empty())
+  {
+    m_TopLevelVolumes.insert(m_Calorimeter->GetRootLogicalVolumes().begin(), m_Calorimeter->GetRootLogicalVolumes().end());
+    PHG4ShowerLibraryModel::FindVolumes(m_Calorimeter, m_Volumes);
+  }
+  const G4StepPoint *prePoint = aStep->GetPreStepPoint();
+  G4LogicalVolume *volume = prePoint->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
+  if (m_Volumes.find(volume) == m_Volumes.end())
+  {
+    return false;
+  }
+
+  if (!m_Entered)
+  {
+    const G4Track *aTrack = aStep->GetTrack();
+    const int type = PHG4ShowerLibrary::particle_type(aTrack->GetParticleDefinition()->GetPDGEncoding());
+    if (aTrack->GetParentID() != 0 || type < 0 ||
+        prePoint->GetStepStatus() != fGeomBoundary ||
+        m_TopLevelVolumes.find(volume) == m_TopLevelVolumes.end())
+    {
+      return false;
+    }
+    m_Entered = true;
+    m_Type = type;
+    m_EntryTime = prePoint->GetGlobalTime();
+    m_EntryPosition = prePoint->GetPosition();
+    m_W = prePoint->GetMomentumDirection();
+    PHG4ShowerLibraryModel::Frame(m_W, m_U, m_V);
+    m_Shower.energy = prePoint->GetKineticEnergy() / GeV;
+    m_Shower.eta = m_EntryPosition.eta();
+    m_Shower.cosangle = PHG4ShowerLibraryModel::CosAngle(m_EntryPosition, m_W);
+  }
+
+  if (aStep->GetTotalEnergyDeposit() <= 0)
+  {
+    return false;
+  }
+  PHG4ShowerLibrary::Spot spot;
+  const G4ThreeVector pre = (prePoint->GetPosition() - m_EntryPosition) / cm;
+  const G4ThreeVector post = (aStep->GetPostStepPoint()->GetPosition() - m_EntryPosition) / cm;
+  spot.pre[0] = pre.dot(m_U);
+  spot.pre[1] = pre.dot(m_V);
+  spot.pre[2] = pre.dot(m_W);
+  spot.post[0] = post.dot(m_U);
+  spot.post[1] = post.dot(m_V);
+  spot.post[2] = post.dot(m_W);
+  spot.dt = (prePoint->GetGlobalTime() - m_EntryTime) / ns;
+  spot.edep = aStep->GetTotalEnergyDeposit() / GeV;
+  spot.eion = (aStep->GetTotalEnergyDeposit() - aStep->GetNonIonizingEnergyDeposit()) / GeV;
+  spot.pdg = aStep->GetTrack()->GetParticleDefinition()->GetPDGEncoding();
+  m_Shower.spots.push_back(spot);
+  return false;
+}
+
+bool PHG4ShowerLibrarySteppingAction::GetShower(int &type, PHG4ShowerLibrary::Shower &shower) const
+{
+  if (!m_Entered)
+  {
+    return false;
+  }
+  type = m_Type;
+  shower = m_Shower;
+  return true;
+}
+
+void PHG4ShowerLibrarySteppingAction::Reset()
+{
+  m_Entered = false;
+  m_Type = -1;
+  m_Shower = PHG4ShowerLibrary::Shower();
+}
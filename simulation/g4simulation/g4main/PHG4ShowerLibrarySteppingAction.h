@@ -0,0 +1,60 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SHOWERLIBRARYSTEPPINGACTION_H
+#define G4MAIN_PHG4SHOWERLIBRARYSTEPPINGACTION_H
+
+#include "PHG4ShowerLibrary.h"
+#include "PHG4SteppingAction.h"
+
+#include <Geant4/G4ThreeVector.hh>
+
+#include <set>
+
+class G4LogicalVolume;
+class G4Step;
+class PHG4Detector;
+
+//! records the shower of the primary electron or photon entering a calorimeter
+/*!
+  Meant for single particle events: the first primary e+, e- or photon which
+  enters one of the top level volumes of the calorimeter defines the entry
+  point, all energy deposits in the calorimeter volumes after that are the
+  spots of the shower. Never claims a step, the calorimeter stepping action
+  makes its hits as usual.
+*/
+class PHG4ShowerLibrarySteppingAction : public PHG4SteppingAction
+{
+ public:
+  explicit PHG4ShowerLibrarySteppingAction(PHG4Detector *calorimeter);
+
+  ~PHG4ShowerLibrarySteppingAction() override {}
+
+  bool UserSteppingAction(const G4Step *step, bool was_used) override;
+
+  //! the recorded shower of this event, false if no particle entered the calorimeter
+  bool GetShower(int &type, PHG4ShowerLibrary::Shower &shower) const;
+
+  //! start a new event
+  void Reset();
+
+ private:
+  //! the volumes are only known once the geometry is built
+  PHG4Detector *m_Calorimeter = nullptr;
+
+  //! top level volumes of the calorimeter, entering one of them starts the shower
+  std::set<G4LogicalVolume *> m_TopLevelVolumes;
+
+  //! all volumes of the calorimeter
+  std::set<G4LogicalVolume *> m_Volumes;
+
+  bool m_Entered = false;
+  int m_Type = -1;
+  double m_EntryTime = 0;
+  G4ThreeVector m_EntryPosition;
+  G4ThreeVector m_U;
+  G4ThreeVector m_V;
+  G4ThreeVector m_W;
+  PHG4ShowerLibrary::Shower m_Shower;
+};
+
+#endif  // G4MAIN_PHG4SHOWERLIBRARYSTEPPINGACTION_H
@@ -0,0 +1,119 @@
+#include "PHG4ShowerLibrarySubsystem.h"
+
+#include "PHG4ShowerLibrary.h"
+#include "PHG4ShowerLibraryModel.h"
+#include "PHG4ShowerLibrarySteppingAction.h"
+
+#include <fun4all/Fun4AllReturnCodes.h>
+
+#include <phool/phool.h>
+
+#include <TSystem.h>
+
+#include <Geant4/G4LogicalVolume.hh>
+
+#include <iostream>
+#include <set>
+#include <utility>
+
+PHG4ShowerLibrarySubsystem::PHG4ShowerLibrarySubsystem(const std::string &name)
+  : PHG4Subsystem(name)
+  , m_Library(new PHG4ShowerLibrary())
+{
+}
+
+PHG4ShowerLibrarySubsystem::~PHG4ShowerLibrarySubsystem() = default;
+
+void PHG4ShowerLibrarySubsystem::SetBinning(const int nebins, const double emin, const double emax,
+                                            const int netabins, const double etamin, const double etamax,
+                                            const int nanglebins, const double cosanglemin)
+{
+  m_Library->set_binning(nebins, emin, emax, netabins, etamin, etamax, nanglebins, cosanglemin);
+}
+
+void PHG4ShowerLibrarySubsystem::SetMaxShowers(const unsigned int n)
+{
+  m_Library->set_max_showers(n);
+}
+
+int PHG4ShowerLibrarySubsystem::InitRun(PHCompositeNode * /*topNode*/)
+{
+  if (!m_Calorimeter || !m_Calorimeter->GetDetector())
+  {
+    std::cout << PHWHERE << " " << Name() << ": no calorimeter set (or registered after the shower library)" << std::endl;
+    gSystem->Exit(1);
+  }
+  if (m_RecordFlag)
+  {
+    // the stepping action is deleted by PHG4PhenixSteppingAction
+    m_SteppingAction = new PHG4ShowerLibrarySteppingAction(m_Calorimeter->GetDetector());
+  }
+  else
+  {
+    if (!m_Library->read(m_Filename))
+    {
+      gSystem->Exit(1);
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4ShowerLibrarySubsystem::InitRun - " << m_Library->nshowers() << " showers for " << m_Calorimeter->Name()
+                << " from " << m_Filename << std::endl;
+    }
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibrarySubsystem::process_after_geant(PHCompositeNode * /*topNode*/)
+{
+  if (!m_SteppingAction)
+  {
+    return Fun4AllReturnCodes::EVENT_OK;
+  }
+  int type = -1;
+  PHG4ShowerLibrary::Shower shower;
+  if (m_SteppingAction->GetShower(type, shower))
+  {
+    const bool added = m_Library->add(type, std::move(shower));
+    if (Verbosity() > 1)
+    {
+      std::cout << "PHG4ShowerLibrarySubsystem::process_after_geant - shower " << (added ? "added" : "not added (bin full or outside)") << std::endl;
+    }
+  }
+  m_SteppingAction->Reset();
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+int PHG4ShowerLibrarySubsystem::End(PHCompositeNode * /*topNode*/)
+{
+  if (m_RecordFlag)
+  {
+    std::cout << "PHG4ShowerLibrarySubsystem::End - writing " << m_Library->nshowers() << " showers to " << m_Filename << std::endl;
+    m_Library->write(m_Filename);
+  }
+  else if (m_Model)
+  {
+    std::cout << "PHG4ShowerLibrarySubsystem::End - " << m_Model->GetNReplayed() << " showers replayed in " << m_Calorimeter->Name() << std::endl;
+  }
+  return Fun4AllReturnCodes::EVENT_OK;
+}
+
+PHG4SteppingAction *PHG4ShowerLibrarySubsystem::GetSteppingAction() const
+{
+  return m_SteppingAction;
+}
+
+PHG4Reco::FastSimulationModelFactory PHG4ShowerLibrarySubsystem::GetModelFactory()
+{
+  return [this](G4Region *region) -> G4VFastSimulationModel *
+  {
+    if (m_RecordFlag || !m_Calorimeter->GetSteppingAction())
+    {
+      std::cout << PHWHERE << " " << Name() << ": the shower library needs replay mode and a calorimeter with stepping action" << std::endl;
+      return nullptr;
+    }
+    std::set<G4LogicalVolume *> volumes;
+    PHG4ShowerLibraryModel::FindVolumes(m_Calorimeter->GetDetector(), volumes);
+    m_Model = new PHG4ShowerLibraryModel(Name(), region, m_Library.get(), m_Calorimeter->GetSteppingAction(), volumes);
+    return m_Model;
+  };
+}
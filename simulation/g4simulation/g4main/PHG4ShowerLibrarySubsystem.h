@@ -0,0 +1,89 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4MAIN_PHG4SHOWERLIBRARYSUBSYSTEM_H
+#define G4MAIN_PHG4SHOWERLIBRARYSUBSYSTEM_H
+
+#include "PHG4Reco.h"
+#include "PHG4Subsystem.h"
+
+#include <memory>
+#include <string>
+
+class PHCompositeNode;
+class PHG4ShowerLibrary;
+class PHG4ShowerLibraryModel;
+class PHG4ShowerLibrarySteppingAction;
+class PHG4SteppingAction;
+
+//! frozen shower library for a calorimeter
+/*!
+  Recording (single e+, e- or photon events, full simulation):
+
+    PHG4ShowerLibrarySubsystem *showers = new PHG4ShowerLibrarySubsystem("CEMC_SHOWERS");
+    showers->SetCalorimeter(cemc);
+    showers->Record("cemc_showers.root");
+    g4Reco->registerSubsystem(showers);
+
+  Replay: the electrons and photons entering the calorimeter are replaced by
+  library showers, the calorimeter stepping action makes the G4Hits from them:
+
+    showers->Replay("cemc_showers.root");
+    g4Reco->registerSubsystem(showers);
+    g4Reco->add_fast_simulation_model(cemc->Name(), showers->GetModelFactory());
+*/
+class PHG4ShowerLibrarySubsystem : public PHG4Subsystem
+{
+ public:
+  PHG4ShowerLibrarySubsystem(const std::string &name = "SHOWERLIBRARY");
+
+  ~PHG4ShowerLibrarySubsystem() override;
+
+  int InitRun(PHCompositeNode *) override;
+
+  //! harvests the recorded shower
+  int process_after_geant(PHCompositeNode *) override;
+
+  //! writes the library when recording
+  int End(PHCompositeNode *) override;
+
+  PHG4SteppingAction *GetSteppingAction() const override;
+
+  //! calorimeter subsystem whose volumes and stepping action are used
+  void SetCalorimeter(PHG4Subsystem *calo) { m_Calorimeter = calo; }
+
+  //! record showers from full simulation into filename
+  void Record(const std::string &filename)
+  {
+    m_Filename = filename;
+    m_RecordFlag = true;
+  }
+
+  //! replay showers from filename
+  void Replay(const std::string &filename)
+  {
+    m_Filename = filename;
+    m_RecordFlag = false;
+  }
+
+  //! binning of a new library, energies are logarithmic
+  void SetBinning(const int nebins, const double emin, const double emax,
+                  const int netabins, const double etamin, const double etamax,
+                  const int nanglebins, const double cosanglemin);
+
+  //! showers per bin in a new library
+  void SetMaxShowers(const unsigned int n);
+
+  //! create the fast simulation model, for PHG4Reco::add_fast_simulation_model
+  PHG4Reco::FastSimulationModelFactory GetModelFactory();
+
+ private:
+  PHG4Subsystem *m_Calorimeter = nullptr;
+  std::unique_ptr<PHG4ShowerLibrary> m_Library;
+  PHG4ShowerLibrarySteppingAction *m_SteppingAction = nullptr;
+  PHG4ShowerLibraryModel *m_Model = nullptr;
+
+  std::string m_Filename;
+  bool m_RecordFlag = false;
+};
+
+#endif  // G4MAIN_PHG4SHOWERLIBRARYSUBSYSTEM_H
@@ -6,11 +6,89 @@
 
 #include <boost/tuple/tuple.hpp>
 
+#include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <string>
 
 using namespace std;
 
+namespace
+{
+  //! ids above this are left to the map, protects against sparse id ranges
+  //! (e.g. offsets added for embedded or pile up events)
+  size_t max_dense_id(const size_t entries)
+  {
+    return 4 * entries + 65536;
+  }
+}  // namespace
+
+template <class T>
+void PHG4TruthInfoContainer::sync_index(DenseIndex<T>& index, const std::map<int, T*>& map)
+{
+  if (index.entries == map.size())
+  {
+    return;
+  }
+  index.positive.clear();
+  index.negative.clear();
+  index.entries = 0;
+  for (const auto& iter : map)
+  {
+    index_insert(index, iter.first, iter.second);
+  }
+}
+
+template <class T>
+void PHG4TruthInfoContainer::index_insert(DenseIndex<T>& index, const int id, T* value)
+{
+  ++index.entries;
+  std::vector<T*>& table = (id >= 0) ? index.positive : index.negative;
+  const size_t slot = std::abs(static_cast<long>(id));
+  if (slot > max_dense_id(index.entries))
+  {
+    return;
+  }
+  if (slot >= table.size())
+  {
+    table.resize(std::max(slot + 1, 2 * table.size()), nullptr);
+  }
+  table[slot] = value;
+}
+
+template <class T>
+void PHG4TruthInfoContainer::index_erase(DenseIndex<T>& index, const int id)
+{
+  if (index.entries > 0)
+  {
+    --index.entries;
+  }
+  std::vector<T*>& table = (id >= 0) ? index.positive : index.negative;
+  const size_t slot = std::abs(static_cast<long>(id));
+  if (slot < table.size())
+  {
+    table[slot] = nullptr;
+  }
+}
+
+template <class T>
+T* PHG4TruthInfoContainer::index_find(DenseIndex<T>& index, const std::map<int, T*>& map, const int id)
+{
+  sync_index(index, map);
+  const std::vector<T*>& table = (id >= 0) ? index.positive : index.negative;
+  const size_t slot = std::abs(static_cast<long>(id));
+  if (slot < table.size() && table[slot])
+  {
+    return table[slot];
+  }
+  auto it = map.find(id);
+  if (it != map.end())
+  {
+    return it->second;
+  }
+  return nullptr;
+}
+
 PHG4TruthInfoContainer::PHG4TruthInfoContainer()
   : particlemap()
   , vtxmap()
@@ -44,6 +122,17 @@ void PHG4TruthInfoContainer::Reset()
   particle_embed_flags.clear();
   vertex_embed_flags.clear();
 
+  // keep the allocated lookup tables for the next event
+  particle_index.positive.assign(particle_index.positive.size(), nullptr);
+  particle_index.negative.assign(particle_index.negative.size(), nullptr);
+  particle_index.entries = 0;
+  vtx_index.positive.assign(vtx_index.positive.size(), nullptr);
+  vtx_index.negative.assign(vtx_index.negative.size(), nullptr);
+  vtx_index.entries = 0;
+  shower_index.positive.assign(shower_index.positive.size(), nullptr);
+  shower_index.negative.assign(shower_index.negative.size(), nullptr);
+  shower_index.entries = 0;
+
   return;
 }
 
@@ -96,9 +185,11 @@ PHG4TruthInfoContainer::AddParticle(const int trackid, PHG4Particle* newparticle
   int key = trackid;
   ConstIterator it;
   bool added = false;
+  sync_index(particle_index, particlemap);
   boost::tie(it, added) = particlemap.insert(std::make_pair(key, newparticle));
   if (added)
   {
+    index_insert(particle_index, key, newparticle);
     return it;
   }
 
@@ -116,13 +207,7 @@ PHG4TruthInfoContainer::AddParticle(const int trackid, PHG4Particle* newparticle
 
 PHG4Particle* PHG4TruthInfoContainer::GetParticle(const int trackid)
 {
-  int key = trackid;
-  Iterator it = particlemap.find(key);
-  if (it != particlemap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(particle_index, particlemap, trackid);
 }
 
 PHG4Particle* PHG4TruthInfoContainer::GetPrimaryParticle(const int trackid)
@@ -131,23 +216,12 @@ PHG4Particle* PHG4TruthInfoContainer::GetPrimaryParticle(const int trackid)
   {
     return nullptr;
   }
-  Iterator it = particlemap.find(trackid);
-  if (it != particlemap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(particle_index, particlemap, trackid);
 }
 
 PHG4VtxPoint* PHG4TruthInfoContainer::GetVtx(const int vtxid)
 {
-  int key = vtxid;
-  VtxIterator it = vtxmap.find(key);
-  if (it != vtxmap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(vtx_index, vtxmap, vtxid);
 }
 
 PHG4VtxPoint* PHG4TruthInfoContainer::GetPrimaryVtx(const int vtxid)
@@ -156,23 +230,12 @@ PHG4VtxPoint* PHG4TruthInfoContainer::GetPrimaryVtx(const int vtxid)
   {
     return nullptr;
   }
-  VtxIterator it = vtxmap.find(vtxid);
-  if (it != vtxmap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(vtx_index, vtxmap, vtxid);
 }
 
 PHG4Shower* PHG4TruthInfoContainer::GetShower(const int showerid)
 {
-  int key = showerid;
-  ShowerIterator it = showermap.find(key);
-  if (it != showermap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(shower_index, showermap, showerid);
 }
 
 PHG4Shower* PHG4TruthInfoContainer::GetPrimaryShower(const int showerid)
@@ -181,12 +244,7 @@ PHG4Shower* PHG4TruthInfoContainer::GetPrimaryShower(const int showerid)
   {
     return nullptr;
   }
-  ShowerIterator it = showermap.find(showerid);
-  if (it != showermap.end())
-  {
-    return it->second;
-  }
-  return nullptr;
+  return index_find(shower_index, showermap, showerid);
 }
 
 PHG4TruthInfoContainer::ConstVtxIterator
@@ -204,9 +262,11 @@ PHG4TruthInfoContainer::AddVertex(const int id, PHG4VtxPoint* newvtx)
     identify();
   }
 
+  sync_index(vtx_index, vtxmap);
   boost::tie(it, added) = vtxmap.insert(std::make_pair(key, newvtx));
   if (added)
   {
+    index_insert(vtx_index, key, newvtx);
     newvtx->set_id(key);
     return it;
   }
@@ -231,9 +291,11 @@ PHG4TruthInfoContainer::AddShower(const int id, PHG4Shower* newshower)
     identify();
   }
 
+  sync_index(shower_index, showermap);
   boost::tie(it, added) = showermap.insert(std::make_pair(key, newshower));
   if (added)
   {
+    index_insert(shower_index, key, newshower);
     newshower->set_id(key);
     return it;
   }
@@ -329,6 +391,8 @@ int PHG4TruthInfoContainer::minshowerindex() const
 
 void PHG4TruthInfoContainer::delete_particle(Iterator piter)
 {
+  sync_index(particle_index, particlemap);
+  index_erase(particle_index, piter->first);
   delete piter->second;
   particlemap.erase(piter);
   return;
@@ -345,6 +409,8 @@ void PHG4TruthInfoContainer::delete_particle(int trackid)
 
 void PHG4TruthInfoContainer::delete_vtx(VtxIterator viter)
 {
+  sync_index(vtx_index, vtxmap);
+  index_erase(vtx_index, viter->first);
   delete viter->second;
   vtxmap.erase(viter);
   return;
@@ -361,6 +427,8 @@ void PHG4TruthInfoContainer::delete_vtx(int vtxid)
 
 void PHG4TruthInfoContainer::delete_shower(ShowerIterator siter)
 {
+  sync_index(shower_index, showermap);
+  index_erase(shower_index, siter->first);
   delete siter->second;
   showermap.erase(siter);
   return;
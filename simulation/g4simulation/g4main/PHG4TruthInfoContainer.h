@@ -9,6 +9,7 @@
 #include <iterator>  // for distance
 #include <map>
 #include <utility>
+#include <vector>
 
 class PHG4Shower;
 class PHG4Particle;
@@ -194,6 +195,30 @@ class PHG4TruthInfoContainer : public PHObject
   int minshowerindex() const;
 
  private:
+  //! dense lookup tables indexed by |id|, one for positive and one for negative ids
+  template <class T>
+  struct DenseIndex
+  {
+    std::vector<T*> positive;
+    std::vector<T*> negative;
+    //! number of map entries seen by the index, rebuilt if it differs from the map size
+    size_t entries{0};
+  };
+
+  //! bring the lookup table in sync with the map, e.g. after reading from file
+  template <class T>
+  static void sync_index(DenseIndex<T>& index, const std::map<int, T*>& map);
+
+  template <class T>
+  static void index_insert(DenseIndex<T>& index, const int id, T* value);
+
+  template <class T>
+  static void index_erase(DenseIndex<T>& index, const int id);
+
+  //! lookup by id, falls back to the map for ids not in the lookup table
+  template <class T>
+  static T* index_find(DenseIndex<T>& index, const std::map<int, T*>& map, const int id);
+
   /// particle storage map format description:
   /// primary particles are appended in the positive direction
   /// secondary particles are appended in the negative direction
@@ -230,6 +255,11 @@ class PHG4TruthInfoContainer : public PHObject
   std::map<int, int> particle_embed_flags;  //< trackid => embed flag
   std::map<int, int> vertex_embed_flags;    //< vtxid => embed flag
 
+  // ids are dense ranges around 0, the lookup by id goes through these instead of the maps
+  DenseIndex<PHG4Particle> particle_index;  //!
+  DenseIndex<PHG4VtxPoint> vtx_index;       //!
+  DenseIndex<PHG4Shower> shower_index;      //!
+
   ClassDefOverride(PHG4TruthInfoContainer, 1)
 };
 
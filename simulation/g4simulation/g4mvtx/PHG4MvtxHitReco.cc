@@ -46,6 +46,7 @@
 #include <phool/PHNodeIterator.h>
 #include <phool/PHObject.h>      // for PHObject
 #include <phool/PHRandomSeed.h>  // for PHRandomSeed
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
@@ -99,6 +100,16 @@ int PHG4MvtxHitReco::InitRun(PHCompositeNode* topNode)
 
   m_extended_readout_time = m_tmax - m_strobe_width;
 
+  m_threadpool.reset();
+  if (m_nthreads != 1)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity())
+    {
+      std::cout << "PHG4MvtxHitReco::InitRun - using " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   // printout
   std::cout
       << "PHG4MvtxHitReco::InitRun\n"
@@ -272,16 +283,35 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
     // loop over the hits in this layer
     const PHG4HitContainer::ConstRange g4hit_range = g4hitContainer->getHits(layer);
 
-    // Get some layer parameters for later use
-    double xpixw = layergeom->get_pixel_x();
-    double xpixw_half = xpixw / 2.0;
-    double zpixw = layergeom->get_pixel_z();
-    double zpixw_half = zpixw / 2.0;
-    int maxNX = layergeom->get_NX();
-    int maxNZ = layergeom->get_NZ();
+    // the charge sharing only depends on the g4hit and the geometry, with threads it is
+    // done for all hits of the layer first. Truth tracking and the hitsets are filled
+    // below in the original hit order, so the output does not depend on the threads
+    std::vector<std::vector<PixelDeposit>> deposits;
+    std::vector<char> deposit_ok;
+    const bool precomputed = m_threadpool && Verbosity() < 2;
+    if (precomputed)
+    {
+      std::vector<PHG4Hit*> g4hits;
+      for (auto g4hit_it = g4hit_range.first; g4hit_it != g4hit_range.second; ++g4hit_it)
+      {
+        g4hits.push_back(g4hit_it->second);
+      }
+      deposits.resize(g4hits.size());
+      deposit_ok.assign(g4hits.size(), 1);
+      m_threadpool->parallel_for(g4hits.size(), [&](size_t i)
+                                 {
+        const double lead_edge = g4hits[i]->get_t(0) * ns + alpide_pulse.first;
+        const double fall_edge = g4hits[i]->get_t(1) * ns + alpide_pulse.second;
+        if (lead_edge > m_tmax or fall_edge < m_tmin)
+        {
+          return;
+        }
+        deposit_ok[i] = share_charge(g4hits[i], layergeom, deposits[i]); });
+    }
 
     // Now loop over all g4 hits for this layer
-    for (auto g4hit_it = g4hit_range.first; g4hit_it != g4hit_range.second; ++g4hit_it)
+    size_t ihit = 0;
+    for (auto g4hit_it = g4hit_range.first; g4hit_it != g4hit_range.second; ++g4hit_it, ++ihit)
     {
       // get hit
       auto g4hit = g4hit_it->second;
@@ -342,7 +372,6 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
 
       TVector3 local_in(g4hit->get_local_x(0), g4hit->get_local_y(0), g4hit->get_local_z(0));
       TVector3 local_out(g4hit->get_local_x(1), g4hit->get_local_y(1), g4hit->get_local_z(1));
-      TVector3 midpoint((local_in.X() + local_out.X()) / 2.0, (local_in.Y() + local_out.Y()) / 2.0, (local_in.Z() + local_out.Z()) / 2.0);
 
       if (Verbosity() > 2)
       {
@@ -410,252 +439,24 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
           << std::endl;
       }
   */
-      // Get the pixel number of the entry location
-      int pixel_number_in = layergeom->get_pixel_from_local_coords(local_in);
-      // Get the pixel number of the exit location
-      int pixel_number_out = layergeom->get_pixel_from_local_coords(local_out);
-
-      if (pixel_number_in < 0 || pixel_number_out < 0)
-      {
-        std::cout
-            << "Oops!  got negative pixel number in layer " << layergeom->get_layer()
-            << " pixel_number_in " << pixel_number_in
-            << " pixel_number_out " << pixel_number_out
-            << " local_in = " << local_in.X() << " " << local_in.Y() << " " << local_in.Z()
-            << " local_out = " << local_out.X() << " " << local_out.Y() << " " << local_out.Z()
-            << std::endl;
-        return Fun4AllReturnCodes::ABORTEVENT;
-      }
-
-      if (Verbosity() > 3)
-      {
-        std::cout
-            << "entry pixel number " << pixel_number_in
-            << " exit pixel number " << pixel_number_out
-            << std::endl;
-      }
-
-      std::vector<int> vpixel;
-      std::vector<int> vxbin;
-      std::vector<int> vzbin;
-      std::vector<std::pair<double, double> > venergy;
-      // double trklen = 0.0;
-
-      //===================================================
-      // OK, now we have found which sensor the hit is in, extracted the hit
-      // position in local sensor coordinates,  and found the pixel numbers of the
-      // entry point and exit point
-
-      //====================================================
-      // Beginning of charge sharing implementation
-      //    Find tracklet line inside sensor
-      //    Divide tracklet line into n segments (vary n until answer stabilizes)
-      //    Find centroid of each segment
-      //    Diffuse charge at each centroid
-      //    Apportion charge between neighboring pixels
-      //    Add the pixel energy contributions from different track segments together
-      //====================================================
-
-      TVector3 pathvec = local_in - local_out;
-
-      // See figure 7.3 of the thesis by  Lucasz Maczewski (arXiv:10053.3710) for diffusion simulations in a MAPS epitaxial layer
-      // The diffusion widths below were inspired by those plots, corresponding to where the probability drops off to 1/3 of the peak value
-      // However note that we make the simplifying assumption that the probability distribution is flat within this diffusion width,
-      // while in the simulation it is not
-      // double diffusion_width_max = 35.0e-04;   // maximum diffusion radius 35 microns, in cm
-      // double diffusion_width_min = 12.0e-04;   // minimum diffusion radius 12 microns, in cm
-      double diffusion_width_max = 25.0e-04;  // maximum diffusion radius 35 microns, in cm
-      double diffusion_width_min = 8.0e-04;   // minimum diffusion radius 12 microns, in cm
-
-      double ydrift_max = pathvec.Y();
-      int nsegments = 4;
-
-      // we want to make a list of all pixels possibly affected by this hit
-      // we take the entry and exit locations in local coordinates, and build
-      // a rectangular array of pixels that encompasses both, with "nadd" pixels added all around
-
-      int xbin_in = layergeom->get_pixel_X_from_pixel_number(pixel_number_in);
-      int zbin_in = layergeom->get_pixel_Z_from_pixel_number(pixel_number_in);
-      int xbin_out = layergeom->get_pixel_X_from_pixel_number(pixel_number_out);
-      int zbin_out = layergeom->get_pixel_Z_from_pixel_number(pixel_number_out);
-
-      int xbin_max, xbin_min;
-      int nadd = 2;
-      if (xbin_in > xbin_out)
-      {
-        xbin_max = xbin_in + nadd;
-        xbin_min = xbin_out - nadd;
-      }
-      else
-      {
-        xbin_max = xbin_out + nadd;
-        xbin_min = xbin_in - nadd;
-      }
-
-      int zbin_max, zbin_min;
-      if (zbin_in > zbin_out)
-      {
-        zbin_max = zbin_in + nadd;
-        zbin_min = zbin_out - nadd;
-      }
-      else
-      {
-        zbin_max = zbin_out + nadd;
-        zbin_min = zbin_in - nadd;
-      }
-
-      // need to check that values of xbin and zbin are within the valid range
-      // YCM: Fix pixel range: Xbin (row) 0 to 511, Zbin (col) 0 to 1023
-      if (xbin_min < 0)
-      {
-        xbin_min = 0;
-      }
-      if (zbin_min < 0)
-      {
-        zbin_min = 0;
-      }
-      if (xbin_max >= maxNX)
-      {
-        xbin_max = maxNX - 1;
-      }
-      if (zbin_max >= maxNZ)
+      // pixel energies from the charge sharing, computed up front when running with threads
+      std::vector<PixelDeposit> local_deposits;
+      if (precomputed)
       {
-        xbin_max = maxNZ - 1;
-      }
-
-      if (Verbosity() > 1)
-      {
-        std::cout << " xbin_in " << xbin_in << " xbin_out " << xbin_out << " xbin_min " << xbin_min << " xbin_max " << xbin_max << std::endl;
-        std::cout << " zbin_in " << zbin_in << " zbin_out " << zbin_out << " zbin_min " << zbin_min << " zbin_max " << zbin_max << std::endl;
-      }
-
-      // skip this hit if it involves an unreasonable  number of pixels
-      // this skips it if either the xbin or ybin range traversed is greater than 8 (for 8 adding two pixels at each end makes the range 12)
-      if (xbin_max - xbin_min > 12 || zbin_max - zbin_min > 12)
-      {
-        continue;
-      }
-
-      // this hit is skipped earlier if this dimensioning would be exceeded
-      double pixenergy[12][12] = {};  // init to 0
-      double pixeion[12][12] = {};    // init to 0
-
-      // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
-      for (int i = 0; i < nsegments; i++)
-      {
-        // Find the tracklet segment location
-        // If there are n segments of equal length, we want 2*n intervals
-        // The 1st segment is centered at interval 1, the 2nd at interval 3, the nth at interval 2n -1
-        double interval = 2 * (double) i + 1;
-        double frac = interval / (double) (2 * nsegments);
-        TVector3 segvec(pathvec.X() * frac, pathvec.Y() * frac, pathvec.Z() * frac);
-        segvec = segvec + local_out;
-
-        //  Find the distance to the back of the sensor from the segment location
-        // That projection changes only the value of y
-        double ydrift = segvec.Y() - local_out.Y();
-
-        // Caculate the charge diffusion over this drift distance
-        // increases from diffusion width_min to diffusion_width_max
-        double ydiffusion_radius = diffusion_width_min + (ydrift / ydrift_max) * (diffusion_width_max - diffusion_width_min);
-
-        if (Verbosity() > 5)
+        if (!deposit_ok[ihit])
         {
-          std::cout
-              << " segment " << i
-              << " interval " << interval
-              << " frac " << frac
-              << " local_in.X " << local_in.X()
-              << " local_in.Z " << local_in.Z()
-              << " local_in.Y " << local_in.Y()
-              << " pathvec.X " << pathvec.X()
-              << " pathvec.Z " << pathvec.Z()
-              << " pathvec.Y " << pathvec.Y()
-              << " segvec.X " << segvec.X()
-              << " segvec.Z " << segvec.Z()
-              << " segvec.Y " << segvec.Y()
-              << " ydrift " << ydrift
-              << " ydrift_max " << ydrift_max
-              << " ydiffusion_radius " << ydiffusion_radius
-              << std::endl;
-        }
-        // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
-        for (int ix = xbin_min; ix <= xbin_max; ix++)
-        {
-          for (int iz = zbin_min; iz <= zbin_max; iz++)
-          {
-            // Find the pixel corners for this pixel number
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-
-            if (pixnum < 0)
-            {
-              std::cout
-                  << " pixnum < 0 , pixnum = " << pixnum << "\n"
-                  << " ix " << ix << " iz " << iz << "\n"
-                  << " xbin_min " << xbin_min << " zbin_min " << zbin_min << "\n"
-                  << " xbin_max " << xbin_max << " zbin_max " << zbin_max << "\n"
-                  << " maxNX " << maxNX << " maxNZ " << maxNZ
-                  << std::endl;
-            }
-
-            TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
-            // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
-            double x1 = tmp.X() - xpixw_half;
-            double z1 = tmp.Z() + zpixw_half;
-            double x2 = tmp.X() + xpixw_half;
-            double z2 = tmp.Z() - zpixw_half;
-
-            // here segvec.X and segvec.Z are the center of the circle, and diffusion_radius is the circle radius
-            // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
-            double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segvec.X(), segvec.Z(), ydiffusion_radius) / (M_PI * pow(ydiffusion_radius, 2));
-            // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
-            pixenergy[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_edep() / (float) nsegments;
-            if (g4hit->has_property(PHG4Hit::prop_eion))
-            {
-              pixeion[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_eion() / (float) nsegments;
-            }
-            if (Verbosity() > 5)
-            {
-              std::cout
-                  << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
-                  << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix - xbin_min][iz - zbin_min]
-                  << std::endl;
-            }
-          }
+          return Fun4AllReturnCodes::ABORTEVENT;
         }
-      }  // end loop over segments
-
-      // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
-      for (int ix = xbin_min; ix <= xbin_max; ix++)
+      }
+      else if (!share_charge(g4hit, layergeom, local_deposits))
       {
-        for (int iz = zbin_min; iz <= zbin_max; iz++)
-        {
-          if (pixenergy[ix - xbin_min][iz - zbin_min] > 0.0)
-          {
-            int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
-            vpixel.push_back(pixnum);
-            vxbin.push_back(ix);
-            vzbin.push_back(iz);
-            std::pair<double, double> tmppair = std::make_pair(pixenergy[ix - xbin_min][iz - zbin_min], pixeion[ix - xbin_min][iz - zbin_min]);
-            venergy.push_back(tmppair);
-            if (Verbosity() > 1)
-            {
-              std::cout
-                  << " Added pixel number " << pixnum << " xbin " << ix
-                  << " zbin " << iz << " to vectors with energy " << pixenergy[ix - xbin_min][iz - zbin_min]
-                  << std::endl;
-            }
-          }
-        }
+        return Fun4AllReturnCodes::ABORTEVENT;
       }
-
-      //===================================
-      // End of charge sharing implementation
-      //===================================
+      const std::vector<PixelDeposit>& hit_deposits = precomputed ? deposits[ihit] : local_deposits;
 
       // loop over all fired cells for this g4hit and add them to the TrkrHitSet
 
-      for (unsigned int i1 = 0; i1 < vpixel.size(); i1++)  // loop over all fired cells
+      for (const auto& deposit : hit_deposits)  // loop over all fired cells
       {
         // This is the new storage object version
         //====================================
@@ -678,7 +479,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
           TrkrHitSetContainer::Iterator hitsetit = trkrHitSetContainer->findOrAddHitSet(hitsetkey);
 
           // generate the key for this hit
-          TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(vzbin[i1], vxbin[i1]);
+          TrkrDefs::hitkey hitkey = MvtxDefs::genHitKey(deposit.zbin, deposit.xbin);
           // See if this hit already exists
           TrkrHit* hit = nullptr;
           hit = hitsetit->second->getHit(hitkey);
@@ -696,7 +497,7 @@ int PHG4MvtxHitReco::process_event(PHCompositeNode* topNode)
           const TrkrDefs::hitsetkey hitsetkeymask = MvtxDefs::genHitSetKey(layer, stave_number, chip_number, 0);
 
           // Regardless of whether the hit should be masked, add the energy to the truth hit
-          double hitenergy = venergy[i1].first * TrkrDefs::MvtxEnergyScaleup;
+          double hitenergy = deposit.energy * TrkrDefs::MvtxEnergyScaleup;
           addtruthhitset(hitsetkey, hitkey, hitenergy);
 
           if ((std::find(m_deadPixelMap.begin(), m_deadPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_deadPixelMap.end()) && (std::find(m_hotPixelMap.begin(), m_hotPixelMap.end(), std::make_pair(hitsetkeymask, hitkey)) == m_hotPixelMap.end()))
@@ -843,6 +644,251 @@ TrkrDefs::hitsetkey PHG4MvtxHitReco::zero_strobe_bits(TrkrDefs::hitsetkey hitset
   return bare_hitsetkey;
 }
 
+bool PHG4MvtxHitReco::share_charge(PHG4Hit* g4hit, CylinderGeom_Mvtx* layergeom, std::vector<PixelDeposit>& deposits) const
+{
+  deposits.clear();
+
+  // layer parameters
+  double xpixw_half = layergeom->get_pixel_x() / 2.0;
+  double zpixw_half = layergeom->get_pixel_z() / 2.0;
+  int maxNX = layergeom->get_NX();
+  int maxNZ = layergeom->get_NZ();
+
+  TVector3 local_in(g4hit->get_local_x(0), g4hit->get_local_y(0), g4hit->get_local_z(0));
+  TVector3 local_out(g4hit->get_local_x(1), g4hit->get_local_y(1), g4hit->get_local_z(1));
+
+  // Get the pixel number of the entry location
+  int pixel_number_in = layergeom->get_pixel_from_local_coords(local_in);
+  // Get the pixel number of the exit location
+  int pixel_number_out = layergeom->get_pixel_from_local_coords(local_out);
+
+  if (pixel_number_in < 0 || pixel_number_out < 0)
+  {
+    std::cout
+        << "Oops!  got negative pixel number in layer " << layergeom->get_layer()
+        << " pixel_number_in " << pixel_number_in
+        << " pixel_number_out " << pixel_number_out
+        << " local_in = " << local_in.X() << " " << local_in.Y() << " " << local_in.Z()
+        << " local_out = " << local_out.X() << " " << local_out.Y() << " " << local_out.Z()
+        << std::endl;
+    return false;
+  }
+
+  if (Verbosity() > 3)
+  {
+    std::cout
+        << "entry pixel number " << pixel_number_in
+        << " exit pixel number " << pixel_number_out
+        << std::endl;
+  }
+
+
+  //===================================================
+  // OK, now we have found which sensor the hit is in, extracted the hit
+  // position in local sensor coordinates,  and found the pixel numbers of the
+  // entry point and exit point
+
+  //====================================================
+  // Beginning of charge sharing implementation
+  //    Find tracklet line inside sensor
+  //    Divide tracklet line into n segments (vary n until answer stabilizes)
+  //    Find centroid of each segment
+  //    Diffuse charge at each centroid
+  //    Apportion charge between neighboring pixels
+  //    Add the pixel energy contributions from different track segments together
+  //====================================================
+
+  TVector3 pathvec = local_in - local_out;
+
+  // See figure 7.3 of the thesis by  Lucasz Maczewski (arXiv:10053.3710) for diffusion simulations in a MAPS epitaxial layer
+  // The diffusion widths below were inspired by those plots, corresponding to where the probability drops off to 1/3 of the peak value
+  // However note that we make the simplifying assumption that the probability distribution is flat within this diffusion width,
+  // while in the simulation it is not
+  // double diffusion_width_max = 35.0e-04;   // maximum diffusion radius 35 microns, in cm
+  // double diffusion_width_min = 12.0e-04;   // minimum diffusion radius 12 microns, in cm
+  double diffusion_width_max = 25.0e-04;  // maximum diffusion radius 35 microns, in cm
+  double diffusion_width_min = 8.0e-04;   // minimum diffusion radius 12 microns, in cm
+
+  double ydrift_max = pathvec.Y();
+  int nsegments = 4;
+
+  // we want to make a list of all pixels possibly affected by this hit
+  // we take the entry and exit locations in local coordinates, and build
+  // a rectangular array of pixels that encompasses both, with "nadd" pixels added all around
+
+  int xbin_in = layergeom->get_pixel_X_from_pixel_number(pixel_number_in);
+  int zbin_in = layergeom->get_pixel_Z_from_pixel_number(pixel_number_in);
+  int xbin_out = layergeom->get_pixel_X_from_pixel_number(pixel_number_out);
+  int zbin_out = layergeom->get_pixel_Z_from_pixel_number(pixel_number_out);
+
+  int xbin_max, xbin_min;
+  int nadd = 2;
+  if (xbin_in > xbin_out)
+  {
+    xbin_max = xbin_in + nadd;
+    xbin_min = xbin_out - nadd;
+  }
+  else
+  {
+    xbin_max = xbin_out + nadd;
+    xbin_min = xbin_in - nadd;
+  }
+
+  int zbin_max, zbin_min;
+  if (zbin_in > zbin_out)
+  {
+    zbin_max = zbin_in + nadd;
+    zbin_min = zbin_out - nadd;
+  }
+  else
+  {
+    zbin_max = zbin_out + nadd;
+    zbin_min = zbin_in - nadd;
+  }
+
+  // need to check that values of xbin and zbin are within the valid range
+  // YCM: Fix pixel range: Xbin (row) 0 to 511, Zbin (col) 0 to 1023
+  if (xbin_min < 0)
+  {
+    xbin_min = 0;
+  }
+  if (zbin_min < 0)
+  {
+    zbin_min = 0;
+  }
+  if (xbin_max >= maxNX)
+  {
+    xbin_max = maxNX - 1;
+  }
+  if (zbin_max >= maxNZ)
+  {
+    xbin_max = maxNZ - 1;
+  }
+
+  if (Verbosity() > 1)
+  {
+    std::cout << " xbin_in " << xbin_in << " xbin_out " << xbin_out << " xbin_min " << xbin_min << " xbin_max " << xbin_max << std::endl;
+    std::cout << " zbin_in " << zbin_in << " zbin_out " << zbin_out << " zbin_min " << zbin_min << " zbin_max " << zbin_max << std::endl;
+  }
+
+  // skip this hit if it involves an unreasonable  number of pixels
+  // this skips it if either the xbin or ybin range traversed is greater than 8 (for 8 adding two pixels at each end makes the range 12)
+  if (xbin_max - xbin_min > 12 || zbin_max - zbin_min > 12)
+  {
+    return true;
+  }
+
+  // this hit is skipped earlier if this dimensioning would be exceeded
+  double pixenergy[12][12] = {};  // init to 0
+  double pixeion[12][12] = {};    // init to 0
+
+  // Loop over track segments and diffuse charge at each segment location, collect energy in pixels
+  for (int i = 0; i < nsegments; i++)
+  {
+    // Find the tracklet segment location
+    // If there are n segments of equal length, we want 2*n intervals
+    // The 1st segment is centered at interval 1, the 2nd at interval 3, the nth at interval 2n -1
+    double interval = 2 * (double) i + 1;
+    double frac = interval / (double) (2 * nsegments);
+    TVector3 segvec(pathvec.X() * frac, pathvec.Y() * frac, pathvec.Z() * frac);
+    segvec = segvec + local_out;
+
+    //  Find the distance to the back of the sensor from the segment location
+    // That projection changes only the value of y
+    double ydrift = segvec.Y() - local_out.Y();
+
+    // Caculate the charge diffusion over this drift distance
+    // increases from diffusion width_min to diffusion_width_max
+    double ydiffusion_radius = diffusion_width_min + (ydrift / ydrift_max) * (diffusion_width_max - diffusion_width_min);
+
+    if (Verbosity() > 5)
+    {
+      std::cout
+          << " segment " << i
+          << " interval " << interval
+          << " frac " << frac
+          << " local_in.X " << local_in.X()
+          << " local_in.Z " << local_in.Z()
+          << " local_in.Y " << local_in.Y()
+          << " pathvec.X " << pathvec.X()
+          << " pathvec.Z " << pathvec.Z()
+          << " pathvec.Y " << pathvec.Y()
+          << " segvec.X " << segvec.X()
+          << " segvec.Z " << segvec.Z()
+          << " segvec.Y " << segvec.Y()
+          << " ydrift " << ydrift
+          << " ydrift_max " << ydrift_max
+          << " ydiffusion_radius " << ydiffusion_radius
+          << std::endl;
+    }
+    // Now find the area of overlap of the diffusion circle with each pixel and apportion the energy
+    for (int ix = xbin_min; ix <= xbin_max; ix++)
+    {
+      for (int iz = zbin_min; iz <= zbin_max; iz++)
+      {
+        // Find the pixel corners for this pixel number
+        int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
+
+        if (pixnum < 0)
+        {
+          std::cout
+              << " pixnum < 0 , pixnum = " << pixnum << "\n"
+              << " ix " << ix << " iz " << iz << "\n"
+              << " xbin_min " << xbin_min << " zbin_min " << zbin_min << "\n"
+              << " xbin_max " << xbin_max << " zbin_max " << zbin_max << "\n"
+              << " maxNX " << maxNX << " maxNZ " << maxNZ
+              << std::endl;
+        }
+
+        TVector3 tmp = layergeom->get_local_coords_from_pixel(pixnum);
+        // note that (x1,z1) is the top left corner, (x2,z2) is the bottom right corner of the pixel - circle_rectangle_intersection expects this ordering
+        double x1 = tmp.X() - xpixw_half;
+        double z1 = tmp.Z() + zpixw_half;
+        double x2 = tmp.X() + xpixw_half;
+        double z2 = tmp.Z() - zpixw_half;
+
+        // here segvec.X and segvec.Z are the center of the circle, and diffusion_radius is the circle radius
+        // circle_rectangle_intersection returns the overlap area of the circle and the pixel. It is very fast if there is no overlap.
+        double pixarea_frac = PHG4Utils::circle_rectangle_intersection(x1, z1, x2, z2, segvec.X(), segvec.Z(), ydiffusion_radius) / (M_PI * pow(ydiffusion_radius, 2));
+        // assume that the energy is deposited uniformly along the tracklet length, so that this segment gets the fraction 1/nsegments of the energy
+        pixenergy[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_edep() / (float) nsegments;
+        if (g4hit->has_property(PHG4Hit::prop_eion))
+        {
+          pixeion[ix - xbin_min][iz - zbin_min] += pixarea_frac * g4hit->get_eion() / (float) nsegments;
+        }
+        if (Verbosity() > 5)
+        {
+          std::cout
+              << "    pixnum " << pixnum << " xbin " << ix << " zbin " << iz
+              << " pixel_area fraction of circle " << pixarea_frac << " accumulated pixel energy " << pixenergy[ix - xbin_min][iz - zbin_min]
+              << std::endl;
+        }
+      }
+    }
+  }  // end loop over segments
+
+  // now we have the energy deposited in each pixel, summed over all tracklet segments. We make a vector of all pixels with non-zero energy deposited
+  for (int ix = xbin_min; ix <= xbin_max; ix++)
+  {
+    for (int iz = zbin_min; iz <= zbin_max; iz++)
+    {
+      if (pixenergy[ix - xbin_min][iz - zbin_min] > 0.0)
+      {
+        int pixnum = layergeom->get_pixel_number_from_xbin_zbin(ix, iz);
+        deposits.push_back({ix, iz, pixenergy[ix - xbin_min][iz - zbin_min], pixeion[ix - xbin_min][iz - zbin_min]});
+        if (Verbosity() > 1)
+        {
+          std::cout
+              << " Added pixel number " << pixnum << " xbin " << ix
+              << " zbin " << iz << " to vectors with energy " << pixenergy[ix - xbin_min][iz - zbin_min]
+              << std::endl;
+        }
+      }
+    }
+  }
+  return true;
+}
+
 PHG4MvtxHitReco::~PHG4MvtxHitReco()
 {
   delete m_truth_hits;
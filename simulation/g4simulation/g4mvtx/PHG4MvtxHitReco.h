@@ -16,9 +16,11 @@
 typedef std::vector<std::pair<TrkrDefs::hitsetkey, TrkrDefs::hitkey>> hitMask;
 
 class ClusHitsVerbosev1;
+class CylinderGeom_Mvtx;
 class PHCompositeNode;
 class PHG4Hit;
 class PHG4TruthInfoContainer;
+class PHThreadPool;
 class TrkrClusterContainer;
 class TrkrHitSetContainer;
 class TrkrTruthTrack;
@@ -53,7 +55,22 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterInterface
   //! parameters
   void SetDefaultParameters() override;
 
+  //! number of threads for the charge sharing, 1 (default) runs without a thread pool
+  void setNumThreads(unsigned int n) { m_nthreads = n; }
+
  private:
+  //! energy deposited in one pixel by a g4hit
+  struct PixelDeposit
+  {
+    int xbin;
+    int zbin;
+    double energy;
+    double eion;
+  };
+
+  //! charge sharing of a g4hit over the pixels, false if it is outside the sensor
+  bool share_charge(PHG4Hit*, CylinderGeom_Mvtx*, std::vector<PixelDeposit>&) const;
+
   void makePixelMask(hitMask& aMask, const std::string& dbName, const std::string& totalPixelsToMask);
 
   std::pair<double, double> generate_alpide_pulse(const double energy_deposited);
@@ -84,6 +101,9 @@ class PHG4MvtxHitReco : public SubsysReco, public PHParameterInterface
 
   std::unique_ptr<gsl_rng, Deleter> m_rng;
 
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
+
   // needed for clustering truth tracks
  private:
   TrkrTruthTrackContainer* m_truthtracks{nullptr};  // output truth tracks
@@ -1,4 +1,5 @@
 #include "PHG4TpcDigitizer.h"
+#include "PHG4TpcSampleShaping.h"
 
 #include <trackbase/TpcDefs.h>
 #include <trackbase/TrkrDefs.h>
@@ -17,17 +18,22 @@
 #include <phool/PHCompositeNode.h>
 #include <phool/PHNode.h>  // for PHNode
 #include <phool/PHNodeIterator.h>
-#include <phool/PHRandomSeed.h>
+#include <phool/PHThreadPool.h>
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
-#include <gsl/gsl_randist.h>
-#include <gsl/gsl_rng.h>  // for gsl_rng_alloc
-
+#include <algorithm>
+#include <cstdint>
 #include <cstdlib>  // for exit
 #include <iostream>
 #include <limits>
 #include <memory>  // for allocator_tra...
+#include <utility>
+
+namespace
+{
+  constexpr unsigned int print_layer = 18;  // to print diagnostic output for layer 18
+}
 
 PHG4TpcDigitizer::PHG4TpcDigitizer(const std::string &name)
   : SubsysReco(name)
@@ -40,10 +46,8 @@ PHG4TpcDigitizer::PHG4TpcDigitizer(const std::string &name)
   , ADCSignalConversionGain(std::numeric_limits<float>::signaling_NaN())  // will be assigned in PHG4TpcDigitizer::InitRun
   , ADCNoiseConversionGain(std::numeric_limits<float>::signaling_NaN())   // will be assigned in PHG4TpcDigitizer::InitRun
 {
-  unsigned int seed = PHRandomSeed();  // fixed seed is handled in this funtcion
-  std::cout << Name() << " random seed: " << seed << std::endl;
-  RandomGenerator = gsl_rng_alloc(gsl_rng_mt19937);
-  gsl_rng_set(RandomGenerator, seed);
+  m_random = PHRandomStream(Name());  // fixed seed is handled in PHRandomSeed
+  std::cout << Name() << " random seed: " << m_random.seed() << std::endl;
 
   if (Verbosity() > 0)
   {
@@ -51,10 +55,7 @@ PHG4TpcDigitizer::PHG4TpcDigitizer(const std::string &name)
   }
 }
 
-PHG4TpcDigitizer::~PHG4TpcDigitizer()
-{
-  gsl_rng_free(RandomGenerator);
-}
+PHG4TpcDigitizer::~PHG4TpcDigitizer() = default;
 
 int PHG4TpcDigitizer::InitRun(PHCompositeNode *topNode)
 {
@@ -85,6 +86,15 @@ int PHG4TpcDigitizer::InitRun(PHCompositeNode *topNode)
 
   CalculateCylinderCellADCScale(topNode);
 
+  if (m_nthreads != 1 && !m_threadpool)
+  {
+    m_threadpool = std::make_unique<PHThreadPool>(m_nthreads);
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4TpcDigitizer::InitRun - digitizing with " << m_threadpool->size() << " threads" << std::endl;
+    }
+  }
+
   //----------------
   // Report Settings
   //----------------
@@ -108,6 +118,7 @@ int PHG4TpcDigitizer::InitRun(PHCompositeNode *topNode)
 
 int PHG4TpcDigitizer::process_event(PHCompositeNode *topNode)
 {
+  m_random.NextEvent();
   DigitizeCylinderCells(topNode);
 
   return Fun4AllReturnCodes::EVENT_OK;
@@ -152,7 +163,6 @@ void PHG4TpcDigitizer::CalculateCylinderCellADCScale(PHCompositeNode *topNode)
 
 void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
 {
-  unsigned int print_layer = 18;  // to print diagnostic output for layer 47
 
   // Digitizes the Tpc cells that were created in PHG4CylinderCellTpcReco
   // These contain as edep the number of electrons out of the GEM stack, distributed between Z bins by shaper response and ADC clock window
@@ -248,304 +258,88 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
   // Digitization
   //-------------
 
-  // Loop over all TPC layers 
-  for(unsigned int layer = TpcMinLayer; layer < TpcMinLayer+TpcNLayers; ++layer)
+  if (m_pads.empty())
+  {
+    BuildPads(geom_container);
+  }
+  for (auto &pad : m_pads)
+  {
+    pad.hits.clear();
+    pad.noise_hits.clear();
+  }
+
+  // sort the signal hits of all TPC layers into their pads
+  TrkrHitSetContainer::ConstRange hitset_range = trkrhitsetcontainer->getHitSets(TrkrDefs::TrkrId::tpcId);
+  for (TrkrHitSetContainer::ConstIterator hitset_iter = hitset_range.first;
+       hitset_iter != hitset_range.second;
+       ++hitset_iter)
+  {
+    TrkrDefs::hitsetkey hitsetkey = hitset_iter->first;
+    const unsigned int layer = TrkrDefs::getLayer(hitsetkey);
+    if (layer < TpcMinLayer || layer >= TpcMinLayer + TpcNLayers)
     {
-      // we need the geometry object for this layer
-      PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
-      if (!layergeom) { exit(1);
-}
+      continue;
+    }
+    const unsigned int side = TpcDefs::getSide(hitsetkey);
+    const size_t offset = m_pad_offset[(layer - TpcMinLayer) * 2 + side];
 
-      int nphibins = layergeom->get_phibins();
-      if(Verbosity() > 1) { 
-        std::cout << "    nphibins " << nphibins << std::endl;
-}
-      
-      for(unsigned int side = 0; side < 2; ++side)
-	{
-	  
-	  if(Verbosity() > 1) { 
-	    std::cout << "TPC layer " << layer << " side " << side << std::endl;
-}
-	  
-	  // for this layer and side, use a vector of a vector of cells for each phibin
-	  phi_sorted_hits.clear();
-	  for (int iphi = 0; iphi < nphibins; iphi++)
-	    {
-	      phi_sorted_hits.emplace_back();
-	    }
-      
-	  // Loop over all hitsets containing signals for this layer and add them to phi_sorted_hits for their phibin
-	  TrkrHitSetContainer::ConstRange hitset_range = trkrhitsetcontainer->getHitSets(TrkrDefs::TrkrId::tpcId, layer);
-	  for (TrkrHitSetContainer::ConstIterator hitset_iter = hitset_range.first;
-	       hitset_iter != hitset_range.second;
-	       ++hitset_iter)
-	    {
+    if (Verbosity() > 2 && layer == print_layer)
+    {
+      std::cout << "new: PHG4TpcDigitizer:  processing signal hits for layer " << layer
+                << " hitsetkey " << hitsetkey << " side " << side << std::endl;
+    }
 
-	      // we have an iterator to one TrkrHitSet for the Tpc from the trkrHitSetContainer
-	      // get the hitset key
-	      TrkrDefs::hitsetkey hitsetkey = hitset_iter->first;
-	      unsigned int this_side = TpcDefs::getSide(hitsetkey);	  
-	      // skip this hitset if it is not on this side
-	      if(this_side != side) { continue; 
-}
+    TrkrHitSet::ConstRange hit_range = hitset_iter->second->getHits();
+    for (TrkrHitSet::ConstIterator hit_iter = hit_range.first;
+         hit_iter != hit_range.second;
+         ++hit_iter)
+    {
+      PadSignal &pad = m_pads[offset + TpcDefs::getPad(hit_iter->first)];
+      pad.hits.push_back({TpcDefs::getTBin(hit_iter->first), hit_iter->second, hitsetkey == pad.hitsetkey});
+    }
+  }
 
-	      if (Verbosity() > 2) {
-		if (layer == print_layer) {
-		  std::cout << "new: PHG4TpcDigitizer:  processing signal hits for layer " << layer 
-			    << " hitsetkey " << hitsetkey << " side " << side << std::endl;
-}
-}
-	  
-	      // get all of the hits from this hitset
-	      TrkrHitSet *hitset = hitset_iter->second;
-	      TrkrHitSet::ConstRange hit_range = hitset->getHits();
-	      for (TrkrHitSet::ConstIterator hit_iter = hit_range.first;
-		   hit_iter != hit_range.second;
-		   ++hit_iter)
-		{
-		  // Fill the vector of signal hits for each phibin
-		  unsigned int phibin = TpcDefs::getPad(hit_iter->first);
-		  phi_sorted_hits[phibin].push_back(hit_iter);
-		}
-	      // For this hitset we now have the signal hits sorted into vectors for each phi
-	    }
-	  
-	  // Process one phi bin at a time
-	  if(Verbosity() > 1) { std::cout << "    phi_sorted_hits size " <<  phi_sorted_hits.size() << " ntbins " << layergeom->get_zbins() << std::endl;
-}
+  // the pads are independent, digitize them in parallel. Verbose printouts need the serial order
+  if (m_threadpool && Verbosity() <= 2)
+  {
+    m_threadpool->parallel_for(m_pads.size(), [this](size_t ipad)
+                               { DigitizePad(m_pads[ipad]); });
+  }
+  else
+  {
+    for (auto &pad : m_pads)
+    {
+      DigitizePad(pad);
+    }
+  }
 
-	  for (unsigned int iphi = 0; iphi < phi_sorted_hits.size(); iphi++)
-	    {
-	      // Make a fixed length vector to indicate whether each time bin is signal or noise
-	      int ntbins = layergeom->get_zbins();
-	      is_populated.clear();
-	      is_populated.assign(ntbins, 2);  // mark all as noise only, for now
-	      
-	      // add an empty vector of hits for each t bin
-	      t_sorted_hits.clear();
-	      for (int it = 0; it < ntbins; it++)
-		{
-		  t_sorted_hits.emplace_back();
-		}
-	      
-	      // add a signal hit from phi_sorted_hits for each t bin that has one
-	      for (unsigned int it = 0; it < phi_sorted_hits[iphi].size(); it++)
-		{
-		  int tbin = TpcDefs::getTBin(phi_sorted_hits[iphi][it]->first);
-		  is_populated[tbin] = 1;  // this bin is a associated with a hit
-		  t_sorted_hits[tbin].push_back(phi_sorted_hits[iphi][it]);
-		  
-		  if (Verbosity() > 2) {
-		    if (layer == print_layer)
-		      {
-			TrkrDefs::hitkey hitkey = phi_sorted_hits[iphi][it]->first;
-			std::cout << "iphi " << iphi << " adding existing signal hit to t vector for layer " << layer 
-				  << " side " << side
-				  << " tbin " << tbin << "  hitkey " << hitkey
-				  << " pad " << TpcDefs::getPad(hitkey)
-				  << " t bin " << TpcDefs::getTBin(hitkey) 
-				  << "  energy " << (phi_sorted_hits[iphi][it]->second)->getEnergy()
-				  << std::endl;
-		      }
-}
-		}
-	      
-	      adc_input.clear();
-	      adc_hitid.clear();
-	      // initialize entries to zero for each t bin
-	      adc_input.assign(ntbins, 0.0); 
-	      adc_hitid.assign(ntbins, 0); 
-
-	      // Now for this phibin we process all bins ordered by t into hits with noise
-	      //======================================================
-	      // For this step we take the edep value and convert it to mV at the ADC input
-	      // See comments above for how to do this for signal and noise
-	      
-	      for (int it = 0; it < ntbins; it++)
-		{
-		  if (is_populated[it] == 1)
-		    {
-		      // This tbin has a hit, add noise
-		      float signal_with_noise =  add_noise_to_bin( (t_sorted_hits[it][0]->second)->getEnergy()) ;
-		      adc_input[it] = signal_with_noise ;
-		      adc_hitid[it] = t_sorted_hits[it][0]->first;
-
-		      if (Verbosity() > 2) {
-			if (layer == print_layer) {
-			  std::cout << "existing signal hit: layer " << layer << " iphi " << iphi << " it " << it 
-				    << " edep " << (t_sorted_hits[it][0]->second)->getEnergy()
-				    << " adc gain " << ADCSignalConversionGain 
-				    << " signal with noise " <<  signal_with_noise
-				    << " adc_input " << adc_input[it] << std::endl;
-}
-}
-		    }
-		  else if (is_populated[it] == 2)
-		    {
-		      if(!skip_noise)
-			{
-			  // This t bin does not have a filled cell, add noise
-			  float noise =  add_noise_to_bin(0.0);
-			  adc_input[it]= noise;
-			  adc_hitid[it] = 0;              // there is no hit, just add a placeholder in the vector for now, replace it later
-			  
-			  if (Verbosity() > 2) {
-			    if (layer == print_layer) {
-			      std::cout << "noise hit: layer " << layer << " side " << side << " iphi " << iphi << " it " << it
-					<< " adc gain " << ADCSignalConversionGain
-					<< " noise " << noise 
-					<< " adc_input " << adc_input[it] << std::endl;
-}
-}
-			}
-		    }
-		  else
-		    {
-		      // Cannot happen
-		      std::cout << "Impossible value of is_populated, it = " << it 
-				<< " is_populated = " << is_populated[it] << std::endl;
-		      exit(-1);
-		    }
-		}
-	      
-	      // Now we can digitize the entire stream of t bins for this phi bin
-	      int binpointer = 0;
-	      
-	      // Since we now store the local z of the hit as time of arrival at the readout plane, 
-	      // there is no difference between north and south
-	      // The first to arrive is always bin 0
-	      
-	      for (int it = 0; it < ntbins; it++)
-		{
-		  if (it < binpointer) { continue;
-}
+  // create the hits of the digitized bins which had only noise
+  for (const auto &pad : m_pads)
+  {
+    if (pad.noise_hits.empty())
+    {
+      continue;
+    }
+    auto hitset_iter = trkrhitsetcontainer->findOrAddHitSet(pad.hitsetkey);
+    for (const auto &[tbin, adc] : pad.noise_hits)
+    {
+      TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(pad.iphi, tbin);
+      TrkrHit *hit = new TrkrHitv2();
+      hit->setAdc(adc);
+      hitset_iter->second->addHitSpecificKey(hitkey, hit);
+
+      if (Verbosity() > 2 && pad.layer == print_layer)
+      {
+        std::cout << "      adding noise TrkrHit for iphi " << pad.iphi
+                  << " tbin " << tbin
+                  << " side " << pad.side
+                  << " created new hit with hitkey " << hitkey
+                  << " adc " << adc
+                  << std::endl;
+      }
+    }
+  }
 
-		  // optionally do not trigger on bins with no signal
-		  if( (is_populated[it] == 2) && skip_noise) 
-		    {
-		      binpointer++;
-		      continue;		  
-		    }
-
-		  // convert threshold in "equivalent electrons" to mV
-		  if (adc_input[it] > ADCThreshold_mV)  
-		    {
-		      // digitize this bin and the following 4 bins
-		      
-		      if (Verbosity() > 2) {
-			if (layer == print_layer) { 
-			  std::cout << std::endl
-				    << "Hit above threshold of " 
-				    << ADCThreshold * ADCNoiseConversionGain << " for phibin " << iphi
-				    << " it " << it << " with adc_input " << adc_input[it] 
-				    << " digitize this and 4 following bins: " << std::endl;
-}
-}
-		      
-		      for (int itup = 0; itup < 5; itup++)
-			{
-			  if (it + itup < ntbins && it + itup >= 0)  // stay within the bin limits
-			    {
-			      float input = 0;
-			      if( (is_populated[it+itup] == 2) && skip_noise)
-				{
-				  input =  add_noise_to_bin(0.0);  // no noise added to this bin previously because skip_noise is true
-				}
-			      else
-				{
-				  input = adc_input[it + itup];
-				}	
-			      // input voltage x 1024 channels over 2200 mV max range
-			      unsigned int adc_output  = (unsigned int) (input * 1024.0 / 2200.0);  
-
-			      if (input < 0) { adc_output = 0;
-}
-			      if (input > 1023) { adc_output = 1023;
-}
-			      
-			      // Get the hitkey
-			      TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, it + itup);
-			      TrkrHit *hit = nullptr;
-			      
-			      if (Verbosity() > 2) {
-				if (layer == print_layer) { 
-				  std::cout << "    Digitizing:  iphi " << iphi << "  it+itup " << it + itup 
-					    << " adc_hitid " << adc_hitid[it + itup]
-					    << " is_populated " << is_populated[it + itup]
-					    << "  adc_input " << adc_input[it + itup] 
-					    << " ADCThreshold " << ADCThreshold * ADCNoiseConversionGain
-					    << " adc_output " << adc_output 
-					    << " hitkey " << hitkey
-					    << " side " << side
-					    << "  binpointer " << binpointer
-					    << std::endl;			  
-}
-}
-			      
-			      if (is_populated[it+itup] == 1)
-				{
-				  // this is a signal hit, it already exists
-				  hit = t_sorted_hits[it+itup][0]->second;  // pointer valid only for signal hits
-				}
-			      else
-				{
-				  // Hit does not exist yet, have to make one
-				  // we need the hitset key, requires (layer, sector, side)
-				  unsigned int sector = 12 * iphi / nphibins;
-				  TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
-				  auto hitset_iter = trkrhitsetcontainer->findOrAddHitSet(hitsetkey);
-				  
-				  hit = new TrkrHitv2();
-				  hitset_iter->second->addHitSpecificKey(hitkey, hit);
-				  
-				  if (Verbosity() > 2) {
-				    if (layer == print_layer) { 
-				      std::cout << "      adding noise TrkrHit for iphi " << iphi 
-						<< " tbin " << it + itup
-						<< " side " << side
-						<< " created new hit with hitkey " << hitkey
-						<< " energy " << adc_input[it + itup] << " adc " << adc_output 
-						<< "  binpointer " << binpointer
-						<< std::endl;
-}
-}
-				  
-				}
-			      
-			      hit->setAdc(adc_output);
-			      
-			    }              // end boundary check
-			  binpointer++;  // skip this bin in future
-			}                // end itup loop
-		      
-		    }  //  adc threshold if
-		  else
-		    {
-		      // set adc value to zero if there is a hit
-		      // we need the hitset key, requires (layer, sector, side)
-		      unsigned int sector = 12 * iphi / nphibins;
-		      TrkrDefs::hitsetkey hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
-		      auto hitset = trkrhitsetcontainer->findHitSet(hitsetkey);
-		      if(hitset)
-			{
-			  // Get the hitkey
-			  TrkrDefs::hitkey hitkey = TpcDefs::genHitKey(iphi, it);
-			  TrkrHit *hit = nullptr;
-			  hit = hitset->getHit(hitkey);
-			  if (hit)
-			    {
-			      hit->setAdc(0);
-			    }
-			}
-		      // bin below threshold, move on
-		      binpointer++;
-		    }  // end adc threshold if/else
-		}    // end time bin loop
-	    }      // end phibins loop
-	}  // end loop over sides     
-    } // end loop over TPC layers
-  
   //======================================================
   if (Verbosity() > 5)
     {
@@ -661,19 +455,167 @@ void PHG4TpcDigitizer::DigitizeCylinderCells(PHCompositeNode *topNode)
   return;
 }
 
-float PHG4TpcDigitizer::add_noise_to_bin(float signal)
+void PHG4TpcDigitizer::BuildPads(PHG4TpcCylinderGeomContainer *geom_container)
 {
-  // add noise to the signal and return adc input voltage
-  float adc_input_voltage = signal * ADCSignalConversionGain;  // mV, see comments above
-  float noise_voltage = ( Pedestal + added_noise() ) * ADCNoiseConversionGain;  // mV - from definition of noise charge and pedestal charge
-  adc_input_voltage += noise_voltage;
-  
-  return adc_input_voltage;
+  m_pads.clear();
+  m_pad_offset.clear();
+  for (unsigned int layer = TpcMinLayer; layer < TpcMinLayer + TpcNLayers; ++layer)
+  {
+    // we need the geometry object for this layer
+    PHG4TpcCylinderGeom *layergeom = geom_container->GetLayerCellGeom(layer);
+    if (!layergeom)
+    {
+      exit(1);
+    }
+
+    const unsigned int nphibins = layergeom->get_phibins();
+    const unsigned int ntbins = layergeom->get_zbins();
+    if (Verbosity() > 1)
+    {
+      std::cout << "TPC layer " << layer << " nphibins " << nphibins << " ntbins " << ntbins << std::endl;
+    }
+
+    for (unsigned int side = 0; side < 2; ++side)
+    {
+      m_pad_offset.push_back(m_pads.size());
+      for (unsigned int iphi = 0; iphi < nphibins; ++iphi)
+      {
+        PadSignal pad;
+        pad.layer = layer;
+        pad.side = side;
+        pad.iphi = iphi;
+        pad.ntbins = ntbins;
+        // we need the hitset key, requires (layer, sector, side)
+        const unsigned int sector = 12 * iphi / nphibins;
+        pad.hitsetkey = TpcDefs::genHitSetKey(layer, sector, side);
+        m_pads.push_back(std::move(pad));
+      }
+    }
+  }
 }
 
-float PHG4TpcDigitizer::added_noise()
+void PHG4TpcDigitizer::DigitizePad(PadSignal &pad) const
 {
-  float noise = gsl_ran_gaussian(RandomGenerator, TpcEnc);
+  // optionally do not trigger on bins with no signal
+  if (pad.hits.empty() && skip_noise)
+  {
+    return;
+  }
 
-  return noise;
+  // dense per time bin buffers, reused by each thread
+  struct Samples
+  {
+    std::vector<float> signal;
+    std::vector<double> noise;
+    std::vector<float> input;
+    std::vector<uint8_t> enabled;
+    std::vector<uint8_t> above;
+    std::vector<TrkrHit *> signal_hit;
+    std::vector<TrkrHit *> pad_hit;
+  };
+  thread_local Samples samples;
+
+  const unsigned int ntbins = pad.ntbins;
+  samples.signal.assign(ntbins, 0);
+  samples.noise.resize(ntbins);
+  samples.input.resize(ntbins);
+  samples.enabled.assign(ntbins, skip_noise ? 0 : 1);
+  samples.above.resize(ntbins);
+  samples.signal_hit.assign(ntbins, nullptr);
+  samples.pad_hit.assign(ntbins, nullptr);
+
+  // the first signal hit of each t bin gives the signal, it is the one digitized
+  for (const auto &padhit : pad.hits)
+  {
+    if (padhit.tbin >= ntbins)
+    {
+      continue;
+    }
+    if (!samples.signal_hit[padhit.tbin])
+    {
+      samples.signal_hit[padhit.tbin] = padhit.hit;
+      samples.signal[padhit.tbin] = padhit.hit->getEnergy();
+      samples.enabled[padhit.tbin] = 1;
+    }
+    if (padhit.in_pad_hitset)
+    {
+      samples.pad_hit[padhit.tbin] = padhit.hit;
+    }
+
+    if (Verbosity() > 2 && pad.layer == print_layer)
+    {
+      std::cout << "iphi " << pad.iphi << " adding existing signal hit to t vector for layer " << pad.layer
+                << " side " << pad.side
+                << " tbin " << padhit.tbin
+                << "  energy " << padhit.hit->getEnergy()
+                << std::endl;
+    }
+  }
+
+  // convert the signal to mV at the ADC input and add pedestal and noise, see comments above
+  // the noise of a (pad, t bin) is the item (layer, side, pad, t bin) of the event random stream
+  const uint64_t first_item = (static_cast<uint64_t>(pad.layer * 2 + pad.side) << 32) | (static_cast<uint64_t>(pad.iphi) << 12);
+  m_random.Gaus(first_item, ntbins, samples.noise.data(), 0, TpcEnc);
+  PHG4TpcSampleShaping::adc_input(samples.signal.data(), samples.noise.data(), ntbins,
+                                  ADCSignalConversionGain, ADCNoiseConversionGain, Pedestal, samples.input.data());
+
+  // convert threshold in "equivalent electrons" to mV
+  PHG4TpcSampleShaping::above_threshold(samples.input.data(), samples.enabled.data(), ntbins, ADCThreshold_mV, samples.above.data());
+
+  // Now we can digitize the entire stream of t bins for this phi bin
+  // Since we now store the local z of the hit as time of arrival at the readout plane,
+  // there is no difference between north and south
+  // The first to arrive is always bin 0
+  unsigned int it = 0;
+  while (it < ntbins)
+  {
+    if (!samples.above[it])
+    {
+      // set adc value to zero if there is a hit, bin below threshold, move on
+      if (samples.pad_hit[it])
+      {
+        samples.pad_hit[it]->setAdc(0);
+      }
+      ++it;
+      continue;
+    }
+
+    if (Verbosity() > 2 && pad.layer == print_layer)
+    {
+      std::cout << std::endl
+                << "Hit above threshold of "
+                << ADCThreshold_mV << " for phibin " << pad.iphi
+                << " it " << it << " with adc_input " << samples.input[it]
+                << " digitize this and 4 following bins: " << std::endl;
+    }
+
+    // digitize this bin and the following 4 bins
+    const unsigned int last = std::min(it + 5, ntbins);
+    for (; it < last; ++it)
+    {
+      const unsigned int adc_output = PHG4TpcSampleShaping::to_adc(samples.input[it]);
+
+      if (Verbosity() > 2 && pad.layer == print_layer)
+      {
+        std::cout << "    Digitizing:  iphi " << pad.iphi << "  it " << it
+                  << " signal " << (samples.signal_hit[it] != nullptr)
+                  << "  adc_input " << samples.input[it]
+                  << " ADCThreshold " << ADCThreshold_mV
+                  << " adc_output " << adc_output
+                  << " side " << pad.side
+                  << std::endl;
+      }
+
+      if (samples.signal_hit[it])
+      {
+        // this is a signal hit, it already exists
+        samples.signal_hit[it]->setAdc(adc_output);
+      }
+      else
+      {
+        // Hit does not exist yet, it is created after all pads are digitized
+        pad.noise_hits.emplace_back(it, adc_output);
+      }
+    }
+  }
 }
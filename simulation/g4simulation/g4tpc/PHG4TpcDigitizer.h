@@ -6,16 +6,19 @@
 #include <fun4all/SubsysReco.h>
 
 #include <trackbase/TrkrDefs.h>
-#include <trackbase/TrkrHitSet.h>
+
+#include <phool/PHRandomStream.h>
 
 #include <map>
+#include <memory>   // for unique_ptr
 #include <string>   // for string
 #include <utility>  // for pair, make_pair
 #include <vector>
 
-#include <gsl/gsl_rng.h>
-
 class PHCompositeNode;
+class PHG4TpcCylinderGeomContainer;
+class PHThreadPool;
+class TrkrHit;
 
 class PHG4TpcDigitizer : public SubsysReco
 {
@@ -47,11 +50,40 @@ class PHG4TpcDigitizer : public SubsysReco
   void set_drift_velocity(float vd) {_drift_velocity = vd;}
   void set_skip_noise_flag(const bool skip) {skip_noise = skip;}
 
+  //! number of threads digitizing the pads (1: no threads, 0: all cores)
+  void set_num_threads(const unsigned int nthreads) { m_nthreads = nthreads; }
+
  private:
   void CalculateCylinderCellADCScale(PHCompositeNode *topNode);
   void DigitizeCylinderCells(PHCompositeNode *topNode);
-  float added_noise();
-  float add_noise_to_bin(float signal);
+
+  //! signal hit of a pad
+  struct PadHit
+  {
+    unsigned int tbin = 0;
+    TrkrHit *hit = nullptr;
+    //! true if the hit is in the hitset of the pad sector
+    bool in_pad_hitset = false;
+  };
+
+  //! signal hits of one pad, and the noise hits to create on it
+  struct PadSignal
+  {
+    unsigned int layer = 0;
+    unsigned int side = 0;
+    unsigned int iphi = 0;
+    unsigned int ntbins = 0;
+    TrkrDefs::hitsetkey hitsetkey = 0;
+    std::vector<PadHit> hits;
+    //! (tbin, adc) of the digitized bins without signal hit
+    std::vector<std::pair<unsigned int, unsigned int>> noise_hits;
+  };
+
+  //! one pad entry for every pad of every layer and side
+  void BuildPads(PHG4TpcCylinderGeomContainer *geom_container);
+
+  //! digitize the time bins of one pad. Does not modify the hitset container, so pads can run in parallel
+  void DigitizePad(PadSignal &pad) const;
   
   unsigned int TpcMinLayer;
   unsigned int TpcNLayers;
@@ -67,19 +99,19 @@ class PHG4TpcDigitizer : public SubsysReco
 
   bool skip_noise = false;
 
-  std::vector<std::vector<TrkrHitSet::ConstIterator> > phi_sorted_hits;
-  std::vector<std::vector<TrkrHitSet::ConstIterator> > t_sorted_hits;
-
-  std::vector<float> adc_input;
-  std::vector<TrkrDefs::hitkey> adc_hitid;
-  std::vector<int> is_populated;
+  std::vector<PadSignal> m_pads;
+  //! index of the first pad of (layer - TpcMinLayer, side) in m_pads
+  std::vector<size_t> m_pad_offset;
 
   // settings
   std::map<int, unsigned int> _max_adc;
   std::map<int, float> _energy_scale;
 
-  //! random generator that conform with sPHENIX standard
-  gsl_rng *RandomGenerator;
+  //! noise of each (pad, time bin) is an item of the stream, so it does not depend on the processing order
+  PHRandomStream m_random;
+
+  unsigned int m_nthreads = 1;
+  std::unique_ptr<PHThreadPool> m_threadpool;
 };
 
 #endif
@@ -561,6 +561,27 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
 
     int notReachingReadout = 0;
 //    int notInAcceptance = 0;
+
+    // hit end points, fetched once for all electrons
+    const double x_entry = hiter->second->get_x(0);
+    const double y_entry = hiter->second->get_y(0);
+    const double z_entry = hiter->second->get_z(0);
+    const double t_entry = hiter->second->get_t(0);
+    const double dx_hit = hiter->second->get_x(1) - x_entry;
+    const double dy_hit = hiter->second->get_y(1) - y_entry;
+    const double dz_hit = hiter->second->get_z(1) - z_entry;
+    const double dt_hit = hiter->second->get_t(1) - t_entry;
+
+    // first drift all electrons of this hit, then map them to the pad plane
+    // the random number sequence is the same as when mapping each electron right away
+    m_electron_x.clear();
+    m_electron_y.clear();
+    m_electron_t.clear();
+    m_electron_side.clear();
+    m_electron_x.reserve(n_electrons);
+    m_electron_y.reserve(n_electrons);
+    m_electron_t.reserve(n_electrons);
+    m_electron_side.reserve(n_electrons);
     for (unsigned int i = 0; i < n_electrons; i++)
     {
       // We choose the electron starting position at random from a flat
@@ -569,10 +590,10 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
       // values between 0 and 1
       const double f = gsl_ran_flat(RandomGenerator.get(), 0.0, 1.0);
 
-      const double x_start = hiter->second->get_x(0) + f * (hiter->second->get_x(1) - hiter->second->get_x(0));
-      const double y_start = hiter->second->get_y(0) + f * (hiter->second->get_y(1) - hiter->second->get_y(0));
-      const double z_start = hiter->second->get_z(0) + f * (hiter->second->get_z(1) - hiter->second->get_z(0));
-      const double t_start = hiter->second->get_t(0) + f * (hiter->second->get_t(1) - hiter->second->get_t(0));
+      const double x_start = x_entry + f * dx_hit;
+      const double y_start = y_entry + f * dy_hit;
+      const double z_start = z_entry + f * dz_hit;
+      const double t_start = t_entry + f * dt_hit;
 
       unsigned int side = 0;
       if (z_start > 0)
@@ -707,11 +728,19 @@ int PHG4TpcElectronDrift::process_event(PHCompositeNode *topNode)
         assert(nt);
         nt->Fill(ihit, t_start, t_final, t_sigma, rad_final, z_start, z_final);
       }
-      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
-                              temp_hitsetcontainer.get(), hittruthassoc, x_final, y_final, t_final,
-                              side, hiter, ntpad, nthit);
+      m_electron_x.push_back(x_final);
+      m_electron_y.push_back(y_final);
+      m_electron_t.push_back(t_final);
+      m_electron_side.push_back(side);
     }  // end loop over electrons for this g4hit
 
+    for (size_t i = 0; i < m_electron_x.size(); ++i)
+    {
+      padplane->MapToPadPlane(truth_clusterer, single_hitsetcontainer.get(),
+                              temp_hitsetcontainer.get(), hittruthassoc, m_electron_x[i], m_electron_y[i], m_electron_t[i],
+                              m_electron_side[i], hiter, ntpad, nthit);
+    }
+
     if (do_ElectronDriftQAHistos)
     {
       ratioElectronsRR->Fill((double) (n_electrons - notReachingReadout) / n_electrons);
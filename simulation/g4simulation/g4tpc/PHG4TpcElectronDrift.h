@@ -21,6 +21,7 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 class PHG4TpcPadPlane;
 class PHG4TpcDistortion;
@@ -163,6 +164,13 @@ class PHG4TpcElectronDrift : public SubsysReco, public PHParameterInterface
     void operator()(gsl_rng *rng) const { gsl_rng_free(rng); }
   };
   std::unique_ptr<gsl_rng, Deleter> RandomGenerator;
+
+  //! drifted electrons of the current g4hit, position at the readout plane
+  /** buffers are kept between hits to avoid reallocation */
+  std::vector<double> m_electron_x;
+  std::vector<double> m_electron_y;
+  std::vector<double> m_electron_t;
+  std::vector<unsigned int> m_electron_side;
 };
 
 #endif  // G4TPC_PHG4TPCELECTRONDRIFT_H
@@ -1,4 +1,5 @@
 #include "PHG4TpcPadBaselineShift.h"
+#include "PHG4TpcSampleShaping.h"
 
 #include <trackbase/TpcDefs.h>
 
@@ -28,7 +29,6 @@
 #include <phool/getClass.h>
 #include <phool/phool.h>  // for PHWHERE
 
-#include <TF1.h>
 #include <TFile.h>
 #include <TTree.h>
 
@@ -304,11 +304,6 @@ int PHG4TpcPadBaselineShift::process_event(PHCompositeNode *topNode)
     // The maximum drift time in the TPC is 13.2 microseconds.
     // So, 53.2 ns / Z bin.
 
-    TF1 *f1 = new TF1("f1", "[0]*exp(-(x-[1])/[2])", 0, 1000);
-    f1->SetParameter(0, 0.005);
-    f1->SetParameter(1, 0);
-    f1->SetParameter(2, 60);  // in terms of 50nsec time bins
-
     //    sumADC=0.; // this is set to zero 14 lines up (perPadADC is zero)
     TrkrHitSet::ConstRange hitrangei = hitset->getHits();
 
@@ -379,14 +374,7 @@ int PHG4TpcPadBaselineShift::process_event(PHCompositeNode *topNode)
       if (hit && _hit_adc > 0)
       {
         // Trkr hit has only one value m_adc which is energy and ADC at the same time
-        if (_hit_adc_bls > 0)
-        {
-          hit->setAdc(_hit_adc_bls);
-        }
-        else
-        {
-          hit->setAdc(0);
-        }
+        hit->setAdc(PHG4TpcSampleShaping::shift_adc(_hit_adc, int(ind_charge)));
       }
       if (_writeTree == 1)
       {
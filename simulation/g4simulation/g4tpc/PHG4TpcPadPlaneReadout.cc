@@ -39,6 +39,7 @@
 #include <cmath>
 #include <cstdlib>  // for getenv
 #include <iostream>
+#include <limits>
 #include <map>      // for _Rb_tree_cons...
 #include <utility>  // for pair
 
@@ -838,8 +839,13 @@ void PHG4TpcPadPlaneReadout::populate_zigzag_phibins(const unsigned int side, co
     this corresponds to integrating the charge distribution Gaussian function (centered on rphi and of width cloud_sig_rp),
     convoluted with a strip response function, which is triangular from -pitch to +pitch, with a maximum of 1. at stript center
     */
+    // each erf and gaus term appears twice, evaluate them once
+    const double erf_center = std::erf(x_loc / (M_SQRT2 * sigma));
+    const double erf_low = std::erf((x_loc - pitch) / (M_SQRT2 * sigma));
+    const double erf_high = std::erf((x_loc + pitch) / (M_SQRT2 * sigma));
+    const double gaus_center = gaus(x_loc, sigma);
     overlap[ipad] =
-        (pitch - x_loc) * (std::erf(x_loc / (M_SQRT2 * sigma)) - std::erf((x_loc - pitch) / (M_SQRT2 * sigma))) / (pitch * 2) + (pitch + x_loc) * (std::erf((x_loc + pitch) / (M_SQRT2 * sigma)) - std::erf(x_loc / (M_SQRT2 * sigma))) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus(x_loc, sigma)) * square(sigma) / pitch;
+        (pitch - x_loc) * (erf_center - erf_low) / (pitch * 2) + (pitch + x_loc) * (erf_high - erf_center) / (pitch * 2) + (gaus(x_loc - pitch, sigma) - gaus_center) * square(sigma) / pitch + (gaus(x_loc + pitch, sigma) - gaus_center) * square(sigma) / pitch;
   }
 
   // now we have the overlap for each pad
@@ -890,6 +896,22 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
     zsect = 1;
   }
 
+  // erf at bin edge m, located at (m - 1/2) * tstepsize from the central bin center.
+  // Neighboring bins on the same shaping side share an edge, so the last value is reused
+  int cached_edge = std::numeric_limits<int>::min();
+  int cached_index = -1;
+  double cached_erf = 0;
+  auto edge_erf = [&](int m, int index, double tLim)
+  {
+    if (m != cached_edge || index != cached_index)
+    {
+      cached_edge = m;
+      cached_index = index;
+      cached_erf = erf(tLim);
+    }
+    return cached_erf;
+  };
+
   int n_zz = int(3 * (cloud_sig_tt[0] + cloud_sig_tt[1]) / (2.0 * tstepsize) + 1);
   if (Verbosity() > 1000)
   {
@@ -928,7 +950,7 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
       double tLim1 = 0.0;
       double tLim2 = 0.5 * M_SQRT2 * (-0.5 * tstepsize - tdisp) * cloud_sig_tt_inv[index1];
       // 1/2 * the erf is the integral probability from the argument Z value to zero, so this is the integral probability between the Z limits
-      double t_integral1 = 0.5 * (erf(tLim1) - erf(tLim2));
+      double t_integral1 = 0.5 * (erf(tLim1) - edge_erf(0, index1, tLim2));
 
       if (Verbosity() > 1000)
       {
@@ -941,7 +963,7 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
 
       tLim2 = 0.0;
       tLim1 = 0.5 * M_SQRT2 * (0.5 * tstepsize - tdisp) * cloud_sig_tt_inv[index2];
-      double t_integral2 = 0.5 * (erf(tLim1) - erf(tLim2));
+      double t_integral2 = 0.5 * (edge_erf(1, index2, tLim1) - erf(tLim2));
 
       if (Verbosity() > 1000)
       {
@@ -983,7 +1005,8 @@ void PHG4TpcPadPlaneReadout::populate_tbins(const double t, const std::array<dou
       }
       double tLim1 = 0.5 * M_SQRT2 * ((it + 0.5) * tstepsize - tdisp) * cloud_sig_tt_inv[index];
       double tLim2 = 0.5 * M_SQRT2 * ((it - 0.5) * tstepsize - tdisp) * cloud_sig_tt_inv[index];
-      t_integral = 0.5 * (erf(tLim1) - erf(tLim2));
+      const double erf2 = edge_erf(it, index, tLim2);
+      t_integral = 0.5 * (edge_erf(it + 1, index, tLim1) - erf2);
 
       if (Verbosity() > 1000)
       {
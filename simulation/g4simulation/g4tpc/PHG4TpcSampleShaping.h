@@ -0,0 +1,60 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+#ifndef G4TPC_PHG4TPCSAMPLESHAPING_H
+#define G4TPC_PHG4TPCSAMPLESHAPING_H
+
+/*!
+ * \file PHG4TpcSampleShaping.h
+ * \brief loops over the time samples of one TPC pad, shared by the digitizer and the baseline shift
+ *
+ * The samples of a pad are kept in dense arrays indexed by time bin, so these loops have
+ * no branches on the hit content and are vectorized by the compiler.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace PHG4TpcSampleShaping
+{
+  //! adc input voltage (mV): signal (electrons) times signal gain, plus pedestal and noise (electrons) times noise gain
+  inline void adc_input(const float* signal, const double* noise, const size_t n,
+                        const float signal_gain, const float noise_gain, const float pedestal, float* out)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      out[i] = signal[i] * signal_gain + (pedestal + static_cast<float>(noise[i])) * noise_gain;
+    }
+  }
+
+  //! 1 for the samples which are enabled and above threshold (mV), 0 otherwise
+  inline void above_threshold(const float* input, const uint8_t* enabled, const size_t n, const float threshold, uint8_t* mask)
+  {
+    for (size_t i = 0; i < n; ++i)
+    {
+      mask[i] = enabled[i] & static_cast<uint8_t>(input[i] > threshold);
+    }
+  }
+
+  //! SAMPA conversion of the adc input voltage (mV): 1024 channels over the 2200 mV range
+  inline unsigned int to_adc(const float input)
+  {
+    if (input < 0)
+    {
+      return 0;
+    }
+    if (input > 1023)
+    {
+      return 1023;
+    }
+    return static_cast<unsigned int>(input * 1024.0 / 2200.0);
+  }
+
+  //! adc after a baseline shift, not below 0
+  inline int shift_adc(const int adc, const int shift)
+  {
+    return std::max(adc + shift, 0);
+  }
+}  // namespace PHG4TpcSampleShaping
+
+#endif
@@ -7,7 +7,7 @@
 
 #include <g4main/PHG4Hit.h>
 #include <g4main/PHG4HitContainer.h>
-#include <g4main/PHG4Hitv1.h>
+#include <g4main/PHG4Hitv2.h>
 #include <g4main/PHG4Shower.h>
 #include <g4main/PHG4SteppingAction.h>  // for PHG4SteppingAction
 
@@ -56,10 +56,7 @@ PHG4TpcSteppingAction::PHG4TpcSteppingAction(PHG4TpcDetector* detector, const PH
 
 PHG4TpcSteppingAction::~PHG4TpcSteppingAction()
 {
-  // if the last hit was a zero energie deposit hit, it is just reset
-  // and the memory is still allocated, so we need to delete it here
-  // if the last hit was saved, hit is a nullptr pointer which are
-  // legal to delete (it results in a no operation)
+  // the hit is reused, saved hits are copies owned by the hit containers
   delete m_Hit;
 }
 //____________________________________________________________________________..
@@ -133,11 +130,10 @@ bool PHG4TpcSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*was_u
       std::cout << " previous phys pre vol: " << m_SaveVolPre->GetName()
                 << " previous phys post vol: " << m_SaveVolPost->GetName() << std::endl;
     }
-    // if previous hit was saved, hit pointer was set to nullptr
-    // and we have to make a new one
+    // the hit is reused for all tracks, saved hits are copied into the container's pool
     if (!m_Hit)
     {
-      m_Hit = new PHG4Hitv1();
+      m_Hit = new PHG4Hitv2();
     }
     m_Hit->set_layer(layer_id);
     // here we set the entrance values in cm
@@ -264,49 +260,42 @@ bool PHG4TpcSteppingAction::UserSteppingAction(const G4Step* aStep, bool /*was_u
       // save only hits with energy deposit (or -1 for geantino)
       if (m_Hit->get_edep())
       {
-        m_CurrentHitContainer->AddHit(layer_id, m_Hit);
+        PHG4Hitv2 *savehit = m_CurrentHitContainer->newHitv2();
+        *savehit = *m_Hit;
+        m_CurrentHitContainer->AddHit(layer_id, savehit);
         if (m_Shower)
         {
-          m_Shower->add_g4hit_id(m_CurrentHitContainer->GetID(), m_Hit->get_hit_id());
+          m_Shower->add_g4hit_id(m_CurrentHitContainer->GetID(), savehit->get_hit_id());
         }
         // promote to double to force double sqrt
-        double rin = sqrt((double) (m_Hit->get_x(0) * m_Hit->get_x(0) + m_Hit->get_y(0) * m_Hit->get_y(0)));
-        double rout = sqrt((double) (m_Hit->get_x(1) * m_Hit->get_x(1) + m_Hit->get_y(1) * m_Hit->get_y(1)));
+        double rin = sqrt((double) (savehit->get_x(0) * savehit->get_x(0) + savehit->get_y(0) * savehit->get_y(0)));
+        double rout = sqrt((double) (savehit->get_x(1) * savehit->get_x(1) + savehit->get_y(1) * savehit->get_y(1)));
         if (Verbosity() > 10)
         {
           if ((rin > 69.0 && rin < 70.125) || (rout > 69.0 && rout < 70.125))
           {
             std::cout << "Added Tpc g4hit with rin, rout = " << rin << "  " << rout
-                      << " g4hitid " << m_Hit->get_hit_id() << std::endl;
-            std::cout << " xin " << m_Hit->get_x(0)
-                      << " yin " << m_Hit->get_y(0)
-                      << " zin " << m_Hit->get_z(0)
+                      << " g4hitid " << savehit->get_hit_id() << std::endl;
+            std::cout << " xin " << savehit->get_x(0)
+                      << " yin " << savehit->get_y(0)
+                      << " zin " << savehit->get_z(0)
                       << " rin " << rin
                       << std::endl;
-            std::cout << " xout " << m_Hit->get_x(1)
-                      << " yout " << m_Hit->get_y(1)
-                      << " zout " << m_Hit->get_z(1)
+            std::cout << " xout " << savehit->get_x(1)
+                      << " yout " << savehit->get_y(1)
+                      << " zout " << savehit->get_z(1)
                       << " rout " << rout
                       << std::endl;
-            std::cout << " xav " << (m_Hit->get_x(1) + m_Hit->get_x(0)) / 2.0
-                      << " yav " << (m_Hit->get_y(1) + m_Hit->get_y(0)) / 2.0
-                      << " zav " << (m_Hit->get_z(1) + m_Hit->get_z(0)) / 2.0
+            std::cout << " xav " << (savehit->get_x(1) + savehit->get_x(0)) / 2.0
+                      << " yav " << (savehit->get_y(1) + savehit->get_y(0)) / 2.0
+                      << " zav " << (savehit->get_z(1) + savehit->get_z(0)) / 2.0
                       << " rav " << (rout + rin) / 2.0
                       << std::endl;
           }
         }
-
-        // ownership has been transferred to container, set to null
-        // so we will create a new hit for the next track
-        m_Hit = nullptr;
-      }
-      else
-      {
-        // if this hit has no energy deposit, just reset it for reuse
-        // this means we have to delete it in the dtor. If this was
-        // the last hit we processed the memory is still allocated
-        m_Hit->Reset();
       }
+      // reset the hit for reuse, it is deleted in the dtor
+      m_Hit->Reset();
     }
     // return true to indicate the hit was used
     return true;
@@ -9,7 +9,7 @@ class G4Step;
 class G4VPhysicalVolume;
 class PHCompositeNode;
 class PHG4TpcDetector;
-class PHG4Hit;
+class PHG4Hitv2;
 class PHG4HitContainer;
 class PHG4Shower;
 class PHParameters;
@@ -38,7 +38,7 @@ class PHG4TpcSteppingAction : public PHG4SteppingAction
   //! pointer to hit container
   PHG4HitContainer *m_HitContainer{nullptr};
   PHG4HitContainer *m_AbsorberHitContainer{nullptr};
-  PHG4Hit *m_Hit{nullptr};
+  PHG4Hitv2 *m_Hit{nullptr};
   const PHParameters *m_Params{nullptr};
   PHG4HitContainer *m_CurrentHitContainer{nullptr};
   PHG4Shower *m_Shower{nullptr};
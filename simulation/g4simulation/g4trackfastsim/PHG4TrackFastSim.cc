@@ -6,6 +6,7 @@
  */
 
 #include "PHG4TrackFastSim.h"
+#include "PHG4TrackFastSimTable.h"
 
 #include <phgenfit/Fitter.h>
 #include <phgenfit/Measurement.h>  // for Measurement
@@ -59,10 +60,13 @@
 #include <GenFit/GFRaveVertexFactory.h>
 #include <GenFit/Track.h>
 
+#include <TDatabasePDG.h>
 #include <TMatrixDSymfwd.h>  // for TMatrixDSym
 #include <TMatrixTSym.h>     // for TMatrixTSym
 #include <TMatrixTUtils.h>   // for TMatrixTRow
+#include <TParticlePDG.h>
 #include <TSystem.h>
+#include <TVector2.h>
 #include <TVector3.h>     // for TVector3, operator*
 #include <TVectorDfwd.h>  // for TVectorD
 #include <TVectorT.h>     // for TVectorT
@@ -75,6 +79,7 @@
 #include <iostream>  // for operator<<, basic_...
 #include <map>
 #include <memory>  // for unique_ptr, alloca...
+#include <string>
 #include <utility>
 
 class PHField;
@@ -147,22 +152,56 @@ int PHG4TrackFastSim::InitRun(PHCompositeNode* topNode)
   {
     return ret;
   }
-  //
-  //
-  TGeoManager* tgeo_manager = PHGeomUtility::GetTGeoManager(topNode);
-  PHField* field = PHFieldUtility::GetFieldMapNode(nullptr, topNode);
-
-  m_Fitter = PHGenFit::Fitter::getInstance(tgeo_manager,
-                                           field, m_FitAlgoName, "RKTrackRep",
-                                           m_DoEvtDisplayFlag);
 
-  if (!m_Fitter)
+  // lookup tables
+  m_LookupTableIn.reset();
+  m_LookupTableOut.reset();
+  m_ValidationTable.reset();
+  if (!m_LookupTableInFile.empty())
   {
-    std::cout << PHWHERE << std::endl;
-    return Fun4AllReturnCodes::ABORTRUN;
+    m_LookupTableIn = std::make_unique<PHG4TrackFastSimTable>();
+    if (!m_LookupTableIn->read(m_LookupTableInFile))
+    {
+      std::cout << PHWHERE << " cannot read lookup table " << m_LookupTableInFile << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
+    if (m_LookupTableValidation > 0)
+    {
+      m_ValidationTable = std::make_unique<PHG4TrackFastSimTable>();
+    }
+    if (Verbosity() > 0)
+    {
+      std::cout << "PHG4TrackFastSim::InitRun - using lookup table " << m_LookupTableInFile
+                << ", overall efficiency " << m_LookupTableIn->efficiency() << std::endl;
+    }
   }
+  if (!m_LookupTableOutFile.empty())
+  {
+    m_LookupTableOut = std::make_unique<PHG4TrackFastSimTable>();
+    const auto& b = m_LookupTableBinning;
+    m_LookupTableOut->set_binning(static_cast<int>(b[0][0]), b[0][1], b[0][2],
+                                  static_cast<int>(b[1][0]), b[1][1], b[1][2],
+                                  static_cast<int>(b[2][0]), b[2][1], b[2][2]);
+  }
+
+  // the fitter is not needed if all events use the lookup table
+  if (!m_LookupTableIn || m_LookupTableValidation > 0 || m_DoEvtDisplayFlag)
+  {
+    TGeoManager* tgeo_manager = PHGeomUtility::GetTGeoManager(topNode);
+    PHField* field = PHFieldUtility::GetFieldMapNode(nullptr, topNode);
+
+    m_Fitter = PHGenFit::Fitter::getInstance(tgeo_manager,
+                                             field, m_FitAlgoName, "RKTrackRep",
+                                             m_DoEvtDisplayFlag);
+
+    if (!m_Fitter)
+    {
+      std::cout << PHWHERE << std::endl;
+      return Fun4AllReturnCodes::ABORTRUN;
+    }
 
-  m_Fitter->set_verbosity(Verbosity());
+    m_Fitter->set_verbosity(Verbosity());
+  }
 
   // tower geometry for track states
 
@@ -234,6 +273,17 @@ int PHG4TrackFastSim::End(PHCompositeNode* /*topNode*/)
     m_Fitter->displayEvent();
   }
 
+  if (m_LookupTableOut)
+  {
+    std::cout << "PHG4TrackFastSim::End - writing lookup table " << m_LookupTableOutFile
+              << ", overall efficiency " << m_LookupTableOut->efficiency() << std::endl;
+    m_LookupTableOut->write(m_LookupTableOutFile);
+  }
+  if (m_ValidationTable)
+  {
+    PrintLookupTableValidation();
+  }
+
   return Fun4AllReturnCodes::EVENT_OK;
 }
 
@@ -280,6 +330,9 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* /*topNode*/)
     itr_range = m_TruthContainer->GetParticleRange();
   }
 
+  // with a lookup table the full fit is only run on the validation events
+  m_UseLookupTable = m_LookupTableIn && !(m_LookupTableValidation > 0 && m_EventCnt % m_LookupTableValidation == 0);
+
   GenFitTrackMap gf_track_map;
   // Now we can loop over the particles
 
@@ -288,6 +341,16 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* /*topNode*/)
   {
     PHG4Particle* particle = itr->second;
 
+    if (m_UseLookupTable)
+    {
+      std::unique_ptr<SvtxTrack> svtx_track_out(new SvtxTrack_FastSim_v1());
+      if (MakeSvtxTrackFromTable(svtx_track_out.get(), particle))
+      {
+        m_SvtxTrackMapOut->insert(svtx_track_out.get());
+      }
+      continue;
+    }
+
     TVector3 seed_pos(vtxPoint.x(), vtxPoint.y(), vtxPoint.z());
     TVector3 seed_mom(0, 0, 0);
     TMatrixDSym seed_cov(6);
@@ -329,6 +392,7 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* /*topNode*/)
         delete measurement->getMeasurement();
         delete measurement;
       }
+      FillLookupTables(particle, nullptr);
       continue;
     }
 
@@ -372,6 +436,7 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* /*topNode*/)
                   << " : fitting_err != 0, next track."
                   << "\n";
       }
+      FillLookupTables(particle, nullptr);
       continue;
     }
 
@@ -391,6 +456,7 @@ int PHG4TrackFastSim::process_event(PHCompositeNode* /*topNode*/)
       const unsigned int track_id = m_SvtxTrackMapOut->insert(svtx_track_out.get())->get_id();
       gf_track_map.insert({track->getGenFitTrack(), track_id});
     }
+    FillLookupTables(particle, track_made ? svtx_track_out.get() : nullptr);
 
   }  // Loop all primary particles
 
@@ -1080,6 +1146,192 @@ PHGenFit::Measurement* PHG4TrackFastSim::VertexMeasurement(const TVector3& vtx,
   return meas;
 }
 
+int PHG4TrackFastSim::LookupTableBin(const PHG4TrackFastSimTable* table, const PHG4Particle* particle) const
+{
+  // neutral particles never make a track, they would only dilute the efficiency
+  const TParticlePDG* pdg = TDatabasePDG::Instance()->GetParticle(particle->get_pid());
+  if (!pdg || pdg->Charge() == 0)
+  {
+    return -1;
+  }
+  const PHG4VtxPoint* vtx = m_TruthContainer->GetVtx(particle->get_vtx_id());
+  const TVector3 mom(particle->get_px(), particle->get_py(), particle->get_pz());
+  if (!vtx || mom.Perp() <= 0)
+  {
+    return -1;
+  }
+  return table->find_bin(mom.Perp(), mom.Eta(), vtx->get_z());
+}
+
+void PHG4TrackFastSim::FillLookupTables(const PHG4Particle* particle, const SvtxTrack* track)
+{
+  for (PHG4TrackFastSimTable* table : {m_LookupTableOut.get(), m_ValidationTable.get()})
+  {
+    if (!table)
+    {
+      continue;
+    }
+    const int bin = LookupTableBin(table, particle);
+    if (bin < 0)
+    {
+      continue;
+    }
+    std::array<double, PHG4TrackFastSimTable::NQuantities> residuals{};
+    if (track)
+    {
+      const TVector3 truth_mom(particle->get_px(), particle->get_py(), particle->get_pz());
+      const TVector3 mom(track->get_px(), track->get_py(), track->get_pz());
+      const PHG4VtxPoint* vtx = m_TruthContainer->GetVtx(particle->get_vtx_id());
+      residuals[PHG4TrackFastSimTable::PtRel] = (mom.Perp() - truth_mom.Perp()) / truth_mom.Perp();
+      residuals[PHG4TrackFastSimTable::Phi] = TVector2::Phi_mpi_pi(mom.Phi() - truth_mom.Phi());
+      residuals[PHG4TrackFastSimTable::Theta] = mom.Theta() - truth_mom.Theta();
+      residuals[PHG4TrackFastSimTable::Dca2d] = track->get_dca2d();
+      residuals[PHG4TrackFastSimTable::Dcaz] = track->get_z() - vtx->get_z();
+      residuals[PHG4TrackFastSimTable::NMeas] = track->get_num_measurements();
+      residuals[PHG4TrackFastSimTable::Ndf] = track->get_ndf();
+    }
+    table->fill(bin, track != nullptr, residuals);
+  }
+}
+
+bool PHG4TrackFastSim::MakeSvtxTrackFromTable(SvtxTrack* track_out, const PHG4Particle* particle)
+{
+  const PHG4TrackFastSimTable* table = m_LookupTableIn.get();
+  const int bin = LookupTableBin(table, particle);
+  if (bin < 0 || gsl_rng_uniform(m_RandomGenerator) >= table->efficiency(bin))
+  {
+    return false;
+  }
+
+  auto smear = [&](const PHG4TrackFastSimTable::Quantity q)
+  {
+    const double sigma = table->sigma(bin, q);
+    return table->mean(bin, q) + (sigma > 0 ? gsl_ran_gaussian(m_RandomGenerator, sigma) : 0);
+  };
+
+  const TVector3 truth_mom(particle->get_px(), particle->get_py(), particle->get_pz());
+  const double pt = truth_mom.Perp() * (1 + smear(PHG4TrackFastSimTable::PtRel));
+  const double phi = truth_mom.Phi() + smear(PHG4TrackFastSimTable::Phi);
+  const double theta = truth_mom.Theta() + smear(PHG4TrackFastSimTable::Theta);
+  if (pt <= 0 || theta <= 0 || theta >= M_PI)
+  {
+    return false;
+  }
+  const double dca2d = smear(PHG4TrackFastSimTable::Dca2d);
+  const double dcaz = smear(PHG4TrackFastSimTable::Dcaz);
+
+  // momentum, and position displaced by the dca along u = mom x z (see MakeSvtxTrack)
+  const double cosphi = std::cos(phi);
+  const double sinphi = std::sin(phi);
+  const double tantheta = std::tan(theta);
+  const PHG4VtxPoint* vtx = m_TruthContainer->GetVtx(particle->get_vtx_id());
+  track_out->set_truth_track_id(particle->get_track_id());
+  track_out->set_px(pt * cosphi);
+  track_out->set_py(pt * sinphi);
+  track_out->set_pz(pt / tantheta);
+  track_out->set_x(vtx->get_x() + dca2d * sinphi);
+  track_out->set_y(vtx->get_y() - dca2d * cosphi);
+  track_out->set_z(vtx->get_z() + dcaz);
+  track_out->set_dca2d(dca2d);
+  track_out->set_dca(std::sqrt(dca2d * dca2d + dcaz * dcaz));
+  track_out->set_charge(TDatabasePDG::Instance()->GetParticle(particle->get_pid())->Charge() > 0 ? 1 : -1);
+
+  const double ndf = table->mean(bin, PHG4TrackFastSimTable::Ndf);
+  track_out->set_ndf(ndf);
+  track_out->set_chisq(ndf);
+  track_out->set_num_measurements(std::lround(table->mean(bin, PHG4TrackFastSimTable::NMeas)));
+
+  // covariance from the table resolutions, dca along u, momentum from (pt, phi, theta)
+  const double sdca2d = table->sigma(bin, PHG4TrackFastSimTable::Dca2d);
+  const double sdcaz = table->sigma(bin, PHG4TrackFastSimTable::Dcaz);
+  const double spt = table->sigma(bin, PHG4TrackFastSimTable::PtRel) * truth_mom.Perp();
+  const double sphi = table->sigma(bin, PHG4TrackFastSimTable::Phi);
+  const double stheta = table->sigma(bin, PHG4TrackFastSimTable::Theta);
+  track_out->set_dca2d_error(sdca2d * sdca2d);
+
+  TMatrixDSym cov(6);
+  cov(0, 0) = sdca2d * sdca2d * sinphi * sinphi;
+  cov(0, 1) = -sdca2d * sdca2d * sinphi * cosphi;
+  cov(1, 1) = sdca2d * sdca2d * cosphi * cosphi;
+  cov(2, 2) = sdcaz * sdcaz;
+  const double jacobian[3][3] = {
+      {cosphi, -pt * sinphi, 0},
+      {sinphi, pt * cosphi, 0},
+      {1 / tantheta, 0, -pt / (std::sin(theta) * std::sin(theta))}};
+  const double variance[3] = {spt * spt, sphi * sphi, stheta * stheta};
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = i; j < 3; j++)
+    {
+      double value = 0;
+      for (int k = 0; k < 3; k++)
+      {
+        value += jacobian[i][k] * variance[k] * jacobian[j][k];
+      }
+      cov(3 + i, 3 + j) = value;
+    }
+  }
+  for (int i = 0; i < 6; i++)
+  {
+    for (int j = i; j < 6; j++)
+    {
+      track_out->set_error(i, j, cov(i, j));
+    }
+  }
+  // the default name is UNKNOWN - let's set this to ORIGIN since it is at pathlength=0
+  track_out->begin_states()->second->set_name("ORIGIN");
+
+  return true;
+}
+
+void PHG4TrackFastSim::PrintLookupTableValidation() const
+{
+  // compare per bin, weighted by the validation particles, so differences in the particle spectra do not matter
+  constexpr size_t nquantities = 5;
+  const std::array<std::pair<PHG4TrackFastSimTable::Quantity, std::string>, nquantities> quantities = {{{PHG4TrackFastSimTable::PtRel, "dpt/pt"},
+                                                                                                        {PHG4TrackFastSimTable::Phi, "dphi"},
+                                                                                                        {PHG4TrackFastSimTable::Theta, "dtheta"},
+                                                                                                        {PHG4TrackFastSimTable::Dca2d, "dca2d"},
+                                                                                                        {PHG4TrackFastSimTable::Dcaz, "dcaz"}}};
+  double ntruth = 0;
+  double nreco = 0;
+  double nexpected = 0;
+  std::array<double, nquantities> weight{};
+  std::array<double, nquantities> sigma_fit{};
+  std::array<double, nquantities> sigma_table{};
+  for (int bin = 0; bin < m_ValidationTable->nbins(); ++bin)
+  {
+    ntruth += m_ValidationTable->ntruth(bin);
+    nreco += m_ValidationTable->nreco(bin);
+    nexpected += m_ValidationTable->ntruth(bin) * m_LookupTableIn->efficiency(bin);
+    const double n = m_ValidationTable->nreco(bin);
+    if (n < 2 || m_LookupTableIn->nreco(bin) < 2)
+    {
+      continue;
+    }
+    for (size_t i = 0; i < nquantities; ++i)
+    {
+      const double fit = m_ValidationTable->sigma(bin, quantities[i].first);
+      const double tab = m_LookupTableIn->sigma(bin, quantities[i].first);
+      weight[i] += n;
+      sigma_fit[i] += n * fit * fit;
+      sigma_table[i] += n * tab * tab;
+    }
+  }
+
+  std::cout << "PHG4TrackFastSim::End - lookup table validation on " << ntruth << " particles:" << std::endl;
+  std::cout << " efficiency: fit " << (ntruth > 0 ? nreco / ntruth : 0)
+            << " table " << (ntruth > 0 ? nexpected / ntruth : 0) << std::endl;
+  for (size_t i = 0; i < nquantities; ++i)
+  {
+    if (weight[i] > 0)
+    {
+      std::cout << " " << quantities[i].second << " resolution: fit " << std::sqrt(sigma_fit[i] / weight[i])
+                << " table " << std::sqrt(sigma_table[i] / weight[i]) << std::endl;
+    }
+  }
+}
+
 void PHG4TrackFastSim::DisplayEvent() const
 {
   if (m_DoEvtDisplayFlag && m_Fitter)
@@ -22,6 +22,7 @@
 
 #include <gsl/gsl_rng.h>
 
+#include <array>
 #include <climits>  // for UINT_MAX
 #include <map>
 #include <memory>
@@ -37,6 +38,7 @@ class SvtxVertexMap;
 class PHCompositeNode;
 class PHG4TruthInfoContainer;
 class PHParameters;
+class PHG4TrackFastSimTable;
 
 namespace PHGenFit
 {
@@ -231,6 +233,26 @@ class PHG4TrackFastSim : public SubsysReco
 
   void Smearing(const bool b) { m_SmearingFlag = b; }
 
+  //! fill an efficiency/resolution lookup table (binned in truth pt, eta, vertex z) from the fitted tracks, written in End
+  void set_lookup_table_output(const std::string& filename) { m_LookupTableOutFile = filename; }
+
+  //! binning of the output lookup table, pt [GeV] and vertex z [cm]
+  void set_lookup_table_binning(const int nptbins, const double ptmin, const double ptmax,
+                                const int netabins, const double etamin, const double etamax,
+                                const int nvzbins, const double vzmin, const double vzmax)
+  {
+    m_LookupTableBinning = {{{static_cast<double>(nptbins), ptmin, ptmax},
+                             {static_cast<double>(netabins), etamin, etamax},
+                             {static_cast<double>(nvzbins), vzmin, vzmax}}};
+  }
+
+  //! smear the truth particles with a lookup table instead of fitting them (O(1) per track).
+  //! No GenFit tracks are made, so there are no projections to calorimeters and no vertexing
+  void set_lookup_table_input(const std::string& filename) { m_LookupTableInFile = filename; }
+
+  //! with a lookup table input, run the full fit every n-th event (0: never) and compare with the table in End
+  void set_lookup_table_validation(const unsigned int n) { m_LookupTableValidation = n; }
+
  private:
   typedef std::map<const genfit::Track*, unsigned int> GenFitTrackMap;
 
@@ -268,6 +290,20 @@ class PHG4TrackFastSim : public SubsysReco
                      const unsigned int truth_track_id = UINT_MAX,
                      const unsigned int nmeas = 0, const TVector3& vtx = TVector3(0.0, 0.0, 0.0));
 
+  /*!
+   * Make SvtxTrack from the lookup table, false if the particle is not reconstructed
+   */
+  bool MakeSvtxTrackFromTable(SvtxTrack* track_out, const PHG4Particle* particle);
+
+  //! add a truth particle and its fitted track (nullptr if none) to the lookup tables being filled
+  void FillLookupTables(const PHG4Particle* particle, const SvtxTrack* track);
+
+  //! lookup table bin of a truth particle, -1 if it is not charged or outside the table
+  int LookupTableBin(const PHG4TrackFastSimTable* table, const PHG4Particle* particle) const;
+
+  //! compare the validation table from the full fit with the input table
+  void PrintLookupTableValidation() const;
+
   /*
    * Fill SvtxVertexMap from GFRaveVertexes and Tracks
    */
@@ -343,6 +379,21 @@ class PHG4TrackFastSim : public SubsysReco
   bool m_DoVertexingFlag;
 
   PHParameters* m_Parameter = nullptr;
+
+  //!@name lookup tables
+  //@{
+  std::string m_LookupTableInFile;
+  std::string m_LookupTableOutFile;
+  unsigned int m_LookupTableValidation = 0;
+  std::array<std::array<double, 3>, 3> m_LookupTableBinning = {{{20, 0, 20}, {40, -4, 4}, {6, -30, 30}}};
+
+  std::unique_ptr<PHG4TrackFastSimTable> m_LookupTableIn;
+  std::unique_ptr<PHG4TrackFastSimTable> m_LookupTableOut;
+  std::unique_ptr<PHG4TrackFastSimTable> m_ValidationTable;
+
+  //! true while the current event uses the lookup table
+  bool m_UseLookupTable = false;
+  //@}
 };
 
 #endif /*__PHG4TrackFastSim_H__*/
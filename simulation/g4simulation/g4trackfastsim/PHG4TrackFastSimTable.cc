@@ -0,0 +1,196 @@
+/*!
+ *  \file		PHG4TrackFastSimTable.cc
+ *  \brief		Efficiency and resolution lookup table for PHG4TrackFastSim
+ */
+
+#include "PHG4TrackFastSimTable.h"
+
+#include <TAxis.h>
+#include <TFile.h>
+#include <TH3.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+  const std::array<std::string, PHG4TrackFastSimTable::NQuantities> quantity_names = {
+      "ptrel", "phi", "theta", "dca2d", "dcaz", "nmeas", "ndf"};
+
+  // value inside the axis range, so the first and last bin are used outside of it
+  double clamp_to_axis(const TAxis* axis, const double value)
+  {
+    if (value < axis->GetXmin())
+    {
+      return axis->GetBinCenter(1);
+    }
+    if (value >= axis->GetXmax())
+    {
+      return axis->GetBinCenter(axis->GetNbins());
+    }
+    return value;
+  }
+}  // namespace
+
+PHG4TrackFastSimTable::PHG4TrackFastSimTable()
+{
+  set_binning(20, 0, 20, 40, -4, 4, 6, -30, 30);
+}
+
+PHG4TrackFastSimTable::~PHG4TrackFastSimTable() = default;
+
+void PHG4TrackFastSimTable::set_binning(const int nptbins, const double ptmin, const double ptmax,
+                                        const int netabins, const double etamin, const double etamax,
+                                        const int nvzbins, const double vzmin, const double vzmax)
+{
+  auto make = [&](const std::string& name)
+  {
+    auto h = std::make_unique<TH3D>(name.c_str(), name.c_str(), nptbins, ptmin, ptmax, netabins, etamin, etamax, nvzbins, vzmin, vzmax);
+    h->SetDirectory(nullptr);
+    h->GetXaxis()->SetTitle("p_{T} [GeV]");
+    h->GetYaxis()->SetTitle("#eta");
+    h->GetZaxis()->SetTitle("v_{z} [cm]");
+    return h;
+  };
+  m_Truth = make("ntruth");
+  m_Reco = make("nreco");
+  for (int q = 0; q < NQuantities; ++q)
+  {
+    m_Sum[q] = make("sum_" + quantity_names[q]);
+    m_Sum2[q] = make("sum2_" + quantity_names[q]);
+  }
+}
+
+int PHG4TrackFastSimTable::find_bin(const double pt, const double eta, const double vz) const
+{
+  const TAxis* etaaxis = m_Truth->GetYaxis();
+  if (!std::isfinite(eta) || eta < etaaxis->GetXmin() || eta >= etaaxis->GetXmax())
+  {
+    return -1;
+  }
+  return m_Truth->FindFixBin(clamp_to_axis(m_Truth->GetXaxis(), pt), eta, clamp_to_axis(m_Truth->GetZaxis(), vz));
+}
+
+void PHG4TrackFastSimTable::fill(const int bin, const bool reconstructed, const std::array<double, NQuantities>& residuals)
+{
+  if (bin < 0)
+  {
+    return;
+  }
+  m_Truth->AddBinContent(bin);
+  if (!reconstructed)
+  {
+    return;
+  }
+  m_Reco->AddBinContent(bin);
+  for (int q = 0; q < NQuantities; ++q)
+  {
+    m_Sum[q]->AddBinContent(bin, residuals[q]);
+    m_Sum2[q]->AddBinContent(bin, residuals[q] * residuals[q]);
+  }
+}
+
+int PHG4TrackFastSimTable::nbins() const
+{
+  return m_Truth->GetNcells();
+}
+
+double PHG4TrackFastSimTable::ntruth(const int bin) const
+{
+  return bin < 0 ? 0 : m_Truth->GetBinContent(bin);
+}
+
+double PHG4TrackFastSimTable::nreco(const int bin) const
+{
+  return bin < 0 ? 0 : m_Reco->GetBinContent(bin);
+}
+
+double PHG4TrackFastSimTable::efficiency(const int bin) const
+{
+  const double n = ntruth(bin);
+  return n > 0 ? nreco(bin) / n : 0;
+}
+
+double PHG4TrackFastSimTable::mean(const int bin, const Quantity q) const
+{
+  const double n = nreco(bin);
+  return n > 0 ? m_Sum[q]->GetBinContent(bin) / n : 0;
+}
+
+double PHG4TrackFastSimTable::sigma(const int bin, const Quantity q) const
+{
+  const double n = nreco(bin);
+  if (n < 2)
+  {
+    return 0;
+  }
+  const double m = m_Sum[q]->GetBinContent(bin) / n;
+  return std::sqrt(std::max(0., m_Sum2[q]->GetBinContent(bin) / n - m * m));
+}
+
+double PHG4TrackFastSimTable::efficiency() const
+{
+  const double n = m_Truth->GetSumOfWeights();
+  return n > 0 ? m_Reco->GetSumOfWeights() / n : 0;
+}
+
+bool PHG4TrackFastSimTable::write(const std::string& filename) const
+{
+  TFile f(filename.c_str(), "RECREATE");
+  if (!f.IsOpen())
+  {
+    std::cout << "PHG4TrackFastSimTable::write - cannot open " << filename << std::endl;
+    return false;
+  }
+  m_Truth->Write();
+  m_Reco->Write();
+  for (int q = 0; q < NQuantities; ++q)
+  {
+    m_Sum[q]->Write();
+    m_Sum2[q]->Write();
+  }
+  f.Close();
+  return true;
+}
+
+bool PHG4TrackFastSimTable::read(const std::string& filename)
+{
+  TFile f(filename.c_str(), "READ");
+  if (!f.IsOpen())
+  {
+    std::cout << "PHG4TrackFastSimTable::read - cannot open " << filename << std::endl;
+    return false;
+  }
+  auto get = [&](const std::string& name) -> std::unique_ptr<TH3D>
+  {
+    TH3D* h = dynamic_cast<TH3D*>(f.Get(name.c_str()));
+    if (!h)
+    {
+      std::cout << "PHG4TrackFastSimTable::read - " << name << " missing in " << filename << std::endl;
+      return nullptr;
+    }
+    h->SetDirectory(nullptr);
+    return std::unique_ptr<TH3D>(h);
+  };
+  std::unique_ptr<TH3D> truth = get("ntruth");
+  std::unique_ptr<TH3D> reco = get("nreco");
+  std::array<std::unique_ptr<TH3D>, NQuantities> sum;
+  std::array<std::unique_ptr<TH3D>, NQuantities> sum2;
+  bool complete = truth && reco;
+  for (int q = 0; q < NQuantities; ++q)
+  {
+    sum[q] = get("sum_" + quantity_names[q]);
+    sum2[q] = get("sum2_" + quantity_names[q]);
+    complete = complete && sum[q] && sum2[q];
+  }
+  if (!complete)
+  {
+    return false;
+  }
+  m_Truth = std::move(truth);
+  m_Reco = std::move(reco);
+  m_Sum = std::move(sum);
+  m_Sum2 = std::move(sum2);
+  return true;
+}
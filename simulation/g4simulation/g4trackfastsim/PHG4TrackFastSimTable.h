@@ -0,0 +1,86 @@
+// Tell emacs that this is a C++ source
+//  -*- C++ -*-.
+/*!
+ *  \file		PHG4TrackFastSimTable.h
+ *  \brief		Efficiency and resolution lookup table for PHG4TrackFastSim
+ *  \details	binned in truth pt, eta and vertex z, filled from the full Kalman fit
+ */
+
+#ifndef G4TRACKFASTSIM_PHG4TRACKFASTSIMTABLE_H
+#define G4TRACKFASTSIM_PHG4TRACKFASTSIMTABLE_H
+
+#include <array>
+#include <memory>
+#include <string>
+
+class TH3D;
+
+class PHG4TrackFastSimTable
+{
+ public:
+  //! residuals (reconstructed - truth) stored per bin
+  enum Quantity
+  {
+    PtRel = 0,  //!< (pt - pt_truth)/pt_truth
+    Phi,        //!< azimuth [rad]
+    Theta,      //!< polar angle [rad]
+    Dca2d,      //!< transverse dca [cm]
+    Dcaz,       //!< z at the point of closest approach - truth vertex z [cm]
+    NMeas,      //!< number of measurements
+    Ndf,        //!< degrees of freedom of the fit
+    NQuantities
+  };
+
+  PHG4TrackFastSimTable();
+  ~PHG4TrackFastSimTable();
+
+  PHG4TrackFastSimTable(const PHG4TrackFastSimTable&) = delete;
+  PHG4TrackFastSimTable& operator=(const PHG4TrackFastSimTable&) = delete;
+
+  //! binning, resets the content. pt [GeV] and vertex z [cm] outside the range use the first/last bin,
+  //! particles outside the eta range are never reconstructed
+  void set_binning(const int nptbins, const double ptmin, const double ptmax,
+                   const int netabins, const double etamin, const double etamax,
+                   const int nvzbins, const double vzmin, const double vzmax);
+
+  //! bin of a truth particle, -1 if outside the eta range
+  int find_bin(const double pt, const double eta, const double vz) const;
+
+  //! add a truth particle, residuals are only used if it was reconstructed
+  void fill(const int bin, const bool reconstructed, const std::array<double, NQuantities>& residuals);
+
+  //! number of bins, including under- and overflows
+  int nbins() const;
+
+  //! number of truth particles in bin
+  double ntruth(const int bin) const;
+
+  //! number of reconstructed particles in bin
+  double nreco(const int bin) const;
+
+  //! fraction of truth particles reconstructed, 0 for empty bins
+  double efficiency(const int bin) const;
+
+  //! mean residual of the reconstructed particles
+  double mean(const int bin, const Quantity q) const;
+
+  //! standard deviation of the residuals of the reconstructed particles
+  double sigma(const int bin, const Quantity q) const;
+
+  //! overall efficiency
+  double efficiency() const;
+
+  //! write the histograms to a ROOT file
+  bool write(const std::string& filename) const;
+
+  //! read the histograms from a ROOT file written by write(), keeps its binning
+  bool read(const std::string& filename);
+
+ private:
+  std::unique_ptr<TH3D> m_Truth;
+  std::unique_ptr<TH3D> m_Reco;
+  std::array<std::unique_ptr<TH3D>, NQuantities> m_Sum;
+  std::array<std::unique_ptr<TH3D>, NQuantities> m_Sum2;
+};
+
+#endif
@@ -36,6 +36,7 @@
 #include <TProfile.h>
 #include <TSystem.h>
 #include <TTree.h>
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -46,6 +47,31 @@ double CaloWaveformSim::template_function(double *x, double *par)
   return v1;
 }
 
+// same as TH1::Interpolate of the template, from the cached bin contents
+double CaloWaveformSim::template_value(double x) const
+{
+  const int nbins = m_template_content.size();
+  if (x <= m_template_center.front())
+  {
+    return m_template_content.front();
+  }
+  if (x >= m_template_center.back())
+  {
+    return m_template_content.back();
+  }
+  // bin number as in TAxis::FindFixBin, starting at 0
+  int bin = static_cast<int>(nbins * (x - m_template_xmin) / (m_template_xmax - m_template_xmin));
+  if (x <= m_template_center[bin])
+  {
+    bin--;
+  }
+  const double x0 = m_template_center[bin];
+  const double y0 = m_template_content[bin];
+  const double x1 = m_template_center[bin + 1];
+  const double y1 = m_template_content[bin + 1];
+  return y0 + (x - x0) * ((y1 - y0) / (x1 - x0));
+}
+
 CaloWaveformSim::CaloWaveformSim(const std::string &name)
   : SubsysReco(name)
 {
@@ -75,7 +101,32 @@ int CaloWaveformSim::Init(PHCompositeNode *topNode)
   assert(ft);
   assert(ft->IsOpen());
   h_template = (TProfile *) ft->Get("hpwaveform");
-  
+
+  // the template is fixed for the job, cache its bin contents for the interpolation
+  // and the position of its maximum
+  const int nbins = h_template->GetNbinsX();
+  m_template_content.resize(nbins);
+  m_template_center.resize(nbins);
+  for (int i = 0; i < nbins; i++)
+  {
+    m_template_content[i] = h_template->GetBinContent(i + 1);
+    m_template_center[i] = h_template->GetBinCenter(i + 1);
+  }
+  m_template_xmin = h_template->GetXaxis()->GetXmin();
+  m_template_xmax = h_template->GetXaxis()->GetXmax();
+  if (h_template->GetXaxis()->IsVariableBinSize())
+  {
+    std::cout << "CaloWaveformSim::Init  template " << templatefilename << " has variable bin sizes" << std::endl;
+    exit(1);
+  }
+  TF1 *f_template = new TF1(
+      "f_template", [this](double *x, double *par)
+      { return this->template_function(x, par); },
+      0, m_nsamples, 3);
+  f_template->SetParameter(0, 1.0);
+  m_template_max_x = f_template->GetMaximumX();
+  delete f_template;
+
   // get the decalibration from the CDB
   PHNodeIterator nodeIter(topNode);
 
@@ -199,11 +250,7 @@ int CaloWaveformSim::Init(PHCompositeNode *topNode)
       exit(1);
     }
   }
-  m_waveforms.resize(m_nchannels);
-  for (auto &waveform : m_waveforms)
-  {
-    waveform.resize(m_nsamples);
-  }
+  m_waveforms.resize(m_nchannels * m_nsamples);
 
   CreateNodeTree(topNode);
   return Fun4AllReturnCodes::EVENT_OK;
@@ -244,23 +291,11 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
   }
 
   // initialize the waveform
-  for (auto &waveform : m_waveforms)
-  {
-    for (auto &sample : waveform)
-    {
-      sample = 0.;
-    }
-  }
-  // waveform TH1
-  TF1 *f_fit = new TF1(
-      "f_fit", [this](double *x, double *par)
-      { return this->template_function(x, par); },
-      0, m_nsamples, 3);
-  f_fit->SetParameter(0, 1.0);
+  std::fill(m_waveforms.begin(), m_waveforms.end(), 0.);
+
   float shift_of_shift = m_timeshiftwidth * gsl_rng_uniform(m_RandomGenerator);
 
-  float _shiftval = m_peakpos + shift_of_shift - f_fit->GetMaximumX();
-  f_fit->SetParameters(1, _shiftval, 0);
+  float _shiftval = m_peakpos + shift_of_shift - m_template_max_x;
 
   // get G4Hits
   std::string nodename = "G4HIT_" + m_detector;
@@ -310,10 +345,12 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
     edepMap[hit->get_hit_id()] += hitEdep;
     showerMap[showerID] += hitEdep;
 
-    f_fit->SetParameters(ADC, _shiftval + t0, 0.);
+    // the pulse is ADC * template(i - shift)
+    float *waveform = &m_waveforms.at(tower_index * m_nsamples);
+    const double shift = _shiftval + t0;
     for (int i = 0; i < m_nsamples; i++)
     {
-      m_waveforms.at(tower_index).at(i) += f_fit->Eval(i);
+      waveform[i] += ADC * template_value(i - shift);
     }
   }
 
@@ -334,25 +371,35 @@ int CaloWaveformSim::process_event(PHCompositeNode *topNode)
 
     for (int i = 0; i < m_nchannels; i++)
     {
-      for (int j = 0; j < m_nsamples; j++)
+      float *waveform = &m_waveforms[i * m_nsamples];
+      if (m_noiseType == NoiseType::NOISE_TREE)
       {
-        if (m_noiseType == NoiseType::NOISE_TREE)
+        TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
+        for (int j = 0; j < m_nsamples; j++)
         {
-          TowerInfo *pedestal_tower = m_PedestalContainer->get_tower_at_channel(i);
-          m_waveforms.at(i).at(j) += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
+          waveform[j] += (j < m_pedestalsamples) ? pedestal_tower->get_waveform_value(j) : pedestal_tower->get_waveform_value(m_pedestalsamples - 1);
         }
-        if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+      }
+      if (m_noiseType == NoiseType::NOISE_GAUSSIAN)
+      {
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
+          waveform[j] += gsl_ran_gaussian(m_RandomGenerator, m_gaussian_noise);
         }
-        if (m_noiseType == NoiseType::NOISE_NONE)
+      }
+      if (m_noiseType == NoiseType::NOISE_NONE)
+      {
+        for (int j = 0; j < m_nsamples; j++)
         {
-          m_waveforms.at(i).at(j) += m_fixpedestal;
+          waveform[j] += m_fixpedestal;
         }
-        m_CaloWaveformContainer->get_tower_at_channel(i)->set_waveform_value(j, m_waveforms.at(i).at(j));
+      }
+      TowerInfo *tower = m_CaloWaveformContainer->get_tower_at_channel(i);
+      for (int j = 0; j < m_nsamples; j++)
+      {
+        tower->set_waveform_value(j, waveform[j]);
       }
     }
-    delete f_fit;
     return Fun4AllReturnCodes::EVENT_OK;
   }
 
@@ -153,7 +153,15 @@ class CaloWaveformSim : public SubsysReco
   TowerInfoContainer *m_CaloWaveformContainer{nullptr};
   TowerInfoContainer *m_PedestalContainer{nullptr};
 
-  std::vector<std::vector<float>> m_waveforms = {{}};
+  //! waveforms of all channels, m_nsamples per channel
+  std::vector<float> m_waveforms;
+  //! template bin contents and centers
+  std::vector<double> m_template_content;
+  std::vector<double> m_template_center;
+  double m_template_xmin{0};
+  double m_template_xmax{1};
+  //! position of the template maximum
+  float m_template_max_x{0};
   int m_runNumber{0};
   int m_nsamples{31};
   int m_nchannels{24576};
@@ -175,6 +183,7 @@ class CaloWaveformSim : public SubsysReco
   unsigned int (*encode_tower)(const unsigned int etabin, const unsigned int phibin){TowerInfoDefs::encode_emcal};
   unsigned int (*decode_tower)(const unsigned int tower_key){TowerInfoDefs::decode_emcal};
   double template_function(double *x, double *par);
+  double template_value(double x) const;
   void CreateNodeTree(PHCompositeNode *topNode);
 
   LightCollectionModel light_collection_model;